@@ -419,6 +419,9 @@ endif()
 
 if(onnxruntime_ENABLE_ATEN)
   message("Aten fallback is enabled.")
+endif()
+
+if(onnxruntime_ENABLE_DLPACK)
   FetchContent_Declare(
     dlpack
     URL ${DEP_URL_dlpack}
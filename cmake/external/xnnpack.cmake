@@ -24,7 +24,19 @@ onnxruntime_fetchcontent_makeavailable(fxdiv)
 set(FXDIV_SOURCE_DIR ${fxdiv_SOURCE_DIR})
 
 FetchContent_Declare(pthreadpool URL ${DEP_URL_pthreadpool} URL_HASH SHA1=${DEP_SHA1_pthreadpool})
-onnxruntime_fetchcontent_makeavailable(pthreadpool)
+if(onnxruntime_XNNPACK_USE_ORT_THREADPOOL)
+  # Only use the pthreadpool header. The "pthreadpool" library XNNPACK links against is implemented on top of
+  # ORT's thread pool, see onnxruntime/core/providers/xnnpack/detail/ort_pthreadpool.cc. Its ORT include
+  # directories and dependencies are set up with the XNNPACK EP in onnxruntime_providers.cmake.
+  FetchContent_GetProperties(pthreadpool)
+  if(NOT pthreadpool_POPULATED)
+    FetchContent_Populate(pthreadpool)
+  endif()
+  add_library(pthreadpool STATIC ${PROJECT_SOURCE_DIR}/../onnxruntime/core/providers/xnnpack/detail/ort_pthreadpool.cc)
+  target_include_directories(pthreadpool PUBLIC ${pthreadpool_SOURCE_DIR}/include)
+else()
+  onnxruntime_fetchcontent_makeavailable(pthreadpool)
+endif()
 FetchContent_Declare(googlexnnpack URL ${DEP_URL_googlexnnpack}  URL_HASH SHA1=${DEP_SHA1_googlexnnpack}
 PATCH_COMMAND ${Patch_EXECUTABLE} --binary --ignore-whitespace -p1 < ${PROJECT_SOURCE_DIR}/patches/xnnpack/AddEmscriptenAndIosSupport.patch)
 
@@ -28,11 +28,24 @@ file(GLOB kernel_explorer_srcs CONFIGURE_DEPENDS
 file(GLOB kernel_explorer_kernel_srcs CONFIGURE_DEPENDS
   "${KERNEL_EXPLORER_ROOT}/kernels/*.cc"
   "${KERNEL_EXPLORER_ROOT}/kernels/*.h"
-  "${KERNEL_EXPLORER_ROOT}/kernels/*.cu"
-  "${KERNEL_EXPLORER_ROOT}/kernels/*.cuh"
 )
 
-onnxruntime_add_shared_library_module(kernel_explorer ${kernel_explorer_srcs} ${kernel_explorer_kernel_srcs})
+if (onnxruntime_USE_CUDA OR onnxruntime_USE_ROCM)
+  file(GLOB kernel_explorer_gpu_kernel_srcs CONFIGURE_DEPENDS
+    "${KERNEL_EXPLORER_ROOT}/kernels/*.cu"
+    "${KERNEL_EXPLORER_ROOT}/kernels/*.cuh"
+  )
+  list(APPEND kernel_explorer_kernel_srcs ${kernel_explorer_gpu_kernel_srcs})
+endif()
+
+# MLAS kernels, available in all builds
+file(GLOB kernel_explorer_cpu_kernel_srcs CONFIGURE_DEPENDS
+  "${KERNEL_EXPLORER_ROOT}/kernels/cpu/*.cc"
+  "${KERNEL_EXPLORER_ROOT}/kernels/cpu/*.h"
+)
+
+onnxruntime_add_shared_library_module(kernel_explorer ${kernel_explorer_srcs} ${kernel_explorer_kernel_srcs}
+                                      ${kernel_explorer_cpu_kernel_srcs})
 set_target_properties(kernel_explorer PROPERTIES PREFIX "_")
 target_include_directories(kernel_explorer PUBLIC
   $<TARGET_PROPERTY:onnxruntime_pybind11_state,INCLUDE_DIRECTORIES>
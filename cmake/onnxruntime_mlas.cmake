@@ -8,6 +8,10 @@ onnxruntime_add_static_library(onnxruntime_mlas
   ${MLAS_SRC_DIR}/threading.cpp
   ${MLAS_SRC_DIR}/sgemm.cpp
   ${MLAS_SRC_DIR}/qgemm.cpp
+  ${MLAS_SRC_DIR}/halfgemm.cpp
+  ${MLAS_SRC_DIR}/q4gemm.cpp
+  ${MLAS_SRC_DIR}/sparsegemm.cpp
+  ${MLAS_SRC_DIR}/dwconv.cpp
   ${MLAS_SRC_DIR}/qdwconv.cpp
   ${MLAS_SRC_DIR}/convolve.cpp
   ${MLAS_SRC_DIR}/convsym.cpp
@@ -20,6 +24,11 @@ onnxruntime_add_static_library(onnxruntime_mlas
   ${MLAS_SRC_DIR}/tanh.cpp
   ${MLAS_SRC_DIR}/erf.cpp
   ${MLAS_SRC_DIR}/compute.cpp
+  ${MLAS_SRC_DIR}/reduce.cpp
+  ${MLAS_SRC_DIR}/resize.cpp
+  ${MLAS_SRC_DIR}/topk.cpp
+  ${MLAS_SRC_DIR}/cast.cpp
+  ${MLAS_SRC_DIR}/layernorm.cpp
   ${MLAS_SRC_DIR}/quantize.cpp
   ${MLAS_SRC_DIR}/qgemm_kernel_default.cpp
   ${MLAS_SRC_DIR}/qladd.cpp
@@ -127,6 +136,11 @@ function(setup_mlas_source_for_windows)
       ${MLAS_SRC_DIR}/qgemm_kernel_sse.cpp
       ${MLAS_SRC_DIR}/qgemm_kernel_sse41.cpp
       ${MLAS_SRC_DIR}/intrinsics/avx512/quantize_avx512f.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/q4gemm_avx512f.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/sparsegemm_avx512f.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/layernorm_avx512f.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/halfgemm_avx512core.cpp
+      ${MLAS_SRC_DIR}/intrinsics/avx512/sparsegemm_avx512core.cpp
       ${MLAS_SRC_DIR}/amd64/QgemmU8S8KernelAvx2.asm
       ${MLAS_SRC_DIR}/amd64/QgemmU8U8KernelAvx2.asm
       ${MLAS_SRC_DIR}/amd64/QgemmU8X8KernelAvx2.asm
@@ -154,7 +168,6 @@ function(setup_mlas_source_for_windows)
       ${MLAS_SRC_DIR}/amd64/SpoolKernelAvx.asm
       ${MLAS_SRC_DIR}/amd64/SpoolKernelAvx512F.asm
       ${MLAS_SRC_DIR}/amd64/sgemma.asm
-      ${MLAS_SRC_DIR}/amd64/cvtfp16a.asm
       ${MLAS_SRC_DIR}/amd64/SoftmaxKernelAvx.asm
       ${MLAS_SRC_DIR}/amd64/TransKernelFma3.asm
       ${MLAS_SRC_DIR}/amd64/TransKernelAvx512F.asm
@@ -297,7 +310,17 @@ else()
           ${MLAS_SRC_DIR}/qgemm_kernel_neon.cpp
           ${MLAS_SRC_DIR}/qgemm_kernel_udot.cpp
           ${MLAS_SRC_DIR}/qgemm_kernel_sdot.cpp
+          ${MLAS_SRC_DIR}/halfgemm_kernel_neon.cpp
         )
+        check_cxx_compiler_flag("-march=armv8.2-a+i8mm" HAS_ARM64_I8MM)
+        if(HAS_ARM64_I8MM)
+          set(mlas_platform_srcs_i8mm
+            ${MLAS_SRC_DIR}/qgemm_kernel_i8mm.cpp
+          )
+          set_source_files_properties(${mlas_platform_srcs_i8mm} PROPERTIES COMPILE_FLAGS "-march=armv8.2-a+i8mm")
+          set_property(SOURCE ${MLAS_SRC_DIR}/platform.cpp APPEND PROPERTY COMPILE_DEFINITIONS MLAS_I8MM_INTRINSICS)
+          list(APPEND mlas_platform_srcs ${mlas_platform_srcs_i8mm})
+        endif()
         if(ONNXRUNTIME_MLAS_MULTI_ARCH)
             onnxruntime_add_static_library(onnxruntime_mlas_arm64 ${mlas_platform_srcs})
             set_target_properties(onnxruntime_mlas_arm64 PROPERTIES OSX_ARCHITECTURES "arm64")
@@ -453,8 +476,12 @@ else()
           ${MLAS_SRC_DIR}/x86_64/ErfKernelFma3.S
           ${MLAS_SRC_DIR}/intrinsics/avx2/qladd_avx2.cpp
           ${MLAS_SRC_DIR}/intrinsics/avx2/qdwconv_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/q4gemm_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/sparsegemm_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/cast_avx2.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx2/layernorm_avx2.cpp
         )
-        set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma")
+        set_source_files_properties(${mlas_platform_srcs_avx2} PROPERTIES COMPILE_FLAGS "-mavx2 -mfma -mf16c")
 
         set(mlas_platform_srcs_avx512f
           ${MLAS_SRC_DIR}/x86_64/DgemmKernelAvx512F.S
@@ -463,6 +490,9 @@ else()
           ${MLAS_SRC_DIR}/x86_64/SpoolKernelAvx512F.S
           ${MLAS_SRC_DIR}/x86_64/TransKernelAvx512F.S
           ${MLAS_SRC_DIR}/intrinsics/avx512/quantize_avx512f.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx512/q4gemm_avx512f.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx512/sparsegemm_avx512f.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx512/layernorm_avx512f.cpp
         )
         set_source_files_properties(${mlas_platform_srcs_avx512f} PROPERTIES COMPILE_FLAGS "-mavx512f")
 
@@ -474,6 +504,12 @@ else()
         )
         set_source_files_properties(${mlas_platform_srcs_avx512core} PROPERTIES COMPILE_FLAGS "-mavx512bw -mavx512dq -mavx512vl")
 
+        set(mlas_platform_srcs_avx512core_intrinsics
+          ${MLAS_SRC_DIR}/intrinsics/avx512/halfgemm_avx512core.cpp
+          ${MLAS_SRC_DIR}/intrinsics/avx512/sparsegemm_avx512core.cpp
+        )
+        set_source_files_properties(${mlas_platform_srcs_avx512core_intrinsics} PROPERTIES COMPILE_FLAGS "-mavx512bw -mavx512dq -mavx512vl -mf16c")
+
         set(mlas_platform_srcs
           ${MLAS_SRC_DIR}/dgemm.cpp
           ${MLAS_SRC_DIR}/qgemm_kernel_avx2.cpp
@@ -482,8 +518,45 @@ else()
           ${mlas_platform_srcs_avx2}
           ${mlas_platform_srcs_avx512f}
           ${mlas_platform_srcs_avx512core}
+          ${mlas_platform_srcs_avx512core_intrinsics}
         )
 
+        check_cxx_compiler_flag("-mavx512bf16" HAS_AVX512BF16)
+        if(HAS_AVX512BF16)
+          set(mlas_platform_srcs_avx512bf16
+            ${MLAS_SRC_DIR}/intrinsics/avx512/halfgemm_avx512bf16.cpp
+          )
+          set_source_files_properties(${mlas_platform_srcs_avx512bf16} PROPERTIES COMPILE_FLAGS "-mavx512bf16 -mavx512bw -mavx512dq -mavx512vl")
+          set_property(SOURCE ${MLAS_SRC_DIR}/platform.cpp APPEND PROPERTY COMPILE_DEFINITIONS MLAS_AVX512BF16_INTRINSICS)
+          set(mlas_platform_srcs
+            ${mlas_platform_srcs}
+            ${mlas_platform_srcs_avx512bf16}
+          )
+        endif()
+
+        check_cxx_compiler_flag("-mamx-int8" HAS_AMX)
+        if(HAS_AMX)
+          set(mlas_platform_srcs_amx
+            ${MLAS_SRC_DIR}/intrinsics/amx/qgemm_amx.cpp
+          )
+          set_source_files_properties(${mlas_platform_srcs_amx} PROPERTIES COMPILE_FLAGS "-mavx512bw -mavx512dq -mavx512vl -mamx-tile -mamx-int8")
+          if(HAS_AVX512BF16)
+            set(mlas_platform_srcs_amxbf16
+              ${MLAS_SRC_DIR}/intrinsics/amx/halfgemm_amx.cpp
+            )
+            set_source_files_properties(${mlas_platform_srcs_amxbf16} PROPERTIES COMPILE_FLAGS "-mavx512bf16 -mavx512bw -mavx512dq -mavx512vl -mamx-tile -mamx-bf16")
+            set(mlas_platform_srcs_amx
+              ${mlas_platform_srcs_amx}
+              ${mlas_platform_srcs_amxbf16}
+            )
+          endif()
+          set_property(SOURCE ${MLAS_SRC_DIR}/platform.cpp APPEND PROPERTY COMPILE_DEFINITIONS MLAS_AMX_INTRINSICS)
+          set(mlas_platform_srcs
+            ${mlas_platform_srcs}
+            ${mlas_platform_srcs_amx}
+          )
+        endif()
+
         if(ONNXRUNTIME_MLAS_MULTI_ARCH)
           onnxruntime_add_static_library(onnxruntime_mlas_x86_64 ${mlas_platform_srcs})
           set_target_properties(onnxruntime_mlas_x86_64 PROPERTIES OSX_ARCHITECTURES "x86_64")
@@ -197,7 +197,7 @@ if (onnxruntime_ENABLE_TRAINING_OPS AND NOT onnxruntime_ENABLE_TRAINING)
   list(REMOVE_ITEM onnxruntime_providers_src ${onnxruntime_cpu_full_training_only_srcs})
 endif()
 
-if (onnxruntime_ENABLE_ATEN)
+if (onnxruntime_ENABLE_DLPACK)
   file(GLOB_RECURSE onnxruntime_providers_dlpack_srcs CONFIGURE_DEPENDS
     "${ONNXRUNTIME_ROOT}/core/dlpack/dlpack_converter.cc"
     "${ONNXRUNTIME_ROOT}/core/dlpack/dlpack_converter.h"
@@ -283,6 +283,9 @@ endif()
 
 if (onnxruntime_ENABLE_ATEN)
   target_compile_definitions(onnxruntime_providers PRIVATE ENABLE_ATEN)
+endif()
+
+if (onnxruntime_ENABLE_DLPACK)
   # DLPack is a header-only dependency
   set(DLPACK_INCLUDE_DIR ${dlpack_SOURCE_DIR}/include)
   target_include_directories(onnxruntime_providers PRIVATE ${DLPACK_INCLUDE_DIR})
@@ -504,6 +507,10 @@ if (onnxruntime_USE_CUDA)
       target_include_directories(onnxruntime_providers_cuda PRIVATE ${NCCL_INCLUDE_DIRS})
       target_link_libraries(onnxruntime_providers_cuda PRIVATE ${NCCL_LIBRARIES})
     endif()
+  elseif (onnxruntime_USE_NCCL)
+    # tensor parallel inference uses the NCCL collectives in contrib_ops/cuda/collective
+    target_include_directories(onnxruntime_providers_cuda PRIVATE ${NCCL_INCLUDE_DIRS} ${MPI_CXX_INCLUDE_DIRS})
+    target_link_libraries(onnxruntime_providers_cuda PRIVATE ${NCCL_LIBRARIES} ${MPI_LIBRARIES} ${MPI_CXX_LINK_FLAGS})
   endif()
 
   if (WIN32)
@@ -1528,12 +1535,25 @@ if (onnxruntime_USE_XNNPACK)
     "${ONNXRUNTIME_ROOT}/core/providers/shared/node_unit/node_unit.cc"
   )
 
+  # The pthreadpool implementation over ORT's thread pool is built as its own library in external/xnnpack.cmake.
+  list(REMOVE_ITEM onnxruntime_providers_xnnpack_cc_srcs
+    "${ONNXRUNTIME_ROOT}/core/providers/xnnpack/detail/ort_pthreadpool.cc"
+  )
+
   source_group(TREE ${REPO_ROOT} FILES ${onnxruntime_providers_xnnpack_cc_srcs})
   onnxruntime_add_static_library(onnxruntime_providers_xnnpack ${onnxruntime_providers_xnnpack_cc_srcs})
   onnxruntime_add_include_to_target(onnxruntime_providers_xnnpack
     onnxruntime_common onnxruntime_framework onnx onnx_proto ${PROTOBUF_LIB} XNNPACK pthreadpool Boost::mp11 safeint_interface
   )
 
+  if (onnxruntime_XNNPACK_USE_ORT_THREADPOOL)
+    target_compile_definitions(onnxruntime_providers_xnnpack PRIVATE XNNPACK_USE_ORT_THREADPOOL)
+    target_include_directories(pthreadpool PRIVATE ${CMAKE_CURRENT_BINARY_DIR} ${ONNXRUNTIME_ROOT} ${ONNXRUNTIME_INCLUDE_DIR}
+                               ${eigen_INCLUDE_DIRS})
+    onnxruntime_add_include_to_target(pthreadpool onnxruntime_common)
+    target_link_libraries(pthreadpool PRIVATE onnxruntime_common)
+  endif()
+
   add_dependencies(onnxruntime_providers_xnnpack onnx ${onnxruntime_EXTERNAL_DEPENDENCIES})
   set_target_properties(onnxruntime_providers_xnnpack PROPERTIES FOLDER "ONNXRuntime")
 
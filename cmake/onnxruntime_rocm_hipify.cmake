@@ -37,6 +37,12 @@ set(contrib_ops_excluded_files
   "quantization/attention_quantization.h"
   "quantization/attention_quantization_impl.cu"
   "quantization/attention_quantization_impl.cuh"
+  "quantization/float8_quantization.cc"
+  "quantization/float8_quantization.h"
+  "quantization/float8_quantization_impl.cu"
+  "quantization/float8_quantization_impl.cuh"
+  "quantization/matmul_float8.cc"
+  "quantization/matmul_float8.h"
   "quantization/quantize_dequantize_linear.cc"
   "quantization/qordered_ops/qordered_attention_impl.cu"
   "quantization/qordered_ops/qordered_attention_impl.h"
@@ -109,6 +115,8 @@ set(provider_excluded_files
   "math/einsum.h"
   "math/gemm.cc"
   "math/matmul.cc"
+  "math/quantize_linear_matmul.cc"  # uses the cuBLASLt IMMA kernels
+  "math/quantize_linear_matmul.h"
   "math/softmax_impl.cu"
   "math/softmax_warpwise_impl.cuh"
   "math/softmax_common.cc"
@@ -128,6 +136,10 @@ set(provider_excluded_files
   "rnn/rnn.h"
   "rnn/rnn_impl.cu"
   "rnn/rnn_impl.h"
+  "tensor/memcpy_batch.cc"  # the ROCm EP does not register the batched copies
+  "tensor/memcpy_batch.h"
+  "tensor/memcpy_batch_impl.cu"
+  "tensor/memcpy_batch_impl.h"
   "shared_inc/cuda_call.h"
   "shared_inc/fpgeneric.h"
   "cuda_allocator.cc"
@@ -141,9 +153,13 @@ set(provider_excluded_files
   "cuda_execution_provider.h"
   "cuda_memory_check.cc"
   "cuda_memory_check.h"
+  "cuda_nhwc_kernels.cc"
+  "cuda_nhwc_kernels.h"
   "cuda_fence.cc"
   "cuda_fence.h"
   "cuda_fwd.h"
+  "cuda_graph.cc"
+  "cuda_graph.h"
   "cuda_kernel.h"
   "cuda_pch.cc"
   "cuda_pch.h"
@@ -127,6 +127,30 @@ namespace Microsoft.ML.OnnxRuntime
             }
         }
 
+        /// <summary>
+        /// This is a factory method that creates a disposable instance of FixedBufferOnnxValue
+        /// on top of a managed CPU buffer of one of the supported primitive types. The element type
+        /// and the size of the buffer are inferred from T, so no copy is made and nothing needs to be
+        /// computed by the caller. The instance can be created once and reused across
+        /// InferenceSession.Run() calls as an input or as a pre-allocated output; the buffer contents can
+        /// be updated between the runs.
+        /// </summary>
+        /// <typeparam name="T">one of the supported primitive types, string is not supported</typeparam>
+        /// <param name="memory">buffer to read or write the tensor data, must hold at least the shape size elements</param>
+        /// <param name="shape">shape of the tensor to be created</param>
+        /// <returns>a disposable instance of FixedBufferOnnxValue</returns>
+        public static FixedBufferOnnxValue CreateFromMemory<T>(Memory<T> memory, long[] shape)
+        {
+            var typeInfo = TensorBase.GetTypeInfo(typeof(T));
+            if (typeInfo == null || typeInfo.IsString)
+            {
+                throw new ArgumentException("Type " + typeof(T) + " is not supported, use the overload" +
+                    " that takes an explicit TensorElementType for custom blittable types");
+            }
+            return CreateFromMemory(OrtMemoryInfo.DefaultInstance, memory, typeInfo.ElementType, shape,
+                (long)memory.Length * typeInfo.TypeSize);
+        }
+
         #region IDisposable Support
 
         /// <summary>
@@ -41,6 +41,12 @@ namespace Microsoft.ML.OnnxRuntime
         /// </summary>
         private Dictionary<string, NodeMetadata> _overridableInitializerMetadata;
 
+        /// <summary>
+        /// Zero terminated utf8 copies of the input, output and overridable initializer names
+        /// in native memory, so Run() does not convert and pin the names on every call.
+        /// </summary>
+        private Dictionary<string, IntPtr> _utf8Names = new Dictionary<string, IntPtr>();
+
         private SessionOptions _builtInSessionOptions = null;
         private RunOptions _builtInRunOptions = null;
         private ModelMetadata _modelMetadata = null;
@@ -333,15 +339,29 @@ namespace Microsoft.ML.OnnxRuntime
                 throw new ArgumentException($"Length of {nameof(outputNames)} ({outputNames.Count}) must match that of {nameof(outputValues)} ({outputValues.Count}).");
             }
 
-            using (var cleanupList = new DisposableList<IDisposable>())
+            // The native arrays are rented and the names come from the session cache, so runs over
+            // pre-allocated values do not allocate once the pool is warm.
+            var pool = ArrayPool<IntPtr>.Shared;
+            var inputNamesArray = pool.Rent(inputNames.Count);
+            var inputValuesArray = pool.Rent(inputValues.Count);
+            var outputNamesArray = pool.Rent(outputNames.Count);
+            var outputValuesArray = pool.Rent(outputValues.Count);
+            DisposableList<IDisposable> cleanupList = null;
+            try
             {
                 // prepare inputs
-                var inputNamesArray = ConvertNamesToUtf8(inputNames, n => n, cleanupList);
-                IntPtr[] inputValuesArray = GetOrtValuesHandles(inputValues, true);
+                for (int i = 0; i < inputNames.Count; ++i)
+                {
+                    inputNamesArray[i] = GetUtf8Name(inputNames.ElementAt(i), ref cleanupList);
+                }
+                FillOrtValuesHandles(inputValues, true, inputValuesArray);
 
                 // prepare outputs
-                var outputNamesArray = ConvertNamesToUtf8(outputNames, n => n, cleanupList);
-                IntPtr[] outputValuesArray = GetOrtValuesHandles(outputValues, false);
+                for (int i = 0; i < outputNames.Count; ++i)
+                {
+                    outputNamesArray[i] = GetUtf8Name(outputNames.ElementAt(i), ref cleanupList);
+                }
+                FillOrtValuesHandles(outputValues, false, outputValuesArray);
 
                 NativeApiStatus.VerifySuccess(NativeMethods.OrtRun(
                                                     _nativeHandle,
@@ -354,6 +374,14 @@ namespace Microsoft.ML.OnnxRuntime
                                                     outputValuesArray /* pointers to Pre-allocated OrtValue instances */
                                                     ));
             }
+            finally
+            {
+                cleanupList?.Dispose();
+                pool.Return(inputNamesArray);
+                pool.Return(inputValuesArray);
+                pool.Return(outputNamesArray);
+                pool.Return(outputValuesArray);
+            }
         }
 
         /// <summary>
@@ -631,15 +659,57 @@ namespace Microsoft.ML.OnnxRuntime
             var result = new IntPtr[inputs.Count];
             for (int i = 0; i < inputs.Count; ++i)
             {
-                var name = extractor(inputs.ElementAt(i));
-                var utf8Name = NativeOnnxValueHelper.StringToZeroTerminatedUtf8(name);
-                var pinnedHandle = new PinnedGCHandle(GCHandle.Alloc(utf8Name, GCHandleType.Pinned));
-                result[i] = pinnedHandle.Pointer;
-                cleanupList.Add(pinnedHandle);
+                result[i] = GetUtf8Name(extractor(inputs.ElementAt(i)), ref cleanupList);
             }
             return result;
         }
 
+        /// <summary>
+        /// Run helper. Returns the cached zero terminated utf8 name of a model input or output,
+        /// other names are converted and pinned.
+        /// </summary>
+        /// <param name="name">name to look up</param>
+        /// <param name="cleanupList">list to add pinned memory to for later disposal, created if null</param>
+        /// <returns>pointer to the utf8 name that stays valid until cleanupList is disposed</returns>
+        private IntPtr GetUtf8Name(string name, ref DisposableList<IDisposable> cleanupList)
+        {
+            IntPtr cachedName;
+            if (_utf8Names.TryGetValue(name, out cachedName))
+            {
+                return cachedName;
+            }
+
+            var utf8Name = NativeOnnxValueHelper.StringToZeroTerminatedUtf8(name);
+            var pinnedHandle = new PinnedGCHandle(GCHandle.Alloc(utf8Name, GCHandleType.Pinned));
+            if (cleanupList == null)
+            {
+                cleanupList = new DisposableList<IDisposable>();
+            }
+            cleanupList.Add(pinnedHandle);
+            return pinnedHandle.Pointer;
+        }
+
+        private void CacheUtf8Name(string name)
+        {
+            if (_utf8Names.ContainsKey(name))
+            {
+                return;
+            }
+            var utf8Name = NativeOnnxValueHelper.StringToZeroTerminatedUtf8(name);
+            var nativeName = Marshal.AllocHGlobal(utf8Name.Length);
+            Marshal.Copy(utf8Name, 0, nativeName, utf8Name.Length);
+            _utf8Names.Add(name, nativeName);
+        }
+
+        private void FreeUtf8Names()
+        {
+            foreach (var nativeName in _utf8Names.Values)
+            {
+                Marshal.FreeHGlobal(nativeName);
+            }
+            _utf8Names.Clear();
+        }
+
         /// <summary>
         /// This function obtains ortValues for NamedOnnxValue.
         /// The problem with NamedOnnxValue is that it does not contain any Onnx (OrtValue)
@@ -671,6 +741,12 @@ namespace Microsoft.ML.OnnxRuntime
         private IntPtr[] GetOrtValuesHandles(IReadOnlyCollection<FixedBufferOnnxValue> values, bool input)
         {
             var valuesArray = new IntPtr[values.Count];
+            FillOrtValuesHandles(values, input, valuesArray);
+            return valuesArray;
+        }
+
+        private void FillOrtValuesHandles(IReadOnlyCollection<FixedBufferOnnxValue> values, bool input, IntPtr[] valuesArray)
+        {
             for (int index = 0; index < values.Count; ++index)
             {
                 var v = values.ElementAt(index);
@@ -680,7 +756,6 @@ namespace Microsoft.ML.OnnxRuntime
                 }
                 valuesArray[index] = v.Value.Handle;
             }
-            return valuesArray;
         }
 
 
@@ -835,6 +910,7 @@ namespace Microsoft.ML.OnnxRuntime
                 {
                     var iname = GetInputName(i);
                     _inputMetadata[iname] = GetInputMetadata(i);
+                    CacheUtf8Name(iname);
                 }
                 // get output count
                 UIntPtr outputCount = UIntPtr.Zero;
@@ -843,7 +919,9 @@ namespace Microsoft.ML.OnnxRuntime
                 // get all the output names and metadata
                 for (ulong i = 0; i < (ulong)outputCount; i++)
                 {
-                    _outputMetadata[GetOutputName(i)] = GetOutputMetadata(i);
+                    var oname = GetOutputName(i);
+                    _outputMetadata[oname] = GetOutputMetadata(i);
+                    CacheUtf8Name(oname);
                 }
 
                 // get overridable initializer count
@@ -853,7 +931,9 @@ namespace Microsoft.ML.OnnxRuntime
                 // get all the overridable initializer names and metadata
                 for (ulong i = 0; i < (ulong)initilaizerCount; i++)
                 {
-                    _overridableInitializerMetadata[GetOverridableInitializerName(i)] = GetOverridableInitializerMetadata(i);
+                    var initializerName = GetOverridableInitializerName(i);
+                    _overridableInitializerMetadata[initializerName] = GetOverridableInitializerMetadata(i);
+                    CacheUtf8Name(initializerName);
                 }
                 // set profiling's start time
                 UIntPtr startTime = UIntPtr.Zero;
@@ -863,6 +943,7 @@ namespace Microsoft.ML.OnnxRuntime
             }
             catch (OnnxRuntimeException)
             {
+                FreeUtf8Names();
                 if (_nativeHandle != IntPtr.Zero)
                 {
                     NativeMethods.OrtReleaseSession(_nativeHandle);
@@ -1092,6 +1173,7 @@ namespace Microsoft.ML.OnnxRuntime
             }
 
             // cleanup unmanaged resources
+            FreeUtf8Names();
             if (_nativeHandle != IntPtr.Zero)
             {
                 NativeMethods.OrtReleaseSession(_nativeHandle);
@@ -1026,6 +1026,45 @@ namespace Microsoft.ML.OnnxRuntime.Tests
             }
         }
 
+        [Fact(DisplayName = "TestFixedBufferOnnxValueFromMemory")]
+        private void TestFixedBufferOnnxValueFromMemory()
+        {
+            // model takes 1x5 input of fixed type, echoes back
+            var model = TestDataLoader.LoadModelFromEmbeddedResource("test_types_INT32.pb");
+            using (var session = new InferenceSession(model))
+            {
+                // the tensors are mapped onto slices of a single buffer
+                var buffer = new int[10];
+                var shape = new long[] { 1, 5 };
+                var inputMemory = new Memory<int>(buffer, 0, 5);
+                var outputMemory = new Memory<int>(buffer, 5, 5);
+
+                using (FixedBufferOnnxValue valueInput = FixedBufferOnnxValue.CreateFromMemory(inputMemory, shape),
+                                            valueOutput = FixedBufferOnnxValue.CreateFromMemory(outputMemory, shape))
+                {
+                    var inputValues = new[] { valueInput };
+                    var outputValues = new[] { valueOutput };
+
+                    for (var i = 0; i < 10; i++)
+                    {
+                        var inputs = Enumerable.Range(i, 5).ToArray();
+                        inputs.AsSpan().CopyTo(inputMemory.Span);
+
+                        session.Run(new[] { "input" }, inputValues, new[] { "output" }, outputValues);
+                        Assert.Equal(inputs, outputMemory.ToArray());
+                    }
+
+                    // names which are not cached by the session are still resolved
+                    var ex = Assert.Throws<OnnxRuntimeException>(
+                        () => session.Run(new[] { "input" }, inputValues, new[] { "foo" }, outputValues));
+                    Assert.Contains("foo", ex.Message);
+                }
+            }
+
+            Assert.Throws<ArgumentException>(
+                () => FixedBufferOnnxValue.CreateFromMemory(new Memory<string>(new string[1]), new long[] { 1 }));
+        }
+
         [Fact(DisplayName = "TestModelInputINT32")]
         private void TestModelInputINT32()
         {
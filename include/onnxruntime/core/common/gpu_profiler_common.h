@@ -437,6 +437,10 @@ class GPUProfilerBase : public EpProfiler {
     MergeEvents(event_map, events);
   }
 
+  virtual void Flush(TimePoint start_time, Events& events) override {
+    EndProfiling(start_time, events);
+  }
+
   virtual void Start(uint64_t id) override {
     auto& manager = TManager::GetInstance();
     manager.PushCorrelation(client_handle_, id, profiling_start_time_);
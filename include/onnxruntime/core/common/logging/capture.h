@@ -33,6 +33,18 @@ class Capture {
       : logger_{&logger}, severity_{severity}, category_{category}, data_type_{dataType}, location_{location} {
   }
 
+  /**
+     Initializes a new instance of the Capture class that is not attached to a logger.
+     The message is not sent anywhere on destruction. Used by sinks that replay a message they buffered.
+     @param severity The severity.
+     @param category The category.
+     @param dataType Type of the data.
+     @param location The file location the log message is coming from.
+  */
+  Capture(logging::Severity severity, const char* category, logging::DataType dataType, const CodeLocation& location)
+      : logger_{nullptr}, severity_{severity}, category_{category}, data_type_{dataType}, location_{location} {
+  }
+
   /**
      The stream that can capture the message via operator<<.
      @returns Output stream.
@@ -16,6 +16,7 @@ enum EventCategory {
   NODE_EVENT,
   KERNEL_EVENT,
   API_EVENT,
+  COUNTER_EVENT,
   EVENT_CATEGORY_MAX
 };
 
@@ -24,7 +25,8 @@ static constexpr const char* event_category_names_[EVENT_CATEGORY_MAX] = {
     "Session",
     "Node",
     "Kernel",
-    "Api"};
+    "Api",
+    "Counter"};
 
 // Timing record for all events.
 struct EventRecord {
@@ -83,6 +85,7 @@ class EpProfiler {
   virtual void EndProfiling(TimePoint start_time, Events& events) = 0;  // called when profiling ends, save all captures numbers to "events"
   virtual void Start(uint64_t){};                                       // called before op start, accept an id as argument to identify the op
   virtual void Stop(uint64_t){};                                        // called after op stop, accept an id as argument to identify the op
+  virtual void Flush(TimePoint, Events&){};                             // called when streamed events are written, save the numbers captured so far to "events"
 };
 
 // Demangle C++ symbols
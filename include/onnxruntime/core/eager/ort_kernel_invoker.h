@@ -3,7 +3,9 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "core/common/common.h"
@@ -14,6 +16,7 @@
 #include "core/session/environment.h"
 #include "core/graph/basic_types.h"
 #include "core/graph/model.h"
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 #ifdef __GNUC__
@@ -44,11 +47,29 @@ class ORTInvoker {
                         const int version = -1);
 
  private:
+  // Graph, kernel and execution frame metadata built for one op signature.
+  struct CachedKernel;
+
+  // Return the kernel to run "op_name" with inputs of the given element types,
+  // creating and caching it on first use.
+  common::Status GetOrCreateKernel(const std::string& op_name,
+                                   const std::vector<OrtValue>& inputs,
+                                   size_t num_outputs,
+                                   const NodeAttributes* attributes,
+                                   const std::string& domain,
+                                   const int version,
+                                   std::shared_ptr<const CachedKernel>& cached_kernel);
+
   std::shared_ptr<IExecutionProvider> execution_provider_;
   const logging::Logger& logger_;
   // custom ops for current execution provider
   // we need the op schema to resolve the output type during invoke
   const IOnnxRuntimeOpSchemaRegistryList& custom_op_registries_;
+  // Kernels keyed by op type, domain, attributes, input element types and number of outputs.
+  // Eager ops are dispatched one by one, so building the graph and kernel once per signature
+  // and reusing it keeps the per-op overhead low.
+  std::unordered_map<std::string, std::shared_ptr<const CachedKernel>> kernel_cache_;
+  OrtMutex kernel_cache_mutex_;
 };
 
 #ifdef __GNUC__
@@ -16,20 +16,37 @@ struct OrtArenaCfg {
                   arena_extend_strategy(-1),
                   initial_chunk_size_bytes(-1),
                   max_dead_bytes_per_chunk(-1),
-                  initial_growth_chunk_size_bytes(-1) {}
+                  initial_growth_chunk_size_bytes(-1),
+                  thread_cache_max_chunk_bytes(-1),
+                  shrink_idle_ms(0),
+                  shrink_low_usage_percent(0),
+                  shrink_window_ms(0),
+                  shrink_retain_bytes(0) {}
   OrtArenaCfg(size_t max_mem, int arena_extend_strategy, int initial_chunk_size_bytes,
-              int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes)
+              int max_dead_bytes_per_chunk, int initial_growth_chunk_size_bytes,
+              int thread_cache_max_chunk_bytes = -1)
       : max_mem(max_mem),
         arena_extend_strategy(arena_extend_strategy),
         initial_chunk_size_bytes(initial_chunk_size_bytes),
         max_dead_bytes_per_chunk(max_dead_bytes_per_chunk),
-        initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes) {}
+        initial_growth_chunk_size_bytes(initial_growth_chunk_size_bytes),
+        thread_cache_max_chunk_bytes(thread_cache_max_chunk_bytes),
+        shrink_idle_ms(0),
+        shrink_low_usage_percent(0),
+        shrink_window_ms(0),
+        shrink_retain_bytes(0) {}
 
   size_t max_mem;                       // use 0 to allow ORT to choose the default
   int arena_extend_strategy;            // use -1 to allow ORT to choose the default, 0 = kNextPowerOfTwo, 1 = kSameAsRequested
   int initial_chunk_size_bytes;         // use -1 to allow ORT to choose the default
   int max_dead_bytes_per_chunk;         // use -1 to allow ORT to choose the default
   int initial_growth_chunk_size_bytes;  // use -1 to allow ORT to choose the default
+  int thread_cache_max_chunk_bytes;     // use -1 to allow ORT to choose the default, 0 disables the thread cache
+  // The arena frees its unused regions in the background, see BFCArena::ShrinkPolicy. 0 disables each trigger.
+  int shrink_idle_ms;                   // shrink after this many milliseconds without allocations or frees
+  int shrink_low_usage_percent;         // shrink when the peak usage of a window is below this percent of the arena
+  int shrink_window_ms;                 // length of the window of shrink_low_usage_percent
+  size_t shrink_retain_bytes;           // the shrinkage stops at this many allocated bytes
 };
 
 namespace onnxruntime {
@@ -77,6 +94,15 @@ class IAllocator {
   // By default, the base implementation  just calls Alloc().
   virtual void* Reserve(size_t size) { return Alloc(size); }
 
+  // A stream aware allocator orders the use of its memory on a Stream: the memory returned by AllocOnStream is
+  // ready to be used by the work queued on `stream`, and ReleaseStreamBuffers is called before `stream` is released.
+  // By default, the base implementation does not track streams and AllocOnStream just calls Alloc().
+  virtual bool IsStreamAware() const { return false; }
+
+  virtual void* AllocOnStream(size_t size, Stream* /*stream*/, WaitNotificationFn /*wait_fn*/) { return Alloc(size); }
+
+  virtual void ReleaseStreamBuffers(Stream* /*stream*/) {}
+
   const OrtMemoryInfo& Info() const { return memory_info_; };
 
   // Each implementation of IAllocator can override and provide their own implementation
@@ -192,16 +192,23 @@ class IExecutionProvider {
   virtual bool IsGraphCaptureEnabled() const { return false; }
 
   /**
-     Indicate whether the graph has been captured and instantiated. Currently
-     only CUDA execution provider supports it.
+     Indicate whether the graph identified by `graph_key` has been captured and
+     instantiated. Currently only CUDA execution provider supports it.
    */
-  virtual bool IsGraphCaptured() const { return false; }
+  virtual bool IsGraphCaptured(const std::string& /*graph_key*/) const { return false; }
 
   /**
-     Run the instantiated graph. Currently only CUDA execution provider supports
-     it.
+     Run the instantiated graph identified by `graph_key`. Currently only CUDA
+     execution provider supports it.
    */
-  virtual common::Status ReplayGraph() { return Status::OK(); }
+  virtual common::Status ReplayGraph(const std::string& /*graph_key*/) { return Status::OK(); }
+
+  /**
+     Select the graph that the next run captures, called before OnRunStart in
+     graph capturing mode. An empty key disables the capture for the run.
+     The runs of a session that captures graphs are serialized.
+   */
+  virtual void SetGraphCaptureKey(const std::string& /*graph_key*/) {}
 
   /**
      Called when session creation is complete
@@ -294,6 +301,23 @@ class IExecutionProvider {
     return DataLayout::NCHW;
   }
 
+  /**
+     Does the layout transformer convert a layout sensitive node assigned to the EP to the preferred layout.
+     A converted node must be taken by the EP in the second call to GetCapability, so an EP that only has kernels in
+     the preferred layout for some of the layout sensitive ops should override this to exclude the others.
+  */
+  virtual bool ShouldConvertDataLayoutForOp(std::string_view /*node_domain*/,
+                                            std::string_view /*node_op_type*/) const {
+    return true;
+  }
+
+  /**
+     The maximum number of compute streams the nodes of the EP may be spread over in a session.
+     If it is larger than 1, the planner places independent branches of the main graph on separate streams of the
+     device, which synchronize with notifications at the cross-stream edges.
+  */
+  virtual int GetMaxComputeStreams() const { return 1; }
+
   virtual void RegisterStreamHandlers(IStreamCommandHandleRegistry& /*stream_handle_registry*/) const {}
 
   /** Does the EP support concurrent calls to InferenceSession::Run to execute the model.
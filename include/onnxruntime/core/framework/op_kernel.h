@@ -121,6 +121,25 @@ class OpKernel {
     return Status::OK();
   }
 
+  // Override this function to use pre-packed weights loaded from the on-disk pre-packed weights cache
+  // (see kOrtSessionOptionsConfigPrepackedWeightsCacheDir) instead of calling PrePack() for the tensor.
+  // The buffers are the ones that PrePack() stored in its PrePackedWeights, for an equivalent node and
+  // the same tensor contents, in an earlier session. They are read-only and owned by the session.
+  // The kernel must set up the same state PrePack() would have without packing the tensor again. It should
+  // re-check anything besides the node's attributes and this tensor that the packing depends on, and set
+  // used_cached_buffers to false to fall back to PrePack() if it doesn't match.
+  // @param tensor: The initialized constant tensor, as passed to PrePack()
+  // @param input_idx: The input index of the tensor in this kernel
+  // @param prepacked_buffers: The cached pre-packed buffers, in the same order PrePack() stored them
+  // @param used_cached_buffers: Boolean flag set by the kernel implementation indicating
+  // that the provided weight has been used by the kernel.
+  virtual Status UseCachedPrePackedBuffers(const Tensor& /*tensor*/, int /*input_idx*/,
+                                           std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                           /*out*/ bool& used_cached_buffers) {
+    used_cached_buffers = false;
+    return Status::OK();
+  }
+
   const OrtMemoryInfo& Allocator(int id, OrtMemType mem_type) const;
   const OpKernelInfo& Info() const {
     return *op_kernel_info_;
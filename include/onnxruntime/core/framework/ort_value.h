@@ -42,6 +42,13 @@ struct OrtValue {
     type_ = type;
   }
 
+  // Takes shared ownership of an existing value, e.g. one created with std::make_shared to allocate the value and
+  // its control block at once.
+  void Init(std::shared_ptr<void> data, onnxruntime::MLDataType type) {
+    data_ = std::move(data);
+    type_ = type;
+  }
+
   bool IsAllocated() const {
     return data_ && type_;
   }
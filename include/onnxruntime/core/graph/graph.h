@@ -9,6 +9,7 @@
 #include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 
 #ifdef _WIN32
 #pragma warning(push)
@@ -1018,6 +1019,25 @@ class Graph {
     return graph_resolve_needed_;
   }
 
+  /** Gets the modification epoch of the Graph.
+  The epoch is incremented whenever a node of this Graph or any of its subgraphs is added or removed, or has its edges
+  or attributes changed, and whenever the graph inputs, outputs or initializers change.
+  Modifications are tracked by the top level graph so the value is the same for all subgraphs. */
+  uint64_t ModificationEpoch() const noexcept {
+    return TopLevelGraph().modification_epoch_;
+  }
+
+  /** Returns true if a node with the given op type was modified after the given epoch, or if the graph was modified
+  after the given epoch in a way that is not attributable to specific nodes. */
+  bool IsOpTypeModifiedSince(std::string_view op_type, uint64_t epoch) const;
+
+  /** Records a modification of the node. Graph methods that change nodes call this, so it is only needed if a node is
+  changed in a way the Graph can't see, e.g. by updating its input or output definitions in place. */
+  void MarkNodeModified(const Node& node);
+
+  /** Records a modification that is not attributable to specific nodes. Any op type is considered modified. */
+  void MarkModified() noexcept;
+
   /** Sets flag that Graph::graph_proto_ needs to be updated to reflect changes in the Graph. */
   Graph& SetGraphProtoSyncNeeded() noexcept {
     graph_proto_sync_needed_ = true;
@@ -1369,6 +1389,8 @@ class Graph {
         bool strict_shape_type_inference);
 
   // internal use by the Graph class only
+  // release_node_protos moves the attributes of the NodeProtos into the nodes and clears the NodeProtos of
+  // graph_proto, which the graph owns. They are recreated from the nodes when the GraphProto is synced.
   Graph(const Model& owning_model,
         ONNX_NAMESPACE::GraphProto* graph_proto,
         const std::unordered_map<std::string, int>& domain_to_version,
@@ -1377,7 +1399,8 @@ class Graph {
         Graph* parent_graph,
         const Node* parent_node,
         const logging::Logger& logger,
-        bool strict_shape_type_inference);
+        bool strict_shape_type_inference,
+        bool release_node_protos);
 
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Graph);
 
@@ -1388,6 +1411,10 @@ class Graph {
   Node& AddNode(const ONNX_NAMESPACE::NodeProto& node_proto,
                 const ArgNameToTypeMap& name_to_type);
 
+  // Add node with specified <node_proto>, moving its attributes into the node.
+  Node& AddNode(ONNX_NAMESPACE::NodeProto&& node_proto,
+                const ArgNameToTypeMap& name_to_type);
+
 #endif
 
   Version IrVersion() const noexcept {
@@ -1543,6 +1570,18 @@ class Graph {
   Node& CreateFusedSubGraphNode(const IndexedSubGraph& sub_graph, const std::string& fused_node_name);
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
+  const Graph& TopLevelGraph() const noexcept {
+    const Graph* graph = this;
+    while (graph->parent_graph_ != nullptr) {
+      graph = graph->parent_graph_;
+    }
+    return *graph;
+  }
+
+  Graph& TopLevelGraph() noexcept {
+    return const_cast<Graph&>(std::as_const(*this).TopLevelGraph());
+  }
+
   Node* NodeAtIndexImpl(NodeIndex node_index) const {
     // if we are trying to access a node that doesn't exist there's (most
     // likely) either a logic issue or a graph consistency/correctness issue.
@@ -1608,6 +1647,10 @@ class Graph {
 
   bool graph_proto_sync_needed_ = false;
 
+  // The NodeProtos of graph_proto_ were released once the nodes were created from them, so graph_proto_ has to be
+  // synced even right after the graph was loaded.
+  bool node_protos_released_ = false;
+
   // The topological order of node index used to do node and op match verification temporarily.
   std::vector<NodeIndex> nodes_in_topological_order_;
 
@@ -1669,6 +1712,13 @@ class Graph {
   // number of times Resolve has run.
   int num_resolves_ = 0;
 
+  // modification tracking. only updated in the top level graph, see ModificationEpoch.
+  uint64_t modification_epoch_ = 0;
+  // epoch of the last modification that is not attributable to specific nodes
+  uint64_t untracked_modification_epoch_ = 0;
+  // epoch of the last modification of a node with the op type
+  InlinedHashMap<std::string, uint64_t> op_type_modification_epochs_;
+
   const logging::Logger& logger_;
 
   // If true, all inconsistencies encountered during shape and type inference
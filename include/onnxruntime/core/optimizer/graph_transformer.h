@@ -42,6 +42,13 @@ class GraphTransformer {
 
   virtual bool ShouldOnlyApplyOnce() const { return false; }
 
+  /** Gets the op types of all the nodes in the patterns this transformer matches. An empty set means any op type.
+  GraphTransformerManager only re-applies the transformer if a node with one of these op types was modified since the
+  transformer last ran (see Graph::IsOpTypeModifiedSince). Transformers whose matching depends on anything other than
+  the nodes, their edges and attributes, and initializers, e.g. on inferred shapes, must return an empty set.
+  */
+  virtual InlinedHashSet<std::string_view> TargetOpTypes() const { return {}; }
+
  protected:
   /** Helper method to call ApplyImpl on any subgraphs in the Node. */
   common::Status Recurse(Node& node, bool& modified, int graph_level, const logging::Logger& logger) const {
@@ -32,7 +32,10 @@
 #pragma warning(disable : 4127)
 #pragma warning(disable : 4805)
 #endif
+#include <algorithm>
+#include <chrono>
 #include <memory>
+#include <vector>
 #include "unsupported/Eigen/CXX11/ThreadPool"
 
 #if defined(__GNUC__)
@@ -45,6 +48,7 @@
 #include "core/common/spin_pause.h"
 #include "core/platform/ort_mutex.h"
 #include "core/platform/Barrier.h"
+#include "core/platform/threadpool.h"
 
 // ORT thread pool overview
 // ------------------------
@@ -70,6 +74,9 @@
 //
 //   This spin-then-block behavior is configured via a flag provided
 //   when creating the thread pool, and by the constant spin_count.
+//   With ThreadOptions::adaptive_spinning, each worker instead spins
+//   for a time derived from its recent idle periods, see
+//   AdaptiveSpinPolicy.
 //
 // - Although all tasks are simple void()->void functions,
 //   conceptually there are three different kinds:
@@ -214,7 +221,7 @@ class ThreadPoolProfiler {
   ThreadPoolProfiler(int, const CHAR_TYPE*){};
   ~ThreadPoolProfiler() = default;
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPoolProfiler);
-  void Start(){};
+  void Start(bool){};
   std::string Stop() { return "not available for minimal build"; }
   void LogStart(){};
   void LogEnd(ThreadPoolEvent){};
@@ -222,8 +229,10 @@ class ThreadPoolProfiler {
   void LogStartAndCoreAndBlock(std::ptrdiff_t){};
   void LogCoreAndBlock(std::ptrdiff_t){};
   void LogThreadId(int){};
+  void LogRunStart(int){};
   void LogRun(int){};
   std::string DumpChildThreadStat() { return {}; }
+  std::vector<ThreadPoolWorkerRun> TakeRuns() { return {}; }
 };
 #else
 class ThreadPoolProfiler {
@@ -240,7 +249,7 @@ class ThreadPoolProfiler {
   ~ThreadPoolProfiler();
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPoolProfiler);
   using Clock = std::chrono::high_resolution_clock;
-  void Start();                  //called by executor to start profiling
+  void Start(bool record_runs);  //called by executor to start profiling, optionally recording the runs of children
   std::string Stop();            //called by executor to stop profiling and return collected numbers
   void LogStart();               //called in main thread to record the starting time point
   void LogEnd(ThreadPoolEvent);  //called in main thread to calculate and save the time elapsed from last start point
@@ -248,8 +257,10 @@ class ThreadPoolProfiler {
   void LogStartAndCoreAndBlock(std::ptrdiff_t block_size);
   void LogCoreAndBlock(std::ptrdiff_t block_size);  //called in main thread to log core and block size for task breakdown
   void LogThreadId(int thread_idx);                 //called in child thread to log its id
+  void LogRunStart(int thread_idx);                 //called in child thread before a run
   void LogRun(int thread_idx);                      //called in child thread to log num of run
   std::string DumpChildThreadStat();                //return all child statitics collected so far
+  std::vector<ThreadPoolWorkerRun> TakeRuns();      //return and clear the runs recorded so far
 
  private:
   static const char* GetEventName(ThreadPoolEvent);
@@ -266,6 +277,7 @@ class ThreadPoolProfiler {
     std::string Reset();
   };
   bool enabled_ = false;
+  bool record_runs_ = false;
   MainThreadStat& GetMainThreadStat();  //return thread local stat
   int num_threads_;
 #ifdef _MSC_VER
@@ -278,12 +290,16 @@ class ThreadPoolProfiler {
     uint64_t num_run_ = 0;
     onnxruntime::TimePoint last_logged_point_ = Clock::now();
     int32_t core_ = -1;                   //core that the child thread is running on
+    unsigned int logging_thread_id_ = 0;
+    onnxruntime::TimePoint run_start_point_{};
   };
 #ifdef _MSC_VER
 #pragma warning(pop)
 #endif  // _MSC_VER
   std::vector<ChildThreadStat> child_thread_stats_;
   std::string thread_pool_name_;
+  OrtMutex runs_mutex_;
+  std::vector<ThreadPoolWorkerRun> runs_;
 };
 #endif
 
@@ -329,8 +345,9 @@ class ExtendedThreadPoolInterface : public Eigen::ThreadPoolInterface {
   // two loops execute in series in a parallel section. ]
   virtual void RunInParallel(std::function<void(unsigned idx)> fn,
                              unsigned n, std::ptrdiff_t block_size) = 0;
-  virtual void StartProfiling() = 0;
+  virtual void StartProfiling(bool record_worker_runs) = 0;
   virtual std::string StopProfiling() = 0;
+  virtual std::vector<ThreadPoolWorkerRun> TakeProfiledWorkerRuns() = 0;
 };
 
 class ThreadPoolParallelSection {
@@ -351,6 +368,10 @@ class ThreadPoolParallelSection {
   // and in the dispatcher.
   unsigned current_dop{0};
 
+  // Whether the tasks of the section go to the high priority queues,
+  // set from the priority of the thread starting the section.
+  bool high_priority{false};
+
   // State shared between the main thread and worker threads
   // -------------------------------------------------------
 
@@ -397,6 +418,42 @@ class ThreadPoolLoop {
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPoolLoop);
 };
 
+// Derives how long an idle worker spins before blocking from the lengths of its recent idle
+// periods, i.e. the inter-arrival times of the work it is given.  When most idle periods are
+// short enough to be caught by spinning, the worker spins for twice their recent average, so
+// that a burst of parallel sections within a run is served without wake-up latency, while the
+// long gap after the burst only costs that short spin.  When most idle periods are longer, e.g.
+// between the requests of a server at low QPS, the worker blocks after a minimal spin.
+// Used only by the worker thread that owns it.
+class AdaptiveSpinPolicy {
+ public:
+  static constexpr std::chrono::nanoseconds kMinSpin{std::chrono::microseconds(10)};
+  static constexpr std::chrono::nanoseconds kMaxSpin{std::chrono::milliseconds(1)};
+
+  std::chrono::nanoseconds GetSpinDuration() const {
+    if (hit_rate_ < kHitRateOne / 4) {
+      return kMinSpin;
+    }
+    return std::clamp(2 * short_idle_average_, kMinSpin, kMaxSpin);
+  }
+
+  // Records the length of an idle period that ended with the worker getting work.
+  void OnIdleEnd(std::chrono::nanoseconds idle_time) {
+    const bool hit = idle_time <= kMaxSpin;
+    hit_rate_ += ((hit ? kHitRateOne : 0) - hit_rate_) / 16;
+    if (hit) {
+      short_idle_average_ += (idle_time - short_idle_average_) / 8;
+    }
+  }
+
+ private:
+  // the fraction of idle periods that spinning for kMaxSpin would catch, in 1 / kHitRateOne
+  static constexpr int64_t kHitRateOne = 1024;
+  int64_t hit_rate_ = kHitRateOne;
+  // the average length of those idle periods, starting with spinning for kMaxSpin
+  std::chrono::nanoseconds short_idle_average_ = kMaxSpin / 2;
+};
+
 template <typename Work, typename Tag, unsigned kSize>
 class RunQueue {
  public:
@@ -694,14 +751,18 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   }
 
  public:
-  void StartProfiling() override {
-    profiler_.Start();
+  void StartProfiling(bool record_worker_runs) override {
+    profiler_.Start(record_worker_runs);
   }
 
   std::string StopProfiling() override {
     return profiler_.Stop();
   }
 
+  std::vector<ThreadPoolWorkerRun> TakeProfiledWorkerRuns() override {
+    return profiler_.TakeRuns();
+  }
+
   struct Tag {
     constexpr Tag() : v_(0) {
     }
@@ -745,6 +806,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         env_(env),
         num_threads_(num_threads),
         allow_spinning_(allow_spinning),
+        adaptive_spinning_(allow_spinning && thread_options.adaptive_spinning),
         set_denormal_as_zero_(thread_options.set_denormal_as_zero),
         worker_data_(num_threads),
         all_coprimes_(num_threads),
@@ -762,6 +824,8 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       ComputeCoprimes(i, &all_coprimes_.back());
     }
 
+    InitializeNumaDomains(thread_options);
+
     // Eigen::MaxSizeVector has neither essential exception safety features
     // such as swap, nor it is movable. So we have to join threads right here
     // on exception
@@ -791,7 +855,19 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     PerThread* pt = GetPerThread();
     int q_idx = Rand(&pt->rand) % num_threads_;
     WorkerData& td = worker_data_[q_idx];
-    Queue& q = td.queue;
+    const ThreadPoolPriority priority = pt->priority;
+    Queue& q = td.GetQueue(priority == ThreadPoolPriority::kHigh);
+    if (priority != ThreadPoolPriority::kNormal) {
+      // the task runs with the priority of the thread scheduling it, so that the work it schedules in turn,
+      // e.g. the kernels of the streams of a run, keeps the priority
+      fn = [fn = std::move(fn), priority]() {
+        PerThread* worker_pt = GetPerThread();
+        const ThreadPoolPriority worker_priority = worker_pt->priority;
+        worker_pt->priority = priority;
+        fn();
+        worker_pt->priority = worker_priority;
+      };
+    }
     fn = q.PushBack(std::move(fn));
     if (!fn) {
       // The queue accepted the work; ensure that the thread will pick it up
@@ -829,6 +905,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     ps.work_done = false;
     ps.tasks_revoked = 0;
     ps.current_dop = 1;
+    ps.high_priority = pt.priority == ThreadPoolPriority::kHigh;
     ps.active = true;
   }
 
@@ -856,7 +933,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     // not the dispatch task itself has started -- if it has not started
     // then it cannot have pushed tasks.
     if (ps.dispatch_q_idx != -1) {
-      Queue& q = worker_data_[ps.dispatch_q_idx].queue;
+      Queue& q = worker_data_[ps.dispatch_q_idx].GetQueue(ps.high_priority);
       if (q.RevokeWithTag(pt.tag, ps.dispatch_w_idx)) {
         if (!ps.dispatch_started.load(std::memory_order_acquire)) {
           // We successfully revoked a task, and saw the dispatch task
@@ -892,7 +969,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     unsigned tasks_started = static_cast<unsigned>(ps.tasks.size());
     while (!ps.tasks.empty()) {
       const auto& item = ps.tasks.back();
-      Queue& q = worker_data_[item.first].queue;
+      Queue& q = worker_data_[item.first].GetQueue(ps.high_priority);
       if (q.RevokeWithTag(pt.tag, item.second)) {
         ps.tasks_revoked++;
       }
@@ -1067,7 +1144,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
       unsigned q_idx = preferred_workers[par_idx] % num_threads_;
       assert(q_idx < num_threads_);
       WorkerData& td = worker_data_[q_idx];
-      Queue& q = td.queue;
+      Queue& q = td.GetQueue(ps.high_priority);
       unsigned w_idx;
 
       // Attempt to enqueue the task
@@ -1180,7 +1257,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
         profiler_.LogStart();
         ps.dispatch_q_idx = preferred_workers[current_dop] % num_threads_;
         WorkerData& dispatch_td = worker_data_[ps.dispatch_q_idx];
-        Queue& dispatch_que = dispatch_td.queue;
+        Queue& dispatch_que = dispatch_td.GetQueue(ps.high_priority);
 
         // assign dispatch task to selected dispatcher
         auto push_status = dispatch_que.PushBackWithTag(dispatch_task, pt.tag, ps.dispatch_w_idx);
@@ -1295,6 +1372,21 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     return -1;
   }
 
+  // Number of NUMA domains the workers are grouped into, or 0 if they are not grouped.
+  unsigned NumNumaDomains() const {
+    return static_cast<unsigned>(numa_domains_.size());
+  }
+
+  // NUMA domain of the calling thread in [0, NumNumaDomains()), or -1 if the workers are not grouped
+  // or the calling thread is not a worker of this pool.
+  int CurrentThreadNumaDomain() const {
+    if (numa_domains_.empty()) {
+      return -1;
+    }
+    const int thread_id = CurrentThreadId();
+    return thread_id == -1 ? -1 : static_cast<int>(worker_numa_domain_[thread_id]);
+  }
+
   void EnableSpinning() {
     spin_loop_status_ = SpinLoopStatus::kBusy;
   }
@@ -1303,6 +1395,30 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     spin_loop_status_ = SpinLoopStatus::kIdle;
   }
 
+  // Starts accumulating the time that the workers spend running tasks.
+  void EnableBusyTimeTracking() {
+    track_busy_time_ = true;
+  }
+
+  // Total time in nanoseconds that the workers spent running tasks since EnableBusyTimeTracking was called.
+  uint64_t GetBusyTimeNs() const {
+    uint64_t busy_ns = 0;
+    for (unsigned i = 0; i < num_threads_; i++) {
+      busy_ns += worker_data_[i].busy_ns.load(std::memory_order_relaxed);
+    }
+    return busy_ns;
+  }
+
+  // Priority of the work scheduled and the parallel sections started by the calling thread. Tasks
+  // scheduled with a priority other than kNormal run with that priority on the workers.
+  static ThreadPoolPriority GetCurrentThreadPriority() {
+    return GetPerThread()->priority;
+  }
+
+  static void SetCurrentThreadPriority(ThreadPoolPriority priority) {
+    GetPerThread()->priority = priority;
+  }
+
  private:
   void ComputeCoprimes(int N, Eigen::MaxSizeVector<unsigned>* coprimes) {
     for (int i = 1; i <= N; i++) {
@@ -1320,6 +1436,41 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     }
   }
 
+  // Group the workers by the NUMA node of the first logical processor in their affinity.  Grouping is
+  // only enabled when the node of every worker is known and the workers span more than one node.
+  void InitializeNumaDomains(const ThreadOptions& thread_options) {
+    if (thread_options.affinities.size() < num_threads_) {
+      return;
+    }
+
+    std::vector<int> nodes;
+    std::vector<unsigned> worker_domain(num_threads_);
+    for (unsigned i = 0; i < num_threads_; i++) {
+      const auto& affinity = thread_options.affinities[i];
+      const int node = affinity.empty() ? -1 : env_.GetNumaNodeOfLogicalProcessor(affinity.front());
+      if (node < 0) {
+        return;
+      }
+      auto it = std::find(nodes.begin(), nodes.end(), node);
+      worker_domain[i] = static_cast<unsigned>(it - nodes.begin());
+      if (it == nodes.end()) {
+        nodes.push_back(node);
+      }
+    }
+    if (nodes.size() < 2) {
+      return;
+    }
+
+    numa_domains_.resize(nodes.size());
+    for (unsigned i = 0; i < num_threads_; i++) {
+      for (unsigned d = 0; d < nodes.size(); d++) {
+        auto& workers = (d == worker_domain[i]) ? numa_domains_[d].local_workers : numa_domains_[d].remote_workers;
+        workers.push_back(i);
+      }
+    }
+    worker_numa_domain_ = std::move(worker_domain);
+  }
+
   typedef typename Environment::EnvThread Thread;
   struct WorkerData;
 
@@ -1347,6 +1498,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     int thread_id{-1};                // Worker thread index in pool.
     Tag tag{};                        // Work item tag used to identify this thread.
     bool leading_par_section{false};  // Leading a parallel section (used only for asserts)
+    ThreadPoolPriority priority{ThreadPoolPriority::kNormal};  // Priority of the work the thread schedules
 
     // When this thread is entering a parallel section, it will
     // initially push work to this set of workers.  The aim is to
@@ -1362,10 +1514,40 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
 
   struct WorkerData {
-    constexpr WorkerData() : thread(), queue() {
+    constexpr WorkerData() : thread(), queue(), high_priority_queue() {
     }
     std::unique_ptr<Thread> thread;
     Queue queue;
+    // tasks of high priority work, which the worker and the thieves take before the ones in queue
+    Queue high_priority_queue;
+
+    Queue& GetQueue(bool high_priority) {
+      return high_priority ? high_priority_queue : queue;
+    }
+
+    Task PopFront() {
+      Task t = high_priority_queue.PopFront();
+      if (!t) {
+        t = queue.PopFront();
+      }
+      return t;
+    }
+
+    Task PopBack() {
+      Task t = high_priority_queue.PopBack();
+      if (!t) {
+        t = queue.PopBack();
+      }
+      return t;
+    }
+
+    bool Empty() const {
+      return high_priority_queue.Empty() && queue.Empty();
+    }
+    // time spent running tasks, only accumulated once busy time tracking is enabled
+    std::atomic<uint64_t> busy_ns{0};
+    // spin duration of the worker when adaptive_spinning_ is set
+    AdaptiveSpinPolicy spin_policy;
 
     // Each thread has a status, available read-only without locking, and protected
     // by the mutex field below for updates.  The status is used for three
@@ -1464,9 +1646,20 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   Environment& env_;
   const unsigned num_threads_;
   const bool allow_spinning_;
+  const bool adaptive_spinning_;
   const bool set_denormal_as_zero_;
   Eigen::MaxSizeVector<WorkerData> worker_data_;
   Eigen::MaxSizeVector<Eigen::MaxSizeVector<unsigned>> all_coprimes_;
+
+  // Workers on the same NUMA node, and the ones on other nodes, indexed by domain.  Empty when the
+  // workers are not grouped by NUMA node, see InitializeNumaDomains.
+  struct NumaDomain {
+    std::vector<unsigned> local_workers;
+    std::vector<unsigned> remote_workers;
+  };
+  std::vector<NumaDomain> numa_domains_;
+  std::vector<unsigned> worker_numa_domain_;
+
   std::atomic<unsigned> blocked_;  // Count of blocked workers, used as a termination condition
   std::atomic<bool> done_;
 
@@ -1482,6 +1675,9 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   // Default is no control over spinning
   std::atomic<SpinLoopStatus> spin_loop_status_{SpinLoopStatus::kBusy};
 
+  // Set by EnableBusyTimeTracking, the workers then time the tasks they run
+  std::atomic<bool> track_busy_time_{false};
+
   // Wake any blocked workers so that they can cleanly exit WorkerLoop().  For
   // a clean exit, each thread will observe (1) done_ set, indicating that the
   // destructor has been called, (2) all threads blocked, and (3) no
@@ -1497,7 +1693,6 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
   void WorkerLoop(int thread_id) {
     PerThread* pt = GetPerThread();
     WorkerData& td = worker_data_[thread_id];
-    Queue& q = td.queue;
     bool should_exit = false;
     pt->pool = this;
     pt->thread_id = thread_id;
@@ -1511,21 +1706,34 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     SetDenormalAsZero(set_denormal_as_zero_);
     profiler_.LogThreadId(thread_id);
 
+    // number of spin iterations between the checks of the adaptive spin deadline
+    constexpr int spin_deadline_check_interval = 64;
+
     while (!should_exit) {
-      Task t = q.PopFront();
+      Task t = td.PopFront();
       if (!t) {
+        const auto idle_start = adaptive_spinning_ ? std::chrono::steady_clock::now()
+                                                   : std::chrono::steady_clock::time_point{};
+        const auto spin_deadline = idle_start + td.spin_policy.GetSpinDuration();
+
         // Spin waiting for work.
         for (int i = 0; i < spin_count && !done_; i++) {
           if (((i + 1) % steal_count == 0)) {
             t = Steal(StealAttemptKind::TRY_ONE);
           } else {
-            t = q.PopFront();
+            t = td.PopFront();
           }
           if (t) break;
 
           if (spin_loop_status_.load(std::memory_order_relaxed) == SpinLoopStatus::kIdle) {
             break;
           }
+          if (adaptive_spinning_ && (i + 1) % spin_deadline_check_interval == 0 &&
+              std::chrono::steady_clock::now() >= spin_deadline) {
+            // an adaptive spin may end before the first steal attempt of the loop
+            t = Steal(StealAttemptKind::TRY_ONE);
+            break;
+          }
           onnxruntime::concurrency::SpinPause();
         }
 
@@ -1550,7 +1758,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
                 //
                 // If #A if after #2 then #B will see #1, and we abandon blocking
                 assert(!t);
-                t = q.PopFront();
+                t = td.PopFront();
                 if (t) {
                   should_block = false;
                 }
@@ -1590,14 +1798,28 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
           // Thread just unblocked.  Unless we picked up work while
           // blocking, or are exiting, then either work was pushed to
           // us, or it was pushed to an overloaded queue
-          if (!t) t = q.PopFront();
+          if (!t) t = td.PopFront();
           if (!t) t = Steal(StealAttemptKind::TRY_ALL);
         }
+
+        if (adaptive_spinning_ && t) {
+          td.spin_policy.OnIdleEnd(std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - idle_start));
+        }
       }
 
       if (t) {
         td.SetActive();
+        profiler_.LogRunStart(thread_id);
+        const bool track_busy_time = track_busy_time_.load(std::memory_order_relaxed);
+        const auto run_start = track_busy_time ? std::chrono::steady_clock::now()
+                                               : std::chrono::steady_clock::time_point{};
         t();
+        if (track_busy_time) {
+          const auto run_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - run_start);
+          td.busy_ns.fetch_add(static_cast<uint64_t>(run_ns.count()), std::memory_order_relaxed);
+        }
         profiler_.LogRun(thread_id);
         td.SetSpinning();
       }
@@ -1619,6 +1841,9 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
 
   Task Steal(StealAttemptKind steal_kind) {
     PerThread* pt = GetPerThread();
+    if (!numa_domains_.empty() && pt->pool == this) {
+      return StealNumaAware(pt, steal_kind);
+    }
     unsigned size = num_threads_;
     unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
     unsigned r = Rand(&pt->rand);
@@ -1628,7 +1853,47 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     for (unsigned i = 0; i < num_attempts; i++) {
       assert(victim < size);
       if (worker_data_[victim].GetStatus() == WorkerData::ThreadStatus::Active) {
-        Task t = worker_data_[victim].queue.PopBack();
+        Task t = worker_data_[victim].PopBack();
+        if (t) {
+          return t;
+        }
+      }
+      victim += inc;
+      if (victim >= size) {
+        victim -= size;
+      }
+    }
+
+    return Task();
+  }
+
+  // Steal from the workers on the same NUMA node first.  A single attempt (TRY_ONE) also tries one
+  // remote worker if the local one had no work, so that work queued on another node is not starved
+  // while all of the local workers are spinning.
+
+  Task StealNumaAware(PerThread* pt, StealAttemptKind steal_kind) {
+    const NumaDomain& domain = numa_domains_[worker_numa_domain_[pt->thread_id]];
+    Task t = StealFromWorkers(pt, domain.local_workers, steal_kind);
+    if (!t) {
+      t = StealFromWorkers(pt, domain.remote_workers, steal_kind);
+    }
+    return t;
+  }
+
+  Task StealFromWorkers(PerThread* pt, const std::vector<unsigned>& workers, StealAttemptKind steal_kind) {
+    const unsigned size = static_cast<unsigned>(workers.size());
+    if (size == 0) {
+      return Task();
+    }
+    unsigned num_attempts = (steal_kind == StealAttemptKind::TRY_ALL) ? size : 1;
+    unsigned r = Rand(&pt->rand);
+    unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
+    unsigned victim = r % size;
+
+    for (unsigned i = 0; i < num_attempts; i++) {
+      WorkerData& td = worker_data_[workers[victim]];
+      if (td.GetStatus() == WorkerData::ThreadStatus::Active) {
+        Task t = td.PopBack();
         if (t) {
           return t;
         }
@@ -1649,7 +1914,7 @@ class ThreadPoolTempl : public onnxruntime::concurrency::ExtendedThreadPoolInter
     unsigned inc = all_coprimes_[size - 1][r % all_coprimes_[size - 1].size()];
     unsigned victim = r % size;
     for (unsigned i = 0; i < size; i++) {
-      if (!worker_data_[victim].queue.Empty()) {
+      if (!worker_data_[victim].Empty()) {
         return victim;
       }
       victim += inc;
@@ -16,6 +16,7 @@ limitations under the License.
 /* Modifications Copyright (c) Microsoft. */
 
 #pragma once
+#include <chrono>
 #include <string>
 #include <vector>
 #include <functional>
@@ -130,11 +131,27 @@ struct TensorOpCost {
 
 namespace concurrency {
 
+// The run of a task on a worker thread of a pool, recorded while profiling.
+struct ThreadPoolWorkerRun {
+  unsigned int thread_id;  // id of the worker as returned by logging::GetThreadId()
+  TimePoint start;
+  TimePoint end;
+};
+
 template <typename Environment>
 class ThreadPoolTempl;
 
+// Priority of the work a thread schedules on the thread pools, e.g. of the Run calls it makes.  The workers prefer
+// the tasks of high priority work, and low priority work yields to high priority work in between its kernels.
+enum class ThreadPoolPriority : int8_t {
+  kLow = -1,
+  kNormal = 0,
+  kHigh = 1,
+};
+
 class ExtendedThreadPoolInterface;
 class LoopCounter;
+class ParallelForCostCalibration;
 class ThreadPoolParallelSection;
 
 class ThreadPool {
@@ -160,6 +177,18 @@ class ThreadPool {
              bool low_latency_hint,
              bool force_hybrid = false);
 
+  // Constructs a pool that hands its work to a scheduler of the host application
+  // instead of creating threads: schedule_fn(scheduler_param, work_fn, work_param)
+  // must run work_fn(work_param) once on some thread.  Parallel loops are split
+  // into up to "degree_of_parallelism" work items, and the calling thread runs
+  // the items that the scheduler has not started by the time it is done with its
+  // own, so a loop does not wait for the scheduler to have a free thread.
+  //
+  // REQUIRES: degree_of_parallelism > 0
+  ThreadPool(OrtCustomScheduleFn schedule_fn,
+             void* scheduler_param,
+             int degree_of_parallelism);
+
   // Waits until all scheduled work has finished and then destroy the
   // set of threads.
   ~ThreadPool();
@@ -222,6 +251,14 @@ class ThreadPool {
 
   void DisableSpinning();
 
+  // Starts accumulating the time that the worker threads spend running tasks, see GetAverageWorkerBusyTimeNs.
+  // Measuring the utilization of the pool this way costs two clock reads per task.
+  void EnableBusyTimeTracking();
+
+  // Time in nanoseconds that the worker threads spent running tasks since EnableBusyTimeTracking was called,
+  // averaged over the worker threads.  Returns 0 if the pool has no worker threads.
+  uint64_t GetAverageWorkerBusyTimeNs() const;
+
   // Schedules fn() for execution in the pool of threads.  The function may run
   // synchronously if it cannot be enqueued.  This will occur if the thread pool's
   // degree-of-parallelism is 1, but it may also occur for implementation-dependent
@@ -361,11 +398,35 @@ class ThreadPool {
   // working in combination with the thread initiating the loop.
   static int DegreeOfParallelism(const ThreadPool* tp);
 
+  // Sets the priority of the work the current thread schedules on the thread pools for the lifetime of the scope.
+  // The tasks that the thread pools run on behalf of the thread inherit the priority.
+  class PriorityScope {
+   public:
+    explicit PriorityScope(ThreadPoolPriority priority);
+    ~PriorityScope();
+
+   private:
+    const ThreadPoolPriority previous_;
+    const bool counted_;
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PriorityScope);
+  };
+
+  static ThreadPoolPriority GetCurrentThreadPriority();
+
+  // Pauses the current thread while high priority work is in progress if the thread runs low priority work,
+  // for at most max_wait so that the low priority work still makes progress.  Called in between kernels.
+  static void YieldToHighPriorityWork(std::chrono::microseconds max_wait = kMaxLowPriorityYield);
+
+  static constexpr std::chrono::microseconds kMaxLowPriorityYield{1000};
+
   ORT_DISALLOW_COPY_AND_ASSIGNMENT(ThreadPool);
 
-  // StartProfiling and StopProfiling are not to be consumed as public-facing API
-  static void StartProfiling(concurrency::ThreadPool* tp);
+  // StartProfiling, StopProfiling and TakeProfiledWorkerRuns are not to be consumed as public-facing API
+  // If record_worker_runs is true the runs of the tasks on the worker threads are recorded until they are taken
+  // with TakeProfiledWorkerRuns.
+  static void StartProfiling(concurrency::ThreadPool* tp, bool record_worker_runs = false);
   static std::string StopProfiling(concurrency::ThreadPool* tp);
+  static std::vector<ThreadPoolWorkerRun> TakeProfiledWorkerRuns(concurrency::ThreadPool* tp);
 
  private:
   friend class LoopCounter;
@@ -378,6 +439,14 @@ class ThreadPool {
   // thread in the pool. Returns -1 otherwise.
   int CurrentThreadId() const;
 
+  // Returns the number of NUMA domains the threads in the pool are grouped into, or 0 if they
+  // are not grouped.  The threads are grouped when their affinities span several NUMA nodes.
+  unsigned NumNumaDomains() const;
+
+  // Returns the NUMA domain of the current thread if it is a thread in the pool whose threads are
+  // grouped by NUMA domain.  Returns -1 otherwise.
+  int CurrentThreadNumaDomain() const;
+
   // Run fn with up to n degree-of-parallelism enlisting the thread pool for
   // help.  The degree-of-parallelism includes the caller, and so if n==1
   // then the function will run directly in the caller.  The fork-join
@@ -412,10 +481,12 @@ class ThreadPool {
 
   void Schedule(std::function<void()> fn);
 
-  void StartProfiling();
+  void StartProfiling(bool record_worker_runs);
 
   std::string StopProfiling();
 
+  std::vector<ThreadPoolWorkerRun> TakeProfiledWorkerRuns();
+
   ThreadOptions thread_options_;
 
   // If a thread pool is created with degree_of_parallelism != 1 then an underlying
@@ -427,6 +498,12 @@ class ThreadPool {
   // If used, underlying_threadpool_ is instantiated and owned by the ThreadPool.
   std::unique_ptr<ThreadPoolTempl<Env> > extended_eigen_threadpool_;
 
+  // Set instead of extended_eigen_threadpool_ if the work runs on a scheduler of the host application.
+  std::unique_ptr<ExtendedThreadPoolInterface> host_scheduler_threadpool_;
+
+  // Set if ThreadOptions::calibrate_parallel_for_cost is, measures the costs of the loops of ParallelFor.
+  std::unique_ptr<ParallelForCostCalibration> cost_calibration_;
+
   // Force the thread pool to run in hybrid mode on a normal cpu.
   bool force_hybrid_ = false;
 };
@@ -17,7 +17,7 @@ struct OrtCUDAProviderOptionsV2 {
   int device_id;                                           // cuda device id.
   int has_user_compute_stream;                             // indicator of user specified CUDA compute stream.
   void* user_compute_stream;                               // user specified CUDA compute stream.
-  int do_copy_in_default_stream;                           // flag specifying if the default stream is to be used for copying.
+  int do_copy_in_default_stream;                           // flag specifying if the default stream is to be used for copying, otherwise dedicated copy streams are used.
   OrtCudnnConvAlgoSearch cudnn_conv_algo_search;           // cudnn algo search enum.
   size_t gpu_mem_limit;                                    // BFC Arena memory limit for CUDA.
                                                            // (will be overridden by contents of `default_memory_arena_cfg` is it exists)
@@ -28,4 +28,11 @@ struct OrtCUDAProviderOptionsV2 {
   int enable_cuda_graph;                                   // flag specifying if the CUDA graph is to be captured for the model.
   int cudnn_conv1d_pad_to_nc1d;                            // flag specifying if pad Conv1D's input [N,C,D] to [N,C,1,D] or [N,C,D,1].
   int tunable_op_enabled;                                  // flag specifying if TunableOp is enabled.
+  int max_cuda_graphs;                                     // maximum number of CUDA graphs kept per thread.
+  int use_cuda_mem_pool;                                   // flag specifying if the device memory is allocated from the CUDA memory pool instead of an arena.
+  size_t cuda_mem_pool_release_threshold;                  // bytes of unused memory kept by the CUDA memory pool when a stream synchronizes.
+  const char* tunable_op_tuning_results_file;              // file the TunableOp tuning results are loaded from and saved to.
+  const char* cudnn_conv_algo_cache_file;                  // file the cuDNN conv algo search results are loaded from and saved to.
+  int prefer_nhwc;                                         // flag specifying if the convolutional layers run in the NHWC layout.
+  int max_compute_streams;                                 // maximum number of streams independent graph branches run on.
 };
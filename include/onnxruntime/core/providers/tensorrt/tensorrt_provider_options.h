@@ -31,4 +31,7 @@ struct OrtTensorRTProviderOptionsV2 {
   int trt_force_sequential_engine_build;        // force building TensorRT engine sequentially. Default 0 = false, nonzero = true
   int trt_context_memory_sharing_enable;        // enable context memory sharing between subgraphs. Default 0 = false, nonzero = true
   int trt_layer_norm_fp32_fallback;             // force Pow + Reduce ops in layer norm to FP32. Default 0 = false, nonzero = true
+  int trt_engine_build_thread_count;            // number of threads building engines of subgraphs concurrently. Default 1, 0 = number of cores
+  int trt_engine_build_in_background;           // return from session creation before the engines are built. Default 0 = false, nonzero = true
+  int trt_max_optimization_profiles;            // maximum number of optimization profiles learned from observed input shapes. Default 0 = disabled
 };
@@ -10,6 +10,7 @@
 #include "core/platform/threadpool.h"
 #include "core/common/logging/logging.h"
 #include "core/framework/allocator.h"
+#include "core/framework/shared_initializer_store.h"
 
 struct OrtThreadingOptions;
 namespace onnxruntime {
@@ -63,6 +64,8 @@ class Environment {
 
   /**
    * Creates and registers an allocator for sharing between multiple sessions.
+   * CPU, CUDA and CUDA pinned memory are supported. The CUDA allocators are created through the CUDA EP and are
+   * used by it in sessions that enable kOrtSessionOptionsConfigUseEnvAllocators.
    * Return an error if an allocator with the same OrtMemoryInfo is already registered.
    */
   Status CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, const OrtArenaCfg* arena_cfg = nullptr);
@@ -79,6 +82,14 @@ class Environment {
    */
   Status UnregisterAllocator(const OrtMemoryInfo& mem_info);
 
+  /**
+   * Returns the store that deduplicates the initializers of the sessions using it across this env.
+   * See kOrtSessionOptionsConfigUseEnvInitializerStore.
+   */
+  SharedInitializerStore& GetSharedInitializerStore() const {
+    return *shared_initializer_store_;
+  }
+
   Environment() = default;
 
  private:
@@ -92,5 +103,6 @@ class Environment {
   std::unique_ptr<onnxruntime::concurrency::ThreadPool> inter_op_thread_pool_;
   bool create_global_thread_pools_{false};
   std::vector<AllocatorPtr> shared_allocators_;
+  std::unique_ptr<SharedInitializerStore> shared_initializer_store_ = std::make_unique<SharedInitializerStore>();
 };
 }  // namespace onnxruntime
@@ -623,6 +623,26 @@ typedef OrtCustomThreadHandle (*OrtCustomCreateThreadFn)(void* ort_custom_thread
 */
 typedef void (*OrtCustomJoinThreadFn)(OrtCustomThreadHandle ort_custom_thread_handle);
 
+/** \brief Custom scheduling function
+*
+* Runs ort_work_fn(ort_work_param) once on a thread of a scheduler of the host application, e.g. by pushing it to
+* the queue of a work-stealing scheduler. The function may return before or after the work is run, and the work may
+* run at any later time. The work never blocks waiting for other work of onnxruntime.
+* Argument ort_custom_scheduler_param is the value given together with the function.
+*/
+typedef void (*OrtCustomScheduleFn)(void* ort_custom_scheduler_param, OrtThreadWorkerFn ort_work_fn,
+                                    void* ort_work_param);
+
+/** \brief Callback function for OrtApi::RunAsync
+*
+* \param[in] user_data The user_data passed to OrtApi::RunAsync
+* \param[in] outputs The outputs array passed to OrtApi::RunAsync. On success the ::OrtValue%s it holds are owned by
+*     the user and must be freed with OrtApi::ReleaseValue. On failure it is left unchanged.
+* \param[in] num_outputs Number of elements in `outputs`, 0 on failure
+* \param[in] status nullptr on success, otherwise the error of the run. Must be freed with OrtApi::ReleaseStatus
+*/
+typedef void (*RunAsyncCallbackFn)(void* user_data, OrtValue** outputs, size_t num_outputs, OrtStatusPtr status);
+
 /** \brief The C API
 *
 * All C API functions are defined inside this structure as pointers to functions.
@@ -2325,6 +2345,10 @@ struct OrtApi {
   * Lifetime of the created allocator will be valid for the duration of the environment.
   * Returns an error if an allocator with the same ::OrtMemoryInfo is already registered.
   *
+  * CPU memory info as well as "Cuda" (OrtMemTypeDefault) and "CudaPinned" (OrtMemTypeCPUOutput) memory info are
+  * supported, the latter two in builds with the CUDA execution provider. The shared CUDA arena is stream aware and
+  * memory freed by one session can be reused by another, so the sessions using the env allocators share one peak.
+  *
   * See https://onnxruntime.ai/docs/reference/api/c-api.html for details.
   *
   * \param[in] env ::OrtEnv instance
@@ -2667,6 +2691,18 @@ struct OrtApi {
   *  Only relevant if arena strategy is `kNextPowerOfTwo`. Use -1 to allow ORT to choose the default.
   *  Ultimately, the allocation size is determined by the allocation memory request.
   *  Further allocation sizes are governed by the arena extend strategy.
+  * "thread_cache_max_chunk_bytes": Allocations of up to this many bytes are served from a cache owned by the
+  *  allocating thread, which moves chunks from and to the arena in batches. This reduces the contention on the
+  *  arena when many threads allocate concurrently, at the cost of the memory held by the caches.
+  *  At most 1 MB. Use 0 to disable the cache, or -1 to allow ORT to choose the default. Default is disabled.
+  * "shrink_idle_ms": A background thread of the arena frees the regions of the arena in which no chunk is in use,
+  *  as OrtApi::AddRunConfigEntry with "memory.enable_memory_arena_shrinkage" does, once the arena has seen no
+  *  allocation or free for this many milliseconds. Use 0 to disable. Default is 0.
+  * "shrink_low_usage_percent", "shrink_window_ms": The background thread also frees these regions at the end of
+  *  each window of "shrink_window_ms" milliseconds in which the peak of the bytes in use stayed below
+  *  "shrink_low_usage_percent" of the bytes allocated by the arena. Use 0 to disable. Default is 0.
+  * "shrink_retain_bytes": The background thread keeps the regions the arena needs to hold at least this many
+  *  bytes. Default is 0.
   *
   * \param[in] arena_config_keys Keys to configure the arena
   * \param[in] arena_config_values Values to configure the arena
@@ -3635,6 +3671,236 @@ struct OrtApi {
   */
   ORT_API2_STATUS(SetGlobalIntraOpThreadAffinity, _Inout_ OrtThreadingOptions* tp_options, const char* affinity_string);
 
+  /** \brief Run the model in an ::OrtSession asynchronously
+  *
+  * Schedules the run on the inter-op thread pool of the session, or on the intra-op thread pool if the session
+  * has no inter-op thread pool, and returns without waiting for the run to complete. `run_async_callback` is
+  * invoked on a thread pool thread once the run has completed. The session must have at least 2 threads in one of
+  * these thread pools. Releasing the session waits for the outstanding runs, but it must not be done from
+  * `run_async_callback`.
+  *
+  * \param[in] session
+  * \param[in] run_options If nullptr, will use a default ::OrtRunOptions. Otherwise it must remain valid until
+  *     `run_async_callback` is invoked.
+  * \param[in] input_names Array of null terminated UTF8 encoded strings of the input names
+  * \param[in] input Array of ::OrtValue%s of the input values
+  * \param[in] input_len Number of elements in the input_names and inputs arrays
+  * \param[in] output_names Array of null terminated UTF8 encoded strings of the output names
+  * \param[in] output_names_len Number of elements in the output_names and outputs array
+  * \param[out] output Array of ::OrtValue%s that the outputs are stored in, see OrtApi::Run. It must remain
+  *     valid until `run_async_callback` is invoked, and is passed back to it.
+  * \param[in] run_async_callback Callback invoked with the outputs and the status of the run
+  * \param[in] user_data Passed back to `run_async_callback`
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.14.
+  */
+  ORT_API2_STATUS(RunAsync, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                  _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                  _Inout_updates_all_(output_names_len) OrtValue** output,
+                  _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+
+  /** \brief Get the usage of the memory arenas and of the intra-op thread pool of an ::OrtSession
+  *
+  * Returns the usage since the previous call and starts a new interval, so calling it after each run of a session
+  * whose runs don't overlap gives per-run values. The first call starts measuring the thread pool utilization and
+  * returns 0 for it.
+  *
+  * \param[in] session
+  * \param[out] arena_peak_bytes_in_use Sum over the memory arenas of the session of their highest number of bytes
+  *     in use during the interval
+  * \param[out] intra_op_thread_pool_utilization Fraction of the interval that the worker threads of the intra-op
+  *     thread pool spent running tasks, from 0 to 1
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.14.
+  */
+  ORT_API2_STATUS(SessionGetResourceStats, _Inout_ OrtSession* session, _Out_ size_t* arena_peak_bytes_in_use,
+                  _Out_ double* intra_op_thread_pool_utilization);
+
+  /** \brief Run the intra-op and inter-op work of a session on a scheduler of the host application
+  *
+  * Instead of creating threads, the intra-op and inter-op thread pools of the session hand their work to
+  * ort_custom_schedule_fn. A parallel loop is split into up to the number of threads of the pool, see
+  * OrtApi::SetIntraOpNumThreads and OrtApi::SetInterOpNumThreads, and the calling thread takes part in it, so a loop
+  * completes even if the scheduler runs none of the work it was given before the loop ends.
+  * The thread creation functions, spinning, thread affinities and denormal as zero settings don't apply to these
+  * pools.
+  *
+  * \param[in] options Session options
+  * \param[in] ort_custom_schedule_fn Custom scheduling function, nullptr to go back to the threads of onnxruntime
+  * \param[in] ort_custom_scheduler_param Passed to each call of ort_custom_schedule_fn (can be nullptr)
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.14.
+  */
+  ORT_API2_STATUS(SessionOptionsSetCustomScheduler, _Inout_ OrtSessionOptions* options,
+                  _In_opt_ OrtCustomScheduleFn ort_custom_schedule_fn, _In_opt_ void* ort_custom_scheduler_param);
+
+  /** \brief Run the work of the global thread pools on a scheduler of the host application
+  *
+  * The global thread pools counterpart of OrtApi::SessionOptionsSetCustomScheduler.
+  *
+  * \param[inout] tp_options
+  * \param[in] ort_custom_schedule_fn Custom scheduling function, nullptr to go back to the threads of onnxruntime
+  * \param[in] ort_custom_scheduler_param Passed to each call of ort_custom_schedule_fn (can be nullptr)
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.14.
+  */
+  ORT_API2_STATUS(SetGlobalCustomScheduler, _Inout_ OrtThreadingOptions* tp_options,
+                  _In_opt_ OrtCustomScheduleFn ort_custom_schedule_fn, _In_opt_ void* ort_custom_scheduler_param);
+
+  /** \brief Predict the memory a run of an ::OrtSession needs for the given input shapes, without running it
+  *
+  * The initializers are counted in the memory of the device they were placed on, and the tensors that a run allocates
+  * are laid out as the memory pattern of a sequential run would be. The shapes of these tensors are inferred from
+  * the input shapes when the model was loaded, the tensors whose shapes depend on the values of the inputs, and the
+  * tensors of the subgraphs of control flow nodes, are not counted.
+  *
+  * The prediction is returned as a JSON object such as
+  * `{"locations": [{"name": "Cpu", "device_id": 0, "mem_type": 0, "initializer_bytes": 1024,
+  * "peak_activation_bytes": 4096}], "num_unresolved_tensors": 0}`
+  *
+  * \param[in] session
+  * \param[in] input_names Names of the inputs of the model
+  * \param[in] input_shapes Dims of each input
+  * \param[in] input_shape_lens Number of dims of each input
+  * \param[in] input_len Number of inputs
+  * \param[in] allocator Allocator used to allocate the returned string
+  * \param[out] prediction The prediction as a null terminated JSON string
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.14.
+  */
+  ORT_API2_STATUS(SessionPredictMemoryUsage, _In_ const OrtSession* session,
+                  _In_reads_(input_len) const char* const* input_names,
+                  _In_reads_(input_len) const int64_t* const* input_shapes,
+                  _In_reads_(input_len) const size_t* input_shape_lens, size_t input_len,
+                  _Inout_ OrtAllocator* allocator, _Outptr_ char** prediction);
+
+  /** \brief Get how the memory of an arena allocator is split into free chunks, to diagnose fragmentation
+  *
+  * The free chunks of the arena are grouped into bins of sizes from `bin_size` to twice `bin_size`, the last bin
+  * holds all the larger chunks. The sizes of the allocations are counted in the same bins over a window that starts
+  * at the previous call with `reset_window` set to 1, or at the creation of the arena. The allocations served from
+  * the per thread caches of the arena are not counted.
+  *
+  * The stats are returned as a JSON object such as
+  * `{"num_regions": 1, "region_bytes": 1048576, "bytes_in_use": 4096, "free_bytes": 1044480,
+  * "largest_free_chunk_bytes": 1044480, "window_num_allocs": 2,
+  * "bins": [{"bin_size": 256, "num_free_chunks": 0, "free_bytes": 0, "num_allocs": 0}, ...]}`
+  *
+  * \param[in] allocator An ::OrtAllocator of onnxruntime whose ::OrtMemoryInfo has the ::OrtArenaAllocator type,
+  *     e.g. one created by OrtApi::CreateAllocator for the CPU or the CUDA memory of a session
+  * \param[in] reset_window 1 to start a new window of allocations after getting the stats, 0 otherwise
+  * \param[in] string_allocator Allocator used to allocate the returned string
+  * \param[out] stats The stats as a null terminated JSON string
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.14.
+  */
+  ORT_API2_STATUS(AllocatorGetArenaStats, _In_ const OrtAllocator* allocator, _In_ int reset_window,
+                  _Inout_ OrtAllocator* string_allocator, _Outptr_ char** stats);
+
+  /** \brief Warm an ::OrtSession up before serving requests
+  *
+  * Runs the session on inputs of zeros with each of the given sets of input shapes, e.g. one per shape bucket of the
+  * requests. The runs extend the memory arenas to what these shapes need, tune the kernels and fill the caches of
+  * the execution providers such as the cuDNN algorithms and the memory patterns, initialize the lazily initialized
+  * kernels, and touch the pages of the weights, so that the first requests don't pay for it.
+  *
+  * The stats are returned as a JSON object such as
+  * `{"shape_sets": [{"first_run_ms": 812.5, "last_run_ms": 9.1}], "arena_allocated_bytes": 67108864,
+  * "arena_num_extensions": 3}`
+  *
+  * \param[in] session
+  * \param[in] run_options If nullptr, will use a default ::OrtRunOptions
+  * \param[in] input_names Names of the inputs of the model, all the required inputs must be given
+  * \param[in] input_len Number of inputs
+  * \param[in] input_shapes Dims of each input for each shape set, the shapes of the first set come first
+  * \param[in] input_shape_lens Number of dims of each input for each shape set
+  * \param[in] num_shape_sets Number of shape sets, `input_shapes` and `input_shape_lens` have
+  *     `num_shape_sets * input_len` elements
+  * \param[in] num_runs_per_shape_set Number of runs with each shape set, at least 1
+  * \param[in] allocator Allocator used to allocate the returned string
+  * \param[out] stats The stats as a null terminated JSON string
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.14.
+  */
+  ORT_API2_STATUS(SessionWarmup, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                  _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                  _In_reads_(num_shape_sets* input_len) const int64_t* const* input_shapes,
+                  _In_reads_(num_shape_sets* input_len) const size_t* input_shape_lens, size_t num_shape_sets,
+                  size_t num_runs_per_shape_set, _Inout_ OrtAllocator* allocator, _Outptr_ char** stats);
+
+  /** \brief Create an ::OrtSession that shares the initialized state of another one
+  *
+  * The clone shares the optimized graph, the kernels, the initializers and pre-packed weights and the execution
+  * providers with their allocators of the session, so creating it costs little time and memory compared to loading
+  * the model again. The clone runs on the thread pools of its own session options, e.g. to run the model for a
+  * tenant with a thread pool of its own. The options the graph was prepared with, like the graph optimization level,
+  * the execution mode and the execution providers, are the ones of the session.
+  *
+  * The session must outlive the clone, and must be released after it.
+  *
+  * \param[in] session An initialized session, which can't be one that captures graphs or enables profiling of
+  *     the clone.
+  * \param[in] options Options of the clone, the thread pool and logging ones are used. If nullptr, the default
+  *     ::OrtSessionOptions are used.
+  * \param[out] out Returned newly created ::OrtSession. Must be freed with OrtApi::ReleaseSession
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \since Version 1.14.
+  */
+  ORT_API2_STATUS(CloneSession, _In_ const OrtSession* session, _In_opt_ const OrtSessionOptions* options,
+                  _Outptr_ OrtSession** out);
+
+  /** \brief Used for custom operators, get all the inputs of a kernel in one call
+  *
+  * \param[in] context
+  * \param[out] values Returns the inputs, with nullptr for the missing optional inputs
+  * \param[in] num_values Number of values, which must be the input count of the kernel
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \see ::OrtCustomOp
+  *
+  * \since Version 1.14.
+  */
+  ORT_API2_STATUS(KernelContext_GetInputs, _In_ const OrtKernelContext* context,
+                  _Out_writes_all_(num_values) const OrtValue** values, size_t num_values);
+
+  /** \brief Used for custom operators, allocate all the outputs of a kernel in one call
+  *
+  * \param[in] context
+  * \param[in] dim_values Shape of each output
+  * \param[in] dim_counts Rank of each output
+  * \param[in] num_values Number of values, which must be the output count of the kernel
+  * \param[out] values Returns the outputs, with nullptr for the outputs that are not used
+  *
+  * \snippet{doc} snippets.dox OrtStatus Return Value
+  *
+  * \see ::OrtCustomOp
+  *
+  * \since Version 1.14.
+  */
+  ORT_API2_STATUS(KernelContext_GetOutputs, _Inout_ OrtKernelContext* context,
+                  _In_reads_(num_values) const int64_t* const* dim_values,
+                  _In_reads_(num_values) const size_t* dim_counts, size_t num_values,
+                  _Out_writes_all_(num_values) OrtValue** values);
+
 #ifdef __cplusplus
   OrtApi(const OrtApi&)=delete; // Prevent users from accidentally copying the API structure, it should always be passed as a pointer
 #endif
@@ -3716,6 +3982,32 @@ struct OrtCustomOp {
   // and false (zero) otherwise.
   // Applicable only for custom ops that have a variadic output.
   int(ORT_API_CALL* GetVariadicOutputHomogeneity)(_In_ const struct OrtCustomOp* op);
+
+  // The callbacks below were added in version 14 and may be nullptr, in which case the kernel does not pre-pack its
+  // inputs and its outputs are allocated on their own.
+
+  // Pre-packs the constant input input_index of the kernel, e.g. to the layout its compute function uses, once
+  // when the session is initialized. The kernel allocates the packed buffer with allocator and returns it in
+  // packed_buffer along with its size, or returns nullptr in packed_buffer to keep the input as is.
+  // ORT owns the packed buffer: it may be shared with the kernels of other sessions through a
+  // ::OrtPrepackedWeightsContainer, and is handed to the kernel with KernelUsePrePackedBuffer.
+  OrtStatusPtr(ORT_API_CALL* KernelPrePack)(_In_ void* op_kernel, _In_ const OrtValue* input, int input_index,
+                                            _Inout_ OrtAllocator* allocator,
+                                            _Outptr_result_maybenull_ void** packed_buffer,
+                                            _Out_ size_t* packed_buffer_size);
+
+  // Hands the packed buffer of input input_index to the kernel, which can use it in KernelCompute until it is
+  // destroyed. The buffer must not be modified, as it may be shared with other kernels.
+  OrtStatusPtr(ORT_API_CALL* KernelUsePrePackedBuffer)(_In_ void* op_kernel, int input_index,
+                                                       _In_ const void* packed_buffer, size_t packed_buffer_size);
+
+  // Returns the index of the input whose buffer the output output_index may reuse if it is not used after the
+  // node, or -1. The output must have the type and the size of the input.
+  int(ORT_API_CALL* GetMayInplaceInput)(_In_ const struct OrtCustomOp* op, _In_ size_t output_index);
+
+  // Returns the index of the input the output output_index always shares its buffer with, or -1. The kernel
+  // must then return the input as the output, e.g. for an op that only changes the shape of its input.
+  int(ORT_API_CALL* GetAliasInput)(_In_ const struct OrtCustomOp* op, _In_ size_t output_index);
 };
 
 /*
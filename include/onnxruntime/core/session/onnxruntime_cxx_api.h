@@ -478,6 +478,8 @@ struct SessionOptionsImpl : Base<T> {
   SessionOptionsImpl& SetCustomCreateThreadFn(OrtCustomCreateThreadFn ort_custom_create_thread_fn);  ///< Wraps OrtApi::SessionOptionsSetCustomCreateThreadFn
   SessionOptionsImpl& SetCustomThreadCreationOptions(void* ort_custom_thread_creation_options);      ///< Wraps OrtApi::SessionOptionsSetCustomThreadCreationOptions
   SessionOptionsImpl& SetCustomJoinThreadFn(OrtCustomJoinThreadFn ort_custom_join_thread_fn);        ///< Wraps OrtApi::SessionOptionsSetCustomJoinThreadFn
+  SessionOptionsImpl& SetCustomScheduler(OrtCustomScheduleFn ort_custom_schedule_fn,
+                                         void* ort_custom_scheduler_param);  ///< Wraps OrtApi::SessionOptionsSetCustomScheduler
 };
 }  // namespace detail
 
@@ -611,6 +613,19 @@ struct ConstSessionImpl : Base<T> {
   TypeInfo GetInputTypeInfo(size_t index) const;                   ///< Wraps OrtApi::SessionGetInputTypeInfo
   TypeInfo GetOutputTypeInfo(size_t index) const;                  ///< Wraps OrtApi::SessionGetOutputTypeInfo
   TypeInfo GetOverridableInitializerTypeInfo(size_t index) const;  ///< Wraps OrtApi::SessionGetOverridableInitializerTypeInfo
+
+  /** \brief Predict the memory a run needs for the given input shapes, without running the session
+   *
+   * Wraps OrtApi::SessionPredictMemoryUsage
+   *
+   * \param input_names Names of the inputs of the model
+   * \param input_shapes Shape of each input
+   * \param allocator to allocate memory for the returned JSON string
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   */
+  AllocatedStringPtr PredictMemoryUsageAllocated(const std::vector<const char*>& input_names,
+                                                 const std::vector<std::vector<int64_t>>& input_shapes,
+                                                 OrtAllocator* allocator) const;
 };
 
 template <typename T>
@@ -646,6 +661,24 @@ struct SessionImpl : ConstSessionImpl<T> {
 
   void Run(const RunOptions& run_options, const IoBinding&);  ///< Wraps OrtApi::RunWithBinding
 
+  /** \brief Run the model asynchronously in a thread owned by the session's thread pools
+   *
+   * Wraps OrtApi::RunAsync
+   *
+   * \param[in] run_options Must remain valid until callback is invoked
+   * \param[in] input_names Array of null terminated strings of length input_count that is the list of input names
+   * \param[in] input_values Array of Value objects of length input_count that is the list of input values
+   * \param[in] input_count Number of inputs (the size of the input_names & input_values arrays)
+   * \param[in] output_names Array of C style strings of length output_count that is the list of output names
+   * \param[out] output_values Array of Value objects of length output_count, filled in as in Run. Must remain
+   *     valid until callback is invoked
+   * \param[in] output_count Number of outputs (the size of the output_names & output_values arrays)
+   * \param[in] callback Invoked with the outputs and the status of the run, see ::RunAsyncCallbackFn
+   * \param[in] user_data Passed back to callback
+   */
+  void RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                const char* const* output_names, Value* output_values, size_t output_count, RunAsyncCallbackFn callback, void* user_data);
+
   /** \brief End profiling and return a copy of the profiling file name.
    *
    * \param allocator to allocate memory for the copy of the string returned
@@ -653,6 +686,30 @@ struct SessionImpl : ConstSessionImpl<T> {
    *  The OrtAllocator instances must be valid at the point of memory release.
    */
   AllocatedStringPtr EndProfilingAllocated(OrtAllocator* allocator);  ///< Wraps OrtApi::SessionEndProfiling
+
+  /** \brief Get the usage of the memory arenas and of the intra-op thread pool since the previous call
+   *
+   * Wraps OrtApi::SessionGetResourceStats
+   *
+   * \param[out] arena_peak_bytes_in_use Sum of the highest number of bytes in use of the memory arenas
+   * \param[out] intra_op_thread_pool_utilization Fraction of the time the intra-op worker threads ran tasks
+   */
+  void GetResourceStats(size_t& arena_peak_bytes_in_use, double& intra_op_thread_pool_utilization);
+
+  /** \brief Warm the session up by running it on inputs of zeros with each set of input shapes
+   *
+   * Wraps OrtApi::SessionWarmup
+   *
+   * \param run_options
+   * \param input_names Names of the inputs of the model
+   * \param shape_sets Shape of each input, for each shape set
+   * \param num_runs_per_shape_set Number of runs with each shape set
+   * \param allocator to allocate memory for the returned JSON string
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   */
+  AllocatedStringPtr WarmupAllocated(const RunOptions& run_options, const std::vector<const char*>& input_names,
+                                     const std::vector<std::vector<std::vector<int64_t>>>& shape_sets,
+                                     size_t num_runs_per_shape_set, OrtAllocator* allocator);
 };
 
 }  // namespace detail
@@ -671,6 +728,7 @@ struct Session : detail::SessionImpl<OrtSession> {
   Session(const Env& env, const void* model_data, size_t model_data_length, const SessionOptions& options);  ///< Wraps OrtApi::CreateSessionFromArray
   Session(const Env& env, const void* model_data, size_t model_data_length, const SessionOptions& options,
           OrtPrepackedWeightsContainer* prepacked_weights_container);  ///< Wraps OrtApi::CreateSessionFromArrayWithPrepackedWeightsContainer
+  Session(const Session& session, const SessionOptions& options);  ///< Wraps OrtApi::CloneSession, session must outlive the clone
 
   ConstSession GetConst() const { return ConstSession{this->p_}; }
   UnownedSession GetUnowned() const { return UnownedSession{this->p_}; }
@@ -1260,6 +1318,16 @@ struct AllocatorImpl : Base<T> {
   MemoryAllocation GetAllocation(size_t size);
   void Free(void* p);
   ConstMemoryInfo GetInfo() const;
+
+  /** \brief Get how the memory of an arena allocator is split into free chunks
+   *
+   * Wraps OrtApi::AllocatorGetArenaStats
+   *
+   * \param reset_window true to start a new window of allocations after getting the stats
+   * \param string_allocator to allocate memory for the returned JSON string
+   * \return a instance of smart pointer that would deallocate the buffer when out of scope.
+   */
+  AllocatedStringPtr GetArenaStatsAllocated(bool reset_window, OrtAllocator* string_allocator) const;
 };
 
 }  // namespace detail
@@ -1370,6 +1438,8 @@ struct KernelContext {
   ConstValue GetInput(size_t index) const;
   UnownedValue GetOutput(size_t index, const int64_t* dim_values, size_t dim_count) const;
   UnownedValue GetOutput(size_t index, const std::vector<int64_t>& dims) const;
+  std::vector<ConstValue> GetInputs() const;                                              ///< Wraps OrtApi::KernelContext_GetInputs
+  std::vector<UnownedValue> GetOutputs(const std::vector<std::vector<int64_t>>& dims) const;  ///< Wraps OrtApi::KernelContext_GetOutputs
   void* GetGPUComputeStream() const;
 
  private:
@@ -1673,6 +1743,12 @@ struct CustomOpBase : OrtCustomOp {
     OrtCustomOp::GetVariadicInputHomogeneity = [](const OrtCustomOp* this_) { return static_cast<int>(static_cast<const TOp*>(this_)->GetVariadicInputHomogeneity()); };
     OrtCustomOp::GetVariadicOutputMinArity = [](const OrtCustomOp* this_) { return static_cast<const TOp*>(this_)->GetVariadicOutputMinArity(); };
     OrtCustomOp::GetVariadicOutputHomogeneity = [](const OrtCustomOp* this_) { return static_cast<int>(static_cast<const TOp*>(this_)->GetVariadicOutputHomogeneity()); };
+
+    // The kernels of the op don't pre-pack their inputs unless the op calls EnablePrePacking()
+    OrtCustomOp::KernelPrePack = nullptr;
+    OrtCustomOp::KernelUsePrePackedBuffer = nullptr;
+    OrtCustomOp::GetMayInplaceInput = [](const OrtCustomOp* this_, size_t index) { return static_cast<const TOp*>(this_)->GetMayInplaceInput(index); };
+    OrtCustomOp::GetAliasInput = [](const OrtCustomOp* this_, size_t index) { return static_cast<const TOp*>(this_)->GetAliasInput(index); };
   }
 
   // Default implementation of GetExecutionProviderType that returns nullptr to default to the CPU provider
@@ -1716,6 +1792,37 @@ struct CustomOpBase : OrtCustomOp {
   bool GetVariadicOutputHomogeneity() const {
     return true;
   }
+
+  // Default implementations of GetMayInplaceInput() and GetAliasInput() return -1 to specify that the outputs
+  // are allocated on their own.
+  int GetMayInplaceInput(size_t /*output_index*/) const {
+    return -1;
+  }
+
+  int GetAliasInput(size_t /*output_index*/) const {
+    return -1;
+  }
+
+ protected:
+  // Lets the kernels of the op pre-pack their constant inputs, see OrtCustomOp::KernelPrePack. TKernel must have
+  //   Ort::Status PrePack(ConstValue input, int input_index, OrtAllocator* allocator,
+  //                       void*& packed_buffer, size_t& packed_buffer_size);
+  //   Ort::Status UsePrePackedBuffer(int input_index, const void* packed_buffer, size_t packed_buffer_size);
+  // which return Status{nullptr} on success.
+  void EnablePrePacking() {
+    OrtCustomOp::KernelPrePack = [](void* op_kernel, const OrtValue* input, int input_index, OrtAllocator* allocator,
+                                    void** packed_buffer, size_t* packed_buffer_size) {
+      *packed_buffer = nullptr;
+      *packed_buffer_size = 0;
+      return static_cast<TKernel*>(op_kernel)->PrePack(ConstValue{input}, input_index, allocator, *packed_buffer,
+                                                        *packed_buffer_size).release();
+    };
+    OrtCustomOp::KernelUsePrePackedBuffer = [](void* op_kernel, int input_index, const void* packed_buffer,
+                                               size_t packed_buffer_size) {
+      return static_cast<TKernel*>(op_kernel)->UsePrePackedBuffer(input_index, packed_buffer, packed_buffer_size)
+          .release();
+    };
+  }
 };
 
 }  // namespace Ort
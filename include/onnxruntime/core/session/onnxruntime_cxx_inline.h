@@ -171,6 +171,14 @@ inline ConstMemoryInfo AllocatorImpl<T>::GetInfo() const {
   return ConstMemoryInfo{out};
 }
 
+template <typename T>
+inline AllocatedStringPtr AllocatorImpl<T>::GetArenaStatsAllocated(bool reset_window,
+                                                                   OrtAllocator* string_allocator) const {
+  char* out = nullptr;
+  ThrowOnError(GetApi().AllocatorGetArenaStats(this->p_, reset_window ? 1 : 0, string_allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(string_allocator));
+}
+
 }  // namespace detail
 
 inline AllocatorWithDefaultOptions::AllocatorWithDefaultOptions() {
@@ -703,6 +711,13 @@ inline SessionOptionsImpl<T>& SessionOptionsImpl<T>::SetCustomJoinThreadFn(OrtCu
   return *this;
 }
 
+template <typename T>
+inline SessionOptionsImpl<T>& SessionOptionsImpl<T>::SetCustomScheduler(OrtCustomScheduleFn ort_custom_schedule_fn,
+                                                                         void* ort_custom_scheduler_param) {
+  ThrowOnError(GetApi().SessionOptionsSetCustomScheduler(this->p_, ort_custom_schedule_fn, ort_custom_scheduler_param));
+  return *this;
+}
+
 template <typename T>
 inline SessionOptionsImpl<T>& SessionOptionsImpl<T>::AppendExecutionProvider_OpenVINO(const OrtOpenVINOProviderOptions& provider_options) {
   ThrowOnError(GetApi().SessionOptionsAppendExecutionProvider_OpenVINO(this->p_, &provider_options));
@@ -787,6 +802,26 @@ inline TypeInfo ConstSessionImpl<T>::GetOverridableInitializerTypeInfo(size_t in
   return TypeInfo{out};
 }
 
+template <typename T>
+inline AllocatedStringPtr ConstSessionImpl<T>::PredictMemoryUsageAllocated(
+    const std::vector<const char*>& input_names, const std::vector<std::vector<int64_t>>& input_shapes,
+    OrtAllocator* allocator) const {
+  if (input_names.size() != input_shapes.size()) {
+    ORT_CXX_API_THROW("Expecting a shape for each input name", ORT_INVALID_ARGUMENT);
+  }
+
+  std::vector<const int64_t*> shapes;
+  std::vector<size_t> shape_lens;
+  for (const auto& shape : input_shapes) {
+    shapes.push_back(shape.data());
+    shape_lens.push_back(shape.size());
+  }
+  char* out = nullptr;
+  ThrowOnError(GetApi().SessionPredictMemoryUsage(this->p_, input_names.data(), shapes.data(), shape_lens.data(),
+                                                  input_names.size(), allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
 template <typename T>
 inline std::vector<Value> SessionImpl<T>::Run(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
                                               const char* const* output_names, size_t output_count) {
@@ -812,6 +847,15 @@ inline void SessionImpl<T>::Run(const RunOptions& run_options, const IoBinding&
   ThrowOnError(GetApi().RunWithBinding(this->p_, run_options, io_binding));
 }
 
+template <typename T>
+inline void SessionImpl<T>::RunAsync(const RunOptions& run_options, const char* const* input_names, const Value* input_values, size_t input_count,
+                                     const char* const* output_names, Value* output_values, size_t output_count, RunAsyncCallbackFn callback, void* user_data) {
+  auto ort_input_values = reinterpret_cast<const OrtValue* const*>(input_values);
+  auto ort_output_values = reinterpret_cast<OrtValue**>(output_values);
+  ThrowOnError(GetApi().RunAsync(this->p_, run_options, input_names, ort_input_values, input_count,
+                                 output_names, output_count, ort_output_values, callback, user_data));
+}
+
 template <typename T>
 inline AllocatedStringPtr SessionImpl<T>::EndProfilingAllocated(OrtAllocator* allocator) {
   char* out = nullptr;
@@ -819,6 +863,35 @@ inline AllocatedStringPtr SessionImpl<T>::EndProfilingAllocated(OrtAllocator* al
   return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
 }
 
+template <typename T>
+inline void SessionImpl<T>::GetResourceStats(size_t& arena_peak_bytes_in_use,
+                                             double& intra_op_thread_pool_utilization) {
+  ThrowOnError(GetApi().SessionGetResourceStats(this->p_, &arena_peak_bytes_in_use,
+                                                &intra_op_thread_pool_utilization));
+}
+
+template <typename T>
+inline AllocatedStringPtr SessionImpl<T>::WarmupAllocated(
+    const RunOptions& run_options, const std::vector<const char*>& input_names,
+    const std::vector<std::vector<std::vector<int64_t>>>& shape_sets, size_t num_runs_per_shape_set,
+    OrtAllocator* allocator) {
+  std::vector<const int64_t*> shapes;
+  std::vector<size_t> shape_lens;
+  for (const auto& shape_set : shape_sets) {
+    if (shape_set.size() != input_names.size()) {
+      ORT_CXX_API_THROW("Expecting a shape for each input name in each shape set", ORT_INVALID_ARGUMENT);
+    }
+    for (const auto& shape : shape_set) {
+      shapes.push_back(shape.data());
+      shape_lens.push_back(shape.size());
+    }
+  }
+  char* out = nullptr;
+  ThrowOnError(GetApi().SessionWarmup(this->p_, run_options, input_names.data(), input_names.size(), shapes.data(),
+                                      shape_lens.data(), shape_sets.size(), num_runs_per_shape_set, allocator, &out));
+  return AllocatedStringPtr(out, detail::AllocatedFree(allocator));
+}
+
 }  // namespace detail
 
 inline SessionOptions::SessionOptions() {
@@ -844,6 +917,10 @@ inline Session::Session(const Env& env, const void* model_data, size_t model_dat
                                                                             prepacked_weights_container, &this->p_));
 }
 
+inline Session::Session(const Session& session, const SessionOptions& options) {
+  ThrowOnError(GetApi().CloneSession(session, options, &this->p_));
+}
+
 inline AllocatedStringPtr ModelMetadata::GetProducerNameAllocated(OrtAllocator* allocator) const {
   char* out;
   ThrowOnError(GetApi().ModelMetadataGetProducerName(p_, allocator, &out));
@@ -1337,6 +1414,27 @@ inline UnownedValue KernelContext::GetOutput(size_t index, const std::vector<int
   return UnownedValue(out);
 }
 
+inline std::vector<ConstValue> KernelContext::GetInputs() const {
+  std::vector<const OrtValue*> values(GetInputCount());
+  Ort::ThrowOnError(GetApi().KernelContext_GetInputs(ctx_, values.data(), values.size()));
+  return std::vector<ConstValue>(values.begin(), values.end());
+}
+
+inline std::vector<UnownedValue> KernelContext::GetOutputs(const std::vector<std::vector<int64_t>>& dims) const {
+  std::vector<const int64_t*> dim_values;
+  std::vector<size_t> dim_counts;
+  dim_values.reserve(dims.size());
+  dim_counts.reserve(dims.size());
+  for (const auto& output_dims : dims) {
+    dim_values.push_back(output_dims.data());
+    dim_counts.push_back(output_dims.size());
+  }
+  std::vector<OrtValue*> values(dims.size());
+  Ort::ThrowOnError(GetApi().KernelContext_GetOutputs(ctx_, dim_values.data(), dim_counts.data(), values.size(),
+                                                      values.data()));
+  return std::vector<UnownedValue>(values.begin(), values.end());
+}
+
 inline void* KernelContext::GetGPUComputeStream() const {
   void* out;
   Ort::ThrowOnError(GetApi().KernelContext_GetGPUComputeStream(ctx_, &out));
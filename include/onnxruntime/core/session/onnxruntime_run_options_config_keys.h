@@ -25,3 +25,17 @@
 // Example usage: "cpu:0;gpu:0" (or) "gpu:0"
 // By default, the value for this key is empty (i.e.) no memory arenas are shrunk
 static const char* const kOrtRunOptionsConfigEnableMemoryArenaShrinkage = "memory.enable_memory_arena_shrinkage";
+
+// Key for identifying the graph that is captured and replayed by the execution provider (currently a CUDA graph)
+// in graph capturing mode. Runs with the same integer id replay the same graph, "-1" runs without capturing or
+// replaying a graph. If the key is not set, the graph is identified by the shapes of the feeds.
+// A graph replays the device memory it was captured with, so the feeds and fetches of each graph must stay bound
+// to the same buffers with IOBinding.
+static const char* const kOrtRunOptionsConfigCudaGraphAnnotation = "gpu_graph_id";
+
+// Key for the priority of the run on the intra-op and inter-op thread pools: "low", "normal" or "high".
+// The tasks of "high" priority runs are taken by the workers before the others. While high priority runs are in
+// progress, "low" priority runs wait for up to 1 ms in between kernels so that a latency sensitive request is not
+// slowed down by batch work running on the same pools.
+// By default, the value for this key is "normal".
+static const char* const kOrtRunOptionsConfigRunPriority = "run.priority";
@@ -20,10 +20,23 @@
 // If the config value is set to "1" then the prepacking is disabled, otherwise prepacking is enabled (default value)
 static const char* const kOrtSessionOptionsConfigDisablePrepacking = "session.disable_prepacking";
 
+// Key for the directory of the on-disk pre-packed weights cache.
+// If set, the weights that CPU kernels pre-pack are saved in this directory, keyed by the node, the initializer
+// contents and the CPU ISA, and sessions created later, in this or other processes, map them read-only instead of
+// pre-packing the weights again. Kernels that don't support loading cached weights pre-pack as usual.
+// The directory is created if it doesn't exist. Default is "", which disables the cache.
+static const char* const kOrtSessionOptionsConfigPrepackedWeightsCacheDir = "session.prepacked_weights_cache_dir";
+
 // A value of "1" means allocators registered in the env will be used. "0" means the allocators created in the session
 // will be used. Use this to override the usage of env allocators on a per session level.
 static const char* const kOrtSessionOptionsConfigUseEnvAllocators = "session.use_env_allocators";
 
+// A value of "1" means the initializers used by CPU nodes are deduplicated with those of the other sessions created
+// with this option in the same env, by data type, shape and content. Identical weights, e.g. those of the base model
+// shared by fine-tuned variants, are then held once per process, and so are their pre-packed forms unless the
+// session was given its own PrepackedWeightsContainer. Default is "0".
+static const char* const kOrtSessionOptionsConfigUseEnvInitializerStore = "session.use_env_initializer_store";
+
 // Set to 'ORT' (case sensitive) to load an ORT format model.
 // If unset, model type will default to ONNX unless inferred from filename ('.ort' == ORT format) or bytes to be ORT
 static const char* const kOrtSessionOptionsConfigLoadModelFormat = "session.load_model_format";
@@ -32,6 +45,15 @@ static const char* const kOrtSessionOptionsConfigLoadModelFormat = "session.load
 // If unset, format will default to ONNX unless optimized_model_filepath ends in '.ort'.
 static const char* const kOrtSessionOptionsConfigSaveModelFormat = "session.save_model_format";
 
+// Directory of the optimized model cache. If set, the optimized and partitioned graph of an ONNX model is saved in
+// ORT format in this directory the first time the model is initialized, and loaded from there by later sessions
+// instead of optimizing the model again. The cache entries are keyed by the content of the model, the session
+// options, the execution providers and their options, and the ORT version, so a change to any of them creates a new
+// entry. The entries may contain hardware specific optimizations and must not be shared between machines.
+// The cache is not used when the model is ORT format, when optimized_model_filepath is set, or when a CUDA graph is
+// captured, and the graph is not saved when an execution provider compiles nodes.
+static const char* const kOrtSessionOptionsOptimizedModelCacheDir = "session.optimized_model_cache_dir";
+
 // If a value is "1", flush-to-zero and denormal-as-zero are applied. The default is "0".
 // When multiple sessions are created, a main thread doesn't override changes from succeeding session options,
 // but threads in session thread pools follow option changes.
@@ -61,13 +83,83 @@ static const char* const kOrtSessionOptionsEnableQuantQDQCleanup = "session.enab
 // GeluApproximation has side effects which may change the inference results. It is disabled by default due to this.
 static const char* const kOrtSessionOptionsEnableGeluApproximation = "optimization.enable_gelu_approximation";
 
+// Enable or disable running the token-wise nodes of BERT encoders on CUDA without the padding of the sequences.
+// "0": disable; "1": enable. The default is "0".
+// Padding is removed using the 1D mask_index of the Attention nodes, and restored for the Attention nodes and the
+// graph outputs. It saves compute when the sequences in a batch are much shorter than the padded sequence length.
+static const char* const kOrtSessionOptionsEnablePackedSequence = "optimization.enable_packed_sequence";
+
+// Enable or disable fusing the MatMul nodes of DequantizeFloat8 inputs into MatMulFloat8 on CUDA.
+// "0": disable; "1": enable. The default is "0".
+// MatMulFloat8 runs on the float8 tensor cores, so it must only be enabled on devices with compute capability 8.9
+// or above.
+static const char* const kOrtSessionOptionsEnableFloat8MatMul = "optimization.enable_float8_matmul";
+
+// Enable or disable keeping regions of nodes in the NCHW format when converting them to the NCHWc format of the CPU
+// EP is estimated to cost more than it saves. "0": disable; "1": enable. The default is "0".
+// The cost of the ReorderInput and ReorderOutput nodes at the region boundaries is estimated from the tensor sizes
+// and the gain from the multiply-accumulates of the convolutions in the region. Transposes between the NHWC and NCHW
+// formats at the boundaries are fused into the reorders so they don't count. Regions with unknown shapes are
+// converted as usual.
+static const char* const kOrtSessionOptionsNchwcSkipUnprofitableRegions =
+    "optimization.nchwc_skip_unprofitable_regions";
+
+// Enable or disable fusing chains of float elementwise nodes of the CPU EP into a FusedElementwise node.
+// "0": disable; "1": enable. The default is "0".
+// The fused node evaluates the chain block by block in a single pass over the data, so the intermediate tensors are
+// neither allocated nor written back to memory. Only linear chains whose intermediate results have a single consumer
+// are fused.
+static const char* const kOrtSessionOptionsEnableElementwiseChainFusion =
+    "optimization.enable_elementwise_chain_fusion";
+
+// Enable or disable removing the ZipMap nodes that produce graph outputs. "0": disable; "1": enable.
+// The default is "0".
+// The graph outputs of the removed nodes keep their names but become the dense float tensor of probabilities, with
+// one column per class label in the order of the labels of the ZipMap node. The labels predicted by the classifier
+// are still returned by its label output. It saves building a map per row when the caller only needs the arrays.
+static const char* const kOrtSessionOptionsDisableZipMap = "optimization.disable_zipmap";
+
+// The number of GPUs of the tensor parallel group and the rank of this session in the group. The default is "1"
+// and "0". When the size is larger than 1, the MLP and self attention blocks of the model are partitioned in the
+// way of Megatron-LM, and the session only keeps the weights of its rank. Each rank runs in its own process on its
+// own GPU, e.g. launched by mpirun, and the partial results are summed over the ranks with NCCL. The rank must be the
+// MPI rank of the process. Only supported by the CUDA EP in builds with NCCL.
+static const char* const kOrtSessionOptionsTensorParallelSize = "session.tensor_parallel_size";
+static const char* const kOrtSessionOptionsTensorParallelRank = "session.tensor_parallel_rank";
+
+// Skip constant folding of a node when the total size of its outputs is larger than the given ratio of the total
+// size of its constant inputs, e.g. an Expand or ConstantOfShape that would turn a few bytes into a large
+// initializer. Outputs smaller than 1MB are always folded. The value is a float, the default is "0" (no limit).
+static const char* const kOrtSessionOptionsConstantFoldingMaxOutputGrowthRatio =
+    "optimization.constant_folding_max_output_growth_ratio";
+
+// Directory to spill the large outputs of constant folding to. The outputs are written to temporary files which are
+// memory mapped for the lifetime of the session instead of being kept in heap memory. Outputs are spilled when they
+// are at least "optimization.constant_folding_spill_threshold_bytes" large, the default threshold is 64MB.
+// The default directory is "" which disables spilling.
+static const char* const kOrtSessionOptionsConstantFoldingSpillDir = "optimization.constant_folding_spill_dir";
+static const char* const kOrtSessionOptionsConstantFoldingSpillThreshold =
+    "optimization.constant_folding_spill_threshold_bytes";
+
+// Path to a profile file written by a previous profiling run of the model (SessionOptions.enable_profiling) with
+// the same execution providers. If set, the node latencies measured in the profile are used to move nodes between
+// the execution providers with kernels after the nodes were assigned in the order of the execution providers,
+// where that lowers the estimated latency of the nodes plus the copies between devices. E.g. small islands of
+// nodes on the CPU between nodes on the GPU are moved to the GPU if the copies cost more than they save.
+// The estimated latency of a copy is the overhead in microseconds plus the size in bytes divided by the bandwidth.
+// Their defaults are "10" and "10000" bytes per microsecond.
+// The default is "" which keeps the assignment in the order of the execution providers.
+static const char* const kOrtSessionOptionsPartitioningCostModelFile = "session.partitioning_cost_model_file";
+static const char* const kOrtSessionOptionsPartitioningCopyOverheadUs = "session.partitioning_copy_overhead_us";
+static const char* const kOrtSessionOptionsPartitioningCopyBytesPerUs = "session.partitioning_copy_bytes_per_us";
+
 #ifdef ENABLE_TRAINING
 // Specifies a list of op types for memory footprint reduction.
 // The value should be a ","-delimited list of pair of
 // <subgraph string : optimization strategy : number of subgraph to apply>.
 // For example, "Gelu+Cast+:1:0,Dropout+:1:1".
 //   A valid "subgraph string" should be one subgraph representation output by ORT graph transformations.
-//   "optimization strategy" currently has valid values: 0 - disabled, 1 - recompute.
+//   "optimization strategy" currently has valid values: 0 - disabled, 1 - recompute, 2 - offload.
 //   "number of subgraph to apply" is used to control how many subgraphs to apply optimization, to avoid "oversaving"
 //   the memory.
 static const char* const kOrtSessionOptionsMemoryOptimizerEnabler = "optimization.enable_memory_optimizer";
@@ -75,6 +167,13 @@ static const char* const kOrtSessionOptionsMemoryOptimizerEnabler = "optimizatio
 // Specifies the level for detecting subgraphs for memory footprint reduction.
 // The value should be an integer. The default value is 0.
 static const char* const kOrtSessionOptionsMemoryOptimizerProbeLevel = "optimization.enable_memory_probe_recompute_level";
+
+// Specifies the budget in bytes for stashed activations kept between forward and backward.
+// When set, the memory optimizer picks recompute and offload actions by itself until the statically known stashed
+// activation size fits in the budget, and the per-subgraph configs of "optimization.enable_memory_optimizer" are
+// ignored. Activations with symbolic shapes are not counted. The default is "" (disabled).
+static const char* const kOrtSessionOptionsMemoryOptimizerActivationBudget =
+    "optimization.memory_optimizer_activation_budget_in_bytes";
 #endif
 
 // Enable or disable using device allocator for allocating initialized tensor memory. "1": enable; "0": disable. The default is "0".
@@ -87,6 +186,22 @@ static const char* const kOrtSessionOptionsUseDeviceAllocatorForInitializers = "
 static const char* const kOrtSessionOptionsConfigAllowInterOpSpinning = "session.inter_op.allow_spinning";
 static const char* const kOrtSessionOptionsConfigAllowIntraOpSpinning = "session.intra_op.allow_spinning";
 
+// Configure how long the intra_op threads spin before blocking, when they are allowed to spin
+// "0": default, a thread spins a fixed number of times before blocking
+// "1": each thread spins for twice the average of its recent idle periods that were at most 1 ms long, between
+// 10 us and 1 ms, or only 10 us when most of its recent idle periods were longer. The threads then stop wasting
+// CPU between the requests of a server at low QPS while still serving the parallel loops within a run, and
+// the bursts of requests under load, without wake-up latency.
+static const char* const kOrtSessionOptionsConfigIntraOpAdaptiveSpinning = "session.intra_op.adaptive_spinning";
+
+// Configure whether the intra_op thread pool measures the cost of the parallel loops of the kernels
+// "0": default, the loops are split based on the cost per iteration that each kernel estimates
+// "1": the pool times a sample of the loops of each call site, and splits the following loops of the call site based
+// on the measured cost, scaled to the current loop by the estimate of the kernel. Kernels whose estimates are too high
+// then stop splitting small loops, and the ones whose estimates are too low split big loops into more blocks.
+// Requires a build with RTTI, the call sites are told apart by the types of their loop bodies.
+static const char* const kOrtSessionOptionsConfigIntraOpCalibrateCost = "session.intra_op.calibrate_cost";
+
 // Key for using model bytes directly for ORT format
 // If a session is created using an input byte array contains the ORT format model data,
 // By default we will copy the model bytes at the time of session creation to ensure the model bytes
@@ -105,6 +220,16 @@ static const char* const kOrtSessionOptionsConfigUseORTModelBytesDirectly = "ses
 static const char* const kOrtSessionOptionsConfigUseORTModelBytesForInitializers =
     "session.use_ort_model_bytes_for_initializers";
 
+/// <summary>
+/// Key for memory mapping an ORT format model file instead of reading it into a buffer.
+/// Applies when the InferenceSession is created from the path of an ORT format model.
+/// If set to "1", the file is mapped read-only (copy-on-write) for the lifetime of the InferenceSession, and
+/// initializers used on CPU refer to the mapped bytes directly, so the pages are shared with other processes
+/// mapping the same file. The file must not be modified while the InferenceSession is alive.
+/// Default is "0".
+/// </summary>
+static const char* const kOrtSessionOptionsConfigMemoryMapOrtModel = "session.memory_map_ort_model";
+
 // This should only be specified when exporting an ORT format model for use on a different platform.
 // If the ORT format model will be used on ARM platforms set to "1". For other platforms set to "0"
 // Available since version 1.11.
@@ -136,6 +261,21 @@ static const char* const kOrtSessionOptionsConfigMinimalBuildOptimizations =
 // exclusion, set the value to "".
 static const char* const kOrtSessionOptionsConfigNnapiEpPartitioningStopOps = "ep.nnapi.partitioning_stop_ops";
 
+// Specifies a directory the NNAPI EP can use to cache the compiled models, the directory must be writable by the
+// application, such as the application cache directory on Android.
+// When set, the compilation of a model that was compiled before with the same inputs, nodes, initializers and flags
+// is loaded from the cache, which can save seconds of session creation time.
+// This is only available after Android API level 29, and will be ignored for Android API level 28-
+// If not specified, compilation caching is disabled.
+static const char* const kOrtSessionOptionsConfigNnapiEpCacheDir = "ep.nnapi.cache_dir";
+
+// Specifies a directory the CoreML EP can use to cache the compiled CoreML models (.mlmodelc), the directory must
+// exist and be writable by the application, such as the application Caches directory on iOS.
+// The compiled models are keyed by the content of the generated CoreML model, so a session which creates the same
+// CoreML model as before will skip the CoreML compilation.
+// If not specified, the compiled models are created in a temporary directory and removed with the session.
+static const char* const kOrtSessionOptionsConfigCoreMLEpCacheDir = "ep.coreml.cache_dir";
+
 // Enabling dynamic block-sizing for multithreading.
 // With a positive value, thread pool will split a task of N iterations to blocks of size starting from:
 // N / (num_of_threads * dynamic_block_base)
@@ -162,6 +302,17 @@ static const char* const kOrtSessionOptionsConfigStrictShapeTypeInference = "ses
 // The file saves configuration for partitioning node among logic streams
 static const char* const kNodePartitionConfigFile = "session.node_partition_config_file";
 
+// Maximum number of memory patterns cached per session when memory pattern optimization is enabled.
+// A memory pattern is generated for every distinct set of input shapes, the least recently used one is evicted
+// once the cache is full. "0" means unlimited. Default is "32".
+static const char* const kOrtSessionOptionsMemoryPatternCacheSize = "session.memory_pattern_cache_size";
+
+// Bucket size of the input dims used to look up cached memory patterns.
+// If larger than 1, each input dim is rounded up to a multiple of it, so inputs with similar shapes,
+// e.g. variable sequence lengths, share one memory pattern which is regenerated whenever larger inputs of the
+// same bucket are seen. Default is "0", i.e. a memory pattern is only shared by identical input shapes.
+static const char* const kOrtSessionOptionsMemoryPatternDimBucketSize = "session.memory_pattern_dim_bucket_size";
+
 // This Option allows setting affinities for intra op threads.
 // Affinity string follows format:
 // logical_processor_id,logical_processor_id;logical_processor_id,logical_processor_id
@@ -178,3 +329,82 @@ static const char* const kNodePartitionConfigFile = "session.node_partition_conf
 //    an id of 64 will be inferred as the last processor of the 1st group, while 65 will be interpreted as the 1st processor of the second group.
 //    Hence 64-65 is an invalid configuration, because a windows thread cannot be attached to processors across group boundary.
 static const char* const kOrtSessionOptionsConfigIntraOpThreadAffinities = "session.intra_op_thread_affinities";
+
+// Comma separated names of the Conv and Pad nodes that are run in streaming mode, e.g. "conv1,conv2,pad1".
+// Each run of the session then feeds the next chunk of frames of a stream along the innermost axis.
+// Conv nodes keep the trailing input frames of the previous run as left context and only compute the outputs of
+// the new frames, Pad nodes only apply the leading pad of the innermost axis to the first chunk.
+// The innermost padding at the end of the stream is never applied. The kept frames are discarded whenever the
+// dims of the other axes change. Runs of a session that has streaming nodes must not be concurrent.
+// Only the CPU execution provider supports streaming nodes.
+static const char* const kOrtSessionOptionsConfigStreamingNodes = "session.streaming_nodes";
+
+// If "1", the CPU QAttention kernel also runs Q x K' and the attention probs x V as uint8 x int8 GEMMs, so that the
+// quantized models stay in int8 past the input projection. Q is quantized per head with a zero point, K and V per
+// head symmetrically, and the exponentials of the softmax are quantized to uint8 before they are normalized.
+// The results are less accurate than with the float attention. Only used without past state.
+// Default is "0".
+static const char* const kOrtSessionOptionsQAttentionInt8Attention = "session.qattention_int8_attention";
+
+// Number of runs with the same values of the symbolic input dims after which the session builds, in the background,
+// a copy of itself that is optimized for these values as if they had been set with free dimension overrides.
+// The later runs with these values use the copy once it is ready, runs with other values use the generic session.
+// Only sessions that load an ONNX model and only use the CPU execution provider are specialized.
+// Default is "0", i.e. shape specialization is disabled.
+static const char* const kOrtSessionOptionsShapeSpecializationWarmupRuns = "session.shape_specialization_warmup_runs";
+
+// Maximum number of shape specialized copies of a session, see kOrtSessionOptionsShapeSpecializationWarmupRuns.
+// Default is "4".
+static const char* const kOrtSessionOptionsShapeSpecializationMaxSessions = "session.shape_specialization_max_sessions";
+
+// Enables the sampling profiler: the nodes of 1 in N graph executions are timed and their latencies aggregated into
+// per node histograms, which can be queried while the session is in use. Unlike the profiling enabled with
+// SessionOptions::enable_profiling no trace is collected, so it is cheap enough to stay enabled in production.
+// Default is "0", i.e. the sampling profiler is disabled.
+static const char* const kOrtSessionOptionsSamplingProfilerRate = "session.sampling_profiler_rate";
+
+// Interval in milliseconds at which the sampling profiler exports and resets the node latencies.
+// By default the slowest nodes are logged at the INFO level. Default is "0", i.e. the latencies are never exported.
+static const char* const kOrtSessionOptionsSamplingProfilerExportIntervalMs =
+    "session.sampling_profiler_export_interval_ms";
+
+// Number of profiling events after which the buffered events are written to the profile file, so that long runs can
+// be profiled without keeping the whole trace in memory or being limited by the maximum number of events.
+// The file is a JSON array of chrome tracing events that is closed when the profiling ends. The trace viewers also
+// open the file of a process that did not end the profiling.
+// Default is "0", i.e. the events are written when the profiling ends.
+static const char* const kOrtSessionOptionsProfilingStreamingBatchSize = "session.profiling_streaming_batch_size";
+
+// If "1", the profiling also records the runs of the tasks on the worker threads of the intra-op thread pool, as
+// events of the worker threads, and the bytes in use of the arena of each node's execution provider after the node
+// ran, as counter events. The traces then show the scheduling gaps and memory spikes on the same timeline as the nodes.
+// Default is "0".
+static const char* const kOrtSessionOptionsProfilingTimelineTracks = "session.profiling_timeline_tracks";
+
+// Comma separated hardware performance counters that the profiling reads around each profiled event, e.g.
+// "cycles,instructions,llc_load_misses,llc_store_misses". The values of the counters, and the instructions per cycle
+// and the bytes read and written by the last level cache misses when these counters are read, are added to the args
+// of the events. The counters count the events of the thread that runs a node, so the work that the node hands to
+// the intra-op thread pool is not included. Only supported on Linux, see /proc/sys/kernel/perf_event_paranoid.
+// Supported counters: cycles, instructions, cache_references, cache_misses, branch_misses, stalled_cycles_frontend,
+// stalled_cycles_backend, llc_load_misses, llc_store_misses, page_faults.
+// Default is "", i.e. no counter is read.
+static const char* const kOrtSessionOptionsProfilingHardwareCounters = "session.profiling_hardware_counters";
+
+// Converts the float nodes of the CUDA and ROCm execution providers to a lower precision when the session is
+// initialized, so that a float model gets the speed of the float16 tensor cores without a converted model file.
+// Supported values: "fp16" and "bf16". The graph inputs and outputs stay in float.
+// Only the nodes of the allowed op types that have a float16 or bfloat16 kernel on their execution provider are
+// converted, see kOrtSessionOptionsMixedPrecisionAllowOps. Reductions, Softmax and the normalizations stay in float,
+// as do the nodes with constant inputs that would overflow float16.
+// Default is "", i.e. the nodes are not converted.
+static const char* const kOrtSessionOptionsMixedPrecision = "session.mixed_precision";
+
+// Comma separated op types that the mixed precision conversion converts in addition to its default op types, of any
+// domain, e.g. "Softmax,FusedMatMul".
+// The default op types are MatMul, Gemm, Conv, ConvTranspose, the basic element-wise ops and the data movement ops.
+static const char* const kOrtSessionOptionsMixedPrecisionAllowOps = "session.mixed_precision_allow_ops";
+
+// Comma separated op types that the mixed precision conversion keeps in float, e.g. "Div,Gemm".
+// They take precedence over the allowed op types.
+static const char* const kOrtSessionOptionsMixedPrecisionDenyOps = "session.mixed_precision_deny_ops";
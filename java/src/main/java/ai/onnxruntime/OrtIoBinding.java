@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates. All rights reserved.
+ * Licensed under the MIT License.
+ */
+package ai.onnxruntime;
+
+import java.io.IOException;
+import java.util.Collections;
+import java.util.LinkedHashMap;
+import java.util.Map;
+
+/**
+ * Binds the inputs and outputs of an {@link OrtSession} to tensors that are reused across calls to
+ * {@link OrtSession#run(OrtIoBinding)}.
+ *
+ * <p>Inputs and outputs bound to {@link OnnxTensor}s created from direct {@link java.nio.Buffer}s
+ * are read and written in place, so a run with such a binding does not allocate on the Java heap
+ * and the results are available in the supplied buffers once it returns. Outputs can also be bound
+ * by name only, in which case ONNX Runtime allocates them and they are fetched with {@link
+ * #getOutputValues()}.
+ *
+ * <p>The binding keeps references to the bound tensors, but it does not own them. They must not be
+ * closed while they are bound.
+ *
+ * <p>Produced by {@link OrtSession#createIoBinding()}. Must be closed before the session is
+ * closed.
+ */
+public class OrtIoBinding implements AutoCloseable {
+
+  static {
+    try {
+      OnnxRuntime.init();
+    } catch (IOException e) {
+      throw new RuntimeException("Failed to load onnx-runtime library", e);
+    }
+  }
+
+  final long nativeHandle;
+
+  private final OrtAllocator allocator;
+
+  private final Map<String, OnnxTensorLike> boundInputs = new LinkedHashMap<>();
+
+  // Outputs bound by name only are mapped to null.
+  private final Map<String, OnnxTensor> boundOutputs = new LinkedHashMap<>();
+
+  private boolean closed = false;
+
+  /**
+   * Creates a binding for the supplied native session.
+   *
+   * @param sessionHandle The native session pointer.
+   * @param allocator The allocator used for the outputs which are not bound to a tensor.
+   * @throws OrtException If the native binding could not be created.
+   */
+  OrtIoBinding(long sessionHandle, OrtAllocator allocator) throws OrtException {
+    this.nativeHandle = createIoBinding(OnnxRuntime.ortApiHandle, sessionHandle);
+    this.allocator = allocator;
+  }
+
+  /**
+   * Binds an input to the supplied tensor, replacing any previous binding of that input.
+   *
+   * <p>The input is read from the tensor's memory on every run, so the tensor's contents can be
+   * updated between runs.
+   *
+   * @param name The input name.
+   * @param input The tensor to bind.
+   * @throws OrtException If the native call failed.
+   */
+  public void bindInput(String name, OnnxTensorLike input) throws OrtException {
+    checkClosed();
+    bindInput(OnnxRuntime.ortApiHandle, nativeHandle, name, input.getNativeHandle());
+    boundInputs.put(name, input);
+  }
+
+  /**
+   * Binds an output to the supplied pre-allocated tensor, replacing any previous binding of that
+   * output.
+   *
+   * <p>The output is written into the tensor's memory on every run, the tensor must have the shape
+   * and type that the model produces.
+   *
+   * @param name The output name.
+   * @param output The tensor to bind.
+   * @throws OrtException If the native call failed.
+   */
+  public void bindOutput(String name, OnnxTensor output) throws OrtException {
+    checkClosed();
+    bindOutput(OnnxRuntime.ortApiHandle, nativeHandle, name, output.getNativeHandle());
+    boundOutputs.put(name, output);
+  }
+
+  /**
+   * Binds an output to CPU memory allocated by ONNX Runtime during the run, for outputs whose
+   * shapes are not known ahead of time. The values are fetched with {@link #getOutputValues()}.
+   *
+   * @param name The output name.
+   * @throws OrtException If the native call failed.
+   */
+  public void bindOutput(String name) throws OrtException {
+    checkClosed();
+    bindOutputToCpu(OnnxRuntime.ortApiHandle, nativeHandle, name);
+    boundOutputs.put(name, null);
+  }
+
+  /** Removes all the input bindings. */
+  public void clearBoundInputs() {
+    checkClosed();
+    clearBoundInputs(OnnxRuntime.ortApiHandle, nativeHandle);
+    boundInputs.clear();
+  }
+
+  /** Removes all the output bindings. */
+  public void clearBoundOutputs() {
+    checkClosed();
+    clearBoundOutputs(OnnxRuntime.ortApiHandle, nativeHandle);
+    boundOutputs.clear();
+  }
+
+  /**
+   * Gets the bound inputs, in the order they were bound.
+   *
+   * @return An unmodifiable view of the bound inputs.
+   */
+  public Map<String, OnnxTensorLike> getBoundInputs() {
+    return Collections.unmodifiableMap(boundInputs);
+  }
+
+  /**
+   * Gets the bound outputs, in the order they were bound. Outputs bound by name only map to null.
+   *
+   * @return An unmodifiable view of the bound outputs.
+   */
+  public Map<String, OnnxTensor> getBoundOutputs() {
+    return Collections.unmodifiableMap(boundOutputs);
+  }
+
+  /**
+   * Gets the values of the bound outputs produced by the last run, including the ones bound to
+   * pre-allocated tensors. The returned values share the memory of the bound outputs, closing them
+   * does not release the tensors that were bound.
+   *
+   * <p>This allocates new Java objects, use outputs bound to pre-allocated tensors to avoid that.
+   *
+   * @return The output values.
+   * @throws OrtException If the native call failed.
+   */
+  public OrtSession.Result getOutputValues() throws OrtException {
+    checkClosed();
+    String[] names = getOutputNames(OnnxRuntime.ortApiHandle, nativeHandle, allocator.handle);
+    OnnxValue[] values = getOutputValues(OnnxRuntime.ortApiHandle, nativeHandle, allocator.handle);
+    return new OrtSession.Result(names, values);
+  }
+
+  /**
+   * Waits for the copies of the bound inputs to the devices they are consumed on, which is only
+   * needed when they are updated concurrently with a run on an asynchronous execution provider.
+   *
+   * @throws OrtException If the native call failed.
+   */
+  public void synchronizeInputs() throws OrtException {
+    checkClosed();
+    synchronizeInputs(OnnxRuntime.ortApiHandle, nativeHandle);
+  }
+
+  /**
+   * Waits for the bound outputs to be written, which is only needed for outputs on the devices of
+   * asynchronous execution providers.
+   *
+   * @throws OrtException If the native call failed.
+   */
+  public void synchronizeOutputs() throws OrtException {
+    checkClosed();
+    synchronizeOutputs(OnnxRuntime.ortApiHandle, nativeHandle);
+  }
+
+  /**
+   * Checks if the binding is closed, if so throws {@link IllegalStateException}.
+   *
+   * @throws IllegalStateException If the binding is closed.
+   */
+  void checkClosed() {
+    if (closed) {
+      throw new IllegalStateException("Trying to use a closed OrtIoBinding");
+    }
+  }
+
+  @Override
+  public String toString() {
+    return "OrtIoBinding(inputs="
+        + boundInputs.keySet()
+        + ",outputs="
+        + boundOutputs.keySet()
+        + ")";
+  }
+
+  /** Closes the binding, the bound tensors are not closed. */
+  @Override
+  public void close() {
+    if (!closed) {
+      close(OnnxRuntime.ortApiHandle, nativeHandle);
+      boundInputs.clear();
+      boundOutputs.clear();
+      closed = true;
+    } else {
+      throw new IllegalStateException("Trying to close an already closed OrtIoBinding.");
+    }
+  }
+
+  private static native long createIoBinding(long apiHandle, long sessionHandle)
+      throws OrtException;
+
+  private native void bindInput(long apiHandle, long nativeHandle, String name, long valueHandle)
+      throws OrtException;
+
+  private native void bindOutput(long apiHandle, long nativeHandle, String name, long valueHandle)
+      throws OrtException;
+
+  private native void bindOutputToCpu(long apiHandle, long nativeHandle, String name)
+      throws OrtException;
+
+  private native void clearBoundInputs(long apiHandle, long nativeHandle);
+
+  private native void clearBoundOutputs(long apiHandle, long nativeHandle);
+
+  private native String[] getOutputNames(long apiHandle, long nativeHandle, long allocatorHandle)
+      throws OrtException;
+
+  private native OnnxValue[] getOutputValues(
+      long apiHandle, long nativeHandle, long allocatorHandle) throws OrtException;
+
+  private native void synchronizeInputs(long apiHandle, long nativeHandle) throws OrtException;
+
+  private native void synchronizeOutputs(long apiHandle, long nativeHandle) throws OrtException;
+
+  private static native void close(long apiHandle, long nativeHandle);
+}
@@ -311,6 +311,55 @@ public class OrtSession implements AutoCloseable {
     }
   }
 
+  /**
+   * Creates an {@link OrtIoBinding} for this session, to run it on inputs and outputs that are
+   * reused across runs.
+   *
+   * @return A new binding with no bound inputs or outputs.
+   * @throws OrtException If the native call failed.
+   */
+  public OrtIoBinding createIoBinding() throws OrtException {
+    if (!closed) {
+      return new OrtIoBinding(nativeHandle, allocator);
+    } else {
+      throw new IllegalStateException("Trying to create an OrtIoBinding on a closed OrtSession.");
+    }
+  }
+
+  /**
+   * Scores the inputs bound in the supplied binding, writing the results into its bound outputs.
+   *
+   * <p>Outputs bound to pre-allocated tensors contain the results when this returns, outputs bound
+   * by name can be fetched with {@link OrtIoBinding#getOutputValues()}.
+   *
+   * @param binding The input and output binding.
+   * @throws OrtException If there was an error in native code.
+   */
+  public void run(OrtIoBinding binding) throws OrtException {
+    run(binding, null);
+  }
+
+  /**
+   * Scores the inputs bound in the supplied binding, writing the results into its bound outputs.
+   *
+   * <p>Outputs bound to pre-allocated tensors contain the results when this returns, outputs bound
+   * by name can be fetched with {@link OrtIoBinding#getOutputValues()}.
+   *
+   * @param binding The input and output binding.
+   * @param runOptions The RunOptions to control this run.
+   * @throws OrtException If there was an error in native code.
+   */
+  public void run(OrtIoBinding binding, RunOptions runOptions) throws OrtException {
+    if (!closed) {
+      binding.checkClosed();
+      long runOptionsHandle = runOptions == null ? 0 : runOptions.nativeHandle;
+      runWithBinding(
+          OnnxRuntime.ortApiHandle, nativeHandle, runOptionsHandle, binding.nativeHandle);
+    } else {
+      throw new IllegalStateException("Trying to score a closed OrtSession.");
+    }
+  }
+
   /**
    * Gets the metadata for the currently loaded model.
    *
@@ -433,6 +482,20 @@ public class OrtSession implements AutoCloseable {
       long runOptionsHandle)
       throws OrtException;
 
+  /**
+   * The native run call on a binding. runOptionsHandle can be zero (i.e. the null pointer), but all
+   * other handles must be valid pointers.
+   *
+   * @param apiHandle The pointer to the api.
+   * @param nativeHandle The pointer to the session.
+   * @param runOptionsHandle The (possibly null) pointer to the run options.
+   * @param bindingHandle The pointer to the io binding.
+   * @throws OrtException If the native call failed in some way.
+   */
+  private native void runWithBinding(
+      long apiHandle, long nativeHandle, long runOptionsHandle, long bindingHandle)
+      throws OrtException;
+
   private native long getProfilingStartTimeInNs(long apiHandle, long nativeHandle)
       throws OrtException;
 
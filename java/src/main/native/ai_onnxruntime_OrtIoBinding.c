@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2022, Oracle and/or its affiliates. All rights reserved.
+ * Licensed under the MIT License.
+ */
+#include <jni.h>
+#include <string.h>
+#include <stdlib.h>
+#include "onnxruntime/core/session/onnxruntime_c_api.h"
+#include "OrtJniUtil.h"
+#include "ai_onnxruntime_OrtIoBinding.h"
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    createIoBinding
+ * Signature: (JJ)J
+ */
+JNIEXPORT jlong JNICALL Java_ai_onnxruntime_OrtIoBinding_createIoBinding
+    (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong sessionHandle) {
+  (void) jclazz; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtIoBinding* binding = NULL;
+  checkOrtStatus(jniEnv, api, api->CreateIoBinding((OrtSession*) sessionHandle, &binding));
+  return (jlong) binding;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    bindInput
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_bindInput
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jstring name, jlong valueHandle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+  checkOrtStatus(jniEnv, api, api->BindInput((OrtIoBinding*) nativeHandle, nameStr, (const OrtValue*) valueHandle));
+  (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, nameStr);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    bindOutput
+ * Signature: (JJLjava/lang/String;J)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_bindOutput
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jstring name, jlong valueHandle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+  checkOrtStatus(jniEnv, api, api->BindOutput((OrtIoBinding*) nativeHandle, nameStr, (const OrtValue*) valueHandle));
+  (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, nameStr);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    bindOutputToCpu
+ * Signature: (JJLjava/lang/String;)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_bindOutputToCpu
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jstring name) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtMemoryInfo* memoryInfo = NULL;
+  OrtErrorCode code = checkOrtStatus(jniEnv, api, api->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault,
+                                                                           &memoryInfo));
+  if (code != ORT_OK) {
+    return;
+  }
+  const char* nameStr = (*jniEnv)->GetStringUTFChars(jniEnv, name, NULL);
+  // The binding keeps the device of the memory info, not the memory info itself.
+  checkOrtStatus(jniEnv, api, api->BindOutputToDevice((OrtIoBinding*) nativeHandle, nameStr, memoryInfo));
+  (*jniEnv)->ReleaseStringUTFChars(jniEnv, name, nameStr);
+  api->ReleaseMemoryInfo(memoryInfo);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    clearBoundInputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_clearBoundInputs
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+  (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  api->ClearBoundInputs((OrtIoBinding*) nativeHandle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    clearBoundOutputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_clearBoundOutputs
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+  (void) jniEnv; (void) jobj; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  api->ClearBoundOutputs((OrtIoBinding*) nativeHandle);
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    getOutputNames
+ * Signature: (JJJ)[Ljava/lang/String;
+ */
+JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtIoBinding_getOutputNames
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jlong allocatorHandle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+
+  // The names are written one after the other into a single buffer without null terminators.
+  char* buffer = NULL;
+  size_t* lengths = NULL;
+  size_t count = 0;
+  OrtErrorCode code = checkOrtStatus(jniEnv, api, api->GetBoundOutputNames((const OrtIoBinding*) nativeHandle,
+                                                                           allocator, &buffer, &lengths, &count));
+  if (code != ORT_OK) {
+    return NULL;
+  }
+
+  jclass stringClazz = (*jniEnv)->FindClass(jniEnv, "java/lang/String");
+  jobjectArray array = (*jniEnv)->NewObjectArray(jniEnv, safecast_size_t_to_jsize(count), stringClazz, NULL);
+  size_t offset = 0;
+  for (size_t i = 0; i < count; i++) {
+    char* name = malloc(lengths[i] + 1);
+    if (name == NULL) {
+      throwOrtException(jniEnv, convertErrorCode(ORT_FAIL), "Failed to allocate memory for an output name");
+      break;
+    }
+    memcpy(name, buffer + offset, lengths[i]);
+    name[lengths[i]] = '\0';
+    offset += lengths[i];
+    jstring nameStr = (*jniEnv)->NewStringUTF(jniEnv, name);
+    free(name);
+    (*jniEnv)->SetObjectArrayElement(jniEnv, array, safecast_size_t_to_jsize(i), nameStr);
+  }
+
+  if (count > 0) {
+    checkOrtStatus(jniEnv, api, api->AllocatorFree(allocator, buffer));
+    checkOrtStatus(jniEnv, api, api->AllocatorFree(allocator, lengths));
+  }
+  return array;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    getOutputValues
+ * Signature: (JJJ)[Lai/onnxruntime/OnnxValue;
+ */
+JNIEXPORT jobjectArray JNICALL Java_ai_onnxruntime_OrtIoBinding_getOutputValues
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle, jlong allocatorHandle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  OrtAllocator* allocator = (OrtAllocator*) allocatorHandle;
+
+  OrtValue** values = NULL;
+  size_t count = 0;
+  OrtErrorCode code = checkOrtStatus(jniEnv, api, api->GetBoundOutputValues((const OrtIoBinding*) nativeHandle,
+                                                                            allocator, &values, &count));
+  if (code != ORT_OK) {
+    return NULL;
+  }
+
+  jclass onnxValueClass = (*jniEnv)->FindClass(jniEnv, "ai/onnxruntime/OnnxValue");
+  jobjectArray array = (*jniEnv)->NewObjectArray(jniEnv, safecast_size_t_to_jsize(count), onnxValueClass, NULL);
+  size_t i = 0;
+  for (; i < count; i++) {
+    // The Java object takes ownership of the value.
+    jobject onnxValue = convertOrtValueToONNXValue(jniEnv, api, allocator, values[i]);
+    if (onnxValue == NULL) {
+      break;  // exception thrown
+    }
+    (*jniEnv)->SetObjectArrayElement(jniEnv, array, safecast_size_t_to_jsize(i), onnxValue);
+  }
+  // Release the values which were not converted because of an error.
+  for (; i < count; i++) {
+    api->ReleaseValue(values[i]);
+  }
+
+  if (count > 0) {
+    checkOrtStatus(jniEnv, api, api->AllocatorFree(allocator, values));
+  }
+  return array;
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    synchronizeInputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_synchronizeInputs
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  checkOrtStatus(jniEnv, api, api->SynchronizeBoundInputs((OrtIoBinding*) nativeHandle));
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    synchronizeOutputs
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_synchronizeOutputs
+    (JNIEnv * jniEnv, jobject jobj, jlong apiHandle, jlong nativeHandle) {
+  (void) jobj; // Required JNI parameter not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  checkOrtStatus(jniEnv, api, api->SynchronizeBoundOutputs((OrtIoBinding*) nativeHandle));
+}
+
+/*
+ * Class:     ai_onnxruntime_OrtIoBinding
+ * Method:    close
+ * Signature: (JJ)V
+ */
+JNIEXPORT void JNICALL Java_ai_onnxruntime_OrtIoBinding_close
+    (JNIEnv * jniEnv, jclass jclazz, jlong apiHandle, jlong nativeHandle) {
+  (void) jniEnv; (void) jclazz; // Required JNI parameters not needed by functions which don't need to access their host object.
+  const OrtApi* api = (const OrtApi*) apiHandle;
+  api->ReleaseIoBinding((OrtIoBinding*) nativeHandle);
+}
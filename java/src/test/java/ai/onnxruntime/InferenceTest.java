@@ -439,6 +439,58 @@ public class InferenceTest {
     }
   }
 
+  @Test
+  public void ioBindingTest() throws OrtException {
+    String modelPath = TestHelpers.getResourcePath("/squeezenet.onnx").toString();
+    float[] inputData = TestHelpers.loadTensorFromFile(TestHelpers.getResourcePath("/bench.in"));
+    float[] expectedOutput =
+        TestHelpers.loadTensorFromFile(TestHelpers.getResourcePath("/bench.expected_out"));
+
+    try (SessionOptions options = new SessionOptions();
+        OrtSession session = env.createSession(modelPath, options);
+        OrtIoBinding binding = session.createIoBinding()) {
+      NodeInfo inputMeta = session.getInputInfo().values().iterator().next();
+      String outputName = session.getOutputNames().iterator().next();
+      long[] inputShape = ((TensorInfo) inputMeta.getInfo()).getShape();
+
+      FloatBuffer inputBuffer =
+          ByteBuffer.allocateDirect(inputData.length * 4)
+              .order(ByteOrder.nativeOrder())
+              .asFloatBuffer();
+      FloatBuffer outputBuffer =
+          ByteBuffer.allocateDirect(expectedOutput.length * 4)
+              .order(ByteOrder.nativeOrder())
+              .asFloatBuffer();
+      try (OnnxTensor input = OnnxTensor.createTensor(env, inputBuffer, inputShape);
+          OnnxTensor output =
+              OnnxTensor.createTensor(env, outputBuffer, new long[] {1, 1000, 1, 1})) {
+        binding.bindInput(inputMeta.getName(), input);
+        binding.bindOutput(outputName, output);
+
+        // the buffers are reused across runs, the input is updated in place
+        float[] resultArray = new float[expectedOutput.length];
+        for (int i = 0; i < 2; i++) {
+          inputBuffer.duplicate().put(inputData);
+          session.run(binding);
+          outputBuffer.duplicate().get(resultArray);
+          assertArrayEquals(expectedOutput, resultArray, 1e-6f);
+        }
+
+        // an output bound by name is allocated by the run
+        binding.clearBoundOutputs();
+        binding.bindOutput(outputName);
+        session.run(binding);
+        try (OrtSession.Result results = binding.getOutputValues()) {
+          assertEquals(1, results.size());
+          OnnxTensor resultTensor = (OnnxTensor) results.get(0);
+          assertArrayEquals(new long[] {1, 1000, 1, 1}, resultTensor.getInfo().getShape());
+          assertArrayEquals(
+              expectedOutput, TestHelpers.flattenFloat(resultTensor.getValue()), 1e-6f);
+        }
+      }
+    }
+  }
+
   @Test
   public void throwWrongInputName() throws OrtException {
     SqueezeNetTuple tuple = openSessionSqueezeNet();
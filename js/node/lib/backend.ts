@@ -35,16 +35,8 @@ class OnnxruntimeSessionHandler implements SessionHandler {
 
   async run(feeds: SessionHandler.FeedsType, fetches: SessionHandler.FetchesType, options: InferenceSession.RunOptions):
       Promise<SessionHandler.ReturnType> {
-    return new Promise((resolve, reject) => {
-      process.nextTick(() => {
-        try {
-          resolve(this.#inferenceSession.run(feeds, fetches, options));
-        } catch (e) {
-          // reject if any error is thrown
-          reject(e);
-        }
-      });
-    });
+    // the inputs are converted synchronously, the inference runs on a thread of the libuv thread pool
+    return this.#inferenceSession.run(feeds, fetches, options);
   }
 }
 
@@ -17,7 +17,7 @@ type RunOptions = InferenceSession.RunOptions;
 
 
 /**
- * Binding exports a simple synchronized inference session object wrap.
+ * Binding exports a simple inference session object wrap. The models are loaded synchronously and run asynchronously.
  */
 export declare namespace Binding {
   export interface InferenceSession {
@@ -27,7 +27,7 @@ export declare namespace Binding {
     readonly inputNames: string[];
     readonly outputNames: string[];
 
-    run(feeds: FeedsType, fetches: FetchesType, options: RunOptions): ReturnType;
+    run(feeds: FeedsType, fetches: FetchesType, options: RunOptions): Promise<ReturnType>;
   }
 
   export interface InferenceSessionConstructor {
@@ -130,6 +130,88 @@ Napi::Value InferenceSessionWrap::GetOutputNames(const Napi::CallbackInfo &info)
   return scope.Escape(CreateNapiArrayFrom(env, outputNames_));
 }
 
+namespace {
+// runs a session on a thread of the libuv thread pool, the inputs and outputs are converted on the main thread.
+class RunWorker : public Napi::AsyncWorker {
+public:
+  RunWorker(Napi::Env env, Napi::Object sessionObject, Ort::Session &session, Ort::RunOptions runOptions,
+            const Ort::RunOptions &defaultRunOptions)
+      : Napi::AsyncWorker(env), deferred_(Napi::Promise::Deferred::New(env)), session_(session),
+        runOptions_(std::move(runOptions)), defaultRunOptions_(defaultRunOptions) {
+    // keep the session alive until the run completes
+    references_.push_back(Napi::Persistent(sessionObject));
+  }
+
+  Napi::Promise Promise() const { return deferred_.Promise(); }
+
+  void AddInput(const char *name, Napi::Value value) {
+    inputNames_.push_back(name);
+    inputValues_.push_back(NapiValueToOrtValue(Env(), value));
+    // the input tensor may wrap the data of the JS object, which must outlive the run
+    references_.push_back(Napi::Persistent(value.As<Napi::Object>()));
+  }
+
+  void AddOutput(const char *name, Napi::Value value) {
+    outputNames_.push_back(name);
+    const bool preAllocated = !value.IsNull();
+    if (preAllocated) {
+      outputValues_.push_back(NapiValueToOrtValue(Env(), value));
+      preAllocatedOutputs_.push_back(Napi::Persistent(value.As<Napi::Object>()));
+    } else {
+      outputValues_.emplace_back(nullptr);
+      preAllocatedOutputs_.emplace_back();
+    }
+  }
+
+protected:
+  void Execute() override {
+    try {
+      session_.Run(runOptions_ == nullptr ? defaultRunOptions_ : runOptions_,
+                   inputNames_.empty() ? nullptr : &inputNames_[0], inputValues_.empty() ? nullptr : &inputValues_[0],
+                   inputValues_.size(), outputNames_.empty() ? nullptr : &outputNames_[0],
+                   outputValues_.empty() ? nullptr : &outputValues_[0], outputValues_.size());
+    } catch (std::exception const &e) {
+      SetError(e.what());
+    }
+  }
+
+  void OnOK() override {
+    Napi::Env env = Env();
+    Napi::HandleScope scope(env);
+    try {
+      Napi::Object result = Napi::Object::New(env);
+      for (size_t i = 0; i < outputNames_.size(); i++) {
+        // a pre-allocated output was written in place, return the tensor that was passed in
+        result.Set(outputNames_[i], preAllocatedOutputs_[i].IsEmpty()
+                                        ? OrtValueToNapiValue(env, std::move(outputValues_[i]))
+                                        : preAllocatedOutputs_[i].Value());
+      }
+      deferred_.Resolve(result);
+    } catch (Napi::Error const &e) {
+      deferred_.Reject(e.Value());
+    } catch (std::exception const &e) {
+      deferred_.Reject(Napi::Error::New(env, e.what()).Value());
+    }
+  }
+
+  void OnError(Napi::Error const &e) override { deferred_.Reject(e.Value()); }
+
+private:
+  Napi::Promise::Deferred deferred_;
+  Ort::Session &session_;
+  Ort::RunOptions runOptions_;
+  const Ort::RunOptions &defaultRunOptions_;
+
+  std::vector<const char *> inputNames_;
+  std::vector<Ort::Value> inputValues_;
+  std::vector<const char *> outputNames_;
+  std::vector<Ort::Value> outputValues_;
+  // the tensors passed in for the pre-allocated outputs, empty for the outputs allocated by the run
+  std::vector<Napi::ObjectReference> preAllocatedOutputs_;
+  std::vector<Napi::ObjectReference> references_;
+};
+} // namespace
+
 Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo &info) {
   Napi::Env env = info.Env();
   ORT_NAPI_THROW_ERROR_IF(!this->initialized_, env, "Session is not initialized.");
@@ -144,51 +226,34 @@ Napi::Value InferenceSessionWrap::Run(const Napi::CallbackInfo &info) {
   auto feed = info[0].As<Napi::Object>();
   auto fetch = info[1].As<Napi::Object>();
 
-  std::vector<const char *> inputNames_cstr;
-  std::vector<Ort::Value> inputValues;
-  std::vector<const char *> outputNames_cstr;
-  std::vector<Ort::Value> outputValues;
-  std::vector<bool> reuseOutput;
-  size_t inputIndex = 0;
-  size_t outputIndex = 0;
-
   try {
-    for (auto &name : inputNames_) {
-      if (feed.Has(name)) {
-        inputIndex++;
-        inputNames_cstr.push_back(name.c_str());
-        auto value = feed.Get(name);
-        inputValues.push_back(NapiValueToOrtValue(env, value));
-      }
-    }
-    for (auto &name : outputNames_) {
-      if (fetch.Has(name)) {
-        outputIndex++;
-        outputNames_cstr.push_back(name.c_str());
-        auto value = fetch.Get(name);
-        reuseOutput.push_back(!value.IsNull());
-        outputValues.emplace_back(value.IsNull() ? Ort::Value{nullptr} : NapiValueToOrtValue(env, value));
-      }
-    }
-
     Ort::RunOptions runOptions{nullptr};
     if (info.Length() > 2) {
       runOptions = Ort::RunOptions{};
       ParseRunOptions(info[2].As<Napi::Object>(), runOptions);
     }
 
-    session_->Run(runOptions == nullptr ? *defaultRunOptions_.get() : runOptions,
-                  inputIndex == 0 ? nullptr : &inputNames_cstr[0], inputIndex == 0 ? nullptr : &inputValues[0],
-                  inputIndex, outputIndex == 0 ? nullptr : &outputNames_cstr[0],
-                  outputIndex == 0 ? nullptr : &outputValues[0], outputIndex);
-
-    Napi::Object result = Napi::Object::New(env);
-
-    for (size_t i = 0; i < outputIndex; i++) {
-      result.Set(outputNames_[i], OrtValueToNapiValue(env, outputValues[i]));
+    // the worker is deleted by node-addon-api once it completes
+    auto *worker = new RunWorker(env, this->Value(), *session_, std::move(runOptions), *defaultRunOptions_);
+    try {
+      for (auto &name : inputNames_) {
+        if (feed.Has(name)) {
+          worker->AddInput(name.c_str(), feed.Get(name));
+        }
+      }
+      for (auto &name : outputNames_) {
+        if (fetch.Has(name)) {
+          worker->AddOutput(name.c_str(), fetch.Get(name));
+        }
+      }
+    } catch (...) {
+      delete worker;
+      throw;
     }
 
-    return scope.Escape(result);
+    auto promise = worker->Promise();
+    worker->Queue();
+    return scope.Escape(promise);
   } catch (Napi::Error const &e) {
     throw e;
   } catch (std::exception const &e) {
@@ -41,11 +41,12 @@ private:
   Napi::Value GetOutputNames(const Napi::CallbackInfo &info);
 
   /**
-   * [sync] run the model.
+   * [async] run the model on a thread of the libuv thread pool.
    * @param arg0 input object: all keys must present, value is object
    * @param arg1 output object: at least one key must present, value can be null.
-   * @returns an object that every output specified will present and value must be object
-   * @throw error if status code != 0
+   * @param arg2 optional run options object
+   * @returns a promise of an object that every output specified will present and value must be object
+   * @throw error if the inputs or outputs are invalid. the promise is rejected if status code != 0
    */
   Napi::Value Run(const Napi::CallbackInfo &info);
 
@@ -191,7 +191,7 @@ Ort::Value NapiValueToOrtValue(Napi::Env env, Napi::Value value) {
   }
 }
 
-Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &value) {
+Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &&value) {
   Napi::EscapableHandleScope scope(env);
   auto returnValue = Napi::Object::New(env);
 
@@ -246,10 +246,29 @@ Napi::Value OrtValueToNapiValue(Napi::Env env, Ort::Value &value) {
     returnValue.Set("data", Napi::Value(env, stringArray));
   } else {
     // number data
-    // TODO: optimize memory
-    auto arrayBuffer = Napi::ArrayBuffer::New(env, size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
+    const size_t byteLength = size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType];
+    napi_value arrayBuffer = nullptr;
     if (size > 0) {
-      memcpy(arrayBuffer.Data(), value.GetTensorRawData(), size * DATA_TYPE_ELEMENT_SIZE_MAP[elemType]);
+      // expose the tensor data without copying it, the OrtValue is released when the ArrayBuffer is collected
+      auto ownedValue = std::make_unique<Ort::Value>(std::move(value));
+      void *data = ownedValue->GetTensorMutableData<void>();
+      napi_status status = napi_create_external_arraybuffer(
+          env, data, byteLength, [](napi_env, void *, void *hint) { delete static_cast<Ort::Value *>(hint); },
+          ownedValue.get(), &arrayBuffer);
+      if (status == napi_ok) {
+        ownedValue.release();
+      } else {
+        // some runtimes don't allow external buffers, e.g. Electron with the V8 memory cage
+        arrayBuffer = nullptr;
+        value = std::move(*ownedValue);
+      }
+    }
+    if (arrayBuffer == nullptr) {
+      auto copiedArrayBuffer = Napi::ArrayBuffer::New(env, byteLength);
+      if (size > 0) {
+        memcpy(copiedArrayBuffer.Data(), value.GetTensorRawData(), byteLength);
+      }
+      arrayBuffer = copiedArrayBuffer;
     }
     napi_value typedArrayData;
     napi_status status =
@@ -132,8 +132,7 @@ describe('UnitTests - InferenceSession.run()', () => {
     const result = await session!.run({'data_0': input0}, {'softmaxout_1': null});
     assertTensorEqual(result.softmaxout_1, expectedOutput0);
   });
-  // TODO: enable after buffer reuse is implemented
-  it.skip('run() - fetches object (pre-allocated)', async () => {
+  it('run() - fetches object (pre-allocated)', async () => {
     const preAllocatedOutputBuffer = new Float32Array(expectedOutput0.size);
     const result = await session!.run(
         {'data_0': input0}, {'softmaxout_1': new Tensor(preAllocatedOutputBuffer, expectedOutput0.dims)});
@@ -142,6 +141,12 @@ describe('UnitTests - InferenceSession.run()', () => {
     assert.strictEqual(softmaxout_1.data.byteOffset, preAllocatedOutputBuffer.byteOffset);
     assertTensorEqual(result.softmaxout_1, expectedOutput0);
   });
+  it('run() - concurrent runs', async () => {
+    const results = await Promise.all([1, 2, 3, 4].map(() => session!.run({'data_0': input0})));
+    for (const result of results) {
+      assertTensorEqual(result.softmaxout_1, expectedOutput0);
+    }
+  });
   // #endregion
 
   // #region test bad output(fetches)
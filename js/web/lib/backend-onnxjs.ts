@@ -8,6 +8,11 @@ import {Session} from './onnxjs/session';
 import {OnnxjsSessionHandler} from './onnxjs/session-handler';
 
 class OnnxjsBackend implements Backend {
+  /**
+   * @param backendHint the onnx.js backend that runs the sessions, onnx.js picks one when it's not specified
+   */
+  constructor(private backendHint?: string) {}
+
   // eslint-disable-next-line @typescript-eslint/no-empty-function
   async init(): Promise<void> {}
 
@@ -17,7 +22,8 @@ class OnnxjsBackend implements Backend {
     // onnxruntime-common).
     //       In future we should remove Session.Config and use InferenceSession.SessionOptions.
     //       Currently we allow this to happen to make test runner work.
-    const session = new Session(options as unknown as Session.Config);
+    const config = options as unknown as Session.Config | undefined;
+    const session = new Session({...config, backendHint: config?.backendHint ?? this.backendHint});
 
     // typescript cannot merge method override correctly (so far in 4.2.3). need if-else to call the method.
     if (typeof pathOrBuffer === 'string') {
@@ -31,3 +37,4 @@ class OnnxjsBackend implements Backend {
 }
 
 export const onnxjsBackend = new OnnxjsBackend();
+export const onnxjsWebGpuBackend = new OnnxjsBackend('webgpu');
@@ -13,6 +13,10 @@ if (!BUILD_DEFS.DISABLE_WEBGL) {
   const onnxjsBackend = require('./backend-onnxjs').onnxjsBackend;
   registerBackend('webgl', onnxjsBackend, -10);
 }
+if (!BUILD_DEFS.DISABLE_WEBGPU) {
+  const onnxjsWebGpuBackend = require('./backend-onnxjs').onnxjsWebGpuBackend;
+  registerBackend('webgpu', onnxjsWebGpuBackend, -20);
+}
 if (!BUILD_DEFS.DISABLE_WASM) {
   const wasmBackend = require('./backend-wasm').wasmBackend;
   registerBackend('cpu', wasmBackend, 10);
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {env} from 'onnxruntime-common';
+
+import {Backend, SessionHandler} from '../backend';
+import {Logger} from '../instrument';
+import {Session} from '../session';
+
+import {WebGpuSessionHandler} from './webgpu/session-handler';
+import {Gpu, GpuDevice} from './webgpu/types';
+
+/**
+ * WebGpuBackend is the entry point for all WebGPU operations
+ * When it starts it requests the GPU device that the sessions run their compute shaders on
+ */
+export class WebGpuBackend implements Backend {
+  device: GpuDevice;
+
+  async initialize(): Promise<boolean> {
+    try {
+      const gpu = typeof navigator !== 'undefined' ? (navigator as unknown as {gpu?: Gpu}).gpu : undefined;
+      if (!gpu) {
+        throw new Error('WebGPU is not supported in the current environment');
+      }
+      const adapter = await gpu.requestAdapter();
+      if (!adapter) {
+        throw new Error('no GPU adapter is available');
+      }
+      this.device = await adapter.requestDevice();
+
+      Logger.setWithEnv(env);
+      Logger.verbose('WebGpuBackend', 'Created the GPU device.');
+      return true;
+    } catch (e) {
+      Logger.warning('WebGpuBackend', `Unable to initialize WebGpuBackend. ${e}`);
+      return false;
+    }
+  }
+  createSessionHandler(context: Session.Context): SessionHandler {
+    return new WebGpuSessionHandler(this, context);
+  }
+  dispose(): void {
+    this.device.destroy();
+  }
+}
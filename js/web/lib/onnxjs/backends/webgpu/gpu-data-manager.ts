@@ -0,0 +1,148 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Logger, Profiler} from '../../instrument';
+import {Tensor} from '../../tensor';
+import {ShapeUtil} from '../../util';
+
+import {GPU_BUFFER_USAGE, GPU_MAP_MODE_READ, GpuBuffer, GpuData, GpuDevice} from './types';
+
+// the size of the storage buffers is rounded up to this alignment so buffers of similar sizes can be reused
+const BUFFER_SIZE_ALIGNMENT = 256;
+
+const STORAGE_USAGE = GPU_BUFFER_USAGE.STORAGE | GPU_BUFFER_USAGE.COPY_SRC | GPU_BUFFER_USAGE.COPY_DST;
+const READ_USAGE = GPU_BUFFER_USAGE.MAP_READ | GPU_BUFFER_USAGE.COPY_DST;
+
+const alignBufferSize = (size: number): number =>
+    Math.max(BUFFER_SIZE_ALIGNMENT, Math.ceil(size / BUFFER_SIZE_ALIGNMENT) * BUFFER_SIZE_ALIGNMENT);
+
+/**
+ * returns the size in bytes of the GPU data of a tensor. the shaders only work with 32 bit elements.
+ */
+export const getGpuDataSize = (type: Tensor.DataType, dims: readonly number[]): number => {
+  switch (type) {
+    case 'float32':
+    case 'int32':
+    case 'uint32':
+      return ShapeUtil.size(dims) * 4;
+    default:
+      throw new Error(`WebGPU backend does not support data type: ${type}`);
+  }
+};
+
+/**
+ * GpuDataManager owns the GPU buffers of the tensors.
+ * The buffers that are released are kept in a pool by size and are reused by the next tensors of the same size, so
+ * the runs of a session do not allocate GPU memory once the pool is warm.
+ */
+export class GpuDataManager {
+  private storageCache: Map<Tensor.Id, GpuData>;
+  private freeStorageBuffers: Map<number, GpuBuffer[]>;
+  private freeReadBuffers: Map<number, GpuBuffer[]>;
+
+  constructor(private device: GpuDevice, private profiler: Readonly<Profiler>) {
+    this.storageCache = new Map();
+    this.freeStorageBuffers = new Map();
+    this.freeReadBuffers = new Map();
+  }
+
+  get(id: Tensor.Id): GpuData|undefined {
+    return this.storageCache.get(id);
+  }
+
+  /**
+   * creates the GPU data of a tensor. the content of the buffer is undefined.
+   */
+  create(id: Tensor.Id, type: Tensor.DataType, dims: readonly number[]): GpuData {
+    if (this.storageCache.has(id)) {
+      throw new Error('the tensor already has GPU data');
+    }
+    const size = getGpuDataSize(type, dims);
+    const buffer = this.acquireBuffer(this.freeStorageBuffers, size, STORAGE_USAGE);
+    const gpuData = {id, type, buffer, size};
+    this.storageCache.set(id, gpuData);
+    return gpuData;
+  }
+
+  /**
+   * creates the GPU data of a tensor and copies the tensor data to it.
+   */
+  upload(tensor: Tensor): GpuData {
+    const gpuData = this.create(tensor.dataId, tensor.type, tensor.dims);
+    const data = tensor.numberData as Float32Array | Int32Array | Uint32Array;
+    this.profiler.event('backend', 'GpuDataManager.upload', () => {
+      this.device.queue.writeBuffer(gpuData.buffer, 0, data);
+    });
+    return gpuData;
+  }
+
+  /**
+   * copies the GPU data of a tensor back to the CPU.
+   */
+  async download(id: Tensor.Id): Promise<Tensor.NumberType> {
+    const gpuData = this.storageCache.get(id);
+    if (!gpuData) {
+      throw new Error('the tensor does not have GPU data');
+    }
+
+    return this.profiler.event('backend', 'GpuDataManager.download', async () => {
+      const readBuffer = this.acquireBuffer(this.freeReadBuffers, gpuData.size, READ_USAGE);
+      const commandEncoder = this.device.createCommandEncoder();
+      commandEncoder.copyBufferToBuffer(gpuData.buffer, 0, readBuffer, 0, gpuData.size);
+      this.device.queue.submit([commandEncoder.finish()]);
+
+      await readBuffer.mapAsync(GPU_MAP_MODE_READ);
+      const data = readBuffer.getMappedRange().slice(0, gpuData.size);
+      readBuffer.unmap();
+      this.releaseBuffer(this.freeReadBuffers, readBuffer);
+
+      switch (gpuData.type) {
+        case 'int32':
+          return new Int32Array(data);
+        case 'uint32':
+          return new Uint32Array(data);
+        default:
+          return new Float32Array(data);
+      }
+    });
+  }
+
+  /**
+   * returns the buffer of a tensor to the pool.
+   */
+  release(id: Tensor.Id): void {
+    const gpuData = this.storageCache.get(id);
+    if (gpuData) {
+      this.storageCache.delete(id);
+      this.releaseBuffer(this.freeStorageBuffers, gpuData.buffer);
+    }
+  }
+
+  dispose(): void {
+    this.storageCache.forEach(gpuData => gpuData.buffer.destroy());
+    this.freeStorageBuffers.forEach(buffers => buffers.forEach(buffer => buffer.destroy()));
+    this.freeReadBuffers.forEach(buffers => buffers.forEach(buffer => buffer.destroy()));
+    this.storageCache = new Map();
+    this.freeStorageBuffers = new Map();
+    this.freeReadBuffers = new Map();
+  }
+
+  private acquireBuffer(pool: Map<number, GpuBuffer[]>, size: number, usage: number): GpuBuffer {
+    const bufferSize = alignBufferSize(size);
+    const buffer = pool.get(bufferSize)?.pop();
+    if (buffer) {
+      return buffer;
+    }
+    Logger.verbose('GpuDataManager', `Creating a GPU buffer of ${bufferSize} bytes`);
+    return this.device.createBuffer({size: bufferSize, usage});
+  }
+
+  private releaseBuffer(pool: Map<number, GpuBuffer[]>, buffer: GpuBuffer): void {
+    const buffers = pool.get(buffer.size);
+    if (buffers) {
+      buffers.push(buffer);
+    } else {
+      pool.set(buffer.size, [buffer]);
+    }
+  }
+}
@@ -0,0 +1,69 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {InferenceHandler} from '../../backend';
+import {Tensor} from '../../tensor';
+
+import {WebGpuSessionHandler} from './session-handler';
+import {GpuData, ProgramInfo} from './types';
+
+export class WebGpuInferenceHandler implements InferenceHandler {
+  // the tensors whose GPU data is released when the run ends
+  private runTensors: Set<Tensor.Id>;
+
+  constructor(public session: WebGpuSessionHandler) {
+    this.runTensors = new Set();
+  }
+
+  /**
+   * runs the program on the GPU data of the inputs and returns the output tensors. the data of the outputs stays on
+   * the GPU until it is read.
+   */
+  run(program: ProgramInfo, inputs: readonly Tensor[]): Tensor[] {
+    const inputDatas = inputs.map(input => this.getOrCreateGpuData(input));
+    const outputs = program.outputs.map(output => this.createGpuTensor(output.dims, output.type));
+    const outputDatas = outputs.map(output => this.session.dataManager.create(output.dataId, output.type, output.dims));
+    this.session.programManager.run(program, inputDatas, outputDatas);
+    return outputs;
+  }
+
+  /**
+   * returns a tensor of the given dimensions that shares the data of the input.
+   */
+  reshape(input: Tensor, reshapedDims: readonly number[]): Tensor {
+    if (this.session.dataManager.get(input.dataId)) {
+      return this.createGpuTensor(reshapedDims, input.type, input.dataId);
+    }
+    return new Tensor(reshapedDims, input.type, undefined, undefined, input.data, input.dataId);
+  }
+
+  dispose(): void {
+    this.runTensors.forEach(id => this.session.dataManager.release(id));
+    this.runTensors = new Set();
+  }
+
+  private getOrCreateGpuData(tensor: Tensor): GpuData {
+    const gpuData = this.session.dataManager.get(tensor.dataId);
+    if (gpuData) {
+      return gpuData;
+    }
+    // the initializers are uploaded once and are kept on the GPU for the lifetime of the session
+    if (!this.session.isInitializer(tensor.dataId)) {
+      this.runTensors.add(tensor.dataId);
+    }
+    return this.session.dataManager.upload(tensor);
+  }
+
+  private createGpuTensor(dims: readonly number[], type: Tensor.DataType, dataId?: Tensor.Id): Tensor {
+    const tensor = new Tensor(
+        dims, type,
+        () => {
+          throw new Error('the data of a WebGPU tensor can only be read asynchronously');
+        },
+        async (id: Tensor.Id) => this.session.dataManager.download(id), undefined, dataId);
+    if (!this.session.isInitializer(tensor.dataId)) {
+      this.runTensors.add(tensor.dataId);
+    }
+    return tensor;
+  }
+}
@@ -0,0 +1,65 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Tensor} from '../../../tensor';
+import {BroadcastUtil, ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo} from '../types';
+
+import {getBroadcastOffsets, getElementwiseDispatch, WORKGROUP_SIZE} from './common';
+
+const createBinaryProgramInfo = (name: string, a: Tensor, b: Tensor, expression: string): ProgramInfo => {
+  const outputDims = ShapeUtil.areEqual(a.dims, b.dims) ? a.dims : BroadcastUtil.calcShape(a.dims, b.dims, false);
+  if (!outputDims) {
+    throw new Error(`Can't perform ${name} on the given tensors.`);
+  }
+  const outputSize = ShapeUtil.size(outputDims);
+  const {dispatchGroup, index} = getElementwiseDispatch(outputSize);
+
+  const offsets = ShapeUtil.areEqual(a.dims, b.dims) ? 'let offset_a = i;\n    let offset_b = i;' :
+                                                       getBroadcastOffsets('i', outputDims, a.dims, b.dims);
+  const shaderSource = `
+  @group(0) @binding(0) var<storage, read> input_a : array<f32>;
+  @group(0) @binding(1) var<storage, read> input_b : array<f32>;
+  @group(0) @binding(2) var<storage, read_write> output : array<f32>;
+
+  @compute @workgroup_size(${WORKGROUP_SIZE})
+  fn main(@builtin(global_invocation_id) global_id : vec3<u32>) {
+    let i = ${index};
+    if (i >= ${outputSize}u) {
+      return;
+    }
+    ${offsets}
+    let a = input_a[offset_a];
+    let b = input_b[offset_b];
+    output[i] = ${expression};
+  }`;
+  return {
+    name,
+    cacheKey: `${a.dims.join(',')};${b.dims.join(',')}`,
+    outputs: [{dims: outputDims, type: a.type}],
+    shaderSource,
+    dispatchGroup
+  };
+};
+
+const validateInputs = (inputs: Tensor[]): void => {
+  if (!inputs || inputs.length !== 2) {
+    throw new Error('Binary op requires 2 inputs.');
+  }
+  if (inputs[0].type !== 'float32' || inputs[1].type !== 'float32') {
+    throw new Error('Binary op only supports float32 inputs.');
+  }
+};
+
+const binary = (name: string, expression: string) =>
+    (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => {
+      validateInputs(inputs);
+      return handler.run(createBinaryProgramInfo(name, inputs[0], inputs[1], expression), inputs);
+    };
+
+export const add = binary('Add', 'a + b');
+export const div = binary('Div', 'a / b');
+export const mul = binary('Mul', 'a * b');
+export const pow = binary('Pow', 'pow(a, b)');
+export const sub = binary('Sub', 'a - b');
@@ -0,0 +1,55 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {ShapeUtil} from '../../../util';
+
+export const WORKGROUP_SIZE = 64;
+
+// the limit of the workgroups of a dispatch dimension that every WebGPU device supports
+const MAX_WORKGROUPS_PER_DIMENSION = 65535;
+
+/**
+ * returns the dispatch group of a program that runs one invocation per element, and the WGSL expression of the index
+ * of the element of an invocation. large sizes are dispatched in two dimensions.
+ */
+export const getElementwiseDispatch = (size: number): {dispatchGroup: [number, number, number]; index: string} => {
+  const groups = Math.ceil(size / WORKGROUP_SIZE);
+  if (groups <= MAX_WORKGROUPS_PER_DIMENSION) {
+    return {dispatchGroup: [groups, 1, 1], index: 'global_id.x'};
+  }
+  const groupsY = Math.ceil(groups / MAX_WORKGROUPS_PER_DIMENSION);
+  return {
+    dispatchGroup: [MAX_WORKGROUPS_PER_DIMENSION, groupsY, 1],
+    index: `global_id.y * ${MAX_WORKGROUPS_PER_DIMENSION * WORKGROUP_SIZE}u + global_id.x`
+  };
+};
+
+/**
+ * returns the WGSL statements that compute the offsets `offset_a` and `offset_b` of the inputs that are broadcast to
+ * the element of the output whose index is in the variable `index`.
+ */
+export const getBroadcastOffsets =
+    (index: string, outputDims: readonly number[], aDims: readonly number[], bDims: readonly number[]): string => {
+      const outputStrides = ShapeUtil.computeStrides(outputDims);
+      const getInputOffset = (dims: readonly number[]): string => {
+        const strides = ShapeUtil.computeStrides(dims);
+        const terms: string[] = [];
+        for (let i = 0; i < dims.length; i++) {
+          // the dimensions of the input are aligned with the last dimensions of the output
+          const outputAxis = outputDims.length - dims.length + i;
+          if (dims[i] !== 1) {
+            terms.push(`idx${outputAxis} * ${strides[i]}u`);
+          }
+        }
+        return terms.length > 0 ? terms.join(' + ') : '0u';
+      };
+
+      const statements = [`var rem = ${index};`];
+      for (let axis = 0; axis < outputDims.length; axis++) {
+        statements.push(`let idx${axis} = rem / ${outputStrides[axis]}u;`);
+        statements.push(`rem = rem % ${outputStrides[axis]}u;`);
+      }
+      statements.push(`let offset_a = ${getInputOffset(aDims)};`);
+      statements.push(`let offset_b = ${getInputOffset(bDims)};`);
+      return statements.join('\n    ');
+    };
@@ -0,0 +1,91 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Tensor} from '../../../tensor';
+import {BroadcastUtil, ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo} from '../types';
+
+import {getBroadcastOffsets} from './common';
+
+// the size of the square tiles of the inputs that a workgroup loads to its shared memory
+const TILE_SIZE = 16;
+
+const createMatMulProgramInfo = (a: Tensor, b: Tensor): ProgramInfo => {
+  const outputDims = BroadcastUtil.calcShape(a.dims, b.dims, true);
+  if (!outputDims) {
+    throw new Error('Can\'t use matmul on the given tensors');
+  }
+  const [m, k] = a.dims.slice(-2);
+  const n = b.dims[b.dims.length - 1];
+  const batchDims = outputDims.slice(0, -2);
+  const batchOffsets = getBroadcastOffsets('batch', batchDims, a.dims.slice(0, -2), b.dims.slice(0, -2));
+
+  const shaderSource = `
+  @group(0) @binding(0) var<storage, read> input_a : array<f32>;
+  @group(0) @binding(1) var<storage, read> input_b : array<f32>;
+  @group(0) @binding(2) var<storage, read_write> output : array<f32>;
+
+  var<workgroup> tile_a : array<array<f32, ${TILE_SIZE}>, ${TILE_SIZE}>;
+  var<workgroup> tile_b : array<array<f32, ${TILE_SIZE}>, ${TILE_SIZE}>;
+
+  @compute @workgroup_size(${TILE_SIZE}, ${TILE_SIZE}, 1)
+  fn main(@builtin(local_invocation_id) local_id : vec3<u32>, @builtin(workgroup_id) group_id : vec3<u32>) {
+    let row = group_id.y * ${TILE_SIZE}u + local_id.y;
+    let col = group_id.x * ${TILE_SIZE}u + local_id.x;
+    let batch = group_id.z;
+    ${batchOffsets}
+    let base_a = offset_a * ${m * k}u;
+    let base_b = offset_b * ${k * n}u;
+
+    var acc = 0.0;
+    for (var t = 0u; t < ${Math.ceil(k / TILE_SIZE)}u; t++) {
+      let ka = t * ${TILE_SIZE}u + local_id.x;
+      let kb = t * ${TILE_SIZE}u + local_id.y;
+      var value_a = 0.0;
+      if (row < ${m}u && ka < ${k}u) {
+        value_a = input_a[base_a + row * ${k}u + ka];
+      }
+      var value_b = 0.0;
+      if (col < ${n}u && kb < ${k}u) {
+        value_b = input_b[base_b + kb * ${n}u + col];
+      }
+      tile_a[local_id.y][local_id.x] = value_a;
+      tile_b[local_id.y][local_id.x] = value_b;
+      workgroupBarrier();
+
+      for (var i = 0u; i < ${TILE_SIZE}u; i++) {
+        acc = acc + tile_a[local_id.y][i] * tile_b[i][local_id.x];
+      }
+      workgroupBarrier();
+    }
+
+    if (row < ${m}u && col < ${n}u) {
+      output[batch * ${m * n}u + row * ${n}u + col] = acc;
+    }
+  }`;
+  return {
+    name: 'MatMul',
+    cacheKey: `${a.dims.join(',')};${b.dims.join(',')}`,
+    outputs: [{dims: outputDims, type: a.type}],
+    shaderSource,
+    dispatchGroup: [Math.ceil(n / TILE_SIZE), Math.ceil(m / TILE_SIZE), ShapeUtil.size(batchDims)]
+  };
+};
+
+const validateInputs = (inputs: Tensor[]): void => {
+  if (!inputs || inputs.length !== 2) {
+    throw new Error('MatMul requires 2 inputs.');
+  }
+  if (inputs[0].dims[inputs[0].dims.length - 1] !== inputs[1].dims[inputs[1].dims.length - 2]) {
+    throw new Error('shared dimension does not match.');
+  }
+  if (inputs[0].type !== 'float32' || inputs[1].type !== 'float32') {
+    throw new Error('inputs should be float type');
+  }
+};
+
+export const matMul = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => {
+  validateInputs(inputs);
+  return handler.run(createMatMulProgramInfo(inputs[0], inputs[1]), inputs);
+};
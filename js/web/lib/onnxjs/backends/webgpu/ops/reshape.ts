@@ -0,0 +1,37 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Graph} from '../../../graph';
+import {Tensor} from '../../../tensor';
+import {ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+
+// the ops in this file only change the dimensions of the input, the output shares the GPU data of the input
+
+export const reshape = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => {
+  const reshapedDims = ShapeUtil.calculateReshapedDims(inputs[0].dims, inputs[1].integerData);
+  return [handler.reshape(inputs[0], reshapedDims)];
+};
+
+export const flatten = (handler: WebGpuInferenceHandler, inputs: Tensor[], axis: number): Tensor[] =>
+    [handler.reshape(inputs[0], ShapeUtil.flattenShape(inputs[0].dims, axis))];
+
+export const parseFlattenAttributes = (node: Graph.Node): number => node.attributes.getInt('axis', 1);
+
+export interface AxesAttributes {
+  readonly axes: number[];
+}
+
+export const squeeze = (handler: WebGpuInferenceHandler, inputs: Tensor[], attributes: AxesAttributes): Tensor[] =>
+    [handler.reshape(inputs[0], ShapeUtil.squeezeShape(inputs[0].dims, attributes.axes))];
+
+export const squeezeV13 = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    squeeze(handler, [inputs[0]], {axes: inputs.length > 1 ? Array.from(inputs[1].integerData) : []});
+
+export const unsqueeze = (handler: WebGpuInferenceHandler, inputs: Tensor[], attributes: AxesAttributes): Tensor[] =>
+    [handler.reshape(inputs[0], ShapeUtil.unsqueezeShape(inputs[0].dims, attributes.axes))];
+
+export const unsqueezeV13 = (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] =>
+    unsqueeze(handler, [inputs[0]], {axes: Array.from(inputs[1].integerData)});
+
+export const parseAxesAttributes = (node: Graph.Node): AxesAttributes => ({axes: node.attributes.getInts('axes', [])});
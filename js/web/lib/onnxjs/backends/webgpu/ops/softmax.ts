@@ -0,0 +1,92 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../../../attribute-with-cache-key';
+import {Graph} from '../../../graph';
+import {Tensor} from '../../../tensor';
+import {ShapeUtil} from '../../../util';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo} from '../types';
+
+import {getElementwiseDispatch, WORKGROUP_SIZE} from './common';
+
+export interface SoftmaxAttributes extends AttributeWithCacheKey {
+  readonly axis: number;
+}
+
+/**
+ * creates a program that computes the softmax of each row of a [rowCount, featureCount] matrix, one invocation per
+ * row.
+ */
+const createSoftmaxProgramInfo = (input: Tensor, rowCount: number, featureCount: number): ProgramInfo => {
+  const {dispatchGroup, index} = getElementwiseDispatch(rowCount);
+  const shaderSource = `
+  @group(0) @binding(0) var<storage, read> x : array<f32>;
+  @group(0) @binding(1) var<storage, read_write> y : array<f32>;
+
+  @compute @workgroup_size(${WORKGROUP_SIZE})
+  fn main(@builtin(global_invocation_id) global_id : vec3<u32>) {
+    let row = ${index};
+    if (row >= ${rowCount}u) {
+      return;
+    }
+    let offset = row * ${featureCount}u;
+
+    var max_value = x[offset];
+    for (var i = 1u; i < ${featureCount}u; i++) {
+      max_value = max(max_value, x[offset + i]);
+    }
+    var sum = 0.0;
+    for (var i = 0u; i < ${featureCount}u; i++) {
+      let e = exp(x[offset + i] - max_value);
+      y[offset + i] = e;
+      sum = sum + e;
+    }
+    for (var i = 0u; i < ${featureCount}u; i++) {
+      y[offset + i] = y[offset + i] / sum;
+    }
+  }`;
+  return {
+    name: 'Softmax',
+    cacheKey: `${rowCount};${featureCount}`,
+    outputs: [{dims: input.dims, type: input.type}],
+    shaderSource,
+    dispatchGroup
+  };
+};
+
+const validateInputs = (inputs: Tensor[]): void => {
+  if (!inputs || inputs.length !== 1) {
+    throw new Error('Softmax requires 1 input.');
+  }
+  if (inputs[0].type !== 'float32') {
+    throw new Error('Invalid input type');
+  }
+};
+
+export const softmax = (handler: WebGpuInferenceHandler, inputs: Tensor[], attributes: SoftmaxAttributes):
+    Tensor[] => {
+      validateInputs(inputs);
+      const axis = ShapeUtil.normalizeAxis(attributes.axis, inputs[0].dims.length);
+      const rowCount = ShapeUtil.sizeToDimension(inputs[0].dims, axis);
+      const featureCount = ShapeUtil.sizeFromDimension(inputs[0].dims, axis);
+      return handler.run(createSoftmaxProgramInfo(inputs[0], rowCount, featureCount), inputs);
+    };
+
+// Softmax-13 normalizes a single axis rather than the flattened dimensions from the axis on, which is the same as long
+// as the axis is the last one
+export const softmaxV13 = (handler: WebGpuInferenceHandler, inputs: Tensor[], attributes: SoftmaxAttributes):
+    Tensor[] => {
+      validateInputs(inputs);
+      const rank = inputs[0].dims.length;
+      if (ShapeUtil.normalizeAxis(attributes.axis, rank) !== rank - 1) {
+        throw new Error('WebGPU Softmax-13 only supports the last axis');
+      }
+      return softmax(handler, inputs, attributes);
+    };
+
+export const parseSoftmaxAttributes = (node: Graph.Node): SoftmaxAttributes =>
+    createAttributeWithCacheKey({axis: node.attributes.getInt('axis', 1)});
+
+export const parseSoftmaxAttributesV13 = (node: Graph.Node): SoftmaxAttributes =>
+    createAttributeWithCacheKey({axis: node.attributes.getInt('axis', -1)});
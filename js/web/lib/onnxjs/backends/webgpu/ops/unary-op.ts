@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {AttributeWithCacheKey, createAttributeWithCacheKey} from '../../../attribute-with-cache-key';
+import {Graph} from '../../../graph';
+import {Tensor} from '../../../tensor';
+import {WebGpuInferenceHandler} from '../inference-handler';
+import {ProgramInfo} from '../types';
+
+import {getElementwiseDispatch, WORKGROUP_SIZE} from './common';
+
+/**
+ * creates a program that computes the given WGSL expression of `a`, the value of an element of the input.
+ */
+const createElementwiseProgramInfo =
+    (name: string, input: Tensor, expression: string, cacheKey = ''): ProgramInfo => {
+      const {dispatchGroup, index} = getElementwiseDispatch(input.size);
+      const shaderSource = `
+  @group(0) @binding(0) var<storage, read> x : array<f32>;
+  @group(0) @binding(1) var<storage, read_write> y : array<f32>;
+
+  @compute @workgroup_size(${WORKGROUP_SIZE})
+  fn main(@builtin(global_invocation_id) global_id : vec3<u32>) {
+    let i = ${index};
+    if (i >= ${input.size}u) {
+      return;
+    }
+    let a = x[i];
+    y[i] = ${expression};
+  }`;
+      return {
+        name,
+        cacheKey: `${cacheKey};${input.size}`,
+        outputs: [{dims: input.dims, type: input.type}],
+        shaderSource,
+        dispatchGroup
+      };
+    };
+
+const validateInputs = (inputs: Tensor[]): void => {
+  if (!inputs || inputs.length !== 1) {
+    throw new Error('Unary op requires 1 input.');
+  }
+  if (inputs[0].type !== 'float32') {
+    throw new Error('Unary op only supports float32 input.');
+  }
+};
+
+const unary = (name: string, expression: string) =>
+    (handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => {
+      validateInputs(inputs);
+      return handler.run(createElementwiseProgramInfo(name, inputs[0], expression), inputs);
+    };
+
+export const abs = unary('Abs', 'abs(a)');
+export const ceil = unary('Ceil', 'ceil(a)');
+export const cos = unary('Cos', 'cos(a)');
+export const exp = unary('Exp', 'exp(a)');
+export const floor = unary('Floor', 'floor(a)');
+export const log = unary('Log', 'log(a)');
+export const neg = unary('Neg', '-a');
+export const reciprocal = unary('Reciprocal', '1.0 / a');
+export const relu = unary('Relu', 'max(a, 0.0)');
+export const sigmoid = unary('Sigmoid', '1.0 / (1.0 + exp(-a))');
+export const sin = unary('Sin', 'sin(a)');
+export const sqrt = unary('Sqrt', 'sqrt(a)');
+export const tan = unary('Tan', 'tan(a)');
+export const tanh = unary('Tanh', 'tanh(a)');
+
+export const identity = (_handler: WebGpuInferenceHandler, inputs: Tensor[]): Tensor[] => [inputs[0]];
+
+export interface LeakyReluAttributes extends AttributeWithCacheKey {
+  readonly alpha: number;
+}
+
+export const leakyRelu =
+    (handler: WebGpuInferenceHandler, inputs: Tensor[], attributes: LeakyReluAttributes): Tensor[] => {
+      validateInputs(inputs);
+      return handler.run(
+          createElementwiseProgramInfo(
+              'LeakyRelu', inputs[0], `select(a * f32(${attributes.alpha}), a, a >= 0.0)`, attributes.cacheKey),
+          inputs);
+    };
+
+export const parseLeakyReluAttributes = (node: Graph.Node): LeakyReluAttributes =>
+    createAttributeWithCacheKey({alpha: node.attributes.getFloat('alpha', 0.01)});
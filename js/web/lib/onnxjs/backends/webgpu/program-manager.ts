@@ -0,0 +1,52 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Logger, Profiler} from '../../instrument';
+
+import {GpuComputePipeline, GpuData, GpuDevice, ProgramInfo} from './types';
+
+/**
+ * ProgramManager compiles the WGSL sources of the programs into compute pipelines, which are cached by their key,
+ * and records the dispatches of the programs.
+ */
+export class ProgramManager {
+  private repo: Map<string, GpuComputePipeline>;
+
+  constructor(private device: GpuDevice, private profiler: Readonly<Profiler>) {
+    this.repo = new Map();
+  }
+
+  run(program: ProgramInfo, inputs: readonly GpuData[], outputs: readonly GpuData[]): void {
+    this.profiler.event('op', `ProgramManager.run ${program.name}`, () => {
+      const pipeline = this.getOrCreatePipeline(program);
+      const entries = [...inputs, ...outputs].map((data, binding) => ({binding, resource: {buffer: data.buffer}}));
+      const bindGroup = this.device.createBindGroup({layout: pipeline.getBindGroupLayout(0), entries});
+
+      const commandEncoder = this.device.createCommandEncoder();
+      const passEncoder = commandEncoder.beginComputePass();
+      passEncoder.setPipeline(pipeline);
+      passEncoder.setBindGroup(0, bindGroup);
+      passEncoder.dispatchWorkgroups(...program.dispatchGroup);
+      passEncoder.end();
+      this.device.queue.submit([commandEncoder.finish()]);
+    });
+  }
+
+  dispose(): void {
+    this.repo = new Map();
+  }
+
+  private getOrCreatePipeline(program: ProgramInfo): GpuComputePipeline {
+    const key = `${program.name}[${program.cacheKey}]`;
+    let pipeline = this.repo.get(key);
+    if (!pipeline) {
+      pipeline = this.profiler.event('backend', 'ProgramManager.build', () => {
+        Logger.verbose('ProgramManager', `Compiling the program ${key}`);
+        const module = this.device.createShaderModule({code: program.shaderSource});
+        return this.device.createComputePipeline({layout: 'auto', compute: {module, entryPoint: 'main'}});
+      });
+      this.repo.set(key, pipeline);
+    }
+    return pipeline;
+  }
+}
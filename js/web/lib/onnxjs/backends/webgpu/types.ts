@@ -0,0 +1,97 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+import {Tensor} from '../../tensor';
+
+// The subset of the WebGPU API (https://www.w3.org/TR/webgpu/) used by the WebGPU backend. The API is not part of
+// the DOM typings of the TypeScript version used by this package yet.
+
+export interface GpuBuffer {
+  readonly size: number;
+  mapAsync(mode: number): Promise<void>;
+  getMappedRange(): ArrayBuffer;
+  unmap(): void;
+  destroy(): void;
+}
+
+export interface GpuBindGroupLayout {
+  readonly label?: string;
+}
+
+export interface GpuComputePipeline {
+  getBindGroupLayout(index: number): GpuBindGroupLayout;
+}
+
+export interface GpuComputePassEncoder {
+  setPipeline(pipeline: GpuComputePipeline): void;
+  setBindGroup(index: number, bindGroup: unknown): void;
+  dispatchWorkgroups(x: number, y?: number, z?: number): void;
+  end(): void;
+}
+
+export interface GpuCommandEncoder {
+  beginComputePass(): GpuComputePassEncoder;
+  copyBufferToBuffer(source: GpuBuffer, sourceOffset: number, destination: GpuBuffer, destinationOffset: number,
+                     size: number): void;
+  finish(): unknown;
+}
+
+export interface GpuQueue {
+  submit(commandBuffers: unknown[]): void;
+  writeBuffer(buffer: GpuBuffer, bufferOffset: number, data: ArrayBufferView): void;
+}
+
+export interface GpuDevice {
+  readonly queue: GpuQueue;
+  readonly limits: {readonly maxComputeWorkgroupsPerDimension: number};
+  createBuffer(descriptor: {size: number; usage: number}): GpuBuffer;
+  createShaderModule(descriptor: {code: string}): unknown;
+  createComputePipeline(descriptor: {layout: 'auto'; compute: {module: unknown; entryPoint: string}}):
+      GpuComputePipeline;
+  createBindGroup(descriptor:
+                      {layout: GpuBindGroupLayout; entries: Array<{binding: number; resource: {buffer: GpuBuffer}}>}):
+      unknown;
+  createCommandEncoder(): GpuCommandEncoder;
+  destroy(): void;
+}
+
+export interface Gpu {
+  requestAdapter(options?: {powerPreference?: 'low-power'|'high-performance'}):
+      Promise<{requestDevice(): Promise<GpuDevice>}|null>;
+}
+
+export const GPU_BUFFER_USAGE = {
+  MAP_READ: 0x0001,
+  COPY_SRC: 0x0004,
+  COPY_DST: 0x0008,
+  STORAGE: 0x0080,
+};
+
+export const GPU_MAP_MODE_READ = 0x0001;
+
+/**
+ * a GPU buffer that holds the data of a tensor
+ */
+export interface GpuData {
+  id: Tensor.Id;
+  type: Tensor.DataType;
+  buffer: GpuBuffer;
+  /**
+   * the size in bytes of the tensor data, the buffer may be larger
+   */
+  size: number;
+}
+
+export interface ProgramInfo {
+  name: string;
+  /**
+   * a key that, together with the name, identifies the shader source
+   */
+  cacheKey: string;
+  outputs: ReadonlyArray<{dims: readonly number[]; type: Tensor.DataType}>;
+  /**
+   * the WGSL source. the inputs are bound to bindings 0..n-1 of group 0 and the outputs follow them.
+   */
+  shaderSource: string;
+  dispatchGroup: readonly[number, number, number];
+}
@@ -140,12 +140,8 @@ export class ExecutionPlan {
         if (outputTensor === undefined) {
           throw new Error(`required output [${outputIndex}] does not have value`);
         }
-        if (outputIndex === 0) {
-          await outputTensor.getData();
-        } else {
-          // eslint-disable-next-line no-unused-expressions
-          outputTensor.data;
-        }
+        // the data of the outputs of a GPU backend may only be readable asynchronously
+        await outputTensor.getData();
         output.push(outputTensor);
       }
       Logger.verbose('ExecPlan', 'disposing of inferenceHandler');
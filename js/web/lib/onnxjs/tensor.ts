@@ -127,11 +127,15 @@ export class Tensor {
   }
 
   /**
-   * get the underlying tensor data asynchronously
+   * get the underlying tensor data asynchronously. falls back to the synchronous data provider when the tensor has no
+   * asynchronous one.
    */
   async getData(): Promise<TensorData> {
     if (this.cache === undefined) {
-      this.cache = await this.asyncDataProvider!(this.dataId);
+      if (this.asyncDataProvider === undefined) {
+        return this.data;
+      }
+      this.cache = await this.asyncDataProvider(this.dataId);
     }
     return this.cache;
   }
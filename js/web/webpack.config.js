@@ -57,6 +57,7 @@ function defaultTerserPluginOptions(target) {
 
 const DEFAULT_BUILD_DEFS = {
   DISABLE_WEBGL: false,
+  DISABLE_WEBGPU: false,
   DISABLE_WASM: false,
   DISABLE_WASM_PROXY: false,
   DISABLE_WASM_THREAD: false,
@@ -142,6 +143,7 @@ function buildConfig({ filename, format, target, mode, devtool, build_defs }) {
                     throw new Error(`content for target file '${filename}' is not string.`);
                   }
                   if (content.includes('DISABLE_WEBGL')
+                    || content.includes('DISABLE_WEBGPU')
                     || content.includes('DISABLE_WASM')
                     || content.includes('DISABLE_WASM_PROXY')
                     || content.includes('DISABLE_WASM_THREAD')) {
@@ -295,6 +297,7 @@ module.exports = () => {
           suffix: '.wasm.min', build_defs: {
             ...DEFAULT_BUILD_DEFS,
             DISABLE_WEBGL: true,
+            DISABLE_WEBGPU: true,
           }
         }),
         // ort.webgl.min.js
@@ -309,6 +312,7 @@ module.exports = () => {
           suffix: '.wasm-core.min', build_defs: {
             ...DEFAULT_BUILD_DEFS,
             DISABLE_WEBGL: true,
+            DISABLE_WEBGPU: true,
             DISABLE_WASM_PROXY: true,
             DISABLE_WASM_THREAD: true,
           }
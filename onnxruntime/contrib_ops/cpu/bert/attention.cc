@@ -202,6 +202,7 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
 
   const Tensor* key = context->Input<Tensor>(6);
   const Tensor* value = context->Input<Tensor>(7);
+  const Tensor* past_seq_len = context->Input<Tensor>(8);
 
   const TensorShape& weights_shape = (weights ? weights->Shape() : weight_shape_);
 
@@ -214,7 +215,8 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
                                   extra_add_qk,
                                   key,
                                   value,
-                                  &parameters));
+                                  &parameters,
+                                  past_seq_len));
 
   const int batch_size = parameters.batch_size;
   const int sequence_length = parameters.sequence_length;
@@ -328,6 +330,11 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
               nullptr                         // use single-thread
           );
         }
+
+        if (parameters.rotary_embedding_dim > 0 && qkv_index < 2) {
+          ApplyRotaryEmbedding(qkv_dest + qkv_offset, sequence_length, head_size, parameters.rotary_embedding_dim,
+                               parameters.past_sequence_length);
+        }
       }
     });
   }
@@ -336,7 +343,7 @@ Status Attention<T>::Compute(OpKernelContext* context) const {
   return ApplyAttention(Q, K, V, mask_index, past, output,
                         batch_size, sequence_length,
                         parameters.head_size, parameters.v_head_size, parameters.v_hidden_size,
-                        extra_add_qk, context);
+                        extra_add_qk, context, past_seq_len);
 }
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -299,6 +299,14 @@ Status AttentionBase::CheckInputs(const TensorShape& input_shape,
     }
   }
 
+  if (rotary_embedding_dim_ != 0 &&
+      (rotary_embedding_dim_ < 0 || rotary_embedding_dim_ % 2 != 0 ||
+       rotary_embedding_dim_ > q_hidden_size / num_heads_)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "rotary_embedding_dim shall be even and no larger than head_size, got ",
+                           rotary_embedding_dim_);
+  }
+
   if (parameters != nullptr) {
     AttentionParameters* output_parameters = reinterpret_cast<AttentionParameters*>(parameters);
     output_parameters->batch_size = static_cast<int>(batch_size);
@@ -315,6 +323,8 @@ Status AttentionBase::CheckInputs(const TensorShape& input_shape,
     output_parameters->num_heads = num_heads_;
     output_parameters->is_unidirectional = is_unidirectional_;
     output_parameters->past_present_share_buffer = (past_present_share_buffer_ != 0);
+    output_parameters->rotary_embedding_dim = rotary_embedding_dim_;
+    output_parameters->use_alibi = use_alibi_;
   }
 
   return Status::OK();
@@ -47,6 +47,9 @@ class AttentionBase {
 
     past_present_share_buffer_ = info.GetAttrOrDefault<int64_t>("past_present_share_buffer", 0LL);
 
+    rotary_embedding_dim_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("rotary_embedding_dim", 0));
+    use_alibi_ = info.GetAttrOrDefault<int64_t>("use_alibi", 0) == 1;
+
     require_same_hidden_size_ = require_same_hidden_size;
     require_weights_ = require_weights;
   }
@@ -75,6 +78,8 @@ class AttentionBase {
   bool require_same_hidden_size_;          // whether the implementation supports different hidden sizes of Q/K/V.
   bool require_weights_;                   // whether the implementation requires weights for Q/K/V.
   bool past_present_share_buffer_;         // whether or not the past (if used) and present tensor share the same buffer
+  int rotary_embedding_dim_;               // number of leading elements of each Q/K head rotated by rotary embedding
+  bool use_alibi_;                         // whether ALiBi position bias is added to Q*K' before softmax
 };
 
 }  // namespace contrib
@@ -21,6 +21,8 @@ struct AttentionParameters {
   int num_heads;
   bool is_unidirectional;
   bool past_present_share_buffer;
+  int rotary_embedding_dim;  // number of elements at the start of each Q/K head rotated by rotary embedding
+  bool use_alibi;            // whether ALiBi position bias is added to Q*K'
 };
 
 }  // namespace contrib
@@ -3,6 +3,11 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
 #include "attention_base.h"
 #include "attention_helper.h"
 
@@ -18,6 +23,27 @@ class AttentionCPUBase : public AttentionBase {
   AttentionCPUBase(const OpKernelInfo& info, bool require_same_hidden_size, bool require_weights)
   : AttentionBase(info, require_same_hidden_size, require_weights) {}
 
+  // Applies rotary position embedding (GPT-NeoX style) in place to the first rotary_embedding_dim elements of
+  // each row of a SxH block of Q or K. Element i of the first half is rotated with element i of the second half
+  // by the angle (past_sequence_length + s) / 10000^(2i / rotary_embedding_dim).
+  static void ApplyRotaryEmbedding(float* data, int sequence_length, int head_size, int rotary_embedding_dim,
+                                   int past_sequence_length) {
+    const int half_dim = rotary_embedding_dim / 2;
+    for (int s = 0; s < sequence_length; s++) {
+      float* row = data + static_cast<size_t>(s) * head_size;
+      const float position = static_cast<float>(past_sequence_length + s);
+      for (int i = 0; i < half_dim; i++) {
+        const float inv_freq = std::pow(10000.0f, -2.0f * i / rotary_embedding_dim);
+        const float cos_value = std::cos(position * inv_freq);
+        const float sin_value = std::sin(position * inv_freq);
+        const float x1 = row[i];
+        const float x2 = row[i + half_dim];
+        row[i] = x1 * cos_value - x2 * sin_value;
+        row[i + half_dim] = x2 * cos_value + x1 * sin_value;
+      }
+    }
+  }
+
   template <typename T>
   Status ApplyAttention(const T* Q,                  // Q data with shape BxNxSxH
                         const T* K,                  // K data with shape BxNxSxH
@@ -31,7 +57,8 @@ class AttentionCPUBase : public AttentionBase {
                         int v_head_size,             // head size of V (H_v)
                         int v_hidden_size,           // hidden size of V (D_v)
                         const Tensor* extra_add_qk,  // extra add in QK. Its size is BxNxSxT
-                        OpKernelContext* context) const {
+                        OpKernelContext* context,
+                        const Tensor* past_seq_len = nullptr) const {  // past sequence length when sharing buffer
     const int kv_sequence_length = sequence_length;
 
     AllocatorPtr allocator;
@@ -40,15 +67,25 @@ class AttentionCPUBase : public AttentionBase {
     auto* tp = context->GetOperatorThreadPool();
 
     int past_sequence_length = 0;
-    Tensor* present = GetPresent(context, past, batch_size, v_head_size, sequence_length, past_sequence_length);
+    Tensor* present = nullptr;
+    const bool use_shared_buffer = past_present_share_buffer_ && past != nullptr;
+    if (use_shared_buffer) {
+      // past and present are the same (2, B, N, M, H) buffer allocated for the max sequence length M. Only the
+      // first past_sequence_length rows of each head are valid, and this step appends its keys and values in place.
+      past_sequence_length = *past_seq_len->Data<int32_t>();
+      present = context->Output(1, past->Shape());
+      if (nullptr == present) {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                               "Expect to have present state output when past state input is given");
+      }
+    } else {
+      present = GetPresent(context, past, batch_size, v_head_size, sequence_length, past_sequence_length);
+    }
 
     // Total sequence length including that of past state: T = P + L
     const int total_sequence_length = past_sequence_length + kv_sequence_length;
-
-    // Compute the attention score.
-    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * total_sequence_length * sizeof(T);
-    auto attention_probs = allocator->Alloc(bytes);
-    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
+    // Number of rows of each head in past and present: M when sharing the buffer, otherwise T.
+    const int max_sequence_length = use_shared_buffer ? static_cast<int>(past->Shape()[3]) : total_sequence_length;
 
     bool has_unidirectional = (is_unidirectional_ && sequence_length > 1);
 
@@ -72,6 +109,31 @@ class AttentionCPUBase : public AttentionBase {
       extra_add_qk_data = extra_add_qk->Data<T>();
     }
 
+    if constexpr (std::is_same<T, float>::value) {
+      // mask_data is nullptr when mask_index is nullptr and not unidirectional, otherwise its shape is BxSxT
+      if (mask_data != nullptr) {
+        PrepareMask(mask_index_data, mask_index_dims, static_cast<T*>(mask_data),
+                    has_unidirectional, batch_size, sequence_length, past_sequence_length);
+      }
+
+      ComputeAttentionTiled(output->MutableData<T>(), Q, K, V,
+                            static_cast<const T*>(mask_data), has_unidirectional,
+                            batch_size, sequence_length, past_sequence_length, max_sequence_length,
+                            qk_head_size == 0 ? v_head_size : qk_head_size, v_head_size, v_hidden_size,
+                            past_data, present_data, extra_add_qk_data, allocator, tp);
+      return Status::OK();
+    }
+
+    if (use_shared_buffer) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                             "past_present_share_buffer is only supported for float in the CPU Attention kernel");
+    }
+
+    // Compute the attention score.
+    size_t bytes = SafeInt<size_t>(batch_size) * num_heads_ * sequence_length * total_sequence_length * sizeof(T);
+    auto attention_probs = allocator->Alloc(bytes);
+    BufferUniquePtr scratch_buffer(attention_probs, BufferDeleter(allocator));
+
     ComputeAttentionProbs<T>(static_cast<T*>(attention_probs), Q, K,
                              mask_index_data, mask_index_dims, static_cast<T*>(mask_data), has_unidirectional,
                              batch_size, sequence_length, past_sequence_length,
@@ -93,6 +155,222 @@ class AttentionCPUBase : public AttentionBase {
   }
 
  private:
+  // ALiBi slope of a head. When num_heads is not a power of 2, the heads after the largest power of 2 get the odd
+  // slopes of twice as many heads, as in the reference implementation.
+  static float AlibiSlope(int head_index, int num_heads) {
+    int closest_power_of_2 = 1;
+    while (closest_power_of_2 * 2 <= num_heads) {
+      closest_power_of_2 *= 2;
+    }
+    if (head_index < closest_power_of_2) {
+      return std::exp2(-8.0f * (head_index + 1) / closest_power_of_2);
+    }
+    return std::exp2(-4.0f * (2 * (head_index - closest_power_of_2) + 1) / closest_power_of_2);
+  }
+
+  // Number of query rows and of key/value rows per tile in ComputeAttentionTiled. A Sq x Tk score tile is 64KB
+  // so it stays in L2 along with the K and V tiles.
+  static constexpr int kAttentionQueryTileSize = 64;
+  static constexpr int kAttentionKeyTileSize = 256;
+
+  // Computes the attention output without materializing the BxNxSxT attention probs, using an online softmax:
+  // for each tile of query rows, the key/value tiles are visited in order while keeping the running max and sum
+  // of each row, and the output rows accumulated so far are rescaled whenever the running max grows.
+  //  output(B, S, N, H_v) = Softmax(1/sqrt(H) x Q x K' + mask_data + extra_add_qk) x V
+  // The scores are computed exactly as in ComputeAttentionProbs.
+  // When max_sequence_length is larger than T, past and present hold M rows per head and the new keys and values
+  // are written after the first P rows instead of concatenating past into a new present.
+  void ComputeAttentionTiled(float* output,                 // output with shape BxSxNxH_v
+                             const float* Q,                // Q data. Its size is BxNxSxH
+                             const float* K,                // K data. Its size is BxNxLxH
+                             const float* V,                // V data. Its size is BxNxLxH_v
+                             const float* mask_data,        // prepared mask with shape BxSxT. nullptr if no mask.
+                             bool has_unidirectional,       // has unidirectional mask
+                             int batch_size,                // batch size of self-attention
+                             int sequence_length,           // sequence length of self-attention
+                             int past_sequence_length,      // sequence length of past state
+                             int max_sequence_length,       // rows per head in past and present (M)
+                             int head_size,                 // head size of Q and K (H)
+                             int v_head_size,               // head size of V (H_v)
+                             int v_hidden_size,             // hidden size of V (D_v)
+                             const float* past,             // past state
+                             float* present,                // present state
+                             const float* extra_add_qk,     // extra add matrix with shape BxNxSxT
+                             const AllocatorPtr& allocator,  // allocator for the per thread tiles
+                             ThreadPool* tp) const {
+    const int total_sequence_length = past_sequence_length + sequence_length;  // T = P + L
+    const ptrdiff_t loop_len = SafeInt<ptrdiff_t>(batch_size) * num_heads_;
+
+    const bool use_shared_buffer = max_sequence_length != total_sequence_length;
+    const size_t k_past_chunk_length = static_cast<size_t>(past_sequence_length) * head_size;         // P x H
+    const size_t k_present_chunk_length = static_cast<size_t>(max_sequence_length) * head_size;       // M x H
+    const size_t v_past_chunk_length = static_cast<size_t>(past_sequence_length) * v_head_size;       // P x H_v
+    const size_t v_present_chunk_length = static_cast<size_t>(max_sequence_length) * v_head_size;     // M x H_v
+    // Move the pointer of past and present to start of v values, as in ComputeVxAttentionScore.
+    const float* past_v = past != nullptr ? past + loop_len * v_past_chunk_length : nullptr;
+    float* present_v = present != nullptr ? present + loop_len * v_present_chunk_length : nullptr;
+
+    if (use_shared_buffer) {
+      // present is normally bound to the buffer of past. If it is not, carry over the whole past state first.
+      if (past != present) {
+        memcpy(present, past, SafeInt<size_t>(loop_len) * (k_present_chunk_length + v_present_chunk_length) *
+                                  sizeof(float));
+      }
+
+      const size_t k_input_chunk_length = static_cast<size_t>(sequence_length) * head_size;    // L x H
+      const size_t v_input_chunk_length = static_cast<size_t>(sequence_length) * v_head_size;  // L x H_v
+      const double append_cost = static_cast<double>(k_input_chunk_length + v_input_chunk_length);
+      ThreadPool::TryParallelFor(tp, loop_len, append_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          memcpy(present + k_present_chunk_length * i + k_past_chunk_length, K + k_input_chunk_length * i,
+                 k_input_chunk_length * sizeof(float));
+          memcpy(present_v + v_present_chunk_length * i + v_past_chunk_length, V + v_input_chunk_length * i,
+                 v_input_chunk_length * sizeof(float));
+        }
+      });
+    } else if (present != nullptr) {
+      // Concatenate past and the new keys and values into present first, as every query tile of a head reads them.
+      const double concat_cost = static_cast<double>(k_present_chunk_length + v_present_chunk_length);
+      ThreadPool::TryParallelFor(tp, loop_len, concat_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t i = begin; i != end; ++i) {
+          ConcatStateChunk(past, K + static_cast<size_t>(sequence_length) * head_size * i, present,
+                           k_past_chunk_length, k_present_chunk_length, i);
+          ConcatStateChunk(past_v, V + static_cast<size_t>(sequence_length) * v_head_size * i, present_v,
+                           v_past_chunk_length, v_present_chunk_length, i);
+        }
+      });
+    }
+
+    const int query_tile_size = std::min(sequence_length, kAttentionQueryTileSize);
+    const int key_tile_size = std::min(total_sequence_length, kAttentionKeyTileSize);
+    const int query_tiles = (sequence_length + query_tile_size - 1) / query_tile_size;
+    const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
+
+    // The cost of both Gemms for a query tile
+    const double cost = static_cast<double>(query_tile_size) * total_sequence_length * (head_size + v_head_size);
+
+    ThreadPool::TryParallelFor(tp, loop_len * query_tiles, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      // scores (Sq x Tk), then the running max and sum of each query row
+      const size_t tile_elements = SafeInt<size_t>(query_tile_size) * key_tile_size + 2 * query_tile_size;
+      auto tile_data = allocator->Alloc(tile_elements * sizeof(float));
+      BufferUniquePtr tile_buffer(tile_data, BufferDeleter(allocator));
+      float* scores = static_cast<float*>(tile_data);
+      float* row_max = scores + static_cast<size_t>(query_tile_size) * key_tile_size;
+      float* row_sum = row_max + query_tile_size;
+
+      for (std::ptrdiff_t task = begin; task != end; ++task) {
+        const std::ptrdiff_t i = task / query_tiles;  // index of (batch, head)
+        const int batch_index = static_cast<int>(i / num_heads_);
+        const int head_index = static_cast<int>(i % num_heads_);
+        const int q_begin = static_cast<int>(task % query_tiles) * query_tile_size;
+        const int q_rows = std::min(query_tile_size, sequence_length - q_begin);
+
+        const float* q = Q + (static_cast<size_t>(i) * sequence_length + q_begin) * head_size;
+        const float* k = present != nullptr ? present + k_present_chunk_length * i
+                                            : K + static_cast<size_t>(sequence_length) * head_size * i;
+        const float* v = present_v != nullptr ? present_v + v_present_chunk_length * i
+                                              : V + static_cast<size_t>(sequence_length) * v_head_size * i;
+
+        // The output rows of this tile accumulate the unnormalized attention x V.
+        float* out = output + ((static_cast<size_t>(batch_index) * sequence_length + q_begin) * num_heads_ +
+                               head_index) *
+                                  v_head_size;
+
+        std::fill_n(row_max, q_rows, -std::numeric_limits<float>::infinity());
+        std::fill_n(row_sum, q_rows, 0.0f);
+
+        for (int k_begin = 0; k_begin < total_sequence_length; k_begin += key_tile_size) {
+          const int k_cols = std::min(key_tile_size, total_sequence_length - k_begin);
+
+          // Broadcast mask data: (Bx)SxT -> (BxNx)SxT
+          const float* mask = mask_data != nullptr
+                                  ? mask_data + (static_cast<size_t>(batch_index) * sequence_length + q_begin) *
+                                                    total_sequence_length +
+                                        k_begin
+                                  : nullptr;
+          if (mask != nullptr) {
+            for (int r = 0; r < q_rows; r++) {
+              memcpy(scores + static_cast<size_t>(r) * k_cols, mask + static_cast<size_t>(r) * total_sequence_length,
+                     static_cast<size_t>(k_cols) * sizeof(float));
+            }
+          }
+
+          // scores = 1/sqrt(H) x Q x K' + mask
+          MlasGemm(CblasNoTrans, CblasTrans, q_rows, k_cols, head_size, alpha,
+                   q, head_size, k + static_cast<size_t>(k_begin) * head_size, head_size,
+                   mask != nullptr ? 1.0f : 0.0f, scores, k_cols, nullptr);
+
+          for (int r = 0; r < q_rows; r++) {
+            float* row = scores + static_cast<size_t>(r) * k_cols;
+            const int s = q_begin + r;
+
+            // Fix unidirectional mask to be parity with huggingface implementation.
+            if (has_unidirectional && mask != nullptr && s < sequence_length - 1) {
+              for (int m = std::max(k_begin, past_sequence_length + s + 1); m < k_begin + k_cols; m++) {
+                row[m - k_begin] = mask[static_cast<size_t>(r) * total_sequence_length + m - k_begin];
+              }
+            }
+
+            if (extra_add_qk != nullptr) {
+              const float* extra = extra_add_qk +
+                                   (static_cast<size_t>(i) * sequence_length + s) * total_sequence_length + k_begin;
+              for (int j = 0; j < k_cols; j++) {
+                row[j] += extra[j];
+              }
+            }
+
+            if (use_alibi_) {
+              const float slope = AlibiSlope(head_index, num_heads_);
+              const int distance = k_begin - (past_sequence_length + s);
+              for (int j = 0; j < k_cols; j++) {
+                row[j] += slope * static_cast<float>(distance + j);
+              }
+            }
+
+            // Online softmax: rescale what was accumulated for this row if its max grows.
+            float tile_max = row_max[r];
+            for (int j = 0; j < k_cols; j++) {
+              tile_max = std::max(tile_max, row[j]);
+            }
+            const float correction = k_begin == 0 ? 0.0f : std::exp(row_max[r] - tile_max);
+            row_max[r] = tile_max;
+
+            for (int j = 0; j < k_cols; j++) {
+              row[j] -= tile_max;
+            }
+            MlasComputeExp(row, row, static_cast<size_t>(k_cols));
+
+            float tile_sum = 0.0f;
+            for (int j = 0; j < k_cols; j++) {
+              tile_sum += row[j];
+            }
+            row_sum[r] = row_sum[r] * correction + tile_sum;
+
+            if (k_begin != 0 && correction != 1.0f) {
+              float* out_row = out + static_cast<size_t>(r) * v_hidden_size;
+              for (int h = 0; h < v_head_size; h++) {
+                out_row[h] *= correction;
+              }
+            }
+          }
+
+          // out += exp(scores - max) x V
+          MlasGemm(CblasNoTrans, CblasNoTrans, q_rows, v_head_size, k_cols, 1.0f,
+                   scores, k_cols, v + static_cast<size_t>(k_begin) * v_head_size, v_head_size,
+                   k_begin == 0 ? 0.0f : 1.0f, out, v_hidden_size, nullptr);
+        }
+
+        for (int r = 0; r < q_rows; r++) {
+          float* out_row = out + static_cast<size_t>(r) * v_hidden_size;
+          const float scale = 1.0f / row_sum[r];
+          for (int h = 0; h < v_head_size; h++) {
+            out_row[h] *= scale;
+          }
+        }
+      }
+    });
+  }
+
   // Helper function to compute the attention probs. It does 2 things:
   //  attention_probs(B, N, S, T) = 1/sqrt(H) x Q(B, N, S, H) x K'(B, N, T, H -> B, N, H, T) +
   //                                1 x mask_data(B, N, S, T)
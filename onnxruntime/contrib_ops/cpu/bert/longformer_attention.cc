@@ -0,0 +1,357 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/bert/longformer_attention.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    LongformerAttention,
+    kMSDomain,
+    1,
+    float,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    LongformerAttention<float>);
+
+namespace {
+
+// Projects the hidden states to the heads of Q, K or V:
+//   dest(B, N, R, H) = input(B, R, D) x weights(D, N x H) + bias(N x H)
+// Only the first row_counts[b] rows of batch b are computed.
+void ComputeHeads(const float* input, const float* weights, int ldb, const float* bias,
+                  gsl::span<const int> row_counts, int rows, int hidden_size, int num_heads, float* dest,
+                  ThreadPool* tp) {
+  const int head_size = hidden_size / num_heads;
+  const std::ptrdiff_t loop_len = SafeInt<std::ptrdiff_t>(row_counts.size()) * num_heads;
+  const double cost = static_cast<double>(rows) * head_size * hidden_size;
+  ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int batch_index = static_cast<int>(i / num_heads);
+      const int head_index = static_cast<int>(i % num_heads);
+      const int row_count = row_counts[batch_index];
+      if (row_count == 0) {
+        continue;
+      }
+
+      float* head = dest + static_cast<size_t>(i) * rows * head_size;
+      for (int r = 0; r < row_count; r++) {
+        memcpy(head + static_cast<size_t>(r) * head_size, bias + head_index * head_size, head_size * sizeof(float));
+      }
+      MlasGemm(CblasNoTrans, CblasNoTrans, row_count, head_size, hidden_size, 1.0f,
+               input + static_cast<size_t>(batch_index) * rows * hidden_size, hidden_size,
+               weights + head_index * head_size, ldb, 1.0f, head, head_size, nullptr);
+    }
+  });
+}
+
+}  // namespace
+
+template <typename T>
+LongformerAttention<T>::LongformerAttention(const OpKernelInfo& info) : OpKernel(info), LongformerAttentionBase(info) {
+}
+
+template <typename T>
+Status LongformerAttention<T>::Compute(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const Tensor* weights = context->Input<Tensor>(1);
+  const Tensor* bias = context->Input<Tensor>(2);
+  const Tensor* attention_mask = context->Input<Tensor>(3);
+  const Tensor* global_weights = context->Input<Tensor>(4);
+  const Tensor* global_bias = context->Input<Tensor>(5);
+  const Tensor* global_attention_mask = context->Input<Tensor>(6);
+  ORT_RETURN_IF_ERROR(CheckInputs(input->Shape(), weights->Shape(), bias->Shape(), attention_mask->Shape(),
+                                  global_weights->Shape(), global_bias->Shape(), global_attention_mask->Shape()));
+
+  const auto& shape = input->Shape();
+  const int batch_size = static_cast<int>(shape[0]);
+  const int sequence_length = static_cast<int>(shape[1]);
+  const int hidden_size = static_cast<int>(shape[2]);
+  const int head_size = hidden_size / num_heads_;
+  const int window = window_;
+
+  Tensor* output = context->Output(0, shape);
+
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  auto* tp = context->GetOperatorThreadPool();
+
+  // Indices of the global tokens of each batch, in the first global_count[b] entries of the row of the batch.
+  const int32_t* global_data = global_attention_mask->Data<int32_t>();
+  std::vector<int> global_index(static_cast<size_t>(batch_size) * sequence_length);
+  std::vector<int> global_count(batch_size, 0);
+  for (int b = 0; b < batch_size; b++) {
+    for (int s = 0; s < sequence_length; s++) {
+      if (global_data[static_cast<size_t>(b) * sequence_length + s] != 0) {
+        global_index[static_cast<size_t>(b) * sequence_length + global_count[b]++] = s;
+      }
+    }
+  }
+  const int max_num_global = *std::max_element(global_count.begin(), global_count.end());
+
+  // Q, K and V with shape (B, N, S, H), then global K and V with shape (B, N, S, H), the hidden states of the
+  // global tokens with shape (B, G, D) and global Q with shape (B, N, G, H).
+  const size_t qkv_elements = SafeInt<size_t>(batch_size) * sequence_length * hidden_size;
+  const size_t global_elements = SafeInt<size_t>(batch_size) * max_num_global * hidden_size;
+  const size_t buffer_elements = max_num_global > 0 ? 5 * qkv_elements + 2 * global_elements : 3 * qkv_elements;
+  auto buffer_data = allocator->Alloc(SafeInt<size_t>(buffer_elements) * sizeof(float));
+  BufferUniquePtr buffer(buffer_data, BufferDeleter(allocator));
+  float* q = static_cast<float*>(buffer_data);
+  float* k = q + qkv_elements;
+  float* v = k + qkv_elements;
+  float* global_k = v + qkv_elements;
+  float* global_v = global_k + qkv_elements;
+  float* global_input = global_v + qkv_elements;
+  float* global_q = global_input + global_elements;
+
+  // Format 1 has merged weights with shape (D, 3D), and format 0 has weights with shape (3, D, D).
+  const bool use_merged_qkv_weights = (weights->Shape().NumDimensions() == 2);
+  const int ldb = use_merged_qkv_weights ? 3 * hidden_size : hidden_size;
+  auto weights_of = [&](const Tensor* tensor, int index) {
+    return tensor->Data<float>() + (use_merged_qkv_weights ? static_cast<size_t>(index) * hidden_size
+                                                           : static_cast<size_t>(index) * hidden_size * hidden_size);
+  };
+  const float* input_data = input->Data<float>();
+  const float* bias_data = bias->Data<float>();
+  const float* global_bias_data = global_bias->Data<float>();
+
+  const std::vector<int> all_rows(batch_size, sequence_length);
+  ComputeHeads(input_data, weights_of(weights, 0), ldb, bias_data, all_rows, sequence_length, hidden_size,
+               num_heads_, q, tp);
+  ComputeHeads(input_data, weights_of(weights, 1), ldb, bias_data + hidden_size, all_rows, sequence_length,
+               hidden_size, num_heads_, k, tp);
+  ComputeHeads(input_data, weights_of(weights, 2), ldb, bias_data + 2 * hidden_size, all_rows, sequence_length,
+               hidden_size, num_heads_, v, tp);
+
+  if (max_num_global > 0) {
+    // Global K and V are only used by the global tokens, so they are skipped for the batches without any.
+    // The bias of global K and V is in the global bias for format 1, and after the bias of V for format 0.
+    std::vector<int> global_rows(batch_size);
+    for (int b = 0; b < batch_size; b++) {
+      global_rows[b] = global_count[b] > 0 ? sequence_length : 0;
+    }
+    const float* global_k_bias = use_merged_qkv_weights ? global_bias_data + hidden_size : bias_data + 3 * hidden_size;
+    const float* global_v_bias = use_merged_qkv_weights ? global_bias_data + 2 * hidden_size
+                                                        : bias_data + 4 * hidden_size;
+    ComputeHeads(input_data, weights_of(global_weights, 1), ldb, global_k_bias, global_rows, sequence_length,
+                 hidden_size, num_heads_, global_k, tp);
+    ComputeHeads(input_data, weights_of(global_weights, 2), ldb, global_v_bias, global_rows, sequence_length,
+                 hidden_size, num_heads_, global_v, tp);
+
+    // Global Q is only computed for the global tokens.
+    for (int b = 0; b < batch_size; b++) {
+      for (int g = 0; g < global_count[b]; g++) {
+        const int s = global_index[static_cast<size_t>(b) * sequence_length + g];
+        memcpy(global_input + (static_cast<size_t>(b) * max_num_global + g) * hidden_size,
+               input_data + (static_cast<size_t>(b) * sequence_length + s) * hidden_size,
+               hidden_size * sizeof(float));
+      }
+    }
+    ComputeHeads(global_input, weights_of(global_weights, 0), ldb, global_bias_data, global_count, max_num_global,
+                 hidden_size, num_heads_, global_q, tp);
+  }
+
+  const float* mask_data = attention_mask->Data<float>();
+  float* output_data = output->MutableData<float>();
+  const float scale = 1.0f / std::sqrt(static_cast<float>(head_size));
+  const size_t head_elements = static_cast<size_t>(sequence_length) * head_size;
+
+  // Local attention of each block of W query rows. The rows of a block attend the band of up to 3W keys around
+  // the block, plus the global tokens outside of their own window:
+  //   scores(W, 3W + G) = 1/sqrt(H) x Q(W, H) x [K_band(3W, H); K_global(G, H)]' + mask
+  //   output(W, H) = Softmax(scores) x [V_band(3W, H); V_global(G, H)]
+  // The rows of the global tokens are computed afterwards by the global attention.
+  {
+    const int blocks = sequence_length / window;
+    const int band_size = 3 * window;
+    const int ld = band_size + max_num_global;
+    const std::ptrdiff_t loop_len = SafeInt<std::ptrdiff_t>(batch_size) * num_heads_ * blocks;
+    const double cost = 2.0 * window * ld * head_size;
+
+    ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      // scores, then K and V of the global tokens
+      const size_t scratch_elements = SafeInt<size_t>(window) * ld + 2 * static_cast<size_t>(max_num_global) * head_size;
+      auto scratch_data = allocator->Alloc(scratch_elements * sizeof(float));
+      BufferUniquePtr scratch_buffer(scratch_data, BufferDeleter(allocator));
+      float* scores = static_cast<float*>(scratch_data);
+      float* global_keys = scores + static_cast<size_t>(window) * ld;
+      float* global_values = global_keys + static_cast<size_t>(max_num_global) * head_size;
+
+      for (std::ptrdiff_t task = begin; task != end; ++task) {
+        const std::ptrdiff_t i = task / blocks;  // index of (batch, head)
+        const int batch_index = static_cast<int>(i / num_heads_);
+        const int head_index = static_cast<int>(i % num_heads_);
+        const int row_begin = static_cast<int>(task % blocks) * window;
+        const int band_begin = std::max(row_begin - window, 0);
+        const int band_end = std::min(row_begin + 2 * window, sequence_length);
+        const int band_length = band_end - band_begin;
+
+        const float* q_head = q + head_elements * i;
+        const float* k_head = k + head_elements * i;
+        const float* v_head = v + head_elements * i;
+        const float* mask = mask_data + static_cast<size_t>(batch_index) * sequence_length;
+        const int32_t* global_flags = global_data + static_cast<size_t>(batch_index) * sequence_length;
+        const int* global_tokens = global_index.data() + static_cast<size_t>(batch_index) * sequence_length;
+        const int num_global = global_count[batch_index];
+
+        MlasGemm(CblasNoTrans, CblasTrans, window, band_length, head_size, scale,
+                 q_head + static_cast<size_t>(row_begin) * head_size, head_size,
+                 k_head + static_cast<size_t>(band_begin) * head_size, head_size, 0.0f, scores, ld, nullptr);
+
+        if (num_global > 0) {
+          for (int g = 0; g < num_global; g++) {
+            memcpy(global_keys + static_cast<size_t>(g) * head_size,
+                   k_head + static_cast<size_t>(global_tokens[g]) * head_size, head_size * sizeof(float));
+            memcpy(global_values + static_cast<size_t>(g) * head_size,
+                   v_head + static_cast<size_t>(global_tokens[g]) * head_size, head_size * sizeof(float));
+          }
+          MlasGemm(CblasNoTrans, CblasTrans, window, num_global, head_size, scale,
+                   q_head + static_cast<size_t>(row_begin) * head_size, head_size,
+                   global_keys, head_size, 0.0f, scores + band_size, ld, nullptr);
+        }
+
+        for (int r = 0; r < window; r++) {
+          const int s = row_begin + r;
+          float* row = scores + static_cast<size_t>(r) * ld;
+          float* global_row = row + band_size;
+
+          // To be consistent with Huggingface Longformer, the rows of masked tokens are zero.
+          if (mask[s] < 0.0f || global_flags[s] != 0) {
+            std::fill_n(row, band_length, 0.0f);
+            std::fill_n(global_row, num_global, 0.0f);
+            continue;
+          }
+
+          // columns of the window of the row within the band
+          const int col_begin = std::max(s - window, 0) - band_begin;
+          const int col_end = std::min(s + window + 1, sequence_length) - band_begin;
+
+          float max_score = -std::numeric_limits<float>::infinity();
+          for (int j = col_begin; j < col_end; j++) {
+            row[j] += mask[band_begin + j];
+            max_score = std::max(max_score, row[j]);
+          }
+          for (int g = 0; g < num_global; g++) {
+            const int t = global_tokens[g];
+            if (t < band_begin + col_begin || t >= band_begin + col_end) {
+              global_row[g] += mask[t];
+              max_score = std::max(max_score, global_row[g]);
+            }
+          }
+
+          std::fill(row, row + col_begin, 0.0f);
+          std::fill(row + col_end, row + band_length, 0.0f);
+          for (int j = col_begin; j < col_end; j++) {
+            row[j] -= max_score;
+          }
+          MlasComputeExp(row + col_begin, row + col_begin, static_cast<size_t>(col_end - col_begin));
+
+          float sum = 0.0f;
+          for (int j = col_begin; j < col_end; j++) {
+            sum += row[j];
+          }
+          for (int g = 0; g < num_global; g++) {
+            const int t = global_tokens[g];
+            // the global tokens within the window are already counted in the band
+            global_row[g] = (t < band_begin + col_begin || t >= band_begin + col_end)
+                                ? std::exp(global_row[g] - max_score)
+                                : 0.0f;
+            sum += global_row[g];
+          }
+
+          const float inverse_sum = 1.0f / sum;
+          for (int j = col_begin; j < col_end; j++) {
+            row[j] *= inverse_sum;
+          }
+          for (int g = 0; g < num_global; g++) {
+            global_row[g] *= inverse_sum;
+          }
+        }
+
+        // The output (B, S, N, H) is written in place, with a stride of D between the rows of a head.
+        float* out = output_data + (static_cast<size_t>(batch_index) * sequence_length + row_begin) * hidden_size +
+                     static_cast<size_t>(head_index) * head_size;
+        MlasGemm(CblasNoTrans, CblasNoTrans, window, head_size, band_length, 1.0f,
+                 scores, ld, v_head + static_cast<size_t>(band_begin) * head_size, head_size,
+                 0.0f, out, hidden_size, nullptr);
+        if (num_global > 0) {
+          MlasGemm(CblasNoTrans, CblasNoTrans, window, head_size, num_global, 1.0f,
+                   scores + band_size, ld, global_values, head_size, 1.0f, out, hidden_size, nullptr);
+        }
+      }
+    });
+  }
+
+  // Global attention of the global tokens, which attend all the tokens:
+  //   scores(G, S) = 1/sqrt(H) x Q_global(G, H) x K_global(S, H)' + mask
+  //   output(G, H) = Softmax(scores) x V_global(S, H)
+  if (max_num_global > 0) {
+    const std::ptrdiff_t loop_len = SafeInt<std::ptrdiff_t>(batch_size) * num_heads_;
+    const double cost = 2.0 * max_num_global * sequence_length * head_size;
+
+    ThreadPool::TryParallelFor(tp, loop_len, cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+      // scores, then the output rows of the global tokens
+      const size_t scratch_elements = SafeInt<size_t>(max_num_global) * (sequence_length + head_size);
+      auto scratch_data = allocator->Alloc(scratch_elements * sizeof(float));
+      BufferUniquePtr scratch_buffer(scratch_data, BufferDeleter(allocator));
+      float* scores = static_cast<float*>(scratch_data);
+      float* context_rows = scores + static_cast<size_t>(max_num_global) * sequence_length;
+
+      for (std::ptrdiff_t i = begin; i != end; ++i) {
+        const int batch_index = static_cast<int>(i / num_heads_);
+        const int head_index = static_cast<int>(i % num_heads_);
+        const int num_global = global_count[batch_index];
+        if (num_global == 0) {
+          continue;
+        }
+
+        const float* mask = mask_data + static_cast<size_t>(batch_index) * sequence_length;
+        const int* global_tokens = global_index.data() + static_cast<size_t>(batch_index) * sequence_length;
+
+        MlasGemm(CblasNoTrans, CblasTrans, num_global, sequence_length, head_size, scale,
+                 global_q + static_cast<size_t>(i) * max_num_global * head_size, head_size,
+                 global_k + head_elements * i, head_size, 0.0f, scores, sequence_length, nullptr);
+        for (int g = 0; g < num_global; g++) {
+          float* row = scores + static_cast<size_t>(g) * sequence_length;
+          for (int s = 0; s < sequence_length; s++) {
+            row[s] += mask[s];
+          }
+        }
+        MlasComputeSoftmax(scores, scores, static_cast<size_t>(num_global), static_cast<size_t>(sequence_length),
+                           false, nullptr);
+        for (int g = 0; g < num_global; g++) {
+          if (mask[global_tokens[g]] < 0.0f) {
+            std::fill_n(scores + static_cast<size_t>(g) * sequence_length, sequence_length, 0.0f);
+          }
+        }
+
+        MlasGemm(CblasNoTrans, CblasNoTrans, num_global, head_size, sequence_length, 1.0f,
+                 scores, sequence_length, global_v + head_elements * i, head_size,
+                 0.0f, context_rows, head_size, nullptr);
+        for (int g = 0; g < num_global; g++) {
+          memcpy(output_data + (static_cast<size_t>(batch_index) * sequence_length + global_tokens[g]) * hidden_size +
+                     static_cast<size_t>(head_index) * head_size,
+                 context_rows + static_cast<size_t>(g) * head_size, head_size * sizeof(float));
+        }
+      }
+    });
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
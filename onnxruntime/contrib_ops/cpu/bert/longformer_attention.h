@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+#include "contrib_ops/cpu/bert/longformer_attention_base.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Sliding window attention of Longformer. A local token attends the tokens within the window of W tokens on each
+// side and the global tokens, and a global token attends all the tokens with the global projections. The scores
+// are computed for blocks of W query rows against the band of 3W keys around them, so memory is linear in the
+// sequence length.
+template <typename T>
+class LongformerAttention final : public OpKernel, public LongformerAttentionBase {
+ public:
+  LongformerAttention(const OpKernelInfo& info);
+  Status Compute(OpKernelContext* context) const override;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
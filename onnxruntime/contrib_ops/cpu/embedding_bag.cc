@@ -0,0 +1,252 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/embedding_bag.h"
+
+#include <algorithm>
+#include <type_traits>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+#include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    EmbeddingBag,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T", {DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<MLFloat16>(),
+                              DataTypeImpl::GetTensorType<int8_t>(), DataTypeImpl::GetTensorType<uint8_t>()})
+        .TypeConstraint("Tind", {DataTypeImpl::GetTensorType<int32_t>(), DataTypeImpl::GetTensorType<int64_t>()})
+        .TypeConstraint("T1", {DataTypeImpl::GetTensorType<float>(), DataTypeImpl::GetTensorType<MLFloat16>()}),
+    EmbeddingBag);
+
+namespace {
+
+// the rows of a bag are at random places in a table that is usually much larger than the caches, so the loads of
+// the rows this far ahead are started while the current row is added
+constexpr int64_t kPrefetchDistance = 8;
+
+// only the start of a long row is prefetched, the hardware prefetcher follows the rest of it
+constexpr size_t kMaxPrefetchBytes = 1024;
+constexpr size_t kCacheLineSize = 64;
+
+inline void PrefetchRow(const void* row, size_t row_bytes) {
+  const char* p = static_cast<const char*>(row);
+  const size_t bytes = std::min(row_bytes, kMaxPrefetchBytes);
+  for (size_t offset = 0; offset < bytes; offset += kCacheLineSize) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(p + offset, _MM_HINT_T0);
+#elif defined(__GNUC__)
+    __builtin_prefetch(p + offset, 0, 3);
+#else
+    ORT_UNUSED_PARAMETER(p);
+#endif
+  }
+}
+
+struct FloatRows {
+  using TOut = float;
+
+  const float* table;
+  int64_t dim;
+
+  const float* Row(int64_t r) const { return table + r * dim; }
+
+  void Add(int64_t r, float* acc, float* /*buffer*/) const {
+    const float* row = Row(r);
+    for (int64_t i = 0; i < dim; ++i) {
+      acc[i] += row[i];
+    }
+  }
+};
+
+struct HalfRows {
+  using TOut = MLFloat16;
+
+  const MLFloat16* table;
+  int64_t dim;
+
+  const MLFloat16* Row(int64_t r) const { return table + r * dim; }
+
+  void Add(int64_t r, float* acc, float* buffer) const {
+    MlasConvertHalfToFloatBuffer(&Row(r)->val, buffer, narrow<size_t>(dim));
+    for (int64_t i = 0; i < dim; ++i) {
+      acc[i] += buffer[i];
+    }
+  }
+};
+
+template <typename T>
+struct QuantizedRows {
+  using TOut = float;
+
+  const T* table;
+  const float* scale;
+  const T* zero_point;  // nullptr for symmetric tables
+  int64_t dim;
+
+  const T* Row(int64_t r) const { return table + r * dim; }
+
+  void Add(int64_t r, float* acc, float* /*buffer*/) const {
+    const T* row = Row(r);
+    const float s = scale[r];
+    const float bias = zero_point != nullptr ? -s * static_cast<float>(zero_point[r]) : 0.0f;
+    for (int64_t i = 0; i < dim; ++i) {
+      acc[i] += s * static_cast<float>(row[i]) + bias;
+    }
+  }
+};
+
+template <typename Rows, typename TIndex>
+void ReduceBags(const Rows& rows, const TIndex* indices, int64_t num_embeddings, int64_t num_bags,
+                int64_t bag_size, bool mean, typename Rows::TOut* output, concurrency::ThreadPool* tp) {
+  using TOut = typename Rows::TOut;
+  constexpr bool kAccumulateInOutput = std::is_same_v<TOut, float>;
+
+  const int64_t dim = rows.dim;
+  const int64_t num_indices = num_bags * bag_size;
+  const size_t row_bytes = narrow<size_t>(dim) * sizeof(*rows.Row(0));
+  const float mean_scale = bag_size > 0 ? 1.0f / static_cast<float>(bag_size) : 1.0f;
+
+  auto row_index = [&](int64_t flat_index) {
+    const int64_t idx = static_cast<int64_t>(indices[flat_index]);
+    return idx < 0 ? idx + num_embeddings : idx;
+  };
+
+  const TensorOpCost cost{static_cast<double>(bag_size * row_bytes),
+                          static_cast<double>(dim * sizeof(TOut)),
+                          static_cast<double>(bag_size * dim)};
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(num_bags), cost, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // the float accumulator of the half precision output and the converted rows of a half precision table
+        std::vector<float> buffer(2 * narrow<size_t>(dim));
+
+        const int64_t flat_end = std::min(num_indices, static_cast<int64_t>(last) * bag_size + kPrefetchDistance);
+        for (int64_t j = first * bag_size; j < std::min(flat_end, first * bag_size + kPrefetchDistance); ++j) {
+          PrefetchRow(rows.Row(row_index(j)), row_bytes);
+        }
+
+        for (std::ptrdiff_t bag = first; bag < last; ++bag) {
+          TOut* y = output + bag * dim;
+          float* acc = kAccumulateInOutput ? reinterpret_cast<float*>(y) : buffer.data();
+          std::fill_n(acc, narrow<size_t>(dim), 0.0f);
+
+          const int64_t bag_start = bag * bag_size;
+          for (int64_t j = bag_start; j < bag_start + bag_size; ++j) {
+            if (j + kPrefetchDistance < flat_end) {
+              PrefetchRow(rows.Row(row_index(j + kPrefetchDistance)), row_bytes);
+            }
+            rows.Add(row_index(j), acc, buffer.data() + dim);
+          }
+
+          if (mean) {
+            for (int64_t i = 0; i < dim; ++i) {
+              acc[i] *= mean_scale;
+            }
+          }
+
+          if constexpr (!kAccumulateInOutput) {
+            MlasConvertFloatToHalfBuffer(acc, &y->val, narrow<size_t>(dim));
+          }
+        }
+      });
+}
+
+}  // namespace
+
+EmbeddingBag::EmbeddingBag(const OpKernelInfo& info) : OpKernel(info) {
+  const std::string mode = info.GetAttrOrDefault<std::string>("mode", "sum");
+  ORT_ENFORCE(mode == "sum" || mode == "mean", "EmbeddingBag mode must be 'sum' or 'mean', got ", mode);
+  mean_ = mode == "mean";
+  keepdims_ = info.GetAttrOrDefault<int64_t>("keepdims", 0) != 0;
+}
+
+Status EmbeddingBag::Compute(OpKernelContext* context) const {
+  if (context->Input<Tensor>(1)->IsDataType<int32_t>()) {
+    return ComputeImpl<int32_t>(context);
+  }
+  return ComputeImpl<int64_t>(context);
+}
+
+template <typename TIndex>
+Status EmbeddingBag::ComputeImpl(OpKernelContext* context) const {
+  const Tensor& table = *context->Input<Tensor>(0);
+  const Tensor& indices = *context->Input<Tensor>(1);
+  const Tensor* scale = context->Input<Tensor>(2);
+  const Tensor* zero_point = context->Input<Tensor>(3);
+
+  const auto& table_shape = table.Shape();
+  const auto& indices_shape = indices.Shape();
+  ORT_RETURN_IF_NOT(table_shape.NumDimensions() == 2, "EmbeddingBag table must be 2D, got ", table_shape);
+  ORT_RETURN_IF_NOT(indices_shape.NumDimensions() >= 1, "EmbeddingBag indices must have at least one dimension.");
+
+  const int64_t num_embeddings = table_shape[0];
+  const int64_t dim = table_shape[1];
+  const size_t bag_axis = indices_shape.NumDimensions() - 1;
+  const int64_t bag_size = indices_shape[bag_axis];
+  const int64_t num_bags = indices_shape.SizeToDimension(bag_axis);
+
+  TensorShapeVector output_dims(indices_shape.GetDims().begin(), indices_shape.GetDims().end() - 1);
+  if (keepdims_) {
+    output_dims.push_back(1);
+  }
+  output_dims.push_back(dim);
+  Tensor& Y = *context->Output(0, TensorShape(output_dims));
+  if (Y.Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  const TIndex* indices_data = indices.Data<TIndex>();
+  for (int64_t i = 0, n = indices_shape.Size(); i < n; ++i) {
+    const int64_t idx = static_cast<int64_t>(indices_data[i]);
+    if (idx < -num_embeddings || idx >= num_embeddings) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "indices element out of data bounds, idx=", idx,
+                             " must be within the inclusive range [", -num_embeddings, ",", num_embeddings - 1, "]");
+    }
+  }
+
+  const bool is_quantized = table.IsDataType<int8_t>() || table.IsDataType<uint8_t>();
+  if (is_quantized) {
+    ORT_RETURN_IF_NOT(scale != nullptr && scale->Shape() == TensorShape({num_embeddings}),
+                      "EmbeddingBag with an 8-bit table requires a scale of shape (", num_embeddings, ").");
+    ORT_RETURN_IF_NOT(zero_point == nullptr || zero_point->Shape() == TensorShape({num_embeddings}),
+                      "EmbeddingBag zero_point must have shape (", num_embeddings, ").");
+  } else {
+    ORT_RETURN_IF_NOT(scale == nullptr && zero_point == nullptr,
+                      "EmbeddingBag scale and zero_point are only used with 8-bit tables.");
+  }
+
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+
+  if (table.IsDataType<float>()) {
+    ReduceBags(FloatRows{table.Data<float>(), dim}, indices_data, num_embeddings, num_bags, bag_size, mean_,
+               Y.MutableData<float>(), tp);
+  } else if (table.IsDataType<MLFloat16>()) {
+    ReduceBags(HalfRows{table.Data<MLFloat16>(), dim}, indices_data, num_embeddings, num_bags, bag_size, mean_,
+               Y.MutableData<MLFloat16>(), tp);
+  } else if (table.IsDataType<int8_t>()) {
+    const int8_t* zero_point_data = zero_point != nullptr ? zero_point->Data<int8_t>() : nullptr;
+    ReduceBags(QuantizedRows<int8_t>{table.Data<int8_t>(), scale->Data<float>(), zero_point_data, dim},
+               indices_data, num_embeddings, num_bags, bag_size, mean_, Y.MutableData<float>(), tp);
+  } else {
+    const uint8_t* zero_point_data = zero_point != nullptr ? zero_point->Data<uint8_t>() : nullptr;
+    ReduceBags(QuantizedRows<uint8_t>{table.Data<uint8_t>(), scale->Data<float>(), zero_point_data, dim},
+               indices_data, num_embeddings, num_bags, bag_size, mean_, Y.MutableData<float>(), tp);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
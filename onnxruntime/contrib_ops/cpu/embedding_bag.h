@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Gathers rows of an embedding table and reduces each bag of rows as they are read, so the gathered rows are never
+// written to a tensor. The table can be float, float16 or 8-bit with a scale and zero point per row.
+class EmbeddingBag final : public OpKernel {
+ public:
+  explicit EmbeddingBag(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  template <typename TIndex>
+  Status ComputeImpl(OpKernelContext* context) const;
+
+  bool mean_;
+  bool keepdims_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,207 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_elementwise.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+ONNX_OPERATOR_KERNEL_EX(
+    FusedElementwise,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    FusedElementwise);
+
+namespace {
+
+// the number of elements processed at a time, small enough for the values of a block to stay in the L1/L2 cache
+constexpr int64_t kBlockSize = 1024;
+
+void ComputeStep(FusedElementwise::Op op, const float* a, const float* b, float* y, int64_t count) {
+  using Op = FusedElementwise::Op;
+  switch (op) {
+    case Op::Add:
+      for (int64_t i = 0; i < count; ++i) y[i] = a[i] + b[i];
+      break;
+    case Op::Sub:
+      for (int64_t i = 0; i < count; ++i) y[i] = a[i] - b[i];
+      break;
+    case Op::Mul:
+      for (int64_t i = 0; i < count; ++i) y[i] = a[i] * b[i];
+      break;
+    case Op::Div:
+      for (int64_t i = 0; i < count; ++i) y[i] = a[i] / b[i];
+      break;
+    case Op::Relu:
+      for (int64_t i = 0; i < count; ++i) y[i] = std::max(a[i], 0.0f);
+      break;
+    case Op::Sigmoid:
+      MlasComputeLogistic(a, y, narrow<size_t>(count));
+      break;
+    case Op::Tanh:
+      MlasComputeTanh(a, y, narrow<size_t>(count));
+      break;
+    case Op::Neg:
+      for (int64_t i = 0; i < count; ++i) y[i] = -a[i];
+      break;
+    case Op::Abs:
+      for (int64_t i = 0; i < count; ++i) y[i] = std::abs(a[i]);
+      break;
+    case Op::Sqrt:
+      for (int64_t i = 0; i < count; ++i) y[i] = std::sqrt(a[i]);
+      break;
+  }
+}
+
+}  // namespace
+
+bool FusedElementwise::TryParseOp(const std::string& op_type, Op& op) {
+  static const InlinedHashMap<std::string, Op> ops{
+      {"Add", Op::Add}, {"Sub", Op::Sub}, {"Mul", Op::Mul}, {"Div", Op::Div}, {"Relu", Op::Relu},
+      {"Sigmoid", Op::Sigmoid}, {"Tanh", Op::Tanh}, {"Neg", Op::Neg}, {"Abs", Op::Abs}, {"Sqrt", Op::Sqrt}};
+
+  auto it = ops.find(op_type);
+  if (it == ops.end()) {
+    return false;
+  }
+
+  op = it->second;
+  return true;
+}
+
+FusedElementwise::FusedElementwise(const OpKernelInfo& info) : OpKernel(info) {
+  const auto op_types = info.GetAttrsOrDefault<std::string>("ops");
+  const auto operands = info.GetAttrsOrDefault<int64_t>("operands");
+  ORT_ENFORCE(!op_types.empty() && operands.size() == 2 * op_types.size(),
+              "FusedElementwise requires at least one op and two operands per op.");
+
+  const auto num_inputs = static_cast<int64_t>(info.GetInputCount());
+  for (size_t i = 0; i < op_types.size(); ++i) {
+    Step step{};
+    ORT_ENFORCE(TryParseOp(op_types[i], step.op), "Unsupported op in FusedElementwise: ", op_types[i]);
+    step.lhs = operands[2 * i];
+    step.rhs = operands[2 * i + 1];
+
+    // the operands must refer to an input or to the result of an earlier step
+    const int64_t num_values = num_inputs + static_cast<int64_t>(i);
+    ORT_ENFORCE(step.lhs >= 0 && step.lhs < num_values, "Invalid operand ", step.lhs, " of step ", i);
+    ORT_ENFORCE(IsUnary(step.op) ? step.rhs == -1 : (step.rhs >= 0 && step.rhs < num_values),
+                "Invalid operand ", step.rhs, " of step ", i);
+    steps_.push_back(step);
+  }
+}
+
+Status FusedElementwise::Compute(OpKernelContext* context) const {
+  const int num_inputs = context->InputCount();
+
+  size_t rank = 0;
+  for (int i = 0; i < num_inputs; ++i) {
+    rank = std::max(rank, context->Input<Tensor>(i)->Shape().NumDimensions());
+  }
+
+  TensorShapeVector output_dims(rank, 1);
+  for (int i = 0; i < num_inputs; ++i) {
+    const auto& shape = context->Input<Tensor>(i)->Shape();
+    const size_t offset = rank - shape.NumDimensions();
+    for (size_t d = 0; d < shape.NumDimensions(); ++d) {
+      const int64_t dim = shape[d];
+      auto& output_dim = output_dims[offset + d];
+      if (dim != 1) {
+        ORT_RETURN_IF_NOT(output_dim == 1 || output_dim == dim, "FusedElementwise inputs are not broadcastable.");
+        output_dim = dim;
+      }
+    }
+  }
+
+  Tensor& Y = *context->Output(0, TensorShape(output_dims));
+  const int64_t output_size = Y.Shape().Size();
+  if (output_size == 0) {
+    return Status::OK();
+  }
+
+  InlinedVector<const float*> input_data;
+  InlinedVector<int64_t> input_sizes;
+  for (int i = 0; i < num_inputs; ++i) {
+    const auto& X = *context->Input<Tensor>(i);
+    const auto& shape = X.Shape();
+    const int64_t size = shape.Size();
+
+    // the data is repeated if the shape without leading ones matches the trailing dims of the output
+    if (size != output_size && size != 1) {
+      size_t first_dim = 0;
+      while (first_dim < shape.NumDimensions() && shape[first_dim] == 1) {
+        ++first_dim;
+      }
+
+      const size_t offset = rank - shape.NumDimensions();
+      for (size_t d = first_dim; d < shape.NumDimensions(); ++d) {
+        ORT_RETURN_IF_NOT(shape[d] == output_dims[offset + d], "FusedElementwise input ", i, " with shape ", shape,
+                          " can not be broadcast to ", Y.Shape(), " by repeating it.");
+      }
+    }
+
+    input_data.push_back(X.Data<float>());
+    input_sizes.push_back(size);
+  }
+
+  float* output_data = Y.MutableData<float>();
+  const size_t num_values = num_inputs + steps_.size();
+  const int64_t block_count = (output_size + kBlockSize - 1) / kBlockSize;
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(block_count),
+      [&](std::ptrdiff_t block_idx) {
+        const int64_t start = block_idx * kBlockSize;
+        const int64_t count = std::min(kBlockSize, output_size - start);
+
+        // holds the repeated inputs and the results of the steps for this block
+        std::vector<float> buffer(num_values * kBlockSize);
+        InlinedVector<const float*> values(num_values);
+
+        for (int i = 0; i < num_inputs; ++i) {
+          const float* data = input_data[i];
+          const int64_t size = input_sizes[i];
+          if (size == output_size) {
+            values[i] = data + start;
+            continue;
+          }
+
+          float* repeated = buffer.data() + i * kBlockSize;
+          if (size == 1) {
+            std::fill_n(repeated, count, data[0]);
+          } else {
+            int64_t offset = start % size;
+            for (int64_t j = 0; j < count; ++j) {
+              repeated[j] = data[offset];
+              if (++offset == size) {
+                offset = 0;
+              }
+            }
+          }
+          values[i] = repeated;
+        }
+
+        for (size_t s = 0; s < steps_.size(); ++s) {
+          const Step& step = steps_[s];
+          const size_t value_idx = num_inputs + s;
+          float* result = s + 1 == steps_.size() ? output_data + start : buffer.data() + value_idx * kBlockSize;
+          ComputeStep(step.op, values[step.lhs], IsUnary(step.op) ? nullptr : values[step.rhs], result, count);
+          values[value_idx] = result;
+        }
+      },
+      0);
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Runs a chain of elementwise operators block by block, so the intermediate results of a block stay in the cache
+// instead of being written to full tensors.
+class FusedElementwise final : public OpKernel {
+ public:
+  enum class Op : uint8_t {
+    Add,
+    Sub,
+    Mul,
+    Div,
+    Relu,
+    Sigmoid,
+    Tanh,
+    Neg,
+    Abs,
+    Sqrt,
+  };
+
+  // the inputs of a chain implicitly broadcast by repeating their data, all other broadcasts are not supported
+  struct Step {
+    Op op;
+    int64_t lhs;
+    int64_t rhs;  // -1 for unary operators
+  };
+
+  explicit FusedElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+  // returns false if op_type is not supported
+  static bool TryParseOp(const std::string& op_type, Op& op);
+
+  static bool IsUnary(Op op) { return op >= Op::Relu; }
+
+ private:
+  InlinedVector<Step> steps_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -14,6 +14,22 @@ class FusedGemm final : public Gemm<T> {
  public:
   FusedGemm(const OpKernelInfo& info) : Gemm<T>(info) {
     std::string activation = info.GetAttrOrDefault<std::string>("activation", "");
+
+    // Activations without parameters are applied by MLAS to each tile of the output while it is in the cache.
+    // GELU is only available this way.
+    static const std::unordered_map<std::string, MLAS_ACTIVATION_KIND> mlas_activations{
+        {"Relu", MlasReluActivation},
+        {"Tanh", MlasTanhActivation},
+        {"Sigmoid", MlasLogisticActivation},
+        {"Gelu", MlasGeluActivation},
+        {"FastGelu", MlasFastGeluActivation},
+    };
+    auto mlas_activation = mlas_activations.find(activation);
+    if (mlas_activation != mlas_activations.end()) {
+      this->mlas_activation_.ActivationKind = mlas_activation->second;
+      return;
+    }
+
     NodeAttributes attrs;
     for (const auto& p : info.node().GetAttributes()) {
       if (p.first.size() > ACTIVATION_NAME_PREFIX_LEN && p.first.compare(0, ACTIVATION_NAME_PREFIX_LEN, ACTIVATION_NAME_PREFIX) == 0) {
@@ -0,0 +1,329 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cpu/fused_activation.h"
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/nn/conv_attributes.h"
+#include "core/util/math.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// Convolution of a channels last (NHWC) input with an optional fused activation. Depthwise convolutions use the MLAS
+// depthwise kernel, the others an NHWC im2col transform and a GEMM per group. Pointwise convolutions with unit
+// strides and no padding multiply the input in place.
+class NhwcConvFloat final : public OpKernel {
+ public:
+  explicit NhwcConvFloat(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
+    ORT_ENFORCE(GetFusedActivationAttr(info, activation_).IsOK());
+  }
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Reorders the filter from [M][C/group][kernel_size] to [kernel_size][C/group][M], which is the GEMM B matrix of
+  // every group with a leading dimension of M, and for a depthwise convolution the [kernel_size][C] layout of the
+  // MLAS depthwise kernel.
+  static void ReorderFilter(const float* input, float* output, size_t output_channels, size_t input_channels,
+                            size_t kernel_size) {
+    for (size_t k = 0; k < kernel_size; k++) {
+      for (size_t ic = 0; ic < input_channels; ic++) {
+        for (size_t oc = 0; oc < output_channels; oc++) {
+          *output++ = input[(oc * input_channels * kernel_size) + (ic * kernel_size) + k];
+        }
+      }
+    }
+  }
+
+  ConvAttributes conv_attrs_;
+  MLAS_ACTIVATION activation_;
+  TensorShape W_shape_;
+  BufferUniquePtr reordered_W_buffer_;
+};
+
+ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(
+    NhwcConv,
+    1,
+    float,
+    KernelDefBuilder()
+        .TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    NhwcConvFloat);
+
+Status NhwcConvFloat::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                              /*out*/ bool& is_packed,
+                              /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+
+  const auto& shape = tensor.Shape();
+  if (input_idx != 1 || shape.NumDimensions() <= 2 || shape[0] % conv_attrs_.group != 0) {
+    return Status::OK();
+  }
+
+  const size_t output_channels = narrow<size_t>(shape[0]);
+  const size_t group_input_channels = narrow<size_t>(shape[1]);
+  const size_t kernel_size = narrow<size_t>(shape.SizeFromDimension(2));
+
+  auto* reordered_W = static_cast<float*>(alloc->Alloc(SafeInt<size_t>(sizeof(float)) * shape.Size()));
+  reordered_W_buffer_ = BufferUniquePtr(reordered_W, BufferDeleter(std::move(alloc)));
+  ReorderFilter(tensor.Data<float>(), reordered_W, output_channels, group_input_channels, kernel_size);
+
+  W_shape_ = shape;
+  is_packed = true;
+  return Status::OK();
+}
+
+Status NhwcConvFloat::Compute(OpKernelContext* context) const {
+  const Tensor* X = context->Input<Tensor>(0);
+  const Tensor* W = reordered_W_buffer_ ? nullptr : context->Input<Tensor>(1);
+  const Tensor* B = context->Input<Tensor>(2);  // optional. nullptr if not provided
+  const TensorShape& W_shape = W ? W->Shape() : W_shape_;
+
+  ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X->Shape(), W_shape, true));
+
+  const int64_t N = X->Shape()[0];
+  const int64_t M = W_shape[0];
+
+  TensorShapeVector kernel_shape;
+  ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W_shape, kernel_shape));
+  const size_t kernel_rank = kernel_shape.size();
+
+  ConvAttributes::ConvPadVector pads(conv_attrs_.pads);
+  if (pads.empty()) {
+    pads.resize(kernel_rank * 2, 0);
+  }
+  TensorShapeVector dilations(conv_attrs_.dilations);
+  if (dilations.empty()) {
+    dilations.resize(kernel_rank, 1);
+  }
+  TensorShapeVector strides(conv_attrs_.strides);
+  if (strides.empty()) {
+    strides.resize(kernel_rank, 1);
+  }
+
+  const int64_t C = X->Shape()[1 + kernel_rank];
+  TensorShape input_shape = X->Shape().Slice(1, 1 + kernel_rank);
+
+  TensorShapeVector Y_dims({N});
+  ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
+  Y_dims.push_back(M);
+  Tensor* Y = context->Output(0, TensorShape(Y_dims));
+  TensorShape output_shape = Y->Shape().Slice(1, 1 + kernel_rank);
+
+  // Bail out early if one of the dimensions is zero.
+  if (Y->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  const int64_t input_image_size = input_shape.Size();
+  const int64_t output_image_size = output_shape.Size();
+  const int64_t kernel_size = TensorShape(kernel_shape).Size();
+
+  // Reorder the filter if it couldn't be packed ahead of time.
+  const float* reordered_W = static_cast<const float*>(reordered_W_buffer_.get());
+  BufferUniquePtr reordered_W_buffer;
+  if (reordered_W == nullptr) {
+    auto* reordered_W_data = static_cast<float*>(alloc->Alloc(SafeInt<size_t>(sizeof(float)) * W_shape.Size()));
+    reordered_W_buffer = BufferUniquePtr(reordered_W_data, BufferDeleter(alloc));
+    ReorderFilter(W->Data<float>(), reordered_W_data, narrow<size_t>(M), narrow<size_t>(W_shape[1]),
+                  narrow<size_t>(kernel_size));
+    reordered_W = reordered_W_data;
+  }
+
+  const int64_t group_count = conv_attrs_.group;
+  const int64_t group_input_channels = W_shape[1];
+  const int64_t group_output_channels = M / group_count;
+  const int64_t kernel_dim = group_input_channels * kernel_size;
+  const int64_t col_buffer_size = kernel_dim * output_image_size;
+
+  const bool is_depthwise_conv = (group_input_channels == 1 && group_output_channels == 1);
+
+  const auto* Xdata = X->Data<float>();
+  const auto* Bdata = B != nullptr ? B->Data<float>() : nullptr;
+  auto* Ydata = Y->MutableData<float>();
+
+  // Depthwise convolutions address the input through an indirection buffer, the other convolutions need an im2col
+  // buffer unless they are pointwise.
+  BufferUniquePtr col_buffer;
+  BufferUniquePtr indirection_buffer;
+  std::vector<float> padding_data;
+
+  if (is_depthwise_conv) {
+    auto* indirection_data = alloc->Alloc(SafeInt<size_t>(sizeof(const float*)) * kernel_size * output_image_size);
+    indirection_buffer = BufferUniquePtr(indirection_data, BufferDeleter(alloc));
+    padding_data.resize(narrow<size_t>(C), 0.0f);
+  } else if (kernel_size != 1 || !conv_attrs_.HasStridesOneAndNoPadding()) {
+    const int64_t group_col_buffer_size = (kernel_rank > 2) ? group_count * col_buffer_size : col_buffer_size;
+    auto* col_data = alloc->Alloc(SafeInt<size_t>(sizeof(float)) * group_col_buffer_size);
+    col_buffer = BufferUniquePtr(col_data, BufferDeleter(alloc));
+  }
+
+  concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
+
+  // Partition the output pixels so that each task does a minimum amount of work, and large images are split into a
+  // few tasks per thread to balance the load.
+  constexpr int64_t kMinimumTaskComplexity = 64 * 1024;
+  const int64_t pixel_complexity = std::max<int64_t>(is_depthwise_conv ? M * kernel_size : M * kernel_dim, 1);
+  const int64_t degree_of_parallelism = concurrency::ThreadPool::DegreeOfParallelism(thread_pool);
+  const int64_t output_stride =
+      std::max((kMinimumTaskComplexity + pixel_complexity - 1) / pixel_complexity,
+               (output_image_size + 4 * degree_of_parallelism - 1) / (4 * degree_of_parallelism));
+  const int64_t task_count = (output_image_size + output_stride - 1) / output_stride;
+
+  for (int64_t image_id = 0; image_id < N; ++image_id) {
+    const float* input_data = Xdata + image_id * input_image_size * C;
+    float* output_data = Ydata + image_id * output_image_size * M;
+
+    // Threaded implementation of ND convolution is not yet supported, so
+    // prepare all im2col transformations here.
+    if (col_buffer && kernel_rank > 2) {
+      for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+        math::Im2col<float, StorageOrder::NHWC>()(
+            input_data + group_id * group_input_channels,
+            group_input_channels,
+            C,
+            input_shape.GetDims().data(),
+            output_shape.GetDims().data(),
+            kernel_shape.data(),
+            strides.data(),
+            dilations.data(),
+            pads.data(),
+            static_cast<ptrdiff_t>(kernel_rank),
+            static_cast<float*>(col_buffer.get()) + group_id * col_buffer_size);
+      }
+    }
+
+    auto conv_worker = [&](ptrdiff_t task) {
+      const int64_t output_start = task * output_stride;
+      const int64_t output_count = std::min(output_stride, output_image_size - output_start);
+      float* worker_output = output_data + output_start * M;
+
+      if (is_depthwise_conv) {
+        auto* worker_indirection_buffer =
+            static_cast<const float**>(indirection_buffer.get()) + output_start * kernel_size;
+        math::Im2col<float, StorageOrder::NHWC>()(
+            input_data,
+            C,
+            input_shape.GetDims().data(),
+            output_shape.GetDims().data(),
+            kernel_shape.data(),
+            strides.data(),
+            dilations.data(),
+            pads.data(),
+            static_cast<ptrdiff_t>(kernel_rank),
+            output_start,
+            output_count,
+            worker_indirection_buffer,
+            padding_data.data());
+
+        MlasConvDepthwise(worker_indirection_buffer, reordered_W, Bdata, worker_output, narrow<size_t>(M),
+                          narrow<size_t>(output_count), narrow<size_t>(kernel_size), &activation_);
+        return;
+      }
+
+      // The GEMMs accumulate into the output rows, which start from the bias.
+      float beta = 0.0f;
+      if (Bdata != nullptr) {
+        for (int64_t i = 0; i < output_count; ++i) {
+          std::copy_n(Bdata, narrow<size_t>(M), worker_output + i * M);
+        }
+        beta = 1.0f;
+      }
+
+      for (int64_t group_id = 0; group_id < group_count; ++group_id) {
+        // Prepare the im2col transformation or use the input buffer directly for
+        // pointwise convolutions.
+        const float* group_input_data = input_data + group_id * group_input_channels;
+        const float* AData;
+        size_t lda;
+        if (col_buffer) {
+          auto* worker_col_buffer = static_cast<float*>(col_buffer.get()) + output_start * kernel_dim;
+          if (kernel_rank == 2) {
+            math::Im2col<float, StorageOrder::NHWC>()(
+                group_input_data,
+                group_input_channels,
+                C,
+                input_shape[0],
+                input_shape[1],
+                kernel_shape[0],
+                kernel_shape[1],
+                dilations[0],
+                dilations[1],
+                pads[0],
+                pads[1],
+                strides[0],
+                strides[1],
+                output_shape[1],
+                output_start,
+                output_count,
+                worker_col_buffer);
+          } else if (kernel_rank == 1) {
+            math::Im2col<float, StorageOrder::NHWC>()(
+                group_input_data,
+                group_input_channels,
+                C,
+                1,
+                input_shape[0],
+                1,
+                kernel_shape[0],
+                1,
+                dilations[0],
+                0,
+                pads[0],
+                1,
+                strides[0],
+                output_shape[0],
+                output_start,
+                output_count,
+                worker_col_buffer);
+          } else {
+            // Use the im2col buffer prepared outside the thread, indexed by group.
+            worker_col_buffer += group_id * col_buffer_size;
+          }
+          AData = worker_col_buffer;
+          lda = narrow<size_t>(kernel_dim);
+        } else {
+          AData = group_input_data + output_start * C;
+          lda = narrow<size_t>(C);
+        }
+
+        MlasGemm(CblasNoTrans,
+                 CblasNoTrans,
+                 narrow<size_t>(output_count),
+                 narrow<size_t>(group_output_channels),
+                 narrow<size_t>(kernel_dim),
+                 1.0f,
+                 AData,
+                 lda,
+                 reordered_W + group_id * group_output_channels,
+                 narrow<size_t>(M),
+                 beta,
+                 worker_output + group_id * group_output_channels,
+                 narrow<size_t>(M),
+                 nullptr);
+      }
+
+      if (activation_.ActivationKind != MlasIdentityActivation) {
+        MlasActivation(&activation_, worker_output, nullptr, narrow<size_t>(output_count), narrow<size_t>(M),
+                       narrow<size_t>(M));
+      }
+    };
+
+    concurrency::ThreadPool::TrySimpleParallelFor(thread_pool, narrow<std::ptrdiff_t>(task_count), conv_worker);
+  }
+
+  return Status::OK();
+}
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -2,7 +2,9 @@
 // Licensed under the MIT License.
 
 #include "core/framework/op_kernel.h"
+#include "core/framework/config_options.h"
 #include "contrib_ops/cpu/bert/attention_cpu_base.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "core/providers/common.h"
 #include "core/util/math.h"
 #include "core/util/qmath.h"
@@ -32,10 +34,16 @@ class QAttention : public OpKernel, public AttentionCPUBase {
                                    /*out*/ bool& used_shared_buffers) override;
 
  private:
+  // Computes output(B, S, N, H) = Softmax(1/sqrt(H) x Q x K' + mask) x V with uint8 x int8 GEMMs.
+  Status ApplyQuantizedAttention(const float* Q, const float* K, const float* V, const Tensor* mask_index,
+                                 Tensor* output, int batch_size, int sequence_length, int head_size,
+                                 int hidden_size, OpKernelContext* context) const;
+
   BufferUniquePtr packed_weights_;
   size_t packed_weights_size_;
   TensorShape weight_shape_;
   bool weights_is_signed_;
+  bool use_int8_attention_;
 };
 
 // These ops are internal-only, so register outside of onnx
@@ -54,6 +62,9 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
 
 template <typename T>
 QAttention<T>::QAttention(const OpKernelInfo& info) : OpKernel(info), AttentionCPUBase(info, true, true) {
+  use_int8_attention_ =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsQAttentionInt8Attention, "0") == "1" &&
+      !use_alibi_;
 }
 
 template <typename T>
@@ -289,11 +300,206 @@ Status QAttention<T>::Compute(OpKernelContext* context) const {
     MlasGemmBatch(gemm_shape, gemm_data_vec.data(), loop_len, tp);
   }
 
+  if (use_int8_attention_ && past_tensor == nullptr && context->OutputCount() < 2) {
+    return ApplyQuantizedAttention(Q, K, V, mask_index, output, batch_size, sequence_length, head_size, hidden_size,
+                                   context);
+  }
+
   // Compute the attention score and apply the score to V
   return ApplyAttention(Q, K, V, mask_index, past_tensor, output,
                         batch_size, sequence_length,
                         head_size, head_size, hidden_size, nullptr, context);
 }
 
+template <typename T>
+Status QAttention<T>::ApplyQuantizedAttention(const float* Q, const float* K, const float* V,
+                                              const Tensor* mask_index, Tensor* output,
+                                              int batch_size, int sequence_length, int head_size, int hidden_size,
+                                              OpKernelContext* context) const {
+  AllocatorPtr allocator;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&allocator));
+  auto* tp = context->GetOperatorThreadPool();
+
+  const int loop_len = batch_size * num_heads_;
+  const size_t head_elements = SafeInt<size_t>(sequence_length) * head_size;       // S x H
+  const size_t score_elements = SafeInt<size_t>(sequence_length) * sequence_length;  // S x S
+
+  // mask_data is nullptr when mask_index is nullptr and not unidirectional, otherwise its shape is BxSxS
+  const bool has_unidirectional = (is_unidirectional_ && sequence_length > 1);
+  void* mask_data = nullptr;
+  if (mask_index != nullptr || has_unidirectional) {
+    size_t mask_data_bytes = SafeInt<size_t>(batch_size) * score_elements * sizeof(float);
+    mask_data = allocator->Alloc(mask_data_bytes);
+    memset(mask_data, 0, mask_data_bytes);
+    PrepareMask(mask_index != nullptr ? mask_index->Data<int32_t>() : nullptr,
+                mask_index != nullptr ? mask_index->Shape().GetDims() : gsl::span<const int64_t>{},
+                static_cast<float*>(mask_data), has_unidirectional, batch_size, sequence_length, 0);
+  }
+  BufferUniquePtr mask_data_buffer(mask_data, BufferDeleter(allocator));
+  const float* mask = static_cast<const float*>(mask_data);
+
+  // int32 scores (BxNxSxS), uint8 probs (BxNxSxS), uint8 Q (BxNxSxH), int8 K' (BxNxHxS) and int8 V (BxNxSxH)
+  const size_t scores_count = SafeInt<size_t>(loop_len) * score_elements;
+  const size_t qkv_count = SafeInt<size_t>(loop_len) * head_elements;
+  auto quantized_data = allocator->Alloc(SafeInt<size_t>(scores_count) * (sizeof(int32_t) + 1) + 3 * qkv_count);
+  BufferUniquePtr quantized_buffer(quantized_data, BufferDeleter(allocator));
+  int32_t* scores = static_cast<int32_t*>(quantized_data);
+  uint8_t* probs = reinterpret_cast<uint8_t*>(scores + scores_count);
+  uint8_t* quantized_q = probs + scores_count;
+  int8_t* quantized_k = reinterpret_cast<int8_t*>(quantized_q + qkv_count);
+  int8_t* quantized_v = quantized_k + qkv_count;
+
+  std::vector<float> q_scales(loop_len);
+  std::vector<uint8_t> q_zero_points(loop_len);
+  std::vector<float> k_scales(loop_len);
+  std::vector<float> v_scales(loop_len);
+
+  // Quantize Q, K and V of each head. K is transposed to be the B matrix of Q x K'.
+  ThreadPool::TryParallelFor(tp, loop_len, 4.0 * head_elements, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    std::vector<int8_t> k_rows(head_elements);
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const size_t offset = head_elements * i;
+      GetQuantizationParameter(Q + offset, head_elements, q_scales[i], q_zero_points[i], nullptr);
+      MlasQuantizeLinear(Q + offset, quantized_q + offset, head_elements, q_scales[i], q_zero_points[i]);
+
+      int8_t zero_point = 0;
+      GetQuantizationParameter<int8_t, false, true>(K + offset, head_elements, k_scales[i], zero_point, nullptr);
+      MlasQuantizeLinear(K + offset, k_rows.data(), head_elements, k_scales[i], zero_point);
+      int8_t* k_transposed = quantized_k + offset;
+      for (int s = 0; s < sequence_length; s++) {
+        for (int h = 0; h < head_size; h++) {
+          k_transposed[static_cast<size_t>(h) * sequence_length + s] = k_rows[static_cast<size_t>(s) * head_size + h];
+        }
+      }
+
+      GetQuantizationParameter<int8_t, false, true>(V + offset, head_elements, v_scales[i], zero_point, nullptr);
+      MlasQuantizeLinear(V + offset, quantized_v + offset, head_elements, v_scales[i], zero_point);
+    }
+  });
+
+  const uint8_t zero_point_zero = 0;
+
+  // STEP.2: scores(B, N, S, S) = Q(B, N, S, H) x K'(B, N, H, S) in int32
+  {
+    MLAS_GEMM_QUANT_SHAPE_PARAMS gemm_shape;
+    gemm_shape.M = sequence_length;
+    gemm_shape.N = sequence_length;
+    gemm_shape.K = head_size;
+    gemm_shape.BIsSigned = true;
+
+    std::vector<MLAS_GEMM_QUANT_DATA_PARAMS> gemm_data_vec(loop_len);
+    for (int i = 0; i < loop_len; i++) {
+      auto& gemm_params = gemm_data_vec[i];
+      gemm_params.A = quantized_q + head_elements * i;
+      gemm_params.lda = head_size;
+      gemm_params.ZeroPointA = q_zero_points[i];
+      gemm_params.B = quantized_k + head_elements * i;
+      gemm_params.ldb = sequence_length;
+      gemm_params.ZeroPointB = &zero_point_zero;
+      gemm_params.C = scores + score_elements * i;
+      gemm_params.ldc = sequence_length;
+    }
+    MlasGemmBatch(gemm_shape, gemm_data_vec.data(), loop_len, tp);
+  }
+
+  // STEP.3: Dequantize the scores, add the mask and compute the exponentials of the softmax, which are quantized
+  // to uint8 with a scale of 1/255 since the largest one of each row is 1. The rows are normalized by the sums of
+  // their quantized exponentials after the product with V.
+  std::vector<float> row_scales(SafeInt<size_t>(loop_len) * sequence_length);
+  const float alpha = 1.0f / sqrt(static_cast<float>(head_size));
+  ThreadPool::TryParallelFor(tp, loop_len, 4.0 * score_elements, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    std::vector<float> row(sequence_length);
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int batch_index = static_cast<int>(i / num_heads_);
+      const float scale = alpha * q_scales[i] * k_scales[i];
+      for (int s = 0; s < sequence_length; s++) {
+        const size_t row_offset = score_elements * i + static_cast<size_t>(s) * sequence_length;
+        const int32_t* score_row = scores + row_offset;
+        const float* mask_row = mask != nullptr
+                                    ? mask + (static_cast<size_t>(batch_index) * sequence_length + s) * sequence_length
+                                    : nullptr;
+
+        float max_value = std::numeric_limits<float>::lowest();
+        for (int j = 0; j < sequence_length; j++) {
+          row[j] = static_cast<float>(score_row[j]) * scale + (mask_row != nullptr ? mask_row[j] : 0.0f);
+          max_value = std::max(max_value, row[j]);
+        }
+
+        // Fix unidirectional mask to be parity with huggingface implementation.
+        if (has_unidirectional && mask_row != nullptr && s < sequence_length - 1) {
+          for (int j = s + 1; j < sequence_length; j++) {
+            row[j] = mask_row[j];
+          }
+          max_value = *std::max_element(row.begin(), row.end());
+        }
+
+        for (int j = 0; j < sequence_length; j++) {
+          row[j] -= max_value;
+        }
+        MlasComputeExp(row.data(), row.data(), sequence_length);
+
+        uint8_t* prob_row = probs + row_offset;
+        MlasQuantizeLinear(row.data(), prob_row, sequence_length, 1.0f / 255.0f, zero_point_zero);
+        int32_t sum = 0;
+        for (int j = 0; j < sequence_length; j++) {
+          sum += prob_row[j];
+        }
+        row_scales[static_cast<size_t>(i) * sequence_length + s] = 1.0f / static_cast<float>(sum);
+      }
+    }
+  });
+
+  // STEP.4: output(B, S, N, H) = probs(B, N, S, S) x V(B, N, S, H), dequantized in place in the output
+  float* output_data = output->MutableData<float>();
+  {
+    MLAS_GEMM_QUANT_SHAPE_PARAMS gemm_shape;
+    gemm_shape.M = sequence_length;
+    gemm_shape.N = head_size;
+    gemm_shape.K = sequence_length;
+    gemm_shape.BIsSigned = true;
+
+    std::vector<MLAS_GEMM_QUANT_DATA_PARAMS> gemm_data_vec(loop_len);
+    std::vector<MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR> scale_procs;
+    scale_procs.reserve(loop_len);
+    for (int i = 0; i < loop_len; i++) {
+      const int batch_index = i / num_heads_;
+      const int head_index = i % num_heads_;
+      float* dest = output_data + static_cast<size_t>(batch_index) * sequence_length * hidden_size +
+                    static_cast<size_t>(head_index) * head_size;
+      scale_procs.emplace_back(dest, hidden_size, &v_scales[i], nullptr);
+
+      auto& gemm_params = gemm_data_vec[i];
+      gemm_params.A = probs + score_elements * i;
+      gemm_params.lda = sequence_length;
+      gemm_params.ZeroPointA = zero_point_zero;
+      gemm_params.B = quantized_v + head_elements * i;
+      gemm_params.ldb = head_size;
+      gemm_params.ZeroPointB = &zero_point_zero;
+      gemm_params.C = reinterpret_cast<int32_t*>(dest);
+      gemm_params.ldc = hidden_size;
+      gemm_params.OutputProcessor = &(scale_procs[i]);
+    }
+    MlasGemmBatch(gemm_shape, gemm_data_vec.data(), loop_len, tp);
+  }
+
+  // Normalize the rows of the softmax.
+  ThreadPool::TryParallelFor(tp, loop_len, static_cast<double>(head_elements), [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+    for (std::ptrdiff_t i = begin; i != end; ++i) {
+      const int batch_index = static_cast<int>(i / num_heads_);
+      const int head_index = static_cast<int>(i % num_heads_);
+      for (int s = 0; s < sequence_length; s++) {
+        float* out_row = output_data + (static_cast<size_t>(batch_index) * sequence_length + s) * hidden_size +
+                         static_cast<size_t>(head_index) * head_size;
+        const float scale = row_scales[static_cast<size_t>(i) * sequence_length + s];
+        for (int h = 0; h < head_size; h++) {
+          out_row[h] *= scale;
+        }
+      }
+    }
+  });
+
+  return Status::OK();
+}
+
 }  // namespace contrib
 }  // namespace onnxruntime
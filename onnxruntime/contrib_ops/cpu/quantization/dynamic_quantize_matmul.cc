@@ -11,6 +11,8 @@
 #include "core/util/qmath.h"
 
 #include <algorithm>
+#include <limits>
+#include <vector>
 
 namespace onnxruntime {
 namespace contrib {
@@ -35,6 +37,36 @@ void ScaleOutput(const Tensor& scale, Tensor& output) {
 
   BroadcastLooper(broadcast_helper, funcs);
 }
+
+// Same as MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR, with an extra scale for every row of A.
+class RowScaleBiasOutputProcessor : public MLAS_QGEMM_OUTPUT_PROCESSOR {
+ public:
+  RowScaleBiasOutputProcessor(float* output, size_t ldo, const float* row_scale, const float* scale,
+                              bool is_scale_per_column, const float* bias)
+      : output_(output), ldo_(ldo), row_scale_(row_scale), scale_(scale),
+        is_scale_per_column_(is_scale_per_column), bias_(bias) {}
+
+  void Process(const int32_t* C, size_t start_m, size_t start_n, size_t count_m, size_t count_n,
+               size_t ldc) const override {
+    for (size_t m = start_m; m < start_m + count_m; m++) {
+      const int32_t* c = C + m * ldc;
+      float* y = output_ + m * ldo_;
+      const float row_scale = row_scale_[m];
+      for (size_t n = start_n; n < start_n + count_n; n++) {
+        float value = static_cast<float>(c[n]) * row_scale * scale_[is_scale_per_column_ ? n : 0];
+        y[n] = bias_ != nullptr ? value + bias_[n] : value;
+      }
+    }
+  }
+
+ private:
+  float* output_;
+  size_t ldo_;
+  const float* row_scale_;
+  const float* scale_;
+  bool is_scale_per_column_;
+  const float* bias_;
+};
 }  // namespace
 
 class MatMulIntegerToFloatBase : public MatMulIntegerBase {
@@ -54,7 +86,8 @@ class MatMulIntegerToFloatBase : public MatMulIntegerBase {
                        const Tensor* b_tensor,
                        const Tensor* b_scale,
                        const Tensor* b_zp,
-                       const Tensor* bias_tensor) const;
+                       const Tensor* bias_tensor,
+                       const float* a_row_scales = nullptr) const;
 };
 
 Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
@@ -66,7 +99,8 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
                                                const Tensor* b_tensor,
                                                const Tensor* b_scale_tensor,
                                                const Tensor* b_zp_tensor,
-                                               const Tensor* bias_tensor) const {
+                                               const Tensor* bias_tensor,
+                                               const float* a_row_scales) const {
   MatMulComputeHelper helper;
   ORT_RETURN_IF_ERROR(helper.Compute(a_shape,
                                      b_tensor ? b_tensor->Shape() : b_shape_,
@@ -126,18 +160,33 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
 
   const size_t num_gemms = helper.OutputOffsets().size();
   std::vector<MLAS_QGEMM_SCALE_BIAS_OUTPUT_PROCESSOR> gemm_scale_procs;
-  gemm_scale_procs.reserve(num_gemms);
+  std::vector<RowScaleBiasOutputProcessor> gemm_row_scale_procs;
+  if (a_row_scales != nullptr) {
+    gemm_row_scale_procs.reserve(num_gemms);
+  } else {
+    gemm_scale_procs.reserve(num_gemms);
+  }
   std::vector<MLAS_GEMM_QUANT_DATA_PARAMS> gemm_data_vec(num_gemms);
 
   for (size_t gemm_idx = 0; gemm_idx < num_gemms; gemm_idx++) {
-    gemm_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
-                                  gemm_shape.N,
-                                  b_scale_data + helper.RightScaleOffsets()[gemm_idx],
-                                  bias_data,
-                                  MLAS_QGEMM_OUTPUT_MODE::ZeroMode,
-                                  is_b_scale_per_column ? MLAS_QUANTIZATION_GRANULARITY::PerColumn : MLAS_QUANTIZATION_GRANULARITY::PerMatrix);
     auto& params = gemm_data_vec[gemm_idx];
-    params.OutputProcessor = &(gemm_scale_procs[gemm_idx]);
+    if (a_row_scales != nullptr) {
+      gemm_row_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
+                                        gemm_shape.N,
+                                        a_row_scales + helper.LeftOffsets()[gemm_idx] / gemm_shape.K,
+                                        b_scale_data + helper.RightScaleOffsets()[gemm_idx],
+                                        is_b_scale_per_column,
+                                        bias_data);
+      params.OutputProcessor = &(gemm_row_scale_procs[gemm_idx]);
+    } else {
+      gemm_scale_procs.emplace_back(y_data + helper.OutputOffsets()[gemm_idx],
+                                    gemm_shape.N,
+                                    b_scale_data + helper.RightScaleOffsets()[gemm_idx],
+                                    bias_data,
+                                    MLAS_QGEMM_OUTPUT_MODE::ZeroMode,
+                                    is_b_scale_per_column ? MLAS_QUANTIZATION_GRANULARITY::PerColumn : MLAS_QUANTIZATION_GRANULARITY::PerMatrix);
+      params.OutputProcessor = &(gemm_scale_procs[gemm_idx]);
+    }
     params.A = a_data + helper.LeftOffsets()[gemm_idx];
     params.lda = gemm_shape.K;
     params.ZeroPointA = a_zp;
@@ -157,7 +206,9 @@ Status MatMulIntegerToFloatBase::ComputeCommon(OpKernelContext* ctx,
 
 class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
  public:
-  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {}
+  DynamicQuantizeMatMul(const OpKernelInfo& info) : MatMulIntegerToFloatBase(info) {
+    per_row_quantization_ = info.GetAttrOrDefault<int64_t>("per_row_quantization", 0) != 0;
+  }
 
   Status Compute(OpKernelContext* context) const override;
 
@@ -171,6 +222,13 @@ class DynamicQuantizeMatMul final : public MatMulIntegerToFloatBase {
 
  protected:
   int GetBIdx() const override { return IN_B; }
+
+ private:
+  // Quantize every row of A with its own scale, symmetrically around a_zero_point.
+  static void QuantizeRows(const float* a_data, uint8_t* a_data_quant, float* row_scales, size_t rows, size_t K,
+                           uint8_t a_zero_point, concurrency::ThreadPool* thread_pool);
+
+  bool per_row_quantization_{false};
 };
 
 class MatMulIntegerToFloat final : public MatMulIntegerToFloatBase {
@@ -209,16 +267,25 @@ Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
   const float* a_data = a->Data<float>();
   int64_t num_of_elements = a->Shape().Size();
 
-  float a_scale;
-  uint8_t a_zero_point;
-  GetQuantizationParameter(a_data, num_of_elements, a_scale, a_zero_point, ctx->GetOperatorThreadPool());
-
   AllocatorPtr allocator;
   ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
   uint8_t* a_data_quant = static_cast<uint8_t*>(allocator->Alloc(SafeInt<size_t>(num_of_elements) * sizeof(uint8_t)));
   BufferUniquePtr a_buffer_quant_holder(a_data_quant, BufferDeleter(std::move(allocator)));
 
-  ParQuantizeLinear(a_data, a_data_quant, narrow<size_t>(num_of_elements), a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+  float a_scale = 1.0f;
+  uint8_t a_zero_point = 128;
+  std::vector<float> a_row_scales;
+  const size_t K = a->Shape().NumDimensions() > 0 ? narrow<size_t>(a->Shape().GetDims().back()) : 1;
+  if (per_row_quantization_ && K > 0) {
+    // Finding the range of a row and quantizing it is done in one pass over the row while it is in cache.
+    // The zero point is the same for all rows, so the GEMM handles it and only the output scale is per row.
+    a_row_scales.resize(narrow<size_t>(num_of_elements) / K);
+    QuantizeRows(a_data, a_data_quant, a_row_scales.data(), a_row_scales.size(), K, a_zero_point,
+                 ctx->GetOperatorThreadPool());
+  } else {
+    GetQuantizationParameter(a_data, num_of_elements, a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+    ParQuantizeLinear(a_data, a_data_quant, narrow<size_t>(num_of_elements), a_scale, a_zero_point, ctx->GetOperatorThreadPool());
+  }
 
   bool is_b_scale_supported = IsBQuantParamSupported(b_scale_tensor->Shape(), b ? b->Shape() : b_shape_);
   ORT_RETURN_IF_ERROR(ComputeCommon(
@@ -231,7 +298,8 @@ Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
       b,
       is_b_scale_supported ? b_scale_tensor : nullptr,
       b_zp_tensor,
-      ctx->Input<Tensor>(IN_BIAS)));
+      ctx->Input<Tensor>(IN_BIAS),
+      a_row_scales.empty() ? nullptr : a_row_scales.data()));
 
   if (!is_b_scale_supported) {
     ScaleOutput(*b_scale_tensor, *ctx->Output<Tensor>(0));
@@ -240,6 +308,27 @@ Status DynamicQuantizeMatMul::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+void DynamicQuantizeMatMul::QuantizeRows(const float* a_data, uint8_t* a_data_quant, float* row_scales,
+                                         size_t rows, size_t K, uint8_t a_zero_point,
+                                         concurrency::ThreadPool* thread_pool) {
+  const TensorOpCost unit_cost{static_cast<double>(K * sizeof(float)), static_cast<double>(K * sizeof(uint8_t)),
+                               static_cast<double>(K) * 3.0};
+  concurrency::ThreadPool::TryParallelFor(
+      thread_pool, static_cast<std::ptrdiff_t>(rows), unit_cost, [&](std::ptrdiff_t begin, std::ptrdiff_t end) {
+        for (std::ptrdiff_t row = begin; row < end; row++) {
+          const float* row_data = a_data + row * K;
+          float min = std::numeric_limits<float>::max();
+          float max = std::numeric_limits<float>::lowest();
+          MlasFindMinMaxElement(row_data, &min, &max, K);
+
+          const float max_abs = std::max(max, -min);
+          const float scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+          row_scales[row] = scale;
+          MlasQuantizeLinear(row_data, a_data_quant + row * K, K, scale, a_zero_point);
+        }
+      });
+}
+
 void MatMulIntegerToFloat::FixupScaleTensor(const Tensor*& a_scale_tensor, const Tensor*& b_scale_tensor) {
   const TensorShape a_scale_shape = a_scale_tensor->Shape();
   const TensorShape b_scale_shape = b_scale_tensor->Shape();
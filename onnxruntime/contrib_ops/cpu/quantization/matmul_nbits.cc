@@ -0,0 +1,196 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+class MatMulNBits final : public OpKernel {
+ public:
+  MatMulNBits(const OpKernelInfo& info) : OpKernel(info) {
+    int64_t K, N, block_size, nbits;
+    ORT_ENFORCE(info.GetAttr<int64_t>("K", &K).IsOK());
+    ORT_ENFORCE(info.GetAttr<int64_t>("N", &N).IsOK());
+    ORT_ENFORCE(info.GetAttr<int64_t>("block_size", &block_size).IsOK());
+    ORT_ENFORCE(info.GetAttr<int64_t>("bits", &nbits).IsOK());
+
+    K_ = narrow<size_t>(K);
+    N_ = narrow<size_t>(N);
+    block_size_ = narrow<size_t>(block_size);
+
+    ORT_ENFORCE(nbits == 4, "Only 4b quantization is supported for MatMulNBits op.");
+    ORT_ENFORCE(MlasIsQ4GemmBlkLenSupported(block_size_),
+                "MatMulNBits: block_size must be a power of 2 in the range [32, 256]. Got ", block_size_);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override;
+
+  enum InputTensors : int {
+    IN_A = 0,
+    IN_B = 1,
+    IN_SCALES = 2,
+    IN_ZERO_POINTS = 3
+  };
+
+ private:
+  Status ValidateQuantizedInputs(const Tensor& b, const Tensor& scales, const Tensor* zero_points) const;
+
+  size_t K_;
+  size_t N_;
+  size_t block_size_;
+  BufferUniquePtr packed_b_;
+};
+
+Status MatMulNBits::ValidateQuantizedInputs(const Tensor& b, const Tensor& scales, const Tensor* zero_points) const {
+  const size_t block_count_k = (K_ + block_size_ - 1) / block_size_;
+
+  ORT_RETURN_IF_NOT(narrow<size_t>(b.Shape().Size()) == SafeInt<size_t>(N_) * block_count_k * (block_size_ / 2),
+                    "MatMulNBits: input B has an unexpected number of elements ", b.Shape().Size());
+  ORT_RETURN_IF_NOT(narrow<size_t>(scales.Shape().Size()) == SafeInt<size_t>(N_) * block_count_k,
+                    "MatMulNBits: input scales has an unexpected number of elements ", scales.Shape().Size());
+  ORT_RETURN_IF_NOT(zero_points == nullptr ||
+                        narrow<size_t>(zero_points->Shape().Size()) == SafeInt<size_t>(N_) * ((block_count_k + 1) / 2),
+                    "MatMulNBits: input zero_points has an unexpected number of elements");
+
+  return Status::OK();
+}
+
+Status MatMulNBits::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  // The packed layout folds the scales and zero points into the quantized data, so pack when all of them
+  // are constant.
+  if (input_idx != IN_B) {
+    return Status::OK();
+  }
+
+  const Tensor* scales = nullptr;
+  const Tensor* zero_points = nullptr;
+  if (!Info().TryGetConstantInput(IN_SCALES, &scales)) {
+    return Status::OK();
+  }
+  const auto& input_defs = Info().node().InputDefs();
+  const bool has_zero_points = input_defs.size() > IN_ZERO_POINTS && input_defs[IN_ZERO_POINTS]->Exists();
+  if (has_zero_points && !Info().TryGetConstantInput(IN_ZERO_POINTS, &zero_points)) {
+    return Status::OK();
+  }
+
+  ORT_RETURN_IF_ERROR(ValidateQuantizedInputs(tensor, *scales, zero_points));
+
+  const size_t packed_b_size = MlasQ4GemmPackBSize(N_, K_, block_size_);
+  if (packed_b_size == 0) {
+    return Status::OK();
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(std::move(alloc)));
+  MlasQ4GemmPackB(packed_b_data, tensor.Data<uint8_t>(), scales->Data<float>(),
+                  zero_points != nullptr ? zero_points->Data<uint8_t>() : nullptr,
+                  N_, K_, block_size_);
+
+  bool share_prepacked_weights = (prepacked_weights != nullptr);
+  if (share_prepacked_weights) {
+    prepacked_weights->buffers_.push_back(std::move(packed_b_));
+    prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+  }
+
+  is_packed = true;
+  return Status::OK();
+}
+
+Status MatMulNBits::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              int input_idx,
+                                              /*out*/ bool& used_shared_buffers) {
+  used_shared_buffers = false;
+
+  if (input_idx == IN_B) {
+    used_shared_buffers = true;
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+
+  return Status::OK();
+}
+
+Status MatMulNBits::Compute(OpKernelContext* ctx) const {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const Tensor* a = ctx->Input<Tensor>(IN_A);
+
+  TensorShape b_shape({static_cast<int64_t>(K_), static_cast<int64_t>(N_)});
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape));
+
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  // Pack the weights for this run if they were not constant when the session was initialized.
+  const void* packed_b = packed_b_.get();
+  IAllocatorUniquePtr<uint8_t> run_packed_b;
+  if (packed_b == nullptr) {
+    const Tensor* b = ctx->Input<Tensor>(IN_B);
+    const Tensor* scales = ctx->Input<Tensor>(IN_SCALES);
+    const Tensor* zero_points = ctx->Input<Tensor>(IN_ZERO_POINTS);
+    ORT_RETURN_IF_ERROR(ValidateQuantizedInputs(*b, *scales, zero_points));
+
+    AllocatorPtr allocator;
+    ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
+    run_packed_b = IAllocator::MakeUniquePtr<uint8_t>(allocator, MlasQ4GemmPackBSize(N_, K_, block_size_));
+    MlasQ4GemmPackB(run_packed_b.get(), b->Data<uint8_t>(), scales->Data<float>(),
+                    zero_points != nullptr ? zero_points->Data<uint8_t>() : nullptr,
+                    N_, K_, block_size_);
+    packed_b = run_packed_b.get();
+  }
+
+  const auto* a_data = a->Data<float>();
+  auto* y_data = y->MutableData<float>();
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  std::vector<MLAS_Q4_GEMM_DATA_PARAMS> gemm_params(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    gemm_params[i].A = a_data + helper.LeftOffsets()[i];
+    gemm_params[i].lda = K;
+    gemm_params[i].PackedB = packed_b;
+    gemm_params[i].C = y_data + helper.OutputOffsets()[i];
+    gemm_params[i].ldc = N;
+  }
+
+  MlasQ4GemmBatch(M, N, K, block_size_, gemm_params.data(), max_len, thread_pool);
+
+  return Status::OK();
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    MatMulNBits,
+    kMSDomain,
+    1,
+    kCpuExecutionProvider,
+    KernelDefBuilder()
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<float>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()),
+    MatMulNBits);
+
+}  // namespace contrib
+}  // namespace onnxruntime
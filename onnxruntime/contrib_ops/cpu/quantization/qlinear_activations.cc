@@ -97,6 +97,76 @@ Status QLinearSigmoid<T>::Compute(OpKernelContext* context) const {
   });
 }
 
+namespace {
+void ComputeGelu(const float* input, float* output, size_t length) {
+  constexpr float sqrt1_2 = 0.70710678118654752440f;
+  for (size_t i = 0; i < length; ++i) {
+    output[i] = input[i] * sqrt1_2;
+  }
+
+  MlasComputeErf(output, output, length);
+
+  for (size_t i = 0; i < length; ++i) {
+    output[i] = 0.5f * input[i] * (output[i] + 1.0f);
+  }
+}
+}  // namespace
+
+template <typename T>
+QLinearGelu<T>::QLinearGelu(const OpKernelInfo& info)
+    : QLinearLookupBase<T>(info) {
+  this->BuildLookupTableIfFixed(info, ComputeGelu);
+}
+
+template <typename T>
+Status QLinearGelu<T>::Compute(OpKernelContext* context) const {
+  return this->ComputeBase(context, ComputeGelu);
+}
+
+QLinearLookupTable::QLinearLookupTable(const OpKernelInfo& info) : OpKernel(info) {
+  const Tensor* table = nullptr;
+  if (info.TryGetConstantInput(1, &table)) {
+    ORT_ENFORCE(table->Shape().Size() == 256, "QLinearLookupTable : table must have 256 entries");
+    const auto* table_data = static_cast<const uint8_t*>(table->DataRaw());
+    fixed_lookup_table_.assign(table_data, table_data + 256);
+  }
+}
+
+Status QLinearLookupTable::Compute(OpKernelContext* context) const {
+  const auto& X = *context->Input<Tensor>(0);
+  const auto& input_shape = X.Shape();
+  const auto N = input_shape.Size();
+  auto& Y = *context->Output(0, input_shape);
+
+  const uint8_t* table = fixed_lookup_table_.data();
+  if (fixed_lookup_table_.empty()) {
+    const Tensor* table_tensor = context->Input<Tensor>(1);
+    ORT_RETURN_IF_NOT(table_tensor->Shape().Size() == 256, "QLinearLookupTable : table must have 256 entries");
+    table = static_cast<const uint8_t*>(table_tensor->DataRaw());
+  }
+
+  using onnxruntime::TensorOpCost;
+  using onnxruntime::concurrency::ThreadPool;
+  ThreadPool* tp = context->GetOperatorThreadPool();
+  const uint8_t* x_data = static_cast<const uint8_t*>(X.DataRaw());
+  uint8_t* y_data = static_cast<uint8_t*>(Y.MutableDataRaw());
+  ThreadPool::TryParallelFor(
+      tp, narrow<std::ptrdiff_t>(N), TensorOpCost{1.0, 1.0, 1.0},
+      [x_data, y_data, table](std::ptrdiff_t first, std::ptrdiff_t last) {
+        QLinearLookupTableTransform(x_data + first, table, y_data + first, last - first);
+      });
+
+  return Status::OK();
+}
+
+ONNX_CPU_OPERATOR_MS_KERNEL(
+    QLinearLookupTable,
+    1,
+    KernelDefBuilder()
+        .TypeConstraint("T1", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()})
+        .TypeConstraint("T2", {DataTypeImpl::GetTensorType<uint8_t>(), DataTypeImpl::GetTensorType<int8_t>()}),
+    QLinearLookupTable);
+
 #define REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(op_name, version, data_type, KERNEL_CLASS) \
   ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(                                                         \
       op_name, version, data_type,                                                           \
@@ -108,6 +178,8 @@ REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearLeakyRelu, 1, int8_t, QLinearLe
 REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearLeakyRelu, 1, uint8_t, QLinearLeakyRelu);
 REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearSigmoid, 1, int8_t, QLinearSigmoid);
 REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearSigmoid, 1, uint8_t, QLinearSigmoid);
+REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearGelu, 1, int8_t, QLinearGelu);
+REGISTER_QLINEAR_LOOKUPTABLE_TYPED_KERNEL(QLinearGelu, 1, uint8_t, QLinearGelu);
 
 }  // namespace contrib
 }  // namespace onnxruntime
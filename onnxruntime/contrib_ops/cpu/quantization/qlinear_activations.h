@@ -49,6 +49,26 @@ class QLinearSigmoid final : public QLinearLookupBase<T> {
   Status Compute(OpKernelContext* context) const override;
 };
 
+template <typename T>
+class QLinearGelu final : public QLinearLookupBase<T> {
+ public:
+  QLinearGelu(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+};
+
+// Maps the bytes of the input through a 256 entry table given as input 1, usually a constant initializer.
+class QLinearLookupTable final : public OpKernel {
+ public:
+  QLinearLookupTable(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // The table when it is a constant initializer, otherwise empty.
+  std::vector<uint8_t> fixed_lookup_table_;
+};
+
 }  // namespace contrib
 }  // namespace onnxruntime
 
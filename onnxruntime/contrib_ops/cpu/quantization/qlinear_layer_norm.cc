@@ -0,0 +1,100 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "qlinear_layer_norm.h"
+
+#include <cmath>
+
+#include "core/common/narrow.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+template <typename T>
+Status QLinearLayerNormalization<T>::Compute(OpKernelContext* context) const {
+  const auto* X = context->Input<Tensor>(0);
+  const auto* X_scale = context->Input<Tensor>(1);
+  const auto* X_zero_point = context->Input<Tensor>(2);
+  const auto* Y_scale = context->Input<Tensor>(3);
+  const auto* Y_zero_point = context->Input<Tensor>(4);
+  const auto* scale = context->Input<Tensor>(5);
+  const auto* B = context->Input<Tensor>(6);
+
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(X_scale), "X_scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(X_zero_point == nullptr || IsScalarOr1ElementVector(X_zero_point),
+                    "X_zero_point must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(Y_scale), "Y_scale must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(Y_zero_point == nullptr || IsScalarOr1ElementVector(Y_zero_point),
+                    "Y_zero_point must be a scalar or 1D tensor of size 1");
+
+  const auto& x_shape = X->Shape();
+  const size_t axis = static_cast<size_t>(HandleNegativeAxis(axis_, x_shape.NumDimensions()));
+  const int64_t norm_count = x_shape.SizeToDimension(axis);
+  const int64_t norm_size = x_shape.SizeFromDimension(axis);
+  ORT_RETURN_IF_NOT(scale->Shape().Size() == norm_size,
+                    "Size of scale and the normalized dimensions of X differ: ", scale->Shape().Size(), " vs ",
+                    norm_size);
+  ORT_RETURN_IF_NOT(B == nullptr || B->Shape().Size() == norm_size,
+                    "Size of B and the normalized dimensions of X differ: ", B->Shape().Size(), " vs ", norm_size);
+
+  auto* Y = context->Output(0, x_shape);
+  if (x_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  const float x_scale = *X_scale->Data<float>();
+  const int32_t x_zero_point = X_zero_point ? static_cast<int32_t>(*X_zero_point->Data<T>()) : 0;
+  const float y_scale = *Y_scale->Data<float>();
+  const T y_zero_point = Y_zero_point ? *Y_zero_point->Data<T>() : T{0};
+
+  const T* x_data = X->Data<T>();
+  const float* scale_data = scale->Data<float>();
+  const float* bias_data = B ? B->Data<float>() : nullptr;
+  T* y_data = Y->MutableData<T>();
+
+  concurrency::ThreadPool::TryBatchParallelFor(
+      context->GetOperatorThreadPool(), narrow<std::ptrdiff_t>(norm_count),
+      [&](std::ptrdiff_t task_idx) {
+        const T* x_row = x_data + task_idx * norm_size;
+        T* y_row = y_data + task_idx * norm_size;
+
+        std::vector<float> row(narrow<size_t>(norm_size));
+        double mean = 0.0;
+        double mean_square = 0.0;
+        for (int64_t h = 0; h < norm_size; ++h) {
+          const float value = x_scale * static_cast<float>(static_cast<int32_t>(x_row[h]) - x_zero_point);
+          row[h] = value;
+          mean += value;
+          mean_square += value * value;
+        }
+
+        mean = mean / norm_size;
+        const double inv_std_dev = 1.0 / std::sqrt(mean_square / norm_size - mean * mean + epsilon_);
+
+        for (int64_t h = 0; h < norm_size; ++h) {
+          const float normalized = static_cast<float>((row[h] - mean) * inv_std_dev) * scale_data[h];
+          row[h] = bias_data ? normalized + bias_data[h] : normalized;
+        }
+
+        MlasQuantizeLinear(row.data(), y_row, narrow<size_t>(norm_size), y_scale, y_zero_point);
+      },
+      0);
+
+  return Status::OK();
+}
+
+#define REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(data_type)              \
+  ONNX_CPU_OPERATOR_TYPED_MS_KERNEL(                                      \
+      QLinearLayerNormalization, 1, data_type,                            \
+      KernelDefBuilder()                                                  \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()), \
+      QLinearLayerNormalization<data_type>);
+
+REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(int8_t);
+REGISTER_QLINEAR_LAYER_NORM_TYPED_KERNEL(uint8_t);
+
+}  // namespace contrib
+}  // namespace onnxruntime
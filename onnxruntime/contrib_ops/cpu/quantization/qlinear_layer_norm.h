@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace contrib {
+
+// LayerNormalization of a quantized input. The rows are dequantized, normalized in float and quantized again to the
+// output, so the float tensors around the LayerNormalization of a QDQ model are never materialized.
+template <typename T>
+class QLinearLayerNormalization final : public OpKernel {
+ public:
+  QLinearLayerNormalization(const OpKernelInfo& info) : OpKernel(info) {
+    axis_ = info.GetAttrOrDefault<int64_t>("axis", -1);
+    epsilon_ = info.GetAttrOrDefault<float>("epsilon", 1e-5f);
+  }
+
+  Status Compute(OpKernelContext* context) const override;
+
+ private:
+  int64_t axis_;
+  float epsilon_;
+};
+
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -3,14 +3,86 @@
 
 #include "qlinear_lookup_table.h"
 
+#include <type_traits>
+
 #include "core/mlas/inc/mlas.h"
 #include "core/providers/common.h"
 
+#if defined(MLAS_TARGET_ARM64)
+#include <arm_neon.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
+
 namespace onnxruntime {
 namespace contrib {
 
+namespace {
+
+// Looks up the 16 byte blocks of x with byte shuffles, and returns the number of bytes done.
+size_t QLinearLookupTableTransformBytes(const uint8_t* x, const uint8_t* table, uint8_t* y, size_t n) {
+#if defined(MLAS_TARGET_ARM64)
+  // The table is 4 x 64 bytes: vqtbl4q looks up the first 64 entries, and vqtbx4q the next ones with the indices
+  // moved down by 64, keeping the results of the lanes whose index is out of its range.
+  uint8x16x4_t tables[4];
+  for (int i = 0; i < 4; ++i) {
+    tables[i] = vld1q_u8_x4(table + 64 * i);
+  }
+  const uint8x16_t offset = vdupq_n_u8(64);
+  size_t done = 0;
+  for (; done + 16 <= n; done += 16) {
+    uint8x16_t index = vld1q_u8(x + done);
+    uint8x16_t result = vqtbl4q_u8(tables[0], index);
+    index = vsubq_u8(index, offset);
+    result = vqtbx4q_u8(result, tables[1], index);
+    index = vsubq_u8(index, offset);
+    result = vqtbx4q_u8(result, tables[2], index);
+    index = vsubq_u8(index, offset);
+    result = vqtbx4q_u8(result, tables[3], index);
+    vst1q_u8(y + done, result);
+  }
+  return done;
+#elif defined(__SSSE3__)
+  // pshufb looks up 16 entries at a time and zeroes the lanes whose index has its high bit set. For the entries
+  // [16k, 16k + 16), the high nibble of the lanes in range is cleared by the xor and the saturating add of 0x70
+  // sets the high bit of the others, so or-ing the 16 lookups gives the result.
+  __m128i tables[16];
+  for (int i = 0; i < 16; ++i) {
+    tables[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table + 16 * i));
+  }
+  const __m128i out_of_range = _mm_set1_epi8(0x70);
+  size_t done = 0;
+  for (; done + 16 <= n; done += 16) {
+    const __m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + done));
+    __m128i result = _mm_setzero_si128();
+    for (int i = 0; i < 16; ++i) {
+      const __m128i block_index =
+          _mm_adds_epu8(_mm_xor_si128(index, _mm_set1_epi8(static_cast<char>(i << 4))), out_of_range);
+      result = _mm_or_si128(result, _mm_shuffle_epi8(tables[i], block_index));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(y + done), result);
+  }
+  return done;
+#else
+  ORT_UNUSED_PARAMETER(x);
+  ORT_UNUSED_PARAMETER(table);
+  ORT_UNUSED_PARAMETER(y);
+  ORT_UNUSED_PARAMETER(n);
+  return 0;
+#endif
+}
+
+}  // namespace
+
 template <typename TOutput>
 void QLinearLookupTableTransform(const uint8_t* x, const TOutput* table, TOutput* y, size_t n) {
+  if constexpr (std::is_same_v<TOutput, uint8_t>) {
+    const size_t done = QLinearLookupTableTransformBytes(x, table, y, n);
+    x += done;
+    y += done;
+    n -= done;
+  }
+
   for (; n >= 4; n -= 4) {
     const size_t x_value0 = x[0];
     const size_t x_value1 = x[1];
@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "core/common/narrow.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/util/math_cpuonly.h"
 #include "core/providers/common.h"
 #include "core/platform/threadpool.h"
@@ -105,6 +107,20 @@ Status SkipLayerNorm<T>::Compute(OpKernelContext* p_ctx) const {
   // of the input and skip tensors
   T* skip_input_add_output_data = skip_input_add_output != nullptr ? skip_input_add_output->MutableData<T>() : nullptr;
 
+  if constexpr (std::is_same_v<T, float>) {
+    // MLAS adds the skip and bias, computes the statistics and normalizes each row in a single pass
+    MLAS_LAYERNORM_PARAMETERS parameters{};
+    parameters.Skip = skip_data;
+    parameters.Bias = bias_data;
+    parameters.Scale = gamma_data;
+    parameters.Shift = beta_data;
+    parameters.SkipOutput = skip_input_add_output_data;
+    parameters.Epsilon = epsilon_;
+    MlasLayerNormalization(input_data, output_data, onnxruntime::narrow<size_t>(task_count),
+                           onnxruntime::narrow<size_t>(hidden_size), &parameters, p_ctx->GetOperatorThreadPool());
+    return Status::OK();
+  }
+
   concurrency::ThreadPool::TryBatchParallelFor(
       p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(task_count),
       [&](ptrdiff_t task_idx) {
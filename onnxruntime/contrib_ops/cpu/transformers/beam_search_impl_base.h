@@ -73,6 +73,10 @@ struct BeamSearchCpuState : public IBeamSearchCpuState {
     this->sequences_space = AllocateBuffer<int32_t>(allocator, sequences_space_buffer_, sequences_bytes);
     memset(this->sequences_space.data(), 0, this->sequences_space.size_bytes());
 
+    // Back-pointers that let sequences reorder beams without copying them. See Sequences.
+    gsl::span<int32_t> sequence_parents = AllocateBuffer<int32_t>(allocator, sequence_parents_buffer_,
+                                                                  SafeInt<size_t>(batch_beam_size) * max_length);
+
     if (is_cuda) {
       // buffers used by CUDA operator but not by CPU operator.
       this->topk_scores = AllocateBuffer<float>(allocator, topk_scores_buffer_, 2 * batch_beam_size);
@@ -81,7 +85,8 @@ struct BeamSearchCpuState : public IBeamSearchCpuState {
       this->final_beam_scores = AllocateBuffer<float>(allocator, final_beam_scores_buffer_, batch_beam_size);
     }
 
-    this->sequences.Init(this->sequences_space, static_cast<int>(batch_beam_size), sequence_length, max_length);
+    this->sequences.Init(this->sequences_space, static_cast<int>(batch_beam_size), sequence_length, max_length,
+                         sequence_parents);
   }
 
   // Copy expanded input_ids to sequences[0]
@@ -120,6 +125,7 @@ struct BeamSearchCpuState : public IBeamSearchCpuState {
   BufferUniquePtr topk_tokens_buffer_;
   BufferUniquePtr topk_indices_buffer_;
   BufferUniquePtr sequences_space_buffer_;
+  BufferUniquePtr sequence_parents_buffer_;
 };
 
 // Base class of beam search implementation that is common for both GPT-2 and T5.
@@ -65,7 +65,8 @@ class BeamSearchGpt : public BeamSearchBase<T> {
       OrtValue& position_ids,
       bool increase_position,
       gsl::span<const int32_t> beam_next_tokens,
-      gsl::span<const int32_t> beam_indices);
+      gsl::span<const int32_t> beam_indices,
+      int past_sequence_length);
 
   const SessionState* init_run_decoder_session_state_ = nullptr;
   GptSubgraph* init_run_gpt_subgraph_ = nullptr;
@@ -99,7 +100,8 @@ Status BeamSearchGpt<T>::CreateInitialFeeds(gsl::span<int32_t>& sequence_lengths
                                                       this->create_inputs_func_,
                                                       this->add_to_feeds_func_,
                                                       buffer,
-                                                      this->ort_stream_);
+                                                      this->ort_stream_,
+                                                      this->parameters_->max_length);
   }
 
   return gpt_subgraph_.CreateInitialFeeds(input_ids,
@@ -113,7 +115,8 @@ Status BeamSearchGpt<T>::CreateInitialFeeds(gsl::span<int32_t>& sequence_lengths
                                           this->create_inputs_func_,
                                           this->add_to_feeds_func_,
                                           buffer,
-                                          this->ort_stream_);
+                                          this->ort_stream_,
+                                          this->parameters_->max_length);
 }
 
 template <typename T>
@@ -124,7 +127,8 @@ Status BeamSearchGpt<T>::UpdateFeeds(
     OrtValue& position_ids,
     bool increase_position,
     gsl::span<const int32_t> beam_next_tokens,
-    gsl::span<const int32_t> beam_indices) {
+    gsl::span<const int32_t> beam_indices,
+    int past_sequence_length) {
   return update_feeds_func_(this->temp_space_allocator_,
                             this->ort_stream_,
                             last_outputs,
@@ -137,8 +141,8 @@ Status BeamSearchGpt<T>::UpdateFeeds(
                             this->parameters_->num_beams,
                             gpt_subgraph_.GetFirstPastInputIndex(),
                             gpt_subgraph_.GetFirstPresentOutputIndex(),
-                            false,
-                            -1);
+                            gpt_subgraph_.past_present_share_buffer_,
+                            past_sequence_length);
 }
 
 template <typename T>
@@ -168,7 +172,6 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
   std::vector<OrtValue> fetches;
 
   // Initialize resources
-  onnxruntime::OrtStlAllocator<HypothesisScore> hypothesis_score_allocator(this->cpu_allocator_);
   onnxruntime::OrtStlAllocator<BeamHypotheses> beam_hyps_allocator(this->cpu_allocator_);
   this->beam_scorer_ = std::make_unique<BeamSearchScorer>(static_cast<size_t>(parameters->batch_size),
                                                           static_cast<size_t>(parameters->num_beams),
@@ -178,7 +181,6 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
                                                           static_cast<size_t>(parameters->num_return_sequences),
                                                           parameters->pad_token_id,
                                                           parameters->eos_token_id,
-                                                          hypothesis_score_allocator,
                                                           beam_hyps_allocator);
   this->beam_scorer_->Initialize(this->cpu_allocator_, parameters->sequence_length);
 
@@ -194,6 +196,24 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
   OrtValue expanded_input_ids_in_cpu;
   ORT_RETURN_IF_ERROR(CreateInitialFeeds(cpu_state.sequence_lengths, expanded_input_ids_in_cpu, feeds, buffer));
 
+  if (gpt_subgraph_.past_present_share_buffer_) {  // Reuse past and present
+    ORT_RETURN_IF(this->IsCuda(), "past_present_share_buffer is not supported by beam search on CUDA");
+
+    // The past state is allocated for max_length once, and present is bound to the same buffer so the subgraph
+    // appends the keys and values of each step in place. UpdateFeeds reorders the beams within the buffer.
+    fetches.reserve(static_cast<size_t>(gpt_subgraph_.GetFirstPresentOutputIndex()) + gpt_subgraph_.num_layers);
+    fetches.resize(gpt_subgraph_.GetFirstPresentOutputIndex(), OrtValue());
+    for (int layer = 0; layer < gpt_subgraph_.num_layers; layer++) {
+      int feed_idx = gpt_subgraph_.GetFirstPastInputIndex() + layer;
+      OrtValue& past_tensor_value = feeds[feed_idx];
+      Tensor* past_tensor = past_tensor_value.GetMutable<Tensor>();
+      OrtValue present_tensor_value;
+      Tensor::InitOrtValue(past_tensor->DataType(), past_tensor->Shape(), past_tensor->MutableData<T>(),
+                           past_tensor->Location(), present_tensor_value);
+      fetches.push_back(present_tensor_value);
+    }
+  }
+
   BeamSearchState<T> beam_state;
   constexpr bool use_position = true;
   beam_state.Init(this->temp_space_allocator_,
@@ -305,9 +325,17 @@ Status BeamSearchGpt<T>::Execute(const FeedsFetchesManager* init_run_feeds_fetch
       ORT_RETURN_IF_ERROR(UpdateFeeds(fetches, feeds, current_length,
                                       position_ids, increase_position,
                                       ReinterpretAsSpan<const int32_t>(beam_next_tokens),
-                                      ReinterpretAsSpan<const int32_t>(beam_indices)));
+                                      ReinterpretAsSpan<const int32_t>(beam_indices),
+                                      current_length - 1));
+    }
+    if (gpt_subgraph_.past_present_share_buffer_) {
+      // clear fetched values before presents[]
+      for (int idx = 0; idx < gpt_subgraph_.GetFirstPresentOutputIndex(); idx++) {
+        fetches[idx] = OrtValue();
+      }
+    } else {
+      fetches.clear();
     }
-    fetches.clear();
   }
 
   gsl::span<const float> final_beam_scores(beam_state.beam_scores.data(), beam_state.beam_scores.size());
@@ -171,7 +171,6 @@ Status BeamSearchT5<T>::Execute(const FeedsFetchesManager& encoder_feeds_fetches
                         parameters->max_length,
                         parameters->sequence_length);
 
-  onnxruntime::OrtStlAllocator<HypothesisScore> hypothesis_score_allocator(this->cpu_allocator_);
   onnxruntime::OrtStlAllocator<BeamHypotheses> beam_hyps_allocator(this->cpu_allocator_);
   this->beam_scorer_ = std::make_unique<BeamSearchScorer>(static_cast<size_t>(parameters->batch_size),
                                                           static_cast<size_t>(parameters->num_beams),
@@ -181,7 +180,6 @@ Status BeamSearchT5<T>::Execute(const FeedsFetchesManager& encoder_feeds_fetches
                                                           static_cast<size_t>(parameters->num_return_sequences),
                                                           parameters->pad_token_id,
                                                           parameters->eos_token_id,
-                                                          hypothesis_score_allocator,
                                                           beam_hyps_allocator);
   this->beam_scorer_->Initialize(this->cpu_allocator_, parameters->sequence_length);
 
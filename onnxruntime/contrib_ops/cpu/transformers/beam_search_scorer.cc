@@ -1,7 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
-#include <queue>
+#include <algorithm>
 #include <math.h>
 #include "core/common/common.h"
 #include "core/common/safeint.h"
@@ -20,27 +20,37 @@ using ::onnxruntime::rnn::detail::Allocate;
 
 BeamHypotheses::BeamHypotheses(int num_beams,
                                float length_penalty,
-                               bool early_stopping,
-                               onnxruntime::OrtStlAllocator<HypothesisScore>& hypothesis_score_allocator)
+                               bool early_stopping)
     : num_beams_(num_beams),
       length_penalty_(length_penalty),
       early_stopping_(early_stopping),
       worst_score_(1e9),
-      beams_(hypothesis_score_allocator) {
+      size_(0) {
+}
+
+void BeamHypotheses::Init(gsl::span<HypothesisScore> beams) {
+  ORT_ENFORCE(beams.size() == static_cast<size_t>(num_beams_));
+  beams_ = beams;
+  size_ = 0;
 }
 
 void BeamHypotheses::Add(gsl::span<const int32_t>& hypothesis, float sum_logprobs) {
   auto length = hypothesis.size();
   float score = sum_logprobs / pow(static_cast<float>(length), length_penalty_);
 
-  if (this->Size() < num_beams_ || score > worst_score_) {
-    HypothesisScore item(hypothesis, score);
-    beams_.push(item);
-    if (this->Size() > num_beams_) {
-      beams_.pop();
-    }
-    worst_score_ = beams_.top().score;
+  if (size_ < num_beams_) {
+    beams_[size_++] = HypothesisScore{hypothesis, score};
+    std::push_heap(beams_.begin(), beams_.begin() + size_, HypothesisScoreCompare());
+  } else if (score > worst_score_) {
+    // Replace the worst hypothesis at the top of the heap.
+    std::pop_heap(beams_.begin(), beams_.end(), HypothesisScoreCompare());
+    beams_.back() = HypothesisScore{hypothesis, score};
+    std::push_heap(beams_.begin(), beams_.end(), HypothesisScoreCompare());
+  } else {
+    return;
   }
+
+  worst_score_ = beams_.front().score;
 }
 
 bool BeamHypotheses::IsDone(float best_sum_logprobs, int current_length) {
@@ -64,29 +74,24 @@ void BeamHypotheses::Output(
     gsl::span<float>& sequences_scores)  // buffer of shape (num_return_sequences) or empty
 {
   ORT_ENFORCE(top_k <= Size());
-  int remove_count = Size() - top_k;
-  for (int i = 0; i < remove_count; i++) {
-    beams_.pop();
-  }
 
-  // Since pop get the worst sequence, so output it in the reverse order.
-  // The first (worst) beam shall be put at the last position among top_k sequences.
-  int index = top_k - 1;
-  while (!beams_.empty()) {
-    auto item = beams_.top();
-    gsl::span<const int32_t>& source = item.hypothesis;
+  // Sorting the heap puts the hypotheses in the order of descending score.
+  auto beams = beams_.first(static_cast<size_t>(size_));
+  std::sort_heap(beams.begin(), beams.end(), HypothesisScoreCompare());
+
+  for (int index = 0; index < top_k; index++) {
+    const HypothesisScore& item = beams[index];
     gsl::span<int32_t> target = sequences.subspan(static_cast<gsl::index>(index) * max_length, max_length);
 
     // Note that word_ids might be less than max_length.
     // Since the sequences has been filled with pad token ID, so padding is not needed here.
-    gsl::copy(source, target);
+    gsl::copy(item.hypothesis, target);
 
     if (!sequences_scores.empty())
       sequences_scores[index] = item.score;
-
-    beams_.pop();
-    index--;
   }
+
+  size_ = 0;
 }
 
 BeamSearchScorer::BeamSearchScorer(size_t batch_size,
@@ -97,7 +102,6 @@ BeamSearchScorer::BeamSearchScorer(size_t batch_size,
                                    size_t num_return_sequences,
                                    int pad_token_id,
                                    int eos_token_id,
-                                   onnxruntime::OrtStlAllocator<HypothesisScore>& hypothesis_score_allocator,
                                    onnxruntime::OrtStlAllocator<BeamHypotheses>& beam_hyps_allocator)
     : batch_size_(batch_size),
       num_beams_(num_beams),
@@ -109,7 +113,7 @@ BeamSearchScorer::BeamSearchScorer(size_t batch_size,
       hypothesis_buffer_offset_(0),
       beam_hyps_(beam_hyps_allocator) {
   for (size_t i = 0; i < batch_size; i++) {
-    beam_hyps_.push_back(BeamHypotheses(num_beams, length_penalty, early_stopping, hypothesis_score_allocator));
+    beam_hyps_.push_back(BeamHypotheses(static_cast<int>(num_beams), length_penalty, early_stopping));
   }
 }
 
@@ -134,6 +138,12 @@ void BeamSearchScorer::Initialize(AllocatorPtr& allocator, int sequence_length)
   next_beam_tokens_ = Allocate<int32_t>(allocator, batch_beam_size, next_beam_tokens_ptr_, no_fill);
   next_beam_indices_ = Allocate<int32_t>(allocator, batch_beam_size, next_beam_indices_ptr_, no_fill);
 
+  // One heap of num_beams hypotheses per batch, so that adding hypotheses does not allocate.
+  hypothesis_scores_ = Allocate<HypothesisScore>(allocator, batch_beam_size, hypothesis_scores_ptr_, no_fill);
+  for (size_t batch = 0; batch < batch_size_; batch++) {
+    beam_hyps_[batch].Init(hypothesis_scores_.subspan(batch * num_beams_, num_beams_));
+  }
+
   // Space to store intermediate sequence with length sequence_length, sequence_length + 1, ..., max_sequence_length.
   size_t per_beam = (SafeInt<size_t>(max_length_) * (max_length_ + 1) - (sequence_length - 1) * sequence_length) / 2;
   hypothesis_buffer_length_ = batch_beam_size * per_beam;
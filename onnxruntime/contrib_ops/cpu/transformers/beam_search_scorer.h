@@ -4,7 +4,7 @@
 // The implementation is based on huggingface transformers generation_beam_search.py
 
 #pragma once
-#include <queue>
+#include <algorithm>
 #include <math.h>
 #include "core/common/common.h"
 #include "core/framework/allocator.h"
@@ -20,9 +20,6 @@ namespace contrib {
 namespace transformers {
 
 struct HypothesisScore {
-  HypothesisScore(gsl::span<const int32_t>& _hypothesis, float _score)
-      : hypothesis(_hypothesis), score(_score) {}
-
   gsl::span<const int32_t> hypothesis;
   float score;
 };
@@ -38,11 +35,13 @@ class BeamHypotheses {
  public:
   BeamHypotheses(int num_beams,
                  float length_penalty,
-                 bool early_stopping,
-                 onnxruntime::OrtStlAllocator<HypothesisScore>& hypothesis_score_allocator);
+                 bool early_stopping);
+
+  // Set the storage of the heap, which has space for num_beams hypotheses.
+  void Init(gsl::span<HypothesisScore> beams);
 
   // Number of hypotheses
-  int Size() { return static_cast<int>(beams_.size()); }
+  int Size() { return size_; }
 
   // Add a new hypothesis
   void Add(gsl::span<const int32_t>& hypothesis, float sum_logprobs);
@@ -61,8 +60,9 @@ class BeamHypotheses {
   bool early_stopping_;
   float worst_score_;
 
-  // Min-heap for top k
-  std::priority_queue<HypothesisScore, onnxruntime::FastAllocVector<HypothesisScore>, HypothesisScoreCompare> beams_;
+  // Fixed capacity min-heap for top k, in the first size_ elements of beams_.
+  gsl::span<HypothesisScore> beams_;
+  int size_;
 };
 
 class BeamSearchScorer : public IBeamScorer {
@@ -75,7 +75,6 @@ class BeamSearchScorer : public IBeamScorer {
                    size_t num_return_sequences,
                    int pad_token_id,
                    int eos_token_id,
-                   onnxruntime::OrtStlAllocator<HypothesisScore>& hypothesis_score_allocator,
                    onnxruntime::OrtStlAllocator<BeamHypotheses>& beam_hyps_allocator);
 
   void Initialize(AllocatorPtr& allocator, int sequence_length) override;
@@ -121,6 +120,9 @@ class BeamSearchScorer : public IBeamScorer {
   size_t hypothesis_buffer_length_;                     // Total number of elements
   size_t hypothesis_buffer_offset_;                     // Offset of available buffer, or length of used buffer.
 
+  IAllocatorUniquePtr<HypothesisScore> hypothesis_scores_ptr_;  // Allocated buffer for the heaps of all batches
+  gsl::span<HypothesisScore> hypothesis_scores_;                // Shape is (batch_size, num_beams)
+
   onnxruntime::FastAllocVector<BeamHypotheses> beam_hyps_;
 };
 
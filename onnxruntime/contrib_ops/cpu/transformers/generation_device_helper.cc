@@ -562,6 +562,66 @@ void PickGptPastState(const std::vector<OrtValue>& last_outputs,
   }
 }
 
+// Reorder the beams of the past state in place for GPT model, when past and present share a buffer of max length.
+// Only the first past_sequence_len rows of each head are valid so only those are moved, and beams that continue
+// from themselves are left untouched.
+template <typename T>
+void PickGptPastStateInPlace(std::vector<OrtValue>& next_inputs,
+                             gsl::span<const int32_t>& beam_indices,
+                             int gpt_subgraph_first_past_input_idx,
+                             int num_past_tensors,
+                             int past_sequence_len,
+                             AllocatorPtr allocator) {
+  std::vector<size_t> moved_beams;
+  for (size_t j = 0; j < beam_indices.size(); j++) {
+    if (beam_indices[j] != static_cast<int32_t>(j)) {
+      moved_beams.push_back(j);
+    }
+  }
+  if (moved_beams.empty() || past_sequence_len == 0) {
+    return;
+  }
+
+  // shape is like (2, batch_beam_size, 12, max_seq_len, 64)
+  const TensorShape& past_shape = next_inputs[gpt_subgraph_first_past_input_idx].Get<Tensor>().Shape();
+  const size_t num_heads = onnxruntime::narrow<size_t>(past_shape[2]);
+  const size_t head_block_size = onnxruntime::narrow<size_t>(past_shape[3] * past_shape[4]);
+  const size_t block_size_per_beam = num_heads * head_block_size;
+  const size_t past_key_size = onnxruntime::narrow<size_t>(past_shape[1]) * block_size_per_beam;
+  const size_t valid_size = static_cast<size_t>(past_sequence_len) * onnxruntime::narrow<size_t>(past_shape[4]);
+
+  // Stage the source beams first since a target beam can be the source of another one. The buffer is shared by
+  // all layers.
+  const size_t staged_size_per_beam = 2 * num_heads * valid_size;
+  auto staged = IAllocator::MakeUniquePtr<T>(allocator, SafeInt<size_t>(moved_beams.size()) * staged_size_per_beam);
+
+  for (int i = 0; i < num_past_tensors; ++i) {
+    T* past_data = next_inputs[gpt_subgraph_first_past_input_idx + i].GetMutable<Tensor>()->MutableData<T>();
+
+    T* dst = staged.get();
+    for (size_t j : moved_beams) {
+      const T* src_key = past_data + static_cast<size_t>(beam_indices[j]) * block_size_per_beam;
+      for (size_t kv = 0; kv < 2; kv++) {
+        for (size_t n = 0; n < num_heads; n++) {
+          std::copy_n(src_key + kv * past_key_size + n * head_block_size, valid_size, dst);
+          dst += valid_size;
+        }
+      }
+    }
+
+    const T* src = staged.get();
+    for (size_t j : moved_beams) {
+      T* dst_key = past_data + j * block_size_per_beam;
+      for (size_t kv = 0; kv < 2; kv++) {
+        for (size_t n = 0; n < num_heads; n++) {
+          std::copy_n(src, valid_size, dst_key + kv * past_key_size + n * head_block_size);
+          src += valid_size;
+        }
+      }
+    }
+  }
+}
+
 template <typename T>
 Status UpdateGptFeeds(
     AllocatorPtr allocator,
@@ -624,8 +684,15 @@ Status UpdateGptFeeds(
   next_inputs[2] = attention_mask;
 
   if (past_present_share_buffer) {
-    int32_t* past_seq_len_data = const_cast<int32_t*>(next_inputs.back().Get<Tensor>().Data<int32_t>());
-    *past_seq_len_data = past_sequence_len;
+    // next_inputs: input_ids, position_id, attention_mask, past_0, past_1, ..., past_sequence_length, implicit inputs
+    const int num_past_tensors = static_cast<int>(last_outputs.size()) - gpt_subgraph_first_present_output_idx;
+    const int k = gpt_subgraph_first_past_input_idx + num_past_tensors;
+    *(next_inputs[k].GetMutable<Tensor>()->MutableData<int32_t>()) = past_sequence_len;
+
+    if (num_beams > 1) {
+      PickGptPastStateInPlace<T>(next_inputs, beam_indices, gpt_subgraph_first_past_input_idx,
+                                 num_past_tensors, past_sequence_len, allocator);
+    }
     return Status::OK();
   }
 
@@ -725,8 +792,18 @@ void PickT5PastState(const std::vector<OrtValue>& last_outputs,
                      int t5_decoder_first_past_input_idx,
                      int t5_decoder_first_present_output_idx,
                      AllocatorPtr allocator) {
+  // When every beam continues from itself, present states can be fed to the next step as they are.
+  bool is_identity = true;
+  for (size_t j = 0; j < beam_indices.size() && is_identity; j++) {
+    is_identity = (beam_indices[j] == static_cast<int32_t>(j));
+  }
+
   for (ptrdiff_t i = 0; i < num_present_tensors; ++i) {
     const OrtValue& present = last_outputs[t5_decoder_first_present_output_idx + i];
+    if (is_identity) {
+      next_inputs[t5_decoder_first_past_input_idx + i] = present;
+      continue;
+    }
 
     // shape is like (batch_beam_size, 12, past_seq_len, 64)
     const TensorShape& past_shape = present.Get<Tensor>().Shape();
@@ -775,6 +852,8 @@ Status UpdateDecoderFeeds(
   //              past_key_self_0, past_value_self_0, ...
   //              past_key_cross_0, past_value_cross_0, ...
   // Only need copy beam next tokens to input_ids, and copy present_*_self_* to past_*_self_*,
+  // past_*_cross_* are computed by the encoder once and are shared by all beams of a batch, so they are never
+  // reordered.
 
   // Update input_ids with next tokens.
   int batch_beam_size = static_cast<int>(beam_next_tokens.size());
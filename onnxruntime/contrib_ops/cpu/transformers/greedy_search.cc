@@ -94,6 +94,13 @@ void GreedySearch::Init(const OpKernelInfo& info) {
     if (info.GetAttr<ONNX_NAMESPACE::GraphProto>("init_decoder", &proto).IsOK()) {
       has_init_decoder_ = true;
     }
+
+    // Check if the draft_decoder sub-graph attribute is present for the GPT2 model.
+    if (info.GetAttr<ONNX_NAMESPACE::GraphProto>("draft_decoder", &proto).IsOK()) {
+      has_draft_decoder_ = true;
+      num_draft_tokens_ = static_cast<int>(info.GetAttrOrDefault<int64_t>("num_draft_tokens", 4));
+      ORT_ENFORCE(num_draft_tokens_ > 0, "num_draft_tokens shall be positive, got ", num_draft_tokens_);
+    }
   }
 
   // Make sure the decoder sub-graph attribute is present for all model types.
@@ -129,6 +136,12 @@ Status GreedySearch::SetupSubgraphExecutionInfo(const SessionState& session_stat
 
       init_run_gpt_subgraph_ = std::move(res.second);
       init_run_decoder_feeds_fetches_manager_ = init_run_gpt_subgraph_->GetFeedsFetchesManager();
+    } else if (attribute_name == "draft_decoder") {
+      ORT_ENFORCE(draft_gpt_subgraph_ == nullptr, "SetupSubgraphExecutionInfo should only be called once for each subgraph.");
+      // The draft model has its own number of layers and heads, so the parameters are not updated from it.
+      draft_gpt_subgraph_ = std::make_unique<GptSubgraph>(node, attribute_name, subgraph_session_state.GetGraphViewer());
+      ORT_RETURN_IF_ERROR(draft_gpt_subgraph_->Setup(session_state, subgraph_session_state));
+      draft_decoder_feeds_fetches_manager_ = draft_gpt_subgraph_->GetFeedsFetchesManager();
     }
   } else if (parameters_.model_type == IGenerationParameters::kModelTypeT5) {  // encoder-decoder like T5
     ORT_THROW("Not Implemented");
@@ -176,6 +189,14 @@ Status GreedySearch::Compute(OpKernelContext* ctx) const {
                 "past_present_share_buffer mode must be same for init decoder and decoder subgraphes");
   }
 
+  auto* draft_decoder_session_state = ctx_internal->SubgraphSessionState("draft_decoder");
+  if (has_draft_decoder_) {
+    ORT_ENFORCE(draft_decoder_session_state, "Subgraph SessionState was not found for 'draft_decoder' attribute.");
+    ORT_ENFORCE(draft_decoder_feeds_fetches_manager_, "CreateFeedsFetchesManager must be called prior to execution of graph.");
+    ORT_RETURN_IF(draft_gpt_subgraph_->vocab_size != gpt_subgraph_->vocab_size,
+                  "draft_decoder and decoder subgraphs shall have the same vocabulary size");
+  }
+
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
   // make a copy since we will update the parameters based on inputs later
@@ -202,6 +223,10 @@ Status GreedySearch::Compute(OpKernelContext* ctx) const {
           device_copy_func_ ? device_copy_func_ : GenerationCpuDeviceHelper::DeviceCopy<float>,
           update_gpt_feeds_func_ ? update_gpt_feeds_func_ : GenerationCpuDeviceHelper::UpdateGptFeeds<float>};
       ORT_RETURN_IF_ERROR(impl.Initialize());
+      if (has_draft_decoder_) {
+        impl.SetDraftDecoder(draft_decoder_session_state, draft_gpt_subgraph_.get(),
+                             draft_decoder_feeds_fetches_manager_, num_draft_tokens_);
+      }
 
       return impl.Execute(init_run_decoder_feeds_fetches_manager_, *decoder_feeds_fetches_manager_);
     } else {
@@ -223,6 +248,10 @@ Status GreedySearch::Compute(OpKernelContext* ctx) const {
           device_copy_func_,
           update_gpt_feeds_fp16_func_};
       ORT_RETURN_IF_ERROR(impl.Initialize());
+      if (has_draft_decoder_) {
+        impl.SetDraftDecoder(draft_decoder_session_state, draft_gpt_subgraph_.get(),
+                             draft_decoder_feeds_fetches_manager_, num_draft_tokens_);
+      }
 
       return impl.Execute(init_run_decoder_feeds_fetches_manager_, *decoder_feeds_fetches_manager_);
     }
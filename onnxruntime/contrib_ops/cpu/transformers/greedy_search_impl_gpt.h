@@ -3,6 +3,7 @@
 
 #pragma once
 #include <algorithm>
+#include <numeric>
 #include <vector>
 
 #include "core/common/span_utils.h"
@@ -66,6 +67,17 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
   Status Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
                  const FeedsFetchesManager& feeds_fetches_manager);
 
+  // Use a draft model to propose tokens, which are verified by one run of the GPT subgraph.
+  void SetDraftDecoder(const SessionState* draft_session_state,
+                       GptSubgraph* draft_gpt_subgraph,
+                       const FeedsFetchesManager* draft_feeds_fetches_manager,
+                       int num_draft_tokens) {
+    draft_session_state_ = draft_session_state;
+    draft_gpt_subgraph_ = draft_gpt_subgraph;
+    draft_feeds_fetches_manager_ = draft_feeds_fetches_manager;
+    num_draft_tokens_ = num_draft_tokens;
+  }
+
  private:
   // Prepare the inputs for first inference of subgraph
   Status CreateInitialFeeds(gsl::span<int32_t>& sequence_lengths,
@@ -83,6 +95,35 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
       gsl::span<const int32_t> next_tokens,
       int past_sequence_length);
 
+  // Remove the rows of finished sequences from the inputs of next iteration, so that the subgraph only runs on
+  // sequences that are still generating. `kept_rows` are the rows of current inputs to keep.
+  Status CompactFeeds(std::vector<OrtValue>& feeds,
+                      OrtValue& position_ids,
+                      gsl::span<const int> kept_rows);
+
+  // Set the inputs of a GPT subgraph for one new token per sequence, with the past state made of the
+  // first past_length positions of the present outputs in `fetches`.
+  void SetSingleTokenFeeds(const GptSubgraph& subgraph,
+                           std::vector<OrtValue>& feeds,
+                           const std::vector<OrtValue>& fetches,
+                           gsl::span<const int32_t> tokens,
+                           const OrtValue& position_ids,
+                           const OrtValue& attention_mask,
+                           int past_length);
+
+  // Generate tokens with one run of the GPT subgraph: the draft subgraph proposes tokens, which are fed to the GPT
+  // subgraph together with the last generated token. Tokens are accepted until the first draft token that differs
+  // from the token chosen from logits of the GPT subgraph, so the sequences are the same as without the draft model.
+  Status SpeculativeDecodingStep(const FeedsFetchesManager& feeds_fetches_manager,
+                                 std::vector<OrtValue>& feeds,
+                                 std::vector<OrtValue>& draft_feeds,
+                                 OrtValue& position_ids,
+                                 GreedySearchState<T>& greedy_state,
+                                 SamplingState<T>& sampling_state,
+                                 int& current_length,
+                                 int& iteration_counter,
+                                 bool& all_finished);
+
   const SessionState* init_run_decoder_session_state_ = nullptr;
   GptSubgraph* init_run_gpt_subgraph_ = nullptr;
   GptSubgraph& gpt_subgraph_;
@@ -92,6 +133,12 @@ class GreedySearchGpt : public GreedySearchBase<T, ParametersT> {
   GenerationDeviceHelper::AddToFeedsFunc add_to_feeds_func_;
   GenerationDeviceHelper::InitGreedyStateFunc<T> init_greedy_state_func_;
   GenerationDeviceHelper::UpdateGptFeedsFunc<T> update_feeds_func_;
+
+  // Optional draft model for speculative decoding
+  const SessionState* draft_session_state_ = nullptr;
+  GptSubgraph* draft_gpt_subgraph_ = nullptr;
+  const FeedsFetchesManager* draft_feeds_fetches_manager_ = nullptr;
+  int num_draft_tokens_ = 0;
 };
 
 template <typename T, typename ParametersT>
@@ -161,6 +208,261 @@ Status GreedySearchGpt<T, ParametersT>::UpdateFeeds(
                             );
 }
 
+// Gather the given rows along an axis of a CPU tensor to a new tensor.
+inline OrtValue GatherTensorRows(const OrtValue& value, size_t axis, gsl::span<const int> rows,
+                                 AllocatorPtr allocator) {
+  const Tensor& tensor = value.Get<Tensor>();
+  const TensorShape& shape = tensor.Shape();
+  const size_t outer_size = onnxruntime::narrow<size_t>(shape.SizeToDimension(axis));
+  const size_t row_bytes = SafeInt<size_t>(shape.SizeFromDimension(axis + 1)) * tensor.DataType()->Size();
+  const size_t num_rows = onnxruntime::narrow<size_t>(shape[axis]);
+
+  TensorShapeVector dims = shape.AsShapeVector();
+  dims[axis] = static_cast<int64_t>(rows.size());
+  OrtValue result;
+  Tensor::InitOrtValue(tensor.DataType(), TensorShape(dims), std::move(allocator), result);
+
+  const char* source = static_cast<const char*>(tensor.DataRaw());
+  char* target = static_cast<char*>(result.GetMutable<Tensor>()->MutableDataRaw());
+  for (size_t i = 0; i < outer_size; i++) {
+    for (int row : rows) {
+      memcpy(target, source + (i * num_rows + row) * row_bytes, row_bytes);
+      target += row_bytes;
+    }
+  }
+  return result;
+}
+
+// Create an int32 tensor of shape (rows, cols), where element (i, j) is value_at(i, j).
+template <typename Func>
+OrtValue CreateInt32Tensor(size_t rows, size_t cols, Func value_at, AllocatorPtr allocator) {
+  int64_t dims[] = {static_cast<int64_t>(rows), static_cast<int64_t>(cols)};
+  OrtValue result;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<int32_t>(), TensorShape(dims), std::move(allocator), result);
+  int32_t* data = result.GetMutable<Tensor>()->MutableData<int32_t>();
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t j = 0; j < cols; j++) {
+      *data++ = value_at(i, j);
+    }
+  }
+  return result;
+}
+
+// Append num_new_tokens columns of 1 to an attention mask of shape (batch_size, length).
+inline OrtValue ExtendAttentionMask(const OrtValue& mask, int num_new_tokens, AllocatorPtr allocator) {
+  const Tensor& mask_tensor = mask.Get<Tensor>();
+  const size_t rows = onnxruntime::narrow<size_t>(mask_tensor.Shape()[0]);
+  const size_t cols = onnxruntime::narrow<size_t>(mask_tensor.Shape()[1]);
+  const int32_t* mask_data = mask_tensor.Data<int32_t>();
+  return CreateInt32Tensor(
+      rows, cols + static_cast<size_t>(num_new_tokens),
+      [&](size_t i, size_t j) { return j < cols ? mask_data[i * cols + j] : 1; },
+      std::move(allocator));
+}
+
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::CompactFeeds(std::vector<OrtValue>& feeds,
+                                                     OrtValue& position_ids,
+                                                     gsl::span<const int> kept_rows) {
+  // feeds: input_ids, position_ids, attention_mask with batch in dimension 0,
+  // and past_0, past_1, ... with shape (2, batch_size, num_heads, past_seq_len, head_size).
+  feeds[0] = GatherTensorRows(feeds[0], 0, kept_rows, this->temp_space_allocator_);
+  position_ids = GatherTensorRows(position_ids, 0, kept_rows, this->temp_space_allocator_);
+  feeds[1] = position_ids;
+  feeds[2] = GatherTensorRows(feeds[2], 0, kept_rows, this->temp_space_allocator_);
+
+  const int first_past_input_index = gpt_subgraph_.GetFirstPastInputIndex();
+  for (int layer = 0; layer < gpt_subgraph_.num_layers; layer++) {
+    OrtValue& past = feeds[static_cast<size_t>(first_past_input_index) + layer];
+    past = GatherTensorRows(past, 1, kept_rows, this->temp_space_allocator_);
+  }
+  return Status::OK();
+}
+
+template <typename T, typename ParametersT>
+void GreedySearchGpt<T, ParametersT>::SetSingleTokenFeeds(const GptSubgraph& subgraph,
+                                                          std::vector<OrtValue>& feeds,
+                                                          const std::vector<OrtValue>& fetches,
+                                                          gsl::span<const int32_t> tokens,
+                                                          const OrtValue& position_ids,
+                                                          const OrtValue& attention_mask,
+                                                          int past_length) {
+  feeds[0] = CreateInt32Tensor(
+      tokens.size(), 1, [&](size_t i, size_t) { return tokens[i]; }, this->temp_space_allocator_);
+  feeds[1] = position_ids;
+  feeds[2] = attention_mask;
+
+  // present_* has shape (2, batch_size, num_heads, total_length, head_size)
+  std::vector<int> past_positions(past_length);
+  std::iota(past_positions.begin(), past_positions.end(), 0);
+  for (int layer = 0; layer < subgraph.num_layers; layer++) {
+    const OrtValue& present = fetches[static_cast<size_t>(subgraph.GetFirstPresentOutputIndex()) + layer];
+    OrtValue& past = feeds[static_cast<size_t>(subgraph.GetFirstPastInputIndex()) + layer];
+    if (present.Get<Tensor>().Shape()[3] == past_length) {
+      past = present;
+    } else {
+      past = GatherTensorRows(present, 3, past_positions, this->temp_space_allocator_);
+    }
+  }
+}
+
+template <typename T, typename ParametersT>
+Status GreedySearchGpt<T, ParametersT>::SpeculativeDecodingStep(const FeedsFetchesManager& feeds_fetches_manager,
+                                                                std::vector<OrtValue>& feeds,
+                                                                std::vector<OrtValue>& draft_feeds,
+                                                                OrtValue& position_ids,
+                                                                GreedySearchState<T>& greedy_state,
+                                                                SamplingState<T>& sampling_state,
+                                                                int& current_length,
+                                                                int& iteration_counter,
+                                                                bool& all_finished) {
+  const ParametersT* parameters = this->parameters_;
+  const size_t batch_beam_size = static_cast<size_t>(parameters->BatchBeamSize());
+  const int past_length = current_length - 1;
+
+  // Verify no more draft tokens than what could be accepted before reaching max_length.
+  const int num_draft_tokens = std::min(num_draft_tokens_, parameters->max_length - current_length - 1);
+  const size_t verify_length = static_cast<size_t>(num_draft_tokens) + 1;
+
+  // Both subgraphs have inputs for the last generated token, see SetSingleTokenFeeds.
+  gsl::span<const int32_t> last_tokens = feeds[0].Get<Tensor>().DataAsSpan<int32_t>();
+  gsl::span<int32_t> positions = position_ids.GetMutable<Tensor>()->MutableDataAsSpan<int32_t>();
+  const OrtValue attention_mask = feeds[2];
+
+  auto execute_subgraph = [this](const SessionState& session_state,
+                                 const FeedsFetchesManager& subgraph_feeds_fetches_manager,
+                                 const std::vector<OrtValue>& subgraph_feeds,
+                                 std::vector<OrtValue>& subgraph_fetches) {
+    return utils::ExecuteSubgraph(session_state,
+                                  subgraph_feeds_fetches_manager,
+                                  subgraph_feeds,
+                                  subgraph_fetches,
+                                  {},
+                                  ExecutionMode::ORT_SEQUENTIAL,
+                                  this->context_.GetTerminateFlag(),
+                                  this->context_.Logger(),
+                                  this->ort_stream_);
+  };
+
+  // verify_tokens[i * verify_length + j] is the j-th token fed to the GPT subgraph for sequence i.
+  std::vector<int32_t> verify_tokens(batch_beam_size * verify_length);
+  for (size_t i = 0; i < batch_beam_size; i++) {
+    verify_tokens[i * verify_length] = last_tokens[i];
+  }
+
+  // Propose tokens greedily with the draft subgraph. The past state of the draft model shall contain all the
+  // tokens fed to the GPT subgraph, so the draft subgraph runs once more after the last draft token is proposed.
+  std::vector<OrtValue> draft_fetches;
+  std::vector<int32_t> draft_tokens(batch_beam_size);
+  for (int step = 0; num_draft_tokens > 0; step++) {
+#ifdef DEBUG_NODE_INPUTS_OUTPUTS
+    const_cast<SessionState*>(draft_session_state_)->IncrementGraphExecutionCounter();
+#endif
+    ORT_RETURN_IF_ERROR(execute_subgraph(*draft_session_state_, *draft_feeds_fetches_manager_,
+                                         draft_feeds, draft_fetches));
+    if (step == num_draft_tokens) {
+      break;
+    }
+
+    const Tensor& draft_logits = draft_fetches[0].Get<Tensor>();
+    const size_t vocab_size = onnxruntime::narrow<size_t>(draft_logits.Shape()[2]);
+    const T* logits_data = draft_logits.Data<T>();
+    for (size_t i = 0; i < batch_beam_size; i++) {
+      const T* row = logits_data + i * vocab_size;
+      draft_tokens[i] = static_cast<int32_t>(
+          std::max_element(row, row + vocab_size,
+                           [](const T& a, const T& b) { return static_cast<float>(a) < static_cast<float>(b); }) -
+          row);
+      verify_tokens[i * verify_length + step + 1] = draft_tokens[i];
+    }
+
+    OrtValue draft_position_ids = CreateInt32Tensor(
+        batch_beam_size, 1, [&](size_t i, size_t) { return positions[i] + step + 1; }, this->temp_space_allocator_);
+    SetSingleTokenFeeds(*draft_gpt_subgraph_, draft_feeds, draft_fetches, draft_tokens, draft_position_ids,
+                        ExtendAttentionMask(attention_mask, step + 1, this->temp_space_allocator_),
+                        past_length + step + 1);
+    draft_fetches.clear();
+  }
+
+  // Run the GPT subgraph on the last generated token and the draft tokens.
+  feeds[0] = CreateInt32Tensor(
+      batch_beam_size, verify_length, [&](size_t i, size_t j) { return verify_tokens[i * verify_length + j]; },
+      this->temp_space_allocator_);
+  feeds[1] = CreateInt32Tensor(
+      batch_beam_size, verify_length, [&](size_t i, size_t j) { return positions[i] + static_cast<int32_t>(j); },
+      this->temp_space_allocator_);
+  feeds[2] = ExtendAttentionMask(attention_mask, num_draft_tokens, this->temp_space_allocator_);
+
+  std::vector<OrtValue> fetches;
+#ifdef DEBUG_NODE_INPUTS_OUTPUTS
+  const_cast<SessionState&>(this->decoder_session_state_).IncrementGraphExecutionCounter();
+#endif
+  ORT_RETURN_IF_ERROR(execute_subgraph(this->decoder_session_state_, feeds_fetches_manager, feeds, fetches));
+
+  // Logits has shape (batch_size, verify_length, vocab_size). Process the logits of one position at a time so that
+  // logits processors see the same sequences as when tokens are generated one by one.
+  const Tensor& logits = fetches[0].Get<Tensor>();
+  const size_t vocab_size = onnxruntime::narrow<size_t>(logits.Shape()[2]);
+  int64_t step_logits_dims[] = {static_cast<int64_t>(batch_beam_size), 1, static_cast<int64_t>(vocab_size)};
+  OrtValue step_logits;
+  Tensor::InitOrtValue(logits.DataType(), TensorShape(step_logits_dims), this->temp_space_allocator_, step_logits);
+
+  gsl::span<bool>& eos_meet = greedy_state.eos_meet;
+  gsl::span<int32_t> next_tokens;
+  int num_accepted = 0;
+  for (size_t j = 0; j < verify_length; j++) {
+    const T* source = logits.Data<T>() + j * vocab_size;
+    T* target = step_logits.GetMutable<Tensor>()->MutableData<T>();
+    for (size_t i = 0; i < batch_beam_size; i++) {
+      std::copy_n(source + i * verify_length * vocab_size, vocab_size, target + i * vocab_size);
+    }
+
+    ORT_RETURN_IF_ERROR(this->GenerateNextToken(step_logits,
+                                                next_tokens,
+                                                greedy_state,
+                                                sampling_state,
+                                                ++iteration_counter,
+                                                parameters->eos_token_id));
+    ++num_accepted;
+    ++current_length;
+
+    all_finished = std::all_of(eos_meet.begin(), eos_meet.end(), [](bool eos) { return eos; });
+    if (all_finished || current_length >= parameters->max_length || j + 1 == verify_length) {
+      break;
+    }
+
+    // Stop at the first draft token that is not the generated one. Finished sequences only get padding.
+    bool draft_accepted = true;
+    for (size_t i = 0; i < batch_beam_size; i++) {
+      if (!eos_meet[i] && next_tokens[i] != verify_tokens[i * verify_length + j + 1]) {
+        draft_accepted = false;
+        break;
+      }
+    }
+    if (!draft_accepted) {
+      break;
+    }
+  }
+
+  if (all_finished || current_length >= parameters->max_length) {
+    return Status::OK();
+  }
+
+  // Continue both subgraphs after the accepted tokens, dropping the past state of the rejected ones.
+  for (size_t i = 0; i < batch_beam_size; i++) {
+    positions[i] += num_accepted;
+  }
+  OrtValue next_attention_mask = ExtendAttentionMask(attention_mask, num_accepted, this->temp_space_allocator_);
+  SetSingleTokenFeeds(gpt_subgraph_, feeds, fetches, next_tokens, position_ids, next_attention_mask,
+                      past_length + num_accepted);
+  if (num_draft_tokens > 0) {
+    SetSingleTokenFeeds(*draft_gpt_subgraph_, draft_feeds, draft_fetches, next_tokens, position_ids,
+                        next_attention_mask, past_length + num_accepted);
+  }
+
+  return Status::OK();
+}
+
 template <typename T, typename ParametersT>
 Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_run_feeds_fetches_manager,
                                                 const FeedsFetchesManager& feeds_fetches_manager) {
@@ -199,6 +501,41 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
   OrtValue expanded_input_ids_in_cpu;
   ORT_RETURN_IF_ERROR(CreateInitialFeeds(greedy_state.sequence_lengths, expanded_input_ids_in_cpu, feeds, buffer));
 
+  // The draft model runs on the prompt first, and joins after the first token is generated by the GPT subgraph.
+  std::vector<OrtValue> draft_feeds;
+  std::vector<OrtValue> draft_prompt_fetches;
+  IAllocatorUniquePtr<char> draft_buffer;
+  OrtValue draft_expanded_input_ids;
+  if (draft_gpt_subgraph_ != nullptr) {
+    ORT_RETURN_IF(this->IsCuda() || gpt_subgraph_.past_present_share_buffer_ ||
+                      draft_gpt_subgraph_->past_present_share_buffer_,
+                  "draft_decoder is only supported on CPU, and without sharing buffer for past and present");
+
+    std::vector<int32_t> draft_sequence_lengths(static_cast<size_t>(parameters->BatchBeamSize()));
+    gsl::span<int32_t> draft_sequence_lengths_span(draft_sequence_lengths);
+    ORT_RETURN_IF_ERROR(draft_gpt_subgraph_->CreateInitialFeeds(*this->context_.Input<Tensor>(0),
+                                                                this->implicit_inputs_,
+                                                                parameters->num_beams,
+                                                                parameters->pad_token_id,
+                                                                draft_sequence_lengths_span,
+                                                                draft_expanded_input_ids,
+                                                                this->context_.GetInputOrtValue(6),
+                                                                draft_feeds,
+                                                                this->create_inputs_func_,
+                                                                this->add_to_feeds_func_,
+                                                                draft_buffer,
+                                                                this->ort_stream_));
+    ORT_RETURN_IF_ERROR(utils::ExecuteSubgraph(*draft_session_state_,
+                                               *draft_feeds_fetches_manager_,
+                                               draft_feeds,
+                                               draft_prompt_fetches,
+                                               {},
+                                               ExecutionMode::ORT_SEQUENTIAL,
+                                               this->context_.GetTerminateFlag(),
+                                               this->context_.Logger(),
+                                               this->ort_stream_));
+  }
+
   if (gpt_subgraph_.past_present_share_buffer_) { // Reuse past and present
     fetches.reserve((int64_t)gpt_subgraph_.GetFirstPresentOutputIndex() + gpt_subgraph_.num_layers);
     fetches.resize(gpt_subgraph_.GetFirstPresentOutputIndex(), OrtValue());
@@ -237,6 +574,18 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
                        this->temp_space_allocator_->Info(),
                        position_ids);
 
+  // On CPU, sequences leave the batch once they meet EOS, so the subgraph only runs on unfinished sequences.
+  // active_rows maps a row of the subgraph inputs to the index of the sequence in the batch, and the logits of
+  // active rows are scattered to full_logits so that logits processing works on the whole batch as before.
+  const bool compact_finished_sequences = !this->IsCuda() && !gpt_subgraph_.past_present_share_buffer_ &&
+                                          parameters->num_beams == 1 && draft_gpt_subgraph_ == nullptr;
+  const int batch_beam_size = static_cast<int>(parameters->BatchBeamSize());
+  std::vector<int> active_rows(batch_beam_size);
+  std::iota(active_rows.begin(), active_rows.end(), 0);
+  std::vector<int> kept_rows;
+  std::vector<int32_t> active_next_tokens;
+  OrtValue full_logits;
+
   int current_length = parameters->sequence_length;
   int iteration_counter = 0;
   while (current_length < parameters->max_length) {
@@ -249,6 +598,24 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
     dumper->Print("past", feeds[3]);
 #endif
 
+    if (draft_gpt_subgraph_ != nullptr && iteration_counter > 0) {
+      if (!draft_prompt_fetches.empty()) {
+        SetSingleTokenFeeds(*draft_gpt_subgraph_, draft_feeds, draft_prompt_fetches,
+                            feeds[0].Get<Tensor>().DataAsSpan<int32_t>(), position_ids, feeds[2],
+                            current_length - 1);
+        draft_prompt_fetches.clear();
+      }
+
+      bool all_finished = false;
+      ORT_RETURN_IF_ERROR(SpeculativeDecodingStep(feeds_fetches_manager, feeds, draft_feeds, position_ids,
+                                                  greedy_state, sampling_state, current_length,
+                                                  iteration_counter, all_finished));
+      if (all_finished) {
+        break;
+      }
+      continue;
+    }
+
     // For the first iteration use the init_run_decoder subgraph (if present)
     if (iteration_counter++ == 0 &&
         init_run_decoder_session_state_ != nullptr) {
@@ -281,10 +648,26 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
 
     ORT_RETURN_IF_ERROR(status);
 
-    const OrtValue& logits = fetches[0];
+    const OrtValue* logits = &fetches[0];
+    if (active_rows.size() < static_cast<size_t>(batch_beam_size)) {
+      const Tensor& active_logits = fetches[0].Get<Tensor>();
+      const size_t row_size = onnxruntime::narrow<size_t>(active_logits.Shape().SizeFromDimension(1));
+      if (!full_logits.IsAllocated()) {
+        int64_t logits_dims[] = {batch_beam_size, 1, active_logits.Shape()[2]};
+        Tensor::InitOrtValue(active_logits.DataType(), TensorShape(logits_dims), this->temp_space_allocator_,
+                             full_logits);
+        memset(full_logits.GetMutable<Tensor>()->MutableDataRaw(), 0, full_logits.Get<Tensor>().SizeInBytes());
+      }
+      const T* source = active_logits.Data<T>();
+      T* target = full_logits.GetMutable<Tensor>()->MutableData<T>();
+      for (size_t i = 0; i < active_rows.size(); i++) {
+        std::copy_n(source + i * row_size, row_size, target + static_cast<size_t>(active_rows[i]) * row_size);
+      }
+      logits = &full_logits;
+    }
     gsl::span<int32_t> next_tokens;
 
-    ORT_RETURN_IF_ERROR(this->GenerateNextToken(logits,
+    ORT_RETURN_IF_ERROR(this->GenerateNextToken(*logits,
                                                 next_tokens,
                                                 greedy_state,
                                                 sampling_state,
@@ -311,10 +694,31 @@ Status GreedySearchGpt<T, ParametersT>::Execute(const FeedsFetchesManager* init_
     if (current_length < parameters->max_length) {
       bool increase_position = (iteration_counter > 1);
 
+      gsl::span<const int32_t> feed_tokens = next_tokens;
+      if (compact_finished_sequences) {
+        active_next_tokens.clear();
+        kept_rows.clear();
+        for (size_t i = 0; i < active_rows.size(); i++) {
+          active_next_tokens.push_back(next_tokens[active_rows[i]]);
+          if (!eos_meet[active_rows[i]]) {
+            kept_rows.push_back(static_cast<int>(i));
+          }
+        }
+        feed_tokens = active_next_tokens;
+      }
+
       ORT_RETURN_IF_ERROR(UpdateFeeds(fetches, feeds, current_length,
                                       position_ids, increase_position,
-                                      ReinterpretAsSpan<const int32_t>(next_tokens),
+                                      feed_tokens,
                                       current_length - 1));
+
+      if (compact_finished_sequences && kept_rows.size() < active_rows.size()) {
+        ORT_RETURN_IF_ERROR(CompactFeeds(feeds, position_ids, kept_rows));
+        for (size_t i = 0; i < kept_rows.size(); i++) {
+          active_rows[i] = active_rows[kept_rows[i]];
+        }
+        active_rows.resize(kept_rows.size());
+      }
     }
     if (gpt_subgraph_.past_present_share_buffer_) {
       // clear fetched values before presents[]
@@ -2,54 +2,63 @@
 // Licensed under the MIT License.
 #pragma once
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 namespace onnxruntime {
 namespace contrib {
 namespace SamplingCpuHelper {
 
+// Returns the number of tokens kept by top-p filtering. On return, the first kept entries of `indices` are the
+// kept tokens in descending order of probability.
+// Tokens are ranked by probability without sorting the whole vocabulary: a growing number of candidates is partially
+// sorted until a token that is filtered out is found among them, and the kept tokens are usually a small part of it.
 template <typename T>
-void filter_scores(std::vector<size_t>& sorted_indice,
-                   gsl::span<T>& next_token_score,
-                   const transformers::IGenerationParameters* parameters,
-                   size_t index) {
-  size_t real_index = sorted_indice[index];
-  next_token_score[real_index] = (T)parameters->filter_value;
-}
-
-template <typename T>
-void cumulate_and_filter_custom(gsl::span<T>& next_token_scores,
-                                gsl::span<T>& cumulative_probs,
-                                const transformers::IGenerationParameters* parameters,
-                                std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] > parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, 1 + offset);
+size_t select_top_p(gsl::span<const T> probs,
+                    const transformers::IGenerationParameters* parameters,
+                    std::vector<int32_t>& indices) {
+  const size_t vocab_size = probs.size();
+  std::iota(indices.begin(), indices.end(), 0);
+
+  // The token at rank r is filtered out when, in ascending order of probability, the cumulative probability up to
+  // the token is no more than 1 - top_p, i.e. the total minus the probabilities of tokens ranked before it.
+  // In custom sampling, the cumulative probability in descending order up to the token before it shall be no more than
+  // top_p. The top token is always kept.
+  T total = 0;
+  if (!parameters->custom_sampling) {
+    total = std::accumulate(probs.begin(), probs.end(), T{0});
+  }
+  const size_t min_tokens_to_keep = parameters->custom_sampling
+                                        ? 1
+                                        : static_cast<size_t>(std::max(parameters->min_tokens_to_keep, 0));
+  auto keep = [&](size_t rank, T cumulative) {
+    if (rank < min_tokens_to_keep) {
+      return true;
     }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - 1; j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] > parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, j + offset + 1);
+    return parameters->custom_sampling ? cumulative <= parameters->top_p
+                                       : total - cumulative > 1 - parameters->top_p;
+  };
+
+  auto greater = [&probs](int32_t a, int32_t b) { return probs[a] > probs[b]; };
+  constexpr size_t kInitialCandidates = 256;
+  size_t num_sorted = 0;
+  size_t num_candidates = std::min(vocab_size, kInitialCandidates);
+  T cumulative = 0;
+  while (true) {
+    std::partial_sort(indices.begin() + num_sorted, indices.begin() + num_candidates, indices.end(), greater);
+    for (size_t rank = num_sorted; rank < num_candidates; rank++) {
+      if (!keep(rank, cumulative)) {
+        return rank;
       }
+      cumulative += probs[indices[rank]];
     }
-  }
-}
 
-template <typename T>
-void cumulate_and_filter(gsl::span<T>& next_token_scores,
-                         gsl::span<T>& cumulative_probs,
-                         const transformers::IGenerationParameters* parameters,
-                         std::vector<size_t>& sorted_indices) {
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    size_t offset = i * parameters->vocab_size;
-    if (cumulative_probs[offset] <= 1 - parameters->top_p) {
-      filter_scores(sorted_indices, next_token_scores, parameters, offset);
-    }
-    for (size_t j = 1; j < static_cast<size_t>(parameters->vocab_size) - static_cast<size_t>(parameters->min_tokens_to_keep); j++) {
-      cumulative_probs[j + offset] += cumulative_probs[j + offset - 1];
-      if (cumulative_probs[j + offset] <= 1 - parameters->top_p) {
-        filter_scores(sorted_indices, next_token_scores, parameters, j + offset);
-      }
+    if (num_candidates == vocab_size) {
+      return vocab_size;
     }
+    num_sorted = num_candidates;
+    num_candidates = std::min(vocab_size, num_candidates * 4);
   }
 }
 
@@ -63,45 +72,24 @@ Status Sample(AllocatorPtr& allocator,
               const transformers::IConsoleDumper* dumper) {
   ORT_UNUSED_PARAMETER(dumper);
 
-  gsl::span<T>& sorted_scores = sampling_state->sorted_scores;
-  memcpy(sorted_scores.data(), next_token_scores.data(), next_token_scores.size_bytes());
-  std::vector<size_t> sorted_indices(static_cast<size_t>(parameters->batch_size) * static_cast<size_t>(parameters->vocab_size));
-
-  std::function<bool(T, T)> predicator;
-  if (parameters->custom_sampling) {
-    predicator = std::greater<T>();
-  } else {
-    predicator = std::less<T>();
-  }
-
-  // TODO: This could be optimized with allocated buffer and handwritten sort algorithm
-  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
-    auto indices_begin = sorted_indices.begin() + i * parameters->vocab_size;
-    auto indices_end = sorted_indices.begin() + (i + 1) * parameters->vocab_size;
-    std::iota(indices_begin, indices_end, 0);
-    std::sort(indices_begin, indices_end,
-              [&next_token_scores, &predicator](size_t i1, size_t i2) {
-                return !predicator(next_token_scores[i1], next_token_scores[i2]);
-              });
-
-    std::sort(sorted_scores.begin() + i * parameters->vocab_size,
-              sorted_scores.begin() + (i + 1) * parameters->vocab_size,
-              predicator);
-  }
-
+  // Probabilities of the unfiltered scores, for top-p filtering.
   gsl::span<T>& cumulative_probs = sampling_state->cumulative_probs;
-
   ORT_RETURN_IF_ERROR(SoftmaxCPU<T>(parameters->batch_size,
                                     parameters->vocab_size,
-                                    sorted_scores.data(),
+                                    next_token_scores.data(),
                                     cumulative_probs.data(),
                                     false,
                                     thread_pool));
 
-  if (parameters->custom_sampling) {
-    cumulate_and_filter_custom(next_token_scores, cumulative_probs, parameters, sorted_indices);
-  } else {
-    cumulate_and_filter(next_token_scores, cumulative_probs, parameters, sorted_indices);
+  const size_t vocab_size = static_cast<size_t>(parameters->vocab_size);
+  std::vector<int32_t> indices(vocab_size);
+  for (size_t i = 0; i < static_cast<size_t>(parameters->batch_size); i++) {
+    gsl::span<const T> probs = cumulative_probs.subspan(i * vocab_size, vocab_size);
+    gsl::span<T> scores = next_token_scores.subspan(i * vocab_size, vocab_size);
+    const size_t num_kept = select_top_p(probs, parameters, indices);
+    for (size_t rank = num_kept; rank < vocab_size; rank++) {
+      scores[indices[rank]] = (T)parameters->filter_value;
+    }
   }
 
   gsl::span<T>& next_token_probs = sampling_state->h_softmaxed_score;
@@ -8,21 +8,30 @@ namespace onnxruntime {
 namespace contrib {
 namespace transformers {
 
-void Sequences::Init(gsl::span<int32_t> buffer, int batch_beam_size, int sequence_length, int max_length) {
+void Sequences::Init(gsl::span<int32_t> buffer, int batch_beam_size, int sequence_length, int max_length,
+                     gsl::span<int32_t> parents) {
   size_t sequences_size = SafeInt<size_t>(batch_beam_size) * max_length;
   assert(buffer.size() == sequences_size + sequences_size);
+  assert(parents.empty() || parents.size() == sequences_size);
 
   sequences[0] = buffer.subspan(0, sequences_size);
   sequences[1] = buffer.subspan(sequences_size);
 
   current_sequences_buffer = 0;
 
+  parents_ = parents;
+  materialized_length_ = sequence_length;
+
   batch_beam_size_ = batch_beam_size;
   max_length_ = max_length;
   current_length_ = sequence_length;
 }
 
 gsl::span<const int32_t> Sequences::GetSequence(int beam_index) const {
+  if (materialized_length_ < current_length_) {
+    Materialize();
+  }
+
   gsl::span<const int32_t> buffer(sequences[current_sequences_buffer].data(),
                                   sequences[current_sequences_buffer].size());
   gsl::span<const int32_t> sequence = buffer.subspan(SafeInt<size_t>(beam_index) * max_length_,
@@ -44,31 +53,50 @@ void Sequences::PrintSequences(const IConsoleDumper* dumper) const {
 }
 #endif
 
-void Sequences::AppendNextTokenToSequences(
-    gsl::span<int32_t>& beam_indices,
-    gsl::span<int32_t>& beam_next_tokens) {
+void Sequences::Materialize() const {
   gsl::span<const int32_t> input(sequences[current_sequences_buffer].data(),
                                  sequences[current_sequences_buffer].size());
   gsl::span<int32_t> output = sequences[1 - current_sequences_buffer];
 
   for (int i = 0; i < batch_beam_size_; i++) {
-    int beam_index = beam_indices[i];
-    gsl::span<const int32_t> source = input.subspan(SafeInt<size_t>(beam_index) * max_length_,
-                                                    static_cast<gsl::index>(current_length_));
     gsl::span<int32_t> target = output.subspan(SafeInt<size_t>(i) * max_length_,
                                                static_cast<gsl::index>(current_length_));
-    gsl::copy(source, target);
+
+    // Follow the back-pointers to collect the tokens appended since last time. Each token is still stored in the
+    // row of the beam that got it.
+    int beam_index = i;
+    for (int t = current_length_ - 1; t >= materialized_length_; t--) {
+      target[t] = input[SafeInt<size_t>(beam_index) * max_length_ + t];
+      beam_index = parents_[SafeInt<size_t>(t) * batch_beam_size_ + beam_index];
+    }
+
+    gsl::span<const int32_t> source = input.subspan(SafeInt<size_t>(beam_index) * max_length_,
+                                                    static_cast<gsl::index>(materialized_length_));
+    gsl::copy(source, target.first(static_cast<size_t>(materialized_length_)));
   }
 
-  // Append next token to each beam.
+  materialized_length_ = current_length_;
+
+  // Rotate buffer so that the rebuilt sequences are active.
+  current_sequences_buffer = 1 - current_sequences_buffer;
+}
+
+void Sequences::AppendNextTokenToSequences(
+    gsl::span<int32_t>& beam_indices,
+    gsl::span<int32_t>& beam_next_tokens) {
+  ORT_ENFORCE(!parents_.empty(), "Sequences must be initialized with a parents buffer to reorder beams");
+
+  gsl::span<int32_t> output = sequences[current_sequences_buffer];
+  gsl::span<int32_t> parents = parents_.subspan(SafeInt<size_t>(current_length_) * batch_beam_size_,
+                                                static_cast<size_t>(batch_beam_size_));
+
+  // Record the next token of each beam, and the beam it extends.
   for (int i = 0; i < batch_beam_size_; i++) {
     output[SafeInt<size_t>(i) * max_length_ + current_length_] = beam_next_tokens[i];
+    parents[i] = beam_indices[i];
   }
 
   ++current_length_;
-
-  // Rotate buffer for next round.
-  current_sequences_buffer = 1 - current_sequences_buffer;
 }
 
 void Sequences::AppendNextTokenToSequences(
@@ -80,6 +108,11 @@ void Sequences::AppendNextTokenToSequences(
     output[SafeInt<size_t>(i) * max_length_ + current_length_] = next_tokens[i];
   }
 
+  // Sequences are not reordered, so they stay complete when they were before.
+  if (materialized_length_ == current_length_) {
+    ++materialized_length_;
+  }
+
   ++current_length_;
 }
 
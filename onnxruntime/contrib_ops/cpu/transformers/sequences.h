@@ -11,12 +11,18 @@ namespace contrib {
 namespace transformers {
 
 // This class keeps track of sequences generated.
+//
+// When beams are reordered, the new tokens are recorded together with the index of the beam they extend
+// (a back-pointer), so that AppendNextTokenToSequences costs O(beams) instead of O(beams x length).
+// The contiguous sequences are only rebuilt from the back-pointers when they are read through GetSequence.
 class Sequences : public ISequences {
  public:
   Sequences() {}
 
-  // Initialize the sequence.
-  void Init(gsl::span<int32_t> buffer, int batch_beam_size, int sequence_length, int max_length);
+  // Initialize the sequence. The parents buffer, of shape (max_length, batch_beam_size), is required to reorder
+  // beams with AppendNextTokenToSequences(beam_indices, beam_next_tokens).
+  void Init(gsl::span<int32_t> buffer, int batch_beam_size, int sequence_length, int max_length,
+            gsl::span<int32_t> parents = {});
 
   // Returns a sequence of word IDs for a given beam index ( beam_index < batch_beam_size).
   gsl::span<const int32_t> GetSequence(int beam_index) const override;
@@ -30,6 +36,7 @@ class Sequences : public ISequences {
 #endif
 
   // Select sequences based on beam indices, then append next token to selected sequences.
+  // Only the token and the selected beam index are recorded here. See GetSequence.
   void AppendNextTokenToSequences(
       gsl::span<int32_t>& beam_indices,
       gsl::span<int32_t>& beam_next_tokens);
@@ -38,13 +45,24 @@ class Sequences : public ISequences {
       gsl::span<int32_t>& next_tokens);
 
  private:
+  // Rebuilds the contiguous sequences of the active buffer from the back-pointers recorded since last time.
+  void Materialize() const;
+
   // Two buffers of shape (batch_size, num_beams, max_seq_length) to store sequences.
-  // At each time, there is only one buffer is active. The other one will be active in next token.
-  // Each AppendNextTokenToSequences call will trigger a rotation of active buffer.
-  gsl::span<int32_t> sequences[2];
+  // At each time, there is only one buffer is active. The other one will be active once the sequences are
+  // rebuilt after a reorder. In the active buffer, positions before materialized_length_ hold the sequences of
+  // each beam, and position t >= materialized_length_ of row i holds the token that beam i got at step t.
+  mutable gsl::span<int32_t> sequences[2];
 
   // Index (either 0 or 1) of two buffers that is currently is active.
-  int current_sequences_buffer;
+  mutable int current_sequences_buffer;
+
+  // Back-pointers of shape (max_length, batch_beam_size): parents[t][i] is the beam that beam i extended with its
+  // token at position t.
+  gsl::span<int32_t> parents_;
+
+  // Length up to which the rows of the active buffer are the complete sequences.
+  mutable int materialized_length_;
 
   int batch_beam_size_;
   int max_length_;
@@ -19,6 +19,23 @@ __device__ __forceinline__ Half4 operator+(const Half4& a, const Half4& b) {
   return r;
 }
 
+// 128-bit vector of 8 halves.
+struct __align__(16) Half8 {
+  half2 x;
+  half2 y;
+  half2 z;
+  half2 w;
+};
+
+__device__ __forceinline__ Half8 operator+(const Half8& a, const Half8& b) {
+  Half8 r;
+  r.x = a.x + b.x;
+  r.y = a.y + b.y;
+  r.z = a.z + b.z;
+  r.w = a.w + b.w;
+  return r;
+}
+
 __device__ __forceinline__ float2 operator+(const float2& a, const float2& b) {
   return make_float2(a.x + b.x, a.y + b.y);
 }
@@ -340,7 +357,15 @@ void LaunchAddBiasTranspose(
     const half* input, const half* biases, half* output,
     bool enable_half4, const int v_head_size, int total_matrix_count) {
   total_matrix_count = std::max(num_matrices, total_matrix_count);
-  if (enable_half4 && 0 == (qk_head_size % 4) && 0 == (v_head_size % 4)) {
+  if (enable_half4 && 0 == (qk_head_size % 8) && 0 == (v_head_size % 8)) {
+    const int H = qk_head_size / 8;
+    const int H_v = v_head_size / 8;
+    const Half8* input2 = reinterpret_cast<const Half8*>(input);
+    const Half8* biases2 = reinterpret_cast<const Half8*>(biases);
+    Half8* output2 = reinterpret_cast<Half8*>(output);
+    InvokeAddBiasTranspose<Half8>(stream, num_matrices, format, max_threads_per_block,
+                                  batch_size, sequence_length, num_heads, H, input2, biases2, output2, H_v, total_matrix_count);
+  } else if (enable_half4 && 0 == (qk_head_size % 4) && 0 == (v_head_size % 4)) {
     const int H = qk_head_size / 4;
     const int H_v = v_head_size / 4;
     const Half4* input2 = reinterpret_cast<const Half4*>(input);
@@ -394,6 +419,81 @@ void LaunchAddBiasTranspose(
   }
 }
 
+template <typename T>
+__global__ void AddBiasTransposeQKVRotary(const int head_size, const int v_head_size, const int rotary_embedding_dim,
+                                          const int past_sequence_length, const T* input, const T* biases,
+                                          T* output) {
+  // Input:  BxSxMxNxH (Format 1), and H_v for V
+  // Output: MxBxNxSxH, where the first rotary_embedding_dim elements of each head of Q and K are rotated.
+  // B is batch_size, S is sequence_length, M is number of matrices (3), N is num_heads, H is head_size
+  const int s = blockIdx.x;
+  const int b = blockIdx.y;
+  const int m = blockIdx.z;  // matrix id
+
+  const int N = blockDim.y;
+  const int S = gridDim.x;
+  const int B = gridDim.y;
+
+  const int n = threadIdx.y;
+  const int H = (m == 2 ? v_head_size : head_size);
+  const int NH = N * head_size;
+  const int in_offset = (b * S + s) * (2 * NH + N * v_head_size) + m * NH + n * H;
+  const int out_offset = m * B * NH * S + ((b * N + n) * S + s) * H;
+  const int half_dim = rotary_embedding_dim / 2;
+  const float position = static_cast<float>(past_sequence_length + s);
+
+  for (int h = threadIdx.x; h < H; h += blockDim.x) {
+    float x = static_cast<float>(input[in_offset + h]);
+    if (biases != nullptr) {
+      x += static_cast<float>(biases[m * NH + n * H + h]);
+    }
+
+    if (m < 2 && h < rotary_embedding_dim) {
+      // Rotate element i of the first half with element i of the second half.
+      const int i = (h < half_dim ? h : h - half_dim);
+      const int partner = (h < half_dim ? h + half_dim : h - half_dim);
+      float y = static_cast<float>(input[in_offset + partner]);
+      if (biases != nullptr) {
+        y += static_cast<float>(biases[m * NH + n * H + partner]);
+      }
+
+      const float inv_freq = exp2f(-2.0f * i / rotary_embedding_dim * log2f(10000.0f));
+      float sin_value;
+      float cos_value;
+      sincosf(position * inv_freq, &sin_value, &cos_value);
+      x = (h < half_dim ? x * cos_value - y * sin_value : x * cos_value + y * sin_value);
+    }
+
+    output[out_offset + h] = static_cast<T>(x);
+  }
+}
+
+template <typename T>
+void LaunchAddBiasTransposeRotary(
+    cudaStream_t stream, const int max_threads_per_block,
+    const int batch_size, const int sequence_length, const int num_heads, const int qk_head_size,
+    const int v_head_size, const int rotary_embedding_dim, const int past_sequence_length,
+    const T* input, const T* biases, T* output) {
+  constexpr int num_matrices = 3;
+  const dim3 grid(sequence_length, batch_size, num_matrices);
+  const int head_size = std::max(qk_head_size, v_head_size);
+  const dim3 block(std::min(head_size, CeilDiv(max_threads_per_block, num_heads)), num_heads, 1);
+  AddBiasTransposeQKVRotary<T><<<grid, block, 0, stream>>>(qk_head_size, v_head_size, rotary_embedding_dim,
+                                                           past_sequence_length, input, biases, output);
+}
+
+template void LaunchAddBiasTransposeRotary(
+    cudaStream_t stream, const int max_threads_per_block,
+    const int batch_size, const int sequence_length, const int num_heads, const int qk_head_size,
+    const int v_head_size, const int rotary_embedding_dim, const int past_sequence_length,
+    const float* input, const float* biases, float* output);
+
+template void LaunchAddBiasTransposeRotary(
+    cudaStream_t stream, const int max_threads_per_block,
+    const int batch_size, const int sequence_length, const int num_heads, const int qk_head_size,
+    const int v_head_size, const int rotary_embedding_dim, const int past_sequence_length,
+    const half* input, const half* biases, half* output);
+
 template <typename T>
 void InvokeAddBiasTransposeTrt(
     cudaStream_t stream, const int max_threads_per_block,
@@ -425,7 +525,17 @@ void LaunchAddBiasTransposeTrt(
     const int batch_size, const int sequence_length,
     const int num_heads, const int head_size,
     const half* biases, const half* query, const half* key, const half* value, half* output) {
-  if (0 == (head_size % 4)) {
+  if (0 == (head_size % 8)) {
+    const int H = head_size / 8;
+    const Half8* query2 = reinterpret_cast<const Half8*>(query);
+    const Half8* key2 = reinterpret_cast<const Half8*>(key);
+    const Half8* value2 = reinterpret_cast<const Half8*>(value);
+    const Half8* biases2 = reinterpret_cast<const Half8*>(biases);
+    Half8* output2 = reinterpret_cast<Half8*>(output);
+    InvokeAddBiasTransposeTrt<Half8>(stream, max_threads_per_block,
+                                     batch_size, sequence_length, num_heads, H,
+                                     biases2, query2, key2, value2, output2);
+  } else if (0 == (head_size % 4)) {
     const int H = head_size / 4;
     const Half4* query2 = reinterpret_cast<const Half4*>(query);
     const Half4* key2 = reinterpret_cast<const Half4*>(key);
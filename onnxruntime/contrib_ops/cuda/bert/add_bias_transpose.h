@@ -28,6 +28,17 @@ void LaunchAddBiasTranspose(
     const T* input, const T* biases, T* output, bool enable_half4, const int v_head_size,
     int total_matrix_count = -1);
 
+// Format 1 of LaunchAddBiasTranspose for Q, K and V, which also applies rotary position embedding (GPT-NeoX style)
+// to the first rotary_embedding_dim elements of each head of Q and K. biases could be nullptr.
+//     input :  (batch_size, sequence_length, 3, num_heads, head_size)
+//     output:  (3, batch_size, num_heads, sequence_length, head_size)
+template <typename T>
+void LaunchAddBiasTransposeRotary(
+    cudaStream_t stream, const int max_threads_per_block,
+    const int batch_size, const int sequence_length, const int num_heads, const int qk_head_size,
+    const int v_head_size, const int rotary_embedding_dim, const int past_sequence_length,
+    const T* input, const T* biases, T* output);
+
 
 // Add (bias) and Transpose for separated inputs of Q, K and V, and output Trt format.
 //   output:  (batch_size, sequence_length, num_heads, num_matrices, head_size)
@@ -86,6 +86,11 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
                                   device_prop.maxThreadsPerBlock,
                                   past_seq_len));
 
+  if (parameters.rotary_embedding_dim > 0 && (nullptr == weights || past_present_share_buffer_)) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                           "rotary_embedding_dim is only supported with weights and without past_present_share_buffer");
+  }
+
   int batch_size = parameters.batch_size;
   int sequence_length = parameters.sequence_length;
 
@@ -110,6 +115,8 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
                            nullptr == present &&
                            nullptr == extra_add_qk &&
                            !is_unidirectional_ &&
+                           parameters.rotary_embedding_dim == 0 &&
+                           !parameters.use_alibi &&
                            parameters.hidden_size == parameters.v_hidden_size &&
                            parameters.sequence_length == parameters.kv_sequence_length &&
                            HasFusedFp16Kernel(sm, parameters.head_size, sequence_length));
@@ -23,6 +23,7 @@ limitations under the License.
 // (3) allow persistent softmax from PyTorch for debugging purpose.
 // (4) support different input hidden size and model hidden size for pruned model
 // (5) support different hidden sizes of Q/K and V
+// (6) support rotary position embedding and ALiBi
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
@@ -217,6 +218,45 @@ template Status LaunchAddBiasTransAppendKvToPresent(cudaStream_t stream,
                                                     const half* qkv_buffer,
                                                     half* present);
 
+// ALiBi slope of a head. When num_heads is not a power of 2, the heads after the largest power of 2 get the odd
+// slopes of twice as many heads, as in the reference implementation.
+__device__ inline float AlibiSlope(const int head_index, const int num_heads) {
+  const int closest_power_of_2 = 1 << (31 - __clz(num_heads));
+  if (head_index < closest_power_of_2) {
+    return exp2f(-8.0f * (head_index + 1) / closest_power_of_2);
+  }
+  return exp2f(-4.0f * (2 * (head_index - closest_power_of_2) + 1) / closest_power_of_2);
+}
+
+template <typename T>
+__global__ void AlibiBiasKernel(const int total_sequence_length, const int past_sequence_length,
+                                const float scale, T* output) {
+  // Output: BxNxSxT, where the element (s, t) of head n is scale * slope(n) * (t - (P + s))
+  const int s = blockIdx.x;
+  const int n = blockIdx.y;
+  const int b = blockIdx.z;
+  const int S = gridDim.x;
+  const int N = gridDim.y;
+
+  const float slope = scale * AlibiSlope(n, N);
+  const int query_position = past_sequence_length + s;
+  output += static_cast<int64_t>((b * N + n) * S + s) * total_sequence_length;
+  for (int t = threadIdx.x; t < total_sequence_length; t += blockDim.x) {
+    output[t] = static_cast<T>(slope * static_cast<float>(t - query_position));
+  }
+}
+
+template <typename T>
+Status LaunchAlibiBias(cudaStream_t stream, const int max_threads_per_block,
+                       const int batch_size, const int num_heads, const int sequence_length,
+                       const int total_sequence_length, const int past_sequence_length, const float scale,
+                       T* output) {
+  const dim3 grid(sequence_length, num_heads, batch_size);
+  const dim3 block(std::min(total_sequence_length, max_threads_per_block), 1, 1);
+  AlibiBiasKernel<T><<<grid, block, 0, stream>>>(total_sequence_length, past_sequence_length, scale, output);
+  return CUDA_CALL(cudaGetLastError());
+}
+
 template <typename T>
 Status QkvToContext(
     const cudaDeviceProp& prop,
@@ -254,7 +294,15 @@ Status QkvToContext(
   bool use_fused_kernel = (nullptr != fused_runner && data.bias != nullptr);
 
   if (nullptr != data.gemm_buffer) {
-    if (data.bias == nullptr) {
+    if (parameters.rotary_embedding_dim > 0) {
+      // BxSx(NH + NH + NH_v) => BxNxSxH + BxNxSxH + BxNxSxH_v, and rotate the heads of Q and K.
+      ORT_ENFORCE(!use_fused_kernel && !past_present_share_buffer);
+      LaunchAddBiasTransposeRotary(stream, max_threads_per_block,
+                                   batch_size, sequence_length, num_heads, qk_head_size, v_head_size,
+                                   parameters.rotary_embedding_dim, parameters.past_sequence_length,
+                                   data.gemm_buffer, data.bias, qkv);
+      CUDA_RETURN_IF_ERROR(cudaGetLastError());
+    } else if (data.bias == nullptr) {
       // gemm_buffer should be BxSx3xNxH => qkv: 3xBxNxSxH
       ORT_ENFORCE(qk_head_size == v_head_size);
       int matrix_to_trans = (past_present_share_buffer ? 1 : 3);
@@ -388,12 +436,21 @@ Status QkvToContext(
   // For raw attention mask, the scalar 1/sqrt(H) is moved to combine with softmax computation.
   float alpha = use_raw_attention_mask ? one : rsqrt_head_size;
 
+  // ALiBi bias is written to scratch1 first and accumulated by the Gemm (beta = 1), so it needs no extra pass over
+  // Q*K'. With raw attention mask, softmax scales its input by 1/sqrt(H), so the bias is scaled by sqrt(H).
+  if (parameters.use_alibi) {
+    const float alibi_scale = use_raw_attention_mask ? sqrt(static_cast<float>(qk_head_size)) : one;
+    ORT_RETURN_IF_ERROR(LaunchAlibiBias(stream, max_threads_per_block, batch_size, num_heads, sequence_length,
+                                        total_sequence_length, parameters.past_sequence_length, alibi_scale,
+                                        scratch1));
+  }
+
   CUBLAS_RETURN_IF_ERROR(cublasGemmStridedBatchedHelper(
       cublas, CUBLAS_OP_T, CUBLAS_OP_N,
       total_sequence_length, sequence_length, qk_head_size,
       &alpha, k, qk_head_size, present_size_per_batch_k,
       q, qk_head_size, sequence_length * qk_head_size,
-      &zero, scratch1, total_sequence_length, temp_matrix_size, batches, prop));
+      parameters.use_alibi ? &one : &zero, scratch1, total_sequence_length, temp_matrix_size, batches, prop));
 
   // Apply softmax and store result R to scratch2: BxNxSxT
   if (use_raw_attention_mask) {  // 2d, 3d or 4d attention mask
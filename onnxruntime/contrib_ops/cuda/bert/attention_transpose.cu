@@ -100,7 +100,18 @@ Status LaunchTransCtx(cudaStream_t stream,
                       const int sequence_length, const int batch_size, const int head_size, const int num_heads,
                       const int max_threads_per_block, const bool reversed_bs, const float* input, float* output) {
   const dim3 grid(sequence_length, batch_size, 1);
-  if (0 == (head_size & 1)) {
+  if (0 == (head_size % 4)) {
+    const int H = head_size / 4;
+    const float4* input2 = reinterpret_cast<const float4*>(input);
+    float4* output2 = reinterpret_cast<float4*>(output);
+    if (H * num_heads <= max_threads_per_block) {
+      const dim3 block(H, num_heads, 1);
+      TransposeCtx<float4><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2);
+    } else {
+      const dim3 block(max_threads_per_block / num_heads, num_heads, 1);
+      TransposeCtxLarge<float4><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2);
+    }
+  } else if (0 == (head_size & 1)) {
     const int H = head_size / 2;
     const float2* input2 = reinterpret_cast<const float2*>(input);
     float2* output2 = reinterpret_cast<float2*>(output);
@@ -127,7 +138,18 @@ Status LaunchTransCtx(cudaStream_t stream,
                       const int sequence_length, const int batch_size, const int head_size, const int num_heads,
                       const int max_threads_per_block, const bool reversed_bs, const half* input, half* output) {
   const dim3 grid(sequence_length, batch_size, 1);
-  if (0 == (head_size % 4)) {
+  if (0 == (head_size % 8)) {
+    const int H = head_size / 8;
+    const float4* input2 = reinterpret_cast<const float4*>(input);
+    float4* output2 = reinterpret_cast<float4*>(output);
+    if (H * num_heads <= max_threads_per_block) {
+      const dim3 block(H, num_heads, 1);
+      TransposeCtx<float4><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2);
+    } else {
+      const dim3 block(max_threads_per_block / num_heads, num_heads, 1);
+      TransposeCtxLarge<float4><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2);
+    }
+  } else if (0 == (head_size % 4)) {
     const int H = head_size / 4;
     const float2* input2 = reinterpret_cast<const float2*>(input);
     float2* output2 = reinterpret_cast<float2*>(output);
@@ -235,7 +257,18 @@ Status LaunchTransQkv(cudaStream_t stream, const int matrix_num,
                       int total_matrix_count) {
   total_matrix_count = max(total_matrix_count, matrix_num);
   const dim3 grid(sequence_length, batch_size, matrix_num);
-  if (0 == (head_size & 1)) {
+  if (0 == (head_size % 4)) {
+    const int H = head_size / 4;
+    const float4* input2 = reinterpret_cast<const float4*>(input);
+    float4* output2 = reinterpret_cast<float4*>(output);
+    if (H * num_heads <= max_threads_per_block) {
+      const dim3 block(H, num_heads, 1);
+      TransposeQKV<float4><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2, total_matrix_count);
+    } else {
+      const dim3 block(max_threads_per_block / num_heads, num_heads, 1);
+      TransposeQKVLarge<float4><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2, total_matrix_count);
+    }
+  } else if (0 == (head_size & 1)) {
     const int H = head_size / 2;
     const float2* input2 = reinterpret_cast<const float2*>(input);
     float2* output2 = reinterpret_cast<float2*>(output);
@@ -264,7 +297,18 @@ Status LaunchTransQkv(cudaStream_t stream, const int matrix_num,
                       int total_matrix_count) {
   total_matrix_count = max(total_matrix_count, matrix_num);
   const dim3 grid(sequence_length, batch_size, matrix_num);
-  if (0 == (head_size % 4)) {
+  if (0 == (head_size % 8)) {
+    const int H = head_size / 8;
+    const float4* input2 = reinterpret_cast<const float4*>(input);
+    float4* output2 = reinterpret_cast<float4*>(output);
+    if (H * num_heads <= max_threads_per_block) {
+      const dim3 block(H, num_heads, 1);
+      TransposeQKV<float4><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2, total_matrix_count);
+    } else {
+      const dim3 block(max_threads_per_block / num_heads, num_heads, 1);
+      TransposeQKVLarge<float4><<<grid, block, 0, stream>>>(H, reversed_bs, input2, output2, total_matrix_count);
+    }
+  } else if (0 == (head_size % 4)) {
     const int H = head_size / 4;
     const float2* input2 = reinterpret_cast<const float2*>(input);
     float2* output2 = reinterpret_cast<float2*>(output);
@@ -3,6 +3,7 @@
 
 #include "contrib_ops/cuda/bert/attention_impl.h"
 #include "contrib_ops/cuda/bert/decoder_attention.h"
+#include "contrib_ops/cuda/bert/paged_attention_impl.h"
 #include "contrib_ops/cuda/bert/transformer_cuda_common.h"
 #include "core/framework/op_kernel.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
@@ -42,7 +43,8 @@ Status CheckInputs(const TensorShape& query_shape,
                    const bool static_kv,
                    const bool use_past,
                    const bool has_layer_state,
-                   const bool has_key_padding_mask) {
+                   const bool has_key_padding_mask,
+                   const bool paged_cache) {
   const auto& query_shape_dims = query_shape.GetDims();
   if (query_shape_dims.size() != 3) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'query' is expected to have 3 dimensions, got ",
@@ -98,6 +100,11 @@ Status CheckInputs(const TensorShape& query_shape,
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "bias shall have shape (3 * hidden size)");
   }
 
+  // the paged caches and their key_padding_mask are checked by CheckPagedCacheInputs
+  if (paged_cache) {
+    return Status::OK();
+  }
+
   int key_length = kv_sequence_length;
   if (key_padding_mask != nullptr && has_key_padding_mask == true) {
     const auto& kp_mask_dims = key_padding_mask->Shape().GetDims();
@@ -160,6 +167,68 @@ Status CheckInputs(const TensorShape& query_shape,
 
   return Status::OK();
 }
+
+Status CheckPagedCacheInputs(const TensorShape& query_shape,
+                             const Tensor* key_padding_mask,
+                             const Tensor* key_cache,
+                             const Tensor* value_cache,
+                             const Tensor* cache_block_table,
+                             const Tensor* cache_sequence_lengths,
+                             const int num_heads,
+                             const bool use_past,
+                             const bool has_layer_state,
+                             const bool has_key_padding_mask) {
+  if (cache_block_table == nullptr || cache_sequence_lengths == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "cache_block_table and cache_sequence_lengths shall be given together");
+  }
+
+  if (!use_past || !has_layer_state || key_cache == nullptr || value_cache == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Paged caches require use_past, has_layer_state, key_cache and value_cache");
+  }
+
+  const int64_t batch_size = query_shape[1];
+  const int64_t hidden_size = query_shape[2];
+
+  const auto& cache_dims = key_cache->Shape().GetDims();
+  if (cache_dims.size() != 4) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input 'key_cache' is expected to have 4 dimension, got ",
+                           cache_dims.size());
+  }
+
+  if (value_cache->Shape() != key_cache->Shape()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "value_cache shall have the same shape as key_cache");
+  }
+
+  if (cache_dims[1] != num_heads || cache_dims[1] * cache_dims[3] != hidden_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Paged key_cache shall have shape (num_blocks, num_heads, block_size, head_size)");
+  }
+
+  const auto& block_table_dims = cache_block_table->Shape().GetDims();
+  if (block_table_dims.size() != 2 || block_table_dims[0] != batch_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "cache_block_table shall have shape (batch_size, max_blocks_per_sequence)");
+  }
+
+  const auto& lengths_dims = cache_sequence_lengths->Shape().GetDims();
+  if (lengths_dims.size() != 1 || lengths_dims[0] != batch_size) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "cache_sequence_lengths shall have shape (batch_size)");
+  }
+
+  if (key_padding_mask != nullptr && has_key_padding_mask) {
+    const auto& kp_mask_dims = key_padding_mask->Shape().GetDims();
+    if (kp_mask_dims.size() != 2 || kp_mask_dims[0] != batch_size ||
+        kp_mask_dims[1] != block_table_dims[1] * cache_dims[2]) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "key_padding_mask shall have shape (batch_size, max_blocks_per_sequence * block_size) "
+                             "with paged caches");
+    }
+  }
+
+  return Status::OK();
+}
 }  // anonymous namespace
 
 template <typename T>
@@ -183,6 +252,9 @@ Status DecoderAttention<T>::ComputeInternal(OpKernelContext* context) const {
   const Tensor* use_past(context->Input<Tensor>(9));
   const Tensor* has_layer_state(context->Input<Tensor>(10));
   const Tensor* has_key_padding_mask(context->Input<Tensor>(11));
+  const Tensor* cache_block_table(context->Input<Tensor>(12));
+  const Tensor* cache_sequence_lengths(context->Input<Tensor>(13));
+  const bool paged_cache = cache_block_table != nullptr || cache_sequence_lengths != nullptr;
 
   cudaStream_t stream = Stream(context);
 
@@ -254,7 +326,14 @@ Status DecoderAttention<T>::ComputeInternal(OpKernelContext* context) const {
                   static_kv_,
                   use_past_,
                   has_layer_state_,
-                  has_key_padding_mask_));
+                  has_key_padding_mask_,
+                  paged_cache));
+
+  if (paged_cache) {
+    ORT_RETURN_IF_ERROR(CheckPagedCacheInputs(query->Shape(), key_padding_mask, key_cache, value_cache,
+                                              cache_block_table, cache_sequence_lengths, num_heads_,
+                                              use_past_, has_layer_state_, has_key_padding_mask_));
+  }
 
   // calculate q
   gemm_query_buffer_p = GetScratchBuffer<T>(batch_size * sequence_length * hidden_size * element_size, context->GetComputeStream());
@@ -277,6 +356,10 @@ Status DecoderAttention<T>::ComputeInternal(OpKernelContext* context) const {
       &one, reinterpret_cast<CudaT*>(gemm_query_buffer_p.get()), n, device_prop));
   // gemm_query_buffer in col-base: (h2, S*B)
 
+  if (paged_cache) {
+    return ComputePagedAttention(context, gemm_query_buffer_p.get(), static_kv_, has_key_padding_mask_);
+  }
+
   // calcualte k, v
   n = 2 * hidden_size;
   k = hidden_size;
@@ -384,6 +467,98 @@ Status DecoderAttention<T>::ComputeInternal(OpKernelContext* context) const {
       nullptr == new_value_cache ? nullptr : new_value_cache->MutableData<T>());
 }
 
+template <typename T>
+Status DecoderAttention<T>::ComputePagedAttention(OpKernelContext* context, const T* gemm_query_buffer,
+                                                  bool static_kv, bool has_key_padding_mask) const {
+  typedef typename ToCudaType<T>::MappedType CudaT;
+
+  const Tensor* query(context->Input<Tensor>(0));
+  const Tensor* kv_weights(context->Input<Tensor>(3));
+  const Tensor* bias(context->Input<Tensor>(4));
+  const Tensor* key_padding_mask(context->Input<Tensor>(5));
+  const Tensor* key_cache(context->Input<Tensor>(6));
+  const Tensor* value_cache(context->Input<Tensor>(7));
+  const Tensor* cache_block_table(context->Input<Tensor>(12));
+  const Tensor* cache_sequence_lengths(context->Input<Tensor>(13));
+
+  cudaStream_t stream = Stream(context);
+  cublasHandle_t cublas = GetCublasHandle(context);
+  auto& device_prop = GetDeviceProp();
+
+  const auto& query_shape = query->Shape();
+  const int sequence_length = static_cast<int>(query_shape[0]);
+  const int batch_size = static_cast<int>(query_shape[1]);
+  const int hidden_size = static_cast<int>(query_shape[2]);
+  const auto& cache_shape = key_cache->Shape();
+
+  Tensor* output(context->Output(0, query_shape));
+  Tensor* new_key_cache(context->Output(1, cache_shape));
+  Tensor* new_value_cache(context->Output(2, cache_shape));
+
+  // The new caches are the caches updated in place, the copy is skipped when they are bound to the same buffers.
+  T* key_pool = const_cast<T*>(key_cache->Data<T>());
+  T* value_pool = const_cast<T*>(value_cache->Data<T>());
+  if (new_key_cache != nullptr && new_value_cache != nullptr) {
+    if (new_key_cache->MutableData<T>() != key_pool) {
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(new_key_cache->MutableData<T>(), key_pool, key_cache->SizeInBytes(),
+                                           cudaMemcpyDeviceToDevice, stream));
+    }
+    if (new_value_cache->MutableData<T>() != value_pool) {
+      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(new_value_cache->MutableData<T>(), value_pool, value_cache->SizeInBytes(),
+                                           cudaMemcpyDeviceToDevice, stream));
+    }
+    key_pool = new_key_cache->MutableData<T>();
+    value_pool = new_value_cache->MutableData<T>();
+  } else if (!static_kv) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "Self attention with paged caches requires new_key_cache and new_value_cache");
+  }
+
+  // the keys and values of the query tokens for self attention: (S, B, 2, N, H)
+  IAllocatorUniquePtr<T> gemm_kv_buffer_p(nullptr);
+  if (!static_kv) {
+    CudaT one = ToCudaType<T>::FromFloat(1.0f);
+    CudaT zero = ToCudaType<T>::FromFloat(0.0f);
+    const int m = sequence_length * batch_size;
+    const int n = 2 * hidden_size;
+    const int k = hidden_size;
+    gemm_kv_buffer_p = GetScratchBuffer<T>(static_cast<size_t>(m) * n, context->GetComputeStream());
+    // broadcast bias for key and value: (2*h2, S*B)
+    CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+        cublas, CUBLAS_OP_N, CUBLAS_OP_N, n, m, 1, &one,
+        reinterpret_cast<const CudaT*>(bias->Data<T>() + hidden_size), n,
+        GetConstOnes<CudaT>(m, stream), 1,
+        &zero, reinterpret_cast<CudaT*>(gemm_kv_buffer_p.get()), n, device_prop));
+    // matmul: (2*h2, h1)*(h1, S*B)
+    CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
+        cublas, CUBLAS_OP_N, CUBLAS_OP_N, n, m, k, &one,
+        reinterpret_cast<const CudaT*>(kv_weights->Data<T>()), n,
+        reinterpret_cast<const CudaT*>(query->Data<T>()), k,
+        &one, reinterpret_cast<CudaT*>(gemm_kv_buffer_p.get()), n, device_prop));
+  }
+
+  PagedAttentionData<CudaT> data;
+  data.batch_size = batch_size;
+  data.sequence_length = sequence_length;
+  data.num_heads = num_heads_;
+  data.head_size = hidden_size / num_heads_;
+  data.block_size = static_cast<int>(cache_shape[2]);
+  data.max_blocks_per_sequence = static_cast<int>(cache_block_table->Shape()[1]);
+  data.static_kv = static_kv;
+  data.query = reinterpret_cast<const CudaT*>(gemm_query_buffer);
+  data.new_key_value = reinterpret_cast<const CudaT*>(gemm_kv_buffer_p.get());
+  data.block_table = cache_block_table->Data<int32_t>();
+  data.past_lengths = cache_sequence_lengths->Data<int32_t>();
+  data.key_padding_mask = (key_padding_mask != nullptr && has_key_padding_mask) ? key_padding_mask->Data<bool>()
+                                                                                : nullptr;
+  data.key_padding_mask_length = data.max_blocks_per_sequence * data.block_size;
+  data.key_cache = reinterpret_cast<CudaT*>(key_pool);
+  data.value_cache = reinterpret_cast<CudaT*>(value_pool);
+  data.output = reinterpret_cast<CudaT*>(output->MutableData<T>());
+
+  return LaunchPagedAttentionKernel(device_prop, stream, data);
+}
+
 }  // namespace cuda
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -18,6 +18,10 @@ class DecoderAttention final : public CudaKernel {
   Status ComputeInternal(OpKernelContext* context) const override;
 
  private:
+  // Attention with paged key and value caches, see the cache_block_table input of DecoderAttention
+  Status ComputePagedAttention(OpKernelContext* context, const T* gemm_query_buffer,
+                               bool static_kv, bool has_key_padding_mask) const;
+
   int num_heads_;
 };
 
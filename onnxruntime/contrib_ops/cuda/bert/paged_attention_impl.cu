@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cub/cub.cuh>
+#include <cuda_fp16.h>
+#include <math_constants.h>
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "core/providers/cuda/cuda_common.h"
+#include "contrib_ops/cuda/bert/paged_attention_impl.h"
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+namespace {
+
+constexpr int kPagedAttentionThreadsPerBlock = 256;
+
+__device__ inline int64_t PagedCacheOffset(const int32_t* block_table, int max_blocks_per_sequence,
+                                           int num_heads, int block_size, int head_size,
+                                           int b, int n, int t) {
+  const int64_t block = block_table[b * max_blocks_per_sequence + t / block_size];
+  return ((block * num_heads + n) * block_size + t % block_size) * head_size;
+}
+
+template <typename T>
+__global__ void WritePagedKVCacheKernel(PagedAttentionData<T> data) {
+  // grid: (S, B), new_key_value: (S, B, 2, N, H)
+  const int s = blockIdx.x;
+  const int b = blockIdx.y;
+  const int NH = data.num_heads * data.head_size;
+  const int t = data.past_lengths[b] + s;
+  const T* key = data.new_key_value + (static_cast<int64_t>(s) * data.batch_size + b) * 2 * NH;
+  const T* value = key + NH;
+  for (int i = threadIdx.x; i < NH; i += blockDim.x) {
+    const int n = i / data.head_size;
+    const int h = i % data.head_size;
+    const int64_t offset = PagedCacheOffset(data.block_table, data.max_blocks_per_sequence, data.num_heads,
+                                            data.block_size, data.head_size, b, n, t) + h;
+    data.key_cache[offset] = key[i];
+    data.value_cache[offset] = value[i];
+  }
+}
+
+template <typename T, int TPB>
+__global__ void PagedAttentionKernel(PagedAttentionData<T> data, float scale) {
+  // grid: (N, S, B), one block per query and head
+  using BlockReduce = cub::BlockReduce<float, TPB>;
+  __shared__ typename BlockReduce::TempStorage tmp_storage;
+  __shared__ float max_block;
+  __shared__ float sum_reverse_block;
+  extern __shared__ float shared[];
+
+  const int n = blockIdx.x;
+  const int s = blockIdx.y;
+  const int b = blockIdx.z;
+  const int H = data.head_size;
+  const int NH = data.num_heads * H;
+  const int total_length = data.past_lengths[b] + (data.static_kv ? 0 : data.sequence_length);
+
+  float* q = shared;           // H
+  float* scores = shared + H;  // total_length
+  const int64_t query_offset = (static_cast<int64_t>(s) * data.batch_size + b) * NH + n * H;
+  for (int h = threadIdx.x; h < H; h += TPB) {
+    q[h] = static_cast<float>(data.query[query_offset + h]);
+  }
+  __syncthreads();
+
+  float thread_max = -CUDART_INF_F;
+  for (int t = threadIdx.x; t < total_length; t += TPB) {
+    const T* k = data.key_cache + PagedCacheOffset(data.block_table, data.max_blocks_per_sequence, data.num_heads,
+                                                   data.block_size, H, b, n, t);
+    float score = 0.0f;
+    for (int h = 0; h < H; h++) {
+      score += q[h] * static_cast<float>(k[h]);
+    }
+    score *= scale;
+    if (data.key_padding_mask != nullptr &&
+        data.key_padding_mask[static_cast<int64_t>(b) * data.key_padding_mask_length + t]) {
+      score = -CUDART_INF_F;
+    }
+    scores[t] = score;
+    thread_max = max(thread_max, score);
+  }
+
+  const float block_max = BlockReduce(tmp_storage).Reduce(thread_max, cub::Max());
+  if (threadIdx.x == 0) {
+    max_block = block_max;
+  }
+  __syncthreads();
+
+  float thread_sum = 0.0f;
+  for (int t = threadIdx.x; t < total_length; t += TPB) {
+    const float e = expf(scores[t] - max_block);
+    scores[t] = e;
+    thread_sum += e;
+  }
+
+  const float block_sum = BlockReduce(tmp_storage).Reduce(thread_sum, cub::Sum());
+  if (threadIdx.x == 0) {
+    sum_reverse_block = 1.0f / block_sum;
+  }
+  __syncthreads();
+
+  for (int h = threadIdx.x; h < H; h += TPB) {
+    float value = 0.0f;
+    for (int t = 0; t < total_length; t++) {
+      const T* v = data.value_cache + PagedCacheOffset(data.block_table, data.max_blocks_per_sequence, data.num_heads,
+                                                       data.block_size, H, b, n, t);
+      value += scores[t] * static_cast<float>(v[h]);
+    }
+    data.output[query_offset + h] = T(value * sum_reverse_block);
+  }
+}
+
+}  // namespace
+
+template <typename T>
+Status LaunchPagedAttentionKernel(const cudaDeviceProp& prop, cudaStream_t stream, const PagedAttentionData<T>& data) {
+  if (!data.static_kv) {
+    const int threads = std::min(data.num_heads * data.head_size, prop.maxThreadsPerBlock);
+    const dim3 grid(data.sequence_length, data.batch_size, 1);
+    WritePagedKVCacheKernel<T><<<grid, threads, 0, stream>>>(data);
+  }
+
+  // the scores of all the tokens a sequence may have are kept in shared memory
+  const size_t shared_bytes =
+      sizeof(float) * (data.head_size + static_cast<size_t>(data.max_blocks_per_sequence) * data.block_size);
+  ORT_RETURN_IF(shared_bytes > prop.sharedMemPerBlock,
+                "Paged attention supports up to ", prop.sharedMemPerBlock / sizeof(float) - data.head_size,
+                " tokens per sequence, the block table has ", data.max_blocks_per_sequence * data.block_size);
+
+  const float scale = 1.f / sqrt(static_cast<float>(data.head_size));
+  const dim3 grid(data.num_heads, data.sequence_length, data.batch_size);
+  PagedAttentionKernel<T, kPagedAttentionThreadsPerBlock>
+      <<<grid, kPagedAttentionThreadsPerBlock, shared_bytes, stream>>>(data, scale);
+  return CUDA_CALL(cudaGetLastError());
+}
+
+template Status LaunchPagedAttentionKernel<float>(const cudaDeviceProp& prop, cudaStream_t stream,
+                                                  const PagedAttentionData<float>& data);
+
+template Status LaunchPagedAttentionKernel<half>(const cudaDeviceProp& prop, cudaStream_t stream,
+                                                 const PagedAttentionData<half>& data);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
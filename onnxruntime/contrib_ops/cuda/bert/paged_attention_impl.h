@@ -0,0 +1,44 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+#include <cuda_fp16.h>
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// The paged key and value caches are pools of blocks with shape (num_blocks, num_heads, block_size, head_size).
+// The t-th token of the b-th sequence is in block block_table[b * max_blocks_per_sequence + t / block_size] at
+// position t % block_size.
+template <typename T>
+struct PagedAttentionData {
+  int batch_size;
+  int sequence_length;  // number of queries, and of new tokens for self attention
+  int num_heads;
+  int head_size;
+  int block_size;
+  int max_blocks_per_sequence;
+  bool static_kv;
+
+  const T* query;                // (S, B, N, H)
+  const T* new_key_value;        // (S, B, 2, N, H) for self attention, nullptr for cross attention
+  const int32_t* block_table;    // (B, max_blocks_per_sequence)
+  const int32_t* past_lengths;   // (B), number of tokens of each sequence in the cache before this run
+  const bool* key_padding_mask;  // (B, key_padding_mask_length), true for the keys to ignore, or nullptr
+  int key_padding_mask_length;
+
+  T* key_cache;                  // key pool, the new keys are written to it
+  T* value_cache;                // value pool, the new values are written to it
+  T* output;                     // (S, B, N, H)
+};
+
+// Writes the new keys and values to the caches, then attends to the first past_lengths[b] + sequence_length (or
+// past_lengths[b] if static_kv) tokens of each sequence through the block table.
+template <typename T>
+Status LaunchPagedAttentionKernel(const cudaDeviceProp& prop, cudaStream_t stream, const PagedAttentionData<T>& data);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -54,18 +54,20 @@ Status SkipLayerNorm<T>::ComputeInternal(OpKernelContext* ctx) const {
     return Status::OK();
   }
 
+  // input is (batch_size, sequence_length, hidden_size), or (total_tokens, hidden_size) when padding is removed
   const auto& input_dims = input->Shape().GetDims();
-  if (input_dims.size() != 3) {
+  if (input_dims.size() != 3 && input_dims.size() != 2) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
-                           "input is expected to have 3 dimensions, got ", input_dims.size());
+                           "input is expected to have 3 or 2 dimensions, got ", input_dims.size());
   }
+  const int64_t hidden_size = input_dims.back();
 
   const auto& gamma_dims = gamma->Shape().GetDims();
   if (gamma_dims.size() != 1) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                            "gamma is expected to have 1 dimension, got ", gamma_dims.size());
   }
-  if (gamma_dims[0] != input_dims[2]) {
+  if (gamma_dims[0] != hidden_size) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                            "Last dimension of gamma and input does not match");
   }
@@ -76,7 +78,7 @@ Status SkipLayerNorm<T>::ComputeInternal(OpKernelContext* ctx) const {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                              "beta is expected to have 1 dimension, got ", beta_dims.size());
     }
-    if (beta_dims[0] != input_dims[2]) {
+    if (beta_dims[0] != hidden_size) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                              "Last dimension of beta and input does not match");
     }
@@ -88,15 +90,13 @@ Status SkipLayerNorm<T>::ComputeInternal(OpKernelContext* ctx) const {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                              "bias is expected to have 1 dimension, got ", bias_dims.size());
     }
-    if (bias_dims[0] != input_dims[2]) {
+    if (bias_dims[0] != hidden_size) {
       return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
                              "Last dimension of bias and input does not match");
     }
   }
 
-  int sequence_length = static_cast<int>(input_dims[1]);
-  int hidden_size = static_cast<int>(input_dims[2]);
-  int64_t element_count = input_dims[0] * sequence_length * hidden_size;
+  int64_t element_count = input->Shape().Size();
   size_t element_size = sizeof(T);
   typedef typename ToCudaType<T>::MappedType CudaT;
 
@@ -110,7 +110,7 @@ Status SkipLayerNorm<T>::ComputeInternal(OpKernelContext* ctx) const {
       (beta != nullptr) ? reinterpret_cast<const CudaT*>(beta->Data<T>()) : nullptr,
       (bias != nullptr) ? reinterpret_cast<const CudaT*>(bias->Data<T>()) : nullptr,
       epsilon_,
-      hidden_size,
+      static_cast<int>(hidden_size),
       static_cast<int>(element_count),
       element_size);
 }
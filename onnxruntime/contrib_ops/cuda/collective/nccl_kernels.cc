@@ -0,0 +1,167 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/collective/nccl_kernels.h"
+
+#if defined(USE_MPI)
+#define OMPI_SKIP_MPICXX 1  // See https://github.com/open-mpi/ompi/issues/5157
+#include <mpi.h>
+#undef OMPI_SKIP_MPICXX
+#endif
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#if defined(ORT_USE_NCCL)
+
+#define MPI_CHECK(condition)                                                                   \
+  do {                                                                                         \
+    int error = (condition);                                                                   \
+    ORT_ENFORCE(error == MPI_SUCCESS, "MPI Error at: ", __FILE__, ":", __LINE__, ": ", error); \
+  } while (0)
+
+ncclDataType_t GetNcclDataType(onnxruntime::MLDataType type) {
+  if (type == DataTypeImpl::GetType<MLFloat16>()) {
+    return ncclFloat16;
+  } else if (type == DataTypeImpl::GetType<float>()) {
+    return ncclFloat32;
+#if defined(NCCL_MAJOR) && (NCCL_MAJOR > 2 || (NCCL_MAJOR == 2 && NCCL_MINOR >= 10))
+  } else if (type == DataTypeImpl::GetType<BFloat16>()) {
+    return ncclBfloat16;
+#endif
+  } else {
+    ORT_THROW("Tensor type not supported in NCCL.");
+  }
+}
+
+NcclContext::NcclContext() {
+#if defined(USE_MPI)
+  int is_mpi_initialized = 0;
+  MPI_CHECK(MPI_Initialized(&is_mpi_initialized));
+  if (!is_mpi_initialized) {
+    int mpi_threads_provided = 0;
+    MPI_CHECK(MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &mpi_threads_provided));
+  }
+
+  MPI_CHECK(MPI_Comm_size(MPI_COMM_WORLD, &world_size_));
+  MPI_CHECK(MPI_Comm_rank(MPI_COMM_WORLD, &rank_));
+
+  ncclUniqueId nccl_id;
+  if (rank_ == 0) {
+    ORT_ENFORCE(NCCL_CALL(ncclGetUniqueId(&nccl_id)).IsOK());
+  }
+  MPI_CHECK(MPI_Bcast(&nccl_id, sizeof(nccl_id), MPI_BYTE, 0, MPI_COMM_WORLD));
+  ORT_ENFORCE(NCCL_CALL(ncclCommInitRank(&comm_, world_size_, nccl_id, rank_)).IsOK());
+#else
+  ORT_THROW("ORT must be built with MPI to use NCCL.");
+#endif
+}
+
+NcclContext::~NcclContext() {
+  if (comm_ != nullptr) {
+    ncclCommDestroy(comm_);
+  }
+
+#if defined(USE_MPI)
+  int is_mpi_finalized = 0;
+  MPI_Finalized(&is_mpi_finalized);
+  if (!is_mpi_finalized) {
+    MPI_Finalize();
+  }
+#endif
+}
+
+NcclKernel::NcclKernel(const OpKernelInfo& info) : CudaKernel(info) {
+  static NcclContext context;
+  nccl_ = &context;
+}
+
+ONNX_OPERATOR_KERNEL_EX(
+    AllReduce,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .MayInplace(0, 0)
+        .TypeConstraint("T", BuildKernelDefConstraints<float, MLFloat16, BFloat16>()),
+    AllReduce);
+
+ONNX_OPERATOR_KERNEL_EX(
+    AllGather,
+    kMSDomain,
+    1,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .TypeConstraint("T", BuildKernelDefConstraints<float, MLFloat16, BFloat16>()),
+    AllGather);
+
+AllReduce::AllReduce(const OpKernelInfo& info) : NcclKernel(info) {
+}
+
+Status AllReduce::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  Tensor* output = context->Output(0, input->Shape());
+  if (input->Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  ncclDataType_t dtype = GetNcclDataType(input->DataType());
+  NCCL_RETURN_IF_ERROR(ncclAllReduce(input->DataRaw(), output->MutableDataRaw(), input->Shape().Size(), dtype,
+                                     ncclSum, nccl_->Comm(), Stream(context)));
+  return Status::OK();
+}
+
+AllGather::AllGather(const OpKernelInfo& info) : NcclKernel(info) {
+  group_size_ = info.GetAttrOrDefault<int64_t>("group_size", 1);
+  axis_ = info.GetAttrOrDefault<int64_t>("axis", 0);
+  ORT_ENFORCE(group_size_ == nccl_->Size(), "AllGather group_size ", group_size_,
+              " does not match the number of MPI processes ", nccl_->Size());
+}
+
+Status AllGather::ComputeInternal(OpKernelContext* context) const {
+  const Tensor* input = context->Input<Tensor>(0);
+  const TensorShape& input_shape = input->Shape();
+  const int64_t axis = HandleNegativeAxis(axis_, input_shape.NumDimensions());
+
+  TensorShapeVector output_dims = input_shape.AsShapeVector();
+  output_dims[axis] *= group_size_;
+  Tensor* output = context->Output(0, output_dims);
+  if (input_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  ncclDataType_t dtype = GetNcclDataType(input->DataType());
+  const size_t count = static_cast<size_t>(input_shape.Size());
+
+  // ncclAllGather concatenates the shards along the outermost axis, which is the output layout when all the
+  // dimensions ahead of axis are 1.
+  const int64_t outer = input_shape.SizeToDimension(axis);
+  if (outer == 1) {
+    NCCL_RETURN_IF_ERROR(ncclAllGather(input->DataRaw(), output->MutableDataRaw(), count, dtype,
+                                       nccl_->Comm(), Stream(context)));
+    return Status::OK();
+  }
+
+  // Otherwise gather into [group_size, outer, shard] and interleave the shards into [outer, group_size * shard].
+  const size_t element_size = input->DataType()->Size();
+  const size_t shard_bytes = static_cast<size_t>(input_shape.SizeFromDimension(axis)) * element_size;
+  auto gathered = GetScratchBuffer<int8_t>(count * group_size_ * element_size, context->GetComputeStream());
+  NCCL_RETURN_IF_ERROR(ncclAllGather(input->DataRaw(), gathered.get(), count, dtype,
+                                     nccl_->Comm(), Stream(context)));
+
+  int8_t* output_data = static_cast<int8_t*>(output->MutableDataRaw());
+  for (int64_t r = 0; r < group_size_; ++r) {
+    CUDA_RETURN_IF_ERROR(cudaMemcpy2DAsync(output_data + r * shard_bytes, shard_bytes * group_size_,
+                                           gathered.get() + r * count * element_size, shard_bytes,
+                                           shard_bytes, static_cast<size_t>(outer),
+                                           cudaMemcpyDeviceToDevice, Stream(context)));
+  }
+  return Status::OK();
+}
+
+#endif
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,79 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_kernel.h"
+
+#if defined(ORT_USE_NCCL)
+#include <nccl.h>
+#endif
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace onnxruntime::cuda;
+
+#if defined(ORT_USE_NCCL)
+#define NCCL_RETURN_IF_ERROR(expr) ORT_RETURN_IF_ERROR(NCCL_CALL(expr))
+
+// The NCCL communicator of the tensor parallel group, which is made of all the processes of MPI_COMM_WORLD.
+// Each process runs its own InferenceSession on one GPU with the shards of the weights of its rank.
+class NcclContext final {
+ public:
+  NcclContext();
+  ~NcclContext();
+
+  ncclComm_t Comm() { return comm_; }
+
+  int Rank() const { return rank_; }
+
+  int Size() const { return world_size_; }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(NcclContext);
+
+  int rank_ = 0;
+  int world_size_ = 1;
+  ncclComm_t comm_ = nullptr;
+};
+
+class NcclKernel : public CudaKernel {
+ public:
+  explicit NcclKernel(const OpKernelInfo& info);
+
+ protected:
+  NcclContext* nccl_ = nullptr;
+};
+
+/*
+ * Sums the partial results of the ranks, e.g. after a row partitioned MatMul.
+ */
+class AllReduce final : public NcclKernel {
+ public:
+  explicit AllReduce(const OpKernelInfo& info);
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+};
+
+/*
+ * Concatenates the shards of the ranks along axis, e.g. after a column partitioned MatMul.
+ */
+class AllGather final : public NcclKernel {
+ public:
+  explicit AllGather(const OpKernelInfo& info);
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  int64_t group_size_;
+  int64_t axis_;
+};
+
+ncclDataType_t GetNcclDataType(onnxruntime::MLDataType type);
+#endif
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
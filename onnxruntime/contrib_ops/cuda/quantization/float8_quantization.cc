@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/quantization/float8_quantization.h"
+
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                         \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                         \
+      QuantizeFloat8,                                                    \
+      kMSDomain,                                                         \
+      1,                                                                 \
+      T,                                                                 \
+      kCudaExecutionProvider,                                            \
+      (*KernelDefBuilder::Create())                                      \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>())        \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<uint8_t>()), \
+      QuantizeFloat8<T>);                                                \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                         \
+      DequantizeFloat8,                                                  \
+      kMSDomain,                                                         \
+      1,                                                                 \
+      T,                                                                 \
+      kCudaExecutionProvider,                                            \
+      (*KernelDefBuilder::Create())                                      \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>())  \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<T>()),       \
+      DequantizeFloat8<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+
+Float8Format GetFloat8FormatAttr(const OpKernelInfo& info, const char* name) {
+  const std::string format = info.GetAttrOrDefault<std::string>(name, "E4M3FN");
+  if (format == "E5M2") {
+    return Float8Format::E5M2;
+  }
+  ORT_ENFORCE(format == "E4M3FN", "Attribute ", name, " must be E4M3FN or E5M2, got ", format);
+  return Float8Format::E4M3FN;
+}
+
+template <typename T>
+QuantizeFloat8<T>::QuantizeFloat8(const OpKernelInfo& info) : CudaKernel(info) {
+  format_ = GetFloat8FormatAttr(info, "fp8_format");
+  saturate_ = info.GetAttrOrDefault<int64_t>("saturate", 1) != 0;
+}
+
+template <typename T>
+Status QuantizeFloat8<T>::ComputeInternal(OpKernelContext* context) const {
+  typedef typename ToCudaType<T>::MappedType CudaT;
+
+  const Tensor& x = *context->Input<Tensor>(0);
+  const Tensor& y_scale = *context->Input<Tensor>(1);
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(&y_scale), "y_scale must be a scalar or 1D tensor of size 1.");
+
+  Tensor& y = *context->Output(0, x.Shape());
+
+  return CudaQuantizeFloat8(Stream(context), reinterpret_cast<const CudaT*>(x.Data<T>()), y.MutableData<uint8_t>(),
+                            reinterpret_cast<const CudaT*>(y_scale.Data<T>()), format_, saturate_,
+                            static_cast<size_t>(x.Shape().Size()));
+}
+
+template <typename T>
+DequantizeFloat8<T>::DequantizeFloat8(const OpKernelInfo& info) : CudaKernel(info) {
+  format_ = GetFloat8FormatAttr(info, "fp8_format");
+}
+
+template <typename T>
+Status DequantizeFloat8<T>::ComputeInternal(OpKernelContext* context) const {
+  typedef typename ToCudaType<T>::MappedType CudaT;
+
+  const Tensor& x = *context->Input<Tensor>(0);
+  const Tensor& x_scale = *context->Input<Tensor>(1);
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(&x_scale), "x_scale must be a scalar or 1D tensor of size 1.");
+
+  Tensor& y = *context->Output(0, x.Shape());
+
+  return CudaDequantizeFloat8(Stream(context), x.Data<uint8_t>(), reinterpret_cast<CudaT*>(y.MutableData<T>()),
+                              reinterpret_cast<const CudaT*>(x_scale.Data<T>()), format_,
+                              static_cast<size_t>(x.Shape().Size()));
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
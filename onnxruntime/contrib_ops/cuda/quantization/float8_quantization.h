@@ -0,0 +1,43 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_kernel.h"
+#include "contrib_ops/cuda/quantization/float8_quantization_impl.cuh"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace onnxruntime::cuda;
+
+// Parses a float8 format attribute, "E4M3FN" or "E5M2".
+Float8Format GetFloat8FormatAttr(const OpKernelInfo& info, const char* name);
+
+template <typename T>
+class QuantizeFloat8 final : public CudaKernel {
+ public:
+  QuantizeFloat8(const OpKernelInfo& info);
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  Float8Format format_;
+  bool saturate_;
+};
+
+template <typename T>
+class DequantizeFloat8 final : public CudaKernel {
+ public:
+  DequantizeFloat8(const OpKernelInfo& info);
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  Float8Format format_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,118 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "float8_quantization_impl.cuh"
+
+#include <cuda_fp16.h>
+
+#include "core/providers/cuda/cu_inc/common.cuh"
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11080
+#include <cuda_fp8.h>
+#endif
+
+using namespace onnxruntime::cuda;
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11080
+
+template <int NumThreadsPerBlock, int NumElementsPerThread, typename T>
+__global__ void QuantizeFloat8Kernel(const T* input, uint8_t* output, const T* scale_ptr,
+                                     __nv_fp8_interpretation_t interpretation, __nv_saturation_t saturation,
+                                     CUDA_LONG N) {
+  CUDA_LONG id = NumElementsPerThread * NumThreadsPerBlock * blockIdx.x + threadIdx.x;
+
+  const float scale = static_cast<float>(*scale_ptr);
+#pragma unroll
+  for (int i = 0; i < NumElementsPerThread; i++) {
+    if (id < N) {
+      output[id] = __nv_cvt_float_to_fp8(static_cast<float>(input[id]) / scale, saturation, interpretation);
+      id += NumThreadsPerBlock;
+    }
+  }
+}
+
+template <int NumThreadsPerBlock, int NumElementsPerThread, typename T>
+__global__ void DequantizeFloat8Kernel(const uint8_t* input, T* output, const T* scale_ptr,
+                                       __nv_fp8_interpretation_t interpretation, CUDA_LONG N) {
+  CUDA_LONG id = NumElementsPerThread * NumThreadsPerBlock * blockIdx.x + threadIdx.x;
+
+  const float scale = static_cast<float>(*scale_ptr);
+#pragma unroll
+  for (int i = 0; i < NumElementsPerThread; i++) {
+    if (id < N) {
+      // every E4M3FN and E5M2 value is exactly representable in half
+      const half value = __nv_cvt_fp8_to_halfraw(input[id], interpretation);
+      output[id] = static_cast<T>(__half2float(value) * scale);
+      id += NumThreadsPerBlock;
+    }
+  }
+}
+
+static __nv_fp8_interpretation_t ToInterpretation(Float8Format format) {
+  return format == Float8Format::E5M2 ? __NV_E5M2 : __NV_E4M3;
+}
+
+template <class T>
+Status CudaQuantizeFloat8(cudaStream_t stream, const T* input, uint8_t* output, const T* scale,
+                          Float8Format format, bool saturate, size_t num_of_element) {
+  if (num_of_element <= 0)
+    return Status::OK();
+
+  int blocksPerGrid = static_cast<int>(CeilDiv(num_of_element, GridDim::maxThreadsPerBlock * GridDim::maxElementsPerThread));
+  QuantizeFloat8Kernel<GridDim::maxThreadsPerBlock, GridDim::maxElementsPerThread><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      input,
+      output,
+      scale,
+      ToInterpretation(format),
+      saturate ? __NV_SATFINITE : __NV_NOSAT,
+      static_cast<CUDA_LONG>(num_of_element));
+  return CUDA_CALL(cudaGetLastError());
+}
+
+template <class T>
+Status CudaDequantizeFloat8(cudaStream_t stream, const uint8_t* input, T* output, const T* scale,
+                            Float8Format format, size_t num_of_element) {
+  if (num_of_element <= 0)
+    return Status::OK();
+
+  int blocksPerGrid = static_cast<int>(CeilDiv(num_of_element, GridDim::maxThreadsPerBlock * GridDim::maxElementsPerThread));
+  DequantizeFloat8Kernel<GridDim::maxThreadsPerBlock, GridDim::maxElementsPerThread><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      input,
+      output,
+      scale,
+      ToInterpretation(format),
+      static_cast<CUDA_LONG>(num_of_element));
+  return CUDA_CALL(cudaGetLastError());
+}
+
+#else
+
+template <class T>
+Status CudaQuantizeFloat8(cudaStream_t, const T*, uint8_t*, const T*, Float8Format, bool, size_t) {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Float8 quantization needs CUDA 11.8 or above.");
+}
+
+template <class T>
+Status CudaDequantizeFloat8(cudaStream_t, const uint8_t*, T*, const T*, Float8Format, size_t) {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Float8 quantization needs CUDA 11.8 or above.");
+}
+
+#endif
+
+template Status CudaQuantizeFloat8<float>(cudaStream_t stream, const float* input, uint8_t* output, const float* scale,
+                                          Float8Format format, bool saturate, size_t num_of_element);
+template Status CudaQuantizeFloat8<half>(cudaStream_t stream, const half* input, uint8_t* output, const half* scale,
+                                         Float8Format format, bool saturate, size_t num_of_element);
+
+template Status CudaDequantizeFloat8<float>(cudaStream_t stream, const uint8_t* input, float* output,
+                                            const float* scale, Float8Format format, size_t num_of_element);
+template Status CudaDequantizeFloat8<half>(cudaStream_t stream, const uint8_t* input, half* output,
+                                           const half* scale, Float8Format format, size_t num_of_element);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// The float8 formats, the values are stored as their bit patterns in uint8 tensors.
+enum class Float8Format {
+  E4M3FN,
+  E5M2,
+};
+
+template <class T>
+Status CudaQuantizeFloat8(cudaStream_t stream, const T* input, uint8_t* output, const T* scale,
+                          Float8Format format, bool saturate, size_t num_of_element);
+
+template <class T>
+Status CudaDequantizeFloat8(cudaStream_t stream, const uint8_t* input, T* output, const T* scale,
+                            Float8Format format, size_t num_of_element);
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -0,0 +1,180 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/quantization/matmul_float8.h"
+
+#include "contrib_ops/cuda/quantization/float8_quantization.h"
+#include "core/providers/cuda/cuda_common.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+#define REGISTER_KERNEL_TYPED(T)                                        \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                        \
+      MatMulFloat8,                                                     \
+      kMSDomain,                                                        \
+      1,                                                                \
+      T,                                                                \
+      kCudaExecutionProvider,                                           \
+      (*KernelDefBuilder::Create())                                     \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<uint8_t>()) \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<float>())   \
+          .TypeConstraint("T3", DataTypeImpl::GetTensorType<T>()),      \
+      MatMulFloat8<T>);
+
+REGISTER_KERNEL_TYPED(float)
+REGISTER_KERNEL_TYPED(MLFloat16)
+REGISTER_KERNEL_TYPED(BFloat16)
+
+// cuBLASLt needs the leading dimensions of the float8 matrices, and their rows in the TN layout, to be multiples of 16.
+constexpr int64_t kFloat8DimAlignment = 16;
+// The float8 kernels of cuBLASLt run faster with a workspace.
+constexpr size_t kFloat8WorkspaceSize = 4 * 1024 * 1024;
+
+template <typename T>
+MatMulFloat8<T>::MatMulFloat8(const OpKernelInfo& info) : CudaKernel(info) {
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11080
+  const auto& device_prop = GetDeviceProp();
+  ORT_ENFORCE((device_prop.major * 10 + device_prop.minor) >= 89, "MatMulFloat8 needs sm89 or higher");
+
+  format_a_ = GetFloat8FormatAttr(info, "fp8_format_a");
+  format_b_ = GetFloat8FormatAttr(info, "fp8_format_b");
+  ORT_ENFORCE(format_a_ != Float8Format::E5M2 || format_b_ != Float8Format::E5M2,
+              "MatMulFloat8 does not support E5M2 for both A and B");
+#else
+  ORT_UNUSED_PARAMETER(info);
+  ORT_ENFORCE(false, "Compiling with CUDA_VERSION >= 11.8 is needed!");
+#endif
+}
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11080
+
+namespace {
+
+cudaDataType_t ToCudaDataType(Float8Format format) {
+  return format == Float8Format::E5M2 ? CUDA_R_8F_E5M2 : CUDA_R_8F_E4M3;
+}
+
+template <typename T>
+cudaDataType_t OutputCudaDataType() {
+  if constexpr (std::is_same<T, MLFloat16>::value) {
+    return CUDA_R_16F;
+  } else if constexpr (std::is_same<T, BFloat16>::value) {
+    return CUDA_R_16BF;
+  } else {
+    return CUDA_R_32F;
+  }
+}
+
+// Owns the cuBLASLt descriptors of one MatMulFloat8 call.
+struct Float8GemmDescriptors {
+  ~Float8GemmDescriptors() {
+    if (preference) cublasLtMatmulPreferenceDestroy(preference);
+    if (c) cublasLtMatrixLayoutDestroy(c);
+    if (b) cublasLtMatrixLayoutDestroy(b);
+    if (a) cublasLtMatrixLayoutDestroy(a);
+    if (matmul) cublasLtMatmulDescDestroy(matmul);
+  }
+
+  cublasLtMatmulDesc_t matmul{};
+  cublasLtMatrixLayout_t a{};
+  cublasLtMatrixLayout_t b{};
+  cublasLtMatrixLayout_t c{};
+  cublasLtMatmulPreference_t preference{};
+};
+
+}  // namespace
+
+#endif
+
+template <typename T>
+Status MatMulFloat8<T>::ComputeInternal(OpKernelContext* context) const {
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11080
+  const Tensor& A = *context->Input<Tensor>(0);
+  const Tensor& B = *context->Input<Tensor>(1);
+  const Tensor& a_scale = *context->Input<Tensor>(2);
+  const Tensor& b_scale = *context->Input<Tensor>(3);
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(&a_scale) && IsScalarOr1ElementVector(&b_scale),
+                    "a_scale and b_scale must be scalars or 1D tensors of size 1.");
+
+  const auto& a_shape = A.Shape();
+  const auto& b_shape = B.Shape();
+  ORT_RETURN_IF_NOT(a_shape.NumDimensions() >= 2, "A must have at least 2 dimensions, got ", a_shape);
+  ORT_RETURN_IF_NOT(b_shape.NumDimensions() == 2, "B must be 2 dimensional, got ", b_shape);
+
+  const int64_t K = a_shape[a_shape.NumDimensions() - 1];
+  const int64_t M = a_shape.SizeToDimension(a_shape.NumDimensions() - 1);
+  const int64_t N = b_shape[0];
+  ORT_RETURN_IF_NOT(b_shape[1] == K, "The last dimension of A and B must match, got ", a_shape, " and ", b_shape);
+  ORT_RETURN_IF_NOT(K % kFloat8DimAlignment == 0 && N % kFloat8DimAlignment == 0,
+                    "MatMulFloat8 needs K and N to be multiples of ", kFloat8DimAlignment, ", got K=", K, " N=", N);
+
+  TensorShapeVector y_dims = a_shape.AsShapeVector();
+  y_dims.back() = N;
+  Tensor& Y = *context->Output(0, TensorShape(y_dims));
+  if (Y.Shape().Size() == 0) {
+    return Status::OK();
+  }
+
+  // Y of (M, N) in row major is Y' of (N, M) in column major, i.e. Y' = B x A' where B of (N, K) is read as the
+  // column major (K, N) matrix and transposed, and A is the column major (K, M) matrix. This is the TN layout that
+  // is required by the float8 kernels of cuBLASLt.
+  const cudaDataType_t y_type = OutputCudaDataType<T>();
+  Float8GemmDescriptors descriptors;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescCreate(&descriptors.matmul, CUBLAS_COMPUTE_32F, CUDA_R_32F));
+  const cublasOperation_t trans_a = CUBLAS_OP_T;
+  const cublasOperation_t trans_b = CUBLAS_OP_N;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(descriptors.matmul, CUBLASLT_MATMUL_DESC_TRANSA,
+                                                        &trans_a, sizeof(trans_a)));
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(descriptors.matmul, CUBLASLT_MATMUL_DESC_TRANSB,
+                                                        &trans_b, sizeof(trans_b)));
+  // the scale of the cuBLASLt A is the scale of B and vice versa
+  const void* scale_a_ptr = b_scale.Data<float>();
+  const void* scale_b_ptr = a_scale.Data<float>();
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(descriptors.matmul, CUBLASLT_MATMUL_DESC_A_SCALE_POINTER,
+                                                        &scale_a_ptr, sizeof(scale_a_ptr)));
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(descriptors.matmul, CUBLASLT_MATMUL_DESC_B_SCALE_POINTER,
+                                                        &scale_b_ptr, sizeof(scale_b_ptr)));
+
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&descriptors.a, ToCudaDataType(format_b_), K, N, K));
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&descriptors.b, ToCudaDataType(format_a_), K, M, K));
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&descriptors.c, y_type, N, M, N));
+
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulPreferenceCreate(&descriptors.preference));
+  const uint64_t workspace_size = kFloat8WorkspaceSize;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulPreferenceSetAttribute(descriptors.preference,
+                                                              CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+                                                              &workspace_size, sizeof(workspace_size)));
+
+  cublasLtMatmulHeuristicResult_t heuristic = {};
+  int result_count = 0;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulAlgoGetHeuristic(CublasLtHandle(), descriptors.matmul,
+                                                        descriptors.a, descriptors.b, descriptors.c, descriptors.c,
+                                                        descriptors.preference, 1, &heuristic, &result_count));
+  ORT_RETURN_IF_NOT(result_count > 0, "cuBLASLt has no float8 algo for M=", M, " N=", N, " K=", K);
+
+  auto workspace = GetScratchBuffer<void>(kFloat8WorkspaceSize, context->GetComputeStream());
+  const float alpha = 1.0f;
+  const float beta = 0.0f;
+  void* y_data = Y.MutableDataRaw();
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmul(
+      CublasLtHandle(), descriptors.matmul,
+      &alpha,
+      B.Data<uint8_t>(), descriptors.a,
+      A.Data<uint8_t>(), descriptors.b,
+      &beta,
+      y_data, descriptors.c,
+      y_data, descriptors.c,
+      &heuristic.algo, workspace.get(), kFloat8WorkspaceSize, Stream(context)));
+
+  return Status::OK();
+#else
+  ORT_UNUSED_PARAMETER(context);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "MatMulFloat8 needs CUDA 11.8 or above.");
+#endif
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
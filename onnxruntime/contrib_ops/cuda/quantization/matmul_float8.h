@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_kernel.h"
+#include "contrib_ops/cuda/quantization/float8_quantization_impl.cuh"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+using namespace onnxruntime::cuda;
+
+// Runs MatMulFloat8 with cublasLtMatmul on the float8 tensor cores, the per tensor scales of A and B are applied
+// by cuBLASLt while the product is accumulated in float.
+template <typename T>
+class MatMulFloat8 final : public CudaKernel {
+ public:
+  MatMulFloat8(const OpKernelInfo& info);
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+ private:
+  Float8Format format_a_;
+  Float8Format format_b_;
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
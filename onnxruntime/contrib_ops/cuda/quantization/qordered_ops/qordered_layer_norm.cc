@@ -20,7 +20,8 @@ ONNX_OPERATOR_KERNEL_EX(
         .TypeConstraint("S", DataTypeImpl::GetTensorType<float>())
         .TypeConstraint("F", BuildKernelDefConstraints<float, MLFloat16>())
         .InputMemoryType(OrtMemTypeCPUInput, 1)   // scale_X
-        .InputMemoryType(OrtMemTypeCPUInput, 4),  // scale_Y
+        .InputMemoryType(OrtMemTypeCPUInput, 4)   // scale_Y
+        .InputMemoryType(OrtMemTypeCPUInput, 6),  // scale_R
     QOrderedLayerNormalization);
 
 QOrderedLayerNormalization::QOrderedLayerNormalization(const OpKernelInfo& op_kernel_info)
@@ -82,6 +83,26 @@ Status QOrderedLayerNormalization::ComputeInternal(OpKernelContext* ctx) const {
   const float* scale_x = ctx->Input<Tensor>(1)->Data<float>();
   const float* scale_y = ctx->Input<Tensor>(4)->Data<float>();
 
+  const Tensor* R = ctx->Input<Tensor>(5);
+  if (R != nullptr) {
+    ORT_ENFORCE(R->Shape() == x_shape, "QOrderedLayerNormlalization: Residual shape must be same as input shape");
+    const Tensor* scale_R = ctx->Input<Tensor>(6);
+    ORT_ENFORCE(scale_R != nullptr, "QOrderedLayerNormlalization: scale_R is required when residual is given");
+    const auto* R_data = reinterpret_cast<const CudaQ*>(R->Data<int8_t>());
+    const float scale_r = *scale_R->Data<float>();
+
+    if (scale->IsDataType<MLFloat16>()) {
+      return QOrderedAddLayerNorm(Stream(ctx), GetDeviceProp(), static_cast<cublasLtOrder_t>(order_X_),
+                                  X_data, *scale_x, R_data, scale_r, Y_data, *scale_y,
+                                  static_cast<const __half*>(scale_data), static_cast<const __half*>(bias_data),
+                                  static_cast<float>(epsilon_), batch, rows, cols);
+    }
+    return QOrderedAddLayerNorm(Stream(ctx), GetDeviceProp(), static_cast<cublasLtOrder_t>(order_X_),
+                                X_data, *scale_x, R_data, scale_r, Y_data, *scale_y,
+                                static_cast<const float*>(scale_data), static_cast<const float*>(bias_data),
+                                static_cast<float>(epsilon_), batch, rows, cols);
+  }
+
   if (scale->IsDataType<MLFloat16>()) {
     return QOrderedLayerNorm(Stream(ctx), GetDeviceProp(), static_cast<cublasLtOrder_t>(order_X_),
                              X_data, *scale_x, Y_data, *scale_y, static_cast<const __half*>(scale_data),
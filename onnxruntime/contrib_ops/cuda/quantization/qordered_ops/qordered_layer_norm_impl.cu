@@ -71,6 +71,66 @@ __global__ void QOrderedLayerNormRowKernel(const int8_t* __restrict__ src, const
   }
 }
 
+// Same as QOrderedLayerNormRowKernel, but normalizes src + residual. The two inputs have different scales, so the
+// statistics are accumulated in float instead of with dp4a on the int8 values.
+template <typename T>
+__global__ void QOrderedAddLayerNormRowKernel(const int8_t* __restrict__ src, const float src_scale,
+                                              const int8_t* __restrict__ residual, const float residual_scale,
+                                              int8_t* __restrict__ dst, const float dst_scale,
+                                              const T* __restrict__ gamma, const T* __restrict__ beta,
+                                              const float epsilon, const unsigned rows, const unsigned cols) {
+  float sum = 0.0f;
+  float square_sum = 0.0f;
+
+  unsigned r = blockIdx.x * QORDER_LAYERNORM_ROWS_PER_BLOCK + threadIdx.y;
+
+  if (rows <= r) {
+    return;
+  }
+
+  const size_t batch_row_index = static_cast<size_t>(blockIdx.y) * (rows * cols) + r * cols;
+  src += batch_row_index;
+  residual += batch_row_index;
+  dst += batch_row_index;
+  float4 f4;
+  for (unsigned c = threadIdx.x << 2; c < cols; c += 128) {
+    char4 ch4 = __ldg(reinterpret_cast<const char4*>(src + c));
+    char4 rh4 = __ldg(reinterpret_cast<const char4*>(residual + c));
+    f4.x = src_scale * ch4.x + residual_scale * rh4.x;
+    f4.y = src_scale * ch4.y + residual_scale * rh4.y;
+    f4.z = src_scale * ch4.z + residual_scale * rh4.z;
+    f4.w = src_scale * ch4.w + residual_scale * rh4.w;
+    sum += (f4.x + f4.y + f4.z + f4.w);
+    square_sum += (f4.x * f4.x + f4.y * f4.y + f4.z * f4.z + f4.w * f4.w);
+  }
+
+  sum = WarpReduceSum<float>(sum);
+  square_sum = WarpReduceSum<float>(square_sum);
+
+  const float mean = sum / cols;
+  const float rvar = rsqrtf(fmaxf(square_sum / cols - mean * mean, 0.0f) + epsilon);
+  const float dst_rscale = 1.0f / dst_scale;
+
+  for (unsigned c = threadIdx.x << 2; c < cols; c += 128) {
+    char4 ch4 = __ldg(reinterpret_cast<const char4*>(src + c));
+    char4 rh4 = __ldg(reinterpret_cast<const char4*>(residual + c));
+
+    f4.x = (src_scale * ch4.x + residual_scale * rh4.x - mean) * rvar * ToFloat(gamma[c]);
+    f4.y = (src_scale * ch4.y + residual_scale * rh4.y - mean) * rvar * ToFloat(gamma[c + 1]);
+    f4.z = (src_scale * ch4.z + residual_scale * rh4.z - mean) * rvar * ToFloat(gamma[c + 2]);
+    f4.w = (src_scale * ch4.w + residual_scale * rh4.w - mean) * rvar * ToFloat(gamma[c + 3]);
+
+    if (beta) {
+      f4.x += ToFloat(beta[c]);
+      f4.y += ToFloat(beta[c + 1]);
+      f4.z += ToFloat(beta[c + 2]);
+      f4.w += ToFloat(beta[c + 3]);
+    }
+
+    *reinterpret_cast<char4*>(dst + c) = QuantizeFloat4Char4(f4, dst_rscale);
+  }
+}
+
 template <typename T>
 Status QOrderedLayerNorm(cudaStream_t stream, const cudaDeviceProp& /*device_prop*/, cublasLtOrder_t order,
                        const int8_t* src, const float src_scale, int8_t* dst, const float dst_scale,
@@ -90,6 +150,27 @@ Status QOrderedLayerNorm(cudaStream_t stream, const cudaDeviceProp& /*device_pro
   return CUDA_CALL(cudaGetLastError());  
 }
 
+template <typename T>
+Status QOrderedAddLayerNorm(cudaStream_t stream, const cudaDeviceProp& /*device_prop*/, cublasLtOrder_t order,
+                            const int8_t* src, const float src_scale,
+                            const int8_t* residual, const float residual_scale,
+                            int8_t* dst, const float dst_scale,
+                            const T* gamma, const T* beta, const float epsilon,
+                            const unsigned batch, const unsigned rows, const unsigned cols) {
+  // The implementation only supports Row major tensor data ordering for now
+  ORT_RETURN_IF(order != CUBLASLT_ORDER_ROW, "Order current not supported!");
+
+  dim3 threads(32, QORDER_LAYERNORM_ROWS_PER_BLOCK, 1);
+
+  dim3 blocks(static_cast<unsigned>(rows + QORDER_LAYERNORM_ROWS_PER_BLOCK - 1) / QORDER_LAYERNORM_ROWS_PER_BLOCK,
+              static_cast<unsigned>(batch), 1);
+
+  QOrderedAddLayerNormRowKernel<T><<<blocks, threads, 0, stream>>>(
+      src, src_scale, residual, residual_scale, dst, dst_scale, gamma, beta, epsilon, rows, cols);
+
+  return CUDA_CALL(cudaGetLastError());
+}
+
 template Status QOrderedLayerNorm<float>(cudaStream_t stream, const cudaDeviceProp& /*device_prop*/, cublasLtOrder_t order,
                                        const int8_t* src, const float src_scale, int8_t* dst, const float dst_scale,
                                        const float* gamma, const float* beta, const float epsilon,
@@ -100,6 +181,20 @@ template Status QOrderedLayerNorm<__half>(cudaStream_t stream, const cudaDeviceP
                                         const __half* gamma, const __half* beta, const float epsilon,
                                         const unsigned batch, const unsigned rows, const unsigned cols);
 
+template Status QOrderedAddLayerNorm<float>(cudaStream_t stream, const cudaDeviceProp& /*device_prop*/,
+                                            cublasLtOrder_t order, const int8_t* src, const float src_scale,
+                                            const int8_t* residual, const float residual_scale,
+                                            int8_t* dst, const float dst_scale,
+                                            const float* gamma, const float* beta, const float epsilon,
+                                            const unsigned batch, const unsigned rows, const unsigned cols);
+
+template Status QOrderedAddLayerNorm<__half>(cudaStream_t stream, const cudaDeviceProp& /*device_prop*/,
+                                             cublasLtOrder_t order, const int8_t* src, const float src_scale,
+                                             const int8_t* residual, const float residual_scale,
+                                             int8_t* dst, const float dst_scale,
+                                             const __half* gamma, const __half* beta, const float epsilon,
+                                             const unsigned batch, const unsigned rows, const unsigned cols);
+
 }  // namespace cuda
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -16,6 +16,15 @@ Status QOrderedLayerNorm(
     const T* gamma, const T* beta, const float epsilon,
     unsigned batch, unsigned rows, unsigned cols);
 
+// Layer normalization of (src + residual), quantized to dst in one pass.
+template <typename T>
+Status QOrderedAddLayerNorm(
+    cudaStream_t stream, const cudaDeviceProp& device_prop, cublasLtOrder_t order,
+    const int8_t* src, const float src_scale, const int8_t* residual, const float residual_scale,
+    int8_t* dst, const float dst_scale,
+    const T* gamma, const T* beta, const float epsilon,
+    unsigned batch, unsigned rows, unsigned cols);
+
 }
 }  // namespace contrib
 }  // namespace onnxruntime
@@ -62,9 +62,13 @@ void LaunchNextTokenKernel(const int64_t* next_token_indices,
                                                       total_elements);
 }
 
+// Apply the logits processors to the score of one token. index is the offset of the score in presence_mask.
 template <typename T>
-__global__ void LogitsProcessKernel(
-    T* next_token_scores,
+__device__ __forceinline__ T ProcessLogit(
+    T score,
+    int index,
+    int batch_beam_index,
+    int word_id,
     const int* vocab_mask,
     const int* prefix_vocab_mask,
     const int* presence_mask,
@@ -72,93 +76,113 @@ __global__ void LogitsProcessKernel(
     float temperature,
     int num_beams,
     int vocab_size,
-    int padded_vocab_size,
-    int total_elements,
     int demote_token_id,
-    int32_t* sequences,
+    const int32_t* sequences,
     int max_sequence_length,
     int current_sequence_length,
     float repetition_penalty,
     int no_repeat_ngram_size) {
-  int index = blockIdx.x * blockDim.x + threadIdx.x;
-  if (index < total_elements) {
-    int batch_beam_index = index / padded_vocab_size;
-    int word_id = index % padded_vocab_size;
+  // RepetitionPenaltyLogitsProcessor
+  if (repetition_penalty != 1.0f) {
+    const int32_t* current_sequence = sequences + batch_beam_index * max_sequence_length;
+    bool found = false;
+    for (int i = 0; i < current_sequence_length; i++) {
+      if (current_sequence[i] == word_id) {
+        found = true;
+        break;
+      }
+    }
+    if (found) {
+      float value = (float)score;
+      score = (T)(value < 0 ? value * repetition_penalty : value / repetition_penalty);
+    }
+  }
 
-    if (word_id >= vocab_size) {
-      // Set any value within the padding region to the lowest value so that it isn't picked
-      next_token_scores[index] = cub::FpLimits<T>::Lowest();
-    } else {
-      // RepetitionPenaltyLogitsProcessor
-      if (repetition_penalty != 1.0f) {
-        int32_t* current_sequence = sequences + batch_beam_index * max_sequence_length;
-        bool found = false;
-        for (int i = 0; i < current_sequence_length; i++) {
-          if (current_sequence[i] == word_id) {
-            found = true;
+  // NoRepeatNGramLogitsProcessor
+  if (no_repeat_ngram_size > 0 && current_sequence_length >= no_repeat_ngram_size) {
+    const int32_t* current_sequence = sequences + batch_beam_index * max_sequence_length;
+    bool found = false;
+    for (int i = no_repeat_ngram_size - 1; i < current_sequence_length; i++) {
+      if (current_sequence[i] == word_id) {  // last token of n-gram matched
+        found = true;
+        for (int j = 0; j < no_repeat_ngram_size - 1; j++) {  // match the remaining N-1 tokens
+          if (current_sequence[i - j - 1] != current_sequence[current_sequence_length - 1 - j]) {
+            found = false;
             break;
           }
         }
         if (found) {
-          float score = (float)next_token_scores[index];
-          next_token_scores[index] = (T)(score < 0 ? score * repetition_penalty : score / repetition_penalty);
+          break;
         }
       }
+    }
 
-      // NoRepeatNGramLogitsProcessor
-      if (no_repeat_ngram_size > 0 && current_sequence_length >= no_repeat_ngram_size) {
-        int32_t* current_sequence = sequences + batch_beam_index * max_sequence_length;
-        bool found = false;
-        for (int i = no_repeat_ngram_size - 1; i < current_sequence_length; i++) {
-          if (current_sequence[i] == word_id) {  // last token of n-gram matched
-            found = true;
-            for (int j = 0; j < no_repeat_ngram_size - 1; j++) {  // match the remaining N-1 tokens
-              if (current_sequence[i - j - 1] != current_sequence[current_sequence_length - 1 - j]) {
-                found = false;
-                break;
-              }
-            }
-            if (found) {
-              break;
-            }
-          }
-        }
+    if (found) {
+      return cub::FpLimits<T>::Lowest();
+    }
+  }
 
-        if (found) {
-          next_token_scores[index] = cub::FpLimits<T>::Lowest();
-          return;
-        }
-      }
+  // VocabMaskLogitsProcessor
+  if (vocab_mask != nullptr && vocab_mask[word_id] == 0) {
+    return cub::FpLimits<T>::Lowest();
+  }
 
-      // VocabMaskLogitsProcessor
-      if (vocab_mask != nullptr && vocab_mask[word_id] == 0) {
-        next_token_scores[index] = cub::FpLimits<T>::Lowest();
-        return;
-      }
+  // PrefixVocabMaskLogitsProcessor
+  int batch_id = batch_beam_index / num_beams;
+  if (prefix_vocab_mask != nullptr && prefix_vocab_mask[batch_id * vocab_size + word_id] == 0) {
+    return cub::FpLimits<T>::Lowest();
+  }
 
-      // PrefixVocabMaskLogitsProcessor
-      int batch_id = batch_beam_index / num_beams;
-      if (prefix_vocab_mask != nullptr && prefix_vocab_mask[batch_id * vocab_size + word_id] == 0) {
-        next_token_scores[index] = cub::FpLimits<T>::Lowest();
-        return;
-      }
+  // MinLengthLogitsProcessor
+  if (word_id == demote_token_id) {
+    score = cub::FpLimits<T>::Lowest();
+  }
 
-      // MinLengthLogitsProcessor
-      if (word_id == demote_token_id) {
-        next_token_scores[index] = cub::FpLimits<T>::Lowest();
-      }
+  // PresencePenaltyLogitsProcessor
+  if (presence_mask != nullptr && presence_mask[index] == 1) {
+    score = (T)((float)score - presence_penalty);
+  }
 
-      // PresencePenaltyLogitsProcessor
-      if (presence_mask != nullptr && presence_mask[index] == 1) {
-        float score = (float)next_token_scores[index] - presence_penalty;
-        next_token_scores[index] = (T)score;
-      }
+  // TemperatureLogitsProcessor
+  if (temperature != 1.0f) {
+    score = (T)((float)score / temperature);
+  }
 
-      // TemperatureLogitsProcessor
-      if (temperature != 1.0f) {
-        float score = (float)(next_token_scores[index]);
-        next_token_scores[index] = (T)(score / temperature);
-      }
+  return score;
+}
+
+template <typename T>
+__global__ void LogitsProcessKernel(
+    T* next_token_scores,
+    const int* vocab_mask,
+    const int* prefix_vocab_mask,
+    const int* presence_mask,
+    float presence_penalty,
+    float temperature,
+    int num_beams,
+    int vocab_size,
+    int padded_vocab_size,
+    int total_elements,
+    int demote_token_id,
+    int32_t* sequences,
+    int max_sequence_length,
+    int current_sequence_length,
+    float repetition_penalty,
+    int no_repeat_ngram_size) {
+  int index = blockIdx.x * blockDim.x + threadIdx.x;
+  if (index < total_elements) {
+    int batch_beam_index = index / padded_vocab_size;
+    int word_id = index % padded_vocab_size;
+
+    if (word_id >= vocab_size) {
+      // Set any value within the padding region to the lowest value so that it isn't picked
+      next_token_scores[index] = cub::FpLimits<T>::Lowest();
+    } else {
+      next_token_scores[index] = ProcessLogit(next_token_scores[index], index, batch_beam_index, word_id,
+                                              vocab_mask, prefix_vocab_mask, presence_mask, presence_penalty,
+                                              temperature, num_beams, vocab_size, demote_token_id, sequences,
+                                              max_sequence_length, current_sequence_length, repetition_penalty,
+                                              no_repeat_ngram_size);
     }
   }
 }
@@ -243,6 +267,168 @@ template void LaunchLogitsProcessKernel(
     int no_repeat_ngram_size,
     cudaStream_t stream);
 
+// One block per row of next_token_scores: log_softmax of the logits of the last token, followed by the logits
+// processors and the addition of the beam score. It replaces gathering the last token logits, softmax,
+// LogitsProcessKernel and AddProbsKernel, so the vocab-sized row is only written once.
+template <typename T, int ThreadsPerBlock>
+__global__ void LogSoftmaxProcessLogitsKernel(
+    float* next_token_scores,
+    const T* logits,
+    const float* beam_scores,
+    int input_length,
+    int logits_batch_size,
+    int num_beams,
+    int vocab_size,
+    int padded_vocab_size,
+    const int* vocab_mask,
+    const int* prefix_vocab_mask,
+    const int* presence_mask,
+    float presence_penalty,
+    float temperature,
+    int demote_token_id,
+    const int32_t* sequences,
+    int max_sequence_length,
+    int current_sequence_length,
+    float repetition_penalty,
+    int no_repeat_ngram_size) {
+  const int batch_beam_index = blockIdx.x;
+
+  // logits has shape (logits_batch_size, input_length, padded_vocab_size), where logits_batch_size is either
+  // batch_size * num_beams, or batch_size when all beams of a batch share logits.
+  const int logits_row = (logits_batch_size == static_cast<int>(gridDim.x)) ? batch_beam_index
+                                                                            : batch_beam_index / num_beams;
+  const T* row = logits + (static_cast<int64_t>(logits_row) * input_length + input_length - 1) * padded_vocab_size;
+
+  typedef cub::BlockReduce<float, ThreadsPerBlock> BlockReduce;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+  __shared__ float row_max;
+  __shared__ float row_log_sum;
+
+  float thread_max = cub::FpLimits<float>::Lowest();
+  for (int i = threadIdx.x; i < vocab_size; i += ThreadsPerBlock) {
+    thread_max = fmaxf(thread_max, static_cast<float>(row[i]));
+  }
+  float block_max = BlockReduce(temp_storage).Reduce(thread_max, cub::Max());
+  if (threadIdx.x == 0) {
+    row_max = block_max;
+  }
+  __syncthreads();
+
+  float thread_sum = 0.0f;
+  for (int i = threadIdx.x; i < vocab_size; i += ThreadsPerBlock) {
+    thread_sum += expf(static_cast<float>(row[i]) - row_max);
+  }
+  float block_sum = BlockReduce(temp_storage).Sum(thread_sum);
+  if (threadIdx.x == 0) {
+    row_log_sum = logf(block_sum);
+  }
+  __syncthreads();
+
+  const float beam_score = beam_scores == nullptr ? 0.0f : beam_scores[batch_beam_index];
+  float* scores = next_token_scores + static_cast<int64_t>(batch_beam_index) * vocab_size;
+  for (int i = threadIdx.x; i < vocab_size; i += ThreadsPerBlock) {
+    float score = static_cast<float>(row[i]) - row_max - row_log_sum;
+    score = ProcessLogit(score, batch_beam_index * vocab_size + i, batch_beam_index, i, vocab_mask,
+                         prefix_vocab_mask, presence_mask, presence_penalty, temperature, num_beams, vocab_size,
+                         demote_token_id, sequences, max_sequence_length, current_sequence_length,
+                         repetition_penalty, no_repeat_ngram_size);
+    scores[i] = score + beam_score;
+  }
+}
+
+template <typename T>
+void LaunchLogSoftmaxProcessLogitsKernel(
+    float* next_token_scores,
+    const T* logits,
+    const float* beam_scores,
+    int batch_size,
+    int num_beams,
+    int input_length,
+    int logits_batch_size,
+    int vocab_size,
+    int padded_vocab_size,
+    const int* vocab_mask,
+    const int* prefix_vocab_mask,
+    int* presence_mask,
+    float presence_penalty,
+    float temperature,
+    int demote_token_id,
+    int32_t* sequences,
+    int max_sequence_length,
+    int current_sequence_length,
+    float repetition_penalty,
+    int no_repeat_ngram_size,
+    cudaStream_t stream) {
+  constexpr int blockSize = 256;
+  const int gridSize = batch_size * num_beams;
+  LogSoftmaxProcessLogitsKernel<T, blockSize><<<gridSize, blockSize, 0, stream>>>(
+      next_token_scores,
+      logits,
+      beam_scores,
+      input_length,
+      logits_batch_size,
+      num_beams,
+      vocab_size,
+      padded_vocab_size,
+      vocab_mask,
+      prefix_vocab_mask,
+      presence_mask,
+      presence_penalty,
+      temperature,
+      demote_token_id,
+      sequences,
+      max_sequence_length,
+      current_sequence_length,
+      repetition_penalty,
+      no_repeat_ngram_size);
+}
+
+template void LaunchLogSoftmaxProcessLogitsKernel(
+    float* next_token_scores,
+    const float* logits,
+    const float* beam_scores,
+    int batch_size,
+    int num_beams,
+    int input_length,
+    int logits_batch_size,
+    int vocab_size,
+    int padded_vocab_size,
+    const int* vocab_mask,
+    const int* prefix_vocab_mask,
+    int* presence_mask,
+    float presence_penalty,
+    float temperature,
+    int demote_token_id,
+    int32_t* sequences,
+    int max_sequence_length,
+    int current_sequence_length,
+    float repetition_penalty,
+    int no_repeat_ngram_size,
+    cudaStream_t stream);
+
+template void LaunchLogSoftmaxProcessLogitsKernel(
+    float* next_token_scores,
+    const half* logits,
+    const float* beam_scores,
+    int batch_size,
+    int num_beams,
+    int input_length,
+    int logits_batch_size,
+    int vocab_size,
+    int padded_vocab_size,
+    const int* vocab_mask,
+    const int* prefix_vocab_mask,
+    int* presence_mask,
+    float presence_penalty,
+    float temperature,
+    int demote_token_id,
+    int32_t* sequences,
+    int max_sequence_length,
+    int current_sequence_length,
+    float repetition_penalty,
+    int no_repeat_ngram_size,
+    cudaStream_t stream);
+
 __global__ void AddProbsKernel(float* log_probs,
                                float* cum_log_probs,
                                const int vocab_size,
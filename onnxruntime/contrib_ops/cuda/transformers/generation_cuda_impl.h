@@ -45,6 +45,31 @@ void LaunchLogitsProcessKernel(
     int no_repeat_ngram_size,
     cudaStream_t stream);
 
+// Fused log_softmax of the last token logits, logits processors and addition of beam scores (when not null).
+template <typename T>
+void LaunchLogSoftmaxProcessLogitsKernel(
+    float* next_token_scores,
+    const T* logits,
+    const float* beam_scores,
+    int batch_size,
+    int num_beams,
+    int input_length,
+    int logits_batch_size,
+    int vocab_size,
+    int padded_vocab_size,
+    const int* vocab_mask,
+    const int* prefix_vocab_mask,
+    int* presence_mask,
+    float presence_penalty,
+    float temperature,
+    int demote_token_id,
+    int32_t* sequences,
+    int max_sequence_length,
+    int current_sequence_length,
+    float repetition_penalty,
+    int no_repeat_ngram_size,
+    cudaStream_t stream);
+
 void LaunchNextTokenKernel(const int64_t* next_token_indices,
                            int32_t* next_indices,
                            int32_t* next_tokens,
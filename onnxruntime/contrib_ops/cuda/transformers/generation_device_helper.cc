@@ -295,55 +295,8 @@ Status ProcessLogits(const OrtValue& logits,                                 //
 
   cudaStream_t cuda_stream = ort_stream ? static_cast<cudaStream_t>(ort_stream->GetHandle()) : nullptr;
 
-  // Get logits for the last token:
-  //    next_token_logits = logits[:, -1, :], and the result shape is (batch_size * num_beams, vocab_size)
-  // When input_length == 1, use logits directly in SoftmaxCPU below so it only need for input_length > 1.
-  gsl::span<T>& next_token_logits = beam_state->next_token_logits;
-  // TODO(tianleiwu): use one kernel to replace a loop of memory copy.
-  if (input_length > 1 || logits_batch_size == batch_size) {
-    // Move the pointer in increments of padded_vocab_size to account for any padding
-    // if any in the logits weight of the MatMul.
-    const CudaT* current_logits = logits_data + (input_length - 1) * padded_vocab_size;
-    for (int i = 0; i < batch_beam_size; i++) {
-      // We only copy what is relevant (i.e.) vocab_size as padded_vocab_size will contain
-      // some logits corresponding to the "padded" vocab size which we will ignore
-      // for token generation.
-      gsl::span<const T> source(reinterpret_cast<const T*>(current_logits), vocab_size);
-      gsl::span<T> target = next_token_logits.subspan(static_cast<size_t>(i) * vocab_size, vocab_size);
-      CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(target.data(), source.data(), sizeof(T) * vocab_size,
-                                           cudaMemcpyDeviceToDevice, cuda_stream));
-      if (logits_batch_size == batch_beam_size) {
-        current_logits += input_length * padded_vocab_size;
-      } else if (logits_batch_size == batch_size && i % num_beams == num_beams - 1) {
-        current_logits += input_length * padded_vocab_size;
-      }
-    }
-  }
-
 #ifdef DEBUG_GENERATION
   dumper->Print("logits", logits);
-  if (input_length > 1 || logits_batch_size == batch_size) {
-    dumper->Print("next_token_logits", next_token_logits.data(), batch_size, num_beams, vocab_size);
-  }
-#endif
-
-  // Get scores for candidates of next token: next_token_scores = log_softmax(next_token_logits, dim=-1)
-  gsl::span<float>& next_token_scores = beam_state->next_token_scores;
-
-  // The output will be float for consideration of precision and easy integration with remaining parts.
-  float* Y_data = next_token_scores.data();
-  bool is_reuse_logits_buffer = (input_length == 1 && logits_batch_size == batch_beam_size);
-
-  const CudaT* X_data = is_reuse_logits_buffer ? logits_data : reinterpret_cast<const CudaT*>(next_token_logits.data());
-
-  dispatch_blockwise_softmax_forward<CudaT, float, float, true>(
-      cuda_stream, Y_data, X_data, vocab_size,
-      is_reuse_logits_buffer ? padded_vocab_size : vocab_size,
-      vocab_size,
-      batch_size * num_beams);
-
-#ifdef DEBUG_GENERATION
-  dumper->Print("next_token_scores after softmax", next_token_scores.data(), batch_size, num_beams, vocab_size);
 #endif
 
   // Sequences generated by beam scorer is currently stored in CPU.
@@ -360,17 +313,28 @@ Status ProcessLogits(const OrtValue& logits,                                 //
                                          cudaMemcpyHostToDevice, cuda_stream));
   }
 
-  cuda::LaunchLogitsProcessKernel<float>(
+  // Get scores for candidates of next token in one kernel, which reads the logits of the last token in place:
+  //    next_token_logits = logits[:, -1, :]
+  //    next_token_scores = log_softmax(next_token_logits, dim=-1)
+  //    next_token_scores = logits_processors(next_token_scores)
+  //    next_token_scores = next_token_scores + beam_scores[:, None].expand_as(next_token_scores)
+  // The output will be float for consideration of precision and easy integration with remaining parts.
+  gsl::span<float>& next_token_scores = beam_state->next_token_scores;
+  cuda::LaunchLogSoftmaxProcessLogitsKernel<CudaT>(
       next_token_scores.data(),
+      logits_data,
+      beam_state->beam_scores.data(),
+      batch_size,
+      num_beams,
+      static_cast<int>(input_length),
+      static_cast<int>(logits_batch_size),
+      vocab_size,
+      padded_vocab_size,
       parameters->vocab_mask.data(),
       step > 1 ? nullptr : parameters->prefix_vocab_mask.data(),  // prefix vocab mask is applied to first step only.
       nullptr,                                                    // parameters->presence_mask.data(),
       parameters->presence_penalty,
       parameters->temperature,
-      parameters->batch_size,
-      parameters->num_beams,
-      parameters->vocab_size,
-      parameters->vocab_size,
       (parameters->min_length > 0 && current_sequence_length < parameters->min_length) ? parameters->eos_token_id : -1,
       reinterpret_cast<int32_t*>(sequences_buffer.get()),
       parameters->max_length,
@@ -379,14 +343,6 @@ Status ProcessLogits(const OrtValue& logits,                                 //
       parameters->no_repeat_ngram_size,
       cuda_stream);
 
-#ifdef DEBUG_GENERATION
-  dumper->Print("next_token_scores after logits process", next_token_scores.data(), batch_size, num_beams, vocab_size);
-#endif
-  // Add beam score to next token scores. Corresponding python code is like:
-  //    next_token_scores = next_token_scores + beam_scores[:, None].expand_as(next_token_scores)
-  cuda::LaunchAddProbsKernel(next_token_scores.data(), beam_state->beam_scores.data(),
-                             batch_size, num_beams, vocab_size, cuda_stream);
-
 #ifdef DEBUG_GENERATION
   dumper->Print("next_token_scores adding beam_scores", next_token_scores.data(), batch_size, num_beams, vocab_size);
 #endif
@@ -782,8 +738,19 @@ Status PickT5PastState(const std::vector<OrtValue>& last_outputs,
                        int t5_decoder_first_present_output_idx,
                        Stream* ort_stream) {
   cudaStream_t cuda_stream = ort_stream ? static_cast<cudaStream_t>(ort_stream->GetHandle()) : nullptr;
+
+  // When every beam continues from itself, present states can be fed to the next step as they are.
+  bool is_identity = true;
+  for (size_t j = 0; j < beam_indices.size() && is_identity; j++) {
+    is_identity = (beam_indices[j] == static_cast<int32_t>(j));
+  }
+
   for (int i = 0; i < num_present_tensors; ++i) {
     const OrtValue& present = last_outputs[t5_decoder_first_present_output_idx + i];
+    if (is_identity) {
+      next_inputs[t5_decoder_first_past_input_idx + i] = present;
+      continue;
+    }
 
     // shape is like (batch_beam_size, 12, past_seq_len, 64)
     const TensorShape& past_shape = present.Get<Tensor>().Shape();
@@ -914,6 +881,8 @@ Status UpdateDecoderFeeds(
   //              past_key_self_0, past_value_self_0, ...
   //              past_key_cross_0, past_value_cross_0, ...
   // Only need copy beam next tokens to input_ids, and copy present_*_self_* to past_*_self_*,
+  // past_*_cross_* are computed by the encoder once and are shared by all beams of a batch, so they are never
+  // reordered.
 
   if (use_sequence_as_input_ids) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
@@ -948,8 +917,8 @@ Status UpdateDecoderFeeds(
     for (int i = 0; i < num_present_tensors; ++i) {
       next_inputs[t5_decoder_first_past_input_idx + i] =
           last_outputs[t5_decoder_first_present_output_idx + i];
-      return Status::OK();
     }
+    return Status::OK();
   }
 
   return PickT5PastState<T>(last_outputs, next_inputs, num_present_tensors, beam_indices, allocator,
@@ -0,0 +1,131 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "contrib_ops/cuda/transformers/paged_kv_cache.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+PagedKVCache::PagedKVCache(int num_blocks, int block_size) : block_size_(block_size) {
+  ORT_ENFORCE(num_blocks > 0 && block_size > 0, "num_blocks and block_size shall be positive");
+  free_blocks_.resize(num_blocks);
+  // blocks are taken from the back, so the lowest ids are used first
+  for (int i = 0; i < num_blocks; i++) {
+    free_blocks_[i] = num_blocks - 1 - i;
+  }
+  ref_counts_.assign(num_blocks, 0);
+}
+
+int PagedKVCache::AddSequence() {
+  const int id = next_sequence_id_++;
+  sequences_.emplace(id, Sequence{});
+  return id;
+}
+
+int PagedKVCache::ForkSequence(int parent) {
+  Sequence child = GetSequence(parent);
+  for (int32_t block : child.blocks) {
+    ++ref_counts_[block];
+  }
+  const int id = next_sequence_id_++;
+  sequences_.emplace(id, std::move(child));
+  return id;
+}
+
+void PagedKVCache::ReleaseSequence(int sequence) {
+  auto it = sequences_.find(sequence);
+  ORT_ENFORCE(it != sequences_.end(), "Unknown sequence ", sequence);
+  for (int32_t block : it->second.blocks) {
+    ReleaseBlock(block);
+  }
+  sequences_.erase(it);
+}
+
+Status PagedKVCache::AppendTokens(int sequence, int count, std::vector<BlockCopy>& copies) {
+  ORT_RETURN_IF(count < 0, "Invalid token count ", count);
+  auto it = sequences_.find(sequence);
+  ORT_RETURN_IF(it == sequences_.end(), "Unknown sequence ", sequence);
+  Sequence& seq = it->second;
+
+  const int new_length = seq.length + count;
+  const int new_blocks = (new_length + block_size_ - 1) / block_size_ - static_cast<int>(seq.blocks.size());
+  // the partially filled last block is written to, so it is copied if it is shared
+  const bool copy_last = count > 0 && seq.length % block_size_ != 0 && ref_counts_[seq.blocks.back()] > 1;
+  ORT_RETURN_IF(new_blocks + (copy_last ? 1 : 0) > NumFreeBlocks(),
+                "The paged KV cache has ", NumFreeBlocks(), " free blocks, ", new_blocks + (copy_last ? 1 : 0),
+                " are needed to append ", count, " tokens");
+
+  if (copy_last) {
+    const int32_t src = seq.blocks.back();
+    const int32_t dst = TakeBlock();
+    ReleaseBlock(src);
+    seq.blocks.back() = dst;
+    copies.push_back({src, dst});
+  }
+  for (int i = 0; i < new_blocks; i++) {
+    seq.blocks.push_back(TakeBlock());
+  }
+  seq.length = new_length;
+  return Status::OK();
+}
+
+void PagedKVCache::ReorderSequences(gsl::span<int> sequences, gsl::span<const int32_t> parents) {
+  ORT_ENFORCE(sequences.size() == parents.size(), "sequences and parents shall have the same size");
+  std::vector<int> reordered(sequences.size());
+  for (size_t i = 0; i < sequences.size(); i++) {
+    ORT_ENFORCE(parents[i] >= 0 && static_cast<size_t>(parents[i]) < sequences.size(), "Invalid parent ", parents[i]);
+    reordered[i] = ForkSequence(sequences[parents[i]]);
+  }
+  for (size_t i = 0; i < sequences.size(); i++) {
+    ReleaseSequence(sequences[i]);
+    sequences[i] = reordered[i];
+  }
+}
+
+int PagedKVCache::SequenceLength(int sequence) const {
+  return GetSequence(sequence).length;
+}
+
+Status PagedKVCache::FillBlockTable(gsl::span<const int> sequences, int max_blocks_per_sequence,
+                                    gsl::span<int32_t> block_table, gsl::span<int32_t> sequence_lengths) const {
+  ORT_RETURN_IF(block_table.size() != sequences.size() * max_blocks_per_sequence ||
+                    sequence_lengths.size() != sequences.size(),
+                "block_table shall have (sequences, max_blocks_per_sequence) entries and sequence_lengths one per sequence");
+  std::fill(block_table.begin(), block_table.end(), 0);
+  for (size_t i = 0; i < sequences.size(); i++) {
+    auto it = sequences_.find(sequences[i]);
+    ORT_RETURN_IF(it == sequences_.end(), "Unknown sequence ", sequences[i]);
+    const auto& blocks = it->second.blocks;
+    ORT_RETURN_IF(static_cast<int>(blocks.size()) > max_blocks_per_sequence,
+                  "Sequence ", sequences[i], " has ", blocks.size(), " blocks, more than ", max_blocks_per_sequence);
+    std::copy(blocks.begin(), blocks.end(), block_table.begin() + i * max_blocks_per_sequence);
+    sequence_lengths[i] = it->second.length;
+  }
+  return Status::OK();
+}
+
+int32_t PagedKVCache::TakeBlock() {
+  const int32_t block = free_blocks_.back();
+  free_blocks_.pop_back();
+  ref_counts_[block] = 1;
+  return block;
+}
+
+void PagedKVCache::ReleaseBlock(int32_t block) {
+  if (--ref_counts_[block] == 0) {
+    free_blocks_.push_back(block);
+  }
+}
+
+const PagedKVCache::Sequence& PagedKVCache::GetSequence(int sequence) const {
+  auto it = sequences_.find(sequence);
+  ORT_ENFORCE(it != sequences_.end(), "Unknown sequence ", sequence);
+  return it->second;
+}
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
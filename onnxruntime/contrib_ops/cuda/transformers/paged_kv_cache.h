@@ -0,0 +1,82 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "core/providers/shared_library/provider_api.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace cuda {
+
+// Bookkeeping of a paged key and value cache, as consumed by DecoderAttention with a cache_block_table input.
+//
+// The cache of all the sequences is one pool of num_blocks blocks of block_size tokens each, and every sequence has
+// a block table that lists the blocks holding its tokens in order. The blocks are taken from the pool as the tokens
+// are appended, so the memory used by a sequence follows its length instead of the maximum length.
+//
+// A forked sequence, e.g. a beam of beam search, shares the blocks of its parent. A shared block is copied before a
+// sequence appends tokens to it (copy on write), the copies to apply to the pool are returned by AppendTokens.
+class PagedKVCache {
+ public:
+  struct BlockCopy {
+    int32_t src;
+    int32_t dst;
+  };
+
+  PagedKVCache(int num_blocks, int block_size);
+
+  int BlockSize() const { return block_size_; }
+  int NumFreeBlocks() const { return static_cast<int>(free_blocks_.size()); }
+
+  // Returns the id of a new empty sequence.
+  int AddSequence();
+
+  // Returns the id of a new sequence that shares the tokens of `parent`.
+  int ForkSequence(int parent);
+
+  // Releases the blocks of the sequence that are not shared with another sequence.
+  void ReleaseSequence(int sequence);
+
+  // Reserves the blocks of `count` more tokens of the sequence. The blocks of shared tokens that the new tokens
+  // are written to are replaced by copies, the copies are appended to `copies` and must be applied to the pool before
+  // the new tokens are written. Fails without changes if the pool does not have enough free blocks.
+  Status AppendTokens(int sequence, int count, std::vector<BlockCopy>& copies);
+
+  // Replaces sequences[i] by a fork of sequences[parents[i]] for all i, then releases the previous sequences.
+  // This is the reordering of the beams after a step of beam search.
+  void ReorderSequences(gsl::span<int> sequences, gsl::span<const int32_t> parents);
+
+  int SequenceLength(int sequence) const;
+
+  // Fills the block table of `sequences`, a (sequences.size(), max_blocks_per_sequence) int32 tensor, and their
+  // lengths. Unused entries of the block table are set to 0.
+  Status FillBlockTable(gsl::span<const int> sequences, int max_blocks_per_sequence,
+                        gsl::span<int32_t> block_table, gsl::span<int32_t> sequence_lengths) const;
+
+ private:
+  struct Sequence {
+    std::vector<int32_t> blocks;
+    int length = 0;
+  };
+
+  int32_t TakeBlock();
+  void ReleaseBlock(int32_t block);
+  const Sequence& GetSequence(int sequence) const;
+
+  const int block_size_;
+  std::vector<int32_t> free_blocks_;
+  std::vector<int> ref_counts_;
+  std::unordered_map<int, Sequence> sequences_;
+  int next_sequence_id_ = 0;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PagedKVCache);
+};
+
+}  // namespace cuda
+}  // namespace contrib
+}  // namespace onnxruntime
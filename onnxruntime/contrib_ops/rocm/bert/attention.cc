@@ -55,6 +55,11 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
                                   nullptr,
                                   device_prop.maxThreadsPerBlock));
 
+  if (rotary_embedding_dim_ != 0 || use_alibi_) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED,
+                           "rotary_embedding_dim and use_alibi are not supported in the ROCm Attention kernel");
+  }
+
   // input shape (batch_size, sequence_length, input_hidden_size)
   const auto& shape = input->Shape();
   int batch_size = static_cast<int>(shape[0]);
@@ -111,6 +116,8 @@ Status Attention<T>::ComputeInternal(OpKernelContext* context) const {
   auto work_space = GetScratchBuffer<void>(workSpaceSize, context->GetComputeStream());
   return LaunchAttentionKernel(
       device_prop,
+      IsTunableOpEnabled(),
+      GetTuningResults(),
       Stream(context),
       rocblas,
       element_size,
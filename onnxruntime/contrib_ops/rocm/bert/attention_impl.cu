@@ -27,6 +27,7 @@ limitations under the License.
 #include "core/providers/rocm/shared_inc/fpgeneric.h"
 #include "contrib_ops/rocm/bert/attention_impl.h"
 #include "contrib_ops/rocm/bert/attention_softmax.h"
+#include "contrib_ops/rocm/bert/attention_softmax_tunable_op.h"
 #include "contrib_ops/rocm/bert/transformer_common.h"
 
 using namespace onnxruntime::rocm;
@@ -66,9 +67,28 @@ size_t GetAttentionWorkspaceSize(
                                                 sequence_length, past_sequence_length + sequence_length);
 }
 
+namespace {
+
+template <typename TunableOpT, typename ParamsT>
+Status RunTunableOp(bool tuning, const ParamsT* params) {
+  // TunableOp keeps the results of its own tuning unsynchronized, so there is one op per thread. The threads share
+  // their results through params->tuning_results.
+  thread_local static TunableOpT op{};
+  if (tuning) {
+    op.EnableTuning();
+  } else {
+    op.DisableTuning();
+  }
+  return op(params);
+}
+
+}  // namespace
+
 template <typename T>
 Status QkvToContext(
     const hipDeviceProp_t& prop,
+    bool tuning,
+    onnxruntime::rocm::tunable::TuningResults* tuning_results,
     rocblas_handle& rocblas,
     hipStream_t stream,
     const int batch_size,
@@ -168,6 +188,10 @@ Status QkvToContext(
     const int* mask_start = (mask_index_dims[0] > batch_size) ? mask_index + batch_size : nullptr;
     ORT_RETURN_IF_ERROR(ComputeSoftmaxWithMask1D<T>(stream, all_sequence_length, sequence_length, batch_size, num_heads,
                                      mask_index, mask_start, extra_add_qk, scratch1, scratch2, is_unidirectional));
+  } else if (tuning || tuning_results != nullptr) {  // no mask
+    AttentionSoftmaxParams<T> params(stream, tuning_results, all_sequence_length, sequence_length, batch_size,
+                                     num_heads, extra_add_qk, scratch1, scratch2, is_unidirectional);
+    ORT_RETURN_IF_ERROR((RunTunableOp<AttentionSoftmaxTunableOp<T>>(tuning, &params)));
   } else {  // no mask
     ORT_RETURN_IF_ERROR(ComputeSoftmax<T>(stream, all_sequence_length, sequence_length, batch_size, num_heads,
                            extra_add_qk, scratch1, scratch2, is_unidirectional));
@@ -188,6 +212,8 @@ Status QkvToContext(
 
 Status LaunchAttentionKernel(
     const hipDeviceProp_t& prop,
+    bool tuning,
+    onnxruntime::rocm::tunable::TuningResults* tuning_results,
     hipStream_t stream,
     rocblas_handle& rocblas,
     const size_t element_size,
@@ -210,7 +236,7 @@ Status LaunchAttentionKernel(
   bool use_persistent_softmax = options->IsPrecisionMode() && !options->DisablePersistentSoftmax();
   if (element_size == 2) {
     return QkvToContext(
-        prop, rocblas, stream, batch_size, sequence_length, num_heads, head_size, element_size,
+        prop, tuning, tuning_results, rocblas, stream, batch_size, sequence_length, num_heads, head_size, element_size,
         reinterpret_cast<const __half*>(input),
         reinterpret_cast<__half*>(output),
         reinterpret_cast<__half*>(workspace),
@@ -224,7 +250,7 @@ Status LaunchAttentionKernel(
         use_persistent_softmax);
   } else {
     return QkvToContext(
-        prop, rocblas, stream, batch_size, sequence_length, num_heads, head_size, element_size,
+        prop, tuning, tuning_results, rocblas, stream, batch_size, sequence_length, num_heads, head_size, element_size,
         reinterpret_cast<const float*>(input),
         reinterpret_cast<float*>(output),
         reinterpret_cast<float*>(workspace),
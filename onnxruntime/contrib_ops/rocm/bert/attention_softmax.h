@@ -284,6 +284,83 @@ __global__ void SoftmaxKernel(const int all_sequence_length, const int sequence_
                   add_before_softmax, input, output);
 }
 
+template <typename T, int VecSize>
+__device__ inline void LoadSoftmaxInputVec(const T* add_before_softmax, const T* input, const int index,
+                                           float (&values)[VecSize]) {
+  using VecT = aligned_vector<T, VecSize>;
+  T input_v[VecSize];
+  *reinterpret_cast<VecT*>(&input_v) = *reinterpret_cast<const VecT*>(&input[index]);
+  if (add_before_softmax == nullptr) {
+#pragma unroll
+    for (int k = 0; k < VecSize; k++) {
+      values[k] = static_cast<float>(input_v[k]);
+    }
+  } else {
+    T add_v[VecSize];
+    *reinterpret_cast<VecT*>(&add_v) = *reinterpret_cast<const VecT*>(&add_before_softmax[index]);
+#pragma unroll
+    for (int k = 0; k < VecSize; k++) {
+      values[k] = static_cast<float>(input_v[k] + add_v[k]);
+    }
+  }
+}
+
+// Same as SoftmaxKernel, but every thread loads and stores VecSize consecutive elements at once.
+// all_sequence_length must be divisible by VecSize.
+template <typename T, unsigned TPB, int VecSize>
+__global__ void SoftmaxKernelVec(const int all_sequence_length, const T* add_before_softmax, const T* input,
+                                 T* output) {
+  using VecT = aligned_vector<T, VecSize>;
+  using BlockReduce = hipcub::BlockReduce<float, TPB>;
+  __shared__ typename BlockReduce::TempStorage tmp_storage;
+
+  __shared__ float sum_reverse_block;
+  __shared__ float max_block;
+
+  const int offset = (blockIdx.y * gridDim.x + blockIdx.x) * all_sequence_length;
+  float values[VecSize];
+
+  float thread_data_max(-ROCMRT_INF_F);
+  for (int i = threadIdx.x * VecSize; i < all_sequence_length; i += TPB * VecSize) {
+    LoadSoftmaxInputVec<T, VecSize>(add_before_softmax, input, offset + i, values);
+#pragma unroll
+    for (int k = 0; k < VecSize; k++) {
+      thread_data_max = fmaxf(thread_data_max, values[k]);
+    }
+  }
+
+  const auto max_value = BlockReduce(tmp_storage).Reduce(thread_data_max, hipcub::Max());
+  if (threadIdx.x == 0) {
+    max_block = max_value;
+  }
+  __syncthreads();
+
+  float thread_data_sum(0.f);
+  for (int i = threadIdx.x * VecSize; i < all_sequence_length; i += TPB * VecSize) {
+    LoadSoftmaxInputVec<T, VecSize>(add_before_softmax, input, offset + i, values);
+#pragma unroll
+    for (int k = 0; k < VecSize; k++) {
+      thread_data_sum += expf(values[k] - max_block);
+    }
+  }
+
+  const auto sum = BlockReduce(tmp_storage).Reduce(thread_data_sum, hipcub::Sum());
+  if (threadIdx.x == 0) {
+    sum_reverse_block = 1.f / sum;
+  }
+  __syncthreads();
+
+  for (int i = threadIdx.x * VecSize; i < all_sequence_length; i += TPB * VecSize) {
+    LoadSoftmaxInputVec<T, VecSize>(add_before_softmax, input, offset + i, values);
+    T output_v[VecSize];
+#pragma unroll
+    for (int k = 0; k < VecSize; k++) {
+      output_v[k] = T(expf(values[k] - max_block) * sum_reverse_block);
+    }
+    *reinterpret_cast<VecT*>(&output[offset + i]) = *reinterpret_cast<VecT*>(&output_v[0]);
+  }
+}
+
 template <typename T>
 Status ComputeSoftmax(
     hipStream_t stream,
@@ -0,0 +1,109 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <hip/hip_runtime.h>
+#include <cstdint>
+#include <string>
+
+#include "contrib_ops/rocm/bert/attention_softmax.h"
+#include "core/providers/rocm/cu_inc/common.cuh"
+#include "core/providers/rocm/tunable/rocm_tunable.h"
+
+namespace onnxruntime {
+namespace contrib {
+namespace rocm {
+
+// Softmax of the BxNxSxS* attention scores without mask.
+template <typename T>
+struct AttentionSoftmaxParams : onnxruntime::rocm::tunable::OpParams {
+  AttentionSoftmaxParams(hipStream_t stream, onnxruntime::rocm::tunable::TuningResults* tuning_results,
+                         int all_sequence_length, int sequence_length, int batch_size, int num_heads,
+                         const T* add_before_softmax, const T* input, T* output, bool is_unidirectional)
+      : OpParams(stream), tuning_results(tuning_results), all_sequence_length(all_sequence_length),
+        sequence_length(sequence_length), batch_size(batch_size), num_heads(num_heads),
+        add_before_softmax(add_before_softmax), input(input), output(output), is_unidirectional(is_unidirectional) {}
+
+  std::string Signature() const override {
+    return MakeString(all_sequence_length, "_", sequence_length, "_", batch_size, "_", num_heads,
+                      add_before_softmax == nullptr ? "" : "_add", is_unidirectional ? "_unidir" : "");
+  }
+
+  onnxruntime::rocm::tunable::TuningResults* GetTuningResults() const override { return tuning_results; }
+
+  onnxruntime::rocm::tunable::TuningResults* tuning_results;
+  int all_sequence_length;
+  int sequence_length;
+  int batch_size;
+  int num_heads;
+  const T* add_before_softmax;
+  const T* input;
+  T* output;
+  bool is_unidirectional;
+};
+
+template <typename T>
+Status AttentionSoftmaxStaticSelection(const AttentionSoftmaxParams<T>* params) {
+  return ComputeSoftmax<T>(params->stream, params->all_sequence_length, params->sequence_length,
+                           params->batch_size, params->num_heads, params->add_before_softmax,
+                           params->input, params->output, params->is_unidirectional);
+}
+
+template <typename T, unsigned ThreadsPerBlock>
+Status AttentionSoftmaxBlockOp(const AttentionSoftmaxParams<T>* params) {
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(params->is_unidirectional);
+  const dim3 grid(params->sequence_length * params->num_heads, params->batch_size, 1);
+  hipLaunchKernelGGL(HIP_KERNEL_NAME(SoftmaxKernel<T, ThreadsPerBlock>), grid, ThreadsPerBlock, 0, params->stream,
+                     params->all_sequence_length, params->sequence_length, params->add_before_softmax,
+                     params->input, params->output);
+  return HIP_CALL(hipGetLastError());
+}
+
+template <typename T, unsigned ThreadsPerBlock, int VecSize>
+Status AttentionSoftmaxVecOp(const AttentionSoftmaxParams<T>* params) {
+  constexpr uintptr_t vec_bytes = sizeof(T) * VecSize;
+  TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(
+      params->is_unidirectional || params->all_sequence_length % VecSize != 0 ||
+      reinterpret_cast<uintptr_t>(params->input) % vec_bytes != 0 ||
+      reinterpret_cast<uintptr_t>(params->output) % vec_bytes != 0 ||
+      reinterpret_cast<uintptr_t>(params->add_before_softmax) % vec_bytes != 0);
+  const dim3 grid(params->sequence_length * params->num_heads, params->batch_size, 1);
+  hipLaunchKernelGGL(HIP_KERNEL_NAME(SoftmaxKernelVec<T, ThreadsPerBlock, VecSize>), grid, ThreadsPerBlock, 0,
+                     params->stream, params->all_sequence_length, params->add_before_softmax,
+                     params->input, params->output);
+  return HIP_CALL(hipGetLastError());
+}
+
+#define ADD_OP_FOR_ALL_VEC_SIZE(name, threads_per_block)  \
+  this->ops_.emplace_back(name<T, threads_per_block, 2>); \
+  this->ops_.emplace_back(name<T, threads_per_block, 4>); \
+  this->ops_.emplace_back(name<T, threads_per_block, 8>);
+
+template <typename T>
+class AttentionSoftmaxTunableOp
+    : public onnxruntime::rocm::tunable::TunableOp<AttentionSoftmaxParams<T>> {
+ public:
+  AttentionSoftmaxTunableOp() {
+    this->ops_.emplace_back(AttentionSoftmaxStaticSelection<T>);
+    this->ops_.emplace_back(AttentionSoftmaxBlockOp<T, 64>);
+    this->ops_.emplace_back(AttentionSoftmaxBlockOp<T, 128>);
+    this->ops_.emplace_back(AttentionSoftmaxBlockOp<T, 256>);
+    this->ops_.emplace_back(AttentionSoftmaxBlockOp<T, 512>);
+    this->ops_.emplace_back(AttentionSoftmaxBlockOp<T, 1024>);
+    ADD_OP_FOR_ALL_VEC_SIZE(AttentionSoftmaxVecOp, 64)
+    ADD_OP_FOR_ALL_VEC_SIZE(AttentionSoftmaxVecOp, 128)
+    ADD_OP_FOR_ALL_VEC_SIZE(AttentionSoftmaxVecOp, 256)
+    ADD_OP_FOR_ALL_VEC_SIZE(AttentionSoftmaxVecOp, 512)
+    ADD_OP_FOR_ALL_VEC_SIZE(AttentionSoftmaxVecOp, 1024)
+
+    // NOTE: the 1st kernel is the original launch configuration of ComputeSoftmax.
+    this->SetDefaultId(0);
+  }
+};
+
+#undef ADD_OP_FOR_ALL_VEC_SIZE
+
+}  // namespace rocm
+}  // namespace contrib
+}  // namespace onnxruntime
@@ -21,6 +21,9 @@
 #ifndef HWCAP_ASIMDDP
 #define HWCAP_ASIMDDP (1 << 20)
 #endif
+#ifndef HWCAP2_I8MM
+#define HWCAP2_I8MM (1 << 13)
+#endif
 
 #endif // ARM
 
@@ -166,6 +169,10 @@ void CPUIDInfo::ArmLinuxInit() {
   } else {
     has_arm_neon_dot_ = ((getauxval(AT_HWCAP) & HWCAP_ASIMDDP) != 0);
   }
+
+  // Older versions of cpuinfo do not report the int8 matrix multiply
+  // extension, so query the kernel directly.
+  has_arm_neon_i8mm_ = ((getauxval(AT_HWCAP2) & HWCAP2_I8MM) != 0);
 }
 
 #elif defined(_WIN32)
@@ -28,6 +28,7 @@ class CPUIDInfo {
 
   // ARM
   bool HasArmNeonDot() const { return has_arm_neon_dot_; }
+  bool HasArmNeon_I8MM() const { return has_arm_neon_i8mm_; }
 
   uint32_t GetCurrentCoreIdx() const;
 
@@ -118,6 +119,7 @@ class CPUIDInfo {
   std::vector<bool> is_armv8_narrow_ld_;
 
   bool has_arm_neon_dot_{false};
+  bool has_arm_neon_i8mm_{false};
 
 #ifdef CPUIDINFO_ARCH_X86
 
@@ -0,0 +1,173 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/logging/sinks/async_sink.h"
+
+#include <chrono>
+#include <sstream>
+
+namespace onnxruntime {
+namespace logging {
+
+namespace {
+size_t RoundUpToPowerOf2(size_t value) {
+  size_t result = 2;
+  while (result < value) {
+    result <<= 1;
+  }
+  return result;
+}
+
+// The producer only notifies the writer when it is waiting, so a wakeup racing with the writer going to sleep can
+// be missed. The wait is bounded to pick up such messages.
+constexpr std::chrono::milliseconds kWriterWaitTimeout{10};
+}  // namespace
+
+AsyncSink::AsyncSink(std::unique_ptr<ISink> sink, size_t capacity)
+    : sink_{std::move(sink)},
+      slots_(RoundUpToPowerOf2(capacity)),
+      mask_{slots_.size() - 1} {
+  ORT_ENFORCE(sink_ != nullptr, "AsyncSink requires a sink to write to");
+  for (size_t i = 0; i < slots_.size(); ++i) {
+    slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  writer_ = std::thread([this]() { WriterLoop(); });
+}
+
+AsyncSink::~AsyncSink() {
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    stop_.store(true, std::memory_order_release);
+  }
+  cv_.notify_one();
+  writer_.join();
+}
+
+void AsyncSink::SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) {
+  if (message.Severity() == Severity::kFATAL) {
+    // keep the ordering with the messages already buffered and make sure this one is out before we return
+    Flush();
+    sink_->Send(timestamp, logger_id, message);
+    return;
+  }
+
+  if (!TryPush(timestamp, logger_id, message)) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  if (writer_waiting_.load(std::memory_order_seq_cst)) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    cv_.notify_one();
+  }
+}
+
+bool AsyncSink::TryPush(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) {
+  Slot* slot = nullptr;
+  size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+  for (;;) {
+    slot = &slots_[pos & mask_];
+    const size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(pos);
+    if (diff == 0) {
+      if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (diff < 0) {
+      // the writer has not released this slot yet, the buffer is full
+      return false;
+    } else {
+      pos = enqueue_pos_.load(std::memory_order_relaxed);
+    }
+  }
+
+  // assign into the existing strings so that their capacity is reused once the buffer has wrapped around
+  Entry& entry = slot->entry;
+  const CodeLocation& location = message.Location();
+  entry.timestamp = timestamp;
+  entry.logger_id.assign(logger_id);
+  entry.severity = message.Severity();
+  entry.category = message.Category();
+  entry.data_type = message.DataType();
+  entry.file.assign(location.file_and_path);
+  entry.line = location.line_num;
+  entry.function.assign(location.function);
+  entry.message.assign(message.Message());
+
+  slot->sequence.store(pos + 1, std::memory_order_seq_cst);
+  return true;
+}
+
+bool AsyncSink::TryWriteOne() {
+  const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+  Slot& slot = slots_[pos & mask_];
+  if (slot.sequence.load(std::memory_order_acquire) != pos + 1) {
+    return false;
+  }
+
+  const Entry& entry = slot.entry;
+  {
+    Capture capture(entry.severity, entry.category, entry.data_type,
+                    CodeLocation(entry.file.c_str(), entry.line, entry.function.c_str()));
+    capture.Stream() << entry.message;
+    sink_->Send(entry.timestamp, entry.logger_id, capture);
+  }
+
+  slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+  dequeue_pos_.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+void AsyncSink::ReportDropped() {
+  const size_t dropped = dropped_.load(std::memory_order_relaxed);
+  if (dropped == reported_dropped_) {
+    return;
+  }
+
+  Capture capture(Severity::kWARNING, Category::onnxruntime, DataType::SYSTEM, ORT_WHERE);
+  capture.Stream() << "Dropped " << dropped - reported_dropped_
+                   << " log messages as the asynchronous log buffer was full. Total dropped: " << dropped;
+  sink_->Send(std::chrono::system_clock::now(), "AsyncSink", capture);
+  reported_dropped_ = dropped;
+}
+
+void AsyncSink::WriterLoop() {
+  for (;;) {
+    if (TryWriteOne()) {
+      continue;
+    }
+
+    ReportDropped();
+
+    std::unique_lock<OrtMutex> lock(mutex_);
+    writer_waiting_.store(true, std::memory_order_seq_cst);
+    const size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    const bool empty = slots_[pos & mask_].sequence.load(std::memory_order_seq_cst) != pos + 1;
+    if (empty) {
+      // stop_ is only set under the lock, so checking it here cannot miss the final notification
+      if (stop_.load(std::memory_order_acquire)) {
+        writer_waiting_.store(false, std::memory_order_relaxed);
+        break;
+      }
+      cv_.wait_for(lock, kWriterWaitTimeout);
+    }
+    writer_waiting_.store(false, std::memory_order_relaxed);
+  }
+}
+
+void AsyncSink::Flush() {
+  const size_t target = enqueue_pos_.load(std::memory_order_acquire);
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    cv_.notify_one();
+  }
+
+  // a message that was claimed but not yet published holds back the writer, so this also waits for it
+  while (dequeue_pos_.load(std::memory_order_acquire) < target) {
+    std::this_thread::yield();
+  }
+}
+
+}  // namespace logging
+}  // namespace onnxruntime
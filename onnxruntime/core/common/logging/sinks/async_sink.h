@@ -0,0 +1,101 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/common/logging/capture.h"
+#include "core/common/logging/isink.h"
+#include "core/common/logging/logging.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace logging {
+/// <summary>
+/// ISink that hands messages to a background thread which writes them to another sink.
+/// The calling thread only copies the message into a bounded lock-free ring buffer, so logging on hot paths
+/// (e.g. per node VERBOSE output from the executors) does not wait on the output stream.
+/// If the buffer is full the message is dropped and counted; the writer thread reports the number of dropped
+/// messages through the wrapped sink.
+/// kFATAL messages are written before Send returns as the process is expected to go down after them.
+/// </summary>
+/// <seealso cref="ISink" />
+class AsyncSink : public ISink {
+ public:
+  static constexpr size_t kDefaultCapacity = 8192;
+
+  /// <summary>
+  /// Initializes a new instance of the <see cref="AsyncSink"/> class.
+  /// </summary>
+  /// <param name="sink">The sink the background thread writes to.</param>
+  /// <param name="capacity">Number of messages that can be buffered. Rounded up to a power of 2.</param>
+  explicit AsyncSink(std::unique_ptr<ISink> sink, size_t capacity = kDefaultCapacity);
+
+  /// <summary>
+  /// Writes all buffered messages and stops the background thread.
+  /// </summary>
+  ~AsyncSink() override;
+
+  /// <summary>
+  /// Blocks until every message sent before the call has been written to the wrapped sink.
+  /// </summary>
+  void Flush();
+
+  /// <summary>
+  /// Number of messages dropped so far because the buffer was full.
+  /// </summary>
+  size_t DroppedMessageCount() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+  void SendProfileEvent(profiling::EventRecord& event_record) const override {
+    sink_->SendProfileEvent(event_record);
+  }
+
+ private:
+  struct Entry {
+    Timestamp timestamp;
+    std::string logger_id;
+    Severity severity;
+    const char* category;
+    DataType data_type;
+    std::string file;
+    int line;
+    std::string function;
+    std::string message;
+  };
+
+  // Bounded multi-producer ring buffer (D. Vyukov). A slot is free for the producer at position p when its
+  // sequence equals p, and holds a message for the consumer at position p when its sequence equals p + 1.
+  struct Slot {
+    std::atomic<size_t> sequence;
+    Entry entry;
+  };
+
+  void SendImpl(const Timestamp& timestamp, const std::string& logger_id, const Capture& message) override;
+
+  bool TryPush(const Timestamp& timestamp, const std::string& logger_id, const Capture& message);
+  bool TryWriteOne();
+  void ReportDropped();
+  void WriterLoop();
+
+  std::unique_ptr<ISink> sink_;
+  std::vector<Slot> slots_;
+  const size_t mask_;
+
+  std::atomic<size_t> enqueue_pos_{0};
+  std::atomic<size_t> dequeue_pos_{0};
+  std::atomic<size_t> dropped_{0};
+  size_t reported_dropped_{0};
+
+  std::atomic<bool> writer_waiting_{false};
+  std::atomic<bool> stop_{false};
+  OrtMutex mutex_;
+  OrtCondVar cv_;
+  std::thread writer_;
+};
+}  // namespace logging
+}  // namespace onnxruntime
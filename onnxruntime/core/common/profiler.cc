@@ -60,6 +60,11 @@ void Profiler::StartProfiling(const std::basic_string<T>& file_name) {
   profile_stream_.open(file_name, std::ios::out | std::ios::trunc);
 #endif
   profile_stream_file_ = ToUTF8String(file_name);
+  num_written_events_ = 0;
+  streaming_ = streaming_batch_size_ > 0;
+  if (streaming_) {
+    profile_stream_ << "[\n";
+  }
   profiling_start_time_ = std::chrono::high_resolution_clock::now();
   for (const auto& ep_profiler : ep_profilers_) {
     ep_profiler->StartProfiling(profiling_start_time_);
@@ -79,27 +84,92 @@ void Profiler::EndTimeAndRecordEvent(EventCategory category,
   long long dur = TimeDiffMicroSeconds(start_time);
   long long ts = TimeDiffMicroSeconds(profiling_start_time_, start_time);
 
-  EventRecord event(category, logging::GetProcessId(),
-                    logging::GetThreadId(), event_name, ts, dur, {event_args.begin(), event_args.end()});
+  // the ep profilers are stopped first so that the numbers they captured can be added to the event when it is
+  // streamed
+  for (const auto& ep_profiler : ep_profilers_) {
+    ep_profiler->Stop(ts);
+  }
+
+  //TODO: sync_gpu if needed.
+  RecordEventRecord(EventRecord(category, logging::GetProcessId(), logging::GetThreadId(), event_name, ts, dur,
+                                {event_args.begin(), event_args.end()}));
+}
+
+void Profiler::RecordEvent(EventCategory category,
+                           const std::string& event_name,
+                           int thread_id,
+                           const TimePoint& start_time,
+                           const TimePoint& end_time,
+                           const std::initializer_list<std::pair<std::string, std::string>>& event_args) {
+  RecordEventRecord(EventRecord(category, logging::GetProcessId(), thread_id, event_name,
+                                TimeDiffMicroSeconds(profiling_start_time_, start_time),
+                                TimeDiffMicroSeconds(start_time, end_time), {event_args.begin(), event_args.end()}));
+}
+
+void Profiler::RecordCounter(const std::string& counter_name, const std::string& series_name, int64_t value) {
+  auto ts = TimeDiffMicroSeconds(profiling_start_time_, std::chrono::high_resolution_clock::now());
+  RecordEventRecord(EventRecord(COUNTER_EVENT, logging::GetProcessId(), logging::GetThreadId(), counter_name, ts, 0,
+                                {{series_name, std::to_string(value)}}));
+}
+
+void Profiler::RecordEventRecord(EventRecord&& event) {
   if (profile_with_logger_) {
     custom_logger_->SendProfileEvent(event);
-  } else {
-    //TODO: sync_gpu if needed.
-    std::lock_guard<OrtMutex> lock(mutex_);
-    if (events_.size() < max_num_events_) {
-      events_.emplace_back(std::move(event));
-    } else {
-      if (session_logger_ && !max_events_reached) {
-        LOGS(*session_logger_, ERROR)
-            << "Maximum number of events reached, could not record profile event.";
-        max_events_reached = true;
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  if (streaming_) {
+    events_.emplace_back(std::move(event));
+    if (events_.size() >= streaming_batch_size_) {
+      for (const auto& ep_profiler : ep_profilers_) {
+        ep_profiler->Flush(profiling_start_time_, events_);
       }
+      WriteEvents();
+    }
+  } else if (events_.size() < max_num_events_) {
+    events_.emplace_back(std::move(event));
+  } else {
+    if (session_logger_ && !max_events_reached) {
+      LOGS(*session_logger_, ERROR)
+          << "Maximum number of events reached, could not record profile event.";
+      max_events_reached = true;
     }
   }
+}
 
-  for (const auto& ep_profiler : ep_profilers_) {
-    ep_profiler->Stop(ts);
+void Profiler::WriteEvents() {
+  for (const auto& rec : events_) {
+    if (num_written_events_++ > 0) {
+      profile_stream_ << ",\n";
+    }
+    // counters have no duration and numeric values, their series are displayed as a counter track
+    const bool is_counter = rec.cat == COUNTER_EVENT;
+    profile_stream_ << R"({"cat" : ")" << event_category_names_[rec.cat] << "\",";
+    profile_stream_ << "\"pid\" :" << rec.pid << ",";
+    profile_stream_ << "\"tid\" :" << rec.tid << ",";
+    if (!is_counter) {
+      profile_stream_ << "\"dur\" :" << rec.dur << ",";
+    }
+    profile_stream_ << "\"ts\" :" << rec.ts << ",";
+    profile_stream_ << (is_counter ? R"("ph" : "C",)" : R"("ph" : "X",)");
+    profile_stream_ << R"("name" :")" << rec.name << "\",";
+    profile_stream_ << "\"args\" : {";
+    bool is_first_arg = true;
+    for (const std::pair<const std::string, std::string>& event_arg : rec.args) {
+      if (!is_first_arg) profile_stream_ << ",";
+      if (is_counter ||
+          (!event_arg.second.empty() && (event_arg.second[0] == '{' || event_arg.second[0] == '['))) {
+        profile_stream_ << "\"" << event_arg.first << "\" : " << event_arg.second << "";
+      } else {
+        profile_stream_ << "\"" << event_arg.first << "\" : \"" << event_arg.second << "\"";
+      }
+      is_first_arg = false;
+    }
+    profile_stream_ << "}}";
   }
+  profile_stream_.flush();
+  events_.clear();
 }
 
 std::string Profiler::EndProfiling() {
@@ -116,44 +186,21 @@ std::string Profiler::EndProfiling() {
   }
 
   std::lock_guard<OrtMutex> lock(mutex_);
-  profile_stream_ << "[\n";
+  if (!streaming_) {
+    profile_stream_ << "[\n";
+  }
 
   for (const auto& ep_profiler : ep_profilers_) {
     ep_profiler->EndProfiling(profiling_start_time_, events_);
   }
 
-  for (size_t i = 0; i < events_.size(); ++i) {
-    auto& rec = events_[i];
-    profile_stream_ << R"({"cat" : ")" << event_category_names_[rec.cat] << "\",";
-    profile_stream_ << "\"pid\" :" << rec.pid << ",";
-    profile_stream_ << "\"tid\" :" << rec.tid << ",";
-    profile_stream_ << "\"dur\" :" << rec.dur << ",";
-    profile_stream_ << "\"ts\" :" << rec.ts << ",";
-    profile_stream_ << R"("ph" : "X",)";
-    profile_stream_ << R"("name" :")" << rec.name << "\",";
-    profile_stream_ << "\"args\" : {";
-    bool is_first_arg = true;
-    for (std::pair<std::string, std::string> event_arg : rec.args) {
-      if (!is_first_arg) profile_stream_ << ",";
-      if (!event_arg.second.empty() && (event_arg.second[0] == '{' || event_arg.second[0] == '[')) {
-        profile_stream_ << "\"" << event_arg.first << "\" : " << event_arg.second << "";
-      } else {
-        profile_stream_ << "\"" << event_arg.first << "\" : \"" << event_arg.second << "\"";
-      }
-      is_first_arg = false;
-    }
-    profile_stream_ << "}";
-    if (i == events_.size() - 1) {
-      profile_stream_ << "}\n";
-    } else {
-      profile_stream_ << "},\n";
-    }
-  }
-  profile_stream_ << "]\n";
+  WriteEvents();
+  profile_stream_ << (num_written_events_ > 0 ? "\n]\n" : "]\n");
 #if !defined(__wasm__)
   profile_stream_.close();
 #endif
   enabled_ = false;  // will not collect profile after writing.
+  streaming_ = false;
   return profile_stream_file_;
 }
 
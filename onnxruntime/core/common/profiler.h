@@ -7,10 +7,12 @@
 #include <fstream>
 #include <initializer_list>
 #include <iostream>
+#include <memory>
 #include <tuple>
 
 #include "core/common/profiler_common.h"
 #include "core/common/logging/logging.h"
+#include "core/common/sampling_profiler.h"
 #include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
@@ -80,6 +82,43 @@ class Profiler {
                              const std::initializer_list<std::pair<std::string, std::string>>& event_args = {},
                              bool sync_gpu = false);
 
+  /*
+  Record a complete event of the given thread, e.g. the run of a task on a thread pool worker.
+  */
+  void RecordEvent(EventCategory category,
+                   const std::string& event_name,
+                   int thread_id,
+                   const TimePoint& start_time,
+                   const TimePoint& end_time,
+                   const std::initializer_list<std::pair<std::string, std::string>>& event_args = {});
+
+  /*
+  Record the current value of a counter, e.g. the bytes in use of an allocator.
+  The values of a counter are displayed as a counter track by the trace viewers.
+  */
+  void RecordCounter(const std::string& counter_name, const std::string& series_name, int64_t value);
+
+  /*
+  Write the recorded events to the profile file whenever batch_size events are buffered instead of only in
+  EndProfiling, so that long runs can be traced without being limited by the maximum event count.
+  0 disables the streaming. Must be called before the profiling starts.
+  */
+  void SetStreamingBatchSize(size_t batch_size) {
+    streaming_batch_size_ = batch_size;
+  }
+
+  /*
+  Whether the runs of the thread pool workers and the bytes in use of the arenas are recorded in addition to
+  the node events, to show the scheduling gaps and memory spikes on the same timeline.
+  */
+  bool IsTimelineTracksEnabled() const {
+    return timeline_tracks_enabled_;
+  }
+
+  void EnableTimelineTracks(bool enable) {
+    timeline_tracks_enabled_ = enable;
+  }
+
   /*
   Write profile data to the given stream in chrome format defined below.
   https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU/preview#
@@ -110,6 +149,20 @@ class Profiler {
     global_max_num_events_.store(new_max_num_events);
   }
 
+  /*
+  Start timing the nodes of a sample of the runs, independently of the profiling above. See SamplingProfiler.
+  */
+  void StartSampling(SamplingOptions options) {
+    sampling_profiler_ = std::make_unique<SamplingProfiler>(std::move(options));
+  }
+
+  /*
+  Returns the sampling profiler, nullptr if sampling was not started.
+  */
+  SamplingProfiler* GetSamplingProfiler() const {
+    return sampling_profiler_.get();
+  }
+
   void AddEpProfilers(std::unique_ptr<EpProfiler> ep_profiler) {
     if (ep_profiler) {
       ep_profilers_.push_back(std::move(ep_profiler));
@@ -122,6 +175,11 @@ class Profiler {
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Profiler);
 
+  void RecordEventRecord(EventRecord&& event);
+
+  // Requires mutex_ to be held.
+  void WriteEvents();
+
   /**
    * The maximum number of profiler records to collect.
    * This value is used to initialize the per-profiler maximum.
@@ -150,12 +208,17 @@ class Profiler {
   bool max_events_reached{false};
   bool profile_with_logger_{false};
   const size_t max_num_events_{global_max_num_events_.load()};
+  size_t streaming_batch_size_{0};
+  bool streaming_{false};
+  bool timeline_tracks_enabled_{false};
+  size_t num_written_events_{0};
 
 #ifdef ENABLE_STATIC_PROFILER_INSTANCE
   static Profiler* instance_;
 #endif
 
   std::vector<std::unique_ptr<EpProfiler>> ep_profilers_;
+  std::unique_ptr<SamplingProfiler> sampling_profiler_;
 };
 
 }  // namespace profiling
@@ -0,0 +1,178 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/sampling_profiler.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+std::atomic<uint64_t> next_sampling_profiler_id{1};
+
+// the buffer of the calling thread for the SamplingProfiler that used it last
+struct ThreadBufferCache {
+  uint64_t profiler_id = 0;
+  void* buffer = nullptr;
+};
+thread_local ThreadBufferCache thread_buffer_cache;
+}  // namespace
+
+size_t NodeLatencyStats::GetBucket(uint64_t latency_ns) {
+  size_t bucket = 0;
+  while (latency_ns > 1 && bucket < kNumBuckets - 1) {
+    latency_ns >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+uint64_t NodeLatencyStats::GetPercentileUpperBoundNs(double percentile) const {
+  if (count == 0) {
+    return 0;
+  }
+
+  const auto rank = static_cast<uint64_t>(std::clamp(percentile, 0.0, 100.0) / 100.0 * static_cast<double>(count));
+  uint64_t num_latencies = 0;
+  for (size_t bucket = 0; bucket < kNumBuckets - 1; ++bucket) {
+    num_latencies += buckets[bucket];
+    if (num_latencies > rank || num_latencies == count) {
+      return std::min(max_ns, (uint64_t{1} << (bucket + 1)) - 1);
+    }
+  }
+  return max_ns;
+}
+
+// Single producer (the owning thread), single consumer (the thread holding SamplingProfiler::mutex_) ring buffer.
+struct SamplingProfiler::ThreadBuffer {
+  static constexpr size_t kCapacity = 4096;
+
+  struct Sample {
+    const std::string* node_name;
+    const std::string* op_type;
+    size_t node_index;
+    uint64_t latency_ns;
+  };
+
+  std::array<Sample, kCapacity> samples;
+  std::atomic<size_t> head{0};  // next sample to write
+  std::atomic<size_t> tail{0};  // next sample to aggregate
+};
+
+SamplingProfiler::SamplingProfiler(SamplingOptions options)
+    : options_(std::move(options)),
+      id_(next_sampling_profiler_id.fetch_add(1)),
+      last_export_time_(std::chrono::steady_clock::now()) {
+  ORT_ENFORCE(options_.sample_every_n > 0, "sample_every_n must be positive.");
+}
+
+SamplingProfiler::~SamplingProfiler() = default;
+
+SamplingProfiler::ThreadBuffer& SamplingProfiler::GetThreadBuffer() {
+  if (thread_buffer_cache.profiler_id == id_) {
+    return *static_cast<ThreadBuffer*>(thread_buffer_cache.buffer);
+  }
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& buffer = thread_buffers_[std::this_thread::get_id()];
+  if (buffer == nullptr) {
+    buffer = std::make_unique<ThreadBuffer>();
+  }
+  thread_buffer_cache = {id_, buffer.get()};
+  return *buffer;
+}
+
+void SamplingProfiler::RecordNodeLatency(const std::string& node_name, const std::string& op_type,
+                                         size_t node_index, std::chrono::nanoseconds latency) noexcept {
+  ThreadBuffer& buffer = GetThreadBuffer();
+  const size_t head = buffer.head.load(std::memory_order_relaxed);
+  if (head - buffer.tail.load(std::memory_order_acquire) == ThreadBuffer::kCapacity) {
+    num_dropped_samples_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+
+  buffer.samples[head % ThreadBuffer::kCapacity] = {&node_name, &op_type, node_index,
+                                                    static_cast<uint64_t>(std::max<int64_t>(latency.count(), 0))};
+  buffer.head.store(head + 1, std::memory_order_release);
+}
+
+void SamplingProfiler::Aggregate() const {
+  for (const auto& entry : thread_buffers_) {
+    ThreadBuffer& buffer = *entry.second;
+    size_t tail = buffer.tail.load(std::memory_order_relaxed);
+    const size_t head = buffer.head.load(std::memory_order_acquire);
+    for (; tail != head; ++tail) {
+      const auto& sample = buffer.samples[tail % ThreadBuffer::kCapacity];
+      auto& stats = stats_[sample.node_name];
+      if (stats.count == 0) {
+        stats.node_name = sample.node_name->empty() ? MakeString(*sample.op_type, "_", sample.node_index)
+                                                    : *sample.node_name;
+        stats.op_type = *sample.op_type;
+      }
+
+      ++stats.count;
+      stats.total_ns += sample.latency_ns;
+      stats.max_ns = std::max(stats.max_ns, sample.latency_ns);
+      ++stats.buckets[NodeLatencyStats::GetBucket(sample.latency_ns)];
+    }
+    buffer.tail.store(tail, std::memory_order_release);
+  }
+}
+
+std::vector<NodeLatencyStats> SamplingProfiler::GetSortedStats() const {
+  std::vector<NodeLatencyStats> result;
+  result.reserve(stats_.size());
+  for (const auto& entry : stats_) {
+    result.push_back(entry.second);
+  }
+
+  std::sort(result.begin(), result.end(), [](const NodeLatencyStats& lhs, const NodeLatencyStats& rhs) {
+    return lhs.total_ns != rhs.total_ns ? lhs.total_ns > rhs.total_ns : lhs.node_name < rhs.node_name;
+  });
+  return result;
+}
+
+void SamplingProfiler::OnSampledRunEnd() {
+  std::vector<NodeLatencyStats> exported_stats;
+  SamplingExportCallback export_callback;
+  {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    Aggregate();
+
+    const auto now = std::chrono::steady_clock::now();
+    if (options_.export_interval.count() <= 0 || !options_.export_callback ||
+        now - last_export_time_ < options_.export_interval) {
+      return;
+    }
+
+    last_export_time_ = now;
+    exported_stats = GetSortedStats();
+    stats_.clear();
+    export_callback = options_.export_callback;
+  }
+
+  // called without holding the lock so the callback can use this instance
+  export_callback(exported_stats);
+}
+
+std::vector<NodeLatencyStats> SamplingProfiler::GetNodeLatencies() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  Aggregate();
+  return GetSortedStats();
+}
+
+void SamplingProfiler::Reset() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  Aggregate();
+  stats_.clear();
+  last_export_time_ = std::chrono::steady_clock::now();
+}
+
+void SamplingProfiler::SetExportCallback(SamplingExportCallback export_callback) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  options_.export_callback = std::move(export_callback);
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+namespace profiling {
+
+/**
+ * Latency histogram of a node aggregated over the sampled runs.
+ */
+struct NodeLatencyStats {
+  // bucket i counts the latencies in [2^i, 2^(i+1)) ns, the first bucket also counts 0 and the last one all
+  // latencies that are larger
+  static constexpr size_t kNumBuckets = 40;
+
+  std::string node_name;
+  std::string op_type;
+  uint64_t count = 0;
+  uint64_t total_ns = 0;
+  uint64_t max_ns = 0;
+  std::array<uint64_t, kNumBuckets> buckets{};
+
+  static size_t GetBucket(uint64_t latency_ns);
+
+  /*
+  Returns the upper bound of the bucket containing the given percentile (0-100) of the latencies.
+  */
+  uint64_t GetPercentileUpperBoundNs(double percentile) const;
+};
+
+using SamplingExportCallback = std::function<void(const std::vector<NodeLatencyStats>&)>;
+
+struct SamplingOptions {
+  // the nodes of every sample_every_n-th graph execution are timed
+  size_t sample_every_n = 100;
+  // stats are passed to export_callback and reset at this interval, 0 disables the exports
+  std::chrono::milliseconds export_interval{0};
+  SamplingExportCallback export_callback;
+};
+
+/**
+ * Times the nodes of a sample of the graph executions and aggregates their latencies into histograms.
+ * Unlike Profiler it keeps no per event record, so it is cheap enough to stay enabled in production.
+ * The latencies are written to per-thread ring buffers without locking and aggregated at the end of each sampled
+ * execution and when the stats are queried.
+ */
+class SamplingProfiler {
+ public:
+  explicit SamplingProfiler(SamplingOptions options);
+  ~SamplingProfiler();
+
+  /*
+  Called at the start of each graph execution. Returns true if the nodes of the execution should be timed.
+  */
+  bool ShouldSampleRun() noexcept {
+    return run_counter_.fetch_add(1, std::memory_order_relaxed) % options_.sample_every_n == 0;
+  }
+
+  /*
+  Records the latency of a node of a sampled execution. The strings must outlive this instance.
+  Samples are dropped if the buffer of the calling thread is full.
+  */
+  void RecordNodeLatency(const std::string& node_name, const std::string& op_type, size_t node_index,
+                         std::chrono::nanoseconds latency) noexcept;
+
+  /*
+  Called at the end of each sampled graph execution. Aggregates the recorded latencies and exports the stats if the
+  export interval elapsed.
+  */
+  void OnSampledRunEnd();
+
+  /*
+  Returns the stats of the nodes recorded since the last export or reset, the slowest nodes in total first.
+  */
+  std::vector<NodeLatencyStats> GetNodeLatencies() const;
+
+  void Reset();
+
+  void SetExportCallback(SamplingExportCallback export_callback);
+
+  /*
+  Number of samples dropped because the buffer of the recording thread was full.
+  */
+  uint64_t GetNumDroppedSamples() const noexcept {
+    return num_dropped_samples_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SamplingProfiler);
+
+  struct ThreadBuffer;
+
+  ThreadBuffer& GetThreadBuffer();
+
+  // Requires mutex_ to be held.
+  void Aggregate() const;
+  std::vector<NodeLatencyStats> GetSortedStats() const;
+
+  SamplingOptions options_;
+  // identifies this instance in the per-thread caches, never reused
+  const uint64_t id_;
+  std::atomic<uint64_t> run_counter_{0};
+  std::atomic<uint64_t> num_dropped_samples_{0};
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::thread::id, std::unique_ptr<ThreadBuffer>> thread_buffers_;  // GUARDED_BY(mutex_)
+  // keyed by the address of the node name
+  mutable std::unordered_map<const std::string*, NodeLatencyStats> stats_;  // GUARDED_BY(mutex_)
+  std::chrono::steady_clock::time_point last_export_time_;                   // GUARDED_BY(mutex_)
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -13,12 +13,18 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <optional>
+#include <thread>
+#include <unordered_map>
 
 #include "core/platform/threadpool.h"
 #include "core/common/common.h"
 #include "core/common/cpuid_info.h"
+#include "core/common/logging/logging.h"
 #include "core/common/eigen_common_wrapper.h"
 #include "core/platform/EigenNonBlockingThreadPool.h"
 #include "core/platform/ort_mutex.h"
@@ -63,8 +69,9 @@ ThreadPoolProfiler::~ThreadPoolProfiler() {
   enabled_ = false;
 }
 
-void ThreadPoolProfiler::Start() {
+void ThreadPoolProfiler::Start(bool record_runs) {
   enabled_ = true;
+  record_runs_ = record_runs;
 }
 
 ThreadPoolProfiler::MainThreadStat& ThreadPoolProfiler::GetMainThreadStat() {
@@ -200,12 +207,25 @@ const char* ThreadPoolProfiler::GetEventName(ThreadPoolEvent event) {
 
 void ThreadPoolProfiler::LogThreadId(int thread_idx) {
   child_thread_stats_[thread_idx].thread_id_ = std::this_thread::get_id();
+  child_thread_stats_[thread_idx].logging_thread_id_ = logging::GetThreadId();
+}
+
+void ThreadPoolProfiler::LogRunStart(int thread_idx) {
+  if (record_runs_) {
+    child_thread_stats_[thread_idx].run_start_point_ = Clock::now();
+  }
 }
 
 void ThreadPoolProfiler::LogRun(int thread_idx) {
   if (enabled_) {
     child_thread_stats_[thread_idx].num_run_++;
     auto now = Clock::now();
+    auto& run_start_point = child_thread_stats_[thread_idx].run_start_point_;
+    if (record_runs_ && run_start_point != onnxruntime::TimePoint{}) {
+      std::lock_guard<OrtMutex> lock(runs_mutex_);
+      runs_.push_back({child_thread_stats_[thread_idx].logging_thread_id_, run_start_point, now});
+    }
+    run_start_point = {};
     if (child_thread_stats_[thread_idx].core_ < 0 ||
         TimeDiffMicroSeconds(child_thread_stats_[thread_idx].last_logged_point_, now) > 10000) {
 #ifdef _WIN32
@@ -230,6 +250,13 @@ void ThreadPoolProfiler::LogRun(int thread_idx) {
   }
 }
 
+std::vector<ThreadPoolWorkerRun> ThreadPoolProfiler::TakeRuns() {
+  std::vector<ThreadPoolWorkerRun> runs;
+  std::lock_guard<OrtMutex> lock(runs_mutex_);
+  std::swap(runs, runs_);
+  return runs;
+}
+
 std::string ThreadPoolProfiler::DumpChildThreadStat() {
   std::stringstream ss;
   for (int i = 0; i < num_threads_; ++i) {
@@ -249,6 +276,11 @@ std::string ThreadPoolProfiler::DumpChildThreadStat() {
 // with atomic operations on a single counter, it reduces contention on the counter in the case of loops with
 // large numbers of short-running iteration.  Second, by having a thread work on its home shard initially, it
 // promotes affinity between the work that a thread performs in one loop and the work that it performs in the next.
+//
+// When the threads of the pool are grouped by NUMA node, the shards are further divided into contiguous ranges,
+// one per NUMA domain.  A thread's home shard is then in the range of its own domain, and it exhausts the shards
+// of its domain before moving to the shards of the others, so that each node mostly touches its own part of the
+// iteration space.
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -271,9 +303,11 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
  public:
   LoopCounter(uint64_t num_iterations,
               uint64_t d_of_p,
-              uint64_t block_size = 1) : _num_shards(GetNumShards(num_iterations,
-                                                                  d_of_p,
-                                                                  block_size)) {
+              uint64_t block_size = 1,
+              unsigned num_domains = 0) : _num_shards(GetNumShards(num_iterations,
+                                                                   d_of_p,
+                                                                   block_size)),
+                                          _num_domains(num_domains <= _num_shards ? num_domains : 0) {
     // Divide the iteration space between the shards.  If the iteration
     // space does not divide evenly into shards of multiples of
     // block_size then the final shard is left uneven.
@@ -302,8 +336,13 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
   // tend to run the same iterations in the next loop.  This helps
   // operators with a series of short loops, such as GRU.
 
-  unsigned GetHomeShard(unsigned idx) const {
-    return idx % _num_shards;
+  unsigned GetHomeShard(unsigned idx, int domain = -1) const {
+    if (_num_domains == 0 || domain < 0) {
+      return idx % _num_shards;
+    }
+    const unsigned first = DomainFirstShard(static_cast<unsigned>(domain));
+    const unsigned count = DomainFirstShard(static_cast<unsigned>(domain) + 1) - first;
+    return first + idx % count;
   }
 
   // Attempt to claim iterations from the sharded counter.  The function either
@@ -326,12 +365,45 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
       }
       // Work in the current shard is exhausted, move to the next shard, until
       // we are back at the home shard.
-      my_shard = (my_shard + 1) % _num_shards;
+      my_shard = NextShard(my_home_shard, my_shard);
     } while (my_shard != my_home_shard);
     return false;
   }
 
  private:
+  // Shards [DomainFirstShard(d), DomainFirstShard(d + 1)) belong to NUMA domain d.
+  unsigned DomainFirstShard(unsigned domain) const {
+    return domain * _num_shards / _num_domains;
+  }
+
+  // Visit the shards of the home shard's domain first, cycling from the home shard, and then the
+  // shards of the other domains.  Returns my_home_shard once all the shards have been visited.
+  unsigned NextShard(unsigned my_home_shard, unsigned my_shard) const {
+    if (_num_domains == 0) {
+      return (my_shard + 1) % _num_shards;
+    }
+    unsigned first = 0;
+    unsigned last = 0;
+    for (unsigned domain = 0; domain < _num_domains; domain++) {
+      first = DomainFirstShard(domain);
+      last = DomainFirstShard(domain + 1);
+      if (my_home_shard < last) {
+        break;
+      }
+    }
+    if (my_shard >= first && my_shard < last) {
+      unsigned next = (my_shard + 1 == last) ? first : my_shard + 1;
+      if (next != my_home_shard) {
+        return next;
+      }
+      // The home domain is exhausted, continue with the other domains.
+      next = last % _num_shards;
+      return next == first ? my_home_shard : next;
+    }
+    unsigned next = (my_shard + 1) % _num_shards;
+    return next == first ? my_home_shard : next;
+  }
+
   // Derive the number of shards to use for a given loop.  We require
   // at least one block of work per shard, and subject to the
   // constraints:
@@ -363,12 +435,189 @@ class alignas(CACHE_LINE_BYTES) LoopCounter {
 
   alignas(CACHE_LINE_BYTES) LoopCounterShard _shards[MAX_SHARDS];
   const unsigned _num_shards;
+  const unsigned _num_domains;
 };
 
 #ifdef _MSC_VER
 #pragma warning(pop) /* Padding added in LoopCounterShard, LoopCounter */
 #endif
 
+namespace {
+
+// Runs the work of a ThreadPool on a scheduler of the host application.  A parallel loop hands
+// n - 1 work items to the scheduler and runs one itself, and each work item in turn runs fn
+// with the next unclaimed index, unless the loop has already ended.  As fn(idx) claims
+// iterations until the loop runs out of them, the caller alone completes the loop if the
+// scheduler runs none of the items in time, and it only has to wait for the items that started.
+class HostSchedulerThreadPool final : public ExtendedThreadPoolInterface {
+ public:
+  HostSchedulerThreadPool(OrtCustomScheduleFn schedule_fn, void* scheduler_param, int num_threads)
+      : schedule_fn_(schedule_fn), scheduler_param_(scheduler_param), num_threads_(num_threads) {
+  }
+
+  void Schedule(std::function<void()> fn) override {
+    auto* work = new std::function<void()>(std::move(fn));
+    schedule_fn_(scheduler_param_, RunScheduledWork, work);
+  }
+
+  // Parallel sections are only an optimization of the loop entry and exit of ThreadPoolTempl.
+  void StartParallelSection(ThreadPoolParallelSection& /*ps*/) override {}
+  void EndParallelSection(ThreadPoolParallelSection& /*ps*/) override {}
+
+  void RunInParallelSection(ThreadPoolParallelSection& /*ps*/, std::function<void(unsigned idx)> fn,
+                            unsigned n, std::ptrdiff_t block_size) override {
+    RunInParallel(std::move(fn), n, block_size);
+  }
+
+  void RunInParallel(std::function<void(unsigned idx)> fn, unsigned n, std::ptrdiff_t /*block_size*/) override {
+    n = std::min(n, static_cast<unsigned>(num_threads_ + 1));
+    if (n <= 1) {
+      fn(0);
+      return;
+    }
+
+    // Shared with the work items, which may start after the loop has ended.
+    auto loop = std::make_shared<Loop>();
+    loop->fn = std::move(fn);
+    loop->num_items = n;
+    for (unsigned i = 1; i < n; i++) {
+      auto* work = new std::shared_ptr<Loop>(loop);
+      schedule_fn_(scheduler_param_, RunLoopWork, work);
+    }
+
+    loop->fn(0);
+
+    std::unique_lock<OrtMutex> lock(loop->mutex);
+    loop->ended = true;
+    loop->cv.wait(lock, [&loop]() { return loop->num_running == 0; });
+  }
+
+  int NumThreads() const override {
+    return num_threads_;
+  }
+
+  // The threads of the scheduler are not known.
+  int CurrentThreadId() const override {
+    return -1;
+  }
+
+  void StartProfiling(bool /*record_worker_runs*/) override {}
+  std::string StopProfiling() override {
+    return {};
+  }
+  std::vector<ThreadPoolWorkerRun> TakeProfiledWorkerRuns() override {
+    return {};
+  }
+
+ private:
+  struct Loop {
+    std::function<void(unsigned idx)> fn;
+    unsigned num_items = 0;
+    OrtMutex mutex;
+    OrtCondVar cv;
+    unsigned next_idx = 1;     // GUARDED_BY(mutex)
+    unsigned num_running = 0;  // GUARDED_BY(mutex)
+    bool ended = false;        // GUARDED_BY(mutex)
+  };
+
+  static void RunScheduledWork(void* param) {
+    std::unique_ptr<std::function<void()>> work(static_cast<std::function<void()>*>(param));
+    (*work)();
+  }
+
+  static void RunLoopWork(void* param) {
+    std::unique_ptr<std::shared_ptr<Loop>> work(static_cast<std::shared_ptr<Loop>*>(param));
+    Loop& loop = **work;
+    unsigned idx;
+    {
+      std::lock_guard<OrtMutex> lock(loop.mutex);
+      if (loop.ended || loop.next_idx == loop.num_items) {
+        return;
+      }
+      idx = loop.next_idx++;
+      loop.num_running++;
+    }
+
+    loop.fn(idx);
+
+    std::lock_guard<OrtMutex> lock(loop.mutex);
+    if (--loop.num_running == 0 && loop.ended) {
+      loop.cv.notify_all();
+    }
+  }
+
+  const OrtCustomScheduleFn schedule_fn_;
+  void* const scheduler_param_;
+  const int num_threads_;
+};
+
+}  // namespace
+
+using CostModel = Eigen::TensorCostModel<Eigen::ThreadPoolDevice>;
+
+// Measures the cost per iteration of the loops of ParallelFor, by call site, and scales the
+// costs given by a call site once its loops have been measured.  The call sites are told apart
+// by the types of their loop bodies, i.e. by lambda expression.  The cost of a call site often
+// depends on the shapes of its inputs, hence the factor between the measured and the given cost
+// is kept rather than the measured cost itself.
+//
+// A loop is measured by timing the blocks of iterations it is split into, which adds two clock
+// reads per block, hence only the first loops of a call site and then a sample of them are.
+class ParallelForCostCalibration {
+ public:
+  struct Site {
+    std::atomic<uint64_t> num_calls{0};
+    std::atomic<double> cost_factor{0};  // measured / given cost, 0 until the first measurement
+  };
+
+  // Returns the cost to split a loop of fn with, and whether the loop should be measured.
+  Eigen::TensorOpCost GetCost(const std::function<void(std::ptrdiff_t, std::ptrdiff_t)>& fn,
+                              const Eigen::TensorOpCost& cost, Site*& site, bool& measure) {
+    site = nullptr;
+    measure = false;
+#ifndef ORT_NO_RTTI
+    const size_t key = fn.target_type().hash_code();
+    {
+      std::lock_guard<OrtMutex> lock(mutex_);
+      site = &sites_[key];
+    }
+    const uint64_t num_calls = site->num_calls.fetch_add(1, std::memory_order_relaxed);
+    measure = num_calls < kNumCallsAlwaysMeasured || num_calls % kMeasurementInterval == 0;
+    const double factor = site->cost_factor.load(std::memory_order_relaxed);
+    if (factor > 0) {
+      return cost * factor;
+    }
+#else
+    ORT_UNUSED_PARAMETER(fn);
+#endif
+    return cost;
+  }
+
+  // Records the time that the blocks of a loop of n iterations took in total.
+  void OnMeasured(Site& site, std::ptrdiff_t n, const Eigen::TensorOpCost& cost, std::chrono::nanoseconds busy_time) {
+    const double given_cycles = CostModel::totalCost(static_cast<double>(n), cost);
+    if (n <= 0 || given_cycles <= 0) {
+      return;
+    }
+    const double measured_cycles = static_cast<double>(busy_time.count()) * kCyclesPerNs;
+    const double sample = std::clamp(measured_cycles / given_cycles, kMinCostFactor, kMaxCostFactor);
+    const double factor = site.cost_factor.load(std::memory_order_relaxed);
+    // concurrent updates may lose a sample, which does not matter for an average
+    site.cost_factor.store(factor > 0 ? factor + (sample - factor) / 4 : sample, std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr uint64_t kNumCallsAlwaysMeasured = 8;
+  static constexpr uint64_t kMeasurementInterval = 64;
+  // the cost model counts cycles, the measurements assume a 3 GHz core
+  static constexpr double kCyclesPerNs = 3.0;
+  static constexpr double kMinCostFactor = 1e-4;
+  static constexpr double kMaxCostFactor = 1e4;
+
+  OrtMutex mutex_;
+  std::unordered_map<size_t, Site> sites_;  // GUARDED_BY(mutex_), the sites are never removed
+};
+
 ThreadPool::ThreadPool(Env* env,
                        const ThreadOptions& thread_options,
                        const NAME_CHAR_TYPE* name,
@@ -397,6 +646,21 @@ ThreadPool::ThreadPool(Env* env,
                                                 thread_options_);
     underlying_threadpool_ = extended_eigen_threadpool_.get();
   }
+
+  if (thread_options_.calibrate_parallel_for_cost) {
+    cost_calibration_ = std::make_unique<ParallelForCostCalibration>();
+  }
+}
+
+ThreadPool::ThreadPool(OrtCustomScheduleFn schedule_fn,
+                       void* scheduler_param,
+                       int degree_of_parallelism) {
+  assert(degree_of_parallelism >= 1);
+  if (degree_of_parallelism >= 2) {
+    host_scheduler_threadpool_ = std::make_unique<HostSchedulerThreadPool>(schedule_fn, scheduler_param,
+                                                                           degree_of_parallelism - 1);
+    underlying_threadpool_ = host_scheduler_threadpool_.get();
+  }
 }
 
 ThreadPool::~ThreadPool() = default;
@@ -424,9 +688,9 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     int num_work_items = static_cast<int>(std::min(static_cast<std::ptrdiff_t>(num_threads_inc_main), num_blocks));
     assert(num_work_items > 0);
 
-    LoopCounter lc(total, d_of_p, block_size);
+    LoopCounter lc(total, d_of_p, block_size, NumNumaDomains());
     std::function<void(unsigned)> run_work = [&](unsigned idx) {
-      unsigned my_home_shard = lc.GetHomeShard(idx);
+      unsigned my_home_shard = lc.GetHomeShard(idx, CurrentThreadNumaDomain());
       unsigned my_shard = my_home_shard;
       uint64_t my_iter_start, my_iter_end;
       while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, block_size)) {
@@ -442,10 +706,10 @@ void ThreadPool::ParallelForFixedBlockSizeScheduling(const std::ptrdiff_t total,
     int num_of_blocks = d_of_p * thread_options_.dynamic_block_base_;
     std::ptrdiff_t base_block_size = static_cast<std::ptrdiff_t>(std::max(1LL, std::llroundl(static_cast<long double>(total) / num_of_blocks)));
     alignas(CACHE_LINE_BYTES) std::atomic<std::ptrdiff_t> left{total};
-    LoopCounter lc(total, d_of_p, base_block_size);
+    LoopCounter lc(total, d_of_p, base_block_size, NumNumaDomains());
     std::function<void(unsigned)> run_work = [&](unsigned idx) {
       std::ptrdiff_t b = base_block_size;
-      unsigned my_home_shard = lc.GetHomeShard(idx);
+      unsigned my_home_shard = lc.GetHomeShard(idx, CurrentThreadNumaDomain());
       unsigned my_shard = my_home_shard;
       uint64_t my_iter_start, my_iter_end;
       while (lc.ClaimIterations(my_home_shard, my_shard, my_iter_start, my_iter_end, b)) {
@@ -479,9 +743,9 @@ void ThreadPool::Schedule(std::function<void()> fn) {
   }
 }
 
-void ThreadPool::StartProfiling() {
+void ThreadPool::StartProfiling(bool record_worker_runs) {
   if (underlying_threadpool_) {
-    underlying_threadpool_->StartProfiling();
+    underlying_threadpool_->StartProfiling(record_worker_runs);
   }
 }
 
@@ -493,6 +757,14 @@ std::string ThreadPool::StopProfiling() {
   }
 }
 
+std::vector<ThreadPoolWorkerRun> ThreadPool::TakeProfiledWorkerRuns() {
+  if (underlying_threadpool_) {
+    return underlying_threadpool_->TakeProfiledWorkerRuns();
+  } else {
+    return {};
+  }
+}
+
 namespace {
 thread_local std::optional<ThreadPoolParallelSection> current_parallel_section;
 }
@@ -549,8 +821,6 @@ bool ThreadPool::ShouldParallelizeLoop(const std::ptrdiff_t num_iterations,
   return true;
 }
 
-using CostModel = Eigen::TensorCostModel<Eigen::ThreadPoolDevice>;
-
 // Calculates block size based on (1) the iteration cost and (2) parallel
 // efficiency. We want blocks to be not too small to mitigate parallelization
 // overheads; not too large to mitigate tail effect and potential load
@@ -614,16 +884,40 @@ void ThreadPool::ParallelFor(std::ptrdiff_t n, const TensorOpCost& c,
                              const std::function<void(std::ptrdiff_t first, std::ptrdiff_t)>& f) {
   ORT_ENFORCE(n >= 0);
   Eigen::TensorOpCost cost{c.bytes_loaded, c.bytes_stored, c.compute_cycles};
+
+  // Use the measured cost of the call site if the costs are calibrated, and time a sample of the loops.
+  ParallelForCostCalibration::Site* site = nullptr;
+  bool measure = false;
+  const Eigen::TensorOpCost given_cost = cost;
+  if (cost_calibration_) {
+    cost = cost_calibration_->GetCost(f, given_cost, site, measure);
+  }
+  std::atomic<int64_t> busy_ns{0};
+  std::function<void(std::ptrdiff_t, std::ptrdiff_t)> timed_f;
+  if (measure) {
+    timed_f = [&f, &busy_ns](std::ptrdiff_t first, std::ptrdiff_t last) {
+      const auto start = std::chrono::steady_clock::now();
+      f(first, last);
+      const auto duration = std::chrono::steady_clock::now() - start;
+      busy_ns.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count(),
+                        std::memory_order_relaxed);
+    };
+  }
+  const auto& loop_body = measure ? timed_f : f;
+
   auto d_of_p = DegreeOfParallelism(this);
   // Compute small problems directly in the caller thread.
   if ((!ShouldParallelizeLoop(n)) ||
       CostModel::numThreads(static_cast<double>(n), cost, d_of_p) == 1) {
-    f(0, n);
-    return;
+    loop_body(0, n);
+  } else {
+    ptrdiff_t block = CalculateParallelForBlock(n, cost, nullptr, d_of_p);
+    ParallelForFixedBlockSizeScheduling(n, block, loop_body);
   }
 
-  ptrdiff_t block = CalculateParallelForBlock(n, cost, nullptr, d_of_p);
-  ParallelForFixedBlockSizeScheduling(n, block, f);
+  if (measure) {
+    cost_calibration_->OnMeasured(*site, n, given_cost, std::chrono::nanoseconds(busy_ns.load()));
+  }
 }
 
 void ThreadPool::ParallelFor(std::ptrdiff_t total, double cost_per_unit,
@@ -649,9 +943,48 @@ int ThreadPool::DegreeOfParallelism(const concurrency::ThreadPool* tp) {
   }
 }
 
-void ThreadPool::StartProfiling(concurrency::ThreadPool* tp) {
+namespace {
+// number of threads in a high priority scope, which low priority work yields to
+std::atomic<int> active_high_priority_scopes{0};
+}  // namespace
+
+ThreadPool::PriorityScope::PriorityScope(ThreadPoolPriority priority)
+    : previous_(ThreadPoolTempl<Env>::GetCurrentThreadPriority()),
+      counted_(priority == ThreadPoolPriority::kHigh) {
+  ThreadPoolTempl<Env>::SetCurrentThreadPriority(priority);
+  if (counted_) {
+    active_high_priority_scopes.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+ThreadPool::PriorityScope::~PriorityScope() {
+  if (counted_) {
+    active_high_priority_scopes.fetch_sub(1, std::memory_order_relaxed);
+  }
+  ThreadPoolTempl<Env>::SetCurrentThreadPriority(previous_);
+}
+
+ThreadPoolPriority ThreadPool::GetCurrentThreadPriority() {
+  return ThreadPoolTempl<Env>::GetCurrentThreadPriority();
+}
+
+void ThreadPool::YieldToHighPriorityWork(std::chrono::microseconds max_wait) {
+  if (GetCurrentThreadPriority() != ThreadPoolPriority::kLow ||
+      active_high_priority_scopes.load(std::memory_order_relaxed) == 0) {
+    return;
+  }
+
+  constexpr std::chrono::microseconds step{50};
+  const auto deadline = std::chrono::steady_clock::now() + max_wait;
+  while (active_high_priority_scopes.load(std::memory_order_relaxed) != 0 &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(step);
+  }
+}
+
+void ThreadPool::StartProfiling(concurrency::ThreadPool* tp, bool record_worker_runs) {
   if (tp) {
-    tp->StartProfiling();
+    tp->StartProfiling(record_worker_runs);
   }
 }
 
@@ -663,6 +996,14 @@ std::string ThreadPool::StopProfiling(concurrency::ThreadPool* tp) {
   }
 }
 
+std::vector<ThreadPoolWorkerRun> ThreadPool::TakeProfiledWorkerRuns(concurrency::ThreadPool* tp) {
+  if (tp) {
+    return tp->TakeProfiledWorkerRuns();
+  } else {
+    return {};
+  }
+}
+
 void ThreadPool::EnableSpinning() {
   if (extended_eigen_threadpool_) {
     extended_eigen_threadpool_->EnableSpinning();
@@ -675,6 +1016,19 @@ void ThreadPool::DisableSpinning() {
   }
 }
 
+void ThreadPool::EnableBusyTimeTracking() {
+  if (extended_eigen_threadpool_) {
+    extended_eigen_threadpool_->EnableBusyTimeTracking();
+  }
+}
+
+uint64_t ThreadPool::GetAverageWorkerBusyTimeNs() const {
+  if (!extended_eigen_threadpool_ || extended_eigen_threadpool_->NumThreads() == 0) {
+    return 0;
+  }
+  return extended_eigen_threadpool_->GetBusyTimeNs() / static_cast<uint64_t>(extended_eigen_threadpool_->NumThreads());
+}
+
 // Return the number of threads created by the pool.
 int ThreadPool::NumThreads() const {
   if (underlying_threadpool_) {
@@ -694,6 +1048,14 @@ int ThreadPool::CurrentThreadId() const {
   }
 }
 
+unsigned ThreadPool::NumNumaDomains() const {
+  return extended_eigen_threadpool_ ? extended_eigen_threadpool_->NumNumaDomains() : 0;
+}
+
+int ThreadPool::CurrentThreadNumaDomain() const {
+  return extended_eigen_threadpool_ ? extended_eigen_threadpool_->CurrentThreadNumaDomain() : -1;
+}
+
 void ThreadPool::TryParallelFor(concurrency::ThreadPool* tp, std::ptrdiff_t total, const TensorOpCost& cost_per_unit,
                                 const std::function<void(std::ptrdiff_t first, std::ptrdiff_t last)>& fn) {
   if (tp == nullptr) {
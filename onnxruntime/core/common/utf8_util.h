@@ -5,6 +5,9 @@
 
 #include "core/common/common.h"
 
+#include <cstdint>
+#include <cstring>
+
 namespace onnxruntime {
 namespace utf8_util {
 
@@ -31,10 +34,34 @@ inline bool utf8_bytes(unsigned char ch, size_t& len) {
   return false;
 }
 
+// Returns the number of leading ASCII bytes of s.
+// Text is mostly ASCII, so the bytes are tested a word at a time.
+inline size_t utf8_ascii_prefix(const unsigned char* s, size_t len) {
+  size_t idx = 0;
+  for (; idx + sizeof(uint64_t) <= len; idx += sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, s + idx, sizeof(word));
+    if ((word & 0x8080808080808080ULL) != 0) {
+      break;
+    }
+  }
+  while (idx < len && s[idx] < 0x80u) {
+    ++idx;
+  }
+  return idx;
+}
+
 // Computes length of the utf8 string in characters
 inline bool utf8_len(const unsigned char* s, size_t bytes, size_t& len) {
   size_t result = 0;
   while (bytes > 0) {
+    if (*s < 0x80u) {
+      const size_t ascii_bytes = utf8_ascii_prefix(s, bytes);
+      bytes -= ascii_bytes;
+      s += ascii_bytes;
+      result += ascii_bytes;
+      continue;
+    }
     size_t char_bytes = 0;
     bool valid = utf8_bytes(*s, char_bytes);
     if (!valid || bytes < char_bytes) {
@@ -52,6 +79,12 @@ inline bool utf8_validate(const unsigned char* s, size_t len, size_t& utf8_chars
   size_t utf8_len = 0;
   size_t idx = 0;
   while (idx < len) {
+    if (s[idx] < 0x80u) {
+      const size_t ascii_bytes = utf8_ascii_prefix(s + idx, len - idx);
+      idx += ascii_bytes;
+      utf8_len += ascii_bytes;
+      continue;
+    }
     size_t bytes = 0;
     auto ch = s[idx];
     if (utf8_bytes(ch, bytes)) {
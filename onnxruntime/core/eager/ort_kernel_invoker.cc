@@ -9,50 +9,110 @@
 #include "core/session/ort_env.h"
 #include "core/graph/constants.h"
 
+#include <algorithm>
+
 namespace onnxruntime {
 
 #define ORT_EAGER_ONNX_OPSET_VERSION 14
 
-common::Status ORTInvoker::Invoke(const std::string& op_name,
-                                  // optional inputs / outputs?
-                                  const std::vector<OrtValue>& inputs,
-                                  std::vector<OrtValue>& outputs,
-                                  const NodeAttributes* attributes,
-                                  const std::string& domain,
-                                  const int version) {
+struct ORTInvoker::CachedKernel {
+  // Owns the single-node graph which "kernel" and "info" refer to.
+  std::unique_ptr<Model> model;
+  std::unique_ptr<OptimizerExecutionFrame::Info> info;
+  std::unique_ptr<const OpKernel> kernel;
+  const KernelCreateInfo* kernel_create_info{nullptr};
+  std::vector<int> feed_mlvalue_idxs;
+  std::vector<int> fetch_mlvalue_idxs;
+};
+
+// Eager inputs are fed at run time, so none of them is a (sparse) initializer.
+// This must outlive the cached OptimizerExecutionFrame::Info's which keep a reference to it.
+static const std::function<bool(const std::string&)> kIsSparseInitializer = [](const std::string&) {
+  return false;
+};
+
+static std::string GetKernelCacheKey(const std::string& op_name,
+                                     const std::vector<OrtValue>& inputs,
+                                     size_t num_outputs,
+                                     const NodeAttributes* attributes,
+                                     const std::string& domain) {
+  std::string key = domain;
+  key += ':';
+  key += op_name;
+  key += '(';
+  for (const auto& input : inputs) {
+    key += std::to_string(input.Get<Tensor>().GetElementType());
+    key += ',';
+  }
+  key += ")->";
+  key += std::to_string(num_outputs);
+  if (attributes) {
+    // NodeAttributes is unordered, so sort the names to get the same key for the same attributes.
+    std::vector<const std::string*> names;
+    names.reserve(attributes->size());
+    for (const auto& attr : *attributes) {
+      names.push_back(&attr.first);
+    }
+    std::sort(names.begin(), names.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+    for (const auto* name : names) {
+      key += '|';
+      key += *name;
+      key += '=';
+      key += attributes->at(*name).SerializeAsString();
+    }
+  }
+  return key;
+}
+
+common::Status ORTInvoker::GetOrCreateKernel(const std::string& op_name,
+                                             const std::vector<OrtValue>& inputs,
+                                             size_t num_outputs,
+                                             const NodeAttributes* attributes,
+                                             const std::string& domain,
+                                             const int version,
+                                             std::shared_ptr<const CachedKernel>& cached_kernel) {
+  const std::string key = GetKernelCacheKey(op_name, inputs, num_outputs, attributes, domain);
+  {
+    std::lock_guard<OrtMutex> lock(kernel_cache_mutex_);
+    auto it = kernel_cache_.find(key);
+    if (it != kernel_cache_.end()) {
+      cached_kernel = it->second;
+      return Status::OK();
+    }
+  }
+
   std::unordered_map<std::string, int> domain_version_map = {{kOnnxDomain, ORT_EAGER_ONNX_OPSET_VERSION},
                                                              {kMSDomain, 1}};
+  auto entry = std::make_shared<CachedKernel>();
   // create a graph
-  Model model("test",
-              false,
-              ModelMetaData(),
-              ORT_TSTR(""),
-              custom_op_registries_,
-              domain_version_map,
-              {},
-              logger_);
+  entry->model = std::make_unique<Model>("test",
+                                         false,
+                                         ModelMetaData(),
+                                         ORT_TSTR(""),
+                                         custom_op_registries_,
+                                         domain_version_map,
+                                         std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                         logger_);
 
   std::vector<onnxruntime::NodeArg*> input_args;
   std::vector<onnxruntime::NodeArg*> output_args;
 
   input_args.reserve(inputs.size());
-  output_args.reserve(outputs.size());
+  output_args.reserve(num_outputs);
 
-  Graph& graph = model.MainGraph();
-  std::unordered_map<std::string, OrtValue> initializer_map;
+  Graph& graph = entry->model->MainGraph();
   size_t i = 0;
 
-  for (auto input : inputs) {
+  for (const auto& input : inputs) {
     std::string name = "I" + std::to_string(i++);
     const Tensor& input_tensor = input.Get<Tensor>();
     ONNX_NAMESPACE::TypeProto input_tensor_type;
     input_tensor_type.mutable_tensor_type()->set_elem_type(input_tensor.GetElementType());
     auto& arg = graph.GetOrCreateNodeArg(name, &input_tensor_type);
     input_args.push_back(&arg);
-    initializer_map[name] = input;
   }
 
-  for (i = 0; i < outputs.size(); ++i) {
+  for (i = 0; i < num_outputs; ++i) {
     auto& arg = graph.GetOrCreateNodeArg("O" + std::to_string(i), nullptr);
     output_args.push_back(&arg);
   }
@@ -61,36 +121,58 @@ common::Status ORTInvoker::Invoke(const std::string& op_name,
   ORT_RETURN_IF_ERROR(graph.Resolve());
 
   node.SetExecutionProviderType(execution_provider_->Type());
-  std::vector<const Node*> frame_nodes{&node};
 
-  OptimizerExecutionFrame::Info info({&node}, initializer_map, graph.ModelPath(), *execution_provider_, [](std::string const&) { return false; });
-  const KernelCreateInfo* kernel_create_info = nullptr;
-  ORT_RETURN_IF_ERROR(info.TryFindKernel(&node, &kernel_create_info));
-  if (!kernel_create_info) {
+  // Inputs are not passed as initializers: the kernel is reused across calls,
+  // so it must not specialize itself on the values seen at creation.
+  entry->info = std::make_unique<OptimizerExecutionFrame::Info>(
+      std::vector<const Node*>{&node}, std::unordered_map<std::string, OrtValue>(), graph.ModelPath(),
+      *execution_provider_, kIsSparseInitializer);
+  ORT_RETURN_IF_ERROR(entry->info->TryFindKernel(&node, &entry->kernel_create_info));
+  if (!entry->kernel_create_info) {
     ORT_THROW("Could not find kernel name:", op_name, ", domain:", domain, ", version:", version);
   }
-  // check whether the inputs are contiguous tensor
-  const auto& may_strided_inputs = kernel_create_info->kernel_def->MayStridedInput();
-  for (i = 0; i < inputs.size(); ++i) {
-    const Tensor& input_tensor = inputs[i].Get<Tensor>();
-    if (!input_tensor.IsContiguous() && std::find(may_strided_inputs.begin(), may_strided_inputs.end(),
-                                                  static_cast<int>(i)) == may_strided_inputs.end())
-      ORT_THROW("kernel name:", op_name, "'s ", i, "th input doesn't support non-contiguous tensor.");
-  }
 
-  auto kernel = info.CreateKernel(&node);
-  if (!kernel) {
+  entry->kernel = entry->info->CreateKernel(&node);
+  if (!entry->kernel) {
     ORT_THROW("Could not find kernel name:", op_name, ", domain:", domain, ", version:", version);
   }
 
-  std::vector<int> fetch_mlvalue_idxs;
+  for (const auto* node_in : node.InputDefs()) {
+    entry->feed_mlvalue_idxs.push_back(entry->info->GetMLValueIndex(node_in->Name()));
+  }
   for (const auto* node_out : node.OutputDefs()) {
-    fetch_mlvalue_idxs.push_back(info.GetMLValueIndex(node_out->Name()));
+    entry->fetch_mlvalue_idxs.push_back(entry->info->GetMLValueIndex(node_out->Name()));
+  }
+
+  std::lock_guard<OrtMutex> lock(kernel_cache_mutex_);
+  // Another thread may have created the same kernel meanwhile; keep the first one.
+  cached_kernel = kernel_cache_.emplace(key, std::move(entry)).first->second;
+  return Status::OK();
+}
+
+common::Status ORTInvoker::Invoke(const std::string& op_name,
+                                  // optional inputs / outputs?
+                                  const std::vector<OrtValue>& inputs,
+                                  std::vector<OrtValue>& outputs,
+                                  const NodeAttributes* attributes,
+                                  const std::string& domain,
+                                  const int version) {
+  std::shared_ptr<const CachedKernel> cached_kernel;
+  ORT_RETURN_IF_ERROR(GetOrCreateKernel(op_name, inputs, outputs.size(), attributes, domain, version, cached_kernel));
+
+  // check whether the inputs are contiguous tensor
+  const auto& may_strided_inputs = cached_kernel->kernel_create_info->kernel_def->MayStridedInput();
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    const Tensor& input_tensor = inputs[i].Get<Tensor>();
+    if (!input_tensor.IsContiguous() && std::find(may_strided_inputs.begin(), may_strided_inputs.end(),
+                                                  static_cast<int>(i)) == may_strided_inputs.end())
+      ORT_THROW("kernel name:", op_name, "'s ", i, "th input doesn't support non-contiguous tensor.");
   }
 
-  OptimizerExecutionFrame frame(info, fetch_mlvalue_idxs, outputs);
-  OpKernelContext op_kernel_context(&frame, kernel.get(), nullptr, nullptr, logger_);
-  ORT_RETURN_IF_ERROR(kernel->Compute(&op_kernel_context));
+  OptimizerExecutionFrame frame(*cached_kernel->info, cached_kernel->feed_mlvalue_idxs, inputs,
+                                cached_kernel->fetch_mlvalue_idxs, outputs);
+  OpKernelContext op_kernel_context(&frame, cached_kernel->kernel.get(), nullptr, nullptr, logger_);
+  ORT_RETURN_IF_ERROR(cached_kernel->kernel->Compute(&op_kernel_context));
 
   return frame.GetOutputs(outputs);
 }
@@ -0,0 +1,84 @@
+# automatically generated by the FlatBuffers compiler, do not modify
+
+# namespace: fbs
+
+import flatbuffers
+from flatbuffers.compat import import_numpy
+np = import_numpy()
+
+class SessionMemoryPatterns(object):
+    __slots__ = ['_tab']
+
+    @classmethod
+    def GetRootAsSessionMemoryPatterns(cls, buf, offset):
+        n = flatbuffers.encode.Get(flatbuffers.packer.uoffset, buf, offset)
+        x = SessionMemoryPatterns()
+        x.Init(buf, n + offset)
+        return x
+
+    @classmethod
+    def SessionMemoryPatternsBufferHasIdentifier(cls, buf, offset, size_prefixed=False):
+        return flatbuffers.util.BufferHasIdentifier(buf, offset, b"\x4F\x52\x54\x4D", size_prefixed=size_prefixed)
+
+    # SessionMemoryPatterns
+    def Init(self, buf, pos):
+        self._tab = flatbuffers.table.Table(buf, pos)
+
+    # SessionMemoryPatterns
+    def InputDims(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            a = self._tab.Vector(o)
+            return self._tab.Get(flatbuffers.number_types.Int64Flags, a + flatbuffers.number_types.UOffsetTFlags.py_type(j * 8))
+        return 0
+
+    # SessionMemoryPatterns
+    def InputDimsAsNumpy(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.GetVectorAsNumpy(flatbuffers.number_types.Int64Flags, o)
+        return 0
+
+    # SessionMemoryPatterns
+    def InputDimsLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # SessionMemoryPatterns
+    def InputDimsIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(4))
+        return o == 0
+
+    # SessionMemoryPatterns
+    def Patterns(self, j):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            x = self._tab.Vector(o)
+            x += flatbuffers.number_types.UOffsetTFlags.py_type(j) * 4
+            x = self._tab.Indirect(x)
+            from ort_flatbuffers_py.fbs.MemoryPattern import MemoryPattern
+            obj = MemoryPattern()
+            obj.Init(self._tab.Bytes, x)
+            return obj
+        return None
+
+    # SessionMemoryPatterns
+    def PatternsLength(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        if o != 0:
+            return self._tab.VectorLen(o)
+        return 0
+
+    # SessionMemoryPatterns
+    def PatternsIsNone(self):
+        o = flatbuffers.number_types.UOffsetTFlags.py_type(self._tab.Offset(6))
+        return o == 0
+
+def SessionMemoryPatternsStart(builder): builder.StartObject(2)
+def SessionMemoryPatternsAddInputDims(builder, inputDims): builder.PrependUOffsetTRelativeSlot(0, flatbuffers.number_types.UOffsetTFlags.py_type(inputDims), 0)
+def SessionMemoryPatternsStartInputDimsVector(builder, numElems): return builder.StartVector(8, numElems, 8)
+def SessionMemoryPatternsAddPatterns(builder, patterns): builder.PrependUOffsetTRelativeSlot(1, flatbuffers.number_types.UOffsetTFlags.py_type(patterns), 0)
+def SessionMemoryPatternsStartPatternsVector(builder, numElems): return builder.StartVector(4, numElems, 4)
+def SessionMemoryPatternsEnd(builder): return builder.EndObject()
@@ -98,6 +98,12 @@ struct OpIdKernelTypeStrArgsEntryBuilder;
 struct KernelTypeStrResolver;
 struct KernelTypeStrResolverBuilder;
 
+struct MemoryPattern;
+struct MemoryPatternBuilder;
+
+struct SessionMemoryPatterns;
+struct SessionMemoryPatternsBuilder;
+
 struct InferenceSession;
 struct InferenceSessionBuilder;
 
@@ -2967,12 +2973,259 @@ inline flatbuffers::Offset<KernelTypeStrResolver> CreateKernelTypeStrResolverDir
       op_kernel_type_str_args__);
 }
 
+struct MemoryPattern FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef MemoryPatternBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_LOCATION_NAME = 4,
+    VT_LOCATION_ID = 6,
+    VT_LOCATION_MEM_TYPE = 8,
+    VT_LOCATION_ALLOC_TYPE = 10,
+    VT_DEVICE_TYPE = 12,
+    VT_DEVICE_MEM_TYPE = 14,
+    VT_DEVICE_ID = 16,
+    VT_PEAK_SIZE = 18,
+    VT_VALUE_NAMES = 20,
+    VT_OFFSETS = 22,
+    VT_SIZES = 24
+  };
+  const flatbuffers::String *location_name() const {
+    return GetPointer<const flatbuffers::String *>(VT_LOCATION_NAME);
+  }
+  int32_t location_id() const {
+    return GetField<int32_t>(VT_LOCATION_ID, 0);
+  }
+  int32_t location_mem_type() const {
+    return GetField<int32_t>(VT_LOCATION_MEM_TYPE, 0);
+  }
+  int32_t location_alloc_type() const {
+    return GetField<int32_t>(VT_LOCATION_ALLOC_TYPE, 0);
+  }
+  int8_t device_type() const {
+    return GetField<int8_t>(VT_DEVICE_TYPE, 0);
+  }
+  int8_t device_mem_type() const {
+    return GetField<int8_t>(VT_DEVICE_MEM_TYPE, 0);
+  }
+  int16_t device_id() const {
+    return GetField<int16_t>(VT_DEVICE_ID, 0);
+  }
+  uint64_t peak_size() const {
+    return GetField<uint64_t>(VT_PEAK_SIZE, 0);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *value_names() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>> *>(VT_VALUE_NAMES);
+  }
+  const flatbuffers::Vector<uint64_t> *offsets() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_OFFSETS);
+  }
+  const flatbuffers::Vector<uint64_t> *sizes() const {
+    return GetPointer<const flatbuffers::Vector<uint64_t> *>(VT_SIZES);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_LOCATION_NAME) &&
+           verifier.VerifyString(location_name()) &&
+           VerifyField<int32_t>(verifier, VT_LOCATION_ID) &&
+           VerifyField<int32_t>(verifier, VT_LOCATION_MEM_TYPE) &&
+           VerifyField<int32_t>(verifier, VT_LOCATION_ALLOC_TYPE) &&
+           VerifyField<int8_t>(verifier, VT_DEVICE_TYPE) &&
+           VerifyField<int8_t>(verifier, VT_DEVICE_MEM_TYPE) &&
+           VerifyField<int16_t>(verifier, VT_DEVICE_ID) &&
+           VerifyField<uint64_t>(verifier, VT_PEAK_SIZE) &&
+           VerifyOffset(verifier, VT_VALUE_NAMES) &&
+           verifier.VerifyVector(value_names()) &&
+           verifier.VerifyVectorOfStrings(value_names()) &&
+           VerifyOffset(verifier, VT_OFFSETS) &&
+           verifier.VerifyVector(offsets()) &&
+           VerifyOffset(verifier, VT_SIZES) &&
+           verifier.VerifyVector(sizes()) &&
+           verifier.EndTable();
+  }
+};
+
+struct MemoryPatternBuilder {
+  typedef MemoryPattern Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_location_name(flatbuffers::Offset<flatbuffers::String> location_name) {
+    fbb_.AddOffset(MemoryPattern::VT_LOCATION_NAME, location_name);
+  }
+  void add_location_id(int32_t location_id) {
+    fbb_.AddElement<int32_t>(MemoryPattern::VT_LOCATION_ID, location_id, 0);
+  }
+  void add_location_mem_type(int32_t location_mem_type) {
+    fbb_.AddElement<int32_t>(MemoryPattern::VT_LOCATION_MEM_TYPE, location_mem_type, 0);
+  }
+  void add_location_alloc_type(int32_t location_alloc_type) {
+    fbb_.AddElement<int32_t>(MemoryPattern::VT_LOCATION_ALLOC_TYPE, location_alloc_type, 0);
+  }
+  void add_device_type(int8_t device_type) {
+    fbb_.AddElement<int8_t>(MemoryPattern::VT_DEVICE_TYPE, device_type, 0);
+  }
+  void add_device_mem_type(int8_t device_mem_type) {
+    fbb_.AddElement<int8_t>(MemoryPattern::VT_DEVICE_MEM_TYPE, device_mem_type, 0);
+  }
+  void add_device_id(int16_t device_id) {
+    fbb_.AddElement<int16_t>(MemoryPattern::VT_DEVICE_ID, device_id, 0);
+  }
+  void add_peak_size(uint64_t peak_size) {
+    fbb_.AddElement<uint64_t>(MemoryPattern::VT_PEAK_SIZE, peak_size, 0);
+  }
+  void add_value_names(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> value_names) {
+    fbb_.AddOffset(MemoryPattern::VT_VALUE_NAMES, value_names);
+  }
+  void add_offsets(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> offsets) {
+    fbb_.AddOffset(MemoryPattern::VT_OFFSETS, offsets);
+  }
+  void add_sizes(flatbuffers::Offset<flatbuffers::Vector<uint64_t>> sizes) {
+    fbb_.AddOffset(MemoryPattern::VT_SIZES, sizes);
+  }
+  explicit MemoryPatternBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  MemoryPatternBuilder &operator=(const MemoryPatternBuilder &);
+  flatbuffers::Offset<MemoryPattern> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<MemoryPattern>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<MemoryPattern> CreateMemoryPattern(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::String> location_name = 0,
+    int32_t location_id = 0,
+    int32_t location_mem_type = 0,
+    int32_t location_alloc_type = 0,
+    int8_t device_type = 0,
+    int8_t device_mem_type = 0,
+    int16_t device_id = 0,
+    uint64_t peak_size = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<flatbuffers::String>>> value_names = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> offsets = 0,
+    flatbuffers::Offset<flatbuffers::Vector<uint64_t>> sizes = 0) {
+  MemoryPatternBuilder builder_(_fbb);
+  builder_.add_peak_size(peak_size);
+  builder_.add_sizes(sizes);
+  builder_.add_offsets(offsets);
+  builder_.add_value_names(value_names);
+  builder_.add_location_alloc_type(location_alloc_type);
+  builder_.add_location_mem_type(location_mem_type);
+  builder_.add_location_id(location_id);
+  builder_.add_location_name(location_name);
+  builder_.add_device_id(device_id);
+  builder_.add_device_mem_type(device_mem_type);
+  builder_.add_device_type(device_type);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<MemoryPattern> CreateMemoryPatternDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const char *location_name = nullptr,
+    int32_t location_id = 0,
+    int32_t location_mem_type = 0,
+    int32_t location_alloc_type = 0,
+    int8_t device_type = 0,
+    int8_t device_mem_type = 0,
+    int16_t device_id = 0,
+    uint64_t peak_size = 0,
+    const std::vector<flatbuffers::Offset<flatbuffers::String>> *value_names = nullptr,
+    const std::vector<uint64_t> *offsets = nullptr,
+    const std::vector<uint64_t> *sizes = nullptr) {
+  auto location_name__ = location_name ? _fbb.CreateString(location_name) : 0;
+  auto value_names__ = value_names ? _fbb.CreateVector<flatbuffers::Offset<flatbuffers::String>>(*value_names) : 0;
+  auto offsets__ = offsets ? _fbb.CreateVector<uint64_t>(*offsets) : 0;
+  auto sizes__ = sizes ? _fbb.CreateVector<uint64_t>(*sizes) : 0;
+  return onnxruntime::fbs::CreateMemoryPattern(
+      _fbb,
+      location_name__,
+      location_id,
+      location_mem_type,
+      location_alloc_type,
+      device_type,
+      device_mem_type,
+      device_id,
+      peak_size,
+      value_names__,
+      offsets__,
+      sizes__);
+}
+
+struct SessionMemoryPatterns FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
+  typedef SessionMemoryPatternsBuilder Builder;
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_INPUT_DIMS = 4,
+    VT_PATTERNS = 6
+  };
+  const flatbuffers::Vector<int64_t> *input_dims() const {
+    return GetPointer<const flatbuffers::Vector<int64_t> *>(VT_INPUT_DIMS);
+  }
+  const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::MemoryPattern>> *patterns() const {
+    return GetPointer<const flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::MemoryPattern>> *>(VT_PATTERNS);
+  }
+  bool Verify(flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_INPUT_DIMS) &&
+           verifier.VerifyVector(input_dims()) &&
+           VerifyOffset(verifier, VT_PATTERNS) &&
+           verifier.VerifyVector(patterns()) &&
+           verifier.VerifyVectorOfTables(patterns()) &&
+           verifier.EndTable();
+  }
+};
+
+struct SessionMemoryPatternsBuilder {
+  typedef SessionMemoryPatterns Table;
+  flatbuffers::FlatBufferBuilder &fbb_;
+  flatbuffers::uoffset_t start_;
+  void add_input_dims(flatbuffers::Offset<flatbuffers::Vector<int64_t>> input_dims) {
+    fbb_.AddOffset(SessionMemoryPatterns::VT_INPUT_DIMS, input_dims);
+  }
+  void add_patterns(flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::MemoryPattern>>> patterns) {
+    fbb_.AddOffset(SessionMemoryPatterns::VT_PATTERNS, patterns);
+  }
+  explicit SessionMemoryPatternsBuilder(flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  SessionMemoryPatternsBuilder &operator=(const SessionMemoryPatternsBuilder &);
+  flatbuffers::Offset<SessionMemoryPatterns> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = flatbuffers::Offset<SessionMemoryPatterns>(end);
+    return o;
+  }
+};
+
+inline flatbuffers::Offset<SessionMemoryPatterns> CreateSessionMemoryPatterns(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    flatbuffers::Offset<flatbuffers::Vector<int64_t>> input_dims = 0,
+    flatbuffers::Offset<flatbuffers::Vector<flatbuffers::Offset<onnxruntime::fbs::MemoryPattern>>> patterns = 0) {
+  SessionMemoryPatternsBuilder builder_(_fbb);
+  builder_.add_patterns(patterns);
+  builder_.add_input_dims(input_dims);
+  return builder_.Finish();
+}
+
+inline flatbuffers::Offset<SessionMemoryPatterns> CreateSessionMemoryPatternsDirect(
+    flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<int64_t> *input_dims = nullptr,
+    const std::vector<flatbuffers::Offset<onnxruntime::fbs::MemoryPattern>> *patterns = nullptr) {
+  auto input_dims__ = input_dims ? _fbb.CreateVector<int64_t>(*input_dims) : 0;
+  auto patterns__ = patterns ? _fbb.CreateVector<flatbuffers::Offset<onnxruntime::fbs::MemoryPattern>>(*patterns) : 0;
+  return onnxruntime::fbs::CreateSessionMemoryPatterns(
+      _fbb,
+      input_dims__,
+      patterns__);
+}
+
 struct InferenceSession FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   typedef InferenceSessionBuilder Builder;
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_ORT_VERSION = 4,
     VT_MODEL = 6,
-    VT_KERNEL_TYPE_STR_RESOLVER = 10
+    VT_KERNEL_TYPE_STR_RESOLVER = 10,
+    VT_MEMORY_PATTERNS = 12
   };
   const flatbuffers::String *ort_version() const {
     return GetPointer<const flatbuffers::String *>(VT_ORT_VERSION);
@@ -2983,6 +3236,9 @@ struct InferenceSession FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
   const onnxruntime::fbs::KernelTypeStrResolver *kernel_type_str_resolver() const {
     return GetPointer<const onnxruntime::fbs::KernelTypeStrResolver *>(VT_KERNEL_TYPE_STR_RESOLVER);
   }
+  const onnxruntime::fbs::SessionMemoryPatterns *memory_patterns() const {
+    return GetPointer<const onnxruntime::fbs::SessionMemoryPatterns *>(VT_MEMORY_PATTERNS);
+  }
   bool Verify(flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyOffset(verifier, VT_ORT_VERSION) &&
@@ -2991,6 +3247,8 @@ struct InferenceSession FLATBUFFERS_FINAL_CLASS : private flatbuffers::Table {
            verifier.VerifyTable(model()) &&
            VerifyOffset(verifier, VT_KERNEL_TYPE_STR_RESOLVER) &&
            verifier.VerifyTable(kernel_type_str_resolver()) &&
+           VerifyOffset(verifier, VT_MEMORY_PATTERNS) &&
+           verifier.VerifyTable(memory_patterns()) &&
            verifier.EndTable();
   }
 };
@@ -3008,6 +3266,9 @@ struct InferenceSessionBuilder {
   void add_kernel_type_str_resolver(flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver) {
     fbb_.AddOffset(InferenceSession::VT_KERNEL_TYPE_STR_RESOLVER, kernel_type_str_resolver);
   }
+  void add_memory_patterns(flatbuffers::Offset<onnxruntime::fbs::SessionMemoryPatterns> memory_patterns) {
+    fbb_.AddOffset(InferenceSession::VT_MEMORY_PATTERNS, memory_patterns);
+  }
   explicit InferenceSessionBuilder(flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -3024,8 +3285,10 @@ inline flatbuffers::Offset<InferenceSession> CreateInferenceSession(
     flatbuffers::FlatBufferBuilder &_fbb,
     flatbuffers::Offset<flatbuffers::String> ort_version = 0,
     flatbuffers::Offset<onnxruntime::fbs::Model> model = 0,
-    flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0) {
+    flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0,
+    flatbuffers::Offset<onnxruntime::fbs::SessionMemoryPatterns> memory_patterns = 0) {
   InferenceSessionBuilder builder_(_fbb);
+  builder_.add_memory_patterns(memory_patterns);
   builder_.add_kernel_type_str_resolver(kernel_type_str_resolver);
   builder_.add_model(model);
   builder_.add_ort_version(ort_version);
@@ -3036,13 +3299,15 @@ inline flatbuffers::Offset<InferenceSession> CreateInferenceSessionDirect(
     flatbuffers::FlatBufferBuilder &_fbb,
     const char *ort_version = nullptr,
     flatbuffers::Offset<onnxruntime::fbs::Model> model = 0,
-    flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0) {
+    flatbuffers::Offset<onnxruntime::fbs::KernelTypeStrResolver> kernel_type_str_resolver = 0,
+    flatbuffers::Offset<onnxruntime::fbs::SessionMemoryPatterns> memory_patterns = 0) {
   auto ort_version__ = ort_version ? _fbb.CreateString(ort_version) : 0;
   return onnxruntime::fbs::CreateInferenceSession(
       _fbb,
       ort_version__,
       model,
-      kernel_type_str_resolver);
+      kernel_type_str_resolver,
+      memory_patterns);
 }
 
 inline bool VerifyTypeInfoValue(flatbuffers::Verifier &verifier, const void *obj, TypeInfoValue type) {
@@ -4,12 +4,18 @@
 #pragma once
 
 #include "core/framework/tensor.h"
+#include <iterator>
+#include <memory>
 #include <vector>
 #include <utility>
 
 namespace onnxruntime {
 // Put this in a separate file to avoid circular dependency between tensor.h and data_types.h
 // Data type to represent a sequence of tensors of the same type
+//
+// The tensors are ref-counted so that sequences can share them, e.g. SequenceInsert shares the tensors of its input
+// sequence with its output sequence instead of copying them. A tensor must not be modified once it is added, as
+// other sequences may hold it.
 class TensorSeq {
  public:
   TensorSeq() = default;
@@ -17,7 +23,37 @@ class TensorSeq {
     SetType(elem_type);
   }
 
-  using const_iterator = std::vector<Tensor>::const_iterator;
+  // Iterates over the tensors of the sequence
+  class const_iterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Tensor;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Tensor*;
+    using reference = const Tensor&;
+
+    explicit const_iterator(std::vector<std::shared_ptr<Tensor>>::const_iterator iter) noexcept : iter_(iter) {}
+
+    reference operator*() const noexcept { return **iter_; }
+    pointer operator->() const noexcept { return iter_->get(); }
+
+    const_iterator& operator++() noexcept {
+      ++iter_;
+      return *this;
+    }
+
+    const_iterator operator++(int) noexcept {
+      const_iterator result = *this;
+      ++iter_;
+      return result;
+    }
+
+    bool operator==(const const_iterator& other) const noexcept { return iter_ == other.iter_; }
+    bool operator!=(const const_iterator& other) const noexcept { return iter_ != other.iter_; }
+
+   private:
+    std::vector<std::shared_ptr<Tensor>>::const_iterator iter_;
+  };
 
   // Sets the element type after construction.
   // Expects sequence to be empty at the time.
@@ -32,7 +68,10 @@ class TensorSeq {
     // (1) `elem_type` is set before invoking this method
     // (2) All tensors contain elements of the same primitive data type
     assert(tensors_.empty());
-    tensors_ = std::move(tensors);
+    tensors_.reserve(tensors.size());
+    for (auto& tensor : tensors) {
+      tensors_.push_back(std::make_shared<Tensor>(std::move(tensor)));
+    }
   }
 
   MLDataType DataType() const noexcept { return elem_type_; }
@@ -49,15 +88,21 @@ class TensorSeq {
 
   // Suitable for for range loop
   const_iterator begin() const noexcept {
-    return tensors_.cbegin();
+    return const_iterator(tensors_.cbegin());
   }
 
   const_iterator end() const noexcept {
-    return tensors_.cend();
+    return const_iterator(tensors_.cend());
   }
 
   // Get by index
   const Tensor& Get(size_t i) const {
+    ORT_ENFORCE(i < tensors_.size());
+    return *tensors_[i];
+  }
+
+  // Get by index, for adding the tensor to another sequence without copying it
+  const std::shared_ptr<Tensor>& GetShared(size_t i) const {
     ORT_ENFORCE(i < tensors_.size());
     return tensors_[i];
   }
@@ -65,6 +110,13 @@ class TensorSeq {
   void Add(Tensor&& tensor) {
     ORT_ENFORCE(IsSameDataType(tensor),
                 "TensorSeq: tensor to be added has a different data type.");
+    tensors_.push_back(std::make_shared<Tensor>(std::move(tensor)));
+  }
+
+  // Adds a tensor that is shared with another sequence
+  void Add(std::shared_ptr<Tensor> tensor) {
+    ORT_ENFORCE(tensor != nullptr && IsSameDataType(*tensor),
+                "TensorSeq: tensor to be added has a different data type.");
     tensors_.push_back(std::move(tensor));
   }
 
@@ -82,7 +134,7 @@ class TensorSeq {
 
   // TODO: optimization opportunity - if all tensors in the seq are scalars, we can potentially represent them
   // as vector<primitive type>
-  std::vector<Tensor> tensors_;
+  std::vector<std::shared_ptr<Tensor>> tensors_;
 };
 
 }  // namespace onnxruntime
@@ -180,6 +180,12 @@ class PlannerImpl {
   InlinedHashMap<onnxruntime::OrtValueIndex, InlinedHashSet<onnxruntime::NodeIndex>> value_consumer_map_;
   InlinedHashMap<onnxruntime::OrtValueIndex, onnxruntime::NodeIndex> value_node_map_;
 
+  // sub_views_[value] = {owner, offset} if value is planned as a view at byte offset into the buffer of owner,
+  // e.g. an input of a Concat that is produced directly into the Concat output. See ComputeSubViews().
+  InlinedHashMap<OrtValueIndex, std::pair<OrtValueIndex, size_t>> sub_views_;
+  // values whose buffer hosts sub-views. they always get their own allocation.
+  InlinedHashSet<OrtValueIndex> sub_view_owners_;
+
   // OrtValueInfo: Auxiliary information about an OrtValue used only during plan-generation:
   struct OrtValueInfo {
     const onnxruntime::NodeArg* p_def_site;  // the (unique) NodeArg corresponding to the MLValue
@@ -279,6 +285,21 @@ class PlannerImpl {
     auto& symplan = AllocPlan(reused_for);
     symplan.alloc_kind = alloc_kind;
     symplan.reused_buffer = original;
+
+    // reusing a sub-view means reusing the same part of the original buffer
+    const auto& reused_plan = AllocPlan(reused);
+    if (alloc_kind == AllocKind::kReuse && reused_plan.is_sub_view) {
+      symplan.is_sub_view = true;
+      symplan.sub_view_offset = reused_plan.sub_view_offset;
+    }
+  }
+
+  // offset is relative to owner, which may itself be a sub-view (e.g. a Split of a Split output)
+  void ReuseAsSubView(OrtValueIndex owner, OrtValueIndex reused_for, size_t offset) {
+    Reuse(owner, reused_for, AllocKind::kReuse);
+    auto& symplan = AllocPlan(reused_for);
+    symplan.sub_view_offset = symplan.is_sub_view ? symplan.sub_view_offset + offset : offset;
+    symplan.is_sub_view = true;
   }
 
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
@@ -1299,6 +1320,177 @@ class PlannerImpl {
   }
 #endif
 
+  // Size in bytes of a non-string tensor with a static shape.
+  bool GetStaticSizeInBytes(const NodeArg& arg, size_t& size_in_bytes) const {
+    if (!arg.Exists() || IsNonTensor(arg) ||
+        arg.TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+      return false;
+    }
+    const auto* shape = context_->GetShape(arg);
+    if (shape == nullptr) return false;
+    SafeInt<size_t> size = GetElementSize(arg.Type());
+    for (const auto& dim : shape->dim()) {
+      if (!utils::HasDimValue(dim) || dim.dim_value() <= 0) return false;
+      size *= dim.dim_value();
+    }
+    size_in_bytes = size;
+    return true;
+  }
+
+  // True if all the dims of arg before axis are 1, i.e. slices along axis are contiguous blocks of the buffer.
+  // axis is normalized with the rank of arg.
+  bool IsOuterDimsOne(const NodeArg& arg, int64_t& axis) const {
+    const auto* shape = context_->GetShape(arg);
+    if (shape == nullptr) return false;
+    const int64_t rank = shape->dim_size();
+    if (axis < 0) axis += rank;
+    if (axis < 0 || axis >= rank) return false;
+    for (int64_t i = 0; i < axis; ++i) {
+      const auto& dim = shape->dim(static_cast<int>(i));
+      if (!utils::HasDimValue(dim) || dim.dim_value() != 1) return false;
+    }
+    return true;
+  }
+
+  static int64_t GetAxisAttribute(const Node& node) {
+    const auto& attrs = node.GetAttributes();
+    auto it = attrs.find("axis");
+    return it == attrs.end() ? 0 : it->second.i();
+  }
+
+  // Plan the inputs of a Concat as views on the parts of the Concat output they are copied to, so their producers
+  // write in place and the Concat has nothing to copy, and the outputs of a Split as views on the parts of the
+  // Split input they are copied from. Only applies if each part is a contiguous block of the buffer, i.e. all the
+  // dims before the axis are 1, and all the shapes are static so that the offsets are known at planning time.
+  // Limited to the CPU EP, whose Concat and Split kernels detect the views and skip the copies, and to sequential
+  // single stream execution with memory reuse.
+  void ComputeSubViews() {
+    sub_views_.clear();
+    sub_view_owners_.clear();
+    if (!context_->GetEnableMemoryReuse() || context_->IsParallelExecutionEnabled() || !IsSingleStream() ||
+        stream_nodes_.empty()) {
+      return;
+    }
+
+    const auto& graph_outputs = graph_viewer_.GetOutputs();
+    auto is_graph_output = [&graph_outputs](const NodeArg* arg) {
+      return std::find(graph_outputs.begin(), graph_outputs.end(), arg) != graph_outputs.end();
+    };
+
+    InlinedHashMap<OrtValueIndex, int> consumer_counts;
+    for (auto node_index : stream_nodes_[0]) {
+      const auto* node = graph_viewer_.GetNode(node_index);
+      for (const auto* arg : node->InputDefs()) {
+        if (arg->Exists()) ++consumer_counts[Index(arg->Name())];
+      }
+      for (const auto* arg : node->ImplicitInputDefs()) {
+        if (arg->Exists()) ++consumer_counts[Index(arg->Name())];
+      }
+    }
+
+    // an intermediate value that is consumed only by the Concat or Split
+    auto get_single_use_producer = [&](const NodeArg& arg) -> const Node* {
+      const auto index = Index(arg.Name());
+      if (is_graph_output(&arg) || consumer_counts[index] != 1) return nullptr;
+      auto producer_it = value_node_map_.find(index);
+      if (producer_it == value_node_map_.end()) return nullptr;
+      const auto* producer = graph_viewer_.GetNode(producer_it->second);
+      return producer != nullptr && !HasExternalOutputs(*producer) ? producer : nullptr;
+    };
+
+#ifdef ENABLE_STRIDED_TENSORS
+    // a strided view on another buffer has no contiguous parts
+    auto may_be_strided = [&](const NodeArg& arg, const Node& producer) {
+      const KernelCreateInfo& ci = GetKernelCreateInfo(kernel_create_info_map_, producer.Index());
+      if (ci.kernel_def == nullptr) return false;
+      const auto output_defs = producer.OutputDefs();
+      for (const auto& pair : ci.kernel_def->MayStridedOutput()) {
+        if (pair.second >= 0 && static_cast<size_t>(pair.second) < output_defs.size() &&
+            output_defs[pair.second] == &arg) {
+          return true;
+        }
+      }
+      return false;
+    };
+#endif
+
+    // a Concat input must be a plain output of a CPU kernel for the kernel to write it to the part of the owner
+    auto can_produce_in_place = [&](const NodeArg& arg, const NodeArg& whole) {
+      const auto index = Index(arg.Name());
+      if (sub_views_.count(index) > 0 || sub_view_owners_.count(index) > 0) return false;
+      const auto* producer = get_single_use_producer(arg);
+      if (producer == nullptr || producer->GetExecutionProviderType() != kCpuExecutionProvider ||
+          producer->ContainsSubgraph()) {
+        return false;
+      }
+      const KernelCreateInfo& ci = GetKernelCreateInfo(kernel_create_info_map_, producer->Index());
+      if (ci.kernel_def == nullptr || ci.kernel_def->VariadicAlias().has_value()) return false;
+      const auto output_defs = producer->OutputDefs();
+      for (const auto& pair : ci.kernel_def->Alias()) {
+        if (pair.second >= 0 && static_cast<size_t>(pair.second) < output_defs.size() &&
+            output_defs[pair.second] == &arg) {
+          return false;
+        }
+      }
+      return AllocPlan(index).location == AllocPlan(whole.Name()).location &&
+             arg.TypeAsProto()->tensor_type().elem_type() == whole.TypeAsProto()->tensor_type().elem_type();
+    };
+
+    for (auto node_index : stream_nodes_[0]) {
+      const auto* node = graph_viewer_.GetNode(node_index);
+      if (node->GetExecutionProviderType() != kCpuExecutionProvider || !node->Domain().empty() ||
+          HasExternalOutputs(*node)) {
+        continue;
+      }
+      const bool is_concat = node->OpType() == "Concat";
+      if (!is_concat && node->OpType() != "Split") continue;
+
+      // the buffer that is split into parts, and the values planned on the parts
+      const NodeArg* whole = is_concat ? node->OutputDefs()[0] : node->InputDefs()[0];
+      InlinedVector<const NodeArg*> parts;
+      for (const auto* part : is_concat ? node->InputDefs() : node->OutputDefs()) {
+        parts.push_back(part);
+      }
+
+      size_t whole_size = 0;
+      int64_t axis = GetAxisAttribute(*node);
+      if (!whole->Exists() || !GetStaticSizeInBytes(*whole, whole_size) || !IsOuterDimsOne(*whole, axis) ||
+          is_graph_output(whole)) {
+        continue;
+      }
+      if (!is_concat) {
+        const auto* producer = get_single_use_producer(*whole);
+        if (producer == nullptr) continue;
+#ifdef ENABLE_STRIDED_TENSORS
+        if (may_be_strided(*whole, *producer)) continue;
+#endif
+      }
+      const auto owner = Index(whole->Name());
+      const auto& owner_location = AllocPlan(owner).location;
+
+      InlinedVector<std::pair<OrtValueIndex, size_t>> offsets;
+      size_t offset = 0;
+      bool ok = true;
+      for (const auto* part : parts) {
+        size_t part_size = 0;
+        if (!part->Exists() || !GetStaticSizeInBytes(*part, part_size) ||
+            (is_concat ? !can_produce_in_place(*part, *whole)
+                       : is_graph_output(part) || !(AllocPlan(part->Name()).location == owner_location))) {
+          ok = false;
+          break;
+        }
+        offsets.emplace_back(Index(part->Name()), offset);
+        offset += part_size;
+      }
+      if (!ok || offset != whole_size) continue;
+
+      for (const auto& entry : offsets) {
+        sub_views_[entry.first] = {owner, entry.second};
+      }
+      if (is_concat) sub_view_owners_.insert(owner);
+    }
+  }
+
   Status ComputeReusePlan() {
     gsl::not_null<const ISequentialPlannerContext*> backup_context = context_;
     SequentialPlannerContext no_mem_reuse_context(ExecutionMode::ORT_PARALLEL, ExecutionOrder::DEFAULT, false);
@@ -1311,6 +1503,7 @@ class PlannerImpl {
     std::vector<int> ort_value_usecount;
     ort_value_usecount.reserve(ort_value_info_.size());
 #endif
+    ComputeSubViews();
     for (size_t i = 0; i < stream_nodes_.size(); ++i) {
       // compute use count first
       ORT_RETURN_IF_ERROR(ComputeReuseCount());
@@ -1406,6 +1599,11 @@ class PlannerImpl {
               }
             }
           }
+        } else if (auto sub_view_it = sub_views_.find(current); sub_view_it != sub_views_.end()) {
+          // planned as a part of a Concat output or a Split input in ComputeSubViews()
+          ReuseAsSubView(sub_view_it->second.first, current, sub_view_it->second.second);
+        } else if (sub_view_owners_.count(current) > 0) {
+          AllocPlan(current).alloc_kind = AllocKind::kAllocate;
         } else if (!context_->IsParallelExecutionEnabled() &&
                    FindReusableInput(*pnode, static_cast<int>(output_arg_def_index), &reused, &is_strided_tensor)) {
           // Re-using inputs is applicable for tensors, sequence tensors,
@@ -1490,8 +1688,12 @@ class PlannerImpl {
         if (!node_output->Exists()) continue;
         // OrtValue index of the considered output NodeArg.
         const auto current = Index(node_output->Name());
-        if (AllocPlan(current).alloc_kind == AllocKind::kAllocate) {
-          AllocPlan(current).program_counter.AddStart(program_counter);
+        // the buffer of a sub-view owner is allocated by the producer of its first sub-view
+        const auto& current_plan = AllocPlan(current);
+        auto& alloc_plan = current_plan.is_sub_view ? AllocPlan(current_plan.reused_buffer) : AllocPlan(current);
+        if (alloc_plan.alloc_kind == AllocKind::kAllocate &&
+            alloc_plan.program_counter.Starts().size() == alloc_plan.program_counter.Ends().size()) {
+          alloc_plan.program_counter.AddStart(program_counter);
         }
       }
 
@@ -1747,7 +1949,9 @@ class PlannerImpl {
   void
   PartitionIntoStreams(const logging::Logger& logger, const ExecutionProviders& execution_providers,
                        const std::string& partition_config_file) {
-    auto partitioner = IGraphPartitioner::CreateGraphPartitioner(logger, partition_config_file);
+    auto partitioner = IGraphPartitioner::CreateGraphPartitioner(logger, partition_config_file,
+                                                                 context_->GetMaxCpuStreams(),
+                                                                 context_->GetMaxGpuStreams());
     auto status = partitioner->PartitionGraph(graph_viewer_, execution_providers, stream_nodes_, context_->GetExecutionOrder());
     ORT_ENFORCE(status.IsOK(), status.ErrorMessage());
     node_stream_map_.resize(SafeInt<size_t>(graph_viewer_.MaxNodeIndex()) + 1);
@@ -2210,7 +2414,11 @@ InlinedHashMap<std::string, IGraphPartitioner::GraphPartitioningStrategy>
 
 class DeviceBasedPartitioner : public IGraphPartitioner {
  public:
-  DeviceBasedPartitioner(const logging::Logger& logger, const std::string& configuration_file) : IGraphPartitioner(logger, configuration_file) {
+  DeviceBasedPartitioner(const logging::Logger& logger, const std::string& configuration_file, int max_cpu_streams,
+                         int max_gpu_streams)
+      : IGraphPartitioner(logger, configuration_file),
+        max_cpu_streams_(max_cpu_streams),
+        max_gpu_streams_(max_gpu_streams) {
     Initialize();
   }
   ~DeviceBasedPartitioner() {
@@ -2225,9 +2433,19 @@ class DeviceBasedPartitioner : public IGraphPartitioner {
   }
 
  private:
+  // the logic streams of a device whose nodes are partitioned by graph branch, with the last node of each stream
+  struct BranchStreams {
+    InlinedVector<int> streams;
+    InlinedVector<NodeIndex> tails;
+  };
+
   void Initialize();
   void Reset();
+  int AssignBranchStream(const Node& node, const InlinedHashMap<NodeIndex, int>& node_to_stream,
+                         BranchStreams& branch_streams, int max_branch_streams);
   int num_streams_{};
+  int max_cpu_streams_{1};
+  int max_gpu_streams_{1};
   std::map<OrtDevice::DeviceType, int> max_streams_;
   std::vector<InlinedVector<std::string>> node_names_by_stream_;
   bool need_dump_ = false;
@@ -2333,6 +2551,46 @@ void DeviceBasedPartitioner::DumpPartition() const {
   }
 }
 
+// Pick the logic stream of a node when partitioning the nodes of its device by graph branch.
+// A node continues the stream of an input node if that input node is the last node of its stream, i.e. it extends
+// a chain. Otherwise the node starts a new branch, which gets a new stream until max_branch_streams is reached,
+// after which it shares the stream holding the fewest nodes.
+int DeviceBasedPartitioner::AssignBranchStream(const Node& node, const InlinedHashMap<NodeIndex, int>& node_to_stream,
+                                               BranchStreams& branch_streams, int max_branch_streams) {
+  auto& streams = branch_streams.streams;
+  auto& tails = branch_streams.tails;
+  for (auto it = node.InputNodesBegin(); it != node.InputNodesEnd(); ++it) {
+    auto producer = node_to_stream.find(it->Index());
+    if (producer == node_to_stream.end()) {
+      continue;
+    }
+    auto stream = std::find(streams.begin(), streams.end(), producer->second);
+    if (stream != streams.end()) {
+      auto offset = std::distance(streams.begin(), stream);
+      if (tails[offset] == it->Index()) {
+        tails[offset] = node.Index();
+        return *stream;
+      }
+    }
+  }
+
+  if (static_cast<int>(streams.size()) < max_branch_streams) {
+    streams.push_back(static_cast<int>(node_names_by_stream_.size()));
+    tails.push_back(node.Index());
+    node_names_by_stream_.push_back({});
+    return streams.back();
+  }
+
+  size_t offset = 0;
+  for (size_t i = 1; i < streams.size(); ++i) {
+    if (node_names_by_stream_[streams[i]].size() < node_names_by_stream_[streams[offset]].size()) {
+      offset = i;
+    }
+  }
+  tails[offset] = node.Index();
+  return streams[offset];
+}
+
 Status DeviceBasedPartitioner::PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
                                               const ExecutionProviders& execution_providers,
                                               std::vector<InlinedVector<NodeIndex>>& stream_nodes,
@@ -2341,8 +2599,10 @@ Status DeviceBasedPartitioner::PartitionGraph(const onnxruntime::GraphViewer& gr
   auto& p_graph_nodes = graph_viewer.GetNodesInTopologicalOrder(execution_order);
 
   if (max_streams_.empty() && node_names_by_stream_.empty()) {  // input configure empty, do it from scratch
-    // partition by ep, each has one stream
+    // partition by ep, each has one stream, unless the nodes of the device are allowed to spread over multiple streams
     InlinedHashMap<OrtDevice::DeviceType, int> device_to_stream;
+    InlinedHashMap<OrtDevice::DeviceType, BranchStreams> device_branch_streams;
+    InlinedHashMap<NodeIndex, int> node_to_stream;
     for (auto node_index : p_graph_nodes) {
       const auto* node = graph_viewer.GetNode(node_index);
       const auto& op_type = node->OpType();
@@ -2350,19 +2610,31 @@ Status DeviceBasedPartitioner::PartitionGraph(const onnxruntime::GraphViewer& gr
       auto* ep = execution_providers.Get(*node);
       auto& device_mem_location = ep->GetAllocator(ep->GetDeviceId(), OrtMemType::OrtMemTypeDefault)->Info();
       auto device_type = device_mem_location.device.Type();
-      if (max_streams_.find(device_mem_location.device.Type()) == max_streams_.end()) {
-        max_streams_[device_type] = 1;
-      }
-      auto it = device_to_stream.find(device_type);
-      if (it == device_to_stream.end()) {
-        device_to_stream[device_type] = static_cast<int>(node_names_by_stream_.size());
-        node_names_by_stream_.push_back({});
-        it = device_to_stream.find(device_type);
+      const int max_branch_streams = device_type == OrtDevice::CPU   ? max_cpu_streams_
+                                     : device_type == OrtDevice::GPU ? max_gpu_streams_
+                                                                     : 1;
+      int stream_idx;
+      if (max_branch_streams > 1) {
+        auto& branch_streams = device_branch_streams[device_type];
+        stream_idx = AssignBranchStream(*node, node_to_stream, branch_streams, max_branch_streams);
+        max_streams_[device_type] = static_cast<int>(branch_streams.streams.size());
+      } else {
+        if (max_streams_.find(device_mem_location.device.Type()) == max_streams_.end()) {
+          max_streams_[device_type] = 1;
+        }
+        auto it = device_to_stream.find(device_type);
+        if (it == device_to_stream.end()) {
+          device_to_stream[device_type] = static_cast<int>(node_names_by_stream_.size());
+          node_names_by_stream_.push_back({});
+          it = device_to_stream.find(device_type);
+        }
+        stream_idx = it->second;
       }
+      node_to_stream[node_index] = stream_idx;
       if (node_name.empty()) {
-        node_names_by_stream_[it->second].push_back(op_type + std::to_string(op_type_counter[op_type]++));
+        node_names_by_stream_[stream_idx].push_back(op_type + std::to_string(op_type_counter[op_type]++));
       } else {
-        node_names_by_stream_[it->second].push_back(node_name);
+        node_names_by_stream_[stream_idx].push_back(node_name);
       }
     }
   }
@@ -2402,7 +2674,10 @@ InlinedVector<std::string> IGraphPartitioner::Split(const std::string& line, cha
   return columns;
 }
 
-std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(const logging::Logger& logger, const std::string& configuration_file) {
+std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(const logging::Logger& logger,
+                                                                             const std::string& configuration_file,
+                                                                             int max_cpu_streams,
+                                                                             int max_gpu_streams) {
   std::string cfg_file = configuration_file;
   IGraphPartitioner::GraphPartitioningStrategy partitioner_type = IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition;
   if (!cfg_file.empty()) {
@@ -2423,7 +2698,7 @@ std::unique_ptr<IGraphPartitioner> IGraphPartitioner::CreateGraphPartitioner(con
   }  // else means configuration will not be written to a file
   std::unique_ptr<IGraphPartitioner> graph_partitioner;
   if (partitioner_type == IGraphPartitioner::GraphPartitioningStrategy::DeviceBasedPartition) {
-    graph_partitioner = std::make_unique<DeviceBasedPartitioner>(logger, cfg_file);
+    graph_partitioner = std::make_unique<DeviceBasedPartitioner>(logger, cfg_file, max_cpu_streams, max_gpu_streams);
   }
 
   return graph_partitioner;
@@ -45,15 +45,27 @@ class ISequentialPlannerContext {
   virtual ExecutionOrder GetExecutionOrder() const { return ExecutionOrder::DEFAULT; }
 
   virtual bool GetEnableMemoryReuse() const { return true; }
+
+  // The maximum number of logic streams the CPU nodes may be partitioned into.
+  // If it is larger than 1, independent branches of the graph are placed on separate streams so they can be
+  // executed concurrently on the inter-op thread pool.
+  virtual int GetMaxCpuStreams() const { return 1; }
+
+  // The maximum number of logic streams the GPU nodes may be partitioned into.
+  // If it is larger than 1, independent branches are placed on separate device streams so their kernels can overlap.
+  virtual int GetMaxGpuStreams() const { return 1; }
   virtual ~ISequentialPlannerContext() = default;
 };
 
 class SequentialPlannerContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse)
+  SequentialPlannerContext(ExecutionMode execution_mode, ExecutionOrder execution_order, bool enable_memory_reuse,
+                           int max_cpu_streams = 1, int max_gpu_streams = 1)
       : execution_mode_(execution_mode),
         exection_order_(execution_order),
-        enable_memory_reuse_(enable_memory_reuse) {
+        enable_memory_reuse_(enable_memory_reuse),
+        max_cpu_streams_(max_cpu_streams),
+        max_gpu_streams_(max_gpu_streams) {
   }
 
   const ONNX_NAMESPACE::TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
@@ -66,10 +78,16 @@ class SequentialPlannerContext : public ISequentialPlannerContext {
 
   bool GetEnableMemoryReuse() const override { return enable_memory_reuse_; }
 
+  int GetMaxCpuStreams() const override { return max_cpu_streams_; }
+
+  int GetMaxGpuStreams() const override { return max_gpu_streams_; }
+
  private:
   ExecutionMode execution_mode_ = ExecutionMode::ORT_SEQUENTIAL;
   ExecutionOrder exection_order_ = ExecutionOrder::DEFAULT;
   bool enable_memory_reuse_ = true;
+  int max_cpu_streams_ = 1;
+  int max_gpu_streams_ = 1;
 };
 
 #ifdef ENABLE_STREAM
@@ -81,6 +99,8 @@ class IGraphPartitioner {
   // DeviceBasedPartition is the default, who partitions a graph based off device information.
   // i.e., given a graph which has CPU EP nodes, Cuda EP nodes and TRT EP nodes,
   // it will be partitioned as two sequences, one is for CPU EP nodes, another is for TRT and Cuda nodes.
+  // When max_cpu_streams or max_gpu_streams is larger than 1, the nodes of that device are further partitioned by
+  // graph branch, so that independent branches land on different sequences.
   // We will add more optimized partitioner later.
   enum GraphPartitioningStrategy {
     DeviceBasedPartition = 0,
@@ -90,7 +110,9 @@ class IGraphPartitioner {
   // create the partition based on the partition type.
   // perform partition based on the user input when provided.
   static std::unique_ptr<IGraphPartitioner> CreateGraphPartitioner(const logging::Logger& logger,
-                                                                   const std::string& configuration_file = {});
+                                                                   const std::string& configuration_file = {},
+                                                                   int max_cpu_streams = 1,
+                                                                   int max_gpu_streams = 1);
   virtual Status PartitionGraph(const onnxruntime::GraphViewer& graph_viewer,
                                 const ExecutionProviders& execution_providers,
                                 std::vector<InlinedVector<NodeIndex>>& stream_nodes,
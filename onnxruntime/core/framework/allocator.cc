@@ -115,11 +115,8 @@ void CPUAllocator::Free(void* p) {
 void* AllocateBufferWithOptions(std::shared_ptr<IAllocator>& alloc, size_t size, bool use_reserve, Stream* stream, WaitNotificationFn wait_fn) {
   if (use_reserve)
     return alloc->Reserve(size);
-  if (stream && alloc->Info().alloc_type == OrtArenaAllocator) {
-    auto* stream_aware_alloc = StreamAwareArena::FromBFCArena(*static_cast<BFCArena*>(alloc.get()));
-    if (stream_aware_alloc) {
-      return stream_aware_alloc->AllocOnStream(size, stream, wait_fn);
-    }
+  if (stream && alloc->IsStreamAware()) {
+    return alloc->AllocOnStream(size, stream, wait_fn);
   }
   return alloc->Alloc(size);
 }
@@ -5,6 +5,7 @@
 
 #include <string>
 #include <sstream>
+#include <vector>
 
 namespace onnxruntime {
 
@@ -22,6 +23,9 @@ struct AllocatorStats {
                                   // is known. Certain allocator may return 0 to indicate the limit is
                                   // unknown.
   int64_t bytes_limit;
+  int64_t num_thread_cache_allocs;   // Number of allocations served from per-thread caches without taking the arena lock.
+  int64_t num_thread_cache_refills;  // Number of batches of chunks moved from the arena to per-thread caches.
+  int64_t bytes_in_thread_caches;    // Number of bytes held free in per-thread caches. Included in bytes_in_use.
 
   AllocatorStats() { Clear(); }
 
@@ -35,6 +39,9 @@ struct AllocatorStats {
     this->max_alloc_size = 0;
     this->bytes_limit = 0;
     this->total_allocated_bytes = 0;
+    this->num_thread_cache_allocs = 0;
+    this->num_thread_cache_refills = 0;
+    this->bytes_in_thread_caches = 0;
   }
 
   std::string DebugString() const {
@@ -47,8 +54,29 @@ struct AllocatorStats {
        << "NumReserves:              " << this->num_reserves << "\n"
        << "NumArenaExtensions:       " << this->num_arena_extensions << "\n"
        << "NumArenaShrinkages:       " << this->num_arena_shrinkages << "\n"
-       << "MaxAllocSize:             " << this->max_alloc_size << "\n";
+       << "MaxAllocSize:             " << this->max_alloc_size << "\n"
+       << "NumThreadCacheAllocs:     " << this->num_thread_cache_allocs << "\n"
+       << "NumThreadCacheRefills:    " << this->num_thread_cache_refills << "\n"
+       << "BytesInThreadCaches:      " << this->bytes_in_thread_caches << "\n";
     return ss.str();
   }
 };
+
+// How the memory of an arena is split into chunks, to diagnose fragmentation. The chunks are grouped into bins of
+// sizes from bin_size to twice bin_size, and the last bin holds all the larger chunks.
+struct ArenaFragmentationStats {
+  struct Bin {
+    size_t bin_size = 0;
+    int64_t num_free_chunks = 0;  // Number of free chunks of the bin.
+    int64_t free_bytes = 0;       // Number of bytes in the free chunks of the bin.
+    int64_t num_allocs = 0;       // Number of allocations of the window whose rounded size falls into the bin.
+  };
+
+  std::vector<Bin> bins;
+  int64_t num_regions = 0;               // Number of memory regions the arena got from the device allocator.
+  int64_t region_bytes = 0;              // Number of bytes in these regions.
+  int64_t free_bytes = 0;                // Number of bytes in the free chunks of all the bins.
+  int64_t largest_free_chunk_bytes = 0;  // The largest allocation that can be served without extending the arena.
+  int64_t window_num_allocs = 0;         // Number of allocations since the window was last reset.
+};
 }  // namespace onnxruntime
\ No newline at end of file
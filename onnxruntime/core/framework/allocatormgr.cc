@@ -42,6 +42,9 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
     int initial_growth_chunk_size_bytes = info.arena_cfg.initial_growth_chunk_size_bytes == -1
                                               ? BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES
                                               : info.arena_cfg.initial_growth_chunk_size_bytes;
+    int thread_cache_max_chunk_bytes = info.arena_cfg.thread_cache_max_chunk_bytes == -1
+                                           ? BFCArena::DEFAULT_THREAD_CACHE_MAX_CHUNK_BYTES
+                                           : info.arena_cfg.thread_cache_max_chunk_bytes;
     ArenaExtendStrategy arena_extend_str;
     switch (info.arena_cfg.arena_extend_strategy) {
       case static_cast<int>(ArenaExtendStrategy::kSameAsRequested):
@@ -57,24 +60,41 @@ AllocatorPtr CreateAllocator(const AllocatorCreationInfo& info) {
         return nullptr;
     }
 
+    if (info.arena_cfg.shrink_low_usage_percent < 0 || info.arena_cfg.shrink_low_usage_percent > 100) {
+      LOGS_DEFAULT(ERROR) << "Received invalid value of shrink_low_usage_percent "
+                          << info.arena_cfg.shrink_low_usage_percent;
+      return nullptr;
+    }
+
+    std::unique_ptr<BFCArena> arena;
     if (info.use_stream_aware_arena) {
-      return AllocatorPtr(
-          std::make_unique<StreamAwareArena>(std::move(device_allocator),
-                                             max_mem,
-                                             info.enable_cross_stream_reusing,
-                                             arena_extend_str,
-                                             initial_chunk_size_bytes,
-                                             max_dead_bytes_per_chunk,
-                                             initial_growth_chunk_size_bytes));
+      arena = std::make_unique<StreamAwareArena>(std::move(device_allocator),
+                                                 max_mem,
+                                                 info.enable_cross_stream_reusing,
+                                                 arena_extend_str,
+                                                 initial_chunk_size_bytes,
+                                                 max_dead_bytes_per_chunk,
+                                                 initial_growth_chunk_size_bytes);
     } else {
-      return AllocatorPtr(
-          std::make_unique<BFCArena>(std::move(device_allocator),
-                                     max_mem,
-                                     arena_extend_str,
-                                     initial_chunk_size_bytes,
-                                     max_dead_bytes_per_chunk,
-                                     initial_growth_chunk_size_bytes));
+      arena = std::make_unique<BFCArena>(std::move(device_allocator),
+                                         max_mem,
+                                         arena_extend_str,
+                                         initial_chunk_size_bytes,
+                                         max_dead_bytes_per_chunk,
+                                         initial_growth_chunk_size_bytes,
+                                         thread_cache_max_chunk_bytes);
     }
+
+    BFCArena::ShrinkPolicy shrink_policy;
+    shrink_policy.idle_time = std::chrono::milliseconds(std::max(info.arena_cfg.shrink_idle_ms, 0));
+    shrink_policy.low_usage_percent = info.arena_cfg.shrink_low_usage_percent;
+    shrink_policy.low_usage_window = std::chrono::milliseconds(std::max(info.arena_cfg.shrink_window_ms, 0));
+    shrink_policy.retain_bytes = info.arena_cfg.shrink_retain_bytes;
+    if (shrink_policy.IsEnabled()) {
+      arena->SetShrinkPolicy(shrink_policy);
+    }
+
+    return AllocatorPtr(std::move(arena));
   } else {
     return device_allocator;
   }
@@ -3,15 +3,87 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/bfc_arena.h"
+#include "core/common/inlined_containers.h"
 #include <type_traits>
 
 namespace onnxruntime {
+namespace {
+// The thread cache serves allocations in power of two size classes starting at kMinAllocationSize.
+constexpr int kNumThreadCacheClasses = 13;
+
+// A refill takes about this many bytes from the bins, but at least one and at most kMaxThreadCacheBatch chunks.
+constexpr size_t kThreadCacheRefillBytes = 64 * 1024;
+constexpr size_t kMaxThreadCacheBatch = 16;
+
+int64_t NextArenaId() {
+  static std::atomic<int64_t> next_arena_id{0};
+  return next_arena_id.fetch_add(1, std::memory_order_relaxed);
+}
+}  // namespace
+
+struct BFCArena::ThreadCache {
+  struct OwnedChunk {
+    int cache_class;
+    size_t size;
+    bool is_free;
+  };
+
+  // Only accessed by the owning thread, or by the arena under lock_ once the owning thread has exited.
+  std::array<std::vector<void*>, kNumThreadCacheClasses> free_lists;
+  InlinedHashMap<void*, OwnedChunk> owned_chunks;
+
+  // Chunks owned by this cache that were freed on other threads. The owning thread moves them to free_lists.
+  OrtMutex remote_frees_lock;
+  std::vector<void*> remote_frees;
+  std::atomic<bool> has_remote_frees{false};
+
+  // Guards arena, which is cleared when the arena is destroyed before the owning thread exits.
+  OrtMutex arena_lock;
+  BFCArena* arena = nullptr;
+
+  // Read by GetStats on other threads.
+  std::atomic<int64_t> num_allocs{0};
+  std::atomic<int64_t> bytes_free{0};
+
+  static size_t ClassSize(int cache_class) {
+    return kMinAllocationSize << cache_class;
+  }
+
+  static size_t BatchSize(int cache_class) {
+    return std::clamp<size_t>(kThreadCacheRefillBytes / ClassSize(cache_class), 1, kMaxThreadCacheBatch);
+  }
+
+  // Returns true if any chunk was freed on another thread.
+  bool DrainRemoteFrees() {
+    if (!has_remote_frees.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    std::vector<void*> ptrs;
+    {
+      std::lock_guard<OrtMutex> guard(remote_frees_lock);
+      ptrs.swap(remote_frees);
+      has_remote_frees.store(false, std::memory_order_relaxed);
+    }
+
+    for (void* ptr : ptrs) {
+      auto& owned = owned_chunks.at(ptr);
+      owned.is_free = true;
+      free_lists[owned.cache_class].push_back(ptr);
+      bytes_free.fetch_add(static_cast<int64_t>(owned.size), std::memory_order_relaxed);
+    }
+
+    return true;
+  }
+};
+
 BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
                    size_t total_memory,
                    ArenaExtendStrategy arena_extend_strategy,
                    int initial_chunk_size_bytes,
                    int max_dead_bytes_per_chunk,
-                   int initial_growth_chunk_size_bytes)
+                   int initial_growth_chunk_size_bytes,
+                   int thread_cache_max_chunk_bytes)
     : IAllocator(OrtMemoryInfo(resource_allocator->Info().name,
                                OrtAllocatorType::OrtArenaAllocator,
                                resource_allocator->Info().device,
@@ -23,14 +95,22 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
       next_allocation_id_(1),
       initial_chunk_size_bytes_(initial_chunk_size_bytes),
       max_dead_bytes_per_chunk_(max_dead_bytes_per_chunk),
-      initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes) {
+      initial_growth_chunk_size_bytes_(initial_growth_chunk_size_bytes),
+      thread_cache_max_chunk_bytes_(static_cast<size_t>(std::max(thread_cache_max_chunk_bytes, 0))),
+      arena_id_(NextArenaId()) {
   LOGS_DEFAULT(INFO) << "Creating BFCArena for " << device_allocator_->Info().name
                      << " with following configs: initial_chunk_size_bytes: " << initial_chunk_size_bytes_
                      << " max_dead_bytes_per_chunk: " << max_dead_bytes_per_chunk_
                      << " initial_growth_chunk_size_bytes: " << initial_growth_chunk_size_bytes_
+                     << " thread_cache_max_chunk_bytes: " << thread_cache_max_chunk_bytes_
                      << " memory limit: " << total_memory
                      << " arena_extend_strategy: " << static_cast<int32_t>(arena_extend_strategy);
 
+  ORT_ENFORCE(thread_cache_max_chunk_bytes_ <= static_cast<size_t>(MAX_THREAD_CACHE_MAX_CHUNK_BYTES),
+              "thread_cache_max_chunk_bytes must not exceed ", MAX_THREAD_CACHE_MAX_CHUNK_BYTES);
+  static_assert(kMinAllocationSize << (kNumThreadCacheClasses - 1) == MAX_THREAD_CACHE_MAX_CHUNK_BYTES,
+                "The thread cache size classes must cover MAX_THREAD_CACHE_MAX_CHUNK_BYTES");
+
   // static_cast<std::underlying_type_t<ArenaExtendStrategy>>(arena_extend_strategy); doesn't work on this compiler
 
   curr_region_allocation_bytes_ = RoundedBytes(std::min(total_memory, static_cast<size_t>(initial_chunk_size_bytes_)));
@@ -75,6 +155,26 @@ BFCArena::BFCArena(std::unique_ptr<IAllocator> resource_allocator,
 }
 
 BFCArena::~BFCArena() {
+  if (shrink_thread_.joinable()) {
+    {
+      std::lock_guard<OrtMutex> lock(shrink_thread_mutex_);
+      stop_shrink_thread_ = true;
+    }
+    shrink_thread_cv_.notify_all();
+    shrink_thread_.join();
+  }
+
+  // Threads that are still alive keep their caches, so make sure they don't return chunks to this arena.
+  std::vector<std::shared_ptr<ThreadCache>> thread_caches;
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    thread_caches = thread_caches_;
+  }
+  for (const auto& cache : thread_caches) {
+    std::lock_guard<OrtMutex> guard(cache->arena_lock);
+    cache->arena = nullptr;
+  }
+
   for (const auto& region : region_manager_.regions()) {
     device_allocator_->Free(region.ptr());
   }
@@ -247,6 +347,7 @@ void BFCArena::DeallocateChunk(ChunkHandle h) {
   // clean the stream / timestamp when deallocate chunk
   c->stream = nullptr;
   c->stream_timestamp = 0;
+  c->thread_cache = nullptr;
   c->next = free_chunks_list_;
   free_chunks_list_ = h;
 }
@@ -261,9 +362,212 @@ size_t BFCArena::RoundedBytes(size_t bytes) {
 }
 
 void* BFCArena::Alloc(size_t size) {
+  if (size != 0 && size <= thread_cache_max_chunk_bytes_) {
+    return AllocateFromThreadCache(size);
+  }
   return AllocateRawInternal(size, false, nullptr, false, nullptr);
 }
 
+BFCArena::ThreadCache* BFCArena::GetThreadCache(bool create) {
+  // The caches of the calling thread, keyed by arena id. Their chunks go back to the arenas when the thread exits.
+  struct ThreadCaches {
+    InlinedHashMap<int64_t, std::shared_ptr<ThreadCache>> caches;
+
+    ~ThreadCaches() {
+      for (auto& entry : caches) {
+        ThreadCache& cache = *entry.second;
+        std::lock_guard<OrtMutex> guard(cache.arena_lock);
+        if (cache.arena != nullptr) {
+          cache.arena->ReleaseThreadCache(cache);
+        }
+      }
+    }
+  };
+  thread_local ThreadCaches thread_caches;
+
+  auto entry = thread_caches.caches.find(arena_id_);
+  if (entry != thread_caches.caches.end()) {
+    return entry->second.get();
+  }
+
+  if (!create) {
+    return nullptr;
+  }
+
+  // Drop the caches of arenas that were destroyed in the meantime.
+  for (auto it = thread_caches.caches.begin(); it != thread_caches.caches.end();) {
+    std::lock_guard<OrtMutex> guard(it->second->arena_lock);
+    if (it->second->arena == nullptr) {
+      thread_caches.caches.erase(it++);
+    } else {
+      ++it;
+    }
+  }
+
+  auto cache = std::make_shared<ThreadCache>();
+  cache->arena = this;
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    thread_caches_.push_back(cache);
+  }
+
+  return thread_caches.caches.emplace(arena_id_, std::move(cache)).first->second.get();
+}
+
+void* BFCArena::AllocateFromThreadCache(size_t num_bytes) {
+  ThreadCache& cache = *GetThreadCache(true);
+
+  if (cache.DrainRemoteFrees()) {
+    for (int cache_class = 0; cache_class < kNumThreadCacheClasses; ++cache_class) {
+      if (cache.free_lists[cache_class].size() > 2 * ThreadCache::BatchSize(cache_class)) {
+        TrimThreadCache(cache, cache_class, ThreadCache::BatchSize(cache_class));
+      }
+    }
+  }
+
+  // Every chunk of a size class is large enough for any request of the class.
+  const size_t rounded_bytes = RoundedBytes(num_bytes);
+  const int cache_class = rounded_bytes == kMinAllocationSize
+                              ? 0
+                              : Log2FloorNonZero(rounded_bytes - 1) + 1 - static_cast<int>(kMinAllocationBits);
+
+  auto& free_list = cache.free_lists[cache_class];
+  if (free_list.empty()) {
+    RefillThreadCache(cache, cache_class);
+  }
+
+  void* ptr = free_list.back();
+  free_list.pop_back();
+
+  auto& owned = cache.owned_chunks.at(ptr);
+  owned.is_free = false;
+  cache.bytes_free.fetch_sub(static_cast<int64_t>(owned.size), std::memory_order_relaxed);
+  cache.num_allocs.fetch_add(1, std::memory_order_relaxed);
+
+  return ptr;
+}
+
+void BFCArena::RefillThreadCache(ThreadCache& cache, int cache_class) {
+  const size_t class_bytes = ThreadCache::ClassSize(cache_class);
+  const size_t batch_size = ThreadCache::BatchSize(cache_class);
+  const BinNum bin_num = BinNumForSize(class_bytes);
+  auto& free_list = cache.free_lists[cache_class];
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  for (size_t i = 0; i < batch_size; ++i) {
+    auto* chunk = FindChunkPtr(bin_num, class_bytes, class_bytes, nullptr, false);
+    if (chunk == nullptr) {
+      // Only extend the arena for the first chunk of a batch.
+      if (i != 0) {
+        break;
+      }
+
+      auto status = Extend(class_bytes * batch_size);
+      if (!status.IsOK() && batch_size > 1) {
+        status = Extend(class_bytes);
+      }
+      if (!status.IsOK()) {
+        ORT_THROW(status.ErrorMessage());
+      }
+
+      chunk = FindChunkPtr(bin_num, class_bytes, class_bytes, nullptr, false);
+      ORT_ENFORCE(chunk != nullptr,
+                  "Failed to find a free memory block despite calling Extend. rounded_bytes=", class_bytes);
+    }
+
+    chunk->thread_cache = &cache;
+    cache.owned_chunks[chunk->ptr] = ThreadCache::OwnedChunk{cache_class, chunk->size, true};
+    cache.bytes_free.fetch_add(static_cast<int64_t>(chunk->size), std::memory_order_relaxed);
+    free_list.push_back(chunk->ptr);
+  }
+
+  ++stats_.num_thread_cache_refills;
+}
+
+void BFCArena::TrimThreadCache(ThreadCache& cache, int cache_class, size_t keep) {
+  auto& free_list = cache.free_lists[cache_class];
+  if (free_list.size() <= keep) {
+    return;
+  }
+
+  // Return the chunks that were freed first, the most recently freed ones are more likely to be in the CPU caches.
+  const size_t count = free_list.size() - keep;
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  for (size_t i = 0; i < count; ++i) {
+    auto owned = cache.owned_chunks.find(free_list[i]);
+    cache.bytes_free.fetch_sub(static_cast<int64_t>(owned->second.size), std::memory_order_relaxed);
+    cache.owned_chunks.erase(owned);
+
+    ChunkHandle h = region_manager_.get_handle(free_list[i]);
+    ChunkFromHandle(h)->thread_cache = nullptr;
+    FreeAndMaybeCoalesce(h);
+  }
+
+  free_list.erase(free_list.begin(), free_list.begin() + count);
+}
+
+void BFCArena::ReleaseThreadCache(ThreadCache& cache) {
+  std::lock_guard<OrtMutex> lock(lock_);
+  {
+    std::lock_guard<OrtMutex> guard(cache.remote_frees_lock);
+    for (void* ptr : cache.remote_frees) {
+      cache.owned_chunks.at(ptr).is_free = true;
+    }
+    cache.remote_frees.clear();
+  }
+
+  // The chunks that are still handed out become regular chunks, which are freed to the bins directly.
+  for (const auto& entry : cache.owned_chunks) {
+    ChunkHandle h = region_manager_.get_handle(entry.first);
+    ChunkFromHandle(h)->thread_cache = nullptr;
+    if (entry.second.is_free) {
+      FreeAndMaybeCoalesce(h);
+    }
+  }
+
+  cache.owned_chunks.clear();
+  for (auto& free_list : cache.free_lists) {
+    free_list.clear();
+  }
+  cache.bytes_free.store(0, std::memory_order_relaxed);
+
+  // Keep the stats of the cache once it's gone.
+  stats_.num_thread_cache_allocs += cache.num_allocs.exchange(0, std::memory_order_relaxed);
+
+  thread_caches_.erase(std::find_if(thread_caches_.begin(), thread_caches_.end(),
+                                    [&cache](const std::shared_ptr<ThreadCache>& c) { return c.get() == &cache; }));
+  cache.arena = nullptr;
+}
+
+bool BFCArena::FreeToThreadCache(void* ptr) {
+  ThreadCache* cache = GetThreadCache(false);
+  if (cache == nullptr) {
+    return false;
+  }
+
+  auto owned = cache->owned_chunks.find(ptr);
+  if (owned == cache->owned_chunks.end()) {
+    return false;
+  }
+
+  ORT_ENFORCE(!owned->second.is_free, "Chunk at ", ptr, " freed twice");
+  owned->second.is_free = true;
+  cache->bytes_free.fetch_add(static_cast<int64_t>(owned->second.size), std::memory_order_relaxed);
+
+  const int cache_class = owned->second.cache_class;
+  auto& free_list = cache->free_lists[cache_class];
+  free_list.push_back(ptr);
+
+  // Return chunks to the bins in batches, so that a thread freeing what other threads allocate doesn't hoard them.
+  const size_t batch_size = ThreadCache::BatchSize(cache_class);
+  if (free_list.size() > 2 * batch_size) {
+    TrimThreadCache(*cache, cache_class, batch_size);
+  }
+
+  return true;
+}
+
 void* BFCArena::Reserve(size_t size) {
   if (size == 0)
     return nullptr;
@@ -281,6 +585,7 @@ void* BFCArena::Reserve(size_t size) {
   stats_.max_alloc_size = std::max<size_t>(static_cast<size_t>(stats_.max_alloc_size), size);
   stats_.max_bytes_in_use = std::max<int64_t>(static_cast<int64_t>(stats_.max_bytes_in_use), stats_.bytes_in_use);
   stats_.total_allocated_bytes += size;
+  shrink_window_peak_bytes_ = std::max(shrink_window_peak_bytes_, stats_.bytes_in_use);
   return ptr;
 }
 
@@ -318,6 +623,7 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
   BinNum bin_num = BinNumForSize(rounded_bytes);
 
   std::lock_guard<OrtMutex> lock(lock_);
+  ++window_num_allocs_[bin_num];
   // search for a valid chunk
   auto* chunk = FindChunkPtr(bin_num,
                              rounded_bytes,
@@ -371,6 +677,47 @@ void* BFCArena::AllocateRawInternal(size_t num_bytes,
 void BFCArena::GetStats(AllocatorStats* stats) {
   std::lock_guard<OrtMutex> lock(lock_);
   *stats = stats_;
+  for (const auto& cache : thread_caches_) {
+    stats->num_thread_cache_allocs += cache->num_allocs.load(std::memory_order_relaxed);
+    stats->bytes_in_thread_caches += cache->bytes_free.load(std::memory_order_relaxed);
+  }
+}
+
+void BFCArena::ResetMaxBytesInUse() {
+  std::lock_guard<OrtMutex> lock(lock_);
+  stats_.max_bytes_in_use = stats_.bytes_in_use;
+}
+
+void BFCArena::GetFragmentationStats(ArenaFragmentationStats* stats, bool reset_window) {
+  std::lock_guard<OrtMutex> lock(lock_);
+  *stats = ArenaFragmentationStats{};
+  stats->bins.resize(kNumBins);
+  for (BinNum b = 0; b < kNumBins; b++) {
+    auto& bin_stats = stats->bins[b];
+    const Bin* bin = BinFromIndex(b);
+    bin_stats.bin_size = bin->bin_size;
+    bin_stats.num_free_chunks = static_cast<int64_t>(bin->free_chunks.size());
+    for (ChunkHandle h : bin->free_chunks) {
+      bin_stats.free_bytes += static_cast<int64_t>(ChunkFromHandle(h)->size);
+    }
+    // the free chunks of a bin are sorted by size
+    if (!bin->free_chunks.empty()) {
+      const auto largest = static_cast<int64_t>(ChunkFromHandle(*bin->free_chunks.rbegin())->size);
+      stats->largest_free_chunk_bytes = std::max(stats->largest_free_chunk_bytes, largest);
+    }
+    bin_stats.num_allocs = window_num_allocs_[b];
+    stats->free_bytes += bin_stats.free_bytes;
+    stats->window_num_allocs += bin_stats.num_allocs;
+  }
+
+  for (const auto& region : region_manager_.regions()) {
+    ++stats->num_regions;
+    stats->region_bytes += static_cast<int64_t>(region.memory_size());
+  }
+
+  if (reset_window) {
+    window_num_allocs_.fill(0);
+  }
 }
 
 BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* free_chunks,
@@ -402,6 +749,7 @@ BFCArena::Chunk* BFCArena::SplitFreeChunkFromBin(BFCArena::Bin::FreeChunkSet* fr
       std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
   stats_.max_alloc_size =
       std::max<int64_t>(stats_.max_alloc_size, static_cast<int64_t>(chunk->size));
+  shrink_window_peak_bytes_ = std::max(shrink_window_peak_bytes_, stats_.bytes_in_use);
   return chunk;
 }
 
@@ -488,6 +836,9 @@ void BFCArena::Free(void* p) {
   if (p == nullptr) {
     return;
   }
+  if (thread_cache_max_chunk_bytes_ != 0 && FreeToThreadCache(p)) {
+    return;
+  }
   std::lock_guard<OrtMutex> lock(lock_);
   auto it = reserved_chunks_.find(p);
   if (it != reserved_chunks_.end()) {
@@ -500,7 +851,16 @@ void BFCArena::Free(void* p) {
   }
 }
 
-Status BFCArena::Shrink() {
+Status BFCArena::Shrink(size_t retain_bytes) {
+  if (thread_cache_max_chunk_bytes_ != 0) {
+    if (ThreadCache* cache = GetThreadCache(false)) {
+      cache->DrainRemoteFrees();
+      for (int cache_class = 0; cache_class < kNumThreadCacheClasses; ++cache_class) {
+        TrimThreadCache(*cache, cache_class, 0);
+      }
+    }
+  }
+
   std::lock_guard<OrtMutex> lock(lock_);
   auto num_regions = region_manager_.regions().size();
   std::vector<void*> region_ptrs;
@@ -531,8 +891,12 @@ Status BFCArena::Shrink() {
       h = c->next;
     }
 
+    auto shrink_size = region_sizes[i];
+    if (static_cast<size_t>(stats_.total_allocated_bytes) < retain_bytes + shrink_size) {
+      deallocate_region = false;
+    }
+
     if (deallocate_region) {
-      auto shrink_size = region_sizes[i];
       stats_.num_arena_shrinkages += 1;
       stats_.total_allocated_bytes -= shrink_size;
 
@@ -565,11 +929,114 @@ Status BFCArena::Shrink() {
   return Status::OK();
 }
 
+void BFCArena::SetShrinkPolicy(const ShrinkPolicy& policy, bool run_in_background) {
+  ORT_ENFORCE(!shrink_thread_.joinable(), "The shrink policy of an arena can only be set once.");
+  ORT_ENFORCE(policy.low_usage_percent >= 0 && policy.low_usage_percent <= 100,
+              "low_usage_percent must be in the range [0, 100]. Got ", policy.low_usage_percent);
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    shrink_policy_ = policy;
+    shrink_last_activity_ = shrink_window_start_ = std::chrono::steady_clock::now();
+    shrink_window_peak_bytes_ = stats_.bytes_in_use;
+  }
+
+  if (run_in_background && policy.IsEnabled()) {
+    shrink_thread_ = std::thread([this]() { RunShrinkPolicy(); });
+  }
+}
+
+bool BFCArena::ApplyShrinkPolicy(std::chrono::steady_clock::time_point now) {
+  size_t retain_bytes = 0;
+  {
+    std::lock_guard<OrtMutex> lock(lock_);
+    int64_t num_allocs = stats_.num_allocs;
+    for (const auto& cache : thread_caches_) {
+      num_allocs += cache->num_allocs.load(std::memory_order_relaxed);
+    }
+    if (num_allocs != shrink_last_num_allocs_ || stats_.bytes_in_use != shrink_last_bytes_in_use_) {
+      shrink_last_num_allocs_ = num_allocs;
+      shrink_last_bytes_in_use_ = stats_.bytes_in_use;
+      shrink_last_activity_ = now;
+      shrunk_since_last_activity_ = false;
+    }
+
+    bool shrink = false;
+    if (shrink_policy_.idle_time.count() > 0 && !shrunk_since_last_activity_ &&
+        now - shrink_last_activity_ >= shrink_policy_.idle_time) {
+      shrink = true;
+    }
+
+    if (shrink_policy_.low_usage_percent > 0 && shrink_policy_.low_usage_window.count() > 0 &&
+        now - shrink_window_start_ >= shrink_policy_.low_usage_window) {
+      if (shrink_window_peak_bytes_ * 100 < shrink_policy_.low_usage_percent * stats_.total_allocated_bytes) {
+        shrink = true;
+      }
+      shrink_window_start_ = now;
+      shrink_window_peak_bytes_ = stats_.bytes_in_use;
+    }
+
+    retain_bytes = shrink_policy_.retain_bytes;
+    if (!shrink || static_cast<size_t>(stats_.total_allocated_bytes) <= retain_bytes) {
+      return false;
+    }
+    shrunk_since_last_activity_ = true;
+  }
+
+  LOGS_DEFAULT(VERBOSE) << "Shrinking the BFCArena for " << device_allocator_->Info().name
+                        << " according to its shrink policy";
+  auto status = Shrink(retain_bytes);
+  if (!status.IsOK()) {
+    LOGS_DEFAULT(WARNING) << "Failed to shrink the BFCArena for " << device_allocator_->Info().name << ": "
+                          << status.ErrorMessage();
+  }
+  return true;
+}
+
+void BFCArena::RunShrinkPolicy() {
+  // check a few times per period so that the arena shrinks soon after the policy says so
+  auto interval = std::chrono::milliseconds::max();
+  if (shrink_policy_.idle_time.count() > 0) {
+    interval = std::min(interval, shrink_policy_.idle_time / 4);
+  }
+  if (shrink_policy_.low_usage_percent > 0 && shrink_policy_.low_usage_window.count() > 0) {
+    interval = std::min(interval, shrink_policy_.low_usage_window / 4);
+  }
+  interval = std::max(interval, std::chrono::milliseconds(10));
+
+  std::unique_lock<OrtMutex> lock(shrink_thread_mutex_);
+  while (!stop_shrink_thread_) {
+    shrink_thread_cv_.wait_for(lock, interval);
+    if (stop_shrink_thread_) {
+      break;
+    }
+
+    lock.unlock();
+    ORT_TRY {
+      ApplyShrinkPolicy(std::chrono::steady_clock::now());
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&ex]() {
+        LOGS_DEFAULT(WARNING) << "Caught exception while applying the shrink policy of a BFCArena: " << ex.what();
+      });
+    }
+    lock.lock();
+  }
+}
+
 void BFCArena::DeallocateRawInternal(void* ptr) {
   // Find the chunk from the ptr.
   BFCArena::ChunkHandle h = region_manager_.get_handle(ptr);
   ORT_ENFORCE(h != kInvalidChunkHandle);
 
+  // A chunk handed out by the thread cache of another thread goes back to that cache.
+  ThreadCache* cache = ChunkFromHandle(h)->thread_cache;
+  if (cache != nullptr) {
+    std::lock_guard<OrtMutex> guard(cache->remote_frees_lock);
+    cache->remote_frees.push_back(ptr);
+    cache->has_remote_frees.store(true, std::memory_order_release);
+    return;
+  }
+
   // Consider coalescing it.
   FreeAndMaybeCoalesce(h);
 }
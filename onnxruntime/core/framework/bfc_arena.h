@@ -16,9 +16,12 @@ limitations under the License.
 
 #pragma once
 #include <array>
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <mutex>
 #include <sstream>
+#include <thread>
 
 #include "onnxruntime_config.h"
 
@@ -60,6 +63,10 @@ class BFCArena : public IAllocator {
   static const int DEFAULT_MAX_DEAD_BYTES_PER_CHUNK = 128 * 1024 * 1024;
   static const int DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES = 2 * 1024 * 1024;
   static const size_t DEFAULT_MAX_MEM = std::numeric_limits<size_t>::max();
+  // The per-thread chunk cache is disabled by default.
+  static constexpr int DEFAULT_THREAD_CACHE_MAX_CHUNK_BYTES = 0;
+  // Upper bound of thread_cache_max_chunk_bytes.
+  static constexpr int MAX_THREAD_CACHE_MAX_CHUNK_BYTES = 1 << 20;
 
   enum ArenaType {
     BaseArena,
@@ -71,7 +78,8 @@ class BFCArena : public IAllocator {
            ArenaExtendStrategy arena_extend_strategy = DEFAULT_ARENA_EXTEND_STRATEGY,
            int initial_chunk_size_bytes = DEFAULT_INITIAL_CHUNK_SIZE_BYTES,
            int max_dead_bytes_per_chunk = DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
-           int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES);
+           int initial_growth_chunk_size_bytes = DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES,
+           int thread_cache_max_chunk_bytes = DEFAULT_THREAD_CACHE_MAX_CHUNK_BYTES);
 
   ~BFCArena() override;
 
@@ -83,18 +91,50 @@ class BFCArena : public IAllocator {
   // If p is NULL, no operation is performed.
   void Free(void* p) override;
 
-  // Frees all allocation regions in which no chunk is in use.
+  // Frees all allocation regions in which no chunk is in use, as long as the total allocated bytes stay at least
+  // `retain_bytes`.
   // Does not free any reserved chunks.
+  // The free chunks in the thread cache of the calling thread are returned to the arena first. Chunks cached
+  // by other threads stay in use and keep their allocation region alive.
   // Resets the size that the arena will grow by in the next allocation to
   // `initial_growth_chunk_size_bytes_` but ultimately all
   // future allocation sizes are determined by the arena growth strategy
   // and the allocation request.
-  Status Shrink();
+  Status Shrink(size_t retain_bytes = 0);
+
+  // When to shrink the arena without the application asking for it, see OrtArenaCfg.
+  // The arena shrinks once it has been idle for idle_time, and at the end of a window of low_usage_window in which
+  // the peak of the bytes in use stayed below low_usage_percent of the allocated bytes. As a shrinkage lowers the
+  // allocated bytes, and a burst of usage postpones the next one by a window, the arena doesn't shrink repeatedly
+  // under a steady load.
+  struct ShrinkPolicy {
+    std::chrono::milliseconds idle_time{0};  // 0 disables the shrinkage of an idle arena
+    int low_usage_percent = 0;               // 0 disables the shrinkage of an arena with a low usage
+    std::chrono::milliseconds low_usage_window{0};
+    size_t retain_bytes = 0;
+
+    bool IsEnabled() const { return idle_time.count() > 0 || (low_usage_percent > 0 && low_usage_window.count() > 0); }
+  };
+
+  // Sets the shrink policy, which is applied by a background thread of the arena if run_in_background is true,
+  // and otherwise by calling ApplyShrinkPolicy.
+  void SetShrinkPolicy(const ShrinkPolicy& policy, bool run_in_background = true);
+
+  // Shrinks the arena if the shrink policy says so at time `now`. Returns true if it tried to shrink.
+  bool ApplyShrinkPolicy(std::chrono::steady_clock::time_point now);
 
   void* Reserve(size_t size) override;
 
   void GetStats(AllocatorStats* stats) override;
 
+  // Resets max_bytes_in_use to the bytes currently in use, so that the peak of the next interval can be measured.
+  void ResetMaxBytesInUse();
+
+  // Gets the free chunks per bin and the sizes of the allocations in the window that started at the previous call
+  // with reset_window set to true, or at the creation of the arena. The allocations served from thread caches are
+  // not counted in the window.
+  void GetFragmentationStats(ArenaFragmentationStats* stats, bool reset_window);
+
   size_t RequestedSize(const void* ptr);
 
   size_t AllocatedSize(const void* ptr);
@@ -121,6 +161,27 @@ class BFCArena : public IAllocator {
  private:
   void DeallocateRawInternal(void* ptr);
 
+  // Per-thread cache of small chunks, see thread_cache_max_chunk_bytes_.
+  struct ThreadCache;
+
+  void* AllocateFromThreadCache(size_t num_bytes);
+
+  // Returns false if `ptr` is not owned by the thread cache of the calling thread.
+  bool FreeToThreadCache(void* ptr);
+
+  // Returns the cache of the calling thread, or nullptr if it doesn't have one and `create` is false.
+  ThreadCache* GetThreadCache(bool create);
+
+  // Takes a batch of chunks for the size class `cache_class` from the bins.
+  void RefillThreadCache(ThreadCache& cache, int cache_class);
+
+  // Returns all but `keep` of the free chunks of the size class `cache_class` to the bins.
+  void TrimThreadCache(ThreadCache& cache, int cache_class, size_t keep);
+
+  // Returns the free chunks of a cache to the bins, and turns the chunks it handed out into regular chunks.
+  // Called when the owning thread exits.
+  void ReleaseThreadCache(ThreadCache& cache);
+
   // A ChunkHandle is an index into the chunks_ vector in BFCAllocator
   // kInvalidChunkHandle means an invalid chunk
   using ChunkHandle = size_t;
@@ -168,6 +229,10 @@ class BFCArena : public IAllocator {
 
     uint64_t stream_timestamp = 0;
 
+    // The thread cache that owns this chunk, if any. Chunks owned by a thread cache are in use from the point of
+    // view of the arena, whether they are handed out or free in the cache.
+    ThreadCache* thread_cache = nullptr;
+
     bool in_use() const { return allocation_id != -1; }
 
     std::string DebugString(BFCArena* a, bool recurse) {
@@ -500,12 +565,42 @@ class BFCArena : public IAllocator {
 
   AllocatorStats stats_;
 
+  // Number of allocations per bin of their rounded size since the window was reset, see GetFragmentationStats.
+  std::array<int64_t, kNumBins> window_num_allocs_{};
+
+  // State of the shrink policy. Guarded by lock_.
+  ShrinkPolicy shrink_policy_;
+  int64_t shrink_last_num_allocs_ = 0;
+  int64_t shrink_last_bytes_in_use_ = 0;
+  std::chrono::steady_clock::time_point shrink_last_activity_;
+  bool shrunk_since_last_activity_ = false;
+  std::chrono::steady_clock::time_point shrink_window_start_;
+  int64_t shrink_window_peak_bytes_ = 0;
+
+  // Applies the shrink policy until stop_shrink_thread_ is set.
+  void RunShrinkPolicy();
+
+  std::thread shrink_thread_;
+  OrtMutex shrink_thread_mutex_;
+  OrtCondVar shrink_thread_cv_;
+  bool stop_shrink_thread_ = false;  // Guarded by shrink_thread_mutex_.
+
   std::unordered_map<void*, size_t> reserved_chunks_;
 
   const int initial_chunk_size_bytes_;
   const int max_dead_bytes_per_chunk_;
   const int initial_growth_chunk_size_bytes_;
 
+  // Allocations of up to this many bytes are served from a cache owned by the calling thread, which only takes
+  // lock_ to move chunks between the cache and the bins in batches. 0 disables the cache.
+  const size_t thread_cache_max_chunk_bytes_;
+
+  // Unique id of this arena, used to look up the thread caches of the arena.
+  const int64_t arena_id_;
+
+  // Caches created by the threads using this arena. Guarded by lock_.
+  std::vector<std::shared_ptr<ThreadCache>> thread_caches_;
+
   // This flag is only relevant if Shrink() is invoked.
   // This is a boolean flag that controls whether the first allocation region
   // is to be considered for shrinkage or not.
@@ -527,9 +622,11 @@ class StreamAwareArena : public BFCArena {
   // If size is 0, then this function returns either NULL,
   // or a unique pointer value that can later be successfully
   // passed to free(). Whatever, do not dereference that pointer
-  void* AllocOnStream(size_t size, Stream* current_stream_id, WaitNotificationFn wait_fn);
+  void* AllocOnStream(size_t size, Stream* current_stream_id, WaitNotificationFn wait_fn) override;
+
+  void ReleaseStreamBuffers(Stream* stream) override;
 
-  void ReleaseStreamBuffers(Stream* stream);
+  bool IsStreamAware() const override { return true; }
 
   static StreamAwareArena* FromBFCArena(BFCArena& arena) {
     return arena.GetArenaType() == ArenaType::StreamAwareArena ? reinterpret_cast<StreamAwareArena*>(&arena) : nullptr;
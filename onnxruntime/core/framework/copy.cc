@@ -3,9 +3,61 @@
 // Licensed under the MIT License.
 #include "core/framework/copy.h"
 
+#if (defined(_M_AMD64) && !defined(_M_ARM64EC)) || defined(__x86_64__)
+#include <emmintrin.h>
+#define ORT_COPY_NON_TEMPORAL_STORES
+#endif
+
 namespace onnxruntime {
 
+namespace strided_copy_detail {
+
+void NonTemporalCopy(void* dst, const void* src, size_t bytes) {
+#ifdef ORT_COPY_NON_TEMPORAL_STORES
+  auto* d = static_cast<uint8_t*>(dst);
+  const auto* s = static_cast<const uint8_t*>(src);
+
+  // the streaming stores need a 16 byte aligned destination
+  const size_t head = std::min(bytes, static_cast<size_t>((16 - reinterpret_cast<uintptr_t>(d) % 16) % 16));
+  memcpy(d, s, head);
+  d += head;
+  s += head;
+  bytes -= head;
+
+  for (; bytes >= 64; bytes -= 64, d += 64, s += 64) {
+    const __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s));
+    const __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 16));
+    const __m128i v2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 32));
+    const __m128i v3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(s + 48));
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d), v0);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 16), v1);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 32), v2);
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d + 48), v3);
+  }
+  for (; bytes >= 16; bytes -= 16, d += 16, s += 16) {
+    _mm_stream_si128(reinterpret_cast<__m128i*>(d), _mm_loadu_si128(reinterpret_cast<const __m128i*>(s)));
+  }
+  memcpy(d, s, bytes);
+#else
+  memcpy(dst, src, bytes);
+#endif
+}
+
+void NonTemporalStoreFence() {
+#ifdef ORT_COPY_NON_TEMPORAL_STORES
+  _mm_sfence();
+#endif
+}
+
+}  // namespace strided_copy_detail
+
 TensorShapeVector StridesForTensor(const Tensor& tensor) {
+#ifdef ENABLE_STRIDED_TENSORS
+  // the inputs of kernels registered with MayStridedInput may be strided views
+  if (!tensor.IsContiguous()) {
+    return ToShapeVector(tensor.Strides());
+  }
+#endif
   const auto& shape = tensor.Shape();
   TensorShapeVector strides(shape.NumDimensions());
   int64_t running_size = 1;
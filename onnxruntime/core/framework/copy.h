@@ -8,6 +8,7 @@
 #include "core/framework/tensor.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 
+#include <algorithm>
 #include <vector>
 
 namespace onnxruntime {
@@ -17,8 +18,30 @@ void CoalesceDimensions(
 
 TensorShapeVector StridesForTensor(const Tensor& tensor);
 
+#ifdef ENABLE_STRIDED_TENSORS
+/*
+    True if output was planned as a strided view on the buffer of input (see KernelDefBuilder::MayStridedOutput).
+    The kernel must then only set the shape, strides and byte offset of output instead of writing to it.
+*/
+inline bool IsStridedViewOf(const Tensor& output, const Tensor& input) {
+  return static_cast<const char*>(output.DataRaw()) - output.ByteOffset() ==
+         static_cast<const char*>(input.DataRaw()) - input.ByteOffset();
+}
+#endif
+
 namespace strided_copy_detail {
 
+// Copies that write at least this many bytes use non-temporal stores for their contiguous spans of at least
+// kNonTemporalCopyMinSpanBytes: a destination this large does not stay in the cache, and the stores do not read
+// it in before overwriting it.
+constexpr size_t kNonTemporalCopyMinBytes = size_t{4} << 20;
+constexpr size_t kNonTemporalCopyMinSpanBytes = 1024;
+
+// memcpy with non-temporal stores where the platform has them. The thread that copies must call
+// NonTemporalStoreFence before the destination is read by another thread.
+void NonTemporalCopy(void* dst, const void* src, size_t bytes);
+void NonTemporalStoreFence();
+
 template <typename T>
 void Copy1DNonContiguous(T* dst, int64_t dst_stride, const T* src, int64_t src_stride, std::ptrdiff_t count) {
   for (std::ptrdiff_t i = 0; i < count; i++) {
@@ -29,22 +52,31 @@ void Copy1DNonContiguous(T* dst, int64_t dst_stride, const T* src, int64_t src_s
 }
 
 template <typename T>
-void Copy1DContiguous(T* dst, const T* src, std::ptrdiff_t count) {
+void Copy1DContiguous(T* dst, const T* src, std::ptrdiff_t count, bool non_temporal = false) {
   if constexpr (std::is_same_v<std::string, T>) {
     Copy1DNonContiguous(dst, 1, src, 1, count);
   } else {
-    memcpy(dst, src, count * sizeof(T));
+    const size_t bytes = count * sizeof(T);
+    if (non_temporal && bytes >= kNonTemporalCopyMinSpanBytes) {
+      NonTemporalCopy(dst, src, bytes);
+    } else {
+      memcpy(dst, src, bytes);
+    }
   }
 }
 
 template <typename T>
-void Copy1D(T* dst, int64_t dst_stride, const T* src, int64_t src_stride, std::ptrdiff_t count) {
-  if constexpr (std::is_same_v<std::string, T>) {
+void Copy1D(T* dst, int64_t dst_stride, const T* src, int64_t src_stride, std::ptrdiff_t count,
+            bool non_temporal = false) {
+  if (dst_stride == 1 && src_stride == 0) {
+    // a value broadcast along the dimension, e.g. by Tile or Expand
+    std::fill_n(dst, count, *src);
+  } else if constexpr (std::is_same_v<std::string, T>) {
     // strings should always be copied using the for loop
     Copy1DNonContiguous(dst, dst_stride, src, src_stride, count);
   } else {
     if (dst_stride == 1 && src_stride == 1) {
-      Copy1DContiguous(dst, src, count);
+      Copy1DContiguous(dst, src, count, non_temporal);
     } else {
       Copy1DNonContiguous(dst, dst_stride, src, src_stride, count);
     }
@@ -138,6 +170,9 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
   }
 
   const std::size_t dims = copy_shape.size();
+  const bool non_temporal = !std::is_same_v<std::string, T> &&
+                            static_cast<uint64_t>(total_num_elements_to_copy) * sizeof(T) >=
+                                strided_copy_detail::kNonTemporalCopyMinBytes;
 
   // TODOs for when we have strided tensors:
   // - Reorder dimensions so that we iterate along the smallest strides first
@@ -157,7 +192,8 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
     concurrency::ThreadPool::TryParallelFor(
         thread_pool, static_cast<std::ptrdiff_t>(total_num_elements_to_copy),
         {static_cast<float>(sizeof(T)), static_cast<float>(sizeof(T)), 1.0F},
-        [src_stride, dst_stride, dst, src, contiguous_span_size](std::ptrdiff_t first, std::ptrdiff_t last) {
+        [src_stride, dst_stride, dst, src, contiguous_span_size, non_temporal](std::ptrdiff_t first,
+                                                                               std::ptrdiff_t last) {
           // get the current inner and outer index
           std::ptrdiff_t inner = first % contiguous_span_size;
           std::ptrdiff_t outer = first / contiguous_span_size;
@@ -170,7 +206,7 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
             auto elements_to_copy = contiguous_span_size - inner;
             // never copy more than what is in our partition
             elements_to_copy = std::min<std::ptrdiff_t>(elements_to_copy, last - first);
-            strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, elements_to_copy);
+            strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, elements_to_copy, non_temporal);
             inner = 0;
             outer++;
             first += elements_to_copy;
@@ -182,7 +218,8 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
 
           // Step 2: copy contiguous span by contiguous span until we reach the penultimate span
           while (first < last - contiguous_span_size) {
-            strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, contiguous_span_size);
+            strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, contiguous_span_size,
+                                                     non_temporal);
             dst_idx += dst_stride;
             src_idx += src_stride;
             first += contiguous_span_size;
@@ -191,7 +228,10 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
           // element in our partition
           ORT_ENFORCE(last >= first);
           auto last_span_size = last - first;
-          strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, last_span_size);
+          strided_copy_detail::Copy1DContiguous<T>(dst + dst_idx, src + src_idx, last_span_size, non_temporal);
+          if (non_temporal) {
+            strided_copy_detail::NonTemporalStoreFence();
+          }
         });
   } else {
     // enforce that the lambda doesn't change anything
@@ -202,8 +242,8 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
     concurrency::ThreadPool::TryParallelFor(
         thread_pool, static_cast<std::ptrdiff_t>(total_num_elements_to_copy),
         {static_cast<float>(sizeof(T)), static_cast<float>(sizeof(T)), 1.0F},
-        [&const_copy_shape, &const_dst_strides, dst, src, &const_src_strides, dims](std::ptrdiff_t first,
-                                                                                    std::ptrdiff_t last) {
+        [&const_copy_shape, &const_dst_strides, dst, src, &const_src_strides, dims,
+         non_temporal](std::ptrdiff_t first, std::ptrdiff_t last) {
           strided_copy_detail::NdCounter counter(const_copy_shape, first, last);
 
           auto last_dst_stride = const_dst_strides[dims - 1];
@@ -219,12 +259,16 @@ void StridedCopy(concurrency::ThreadPool* thread_pool,
               src_idx += static_cast<std::ptrdiff_t>(counter.current_index[dim] * const_src_strides[dim]);
             }
             // we can copy until the current dimension is done (or until we hit the last element we are trying to copy)
-            strided_copy_detail::Copy1D<T>(dst + dst_idx, last_dst_stride, src + src_idx, last_src_stride, iter_size);
+            strided_copy_detail::Copy1D<T>(dst + dst_idx, last_dst_stride, src + src_idx, last_src_stride, iter_size,
+                                           non_temporal);
 
             counter.Step(iter_size);
             iter_size = counter.NextStepSize();
           }
           ORT_ENFORCE(counter.current_offset == last);
+          if (non_temporal) {
+            strided_copy_detail::NonTemporalStoreFence();
+          }
         });
   }
 }
@@ -40,13 +40,8 @@ class DeviceStreamCollectionImpl {
         for (auto& ep : eps_) {
           auto& allocators = ep->GetAllocators();
           for (auto& alloc : allocators) {
-            if (alloc->Info().device == stream->GetDevice() &&
-                alloc->Info().alloc_type == OrtArenaAllocator) {
-              auto* arena_alloc = static_cast<BFCArena*>(alloc.get());
-              auto* stream_aware_alloc = StreamAwareArena::FromBFCArena(*arena_alloc);
-              if (stream_aware_alloc) {
-                stream_aware_alloc->ReleaseStreamBuffers(stream.get());
-              }
+            if (alloc->Info().device == stream->GetDevice() && alloc->IsStreamAware()) {
+              alloc->ReleaseStreamBuffers(stream.get());
             }
           }
         }
@@ -5,6 +5,7 @@
 
 #include <sstream>
 
+#include "core/common/safeint.h"
 #include "core/framework/mem_pattern_planner.h"
 #include "core/framework/execution_plan_base.h"
 #include "core/framework/sequential_execution_plan.h"
@@ -26,16 +27,6 @@
 using namespace onnxruntime::common;
 
 namespace onnxruntime {
-#ifdef ENABLE_STREAM
-static StreamAwareArena* AsStreamBasedAllocator(AllocatorPtr allocator) {
-  if (allocator->Info().alloc_type == OrtArenaAllocator) {
-    BFCArena* arena_ptr = static_cast<BFCArena*>(allocator.get());
-    return StreamAwareArena::FromBFCArena(*arena_ptr);
-  }
-  return nullptr;
-}
-#endif
-
 IExecutionFrame::IExecutionFrame(const OrtValueNameIdxMap& ort_value_idx_map,
                                  const NodeIndexInfo& node_index_info,
                                  gsl::span<const int> fetch_mlvalue_idxs)
@@ -393,7 +384,13 @@ ExecutionFrame::ExecutionFrame(gsl::span<const int> feed_mlvalue_idxs, gsl::span
 
     // if there are some traditional ml value type in inputs disable the memory pattern optimization.
     if (all_tensors) {
-      mem_patterns_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs, inferred_shapes_);
+      mem_pattern_entry_ = session_state.GetMemoryPatternGroup(feeds, feed_mlvalue_idxs);
+      if (mem_pattern_entry_) {
+        mem_patterns_ = &mem_pattern_entry_->mem_patterns;
+        if (!mem_pattern_entry_->inferred_shapes.empty()) {
+          inferred_shapes_ = &mem_pattern_entry_->inferred_shapes;
+        }
+      }
       // if no existing patterns, generate one in this execution frame
       if (!mem_patterns_) {
         planner_.emplace(*session_state.GetExecutionPlan());
@@ -528,8 +525,10 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
       if (block) {
         auto it = buffers_.find(location);
         if (it != buffers_.end()) {
-          // if the block is not correct, log message then fall back to default behavior
-          if (block->size_ == size) {
+          // if the block is too small, log message then fall back to default behavior.
+          // a larger block is expected when the pattern is shared by inputs of a dim bucket, and it's
+          // reserved for this ort_value during its lifetime anyway.
+          if (block->size_ >= size) {
             void* buffer = it->second.get();
             auto status = AllocateTensorWithPreAllocateBufferHelper(
                 ort_value, static_cast<void*>(static_cast<char*>(buffer) + block->offset_), element_type, location,
@@ -538,8 +537,6 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
           } else {
             // the block size may vary especially if the model has NonZero ops, or different sequence lengths are
             // fed in, so use VERBOSE as the log level as it's expected.
-            // TODO: Should we re-use the block if the size is large enough? Would probably need to allow it
-            // to be freed if the size difference was too large so our memory usage doesn't stick at a high water mark
             LOGS(session_state_.Logger(), VERBOSE) << "For ort_value with index: " << ort_value_index
                                                    << ", block in memory pattern size is: " << block->size_
                                                    << " but the actually size is: " << size
@@ -556,13 +553,12 @@ Status ExecutionFrame::AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_va
   Stream* current_stream = GetValueStream(ort_value_index);
   if (current_stream) {
 #ifdef ENABLE_STREAM
-    auto stream_aware_alloc = AsStreamBasedAllocator(alloc);
-    if (stream_aware_alloc) {
+    if (alloc->IsStreamAware()) {
       size_t buffer_size = Tensor::CalculateTensorStorageSize(element_type, shape);
       // the reused memory must from same EP
       auto wait_handle = this->session_state_.GetStreamHandleRegistryInstance().GetWaitHandle(
           current_stream->GetDevice().Type(), current_stream->GetDevice().Type());
-      void* p_data = stream_aware_alloc->AllocOnStream(buffer_size, current_stream, wait_handle);
+      void* p_data = alloc->AllocOnStream(buffer_size, current_stream, wait_handle);
       Tensor::InitOrtValue(element_type, shape, p_data, std::move(alloc), ort_value);
     } else {
       Tensor::InitOrtValue(element_type, shape, std::move(alloc), ort_value);
@@ -684,6 +680,34 @@ Status ExecutionFrame::AllocateReusedOrtValueIfNotAllocatedHelper(int reuse_mlva
   return Status::OK();
 }
 
+// The owner of the buffer is allocated with its static shape, as sub-views (e.g. the inputs of a Concat produced in
+// place in its output) are created before the node producing the owner runs.
+Status ExecutionFrame::AllocateMLValueTensorSubView(OrtValue& ort_value, int ort_value_index_owner, size_t offset,
+                                                    MLDataType element_type, const OrtMemoryInfo& location,
+                                                    const TensorShape& shape, bool is_strided_tensor) {
+  OrtValue& owner_value = GetMutableMLValue(ort_value_index_owner);
+  if (!owner_value.IsAllocated()) {
+    std::string owner_name;
+    ORT_RETURN_IF_ERROR(session_state_.GetOrtValueNameIdxMap().GetName(ort_value_index_owner, owner_name));
+    const NodeArg* owner_arg = session_state_.GetGraphViewer().GetNodeArg(owner_name);
+    ORT_RETURN_IF(owner_arg == nullptr || owner_arg->Shape() == nullptr,
+                  "Static shape of sub-view buffer owner ", owner_name, " is not known.");
+    const TensorShape owner_shape = utils::GetTensorShapeFromTensorShapeProto(*owner_arg->Shape());
+    ORT_RETURN_IF_ERROR(AllocateAsPerAllocationPlan(owner_value, ort_value_index_owner, &owner_shape));
+  }
+
+  auto* owner_tensor = owner_value.GetMutable<Tensor>();
+  if (!is_strided_tensor) {
+    const size_t required_bytes = SafeInt<size_t>(shape.Size()) * element_type->Size();
+    ORT_RETURN_IF(offset + required_bytes > owner_tensor->SizeInBytes(),
+                  "Sub-view of ", shape, " at offset ", offset, " exceeds the buffer of ", owner_tensor->Shape(),
+                  ". Validate the static shapes in the model.");
+  }
+
+  void* buffer = static_cast<char*>(owner_tensor->MutableDataRaw()) + offset;
+  return AllocateTensorWithPreAllocateBufferHelper(ort_value, buffer, element_type, location, shape);
+}
+
 // This method is not thread safe!
 Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_value_index, const TensorShape* shape) {
   const auto& alloc_plan = session_state_.GetPerValueAllocPlan();
@@ -738,12 +762,19 @@ Status ExecutionFrame::AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_
       case AllocKind::kReuse: {
         int reuse_mlvalue_index = per_alloc_plan.reused_buffer;
 
-        ORT_RETURN_IF_ERROR(AllocateReusedOrtValueIfNotAllocatedHelper(reuse_mlvalue_index, shape));
-
         bool is_strided_tensor = false;
 #ifdef ENABLE_STRIDED_TENSORS
         is_strided_tensor = per_alloc_plan.is_strided_tensor;
 #endif  // ENABLE_STRIDED_TENSORS
+        if (per_alloc_plan.is_sub_view) {
+          ORT_RETURN_IF_ERROR(AllocateMLValueTensorSubView(ort_value, reuse_mlvalue_index,
+                                                           per_alloc_plan.sub_view_offset, ml_data_type, alloc_info,
+                                                           *shape, is_strided_tensor));
+          break;
+        }
+
+        ORT_RETURN_IF_ERROR(AllocateReusedOrtValueIfNotAllocatedHelper(reuse_mlvalue_index, shape));
+
         ORT_RETURN_IF_ERROR(AllocateMLValueTensorPreAllocateBuffer(
             ort_value, reuse_mlvalue_index, ml_data_type, alloc_info, *shape, is_strided_tensor));
         break;
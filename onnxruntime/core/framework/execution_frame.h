@@ -23,6 +23,7 @@ class DataTransferManager;
 class SessionState;
 class OrtValueNameIdxMap;
 struct MemoryPatternGroup;
+struct MemoryPatternCacheEntry;
 class NodeIndexInfo;
 class Stream;
 
@@ -196,6 +197,10 @@ class ExecutionFrame final : public IExecutionFrame {
 
   common::Status AllocateReusedOrtValueIfNotAllocatedHelper(int reuse_mlvalue_index, const TensorShape* shape);
 
+  Status AllocateMLValueTensorSubView(OrtValue& ort_value, int ort_value_index_owner, size_t offset,
+                                      MLDataType element_type, const OrtMemoryInfo& location,
+                                      const TensorShape& shape, bool is_strided_tensor);
+
   common::Status AllocateAsPerAllocationPlan(OrtValue& ort_value, int ort_value_index, const TensorShape* shape);
 
   Status AllocateMLValueTensorSelfOwnBufferHelper(OrtValue& ort_value, int ort_value_index, MLDataType element_type,
@@ -216,6 +221,10 @@ class ExecutionFrame final : public IExecutionFrame {
   // map of index to custom allocator
   InlinedHashMap<int, IExecutor::CustomAllocator> custom_allocators_;
 
+  // The cache entry of the memory pattern used by this frame. Holding it keeps
+  // mem_patterns_ and inferred_shapes_ valid if the entry is evicted from the cache.
+  std::shared_ptr<const MemoryPatternCacheEntry> mem_pattern_entry_;
+
   // If we already have cached memory pattern on these input shapes
   // Use this mem pattern that create a big chunk for all the internal
   // kernel's input/output tensors.
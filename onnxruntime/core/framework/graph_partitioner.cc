@@ -12,6 +12,7 @@
 #include "core/framework/kernel_lookup.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/kernel_registry.h"
+#include "core/framework/utils.h"
 #include "core/graph/function.h"
 #include "core/graph/graph_viewer.h"
 
@@ -528,9 +529,250 @@ static Status InlineNodes(Graph& graph, bool& modified_graph) {
   return Status::OK();
 }
 
+// estimated size of the tensor produced for node_arg
+static size_t EstimateTensorSizeInBytes(const NodeArg& node_arg, const PartitioningCostModel& cost_model) {
+  const auto* type = node_arg.TypeAsProto();
+  const auto* shape = node_arg.Shape();
+  if (type == nullptr || !type->has_tensor_type() || shape == nullptr) {
+    return cost_model.default_tensor_bytes;
+  }
+
+  size_t size = 4;
+  switch (type->tensor_type().elem_type()) {
+    case ONNX_NAMESPACE::TensorProto_DataType_BOOL:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT8:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT8:
+      size = 1;
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT16:
+      size = 2;
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_DOUBLE:
+    case ONNX_NAMESPACE::TensorProto_DataType_INT64:
+    case ONNX_NAMESPACE::TensorProto_DataType_UINT64:
+      size = 8;
+      break;
+    default:
+      break;
+  }
+
+  for (const auto& dim : shape->dim()) {
+    if (!dim.has_dim_value() || dim.dim_value() < 0) {
+      return cost_model.default_tensor_bytes;
+    }
+
+    size *= static_cast<size_t>(dim.dim_value());
+  }
+
+  return size;
+}
+
+// The greedy partitioning assigns each node to the first EP that can run it, which can leave small islands of nodes
+// on one device in the middle of nodes on another, each with a pair of copies. Move the islands of connected nodes
+// assigned to the same EP to another EP with kernels for all of them if that lowers the estimated latency of the
+// nodes plus the copies across the island boundary. Only the nodes of EPs with kernels in the main graph are moved.
+// Fused nodes and nodes with subgraphs keep their assignment.
+static void RefineAssignmentWithCostModel(Graph& graph, const PartitioningCostModel& cost_model,
+                                          const ExecutionProviders& execution_providers,
+                                          const KernelRegistryManager& kernel_registry_mgr) {
+  InlinedVector<std::string> kernel_ep_types;
+  for (const auto& ep : execution_providers) {
+    if (ep->GetKernelRegistry() != nullptr) {
+      kernel_ep_types.push_back(ep->Type());
+    }
+  }
+
+  if (kernel_ep_types.size() < 2) {
+    return;
+  }
+
+  // the EPs that have a kernel for each node that can be moved
+  InlinedHashMap<NodeIndex, InlinedVector<std::string_view>> candidate_eps;
+  for (auto& node : graph.Nodes()) {
+    const std::string assigned_ep = node.GetExecutionProviderType();
+    if (node.NodeType() == Node::Type::Fused || node.ContainsSubgraph() ||
+        std::find(kernel_ep_types.cbegin(), kernel_ep_types.cend(), assigned_ep) == kernel_ep_types.cend()) {
+      continue;
+    }
+
+    // the kernel lookup matches the assigned EP if there is one
+    auto& candidates = candidate_eps[node.Index()];
+    node.SetExecutionProviderType("");
+    for (const auto& ep_type : kernel_ep_types) {
+      if (KernelRegistryManager::HasImplementationOf(kernel_registry_mgr, node, ep_type)) {
+        candidates.push_back(ep_type);
+      }
+    }
+    node.SetExecutionProviderType(assigned_ep);
+  }
+
+  InlinedHashSet<std::string_view> graph_io_names;
+  for (const auto* node_arg : graph.GetInputs()) {
+    graph_io_names.insert(node_arg->Name());
+  }
+  for (const auto* node_arg : graph.GetOutputs()) {
+    graph_io_names.insert(node_arg->Name());
+  }
+
+  auto node_cost = [&cost_model](const Node& node, std::string_view ep_type) {
+    auto op_entry = cost_model.op_costs.find(node.OpType());
+    if (op_entry == cost_model.op_costs.end() || op_entry->second.empty()) {
+      return 0.0;
+    }
+
+    const auto& ep_costs = op_entry->second;
+    auto ep_entry = ep_costs.find(std::string{ep_type});
+    if (ep_entry != ep_costs.end()) {
+      return ep_entry->second;
+    }
+
+    // not measured with this EP so assume the average of the measured ones
+    double total = 0.0;
+    for (const auto& entry : ep_costs) {
+      total += entry.second;
+    }
+    return total / ep_costs.size();
+  };
+
+  auto needs_copy = [](const std::string& ep_type, const std::string& other_ep_type) {
+    return ep_type != other_ep_type &&
+           (!utils::ProviderIsCpuBased(ep_type) || !utils::ProviderIsCpuBased(other_ep_type));
+  };
+
+  // estimated latency of the island if its nodes were assigned to ep_type
+  auto island_cost = [&](const InlinedHashSet<NodeIndex>& island, const std::string& ep_type) {
+    double cost = 0.0;
+    // each tensor is copied once to each device that consumes it
+    InlinedHashSet<std::string> copies;
+    auto add_copy = [&](const NodeArg& node_arg, const std::string& other_ep_type) {
+      if (needs_copy(ep_type, other_ep_type) && copies.insert(node_arg.Name() + "/" + other_ep_type).second) {
+        cost += cost_model.copy_overhead_us +
+                EstimateTensorSizeInBytes(node_arg, cost_model) / cost_model.copy_bytes_per_us;
+      }
+    };
+
+    for (const auto node_index : island) {
+      const Node& node = *graph.GetNode(node_index);
+      cost += node_cost(node, ep_type);
+
+      for (auto edge = node.InputEdgesBegin(), end = node.InputEdgesEnd(); edge != end; ++edge) {
+        const Node& producer = edge->GetNode();
+        if (island.count(producer.Index()) == 0) {
+          add_copy(*producer.OutputDefs()[edge->GetSrcArgIndex()], producer.GetExecutionProviderType());
+        }
+      }
+
+      for (auto edge = node.OutputEdgesBegin(), end = node.OutputEdgesEnd(); edge != end; ++edge) {
+        const Node& consumer = edge->GetNode();
+        if (island.count(consumer.Index()) == 0) {
+          add_copy(*node.OutputDefs()[edge->GetSrcArgIndex()], consumer.GetExecutionProviderType());
+        }
+      }
+
+      // graph inputs are provided and graph outputs are returned in CPU memory by default
+      for (const auto* node_arg : node.InputDefs()) {
+        if (node_arg->Exists() && graph_io_names.count(node_arg->Name()) > 0) {
+          add_copy(*node_arg, kCpuExecutionProvider);
+        }
+      }
+      for (const auto* node_arg : node.OutputDefs()) {
+        if (node_arg->Exists() && graph_io_names.count(node_arg->Name()) > 0) {
+          add_copy(*node_arg, kCpuExecutionProvider);
+        }
+      }
+    }
+
+    return cost;
+  };
+
+  // moving an island can make it part of a neighbouring island, so repeat until nothing changes
+  constexpr int kMaxIterations = 8;
+  for (int iteration = 0; iteration < kMaxIterations; ++iteration) {
+    bool moved_island = false;
+    InlinedHashSet<NodeIndex> visited;
+
+    for (NodeIndex start = 0, end = graph.MaxNodeIndex(); start < end; ++start) {
+      if (candidate_eps.count(start) == 0 || !visited.insert(start).second) {
+        continue;
+      }
+
+      // collect the connected nodes with the same EP
+      const std::string island_ep = graph.GetNode(start)->GetExecutionProviderType();
+      InlinedHashSet<NodeIndex> island{start};
+      InlinedVector<NodeIndex> to_visit{start};
+      while (!to_visit.empty()) {
+        const Node& node = *graph.GetNode(to_visit.back());
+        to_visit.pop_back();
+
+        auto visit = [&](const Node& neighbour) {
+          if (candidate_eps.count(neighbour.Index()) > 0 && neighbour.GetExecutionProviderType() == island_ep &&
+              visited.insert(neighbour.Index()).second) {
+            island.insert(neighbour.Index());
+            to_visit.push_back(neighbour.Index());
+          }
+        };
+
+        for (auto it = node.InputNodesBegin(), it_end = node.InputNodesEnd(); it != it_end; ++it) {
+          visit(*it);
+        }
+        for (auto it = node.OutputNodesBegin(), it_end = node.OutputNodesEnd(); it != it_end; ++it) {
+          visit(*it);
+        }
+      }
+
+      // the EPs that can run every node of the island
+      InlinedVector<std::string_view> island_candidates = candidate_eps[start];
+      for (const auto node_index : island) {
+        const auto& node_candidates = candidate_eps[node_index];
+        island_candidates.erase(std::remove_if(island_candidates.begin(), island_candidates.end(),
+                                               [&node_candidates](std::string_view ep_type) {
+                                                 return std::find(node_candidates.cbegin(), node_candidates.cend(),
+                                                                  ep_type) == node_candidates.cend();
+                                               }),
+                                island_candidates.end());
+      }
+
+      const double current_cost = island_cost(island, island_ep);
+      double best_cost = current_cost;
+      std::string best_ep = island_ep;
+      for (const auto ep_type : island_candidates) {
+        const std::string candidate_ep{ep_type};
+        if (candidate_ep == island_ep) {
+          continue;
+        }
+
+        const double cost = island_cost(island, candidate_ep);
+        // require a minimal gain so rounding differences don't move nodes back and forth
+        if (cost < best_cost - 1e-3) {
+          best_cost = cost;
+          best_ep = candidate_ep;
+        }
+      }
+
+      if (best_ep != island_ep) {
+        LOGS_DEFAULT(VERBOSE) << "Moving " << island.size() << " node(s) from " << island_ep << " to " << best_ep
+                              << " reduces the estimated latency from " << current_cost << "us to " << best_cost
+                              << "us.";
+        for (const auto node_index : island) {
+          graph.GetNode(node_index)->SetExecutionProviderType(best_ep);
+        }
+        moved_island = true;
+      }
+    }
+
+    if (!moved_island) {
+      break;
+    }
+  }
+}
+
 static Status PartitionOnnxFormatModel(const PartitionParams& partition_params, GraphPartitioner::Mode mode,
                                        const ExecutionProviders& execution_providers,
-                                       KernelRegistryManager& kernel_registry_manager) {
+                                       KernelRegistryManager& kernel_registry_manager,
+                                       const PartitioningCostModel* cost_model) {
   bool modified_graph = false;
 
   auto& graph = partition_params.graph.get();
@@ -557,6 +799,10 @@ static Status PartitionOnnxFormatModel(const PartitionParams& partition_params,
     }
   } while (modified_graph);
 
+  if (cost_model != nullptr && mode == GraphPartitioner::Mode::kNormal) {
+    RefineAssignmentWithCostModel(graph, *cost_model, execution_providers, kernel_registry_manager);
+  }
+
   return Status::OK();
 }
 
@@ -694,6 +940,8 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
   //          but are completely separate Graph instances and not a subset of nodes within a single Graph instance.
   // 3. CPU execution provider is expected to be able to run any node and is the last one in execution provider
   //    preference.
+  // 4. If a cost model is provided, islands of nodes are moved between EPs with kernels when that lowers the
+  //    estimated latency. See RefineAssignmentWithCostModel.
   if (providers_.Empty()) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "No provider specified.");
   }
@@ -728,8 +976,9 @@ Status GraphPartitioner::Partition(Graph& graph, FuncManager& func_mgr,
   if (mode == Mode::kNormal || mode == Mode::kAssignOnly) {
 #if !defined(ORT_MINIMAL_BUILD)
     ORT_RETURN_IF_ERROR(PartitionOnnxFormatModel(partition_params, mode,
-                                                 providers_, kernel_registry_mgr_));
+                                                 providers_, kernel_registry_mgr_, cost_model_));
 #else
+    ORT_UNUSED_PARAMETER(cost_model_);
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "ONNX models are not supported in this build.");
 #endif  //! defined(ORT_MINIMAL_BUILD)
   } else {
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/graph/graph.h"
 #include "core/framework/fuse_nodes_funcs.h"
 
@@ -13,6 +14,20 @@ class ExecutionProviders;
 class KernelRegistryManager;
 using TransformLayoutFunction = std::function<Status(Graph& graph, bool& modified, IExecutionProvider& current_ep)>;
 
+// Estimated costs that GraphPartitioner uses to refine the greedy node assignment.
+struct PartitioningCostModel {
+  // estimated latency in microseconds of a node of the op type with the EP. op type -> EP type -> latency.
+  InlinedHashMap<std::string, InlinedHashMap<std::string, double>> op_costs;
+
+  // estimated latency in microseconds of copying a tensor between devices is
+  // copy_overhead_us + size in bytes / copy_bytes_per_us.
+  double copy_overhead_us{10.0};
+  double copy_bytes_per_us{10000.0};
+
+  // size assumed for tensors without a static shape
+  size_t default_tensor_bytes{4096};
+};
+
 class GraphPartitioner {
  public:
   enum class Mode {
@@ -22,9 +37,13 @@ class GraphPartitioner {
   };
 
   // The order of providers represents the user preference.
-  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers)
+  // If cost_model is provided, the nodes assigned to EPs with kernels are moved between those EPs afterwards where
+  // that lowers the estimated latency of the nodes and the copies between devices. It must outlive the partitioner.
+  GraphPartitioner(KernelRegistryManager& kernel_registry_mgr, const ExecutionProviders& providers,
+                   const PartitioningCostModel* cost_model = nullptr)
       : kernel_registry_mgr_(kernel_registry_mgr),
-        providers_(providers) {
+        providers_(providers),
+        cost_model_(cost_model) {
   }
 
   // Run partitioning.
@@ -37,6 +56,7 @@ class GraphPartitioner {
 
   KernelRegistryManager& kernel_registry_mgr_;
   const ExecutionProviders& providers_;
+  const PartitioningCostModel* cost_model_;
 };
 
 }  // namespace onnxruntime
@@ -5,6 +5,7 @@
 #include "core/common/common.h"
 #include "core/common/inlined_containers.h"
 #include "core/framework/allocation_planner.h"
+#include "core/framework/tensor_shape.h"
 
 namespace onnxruntime {
 struct MemoryBlock {
@@ -24,6 +25,10 @@ class MemoryPattern {
  public:
   MemoryPattern() = default;
 
+  MemoryPattern(InlinedHashMap<int, MemoryBlock> patterns, size_t peak_size)
+      : patterns_{std::move(patterns)},
+        peak_size_{peak_size} {}
+
   MemoryPattern(MemoryPattern&& rhs) noexcept
       : patterns_{std::move(rhs.patterns_)},
         peak_size_{std::move(rhs.peak_size_)} {}
@@ -70,4 +75,16 @@ struct MemoryPatternGroup {
     return nullptr;
   }
 };
+
+// An entry of the memory pattern cache kept by a SessionState.
+// The frames of concurrent runs hold a reference to the entry they use, so an entry can be
+// evicted from the cache or replaced while a run is still using it.
+struct MemoryPatternCacheEntry {
+  MemoryPatternGroup mem_patterns;
+  // The feed dims the patterns were generated with, prefixed by the rank of each feed.
+  // The patterns are valid for any feeds with the same ranks and dims no larger than these.
+  InlinedVector<int64_t> input_dims;
+  // The activation shapes inferred together with the patterns (training only).
+  InlinedHashMap<int, TensorShape> inferred_shapes;
+};
 }  // namespace onnxruntime
@@ -0,0 +1,264 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/prepacked_weights_disk_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <type_traits>
+
+#include "core/common/cpuid_info.h"
+#include "core/common/safeint.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensor.h"
+#include "core/graph/graph.h"
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr uint32_t kEntryMagic = 0x5054524f;  // "ORTP"
+// Bump this when the entry layout, or the layout of any pre-packed buffer that is cached, changes.
+constexpr uint32_t kEntryVersion = 1;
+// Buffers are placed at this alignment in the entry so the mapped buffers are suitably aligned for MLAS.
+constexpr size_t kBufferAlignment = 64;
+
+struct EntryHeader {
+  uint32_t magic;
+  uint32_t version;
+  uint64_t num_buffers;
+};
+
+struct BufferRecord {
+  uint64_t offset;
+  uint64_t size;
+};
+
+size_t AlignUp(size_t value) {
+  return (value + kBufferAlignment - 1) / kBufferAlignment * kBufferAlignment;
+}
+
+class KeyHasher {
+ public:
+  void Add(const void* data, size_t len) {
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    // MurmurHash3 takes an int length, so hash large buffers in chunks, chaining the seed.
+    constexpr size_t kMaxChunk = 1 << 30;
+    do {
+      const size_t chunk = std::min(len, kMaxChunk);
+      MurmurHash3::x86_128(bytes, static_cast<int>(chunk), hash_[0] ^ hash_[2], &hash_);
+      bytes += chunk;
+      len -= chunk;
+    } while (len > 0);
+  }
+
+  void Add(const std::string& str) {
+    Add(static_cast<uint64_t>(str.size()));
+    Add(str.data(), str.size());
+  }
+
+  template <typename T>
+  void Add(T value) {
+    static_assert(std::is_arithmetic<T>::value, "Use Add(data, len) for non-arithmetic types");
+    Add(&value, sizeof(value));
+  }
+
+  std::string ToString() const {
+    std::ostringstream ss;
+    ss << std::hex << std::setfill('0');
+    for (uint32_t h : hash_) {
+      ss << std::setw(8) << h;
+    }
+    return ss.str();
+  }
+
+ private:
+  uint32_t hash_[4] = {0, 0, 0, 0};
+};
+
+// The layout of MLAS packed buffers depends on the kernels MLAS dispatches to on this CPU.
+std::string GetIsaTag() {
+  const auto& cpuid_info = CPUIDInfo::GetCPUIDInfo();
+  std::string tag;
+  tag += cpuid_info.HasSSE3() ? '1' : '0';
+  tag += cpuid_info.HasSSE4_1() ? '1' : '0';
+  tag += cpuid_info.HasAVX() ? '1' : '0';
+  tag += cpuid_info.HasAVX2() ? '1' : '0';
+  tag += cpuid_info.HasAVX512f() ? '1' : '0';
+  tag += cpuid_info.HasAVX512Skylake() ? '1' : '0';
+  tag += cpuid_info.HasAVX512_BF16() ? '1' : '0';
+  tag += cpuid_info.HasAMX_BF16() ? '1' : '0';
+  tag += cpuid_info.HasArmNeonDot() ? '1' : '0';
+  return tag;
+}
+
+void RemoveFile(const PathString& path) {
+#ifdef _WIN32
+  _wremove(path.c_str());
+#else
+  std::remove(path.c_str());
+#endif
+}
+
+}  // namespace
+
+std::string PrepackedWeightsDiskCache::GetKey(const Node& node, int input_idx, const Tensor& tensor) {
+  if (tensor.IsDataTypeString()) {
+    return {};
+  }
+
+  static const std::string isa_tag = GetIsaTag();
+
+  KeyHasher hasher;
+  hasher.Add(kEntryVersion);
+  hasher.Add(isa_tag);
+  hasher.Add(node.OpType());
+  hasher.Add(node.Domain());
+  hasher.Add(node.SinceVersion());
+
+  // Attributes can change how a weight is packed, e.g. transB for Gemm. Hash them in name order as the
+  // attributes map is unordered.
+  const auto& attributes = node.GetAttributes();
+  std::vector<std::string> attribute_names;
+  attribute_names.reserve(attributes.size());
+  for (const auto& attribute : attributes) {
+    attribute_names.push_back(attribute.first);
+  }
+  std::sort(attribute_names.begin(), attribute_names.end());
+  for (const auto& name : attribute_names) {
+    hasher.Add(name);
+    hasher.Add(attributes.at(name).SerializeAsString());
+  }
+
+  hasher.Add(input_idx);
+  hasher.Add(tensor.GetElementType());
+  for (int64_t dim : tensor.Shape().GetDims()) {
+    hasher.Add(dim);
+  }
+  hasher.Add(tensor.DataRaw(), tensor.SizeInBytes());
+
+  return hasher.ToString();
+}
+
+PathString PrepackedWeightsDiskCache::GetEntryPath(const std::string& key) const {
+  PathString path = cache_dir_;
+  if (!path.empty() && path.back() != ORT_TSTR('/') && path.back() != ORT_TSTR('\\')) {
+    path += ORT_TSTR('/');
+  }
+  return path + ToPathString(key) + ORT_TSTR(".prepacked");
+}
+
+Status PrepackedWeightsDiskCache::TryLoad(const std::string& key, PrePackedWeights& packed_weights, bool& found) {
+  found = false;
+
+  const PathString path = GetEntryPath(key);
+  size_t file_length = 0;
+  if (!Env::Default().GetFileLength(path.c_str(), file_length).IsOK() || file_length < sizeof(EntryHeader)) {
+    // not cached yet
+    return Status::OK();
+  }
+
+  Env::MappedMemoryPtr mapped_entry;
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(path.c_str(), 0, file_length, mapped_entry));
+  const char* entry = mapped_entry.get();
+
+  EntryHeader header;
+  memcpy(&header, entry, sizeof(header));
+  ORT_RETURN_IF_NOT(header.magic == kEntryMagic && header.version == kEntryVersion,
+                    "Pre-packed weights cache entry ", ToUTF8String(path), " has an unexpected format.");
+  ORT_RETURN_IF_NOT(header.num_buffers <= (file_length - sizeof(EntryHeader)) / sizeof(BufferRecord),
+                    "Pre-packed weights cache entry ", ToUTF8String(path), " is truncated.");
+
+  PrePackedWeights loaded;
+  for (uint64_t i = 0; i < header.num_buffers; ++i) {
+    BufferRecord record;
+    memcpy(&record, entry + sizeof(EntryHeader) + i * sizeof(BufferRecord), sizeof(record));
+    ORT_RETURN_IF_NOT(record.offset <= file_length && record.size <= file_length - record.offset,
+                      "Pre-packed weights cache entry ", ToUTF8String(path), " is truncated.");
+
+    // The kernel must not free the buffer, it belongs to the mapping.
+    void* buffer = record.size == 0 ? nullptr : const_cast<char*>(entry + record.offset);
+    loaded.buffers_.emplace_back(buffer, BufferDeleter(nullptr));
+    loaded.buffer_sizes_.push_back(static_cast<size_t>(record.size));
+  }
+
+  mapped_entries_.push_back(std::move(mapped_entry));
+  packed_weights = std::move(loaded);
+  found = true;
+
+  return Status::OK();
+}
+
+Status PrepackedWeightsDiskCache::Save(const std::string& key, const PrePackedWeights& packed_weights) const {
+  ORT_ENFORCE(packed_weights.buffers_.size() == packed_weights.buffer_sizes_.size());
+
+  const size_t num_buffers = packed_weights.buffers_.size();
+  std::vector<BufferRecord> records(num_buffers);
+  size_t offset = AlignUp(sizeof(EntryHeader) + SafeInt<size_t>(num_buffers) * sizeof(BufferRecord));
+  for (size_t i = 0; i < num_buffers; ++i) {
+    const size_t size = packed_weights.buffers_[i] != nullptr ? packed_weights.buffer_sizes_[i] : 0;
+    records[i].offset = size == 0 ? 0 : offset;
+    records[i].size = size;
+    offset = AlignUp(SafeInt<size_t>(offset) + size);
+  }
+
+  if (!Env::Default().FolderExists(cache_dir_)) {
+    ORT_RETURN_IF_ERROR(Env::Default().CreateFolder(cache_dir_));
+  }
+
+  // Write to a file unique to this writer and rename it into place so readers never see a partial entry.
+  static std::atomic<uint64_t> temp_file_counter{0};
+  const PathString path = GetEntryPath(key);
+  const PathString temp_path = path + ORT_TSTR(".") +
+                               ToPathString(std::to_string(Env::Default().GetSelfPid()) + "." +
+                                            std::to_string(temp_file_counter++)) +
+                               ORT_TSTR(".tmp");
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    ORT_RETURN_IF_NOT(out.good(), "Failed to create pre-packed weights cache entry ", ToUTF8String(temp_path));
+
+    const EntryHeader header{kEntryMagic, kEntryVersion, static_cast<uint64_t>(num_buffers)};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(records.data()), num_buffers * sizeof(BufferRecord));
+
+    const char padding[kBufferAlignment] = {};
+    size_t written = sizeof(EntryHeader) + num_buffers * sizeof(BufferRecord);
+    for (size_t i = 0; i < num_buffers; ++i) {
+      if (records[i].size == 0) {
+        continue;
+      }
+      out.write(padding, static_cast<std::streamsize>(records[i].offset - written));
+      out.write(static_cast<const char*>(packed_weights.buffers_[i].get()), static_cast<std::streamsize>(records[i].size));
+      written = static_cast<size_t>(records[i].offset + records[i].size);
+    }
+
+    out.close();
+    if (out.fail()) {
+      RemoveFile(temp_path);
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write pre-packed weights cache entry ",
+                             ToUTF8String(temp_path));
+    }
+  }
+
+#ifdef _WIN32
+  // _wrename doesn't replace an existing file. If another process created the entry in the meantime it has the
+  // same contents, so just keep that one.
+  if (_wrename(temp_path.c_str(), path.c_str()) != 0) {
+    RemoveFile(temp_path);
+  }
+#else
+  if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+    RemoveFile(temp_path);
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to rename pre-packed weights cache entry to ", path);
+  }
+#endif
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
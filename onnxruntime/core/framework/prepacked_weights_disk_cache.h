@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/framework/prepacked_weights.h"
+#include "core/platform/env.h"
+
+namespace onnxruntime {
+
+class Node;
+class Tensor;
+
+/**
+ * On-disk cache of pre-packed weights that persists across sessions and processes.
+ *
+ * Each entry holds the buffers that a kernel's PrePack() stored in a PrePackedWeights instance, in a file named by
+ * a hash of the node's op type, domain, opset version and attributes, the input index, the contents of the
+ * constant initializer, and the CPU ISA the packing was done for. Entries are memory mapped read-only on lookup,
+ * so the buffers returned by TryLoad() are valid for the lifetime of this instance and must not be written to.
+ *
+ * Entries are written to a temporary file first and renamed into place, so concurrent writers of the same entry
+ * from different processes are safe.
+ */
+class PrepackedWeightsDiskCache final {
+ public:
+  explicit PrepackedWeightsDiskCache(const PathString& cache_dir) : cache_dir_(cache_dir) {}
+
+  // Returns the cache key for the pre-packed weights of `tensor`, which is input `input_idx` of `node`.
+  // Returns an empty key if the tensor can't be cached, e.g. it is a string tensor.
+  static std::string GetKey(const Node& node, int input_idx, const Tensor& tensor);
+
+  // Looks up the entry for `key`. On a hit, `packed_weights` is filled in with buffers that point into the mapped
+  // file and `found` is set to true. An entry that doesn't exist is not an error.
+  common::Status TryLoad(const std::string& key, PrePackedWeights& packed_weights, bool& found);
+
+  // Writes the entry for `key`, replacing any existing entry.
+  common::Status Save(const std::string& key, const PrePackedWeights& packed_weights) const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PrepackedWeightsDiskCache);
+
+ private:
+  PathString GetEntryPath(const std::string& key) const;
+
+  const PathString cache_dir_;
+
+  // Mappings of the entries returned by TryLoad(). Kernels refer to these so they live as long as the cache.
+  std::vector<Env::MappedMemoryPtr> mapped_entries_;
+};
+
+}  // namespace onnxruntime
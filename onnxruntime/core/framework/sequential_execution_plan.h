@@ -35,6 +35,10 @@ struct AllocPlanPerValue {
   // reused_buffer is valid only if alloc_kind == kReuse. It indicates
   // which OrtValue's buffer must be reused for this OrtValue.
   OrtValueIndex reused_buffer{0};
+  // is_sub_view is valid only if alloc_kind == kReuse. It indicates that this OrtValue is a view on the part of
+  // reused_buffer starting at sub_view_offset bytes, e.g. a Concat input produced in place in the Concat output.
+  bool is_sub_view{false};
+  size_t sub_view_offset{0};
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   IntervalT life_interval{0, 0};
   IntervalT allocate_interval{0, 0};
@@ -177,6 +177,11 @@ class SessionScope {
       session_start_ = session_state.Profiler().Start();
     }
 
+    auto* sampling_profiler = session_state_.Profiler().GetSamplingProfiler();
+    if (sampling_profiler != nullptr && sampling_profiler->ShouldSampleRun()) {
+      sampling_profiler_ = sampling_profiler;
+    }
+
     auto& logger = session_state_.Logger();
     LOGS(logger, INFO) << "Begin execution";
     const SequentialExecutionPlan& seq_exec_plan = *session_state_.GetExecutionPlan();
@@ -222,6 +227,10 @@ class SessionScope {
     if (session_state_.Profiler().IsEnabled()) {
       session_state_.Profiler().EndTimeAndRecordEvent(profiling::SESSION_EVENT, "SequentialExecutor::Execute", session_start_);
     }
+
+    if (sampling_profiler_ != nullptr) {
+      sampling_profiler_->OnSampledRunEnd();
+    }
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
     auto& logger = session_state_.Logger();
     for (auto i : frame_.GetStaticMemorySizeInfo()) {
@@ -238,6 +247,8 @@ class SessionScope {
 private:
   const SessionState& session_state_;
   TimePoint session_start_;
+  // set if the nodes of this execution are timed by the sampling profiler
+  profiling::SamplingProfiler* sampling_profiler_ = nullptr;
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   const ExecutionFrame& frame_;
 #endif
@@ -316,6 +327,10 @@ class KernelScope {
     node_compute_range_.Begin();
 #endif
 
+    if (session_scope_.sampling_profiler_ != nullptr) {
+      sample_begin_time_ = std::chrono::steady_clock::now();
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& node = kernel.Node();
       node_name_ = node.Name().empty() ? MakeString(node.OpType(), "_", node.Index()) : node.Name();
@@ -325,7 +340,7 @@ class KernelScope {
                                      node_name_ + "_fence_before",
                                      sync_time_begin,
                                      {{"op_name", kernel_.KernelDef().OpName()}});
-      concurrency::ThreadPool::StartProfiling(session_state_.GetThreadPool());
+      concurrency::ThreadPool::StartProfiling(session_state_.GetThreadPool(), profiler.IsTimelineTracksEnabled());
       VLOGS(session_state_.Logger(), 1) << "Computing kernel: " << node_name_;
       kernel_begin_time_ = session_state_.Profiler().Start();
       CalculateTotalInputSizes(&kernel_context, &kernel_,
@@ -341,6 +356,12 @@ class KernelScope {
     node_compute_range_.End();
 #endif
 
+    if (session_scope_.sampling_profiler_ != nullptr) {
+      const auto& node = kernel_.Node();
+      session_scope_.sampling_profiler_->RecordNodeLatency(node.Name(), node.OpType(), node.Index(),
+                                                           std::chrono::steady_clock::now() - sample_begin_time_);
+    }
+
     if (session_state_.Profiler().IsEnabled()) {
       auto& profiler = session_state_.Profiler();
       std::string output_type_shape_;
@@ -360,6 +381,9 @@ class KernelScope {
                                          {"output_type_shape", output_type_shape_},
                                          {"thread_scheduling_stats", concurrency::ThreadPool::StopProfiling(session_state_.GetThreadPool())},
                                      });
+      if (profiler.IsTimelineTracksEnabled()) {
+        RecordTimelineTracks(profiler);
+      }
       auto sync_time_begin = profiler.Start();
       profiler.EndTimeAndRecordEvent(profiling::NODE_EVENT,
                                      node_name_ + "_fence_after",
@@ -387,7 +411,25 @@ class KernelScope {
   }  //~KernelScope
 
  private:
+  // Records the runs of the tasks on the workers of the intra-op thread pool as events of the worker threads,
+  // and the bytes in use of the arena of the kernel as a counter.
+  void RecordTimelineTracks(profiling::Profiler& profiler) {
+    for (const auto& run : concurrency::ThreadPool::TakeProfiledWorkerRuns(session_state_.GetThreadPool())) {
+      profiler.RecordEvent(profiling::NODE_EVENT, node_name_ + "_worker_run", static_cast<int>(run.thread_id),
+                           run.start, run.end, {{"op_name", kernel_.KernelDef().OpName()}});
+    }
+
+    const auto* execution_provider = kernel_.Info().GetExecutionProvider();
+    AllocatorPtr allocator = execution_provider->GetAllocator(execution_provider->GetDeviceId(), OrtMemTypeDefault);
+    if (allocator != nullptr && allocator->Info().alloc_type == OrtArenaAllocator) {
+      AllocatorStats stats;
+      allocator->GetStats(&stats);
+      profiler.RecordCounter(std::string(allocator->Info().name) + "_arena", "bytes_in_use", stats.bytes_in_use);
+    }
+  }
+
   TimePoint kernel_begin_time_;
+  std::chrono::steady_clock::time_point sample_begin_time_;
   SessionScope& session_scope_;
   const SessionState& session_state_;
   std::string node_name_;
@@ -427,6 +469,8 @@ onnxruntime::Status ExecuteKernel(StreamExecutionContext& ctx,
     ctx.RecycleNodeInputs(idx);
     return Status::OK();
   }
+  // a low priority run lets the kernels of high priority runs in progress have the threads first
+  concurrency::ThreadPool::YieldToHighPriorityWork();
   // TODO: set terminate flag from run_option
   OpKernelContextInternal kernel_ctx(ctx.GetSessionState(),
                                      ctx.GetExecutionFrame(),
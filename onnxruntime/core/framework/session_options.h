@@ -136,6 +136,12 @@ struct SessionOptions {
 
   // custom function callback to join a thread
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
+
+  // custom function callback to run the work of the thread pools on a scheduler of the host application
+  OrtCustomScheduleFn custom_schedule_fn = nullptr;
+
+  // custom parameter to pass to custom_schedule_fn
+  void* custom_scheduler_param = nullptr;
 };
 
 }  // namespace onnxruntime
@@ -3,10 +3,16 @@
 
 #include "core/framework/session_state.h"
 
+#include <algorithm>
+#include <optional>
 #include <sstream>
 
 #include "core/platform/ort_mutex.h"
+#include "core/platform/threadpool.h"
+#include "core/common/hash_combine.h"
 #include "core/common/logging/logging.h"
+#include "core/common/narrow.h"
+#include "core/common/parse_string.h"
 #include "core/common/safeint.h"
 #include "core/flatbuffers/schema/ort.fbs.h"
 #include "core/framework/allocator.h"
@@ -14,6 +20,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/framework/ort_value_pattern_planner.h"
 #include "core/framework/session_state_utils.h"
+#include "core/framework/tensorprotoutils.h"
 #include "core/framework/utils.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/session/onnxruntime_session_options_config_keys.h"
@@ -61,6 +68,8 @@ class StreamCommandHandleRegistryImpl : public IStreamCommandHandleRegistry {
 };
 #endif
 
+thread_local const ThreadPoolOverride* SessionState::thread_pool_override_ = nullptr;
+
 SessionState::SessionState(Graph& graph,
                            const ExecutionProviders& execution_providers,
                            bool enable_mem_pattern,
@@ -181,12 +190,53 @@ void SessionState::CreateGraphInfo() {
   LOGS(logger_, VERBOSE) << "Done saving OrtValue mappings.";
 }
 
+// The kernel lookup only depends on the EP, op, since version and the types of the node args, so nodes sharing
+// those resolve to the same kernel. The types are interned strings, their addresses identify them.
+static std::string GetKernelLookupKey(const Node& node) {
+  std::string key;
+  key.reserve(node.GetExecutionProviderType().size() + node.Domain().size() + node.OpType().size() + 64);
+  key.append(node.GetExecutionProviderType()).push_back(':');
+  key.append(node.Domain()).push_back(':');
+  key.append(node.OpType()).push_back(':');
+  key.append(std::to_string(node.SinceVersion()));
+
+  auto append_types = [&key](const ConstPointerContainer<std::vector<NodeArg*>>& defs) {
+    key.push_back('|');
+    for (const NodeArg* def : defs) {
+      const void* type = def->Exists() ? static_cast<const void*>(def->Type()) : nullptr;
+      key.append(reinterpret_cast<const char*>(&type), sizeof(type));
+    }
+  };
+  append_types(node.InputDefs());
+  append_types(node.OutputDefs());
+
+  key.push_back('|');
+  for (int count : node.InputArgCount()) {
+    key.append(std::to_string(count)).push_back(',');
+  }
+
+  return key;
+}
+
 Status SessionState::PopulateKernelCreateInfo(const KernelRegistryManager& kernel_registry_manager,
                                               bool saving_ort_format) {
+  // Large models repeat the same few node configs many times, avoid searching the registries for each of them.
+  InlinedHashMap<std::string, const KernelCreateInfo*> kernel_lookup_cache;
+  kernel_lookup_cache.reserve(static_cast<size_t>(graph_.NumberOfNodes()));
+
   for (auto& node : graph_.Nodes()) {
     const KernelCreateInfo* kci = nullptr;
+    std::string lookup_key = GetKernelLookupKey(node);
+    if (auto cached = kernel_lookup_cache.find(lookup_key); cached != kernel_lookup_cache.end()) {
+      ORT_IGNORE_RETURN_VALUE(
+          kernel_create_info_map_.insert({node.Index(), gsl::not_null<const KernelCreateInfo*>(cached->second)}));
+      continue;
+    }
+
     auto status = kernel_registry_manager.SearchKernelRegistry(node, &kci);
-    if (!status.IsOK() && saving_ort_format) {
+    if (status.IsOK()) {
+      kernel_lookup_cache.emplace(std::move(lookup_key), kci);
+    } else if (saving_ort_format) {
       // if we didn't find the kernel and are saving to ORT format an EP that compiles nodes is enabled.
       // in that case we assigned the node to that EP but do not compile it into a fused node.
       // this keeps the original node and prevents level 2 and level 3 optimizers from modifying it.
@@ -370,9 +420,134 @@ static std::string GenerateKeyForPrepackedWeightsMap(const std::string& op_type,
   return ss_1.str();
 }
 
+Status SessionState::PrepackWithDiskCache(const Node& node, OpKernel& kernel, int input_idx, const Tensor& tensor,
+                                          /*out*/ bool& is_packed) {
+  is_packed = false;
+
+  const std::string key = PrepackedWeightsDiskCache::GetKey(node, input_idx, tensor);
+  bool found = false;
+  if (!key.empty()) {
+    PrePackedWeights cached_weights;
+    ORT_RETURN_IF_ERROR(prepacked_weights_disk_cache_->TryLoad(key, cached_weights, found));
+    if (found) {
+      ORT_RETURN_IF_ERROR(kernel.UseCachedPrePackedBuffers(tensor, input_idx, cached_weights.buffers_, is_packed));
+      if (is_packed) {
+        LOGS(logger_, INFO) << "Using pre-packed weight from the on-disk cache for input " << input_idx
+                            << " of the node: " << node.Name() << " which is of op type: " << node.OpType();
+        ++used_disk_cached_pre_packed_weights_counter_;
+        return Status::OK();
+      }
+    }
+  }
+
+  AllocatorPtr session_cpu_alloc = kernel.Info().GetAllocator(0, OrtMemType::OrtMemTypeDefault);
+  PrePackedWeights weights_to_be_filled_in;
+  ORT_RETURN_IF_ERROR(kernel.PrePack(tensor, input_idx, session_cpu_alloc, is_packed, &weights_to_be_filled_in));
+
+  // A kernel that keeps the packed buffers itself, e.g. for a packing variant it doesn't share, can't be cached.
+  if (!is_packed || weights_to_be_filled_in.buffers_.empty()) {
+    return Status::OK();
+  }
+
+  if (!key.empty() && !found) {
+    auto status = prepacked_weights_disk_cache_->Save(key, weights_to_be_filled_in);
+    if (!status.IsOK()) {
+      // the cache is an optimization so failing to write to it only costs a re-pack in the next session
+      LOGS(logger_, WARNING) << "Failed to save the pre-packed weight for the node: " << node.Name()
+                             << " to the on-disk cache. " << status.ErrorMessage();
+    }
+  }
+
+  // Hand the buffers back to the kernel along with their ownership.
+  bool used_shared_buffers = false;
+  ORT_RETURN_IF_ERROR(kernel.UseSharedPrePackedBuffers(weights_to_be_filled_in.buffers_, input_idx,
+                                                       used_shared_buffers));
+  if (!used_shared_buffers) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The kernel corresponding to the node ", node.Name(),
+                           " doesn't have an implementation that can consume provided pre-packed weights");
+  }
+
+  return Status::OK();
+}
+
+static uint64_t GetPrePackResultKey(NodeIndex node_index, int input_idx) {
+  return (static_cast<uint64_t>(node_index) << 32) | static_cast<uint32_t>(input_idx);
+}
+
+Status SessionState::ParallelPrePackConstantInitializedTensors(
+    const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+    InlinedHashMap<uint64_t, bool>& prepack_results) {
+  // the on-disk cache serializes its reads and writes, leave those to the sequential pass
+  if (prepacked_weights_disk_cache_ != nullptr || concurrency::ThreadPool::DegreeOfParallelism(thread_pool_) <= 1) {
+    return Status::OK();
+  }
+
+  struct PrePackItem {
+    OpKernel* kernel;
+    int input_idx;
+    const Tensor* tensor;
+    uint64_t key;
+  };
+  std::vector<PrePackItem> items;
+
+  // only the constant initializers of this graph, the outer scope ones are left to the sequential pass
+  for (auto& node : GetGraphViewer().Nodes()) {
+    if (node.GetExecutionProviderType() != kCpuExecutionProvider) {
+      continue;
+    }
+    OpKernel* kernel = GetMutableKernel(node.Index());
+    int input_idx = 0;
+    for (const auto* input_def : node.InputDefs()) {
+      const std::string& input_name = input_def->Name();
+      int ort_value_idx;
+      if (input_def->Exists() &&
+          (prepacked_weights_container_ == nullptr || initializers_to_share_map.count(input_name) == 0) &&
+          GetOrtValueNameIdxMap().GetIdx(input_name, ort_value_idx).IsOK()) {
+        auto it = constant_initialized_tensors_.find(ort_value_idx);
+        if (it != constant_initialized_tensors_.end()) {
+          items.push_back({kernel, input_idx, &it->second.Get<Tensor>(), GetPrePackResultKey(node.Index(), input_idx)});
+        }
+      }
+      ++input_idx;
+    }
+  }
+
+  if (items.size() < 2) {
+    return Status::OK();
+  }
+
+  std::vector<Status> statuses(items.size());
+  std::unique_ptr<bool[]> is_packed = std::make_unique<bool[]>(items.size());
+  concurrency::ThreadPool::TrySimpleParallelFor(
+      thread_pool_, static_cast<std::ptrdiff_t>(items.size()), [&](std::ptrdiff_t i) {
+        const PrePackItem& item = items[i];
+        ORT_TRY {
+          AllocatorPtr session_cpu_alloc = item.kernel->Info().GetAllocator(0, OrtMemType::OrtMemTypeDefault);
+          statuses[i] = item.kernel->PrePack(*item.tensor, item.input_idx, session_cpu_alloc, is_packed[i], nullptr);
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            statuses[i] = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "PrePack failed: ", ex.what());
+          });
+        }
+      });
+
+  prepack_results.reserve(items.size());
+  for (size_t i = 0; i < items.size(); ++i) {
+    ORT_RETURN_IF_ERROR(statuses[i]);
+    prepack_results.emplace(items[i].key, is_packed[i]);
+  }
+
+  return Status::OK();
+}
+
 Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
                                                        const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map) {
-  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map](
+  InlinedHashMap<uint64_t, bool> prepack_results;
+  ORT_RETURN_IF_ERROR(ParallelPrePackConstantInitializedTensors(initializers_to_share_map, prepack_results));
+
+  auto prepacked_constant_weights = [this, &constant_initializers_use_count, &initializers_to_share_map,
+                                     &prepack_results](
                                         bool should_cache_prepacked_weights_for_shared_initializers) -> Status {
     for (auto& node : GetGraphViewer().Nodes()) {
       auto kernel = GetMutableKernel(node.Index());
@@ -452,6 +627,13 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
                     }
                   }
 
+                } else if (prepacked_weights_disk_cache_ != nullptr &&
+                           node.GetExecutionProviderType() == kCpuExecutionProvider) {  // on-disk cache turned ON
+                  ORT_RETURN_IF_ERROR(PrepackWithDiskCache(node, *kernel, input_idx, const_initialized_tensor,
+                                                           is_packed));
+                } else if (auto result = prepack_results.find(GetPrePackResultKey(node.Index(), input_idx));
+                           st == this && result != prepack_results.end()) {  // already done in parallel
+                  is_packed = result->second;
                 } else {  // caching of pre-packed weights' turned OFF
                   AllocatorPtr session_cpu_alloc = kernel->Info().GetAllocator(0, OrtMemType::OrtMemTypeDefault);
                   ORT_RETURN_IF_ERROR(kernel->PrePack(const_initialized_tensor, input_idx,
@@ -499,15 +681,50 @@ Status SessionState::PrepackConstantInitializedTensors(InlinedHashMap<std::strin
   }
 }
 
-static int64_t CalculateMemoryPatternsKey(const gsl::span<const OrtValue>& tensor_inputs) {
-  int64_t key = 0;
-  for (const auto& input : tensor_inputs) {
-    for (auto dim : input.Get<Tensor>().Shape().GetDims()) key ^= dim;
+// Calculate the memory pattern cache key from the input shapes, and collect the input dims, each input prefixed by
+// its rank. If dim_bucket_size is larger than 1, the dims are rounded up to a multiple of it for the key so that
+// inputs with similar shapes, e.g. variable sequence lengths, share one cache entry.
+static size_t CalculateMemoryPatternsKey(gsl::span<const int64_t> input_dims, int64_t dim_bucket_size) {
+  size_t key = 0;
+  for (size_t i = 0; i < input_dims.size();) {
+    const auto rank = static_cast<size_t>(input_dims[i++]);
+    HashCombine(rank, key);
+    for (const size_t end = i + rank; i < end; ++i) {
+      const int64_t dim = input_dims[i];
+      HashCombine(dim_bucket_size > 1 ? (dim + dim_bucket_size - 1) / dim_bucket_size : dim, key);
+    }
   }
   return key;
 }
 
-#ifdef ENABLE_TRAINING
+static size_t CalculateMemoryPatternsKey(gsl::span<const OrtValue> tensor_inputs, int64_t dim_bucket_size,
+                                         InlinedVector<int64_t>& input_dims) {
+  input_dims.clear();
+  for (const auto& input : tensor_inputs) {
+    auto dims = input.Get<Tensor>().Shape().GetDims();
+    input_dims.push_back(static_cast<int64_t>(dims.size()));
+    input_dims.insert(input_dims.end(), dims.begin(), dims.end());
+  }
+  return CalculateMemoryPatternsKey(input_dims, dim_bucket_size);
+}
+
+// Check whether a cached entry can be used for inputs with input_dims.
+// The memory blocks of the patterns are large enough for inputs no larger than the ones they were generated with,
+// but the inferred shapes are only valid for the very same inputs.
+static bool IsMemoryPatternUsable(const MemoryPatternCacheEntry& entry, gsl::span<const int64_t> input_dims) {
+  const auto& cached_dims = entry.input_dims;
+  if (cached_dims.size() != input_dims.size()) {
+    return false;
+  }
+  const bool need_exact_dims = !entry.inferred_shapes.empty();
+  for (size_t i = 0; i < input_dims.size(); ++i) {
+    if (input_dims[i] > cached_dims[i] || (need_exact_dims && input_dims[i] != cached_dims[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 namespace {
 Status ResolveDimParams(const GraphViewer& graph,
                         const InlinedHashMap<std::string, TensorShape>& feeds,
@@ -578,6 +795,7 @@ Status TryResolveShape(
   return Status::OK();
 }
 
+#ifdef ENABLE_TRAINING
 void TryCalculateSizeFromResolvedShape(int ml_value_idx, const InlinedHashMap<int, TensorShape>& resolved_shapes, size_t& size) {
   size = 0;
   auto shape = resolved_shapes.find(ml_value_idx);
@@ -587,9 +805,11 @@ void TryCalculateSizeFromResolvedShape(int ml_value_idx, const InlinedHashMap<in
       size *= dim;
   }
 }
+#endif
 
 }  // namespace
 
+#ifdef ENABLE_TRAINING
 // If this function fails NO memory planning will take place, hence lets ONLY FAIL and stop training where warranted, example SIZE overflow.
 Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                                gsl::span<const int> feed_mlvalue_idxs,
@@ -741,38 +961,306 @@ Status SessionState::GeneratePatternGroupCache(gsl::span<const OrtValue> tensor_
 
 #endif
 
-// MemoryPatternGroup pointer is cached. It only inserted upon creation
-// and is not updated if already present.
-const MemoryPatternGroup* SessionState::GetMemoryPatternGroup(
-    gsl::span<const OrtValue> tensor_inputs,
-    gsl::span<const int> feed_mlvalue_idxs,
-    const InlinedHashMap<int, TensorShape>*& out_inferred_shapes) const {
-  out_inferred_shapes = nullptr;
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+Status SessionState::GenerateMemoryPatternsFromShapes(const InlinedHashMap<std::string, TensorShape>& input_shapes,
+                                                      MemoryPatternGroup& patterns,
+                                                      size_t& num_unresolved_tensors) const {
+  num_unresolved_tensors = 0;
+  InlinedHashMap<std::string, int64_t> dim_params;
+  ORT_RETURN_IF_ERROR(ResolveDimParams(*graph_viewer_, input_shapes, dim_params));
+  const auto* exe_plan = GetExecutionPlan();
+  ORT_ENFORCE(exe_plan);
+  const auto& allocation_plan = exe_plan->allocation_plan;
+  OrtValuePatternPlanner mem_planner(*exe_plan);
+  InlinedHashSet<int> traced_values;
+
+  // Trace the allocations and frees of the activations as the frame of a single stream run would.
+  const auto& node_index_info = GetNodeIndexInfo();
+  for (auto node_index : graph_viewer_->GetNodesInTopologicalOrder(execution_order_)) {
+    const auto* node = graph_viewer_->GetNode(node_index);
+    const int output_start = node_index_info.GetNodeOffset(node_index) +
+                             static_cast<int>(node->InputDefs().size()) +
+                             static_cast<int>(node->ImplicitInputDefs().size());
+    for (int i = 0, end = static_cast<int>(node->OutputDefs().size()); i < end; ++i) {
+      const auto ml_value_idx = node_index_info.GetMLValueIndex(output_start + i);
+      if (ml_value_idx == NodeIndexInfo::kInvalidEntry) {
+        continue;
+      }
+
+      const auto& per_value_plan = allocation_plan[ml_value_idx];
+      if ((per_value_plan.alloc_kind != AllocKind::kAllocate &&
+           per_value_plan.alloc_kind != AllocKind::kAllocateOutput) ||
+          !per_value_plan.value_type->IsTensorType()) {
+        continue;
+      }
+
+      const auto* ml_data_type = static_cast<const TensorTypeBase*>(per_value_plan.value_type)->GetElementType();
+      size_t num_elements = 0;
+      TensorShapeVector resolved_shape;
+      if (utils::IsDataTypeString(ml_data_type) ||
+          !TryResolveShape(node->OutputDefs()[i], dim_params, num_elements, resolved_shape).IsOK() ||
+          num_elements == 0) {
+        ++num_unresolved_tensors;
+        continue;
+      }
+
+      size_t size = 0;
+      ORT_RETURN_IF_NOT(IAllocator::CalcMemSizeForArrayWithAlignment<kAllocAlignment>(num_elements,
+                                                                                      ml_data_type->Size(), &size),
+                        "Size overflow");
+      ORT_RETURN_IF_ERROR(mem_planner.TraceAllocation(ml_value_idx, size));
+      traced_values.insert(ml_value_idx);
+    }
+
+    for (auto release_action_idx : exe_plan->node_release_list[node_index]) {
+      const auto& action = exe_plan->release_actions[release_action_idx];
+      // the values consumed by multiple streams are released when their last consumer is done
+      const int ml_value_idx = static_cast<int>(action.value_index);
+      if (action.ref_count == 1 && traced_values.erase(ml_value_idx) > 0) {
+        ORT_RETURN_IF_ERROR(mem_planner.TraceFree(ml_value_idx));
+      }
+    }
+  }
+
+  return mem_planner.GeneratePatterns(patterns);
+}
+
+Status SessionState::PredictMemoryUsage(const InlinedHashMap<std::string, TensorShape>& input_shapes,
+                                        MemoryUsagePrediction& prediction) const {
+  prediction = MemoryUsagePrediction{};
+  auto usage_of = [&prediction](const OrtMemoryInfo& location) -> MemoryUsagePrediction::LocationUsage& {
+    for (auto& usage : prediction.locations) {
+      if (usage.location == location) {
+        return usage;
+      }
+    }
+    prediction.locations.push_back({location});
+    return prediction.locations.back();
+  };
+
+  for (const auto& entry : GetInitializedTensors()) {
+    if (entry.second.IsTensor()) {
+      const auto& tensor = entry.second.Get<Tensor>();
+      usage_of(tensor.Location()).initializer_bytes += tensor.SizeInBytes();
+    }
+  }
+
+  MemoryPatternGroup patterns;
+  ORT_RETURN_IF_ERROR(GenerateMemoryPatternsFromShapes(input_shapes, patterns, prediction.num_unresolved_tensors));
+  for (size_t i = 0; i < patterns.locations.size(); ++i) {
+    if (patterns.patterns[i].PeakSize() > 0) {
+      usage_of(patterns.locations[i]).peak_activation_bytes = patterns.patterns[i].PeakSize();
+    }
+  }
+
+  return Status::OK();
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status SessionState::SaveMemoryPatternsToOrtFormat(
+    flatbuffers::FlatBufferBuilder& builder,
+    flatbuffers::Offset<fbs::SessionMemoryPatterns>& fbs_memory_patterns) const {
+  fbs_memory_patterns = flatbuffers::Offset<fbs::SessionMemoryPatterns>{};
+
+  InlinedHashMap<std::string, TensorShape> input_shapes;
+  std::vector<int64_t> input_dims;
+  for (const auto* input : graph_viewer_->GetInputs()) {
+    if (!input->HasTensorOrScalarShape()) {
+      return Status::OK();
+    }
+    const auto shape = utils::GetTensorShapeFromTensorShapeProto(*input->Shape());
+    if (shape.Size() < 0) {
+      return Status::OK();
+    }
+    input_dims.push_back(static_cast<int64_t>(shape.NumDimensions()));
+    const auto dims = shape.GetDims();
+    input_dims.insert(input_dims.end(), dims.begin(), dims.end());
+    input_shapes.emplace(input->Name(), shape);
+  }
+
+  MemoryPatternGroup patterns;
+  size_t num_unresolved_tensors = 0;
+  ORT_RETURN_IF_ERROR(GenerateMemoryPatternsFromShapes(input_shapes, patterns, num_unresolved_tensors));
+
+  std::vector<flatbuffers::Offset<fbs::MemoryPattern>> fbs_patterns;
+  for (size_t i = 0; i < patterns.locations.size(); ++i) {
+    const auto& location = patterns.locations[i];
+    const auto& pattern = patterns.patterns[i];
+    if (pattern.PeakSize() == 0) {
+      continue;
+    }
+
+    // sorted by OrtValue index so that saving the same model twice gives the same file
+    std::vector<std::pair<int, MemoryBlock>> blocks(pattern.GetPatternsMap().begin(), pattern.GetPatternsMap().end());
+    std::sort(blocks.begin(), blocks.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    std::vector<flatbuffers::Offset<flatbuffers::String>> value_names;
+    std::vector<uint64_t> offsets;
+    std::vector<uint64_t> sizes;
+    value_names.reserve(blocks.size());
+    offsets.reserve(blocks.size());
+    sizes.reserve(blocks.size());
+    for (const auto& [ort_value_idx, block] : blocks) {
+      std::string name;
+      ORT_RETURN_IF_ERROR(ort_value_name_idx_map_.GetName(ort_value_idx, name));
+      value_names.push_back(builder.CreateSharedString(name));
+      offsets.push_back(block.offset_);
+      sizes.push_back(block.size_);
+    }
+
+    fbs_patterns.push_back(fbs::CreateMemoryPatternDirect(
+        builder, location.name, location.id, static_cast<int32_t>(location.mem_type),
+        static_cast<int32_t>(location.alloc_type), static_cast<int8_t>(location.device.Type()),
+        static_cast<int8_t>(location.device.MemType()), static_cast<int16_t>(location.device.Id()),
+        pattern.PeakSize(), &value_names, &offsets, &sizes));
+  }
+
+  if (!fbs_patterns.empty()) {
+    fbs_memory_patterns = fbs::CreateSessionMemoryPatternsDirect(builder, &input_dims, &fbs_patterns);
+  }
+  return Status::OK();
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+Status SessionState::LoadMemoryPatternsFromOrtFormat(const fbs::SessionMemoryPatterns& fbs_memory_patterns) const {
+  const auto* fbs_input_dims = fbs_memory_patterns.input_dims();
+  const auto* fbs_patterns = fbs_memory_patterns.patterns();
+  ORT_RETURN_IF(fbs_input_dims == nullptr || fbs_patterns == nullptr,
+                "Memory patterns without input dims or patterns. Invalid ORT format model.");
+
+  auto ignore = [this](const char* reason) {
+    LOGS(logger_, INFO) << "The memory patterns saved with the model are not used: " << reason;
+    return Status::OK();
+  };
+
+  // the patterns are for the static shapes of the graph inputs
+  auto entry = std::make_shared<MemoryPatternCacheEntry>();
+  entry->input_dims.assign(fbs_input_dims->begin(), fbs_input_dims->end());
+  size_t dims_offset = 0;
+  for (const auto* input : graph_viewer_->GetInputs()) {
+    if (!input->HasTensorOrScalarShape()) {
+      return ignore("an input has no shape.");
+    }
+    const auto shape = utils::GetTensorShapeFromTensorShapeProto(*input->Shape());
+    const auto dims = shape.GetDims();
+    if (dims_offset + 1 + dims.size() > entry->input_dims.size() ||
+        entry->input_dims[dims_offset] != static_cast<int64_t>(dims.size()) ||
+        !std::equal(dims.begin(), dims.end(), entry->input_dims.begin() + dims_offset + 1)) {
+      return ignore("the input shapes differ.");
+    }
+    dims_offset += 1 + dims.size();
+  }
+  if (dims_offset != entry->input_dims.size()) {
+    return ignore("the input shapes differ.");
+  }
+
+  const auto* exe_plan = GetExecutionPlan();
+  ORT_ENFORCE(exe_plan);
+  const auto& allocation_plan = exe_plan->allocation_plan;
+  const auto locations = exe_plan->GetAllLocations();
+  for (const auto* fbs_pattern : *fbs_patterns) {
+    ORT_RETURN_IF(fbs_pattern == nullptr, "Null memory pattern. Invalid ORT format model.");
+    const auto* fbs_location_name = fbs_pattern->location_name();
+    const auto* fbs_value_names = fbs_pattern->value_names();
+    const auto* fbs_offsets = fbs_pattern->offsets();
+    const auto* fbs_sizes = fbs_pattern->sizes();
+    ORT_RETURN_IF(fbs_location_name == nullptr || fbs_value_names == nullptr || fbs_offsets == nullptr ||
+                      fbs_sizes == nullptr || fbs_offsets->size() != fbs_value_names->size() ||
+                      fbs_sizes->size() != fbs_value_names->size(),
+                  "Incomplete memory pattern. Invalid ORT format model.");
+
+    // the name of an OrtMemoryInfo must outlive it, so use the location of the plan
+    const OrtMemoryInfo* location = nullptr;
+    for (const auto& plan_location : locations) {
+      if (fbs_location_name->string_view() == plan_location.name &&
+          fbs_pattern->location_id() == plan_location.id &&
+          fbs_pattern->location_mem_type() == static_cast<int32_t>(plan_location.mem_type) &&
+          fbs_pattern->location_alloc_type() == static_cast<int32_t>(plan_location.alloc_type) &&
+          fbs_pattern->device_type() == static_cast<int8_t>(plan_location.device.Type()) &&
+          fbs_pattern->device_mem_type() == static_cast<int8_t>(plan_location.device.MemType()) &&
+          fbs_pattern->device_id() == static_cast<int16_t>(plan_location.device.Id())) {
+        location = &plan_location;
+        break;
+      }
+    }
+    if (location == nullptr) {
+      return ignore("a location is not used by the execution plan.");
+    }
+
+    const size_t peak_size = onnxruntime::narrow<size_t>(fbs_pattern->peak_size());
+    InlinedHashMap<int, MemoryBlock> blocks;
+    blocks.reserve(fbs_value_names->size());
+    for (flatbuffers::uoffset_t i = 0, end = fbs_value_names->size(); i < end; ++i) {
+      int ort_value_idx = -1;
+      if (!ort_value_name_idx_map_.GetIdx(fbs_value_names->Get(i)->string_view(), ort_value_idx).IsOK()) {
+        return ignore("an activation is not in the graph.");
+      }
+      const auto& per_value_plan = allocation_plan[ort_value_idx];
+      if ((per_value_plan.alloc_kind != AllocKind::kAllocate &&
+           per_value_plan.alloc_kind != AllocKind::kAllocateOutput) ||
+          per_value_plan.location != *location) {
+        return ignore("the allocation plan differs.");
+      }
+      const auto offset = onnxruntime::narrow<size_t>(fbs_offsets->Get(i));
+      const auto size = onnxruntime::narrow<size_t>(fbs_sizes->Get(i));
+      ORT_RETURN_IF(offset > peak_size || size > peak_size - offset,
+                    "Memory block beyond the peak size of its pattern. Invalid ORT format model.");
+      blocks.emplace(ort_value_idx, MemoryBlock(offset, size));
+    }
+
+    entry->mem_patterns.locations.push_back(*location);
+    entry->mem_patterns.patterns.emplace_back(std::move(blocks), peak_size);
+  }
+
+  const size_t key = CalculateMemoryPatternsKey(entry->input_dims, mem_patterns_dim_bucket_size_);
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  auto it = mem_patterns_.find(key);
-  if (it == mem_patterns_.end()) {
-#ifdef ENABLE_TRAINING
-    MemoryPatternGroup mem_patterns;
-    InlinedHashMap<int, TensorShape> inferred_shapes;
-    if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, mem_patterns, inferred_shapes).IsOK()) {
-      auto patt_insert = mem_patterns_.insert_or_assign(key, std::move(mem_patterns));
-      auto ptr = &patt_insert.first->second;
-      auto shape_insert = shape_patterns_.insert_or_assign(key, std::move(inferred_shapes));
-      out_inferred_shapes = &shape_insert.first->second;
-      return ptr;
+  AddMemoryPatternCacheEntry(key, std::move(entry));
+  return Status::OK();
+}
+
+void SessionState::AddMemoryPatternCacheEntry(size_t key,
+                                              std::shared_ptr<const MemoryPatternCacheEntry> entry) const {
+  auto it = mem_patterns_index_.find(key);
+  if (it != mem_patterns_index_.end()) {
+    mem_patterns_.erase(it->second);
+  }
+  mem_patterns_.emplace_front(key, std::move(entry));
+  mem_patterns_index_[key] = mem_patterns_.begin();
+
+  if (mem_patterns_capacity_ > 0) {
+    while (mem_patterns_.size() > mem_patterns_capacity_) {
+      mem_patterns_index_.erase(mem_patterns_.back().first);
+      mem_patterns_.pop_back();
     }
-#else
-    ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
-#endif
-    return nullptr;
   }
+}
 
-  auto patt_hit = shape_patterns_.find(key);
-  if (patt_hit != shape_patterns_.cend()) {
-    out_inferred_shapes = &patt_hit->second;
+std::shared_ptr<const MemoryPatternCacheEntry> SessionState::GetMemoryPatternGroup(
+    gsl::span<const OrtValue> tensor_inputs,
+    gsl::span<const int> feed_mlvalue_idxs) const {
+  InlinedVector<int64_t> input_dims;
+  size_t key = CalculateMemoryPatternsKey(tensor_inputs, mem_patterns_dim_bucket_size_, input_dims);
+  std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
+  auto it = mem_patterns_index_.find(key);
+  // The patterns of a bucket were generated with the inputs of an earlier run. If the current inputs are larger,
+  // the patterns are re-generated and replace the cached ones.
+  if (it != mem_patterns_index_.end() && IsMemoryPatternUsable(*it->second->second, input_dims)) {
+    // mark as most recently used
+    mem_patterns_.splice(mem_patterns_.begin(), mem_patterns_, it->second);
+    return mem_patterns_.front().second;
+  }
+
+#ifdef ENABLE_TRAINING
+  auto entry = std::make_shared<MemoryPatternCacheEntry>();
+  if (GeneratePatternGroupCache(tensor_inputs, feed_mlvalue_idxs, entry->mem_patterns,
+                                entry->inferred_shapes)
+          .IsOK()) {
+    entry->input_dims = std::move(input_dims);
+    AddMemoryPatternCacheEntry(key, entry);
+    return entry;
   }
-  return &it->second;
+#else
+  ORT_UNUSED_PARAMETER(feed_mlvalue_idxs);
+#endif
+  return nullptr;
 }
 
 void SessionState::ResolveMemoryPatternFlag() {
@@ -823,11 +1311,13 @@ void SessionState::ResolveMemoryPatternFlag() {
 
 Status SessionState::UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                                    MemoryPatternGroup mem_patterns) const {
-  int64_t key = CalculateMemoryPatternsKey(tensor_inputs);
+  auto entry = std::make_shared<MemoryPatternCacheEntry>();
+  size_t key = CalculateMemoryPatternsKey(tensor_inputs, mem_patterns_dim_bucket_size_, entry->input_dims);
+  entry->mem_patterns = std::move(mem_patterns);
 
   std::lock_guard<OrtMutex> lock(mem_patterns_lock_);
-  // Do not update if present, as the pointer to the existing one is cached
-  mem_patterns_.emplace(key, std::move(mem_patterns));
+  // Replacing an existing entry is safe as the execution frames using it hold their own reference.
+  AddMemoryPatternCacheEntry(key, std::move(entry));
   return Status::OK();
 }
 
@@ -1349,9 +1839,34 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
   SubgraphsKernelCreateInfoMaps subgraphs_kernel_create_info_maps;
   AccumulateAllNestedSubgraphsInfo(*this, "", 0, subgraphs_kernel_create_info_maps);
 
+  // In parallel execution mode, independent branches of the main graph are spread over as many CPU logic streams
+  // as the inter-op thread pool can run concurrently. Subgraphs are always executed on the thread of their
+  // parent node, so they keep a single CPU stream. Training builds rely on a single stream per device.
+  // The GPU branches of the main graph are spread over the compute streams the GPU EPs allow in any execution mode,
+  // as the kernels launched on separate device streams overlap on the device even if a single thread launches them.
+  int max_cpu_streams = 1;
+  int max_gpu_streams = 1;
+#if defined(ENABLE_STREAM) && !defined(ENABLE_TRAINING)
+  if (session_options.execution_mode == ExecutionMode::ORT_PARALLEL && parent_node == nullptr) {
+    max_cpu_streams = concurrency::ThreadPool::DegreeOfParallelism(GetInterOpThreadPool());
+  }
+  if (parent_node == nullptr) {
+    // the GPU EPs share the streams created for the device, so take the smallest limit of them
+    std::optional<int> gpu_streams;
+    for (const auto& ep : execution_providers_) {
+      auto allocator = ep->GetAllocator(ep->GetDeviceId(), OrtMemTypeDefault);
+      if (allocator != nullptr && allocator->Info().device.Type() == OrtDevice::GPU) {
+        gpu_streams = std::min(gpu_streams.value_or(ep->GetMaxComputeStreams()), ep->GetMaxComputeStreams());
+      }
+    }
+    max_gpu_streams = std::max(gpu_streams.value_or(1), 1);
+  }
+#endif
   SequentialPlannerContext context(session_options.execution_mode,
                                    session_options.execution_order,
-                                   session_options.enable_mem_reuse);
+                                   session_options.enable_mem_reuse,
+                                   max_cpu_streams,
+                                   max_gpu_streams);
   auto status = SequentialPlanner::CreatePlan(parent_node, *graph_viewer_, valid_outer_scope_node_args,
                                                     execution_providers_, kernel_create_info_map_,
                                                     subgraphs_kernel_create_info_maps,
@@ -1365,6 +1880,18 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
                                                     Logger(),
                                                     p_seq_exec_plan_);
   ORT_RETURN_IF_ERROR(status);
+  execution_order_ = session_options.execution_order;
+
+  const auto mem_pattern_cache_size = session_options.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsMemoryPatternCacheSize, std::to_string(kDefaultMemoryPatternCacheSize));
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(mem_pattern_cache_size, mem_patterns_capacity_),
+                    "Invalid value for ", kOrtSessionOptionsMemoryPatternCacheSize, ": ", mem_pattern_cache_size);
+  const auto mem_pattern_dim_bucket_size = session_options.config_options.GetConfigOrDefault(
+      kOrtSessionOptionsMemoryPatternDimBucketSize, "0");
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(mem_pattern_dim_bucket_size, mem_patterns_dim_bucket_size_) &&
+                        mem_patterns_dim_bucket_size_ >= 0,
+                    "Invalid value for ", kOrtSessionOptionsMemoryPatternDimBucketSize, ": ",
+                    mem_pattern_dim_bucket_size);
 
 // Record the allocation plan
 
@@ -1440,6 +1967,7 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
     CleanInitializedTensorsFromGraph();
   }
 
+  config_options_ = session_options.config_options;
   ORT_RETURN_IF_ERROR(CreateKernels(kernel_registry_manager));
 
 #ifndef ENABLE_TRAINING
@@ -1447,6 +1975,13 @@ Status SessionState::FinalizeSessionStateImpl(const std::basic_string<PATH_CHAR_
       session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDisablePrepacking, "0");
 
   if (disable_prepacking != "1") {
+    const auto prepacked_weights_cache_dir =
+        session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigPrepackedWeightsCacheDir, "");
+    if (!prepacked_weights_cache_dir.empty()) {
+      prepacked_weights_disk_cache_ =
+          std::make_unique<PrepackedWeightsDiskCache>(ToPathString(prepacked_weights_cache_dir));
+    }
+
     ORT_RETURN_IF_ERROR(PrepackConstantInitializedTensors(constant_initializers_use_count,
                                                           session_options.initializers_to_share_map));
   }
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <list>
 #include <memory>
 #include <map>
 #include <unordered_map>
@@ -16,12 +17,14 @@
 #include "core/common/profiler.h"
 #include "core/framework/allocation_planner.h"
 #include "core/framework/callback.h"
+#include "core/framework/config_options.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/stream_execution_context.h"
 #include "core/framework/feeds_fetches_manager.h"
 #include "core/framework/framework_common.h"
 #include "core/framework/prepacked_weights_container.h"
+#include "core/framework/prepacked_weights_disk_cache.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/mem_pattern.h"
@@ -52,6 +55,7 @@ struct Offset;
 namespace onnxruntime {
 
 namespace fbs {
+struct SessionMemoryPatterns;
 struct SessionState;
 }  // namespace fbs
 
@@ -66,6 +70,25 @@ class DeviceStreamCollection;
 class MemoryInfo;
 #endif
 
+/**
+ * The memory that a run of a graph is predicted to need, by location, see SessionState::PredictMemoryUsage.
+ */
+struct MemoryUsagePrediction {
+  struct LocationUsage {
+    OrtMemoryInfo location;
+    // Bytes of the initializers, which were allocated when the session was initialized.
+    size_t initializer_bytes = 0;
+    // Highest number of bytes of the tensors allocated by a run, including the graph outputs, once laid out by the
+    // memory pattern planner.
+    size_t peak_activation_bytes = 0;
+  };
+
+  std::vector<LocationUsage> locations;
+  // Number of tensors whose shapes can't be inferred from the input shapes. They are allocated at run time on top of
+  // the prediction, as are the tensors of the subgraphs of control flow nodes.
+  size_t num_unresolved_tensors = 0;
+};
+
 /**
  * SessionState should be modified by the inference session class only.
  * It is supposed to be passed by const-ref only to all the executors.
@@ -89,6 +112,13 @@ class MemoryInfo;
 using SubgraphSessionStateMap =
     std::unordered_map<onnxruntime::NodeIndex, std::unordered_map<std::string, std::unique_ptr<SessionState>>>;
 
+// Thread pools to run the kernels of the session states on in place of their own thread pools, used by the
+// sessions that share the session state of another session (see InferenceSession::Clone) but not its thread pools.
+struct ThreadPoolOverride {
+  concurrency::ThreadPool* thread_pool;
+  concurrency::ThreadPool* inter_op_thread_pool;
+};
+
 class SessionState {
  public:
   SessionState(Graph& graph,
@@ -211,25 +241,54 @@ class SessionState {
   /**
   Get cached memory pattern based on input shapes
   Must be called only when all values contain tensors
-  In training scenarios, the cache may be updated so
-  the callers would receive a copy of inferred shapes
-  made under mutex being held. In inference scenarios,
-  it is not mutable, we do not obtain a lock and simply get a pointer
-  w/o copying a hashtable
+  In training scenarios, a missing pattern is generated and
+  added to the cache, together with the inferred shapes.
+  The returned entry stays valid for as long as the caller holds it,
+  even if it's evicted from the cache in the meantime.
+  Returns nullptr if there's no pattern usable for the input shapes.
   */
-  const MemoryPatternGroup* GetMemoryPatternGroup(
+  std::shared_ptr<const MemoryPatternCacheEntry> GetMemoryPatternGroup(
       gsl::span<const OrtValue> tensor_inputs,
-      gsl::span<const int> feed_mlvalue_idxs,
-      const InlinedHashMap<int, TensorShape>*& inferred_shapes) const;
+      gsl::span<const int> feed_mlvalue_idxs) const;
 
   /**
   Set generated memory pattern with a given input shapes.
+  Replaces the cached pattern for the same key, and evicts the least
+  recently used pattern once the cache holds more than
+  session.memory_pattern_cache_size patterns.
   Const as it's an internal cache update only.
   All inputs must represent Tensors
   */
   Status UpdateMemoryPatternGroupCache(gsl::span<const OrtValue> tensor_inputs,
                                        MemoryPatternGroup mem_patterns) const;
 
+  /**
+  Predict the memory a run needs for the given input shapes without running any kernel.
+  The shapes of the activations are taken from the graph, with the symbolic dimensions resolved from the input
+  shapes, and their lifetimes from the execution plan.
+  @param input_shapes the shape of each graph input, by name.
+  @param prediction the predicted memory usage by location.
+  @return an error if an input is missing or its rank doesn't match the graph.
+  */
+  Status PredictMemoryUsage(const InlinedHashMap<std::string, TensorShape>& input_shapes,
+                            MemoryUsagePrediction& prediction) const;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  /**
+  Save the memory patterns of the graph for the static shapes of its inputs, laid out as PredictMemoryUsage does.
+  fbs_memory_patterns is left null if an input has no static shape.
+  */
+  Status SaveMemoryPatternsToOrtFormat(flatbuffers::FlatBufferBuilder& builder,
+                                       flatbuffers::Offset<fbs::SessionMemoryPatterns>& fbs_memory_patterns) const;
+#endif
+
+  /**
+  Add the memory patterns saved with an ORT format model to the memory pattern cache.
+  The patterns are ignored if they don't match the execution plan, e.g. if the locations of the activations
+  differ as the model was saved with other execution providers.
+  */
+  Status LoadMemoryPatternsFromOrtFormat(const fbs::SessionMemoryPatterns& fbs_memory_patterns) const;
+
   bool GetUseDeterministicCompute() const { return use_deterministic_compute_; }
 
   /**
@@ -283,14 +342,39 @@ class SessionState {
   /// Return SessionState for the given Node index and attribute name if found.
   const SessionState* GetSubgraphSessionState(NodeIndex index, const std::string& attribute_name) const;
 
-  concurrency::ThreadPool* GetThreadPool() const noexcept { return thread_pool_; }
-  concurrency::ThreadPool* GetInterOpThreadPool() const noexcept { return inter_op_thread_pool_; }
+  // The thread pools of the session, or the ones of the ThreadPoolOverride of the current thread if there is one.
+  concurrency::ThreadPool* GetThreadPool() const noexcept {
+    return thread_pool_override_ != nullptr ? thread_pool_override_->thread_pool : thread_pool_;
+  }
+  concurrency::ThreadPool* GetInterOpThreadPool() const noexcept {
+    return thread_pool_override_ != nullptr ? thread_pool_override_->inter_op_thread_pool : inter_op_thread_pool_;
+  }
+
+  // Sets the ThreadPoolOverride of the current thread, nullptr for none, for the lifetime of the scope.
+  class ThreadPoolOverrideScope {
+   public:
+    explicit ThreadPoolOverrideScope(const ThreadPoolOverride* thread_pool_override) noexcept
+        : previous_(thread_pool_override_) {
+      thread_pool_override_ = thread_pool_override;
+    }
+    ~ThreadPoolOverrideScope() { thread_pool_override_ = previous_; }
+    ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(ThreadPoolOverrideScope);
+
+   private:
+    const ThreadPoolOverride* const previous_;
+  };
+
+  // The ThreadPoolOverride of the current thread, to set it for the tasks of a run scheduled on other threads.
+  static const ThreadPoolOverride* GetThreadPoolOverride() noexcept { return thread_pool_override_; }
 
   const FuncManager& GetFuncMgr() const noexcept { return fused_funcs_mgr_; }
   FuncManager& GetMutableFuncMgr() noexcept { return fused_funcs_mgr_; }
 
   const DataTransferManager& GetDataTransferMgr() const noexcept { return data_transfer_mgr_; }
 
+  // The session config options the kernels are created with. Set by FinalizeSessionState.
+  const ConfigOptions& GetConfigOptions() const noexcept { return config_options_; }
+
   InlinedVector<BufferUniquePtr>& GetMutableWeightsBuffers() noexcept { return weights_buffers_; }
 
   const NodeIndexInfo& GetNodeIndexInfo() const;
@@ -317,6 +401,10 @@ class SessionState {
     return used_shared_pre_packed_weights_counter_;
   }
 
+  size_t GetUsedDiskCachedPrePackedWeightCounter() const {
+    return used_disk_cached_pre_packed_weights_counter_;
+  }
+
   const KernelCreateInfoMap& GetKernelCreateInfoMap() const {
     return kernel_create_info_map_;
   }
@@ -368,6 +456,17 @@ class SessionState {
   Status PrepackConstantInitializedTensors(InlinedHashMap<std::string, size_t>& constant_initializers_use_count,
                                            const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map);
 
+  // Runs PrePack in parallel on the intra-op thread pool for the CPU kernels whose packed weights are neither
+  // shared nor cached, as those calls only touch their own kernel. The results are keyed by
+  // GetPrePackResultKey(node index, input index) for PrepackConstantInitializedTensors to consume.
+  Status ParallelPrePackConstantInitializedTensors(
+      const std::unordered_map<std::string, const OrtValue*>& initializers_to_share_map,
+      /*out*/ InlinedHashMap<uint64_t, bool>& prepack_results);
+
+  // Pre-packs a constant initializer for a kernel using the on-disk pre-packed weights cache.
+  Status PrepackWithDiskCache(const Node& node, OpKernel& kernel, int input_idx, const Tensor& tensor,
+                              /*out*/ bool& is_packed);
+
   SessionState* GetMutableSubgraphSessionState(onnxruntime::NodeIndex index, const std::string& attribute_name);
 
   Status CreateSubgraphSessionState();
@@ -387,6 +486,11 @@ class SessionState {
                                   const InlinedHashMap<OrtValueName, OrtMemoryInfo>& outer_scope_node_arg_to_location_map = {},
                                   bool graph_info_already_created = false);
 
+  // Lay out the activations of a run with the given input shapes, from the shapes of the graph and the lifetimes of
+  // the execution plan. num_unresolved_tensors is set to the number of tensors whose size is unknown.
+  Status GenerateMemoryPatternsFromShapes(const InlinedHashMap<std::string, TensorShape>& input_shapes,
+                                          MemoryPatternGroup& patterns, size_t& num_unresolved_tensors) const;
+
 #ifdef ENABLE_TRAINING
   Status GeneratePatternGroupCache(
       gsl::span<const OrtValue> inputs,
@@ -401,6 +505,10 @@ class SessionState {
   // fused_funcs_mgr_ must live longer than the session_kernels_, becaues a kernel could be created from this manager
   FuncManager fused_funcs_mgr_;
 
+  // On-disk pre-packed weights cache, if enabled. Kernels may refer to buffers mapped by it so it must live longer
+  // than the session_kernels_.
+  std::unique_ptr<PrepackedWeightsDiskCache> prepacked_weights_disk_cache_;
+
   // cache of the constructed kernels to avoid spending construction time per executor
   std::vector<std::unique_ptr<OpKernel>> session_kernels_;
   Graph& graph_;
@@ -482,18 +590,23 @@ class SessionState {
   // switch for enable memory pattern optimization or not.
   bool enable_mem_pattern_;
 
+  // Insert or replace the cached mem_patterns for key and evict the least recently used ones beyond the capacity.
+  // mem_patterns_lock_ must be held by the caller.
+  void AddMemoryPatternCacheEntry(size_t key, std::shared_ptr<const MemoryPatternCacheEntry> entry) const;
+
+  static constexpr size_t kDefaultMemoryPatternCacheSize = 32;
+
   // lock for the mem_patterns_
   mutable OrtMutex mem_patterns_lock_;
-  // cache for the generated mem_patterns. key is calculated based on input shapes.
-  // must be a node based container as a pointer is cached.
-  mutable NodeHashMap<int64_t, MemoryPatternGroup> mem_patterns_;
-  // This is mutable under mutex in training scenarios so execution frame would make a copy
-  // of the value when created.
-#ifdef ENABLE_TRAINING
-  mutable NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#else
-  NodeHashMap<int64_t, InlinedHashMap<int, TensorShape>> shape_patterns_;
-#endif
+  // LRU cache for the generated mem_patterns, most recently used first.
+  // key is calculated based on input shapes, see CalculateMemoryPatternsKey.
+  using MemoryPatternCacheList = std::list<std::pair<size_t, std::shared_ptr<const MemoryPatternCacheEntry>>>;
+  mutable MemoryPatternCacheList mem_patterns_;
+  mutable InlinedHashMap<size_t, MemoryPatternCacheList::iterator> mem_patterns_index_;
+  // max number of cached mem_patterns. 0 means unlimited.
+  size_t mem_patterns_capacity_{kDefaultMemoryPatternCacheSize};
+  // if larger than 1, input dims are rounded up to a multiple of it when calculating the cache key.
+  int64_t mem_patterns_dim_bucket_size_{0};
 
   NameNodeInfoMapType input_names_to_nodeinfo_mapping_;
   NameNodeInfoMapType output_names_to_nodeinfo_mapping_;
@@ -504,10 +617,17 @@ class SessionState {
   concurrency::ThreadPool* const thread_pool_{};
   concurrency::ThreadPool* const inter_op_thread_pool_{};
 
+  static thread_local const ThreadPoolOverride* thread_pool_override_;
+
   const DataTransferManager& data_transfer_mgr_;
 
+  // Copy of the session config options, the kernels refer to it for their lifetime
+  ConfigOptions config_options_;
+
   bool use_deterministic_compute_;
   bool enable_mem_reuse_;
+  // the order the nodes of the execution plan run in
+  ExecutionOrder execution_order_{ExecutionOrder::DEFAULT};
   std::optional<NodeIndexInfo> node_index_info_;
 
   // Container to store pre-packed weights to share between sessions.
@@ -545,6 +665,9 @@ class SessionState {
   // a constant initialized weight was used by the session state
   size_t used_shared_pre_packed_weights_counter_ = 0;
 
+  // Counter for number of times a pre-packed weight loaded from the on-disk cache was used by the session state
+  size_t used_disk_cached_pre_packed_weights_counter_ = 0;
+
 #ifdef DEBUG_NODE_INPUTS_OUTPUTS
   // Counter for number of times the session graph has been executed
   size_t graph_executions_counter_ = 0;
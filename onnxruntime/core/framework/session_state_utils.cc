@@ -107,6 +107,24 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
   TensorShape tensor_shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
   const DataTypeImpl* const type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type())->GetElementType();
   std::unique_ptr<Tensor> p_tensor;
+  const bool has_external_data = utils::HasExternalData(tensor_proto);
+  const OrtMemoryInfo& location = m != nullptr ? m->GetAllocInfo() : alloc->Info();
+  if (has_external_data && location.device.Type() == OrtDevice::CPU) {
+    // NB: The file containing external data for the tensor is mmap'd. If the tensor will be used on CPU we can
+    // utilize the mmap'd buffer directly by calling ExtDataTensorProtoToTensor. If we called
+    // TensorProtoToTensor it would copy the data, causing unnecessary overhead.
+    // The tensor doesn't own a buffer, so pages of the file are only read in when a kernel touches them.
+    p_tensor = std::make_unique<Tensor>();
+    OrtCallback ext_data_deleter;
+    ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor, ext_data_deleter));
+
+    ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
+
+    MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
+    ort_value.Init(p_tensor.release(), ml_tensor_type, deleter);
+    return common::Status::OK();
+  }
+
   if (m != nullptr) {
     p_tensor = std::make_unique<Tensor>(type, tensor_shape, m->GetBuffer(), m->GetAllocInfo());
     if (m->GetLen() < p_tensor->SizeInBytes()) {
@@ -128,19 +146,6 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
 
   if (p_tensor->Location().device.Type() == OrtDevice::CPU) {
     // deserialize directly to CPU tensor
-    if (utils::HasExternalData(tensor_proto)) {
-      // NB: The file containing external data for the tensor is mmap'd. If the tensor will be used on CPU we can
-      // utilize the mmap'd buffer directly by calling ExtDataTensorProtoToTensor. If we called
-      // TensorProtoToTensor it would copy the data, causing unnecessary overhead
-      OrtCallback ext_data_deleter;
-      ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_tensor, ext_data_deleter));
-
-      ExtDataValueDeleter deleter{ext_data_deleter, p_tensor.get()};
-
-      MLDataType ml_tensor_type = DataTypeImpl::GetType<Tensor>();
-      ort_value.Init(p_tensor.release(), ml_tensor_type, deleter);
-      return common::Status::OK();
-    }
     ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_tensor));
   } else {  // non-cpu tensor
     if (tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
@@ -149,7 +154,10 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
 
     // deserialize to CPU first for non-CPU allocator, then copy
     std::unique_ptr<Tensor> p_deserialize_tensor;
-    if (use_device_allocator_for_initializers) {
+    if (has_external_data) {
+      // the mmap'd data is used as the copy source, no staging buffer is needed
+      p_deserialize_tensor = std::make_unique<Tensor>();
+    } else if (use_device_allocator_for_initializers) {
       void* tensor_buffer = nullptr;
       ORT_RETURN_IF_ERROR(AllocateBufferUsingDeviceAllocatorFromShapeAndType(tensor_shape, type, default_cpu_alloc, tensor_buffer));
       p_deserialize_tensor = std::make_unique<Tensor>(type, tensor_shape, tensor_buffer, default_cpu_alloc);
@@ -160,13 +168,15 @@ static common::Status DeserializeTensorProto(const Env& env, const std::basic_st
       p_deserialize_tensor = std::make_unique<Tensor>(type, tensor_shape, default_cpu_alloc);
     }
 
-    OrtCallback ext_data_deleter;
-    if (utils::HasExternalData(tensor_proto)) {
+    OrtCallback ext_data_deleter{nullptr, nullptr};
+    if (has_external_data) {
       ORT_RETURN_IF_ERROR(ExtDataTensorProtoToTensor(env, proto_path, tensor_proto, *p_deserialize_tensor,
                                                      ext_data_deleter));
     } else {
       ORT_RETURN_IF_ERROR(utils::TensorProtoToTensor(env, proto_path.c_str(), tensor_proto, *p_deserialize_tensor));
     }
+    // unmap the external data once it has been copied to the device
+    ScopedOrtCallbackInvoker release_ext_data(ext_data_deleter);
     // TODO!! Need a temp buffer allocator for non-escape buffers that maybe too big for stack allocation.
 
     Status copy_status = data_transfer_mgr.CopyTensor(*p_deserialize_tensor, *p_tensor);
@@ -270,6 +280,10 @@ common::Status SaveInitializedTensors(
       // do not trace string tensor
       continue;
     }
+    // see NB2, the mmap'd data is used in place so no buffer is planned for it
+    if (utils::HasExternalData(*entry.second) && exec_plan.GetLocation(entry.first).device.Type() == OrtDevice::CPU) {
+      continue;
+    }
     ORT_RETURN_IF_ERROR(planner.Trace(entry.first, entry.second));
   }
   // 2. allocate weight buffer on different locations
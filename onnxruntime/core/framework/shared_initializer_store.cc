@@ -0,0 +1,78 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/shared_initializer_store.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "core/common/hash_combine.h"
+#include "core/common/safeint.h"
+#include "core/framework/allocatormgr.h"
+#include "core/framework/murmurhash3.h"
+#include "core/framework/tensorprotoutils.h"
+
+namespace onnxruntime {
+
+Status SharedInitializerStore::GetOrAdd(const Path& model_path, const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                                        const OrtValue*& value) {
+  value = nullptr;
+  ORT_RETURN_IF(tensor_proto.data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING,
+                "String initializers can't be shared: ", tensor_proto.name());
+
+  const auto* tensor_type = DataTypeImpl::TensorTypeFromONNXEnum(tensor_proto.data_type());
+  ORT_RETURN_IF(tensor_type == nullptr, "Unsupported data type of initializer: ", tensor_proto.name());
+  const MLDataType element_type = tensor_type->GetElementType();
+  const TensorShape shape = utils::GetTensorShapeFromTensorProto(tensor_proto);
+
+  std::vector<uint8_t> data;
+  ORT_RETURN_IF_ERROR(utils::UnpackInitializerData(tensor_proto, model_path, data));
+  ORT_RETURN_IF_NOT(data.size() == SafeInt<size_t>(shape.Size()) * element_type->Size(),
+                    "Unexpected data size of initializer: ", tensor_proto.name());
+
+  // murmurhash takes an int length, the full comparison on lookup takes care of what lies past it
+  uint32_t content_hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(data.data(),
+                       static_cast<int>(std::min<size_t>(data.size(), std::numeric_limits<int>::max())),
+                       0, content_hash);
+  size_t key = content_hash[0];
+  HashCombine(content_hash[1], key);
+  HashCombine(data.size(), key);
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+
+  auto range = values_.equal_range(key);
+  for (auto it = range.first; it != range.second; ++it) {
+    const Tensor& tensor = it->second->Get<Tensor>();
+    if (tensor.DataType() == element_type && tensor.Shape() == shape &&
+        (data.empty() || std::memcmp(tensor.DataRaw(), data.data(), data.size()) == 0)) {
+      value = it->second.get();
+      return Status::OK();
+    }
+  }
+
+  if (!allocator_) {
+    // the tensors are never freed before the store, a plain allocator avoids holding arena chunks
+    AllocatorCreationInfo device_info{[](int) { return std::make_unique<CPUAllocator>(); }, 0, false};
+    allocator_ = CreateAllocator(device_info);
+  }
+
+  auto ort_value = std::make_unique<OrtValue>();
+  Tensor::InitOrtValue(element_type, shape, allocator_, *ort_value);
+  if (!data.empty()) {
+    std::memcpy(ort_value->GetMutable<Tensor>()->MutableDataRaw(), data.data(), data.size());
+  }
+
+  value = ort_value.get();
+  values_.emplace(key, std::move(ort_value));
+  return Status::OK();
+}
+
+size_t SharedInitializerStore::GetNumberOfInitializers() const {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  return values_.size();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,56 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+
+#include "core/common/common.h"
+#include "core/common/path.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/prepacked_weights_container.h"
+#include "core/platform/ort_mutex.h"
+
+namespace ONNX_NAMESPACE {
+class TensorProto;
+}
+
+namespace onnxruntime {
+
+// Process wide store of initializers, owned by the Environment, that lets sessions of models sharing weights (e.g.
+// fine-tuned variants of one base model) hold a single copy of each identical initializer.
+// Initializers are identified by their data type, shape and content, not by their name.
+// The stored tensors, and the pre-packed weights in the store's PrepackedWeightsContainer, live as long as the store.
+class SharedInitializerStore final {
+ public:
+  SharedInitializerStore() = default;
+
+  // Returns a CPU tensor with the data type, shape and content of `tensor_proto`. All identical initializers get the
+  // same instance; the data is copied into the store the first time it is seen.
+  // String initializers are not supported.
+  Status GetOrAdd(const Path& model_path, const ONNX_NAMESPACE::TensorProto& tensor_proto,
+                  /*out*/ const OrtValue*& value);
+
+  // Container for the pre-packed versions of the stored initializers, shared by the sessions using the store.
+  PrepackedWeightsContainer& GetPrepackedWeightsContainer() { return prepacked_weights_container_; }
+
+  // Returns the number of distinct initializers in the store
+  size_t GetNumberOfInitializers() const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(SharedInitializerStore);
+
+ private:
+  mutable OrtMutex mutex_;
+
+  // declared ahead of the tensors so that it outlives them
+  AllocatorPtr allocator_;
+
+  // keyed by a hash of the content, the entries are compared in full on lookup
+  std::unordered_multimap<size_t, std::unique_ptr<OrtValue>> values_;
+
+  PrepackedWeightsContainer prepacked_weights_container_;
+};
+
+}  // namespace onnxruntime
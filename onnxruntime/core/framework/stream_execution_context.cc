@@ -29,6 +29,7 @@ StreamExecutionContext ::StreamExecutionContext(const SessionState& sess_state,
                                                                                   device_stream_map.GetStreams()),
                                                                            logger_(&sess_logger),
                                                                            single_thread_mode_(single_thread_mode),
+                                                                           thread_pool_override_(SessionState::GetThreadPoolOverride()),
                                                                            device_stream_map_(device_stream_map),
                                                                            count_down_barriers_(num_barriers) {
   notifications_.reserve(notification_owners.size());
@@ -90,7 +91,8 @@ StreamExecutionContext ::StreamExecutionContext(const SessionState& sess_state,
                                                                                   sess_state,
                                                                                   {}),
                                                                            logger_(&sess_logger),
-                                                                           single_thread_mode_(single_thread_mode) {
+                                                                           single_thread_mode_(single_thread_mode),
+                                                                           thread_pool_override_(SessionState::GetThreadPoolOverride()) {
 #ifdef _WIN32
 #pragma warning(push)
 #pragma warning(disable : 26409 26400)
@@ -167,6 +169,8 @@ void StreamExecutionContext ::RecycleNodeInputs(onnxruntime::NodeIndex node_inde
 }
 
 void RunSince(size_t stream_idx, StreamExecutionContext& ctx, SessionScope& session_scope, const bool& terminate_flag, size_t since) {
+  SessionState::ThreadPoolOverrideScope thread_pool_override_scope(ctx.GetThreadPoolOverride());
+
   if (!ctx.TaskStatus().IsOK()) {
     // already in bad status, terminate it
     ctx.CompleteTask();
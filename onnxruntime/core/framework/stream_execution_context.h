@@ -16,6 +16,7 @@
 
 namespace onnxruntime {
 class SessionState;
+struct ThreadPoolOverride;
 
 class SessionScope;
 typedef InlinedHashMap<std::string, OrtValue> OrtValueCache;
@@ -94,6 +95,9 @@ class StreamExecutionContext {
   // 2. multi-threads mode: use inter-op thread pool to schedule the N streams.
   bool SingleThreadMode() const { return single_thread_mode_; }
 
+  // The thread pool override of the thread that created the context, which the streams run with on any thread.
+  const ThreadPoolOverride* GetThreadPoolOverride() const { return thread_pool_override_; }
+
   // Get the Stream instance for a given logic sequence.
   // return nullptr if the device of given logic sequence doesn't register stream support.
   Stream* GetDeviceStream(size_t idx);
@@ -169,6 +173,8 @@ class StreamExecutionContext {
 #endif
   const bool single_thread_mode_;
 
+  const ThreadPoolOverride* const thread_pool_override_;
+
 #ifdef ENABLE_STREAM
   InlinedVector<std::unique_ptr<synchronize::Notification>> notifications_;
   const DeviceStreamCollection& device_stream_map_;
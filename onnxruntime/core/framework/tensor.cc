@@ -84,25 +84,22 @@ Tensor::Tensor(MLDataType p_type, const TensorShape& shape, void* p_data, std::s
 
 void Tensor::InitOrtValue(MLDataType elt_type, const TensorShape& shape, std::shared_ptr<IAllocator> allocator,
                           OrtValue& ort_value, gsl::span<const int64_t> strides) {
-  auto p_tensor = std::make_unique<Tensor>(elt_type, shape, std::move(allocator), strides);
-  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
-  ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  auto p_tensor = std::make_shared<Tensor>(elt_type, shape, std::move(allocator), strides);
+  ort_value.Init(std::move(p_tensor), DataTypeImpl::GetType<Tensor>());
 }
 
 void Tensor::InitOrtValue(MLDataType p_type, const TensorShape& shape, void* p_data, const OrtMemoryInfo& location,
                           OrtValue& ort_value, ptrdiff_t offset, gsl::span<const int64_t> strides) {
-  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
-  auto p_tensor = std::make_unique<Tensor>(p_type, shape, p_data, location, offset, strides);
-  ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  auto p_tensor = std::make_shared<Tensor>(p_type, shape, p_data, location, offset, strides);
+  ort_value.Init(std::move(p_tensor), DataTypeImpl::GetType<Tensor>());
 }
 
 void Tensor::InitOrtValue(MLDataType p_type, const TensorShape& shape,
                           void* p_data, std::shared_ptr<IAllocator> allocator,
                           OrtValue& ort_value, ptrdiff_t offset,
                           gsl::span<const int64_t> strides) {
-  auto ml_tensor = DataTypeImpl::GetType<Tensor>();
-  auto p_tensor = std::make_unique<Tensor>(p_type, shape, p_data, std::move(allocator), offset, strides);
-  ort_value.Init(p_tensor.release(), ml_tensor, ml_tensor->GetDeleteFunc());
+  auto p_tensor = std::make_shared<Tensor>(p_type, shape, p_data, std::move(allocator), offset, strides);
+  ort_value.Init(std::move(p_tensor), DataTypeImpl::GetType<Tensor>());
 }
 
 size_t Tensor::SizeInBytes() const {
@@ -174,6 +174,13 @@ static Status ReadExternalDataForTensor(const ONNX_NAMESPACE::TensorProto& tenso
       file_offset,
       tensor_byte_size));
 
+  if (external_file_path == onnxruntime::utils::kTensorProtoMemoryAddressTag) {
+    // the value in offset is the memory address of the data
+    const auto* data = reinterpret_cast<const uint8_t*>(file_offset);
+    unpacked_tensor.assign(data, data + static_cast<size_t>(tensor_byte_size));
+    return Status::OK();
+  }
+
   unpacked_tensor.resize(tensor_byte_size);
   ORT_RETURN_IF_ERROR(onnxruntime::Env::Default().ReadFileIntoBuffer(
       external_file_path.c_str(),
@@ -8,9 +8,12 @@
 #endif
 
 #include <chrono>
+#include <fstream>
 #include <functional>
 #include <limits>
+#include <map>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <type_traits>
@@ -23,10 +26,115 @@
 #ifndef SHARED_PROVIDER
 #include "core/common/logging/logging.h"
 #endif
+#include "core/platform/ort_mutex.h"
 
 namespace onnxruntime {
 namespace tunable {
 
+// The results of the tuning, i.e., the id of the fastest op of a TunableOp by op signature and params signature.
+// The results can be shared by the TunableOps of all threads, and saved to a file so that another process does not
+// need to tune again. The validators of a file describe the environment of the tuning, e.g., the device and library
+// versions, the results are only loaded into an environment with the same validators.
+class TuningResults {
+ public:
+  using Validators = std::map<std::string, std::string>;
+
+  // Returns the id of the fastest op, or -1 if the op has not been tuned for the params.
+  int Lookup(const std::string& op_sig, const std::string& params_sig) const {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto op_it = results_.find(op_sig);
+    if (op_it == results_.end()) {
+      return -1;
+    }
+    auto it = op_it->second.find(params_sig);
+    return it == op_it->second.end() ? -1 : it->second;
+  }
+
+  void Add(const std::string& op_sig, const std::string& params_sig, int id) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    results_[op_sig][params_sig] = id;
+    modified_ = true;
+  }
+
+  // Returns true if results were added since the last Save() or Load().
+  bool IsModified() const {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    return modified_;
+  }
+
+  // The file has one tab separated entry per line, "V <key> <value>" for the validators followed by
+  // "R <op signature> <params signature> <id>" for the results.
+  Status Save(const std::string& path, const Validators& validators) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    std::ofstream file(path, std::ios::trunc);
+    ORT_RETURN_IF_NOT(file.good(), "Failed to open tuning results file ", path, " for writing.");
+    for (const auto& [key, value] : validators) {
+      file << "V\t" << key << '\t' << value << '\n';
+    }
+    for (const auto& [op_sig, op_results] : results_) {
+      for (const auto& [params_sig, id] : op_results) {
+        file << "R\t" << op_sig << '\t' << params_sig << '\t' << id << '\n';
+      }
+    }
+    file.close();
+    ORT_RETURN_IF_NOT(file.good(), "Failed to write tuning results file ", path, ".");
+    modified_ = false;
+    return Status::OK();
+  }
+
+  Status Load(const std::string& path, const Validators& validators) {
+    std::ifstream file(path);
+    ORT_RETURN_IF_NOT(file.good(), "Failed to open tuning results file ", path, ".");
+
+    Validators file_validators;
+    std::unordered_map<std::string, std::unordered_map<std::string, int>> file_results;
+    std::string line;
+    while (std::getline(file, line)) {
+      if (line.empty()) {
+        continue;
+      }
+      std::vector<std::string> fields;
+      std::istringstream line_stream(line);
+      for (std::string field; std::getline(line_stream, field, '\t');) {
+        fields.push_back(std::move(field));
+      }
+      if (fields.size() == 3 && fields[0] == "V") {
+        file_validators[fields[1]] = fields[2];
+      } else if (fields.size() == 4 && fields[0] == "R") {
+        int id = -1;
+        ORT_RETURN_IF_NOT(ParseId(fields[3], id), "Invalid id in tuning results file ", path, ": ", line);
+        file_results[fields[1]][fields[2]] = id;
+      } else {
+        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid entry in tuning results file ", path, ": ", line);
+      }
+    }
+
+    for (const auto& [key, value] : validators) {
+      auto it = file_validators.find(key);
+      ORT_RETURN_IF_NOT(it != file_validators.end() && it->second == value,
+                        "Tuning results file ", path, " does not match ", key, " ", value, ", it was tuned for ",
+                        it == file_validators.end() ? std::string("unknown") : it->second, ".");
+    }
+
+    std::lock_guard<OrtMutex> lock(mutex_);
+    for (auto& [op_sig, op_results] : file_results) {
+      results_[op_sig].merge(op_results);
+    }
+    modified_ = false;
+    return Status::OK();
+  }
+
+ private:
+  static bool ParseId(const std::string& str, int& id) {
+    std::istringstream stream(str);
+    return (stream >> id) && stream.eof() && id >= 0;
+  }
+
+  mutable OrtMutex mutex_;
+  std::unordered_map<std::string, std::unordered_map<std::string, int>> results_;
+  bool modified_{false};
+};
+
 template <typename StreamT>
 struct OpParams {
   OpParams() : stream{} {}
@@ -34,6 +142,8 @@ struct OpParams {
   virtual ~OpParams() = default;
   virtual std::string Signature() const = 0;
   virtual StreamT Stream() const { return stream; }
+  // The results shared with the other TunableOps, nullptr if the results are only kept by the TunableOp itself.
+  virtual TuningResults* GetTuningResults() const { return nullptr; }
   StreamT stream;
 };
 
@@ -124,18 +234,32 @@ class TunableOp {
   TunableOp(TunableOp&&) = default;
 
   Status operator()(const ParamsT* params) {
-    int id;
-    if (tuning_) {
-      if (kernel_map_.find(params->Signature()) == kernel_map_.end()) {
-        auto maybe_proxy_params = this->PreTuning(params);
-        id = FindFastest(maybe_proxy_params);
-        PostTuning(maybe_proxy_params);
-        kernel_map_.insert({params->Signature(), id});
+    int id = default_id_;
+    TuningResults* results = params->GetTuningResults();
+    if (tuning_ || results != nullptr) {
+      auto params_sig = params->Signature();
+      auto it = kernel_map_.find(params_sig);
+      if (it != kernel_map_.end()) {
+        id = it->second;
       } else {
-        id = kernel_map_[params->Signature()];
+        // The shared results have the ops that were tuned by other threads or loaded from a file.
+        int result_id = results != nullptr ? results->Lookup(OpSignature(), params_sig) : -1;
+        if (result_id >= static_cast<int>(ops_.size())) {
+          result_id = -1;
+        }
+        if (result_id < 0 && tuning_) {
+          auto maybe_proxy_params = this->PreTuning(params);
+          result_id = FindFastest(maybe_proxy_params);
+          PostTuning(maybe_proxy_params);
+          if (results != nullptr) {
+            results->Add(OpSignature(), params_sig, result_id);
+          }
+        }
+        if (result_id >= 0) {
+          kernel_map_.insert({params_sig, result_id});
+          id = result_id;
+        }
       }
-    } else {
-      id = default_id_;
     }
     ORT_RETURN_IF_ERROR(ops_[id](params));
     return Status::OK();
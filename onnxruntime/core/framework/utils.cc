@@ -3,6 +3,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/framework/utils.h"
 
+#include <algorithm>
 #include <iomanip>
 
 #include "core/graph/graph_viewer.h"
@@ -78,21 +79,13 @@ static common::Status AllocateHelper(const AllocatorPtr& allocator,
 
   if (source_mlvalue.IsTensor()) {
     const Tensor& source_tensor = source_mlvalue.Get<Tensor>();
-    if (allocator->Info().alloc_type == OrtArenaAllocator) {
-      BFCArena* arena_ptr = static_cast<BFCArena*>(allocator.get());
-      auto* stream_aware_alloc = StreamAwareArena::FromBFCArena(*arena_ptr);
-      if (stream_aware_alloc && target_stream) {
-        size_t len = Tensor::CalculateTensorStorageSize(source_tensor.DataType(), source_tensor.Shape());
-        void* p_data = stream_aware_alloc->AllocOnStream(len, target_stream, nullptr);
-        Tensor::InitOrtValue(source_tensor.DataType(),
-                             source_tensor.Shape(),
-                             p_data,
-                             allocator, target_mlvalue);
-      } else {
-        Tensor::InitOrtValue(source_tensor.DataType(),
-                             source_tensor.Shape(),
-                             allocator, target_mlvalue);
-      }
+    if (allocator->IsStreamAware() && target_stream) {
+      size_t len = Tensor::CalculateTensorStorageSize(source_tensor.DataType(), source_tensor.Shape());
+      void* p_data = allocator->AllocOnStream(len, target_stream, nullptr);
+      Tensor::InitOrtValue(source_tensor.DataType(),
+                           source_tensor.Shape(),
+                           p_data,
+                           allocator, target_mlvalue);
     } else {
       Tensor::InitOrtValue(source_tensor.DataType(),
                            source_tensor.Shape(),
@@ -451,7 +444,8 @@ static common::Status CopyInputsAcrossDevices(const SessionState& session_state,
                                               gsl::span<const OrtValue> orig_feeds,
                                               std::vector<OrtValue>& new_feeds,
                                               gsl::span<const MLValueCopyInfo> copy_info,
-                                              gsl::span<Stream* const> feed_streams) {
+                                              gsl::span<Stream* const> feed_streams,
+                                              DeviceStreamCollection* device_stream_collection) {
   size_t num_feeds = orig_feeds.size();
   ORT_ENFORCE(copy_info.size() == num_feeds);
   ORT_ENFORCE(feed_streams.size() == num_feeds);
@@ -484,13 +478,39 @@ static common::Status CopyInputsAcrossDevices(const SessionState& session_state,
   }
 #endif
 
-  // flush the stream to make sure the inputs are ready before launch the inference.
-  // TODO: this sync is because the graph inputs can be consumed by multiple stream,
-  // but we can only place the MemCpyAsync on one of the stream. Ideally we should make
-  // other stream wait on the event of the memory copy stream, instead of host sync stream.
+  // the graph inputs can be consumed by multiple streams, but the MemCpyAsync is only placed on one of them.
+  // make the other streams wait on a notification of the copying stream, so the host does not need to wait for the
+  // copies. flush the copying stream if a stream can not wait on it.
+  InlinedVector<Stream*> copy_streams;
   for (auto* stream : feed_streams) {
-    if (stream)
-      stream->Flush();
+    if (stream && std::find(copy_streams.begin(), copy_streams.end(), stream) == copy_streams.end()) {
+      copy_streams.push_back(stream);
+    }
+  }
+
+  for (auto* copy_stream : copy_streams) {
+    auto notification = copy_stream->CreateNotification(/*num_consumers*/ 0);
+    if (!notification || device_stream_collection == nullptr) {
+      copy_stream->Flush();
+      continue;
+    }
+
+    notification->ActivateAndUpdate();
+    for (size_t i = 0, end = device_stream_collection->NumStreams(); i < end; ++i) {
+      Stream* stream = device_stream_collection->GetStream(i);
+      if (stream == nullptr || stream == copy_stream) {
+        continue;
+      }
+
+      auto wait_handle = session_state.GetStreamHandleRegistryInstance().GetWaitHandle(
+          copy_stream->GetDevice().Type(), stream->GetDevice().Type());
+      if (!wait_handle) {
+        copy_stream->Flush();
+        break;
+      }
+      wait_handle(*stream, *notification);
+      stream->UpdateStreamClock(notification->GetStreamSyncTable());
+    }
   }
   return Status::OK();
 }
@@ -518,6 +538,29 @@ common::Status CopyOneInputAcrossDevices(const SessionState& session_state, cons
   return BatchOrCopyMLValue(session_state, copy_info, orig_mlvalue, new_mlvalue, nullptr);
 }
 
+#ifdef ENABLE_STREAM
+// Returns the pinned host allocator used to stage the copy of a graph output from the device to pageable CPU memory,
+// or nullptr if the output is copied directly. A user buffer in pinned memory is a direct copy.
+static AllocatorPtr GetFetchStagingAllocator(const SessionState& session_state, const MLValueCopyInfo& copy_info,
+                                             const OrtValue& fetch, const Stream* stream) {
+  if (stream == nullptr || !fetch.IsTensor() || fetch.Get<Tensor>().SizeInBytes() == 0 ||
+      copy_info.source_device.Type() != OrtDevice::GPU ||
+      copy_info.target_device.Type() != OrtDevice::CPU ||
+      copy_info.target_device.MemType() != OrtDevice::MemType::DEFAULT ||
+      !session_state.GetStreamHandleRegistryInstance().GetWaitHandle(stream->GetDevice().Type(), OrtDevice::CPU)) {
+    return nullptr;
+  }
+
+  for (auto mem_type : {OrtDevice::MemType::CUDA_PINNED, OrtDevice::MemType::HIP_PINNED}) {
+    auto allocator = session_state.GetAllocator(OrtDevice(OrtDevice::CPU, mem_type, 0));
+    if (allocator) {
+      return allocator;
+    }
+  }
+  return nullptr;
+}
+#endif
+
 static common::Status CopyOutputsAcrossDevices(const SessionState& session_state,
                                                gsl::span<const OrtValue> fetches,
                                                std::vector<OrtValue>& user_fetches,
@@ -531,7 +574,40 @@ static common::Status CopyOutputsAcrossDevices(const SessionState& session_state
   std::vector<IDataTransfer::SparseSrcDstPair> batched_sparse_data_transfers;
 #endif
 
+#ifdef ENABLE_STREAM
+  // outputs copied to pageable memory are first copied asynchronously to pinned staging buffers, so the copies of all
+  // the outputs are queued without blocking the host, and the copies of the outputs of different streams overlap.
+  // each output is then moved to the user memory with a single memcpy once its stream is done.
+  struct StagedFetch {
+    size_t idx;
+    OrtValue staging_buffer;
+  };
+  InlinedVector<StagedFetch> staged_fetches;
+#endif
+
   for (size_t idx = 0; idx < num_outputs; ++idx) {
+#ifdef ENABLE_STREAM
+    if (auto staging_allocator = GetFetchStagingAllocator(session_state, copy_info[idx], fetches[idx],
+                                                          fetch_streams[idx]);
+        staging_allocator != nullptr) {
+      if (!user_fetches[idx].IsAllocated()) {
+        auto allocator = session_state.GetAllocator(copy_info[idx].target_device);
+        ORT_ENFORCE(allocator != nullptr, "Failed to find allocator for device ",
+                    copy_info[idx].target_device.ToString());
+        ORT_RETURN_IF_ERROR(AllocateHelper(allocator, fetch_streams[idx], fetches[idx], user_fetches[idx]));
+      }
+
+      StagedFetch staged_fetch{idx, {}};
+      ORT_RETURN_IF_ERROR(AllocateHelper(staging_allocator, fetch_streams[idx], fetches[idx],
+                                         staged_fetch.staging_buffer));
+      batched_data_transfers.push_back({fetches[idx].Get<Tensor>(),
+                                        *staged_fetch.staging_buffer.GetMutable<Tensor>(),
+                                        fetch_streams[idx]});
+      staged_fetches.push_back(std::move(staged_fetch));
+      continue;
+    }
+#endif
+
 #if !defined(DISABLE_SPARSE_TENSORS)
     ORT_RETURN_IF_ERROR(BatchOrCopyMLValue(session_state, copy_info[idx], fetches[idx], user_fetches[idx], fetch_streams[idx],
                                            &batched_data_transfers, &batched_sparse_data_transfers));
@@ -551,6 +627,29 @@ static common::Status CopyOutputsAcrossDevices(const SessionState& session_state
   }
 #endif
 
+#ifdef ENABLE_STREAM
+  InlinedVector<Stream*> completed_streams;
+  for (auto& staged_fetch : staged_fetches) {
+    Stream* stream = fetch_streams[staged_fetch.idx];
+    if (std::find(completed_streams.begin(), completed_streams.end(), stream) == completed_streams.end()) {
+      auto notification = stream->CreateNotification(/*num_consumers*/ 0);
+      if (notification) {
+        notification->ActivateAndUpdate();
+        auto wait_handle = session_state.GetStreamHandleRegistryInstance().GetWaitHandle(
+            stream->GetDevice().Type(), OrtDevice::CPU);
+        wait_handle(*stream, *notification);
+      } else {
+        stream->Flush();
+      }
+      completed_streams.push_back(stream);
+    }
+
+    const Tensor& staging_tensor = staged_fetch.staging_buffer.Get<Tensor>();
+    memcpy(user_fetches[staged_fetch.idx].GetMutable<Tensor>()->MutableDataRaw(), staging_tensor.DataRaw(),
+           staging_tensor.SizeInBytes());
+  }
+#endif
+
   return Status::OK();
 }
 
@@ -667,12 +766,15 @@ ExecuteGraphImpl(const SessionState& session_state,
         if (!found)
           feed_streams.push_back(nullptr);
       }
+      ORT_RETURN_IF_ERROR(CopyInputsAcrossDevices(session_state, feeds, device_feeds, feed_copy_info, feed_streams,
+                                                  &device_stream_collection));
 #else
       for (size_t i = 0; i < feed_copy_info.size(); ++i) {
         feed_streams.push_back(nullptr);
       }
+      ORT_RETURN_IF_ERROR(CopyInputsAcrossDevices(session_state, feeds, device_feeds, feed_copy_info, feed_streams,
+                                                  nullptr));
 #endif
-      ORT_RETURN_IF_ERROR(CopyInputsAcrossDevices(session_state, feeds, device_feeds, feed_copy_info, feed_streams));
       feeds_to_use = device_feeds;
     }
 
@@ -821,7 +923,8 @@ common::Status ExecutePartialGraphImpl(const SessionState& session_state, FeedsF
         if (!found)
           feed_streams.push_back(nullptr);
       }
-      ORT_RETURN_IF_ERROR(CopyInputsAcrossDevices(session_state, feeds, device_feeds, feed_copy_info, feed_streams));
+      ORT_RETURN_IF_ERROR(CopyInputsAcrossDevices(session_state, feeds, device_feeds, feed_copy_info, feed_streams,
+                                                  &device_stream_collection));
       p_feeds = device_feeds;
     }
 
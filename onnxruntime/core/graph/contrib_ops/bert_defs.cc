@@ -37,6 +37,17 @@ void DecoderAttentionTypeAndShapeInference(ONNX_NAMESPACE::InferenceContext& ctx
     updateOutputShape(ctx, 0, query_shape);
   }
   if (ctx.getNumOutputs() > 1) {
+    // The paged key and value caches are updated in place, so the new caches have the shape of the caches.
+    if (ctx.getNumInputs() > 12 && ctx.getInputType(12) != nullptr) {
+      if (hasInputShape(ctx, 6)) {
+        propagateShapeFromInputToOutput(ctx, 6, 1);
+      }
+      if (hasInputShape(ctx, 7)) {
+        propagateShapeFromInputToOutput(ctx, 7, 2);
+      }
+      return;
+    }
+
     if (hasInputShape(ctx, 6) && hasInputShape(ctx, 7)) {
       auto& cache_shape = getInputShape(ctx, 6);
       auto& cache_dims = cache_shape.dim();
@@ -152,6 +163,13 @@ When there is past state, hidden dimension for Q, K and V shall be the same.
 The total_sequence_length is past_sequence_length + kv_sequence_length. Here kv_sequence_length is the length of K or V.
 For self attention, kv_sequence_length equals to sequence_length (sequence length of Q).
 For cross attention, query and key might have different lengths.
+
+When rotary_embedding_dim is not zero, rotary position embedding (GPT-NeoX style, base 10000) is applied to the first
+rotary_embedding_dim elements of each head of Q and K after the bias is added. The position of a token is its index in
+the sequence plus past_sequence_length.
+
+When use_alibi is 1, the ALiBi bias slope(head) * (key_position - query_position) is added to Q*K' before softmax,
+with the standard slopes of head: 2^(-8 * (head + 1) / num_heads) when num_heads is a power of 2.
 )DOC";
 
 ONNX_MS_OPERATOR_SET_SCHEMA(
@@ -172,6 +190,15 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
               "(2, batch_size, num_heads, max_sequence_length, head_size)",
               AttributeProto::INT,
               static_cast<int64_t>(0))
+        .Attr("rotary_embedding_dim",
+              "Number of elements at the start of each head of Q and K rotated by rotary position embedding. "
+              "It shall be even and no larger than head_size. Default value is 0 (no rotary embedding).",
+              AttributeProto::INT,
+              static_cast<int64_t>(0))
+        .Attr("use_alibi",
+              "Whether to add ALiBi position bias to Q*K' before softmax. Default value is 0.",
+              AttributeProto::INT,
+              static_cast<int64_t>(0))
         .Input(0,
                "input",
                "Input tensor with shape (batch_size, sequence_length, input_hidden_size) when weights is available, "
@@ -279,6 +306,14 @@ ONNX_MS_OPERATOR_SET_SCHEMA(LongformerAttention, 1,
 constexpr const char* Decoder_Attention_doc = R"DOC(
 This DecoderAttention supports self attention and cross attention, key and value cache, and key_padding_mask. The attention mask is not support at the moment.
 Some boolean parameters are passed by runtime input for generic purpose
+
+When cache_block_table is given, the key and value caches are paged: key_cache and value_cache are pools of blocks with shape
+(num_blocks, num_heads, block_size, head_size) shared by all the sequences, and the t-th token of the b-th sequence is at position
+t % block_size of block cache_block_table[b][t / block_size]. cache_sequence_lengths gives the number of tokens of each sequence
+in the cache. Self attention writes the keys and values of the query tokens after them, so the block table must have room for them,
+and attends to all the tokens of the sequence. New_key_cache and new_value_cache are the updated pools, they can be bound to the
+same buffers as the input caches to update them in place. Only the CUDA kernel supports paged caches, and use_past and
+has_layer_state shall be true.
 )DOC";
 
 ONNX_MS_OPERATOR_SET_SCHEMA(DecoderAttention, 1,
@@ -297,11 +332,14 @@ ONNX_MS_OPERATOR_SET_SCHEMA(DecoderAttention, 1,
                                 .Input(9, "use_past", "If use_past = true, use cache; else no cache", "B")
                                 .Input(10, "has_layer_state", "If has_layer_state = true, layer_state = {} or [a,b]; else layer_state = None", "B")
                                 .Input(11, "has_key_padding_mask", "has_key_padding_mask or not", "B")
+                                .Input(12, "cache_block_table", "2D input tensor with shape (batch_size, max_blocks_per_sequence), the blocks of the paged caches of each sequence", "M", OpSchema::Optional)
+                                .Input(13, "cache_sequence_lengths", "1D input tensor with shape (batch_size), the number of tokens of each sequence in the paged caches", "M", OpSchema::Optional)
                                 .Output(0, "output", "3D output tensor with shape (sequence_length, batch_size, hidden_size)", "T")
                                 .Output(1, "new_key_cache", "output tensor with shape (batch_size, num_heads, new sequence_length, head_size)", "T", OpSchema::Optional)    // self & cross
                                 .Output(2, "new_value_cache", "output tensor with shape (batch_size, num_heads, new sequence_length, head_size)", "T", OpSchema::Optional)  // self & cross
                                 .TypeConstraint("T", {"tensor(float)", "tensor(float16)"}, "Constrain input and output types to float and float16 tensors.")
                                 .TypeConstraint("B", {"tensor(bool)"}, "Constrain key_padding_mask to bool tensors.")
+                                .TypeConstraint("M", {"tensor(int32)"}, "Constrain the block table and sequence lengths to int32 tensors.")
                                 .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
                                   DecoderAttentionTypeAndShapeInference(ctx);
                                 }));
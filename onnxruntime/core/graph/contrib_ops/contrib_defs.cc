@@ -608,6 +608,94 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           return true;
         }));
 
+constexpr const char* FusedElementwise_ver1_doc = R"DOC(
+Runs a chain of elementwise operators in a single pass over the data, without materializing the intermediate
+results. The values are numbered starting with the inputs, followed by the result of each step. Step i applies
+ops[i] to the values operands[2 * i] and operands[2 * i + 1], where the second operand is -1 for unary operators.
+The output is the result of the last step. The supported operators are Add, Sub, Mul, Div, Relu, Sigmoid, Tanh,
+Neg, Abs and Sqrt.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    FusedElementwise, 1,
+    OpSchema()
+        .SetDoc(FusedElementwise_ver1_doc)
+        .Attr("ops", "The operator of each step.", AttributeProto::STRINGS)
+        .Attr("operands", "The two operands of each step.", AttributeProto::INTS)
+        .Input(0, "inputs", "The inputs of the chain. They must be broadcastable to the output shape.", "T",
+               OpSchema::Variadic)
+        .Output(0, "Y", "The result of the last step.", "T")
+        .TypeConstraint("T", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          std::vector<const TensorShapeProto*> shapes;
+          for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+            if (!hasInputShape(ctx, i)) {
+              return;
+            }
+            shapes.push_back(&ctx.getInputType(i)->tensor_type().shape());
+          }
+          multidirectionalBroadcastShapeInference(
+              shapes, *ctx.getOutputType(0)->mutable_tensor_type()->mutable_shape());
+        }));
+
+constexpr const char* EmbeddingBag_ver1_doc = R"DOC(
+Gathers rows of an embedding table and reduces each bag of rows, which is the last dimension of the indices, without
+materializing the gathered rows. It computes ReduceSum or ReduceMean over the last axis of the indices of
+Gather(table, indices) with axis 0. Negative indices count from the end of the table, and an empty bag produces zeros.
+The table may be stored as float16, in which case the output is float16, or as 8-bit integers with a scale and an
+optional zero point per row, in which case row r is dequantized to scale[r] * (table[r] - zero_point[r]).
+The rows are accumulated in single precision.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    EmbeddingBag, 1,
+    OpSchema()
+        .SetDoc(EmbeddingBag_ver1_doc)
+        .Attr("mode", "The reduction of the rows of a bag, 'sum' or 'mean'.", AttributeProto::STRING,
+              std::string("sum"))
+        .Attr("keepdims", "Keep the reduced dimension of the indices with size 1.", AttributeProto::INT,
+              static_cast<int64_t>(0))
+        .Input(0, "table", "The embedding table with shape (num_embeddings, embedding_dim).", "T")
+        .Input(1, "indices", "The row indices, where the last dimension is the bag.", "Tind")
+        .Input(2, "scale", "The scale of each row with shape (num_embeddings). Required for 8-bit tables.",
+               "tensor(float)", OpSchema::Optional)
+        .Input(3, "zero_point", "The zero point of each row with shape (num_embeddings) for 8-bit tables.", "T",
+               OpSchema::Optional)
+        .Output(0, "Y", "The reduced rows with shape indices.shape[:-1] + (embedding_dim).", "T1")
+        .TypeConstraint("T", {"tensor(float)", "tensor(float16)", "tensor(int8)", "tensor(uint8)"},
+                        "Constrain the table to float or 8-bit integer tensors.")
+        .TypeConstraint("Tind", {"tensor(int32)", "tensor(int64)"}, "Constrain indices to integer types.")
+        .TypeConstraint("T1", {"tensor(float)", "tensor(float16)"}, "Constrain the output to float tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          const auto* table_type = ctx.getInputType(0);
+          if (table_type == nullptr || !table_type->has_tensor_type()) {
+            return;
+          }
+          const bool is_half = table_type->tensor_type().elem_type() == TensorProto::FLOAT16;
+          updateOutputElemType(ctx, 0, is_half ? TensorProto::FLOAT16 : TensorProto::FLOAT);
+
+          if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1)) {
+            return;
+          }
+          const auto& table_shape = getInputShape(ctx, 0);
+          const auto& indices_shape = getInputShape(ctx, 1);
+          if (table_shape.dim_size() != 2) {
+            fail_shape_inference("table must be 2D");
+          }
+          if (indices_shape.dim_size() < 1) {
+            fail_shape_inference("indices must have at least one dimension");
+          }
+
+          const bool keepdims = getAttribute(ctx, "keepdims", 0) != 0;
+          auto* output_shape = getOutputShape(ctx, 0);
+          for (int i = 0; i < indices_shape.dim_size() - 1; ++i) {
+            *output_shape->add_dim() = indices_shape.dim(i);
+          }
+          if (keepdims) {
+            output_shape->add_dim()->set_dim_value(1);
+          }
+          *output_shape->add_dim() = table_shape.dim(1);
+        }));
+
 // Used to be ONNX 1.7 Inverse(12)
 // Comment out docs not to increase the binary size
 //
@@ -1102,6 +1190,13 @@ ONNX_MS_OPERATOR_SET_SCHEMA(GreedySearch, 1,
                                       "This is relevant only for the GPT2 model. If this attribute is missing, the `decoder` subgraph will be used for all decoding runs",
                                       AttributeProto::GRAPH, OPTIONAL_VALUE)
                                 .Attr("decoder", "Decoder subgraph to execute in a loop.", AttributeProto::GRAPH)
+                                .Attr("draft_decoder",
+                                      "Decoder subgraph of a smaller draft model with the same vocabulary. "
+                                      "When present, the draft model proposes `num_draft_tokens` tokens that are verified by one run of `decoder`. "
+                                      "This is relevant only for the GPT2 model, and the generated sequences are the same as without it",
+                                      AttributeProto::GRAPH, OPTIONAL_VALUE)
+                                .Attr("num_draft_tokens", "The number of tokens proposed by `draft_decoder` for each run of `decoder`.",
+                                      AttributeProto::INT, static_cast<int64_t>(4))
                                 .Attr("vocab_size",
                                       "Size of the vocabulary. "
                                       "If not provided, it will be inferred from the decoder subgraph's output shape",
@@ -1705,6 +1800,12 @@ ONNX_MS_OPERATOR_SET_SCHEMA(FusedMatMul, 1,
                             OpSchema()
                                 .Input(0, "A", "N-dimensional matrix A", "T")
                                 .Input(1, "B", "N-dimensional matrix B", "T")
+                                .Attr("activation",
+                                      "Optional activation applied to the matrix multiply results by the CPU kernel: "
+                                      "Relu, Tanh, Sigmoid, LeakyRelu, Clip, HardSigmoid, Gelu or FastGelu",
+                                      AttributeProto::STRING, OPTIONAL_VALUE)
+                                .Attr("activation_params", "Parameters of the activation", AttributeProto::FLOATS,
+                                      OPTIONAL_VALUE)
                                 .Attr("alpha", "Scalar multiplier for the product of the input tensors.", AttributeProto::FLOAT, 1.0f)
                                 .Attr("transA", "Whether A should be transposed on the last two dimensions before doing multiplication",
                                       AttributeProto::INT, static_cast<int64_t>(0))
@@ -2176,6 +2277,72 @@ ONNX_MS_OPERATOR_SET_SCHEMA(CropAndResize, 1,
         a fixed size = [crop_height, crop_width]. The result is a 4-D tensor [num_boxes, crop_height, crop_width, depth].
         The resizing is corner aligned.)DOC"));
 
+constexpr const char* AllReduce_ver1_doc = R"DOC(
+Sums the input tensor element wise over all the ranks of the tensor parallel group and returns the sum on every
+rank. The tensor must have the same shape on every rank.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(AllReduce, 1,
+                            OpSchema()
+                                .SetDoc(AllReduce_ver1_doc)
+                                .Input(0, "input", "The partial tensor of this rank.", "T")
+                                .Output(0, "output", "The sum of the input over all the ranks.", "T")
+                                .TypeConstraint(
+                                    "T",
+                                    {"tensor(float16)", "tensor(float)", "tensor(bfloat16)"},
+                                    "Constrain input and output types to float tensors.")
+                                .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
+constexpr const char* AllGather_ver1_doc = R"DOC(
+Gathers the input tensors of all the ranks of the tensor parallel group and concatenates them along the given axis
+in rank order. The tensor must have the same shape on every rank.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(AllGather, 1,
+                            OpSchema()
+                                .SetDoc(AllGather_ver1_doc)
+                                .Attr("group_size",
+                                      "The number of ranks of the tensor parallel group.",
+                                      AttributeProto::INT,
+                                      static_cast<int64_t>(1))
+                                .Attr("axis",
+                                      "The axis to concatenate the gathered tensors along.",
+                                      AttributeProto::INT,
+                                      static_cast<int64_t>(0))
+                                .Input(0, "input", "The shard of this rank.", "T")
+                                .Output(0, "output", "The shards of all the ranks concatenated along axis.", "T")
+                                .TypeConstraint(
+                                    "T",
+                                    {"tensor(float16)", "tensor(float)", "tensor(bfloat16)"},
+                                    "Constrain input and output types to float tensors.")
+                                .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+                                  propagateElemTypeFromInputToOutput(ctx, 0, 0);
+                                  if (!hasInputShape(ctx, 0)) {
+                                    return;
+                                  }
+
+                                  const auto& input_shape = getInputShape(ctx, 0);
+                                  const int rank = input_shape.dim_size();
+                                  int64_t axis = getAttribute(ctx, "axis", 0);
+                                  if (axis < -rank || axis >= rank) {
+                                    fail_shape_inference("axis must be in [-rank, rank-1].");
+                                  }
+                                  if (axis < 0) {
+                                    axis += rank;
+                                  }
+
+                                  const int64_t group_size = getAttribute(ctx, "group_size", 1);
+                                  ONNX_NAMESPACE::TensorShapeProto output_shape;
+                                  for (int i = 0; i < rank; ++i) {
+                                    auto* dim = output_shape.add_dim();
+                                    const auto& input_dim = input_shape.dim(i);
+                                    if (i != axis) {
+                                      *dim = input_dim;
+                                    } else if (input_dim.has_dim_value()) {
+                                      dim->set_dim_value(input_dim.dim_value() * group_size);
+                                    }
+                                  }
+                                  updateOutputShape(ctx, 0, output_shape);
+                                }));
+
 void RegisterContribSchemas() {
   ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(AttnLSTM, RegisterAttnLSTMContribOpSchema);
   ONNX_CONTRIB_OPERATOR_SCHEMA_ELSEWHERE(Range, RegisterRangeOpSchema);
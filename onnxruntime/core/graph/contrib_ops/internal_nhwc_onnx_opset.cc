@@ -81,13 +81,16 @@ void OpSet_Internal_NHWC_ONNX::ForEachSchema(const std::function<void(ONNX_NAMES
   REGISTER_NHWC_SCHEMA_WITH_ACTIVATION(fn, MaxUnpool, 9);
   REGISTER_NHWC_SCHEMA_WITH_ACTIVATION(fn, MaxUnpool, 11);
   REGISTER_NHWC_SCHEMA_WITH_ACTIVATION(fn, AveragePool, 11);
+  REGISTER_NHWC_SCHEMA(fn, GlobalAveragePool, 1);
+  REGISTER_NHWC_SCHEMA(fn, GlobalMaxPool, 1);
+  REGISTER_NHWC_SCHEMA(fn, BatchNormalization, 9);
+  REGISTER_NHWC_SCHEMA(fn, BatchNormalization, 14);
+  REGISTER_NHWC_SCHEMA(fn, BatchNormalization, 15);
   REGISTER_NHWC_SCHEMA(fn, QLinearConv, 10);
   REGISTER_NHWC_SCHEMA_FROM_MSDOMAIN(fn, QLinearAveragePool, 1);
   REGISTER_NHWC_SCHEMA_FROM_MSDOMAIN(fn, QLinearConvTranspose, 1);
 
   // TODO: Add other layout sensitive ops when needed. Those are:
-  //   BatchNormalization,
-  //   AveragePool, GlobalAveragePool, GlobalMaxPool,
   //   LRN,
   //   GridSample
   //   DepthToSpace, SpaceToDepth
@@ -370,6 +370,16 @@ std::function<void(OpSchema&)> ConvOpSchemaGenerator() {
         "number of groups input channels and output channels are divided into.",
         AttributeProto::INT,
         static_cast<int64_t>(1));
+    schema.Attr(
+        "activation",
+        "Optional activation fused into the convolution, as named by FusedConv.",
+        AttributeProto::STRING,
+        OPTIONAL_VALUE);
+    schema.Attr(
+        "activation_params",
+        "Optional parameters of the fused activation.",
+        AttributeProto::FLOATS,
+        OPTIONAL_VALUE);
     schema.TypeAndShapeInferenceFunction([](InferenceContext& ctx) {
       propagateElemTypeFromInputToOutput(ctx, 0, 0);
       NhwcInferenceContext nhwc_ctx(ctx);
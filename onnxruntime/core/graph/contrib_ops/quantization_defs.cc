@@ -307,6 +307,108 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           y_type->mutable_tensor_type()->set_elem_type(static_cast<int>(dtype_proto->i()));
         }));
 
+static const char* QuantizeFloat8_ver1_doc = R"DOC(
+The float8 quantization operator. It consumes a full precision tensor and a per tensor scale and computes the float8
+tensor y = float8(x / y_scale), rounding to nearest even. The float8 values are stored as their bit patterns in a
+uint8 tensor. The 'fp8_format' attribute selects the E4M3FN format (4 exponent and 3 mantissa bits, no infinity) or
+the E5M2 format (5 exponent and 2 mantissa bits). When 'saturate' is set, values out of the range of the format are
+clamped to its largest finite value, otherwise they become NaN or infinity.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    QuantizeFloat8, 1,
+    OpSchema()
+        .Attr("fp8_format", "The float8 format of y: 'E4M3FN' or 'E5M2'.", AttributeProto::STRING,
+              std::string("E4M3FN"))
+        .Attr("saturate", "Whether out of range values are clamped to the largest finite value of the format.",
+              AttributeProto::INT, static_cast<int64_t>(1))
+        .Input(0, "x", "N-D full precision input tensor to be quantized.", "T1")
+        .Input(1, "y_scale", "Scalar scale for doing quantization to get 'y'.", "T1")
+        .Output(0, "y", "N-D float8 output tensor. It has same shape as input 'x'.", "T2")
+        .TypeConstraint("T1", {"tensor(float16)", "tensor(float)"}, "Constrain 'x', 'y_scale' to float tensors.")
+        .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain 'y' to uint8 tensors holding the float8 values.")
+        .SetDoc(QuantizeFloat8_ver1_doc)
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          updateOutputElemType(ctx, 0, ONNX_NAMESPACE::TensorProto::UINT8);
+
+          if (!hasInputShape(ctx, 0)) return;
+
+          auto& input_shape = getInputShape(ctx, 0);
+          updateOutputShape(ctx, 0, input_shape);
+        }));
+
+static const char* DequantizeFloat8_ver1_doc = R"DOC(
+The float8 dequantization operator. It consumes a float8 tensor stored as uint8 and a per tensor scale and computes
+the full precision tensor y = float(x) * x_scale.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    DequantizeFloat8, 1,
+    OpSchema()
+        .Attr("fp8_format", "The float8 format of x: 'E4M3FN' or 'E5M2'.", AttributeProto::STRING,
+              std::string("E4M3FN"))
+        .Input(0, "x", "N-D float8 input tensor to be de-quantized.", "T1")
+        .Input(1, "x_scale", "Scalar scale for input 'x'.", "T2")
+        .Output(0, "y", "N-D full precision output tensor. It has same shape as input 'x'.", "T2")
+        .TypeConstraint("T1", {"tensor(uint8)"}, "Constrain 'x' to uint8 tensors holding the float8 values.")
+        .TypeConstraint("T2", {"tensor(float16)", "tensor(float)"}, "Constrain 'y', 'x_scale' to float tensors.")
+        .SetDoc(DequantizeFloat8_ver1_doc)
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 1, 0);
+
+          if (!hasInputShape(ctx, 0)) return;
+
+          auto& input_shape = getInputShape(ctx, 0);
+          updateOutputShape(ctx, 0, input_shape);
+        }));
+
+static const char* MatMulFloat8_ver1_doc = R"DOC(
+Matrix product of float8 tensors with per tensor scales, Y = (A * a_scale) x transpose(B * b_scale). A has shape
+(..., M, K) and B is the transposed weight of shape (N, K), both hold float8 values stored as uint8. The product is
+accumulated in float. A and B can not both be E5M2. The CUDA implementation runs on the float8 tensor cores of
+devices with compute capability 8.9 or above, and requires K and N to be multiples of 16.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    MatMulFloat8, 1,
+    OpSchema()
+        .Attr("fp8_format_a", "The float8 format of A: 'E4M3FN' or 'E5M2'.", AttributeProto::STRING,
+              std::string("E4M3FN"))
+        .Attr("fp8_format_b", "The float8 format of B: 'E4M3FN' or 'E5M2'.", AttributeProto::STRING,
+              std::string("E4M3FN"))
+        .Attr("dtype", "The data type of Y.", AttributeProto::INT,
+              static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_FLOAT16))
+        .Input(0, "A", "N-dimensional float8 matrix A with shape (..., M, K).", "T1")
+        .Input(1, "B", "2-dimensional float8 matrix B with shape (N, K).", "T1")
+        .Input(2, "a_scale", "Scalar scale of A.", "T2")
+        .Input(3, "b_scale", "Scalar scale of B.", "T2")
+        .Output(0, "Y", "Matrix multiply results with shape (..., M, N).", "T3")
+        .TypeConstraint("T1", {"tensor(uint8)"}, "Constrain A and B to uint8 tensors holding the float8 values.")
+        .TypeConstraint("T2", {"tensor(float)"}, "Constrain the scales to float tensors.")
+        .TypeConstraint("T3", {"tensor(float16)", "tensor(bfloat16)", "tensor(float)"},
+                        "Constrain Y to float tensors.")
+        .SetDoc(MatMulFloat8_ver1_doc)
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          auto* dtype = ctx.getAttribute("dtype");
+          updateOutputElemType(ctx, 0, dtype != nullptr ? static_cast<int32_t>(dtype->i())
+                                                        : ONNX_NAMESPACE::TensorProto::FLOAT16);
+
+          if (!hasInputShape(ctx, 0) || !hasInputShape(ctx, 1)) return;
+
+          auto& a_shape = getInputShape(ctx, 0);
+          auto& b_shape = getInputShape(ctx, 1);
+          if (a_shape.dim_size() < 2) {
+            fail_shape_inference("A must have at least 2 dimensions");
+          }
+          if (b_shape.dim_size() != 2) {
+            fail_shape_inference("B must be 2 dimensional");
+          }
+
+          ONNX_NAMESPACE::TensorShapeProto y_shape;
+          for (int i = 0; i < a_shape.dim_size() - 1; ++i) {
+            *y_shape.add_dim() = a_shape.dim(i);
+          }
+          *y_shape.add_dim() = b_shape.dim(0);
+          updateOutputShape(ctx, 0, y_shape);
+        }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(ReduceSumInteger, 1,
                             OpSchema()
                                 .SetDoc(R"DOC(
@@ -381,6 +483,10 @@ C (int32) = (A - A_zero_point) * (B - B_zero_point)
 ONNX_MS_OPERATOR_SET_SCHEMA(
     DynamicQuantizeMatMul, 1,
     OpSchema()
+        .Attr("per_row_quantization",
+              "If 1, A is quantized symmetrically with one scale per row (per token) instead of one scale and zero "
+              "point for the whole tensor.",
+              AttributeProto::INT, static_cast<int64_t>(0))
         .Input(0, "A", "N-dimensional matrix A", "T1")
         .Input(1, "B", "N-dimensional matrix B", "T2")
         .Input(2, "b_scale",
@@ -441,6 +547,73 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
           ONNX_NAMESPACE::matmulShapeInference(ctx, 0, 1);
         }));
 
+static const char* MatMulNBits_ver1_doc = R"DOC(
+MatMulNBits is a MatMul with weight quantized with N bits. It does Matrix Multiplication like MatMul (https://github.com/onnx/onnx/blob/main/docs/Operators.md#matmul) with differences:
+  1. Input B is a 2D constant Matrix. Its input feature count and output feature count are specified by attribute 'K' and 'N'.
+  2. Input B is quantized with x bits which is specified by attribute 'bits'. It is quantized blockwisely along dimension 0 (e.g. column) with block size specified by attribute block_size.
+     And block_size is not an arbitrary number and must be a power of 2 and not smaller than 32, like 32, 64, 128, 256.
+  3. Input B's scale and zero point are specified by input scales and zero_points.
+
+Input B is stored as uint8_t with shape: [N][n_blocks_per_col][blob_size] in which:
+  - n_blocks_per_col = (K + block_size - 1) / block_size
+  - blob_size = block_size / 8 * bits
+For 4 bits, element 2i of a block is stored in the low nibble of byte i and element 2i+1 in the high nibble.
+
+Input scales is stored in same type as A with shape: [N * n_blocks_per_col]
+Input zero_points is stored as uint8_t, two zero points per byte (the zero point of block 2i in the low nibble), with shape:
+  - [N * ((n_blocks_per_col + 1) / 2)]
+If zero_points is not provided, the zero point is 2^(bits - 1) (8 for 4 bits).
+
+Only bits = 4 is currently supported.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    MatMulNBits, 1,
+    OpSchema()
+        .SetDoc(MatMulNBits_ver1_doc)
+        .Attr("K", "size of each input feature", AttributeProto::INT)
+        .Attr("N", "size of each output feature", AttributeProto::INT)
+        .Attr("bits", "number of bits used for weight quantization (default 4)", AttributeProto::INT,
+              static_cast<int64_t>(4))
+        .Attr("block_size",
+              "number of groupsize used for weight quantization,(default 128). It needs to be a power of 2 and not "
+              "smaller than 32.",
+              AttributeProto::INT, static_cast<int64_t>(128))
+        .Input(0, "A", "The input tensor, not quantized", "T1")
+        .Input(1, "B", "1-dimensional data blob", "T2")
+        .Input(2, "scales", "quantization scale", "T1")
+        .Input(3, "zero_points", "quantization zero points", "T2", OpSchema::Optional)
+        .Output(0, "Y", "tensor. The output tensor has the same rank as the input. ", "T1")
+        .TypeConstraint("T1", {"tensor(float)"}, "Constrain input and output types to float tensors.")
+        .TypeConstraint("T2", {"tensor(uint8)"}, "Constrain quantized weight types to uint8.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          // Type inference
+          propagateElemTypeFromInputToOutput(ctx, 0, 0);
+          // Shape inference
+          int64_t in_features = getAttribute(ctx, "K", -1);
+          int64_t out_features = getAttribute(ctx, "N", -1);
+          if (!hasInputShape(ctx, 0)) {
+            return;
+          }
+
+          const auto& a_shape = ctx.getInputType(0)->tensor_type().shape();
+          if (a_shape.dim_size() == 0) {
+            fail_shape_inference("Input A should not be a scalar.");
+          }
+
+          const auto& a_last_dim = a_shape.dim(a_shape.dim_size() - 1);
+          if (a_last_dim.has_dim_value() && a_last_dim.dim_value() != in_features) {
+            fail_shape_inference("Incompatible dimensions for matrix multiplication");
+          }
+
+          ONNX_NAMESPACE::TensorShapeProto result_shape;
+          for (int i = 0; i < a_shape.dim_size() - 1; ++i) {
+            *result_shape.add_dim() = a_shape.dim(i);
+          }
+          result_shape.add_dim()->set_dim_value(out_features);
+          updateOutputShape(ctx, 0, result_shape);
+        }));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(
     QLinearAdd, 1,
     OpSchema().FillUsing(QLinearMathDocGenerator(
@@ -570,6 +743,28 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
         .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"}, "Constrain input and output types to 8 bit tensors.")
         .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
 
+const char* QLinearLookupTableDoc_ver1 = R"DOC(
+QLinearLookupTable maps each element of the 8 bit input X to the entry of the 256 entry table at the index of its
+bits, i.e. `Y = table[X]` for uint8 X and `Y = table[X + 256 if X < 0 else X]` for int8 X.
+It is created by the QDQ optimizations from a chain of elementwise float ops between a DequantizeLinear and
+a QuantizeLinear node, with the table holding the quantized results of the chain for all the input values.)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    QLinearLookupTable, 1,
+    OpSchema()
+        .SetDoc(QLinearLookupTableDoc_ver1)
+        .Input(0, "X", "Input tensor", "T1")
+        .Input(1, "table", "1D tensor with 256 entries, the output value for each of the input values.", "T2")
+        .Output(0, "Y", "Output tensor with the shape of X", "T2")
+        .TypeConstraint("T1", {"tensor(uint8)", "tensor(int8)"}, "Constrain input type to 8 bit tensors.")
+        .TypeConstraint("T2", {"tensor(uint8)", "tensor(int8)"}, "Constrain table and output types to 8 bit tensors.")
+        .TypeAndShapeInferenceFunction([](ONNX_NAMESPACE::InferenceContext& ctx) {
+          propagateElemTypeFromInputToOutput(ctx, 1, 0);
+          if (hasInputShape(ctx, 0)) {
+            propagateShapeFromInputToOutput(ctx, 0, 0);
+          }
+        }));
+
 const char* QLinearSigmoidDoc_ver1 = R"DOC(
 QLinearSigmoid takes quantized input data (Tensor), and quantize parameter for output, and produces one output data
 (Tensor<T>) where the function `f(x) = quantize(Sigmoid(dequantize(x)))`, is applied to the data tensor elementwise.
@@ -596,6 +791,67 @@ ONNX_MS_OPERATOR_SET_SCHEMA(
         .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"}, "Constrain input and output types to 8 bit tensors.")
         .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
 
+const char* QLinearGeluDoc_ver1 = R"DOC(
+QLinearGelu takes quantized input data (Tensor), and quantize parameter for output, and produces one output data
+(Tensor<T>) where the function `f(x) = quantize(Gelu(dequantize(x)))`, is applied to the data tensor elementwise.
+Where the function `Gelu(x) = 0.5 * x * (1 + erf(x / sqrt(2)))` )DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    QLinearGelu, 1,
+    OpSchema()
+        .SetDoc(QLinearGeluDoc_ver1)
+        .Input(0, "X", "Input tensor", "T")
+        .Input(1, "X_scale", "Input X's scale. It's a scalar, which means a per-tensor/layer quantization.",
+               "tensor(float)")
+        .Input(2, "X_zero_point",
+               "Input X's zero point. Default value is 0 if it's not specified. It's a scalar, which means a "
+               "per-tensor/layer quantization.",
+               "T", OpSchema::Optional)
+        .Input(3, "Y_scale", "Output Y's scale. It's a scalar, which means a per-tensor/layer quantization.",
+               "tensor(float)")
+        .Input(4, "Y_zero_point",
+               "Output Y's zero point. Default value is 0 if it's not specified. It's a scalar, which means a "
+               "per-tensor/layer quantization.",
+               "T", OpSchema::Optional)
+        .Output(0, "Y", "Output tensor", "T")
+        .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"}, "Constrain input and output types to 8 bit tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
+const char* QLinearLayerNormalizationDoc_ver1 = R"DOC(
+QLinearLayerNormalization takes quantized input data (Tensor), float scale and bias, and quantize parameter for output,
+and produces one output data (Tensor<T>) where `Y = quantize(LayerNormalization(dequantize(X), scale, B))`.
+The normalization is computed in float over the dimensions from `axis` to the last one.
+)DOC";
+
+ONNX_MS_OPERATOR_SET_SCHEMA(
+    QLinearLayerNormalization, 1,
+    OpSchema()
+        .SetDoc(QLinearLayerNormalizationDoc_ver1)
+        .Attr("axis", "The first normalization dimension. Negative value means counting dimensions from the back.",
+              AttributeProto::INT, static_cast<int64_t>(-1))
+        .Attr("epsilon", "The epsilon value to use to avoid division by zero.", AttributeProto::FLOAT, 1e-5f)
+        .Attr("stash_type", "Type of the intermediate results. Only float is supported.", AttributeProto::INT,
+              static_cast<int64_t>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT))
+        .Input(0, "X", "Input tensor", "T")
+        .Input(1, "X_scale", "Input X's scale. It's a scalar, which means a per-tensor/layer quantization.",
+               "tensor(float)")
+        .Input(2, "X_zero_point",
+               "Input X's zero point. Default value is 0 if it's not specified. It's a scalar, which means a "
+               "per-tensor/layer quantization.",
+               "T", OpSchema::Optional)
+        .Input(3, "Y_scale", "Output Y's scale. It's a scalar, which means a per-tensor/layer quantization.",
+               "tensor(float)")
+        .Input(4, "Y_zero_point",
+               "Output Y's zero point. Default value is 0 if it's not specified. It's a scalar, which means a "
+               "per-tensor/layer quantization.",
+               "T", OpSchema::Optional)
+        .Input(5, "scale", "Scale tensor with the shape of the normalized dimensions.", "tensor(float)")
+        .Input(6, "B", "Bias tensor with the shape of the normalized dimensions.", "tensor(float)",
+               OpSchema::Optional)
+        .Output(0, "Y", "Output tensor", "T")
+        .TypeConstraint("T", {"tensor(uint8)", "tensor(int8)"}, "Constrain input and output types to 8 bit tensors.")
+        .TypeAndShapeInferenceFunction(ONNX_NAMESPACE::propagateShapeAndTypeFromFirstInput));
+
 ONNX_MS_OPERATOR_SET_SCHEMA(
     QLinearSoftmax, 1,
     OpSchema()
@@ -1223,6 +1479,10 @@ ONNX_MS_OPERATOR_SET_SCHEMA(QOrderedLayerNormalization, 1,
                                 .Input(2, "scale", "Scale tensor, i.e., gamma vector.", "F")
                                 .Input(3, "B", "Bias tensor.", "F", OpSchema::Optional)
                                 .Input(4, "scale_Y", "scale of the quantized X", "S")
+                                .Input(5, "R",
+                                       "Optional residual with same shape as X. When given, (X + R) is normalized.",
+                                       "Q", OpSchema::Optional)
+                                .Input(6, "scale_R", "scale of the quantized R", "S", OpSchema::Optional)
                                 .Output(0, "Y", "Output data tensor.", "Q")
                                 .TypeConstraint("F", {"tensor(float16)", "tensor(float)"},
                                                 "Constrain input gamma and bias could be float16/float tensors. "
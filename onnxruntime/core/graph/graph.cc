@@ -894,6 +894,7 @@ void Node::AddAttributeProto(AttributeProto value) {
   if (graph_) {
     graph_->SetGraphResolveNeeded();
     graph_->SetGraphProtoSyncNeeded();
+    graph_->MarkNodeModified(*this);
   }
 }
 
@@ -941,6 +942,7 @@ void Node::AddAttribute(std::string attr_name, GraphProto value) {
 bool Node::ClearAttribute(const std::string& attr_name) {
   graph_->SetGraphResolveNeeded();
   graph_->SetGraphProtoSyncNeeded();
+  graph_->MarkNodeModified(*this);
   return attributes_.erase(attr_name) > 0;
 }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -1093,13 +1095,15 @@ Graph::Graph(const Model& owning_model,
              IOnnxRuntimeOpSchemaCollectionPtr schema_registry,
              const logging::Logger& logger,
              bool strict_shape_type_inference)
-    : Graph(owning_model, graph_proto, domain_to_version, ir_version, schema_registry, nullptr, nullptr, logger, strict_shape_type_inference) {}
+    : Graph(owning_model, graph_proto, domain_to_version, ir_version, schema_registry, nullptr, nullptr, logger,
+            strict_shape_type_inference, /* release_node_protos */ true) {}
 
 Graph::Graph(const Model& owning_model,
              GraphProto* graph_proto, const std::unordered_map<std::string, int>& domain_to_version, Version ir_version,
              IOnnxRuntimeOpSchemaCollectionPtr schema_registry, Graph* parent_graph, const Node* parent_node,
              const logging::Logger& logger,
-             bool strict_shape_type_inference)
+             bool strict_shape_type_inference,
+             bool release_node_protos)
     : owning_model_(owning_model),
       graph_proto_(graph_proto),
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -1253,8 +1257,21 @@ Graph::Graph(const Model& owning_model,
     }
   }
 
-  for (const auto& node_proto : graph_proto_->node()) {
-    AddNode(node_proto, name_to_type_map);
+  if (release_node_protos) {
+    // the attributes, e.g. large string or tensor attributes, would otherwise be held by both the NodeProtos
+    // and the nodes
+    for (auto& node_proto : *graph_proto_->mutable_node()) {
+      AddNode(std::move(node_proto), name_to_type_map);
+    }
+    if (graph_proto_->node_size() > 0) {
+      graph_proto_->clear_node();
+      node_protos_released_ = true;
+      GraphProtoSyncNeeded(true);
+    }
+  } else {
+    for (const auto& node_proto : graph_proto_->node()) {
+      AddNode(node_proto, name_to_type_map);
+    }
   }
 
   if (is_loaded_from_model_file_) {
@@ -1269,7 +1286,8 @@ Graph::Graph(Graph& parent_graph, const Node& parent_node, ONNX_NAMESPACE::Graph
             &parent_graph,
             &parent_node,
             parent_graph.logger_,
-            parent_graph.strict_shape_type_inference_) {
+            parent_graph.strict_shape_type_inference_,
+            /* release_node_protos */ false) {
 }
 
 Graph::Graph(const Model& owning_model,
@@ -1286,7 +1304,8 @@ Graph::Graph(const Model& owning_model,
             nullptr,
             nullptr,
             logger,
-            strict_shape_type_inference) {
+            strict_shape_type_inference,
+            /* release_node_protos */ false) {
 }
 
 void Graph::InitializeStateFromModelFileGraphProto() {
@@ -1424,6 +1443,27 @@ Status Graph::VerifyNoDuplicateName() {
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
+bool Graph::IsOpTypeModifiedSince(std::string_view op_type, uint64_t epoch) const {
+  const Graph& top_level_graph = TopLevelGraph();
+  if (top_level_graph.untracked_modification_epoch_ > epoch) {
+    return true;
+  }
+
+  // std::string key as heterogeneous lookup isn't available if abseil is disabled
+  auto entry = top_level_graph.op_type_modification_epochs_.find(std::string{op_type});
+  return entry != top_level_graph.op_type_modification_epochs_.end() && entry->second > epoch;
+}
+
+void Graph::MarkNodeModified(const Node& node) {
+  Graph& top_level_graph = TopLevelGraph();
+  top_level_graph.op_type_modification_epochs_[node.OpType()] = ++top_level_graph.modification_epoch_;
+}
+
+void Graph::MarkModified() noexcept {
+  Graph& top_level_graph = TopLevelGraph();
+  top_level_graph.untracked_modification_epoch_ = ++top_level_graph.modification_epoch_;
+}
+
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 void Graph::AddEdge(NodeIndex src_node_index, NodeIndex dst_node_index, int src_arg_slot, int dst_arg_slot) {
   if (nodes_.size() <= src_node_index || src_arg_slot < 0 || nodes_.size() <= dst_node_index || dst_arg_slot < 0 ||
@@ -1466,8 +1506,15 @@ void Graph::AddEdge(NodeIndex src_node_index, NodeIndex dst_node_index, int src_
     *dst_arg_pointer = src_arg;
   }
 
-  nodes_[src_node_index]->MutableRelationships().output_edges.insert(Node::EdgeEnd(*nodes_[dst_node_index], src_arg_slot, dst_arg_slot));
+  const bool inserted =
+      nodes_[src_node_index]->MutableRelationships().output_edges.insert(Node::EdgeEnd(*nodes_[dst_node_index], src_arg_slot, dst_arg_slot)).second;
   nodes_[dst_node_index]->MutableRelationships().input_edges.insert(Node::EdgeEnd(*nodes_[src_node_index], src_arg_slot, dst_arg_slot));
+
+  // Resolve adds the existing edges again so only new edges are modifications
+  if (inserted) {
+    MarkNodeModified(*nodes_[src_node_index]);
+    MarkNodeModified(*nodes_[dst_node_index]);
+  }
 }
 
 void Graph::RemoveEdge(NodeIndex src_node_index, NodeIndex dst_node_index, int src_arg_slot, int dst_arg_slot) {
@@ -1508,6 +1555,8 @@ void Graph::RemoveEdge(NodeIndex src_node_index, NodeIndex dst_node_index, int s
 
   nodes_[dst_node_index]->MutableRelationships().input_edges.erase(Node::EdgeEnd(*nodes_[src_node_index], src_arg_slot, dst_arg_slot));
   nodes_[src_node_index]->MutableRelationships().output_edges.erase(Node::EdgeEnd(*nodes_[dst_node_index], src_arg_slot, dst_arg_slot));
+  MarkNodeModified(*nodes_[src_node_index]);
+  MarkNodeModified(*nodes_[dst_node_index]);
 }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
@@ -2172,7 +2221,7 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
     // Number of inputs corresponding to the i-th argument.
     const int arg_count = node.InputArgCount()[i];
     // The i-th formal parameter definition.
-    auto op_formal_parameter = op.inputs()[i];
+    const auto& op_formal_parameter = op.inputs()[i];
 
     // Check all <arg_count> actual parameters (corresponding to the k-th input)
     // match the formal parameter definition (i-th argument).
@@ -2277,7 +2326,7 @@ Status Graph::InferAndVerifyTypeMatch(Node& node, const OpSchema& op, const Reso
 
     const int num_formal_params = gsl::narrow_cast<int>(op.outputs().size());
     auto operand_index = std::min(i, num_formal_params - 1);
-    auto op_formal_parameter = op.outputs().at(operand_index);
+    const auto& op_formal_parameter = op.outputs().at(operand_index);
 
     const TypeProto& onnx_inferred_type = onnx_inferred_types[i];
     DataType existing_type = output_def->Type();
@@ -2481,13 +2530,15 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
   for (auto node_index : nodes_in_topological_order_) {
     // Node verification.
     auto& node = *GetNode(node_index);
-
-    NodeProto node_proto;
-    node.ToProto(node_proto);
     const auto& node_name = node.Name();
 
     if (!node.Op()) {
       {
+        // the NodeProto, which copies all the attributes and any subgraphs, is only needed by the ONNX checker.
+        // nodes that already have their schema were checked by a previous Resolve so skip creating it.
+        NodeProto node_proto;
+        node.ToProto(node_proto);
+
         auto status = Status::OK();
         ORT_TRY {
           checker::check_node(node_proto, ctx, lsc);
@@ -2562,8 +2613,8 @@ Status Graph::VerifyNodeAndOpMatch(const ResolveOptions& options) {
     NO_CHANGE_ON_SYNC_FLAG(ORT_RETURN_IF_ERROR(InferAndVerifyTypeMatch(node, *p_op, options)));
 
     // Accumulate output names of the iterated Node
-    for (auto& output_name : node_proto.output()) {
-      lsc.output_names.insert(output_name);
+    for (const auto* output_def : node.OutputDefs()) {
+      lsc.output_names.insert(output_def->Name());
     }
   }
 
@@ -2719,8 +2770,8 @@ Status Graph::Resolve(const ResolveOptions& options) {
             graph.GraphResolveNeeded(false);
 
             // if we are resolving immediately after loading from a GraphProto, we don't need to
-            // do a proto sync
-            if (options.no_proto_sync_required) {
+            // do a proto sync unless its NodeProtos were released
+            if (options.no_proto_sync_required && !graph.node_protos_released_) {
                 graph.GraphProtoSyncNeeded(false);
             }
 
@@ -2770,6 +2821,7 @@ void Graph::AddInitializedTensor(const TensorProto& tensor) {
   *(tensor_added) = tensor;
   name_to_initial_tensor_[tensor.name()] = tensor_added;
   SetGraphResolveNeeded();
+  MarkModified();
   if (!is_loaded_from_model_file_ && GetNodeArg(tensor.name()) == nullptr) {
     // make sure there is a NodeArg for the initializer as SetGraphInputsOutputs may add it to the graph inputs.
     // the shape will be set to the correct value in TypeCheckInputsAndInitializers as we don't yet know whether there
@@ -2829,6 +2881,7 @@ void Graph::RemoveInitializedTensor(const std::string& tensor_name) {
     sparse_tensor_names_.erase(tensor_name);
 #endif
     SetGraphResolveNeeded();
+    MarkModified();
   } else {
 #if !defined(DISABLE_SPARSE_TENSORS)
     ORT_ENFORCE(sparse_tensor_names_.count(tensor_name) == 0, "sparse_tensor_names_ not in sync with name_to_initial_tensor_");
@@ -2883,6 +2936,7 @@ Status Graph::ReplaceInitializedTensorImpl(ONNX_NAMESPACE::TensorProto new_initi
               "graph_proto_ is not in sync with name_to_initial_tensor_");
 
   **existing_entry = std::move(new_initializer);
+  MarkModified();
 
   return Status::OK();
 }
@@ -3016,6 +3070,11 @@ Node& Graph::AddNode(const Node& other) {
 
 Node& Graph::AddNode(const NodeProto& node_proto,
                      const ArgNameToTypeMap& name_to_type_map) {
+  return AddNode(NodeProto(node_proto), name_to_type_map);
+}
+
+Node& Graph::AddNode(NodeProto&& node_proto,
+                     const ArgNameToTypeMap& name_to_type_map) {
   auto input_defs = CreateNodeArgs(node_proto.input(), name_to_type_map);
   auto output_defs = CreateNodeArgs(node_proto.output(), name_to_type_map);
 
@@ -3024,8 +3083,9 @@ Node& Graph::AddNode(const NodeProto& node_proto,
   attributes.reserve(num_attributes);
 
   for (int i = 0; i < num_attributes; ++i) {
-    auto& attr = node_proto.attribute(i);
-    attributes[attr.name()] = attr;
+    auto& attr = *node_proto.mutable_attribute(i);
+    const std::string attr_name = attr.name();
+    attributes[attr_name] = std::move(attr);
   }
 
   return AddNode(node_proto.name(),
@@ -3225,6 +3285,7 @@ Node& Graph::AddNode(const std::string& name,
   if (0 != op_type.compare(kNoOp)) {
     GraphProtoSyncNeeded(true);
   }
+  MarkNodeModified(*node);
 
   return *node;
 }
@@ -3795,6 +3856,7 @@ bool Graph::ReleaseNode(NodeIndex index) {
 
   // index is valid, but the entry may already be empty
   if (nodes_[index] != nullptr) {
+    MarkNodeModified(*nodes_[index]);
     nodes_[index] = nullptr;
     --num_of_nodes_;
     GraphProtoSyncNeeded(true);
@@ -4096,6 +4158,7 @@ void Graph::SetInputs(gsl::span<const NodeArg* const> inputs) {
   graph_inputs_manually_set_ = true;
   GraphProtoSyncNeeded(true);
   GraphResolveNeeded(true);
+  MarkModified();
 }
 
 void Graph::SetOutputs(gsl::span<const NodeArg* const> outputs) {
@@ -4105,6 +4168,7 @@ void Graph::SetOutputs(gsl::span<const NodeArg* const> outputs) {
   graph_outputs_manually_set_ = true;
   GraphProtoSyncNeeded(true);
   GraphResolveNeeded(true);
+  MarkModified();
 }
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
@@ -4113,6 +4177,7 @@ void Graph::SetOutputs(gsl::span<const NodeArg* const> outputs) {
 void Graph::SetNodeArgType(NodeArg& arg, const ONNX_NAMESPACE::TypeProto& type_proto) {
   arg.SetType(type_proto);
   GraphResolveNeeded(true);
+  MarkModified();
 }
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
 
@@ -127,6 +127,44 @@ MlasPlatformU8S8Overflow(
     void
     );
 
+/**
+ * @brief Instruction set levels of the x86/x64 kernels, in increasing order
+*/
+enum MLAS_ISA {
+    MlasIsaSse2,
+    MlasIsaAvx,
+    MlasIsaAvx2,
+    MlasIsaAvxVnni,
+    MlasIsaAvx512F,
+    MlasIsaAvx512Core,
+    MlasIsaAvx512Vnni,
+    MlasIsaAmx,
+    MlasIsaNative,
+};
+
+/**
+ * @brief Select the kernels again, using instructions up to the level Isa at most,
+ *        so that the kernels of the lower levels can be tested and benchmarked on
+ *        the same processor. MlasIsaNative restores the default selection.
+ *        Not thread safe, no other MLAS routine may run during the call.
+ *
+ * @param Isa   highest instruction set level to use
+*/
+void
+MLASCALL
+MlasSetMaximumIsa(
+    MLAS_ISA Isa
+    );
+
+/**
+ * @brief Return the highest instruction set level of the selected kernels
+*/
+MLAS_ISA
+MLASCALL
+MlasGetIsa(
+    void
+    );
+
 #endif
 
 
@@ -142,6 +180,8 @@ enum MLAS_ACTIVATION_KIND {
     MlasLogisticActivation,
     MlasClipActivation,
     MlasHardSigmoidActivation,
+    MlasGeluActivation,
+    MlasFastGeluActivation,
 };
 
 struct MLAS_ACTIVATION {
@@ -192,6 +232,7 @@ struct MLAS_SGEMM_DATA_PARAMS {
     float alpha = 1.0f;       /**< Supplies the scalar alpha multiplier (see SGEMM definition) */
     float beta = 0.0f;        /**< Supplies the scalar beta multiplier (see SGEMM definition) */
     bool BIsPacked = false;   /**< Whether B is pre-packed */
+    const MLAS_ACTIVATION* Activation = nullptr; /**< Optional activation applied to matrix C as it is computed */
 };
 
 /**
@@ -472,6 +513,417 @@ MlasGemm(
     MlasGemmBatch(TransA, TransB, M, N, K, &Data, 1, ThreadPool);
 }
 
+/**
+ * @brief Supply matrices data information to half precision (fp16) and
+ *        bfloat16 gemm functions. Elements are supplied as their raw 16-bit
+ *        encodings.
+ */
+struct MLAS_HALF_GEMM_DATA_PARAMS {
+    const uint16_t* A = nullptr; /**< Supplies the address of matrix A */
+    size_t lda = 0;              /**< Supplies the first dimension of matrix A. */
+    const uint16_t* B = nullptr; /**< Supplies the address of matrix B */
+    size_t ldb = 0;              /**< Supplies the first dimension of matrix B. */
+    uint16_t* C = nullptr;       /**< Supplies the address of matrix C */
+    size_t ldc = 0;              /**< Supplies the first dimension of matrix C. */
+};
+
+/**
+ * @brief  Batched half precision matrix/matrix multiply operation, C := A * B.
+ *         The inputs and output are fp16, the products are accumulated using
+ *         single precision.
+ *
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param Data       A array of matrices data parameters
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasHalfGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief  Batched bfloat16 matrix/matrix multiply operation, C := A * B.
+ *         The inputs and output are bfloat16, the products are accumulated
+ *         using single precision.
+ *
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param Data       A array of matrices data parameters
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasBf16GemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Blockwise 4-bit quantized weight matrix/matrix multiply routines.
+//
+// Matrix B (K x N) is quantized along the K dimension in blocks of BlkLen
+// elements, each with its own scale and zero point. The quantized source is
+// stored by column:
+//
+//   QuantBData      [N][BlockCountK][BlkLen / 2] bytes, element 2i of a
+//                   block in the low nibble of byte i and element 2i+1 in the
+//                   high nibble.
+//   QuantBScale     [N][BlockCountK] floats.
+//   QuantBZeroPoint [N][(BlockCountK + 1) / 2] bytes, the zero point of
+//                   block 2i in the low nibble of byte i and block 2i+1 in the
+//                   high nibble. If not supplied, the zero point is 8.
+//
+// where BlockCountK = (K + BlkLen - 1) / BlkLen.
+//
+
+/**
+ * @brief  Returns true if the block length is supported by the blockwise
+ *         4-bit quantized GEMM routines.
+ *
+ * @param BlkLen    Supplies the number of quantized elements per block.
+ */
+bool
+MLASCALL
+MlasIsQ4GemmBlkLenSupported(
+    size_t BlkLen
+    );
+
+/**
+ * @brief  Returns the size in bytes of the packed buffer required by
+ *         MlasQ4GemmPackB, or zero if the block length is not supported.
+ *
+ * @param N         Supplies the number of columns of matrix B.
+ * @param K         Supplies the number of rows of matrix B.
+ * @param BlkLen    Supplies the number of quantized elements per block.
+ */
+size_t
+MLASCALL
+MlasQ4GemmPackBSize(
+    size_t N,
+    size_t K,
+    size_t BlkLen
+    );
+
+/**
+ * @brief  Packs the blockwise 4-bit quantized matrix B into the layout used
+ *         by MlasQ4GemmBatch.
+ *
+ * @param PackedBuf         Supplies the output buffer, sized by
+ *                          MlasQ4GemmPackBSize.
+ * @param QuantBData        Supplies the quantized elements of matrix B.
+ * @param QuantBScale       Supplies the per block scales of matrix B.
+ * @param QuantBZeroPoint   Supplies the per block zero points of matrix B,
+ *                          else nullptr for symmetric quantization.
+ * @param N                 Supplies the number of columns of matrix B.
+ * @param K                 Supplies the number of rows of matrix B.
+ * @param BlkLen            Supplies the number of quantized elements per block.
+ */
+void
+MLASCALL
+MlasQ4GemmPackB(
+    void* PackedBuf,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    size_t N,
+    size_t K,
+    size_t BlkLen
+    );
+
+/**
+ * @brief Supply matrices data information to the blockwise 4-bit quantized
+ *        gemm functions.
+ */
+struct MLAS_Q4_GEMM_DATA_PARAMS {
+    const float* A = nullptr;       /**< Supplies the address of matrix A */
+    size_t lda = 0;                 /**< Supplies the first dimension of matrix A. */
+    const void* PackedB = nullptr;  /**< Supplies the address of packed matrix B */
+    float* C = nullptr;             /**< Supplies the address of matrix C */
+    size_t ldc = 0;                 /**< Supplies the first dimension of matrix C. */
+    const float* Bias = nullptr;    /**< Supplies the optional bias vector of N elements */
+};
+
+/**
+ * @brief  Batched single precision matrix/matrix multiply operation with a
+ *         blockwise 4-bit quantized matrix B, C := A * B + Bias. The elements
+ *         of matrix B are dequantized in registers.
+ *
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param BlkLen     Supplies the number of quantized elements per block.
+ * @param Data       A array of matrices data parameters
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasQ4GemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlkLen,
+    const MLAS_Q4_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+//
+// Block sparse matrix/matrix multiply routines.
+//
+// Matrix B (K x N) is split into blocks of one row by
+// MLAS_BLOCK_SPARSE_GEMM_BLOCK_N columns. The packed format keeps only the
+// blocks holding a nonzero element: for each panel of
+// MLAS_BLOCK_SPARSE_GEMM_BLOCK_N columns, the row indices of the nonzero blocks
+// and their elements. This is the block CSR format of the transpose of matrix
+// B, the usual [N x K] layout of a weight matrix. Blocks of the last panel
+// are padded with zeros.
+//
+
+#define MLAS_BLOCK_SPARSE_GEMM_BLOCK_N 16
+
+/**
+ * @brief  Returns the number of blocks of a single precision matrix B that
+ *         hold an element with a magnitude above the threshold. The ratio of
+ *         this count to K * ((N + MLAS_BLOCK_SPARSE_GEMM_BLOCK_N - 1) /
+ *         MLAS_BLOCK_SPARSE_GEMM_BLOCK_N) is the block density of matrix B.
+ *
+ * @param TransB    Supplies the transpose operation for matrix B.
+ * @param N         Supplies the number of columns of matrix B.
+ * @param K         Supplies the number of rows of matrix B.
+ * @param B         Supplies the address of matrix B.
+ * @param ldb       Supplies the first dimension of matrix B.
+ * @param Threshold Supplies the magnitude at or below which an element is
+ *                  treated as zero.
+ */
+size_t
+MLASCALL
+MlasBlockSparseSgemmCountBlocks(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    float Threshold
+    );
+
+/**
+ * @brief  Returns the size in bytes of the packed buffer required by
+ *         MlasBlockSparseSgemmPackB, or zero if the matrix is too large for
+ *         the packed format.
+ *
+ * @param N             Supplies the number of columns of matrix B.
+ * @param K             Supplies the number of rows of matrix B.
+ * @param BlockCount    Supplies the number of nonzero blocks, as returned by
+ *                      MlasBlockSparseSgemmCountBlocks.
+ */
+size_t
+MLASCALL
+MlasBlockSparseSgemmPackBSize(
+    size_t N,
+    size_t K,
+    size_t BlockCount
+    );
+
+/**
+ * @brief  Packs the nonzero blocks of a single precision matrix B into the
+ *         layout used by MlasBlockSparseSgemmBatch. Blocks with all elements
+ *         at or below the threshold in magnitude are dropped, the elements of
+ *         the other blocks are kept unchanged.
+ *
+ * @param TransB    Supplies the transpose operation for matrix B.
+ * @param N         Supplies the number of columns of matrix B.
+ * @param K         Supplies the number of rows of matrix B.
+ * @param B         Supplies the address of matrix B.
+ * @param ldb       Supplies the first dimension of matrix B.
+ * @param Threshold Supplies the magnitude at or below which an element is
+ *                  treated as zero.
+ * @param PackedB   Supplies the output buffer, sized by
+ *                  MlasBlockSparseSgemmPackBSize.
+ */
+void
+MLASCALL
+MlasBlockSparseSgemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    float Threshold,
+    void* PackedB
+    );
+
+/**
+ * @brief Supply matrices data information to the block sparse single
+ *        precision gemm functions.
+ */
+struct MLAS_BLOCK_SPARSE_SGEMM_DATA_PARAMS {
+    const float* A = nullptr;       /**< Supplies the address of matrix A */
+    size_t lda = 0;                 /**< Supplies the first dimension of matrix A. */
+    const void* PackedB = nullptr;  /**< Supplies the address of packed matrix B */
+    float* C = nullptr;             /**< Supplies the address of matrix C */
+    size_t ldc = 0;                 /**< Supplies the first dimension of matrix C. */
+    float alpha = 1.0f;             /**< Supplies the scalar multiplier */
+};
+
+/**
+ * @brief  Batched single precision matrix/matrix multiply operation with a
+ *         block sparse matrix B, C := alpha * A * B.
+ *
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param Data       A array of matrices data parameters
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasBlockSparseSgemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_BLOCK_SPARSE_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+/**
+ * @brief  Returns the number of blocks of a quantized matrix B that hold an
+ *         element different from its zero point.
+ *
+ * @param N                     Supplies the number of columns of matrix B.
+ * @param K                     Supplies the number of rows of matrix B.
+ * @param B                     Supplies the address of matrix B.
+ * @param ldb                   Supplies the first dimension of matrix B.
+ * @param BIsSigned             Supplies true if matrix B is signed data.
+ * @param ZeroPointB            Supplies the zero point of matrix B, or a
+ *                              vector of N zero points.
+ * @param PerColumnZeroPoints   Supplies true if ZeroPointB is a vector.
+ */
+size_t
+MLASCALL
+MlasBlockSparseQgemmCountBlocks(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    bool BIsSigned,
+    const uint8_t* ZeroPointB,
+    bool PerColumnZeroPoints
+    );
+
+/**
+ * @brief  Returns the size in bytes of the packed buffer required by
+ *         MlasBlockSparseQgemmPackB, or zero if the matrix is too large for
+ *         the packed format.
+ *
+ * @param N             Supplies the number of columns of matrix B.
+ * @param K             Supplies the number of rows of matrix B.
+ * @param BlockCount    Supplies the number of nonzero blocks, as returned by
+ *                      MlasBlockSparseQgemmCountBlocks.
+ */
+size_t
+MLASCALL
+MlasBlockSparseQgemmPackBSize(
+    size_t N,
+    size_t K,
+    size_t BlockCount
+    );
+
+/**
+ * @brief  Packs the blocks of a quantized matrix B that hold an element
+ *         different from its zero point into the layout used by
+ *         MlasBlockSparseQgemmBatch. The zero points are subtracted from the
+ *         packed elements.
+ *
+ * @param N                     Supplies the number of columns of matrix B.
+ * @param K                     Supplies the number of rows of matrix B.
+ * @param B                     Supplies the address of matrix B.
+ * @param ldb                   Supplies the first dimension of matrix B.
+ * @param BIsSigned             Supplies true if matrix B is signed data.
+ * @param ZeroPointB            Supplies the zero point of matrix B, or a
+ *                              vector of N zero points.
+ * @param PerColumnZeroPoints   Supplies true if ZeroPointB is a vector.
+ * @param PackedB               Supplies the output buffer, sized by
+ *                              MlasBlockSparseQgemmPackBSize.
+ */
+void
+MLASCALL
+MlasBlockSparseQgemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    bool BIsSigned,
+    const uint8_t* ZeroPointB,
+    bool PerColumnZeroPoints,
+    void* PackedB
+    );
+
+/**
+ * @brief Supply matrices data information to the block sparse quantized gemm
+ *        functions.
+ */
+struct MLAS_BLOCK_SPARSE_QGEMM_DATA_PARAMS {
+    const uint8_t* A = nullptr;     /**< Supplies the address of matrix A */
+    size_t lda = 0;                 /**< Supplies the first dimension of matrix A. */
+    uint8_t ZeroPointA = 0;         /**< Supplies the zero point of matrix A */
+    const void* PackedB = nullptr;  /**< Supplies the address of packed matrix B */
+    int32_t* C = nullptr;           /**< Supplies the address of matrix C */
+    size_t ldc = 0;                 /**< Supplies the first dimension of matrix C. */
+};
+
+/**
+ * @brief  Batched quantized matrix/matrix multiply operation with a block
+ *         sparse matrix B, C := (A - ZeroPointA) * (B - ZeroPointB). The
+ *         result is exact, as for MlasGemmBatch.
+ *
+ * @param M          Supplies the number of rows of matrix A and matrix C.
+ * @param N          Supplies the number of columns of matrix B and matrix C.
+ * @param K          Supplies the number of columns of matrix A and the number
+                     of rows of matrix B.
+ * @param AIsSigned  Supplies true if matrix A is signed data.
+ * @param Data       A array of matrices data parameters
+ * @param BatchSize  Supplies number of multiplications in this batch
+ * @param ThreadPool Supplies the thread pool object to use, else nullptr if the
+                     base library threading support should be used.
+ */
+void
+MLASCALL
+MlasBlockSparseQgemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    bool AIsSigned,
+    const MLAS_BLOCK_SPARSE_QGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 enum class MLAS_QUANTIZATION_GRANULARITY {
     PerMatrix,
     PerColumn,
@@ -734,6 +1186,7 @@ enum MLAS_CONV_ALGORITHM {
     MlasConvAlgorithmGemmDirect,
     MlasConvAlgorithmExpandThenGemm,
     MlasConvAlgorithmExpandThenGemmSegmented,
+    MlasConvAlgorithmWinograd,
 #if defined(MLAS_TARGET_WASM_SCALAR)
     MlasConvAlgorithmDepthwise,
 #endif
@@ -766,6 +1219,11 @@ struct MLAS_CONV_PARAMETERS {
         struct {
             size_t ThreadStrideN;
         } ExpandThenGemmSegmented;
+        struct {
+            size_t TileSize;
+            size_t TileBlockSize;
+            const float* PackedFilter;
+        } Winograd;
     } u;
 };
 
@@ -799,6 +1257,50 @@ MlasConv(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Winograd convolution routines for 3x3 filters with unit stride and
+// dilation. The filter is transformed once by MlasConvWinogradPackFilter,
+// then MlasConvPrepareWinograd switches a prepared convolution to the
+// Winograd algorithm when its shape is supported.
+//
+
+size_t
+MLASCALL
+MlasConvWinogradTileSize(
+    size_t InputChannels,
+    size_t FilterCount
+    );
+
+size_t
+MLASCALL
+MlasConvWinogradPackedFilterSize(
+    size_t TileSize,
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    );
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t TileSize,
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    );
+
+bool
+MLASCALL
+MlasConvPrepareWinograd(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t TileSize,
+    const float* PackedFilter,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasConvDepthwise(
@@ -814,6 +1316,26 @@ MlasConvDepthwise(
     size_t KernelSize
     );
 
+//
+// Single precision floating point depthwise convolution for the channels last
+// (NHWC) layout. The input is an indirection buffer of OutputCount by
+// KernelSize pointers to input pixels and the filter has shape
+// [KernelSize][Channels].
+//
+
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    const MLAS_ACTIVATION* Activation
+    );
+
 //
 // Symmetric quantized integer convolution routines.
 //
@@ -894,6 +1416,15 @@ MlasQgemmGetKernelOutputCnt(
     );
 
 
+//
+// Parameters of MlasConvSym. For a grouped convolution (GroupCount > 1), the
+// input and output channels are the ones of a single group, the filter is
+// packed by MlasConvSymPackW with the same GroupCount, the bias and scale
+// cover the output channels of all the groups, and InputIndirection holds
+// GroupCount indirection buffers of OutputCount * KernelSize entries, one for
+// each group. A GroupCount of zero is the same as one.
+//
+
 struct MLAS_CONV_SYM_PARAMS {
     const void* InputDirect;
     const void* const* InputIndirection;
@@ -908,6 +1439,7 @@ struct MLAS_CONV_SYM_PARAMS {
     bool PerChannelScale;
     int32_t OutputZeroPoint;
     bool InputIsSigned;
+    size_t GroupCount;
 };
 
 void
@@ -996,6 +1528,56 @@ MlasComputeSoftmax(
     MLAS_THREADPOOL* ThreadPool
     );
 
+//
+// Layer normalization routines.
+//
+// Each row of D elements is normalized as
+//
+//     X = Input + Skip + Bias
+//     Output = (X - Mean(X)) * InvStdDev(X) * Scale + Shift
+//
+// where Skip, Bias and Shift are optional. The simplified form (RMS
+// normalization) uses the root mean square of X instead of the standard
+// deviation and does not subtract the mean.
+//
+
+struct MLAS_LAYERNORM_PARAMETERS {
+    const float* Skip;          // optional, N x D elements added to the input
+    const float* Bias;          // optional, D elements added to the input
+    const float* Scale;         // D elements
+    const float* Shift;         // optional, D elements
+    float* SkipOutput;          // optional, receives the N x D sums Input + Skip
+    float* Mean;                // optional, receives the N row means
+    float* InvStdDev;           // optional, receives the N row inverse standard deviations
+    float Epsilon;
+    bool Simplified;
+};
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    const MLAS_LAYERNORM_PARAMETERS* Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template<typename OutputType>
+void
+MLASCALL
+MlasLayerNormalizationQuantizeLinear(
+    const float* Input,
+    OutputType* Output,
+    size_t N,
+    size_t D,
+    const MLAS_LAYERNORM_PARAMETERS* Parameters,
+    float OutputScale,
+    OutputType OutputZeroPoint,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 void
 MLASCALL
 MlasComputeTanh(
@@ -1005,10 +1587,53 @@ MlasComputeTanh(
     );
 
 //
-// Half-precision floating-point routines.
+// Reduction routines.
+//
+// MlasReduceMaximumFinite ignores infinities and NaNs and produces the lowest
+// float value when no element is finite. MlasReduceSumExp sums exp(x - Bias)
+// with one bias value per output element.
+//
+
+enum MLAS_REDUCE_KIND {
+    MlasReduceSum,
+    MlasReduceSumSquare,
+    MlasReduceMaximum,
+    MlasReduceMinimum,
+    MlasReduceMaximumFinite,
+    MlasReduceSumExp,
+};
+
+void
+MLASCALL
+MlasReduceRowsF32(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias,
+    float* Output,
+    bool Accumulate
+    );
+
+void
+MLASCALL
+MlasReduceColumnsF32(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias,
+    float* Output,
+    bool Accumulate
+    );
+
+//
+// Half-precision and bfloat16 floating-point conversion routines. Narrowing
+// conversions round to nearest even.
 //
 
-extern "C"
 void
 MLASCALL
 MlasConvertHalfToFloatBuffer(
@@ -1017,6 +1642,30 @@ MlasConvertHalfToFloatBuffer(
     size_t Count
     );
 
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
 //
 // Transpose routines.
 //
@@ -1177,6 +1826,105 @@ MlasNchwcUpsampleLinear(
     float* Output
     );
 
+//
+// Separable resize routines.
+//
+// An image is resized by first resizing each input row horizontally, where
+// output pixel x is the weighted sum of the input pixels Indices[x * TapCount
+// + t], and then blending TapCount horizontally resized rows into each output
+// row. Pixels are Channels interleaved elements (NHWC) or a single element
+// (NCHW). The quantized routines accumulate fixed point weights in int32 and
+// divide the vertical sum by (1 << Shift), rounding toward zero.
+//
+
+void
+MLASCALL
+MlasResizeHorizontal(
+    const float* Input,
+    size_t Channels,
+    const int32_t* Indices,
+    const float* Weights,
+    size_t TapCount,
+    size_t CountX,
+    float* Output
+    );
+
+void
+MLASCALL
+MlasResizeHorizontal(
+    const uint8_t* Input,
+    size_t Channels,
+    const int32_t* Indices,
+    const int32_t* Weights,
+    size_t TapCount,
+    size_t CountX,
+    int32_t* Output
+    );
+
+void
+MLASCALL
+MlasResizeHorizontal(
+    const int8_t* Input,
+    size_t Channels,
+    const int32_t* Indices,
+    const int32_t* Weights,
+    size_t TapCount,
+    size_t CountX,
+    int32_t* Output
+    );
+
+void
+MLASCALL
+MlasResizeVertical(
+    const float* const* Rows,
+    const float* Weights,
+    size_t TapCount,
+    size_t N,
+    float* Output
+    );
+
+void
+MLASCALL
+MlasResizeVertical(
+    const int32_t* const* Rows,
+    const int32_t* Weights,
+    size_t TapCount,
+    size_t N,
+    int32_t Shift,
+    uint8_t* Output
+    );
+
+void
+MLASCALL
+MlasResizeVertical(
+    const int32_t* const* Rows,
+    const int32_t* Weights,
+    size_t TapCount,
+    size_t N,
+    int32_t Shift,
+    int8_t* Output
+    );
+
+//
+// Top-K selection routines.
+//
+// MlasTopK selects the K largest or smallest of N contiguous elements, ranking
+// equal values by ascending index as the TopK operator does.
+//
+
+void
+MLASCALL
+MlasTopK(
+    const float* Input,
+    size_t N,
+    size_t K,
+    bool Largest,
+    bool Sorted,
+    float* Values,
+    int64_t* Indices,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
 //
 // Linear quantization routines.
 //
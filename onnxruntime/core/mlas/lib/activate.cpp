@@ -404,6 +404,115 @@ Return Value:
     }
 }
 
+template<MLAS_ACTIVATION_KIND ActivationKind>
+void
+MlasGeluActivationKernel(
+    float* Buffer,
+    size_t M,
+    size_t N,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine applies the GELU activation to the output matrix. The exact
+    form computes 0.5 * x * (1 + erf(x / sqrt(2))) and the fast form computes
+    0.5 * x * (1 + tanh(sqrt(2 / pi) * (x + 0.044715 * x^3))).
+
+    Each row is processed in blocks that stay in the cache: the argument of
+    the transcendental function is computed to a local buffer, the vectorized
+    erf or tanh routine is applied to the local buffer, and the result is
+    combined with the input.
+
+Arguments:
+
+    Buffer - Supplies the output matrix.
+
+    M - Supplies the number of rows in the output matrix.
+
+    N - Supplies the number of columns of the output matrix.
+
+    ldc - Supplies the number of elements per row of the output matrix.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = 256;
+    constexpr float SqrtHalf = 0.70710678118654752440f;
+    constexpr float FastGeluB = 0.7978845608028654f;
+    constexpr float FastGeluC = 0.035677408136300125f;
+
+    MLAS_DECLSPEC_ALIGN(float Temporary[BlockSize], 16 * sizeof(float));
+
+    const MLAS_FLOAT32X4 SqrtHalfBroadcast = MlasBroadcastFloat32x4(SqrtHalf);
+    const MLAS_FLOAT32X4 FastGeluBBroadcast = MlasBroadcastFloat32x4(FastGeluB);
+    const MLAS_FLOAT32X4 FastGeluCBroadcast = MlasBroadcastFloat32x4(FastGeluC);
+    const MLAS_FLOAT32X4 HalfBroadcast = MlasBroadcastFloat32x4(0.5f);
+    const MLAS_FLOAT32X4 OneBroadcast = MlasBroadcastFloat32x4(1.0f);
+
+    while (M-- > 0) {
+
+        for (size_t n = 0; n < N; n += BlockSize) {
+
+            float* buffer = Buffer + n;
+            const size_t CountN = std::min(N - n, BlockSize);
+            size_t i = 0;
+
+            for (; i + 4 <= CountN; i += 4) {
+
+                MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(&buffer[i]);
+
+                if (ActivationKind == MlasGeluActivation) {
+                    Vector = MlasMultiplyFloat32x4(Vector, SqrtHalfBroadcast);
+                } else {
+                    MLAS_FLOAT32X4 Scale = MlasMultiplyFloat32x4(Vector, Vector);
+                    Scale = MlasMultiplyAddFloat32x4(Scale, FastGeluCBroadcast, FastGeluBBroadcast);
+                    Vector = MlasMultiplyFloat32x4(Vector, Scale);
+                }
+
+                MlasStoreAlignedFloat32x4(&Temporary[i], Vector);
+            }
+
+            for (; i < CountN; i++) {
+
+                const float Value = buffer[i];
+
+                if (ActivationKind == MlasGeluActivation) {
+                    Temporary[i] = Value * SqrtHalf;
+                } else {
+                    Temporary[i] = Value * (FastGeluB + FastGeluC * Value * Value);
+                }
+            }
+
+            if (ActivationKind == MlasGeluActivation) {
+                MlasComputeErf(Temporary, Temporary, CountN);
+            } else {
+                MlasComputeTanh(Temporary, Temporary, CountN);
+            }
+
+            for (i = 0; i + 4 <= CountN; i += 4) {
+
+                MLAS_FLOAT32X4 Vector = MlasLoadFloat32x4(&buffer[i]);
+                MLAS_FLOAT32X4 Scale = MlasAddFloat32x4(MlasLoadFloat32x4(&Temporary[i]), OneBroadcast);
+
+                Vector = MlasMultiplyFloat32x4(MlasMultiplyFloat32x4(Vector, HalfBroadcast), Scale);
+
+                MlasStoreFloat32x4(&buffer[i], Vector);
+            }
+
+            for (; i < CountN; i++) {
+                buffer[i] = 0.5f * buffer[i] * (1.0f + Temporary[i]);
+            }
+        }
+
+        Buffer += ldc;
+    }
+}
+
 void
 MLASCALL
 MlasActivation(
@@ -509,5 +618,25 @@ Return Value:
             MlasActivationKernel<MlasHardSigmoidActivation>(Activation, Buffer, Bias, M, N, ldc);
             break;
         }
+
+        case MlasGeluActivation:
+        {
+            if (Bias != nullptr) {
+                MlasActivationKernel<MlasIdentityActivation, true>(Activation, Buffer, Bias, M, N, ldc);
+            }
+
+            MlasGeluActivationKernel<MlasGeluActivation>(Buffer, M, N, ldc);
+            break;
+        }
+
+        case MlasFastGeluActivation:
+        {
+            if (Bias != nullptr) {
+                MlasActivationKernel<MlasIdentityActivation, true>(Activation, Buffer, Bias, M, N, ldc);
+            }
+
+            MlasGeluActivationKernel<MlasFastGeluActivation>(Buffer, M, N, ldc);
+            break;
+        }
     }
 }
@@ -0,0 +1,305 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast.cpp
+
+Abstract:
+
+    This module implements routines to convert buffers between single
+    precision and the 16-bit floating point formats.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasCastF16ToF32Kernel(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of half precision elements to single
+    precision.
+
+Arguments:
+
+    Source - Supplies the half precision input buffer.
+
+    Destination - Supplies the single precision output buffer.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_ARM64) && !defined(_WIN32)
+
+    while (Count >= 8) {
+
+        float16x8_t Vector = vreinterpretq_f16_u16(vld1q_u16(Source));
+
+        vst1q_f32(Destination, vcvt_f32_f16(vget_low_f16(Vector)));
+        vst1q_f32(Destination + 4, vcvt_high_f32_f16(Vector));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#endif
+
+    for (size_t n = 0; n < Count; n++) {
+        Destination[n] = MlasFp16ToFp32(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToF16Kernel(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of single precision elements to half
+    precision.
+
+Arguments:
+
+    Source - Supplies the single precision input buffer.
+
+    Destination - Supplies the half precision output buffer.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_TARGET_ARM64) && !defined(_WIN32)
+
+    while (Count >= 8) {
+
+        float16x4_t Vector0 = vcvt_f16_f32(vld1q_f32(Source));
+        float16x8_t Vector = vcvt_high_f16_f32(Vector0, vld1q_f32(Source + 4));
+
+        vst1q_u16(Destination, vreinterpretq_u16_f16(Vector));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#endif
+
+    for (size_t n = 0; n < Count; n++) {
+        Destination[n] = MlasFp32ToFp16(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertHalfToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    GetMlasPlatform().CastF16ToF32Kernel(Source, Destination, Count);
+}
+
+void
+MLASCALL
+MlasConvertFloatToHalfBuffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+    GetMlasPlatform().CastF32ToF16Kernel(Source, Destination, Count);
+}
+
+void
+MLASCALL
+MlasConvertBFloat16ToFloatBuffer(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of bfloat16 elements to single precision.
+    The bfloat16 format is the upper half of the single precision format, so
+    the conversion is exact.
+
+Arguments:
+
+    Source - Supplies the bfloat16 input buffer.
+
+    Destination - Supplies the single precision output buffer.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    const __m128i ZeroVector = _mm_setzero_si128();
+
+    while (Count >= 8) {
+
+        __m128i Vector = _mm_loadu_si128((const __m128i*)Source);
+
+        _mm_storeu_si128((__m128i*)Destination, _mm_unpacklo_epi16(ZeroVector, Vector));
+        _mm_storeu_si128((__m128i*)(Destination + 4), _mm_unpackhi_epi16(ZeroVector, Vector));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#elif defined(MLAS_NEON64_INTRINSICS)
+
+    while (Count >= 8) {
+
+        uint16x8_t Vector = vld1q_u16(Source);
+
+        vst1q_u32(reinterpret_cast<uint32_t*>(Destination), vshll_n_u16(vget_low_u16(Vector), 16));
+        vst1q_u32(reinterpret_cast<uint32_t*>(Destination + 4), vshll_high_n_u16(Vector, 16));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#endif
+
+    for (size_t n = 0; n < Count; n++) {
+        Destination[n] = MlasBf16ToFp32(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasConvertFloatToBFloat16Buffer(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+/*++
+
+Routine Description:
+
+    This routine converts a buffer of single precision elements to bfloat16.
+    Values are rounded to nearest even and NaNs are kept quiet.
+
+Arguments:
+
+    Source - Supplies the single precision input buffer.
+
+    Destination - Supplies the bfloat16 output buffer.
+
+    Count - Supplies the number of elements to convert.
+
+Return Value:
+
+    None.
+
+--*/
+{
+#if defined(MLAS_SSE2_INTRINSICS)
+
+    const __m128i RoundingBias = _mm_set1_epi32(0x7FFF);
+    const __m128i OnesVector = _mm_set1_epi32(1);
+    const __m128i QuietBit = _mm_set1_epi32(0x00400000);
+
+    auto RoundToBFloat16 = [&](__m128 FloatVector) {
+
+        __m128i Bits = _mm_castps_si128(FloatVector);
+        __m128i Odd = _mm_and_si128(_mm_srli_epi32(Bits, 16), OnesVector);
+        __m128i Rounded = _mm_add_epi32(Bits, _mm_add_epi32(RoundingBias, Odd));
+
+        __m128i NaNMask = _mm_castps_si128(_mm_cmpunord_ps(FloatVector, FloatVector));
+        Rounded = _mm_or_si128(_mm_andnot_si128(NaNMask, Rounded),
+                               _mm_and_si128(NaNMask, _mm_or_si128(Bits, QuietBit)));
+
+        //
+        // The arithmetic shift leaves each result in the int16 range, so the
+        // signed saturating pack is exact.
+        //
+
+        return _mm_srai_epi32(Rounded, 16);
+    };
+
+    while (Count >= 8) {
+
+        __m128i Vector0 = RoundToBFloat16(_mm_loadu_ps(Source));
+        __m128i Vector1 = RoundToBFloat16(_mm_loadu_ps(Source + 4));
+
+        _mm_storeu_si128((__m128i*)Destination, _mm_packs_epi32(Vector0, Vector1));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#elif defined(MLAS_NEON64_INTRINSICS)
+
+    const uint32x4_t RoundingBias = vdupq_n_u32(0x7FFF);
+    const uint32x4_t OnesVector = vdupq_n_u32(1);
+    const uint32x4_t QuietBit = vdupq_n_u32(0x00400000);
+
+    auto RoundToBFloat16 = [&](float32x4_t FloatVector) {
+
+        uint32x4_t Bits = vreinterpretq_u32_f32(FloatVector);
+        uint32x4_t Odd = vandq_u32(vshrq_n_u32(Bits, 16), OnesVector);
+        uint32x4_t Rounded = vaddq_u32(Bits, vaddq_u32(RoundingBias, Odd));
+
+        uint32x4_t OrderedMask = vceqq_f32(FloatVector, FloatVector);
+        Rounded = vbslq_u32(OrderedMask, Rounded, vorrq_u32(Bits, QuietBit));
+
+        return vshrn_n_u32(Rounded, 16);
+    };
+
+    while (Count >= 8) {
+
+        uint16x4_t Vector0 = RoundToBFloat16(vld1q_f32(Source));
+        uint16x4_t Vector1 = RoundToBFloat16(vld1q_f32(Source + 4));
+
+        vst1q_u16(Destination, vcombine_u16(Vector0, Vector1));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+#endif
+
+    for (size_t n = 0; n < Count; n++) {
+        Destination[n] = MlasFp32ToBf16(Source[n]);
+    }
+}
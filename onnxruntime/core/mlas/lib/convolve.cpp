@@ -23,6 +23,17 @@ Abstract:
 #define MLAS_CONV_WORKING_BUFFER_SIZE_PER_THREAD \
     (MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK)
 
+//
+// Define the target number of working buffer elements per thread for the
+// Winograd algorithm, which holds the transformed input and output tiles of
+// a block of tiles, and the bounds of the number of tiles in a block.
+//
+
+#define MLAS_CONV_WINOGRAD_WORKING_BUFFER_SIZE_PER_THREAD (256 * 1024)
+
+#define MLAS_CONV_WINOGRAD_MINIMUM_TILE_BLOCK 16
+#define MLAS_CONV_WINOGRAD_MAXIMUM_TILE_BLOCK 64
+
 //
 // Define the parameters to execute segments of a convolution operation on
 // worker threads.
@@ -729,6 +740,497 @@ Return Value:
     }
 }
 
+//
+// Winograd minimal filtering transforms F(2x2,3x3) and F(4x4,3x3) from
+// "Fast Algorithms for Convolutional Neural Networks" (Lavin, Gray). Each
+// transform is applied to the columns and then to the rows of a tile:
+//
+//     filter: U = G g G'
+//     input:  V = B' d B
+//     output: Y = A' (U . V) A
+//
+// The one dimensional transforms read Count elements spaced by InputStride
+// and write the transformed elements spaced by OutputStride.
+//
+
+struct MLAS_CONV_WINOGRAD_F2X2_3X3 {
+
+    static constexpr size_t OutputTileSize = 2;
+    static constexpr size_t InputTileSize = 4;
+
+    static
+    MLAS_FORCEINLINE
+    void
+    TransformFilter(
+        const float* g,
+        size_t InputStride,
+        float* u,
+        size_t OutputStride
+        )
+    {
+        const float g0 = g[0];
+        const float g1 = g[InputStride];
+        const float g2 = g[2 * InputStride];
+
+        u[0] = g0;
+        u[OutputStride] = 0.5f * (g0 + g1 + g2);
+        u[2 * OutputStride] = 0.5f * (g0 - g1 + g2);
+        u[3 * OutputStride] = g2;
+    }
+
+    static
+    MLAS_FORCEINLINE
+    void
+    TransformInput(
+        const float* d,
+        size_t InputStride,
+        float* v,
+        size_t OutputStride
+        )
+    {
+        const float d0 = d[0];
+        const float d1 = d[InputStride];
+        const float d2 = d[2 * InputStride];
+        const float d3 = d[3 * InputStride];
+
+        v[0] = d0 - d2;
+        v[OutputStride] = d1 + d2;
+        v[2 * OutputStride] = d2 - d1;
+        v[3 * OutputStride] = d1 - d3;
+    }
+
+    static
+    MLAS_FORCEINLINE
+    void
+    TransformOutput(
+        const float* m,
+        size_t InputStride,
+        float* y,
+        size_t OutputStride
+        )
+    {
+        const float m0 = m[0];
+        const float m1 = m[InputStride];
+        const float m2 = m[2 * InputStride];
+        const float m3 = m[3 * InputStride];
+
+        y[0] = m0 + m1 + m2;
+        y[OutputStride] = m1 - m2 - m3;
+    }
+};
+
+struct MLAS_CONV_WINOGRAD_F4X4_3X3 {
+
+    static constexpr size_t OutputTileSize = 4;
+    static constexpr size_t InputTileSize = 6;
+
+    static
+    MLAS_FORCEINLINE
+    void
+    TransformFilter(
+        const float* g,
+        size_t InputStride,
+        float* u,
+        size_t OutputStride
+        )
+    {
+        const float g0 = g[0];
+        const float g1 = g[InputStride];
+        const float g2 = g[2 * InputStride];
+
+        u[0] = g0 * (1.0f / 4.0f);
+        u[OutputStride] = (g0 + g1 + g2) * (-1.0f / 6.0f);
+        u[2 * OutputStride] = (g0 - g1 + g2) * (-1.0f / 6.0f);
+        u[3 * OutputStride] = g0 * (1.0f / 24.0f) + g1 * (1.0f / 12.0f) + g2 * (1.0f / 6.0f);
+        u[4 * OutputStride] = g0 * (1.0f / 24.0f) - g1 * (1.0f / 12.0f) + g2 * (1.0f / 6.0f);
+        u[5 * OutputStride] = g2;
+    }
+
+    static
+    MLAS_FORCEINLINE
+    void
+    TransformInput(
+        const float* d,
+        size_t InputStride,
+        float* v,
+        size_t OutputStride
+        )
+    {
+        const float d0 = d[0];
+        const float d1 = d[InputStride];
+        const float d2 = d[2 * InputStride];
+        const float d3 = d[3 * InputStride];
+        const float d4 = d[4 * InputStride];
+        const float d5 = d[5 * InputStride];
+
+        v[0] = 4.0f * d0 - 5.0f * d2 + d4;
+        v[OutputStride] = -4.0f * (d1 + d2) + d3 + d4;
+        v[2 * OutputStride] = 4.0f * (d1 - d2) - d3 + d4;
+        v[3 * OutputStride] = 2.0f * (d3 - d1) - d2 + d4;
+        v[4 * OutputStride] = 2.0f * (d1 - d3) - d2 + d4;
+        v[5 * OutputStride] = 4.0f * d1 - 5.0f * d3 + d5;
+    }
+
+    static
+    MLAS_FORCEINLINE
+    void
+    TransformOutput(
+        const float* m,
+        size_t InputStride,
+        float* y,
+        size_t OutputStride
+        )
+    {
+        const float m0 = m[0];
+        const float m1 = m[InputStride];
+        const float m2 = m[2 * InputStride];
+        const float m3 = m[3 * InputStride];
+        const float m4 = m[4 * InputStride];
+        const float m5 = m[5 * InputStride];
+
+        const float m12p = m1 + m2;
+        const float m12n = m1 - m2;
+        const float m34p = m3 + m4;
+        const float m34n = m3 - m4;
+
+        y[0] = m0 + m12p + m34p;
+        y[OutputStride] = m12n + 2.0f * m34n;
+        y[2 * OutputStride] = m12p + 4.0f * m34p;
+        y[3 * OutputStride] = m12n + 8.0f * m34n + m5;
+    }
+};
+
+template<typename Transform>
+void
+MlasConvWinogradPackFilterGroup(
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the 3x3 filters of one group.
+
+Arguments:
+
+    FilterCount - Supplies the number of filters of the group.
+
+    InputChannels - Supplies the number of input channels of the group.
+
+    Filter - Supplies the filter tensor of the group with shape
+        FilterCount x InputChannels x 3 x 3.
+
+    PackedFilter - Receives the transformed filters, stored as one
+        FilterCount x InputChannels matrix for each element of the
+        InputTileSize x InputTileSize transformed tile.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t InputTileSize = Transform::InputTileSize;
+    const size_t MatrixSize = FilterCount * InputChannels;
+
+    for (size_t f = 0; f < FilterCount; f++) {
+
+        for (size_t c = 0; c < InputChannels; c++) {
+
+            const float* g = Filter + (f * InputChannels + c) * 9;
+
+            float GTile[InputTileSize * 3];
+            float UTile[InputTileSize * InputTileSize];
+
+            for (size_t j = 0; j < 3; j++) {
+                Transform::TransformFilter(g + j, 3, GTile + j, 3);
+            }
+
+            for (size_t i = 0; i < InputTileSize; i++) {
+                Transform::TransformFilter(GTile + i * 3, 1, UTile + i * InputTileSize, 1);
+            }
+
+            float* u = PackedFilter + f * InputChannels + c;
+
+            for (size_t e = 0; e < InputTileSize * InputTileSize; e++) {
+                u[e * MatrixSize] = UTile[e];
+            }
+        }
+    }
+}
+
+template<typename Transform>
+void
+MlasConvWinogradOperation(
+    const MLAS_CONV_PARAMETERS* Parameters,
+    const float* Input,
+    const float* PackedFilter,
+    const float* Bias,
+    float* WorkingBuffer,
+    float* Output,
+    size_t TileStart,
+    size_t TileCount
+    )
+/*++
+
+Routine Description:
+
+    This routine computes a block of output tiles of one batch and group with
+    the Winograd algorithm: the input tiles of every channel are transformed,
+    multiplied by the transformed filters with one GEMM per element of the
+    transformed tile, and the products are transformed back to output tiles.
+
+Arguments:
+
+    Parameters - Supplies the structure that contains the convolution
+        parameters.
+
+    Input - Supplies the input tensor of the batch and group.
+
+    PackedFilter - Supplies the transformed filters of the group.
+
+    Bias - Optionally supplies the bias vector of the group.
+
+    WorkingBuffer - Supplies the thread local slice of the working buffer.
+
+    Output - Supplies the output tensor of the batch and group.
+
+    TileStart - Supplies the index of the first output tile to compute.
+
+    TileCount - Supplies the number of output tiles to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t OutputTileSize = Transform::OutputTileSize;
+    constexpr size_t InputTileSize = Transform::InputTileSize;
+    constexpr size_t TransformedTileSize = InputTileSize * InputTileSize;
+
+    const size_t InputChannels = Parameters->InputChannels;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputHeight = Parameters->InputShape[0];
+    const size_t InputWidth = Parameters->InputShape[1];
+    const size_t OutputHeight = Parameters->OutputShape[0];
+    const size_t OutputWidth = Parameters->OutputShape[1];
+    const size_t InputSize = Parameters->InputSize;
+    const size_t OutputSize = Parameters->OutputSize;
+    const size_t PaddingTop = Parameters->Padding[0];
+    const size_t PaddingLeft = Parameters->Padding[1];
+    const float Beta = Parameters->Beta;
+
+    const size_t TileCountWidth = (OutputWidth + OutputTileSize - 1) / OutputTileSize;
+
+    //
+    // The transformed input is InputChannels x TileCount and the products
+    // are FilterCount x TileCount for each element of the transformed tile.
+    //
+
+    float* TransformedInput = WorkingBuffer;
+    float* TransformedOutput = TransformedInput + TransformedTileSize * InputChannels * TileCount;
+
+    for (size_t c = 0; c < InputChannels; c++) {
+
+        const float* input = Input + c * InputSize;
+
+        for (size_t t = 0; t < TileCount; t++) {
+
+            const size_t tile = TileStart + t;
+            const size_t ih0 = (tile / TileCountWidth) * OutputTileSize - PaddingTop;
+            const size_t iw0 = (tile % TileCountWidth) * OutputTileSize - PaddingLeft;
+
+            //
+            // Gather the input tile, the elements in the padding are zero.
+            // The unsigned compares also catch the negative indices.
+            //
+
+            float DTile[TransformedTileSize];
+            float BTile[TransformedTileSize];
+            float VTile[TransformedTileSize];
+
+            for (size_t i = 0; i < InputTileSize; i++) {
+
+                const size_t ih = ih0 + i;
+
+                for (size_t j = 0; j < InputTileSize; j++) {
+
+                    const size_t iw = iw0 + j;
+
+                    DTile[i * InputTileSize + j] =
+                        (ih < InputHeight && iw < InputWidth) ? input[ih * InputWidth + iw] : 0.0f;
+                }
+            }
+
+            for (size_t j = 0; j < InputTileSize; j++) {
+                Transform::TransformInput(DTile + j, InputTileSize, BTile + j, InputTileSize);
+            }
+
+            for (size_t i = 0; i < InputTileSize; i++) {
+                Transform::TransformInput(BTile + i * InputTileSize, 1, VTile + i * InputTileSize, 1);
+            }
+
+            float* v = TransformedInput + c * TileCount + t;
+
+            for (size_t e = 0; e < TransformedTileSize; e++) {
+                v[e * InputChannels * TileCount] = VTile[e];
+            }
+        }
+    }
+
+    //
+    // Multiply the transformed filters by the transformed input tiles.
+    //
+
+    for (size_t e = 0; e < TransformedTileSize; e++) {
+
+        MlasSgemmOperation(CblasNoTrans, CblasNoTrans, FilterCount, TileCount, InputChannels, 1.0f,
+            PackedFilter + e * FilterCount * InputChannels, InputChannels,
+            TransformedInput + e * InputChannels * TileCount, TileCount, 0.0f,
+            TransformedOutput + e * FilterCount * TileCount, TileCount);
+    }
+
+    //
+    // Transform the products to output tiles, then apply the activation with
+    // optional bias to the rows of the tile for all the filters.
+    //
+
+    for (size_t t = 0; t < TileCount; t++) {
+
+        const size_t tile = TileStart + t;
+        const size_t oh0 = (tile / TileCountWidth) * OutputTileSize;
+        const size_t ow0 = (tile % TileCountWidth) * OutputTileSize;
+        const size_t TileHeight = std::min(OutputTileSize, OutputHeight - oh0);
+        const size_t TileWidth = std::min(OutputTileSize, OutputWidth - ow0);
+
+        for (size_t f = 0; f < FilterCount; f++) {
+
+            float MTile[TransformedTileSize];
+            float ATile[OutputTileSize * InputTileSize];
+            float YTile[OutputTileSize * OutputTileSize];
+
+            const float* m = TransformedOutput + f * TileCount + t;
+
+            for (size_t e = 0; e < TransformedTileSize; e++) {
+                MTile[e] = m[e * FilterCount * TileCount];
+            }
+
+            for (size_t j = 0; j < InputTileSize; j++) {
+                Transform::TransformOutput(MTile + j, InputTileSize, ATile + j, InputTileSize);
+            }
+
+            for (size_t i = 0; i < OutputTileSize; i++) {
+                Transform::TransformOutput(ATile + i * InputTileSize, 1, YTile + i * OutputTileSize, 1);
+            }
+
+            float* output = Output + f * OutputSize + oh0 * OutputWidth + ow0;
+
+            for (size_t i = 0; i < TileHeight; i++) {
+                for (size_t j = 0; j < TileWidth; j++) {
+                    float y = YTile[i * OutputTileSize + j];
+                    if (Beta != 0.0f) {
+                        y += Beta * output[i * OutputWidth + j];
+                    }
+                    output[i * OutputWidth + j] = y;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < TileHeight; i++) {
+            MlasActivation(Parameters->Activation, Output + (oh0 + i) * OutputWidth + ow0, Bias,
+                FilterCount, TileWidth, OutputSize);
+        }
+    }
+}
+
+void
+MlasConvWinogradThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute blocks of output
+    tiles of a Winograd convolution operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_CONV_WORK_BLOCK* WorkBlock = (MLAS_CONV_WORK_BLOCK*)Context;
+
+    const MLAS_CONV_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    const size_t TileSize = Parameters->u.Winograd.TileSize;
+    const size_t TileBlockSize = Parameters->u.Winograd.TileBlockSize;
+    const size_t TransformedTileSize = (TileSize + 2) * (TileSize + 2);
+
+    const size_t TileCount = ((Parameters->OutputShape[0] + TileSize - 1) / TileSize) *
+                             ((Parameters->OutputShape[1] + TileSize - 1) / TileSize);
+    const size_t TileBlockCount = (TileCount + TileBlockSize - 1) / TileBlockSize;
+
+    const size_t GroupCount = Parameters->GroupCount;
+    const size_t FilterCount = Parameters->FilterCount;
+    const size_t InputChannels = Parameters->InputChannels;
+
+    const size_t InputGroupSize = InputChannels * Parameters->InputSize;
+    const size_t OutputGroupSize = FilterCount * Parameters->OutputSize;
+    const size_t FilterGroupSize = TransformedTileSize * FilterCount * InputChannels;
+
+    //
+    // Compute the range of blocks of tiles to use for this thread.
+    //
+
+    size_t TaskStart;
+    size_t TaskRemaining;
+
+    MlasPartitionWork(Index, WorkBlock->TargetThreadCount,
+        Parameters->BatchCount * GroupCount * TileBlockCount, &TaskStart, &TaskRemaining);
+
+    float* WorkingBuffer = WorkBlock->WorkingBuffer +
+        Index * TransformedTileSize * (InputChannels + FilterCount) * TileBlockSize;
+
+    for (size_t task = TaskStart; task < TaskStart + TaskRemaining; task++) {
+
+        const size_t bg = task / TileBlockCount;
+        const size_t group = bg % GroupCount;
+        const size_t TileStart = (task % TileBlockCount) * TileBlockSize;
+        const size_t TileBlockCountN = std::min(TileBlockSize, TileCount - TileStart);
+
+        const float* input = WorkBlock->Input + bg * InputGroupSize;
+        const float* filter = WorkBlock->Filter + group * FilterGroupSize;
+        float* output = WorkBlock->Output + bg * OutputGroupSize;
+
+        const float* bias = WorkBlock->Bias;
+
+        if (bias != nullptr) {
+            bias += group * FilterCount;
+        }
+
+        if (TileSize == 2) {
+            MlasConvWinogradOperation<MLAS_CONV_WINOGRAD_F2X2_3X3>(Parameters, input, filter, bias,
+                WorkingBuffer, output, TileStart, TileBlockCountN);
+        } else {
+            MlasConvWinogradOperation<MLAS_CONV_WINOGRAD_F4X4_3X3>(Parameters, input, filter, bias,
+                WorkingBuffer, output, TileStart, TileBlockCountN);
+        }
+    }
+}
+
 inline
 bool
 MlasConvTryMultithread(
@@ -874,6 +1376,28 @@ Return Value:
 
     const MLAS_CONV_ALGORITHM Algorithm = Parameters->Algorithm;
 
+    //
+    // Schedule blocks of output tiles of the Winograd algorithm across
+    // multiple threads. The transformed filter replaces the filter tensor.
+    //
+
+    if (Algorithm == MlasConvAlgorithmWinograd) {
+
+        MLAS_CONV_WORK_BLOCK WorkBlock;
+
+        WorkBlock.Parameters = Parameters;
+        WorkBlock.Input = Input;
+        WorkBlock.Filter = Parameters->u.Winograd.PackedFilter;
+        WorkBlock.Bias = Bias;
+        WorkBlock.WorkingBuffer = WorkingBuffer;
+        WorkBlock.Output = Output;
+        WorkBlock.TargetThreadCount = Parameters->ThreadCount;
+
+        MlasExecuteThreaded(MlasConvWinogradThreaded, &WorkBlock, Parameters->ThreadCount, ThreadPool);
+
+        return;
+    }
+
     //
     // Schedule batches of GEMMs across multiple threads.
     //
@@ -903,7 +1427,7 @@ Return Value:
         return;
     }
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+#if defined(MLAS_TARGET_WASM)
 
     if (Algorithm == MlasConvAlgorithmDepthwise) {
         // Fill the Working Buffer with Zero for use by the depthwise kernel.
@@ -976,7 +1500,7 @@ Return Value:
                     break;
                 }
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+#if defined(MLAS_TARGET_WASM)
 
                 case MlasConvAlgorithmDepthwise:
                 {
@@ -987,6 +1511,15 @@ Return Value:
 
 #endif
 
+                case MlasConvAlgorithmWinograd:
+                {
+                    //
+                    // Dispatched above for all the batches and groups.
+                    //
+
+                    break;
+                }
+
                 case MlasConvAlgorithmExpandThenGemmSegmented:
                 {
                     //
@@ -1224,9 +1757,9 @@ Return Value:
 
     } else {
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+#if defined(MLAS_TARGET_WASM)
 
-        // Scalar direct conv for depthwise convolution.
+        // Direct conv for depthwise convolution, vectorized by the WebAssembly SIMD build.
         // Currently only support 3x3 kernel with padding <=1 and dilations = 1.
         // TODO: support more general depthwise convolution.
 
@@ -1299,4 +1832,221 @@ Return Value:
 }
 #if defined(_MSC_VER) && !defined(__clang__)
 #pragma warning(pop)
-#endif
\ No newline at end of file
+#endif
+
+size_t
+MLASCALL
+MlasConvWinogradTileSize(
+    size_t InputChannels,
+    size_t FilterCount
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the Winograd algorithm for a 3x3 convolution given
+    the channel counts of a group. The transforms cost the same for every
+    channel while the saving of the GEMMs grows with the channel counts, so
+    small channel counts keep the im2col algorithm or use the cheaper
+    transforms of F(2x2,3x3), and larger ones use F(4x4,3x3).
+
+Arguments:
+
+    InputChannels - Supplies the number of input channels per group.
+
+    FilterCount - Supplies the number of filters per group.
+
+Return Value:
+
+    Returns the output tile size (2 or 4) of the Winograd algorithm to use,
+    else 0 if the Winograd algorithm should not be used.
+
+--*/
+{
+    if (InputChannels < 8 || FilterCount < 8) {
+        return 0;
+    }
+
+    if (InputChannels < 32 || FilterCount < 32) {
+        return 2;
+    }
+
+    return 4;
+}
+
+size_t
+MLASCALL
+MlasConvWinogradPackedFilterSize(
+    size_t TileSize,
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the number of elements of the transformed filter.
+
+Arguments:
+
+    TileSize - Supplies the output tile size (2 or 4).
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+Return Value:
+
+    Returns the number of elements of the transformed filter.
+
+--*/
+{
+    return (TileSize + 2) * (TileSize + 2) * GroupCount * FilterCount * InputChannels;
+}
+
+void
+MLASCALL
+MlasConvWinogradPackFilter(
+    size_t TileSize,
+    size_t GroupCount,
+    size_t FilterCount,
+    size_t InputChannels,
+    const float* Filter,
+    float* PackedFilter
+    )
+/*++
+
+Routine Description:
+
+    This routine transforms the 3x3 filters for the Winograd algorithm.
+
+Arguments:
+
+    TileSize - Supplies the output tile size (2 or 4).
+
+    GroupCount - Supplies the number of channel groups.
+
+    FilterCount - Supplies the number of filters per group.
+
+    InputChannels - Supplies the number of input channels per group.
+
+    Filter - Supplies the filter tensor with shape
+        (GroupCount x FilterCount) x InputChannels x 3 x 3.
+
+    PackedFilter - Receives the transformed filter, sized to the number of
+        elements returned by MlasConvWinogradPackedFilterSize.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t PackedGroupSize = MlasConvWinogradPackedFilterSize(TileSize, 1, FilterCount, InputChannels);
+    const size_t FilterGroupSize = FilterCount * InputChannels * 9;
+
+    for (size_t group = 0; group < GroupCount; group++) {
+
+        if (TileSize == 2) {
+            MlasConvWinogradPackFilterGroup<MLAS_CONV_WINOGRAD_F2X2_3X3>(FilterCount, InputChannels,
+                Filter + group * FilterGroupSize, PackedFilter + group * PackedGroupSize);
+        } else {
+            MlasConvWinogradPackFilterGroup<MLAS_CONV_WINOGRAD_F4X4_3X3>(FilterCount, InputChannels,
+                Filter + group * FilterGroupSize, PackedFilter + group * PackedGroupSize);
+        }
+    }
+}
+
+bool
+MLASCALL
+MlasConvPrepareWinograd(
+    MLAS_CONV_PARAMETERS* Parameters,
+    size_t TileSize,
+    const float* PackedFilter,
+    size_t* WorkingBufferSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine switches a convolution operation prepared by MlasConvPrepare
+    to the Winograd algorithm if it is a 2D 3x3 convolution with unit stride
+    and dilation, and its output is large enough for the output tiles.
+
+Arguments:
+
+    Parameters - Supplies the structure that stores the provided and computed
+        parameters for the convolution operation.
+
+    TileSize - Supplies the output tile size (2 or 4) the filter has been
+        transformed for.
+
+    PackedFilter - Supplies the filter transformed by
+        MlasConvWinogradPackFilter. MlasConv uses it instead of the filter
+        tensor.
+
+    WorkingBufferSize - Receives the number of elements to allocate for the
+        working buffer for intermediate results if the Winograd algorithm is
+        selected.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    Returns true if the Winograd algorithm is selected, else false if the
+    parameters are unchanged.
+
+--*/
+{
+    if ((TileSize != 2 && TileSize != 4) || PackedFilter == nullptr || Parameters->Dimensions != 2) {
+        return false;
+    }
+
+    for (size_t dim = 0; dim < 2; dim++) {
+        if (Parameters->KernelShape[dim] != 3 || Parameters->StrideShape[dim] != 1 ||
+            Parameters->DilationShape[dim] != 1 || Parameters->OutputShape[dim] < TileSize) {
+            return false;
+        }
+    }
+
+    const size_t TileCount = ((Parameters->OutputShape[0] + TileSize - 1) / TileSize) *
+                             ((Parameters->OutputShape[1] + TileSize - 1) / TileSize);
+    const size_t TileWorkingSize = (TileSize + 2) * (TileSize + 2) *
+                                   (Parameters->InputChannels + Parameters->FilterCount);
+
+    //
+    // Size the blocks of tiles so that the transformed tiles of a block fit
+    // in the per thread working buffer, while keeping enough columns for
+    // the GEMMs.
+    //
+
+    size_t TileBlockSize = MLAS_CONV_WINOGRAD_WORKING_BUFFER_SIZE_PER_THREAD / TileWorkingSize;
+
+    TileBlockSize = std::max(TileBlockSize, size_t(MLAS_CONV_WINOGRAD_MINIMUM_TILE_BLOCK));
+    TileBlockSize = std::min(TileBlockSize, size_t(MLAS_CONV_WINOGRAD_MAXIMUM_TILE_BLOCK));
+    TileBlockSize = std::min(TileBlockSize, TileCount);
+
+    const size_t TaskCount = Parameters->BatchCount * Parameters->GroupCount *
+                             ((TileCount + TileBlockSize - 1) / TileBlockSize);
+
+    ptrdiff_t TargetThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(TargetThreadCount) >= TaskCount) {
+        TargetThreadCount = ptrdiff_t(TaskCount);
+    }
+
+    Parameters->Algorithm = MlasConvAlgorithmWinograd;
+    Parameters->ThreadCount = TargetThreadCount;
+    Parameters->u.Winograd.TileSize = TileSize;
+    Parameters->u.Winograd.TileBlockSize = TileBlockSize;
+    Parameters->u.Winograd.PackedFilter = PackedFilter;
+
+    *WorkingBufferSize = size_t(TargetThreadCount) * TileBlockSize * TileWorkingSize;
+
+    return true;
+}
@@ -325,6 +325,51 @@ GetConvSymDispatch(bool InputIsSigned){
     return InputIsSigned ? GetMlasPlatform().ConvSymS8S8Dispatch : GetMlasPlatform().ConvSymU8S8Dispatch;
 }
 
+static
+size_t
+MlasConvSymPackWGroupSize(
+    const MLAS_CONV_SYM_DISPATCH* ConvSymDispatch,
+    size_t InputChannels,
+    size_t OutputChannels,
+    size_t KernelSize
+    )
+/*++
+
+Routine Description:
+
+    This routine returns the size of the packed filter of a single group for
+    the MlasConvSym kernels, or zero if the kernels do not support the shape.
+
+--*/
+{
+#ifdef MLAS_TARGET_ARM64
+    if (KernelSize <= 1) {
+        // im2col not needed, indirected buffer not needed
+        // just use qgemm path for pointwise
+        return 0;
+    }
+    if (InputChannels < 64) {
+        // Shallow indirect conv runs slower.
+        // TODO!! remove this for functional testing!
+        // TODO!! is there a way to know whether this is called by tests?
+        return 0;
+    }
+#endif
+
+    size_t OutputChannelPackCount = ConvSymDispatch->FilterOutputChannelPackCount;
+
+    if (ConvSymDispatch->Kernel == nullptr ||
+        OutputChannels < OutputChannelPackCount ||
+        (InputChannels % ConvSymDispatch->KernelInputChannelAlignment) != 0 ||
+        (OutputChannels % ConvSymDispatch->KernelOutputChannelAlignment) != 0
+        ) {
+        return 0;
+    }
+
+    size_t AlignedOutputChannels = (OutputChannels + OutputChannelPackCount - 1) / OutputChannelPackCount * OutputChannelPackCount;
+    return AlignedOutputChannels * InputChannels * KernelSize;
+}
+
 size_t
 MlasConvSymPackWSize(
     size_t GroupCount,
@@ -340,10 +385,9 @@ MlasConvSymPackWSize(
         return 0;
     }
 
-    if (GroupCount > 1) {
+    if (GroupCount > 1 && InputChannels == 1 && OutputChannels == 1) {
 
-        if (ConvSymDispatch->DepthwiseKernel != nullptr &&
-            InputChannels == 1 && OutputChannels == 1) {
+        if (ConvSymDispatch->DepthwiseKernel != nullptr) {
 #ifdef MLAS_TARGET_ARM64
             constexpr size_t GroupAlign = 8;
 #else
@@ -360,36 +404,14 @@ MlasConvSymPackWSize(
         } else {
             return 0;
         }
+    }
 
-    } else {
-
-#ifdef MLAS_TARGET_ARM64
-        if (KernelSize <= 1) {
-            // im2col not needed, indirected buffer not needed
-            // just use qgemm path for pointwise
-            return 0;
-        }
-        if (InputChannels < 64) {
-            // Shallow indirect conv runs slower.
-            // TODO!! remove this for functional testing!
-            // TODO!! is there a way to know whether this is called by tests?
-            return 0;
-        }
-#endif
-
-        size_t OutputChannelPackCount = ConvSymDispatch->FilterOutputChannelPackCount;
-
-        if (ConvSymDispatch->Kernel == nullptr ||
-            OutputChannels < OutputChannelPackCount ||
-            (InputChannels % ConvSymDispatch->KernelInputChannelAlignment) != 0 ||
-            (OutputChannels % ConvSymDispatch->KernelOutputChannelAlignment) != 0
-            ) {
-            return 0;
-        }
+    //
+    // Grouped convolutions pack the filter of each group with the same layout
+    // as a single group convolution, one after the other.
+    //
 
-        size_t AlignedOutputChannels = (OutputChannels + OutputChannelPackCount - 1) / OutputChannelPackCount * OutputChannelPackCount;
-        return AlignedOutputChannels * InputChannels * KernelSize;
-    }
+    return GroupCount * MlasConvSymPackWGroupSize(ConvSymDispatch, InputChannels, OutputChannels, KernelSize);
 }
 
 void
@@ -406,7 +428,7 @@ MlasConvSymPackW(
 {
     memset(PackedW, 0, PackedWSize);
 
-    if (GroupCount > 1) {
+    if (GroupCount > 1 && InputChannels == 1 && OutputChannels == 1) {
 
         for (size_t gc = 0; gc < GroupCount; gc++) {
 
@@ -417,13 +439,20 @@ MlasConvSymPackW(
             }
         }
 
-    } else {
+        return;
+    }
+
+    const MLAS_CONV_SYM_DISPATCH* ConvSymDispatch = GetConvSymDispatch(InputIsSigned);
+    size_t InputChannelPackCount = ConvSymDispatch->FilterInputChannelPackCount;
+    size_t OutputChannelPackCount = ConvSymDispatch->FilterOutputChannelPackCount;
 
-        const MLAS_CONV_SYM_DISPATCH* ConvSymDispatch = GetConvSymDispatch(InputIsSigned);
-        size_t InputChannelPackCount = ConvSymDispatch->FilterInputChannelPackCount;
-        size_t OutputChannelPackCount = ConvSymDispatch->FilterOutputChannelPackCount;
+    size_t kernel_dim = InputChannels * KernelSize;
+    size_t GroupPackedWSize = PackedWSize / GroupCount;
 
-        size_t kernel_dim = InputChannels * KernelSize;
+    for (size_t gc = 0; gc < GroupCount; gc++) {
+
+        int8_t* GroupPackedW = PackedW + gc * GroupPackedWSize;
+        const int8_t* GroupW = W + gc * OutputChannels * kernel_dim;
 
         for (size_t oc = 0; oc < OutputChannels; oc += OutputChannelPackCount) {
 
@@ -439,20 +468,19 @@ MlasConvSymPackW(
 
                         for (size_t ic_pack = 0; ic_pack < ic_pack_size; ic_pack++) {
 
-                            *(PackedW++) = W[(oc + oc_pack) * kernel_dim + (ic + ic_pack) * KernelSize + ki];
+                            *(GroupPackedW++) = GroupW[(oc + oc_pack) * kernel_dim + (ic + ic_pack) * KernelSize + ki];
 
                         }
 
-                        PackedW += InputChannelPackCount - ic_pack_size;
+                        GroupPackedW += InputChannelPackCount - ic_pack_size;
 
                     }
 
-                    PackedW += (OutputChannelPackCount - oc_pack_size) * InputChannelPackCount;
+                    GroupPackedW += (OutputChannelPackCount - oc_pack_size) * InputChannelPackCount;
 
                 }
             }
         }
-
     }
 }
 
@@ -530,49 +558,67 @@ MlasConvSym(
     const size_t InputChannels = Params.InputChannels;
     const size_t OutputChannels = Params.OutputChannels;
 
-    for (size_t oc_outside = 0; oc_outside < Params.OutputCount;) {
+    //
+    // Grouped convolutions run each group as a convolution with the input and
+    // output channels of the group, writing into the interleaved output rows of
+    // all the groups.
+    //
+
+    const size_t GroupCount = std::max<size_t>(Params.GroupCount, 1);
+    const size_t OutputStride = GroupCount * OutputChannels;
+    const size_t GroupPackedWSize = (GroupCount > 1) ?
+        MlasConvSymPackWSize(GroupCount, InputChannels, OutputChannels, KernelSize, Params.InputIsSigned) / GroupCount : 0;
 
-        const size_t oc_outside_block_size = std::min<size_t>(Params.OutputCount - oc_outside, 240);
-        const int8_t* pwb = static_cast<const int8_t*>(Params.Filter);
+    for (size_t gc = 0; gc < GroupCount; gc++) {
 
-        for (size_t co = 0; co < OutputChannels;) {
+        const void* const* InputIndirection = (Params.InputIndirection != nullptr) ?
+            Params.InputIndirection + gc * Params.OutputCount * KernelSize : nullptr;
+        const size_t GroupChannelOffset = gc * OutputChannels;
 
-            const size_t ChannelCount = std::min<size_t>(OutputChannels - co, KernelChannelCount);
-            void* conv_out = static_cast<int8_t*>(Params.Output) + (oc_outside * OutputChannels) + co;
+        for (size_t oc_outside = 0; oc_outside < Params.OutputCount;) {
 
-            PostProcessParams.Bias = Params.Bias + co;
-            PostProcessParams.Scale = Params.Scale + (Params.PerChannelScale ? co : 0);
+            const size_t oc_outside_block_size = std::min<size_t>(Params.OutputCount - oc_outside, 240);
+            const int8_t* pwb = static_cast<const int8_t*>(Params.Filter) + gc * GroupPackedWSize;
 
-            for (size_t oc = 0; oc < oc_outside_block_size;) {
+            for (size_t co = 0; co < OutputChannels;) {
 
-                const void* Input;
-                if (Params.InputIndirection) {
-                    Input = Params.InputIndirection + (oc_outside + oc) * KernelSize;
-                } else {
-                    Input = static_cast<const int8_t*>(Params.InputDirect) + (oc_outside + oc) * InputChannels;
+                const size_t ChannelCount = std::min<size_t>(OutputChannels - co, KernelChannelCount);
+                void* conv_out = static_cast<int8_t*>(Params.Output) + (oc_outside * OutputStride) + GroupChannelOffset + co;
+
+                PostProcessParams.Bias = Params.Bias + GroupChannelOffset + co;
+                PostProcessParams.Scale = Params.Scale + (Params.PerChannelScale ? GroupChannelOffset + co : 0);
+
+                for (size_t oc = 0; oc < oc_outside_block_size;) {
+
+                    const void* Input;
+                    if (InputIndirection) {
+                        Input = InputIndirection + (oc_outside + oc) * KernelSize;
+                    } else {
+                        Input = static_cast<const int8_t*>(Params.InputDirect) + (oc_outside + oc) * InputChannels;
+                    }
+                    size_t OutputCount = std::min<size_t>(oc_outside_block_size - oc, KernelOutputCount);
+
+                    Kernel(
+                        Input,
+                        pwb,
+                        conv_out,
+                        KernelSize,
+                        InputChannels,
+                        OutputStride,
+                        static_cast<unsigned>(ChannelCount),
+                        static_cast<unsigned>(OutputCount),
+                        &PostProcessParams,
+                        KernelFlags);
+                    oc += OutputCount;
+                    conv_out = static_cast<int8_t*>(conv_out) + OutputCount * OutputStride;
                 }
-                size_t OutputCount = std::min<size_t>(oc_outside_block_size - oc, KernelOutputCount);
-
-                Kernel(
-                    Input,
-                    pwb,
-                    conv_out,
-                    KernelSize,
-                    InputChannels,
-                    OutputChannels,
-                    static_cast<unsigned>(ChannelCount),
-                    static_cast<unsigned>(OutputCount),
-                    &PostProcessParams,
-                    KernelFlags);
-                oc += OutputCount;
-                conv_out = static_cast<int8_t*>(conv_out) + OutputCount * OutputChannels;
+
+                co += ChannelCount;
+                pwb += ChannelCount * InputChannels * KernelSize;
             }
 
-            co += ChannelCount;
-            pwb += ChannelCount * InputChannels * KernelSize;
+            oc_outside += oc_outside_block_size;
         }
-
-        oc_outside += oc_outside_block_size;
     }
 }
 
@@ -0,0 +1,234 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    dwconv.cpp
+
+Abstract:
+
+    This module implements the single precision floating point depthwise
+    convolution routines for the channels last (NHWC) layout.
+
+--*/
+
+#include "mlasi.h"
+
+template<size_t FixedKernelSize>
+void
+MlasConvDepthwiseFloatKernel(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    const MLAS_ACTIVATION* Activation,
+    bool ClampOutput,
+    float MinimumValue,
+    float MaximumValue
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the depthwise convolution kernel. The kernel size
+    is a compile time constant for the common 3x3 and 5x5 filters so that the
+    loop over the filter taps is fully unrolled.
+
+Arguments:
+
+    See MlasConvDepthwise.
+
+    ClampOutput - Supplies true if the output is clamped to the range
+        [MinimumValue, MaximumValue] as part of the accumulation, which
+        implements the Relu and Clip activations.
+
+    MinimumValue - Supplies the minimum output value.
+
+    MaximumValue - Supplies the maximum output value.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t KernelCount = (FixedKernelSize != 0) ? FixedKernelSize : KernelSize;
+
+    const MLAS_FLOAT32X4 MinimumVector = MlasBroadcastFloat32x4(MinimumValue);
+    const MLAS_FLOAT32X4 MaximumVector = MlasBroadcastFloat32x4(MaximumValue);
+
+    const bool ApplyActivation = !ClampOutput && Activation != nullptr &&
+        Activation->ActivationKind != MlasIdentityActivation;
+
+    while (OutputCount > 0) {
+
+        size_t c = 0;
+
+        for (; c + 8 <= Channels; c += 8) {
+
+            MLAS_FLOAT32X4 Accumulator0 = MlasZeroFloat32x4();
+            MLAS_FLOAT32X4 Accumulator1 = MlasZeroFloat32x4();
+
+            if (Bias != nullptr) {
+                Accumulator0 = MlasLoadFloat32x4(&Bias[c]);
+                Accumulator1 = MlasLoadFloat32x4(&Bias[c + 4]);
+            }
+
+            const float* filter = Filter + c;
+
+            for (size_t k = 0; k < KernelCount; k++) {
+
+                MLAS_FLOAT32X4 InputVector0 = MlasLoadFloat32x4(&Input[k][c]);
+                MLAS_FLOAT32X4 InputVector1 = MlasLoadFloat32x4(&Input[k][c + 4]);
+
+                Accumulator0 = MlasMultiplyAddFloat32x4(InputVector0, MlasLoadFloat32x4(filter), Accumulator0);
+                Accumulator1 = MlasMultiplyAddFloat32x4(InputVector1, MlasLoadFloat32x4(filter + 4), Accumulator1);
+
+                filter += Channels;
+            }
+
+            if (ClampOutput) {
+                Accumulator0 = MlasMinimumFloat32x4(MlasMaximumFloat32x4(Accumulator0, MinimumVector), MaximumVector);
+                Accumulator1 = MlasMinimumFloat32x4(MlasMaximumFloat32x4(Accumulator1, MinimumVector), MaximumVector);
+            }
+
+            MlasStoreFloat32x4(&Output[c], Accumulator0);
+            MlasStoreFloat32x4(&Output[c + 4], Accumulator1);
+        }
+
+        for (; c + 4 <= Channels; c += 4) {
+
+            MLAS_FLOAT32X4 Accumulator = (Bias != nullptr) ? MlasLoadFloat32x4(&Bias[c]) : MlasZeroFloat32x4();
+
+            const float* filter = Filter + c;
+
+            for (size_t k = 0; k < KernelCount; k++) {
+                Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(&Input[k][c]), MlasLoadFloat32x4(filter),
+                                                       Accumulator);
+                filter += Channels;
+            }
+
+            if (ClampOutput) {
+                Accumulator = MlasMinimumFloat32x4(MlasMaximumFloat32x4(Accumulator, MinimumVector), MaximumVector);
+            }
+
+            MlasStoreFloat32x4(&Output[c], Accumulator);
+        }
+
+        for (; c < Channels; c++) {
+
+            float Accumulator = (Bias != nullptr) ? Bias[c] : 0.0f;
+
+            const float* filter = Filter + c;
+
+            for (size_t k = 0; k < KernelCount; k++) {
+                Accumulator += Input[k][c] * *filter;
+                filter += Channels;
+            }
+
+            if (ClampOutput) {
+                Accumulator = std::min(std::max(Accumulator, MinimumValue), MaximumValue);
+            }
+
+            Output[c] = Accumulator;
+        }
+
+        //
+        // Apply the remaining activations to the output row while it is
+        // still in the cache.
+        //
+
+        if (ApplyActivation) {
+            MlasActivation(Activation, Output, nullptr, 1, Channels, Channels);
+        }
+
+        Input += KernelCount;
+        Output += Channels;
+        OutputCount -= 1;
+    }
+}
+
+void
+MLASCALL
+MlasConvDepthwise(
+    const float* const* Input,
+    const float* Filter,
+    const float* Bias,
+    float* Output,
+    size_t Channels,
+    size_t OutputCount,
+    size_t KernelSize,
+    const MLAS_ACTIVATION* Activation
+    )
+/*++
+
+Routine Description:
+
+    This routine implements the single precision floating point depthwise
+    convolution for the channels last (NHWC) layout.
+
+Arguments:
+
+    Input - Supplies the indirection buffer of OutputCount by KernelSize
+        pointers to the input pixels. Each pointer addresses Channels values,
+        padding pixels point to a buffer of zeros.
+
+    Filter - Supplies the filter with shape [KernelSize][Channels].
+
+    Bias - Optionally supplies the bias with Channels values.
+
+    Output - Supplies the output buffer with shape [OutputCount][Channels].
+
+    Channels - Supplies the number of channels.
+
+    OutputCount - Supplies the number of output pixels.
+
+    KernelSize - Supplies the number of filter taps.
+
+    Activation - Optionally supplies the activation to apply to the output.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    bool ClampOutput = false;
+    float MinimumValue = std::numeric_limits<float>::lowest();
+    float MaximumValue = std::numeric_limits<float>::max();
+
+    if (Activation != nullptr) {
+        if (Activation->ActivationKind == MlasReluActivation) {
+            ClampOutput = true;
+            MinimumValue = 0.0f;
+        } else if (Activation->ActivationKind == MlasClipActivation) {
+            ClampOutput = true;
+            MinimumValue = Activation->Parameters.Clip.minimum;
+            MaximumValue = Activation->Parameters.Clip.maximum;
+        }
+    }
+
+    switch (KernelSize) {
+
+        case 9:
+            MlasConvDepthwiseFloatKernel<9>(Input, Filter, Bias, Output, Channels, OutputCount, KernelSize,
+                                            Activation, ClampOutput, MinimumValue, MaximumValue);
+            break;
+
+        case 25:
+            MlasConvDepthwiseFloatKernel<25>(Input, Filter, Bias, Output, Channels, OutputCount, KernelSize,
+                                             Activation, ClampOutput, MinimumValue, MaximumValue);
+            break;
+
+        default:
+            MlasConvDepthwiseFloatKernel<0>(Input, Filter, Bias, Output, Channels, OutputCount, KernelSize,
+                                            Activation, ClampOutput, MinimumValue, MaximumValue);
+            break;
+    }
+}
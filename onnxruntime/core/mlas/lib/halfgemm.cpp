@@ -0,0 +1,367 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm.cpp
+
+Abstract:
+
+    This module implements the half precision (fp16) and bfloat16 matrix/matrix
+    multiply operations.
+
+    The inputs and outputs stay in their 16-bit formats so that the weights are
+    streamed from memory at half the cost of single precision. The elements are
+    widened in registers and the products are accumulated using single
+    precision before being rounded back to the 16-bit format.
+
+    The implementation below is the portable version of the kernels, platform
+    specific versions target newer instruction sets (such as AVX512 or NEON).
+
+--*/
+
+#include "mlasi.h"
+
+template<bool IsBf16>
+MLAS_FORCEINLINE
+float
+MlasHalfGemmLoadElement(
+    uint16_t Value
+    )
+{
+    return IsBf16 ? MlasBf16ToFp32(Value) : MlasFp16ToFp32(Value);
+}
+
+template<bool IsBf16>
+MLAS_FORCEINLINE
+uint16_t
+MlasHalfGemmStoreElement(
+    float Value
+    )
+{
+    return IsBf16 ? MlasFp32ToBf16(Value) : MlasFp32ToFp16(Value);
+}
+
+template<bool IsBf16>
+size_t
+MlasHalfGemmKernelPortable(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountN,
+    size_t ldb
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute a single row of a matrix
+    multiplication of 16-bit floating point elements.
+
+Arguments:
+
+    A - Supplies the address of the row of matrix A.
+
+    B - Supplies the address of matrix B.
+
+    C - Supplies the address of the row of matrix C.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    ldb - Supplies the first dimension of matrix B.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    constexpr size_t StrideN = 16;
+
+    float Accumulators[StrideN];
+
+    for (size_t n = 0; n < CountN; n += StrideN) {
+
+        const size_t CountBlockN = std::min(CountN - n, StrideN);
+
+        std::fill_n(Accumulators, CountBlockN, 0.0f);
+
+        const uint16_t* b = B + n;
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            const float AElement = MlasHalfGemmLoadElement<IsBf16>(A[k]);
+
+            for (size_t j = 0; j < CountBlockN; j++) {
+                Accumulators[j] += AElement * MlasHalfGemmLoadElement<IsBf16>(b[j]);
+            }
+
+            b += ldb;
+        }
+
+        for (size_t j = 0; j < CountBlockN; j++) {
+            C[n + j] = MlasHalfGemmStoreElement<IsBf16>(Accumulators[j]);
+        }
+    }
+
+    return 1;
+}
+
+size_t
+MLASCALL
+MlasHalfGemmKernel(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(CountM);
+    MLAS_UNREFERENCED_PARAMETER(lda);
+    MLAS_UNREFERENCED_PARAMETER(ldc);
+
+    return MlasHalfGemmKernelPortable<false>(A, B, C, CountK, CountN, ldb);
+}
+
+size_t
+MLASCALL
+MlasBf16GemmKernel(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(CountM);
+    MLAS_UNREFERENCED_PARAMETER(lda);
+    MLAS_UNREFERENCED_PARAMETER(ldc);
+
+    return MlasHalfGemmKernelPortable<true>(A, B, C, CountK, CountN, ldb);
+}
+
+void
+MlasHalfGemmThreaded(
+    MLAS_HALF_GEMM_KERNEL* Kernel,
+    const ptrdiff_t ThreadCountM,
+    const ptrdiff_t ThreadCountN,
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* DataParams,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    half precision or bfloat16 GEMM operation.
+
+Arguments:
+
+    Kernel - Supplies the platform kernel for the element format.
+
+    ThreadCountM - Supplies the total thread partition on the M dimension.
+
+    ThreadCountN - Supplies the total thread partition on the N dimension.
+
+    M, N, K - Supplies the shape of the multiplication
+
+    DataParams - Supplies the data position and layout of the matrices
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t ThreadIdM = ThreadId / ThreadCountN;
+    const ptrdiff_t ThreadIdN = ThreadId % ThreadCountN;
+
+    //
+    // Partition the operation along the M dimension.
+    //
+
+    size_t RangeStartM;
+    size_t RangeCountM;
+
+    MlasPartitionWork(ThreadIdM, ThreadCountM, M, &RangeStartM, &RangeCountM);
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    const size_t BlockedN = (N + MLAS_HALF_GEMM_STRIDEN_THREAD_ALIGN - 1) /
+        MLAS_HALF_GEMM_STRIDEN_THREAD_ALIGN;
+
+    MlasPartitionWork(ThreadIdN, ThreadCountN, BlockedN, &RangeStartN,
+        &RangeCountN);
+
+    RangeStartN *= MLAS_HALF_GEMM_STRIDEN_THREAD_ALIGN;
+    RangeCountN *= MLAS_HALF_GEMM_STRIDEN_THREAD_ALIGN;
+
+    if (RangeStartN >= N) {
+        return;
+    }
+
+    RangeCountN = std::min(N - RangeStartN, RangeCountN);
+
+    const size_t lda = DataParams->lda;
+    const size_t ldb = DataParams->ldb;
+    const size_t ldc = DataParams->ldc;
+
+    const uint16_t* A = DataParams->A + RangeStartM * lda;
+    const uint16_t* B = DataParams->B + RangeStartN;
+    uint16_t* C = DataParams->C + RangeStartM * ldc + RangeStartN;
+
+    //
+    // Step through each slice of matrix B along the N dimension. The kernel
+    // accumulates over the full K dimension, so a column slice of matrix B
+    // is reused from the cache for every row of matrix A.
+    //
+
+    size_t CountN;
+
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+
+        CountN = std::min(RangeCountN - n, size_t(MLAS_HALF_GEMM_STRIDEN));
+
+        const uint16_t* a = A;
+        uint16_t* c = C + n;
+        size_t RowsRemaining = RangeCountM;
+
+        while (RowsRemaining > 0) {
+
+            size_t RowsHandled = Kernel(a, B + n, c, K, RowsRemaining, CountN, lda, ldb, ldc);
+
+            a += lda * RowsHandled;
+            c += ldc * RowsHandled;
+
+            RowsRemaining -= RowsHandled;
+        }
+    }
+}
+
+void
+MlasHalfGemmBatchOperation(
+    MLAS_HALF_GEMM_KERNEL* Kernel,
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_HALF_GEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_HALF_GEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across multiple threads.
+    //
+
+    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    if (N > M) {
+
+        const size_t BlockedN = (N + MLAS_HALF_GEMM_STRIDEN_THREAD_ALIGN - 1) /
+            MLAS_HALF_GEMM_STRIDEN_THREAD_ALIGN;
+
+        if (size_t(ThreadsPerGemm) > BlockedN) {
+            ThreadsPerGemm = ptrdiff_t(BlockedN);
+        }
+
+        ThreadCountM = 1;
+        ThreadCountN = ThreadsPerGemm;
+
+    } else {
+
+        if (size_t(ThreadsPerGemm) > M) {
+            ThreadsPerGemm = ptrdiff_t(M);
+        }
+
+        ThreadCountM = ThreadsPerGemm;
+        ThreadCountN = 1;
+    }
+
+    MlasTrySimpleParallel(ThreadPool,
+        ThreadsPerGemm * static_cast<ptrdiff_t>(BatchSize),
+        [=](ptrdiff_t tid)
+    {
+        ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
+        ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
+        MlasHalfGemmThreaded(Kernel, ThreadCountM, ThreadCountN,
+            M, N, K, &(Data[GemmIdx]), ThreadIdx);
+    });
+}
+
+void
+MLASCALL
+MlasHalfGemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MlasHalfGemmBatchOperation(GetMlasPlatform().HalfGemmKernel, M, N, K, Data, BatchSize, ThreadPool);
+}
+
+void
+MLASCALL
+MlasBf16GemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_HALF_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MlasHalfGemmBatchOperation(GetMlasPlatform().Bf16GemmKernel, M, N, K, Data, BatchSize, ThreadPool);
+}
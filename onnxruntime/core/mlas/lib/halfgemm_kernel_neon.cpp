@@ -0,0 +1,216 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_kernel_neon.cpp
+
+Abstract:
+
+    This module implements the half precision (fp16) and bfloat16 matrix/matrix
+    multiply kernels for ARM NEON.
+
+    The 16-bit elements of matrix B are widened to single precision in
+    registers, so the products are accumulated using single precision FMA.
+
+--*/
+
+#include "mlasi.h"
+
+template<bool IsBf16>
+MLAS_FORCEINLINE
+float32x4_t
+MlasHalfGemmLoadVector(
+    const uint16_t* Buffer
+    )
+{
+    uint16x4_t Vector = vld1_u16(Buffer);
+
+    if (IsBf16) {
+        return vreinterpretq_f32_u32(vshll_n_u16(Vector, 16));
+    } else {
+        return vcvt_f32_f16(vreinterpret_f16_u16(Vector));
+    }
+}
+
+template<bool IsBf16>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmStoreVector(
+    uint16_t* Buffer,
+    float32x4_t Vector
+    )
+{
+    if (IsBf16) {
+
+        //
+        // Round to nearest even and force NaNs to stay quiet NaNs.
+        //
+
+        uint32x4_t Bits = vreinterpretq_u32_f32(Vector);
+        uint32x4_t Lsb = vandq_u32(vshrq_n_u32(Bits, 16), vdupq_n_u32(1));
+        uint32x4_t Rounded = vaddq_u32(Bits, vaddq_u32(Lsb, vdupq_n_u32(0x7FFF)));
+        uint32x4_t IsNumber = vceqq_f32(Vector, Vector);
+        uint32x4_t QuietNan = vorrq_u32(Bits, vdupq_n_u32(0x00400000));
+        Rounded = vbslq_u32(IsNumber, Rounded, QuietNan);
+        vst1_u16(Buffer, vshrn_n_u32(Rounded, 16));
+
+    } else {
+
+        vst1_u16(Buffer, vreinterpret_u16_f16(vcvt_f16_f32(Vector)));
+    }
+}
+
+template<bool IsBf16, size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelNeonBlock(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    )
+{
+    constexpr size_t StrideN = 16;
+
+    for (size_t n = 0; n < CountN; n += StrideN) {
+
+        float32x4_t Accumulators[RowCount][4];
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r][0] = vdupq_n_f32(0.0f);
+            Accumulators[r][1] = vdupq_n_f32(0.0f);
+            Accumulators[r][2] = vdupq_n_f32(0.0f);
+            Accumulators[r][3] = vdupq_n_f32(0.0f);
+        }
+
+        const uint16_t* a = A;
+        const uint16_t* b = B + n;
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            float32x4_t BElements0 = MlasHalfGemmLoadVector<IsBf16>(b);
+            float32x4_t BElements1 = MlasHalfGemmLoadVector<IsBf16>(b + 4);
+            float32x4_t BElements2 = MlasHalfGemmLoadVector<IsBf16>(b + 8);
+            float32x4_t BElements3 = MlasHalfGemmLoadVector<IsBf16>(b + 12);
+
+            for (size_t r = 0; r < RowCount; r++) {
+
+                const uint16_t AValue = a[r * lda];
+                const float AElement = IsBf16 ? MlasBf16ToFp32(AValue) : MlasFp16ToFp32(AValue);
+
+                Accumulators[r][0] = vfmaq_n_f32(Accumulators[r][0], BElements0, AElement);
+                Accumulators[r][1] = vfmaq_n_f32(Accumulators[r][1], BElements1, AElement);
+                Accumulators[r][2] = vfmaq_n_f32(Accumulators[r][2], BElements2, AElement);
+                Accumulators[r][3] = vfmaq_n_f32(Accumulators[r][3], BElements3, AElement);
+            }
+
+            a += 1;
+            b += ldb;
+        }
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            uint16_t* c = C + r * ldc + n;
+
+            MlasHalfGemmStoreVector<IsBf16>(c, Accumulators[r][0]);
+            MlasHalfGemmStoreVector<IsBf16>(c + 4, Accumulators[r][1]);
+            MlasHalfGemmStoreVector<IsBf16>(c + 8, Accumulators[r][2]);
+            MlasHalfGemmStoreVector<IsBf16>(c + 12, Accumulators[r][3]);
+        }
+    }
+}
+
+template<bool IsBf16>
+size_t
+MlasHalfGemmKernelNeonImpl(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    )
+{
+    const size_t RowsHandled = std::min(CountM, size_t(4));
+
+    //
+    // Process the columns that fill whole vectors with NEON and fallback to
+    // the portable kernel for the remaining columns.
+    //
+
+    const size_t CountVectorN = CountN & ~size_t(15);
+
+    if (CountVectorN > 0) {
+        switch (RowsHandled) {
+            case 4:
+                MlasHalfGemmKernelNeonBlock<IsBf16, 4>(A, B, C, CountK, CountVectorN, lda, ldb, ldc);
+                break;
+            case 3:
+                MlasHalfGemmKernelNeonBlock<IsBf16, 3>(A, B, C, CountK, CountVectorN, lda, ldb, ldc);
+                break;
+            case 2:
+                MlasHalfGemmKernelNeonBlock<IsBf16, 2>(A, B, C, CountK, CountVectorN, lda, ldb, ldc);
+                break;
+            default:
+                MlasHalfGemmKernelNeonBlock<IsBf16, 1>(A, B, C, CountK, CountVectorN, lda, ldb, ldc);
+                break;
+        }
+    }
+
+    if (CountVectorN < CountN) {
+
+        MLAS_HALF_GEMM_KERNEL* PortableKernel = IsBf16 ? MlasBf16GemmKernel : MlasHalfGemmKernel;
+
+        for (size_t r = 0; r < RowsHandled; r++) {
+            PortableKernel(A + r * lda, B + CountVectorN, C + r * ldc + CountVectorN, CountK, 1,
+                CountN - CountVectorN, lda, ldb, ldc);
+        }
+    }
+
+    return RowsHandled;
+}
+
+size_t
+MLASCALL
+MlasHalfGemmKernelNeon(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    )
+{
+    return MlasHalfGemmKernelNeonImpl<false>(A, B, C, CountK, CountM, CountN, lda, ldb, ldc);
+}
+
+size_t
+MLASCALL
+MlasBf16GemmKernelNeon(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    )
+{
+    return MlasHalfGemmKernelNeonImpl<true>(A, B, C, CountK, CountM, CountN, lda, ldb, ldc);
+}
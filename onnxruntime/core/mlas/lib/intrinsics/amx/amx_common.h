@@ -0,0 +1,49 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    amx_common.h
+
+Abstract:
+
+    This module defines the tile configuration shared by the kernels using
+    Advanced Matrix Extensions (AMX) instructions.
+
+    All of the kernels use palette 1 with eight tiles of 16 rows by 64 bytes:
+    tiles 0-3 accumulate a 32x32 block of matrix C, tiles 4-5 hold two row
+    blocks of matrix A and tiles 6-7 hold two column blocks of matrix B.
+
+--*/
+
+#pragma once
+
+#include "../../mlasi.h"
+
+struct MLAS_AMX_TILE_CONFIG {
+    uint8_t PaletteId;
+    uint8_t StartRow;
+    uint8_t Reserved[14];
+    uint16_t ColumnBytes[16];
+    uint8_t Rows[16];
+};
+
+MLAS_FORCEINLINE
+void
+MlasAmxLoadTileConfig(
+    void
+    )
+{
+    MLAS_DECLSPEC_ALIGN(static const MLAS_AMX_TILE_CONFIG TileConfig, 64) = {
+        1,
+        0,
+        {},
+        { 64, 64, 64, 64, 64, 64, 64, 64 },
+        { 16, 16, 16, 16, 16, 16, 16, 16 },
+    };
+
+    _tile_loadconfig(&TileConfig);
+}
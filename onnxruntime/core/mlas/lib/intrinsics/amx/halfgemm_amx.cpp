@@ -0,0 +1,239 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_amx.cpp
+
+Abstract:
+
+    This module implements the bfloat16 matrix/matrix multiply kernel with
+    AMX-BF16 instructions.
+
+    The slice of matrix B passed to the kernel is packed once in blocks of 16
+    columns, where each row of 64 bytes holds a pair of consecutive elements
+    along the K dimension for each of the 16 columns, which is the layout
+    expected by TDPBF16PS for the second source tile. The kernel then
+    computes every row of matrix A against the packed slice. Tiles of matrix
+    A are loaded directly from matrix A, except at the edges of the matrix
+    where they are copied to a zero padded buffer.
+
+--*/
+
+#include "amx_common.h"
+
+void
+MlasBf16GemmPackBAmx(
+    uint16_t* D,
+    const uint16_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    size_t AlignedCountK
+    )
+{
+    //
+    // Element 2*j of the interleaved vector is column j of the first row and
+    // element 2*j+1 is column j of the second row.
+    //
+
+    const __m512i Interleave = _mm512_set_epi16(
+        31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8,
+        23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0);
+
+    for (size_t n = 0; n < CountN; n += 16) {
+
+        const size_t CountBlockN = std::min(CountN - n, size_t(16));
+        const __mmask16 Mask = __mmask16((1u << CountBlockN) - 1);
+
+        const uint16_t* b = B + n;
+
+        for (size_t k = 0; k < AlignedCountK; k += 2) {
+
+            const __m256i Row0 = (k < CountK) ? _mm256_maskz_loadu_epi16(Mask, b) : _mm256_setzero_si256();
+            const __m256i Row1 = (k + 1 < CountK) ? _mm256_maskz_loadu_epi16(Mask, b + ldb) : _mm256_setzero_si256();
+
+            const __m512i Rows = _mm512_inserti64x4(_mm512_castsi256_si512(Row0), Row1, 1);
+
+            _mm512_storeu_si512(D, _mm512_permutexvar_epi16(Interleave, Rows));
+
+            b += ldb * 2;
+            D += 32;
+        }
+    }
+}
+
+MLAS_FORCEINLINE
+const uint16_t*
+MlasBf16GemmStageTileAmx(
+    uint16_t* Buffer,
+    const uint16_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK
+    )
+/*++
+
+Routine Description:
+
+    This routine copies a partial tile of up to 16 rows by 32 elements of
+    matrix A to a buffer padded with zeros.
+
+Return Value:
+
+    Returns the address of the buffer.
+
+--*/
+{
+    const __mmask32 Mask = (CountK >= 32) ? ~__mmask32(0) : __mmask32((1u << CountK) - 1);
+
+    for (size_t m = 0; m < 16; m++) {
+
+        const __m512i Row = (m < CountM) ? _mm512_maskz_loadu_epi16(Mask, A + m * lda) : _mm512_setzero_si512();
+
+        _mm512_store_si512(Buffer + m * 32, Row);
+    }
+
+    return Buffer;
+}
+
+MLAS_FORCEINLINE
+void
+MlasBf16GemmStoreRowAmx(
+    uint16_t* C,
+    const float* Accumulators,
+    size_t CountN
+    )
+{
+    for (size_t n = 0; n < CountN; n += 16) {
+
+        const size_t CountVectorN = std::min(CountN - n, size_t(16));
+        const __mmask16 Mask = __mmask16((1u << CountVectorN) - 1);
+
+        const __m512 Vector = _mm512_load_ps(Accumulators + n);
+
+        _mm256_mask_storeu_epi16(C + n, Mask, (__m256i)_mm512_cvtneps_pbh(Vector));
+    }
+}
+
+size_t
+MLASCALL
+MlasBf16GemmKernelAmx(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    )
+/*++
+
+Routine Description:
+
+    This routine computes all rows of the output matrix for the supplied
+    slice of matrix B.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    const size_t AlignedCountK = (CountK + 31) & ~size_t(31);
+    const size_t StrideB = AlignedCountK * 16;
+
+    MlasThreadedBufAlloc(((CountN + 15) / 16) * StrideB * sizeof(uint16_t));
+
+    uint16_t* PackedB = reinterpret_cast<uint16_t*>(ThreadedBufHolder.get());
+
+    MlasBf16GemmPackBAmx(PackedB, B, ldb, CountN, CountK, AlignedCountK);
+
+    MLAS_DECLSPEC_ALIGN(uint16_t Buffer[2][16 * 32], 64);
+    MLAS_DECLSPEC_ALIGN(float Accumulators[32 * 32], 64);
+
+    MlasAmxLoadTileConfig();
+
+    for (size_t m = 0; m < CountM; m += 32) {
+
+        const size_t CountBlockM = std::min(CountM - m, size_t(32));
+        const uint16_t* a = A + m * lda;
+
+        for (size_t n = 0; n < CountN; n += 32) {
+
+            const size_t CountBlockN = std::min(CountN - n, size_t(32));
+
+            _tile_zero(0);
+            _tile_zero(1);
+            _tile_zero(2);
+            _tile_zero(3);
+
+            const uint16_t* b = PackedB + (n / 16) * StrideB;
+
+            for (size_t k = 0; k < AlignedCountK; k += 32) {
+
+                const size_t CountBlockK = CountK - k;
+
+                //
+                // Load the tiles of matrix A directly unless they extend past
+                // the rows or the columns of matrix A.
+                //
+
+                const uint16_t* a0 = a + k;
+                size_t StrideA0 = lda * sizeof(uint16_t);
+
+                if (CountBlockM < 16 || CountBlockK < 32) {
+                    a0 = MlasBf16GemmStageTileAmx(Buffer[0], a0, lda, CountBlockM, CountBlockK);
+                    StrideA0 = 64;
+                }
+
+                _tile_loadd(4, a0, StrideA0);
+                _tile_loadd(6, b, 64);
+                _tile_dpbf16ps(0, 4, 6);
+
+                if (CountBlockN > 16) {
+                    _tile_loadd(7, b + StrideB, 64);
+                    _tile_dpbf16ps(1, 4, 7);
+                }
+
+                if (CountBlockM > 16) {
+
+                    const uint16_t* a1 = a + 16 * lda + k;
+                    size_t StrideA1 = lda * sizeof(uint16_t);
+
+                    if (CountBlockM < 32 || CountBlockK < 32) {
+                        a1 = MlasBf16GemmStageTileAmx(Buffer[1], a1, lda, CountBlockM - 16, CountBlockK);
+                        StrideA1 = 64;
+                    }
+
+                    _tile_loadd(5, a1, StrideA1);
+                    _tile_dpbf16ps(2, 5, 6);
+
+                    if (CountBlockN > 16) {
+                        _tile_dpbf16ps(3, 5, 7);
+                    }
+                }
+
+                b += 16 * 32;
+            }
+
+            _tile_stored(0, Accumulators, 128);
+            _tile_stored(1, Accumulators + 16, 128);
+            _tile_stored(2, Accumulators + 16 * 32, 128);
+            _tile_stored(3, Accumulators + 16 * 32 + 16, 128);
+
+            for (size_t mm = 0; mm < CountBlockM; mm++) {
+                MlasBf16GemmStoreRowAmx(C + (m + mm) * ldc + n, Accumulators + mm * 32, CountBlockN);
+            }
+        }
+    }
+
+    _tile_release();
+
+    return CountM;
+}
@@ -0,0 +1,451 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_amx.cpp
+
+Abstract:
+
+    This module implements QGEMM kernels for AMX-INT8.
+
+    Matrix A is packed with the rows padded to a multiple of 64 bytes, so that
+    a tile of 16 rows by 64 bytes is loaded at the row stride of the packed
+    buffer. Matrix B is packed in blocks of 16 columns, where each row of 64
+    bytes holds four consecutive elements along the K dimension for each of
+    the 16 columns, which is the layout expected by the TDPB[SU][SU]D
+    instructions for the second source tile. The elements of both matrices
+    are used natively, so no sign bit flip is needed for any of the
+    supported formats.
+
+--*/
+
+#include "amx_common.h"
+#include "../../qgemm.h"
+
+#include <type_traits>
+
+template<typename AType, typename BType>
+struct MLAS_GEMM_QUANT_KERNEL_AMX
+{
+    typedef uint8_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef AType OffsetAType;
+    typedef BType OffsetBType;
+
+    static constexpr size_t PackedK = 64;
+    static constexpr MLAS_GEMM_QUANT_STRIDES Strides{ 128, 256, 2048 };
+    static constexpr MLAS_GEMM_QUANT_STRIDES PackedStrides{ 64, 512, 2048 };
+};
+
+template<typename AType, typename BType>
+constexpr size_t MLAS_GEMM_QUANT_KERNEL_AMX<AType, BType>::PackedK;
+template<typename AType, typename BType>
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_QUANT_KERNEL_AMX<AType, BType>::Strides;
+template<typename AType, typename BType>
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_QUANT_KERNEL_AMX<AType, BType>::PackedStrides;
+
+typedef MLAS_GEMM_QUANT_KERNEL_AMX<uint8_t, int8_t> MLAS_GEMM_U8S8_KERNEL_AMX;
+typedef MLAS_GEMM_QUANT_KERNEL_AMX<uint8_t, uint8_t> MLAS_GEMM_U8U8_KERNEL_AMX;
+typedef MLAS_GEMM_QUANT_KERNEL_AMX<int8_t, int8_t> MLAS_GEMM_S8S8_KERNEL_AMX;
+
+//
+// Multiply tile TileA by tile TileB and accumulate into tile TileC with the
+// instruction matching the formats of matrix A and matrix B. The tile
+// numbers must be literals.
+//
+
+#define MlasAmxTileDotProduct(TileC, TileA, TileB) \
+    if constexpr (std::is_signed<AType>::value) { \
+        if constexpr (std::is_signed<BType>::value) { \
+            _tile_dpbssd(TileC, TileA, TileB); \
+        } else { \
+            _tile_dpbsud(TileC, TileA, TileB); \
+        } \
+    } else { \
+        if constexpr (std::is_signed<BType>::value) { \
+            _tile_dpbusd(TileC, TileA, TileB); \
+        } else { \
+            _tile_dpbuud(TileC, TileA, TileB); \
+        } \
+    }
+
+template<typename AType>
+void
+MlasGemmQuantCopyPackAAmx(
+    uint8_t* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+{
+    const size_t AlignedCountK = (CountK + 63) & ~size_t(63);
+
+    //
+    // The row sums are computed with VPSADBW, so signed elements are biased
+    // to unsigned values and the bias is removed from the final sum.
+    //
+
+    constexpr int32_t Bias = std::is_signed<AType>::value ? 128 : 0;
+    const __m512i BiasVector = _mm512_set1_epi8(char(Bias));
+    const __m512i ZeroVector = _mm512_setzero_si512();
+
+    while (CountM-- > 0) {
+
+        __m512i RowSums = _mm512_setzero_si512();
+
+        for (size_t k = 0; k < AlignedCountK; k += 64) {
+
+            const size_t CountBlockK = std::min(CountK - k, size_t(64));
+            const __mmask64 Mask = (CountBlockK == 64) ? ~__mmask64(0) : (__mmask64(1) << CountBlockK) - 1;
+
+            const __m512i Values = _mm512_maskz_loadu_epi8(Mask, A + k);
+            _mm512_storeu_si512(D + k, Values);
+
+            const __m512i BiasedValues = _mm512_maskz_mov_epi8(Mask, _mm512_xor_si512(Values, BiasVector));
+            RowSums = _mm512_add_epi64(RowSums, _mm512_sad_epu8(BiasedValues, ZeroVector));
+        }
+
+        *RowSumBuffer++ = int32_t(_mm512_reduce_add_epi64(RowSums)) - Bias * int32_t(CountK);
+
+        A += lda;
+        D += AlignedCountK;
+    }
+}
+
+template<typename BType>
+void
+MlasGemmQuantCopyPackBAmx(
+    uint8_t* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer
+    )
+{
+    const size_t AlignedCountK = (CountK + 63) & ~size_t(63);
+
+    const __m128i OnesByteVector = _mm_set1_epi8(1);
+    const __m128i OnesWordVector = _mm_set1_epi16(1);
+
+    //
+    // Process a block of 16 columns of matrix B in a loop. The columns past
+    // the end of matrix B are padded with zeros, so that the kernel always
+    // loads complete tiles.
+    //
+
+    for (size_t n = 0; n < CountN; n += 16) {
+
+        const size_t CountBlockN = std::min(CountN - n, size_t(16));
+        const __mmask16 Mask = __mmask16((1u << CountBlockN) - 1);
+
+        __m128i ColumnSums[4];
+
+        for (size_t i = 0; i < 4; i++) {
+            ColumnSums[i] = _mm_setzero_si128();
+        }
+
+        const uint8_t* b = B + n;
+
+        for (size_t k = 0; k < AlignedCountK; k += 4) {
+
+            __m128i Rows[4];
+
+            for (size_t r = 0; r < 4; r++) {
+                Rows[r] = (k + r < CountK) ? _mm_maskz_loadu_epi8(Mask, b + r * ldb) : _mm_setzero_si128();
+            }
+
+            //
+            // Interleave the four rows so that each group of 4 bytes holds the
+            // consecutive elements of a column.
+            //
+
+            const __m128i Rows01Low = _mm_unpacklo_epi8(Rows[0], Rows[1]);
+            const __m128i Rows01High = _mm_unpackhi_epi8(Rows[0], Rows[1]);
+            const __m128i Rows23Low = _mm_unpacklo_epi8(Rows[2], Rows[3]);
+            const __m128i Rows23High = _mm_unpackhi_epi8(Rows[2], Rows[3]);
+
+            __m128i Columns[4];
+
+            Columns[0] = _mm_unpacklo_epi16(Rows01Low, Rows23Low);
+            Columns[1] = _mm_unpackhi_epi16(Rows01Low, Rows23Low);
+            Columns[2] = _mm_unpacklo_epi16(Rows01High, Rows23High);
+            Columns[3] = _mm_unpackhi_epi16(Rows01High, Rows23High);
+
+            for (size_t i = 0; i < 4; i++) {
+
+                _mm_storeu_si128((__m128i*)(D + i * 16), Columns[i]);
+
+                const __m128i PairSums = std::is_signed<BType>::value ?
+                    _mm_maddubs_epi16(OnesByteVector, Columns[i]) :
+                    _mm_maddubs_epi16(Columns[i], OnesByteVector);
+
+                ColumnSums[i] = _mm_add_epi32(ColumnSums[i], _mm_madd_epi16(PairSums, OnesWordVector));
+            }
+
+            b += ldb * 4;
+            D += 64;
+        }
+
+        for (size_t i = 0; i < 4; i++) {
+            _mm_storeu_si128((__m128i*)(ColumnSumBuffer + n + i * 4), ColumnSums[i]);
+        }
+    }
+}
+
+template<typename AType, typename BType>
+size_t
+MlasGemmQuantKernelAmx(
+    const uint8_t* A,
+    const uint8_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to 32 rows of the output matrix from tiles of
+    the packed matrices. The packed buffer of matrix A is read in blocks of
+    16 rows, so it must be allocated for a multiple of 16 rows; the extra
+    rows only affect the accumulators that are not stored.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    const size_t StrideA = PackedCountK * 64;
+    const size_t StrideB = PackedCountK * 1024;
+    const size_t CountBlockM = std::min(CountM, size_t(32));
+
+    MLAS_DECLSPEC_ALIGN(int32_t Accumulators[32 * 32], 64);
+
+    MlasAmxLoadTileConfig();
+
+    for (size_t n = 0; n < CountN; n += 32) {
+
+        const size_t CountBlockN = std::min(CountN - n, size_t(32));
+
+        _tile_zero(0);
+        _tile_zero(1);
+        _tile_zero(2);
+        _tile_zero(3);
+
+        const uint8_t* a = A;
+        const uint8_t* b = B + (n / 16) * StrideB;
+
+        for (size_t k = 0; k < PackedCountK; k++) {
+
+            _tile_loadd(4, a, StrideA);
+            _tile_loadd(6, b, 64);
+            MlasAmxTileDotProduct(0, 4, 6);
+
+            if (CountBlockN > 16) {
+                _tile_loadd(7, b + StrideB, 64);
+                MlasAmxTileDotProduct(1, 4, 7);
+            }
+
+            if (CountBlockM > 16) {
+                _tile_loadd(5, a + 16 * StrideA, StrideA);
+                MlasAmxTileDotProduct(2, 5, 6);
+
+                if (CountBlockN > 16) {
+                    MlasAmxTileDotProduct(3, 5, 7);
+                }
+            }
+
+            a += 64;
+            b += 1024;
+        }
+
+        _tile_stored(0, Accumulators, 128);
+        _tile_stored(1, Accumulators + 16, 128);
+        _tile_stored(2, Accumulators + 16 * 32, 128);
+        _tile_stored(3, Accumulators + 16 * 32 + 16, 128);
+
+        //
+        // Apply the row and column sums for the zero points and store the
+        // block to matrix C.
+        //
+
+        const __mmask16 Mask0 = (CountBlockN >= 16) ? __mmask16(0xFFFF) : __mmask16((1u << CountBlockN) - 1);
+        const __mmask16 Mask1 = (CountBlockN > 16) ? __mmask16((1u << (CountBlockN - 16)) - 1) : __mmask16(0);
+
+        const __m512i ColumnSums0 = _mm512_maskz_loadu_epi32(Mask0, ColumnSumBuffer + n);
+        const __m512i ColumnSums1 = _mm512_maskz_loadu_epi32(Mask1, ColumnSumBuffer + n + 16);
+
+        __m512i ZeroPoints0 = _mm512_set1_epi32(1);
+        __m512i ZeroPoints1 = _mm512_set1_epi32(1);
+
+        if (ZeroPointB != nullptr) {
+            ZeroPoints0 = _mm512_maskz_loadu_epi32(Mask0, ZeroPointB + n);
+            ZeroPoints1 = _mm512_maskz_loadu_epi32(Mask1, ZeroPointB + n + 16);
+        }
+
+        for (size_t m = 0; m < CountBlockM; m++) {
+
+            const __m512i RowSum = _mm512_set1_epi32(RowSumBuffer[m]);
+            const int32_t* Accumulator = Accumulators + m * 32;
+            int32_t* c = C + m * ldc + n;
+
+            __m512i Vector0 = _mm512_add_epi32(_mm512_mullo_epi32(RowSum, ZeroPoints0), ColumnSums0);
+            Vector0 = _mm512_add_epi32(Vector0, _mm512_load_si512(Accumulator));
+
+            if (!ZeroMode) {
+                Vector0 = _mm512_add_epi32(Vector0, _mm512_maskz_loadu_epi32(Mask0, c));
+            }
+
+            _mm512_mask_storeu_epi32(c, Mask0, Vector0);
+
+            if (CountBlockN > 16) {
+
+                __m512i Vector1 = _mm512_add_epi32(_mm512_mullo_epi32(RowSum, ZeroPoints1), ColumnSums1);
+                Vector1 = _mm512_add_epi32(Vector1, _mm512_load_si512(Accumulator + 16));
+
+                if (!ZeroMode) {
+                    Vector1 = _mm512_add_epi32(Vector1, _mm512_maskz_loadu_epi32(Mask1, c + 16));
+                }
+
+                _mm512_mask_storeu_epi32(c + 16, Mask1, Vector1);
+            }
+        }
+    }
+
+    _tile_release();
+
+    return CountBlockM;
+}
+
+//
+// Use the AVX512 GEMV kernel for a single row of matrix A, which would only
+// fill one row of the tiles.
+//
+
+template<>
+MLAS_FORCEINLINE
+bool
+MlasGemmQuantTryGemvKernel<MLAS_GEMM_U8S8_KERNEL_AMX>(
+    const uint8_t* A,
+    const uint8_t* B,
+    size_t ldb,
+    int32_t* C,
+    size_t CountK,
+    size_t CountN,
+    bool AIsSigned,
+    bool BIsSigned
+    )
+{
+    if (!AIsSigned && BIsSigned) {
+        GetMlasPlatform().GemvU8S8Kernel(A, B, C, CountK, CountN, ldb);
+        return true;
+    }
+
+    return false;
+}
+
+//
+// Specialize the template functions of the kernel driver for each of the
+// supported formats.
+//
+
+#define MLAS_GEMM_QUANT_KERNEL_AMX_SPECIALIZE(KernelType) \
+    template<> \
+    MLAS_FORCEINLINE \
+    void \
+    MlasGemmQuantCopyPackA<KernelType>( \
+        KernelType::PackedAType* D, \
+        const uint8_t* A, \
+        size_t lda, \
+        size_t CountM, \
+        size_t CountK, \
+        int32_t* RowSumBuffer, \
+        bool AIsSigned \
+        ) \
+    { \
+        MLAS_UNREFERENCED_PARAMETER(AIsSigned); \
+        MlasGemmQuantCopyPackAAmx<KernelType::OffsetAType>(D, A, lda, CountM, CountK, RowSumBuffer); \
+    } \
+    \
+    template<> \
+    MLAS_FORCEINLINE \
+    void \
+    MlasGemmQuantCopyPackB<KernelType>( \
+        KernelType::PackedBType* D, \
+        const uint8_t* B, \
+        size_t ldb, \
+        size_t CountN, \
+        size_t CountK, \
+        int32_t* ColumnSumBuffer, \
+        bool BIsSigned \
+        ) \
+    { \
+        MLAS_UNREFERENCED_PARAMETER(BIsSigned); \
+        MlasGemmQuantCopyPackBAmx<KernelType::OffsetBType>(D, B, ldb, CountN, CountK, ColumnSumBuffer); \
+    } \
+    \
+    template<> \
+    MLAS_FORCEINLINE \
+    size_t \
+    MlasGemmQuantKernel<KernelType>( \
+        const KernelType::PackedAType* A, \
+        const KernelType::PackedBType* B, \
+        int32_t* C, \
+        size_t PackedCountK, \
+        size_t CountM, \
+        size_t CountN, \
+        size_t ldc, \
+        const int32_t* RowSumBuffer, \
+        const int32_t* ColumnSumBuffer, \
+        const int32_t* ZeroPointB, \
+        bool ZeroMode \
+        ) \
+    { \
+        return MlasGemmQuantKernelAmx<KernelType::OffsetAType, KernelType::OffsetBType>( \
+            A, B, C, PackedCountK, CountM, CountN, ldc, RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode); \
+    }
+
+MLAS_GEMM_QUANT_KERNEL_AMX_SPECIALIZE(MLAS_GEMM_U8S8_KERNEL_AMX)
+MLAS_GEMM_QUANT_KERNEL_AMX_SPECIALIZE(MLAS_GEMM_U8U8_KERNEL_AMX)
+MLAS_GEMM_QUANT_KERNEL_AMX_SPECIALIZE(MLAS_GEMM_S8S8_KERNEL_AMX)
+
+const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8S8DispatchAmx = {
+    MlasGemmQuantOperation<MLAS_GEMM_U8S8_KERNEL_AMX>,
+    MlasGemmQuantPackedOperation<MLAS_GEMM_U8S8_KERNEL_AMX>,
+    MlasGemmQuantCopyPackB<MLAS_GEMM_U8S8_KERNEL_AMX>,
+    MLAS_GEMM_U8S8_KERNEL_AMX::PackedK,
+    MLAS_GEMM_U8S8_KERNEL_AMX::PackedStrides.K,
+    32 // kernel M stride
+};
+
+const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8U8DispatchAmx = {
+    MlasGemmQuantOperation<MLAS_GEMM_U8U8_KERNEL_AMX>,
+    MlasGemmQuantPackedOperation<MLAS_GEMM_U8U8_KERNEL_AMX>,
+    MlasGemmQuantCopyPackB<MLAS_GEMM_U8U8_KERNEL_AMX>,
+    MLAS_GEMM_U8U8_KERNEL_AMX::PackedK,
+    MLAS_GEMM_U8U8_KERNEL_AMX::PackedStrides.K,
+    32 // kernel M stride
+};
+
+const MLAS_GEMM_QUANT_DISPATCH MlasGemmS8S8DispatchAmx = {
+    MlasGemmQuantOperation<MLAS_GEMM_S8S8_KERNEL_AMX>,
+    MlasGemmQuantPackedOperation<MLAS_GEMM_S8S8_KERNEL_AMX>,
+    MlasGemmQuantCopyPackB<MLAS_GEMM_S8S8_KERNEL_AMX>,
+    MLAS_GEMM_S8S8_KERNEL_AMX::PackedK,
+    MLAS_GEMM_S8S8_KERNEL_AMX::PackedStrides.K,
+    32 // kernel M stride
+};
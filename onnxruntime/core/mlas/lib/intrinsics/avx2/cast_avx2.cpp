@@ -0,0 +1,89 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    cast_avx2.cpp
+
+Abstract:
+
+    This module implements routines to convert buffers between single and
+    half precision using the F16C instructions.
+
+--*/
+
+#include "../../mlasi.h"
+
+void
+MLASCALL
+MlasCastF16ToF32KernelAvx2(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m256 Vector0 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)Source));
+        __m256 Vector1 = _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)(Source + 8)));
+
+        _mm256_storeu_ps(Destination, Vector0);
+        _mm256_storeu_ps(Destination + 8, Vector1);
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        _mm256_storeu_ps(Destination, _mm256_cvtph_ps(_mm_loadu_si128((const __m128i*)Source)));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    for (size_t n = 0; n < Count; n++) {
+        Destination[n] = MlasFp16ToFp32(Source[n]);
+    }
+}
+
+void
+MLASCALL
+MlasCastF32ToF16KernelAvx2(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    )
+{
+    while (Count >= 16) {
+
+        __m128i Vector0 = _mm256_cvtps_ph(_mm256_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT);
+        __m128i Vector1 = _mm256_cvtps_ph(_mm256_loadu_ps(Source + 8), _MM_FROUND_TO_NEAREST_INT);
+
+        _mm_storeu_si128((__m128i*)Destination, Vector0);
+        _mm_storeu_si128((__m128i*)(Destination + 8), Vector1);
+
+        Source += 16;
+        Destination += 16;
+        Count -= 16;
+    }
+
+    if (Count >= 8) {
+
+        _mm_storeu_si128((__m128i*)Destination,
+                         _mm256_cvtps_ph(_mm256_loadu_ps(Source), _MM_FROUND_TO_NEAREST_INT));
+
+        Source += 8;
+        Destination += 8;
+        Count -= 8;
+    }
+
+    for (size_t n = 0; n < Count; n++) {
+        Destination[n] = MlasFp32ToFp16(Source[n]);
+    }
+}
@@ -0,0 +1,54 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm_avx2.cpp
+
+Abstract:
+
+    This module implements the layer normalization kernel using AVX2 and FMA3
+    instructions.
+
+--*/
+
+#include "../../layernorm.h"
+
+struct MLAS_LAYERNORM_AVX2_TRAITS {
+
+    typedef __m256 Vector;
+
+    static constexpr size_t Width = 8;
+
+    static MLAS_FORCEINLINE Vector Load(const float* Buffer) { return _mm256_loadu_ps(Buffer); }
+
+    static MLAS_FORCEINLINE void Store(float* Buffer, Vector Value) { _mm256_storeu_ps(Buffer, Value); }
+
+    static MLAS_FORCEINLINE Vector Broadcast(float Value) { return _mm256_set1_ps(Value); }
+
+    static MLAS_FORCEINLINE Vector Add(Vector A, Vector B) { return _mm256_add_ps(A, B); }
+
+    static MLAS_FORCEINLINE Vector Subtract(Vector A, Vector B) { return _mm256_sub_ps(A, B); }
+
+    static MLAS_FORCEINLINE Vector Multiply(Vector A, Vector B) { return _mm256_mul_ps(A, B); }
+
+    static MLAS_FORCEINLINE Vector MultiplyAdd(Vector A, Vector B, Vector C) { return _mm256_fmadd_ps(A, B, C); }
+};
+
+void
+MLASCALL
+MlasLayerNormF32KernelAvx2(
+    const float* Input,
+    const float* Skip,
+    float* SkipOutput,
+    float* Output,
+    size_t D,
+    const MLAS_LAYERNORM_PARAMETERS* Parameters,
+    float* Statistics
+    )
+{
+    MlasLayerNormKernel<MLAS_LAYERNORM_AVX2_TRAITS>(Input, Skip, SkipOutput, Output, D, Parameters, Statistics);
+}
@@ -0,0 +1,191 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm_avx2.cpp
+
+Abstract:
+
+    This module implements the kernel for the single precision matrix/matrix
+    multiply operation with a blockwise 4-bit quantized matrix B using AVX2
+    and FMA3 instructions.
+
+    Each group of 32 quantized elements is unpacked to four vectors of single
+    precision elements, which are scaled and offset by the block parameters
+    and accumulated with the elements of matrix A.
+
+--*/
+
+#include "../../q4gemm.h"
+
+MLAS_FORCEINLINE
+__m256
+MlasQ4GemmDequantizeVector(
+    __m128i Bytes,
+    __m256 Scale,
+    __m256 Offset
+    )
+{
+    __m256 Elements = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(Bytes));
+
+    return _mm256_fmadd_ps(Elements, Scale, Offset);
+}
+
+MLAS_FORCEINLINE
+float
+MlasQ4GemmReduceAdd(
+    __m256 Vector
+    )
+{
+    __m128 Sum = _mm_add_ps(_mm256_castps256_ps128(Vector), _mm256_extractf128_ps(Vector, 1));
+    Sum = _mm_add_ps(Sum, _mm_movehl_ps(Sum, Sum));
+    Sum = _mm_add_ss(Sum, _mm_shuffle_ps(Sum, Sum, 0x55));
+
+    return _mm_cvtss_f32(Sum);
+}
+
+template<size_t ColumnCount>
+MLAS_FORCEINLINE
+void
+MlasQ4GemmKernelAvx2Block(
+    const float* A,
+    const float* TailA,
+    size_t CountFullK,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountK,
+    size_t BlkLen,
+    size_t ColumnStride,
+    const float* Bias
+    )
+{
+    const size_t BlockStride = MlasQ4GemmBlockStride(BlkLen);
+    const __m128i LowMask = _mm_set1_epi8(0x0F);
+
+    __m256 Accumulators[ColumnCount];
+
+    for (size_t c = 0; c < ColumnCount; c++) {
+        Accumulators[c] = _mm256_setzero_ps();
+    }
+
+    const uint8_t* b = PackedB;
+
+    for (size_t k = 0; k < CountK; k += BlkLen) {
+
+        __m256 Scale[ColumnCount];
+        __m256 Offset[ColumnCount];
+
+        for (size_t c = 0; c < ColumnCount; c++) {
+            const float* Header = reinterpret_cast<const float*>(b + c * ColumnStride);
+            Scale[c] = _mm256_set1_ps(Header[0]);
+            Offset[c] = _mm256_set1_ps(Header[1]);
+        }
+
+        const uint8_t* QuantData = b + 2 * sizeof(float);
+        const size_t BlockEndK = std::min(k + BlkLen, CountK);
+
+        for (size_t kk = k; kk < BlockEndK; kk += MLAS_Q4GEMM_GROUP_SIZE) {
+
+            const float* a = (kk < CountFullK) ? A + kk : TailA;
+
+            __m256 A0 = _mm256_loadu_ps(a);
+            __m256 A1 = _mm256_loadu_ps(a + 8);
+            __m256 A2 = _mm256_loadu_ps(a + 16);
+            __m256 A3 = _mm256_loadu_ps(a + 24);
+
+            for (size_t c = 0; c < ColumnCount; c++) {
+
+                __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(QuantData + c * ColumnStride));
+                __m128i LowBytes = _mm_and_si128(Bytes, LowMask);
+                __m128i HighBytes = _mm_and_si128(_mm_srli_epi16(Bytes, 4), LowMask);
+
+                Accumulators[c] = _mm256_fmadd_ps(A0,
+                    MlasQ4GemmDequantizeVector(LowBytes, Scale[c], Offset[c]), Accumulators[c]);
+                Accumulators[c] = _mm256_fmadd_ps(A1,
+                    MlasQ4GemmDequantizeVector(_mm_srli_si128(LowBytes, 8), Scale[c], Offset[c]), Accumulators[c]);
+                Accumulators[c] = _mm256_fmadd_ps(A2,
+                    MlasQ4GemmDequantizeVector(HighBytes, Scale[c], Offset[c]), Accumulators[c]);
+                Accumulators[c] = _mm256_fmadd_ps(A3,
+                    MlasQ4GemmDequantizeVector(_mm_srli_si128(HighBytes, 8), Scale[c], Offset[c]), Accumulators[c]);
+            }
+
+            QuantData += MLAS_Q4GEMM_GROUP_SIZE / 2;
+        }
+
+        b += BlockStride;
+    }
+
+    for (size_t c = 0; c < ColumnCount; c++) {
+        float Sum = MlasQ4GemmReduceAdd(Accumulators[c]);
+        C[c] = (Bias != nullptr) ? Sum + Bias[c] : Sum;
+    }
+}
+
+void
+MLASCALL
+MlasQ4GemmKernelAvx2(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlkLen,
+    const float* Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute a single row of a matrix
+    multiplication with a packed blockwise 4-bit quantized matrix B.
+
+Arguments:
+
+    A - Supplies the address of the row of matrix A.
+
+    PackedB - Supplies the address of the first packed column of matrix B.
+
+    C - Supplies the address of the row of matrix C.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    BlkLen - Supplies the number of quantized elements per block.
+
+    Bias - Supplies the optional bias vector for the columns of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t ColumnStride = MlasQ4GemmBlockCountK(CountK, BlkLen) * MlasQ4GemmBlockStride(BlkLen);
+
+    MLAS_DECLSPEC_ALIGN(float TailA[MLAS_Q4GEMM_GROUP_SIZE], 32);
+    const size_t CountFullK = MlasQ4GemmPrepareTailA(A, CountK, TailA);
+
+    //
+    // Process four columns at a time to reuse the elements of matrix A from
+    // registers.
+    //
+
+    size_t n = 0;
+
+    for (; n + 4 <= CountN; n += 4) {
+        MlasQ4GemmKernelAvx2Block<4>(A, TailA, CountFullK, PackedB + n * ColumnStride, C + n,
+            CountK, BlkLen, ColumnStride, (Bias != nullptr) ? Bias + n : nullptr);
+    }
+
+    for (; n < CountN; n++) {
+        MlasQ4GemmKernelAvx2Block<1>(A, TailA, CountFullK, PackedB + n * ColumnStride, C + n,
+            CountK, BlkLen, ColumnStride, (Bias != nullptr) ? Bias + n : nullptr);
+    }
+}
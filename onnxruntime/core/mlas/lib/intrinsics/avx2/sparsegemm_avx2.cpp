@@ -0,0 +1,243 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparsegemm_avx2.cpp
+
+Abstract:
+
+    This module implements the kernels for the single precision and quantized
+    matrix/matrix multiply operations with a block sparse matrix B using AVX2
+    and FMA3 instructions.
+
+    Each block of matrix B is loaded to two vectors and multiplied with the
+    broadcast element of matrix A for up to six rows of matrix A. The
+    quantized kernel multiplies a pair of blocks at a time with the broadcast
+    pair of elements of matrix A.
+
+--*/
+
+#include "../../mlasi.h"
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasBlockSparseSgemmKernelAvx2Tile(
+    const float* A,
+    size_t lda,
+    const uint32_t* BlockRowK,
+    const float* Values,
+    size_t BlockCount,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    float alpha
+    )
+{
+    __m256 Accumulators[RowCount][2];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r][0] = _mm256_setzero_ps();
+        Accumulators[r][1] = _mm256_setzero_ps();
+    }
+
+    for (size_t b = 0; b < BlockCount; b++) {
+
+        const float* a = A + BlockRowK[b];
+
+        const __m256 B0 = _mm256_loadu_ps(Values);
+        const __m256 B1 = _mm256_loadu_ps(Values + 8);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const __m256 ABroadcast = _mm256_broadcast_ss(a + r * lda);
+            Accumulators[r][0] = _mm256_fmadd_ps(B0, ABroadcast, Accumulators[r][0]);
+            Accumulators[r][1] = _mm256_fmadd_ps(B1, ABroadcast, Accumulators[r][1]);
+        }
+
+        Values += MLAS_BLOCK_SPARSE_GEMM_BLOCK_N;
+    }
+
+    const __m256 AlphaBroadcast = _mm256_set1_ps(alpha);
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        float* c = C + r * ldc;
+
+        const __m256 C0 = _mm256_mul_ps(Accumulators[r][0], AlphaBroadcast);
+        const __m256 C1 = _mm256_mul_ps(Accumulators[r][1], AlphaBroadcast);
+
+        if (CountN == MLAS_BLOCK_SPARSE_GEMM_BLOCK_N) {
+
+            _mm256_storeu_ps(c, C0);
+            _mm256_storeu_ps(c + 8, C1);
+
+        } else {
+
+            MLAS_DECLSPEC_ALIGN(float Row[MLAS_BLOCK_SPARSE_GEMM_BLOCK_N], 32);
+
+            _mm256_store_ps(Row, C0);
+            _mm256_store_ps(Row + 8, C1);
+
+            std::copy_n(Row, CountN, c);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasBlockSparseSgemmKernelAvx2(
+    const float* A,
+    size_t lda,
+    const uint32_t* BlockRowK,
+    const float* Values,
+    size_t BlockCount,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    float alpha
+    )
+{
+    size_t m = 0;
+
+    for (; m + 6 <= CountM; m += 6) {
+        MlasBlockSparseSgemmKernelAvx2Tile<6>(A + m * lda, lda, BlockRowK, Values, BlockCount,
+            C + m * ldc, ldc, CountN, alpha);
+    }
+
+    if (m + 3 <= CountM) {
+        MlasBlockSparseSgemmKernelAvx2Tile<3>(A + m * lda, lda, BlockRowK, Values, BlockCount,
+            C + m * ldc, ldc, CountN, alpha);
+        m += 3;
+    }
+
+    for (; m < CountM; m++) {
+        MlasBlockSparseSgemmKernelAvx2Tile<1>(A + m * lda, lda, BlockRowK, Values, BlockCount,
+            C + m * ldc, ldc, CountN, alpha);
+    }
+}
+
+template<size_t RowCount, typename AType>
+MLAS_FORCEINLINE
+void
+MlasBlockSparseQgemmKernelAvx2Tile(
+    const AType* A,
+    size_t lda,
+    int32_t ZeroPointA,
+    const uint32_t* BlockRowK,
+    const int16_t* Values,
+    size_t BlockCount,
+    int32_t* C,
+    size_t ldc,
+    size_t CountN
+    )
+{
+    __m256i Accumulators[RowCount][2];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r][0] = _mm256_setzero_si256();
+        Accumulators[r][1] = _mm256_setzero_si256();
+    }
+
+    for (size_t b = 0; b < BlockCount; b += 2) {
+
+        const AType* a0 = A + BlockRowK[b];
+        const AType* a1 = A + BlockRowK[b + 1];
+
+        const __m256i B0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Values));
+        const __m256i B1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(Values + 16));
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const int32_t AValue0 = int32_t(a0[r * lda]) - ZeroPointA;
+            const int32_t AValue1 = int32_t(a1[r * lda]) - ZeroPointA;
+            const __m256i APair = _mm256_set1_epi32(int32_t((uint32_t(AValue1) << 16) | (uint32_t(AValue0) & 0xFFFF)));
+            Accumulators[r][0] = _mm256_add_epi32(Accumulators[r][0], _mm256_madd_epi16(B0, APair));
+            Accumulators[r][1] = _mm256_add_epi32(Accumulators[r][1], _mm256_madd_epi16(B1, APair));
+        }
+
+        Values += 2 * MLAS_BLOCK_SPARSE_GEMM_BLOCK_N;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        int32_t* c = C + r * ldc;
+
+        if (CountN == MLAS_BLOCK_SPARSE_GEMM_BLOCK_N) {
+
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(c), Accumulators[r][0]);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(c + 8), Accumulators[r][1]);
+
+        } else {
+
+            MLAS_DECLSPEC_ALIGN(int32_t Row[MLAS_BLOCK_SPARSE_GEMM_BLOCK_N], 32);
+
+            _mm256_store_si256(reinterpret_cast<__m256i*>(Row), Accumulators[r][0]);
+            _mm256_store_si256(reinterpret_cast<__m256i*>(Row + 8), Accumulators[r][1]);
+
+            std::copy_n(Row, CountN, c);
+        }
+    }
+}
+
+template<typename AType>
+void
+MlasBlockSparseQgemmKernelAvx2Rows(
+    const AType* A,
+    size_t lda,
+    int32_t ZeroPointA,
+    const uint32_t* BlockRowK,
+    const int16_t* Values,
+    size_t BlockCount,
+    int32_t* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN
+    )
+{
+    size_t m = 0;
+
+    for (; m + 6 <= CountM; m += 6) {
+        MlasBlockSparseQgemmKernelAvx2Tile<6>(A + m * lda, lda, ZeroPointA, BlockRowK, Values, BlockCount,
+            C + m * ldc, ldc, CountN);
+    }
+
+    if (m + 3 <= CountM) {
+        MlasBlockSparseQgemmKernelAvx2Tile<3>(A + m * lda, lda, ZeroPointA, BlockRowK, Values, BlockCount,
+            C + m * ldc, ldc, CountN);
+        m += 3;
+    }
+
+    for (; m < CountM; m++) {
+        MlasBlockSparseQgemmKernelAvx2Tile<1>(A + m * lda, lda, ZeroPointA, BlockRowK, Values, BlockCount,
+            C + m * ldc, ldc, CountN);
+    }
+}
+
+void
+MLASCALL
+MlasBlockSparseQgemmKernelAvx2(
+    const uint8_t* A,
+    size_t lda,
+    int32_t ZeroPointA,
+    bool AIsSigned,
+    const uint32_t* BlockRowK,
+    const int16_t* Values,
+    size_t BlockCount,
+    int32_t* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN
+    )
+{
+    if (AIsSigned) {
+        MlasBlockSparseQgemmKernelAvx2Rows(reinterpret_cast<const int8_t*>(A), lda, ZeroPointA,
+            BlockRowK, Values, BlockCount, C, ldc, CountM, CountN);
+    } else {
+        MlasBlockSparseQgemmKernelAvx2Rows(A, lda, ZeroPointA,
+            BlockRowK, Values, BlockCount, C, ldc, CountM, CountN);
+    }
+}
@@ -0,0 +1,208 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_avx512bf16.cpp
+
+Abstract:
+
+    This module implements the bfloat16 matrix/matrix multiply kernel with
+    AVX512 BF16 instructions.
+
+    Pairs of rows from matrix B are interleaved in registers so that VDPBF16PS
+    accumulates two products per single precision lane.
+
+--*/
+
+#include "mlasi.h"
+
+MLAS_FORCEINLINE
+__m512i
+MlasBf16GemmLoadPair(
+    const uint16_t* B,
+    size_t ldb,
+    bool HasSecondRow,
+    __mmask16 Mask,
+    __m512i Interleave
+    )
+{
+    __m256i Row0 = _mm256_maskz_loadu_epi16(Mask, B);
+    __m256i Row1 = HasSecondRow ? _mm256_maskz_loadu_epi16(Mask, B + ldb) : _mm256_setzero_si256();
+
+    __m512i Rows = _mm512_inserti64x4(_mm512_castsi256_si512(Row0), Row1, 1);
+
+    return _mm512_permutexvar_epi16(Interleave, Rows);
+}
+
+MLAS_FORCEINLINE
+__m512
+MlasBf16GemmBroadcastPair(
+    const uint16_t* A,
+    bool HasSecondElement
+    )
+{
+    uint32_t Pair = uint32_t(A[0]);
+
+    if (HasSecondElement) {
+        Pair |= uint32_t(A[1]) << 16;
+    }
+
+    return _mm512_castsi512_ps(_mm512_set1_epi32(int32_t(Pair)));
+}
+
+MLAS_FORCEINLINE
+__m512
+MlasBf16GemmDotProduct(
+    __m512 Accumulator,
+    __m512 APair,
+    __m512i BPairs
+    )
+{
+    return _mm512_dpbf16_ps(Accumulator, (__m512bh)_mm512_castps_si512(APair), (__m512bh)BPairs);
+}
+
+MLAS_FORCEINLINE
+void
+MlasBf16GemmStoreVector(
+    uint16_t* Buffer,
+    __m512 Vector,
+    __mmask16 Mask
+    )
+{
+    _mm256_mask_storeu_epi16(Buffer, Mask, (__m256i)_mm512_cvtneps_pbh(Vector));
+}
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasBf16GemmKernelAvx512Bf16Block(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    )
+{
+    constexpr size_t StrideN = 32;
+
+    //
+    // Element 2*j of the interleaved vector is column j of the first row and
+    // element 2*j+1 is column j of the second row.
+    //
+
+    const __m512i Interleave = _mm512_set_epi16(
+        31, 15, 30, 14, 29, 13, 28, 12, 27, 11, 26, 10, 25, 9, 24, 8,
+        23, 7, 22, 6, 21, 5, 20, 4, 19, 3, 18, 2, 17, 1, 16, 0);
+
+    for (size_t n = 0; n < CountN; n += StrideN) {
+
+        const size_t CountBlockN = std::min(CountN - n, StrideN);
+
+        const __mmask16 Mask0 = (CountBlockN >= 16) ?
+            __mmask16(0xFFFF) : __mmask16((1u << CountBlockN) - 1);
+        const __mmask16 Mask1 = (CountBlockN >= 32) ?
+            __mmask16(0xFFFF) : (CountBlockN > 16) ? __mmask16((1u << (CountBlockN - 16)) - 1) : __mmask16(0);
+
+        __m512 Accumulator00 = _mm512_setzero_ps();
+        __m512 Accumulator01 = _mm512_setzero_ps();
+        __m512 Accumulator10 = _mm512_setzero_ps();
+        __m512 Accumulator11 = _mm512_setzero_ps();
+        __m512 Accumulator20 = _mm512_setzero_ps();
+        __m512 Accumulator21 = _mm512_setzero_ps();
+        __m512 Accumulator30 = _mm512_setzero_ps();
+        __m512 Accumulator31 = _mm512_setzero_ps();
+
+        const uint16_t* a = A;
+        const uint16_t* b = B + n;
+
+        for (size_t k = 0; k < CountK; k += 2) {
+
+            const bool HasSecondRow = (k + 1 < CountK);
+
+            __m512i BPairs0 = MlasBf16GemmLoadPair(b, ldb, HasSecondRow, Mask0, Interleave);
+            __m512i BPairs1 = MlasBf16GemmLoadPair(b + 16, ldb, HasSecondRow, Mask1, Interleave);
+            __m512 APair;
+
+            APair = MlasBf16GemmBroadcastPair(a, HasSecondRow);
+            Accumulator00 = MlasBf16GemmDotProduct(Accumulator00, APair, BPairs0);
+            Accumulator01 = MlasBf16GemmDotProduct(Accumulator01, APair, BPairs1);
+
+            if (RowCount >= 2) {
+                APair = MlasBf16GemmBroadcastPair(a + lda, HasSecondRow);
+                Accumulator10 = MlasBf16GemmDotProduct(Accumulator10, APair, BPairs0);
+                Accumulator11 = MlasBf16GemmDotProduct(Accumulator11, APair, BPairs1);
+            }
+
+            if (RowCount >= 3) {
+                APair = MlasBf16GemmBroadcastPair(a + lda * 2, HasSecondRow);
+                Accumulator20 = MlasBf16GemmDotProduct(Accumulator20, APair, BPairs0);
+                Accumulator21 = MlasBf16GemmDotProduct(Accumulator21, APair, BPairs1);
+            }
+
+            if (RowCount >= 4) {
+                APair = MlasBf16GemmBroadcastPair(a + lda * 3, HasSecondRow);
+                Accumulator30 = MlasBf16GemmDotProduct(Accumulator30, APair, BPairs0);
+                Accumulator31 = MlasBf16GemmDotProduct(Accumulator31, APair, BPairs1);
+            }
+
+            a += 2;
+            b += ldb * 2;
+        }
+
+        uint16_t* c = C + n;
+
+        MlasBf16GemmStoreVector(c, Accumulator00, Mask0);
+        MlasBf16GemmStoreVector(c + 16, Accumulator01, Mask1);
+
+        if (RowCount >= 2) {
+            MlasBf16GemmStoreVector(c + ldc, Accumulator10, Mask0);
+            MlasBf16GemmStoreVector(c + ldc + 16, Accumulator11, Mask1);
+        }
+
+        if (RowCount >= 3) {
+            MlasBf16GemmStoreVector(c + ldc * 2, Accumulator20, Mask0);
+            MlasBf16GemmStoreVector(c + ldc * 2 + 16, Accumulator21, Mask1);
+        }
+
+        if (RowCount >= 4) {
+            MlasBf16GemmStoreVector(c + ldc * 3, Accumulator30, Mask0);
+            MlasBf16GemmStoreVector(c + ldc * 3 + 16, Accumulator31, Mask1);
+        }
+    }
+}
+
+size_t
+MLASCALL
+MlasBf16GemmKernelAvx512Bf16(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    )
+{
+    if (CountM >= 4) {
+        MlasBf16GemmKernelAvx512Bf16Block<4>(A, B, C, CountK, CountN, lda, ldb, ldc);
+        return 4;
+    } else if (CountM == 3) {
+        MlasBf16GemmKernelAvx512Bf16Block<3>(A, B, C, CountK, CountN, lda, ldb, ldc);
+        return 3;
+    } else if (CountM == 2) {
+        MlasBf16GemmKernelAvx512Bf16Block<2>(A, B, C, CountK, CountN, lda, ldb, ldc);
+        return 2;
+    } else {
+        MlasBf16GemmKernelAvx512Bf16Block<1>(A, B, C, CountK, CountN, lda, ldb, ldc);
+        return 1;
+    }
+}
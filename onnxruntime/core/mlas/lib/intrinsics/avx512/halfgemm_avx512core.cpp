@@ -0,0 +1,238 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    halfgemm_avx512core.cpp
+
+Abstract:
+
+    This module implements the half precision (fp16) and bfloat16 matrix/matrix
+    multiply kernels with AVX512 core instructions.
+
+    The 16-bit elements of matrix B are widened to single precision in
+    registers, so the products are accumulated using single precision FMA.
+
+--*/
+
+#include "mlasi.h"
+
+template<bool IsBf16>
+MLAS_FORCEINLINE
+__m512
+MlasHalfGemmLoadVector(
+    const uint16_t* Buffer,
+    __mmask16 Mask
+    )
+{
+    __m256i Vector = _mm256_maskz_loadu_epi16(Mask, Buffer);
+
+    if (IsBf16) {
+        return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(Vector), 16));
+    } else {
+        return _mm512_cvtph_ps(Vector);
+    }
+}
+
+template<bool IsBf16>
+MLAS_FORCEINLINE
+__m512
+MlasHalfGemmBroadcastElement(
+    const uint16_t* Buffer
+    )
+{
+    if (IsBf16) {
+        return _mm512_set1_ps(MlasBf16ToFp32(*Buffer));
+    } else {
+        return _mm512_set1_ps(_cvtsh_ss(*Buffer));
+    }
+}
+
+template<bool IsBf16>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmStoreVector(
+    uint16_t* Buffer,
+    __m512 Vector,
+    __mmask16 Mask
+    )
+{
+    __m256i HalfVector;
+
+    if (IsBf16) {
+
+        //
+        // Round to nearest even and force NaNs to stay quiet NaNs.
+        //
+
+        __m512i Bits = _mm512_castps_si512(Vector);
+        __m512i Lsb = _mm512_and_si512(_mm512_srli_epi32(Bits, 16), _mm512_set1_epi32(1));
+        __m512i Rounded = _mm512_add_epi32(Bits, _mm512_add_epi32(Lsb, _mm512_set1_epi32(0x7FFF)));
+        __mmask16 NanMask = _mm512_cmp_ps_mask(Vector, Vector, _CMP_UNORD_Q);
+        Rounded = _mm512_mask_or_epi32(Rounded, NanMask, Bits, _mm512_set1_epi32(0x00400000));
+        HalfVector = _mm512_cvtepi32_epi16(_mm512_srli_epi32(Rounded, 16));
+
+    } else {
+
+        HalfVector = _mm512_cvtps_ph(Vector, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    }
+
+    _mm256_mask_storeu_epi16(Buffer, Mask, HalfVector);
+}
+
+template<bool IsBf16, size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasHalfGemmKernelAvx512CoreBlock(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    )
+{
+    constexpr size_t StrideN = 32;
+
+    for (size_t n = 0; n < CountN; n += StrideN) {
+
+        const size_t CountBlockN = std::min(CountN - n, StrideN);
+
+        const __mmask16 Mask0 = (CountBlockN >= 16) ?
+            __mmask16(0xFFFF) : __mmask16((1u << CountBlockN) - 1);
+        const __mmask16 Mask1 = (CountBlockN >= 32) ?
+            __mmask16(0xFFFF) : (CountBlockN > 16) ? __mmask16((1u << (CountBlockN - 16)) - 1) : __mmask16(0);
+
+        __m512 Accumulator00 = _mm512_setzero_ps();
+        __m512 Accumulator01 = _mm512_setzero_ps();
+        __m512 Accumulator10 = _mm512_setzero_ps();
+        __m512 Accumulator11 = _mm512_setzero_ps();
+        __m512 Accumulator20 = _mm512_setzero_ps();
+        __m512 Accumulator21 = _mm512_setzero_ps();
+        __m512 Accumulator30 = _mm512_setzero_ps();
+        __m512 Accumulator31 = _mm512_setzero_ps();
+
+        const uint16_t* a = A;
+        const uint16_t* b = B + n;
+
+        for (size_t k = 0; k < CountK; k++) {
+
+            __m512 BElements0 = MlasHalfGemmLoadVector<IsBf16>(b, Mask0);
+            __m512 BElements1 = MlasHalfGemmLoadVector<IsBf16>(b + 16, Mask1);
+            __m512 AElement;
+
+            AElement = MlasHalfGemmBroadcastElement<IsBf16>(a);
+            Accumulator00 = _mm512_fmadd_ps(AElement, BElements0, Accumulator00);
+            Accumulator01 = _mm512_fmadd_ps(AElement, BElements1, Accumulator01);
+
+            if (RowCount >= 2) {
+                AElement = MlasHalfGemmBroadcastElement<IsBf16>(a + lda);
+                Accumulator10 = _mm512_fmadd_ps(AElement, BElements0, Accumulator10);
+                Accumulator11 = _mm512_fmadd_ps(AElement, BElements1, Accumulator11);
+            }
+
+            if (RowCount >= 3) {
+                AElement = MlasHalfGemmBroadcastElement<IsBf16>(a + lda * 2);
+                Accumulator20 = _mm512_fmadd_ps(AElement, BElements0, Accumulator20);
+                Accumulator21 = _mm512_fmadd_ps(AElement, BElements1, Accumulator21);
+            }
+
+            if (RowCount >= 4) {
+                AElement = MlasHalfGemmBroadcastElement<IsBf16>(a + lda * 3);
+                Accumulator30 = _mm512_fmadd_ps(AElement, BElements0, Accumulator30);
+                Accumulator31 = _mm512_fmadd_ps(AElement, BElements1, Accumulator31);
+            }
+
+            a += 1;
+            b += ldb;
+        }
+
+        uint16_t* c = C + n;
+
+        MlasHalfGemmStoreVector<IsBf16>(c, Accumulator00, Mask0);
+        MlasHalfGemmStoreVector<IsBf16>(c + 16, Accumulator01, Mask1);
+
+        if (RowCount >= 2) {
+            MlasHalfGemmStoreVector<IsBf16>(c + ldc, Accumulator10, Mask0);
+            MlasHalfGemmStoreVector<IsBf16>(c + ldc + 16, Accumulator11, Mask1);
+        }
+
+        if (RowCount >= 3) {
+            MlasHalfGemmStoreVector<IsBf16>(c + ldc * 2, Accumulator20, Mask0);
+            MlasHalfGemmStoreVector<IsBf16>(c + ldc * 2 + 16, Accumulator21, Mask1);
+        }
+
+        if (RowCount >= 4) {
+            MlasHalfGemmStoreVector<IsBf16>(c + ldc * 3, Accumulator30, Mask0);
+            MlasHalfGemmStoreVector<IsBf16>(c + ldc * 3 + 16, Accumulator31, Mask1);
+        }
+    }
+}
+
+template<bool IsBf16>
+size_t
+MlasHalfGemmKernelAvx512CoreImpl(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    )
+{
+    if (CountM >= 4) {
+        MlasHalfGemmKernelAvx512CoreBlock<IsBf16, 4>(A, B, C, CountK, CountN, lda, ldb, ldc);
+        return 4;
+    } else if (CountM == 3) {
+        MlasHalfGemmKernelAvx512CoreBlock<IsBf16, 3>(A, B, C, CountK, CountN, lda, ldb, ldc);
+        return 3;
+    } else if (CountM == 2) {
+        MlasHalfGemmKernelAvx512CoreBlock<IsBf16, 2>(A, B, C, CountK, CountN, lda, ldb, ldc);
+        return 2;
+    } else {
+        MlasHalfGemmKernelAvx512CoreBlock<IsBf16, 1>(A, B, C, CountK, CountN, lda, ldb, ldc);
+        return 1;
+    }
+}
+
+size_t
+MLASCALL
+MlasHalfGemmKernelAvx512Core(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    )
+{
+    return MlasHalfGemmKernelAvx512CoreImpl<false>(A, B, C, CountK, CountM, CountN, lda, ldb, ldc);
+}
+
+size_t
+MLASCALL
+MlasBf16GemmKernelAvx512Core(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    )
+{
+    return MlasHalfGemmKernelAvx512CoreImpl<true>(A, B, C, CountK, CountM, CountN, lda, ldb, ldc);
+}
@@ -0,0 +1,180 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernel for the single precision matrix/matrix
+    multiply operation with a blockwise 4-bit quantized matrix B using AVX512F
+    instructions.
+
+    Each group of 32 quantized elements is unpacked to two vectors of single
+    precision elements, which are scaled and offset by the block parameters
+    and accumulated with the elements of matrix A.
+
+--*/
+
+#include "../../q4gemm.h"
+
+MLAS_FORCEINLINE
+void
+MlasQ4GemmDequantizeGroup(
+    const uint8_t* QuantData,
+    __m512 Scale,
+    __m512 Offset,
+    __m512& Low,
+    __m512& High
+    )
+{
+    const __m128i LowMask = _mm_set1_epi8(0x0F);
+
+    __m128i Bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(QuantData));
+    __m128i LowBytes = _mm_and_si128(Bytes, LowMask);
+    __m128i HighBytes = _mm_and_si128(_mm_srli_epi16(Bytes, 4), LowMask);
+
+    Low = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(LowBytes));
+    High = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(HighBytes));
+
+    Low = _mm512_fmadd_ps(Low, Scale, Offset);
+    High = _mm512_fmadd_ps(High, Scale, Offset);
+}
+
+template<size_t ColumnCount>
+MLAS_FORCEINLINE
+void
+MlasQ4GemmKernelAvx512FBlock(
+    const float* A,
+    const float* TailA,
+    size_t CountFullK,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountK,
+    size_t BlkLen,
+    size_t ColumnStride,
+    const float* Bias
+    )
+{
+    const size_t BlockStride = MlasQ4GemmBlockStride(BlkLen);
+
+    __m512 Accumulators[ColumnCount];
+
+    for (size_t c = 0; c < ColumnCount; c++) {
+        Accumulators[c] = _mm512_setzero_ps();
+    }
+
+    const uint8_t* b = PackedB;
+
+    for (size_t k = 0; k < CountK; k += BlkLen) {
+
+        __m512 Scale[ColumnCount];
+        __m512 Offset[ColumnCount];
+
+        for (size_t c = 0; c < ColumnCount; c++) {
+            const float* Header = reinterpret_cast<const float*>(b + c * ColumnStride);
+            Scale[c] = _mm512_set1_ps(Header[0]);
+            Offset[c] = _mm512_set1_ps(Header[1]);
+        }
+
+        const uint8_t* QuantData = b + 2 * sizeof(float);
+        const size_t BlockEndK = std::min(k + BlkLen, CountK);
+
+        for (size_t kk = k; kk < BlockEndK; kk += MLAS_Q4GEMM_GROUP_SIZE) {
+
+            const float* a = (kk < CountFullK) ? A + kk : TailA;
+
+            __m512 ALow = _mm512_loadu_ps(a);
+            __m512 AHigh = _mm512_loadu_ps(a + 16);
+
+            for (size_t c = 0; c < ColumnCount; c++) {
+
+                __m512 Low;
+                __m512 High;
+
+                MlasQ4GemmDequantizeGroup(QuantData + c * ColumnStride, Scale[c], Offset[c], Low, High);
+
+                Accumulators[c] = _mm512_fmadd_ps(ALow, Low, Accumulators[c]);
+                Accumulators[c] = _mm512_fmadd_ps(AHigh, High, Accumulators[c]);
+            }
+
+            QuantData += MLAS_Q4GEMM_GROUP_SIZE / 2;
+        }
+
+        b += BlockStride;
+    }
+
+    for (size_t c = 0; c < ColumnCount; c++) {
+        float Sum = _mm512_reduce_add_ps(Accumulators[c]);
+        C[c] = (Bias != nullptr) ? Sum + Bias[c] : Sum;
+    }
+}
+
+void
+MLASCALL
+MlasQ4GemmKernelAvx512F(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlkLen,
+    const float* Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute a single row of a matrix
+    multiplication with a packed blockwise 4-bit quantized matrix B.
+
+Arguments:
+
+    A - Supplies the address of the row of matrix A.
+
+    PackedB - Supplies the address of the first packed column of matrix B.
+
+    C - Supplies the address of the row of matrix C.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    BlkLen - Supplies the number of quantized elements per block.
+
+    Bias - Supplies the optional bias vector for the columns of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t ColumnStride = MlasQ4GemmBlockCountK(CountK, BlkLen) * MlasQ4GemmBlockStride(BlkLen);
+
+    MLAS_DECLSPEC_ALIGN(float TailA[MLAS_Q4GEMM_GROUP_SIZE], 64);
+    const size_t CountFullK = MlasQ4GemmPrepareTailA(A, CountK, TailA);
+
+    //
+    // Process four columns at a time to reuse the elements of matrix A from
+    // registers.
+    //
+
+    size_t n = 0;
+
+    for (; n + 4 <= CountN; n += 4) {
+        MlasQ4GemmKernelAvx512FBlock<4>(A, TailA, CountFullK, PackedB + n * ColumnStride, C + n,
+            CountK, BlkLen, ColumnStride, (Bias != nullptr) ? Bias + n : nullptr);
+    }
+
+    for (; n < CountN; n++) {
+        MlasQ4GemmKernelAvx512FBlock<1>(A, TailA, CountFullK, PackedB + n * ColumnStride, C + n,
+            CountK, BlkLen, ColumnStride, (Bias != nullptr) ? Bias + n : nullptr);
+    }
+}
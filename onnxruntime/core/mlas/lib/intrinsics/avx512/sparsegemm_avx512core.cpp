@@ -0,0 +1,128 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparsegemm_avx512core.cpp
+
+Abstract:
+
+    This module implements the kernel for the quantized matrix/matrix
+    multiply operation with a block sparse matrix B using AVX512 core
+    (AVX512BW) instructions.
+
+    Each pair of blocks of matrix B is loaded to a single vector of
+    interleaved 16-bit elements and multiplied with the broadcast pair of
+    elements of matrix A for up to eight rows of matrix A. A partial panel of
+    columns is stored with a mask.
+
+--*/
+
+#include "../../mlasi.h"
+
+template<size_t RowCount, typename AType>
+MLAS_FORCEINLINE
+void
+MlasBlockSparseQgemmKernelAvx512CoreTile(
+    const AType* A,
+    size_t lda,
+    int32_t ZeroPointA,
+    const uint32_t* BlockRowK,
+    const int16_t* Values,
+    size_t BlockCount,
+    int32_t* C,
+    size_t ldc,
+    __mmask16 StoreMask
+    )
+{
+    __m512i Accumulators[RowCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r] = _mm512_setzero_si512();
+    }
+
+    for (size_t b = 0; b < BlockCount; b += 2) {
+
+        const AType* a0 = A + BlockRowK[b];
+        const AType* a1 = A + BlockRowK[b + 1];
+
+        const __m512i B0 = _mm512_loadu_si512(Values);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const int32_t AValue0 = int32_t(a0[r * lda]) - ZeroPointA;
+            const int32_t AValue1 = int32_t(a1[r * lda]) - ZeroPointA;
+            const __m512i APair = _mm512_set1_epi32(int32_t((uint32_t(AValue1) << 16) | (uint32_t(AValue0) & 0xFFFF)));
+            Accumulators[r] = _mm512_add_epi32(Accumulators[r], _mm512_madd_epi16(B0, APair));
+        }
+
+        Values += 2 * MLAS_BLOCK_SPARSE_GEMM_BLOCK_N;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        _mm512_mask_storeu_epi32(C + r * ldc, StoreMask, Accumulators[r]);
+    }
+}
+
+template<typename AType>
+void
+MlasBlockSparseQgemmKernelAvx512CoreRows(
+    const AType* A,
+    size_t lda,
+    int32_t ZeroPointA,
+    const uint32_t* BlockRowK,
+    const int16_t* Values,
+    size_t BlockCount,
+    int32_t* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN
+    )
+{
+    const __mmask16 StoreMask = __mmask16((1u << CountN) - 1);
+
+    size_t m = 0;
+
+    for (; m + 8 <= CountM; m += 8) {
+        MlasBlockSparseQgemmKernelAvx512CoreTile<8>(A + m * lda, lda, ZeroPointA, BlockRowK, Values, BlockCount,
+            C + m * ldc, ldc, StoreMask);
+    }
+
+    if (m + 4 <= CountM) {
+        MlasBlockSparseQgemmKernelAvx512CoreTile<4>(A + m * lda, lda, ZeroPointA, BlockRowK, Values, BlockCount,
+            C + m * ldc, ldc, StoreMask);
+        m += 4;
+    }
+
+    for (; m < CountM; m++) {
+        MlasBlockSparseQgemmKernelAvx512CoreTile<1>(A + m * lda, lda, ZeroPointA, BlockRowK, Values, BlockCount,
+            C + m * ldc, ldc, StoreMask);
+    }
+}
+
+void
+MLASCALL
+MlasBlockSparseQgemmKernelAvx512Core(
+    const uint8_t* A,
+    size_t lda,
+    int32_t ZeroPointA,
+    bool AIsSigned,
+    const uint32_t* BlockRowK,
+    const int16_t* Values,
+    size_t BlockCount,
+    int32_t* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN
+    )
+{
+    if (AIsSigned) {
+        MlasBlockSparseQgemmKernelAvx512CoreRows(reinterpret_cast<const int8_t*>(A), lda, ZeroPointA,
+            BlockRowK, Values, BlockCount, C, ldc, CountM, CountN);
+    } else {
+        MlasBlockSparseQgemmKernelAvx512CoreRows(A, lda, ZeroPointA,
+            BlockRowK, Values, BlockCount, C, ldc, CountM, CountN);
+    }
+}
@@ -0,0 +1,100 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparsegemm_avx512f.cpp
+
+Abstract:
+
+    This module implements the kernel for the single precision matrix/matrix
+    multiply operation with a block sparse matrix B using AVX512F
+    instructions.
+
+    Each block of matrix B is loaded to a single vector and multiplied with
+    the broadcast element of matrix A for up to eight rows of matrix A. A
+    partial panel of columns is stored with a mask.
+
+--*/
+
+#include "../../mlasi.h"
+
+template<size_t RowCount>
+MLAS_FORCEINLINE
+void
+MlasBlockSparseSgemmKernelAvx512FTile(
+    const float* A,
+    size_t lda,
+    const uint32_t* BlockRowK,
+    const float* Values,
+    size_t BlockCount,
+    float* C,
+    size_t ldc,
+    __mmask16 StoreMask,
+    float alpha
+    )
+{
+    __m512 Accumulators[RowCount];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        Accumulators[r] = _mm512_setzero_ps();
+    }
+
+    for (size_t b = 0; b < BlockCount; b++) {
+
+        const float* a = A + BlockRowK[b];
+
+        const __m512 B0 = _mm512_loadu_ps(Values);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            Accumulators[r] = _mm512_fmadd_ps(B0, _mm512_set1_ps(a[r * lda]), Accumulators[r]);
+        }
+
+        Values += MLAS_BLOCK_SPARSE_GEMM_BLOCK_N;
+    }
+
+    const __m512 AlphaBroadcast = _mm512_set1_ps(alpha);
+
+    for (size_t r = 0; r < RowCount; r++) {
+        _mm512_mask_storeu_ps(C + r * ldc, StoreMask, _mm512_mul_ps(Accumulators[r], AlphaBroadcast));
+    }
+}
+
+void
+MLASCALL
+MlasBlockSparseSgemmKernelAvx512F(
+    const float* A,
+    size_t lda,
+    const uint32_t* BlockRowK,
+    const float* Values,
+    size_t BlockCount,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    float alpha
+    )
+{
+    const __mmask16 StoreMask = __mmask16((1u << CountN) - 1);
+
+    size_t m = 0;
+
+    for (; m + 8 <= CountM; m += 8) {
+        MlasBlockSparseSgemmKernelAvx512FTile<8>(A + m * lda, lda, BlockRowK, Values, BlockCount,
+            C + m * ldc, ldc, StoreMask, alpha);
+    }
+
+    if (m + 4 <= CountM) {
+        MlasBlockSparseSgemmKernelAvx512FTile<4>(A + m * lda, lda, BlockRowK, Values, BlockCount,
+            C + m * ldc, ldc, StoreMask, alpha);
+        m += 4;
+    }
+
+    for (; m < CountM; m++) {
+        MlasBlockSparseSgemmKernelAvx512FTile<1>(A + m * lda, lda, BlockRowK, Values, BlockCount,
+            C + m * ldc, ldc, StoreMask, alpha);
+    }
+}
@@ -0,0 +1,316 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.cpp
+
+Abstract:
+
+    This module implements routines to compute the layer normalization and
+    skip layer normalization operations, optionally quantizing the output.
+
+--*/
+
+#include "layernorm.h"
+
+//
+// Define the parameters to execute segments of a layer normalization
+// operation on worker threads.
+//
+
+template<typename OutputType>
+struct MLAS_LAYERNORM_WORK_BLOCK {
+    ptrdiff_t ThreadCountN;
+    const float* Input;
+    OutputType* Output;
+    size_t N;
+    size_t D;
+    const MLAS_LAYERNORM_PARAMETERS* Parameters;
+    float OutputScale;
+    OutputType OutputZeroPoint;
+};
+
+void
+MLASCALL
+MlasLayerNormF32Kernel(
+    const float* Input,
+    const float* Skip,
+    float* SkipOutput,
+    float* Output,
+    size_t D,
+    const MLAS_LAYERNORM_PARAMETERS* Parameters,
+    float* Statistics
+    )
+{
+    MlasLayerNormKernel<MLAS_LAYERNORM_FLOAT32X4_TRAITS>(Input, Skip, SkipOutput, Output, D, Parameters, Statistics);
+}
+
+template<typename OutputType>
+void
+MlasLayerNormThreaded(
+    void* Context,
+    ptrdiff_t Index
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    layer normalization operation.
+
+Arguments:
+
+    Context - Supplies the pointer to the context for the threaded operation.
+
+    Index - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const auto* WorkBlock = (MLAS_LAYERNORM_WORK_BLOCK<OutputType>*)Context;
+    const MLAS_LAYERNORM_PARAMETERS* Parameters = WorkBlock->Parameters;
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t n;
+    size_t CountN;
+
+    MlasPartitionWork(Index, WorkBlock->ThreadCountN, WorkBlock->N, &n, &CountN);
+
+    const size_t D = WorkBlock->D;
+
+    //
+    // A quantized output is normalized to a buffer that stays in the cache
+    // and then quantized.
+    //
+
+    float* Buffer = nullptr;
+
+    if constexpr (!std::is_same<OutputType, float>::value) {
+        MlasThreadedBufAlloc(D * sizeof(float));
+        Buffer = reinterpret_cast<float*>(ThreadedBufHolder.get());
+    }
+
+    for (size_t row = n; row < n + CountN; row++) {
+
+        const size_t Offset = row * D;
+        const float* Skip = (Parameters->Skip != nullptr) ? Parameters->Skip + Offset : nullptr;
+        float* SkipOutput = (Parameters->SkipOutput != nullptr) ? Parameters->SkipOutput + Offset : nullptr;
+        float* Output;
+
+        if constexpr (std::is_same<OutputType, float>::value) {
+            Output = WorkBlock->Output + Offset;
+        } else {
+            Output = Buffer;
+        }
+
+        float Statistics[2];
+
+#if defined(MLAS_TARGET_AMD64)
+        GetMlasPlatform().LayerNormF32Kernel(WorkBlock->Input + Offset, Skip, SkipOutput, Output, D, Parameters,
+                                             Statistics);
+#else
+        MlasLayerNormF32Kernel(WorkBlock->Input + Offset, Skip, SkipOutput, Output, D, Parameters, Statistics);
+#endif
+
+        if (Parameters->Mean != nullptr) {
+            Parameters->Mean[row] = Statistics[0];
+        }
+
+        if (Parameters->InvStdDev != nullptr) {
+            Parameters->InvStdDev[row] = Statistics[1];
+        }
+
+        if constexpr (!std::is_same<OutputType, float>::value) {
+            MlasQuantizeLinear(Buffer, WorkBlock->Output + Offset, D, WorkBlock->OutputScale,
+                               WorkBlock->OutputZeroPoint);
+        }
+    }
+}
+
+template<typename OutputType>
+void
+MlasLayerNormExecute(
+    MLAS_LAYERNORM_WORK_BLOCK<OutputType>* WorkBlock,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    const size_t N = WorkBlock->N;
+    const size_t D = WorkBlock->D;
+
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Limit the number of threads to the number of rows and try to
+    // keep each thread processing a minimum number of elements before using
+    // another thread.
+    //
+
+    ptrdiff_t ThreadCountN = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (size_t(ThreadCountN) > N) {
+        ThreadCountN = ptrdiff_t(N);
+    }
+
+    constexpr size_t MinimumElementsPerThread = 16384;
+
+    size_t BlockCount = ((N * D) / MinimumElementsPerThread) + 1;
+
+    if (size_t(ThreadCountN) > BlockCount) {
+        ThreadCountN = ptrdiff_t(BlockCount);
+    }
+
+    WorkBlock->ThreadCountN = ThreadCountN;
+
+    MlasExecuteThreaded(MlasLayerNormThreaded<OutputType>, WorkBlock, ThreadCountN, ThreadPool);
+}
+
+void
+MLASCALL
+MlasLayerNormalization(
+    const float* Input,
+    float* Output,
+    size_t N,
+    size_t D,
+    const MLAS_LAYERNORM_PARAMETERS* Parameters,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the layer normalization or the skip layer
+    normalization operation.
+
+    N.B. This implementation supports in place updates of the output buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of elements per row to process.
+
+    Parameters - Supplies the optional inputs and outputs and the form of the
+        normalization.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_LAYERNORM_WORK_BLOCK<float> WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.OutputScale = 1.0f;
+    WorkBlock.OutputZeroPoint = 0.0f;
+
+    MlasLayerNormExecute(&WorkBlock, ThreadPool);
+}
+
+template<typename OutputType>
+void
+MLASCALL
+MlasLayerNormalizationQuantizeLinear(
+    const float* Input,
+    OutputType* Output,
+    size_t N,
+    size_t D,
+    const MLAS_LAYERNORM_PARAMETERS* Parameters,
+    float OutputScale,
+    OutputType OutputZeroPoint,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine computes the layer normalization or the skip layer
+    normalization operation and quantizes the output, which feeds a following
+    quantized operator without a separate quantization pass.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    Output - Supplies the quantized output buffer.
+
+    N - Supplies the number of rows to process.
+
+    D - Supplies the number of elements per row to process.
+
+    Parameters - Supplies the optional inputs and outputs and the form of the
+        normalization.
+
+    OutputScale - Supplies the quantization scale of the output.
+
+    OutputZeroPoint - Supplies the quantization zero point of the output.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_LAYERNORM_WORK_BLOCK<OutputType> WorkBlock;
+
+    WorkBlock.Input = Input;
+    WorkBlock.Output = Output;
+    WorkBlock.N = N;
+    WorkBlock.D = D;
+    WorkBlock.Parameters = Parameters;
+    WorkBlock.OutputScale = OutputScale;
+    WorkBlock.OutputZeroPoint = OutputZeroPoint;
+
+    MlasLayerNormExecute(&WorkBlock, ThreadPool);
+}
+
+template
+void
+MLASCALL
+MlasLayerNormalizationQuantizeLinear<int8_t>(
+    const float* Input,
+    int8_t* Output,
+    size_t N,
+    size_t D,
+    const MLAS_LAYERNORM_PARAMETERS* Parameters,
+    float OutputScale,
+    int8_t OutputZeroPoint,
+    MLAS_THREADPOOL* ThreadPool
+    );
+
+template
+void
+MLASCALL
+MlasLayerNormalizationQuantizeLinear<uint8_t>(
+    const float* Input,
+    uint8_t* Output,
+    size_t N,
+    size_t D,
+    const MLAS_LAYERNORM_PARAMETERS* Parameters,
+    float OutputScale,
+    uint8_t OutputZeroPoint,
+    MLAS_THREADPOOL* ThreadPool
+    );
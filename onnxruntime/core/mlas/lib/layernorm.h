@@ -0,0 +1,240 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    layernorm.h
+
+Abstract:
+
+    This module implements the layer normalization kernel for a row, shared
+    by the vector instruction sets through a traits type.
+
+    The first pass over the row adds the optional skip and bias inputs and
+    computes the statistics with Welford's algorithm in each vector lane. The
+    lanes have the same number of elements, so they are merged pairwise. The
+    second pass normalizes the row, which is still in the cache.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+//
+// Traits for the MLAS_FLOAT32X4 vector type.
+//
+
+struct MLAS_LAYERNORM_FLOAT32X4_TRAITS {
+
+    typedef MLAS_FLOAT32X4 Vector;
+
+    static constexpr size_t Width = 4;
+
+    static MLAS_FORCEINLINE Vector Load(const float* Buffer) { return MlasLoadFloat32x4(Buffer); }
+
+    static MLAS_FORCEINLINE void Store(float* Buffer, Vector Value) { MlasStoreFloat32x4(Buffer, Value); }
+
+    static MLAS_FORCEINLINE Vector Broadcast(float Value) { return MlasBroadcastFloat32x4(Value); }
+
+    static MLAS_FORCEINLINE Vector Add(Vector A, Vector B) { return MlasAddFloat32x4(A, B); }
+
+    static MLAS_FORCEINLINE Vector Subtract(Vector A, Vector B) { return MlasSubtractFloat32x4(A, B); }
+
+    static MLAS_FORCEINLINE Vector Multiply(Vector A, Vector B) { return MlasMultiplyFloat32x4(A, B); }
+
+    static MLAS_FORCEINLINE Vector MultiplyAdd(Vector A, Vector B, Vector C)
+    {
+        return MlasMultiplyAddFloat32x4(A, B, C);
+    }
+};
+
+template<typename Traits>
+void
+MlasLayerNormKernel(
+    const float* Input,
+    const float* Skip,
+    float* SkipOutput,
+    float* Output,
+    size_t D,
+    const MLAS_LAYERNORM_PARAMETERS* Parameters,
+    float* Statistics
+    )
+/*++
+
+Routine Description:
+
+    This routine normalizes a row of the layer normalization operation.
+
+    N.B. The output buffer may be the same as the input buffer.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Skip - Optionally supplies the skip row added to the input.
+
+    SkipOutput - Optionally supplies the buffer that receives the sum of the
+        input and skip rows.
+
+    Output - Supplies the output row.
+
+    D - Supplies the number of elements of the row.
+
+    Parameters - Supplies the bias, scale, shift, epsilon and the form of the
+        normalization.
+
+    Statistics - Supplies the buffer that receives the mean and the inverse
+        standard deviation of the row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    typedef typename Traits::Vector Vector;
+    constexpr size_t Width = Traits::Width;
+
+    const float* Bias = Parameters->Bias;
+    const bool Simplified = Parameters->Simplified;
+
+    //
+    // The sum of the input, skip and bias is staged in the output buffer when
+    // the input is modified.
+    //
+
+    const float* Values = (Skip == nullptr && Bias == nullptr) ? Input : Output;
+
+    Vector MeanVector = Traits::Broadcast(0.0f);
+    Vector M2Vector = Traits::Broadcast(0.0f);
+    size_t VectorCount = 0;
+    size_t d = 0;
+
+    for (; d + Width <= D; d += Width) {
+
+        Vector X = Traits::Load(Input + d);
+
+        if (Skip != nullptr) {
+            X = Traits::Add(X, Traits::Load(Skip + d));
+            if (SkipOutput != nullptr) {
+                Traits::Store(SkipOutput + d, X);
+            }
+        }
+
+        if (Bias != nullptr) {
+            X = Traits::Add(X, Traits::Load(Bias + d));
+        }
+
+        if (Values == Output) {
+            Traits::Store(Output + d, X);
+        }
+
+        if (Simplified) {
+            M2Vector = Traits::MultiplyAdd(X, X, M2Vector);
+        } else {
+            VectorCount++;
+            Vector Delta = Traits::Subtract(X, MeanVector);
+            MeanVector = Traits::MultiplyAdd(Delta, Traits::Broadcast(1.0f / float(VectorCount)), MeanVector);
+            M2Vector = Traits::MultiplyAdd(Delta, Traits::Subtract(X, MeanVector), M2Vector);
+        }
+    }
+
+    float Means[Width];
+    float M2s[Width];
+
+    Traits::Store(Means, MeanVector);
+    Traits::Store(M2s, M2Vector);
+
+    float Mean = 0.0f;
+    float M2 = 0.0f;
+    size_t Count = VectorCount;
+
+    if (Simplified) {
+        for (size_t w = 0; w < Width; w++) {
+            M2 += M2s[w];
+        }
+    } else {
+        for (size_t w = Width / 2; w > 0; w /= 2) {
+            for (size_t i = 0; i < w; i++) {
+                const float Delta = Means[i + w] - Means[i];
+                Means[i] = (Means[i] + Means[i + w]) * 0.5f;
+                M2s[i] = M2s[i] + M2s[i + w] + Delta * Delta * (float(Count) * 0.5f);
+            }
+            Count *= 2;
+        }
+        Mean = Means[0];
+        M2 = M2s[0];
+    }
+
+    for (; d < D; d++) {
+
+        float x = Input[d];
+
+        if (Skip != nullptr) {
+            x += Skip[d];
+            if (SkipOutput != nullptr) {
+                SkipOutput[d] = x;
+            }
+        }
+
+        if (Bias != nullptr) {
+            x += Bias[d];
+        }
+
+        if (Values == Output) {
+            Output[d] = x;
+        }
+
+        if (Simplified) {
+            M2 += x * x;
+        } else {
+            Count++;
+            const float Delta = x - Mean;
+            Mean += Delta / float(Count);
+            M2 += Delta * (x - Mean);
+        }
+    }
+
+    const float InverseD = (D > 0) ? 1.0f / float(D) : 0.0f;
+    const float InvStdDev = 1.0f / std::sqrt(std::max(M2 * InverseD, 0.0f) + Parameters->Epsilon);
+
+    Statistics[0] = Mean;
+    Statistics[1] = InvStdDev;
+
+    //
+    // Normalize the row.
+    //
+
+    const float* Scale = Parameters->Scale;
+    const float* Shift = Parameters->Shift;
+
+    const Vector MeanBroadcast = Traits::Broadcast(Mean);
+    const Vector InvStdDevBroadcast = Traits::Broadcast(InvStdDev);
+
+    for (d = 0; d + Width <= D; d += Width) {
+
+        Vector Y = Traits::Multiply(Traits::Subtract(Traits::Load(Values + d), MeanBroadcast),
+                                    Traits::Multiply(InvStdDevBroadcast, Traits::Load(Scale + d)));
+
+        if (Shift != nullptr) {
+            Y = Traits::Add(Y, Traits::Load(Shift + d));
+        }
+
+        Traits::Store(Output + d, Y);
+    }
+
+    for (; d < D; d++) {
+
+        float y = (Values[d] - Mean) * (InvStdDev * Scale[d]);
+
+        if (Shift != nullptr) {
+            y += Shift[d];
+        }
+
+        Output[d] = y;
+    }
+}
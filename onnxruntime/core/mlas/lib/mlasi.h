@@ -121,6 +121,8 @@ class MLASCPUIDInfo
     // ARM
     bool HasArmNeonDot() const { return has_arm_neon_dot_; }
 
+    bool HasArmNeon_I8MM() const { return has_arm_neon_i8mm_; }
+
     uint32_t GetCurrentCoreIdx() const { return 0xFFFFFFFF; }
 
     int32_t GetCurrentUarch() const { return -1; }
@@ -135,6 +137,7 @@ class MLASCPUIDInfo
     MLASCPUIDInfo();
 
     bool has_arm_neon_dot_{false};
+    bool has_arm_neon_i8mm_{false};
 };
 using MLAS_CPUIDINFO = MLASCPUIDInfo;
 
@@ -197,6 +200,8 @@ enum MlasUArch {
 #define MLAS_SGEMM_PACKED_STRIDEK                   256
 #define MLAS_DGEMM_STRIDEN                          64
 #define MLAS_DGEMM_STRIDEK                          128
+#define MLAS_HALF_GEMM_STRIDEN                      128
+#define MLAS_Q4GEMM_DEQUANT_STRIDEN                 32
 
 //
 // Define the alignment for segmenting a GEMM operation across multiple
@@ -210,6 +215,8 @@ enum MlasUArch {
 #define MLAS_SGEMM_STRIDEN_THREAD_ALIGN             16
 #define MLAS_DGEMM_STRIDEN_THREAD_ALIGN             8
 #define MLAS_QGEMM_STRIDEN_THREAD_ALIGN             16
+#define MLAS_HALF_GEMM_STRIDEN_THREAD_ALIGN         32
+#define MLAS_Q4GEMM_STRIDEN_THREAD_ALIGN            16
 
 //
 // Define the prototypes of the platform optimized routines.
@@ -279,6 +286,91 @@ size_t
 
 #endif
 
+typedef
+size_t
+(MLASCALL MLAS_HALF_GEMM_KERNEL)(
+    const uint16_t* A,
+    const uint16_t* B,
+    uint16_t* C,
+    size_t CountK,
+    size_t CountM,
+    size_t CountN,
+    size_t lda,
+    size_t ldb,
+    size_t ldc
+    );
+
+typedef
+void
+(MLASCALL MLAS_Q4GEMM_KERNEL)(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlkLen,
+    const float* Bias
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F16_TO_F32_KERNEL)(
+    const unsigned short* Source,
+    float* Destination,
+    size_t Count
+    );
+
+typedef
+void
+(MLASCALL MLAS_CAST_F32_TO_F16_KERNEL)(
+    const float* Source,
+    unsigned short* Destination,
+    size_t Count
+    );
+
+typedef
+void
+(MLASCALL MLAS_LAYERNORM_F32_KERNEL)(
+    const float* Input,
+    const float* Skip,
+    float* SkipOutput,
+    float* Output,
+    size_t D,
+    const MLAS_LAYERNORM_PARAMETERS* Parameters,
+    float* Statistics
+    );
+
+typedef
+void
+(MLASCALL MLAS_BLOCK_SPARSE_SGEMM_KERNEL)(
+    const float* A,
+    size_t lda,
+    const uint32_t* BlockRowK,
+    const float* Values,
+    size_t BlockCount,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    float alpha
+    );
+
+typedef
+void
+(MLASCALL MLAS_BLOCK_SPARSE_QGEMM_KERNEL)(
+    const uint8_t* A,
+    size_t lda,
+    int32_t ZeroPointA,
+    bool AIsSigned,
+    const uint32_t* BlockRowK,
+    const int16_t* Values,
+    size_t BlockCount,
+    int32_t* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN
+    );
+
 typedef
 void
 (MLASCALL MLAS_GEMV_FLOAT_KERNEL)(
@@ -676,6 +768,49 @@ extern "C" {
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL MlasReduceMinimumMaximumF32KernelAvx;
 #endif
 
+    MLAS_LAYERNORM_F32_KERNEL MlasLayerNormF32Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_LAYERNORM_F32_KERNEL MlasLayerNormF32KernelAvx2;
+    MLAS_LAYERNORM_F32_KERNEL MlasLayerNormF32KernelAvx512F;
+#endif
+
+    MLAS_HALF_GEMM_KERNEL MlasHalfGemmKernel;
+    MLAS_HALF_GEMM_KERNEL MlasBf16GemmKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_HALF_GEMM_KERNEL MlasHalfGemmKernelAvx512Core;
+    MLAS_HALF_GEMM_KERNEL MlasBf16GemmKernelAvx512Core;
+    MLAS_HALF_GEMM_KERNEL MlasBf16GemmKernelAvx512Bf16;
+    MLAS_HALF_GEMM_KERNEL MlasBf16GemmKernelAmx;
+#elif defined(MLAS_TARGET_ARM64)
+    MLAS_HALF_GEMM_KERNEL MlasHalfGemmKernelNeon;
+    MLAS_HALF_GEMM_KERNEL MlasBf16GemmKernelNeon;
+#endif
+
+    MLAS_Q4GEMM_KERNEL MlasQ4GemmKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_Q4GEMM_KERNEL MlasQ4GemmKernelAvx2;
+    MLAS_Q4GEMM_KERNEL MlasQ4GemmKernelAvx512F;
+#endif
+
+    MLAS_CAST_F16_TO_F32_KERNEL MlasCastF16ToF32Kernel;
+    MLAS_CAST_F32_TO_F16_KERNEL MlasCastF32ToF16Kernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_CAST_F16_TO_F32_KERNEL MlasCastF16ToF32KernelAvx2;
+    MLAS_CAST_F32_TO_F16_KERNEL MlasCastF32ToF16KernelAvx2;
+#endif
+
+    MLAS_BLOCK_SPARSE_SGEMM_KERNEL MlasBlockSparseSgemmKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_BLOCK_SPARSE_SGEMM_KERNEL MlasBlockSparseSgemmKernelAvx2;
+    MLAS_BLOCK_SPARSE_SGEMM_KERNEL MlasBlockSparseSgemmKernelAvx512F;
+#endif
+
+    MLAS_BLOCK_SPARSE_QGEMM_KERNEL MlasBlockSparseQgemmKernel;
+#if defined(MLAS_TARGET_AMD64)
+    MLAS_BLOCK_SPARSE_QGEMM_KERNEL MlasBlockSparseQgemmKernelAvx2;
+    MLAS_BLOCK_SPARSE_QGEMM_KERNEL MlasBlockSparseQgemmKernelAvx512Core;
+#endif
+
 }
 
 //
@@ -703,6 +838,9 @@ extern "C" {
 #define MLAS_SGEMM_THREAD_COMPLEXITY                (64 * 1024)
 #define MLAS_DGEMM_THREAD_COMPLEXITY                (64 * 1024)
 #define MLAS_QGEMM_THREAD_COMPLEXITY                (64 * 1024)
+#define MLAS_HALF_GEMM_THREAD_COMPLEXITY            (64 * 1024)
+#define MLAS_Q4GEMM_THREAD_COMPLEXITY               (64 * 1024)
+#define MLAS_BLOCK_SPARSE_GEMM_THREAD_COMPLEXITY    (64 * 1024)
 
 //
 // Single-threaded single precision matrix/matrix multiply operation.
@@ -722,7 +860,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_ACTIVATION* Activation = nullptr
     );
 
 //
@@ -735,10 +874,16 @@ extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8X8DispatchSse;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8S8DispatchSse41;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8S8DispatchAvx2;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8U8DispatchAvx2;
+extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8S8DispatchAmx;
+extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8U8DispatchAmx;
+extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmS8S8DispatchAmx;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8X8DispatchNeon;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmX8S8DispatchNeon;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8X8DispatchUdot;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmS8S8DispatchSdot;
+extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8S8DispatchI8mm;
+extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8U8DispatchI8mm;
+extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmS8S8DispatchI8mm;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8X8DispatchWasmSimd;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemmQuantDispatchDefault;
 extern const MLAS_GEMM_QUANT_DISPATCH MlasGemm8X8DispatchPOWER10;
@@ -825,23 +970,39 @@ enum MlasCoreType { mlas_core_unknown = 0, mlas_core_little = 2, mlas_core_big =
 
 struct MLAS_PLATFORM {
 
+#if defined(MLAS_TARGET_AMD64_IX86)
+    MLAS_PLATFORM(MLAS_ISA MaximumIsa = MlasIsaNative);
+#else
     MLAS_PLATFORM(void);
+#endif
 
 #if defined(MLAS_TARGET_AMD64_IX86) || defined(MLAS_TARGET_POWER)
     MLAS_GEMM_FLOAT_KERNEL* GemmFloatKernel;
 #endif
 
 #if defined(MLAS_TARGET_AMD64_IX86)
+    MLAS_ISA Isa;
     const MLAS_GEMM_QUANT_DISPATCH* GemmU8S8Dispatch;
     const MLAS_GEMM_QUANT_DISPATCH* GemmU8U8Dispatch;
+    const MLAS_GEMM_QUANT_DISPATCH* GemmS8S8Dispatch;
 #elif defined(MLAS_TARGET_ARM64)
     const MLAS_GEMM_QUANT_DISPATCH* GemmU8X8Dispatch;
+    const MLAS_GEMM_QUANT_DISPATCH* GemmU8S8Dispatch;
+    const MLAS_GEMM_QUANT_DISPATCH* GemmS8S8Dispatch;
 #endif
     const MLAS_SYMM_QGEMM_DISPATCH* SymmQgemmDispatch{nullptr};
 
     const MLAS_CONV_SYM_DISPATCH* ConvSymU8S8Dispatch{nullptr};
     const MLAS_CONV_SYM_DISPATCH* ConvSymS8S8Dispatch{nullptr};
 
+    MLAS_HALF_GEMM_KERNEL* HalfGemmKernel;
+    MLAS_HALF_GEMM_KERNEL* Bf16GemmKernel;
+    MLAS_Q4GEMM_KERNEL* Q4GemmKernel;
+    MLAS_BLOCK_SPARSE_SGEMM_KERNEL* BlockSparseSgemmKernel;
+    MLAS_BLOCK_SPARSE_QGEMM_KERNEL* BlockSparseQgemmKernel;
+    MLAS_CAST_F16_TO_F32_KERNEL* CastF16ToF32Kernel;
+    MLAS_CAST_F32_TO_F16_KERNEL* CastF32ToF16Kernel;
+
     MLAS_QUANT_KERNEL<uint8_t, int8_t>::DepthwiseKernel* ConvDepthwiseU8S8Kernel;
     MLAS_QUANT_KERNEL<uint8_t, uint8_t>::DepthwiseKernel* ConvDepthwiseU8U8Kernel;
     MLAS_QUANT_KERNEL<int8_t, int8_t>::DepthwiseKernel* ConvDepthwiseS8S8Kernel;
@@ -877,6 +1038,7 @@ struct MLAS_PLATFORM {
     MLAS_COMPUTE_LOGSOFTMAX_OUTPUT_FLOAT_KERNEL* ComputeLogSoftmaxOutputF32Kernel;
     MLAS_REDUCE_MAXIMUM_FLOAT_KERNEL* ReduceMaximumF32Kernel;
     MLAS_REDUCE_MINIMUM_MAXIMUM_FLOAT_KERNEL* ReduceMinimumMaximumF32Kernel;
+    MLAS_LAYERNORM_F32_KERNEL* LayerNormF32Kernel;
     MLAS_QUANTIZE_LINEAR_S8_KERNEL* QuantizeLinearS8Kernel;
     MLAS_QUANTIZE_LINEAR_U8_KERNEL* QuantizeLinearU8Kernel;
     uint32_t NchwcBlockSize;
@@ -1021,7 +1183,91 @@ MlasFp32FromBits(
 #pragma warning(pop)
 #endif
 
-#if defined(MLAS_TARGET_WASM_SCALAR)
+//
+// Helpers to convert between single precision and the 16-bit floating point
+// formats. Narrowing conversions round to nearest even.
+//
+
+MLAS_FORCEINLINE
+float
+MlasFp16ToFp32(
+    uint16_t HalfValue
+    )
+{
+    constexpr uint32_t ExponentMask = 0x7C00 << 13;
+
+    uint32_t Bits = (uint32_t(HalfValue) & 0x7FFF) << 13;
+    const uint32_t Exponent = Bits & ExponentMask;
+
+    Bits += (127 - 15) << 23;
+
+    if (Exponent == ExponentMask) {
+        Bits += (128 - 16) << 23;
+    } else if (Exponent == 0) {
+        Bits += 1 << 23;
+        Bits = MlasBitsOfFp32(MlasFp32FromBits(Bits) - MlasFp32FromBits(113 << 23));
+    }
+
+    return MlasFp32FromBits(Bits | ((uint32_t(HalfValue) & 0x8000) << 16));
+}
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFp32ToFp16(
+    float FloatValue
+    )
+{
+    constexpr uint32_t Fp32Infinity = 255 << 23;
+    constexpr uint32_t Fp16Maximum = (127 + 16) << 23;
+    constexpr uint32_t DenormalMagic = ((127 - 15) + (23 - 10) + 1) << 23;
+
+    uint32_t Bits = MlasBitsOfFp32(FloatValue);
+    const uint32_t Sign = Bits & 0x80000000;
+    uint32_t HalfBits;
+
+    Bits ^= Sign;
+
+    if (Bits >= Fp16Maximum) {
+        HalfBits = (Bits > Fp32Infinity) ? 0x7E00 : 0x7C00;
+    } else if (Bits < (113 << 23)) {
+        HalfBits = MlasBitsOfFp32(MlasFp32FromBits(Bits) + MlasFp32FromBits(DenormalMagic)) - DenormalMagic;
+    } else {
+        const uint32_t MantissaOdd = (Bits >> 13) & 1;
+        Bits += (uint32_t(15 - 127) << 23) + 0xFFF;
+        Bits += MantissaOdd;
+        HalfBits = Bits >> 13;
+    }
+
+    return uint16_t(HalfBits | (Sign >> 16));
+}
+
+MLAS_FORCEINLINE
+float
+MlasBf16ToFp32(
+    uint16_t Bf16Value
+    )
+{
+    return MlasFp32FromBits(uint32_t(Bf16Value) << 16);
+}
+
+MLAS_FORCEINLINE
+uint16_t
+MlasFp32ToBf16(
+    float FloatValue
+    )
+{
+    uint32_t Bits = MlasBitsOfFp32(FloatValue);
+
+    if ((Bits & 0x7FFFFFFF) > 0x7F800000) {
+        return uint16_t((Bits >> 16) | 0x0040);
+    }
+
+    Bits += 0x7FFF + ((Bits >> 16) & 1);
+
+    return uint16_t(Bits >> 16);
+}
+
+#if defined(MLAS_TARGET_WASM)
 
 void
 MLASCALL
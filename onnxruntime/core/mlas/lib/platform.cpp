@@ -24,6 +24,11 @@ Abstract:
 #include <sys/auxv.h>
 #endif
 
+#if defined(MLAS_AMX_INTRINSICS) && defined(__linux__)
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
 #if defined(MLAS_TARGET_ARM64)
 #if defined(_WIN32)
 
@@ -48,9 +53,16 @@ MLASCPUIDInfo::MLASCPUIDInfo()
 #ifndef HWCAP_ASIMDDP
 #define HWCAP_ASIMDDP (1 << 20)
 #endif
+#ifndef HWCAP2_I8MM
+#define HWCAP2_I8MM (1 << 13)
+#endif
 
 #if defined(BUILD_MLAS_NO_ONNXRUNTIME)
-MLASCPUIDInfo::MLASCPUIDInfo() { has_arm_neon_dot_ = ((getauxval(AT_HWCAP) & HWCAP_ASIMDDP) != 0); }
+MLASCPUIDInfo::MLASCPUIDInfo()
+{
+    has_arm_neon_dot_ = ((getauxval(AT_HWCAP) & HWCAP_ASIMDDP) != 0);
+    has_arm_neon_i8mm_ = ((getauxval(AT_HWCAP2) & HWCAP2_I8MM) != 0);
+}
 #endif
 
 #else
@@ -125,10 +137,47 @@ MlasReadExtendedControlRegister(
 #endif
 }
 
+#if defined(MLAS_AMX_INTRINSICS)
+
+bool
+MlasRequestAmxTileDataPermission(
+    void
+    )
+/*++
+
+Routine Description:
+
+    This routine requests permission from the operating system to use the
+    AMX tile data state. Linux disables the state for a process until it is
+    requested, so that the larger signal frames are only used by processes
+    that need them.
+
+Return Value:
+
+    Returns true if the AMX tile data state can be used.
+
+--*/
+{
+#if defined(__linux__)
+    constexpr long ArchReqXcompPerm = 0x1023;
+    constexpr long XfeatureXtiledata = 18;
+
+    return syscall(SYS_arch_prctl, ArchReqXcompPerm, XfeatureXtiledata) == 0;
+#else
+    return true;
+#endif
+}
+
+#endif
+
 #endif
 
 MLAS_PLATFORM::MLAS_PLATFORM(
+#if defined(MLAS_TARGET_AMD64_IX86)
+    MLAS_ISA MaximumIsa
+#else
     void
+#endif
     )
 /*++
 
@@ -138,7 +187,9 @@ Routine Description:
 
 Arguments:
 
-    None.
+    MaximumIsa - Supplies the highest instruction set level of the kernels
+        to select on x86/x64, lower than the processor supports when the
+        kernels of the lower levels are to be tested or benchmarked.
 
 Return Value:
 
@@ -151,6 +202,13 @@ Return Value:
     this->ConvDepthwiseU8U8Kernel = MlasConvDepthwiseKernel<uint8_t, uint8_t>;
     this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernel<int8_t, int8_t>;
     this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernel<int8_t, uint8_t>;
+    this->HalfGemmKernel = MlasHalfGemmKernel;
+    this->Bf16GemmKernel = MlasBf16GemmKernel;
+    this->Q4GemmKernel = MlasQ4GemmKernel;
+    this->BlockSparseSgemmKernel = MlasBlockSparseSgemmKernel;
+    this->BlockSparseQgemmKernel = MlasBlockSparseQgemmKernel;
+    this->CastF16ToF32Kernel = MlasCastF16ToF32Kernel;
+    this->CastF32ToF16Kernel = MlasCastF32ToF16Kernel;
 
 #if defined(MLAS_TARGET_AMD64_IX86)
 
@@ -161,6 +219,7 @@ Return Value:
     this->GemmFloatKernel = MlasGemmFloatKernelSse;
     this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchSse;
     this->GemmU8U8Dispatch = &MlasGemmU8X8DispatchSse;
+    this->GemmS8S8Dispatch = &MlasGemmQuantDispatchDefault;
 
 #if defined(MLAS_TARGET_AMD64)
 
@@ -182,6 +241,7 @@ Return Value:
     this->ComputeLogSoftmaxOutputF32Kernel = MlasComputeLogSoftmaxOutputF32Kernel;
     this->ReduceMaximumF32Kernel = MlasReduceMaximumF32Kernel;
     this->ReduceMinimumMaximumF32Kernel = MlasReduceMinimumMaximumF32Kernel;
+    this->LayerNormF32Kernel = MlasLayerNormF32Kernel;
     this->QLinearAddS8Kernel = MlasQLinearAddS8Kernel;
     this->QLinearAddU8Kernel = MlasQLinearAddU8Kernel;
     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8Kernel;
@@ -194,6 +254,8 @@ Return Value:
 
 #endif
 
+    this->Isa = MlasIsaSse2;
+
     unsigned Cpuid1[4];
 #if defined(_WIN32)
     __cpuid((int*)Cpuid1, 1);
@@ -217,7 +279,7 @@ Return Value:
     // Check if the processor supports the AVX and OSXSAVE features.
     //
 
-    if ((Cpuid1[2] & 0x18000000) == 0x18000000) {
+    if ((Cpuid1[2] & 0x18000000) == 0x18000000 && MaximumIsa >= MlasIsaAvx) {
 
         //
         // Check if the operating system supports saving SSE and AVX states.
@@ -227,6 +289,7 @@ Return Value:
 
         if ((xcr0 & 0x6) == 0x6) {
 
+            this->Isa = MlasIsaAvx;
             this->GemmFloatKernel = MlasGemmFloatKernelAvx;
 
 #if defined(MLAS_TARGET_AMD64)
@@ -259,8 +322,9 @@ Return Value:
             __cpuid_count(7, 0, Cpuid7[0], Cpuid7[1], Cpuid7[2], Cpuid7[3]);
 #endif
 
-            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0)) {
+            if (((Cpuid1[2] & 0x1000) != 0) && ((Cpuid7[1] & 0x20) != 0) && MaximumIsa >= MlasIsaAvx2) {
 
+                this->Isa = MlasIsaAvx2;
                 this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAvx2;
                 this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx2;
                 this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx2;
@@ -285,6 +349,12 @@ Return Value:
                 this->ConvDepthwiseS8S8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, int8_t>;
                 this->ConvDepthwiseS8U8Kernel = MlasConvDepthwiseKernelAvx2<int8_t, uint8_t>;
                 this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelFma3;
+                this->Q4GemmKernel = MlasQ4GemmKernelAvx2;
+                this->BlockSparseSgemmKernel = MlasBlockSparseSgemmKernelAvx2;
+                this->BlockSparseQgemmKernel = MlasBlockSparseQgemmKernelAvx2;
+                this->CastF16ToF32Kernel = MlasCastF16ToF32KernelAvx2;
+                this->CastF32ToF16Kernel = MlasCastF32ToF16KernelAvx2;
+                this->LayerNormF32Kernel = MlasLayerNormF32KernelAvx2;
 
                 //
                 // Check if the processor supports Hybrid core architecture.
@@ -305,8 +375,9 @@ Return Value:
                 __cpuid_count(7, 1, Cpuid7_1[0], Cpuid7_1[1], Cpuid7_1[2], Cpuid7_1[3]);
 #endif
 
-                if ((Cpuid7_1[0] & 0x10) != 0) {
+                if ((Cpuid7_1[0] & 0x10) != 0 && MaximumIsa >= MlasIsaAvxVnni) {
 
+                    this->Isa = MlasIsaAvxVnni;
                     this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
                     this->GemmU8S8Kernel = MlasGemmU8S8KernelAvxVnni;
                     this->GemvU8S8Kernel = MlasGemvU8S8KernelAvxVnni;
@@ -320,8 +391,9 @@ Return Value:
                 // operating system supports saving AVX512F state.
                 //
 
-                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0)) {
+                if (((Cpuid7[1] & 0x10000) != 0) && ((xcr0 & 0xE0) == 0xE0) && MaximumIsa >= MlasIsaAvx512F) {
 
+                    this->Isa = MlasIsaAvx512F;
                     this->GemmFloatKernel = MlasGemmFloatKernelAvx512F;
                     this->GemmDoubleKernel = MlasGemmDoubleKernelAvx512F;
                     this->ConvNchwFloatKernel = MlasConvNchwFloatKernelAvx512F;
@@ -335,6 +407,9 @@ Return Value:
                     this->ComputeSumExpF32Kernel = MlasComputeSumExpF32KernelAvx512F;
                     this->QuantizeLinearS8Kernel = MlasQuantizeLinearS8KernelAvx512F;
                     this->QuantizeLinearU8Kernel = MlasQuantizeLinearU8KernelAvx512F;
+                    this->Q4GemmKernel = MlasQ4GemmKernelAvx512F;
+                    this->BlockSparseSgemmKernel = MlasBlockSparseSgemmKernelAvx512F;
+                    this->LayerNormF32Kernel = MlasLayerNormF32KernelAvx512F;
                     this->NchwcBlockSize = 16;
                     this->PreferredBufferAlignment = 64;
 
@@ -343,24 +418,81 @@ Return Value:
                     // (AVX512BW/AVX512DQ/AVX512VL).
                     //
 
-                    if ((Cpuid7[1] & 0xC0020000) == 0xC0020000) {
+                    if ((Cpuid7[1] & 0xC0020000) == 0xC0020000 && MaximumIsa >= MlasIsaAvx512Core) {
 
+                        this->Isa = MlasIsaAvx512Core;
                         this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Core;
                         this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Core;
                         this->GemmU8U8Kernel = MlasGemmU8U8KernelAvx512Core;
                         this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Core;
+                        this->HalfGemmKernel = MlasHalfGemmKernelAvx512Core;
+                        this->Bf16GemmKernel = MlasBf16GemmKernelAvx512Core;
+                        this->BlockSparseQgemmKernel = MlasBlockSparseQgemmKernelAvx512Core;
 
                         //
                         // Check if the processor supports AVX512VNNI.
                         //
 
-                        if ((Cpuid7[2] & 0x800) != 0) {
+                        if ((Cpuid7[2] & 0x800) != 0 && MaximumIsa >= MlasIsaAvx512Vnni) {
 
+                            this->Isa = MlasIsaAvx512Vnni;
                             this->GemmU8U8Dispatch = &MlasGemmU8S8DispatchAvx2;
                             this->GemmU8S8Kernel = MlasGemmU8S8KernelAvx512Vnni;
                             this->GemvU8S8Kernel = MlasGemvU8S8KernelAvx512Vnni;
                             this->ConvSymU8S8Dispatch = &MlasConvSymDispatchAvx512Vnni;
                         }
+
+#if defined(MLAS_AVX512BF16_INTRINSICS)
+
+                        //
+                        // Check if the processor supports AVX512BF16.
+                        //
+
+                        if ((Cpuid7_1[0] & 0x20) != 0) {
+
+                            this->Bf16GemmKernel = MlasBf16GemmKernelAvx512Bf16;
+                        }
+
+#endif
+
+#if defined(MLAS_AMX_INTRINSICS)
+
+                        //
+                        // Check if the processor supports AMX-TILE and the
+                        // operating system supports saving the tile state.
+                        //
+
+                        if (((Cpuid7[3] & 0x1000000) != 0) && ((xcr0 & 0x60000) == 0x60000) &&
+                            MaximumIsa >= MlasIsaAmx && MlasRequestAmxTileDataPermission()) {
+
+                            //
+                            // Check if the processor supports AMX-INT8.
+                            //
+
+                            if ((Cpuid7[3] & 0x2000000) != 0) {
+
+                                this->Isa = MlasIsaAmx;
+                                this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchAmx;
+                                this->GemmU8U8Dispatch = &MlasGemmU8U8DispatchAmx;
+                                this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchAmx;
+                            }
+
+#if defined(MLAS_AVX512BF16_INTRINSICS)
+
+                            //
+                            // Check if the processor supports AMX-BF16, the
+                            // kernel also converts the output with AVX512BF16.
+                            //
+
+                            if (((Cpuid7[3] & 0x400000) != 0) && ((Cpuid7_1[0] & 0x20) != 0)) {
+
+                                this->Bf16GemmKernel = MlasBf16GemmKernelAmx;
+                            }
+
+#endif
+                        }
+
+#endif
                     }
                 }
 
@@ -378,6 +510,8 @@ Return Value:
 #if defined(MLAS_TARGET_ARM64)
 
     this->GemmU8X8Dispatch = &MlasGemmU8X8DispatchNeon;
+    this->GemmU8S8Dispatch = &MlasGemmX8S8DispatchNeon;
+    this->GemmS8S8Dispatch = &MlasGemmX8S8DispatchNeon;
     this->SymmQgemmDispatch = &MlasSymmQgemmS8DispatchNeon;
     this->ConvSymU8S8Dispatch = &MlasConvSymU8DispatchNeon;
     this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchNeon;
@@ -398,11 +532,32 @@ Return Value:
 
     if (HasDotProductInstructions) {
         this->GemmU8X8Dispatch = &MlasGemmU8X8DispatchUdot;
+        this->GemmU8S8Dispatch = &MlasGemmU8X8DispatchUdot;
+        this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchSdot;
         this->SymmQgemmDispatch = &MlasSymmQgemmS8DispatchSdot;
         this->ConvSymU8S8Dispatch = &MlasConvSymU8DispatchDot;
         this->ConvSymS8S8Dispatch = &MlasConvSymS8DispatchDot;
     }
 
+#if defined(MLAS_I8MM_INTRINSICS)
+
+    //
+    // Check if the processor supports the int8 matrix multiply instructions.
+    //
+
+    if (MLAS_CPUIDINFO::GetCPUIDInfo().HasArmNeon_I8MM()) {
+        this->GemmU8X8Dispatch = &MlasGemmU8U8DispatchI8mm;
+        this->GemmU8S8Dispatch = &MlasGemmU8S8DispatchI8mm;
+        this->GemmS8S8Dispatch = &MlasGemmS8S8DispatchI8mm;
+    }
+
+#endif
+
+#if !defined(_WIN32)
+    this->HalfGemmKernel = MlasHalfGemmKernelNeon;
+    this->Bf16GemmKernel = MlasBf16GemmKernelNeon;
+#endif
+
 #endif // MLAS_TARGET_ARM64
 #if defined(MLAS_TARGET_POWER)
     this->GemmFloatKernel = MlasSgemmKernel;
@@ -478,6 +633,24 @@ MlasPlatformU8S8Overflow(
     return p.GemmU8U8Dispatch != p.GemmU8S8Dispatch;
 }
 
+void
+MLASCALL
+MlasSetMaximumIsa(
+    MLAS_ISA Isa
+    )
+{
+    GetMlasPlatform() = MLAS_PLATFORM(Isa);
+}
+
+MLAS_ISA
+MLASCALL
+MlasGetIsa(
+    void
+    )
+{
+    return GetMlasPlatform().Isa;
+}
+
 #endif
 
 thread_local size_t ThreadedBufSize = 0;
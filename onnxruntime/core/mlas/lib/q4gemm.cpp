@@ -0,0 +1,498 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm.cpp
+
+Abstract:
+
+    This module implements the single precision matrix/matrix multiply
+    operation with a blockwise 4-bit quantized matrix B.
+
+    The quantized weights are read from memory at one eighth of the cost of
+    single precision. For a small number of rows of matrix A (the common case
+    for token generation), the kernels dequantize the elements of matrix B in
+    registers. For a larger number of rows, slices of matrix B are
+    dequantized to a thread local buffer and multiplied using the single
+    precision GEMM kernels.
+
+--*/
+
+#include "q4gemm.h"
+
+//
+// Number of rows of matrix A from which slices of matrix B are dequantized
+// to a buffer instead of being dequantized in registers for each row.
+//
+
+constexpr size_t MLAS_Q4GEMM_DEQUANT_MINIMUM_M = 4;
+
+bool
+MLASCALL
+MlasIsQ4GemmBlkLenSupported(
+    size_t BlkLen
+    )
+{
+    return BlkLen >= MLAS_Q4GEMM_GROUP_SIZE && BlkLen <= 256 && (BlkLen & (BlkLen - 1)) == 0;
+}
+
+size_t
+MLASCALL
+MlasQ4GemmPackBSize(
+    size_t N,
+    size_t K,
+    size_t BlkLen
+    )
+{
+    if (!MlasIsQ4GemmBlkLenSupported(BlkLen)) {
+        return 0;
+    }
+
+    return N * MlasQ4GemmBlockCountK(K, BlkLen) * MlasQ4GemmBlockStride(BlkLen);
+}
+
+void
+MLASCALL
+MlasQ4GemmPackB(
+    void* PackedBuf,
+    const uint8_t* QuantBData,
+    const float* QuantBScale,
+    const uint8_t* QuantBZeroPoint,
+    size_t N,
+    size_t K,
+    size_t BlkLen
+    )
+/*++
+
+Routine Description:
+
+    This routine packs the blockwise 4-bit quantized matrix B into the layout
+    described in q4gemm.h.
+
+Arguments:
+
+    PackedBuf - Supplies the address of the packed buffer.
+
+    QuantBData - Supplies the quantized elements of matrix B.
+
+    QuantBScale - Supplies the per block scales of matrix B.
+
+    QuantBZeroPoint - Supplies the per block zero points of matrix B, else
+        nullptr if the elements are symmetrically quantized.
+
+    N - Supplies the number of columns of matrix B.
+
+    K - Supplies the number of rows of matrix B.
+
+    BlkLen - Supplies the number of quantized elements per block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockCountK = MlasQ4GemmBlockCountK(K, BlkLen);
+    const size_t ZeroPointStride = (BlockCountK + 1) / 2;
+
+    uint8_t* PackedB = reinterpret_cast<uint8_t*>(PackedBuf);
+
+    for (size_t n = 0; n < N; n++) {
+
+        for (size_t blk = 0; blk < BlockCountK; blk++) {
+
+            const uint8_t* QuantData = QuantBData + (n * BlockCountK + blk) * (BlkLen / 2);
+            const float Scale = QuantBScale[n * BlockCountK + blk];
+
+            uint8_t ZeroPoint = 8;
+
+            if (QuantBZeroPoint != nullptr) {
+                const uint8_t ZeroPointPair = QuantBZeroPoint[n * ZeroPointStride + blk / 2];
+                ZeroPoint = (blk & 1) ? (ZeroPointPair >> 4) : (ZeroPointPair & 0x0F);
+            }
+
+            float* Header = reinterpret_cast<float*>(PackedB);
+            Header[0] = Scale;
+            Header[1] = -Scale * float(ZeroPoint);
+
+            uint8_t* PackedData = PackedB + 2 * sizeof(float);
+
+            //
+            // Elements beyond the end of matrix B are cleared, as the packed
+            // buffer may be hashed when it is shared between sessions.
+            //
+
+            const size_t CountK = std::min(K - blk * BlkLen, BlkLen);
+
+            auto LoadElement = [&](size_t k) -> uint8_t {
+                if (k >= CountK) {
+                    return 0;
+                }
+                return (k & 1) ? (QuantData[k / 2] >> 4) : (QuantData[k / 2] & 0x0F);
+            };
+
+            for (size_t g = 0; g < BlkLen; g += MLAS_Q4GEMM_GROUP_SIZE) {
+                for (size_t i = 0; i < MLAS_Q4GEMM_GROUP_SIZE / 2; i++) {
+                    *PackedData++ = uint8_t(LoadElement(g + i) |
+                        (LoadElement(g + i + MLAS_Q4GEMM_GROUP_SIZE / 2) << 4));
+                }
+            }
+
+            PackedB += MlasQ4GemmBlockStride(BlkLen);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasQ4GemmKernel(
+    const float* A,
+    const uint8_t* PackedB,
+    float* C,
+    size_t CountN,
+    size_t CountK,
+    size_t BlkLen,
+    const float* Bias
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute a single row of a matrix
+    multiplication with a packed blockwise 4-bit quantized matrix B.
+
+Arguments:
+
+    A - Supplies the address of the row of matrix A.
+
+    PackedB - Supplies the address of the first packed column of matrix B.
+
+    C - Supplies the address of the row of matrix C.
+
+    CountN - Supplies the number of columns from matrix B and matrix C to
+        iterate over.
+
+    CountK - Supplies the number of columns from matrix A and the number of
+        rows from matrix B to iterate over.
+
+    BlkLen - Supplies the number of quantized elements per block.
+
+    Bias - Supplies the optional bias vector for the columns of matrix C.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockStride = MlasQ4GemmBlockStride(BlkLen);
+    const size_t BlockCountK = MlasQ4GemmBlockCountK(CountK, BlkLen);
+
+    float TailA[MLAS_Q4GEMM_GROUP_SIZE];
+    const size_t CountFullK = MlasQ4GemmPrepareTailA(A, CountK, TailA);
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        const uint8_t* b = PackedB + n * BlockCountK * BlockStride;
+        float Accumulator = (Bias != nullptr) ? Bias[n] : 0.0f;
+
+        for (size_t k = 0; k < CountK; k += BlkLen) {
+
+            const float Scale = reinterpret_cast<const float*>(b)[0];
+            const float Offset = reinterpret_cast<const float*>(b)[1];
+            const uint8_t* QuantData = b + 2 * sizeof(float);
+
+            const size_t BlockEndK = std::min(k + BlkLen, CountK);
+
+            for (size_t kk = k; kk < BlockEndK; kk += MLAS_Q4GEMM_GROUP_SIZE) {
+
+                const float* a = (kk < CountFullK) ? A + kk : TailA;
+
+                for (size_t i = 0; i < MLAS_Q4GEMM_GROUP_SIZE / 2; i++) {
+                    const float Low = float(QuantData[i] & 0x0F) * Scale + Offset;
+                    const float High = float(QuantData[i] >> 4) * Scale + Offset;
+                    Accumulator += a[i] * Low;
+                    Accumulator += a[i + MLAS_Q4GEMM_GROUP_SIZE / 2] * High;
+                }
+
+                QuantData += MLAS_Q4GEMM_GROUP_SIZE / 2;
+            }
+
+            b += BlockStride;
+        }
+
+        C[n] = Accumulator;
+    }
+}
+
+void
+MlasQ4GemmDequantizeB(
+    const uint8_t* PackedB,
+    float* DequantB,
+    size_t CountN,
+    size_t CountK,
+    size_t BlkLen
+    )
+/*++
+
+Routine Description:
+
+    This routine dequantizes columns of the packed matrix B to a buffer
+    holding the transpose of the slice of matrix B.
+
+Arguments:
+
+    PackedB - Supplies the address of the first packed column of matrix B.
+
+    DequantB - Supplies the output buffer of CountN rows of CountK elements.
+
+    CountN - Supplies the number of columns from matrix B to dequantize.
+
+    CountK - Supplies the number of rows from matrix B to dequantize.
+
+    BlkLen - Supplies the number of quantized elements per block.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const size_t BlockStride = MlasQ4GemmBlockStride(BlkLen);
+
+    for (size_t n = 0; n < CountN; n++) {
+
+        const uint8_t* b = PackedB;
+
+        for (size_t k = 0; k < CountK; k += BlkLen) {
+
+            const float Scale = reinterpret_cast<const float*>(b)[0];
+            const float Offset = reinterpret_cast<const float*>(b)[1];
+            const uint8_t* QuantData = b + 2 * sizeof(float);
+
+            const size_t BlockEndK = std::min(k + BlkLen, CountK);
+
+            for (size_t kk = k; kk < BlockEndK; kk += MLAS_Q4GEMM_GROUP_SIZE) {
+
+                float Group[MLAS_Q4GEMM_GROUP_SIZE];
+
+                for (size_t i = 0; i < MLAS_Q4GEMM_GROUP_SIZE / 2; i++) {
+                    Group[i] = float(QuantData[i] & 0x0F) * Scale + Offset;
+                    Group[i + MLAS_Q4GEMM_GROUP_SIZE / 2] = float(QuantData[i] >> 4) * Scale + Offset;
+                }
+
+                std::copy_n(Group, std::min(CountK - kk, MLAS_Q4GEMM_GROUP_SIZE), DequantB + kk);
+
+                QuantData += MLAS_Q4GEMM_GROUP_SIZE / 2;
+            }
+
+            b += BlockStride;
+        }
+
+        PackedB = b;
+        DequantB += CountK;
+    }
+}
+
+void
+MlasQ4GemmThreaded(
+    const ptrdiff_t ThreadCountM,
+    const ptrdiff_t ThreadCountN,
+    const size_t M,
+    const size_t N,
+    const size_t K,
+    const size_t BlkLen,
+    const MLAS_Q4_GEMM_DATA_PARAMS* DataParams,
+    ptrdiff_t ThreadId
+    )
+/*++
+
+Routine Description:
+
+    This routine is invoked from a worker thread to execute a segment of a
+    blockwise 4-bit quantized GEMM operation.
+
+Arguments:
+
+    ThreadCountM - Supplies the total thread partition on the M dimension.
+
+    ThreadCountN - Supplies the total thread partition on the N dimension.
+
+    M, N, K - Supplies the shape of the multiplication
+
+    BlkLen - Supplies the number of quantized elements per block.
+
+    DataParams - Supplies the data position and layout of the matrices
+
+    ThreadId - Supplies the current index of the threaded operation.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const ptrdiff_t ThreadIdM = ThreadId / ThreadCountN;
+    const ptrdiff_t ThreadIdN = ThreadId % ThreadCountN;
+
+    //
+    // Partition the operation along the M dimension.
+    //
+
+    size_t RangeStartM;
+    size_t RangeCountM;
+
+    MlasPartitionWork(ThreadIdM, ThreadCountM, M, &RangeStartM, &RangeCountM);
+
+    //
+    // Partition the operation along the N dimension.
+    //
+
+    size_t RangeStartN;
+    size_t RangeCountN;
+
+    const size_t BlockedN = (N + MLAS_Q4GEMM_STRIDEN_THREAD_ALIGN - 1) /
+        MLAS_Q4GEMM_STRIDEN_THREAD_ALIGN;
+
+    MlasPartitionWork(ThreadIdN, ThreadCountN, BlockedN, &RangeStartN,
+        &RangeCountN);
+
+    RangeStartN *= MLAS_Q4GEMM_STRIDEN_THREAD_ALIGN;
+    RangeCountN *= MLAS_Q4GEMM_STRIDEN_THREAD_ALIGN;
+
+    if (RangeStartN >= N) {
+        return;
+    }
+
+    RangeCountN = std::min(N - RangeStartN, RangeCountN);
+
+    const size_t ColumnStride = MlasQ4GemmBlockCountK(K, BlkLen) * MlasQ4GemmBlockStride(BlkLen);
+
+    const size_t lda = DataParams->lda;
+    const size_t ldc = DataParams->ldc;
+
+    const float* A = DataParams->A + RangeStartM * lda;
+    const uint8_t* PackedB = reinterpret_cast<const uint8_t*>(DataParams->PackedB) + RangeStartN * ColumnStride;
+    float* C = DataParams->C + RangeStartM * ldc + RangeStartN;
+    const float* Bias = (DataParams->Bias != nullptr) ? DataParams->Bias + RangeStartN : nullptr;
+
+    if (RangeCountM < MLAS_Q4GEMM_DEQUANT_MINIMUM_M) {
+
+        MLAS_Q4GEMM_KERNEL* Kernel = GetMlasPlatform().Q4GemmKernel;
+
+        for (size_t m = 0; m < RangeCountM; m++) {
+            Kernel(A + m * lda, PackedB, C + m * ldc, RangeCountN, K, BlkLen, Bias);
+        }
+
+        return;
+    }
+
+    //
+    // Step through each slice of matrix B along the N dimension, dequantizing
+    // the slice once for every row of matrix A.
+    //
+
+    MlasThreadedBufAlloc(MLAS_Q4GEMM_DEQUANT_STRIDEN * K * sizeof(float));
+    float* DequantB = reinterpret_cast<float*>(ThreadedBufHolder.get());
+
+    size_t CountN;
+
+    for (size_t n = 0; n < RangeCountN; n += CountN) {
+
+        CountN = std::min(RangeCountN - n, size_t(MLAS_Q4GEMM_DEQUANT_STRIDEN));
+
+        MlasQ4GemmDequantizeB(PackedB + n * ColumnStride, DequantB, CountN, K, BlkLen);
+
+        MlasSgemmOperation(CblasNoTrans, CblasTrans, RangeCountM, CountN, K, 1.0f,
+            A, lda, DequantB, K, 0.0f, C + n, ldc);
+
+        if (Bias != nullptr) {
+            for (size_t m = 0; m < RangeCountM; m++) {
+                float* c = C + m * ldc + n;
+                for (size_t j = 0; j < CountN; j++) {
+                    c[j] += Bias[n + j];
+                }
+            }
+        }
+    }
+}
+
+void
+MLASCALL
+MlasQ4GemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    size_t BlkLen,
+    const MLAS_Q4_GEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation. Small requests should run using the single threaded path.
+    //
+
+    const double Complexity = double(M) * double(N) * double(K);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_Q4GEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_Q4GEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Segment the operation across multiple threads. The weights dominate the
+    // memory traffic, so prefer to partition along the N dimension so that
+    // each thread streams a distinct slice of matrix B.
+    //
+
+    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    const size_t BlockedN = (N + MLAS_Q4GEMM_STRIDEN_THREAD_ALIGN - 1) /
+        MLAS_Q4GEMM_STRIDEN_THREAD_ALIGN;
+
+    if (size_t(ThreadsPerGemm) <= BlockedN || BlockedN >= M) {
+
+        if (size_t(ThreadsPerGemm) > BlockedN) {
+            ThreadsPerGemm = ptrdiff_t(BlockedN);
+        }
+
+        ThreadCountM = 1;
+        ThreadCountN = ThreadsPerGemm;
+
+    } else {
+
+        if (size_t(ThreadsPerGemm) > M) {
+            ThreadsPerGemm = ptrdiff_t(M);
+        }
+
+        ThreadCountM = ThreadsPerGemm;
+        ThreadCountN = 1;
+    }
+
+    MlasTrySimpleParallel(ThreadPool,
+        ThreadsPerGemm * static_cast<ptrdiff_t>(BatchSize),
+        [=](ptrdiff_t tid)
+    {
+        ptrdiff_t GemmIdx = tid / ThreadsPerGemm;
+        ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
+        MlasQ4GemmThreaded(ThreadCountM, ThreadCountN,
+            M, N, K, BlkLen, &(Data[GemmIdx]), ThreadIdx);
+    });
+}
@@ -0,0 +1,89 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    q4gemm.h
+
+Abstract:
+
+    This module contains the private data structures and procedure prototypes
+    for the blockwise 4-bit quantized matrix/matrix multiply operation.
+
+    Matrix B is packed by column. Each column is a sequence of blocks, each
+    holding the single precision scale of the block, the single precision
+    offset of the block (the negated product of the scale and the zero point)
+    and the BlkLen / 2 bytes of quantized elements.
+
+    The quantized elements of a block are grouped by 32, with element i of a
+    group in the low nibble of byte i and element i + 16 in the high nibble.
+    This allows a vector of elements to be unpacked with a mask and a shift.
+
+--*/
+
+#pragma once
+
+#include "mlasi.h"
+
+constexpr size_t MLAS_Q4GEMM_GROUP_SIZE = 32;
+
+MLAS_FORCEINLINE
+constexpr
+size_t
+MlasQ4GemmBlockStride(
+    size_t BlkLen
+    )
+{
+    return 2 * sizeof(float) + BlkLen / 2;
+}
+
+MLAS_FORCEINLINE
+constexpr
+size_t
+MlasQ4GemmBlockCountK(
+    size_t K,
+    size_t BlkLen
+    )
+{
+    return (K + BlkLen - 1) / BlkLen;
+}
+
+MLAS_FORCEINLINE
+size_t
+MlasQ4GemmPrepareTailA(
+    const float* A,
+    size_t CountK,
+    float* TailA
+    )
+/*++
+
+Routine Description:
+
+    This routine copies the partial group at the end of a row of matrix A to
+    a zero padded buffer, so that the kernels can process every group of the
+    row with full vectors.
+
+Arguments:
+
+    A - Supplies the address of the row of matrix A.
+
+    CountK - Supplies the number of columns of matrix A.
+
+    TailA - Supplies the buffer of MLAS_Q4GEMM_GROUP_SIZE elements.
+
+Return Value:
+
+    Returns the number of columns of matrix A in full groups.
+
+--*/
+{
+    const size_t CountFullK = CountK & ~(MLAS_Q4GEMM_GROUP_SIZE - 1);
+
+    std::fill_n(TailA, MLAS_Q4GEMM_GROUP_SIZE, 0.0f);
+    std::copy(A + CountFullK, A + CountK, TailA);
+
+    return CountFullK;
+}
@@ -879,14 +879,12 @@ MlasGemmQuantGetDispatch(
         else {
             GemmQuantDispatch = GetMlasPlatform().GemmU8U8Dispatch;
         }
+    } else if (BIsSigned) {
+        GemmQuantDispatch = GetMlasPlatform().GemmS8S8Dispatch;
     }
 #elif defined(MLAS_TARGET_ARM64)
     if(BIsSigned) {
-        if(GetMlasPlatform().GemmU8X8Dispatch == &MlasGemmU8X8DispatchNeon) {
-            GemmQuantDispatch = &MlasGemmX8S8DispatchNeon;
-        } else {
-            GemmQuantDispatch = AIsSigned? &MlasGemmS8S8DispatchSdot : &MlasGemmU8X8DispatchUdot;
-        }
+        GemmQuantDispatch = AIsSigned? GetMlasPlatform().GemmS8S8Dispatch : GetMlasPlatform().GemmU8S8Dispatch;
     } else if(!AIsSigned) {
         GemmQuantDispatch = GetMlasPlatform().GemmU8X8Dispatch;
     }
@@ -0,0 +1,551 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    qgemm_kernel_i8mm.cpp
+
+Abstract:
+
+    This module implements QGEMM kernels for the ARMv8.6 int8 matrix
+    multiply (I8MM) extension.
+
+    The SMMLA, UMMLA and USMMLA instructions multiply a 2x8 block of matrix A
+    by an 8x2 block of matrix B and accumulate the 2x2 result. Matrix A is
+    packed in blocks of 8 rows, where each 16 byte vector holds 8 consecutive
+    elements along the K dimension for a pair of rows. Matrix B is packed the
+    same way in blocks of 8 columns. The elements of both matrices are used
+    natively, so no sign bit flip is needed for any of the supported formats.
+
+--*/
+
+#include "mlasi.h"
+#include "qgemm.h"
+
+#include <type_traits>
+
+template<typename AType, typename BType>
+struct MLAS_GEMM_QUANT_KERNEL_I8MM
+{
+    typedef uint8_t PackedAType;
+    typedef uint8_t PackedBType;
+    typedef AType OffsetAType;
+    typedef BType OffsetBType;
+
+    static constexpr size_t PackedK = 8;
+    static constexpr MLAS_GEMM_QUANT_STRIDES Strides{ 24, 128, 256 };
+    static constexpr MLAS_GEMM_QUANT_STRIDES PackedStrides{ 24, 128, 384 };
+};
+
+template<typename AType, typename BType>
+constexpr size_t MLAS_GEMM_QUANT_KERNEL_I8MM<AType, BType>::PackedK;
+template<typename AType, typename BType>
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_QUANT_KERNEL_I8MM<AType, BType>::Strides;
+template<typename AType, typename BType>
+constexpr MLAS_GEMM_QUANT_STRIDES MLAS_GEMM_QUANT_KERNEL_I8MM<AType, BType>::PackedStrides;
+
+typedef MLAS_GEMM_QUANT_KERNEL_I8MM<uint8_t, int8_t> MLAS_GEMM_U8S8_KERNEL_I8MM;
+typedef MLAS_GEMM_QUANT_KERNEL_I8MM<uint8_t, uint8_t> MLAS_GEMM_U8U8_KERNEL_I8MM;
+typedef MLAS_GEMM_QUANT_KERNEL_I8MM<int8_t, int8_t> MLAS_GEMM_S8S8_KERNEL_I8MM;
+
+template<typename AType, typename BType>
+MLAS_FORCEINLINE
+int32x4_t
+MlasI8mmMultiplyAccumulate(
+    int32x4_t Accumulator,
+    uint8x16_t VectorA,
+    uint8x16_t VectorB
+    )
+/*++
+
+Routine Description:
+
+    This routine multiplies a 2x8 block of matrix A by an 8x2 block of matrix
+    B with the instruction matching the formats of matrix A and matrix B.
+
+Return Value:
+
+    Returns the accumulated 2x2 block in row major order.
+
+--*/
+{
+    static_assert(std::is_signed<BType>::value || !std::is_signed<AType>::value,
+        "signed matrix A requires signed matrix B");
+
+    if constexpr (std::is_signed<AType>::value) {
+        return vmmlaq_s32(Accumulator, vreinterpretq_s8_u8(VectorA), vreinterpretq_s8_u8(VectorB));
+    } else if constexpr (std::is_signed<BType>::value) {
+        return vusmmlaq_s32(Accumulator, VectorA, vreinterpretq_s8_u8(VectorB));
+    } else {
+        return vreinterpretq_s32_u32(vmmlaq_u32(vreinterpretq_u32_s32(Accumulator), VectorA, VectorB));
+    }
+}
+
+template<typename Type>
+MLAS_FORCEINLINE
+int32x4_t
+MlasI8mmAccumulatePairSums(
+    int32x4_t Sums,
+    uint8x16_t Vector
+    )
+/*++
+
+Routine Description:
+
+    This routine accumulates the elements of a packed vector: lanes 0 and 1
+    of the sums vector receive the first 8 elements and lanes 2 and 3 receive
+    the last 8 elements.
+
+--*/
+{
+    if constexpr (std::is_signed<Type>::value) {
+        return vpadalq_s16(Sums, vpaddlq_s8(vreinterpretq_s8_u8(Vector)));
+    } else {
+        return vreinterpretq_s32_u32(vpadalq_u16(vreinterpretq_u32_s32(Sums), vpaddlq_u8(Vector)));
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasI8mmLoadBlock(
+    uint8x8_t Rows[8],
+    const uint8_t* Source,
+    size_t Stride,
+    size_t CountRows,
+    size_t CountColumns
+    )
+/*++
+
+Routine Description:
+
+    This routine loads a block of up to 8 rows by 8 bytes. The rows and
+    columns past the supplied counts are zero filled.
+
+--*/
+{
+    for (size_t r = 0; r < 8; r++) {
+
+        if (r >= CountRows) {
+            Rows[r] = vdup_n_u8(0);
+        } else if (CountColumns == 8) {
+            Rows[r] = vld1_u8(Source);
+        } else {
+            uint8_t PaddedRow[8] = {};
+            std::copy_n(Source, CountColumns, PaddedRow);
+            Rows[r] = vld1_u8(PaddedRow);
+        }
+
+        Source += Stride;
+    }
+}
+
+template<typename AType>
+void
+MlasGemmQuantCopyPackAI8mm(
+    uint8_t* D,
+    const uint8_t* A,
+    size_t lda,
+    size_t CountM,
+    size_t CountK,
+    int32_t* RowSumBuffer
+    )
+{
+    const size_t AlignedCountK = (CountK + 7) & ~size_t(7);
+
+    //
+    // Process a block of 8 rows of matrix A in a loop. The rows past the end
+    // of matrix A are padded with zeros, so that the kernel always loads
+    // complete vectors.
+    //
+
+    for (size_t m = 0; m < CountM; m += 8) {
+
+        const size_t CountBlockM = std::min(CountM - m, size_t(8));
+
+        int32x4_t RowSums[4];
+
+        for (size_t i = 0; i < 4; i++) {
+            RowSums[i] = vdupq_n_s32(0);
+        }
+
+        const uint8_t* a = A + m * lda;
+
+        for (size_t k = 0; k < AlignedCountK; k += 8) {
+
+            uint8x8_t Rows[8];
+
+            MlasI8mmLoadBlock(Rows, a + k, lda, CountBlockM, std::min(CountK - k, size_t(8)));
+
+            for (size_t i = 0; i < 4; i++) {
+
+                const uint8x16_t Vector = vcombine_u8(Rows[2 * i], Rows[2 * i + 1]);
+
+                vst1q_u8(D, Vector);
+                RowSums[i] = MlasI8mmAccumulatePairSums<AType>(RowSums[i], Vector);
+
+                D += 16;
+            }
+        }
+
+        int32_t BlockRowSums[8];
+
+        vst1q_s32(BlockRowSums, vpaddq_s32(RowSums[0], RowSums[1]));
+        vst1q_s32(BlockRowSums + 4, vpaddq_s32(RowSums[2], RowSums[3]));
+
+        std::copy_n(BlockRowSums, CountBlockM, RowSumBuffer + m);
+    }
+}
+
+template<typename BType>
+void
+MlasGemmQuantCopyPackBI8mm(
+    uint8_t* D,
+    const uint8_t* B,
+    size_t ldb,
+    size_t CountN,
+    size_t CountK,
+    int32_t* ColumnSumBuffer
+    )
+{
+    const size_t AlignedCountK = (CountK + 7) & ~size_t(7);
+
+    //
+    // Process a block of 8 columns of matrix B in a loop. The columns past the
+    // end of matrix B are padded with zeros, so that the kernel always loads
+    // complete vectors.
+    //
+
+    for (size_t n = 0; n < CountN; n += 8) {
+
+        const size_t CountBlockN = std::min(CountN - n, size_t(8));
+
+        int32x4_t ColumnSums[4];
+
+        for (size_t i = 0; i < 4; i++) {
+            ColumnSums[i] = vdupq_n_s32(0);
+        }
+
+        const uint8_t* b = B + n;
+
+        for (size_t k = 0; k < AlignedCountK; k += 8) {
+
+            uint8x8_t Rows[8];
+
+            MlasI8mmLoadBlock(Rows, b, ldb, std::min(CountK - k, size_t(8)), CountBlockN);
+
+            //
+            // Transpose the 8x8 block so that each vector holds the 8
+            // consecutive elements of a column.
+            //
+
+            const uint8x8x2_t Rows01 = vtrn_u8(Rows[0], Rows[1]);
+            const uint8x8x2_t Rows23 = vtrn_u8(Rows[2], Rows[3]);
+            const uint8x8x2_t Rows45 = vtrn_u8(Rows[4], Rows[5]);
+            const uint8x8x2_t Rows67 = vtrn_u8(Rows[6], Rows[7]);
+
+            const uint16x4x2_t Rows0123Even =
+                vtrn_u16(vreinterpret_u16_u8(Rows01.val[0]), vreinterpret_u16_u8(Rows23.val[0]));
+            const uint16x4x2_t Rows0123Odd =
+                vtrn_u16(vreinterpret_u16_u8(Rows01.val[1]), vreinterpret_u16_u8(Rows23.val[1]));
+            const uint16x4x2_t Rows4567Even =
+                vtrn_u16(vreinterpret_u16_u8(Rows45.val[0]), vreinterpret_u16_u8(Rows67.val[0]));
+            const uint16x4x2_t Rows4567Odd =
+                vtrn_u16(vreinterpret_u16_u8(Rows45.val[1]), vreinterpret_u16_u8(Rows67.val[1]));
+
+            const uint32x2x2_t Columns04 =
+                vtrn_u32(vreinterpret_u32_u16(Rows0123Even.val[0]), vreinterpret_u32_u16(Rows4567Even.val[0]));
+            const uint32x2x2_t Columns15 =
+                vtrn_u32(vreinterpret_u32_u16(Rows0123Odd.val[0]), vreinterpret_u32_u16(Rows4567Odd.val[0]));
+            const uint32x2x2_t Columns26 =
+                vtrn_u32(vreinterpret_u32_u16(Rows0123Even.val[1]), vreinterpret_u32_u16(Rows4567Even.val[1]));
+            const uint32x2x2_t Columns37 =
+                vtrn_u32(vreinterpret_u32_u16(Rows0123Odd.val[1]), vreinterpret_u32_u16(Rows4567Odd.val[1]));
+
+            uint8x16_t Columns[4];
+
+            Columns[0] = vreinterpretq_u8_u32(vcombine_u32(Columns04.val[0], Columns15.val[0]));
+            Columns[1] = vreinterpretq_u8_u32(vcombine_u32(Columns26.val[0], Columns37.val[0]));
+            Columns[2] = vreinterpretq_u8_u32(vcombine_u32(Columns04.val[1], Columns15.val[1]));
+            Columns[3] = vreinterpretq_u8_u32(vcombine_u32(Columns26.val[1], Columns37.val[1]));
+
+            for (size_t i = 0; i < 4; i++) {
+
+                vst1q_u8(D, Columns[i]);
+                ColumnSums[i] = MlasI8mmAccumulatePairSums<BType>(ColumnSums[i], Columns[i]);
+
+                D += 16;
+            }
+
+            b += ldb * 8;
+        }
+
+        vst1q_s32(ColumnSumBuffer + n, vpaddq_s32(ColumnSums[0], ColumnSums[1]));
+        vst1q_s32(ColumnSumBuffer + n + 4, vpaddq_s32(ColumnSums[2], ColumnSums[3]));
+    }
+}
+
+MLAS_FORCEINLINE
+void
+MlasI8mmStoreRow(
+    int32_t* C,
+    int32x4_t Vector0,
+    int32x4_t Vector1,
+    size_t CountN,
+    bool ZeroMode
+    )
+{
+    if (CountN == 8) {
+
+        if (!ZeroMode) {
+            Vector0 = vaddq_s32(Vector0, vld1q_s32(C));
+            Vector1 = vaddq_s32(Vector1, vld1q_s32(C + 4));
+        }
+
+        vst1q_s32(C, Vector0);
+        vst1q_s32(C + 4, Vector1);
+
+    } else {
+
+        int32_t Row[8];
+
+        vst1q_s32(Row, Vector0);
+        vst1q_s32(Row + 4, Vector1);
+
+        for (size_t n = 0; n < CountN; n++) {
+            C[n] = ZeroMode ? Row[n] : C[n] + Row[n];
+        }
+    }
+}
+
+template<typename AType, typename BType, size_t RowPairs>
+size_t
+MlasGemmQuantKernelI8mm(
+    const uint8_t* A,
+    const uint8_t* B,
+    int32_t* C,
+    size_t PackedCountK,
+    size_t CountM,
+    size_t CountN,
+    size_t ldc,
+    const int32_t* RowSumBuffer,
+    const int32_t* ColumnSumBuffer,
+    const int32_t* ZeroPointB,
+    bool ZeroMode
+    )
+/*++
+
+Routine Description:
+
+    This routine computes up to 2*RowPairs rows of the output matrix from a
+    block of 8 rows of the packed matrix A. Each pair of rows and pair of
+    columns accumulates into a vector holding a 2x2 block of matrix C.
+
+Return Value:
+
+    Returns the number of rows handled.
+
+--*/
+{
+    const size_t StrideB = PackedCountK * 64;
+    const size_t CountBlockM = std::min(CountM, 2 * RowPairs);
+
+    for (size_t n = 0; n < CountN; n += 8) {
+
+        const size_t CountBlockN = std::min(CountN - n, size_t(8));
+
+        int32x4_t Accumulators[RowPairs][4];
+
+        for (size_t i = 0; i < RowPairs; i++) {
+            for (size_t j = 0; j < 4; j++) {
+                Accumulators[i][j] = vdupq_n_s32(0);
+            }
+        }
+
+        const uint8_t* a = A;
+        const uint8_t* b = B + (n / 8) * StrideB;
+
+        for (size_t k = 0; k < PackedCountK; k++) {
+
+            uint8x16_t VectorB[4];
+
+            for (size_t j = 0; j < 4; j++) {
+                VectorB[j] = vld1q_u8(b + j * 16);
+            }
+
+            for (size_t i = 0; i < RowPairs; i++) {
+
+                const uint8x16_t VectorA = vld1q_u8(a + i * 16);
+
+                for (size_t j = 0; j < 4; j++) {
+                    Accumulators[i][j] =
+                        MlasI8mmMultiplyAccumulate<AType, BType>(Accumulators[i][j], VectorA, VectorB[j]);
+                }
+            }
+
+            a += 64;
+            b += 64;
+        }
+
+        //
+        // Apply the row and column sums for the zero points and store the
+        // block to matrix C.
+        //
+
+        const int32x4_t ColumnSums0 = vld1q_s32(ColumnSumBuffer + n);
+        const int32x4_t ColumnSums1 = vld1q_s32(ColumnSumBuffer + n + 4);
+
+        int32x4_t ZeroPoints0 = vdupq_n_s32(1);
+        int32x4_t ZeroPoints1 = vdupq_n_s32(1);
+
+        if (ZeroPointB != nullptr) {
+            ZeroPoints0 = vld1q_s32(ZeroPointB + n);
+            ZeroPoints1 = vld1q_s32(ZeroPointB + n + 4);
+        }
+
+        for (size_t m = 0; m < CountBlockM; m++) {
+
+            //
+            // Extract the row from the 2x2 blocks: the even row is held in
+            // the low half of each block and the odd row in the high half.
+            //
+
+            const int32x4_t* Blocks = Accumulators[m / 2];
+
+            int64x2_t Blocks01[2] = { vreinterpretq_s64_s32(Blocks[0]), vreinterpretq_s64_s32(Blocks[1]) };
+            int64x2_t Blocks23[2] = { vreinterpretq_s64_s32(Blocks[2]), vreinterpretq_s64_s32(Blocks[3]) };
+
+            int32x4_t Vector0;
+            int32x4_t Vector1;
+
+            if (m % 2 == 0) {
+                Vector0 = vreinterpretq_s32_s64(vzip1q_s64(Blocks01[0], Blocks01[1]));
+                Vector1 = vreinterpretq_s32_s64(vzip1q_s64(Blocks23[0], Blocks23[1]));
+            } else {
+                Vector0 = vreinterpretq_s32_s64(vzip2q_s64(Blocks01[0], Blocks01[1]));
+                Vector1 = vreinterpretq_s32_s64(vzip2q_s64(Blocks23[0], Blocks23[1]));
+            }
+
+            const int32x4_t RowSum = vdupq_n_s32(RowSumBuffer[m]);
+
+            Vector0 = vaddq_s32(Vector0, vmlaq_s32(ColumnSums0, RowSum, ZeroPoints0));
+            Vector1 = vaddq_s32(Vector1, vmlaq_s32(ColumnSums1, RowSum, ZeroPoints1));
+
+            MlasI8mmStoreRow(C + m * ldc + n, Vector0, Vector1, CountBlockN, ZeroMode);
+        }
+    }
+
+    return CountBlockM;
+}
+
+//
+// Specialize the template functions of the kernel driver for each of the
+// supported formats.
+//
+
+#define MLAS_GEMM_QUANT_KERNEL_I8MM_SPECIALIZE(KernelType) \
+    template<> \
+    MLAS_FORCEINLINE \
+    void \
+    MlasGemmQuantCopyPackA<KernelType>( \
+        KernelType::PackedAType* D, \
+        const uint8_t* A, \
+        size_t lda, \
+        size_t CountM, \
+        size_t CountK, \
+        int32_t* RowSumBuffer, \
+        bool AIsSigned \
+        ) \
+    { \
+        MLAS_UNREFERENCED_PARAMETER(AIsSigned); \
+        MlasGemmQuantCopyPackAI8mm<KernelType::OffsetAType>(D, A, lda, CountM, CountK, RowSumBuffer); \
+    } \
+    \
+    template<> \
+    MLAS_FORCEINLINE \
+    void \
+    MlasGemmQuantCopyPackB<KernelType>( \
+        KernelType::PackedBType* D, \
+        const uint8_t* B, \
+        size_t ldb, \
+        size_t CountN, \
+        size_t CountK, \
+        int32_t* ColumnSumBuffer, \
+        bool BIsSigned \
+        ) \
+    { \
+        MLAS_UNREFERENCED_PARAMETER(BIsSigned); \
+        MlasGemmQuantCopyPackBI8mm<KernelType::OffsetBType>(D, B, ldb, CountN, CountK, ColumnSumBuffer); \
+    } \
+    \
+    template<> \
+    MLAS_FORCEINLINE \
+    size_t \
+    MlasGemmQuantKernel<KernelType>( \
+        const KernelType::PackedAType* A, \
+        const KernelType::PackedBType* B, \
+        int32_t* C, \
+        size_t PackedCountK, \
+        size_t CountM, \
+        size_t CountN, \
+        size_t ldc, \
+        const int32_t* RowSumBuffer, \
+        const int32_t* ColumnSumBuffer, \
+        const int32_t* ZeroPointB, \
+        bool ZeroMode \
+        ) \
+    { \
+        typedef KernelType::OffsetAType AType; \
+        typedef KernelType::OffsetBType BType; \
+        \
+        switch (CountM) { \
+            case 1: \
+            case 2: \
+                return MlasGemmQuantKernelI8mm<AType, BType, 1>(A, B, C, PackedCountK, CountM, CountN, ldc, \
+                    RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode); \
+            case 3: \
+            case 4: \
+                return MlasGemmQuantKernelI8mm<AType, BType, 2>(A, B, C, PackedCountK, CountM, CountN, ldc, \
+                    RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode); \
+            case 5: \
+            case 6: \
+                return MlasGemmQuantKernelI8mm<AType, BType, 3>(A, B, C, PackedCountK, CountM, CountN, ldc, \
+                    RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode); \
+            default: \
+                return MlasGemmQuantKernelI8mm<AType, BType, 4>(A, B, C, PackedCountK, CountM, CountN, ldc, \
+                    RowSumBuffer, ColumnSumBuffer, ZeroPointB, ZeroMode); \
+        } \
+    }
+
+MLAS_GEMM_QUANT_KERNEL_I8MM_SPECIALIZE(MLAS_GEMM_U8S8_KERNEL_I8MM)
+MLAS_GEMM_QUANT_KERNEL_I8MM_SPECIALIZE(MLAS_GEMM_U8U8_KERNEL_I8MM)
+MLAS_GEMM_QUANT_KERNEL_I8MM_SPECIALIZE(MLAS_GEMM_S8S8_KERNEL_I8MM)
+
+const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8S8DispatchI8mm = {
+    MlasGemmQuantOperation<MLAS_GEMM_U8S8_KERNEL_I8MM>,
+    MlasGemmQuantPackedOperation<MLAS_GEMM_U8S8_KERNEL_I8MM>,
+    MlasGemmQuantCopyPackB<MLAS_GEMM_U8S8_KERNEL_I8MM>,
+    MLAS_GEMM_U8S8_KERNEL_I8MM::PackedK,
+    MLAS_GEMM_U8S8_KERNEL_I8MM::PackedStrides.K,
+    8 // Kernel Stride M
+};
+
+const MLAS_GEMM_QUANT_DISPATCH MlasGemmU8U8DispatchI8mm = {
+    MlasGemmQuantOperation<MLAS_GEMM_U8U8_KERNEL_I8MM>,
+    MlasGemmQuantPackedOperation<MLAS_GEMM_U8U8_KERNEL_I8MM>,
+    MlasGemmQuantCopyPackB<MLAS_GEMM_U8U8_KERNEL_I8MM>,
+    MLAS_GEMM_U8U8_KERNEL_I8MM::PackedK,
+    MLAS_GEMM_U8U8_KERNEL_I8MM::PackedStrides.K,
+    8 // Kernel Stride M
+};
+
+const MLAS_GEMM_QUANT_DISPATCH MlasGemmS8S8DispatchI8mm = {
+    MlasGemmQuantOperation<MLAS_GEMM_S8S8_KERNEL_I8MM>,
+    MlasGemmQuantPackedOperation<MLAS_GEMM_S8S8_KERNEL_I8MM>,
+    MlasGemmQuantCopyPackB<MLAS_GEMM_S8S8_KERNEL_I8MM>,
+    MLAS_GEMM_S8S8_KERNEL_I8MM::PackedK,
+    MLAS_GEMM_S8S8_KERNEL_I8MM::PackedStrides.K,
+    8 // Kernel Stride M
+};
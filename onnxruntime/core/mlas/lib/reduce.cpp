@@ -0,0 +1,512 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    reduce.cpp
+
+Abstract:
+
+    This module implements routines to reduce the rows or the columns of a
+    single precision matrix.
+
+    Callers reduce a tensor over an arbitrary set of axes by splitting it into
+    matrices where either the reduced elements are contiguous (rows) or the
+    kept elements are contiguous (columns), and by accumulating the partial
+    results of several matrices into the same output.
+
+--*/
+
+#include "mlasi.h"
+
+//
+// Reducers used by the generic kernels. Accumulate folds an input element
+// into an accumulator and Combine merges two accumulators.
+//
+
+struct MLAS_REDUCER_SUM
+{
+    static float Identity() { return 0.0f; }
+
+    static MLAS_FLOAT32X4 Accumulate(MLAS_FLOAT32X4 Accumulator, MLAS_FLOAT32X4 Vector)
+    {
+        return MlasAddFloat32x4(Accumulator, Vector);
+    }
+
+    static float Accumulate(float Accumulator, float Value) { return Accumulator + Value; }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+    {
+        return MlasAddFloat32x4(Vector1, Vector2);
+    }
+
+    static float Combine(float Value1, float Value2) { return Value1 + Value2; }
+
+    static float Reduce(MLAS_FLOAT32X4 Vector) { return MlasReduceAddFloat32x4(Vector); }
+};
+
+struct MLAS_REDUCER_SUM_SQUARE : MLAS_REDUCER_SUM
+{
+    static MLAS_FLOAT32X4 Accumulate(MLAS_FLOAT32X4 Accumulator, MLAS_FLOAT32X4 Vector)
+    {
+        return MlasMultiplyAddFloat32x4(Vector, Vector, Accumulator);
+    }
+
+    static float Accumulate(float Accumulator, float Value) { return Accumulator + Value * Value; }
+};
+
+struct MLAS_REDUCER_MAXIMUM
+{
+    static float Identity() { return std::numeric_limits<float>::lowest(); }
+
+    static MLAS_FLOAT32X4 Accumulate(MLAS_FLOAT32X4 Accumulator, MLAS_FLOAT32X4 Vector)
+    {
+        return MlasMaximumFloat32x4(Accumulator, Vector);
+    }
+
+    static float Accumulate(float Accumulator, float Value) { return std::max(Accumulator, Value); }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+    {
+        return MlasMaximumFloat32x4(Vector1, Vector2);
+    }
+
+    static float Combine(float Value1, float Value2) { return std::max(Value1, Value2); }
+
+    static float Reduce(MLAS_FLOAT32X4 Vector) { return MlasReduceMaximumFloat32x4(Vector); }
+};
+
+struct MLAS_REDUCER_MAXIMUM_FINITE : MLAS_REDUCER_MAXIMUM
+{
+    static MLAS_FLOAT32X4 Accumulate(MLAS_FLOAT32X4 Accumulator, MLAS_FLOAT32X4 Vector)
+    {
+        //
+        // Infinities and NaNs fail the comparison of their magnitude against
+        // infinity and are excluded.
+        //
+
+        const MLAS_FLOAT32X4 Magnitude = MlasAndNotFloat32x4(MlasBroadcastFloat32x4(-0.0f), Vector);
+        const MLAS_FLOAT32X4 IsFinite =
+            MlasGreaterThanFloat32x4(MlasBroadcastFloat32x4(std::numeric_limits<float>::infinity()), Magnitude);
+
+        return MlasMaximumFloat32x4(Accumulator, MlasBlendFloat32x4(Accumulator, Vector, IsFinite));
+    }
+
+    static float Accumulate(float Accumulator, float Value)
+    {
+        return std::isfinite(Value) ? std::max(Accumulator, Value) : Accumulator;
+    }
+};
+
+struct MLAS_REDUCER_MINIMUM
+{
+    static float Identity() { return std::numeric_limits<float>::max(); }
+
+    static MLAS_FLOAT32X4 Accumulate(MLAS_FLOAT32X4 Accumulator, MLAS_FLOAT32X4 Vector)
+    {
+        return MlasMinimumFloat32x4(Accumulator, Vector);
+    }
+
+    static float Accumulate(float Accumulator, float Value) { return std::min(Accumulator, Value); }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+    {
+        return MlasMinimumFloat32x4(Vector1, Vector2);
+    }
+
+    static float Combine(float Value1, float Value2) { return std::min(Value1, Value2); }
+
+    static float Reduce(MLAS_FLOAT32X4 Vector) { return MlasReduceMinimumFloat32x4(Vector); }
+};
+
+template<typename Reducer>
+float
+MlasReduceRowF32(
+    const float* Input,
+    size_t N
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces a contiguous buffer.
+
+Arguments:
+
+    Input - Supplies the input buffer.
+
+    N - Supplies the number of elements to process.
+
+Return Value:
+
+    Returns the reduction of the buffer.
+
+--*/
+{
+    float Accumulator = Reducer::Identity();
+
+    if (N >= 4) {
+
+        MLAS_FLOAT32X4 AccumulatorVector0 = MlasBroadcastFloat32x4(Accumulator);
+
+        if (N >= 16) {
+
+            MLAS_FLOAT32X4 AccumulatorVector1 = AccumulatorVector0;
+            MLAS_FLOAT32X4 AccumulatorVector2 = AccumulatorVector0;
+            MLAS_FLOAT32X4 AccumulatorVector3 = AccumulatorVector0;
+
+            while (N >= 16) {
+
+                AccumulatorVector0 = Reducer::Accumulate(AccumulatorVector0, MlasLoadFloat32x4(Input));
+                AccumulatorVector1 = Reducer::Accumulate(AccumulatorVector1, MlasLoadFloat32x4(Input + 4));
+                AccumulatorVector2 = Reducer::Accumulate(AccumulatorVector2, MlasLoadFloat32x4(Input + 8));
+                AccumulatorVector3 = Reducer::Accumulate(AccumulatorVector3, MlasLoadFloat32x4(Input + 12));
+
+                Input += 16;
+                N -= 16;
+            }
+
+            AccumulatorVector0 = Reducer::Combine(AccumulatorVector0, AccumulatorVector1);
+            AccumulatorVector2 = Reducer::Combine(AccumulatorVector2, AccumulatorVector3);
+            AccumulatorVector0 = Reducer::Combine(AccumulatorVector0, AccumulatorVector2);
+        }
+
+        while (N >= 4) {
+
+            AccumulatorVector0 = Reducer::Accumulate(AccumulatorVector0, MlasLoadFloat32x4(Input));
+
+            Input += 4;
+            N -= 4;
+        }
+
+        Accumulator = Reducer::Reduce(AccumulatorVector0);
+    }
+
+    while (N > 0) {
+
+        Accumulator = Reducer::Accumulate(Accumulator, *Input);
+
+        Input += 1;
+        N -= 1;
+    }
+
+    return Accumulator;
+}
+
+template<typename Reducer>
+void
+MlasReduceRowsF32Kernel(
+    const float* Input,
+    size_t ldInput,
+    size_t CountM,
+    size_t CountN,
+    float* Output,
+    bool Accumulate
+    )
+{
+    for (size_t m = 0; m < CountM; m++) {
+
+        const float Value = MlasReduceRowF32<Reducer>(Input, CountN);
+
+        Output[m] = Accumulate ? Reducer::Combine(Output[m], Value) : Value;
+
+        Input += ldInput;
+    }
+}
+
+template<typename Reducer>
+void
+MlasReduceColumnsF32Kernel(
+    const float* Input,
+    size_t ldInput,
+    size_t CountM,
+    size_t CountN,
+    float* Output,
+    bool Accumulate
+    )
+{
+    const MLAS_FLOAT32X4 IdentityVector = MlasBroadcastFloat32x4(Reducer::Identity());
+
+    //
+    // Stream through the rows of the input matrix and keep the partial
+    // results in the output buffer, which stays in the cache. Each pass over
+    // the output buffer folds in up to four rows.
+    //
+
+    for (size_t m = 0; m < CountM; m += 4) {
+
+        const size_t CountRows = std::min<size_t>(4, CountM - m);
+        const bool LoadOutput = Accumulate || m > 0;
+
+        const float* input = Input + m * ldInput;
+
+        size_t n = 0;
+
+        for (; n + 4 <= CountN; n += 4) {
+
+            MLAS_FLOAT32X4 AccumulatorVector = LoadOutput ? MlasLoadFloat32x4(Output + n) : IdentityVector;
+
+            for (size_t r = 0; r < CountRows; r++) {
+                AccumulatorVector = Reducer::Accumulate(AccumulatorVector, MlasLoadFloat32x4(input + r * ldInput + n));
+            }
+
+            MlasStoreFloat32x4(Output + n, AccumulatorVector);
+        }
+
+        for (; n < CountN; n++) {
+
+            float Accumulator = LoadOutput ? Output[n] : Reducer::Identity();
+
+            for (size_t r = 0; r < CountRows; r++) {
+                Accumulator = Reducer::Accumulate(Accumulator, input[r * ldInput + n]);
+            }
+
+            Output[n] = Accumulator;
+        }
+    }
+}
+
+void
+MlasReduceRowsSumExpF32Kernel(
+    const float* Input,
+    size_t ldInput,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias,
+    float* Output,
+    bool Accumulate
+    )
+{
+    for (size_t m = 0; m < CountM; m++) {
+
+        const float NegativeBias = -Bias[m];
+
+#if defined(MLAS_TARGET_AMD64)
+        const float Value = GetMlasPlatform().ComputeSumExpF32Kernel(Input, nullptr, CountN, &NegativeBias);
+#else
+        const float Value = MlasComputeSumExpF32Kernel(Input, nullptr, CountN, &NegativeBias);
+#endif
+
+        Output[m] = Accumulate ? Output[m] + Value : Value;
+
+        Input += ldInput;
+    }
+}
+
+void
+MlasReduceColumnsSumExpF32Kernel(
+    const float* Input,
+    size_t ldInput,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias,
+    float* Output,
+    bool Accumulate
+    )
+{
+    //
+    // Compute the exponential functions of a chunk of columns at a time in a
+    // local buffer so that the vectorized exponential kernel can be used.
+    //
+
+    constexpr size_t ChunkSize = 256;
+
+    MLAS_DECLSPEC_ALIGN(float Buffer[ChunkSize], 64);
+
+    for (size_t n = 0; n < CountN; n += ChunkSize) {
+
+        const size_t CountChunk = std::min(ChunkSize, CountN - n);
+        float* output = Output + n;
+
+        if (!Accumulate) {
+            std::fill_n(output, CountChunk, 0.0f);
+        }
+
+        const float* input = Input + n;
+
+        for (size_t m = 0; m < CountM; m++) {
+
+            size_t i = 0;
+
+            for (; i + 4 <= CountChunk; i += 4) {
+                MlasStoreAlignedFloat32x4(Buffer + i,
+                    MlasSubtractFloat32x4(MlasLoadFloat32x4(input + i), MlasLoadFloat32x4(Bias + n + i)));
+            }
+
+            for (; i < CountChunk; i++) {
+                Buffer[i] = input[i] - Bias[n + i];
+            }
+
+            MlasComputeExp(Buffer, Buffer, CountChunk);
+
+            i = 0;
+
+            for (; i + 4 <= CountChunk; i += 4) {
+                MlasStoreFloat32x4(output + i,
+                    MlasAddFloat32x4(MlasLoadFloat32x4(output + i), MlasLoadFloat32x4(Buffer + i)));
+            }
+
+            for (; i < CountChunk; i++) {
+                output[i] += Buffer[i];
+            }
+
+            input += ldInput;
+        }
+    }
+}
+
+void
+MLASCALL
+MlasReduceRowsF32(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias,
+    float* Output,
+    bool Accumulate
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces each row of a matrix to one output element.
+
+Arguments:
+
+    Kind - Supplies the kind of reduction.
+
+    Input - Supplies the input matrix.
+
+    ldInput - Supplies the first dimension of the input matrix.
+
+    CountM - Supplies the number of rows of the input matrix, which is the
+        number of output elements.
+
+    CountN - Supplies the number of columns of the input matrix, which are
+        reduced.
+
+    Bias - Supplies a value per row for MlasReduceSumExp, else unused.
+
+    Output - Supplies the output buffer.
+
+    Accumulate - Supplies true if the reduction is merged with the partial
+        results already in the output buffer, else the output is overwritten.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (Kind) {
+
+        case MlasReduceSum:
+            MlasReduceRowsF32Kernel<MLAS_REDUCER_SUM>(Input, ldInput, CountM, CountN, Output, Accumulate);
+            break;
+
+        case MlasReduceSumSquare:
+            MlasReduceRowsF32Kernel<MLAS_REDUCER_SUM_SQUARE>(Input, ldInput, CountM, CountN, Output, Accumulate);
+            break;
+
+        case MlasReduceMaximum:
+            for (size_t m = 0; m < CountM; m++) {
+#if defined(MLAS_TARGET_AMD64)
+                const float Value = GetMlasPlatform().ReduceMaximumF32Kernel(Input + m * ldInput, CountN);
+#else
+                const float Value = MlasReduceMaximumF32Kernel(Input + m * ldInput, CountN);
+#endif
+                Output[m] = Accumulate ? std::max(Output[m], Value) : Value;
+            }
+            break;
+
+        case MlasReduceMinimum:
+            MlasReduceRowsF32Kernel<MLAS_REDUCER_MINIMUM>(Input, ldInput, CountM, CountN, Output, Accumulate);
+            break;
+
+        case MlasReduceMaximumFinite:
+            MlasReduceRowsF32Kernel<MLAS_REDUCER_MAXIMUM_FINITE>(Input, ldInput, CountM, CountN, Output, Accumulate);
+            break;
+
+        case MlasReduceSumExp:
+            MlasReduceRowsSumExpF32Kernel(Input, ldInput, CountM, CountN, Bias, Output, Accumulate);
+            break;
+    }
+}
+
+void
+MLASCALL
+MlasReduceColumnsF32(
+    MLAS_REDUCE_KIND Kind,
+    const float* Input,
+    size_t ldInput,
+    size_t CountM,
+    size_t CountN,
+    const float* Bias,
+    float* Output,
+    bool Accumulate
+    )
+/*++
+
+Routine Description:
+
+    This routine reduces each column of a matrix to one output element.
+
+Arguments:
+
+    Kind - Supplies the kind of reduction.
+
+    Input - Supplies the input matrix.
+
+    ldInput - Supplies the first dimension of the input matrix.
+
+    CountM - Supplies the number of rows of the input matrix, which are
+        reduced.
+
+    CountN - Supplies the number of columns of the input matrix, which is the
+        number of output elements.
+
+    Bias - Supplies a value per column for MlasReduceSumExp, else unused.
+
+    Output - Supplies the output buffer.
+
+    Accumulate - Supplies true if the reduction is merged with the partial
+        results already in the output buffer, else the output is overwritten.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    switch (Kind) {
+
+        case MlasReduceSum:
+            MlasReduceColumnsF32Kernel<MLAS_REDUCER_SUM>(Input, ldInput, CountM, CountN, Output, Accumulate);
+            break;
+
+        case MlasReduceSumSquare:
+            MlasReduceColumnsF32Kernel<MLAS_REDUCER_SUM_SQUARE>(Input, ldInput, CountM, CountN, Output, Accumulate);
+            break;
+
+        case MlasReduceMaximum:
+            MlasReduceColumnsF32Kernel<MLAS_REDUCER_MAXIMUM>(Input, ldInput, CountM, CountN, Output, Accumulate);
+            break;
+
+        case MlasReduceMinimum:
+            MlasReduceColumnsF32Kernel<MLAS_REDUCER_MINIMUM>(Input, ldInput, CountM, CountN, Output, Accumulate);
+            break;
+
+        case MlasReduceMaximumFinite:
+            MlasReduceColumnsF32Kernel<MLAS_REDUCER_MAXIMUM_FINITE>(Input, ldInput, CountM, CountN, Output, Accumulate);
+            break;
+
+        case MlasReduceSumExp:
+            MlasReduceColumnsSumExpF32Kernel(Input, ldInput, CountM, CountN, Bias, Output, Accumulate);
+            break;
+    }
+}
@@ -0,0 +1,383 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    resize.cpp
+
+Abstract:
+
+    This module implements the horizontal and vertical passes of a separable
+    image resize, as used by the bilinear and bicubic modes of the Resize
+    operator.
+
+    The horizontal pass gathers TapCount input pixels for each output pixel
+    and the vertical pass blends TapCount horizontally resized rows. Callers
+    compute the indices and weights so that the passes are independent of the
+    coordinate transformation used to produce them.
+
+--*/
+
+#include "mlasi.h"
+
+void
+MLASCALL
+MlasResizeHorizontal(
+    const float* Input,
+    size_t Channels,
+    const int32_t* Indices,
+    const float* Weights,
+    size_t TapCount,
+    size_t CountX,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine resizes a row of pixels horizontally.
+
+Arguments:
+
+    Input - Supplies the input row.
+
+    Channels - Supplies the number of interleaved elements of each pixel.
+
+    Indices - Supplies the TapCount input pixel indices of each output pixel.
+
+    Weights - Supplies the TapCount weights of each output pixel.
+
+    TapCount - Supplies the number of input pixels blended into each output
+        pixel.
+
+    CountX - Supplies the number of output pixels.
+
+    Output - Supplies the output row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (Channels == 1) {
+
+        for (size_t x = 0; x < CountX; x++) {
+
+            float Accumulator = 0.0f;
+
+            for (size_t t = 0; t < TapCount; t++) {
+                Accumulator += Weights[t] * Input[Indices[t]];
+            }
+
+            Output[x] = Accumulator;
+
+            Indices += TapCount;
+            Weights += TapCount;
+        }
+
+        return;
+    }
+
+    for (size_t x = 0; x < CountX; x++) {
+
+        const float* Input0 = Input + size_t(Indices[0]) * Channels;
+        const MLAS_FLOAT32X4 WeightBroadcast0 = MlasBroadcastFloat32x4(Weights[0]);
+
+        size_t c = 0;
+
+        for (; c + 4 <= Channels; c += 4) {
+
+            MLAS_FLOAT32X4 Accumulator =
+                MlasMultiplyFloat32x4(MlasLoadFloat32x4(Input0 + c), WeightBroadcast0);
+
+            for (size_t t = 1; t < TapCount; t++) {
+                const float* InputT = Input + size_t(Indices[t]) * Channels;
+                Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(InputT + c),
+                    MlasBroadcastFloat32x4(Weights[t]), Accumulator);
+            }
+
+            MlasStoreFloat32x4(Output + c, Accumulator);
+        }
+
+        for (; c < Channels; c++) {
+
+            float Accumulator = Weights[0] * Input0[c];
+
+            for (size_t t = 1; t < TapCount; t++) {
+                Accumulator += Weights[t] * Input[size_t(Indices[t]) * Channels + c];
+            }
+
+            Output[c] = Accumulator;
+        }
+
+        Output += Channels;
+        Indices += TapCount;
+        Weights += TapCount;
+    }
+}
+
+template<typename InputType>
+void
+MlasResizeHorizontalInteger(
+    const InputType* Input,
+    size_t Channels,
+    const int32_t* Indices,
+    const int32_t* Weights,
+    size_t TapCount,
+    size_t CountX,
+    int32_t* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine resizes a row of quantized pixels horizontally using fixed
+    point weights.
+
+Arguments:
+
+    See MlasResizeHorizontal.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    for (size_t x = 0; x < CountX; x++) {
+
+        const InputType* Input0 = Input + size_t(Indices[0]) * Channels;
+        const int32_t Weight0 = Weights[0];
+
+        for (size_t c = 0; c < Channels; c++) {
+            Output[c] = Weight0 * int32_t(Input0[c]);
+        }
+
+        for (size_t t = 1; t < TapCount; t++) {
+
+            const InputType* InputT = Input + size_t(Indices[t]) * Channels;
+            const int32_t WeightT = Weights[t];
+
+            for (size_t c = 0; c < Channels; c++) {
+                Output[c] += WeightT * int32_t(InputT[c]);
+            }
+        }
+
+        Output += Channels;
+        Indices += TapCount;
+        Weights += TapCount;
+    }
+}
+
+void
+MLASCALL
+MlasResizeHorizontal(
+    const uint8_t* Input,
+    size_t Channels,
+    const int32_t* Indices,
+    const int32_t* Weights,
+    size_t TapCount,
+    size_t CountX,
+    int32_t* Output
+    )
+{
+    MlasResizeHorizontalInteger(Input, Channels, Indices, Weights, TapCount, CountX, Output);
+}
+
+void
+MLASCALL
+MlasResizeHorizontal(
+    const int8_t* Input,
+    size_t Channels,
+    const int32_t* Indices,
+    const int32_t* Weights,
+    size_t TapCount,
+    size_t CountX,
+    int32_t* Output
+    )
+{
+    MlasResizeHorizontalInteger(Input, Channels, Indices, Weights, TapCount, CountX, Output);
+}
+
+void
+MLASCALL
+MlasResizeVertical(
+    const float* const* Rows,
+    const float* Weights,
+    size_t TapCount,
+    size_t N,
+    float* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine blends horizontally resized rows into an output row.
+
+Arguments:
+
+    Rows - Supplies the TapCount horizontally resized rows.
+
+    Weights - Supplies the TapCount weights of the rows.
+
+    TapCount - Supplies the number of rows.
+
+    N - Supplies the number of elements of each row.
+
+    Output - Supplies the output row.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_FLOAT32X4 WeightBroadcast0 = MlasBroadcastFloat32x4(Weights[0]);
+    const float* Row0 = Rows[0];
+
+    size_t n = 0;
+
+    for (; n + 8 <= N; n += 8) {
+
+        MLAS_FLOAT32X4 Accumulator0 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Row0 + n), WeightBroadcast0);
+        MLAS_FLOAT32X4 Accumulator1 = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Row0 + n + 4), WeightBroadcast0);
+
+        for (size_t t = 1; t < TapCount; t++) {
+            const MLAS_FLOAT32X4 WeightBroadcast = MlasBroadcastFloat32x4(Weights[t]);
+            Accumulator0 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Rows[t] + n), WeightBroadcast, Accumulator0);
+            Accumulator1 = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Rows[t] + n + 4), WeightBroadcast, Accumulator1);
+        }
+
+        MlasStoreFloat32x4(Output + n, Accumulator0);
+        MlasStoreFloat32x4(Output + n + 4, Accumulator1);
+    }
+
+    for (; n + 4 <= N; n += 4) {
+
+        MLAS_FLOAT32X4 Accumulator = MlasMultiplyFloat32x4(MlasLoadFloat32x4(Row0 + n), WeightBroadcast0);
+
+        for (size_t t = 1; t < TapCount; t++) {
+            Accumulator = MlasMultiplyAddFloat32x4(MlasLoadFloat32x4(Rows[t] + n),
+                MlasBroadcastFloat32x4(Weights[t]), Accumulator);
+        }
+
+        MlasStoreFloat32x4(Output + n, Accumulator);
+    }
+
+    for (; n < N; n++) {
+
+        float Accumulator = Weights[0] * Row0[n];
+
+        for (size_t t = 1; t < TapCount; t++) {
+            Accumulator += Weights[t] * Rows[t][n];
+        }
+
+        Output[n] = Accumulator;
+    }
+}
+
+template<typename OutputType>
+void
+MlasResizeVerticalInteger(
+    const int32_t* const* Rows,
+    const int32_t* Weights,
+    size_t TapCount,
+    size_t N,
+    int32_t Shift,
+    OutputType* Output
+    )
+/*++
+
+Routine Description:
+
+    This routine blends horizontally resized quantized rows into an output
+    row using fixed point weights.
+
+Arguments:
+
+    See MlasResizeVertical.
+
+    Shift - Supplies the number of fractional bits of the accumulated
+        horizontal and vertical weights.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    constexpr size_t BlockSize = 128;
+
+    const int32_t RoundTowardZero = (int32_t(1) << Shift) - 1;
+
+    int32_t Accumulators[BlockSize];
+
+    //
+    // Accumulate one row at a time over a block of elements so that the
+    // loops vectorize for any number of taps.
+    //
+
+    for (size_t n = 0; n < N; n += BlockSize) {
+
+        const size_t CountN = std::min(N - n, BlockSize);
+
+        const int32_t* Row0 = Rows[0] + n;
+        const int32_t Weight0 = Weights[0];
+
+        for (size_t i = 0; i < CountN; i++) {
+            Accumulators[i] = Weight0 * Row0[i];
+        }
+
+        for (size_t t = 1; t < TapCount; t++) {
+
+            const int32_t* RowT = Rows[t] + n;
+            const int32_t WeightT = Weights[t];
+
+            for (size_t i = 0; i < CountN; i++) {
+                Accumulators[i] += WeightT * RowT[i];
+            }
+        }
+
+        //
+        // Divide by (1 << Shift) rounding toward zero as integer division
+        // does, using an arithmetic shift that vectorizes.
+        //
+
+        for (size_t i = 0; i < CountN; i++) {
+            const int32_t Accumulator = Accumulators[i];
+            Output[n + i] = OutputType((Accumulator + ((Accumulator >> 31) & RoundTowardZero)) >> Shift);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasResizeVertical(
+    const int32_t* const* Rows,
+    const int32_t* Weights,
+    size_t TapCount,
+    size_t N,
+    int32_t Shift,
+    uint8_t* Output
+    )
+{
+    MlasResizeVerticalInteger(Rows, Weights, TapCount, N, Shift, Output);
+}
+
+void
+MLASCALL
+MlasResizeVertical(
+    const int32_t* const* Rows,
+    const int32_t* Weights,
+    size_t TapCount,
+    size_t N,
+    int32_t Shift,
+    int8_t* Output
+    )
+{
+    MlasResizeVerticalInteger(Rows, Weights, TapCount, N, Shift, Output);
+}
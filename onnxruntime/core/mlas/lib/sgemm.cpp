@@ -1015,7 +1015,8 @@ MlasSgemmKernelLoop(
     size_t lda,
     size_t ldc,
     float alpha,
-    bool ZeroMode
+    bool ZeroMode,
+    const MLAS_ACTIVATION* Activation
     )
 /*++
 
@@ -1051,6 +1052,9 @@ Arguments:
     ZeroMode - Supplies true if the output matrix must be zero initialized,
         else false if the output matrix is accumulated into.
 
+    Activation - Optionally supplies the activation to apply to the rows of
+        matrix C after the kernel has completed them.
+
 Return Value:
 
     Returns the next address of matrix C.
@@ -1071,6 +1075,15 @@ Return Value:
         }
 #endif
 
+        //
+        // Apply the activation to the completed rows while they are still in
+        // the cache.
+        //
+
+        if (Activation != nullptr) {
+            MlasActivation(Activation, C, nullptr, RowsHandled, CountN, ldc);
+        }
+
         C += ldc * RowsHandled;
         A += lda * RowsHandled;
         CountM -= RowsHandled;
@@ -1093,7 +1106,8 @@ MlasSgemmOperation(
     size_t ldb,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_ACTIVATION* Activation
     )
 /*++
 
@@ -1131,6 +1145,8 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Activation - Optionally supplies the activation to apply to matrix C.
+
 Return Value:
 
     None.
@@ -1140,6 +1156,10 @@ Return Value:
     float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_STRIDEK];
     MLAS_DECLSPEC_ALIGN(float PanelB[MLAS_SGEMM_STRIDEN * MLAS_SGEMM_STRIDEK], 16 * sizeof(float));
 
+    if (Activation != nullptr && Activation->ActivationKind == MlasIdentityActivation) {
+        Activation = nullptr;
+    }
+
     //
     // Handle the special case of K equals zero. Apply the beta multiplier to
     // the output matrix and exit.
@@ -1147,6 +1167,9 @@ Return Value:
 
     if (K == 0) {
         MlasSgemmMultiplyBeta(C, M, N, ldc, beta);
+        if (Activation != nullptr) {
+            MlasActivation(Activation, C, nullptr, M, N, ldc);
+        }
         return;
     }
 
@@ -1170,6 +1193,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(A, B, C, K, N, ldb, beta);
+            if (Activation != nullptr) {
+                MlasActivation(Activation, C, nullptr, 1, N, ldc);
+            }
             return;
         }
 
@@ -1177,6 +1203,9 @@ Return Value:
 
         if (TransB == CblasNoTrans) {
             MlasGemvFloatKernel(A, B, C, K, N, ldb, (beta == 0.0f));
+            if (Activation != nullptr) {
+                MlasActivation(Activation, C, nullptr, 1, N, ldc);
+            }
             return;
         }
 
@@ -1205,6 +1234,9 @@ Return Value:
 
         if (SgemmKernelM1Routine != nullptr) {
             SgemmKernelM1Routine(B, A, C, K, M, lda, beta);
+            if (Activation != nullptr) {
+                MlasActivation(Activation, C, nullptr, M, 1, 1);
+            }
             return;
         }
 
@@ -1267,6 +1299,13 @@ Return Value:
 
             CountK = std::min(K - k, StrideK);
 
+            //
+            // Apply the activation as part of the last slice along the K
+            // dimension.
+            //
+
+            const MLAS_ACTIVATION* SliceActivation = (k + CountK == K) ? Activation : nullptr;
+
             //
             // Copy or transpose a panel of matrix B to a local packed buffer.
             //
@@ -1285,7 +1324,7 @@ Return Value:
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoop(A + k, PanelB, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode, SliceActivation);
 
             } else {
 
@@ -1309,7 +1348,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, PanelB, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha,
+                                            ZeroMode, SliceActivation);
                 }
             }
 
@@ -1332,7 +1372,8 @@ MlasSgemmPackedOperation(
     size_t AlignedN,
     float beta,
     float* C,
-    size_t ldc
+    size_t ldc,
+    const MLAS_ACTIVATION* Activation
     )
 /*++
 
@@ -1372,6 +1413,8 @@ Arguments:
 
     ldc - Supplies the first dimension of matrix C.
 
+    Activation - Optionally supplies the activation to apply to matrix C.
+
 Return Value:
 
     None.
@@ -1380,6 +1423,23 @@ Return Value:
 {
     float PanelA[MLAS_SGEMM_TRANSA_ROWS * MLAS_SGEMM_PACKED_STRIDEK];
 
+    if (Activation != nullptr && Activation->ActivationKind == MlasIdentityActivation) {
+        Activation = nullptr;
+    }
+
+    //
+    // Handle the special case of K equals zero. Apply the beta multiplier to
+    // the output matrix and exit.
+    //
+
+    if (K == 0) {
+        MlasSgemmMultiplyBeta(C, M, RangeCountN, ldc, beta);
+        if (Activation != nullptr) {
+            MlasActivation(Activation, C, nullptr, M, RangeCountN, ldc);
+        }
+        return;
+    }
+
     //
     // Step through each slice of matrix B along the N dimension.
     //
@@ -1411,6 +1471,13 @@ Return Value:
 
             CountK = std::min(K - k, size_t(MLAS_SGEMM_PACKED_STRIDEK));
 
+            //
+            // Apply the activation as part of the last slice along the K
+            // dimension.
+            //
+
+            const MLAS_ACTIVATION* SliceActivation = (k + CountK == K) ? Activation : nullptr;
+
             //
             // Step through each slice of matrix A along the M dimension.
             //
@@ -1420,7 +1487,7 @@ Return Value:
 
             if (TransA == CblasNoTrans) {
 
-                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode);
+                MlasSgemmKernelLoop(A + k, pb, c, CountK, M, CountN, lda, ldc, alpha, ZeroMode, SliceActivation);
 
             } else {
 
@@ -1444,7 +1511,8 @@ Return Value:
                     // Step through the rows of the local buffer.
                     //
 
-                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha, ZeroMode);
+                    c = MlasSgemmKernelLoop(PanelA, pb, c, CountK, RowsTransposed, CountN, CountK, ldc, alpha,
+                                            ZeroMode, SliceActivation);
                 }
             }
 
@@ -1540,7 +1608,8 @@ Return Value:
 
         MlasSgemmPackedOperation(TransA, RangeCountM, RangeStartN, RangeCountN,
             K, DataParams->alpha, A, lda, DataParams->B,
-            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc);
+            BlockedN * MLAS_SGEMM_STRIDEN_THREAD_ALIGN, DataParams->beta, C, ldc,
+            DataParams->Activation);
 
     } else {
 
@@ -1549,7 +1618,8 @@ Return Value:
         const float* B = (const float*)DataParams->B + RangeStartN * ((TransB == CblasNoTrans) ? 1 : ldb);
 
         MlasSgemmOperation(TransA, TransB, RangeCountM, RangeCountN, K,
-            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc);
+            DataParams->alpha, A, lda, B, ldb, DataParams->beta, C, ldc,
+            DataParams->Activation);
     }
 }
 #if defined(_MSC_VER) && !defined(__clang__)
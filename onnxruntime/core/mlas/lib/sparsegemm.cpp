@@ -0,0 +1,950 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    sparsegemm.cpp
+
+Abstract:
+
+    This module implements the single precision and quantized matrix/matrix
+    multiply operations with a block sparse matrix B.
+
+    Matrix B is split into blocks of one row by MLAS_BLOCK_SPARSE_GEMM_BLOCK_N
+    columns and only the blocks holding a nonzero element are stored. The
+    kernels step through the nonzero blocks of a panel of columns, broadcast
+    the element of matrix A from the row of the block and accumulate the
+    block into a tile of matrix C held in registers. The work done is
+    proportional to the number of nonzero blocks, so a pruned weight matrix
+    with a low block density is multiplied in a fraction of the time of the
+    dense GEMM.
+
+    The packed buffer is laid out as:
+
+        MLAS_BLOCK_SPARSE_GEMM_HEADER
+        uint32_t PanelStart[PanelCountN + 1]    start of each panel in the
+                                                block arrays below
+        uint32_t BlockRowK[BlockCount]          row of matrix B of each block
+        padding to MLAS_BLOCK_SPARSE_GEMM_VALUES_ALIGN
+        ElementType Values[BlockCount][MLAS_BLOCK_SPARSE_GEMM_BLOCK_N]
+
+    where the element type is float for the single precision routines and
+    int16_t, holding the element minus its zero point, for the quantized
+    routines.
+
+    The quantized routines multiply pairs of 16-bit elements and add the
+    products to 32-bit accumulators in a single instruction, so the blocks of
+    a panel are stored in pairs with the elements of the two blocks
+    interleaved. A panel with an odd number of blocks is padded with a block
+    of zeros.
+
+--*/
+
+#include "mlasi.h"
+
+#include <limits>
+
+//
+// Alignment of the block elements in the packed buffer.
+//
+
+constexpr size_t MLAS_BLOCK_SPARSE_GEMM_VALUES_ALIGN = 64;
+
+//
+// Number of rows of matrix A processed by a kernel invocation.
+//
+
+constexpr size_t MLAS_BLOCK_SPARSE_GEMM_ROWS = 4;
+
+static_assert(MLAS_BLOCK_SPARSE_GEMM_BLOCK_N == 16, "kernels assume four vectors of four floats per block");
+
+struct MLAS_BLOCK_SPARSE_GEMM_HEADER {
+    uint64_t N;
+    uint64_t K;
+    uint64_t BlockCount;
+};
+
+template<typename ElementType>
+struct MLAS_BLOCK_SPARSE_GEMM_PACKED_B {
+    const MLAS_BLOCK_SPARSE_GEMM_HEADER* Header;
+    const uint32_t* PanelStart;
+    const uint32_t* BlockRowK;
+    const ElementType* Values;
+};
+
+MLAS_FORCEINLINE
+size_t
+MlasBlockSparseGemmPanelCount(
+    size_t N
+    )
+{
+    return (N + MLAS_BLOCK_SPARSE_GEMM_BLOCK_N - 1) / MLAS_BLOCK_SPARSE_GEMM_BLOCK_N;
+}
+
+MLAS_FORCEINLINE
+size_t
+MlasBlockSparseGemmValuesOffset(
+    size_t N,
+    size_t BlockCount
+    )
+{
+    const size_t IndexBytes = sizeof(MLAS_BLOCK_SPARSE_GEMM_HEADER) +
+        (MlasBlockSparseGemmPanelCount(N) + 1 + BlockCount) * sizeof(uint32_t);
+
+    return (IndexBytes + MLAS_BLOCK_SPARSE_GEMM_VALUES_ALIGN - 1) &
+        ~(MLAS_BLOCK_SPARSE_GEMM_VALUES_ALIGN - 1);
+}
+
+template<typename ElementType, bool PairBlocks>
+size_t
+MlasBlockSparseGemmPackBSize(
+    size_t N,
+    size_t K,
+    size_t BlockCount
+    )
+{
+    const size_t PanelCount = MlasBlockSparseGemmPanelCount(N);
+
+    if (BlockCount > K * PanelCount) {
+        return 0;
+    }
+
+    //
+    // Allow for the padding block of each panel.
+    //
+
+    if (PairBlocks) {
+        BlockCount += PanelCount;
+    }
+
+    //
+    // Block indices are stored as 32-bit values.
+    //
+
+    if (K > std::numeric_limits<uint32_t>::max() ||
+        BlockCount > std::numeric_limits<uint32_t>::max()) {
+        return 0;
+    }
+
+    return MlasBlockSparseGemmValuesOffset(N, BlockCount) +
+        BlockCount * MLAS_BLOCK_SPARSE_GEMM_BLOCK_N * sizeof(ElementType);
+}
+
+template<typename IsNonzeroFn>
+size_t
+MlasBlockSparseGemmCountBlocks(
+    size_t N,
+    size_t K,
+    IsNonzeroFn IsNonzero
+    )
+{
+    size_t BlockCount = 0;
+
+    for (size_t n = 0; n < N; n += MLAS_BLOCK_SPARSE_GEMM_BLOCK_N) {
+
+        const size_t CountN = std::min(N - n, size_t(MLAS_BLOCK_SPARSE_GEMM_BLOCK_N));
+
+        for (size_t k = 0; k < K; k++) {
+            for (size_t i = 0; i < CountN; i++) {
+                if (IsNonzero(k, n + i)) {
+                    BlockCount++;
+                    break;
+                }
+            }
+        }
+    }
+
+    return BlockCount;
+}
+
+template<typename ElementType, bool PairBlocks, typename IsNonzeroFn, typename LoadFn>
+void
+MlasBlockSparseGemmPackB(
+    size_t N,
+    size_t K,
+    IsNonzeroFn IsNonzero,
+    LoadFn Load,
+    void* PackedB
+    )
+{
+    const size_t PanelCount = MlasBlockSparseGemmPanelCount(N);
+
+    auto IsNonzeroBlock = [&](size_t k, size_t n) {
+        const size_t CountN = std::min(N - n, size_t(MLAS_BLOCK_SPARSE_GEMM_BLOCK_N));
+        for (size_t i = 0; i < CountN; i++) {
+            if (IsNonzero(k, n + i)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    //
+    // Count the stored blocks, including the padding blocks.
+    //
+
+    size_t NonzeroBlockCount = 0;
+    size_t BlockCount = 0;
+
+    for (size_t p = 0; p < PanelCount; p++) {
+
+        size_t PanelBlockCount = 0;
+
+        for (size_t k = 0; k < K; k++) {
+            if (IsNonzeroBlock(k, p * MLAS_BLOCK_SPARSE_GEMM_BLOCK_N)) {
+                PanelBlockCount++;
+            }
+        }
+
+        NonzeroBlockCount += PanelBlockCount;
+        BlockCount += PairBlocks ? (PanelBlockCount + 1) & ~size_t(1) : PanelBlockCount;
+    }
+
+    auto* Header = reinterpret_cast<MLAS_BLOCK_SPARSE_GEMM_HEADER*>(PackedB);
+    Header->N = N;
+    Header->K = K;
+    Header->BlockCount = BlockCount;
+
+    uint32_t* PanelStart = reinterpret_cast<uint32_t*>(Header + 1);
+    uint32_t* BlockRowK = PanelStart + PanelCount + 1;
+    ElementType* Values = reinterpret_cast<ElementType*>(
+        reinterpret_cast<uint8_t*>(PackedB) + MlasBlockSparseGemmValuesOffset(N, BlockCount));
+
+    //
+    // Clear the padding and the elements, as the packed buffer may be hashed
+    // when it is shared between sessions.
+    //
+
+    const size_t PackedBSize = MlasBlockSparseGemmPackBSize<ElementType, PairBlocks>(N, K, NonzeroBlockCount);
+
+    std::fill(reinterpret_cast<uint8_t*>(BlockRowK + BlockCount), reinterpret_cast<uint8_t*>(PackedB) + PackedBSize,
+        uint8_t(0));
+
+    size_t Block = 0;
+
+    for (size_t p = 0; p < PanelCount; p++) {
+
+        PanelStart[p] = uint32_t(Block);
+
+        const size_t n = p * MLAS_BLOCK_SPARSE_GEMM_BLOCK_N;
+        const size_t CountN = std::min(N - n, size_t(MLAS_BLOCK_SPARSE_GEMM_BLOCK_N));
+
+        for (size_t k = 0; k < K; k++) {
+
+            if (!IsNonzeroBlock(k, n)) {
+                continue;
+            }
+
+            BlockRowK[Block] = uint32_t(k);
+
+            for (size_t i = 0; i < CountN; i++) {
+                if (PairBlocks) {
+                    Values[(Block & ~size_t(1)) * MLAS_BLOCK_SPARSE_GEMM_BLOCK_N + i * 2 + (Block & 1)] = Load(k, n + i);
+                } else {
+                    Values[Block * MLAS_BLOCK_SPARSE_GEMM_BLOCK_N + i] = Load(k, n + i);
+                }
+            }
+
+            Block++;
+        }
+
+        //
+        // The padding block of zeros refers to the row of the previous block,
+        // so the kernels never read matrix A out of bounds.
+        //
+
+        if (PairBlocks && (Block & 1) != 0) {
+            BlockRowK[Block] = BlockRowK[Block - 1];
+            Block++;
+        }
+    }
+
+    PanelStart[PanelCount] = uint32_t(Block);
+}
+
+template<typename ElementType>
+MLAS_BLOCK_SPARSE_GEMM_PACKED_B<ElementType>
+MlasBlockSparseGemmUnpackLayout(
+    const void* PackedB
+    )
+{
+    MLAS_BLOCK_SPARSE_GEMM_PACKED_B<ElementType> Layout;
+
+    Layout.Header = reinterpret_cast<const MLAS_BLOCK_SPARSE_GEMM_HEADER*>(PackedB);
+
+    const size_t N = size_t(Layout.Header->N);
+    const size_t BlockCount = size_t(Layout.Header->BlockCount);
+
+    Layout.PanelStart = reinterpret_cast<const uint32_t*>(Layout.Header + 1);
+    Layout.BlockRowK = Layout.PanelStart + MlasBlockSparseGemmPanelCount(N) + 1;
+    Layout.Values = reinterpret_cast<const ElementType*>(
+        reinterpret_cast<const uint8_t*>(PackedB) + MlasBlockSparseGemmValuesOffset(N, BlockCount));
+
+    return Layout;
+}
+
+template<typename ThreadedFn>
+void
+MlasBlockSparseGemmSchedule(
+    size_t M,
+    size_t N,
+    size_t BlockCount,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool,
+    ThreadedFn Threaded
+    )
+/*++
+
+Routine Description:
+
+    This routine segments a batch of block sparse GEMM operations across
+    threads and invokes the supplied routine for each segment.
+
+Arguments:
+
+    M - Supplies the number of rows of matrix A and matrix C.
+
+    N - Supplies the number of columns of matrix B and matrix C.
+
+    BlockCount - Supplies the number of nonzero blocks of matrix B.
+
+    BatchSize - Supplies the number of multiplications in the batch.
+
+    ThreadPool - Supplies the thread pool object to use.
+
+    Threaded - Supplies the routine invoked with the index of the
+        multiplication and the range of rows and panels to compute.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    //
+    // Compute the number of target threads given the complexity of the
+    // operation, which is proportional to the number of nonzero blocks.
+    //
+
+    const double Complexity = double(M) * double(BlockCount) * double(MLAS_BLOCK_SPARSE_GEMM_BLOCK_N);
+
+    ptrdiff_t TargetThreadCount;
+
+    if (Complexity < double(MLAS_BLOCK_SPARSE_GEMM_THREAD_COMPLEXITY * GetMlasPlatform().MaximumThreadCount)) {
+        TargetThreadCount = ptrdiff_t(Complexity / double(MLAS_BLOCK_SPARSE_GEMM_THREAD_COMPLEXITY)) + 1;
+    } else {
+        TargetThreadCount = GetMlasPlatform().MaximumThreadCount;
+    }
+
+    ptrdiff_t MaximumThreadCount = MlasGetMaximumThreadCount(ThreadPool);
+
+    if (TargetThreadCount >= MaximumThreadCount) {
+        TargetThreadCount = MaximumThreadCount;
+    }
+
+    //
+    // Prefer to partition along the N dimension so that each thread streams
+    // a distinct set of panels of matrix B.
+    //
+
+    const size_t PanelCount = MlasBlockSparseGemmPanelCount(N);
+
+    ptrdiff_t ThreadsPerGemm = (TargetThreadCount + BatchSize - 1) / BatchSize;
+    ptrdiff_t ThreadCountM;
+    ptrdiff_t ThreadCountN;
+
+    if (size_t(ThreadsPerGemm) <= PanelCount || PanelCount >= M) {
+
+        if (size_t(ThreadsPerGemm) > PanelCount) {
+            ThreadsPerGemm = ptrdiff_t(PanelCount);
+        }
+
+        ThreadCountM = 1;
+        ThreadCountN = ThreadsPerGemm;
+
+    } else {
+
+        if (size_t(ThreadsPerGemm) > M) {
+            ThreadsPerGemm = ptrdiff_t(M);
+        }
+
+        ThreadCountM = ThreadsPerGemm;
+        ThreadCountN = 1;
+    }
+
+    MlasTrySimpleParallel(ThreadPool,
+        ThreadsPerGemm * static_cast<ptrdiff_t>(BatchSize),
+        [=](ptrdiff_t tid)
+    {
+        const size_t GemmIdx = size_t(tid / ThreadsPerGemm);
+        const ptrdiff_t ThreadIdx = tid % ThreadsPerGemm;
+
+        size_t RangeStartM;
+        size_t RangeCountM;
+
+        MlasPartitionWork(ThreadIdx / ThreadCountN, ThreadCountM, M, &RangeStartM, &RangeCountM);
+
+        size_t RangeStartPanel;
+        size_t RangeCountPanel;
+
+        MlasPartitionWork(ThreadIdx % ThreadCountN, ThreadCountN, PanelCount, &RangeStartPanel, &RangeCountPanel);
+
+        Threaded(GemmIdx, RangeStartM, RangeCountM, RangeStartPanel, RangeCountPanel);
+    });
+}
+
+//
+// Single precision routines.
+//
+
+template<size_t RowCount>
+void
+MlasBlockSparseSgemmKernelTile(
+    const float* A,
+    size_t lda,
+    const uint32_t* BlockRowK,
+    const float* Values,
+    size_t BlockCount,
+    float* C,
+    size_t ldc,
+    size_t CountN,
+    float alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute a tile of RowCount rows by one
+    panel of columns of a matrix multiplication with a block sparse matrix B.
+
+Arguments:
+
+    A - Supplies the address of the first row of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    BlockRowK - Supplies the rows of matrix B of the blocks of the panel.
+
+    Values - Supplies the elements of the blocks of the panel.
+
+    BlockCount - Supplies the number of blocks of the panel.
+
+    C - Supplies the address of the first row of the tile of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountN - Supplies the number of columns of the panel, at most
+        MLAS_BLOCK_SPARSE_GEMM_BLOCK_N.
+
+    alpha - Supplies the scalar multiplier.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    MLAS_FLOAT32X4 Accumulators[RowCount][4];
+
+    for (size_t r = 0; r < RowCount; r++) {
+        for (size_t v = 0; v < 4; v++) {
+            Accumulators[r][v] = MlasZeroFloat32x4();
+        }
+    }
+
+    for (size_t b = 0; b < BlockCount; b++) {
+
+        const float* a = A + BlockRowK[b];
+
+        const MLAS_FLOAT32X4 B0 = MlasLoadFloat32x4(Values);
+        const MLAS_FLOAT32X4 B1 = MlasLoadFloat32x4(Values + 4);
+        const MLAS_FLOAT32X4 B2 = MlasLoadFloat32x4(Values + 8);
+        const MLAS_FLOAT32X4 B3 = MlasLoadFloat32x4(Values + 12);
+
+        for (size_t r = 0; r < RowCount; r++) {
+            const MLAS_FLOAT32X4 ABroadcast = MlasBroadcastFloat32x4(a + r * lda);
+            Accumulators[r][0] = MlasMultiplyAddFloat32x4(B0, ABroadcast, Accumulators[r][0]);
+            Accumulators[r][1] = MlasMultiplyAddFloat32x4(B1, ABroadcast, Accumulators[r][1]);
+            Accumulators[r][2] = MlasMultiplyAddFloat32x4(B2, ABroadcast, Accumulators[r][2]);
+            Accumulators[r][3] = MlasMultiplyAddFloat32x4(B3, ABroadcast, Accumulators[r][3]);
+        }
+
+        Values += MLAS_BLOCK_SPARSE_GEMM_BLOCK_N;
+    }
+
+    const MLAS_FLOAT32X4 AlphaBroadcast = MlasBroadcastFloat32x4(alpha);
+
+    for (size_t r = 0; r < RowCount; r++) {
+
+        float* c = C + r * ldc;
+
+        if (CountN == MLAS_BLOCK_SPARSE_GEMM_BLOCK_N) {
+
+            for (size_t v = 0; v < 4; v++) {
+                MlasStoreFloat32x4(c + v * 4, MlasMultiplyFloat32x4(Accumulators[r][v], AlphaBroadcast));
+            }
+
+        } else {
+
+            float Row[MLAS_BLOCK_SPARSE_GEMM_BLOCK_N];
+
+            for (size_t v = 0; v < 4; v++) {
+                MlasStoreFloat32x4(Row + v * 4, MlasMultiplyFloat32x4(Accumulators[r][v], AlphaBroadcast));
+            }
+
+            std::copy_n(Row, CountN, c);
+        }
+    }
+}
+
+void
+MLASCALL
+MlasBlockSparseSgemmKernel(
+    const float* A,
+    size_t lda,
+    const uint32_t* BlockRowK,
+    const float* Values,
+    size_t BlockCount,
+    float* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN,
+    float alpha
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute CountM rows by one panel of
+    columns of a matrix multiplication with a block sparse matrix B.
+
+Arguments:
+
+    A - Supplies the address of the first row of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    BlockRowK - Supplies the rows of matrix B of the blocks of the panel.
+
+    Values - Supplies the elements of the blocks of the panel.
+
+    BlockCount - Supplies the number of blocks of the panel.
+
+    C - Supplies the address of the first row of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountM - Supplies the number of rows of matrix A and matrix C.
+
+    CountN - Supplies the number of columns of the panel, at most
+        MLAS_BLOCK_SPARSE_GEMM_BLOCK_N.
+
+    alpha - Supplies the scalar multiplier.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    size_t m = 0;
+
+    for (; m + MLAS_BLOCK_SPARSE_GEMM_ROWS <= CountM; m += MLAS_BLOCK_SPARSE_GEMM_ROWS) {
+        MlasBlockSparseSgemmKernelTile<MLAS_BLOCK_SPARSE_GEMM_ROWS>(A + m * lda, lda,
+            BlockRowK, Values, BlockCount, C + m * ldc, ldc, CountN, alpha);
+    }
+
+    for (; m < CountM; m++) {
+        MlasBlockSparseSgemmKernelTile<1>(A + m * lda, lda,
+            BlockRowK, Values, BlockCount, C + m * ldc, ldc, CountN, alpha);
+    }
+}
+
+size_t
+MLASCALL
+MlasBlockSparseSgemmCountBlocks(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    float Threshold
+    )
+{
+    if (TransB == CblasNoTrans) {
+        return MlasBlockSparseGemmCountBlocks(N, K,
+            [=](size_t k, size_t n) { return std::fabs(B[k * ldb + n]) > Threshold; });
+    } else {
+        return MlasBlockSparseGemmCountBlocks(N, K,
+            [=](size_t k, size_t n) { return std::fabs(B[n * ldb + k]) > Threshold; });
+    }
+}
+
+size_t
+MLASCALL
+MlasBlockSparseSgemmPackBSize(
+    size_t N,
+    size_t K,
+    size_t BlockCount
+    )
+{
+    return MlasBlockSparseGemmPackBSize<float, false>(N, K, BlockCount);
+}
+
+void
+MLASCALL
+MlasBlockSparseSgemmPackB(
+    CBLAS_TRANSPOSE TransB,
+    size_t N,
+    size_t K,
+    const float* B,
+    size_t ldb,
+    float Threshold,
+    void* PackedB
+    )
+{
+    if (TransB == CblasNoTrans) {
+        MlasBlockSparseGemmPackB<float, false>(N, K,
+            [=](size_t k, size_t n) { return std::fabs(B[k * ldb + n]) > Threshold; },
+            [=](size_t k, size_t n) { return B[k * ldb + n]; },
+            PackedB);
+    } else {
+        MlasBlockSparseGemmPackB<float, false>(N, K,
+            [=](size_t k, size_t n) { return std::fabs(B[n * ldb + k]) > Threshold; },
+            [=](size_t k, size_t n) { return B[n * ldb + k]; },
+            PackedB);
+    }
+}
+
+void
+MLASCALL
+MlasBlockSparseSgemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    const MLAS_BLOCK_SPARSE_SGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(K);
+
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
+
+    const size_t BlockCount = size_t(MlasBlockSparseGemmUnpackLayout<float>(Data[0].PackedB).Header->BlockCount);
+
+    MLAS_BLOCK_SPARSE_SGEMM_KERNEL* Kernel = GetMlasPlatform().BlockSparseSgemmKernel;
+
+    MlasBlockSparseGemmSchedule(M, N, BlockCount, BatchSize, ThreadPool,
+        [=](size_t GemmIdx, size_t StartM, size_t CountM, size_t StartPanel, size_t CountPanel)
+    {
+        const MLAS_BLOCK_SPARSE_SGEMM_DATA_PARAMS& Params = Data[GemmIdx];
+        const auto Layout = MlasBlockSparseGemmUnpackLayout<float>(Params.PackedB);
+
+        for (size_t p = StartPanel; p < StartPanel + CountPanel; p++) {
+
+            const size_t n = p * MLAS_BLOCK_SPARSE_GEMM_BLOCK_N;
+            const size_t CountN = std::min(N - n, size_t(MLAS_BLOCK_SPARSE_GEMM_BLOCK_N));
+
+            const uint32_t* BlockRowK = Layout.BlockRowK + Layout.PanelStart[p];
+            const float* Values = Layout.Values + size_t(Layout.PanelStart[p]) * MLAS_BLOCK_SPARSE_GEMM_BLOCK_N;
+            const size_t PanelBlockCount = Layout.PanelStart[p + 1] - Layout.PanelStart[p];
+
+            Kernel(Params.A + StartM * Params.lda, Params.lda, BlockRowK, Values, PanelBlockCount,
+                Params.C + StartM * Params.ldc + n, Params.ldc, CountM, CountN, Params.alpha);
+        }
+    });
+}
+
+//
+// Quantized routines.
+//
+
+template<size_t RowCount, typename AType>
+void
+MlasBlockSparseQgemmKernelTile(
+    const AType* A,
+    size_t lda,
+    int32_t ZeroPointA,
+    const uint32_t* BlockRowK,
+    const int16_t* Values,
+    size_t BlockCount,
+    int32_t* C,
+    size_t ldc,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute a tile of RowCount rows by one
+    panel of columns of a quantized matrix multiplication with a block sparse
+    matrix B.
+
+Arguments:
+
+    A - Supplies the address of the first row of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ZeroPointA - Supplies the zero point of matrix A.
+
+    BlockRowK - Supplies the rows of matrix B of the blocks of the panel.
+
+    Values - Supplies the interleaved elements of the pairs of blocks of the
+        panel, minus their zero points.
+
+    BlockCount - Supplies the number of blocks of the panel, a multiple of
+        two.
+
+    C - Supplies the address of the first row of the tile of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountN - Supplies the number of columns of the panel, at most
+        MLAS_BLOCK_SPARSE_GEMM_BLOCK_N.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    int32_t Accumulators[RowCount][MLAS_BLOCK_SPARSE_GEMM_BLOCK_N] = {};
+
+    for (size_t b = 0; b < BlockCount; b += 2) {
+
+        const AType* a0 = A + BlockRowK[b];
+        const AType* a1 = A + BlockRowK[b + 1];
+
+        for (size_t r = 0; r < RowCount; r++) {
+
+            const int32_t AValue0 = int32_t(a0[r * lda]) - ZeroPointA;
+            const int32_t AValue1 = int32_t(a1[r * lda]) - ZeroPointA;
+
+            for (size_t i = 0; i < MLAS_BLOCK_SPARSE_GEMM_BLOCK_N; i++) {
+                Accumulators[r][i] += AValue0 * int32_t(Values[i * 2]) + AValue1 * int32_t(Values[i * 2 + 1]);
+            }
+        }
+
+        Values += 2 * MLAS_BLOCK_SPARSE_GEMM_BLOCK_N;
+    }
+
+    for (size_t r = 0; r < RowCount; r++) {
+        std::copy_n(Accumulators[r], CountN, C + r * ldc);
+    }
+}
+
+template<typename AType>
+void
+MlasBlockSparseQgemmKernelRows(
+    const AType* A,
+    size_t lda,
+    int32_t ZeroPointA,
+    const uint32_t* BlockRowK,
+    const int16_t* Values,
+    size_t BlockCount,
+    int32_t* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN
+    )
+{
+    size_t m = 0;
+
+    for (; m + MLAS_BLOCK_SPARSE_GEMM_ROWS <= CountM; m += MLAS_BLOCK_SPARSE_GEMM_ROWS) {
+        MlasBlockSparseQgemmKernelTile<MLAS_BLOCK_SPARSE_GEMM_ROWS>(A + m * lda, lda, ZeroPointA,
+            BlockRowK, Values, BlockCount, C + m * ldc, ldc, CountN);
+    }
+
+    for (; m < CountM; m++) {
+        MlasBlockSparseQgemmKernelTile<1>(A + m * lda, lda, ZeroPointA,
+            BlockRowK, Values, BlockCount, C + m * ldc, ldc, CountN);
+    }
+}
+
+void
+MLASCALL
+MlasBlockSparseQgemmKernel(
+    const uint8_t* A,
+    size_t lda,
+    int32_t ZeroPointA,
+    bool AIsSigned,
+    const uint32_t* BlockRowK,
+    const int16_t* Values,
+    size_t BlockCount,
+    int32_t* C,
+    size_t ldc,
+    size_t CountM,
+    size_t CountN
+    )
+/*++
+
+Routine Description:
+
+    This routine is an inner kernel to compute CountM rows by one panel of
+    columns of a quantized matrix multiplication with a block sparse matrix
+    B.
+
+Arguments:
+
+    A - Supplies the address of the first row of matrix A.
+
+    lda - Supplies the first dimension of matrix A.
+
+    ZeroPointA - Supplies the zero point of matrix A.
+
+    AIsSigned - Supplies true if matrix A is signed data.
+
+    BlockRowK - Supplies the rows of matrix B of the blocks of the panel.
+
+    Values - Supplies the interleaved elements of the pairs of blocks of the
+        panel, minus their zero points.
+
+    BlockCount - Supplies the number of blocks of the panel, a multiple of
+        two.
+
+    C - Supplies the address of the first row of matrix C.
+
+    ldc - Supplies the first dimension of matrix C.
+
+    CountM - Supplies the number of rows of matrix A and matrix C.
+
+    CountN - Supplies the number of columns of the panel, at most
+        MLAS_BLOCK_SPARSE_GEMM_BLOCK_N.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (AIsSigned) {
+        MlasBlockSparseQgemmKernelRows(reinterpret_cast<const int8_t*>(A), lda, ZeroPointA,
+            BlockRowK, Values, BlockCount, C, ldc, CountM, CountN);
+    } else {
+        MlasBlockSparseQgemmKernelRows(A, lda, ZeroPointA,
+            BlockRowK, Values, BlockCount, C, ldc, CountM, CountN);
+    }
+}
+
+MLAS_FORCEINLINE
+int32_t
+MlasBlockSparseQgemmLoadB(
+    const uint8_t* B,
+    bool BIsSigned
+    )
+{
+    return BIsSigned ? int32_t(int8_t(*B)) : int32_t(*B);
+}
+
+size_t
+MLASCALL
+MlasBlockSparseQgemmCountBlocks(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    bool BIsSigned,
+    const uint8_t* ZeroPointB,
+    bool PerColumnZeroPoints
+    )
+{
+    //
+    // The zero point has the same representation as the elements, so the
+    // bytes are compared directly.
+    //
+
+    MLAS_UNREFERENCED_PARAMETER(BIsSigned);
+
+    return MlasBlockSparseGemmCountBlocks(N, K,
+        [=](size_t k, size_t n) {
+            return B[k * ldb + n] != ZeroPointB[PerColumnZeroPoints ? n : 0];
+        });
+}
+
+size_t
+MLASCALL
+MlasBlockSparseQgemmPackBSize(
+    size_t N,
+    size_t K,
+    size_t BlockCount
+    )
+{
+    return MlasBlockSparseGemmPackBSize<int16_t, true>(N, K, BlockCount);
+}
+
+void
+MLASCALL
+MlasBlockSparseQgemmPackB(
+    size_t N,
+    size_t K,
+    const uint8_t* B,
+    size_t ldb,
+    bool BIsSigned,
+    const uint8_t* ZeroPointB,
+    bool PerColumnZeroPoints,
+    void* PackedB
+    )
+{
+    MlasBlockSparseGemmPackB<int16_t, true>(N, K,
+        [=](size_t k, size_t n) {
+            return B[k * ldb + n] != ZeroPointB[PerColumnZeroPoints ? n : 0];
+        },
+        [=](size_t k, size_t n) {
+            const uint8_t* ZeroPoint = &ZeroPointB[PerColumnZeroPoints ? n : 0];
+            return int16_t(MlasBlockSparseQgemmLoadB(&B[k * ldb + n], BIsSigned) -
+                MlasBlockSparseQgemmLoadB(ZeroPoint, BIsSigned));
+        },
+        PackedB);
+}
+
+void
+MLASCALL
+MlasBlockSparseQgemmBatch(
+    size_t M,
+    size_t N,
+    size_t K,
+    bool AIsSigned,
+    const MLAS_BLOCK_SPARSE_QGEMM_DATA_PARAMS* Data,
+    size_t BatchSize,
+    MLAS_THREADPOOL* ThreadPool
+    )
+{
+    MLAS_UNREFERENCED_PARAMETER(K);
+
+    if (M == 0 || N == 0 || BatchSize == 0) {
+        return;
+    }
+
+    const size_t BlockCount = size_t(MlasBlockSparseGemmUnpackLayout<int16_t>(Data[0].PackedB).Header->BlockCount);
+
+    MLAS_BLOCK_SPARSE_QGEMM_KERNEL* Kernel = GetMlasPlatform().BlockSparseQgemmKernel;
+
+    MlasBlockSparseGemmSchedule(M, N, BlockCount, BatchSize, ThreadPool,
+        [=](size_t GemmIdx, size_t StartM, size_t CountM, size_t StartPanel, size_t CountPanel)
+    {
+        const MLAS_BLOCK_SPARSE_QGEMM_DATA_PARAMS& Params = Data[GemmIdx];
+        const auto Layout = MlasBlockSparseGemmUnpackLayout<int16_t>(Params.PackedB);
+
+        const int32_t ZeroPointA = AIsSigned ? int32_t(int8_t(Params.ZeroPointA)) : int32_t(Params.ZeroPointA);
+
+        for (size_t p = StartPanel; p < StartPanel + CountPanel; p++) {
+
+            const size_t n = p * MLAS_BLOCK_SPARSE_GEMM_BLOCK_N;
+            const size_t CountN = std::min(N - n, size_t(MLAS_BLOCK_SPARSE_GEMM_BLOCK_N));
+
+            const uint32_t* BlockRowK = Layout.BlockRowK + Layout.PanelStart[p];
+            const int16_t* Values = Layout.Values + size_t(Layout.PanelStart[p]) * MLAS_BLOCK_SPARSE_GEMM_BLOCK_N;
+            const size_t PanelBlockCount = Layout.PanelStart[p + 1] - Layout.PanelStart[p];
+
+            Kernel(Params.A + StartM * Params.lda, Params.lda, ZeroPointA, AIsSigned, BlockRowK, Values,
+                PanelBlockCount, Params.C + StartM * Params.ldc + n, Params.ldc, CountM, CountN);
+        }
+    });
+}
@@ -0,0 +1,333 @@
+/*++
+
+Copyright (c) Microsoft Corporation. All rights reserved.
+
+Licensed under the MIT License.
+
+Module Name:
+
+    topk.cpp
+
+Abstract:
+
+    This module implements the selection of the K largest or smallest
+    elements of a single precision vector, as used by the TopK operator.
+
+    The vector is scanned against a threshold, the K-th best value found so
+    far. Blocks of elements are reduced with vector maximum (or minimum)
+    operations, and only the blocks that hold an element better than the
+    threshold are inspected element by element. Such elements are appended
+    to a candidate buffer that is periodically partitioned down to the K best
+    elements, which raises the threshold. For typical inputs few blocks pass
+    the threshold test and the scan runs at the speed of the vector loads.
+
+    The vector is split into chunks that are scanned in parallel and the
+    candidates of every chunk are merged at the end.
+
+--*/
+
+#include "mlasi.h"
+
+#include <algorithm>
+
+//
+// Number of elements reduced before comparing against the threshold.
+//
+
+constexpr size_t MLAS_TOPK_BLOCK_SIZE = 32;
+
+//
+// Minimum number of elements scanned by a thread.
+//
+
+constexpr size_t MLAS_TOPK_MINIMUM_CHUNK_SIZE = 16 * 1024;
+
+//
+// Number of candidates buffered beyond 2 * K before the candidates are
+// partitioned down to K.
+//
+
+constexpr size_t MLAS_TOPK_CANDIDATE_SLACK = 256;
+
+struct MLAS_TOPK_CANDIDATE {
+    float Value;
+    uint32_t Index;
+};
+
+struct MLAS_TOPK_LARGEST {
+    static bool IsBetter(float Value1, float Value2) { return Value1 > Value2; }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+    {
+        return MlasMaximumFloat32x4(Vector1, Vector2);
+    }
+
+    static float Reduce(MLAS_FLOAT32X4 Vector) { return MlasReduceMaximumFloat32x4(Vector); }
+};
+
+struct MLAS_TOPK_SMALLEST {
+    static bool IsBetter(float Value1, float Value2) { return Value1 < Value2; }
+
+    static MLAS_FLOAT32X4 Combine(MLAS_FLOAT32X4 Vector1, MLAS_FLOAT32X4 Vector2)
+    {
+        return MlasMinimumFloat32x4(Vector1, Vector2);
+    }
+
+    static float Reduce(MLAS_FLOAT32X4 Vector) { return MlasReduceMinimumFloat32x4(Vector); }
+};
+
+template<typename Ranking>
+struct MLAS_TOPK_CANDIDATE_ORDER {
+    bool operator()(const MLAS_TOPK_CANDIDATE& lhs, const MLAS_TOPK_CANDIDATE& rhs) const
+    {
+        return Ranking::IsBetter(lhs.Value, rhs.Value) || (lhs.Value == rhs.Value && lhs.Index < rhs.Index);
+    }
+};
+
+template<typename Ranking>
+void
+MlasTopKScan(
+    const float* Input,
+    size_t Start,
+    size_t End,
+    size_t K,
+    MLAS_TOPK_CANDIDATE* Candidates
+    )
+/*++
+
+Routine Description:
+
+    This routine finds the K best elements of a range of a vector.
+
+Arguments:
+
+    Input - Supplies the input vector.
+
+    Start - Supplies the index of the first element of the range.
+
+    End - Supplies the index one past the last element of the range.
+
+    K - Supplies the number of elements to find. This must not exceed the
+        number of elements of the range.
+
+    Candidates - Supplies the storage for 2 * K + MLAS_TOPK_CANDIDATE_SLACK
+        candidates. The first K candidates hold the best elements of the range
+        on return, in no particular order.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_TOPK_CANDIDATE_ORDER<Ranking> Order;
+    const size_t Capacity = 2 * K + MLAS_TOPK_CANDIDATE_SLACK;
+
+    //
+    // Seed the candidates with the first K elements. The threshold is the
+    // worst of the candidates.
+    //
+
+    size_t Count = 0;
+    size_t n = Start;
+
+    float Threshold = Input[n];
+
+    for (; Count < K; n++) {
+        Candidates[Count].Value = Input[n];
+        Candidates[Count].Index = uint32_t(n);
+        Count++;
+        if (Ranking::IsBetter(Threshold, Input[n])) {
+            Threshold = Input[n];
+        }
+    }
+
+    //
+    // Every element that is scanned from here on has a higher index than the
+    // candidates, so an element that equals the threshold ranks below it and
+    // can be skipped.
+    //
+
+    const auto Append = [&](size_t Index) {
+        Candidates[Count].Value = Input[Index];
+        Candidates[Count].Index = uint32_t(Index);
+        Count++;
+        if (Count == Capacity) {
+            std::nth_element(Candidates, Candidates + (K - 1), Candidates + Count, Order);
+            Count = K;
+            Threshold = Candidates[K - 1].Value;
+        }
+    };
+
+    for (; n + MLAS_TOPK_BLOCK_SIZE <= End; n += MLAS_TOPK_BLOCK_SIZE) {
+
+        const float* p = Input + n;
+
+        MLAS_FLOAT32X4 Best0 = Ranking::Combine(MlasLoadFloat32x4(p + 0), MlasLoadFloat32x4(p + 4));
+        MLAS_FLOAT32X4 Best1 = Ranking::Combine(MlasLoadFloat32x4(p + 8), MlasLoadFloat32x4(p + 12));
+        MLAS_FLOAT32X4 Best2 = Ranking::Combine(MlasLoadFloat32x4(p + 16), MlasLoadFloat32x4(p + 20));
+        MLAS_FLOAT32X4 Best3 = Ranking::Combine(MlasLoadFloat32x4(p + 24), MlasLoadFloat32x4(p + 28));
+
+        Best0 = Ranking::Combine(Best0, Best1);
+        Best2 = Ranking::Combine(Best2, Best3);
+
+        if (!Ranking::IsBetter(Ranking::Reduce(Ranking::Combine(Best0, Best2)), Threshold)) {
+            continue;
+        }
+
+        for (size_t i = n; i < n + MLAS_TOPK_BLOCK_SIZE; i++) {
+            if (Ranking::IsBetter(Input[i], Threshold)) {
+                Append(i);
+            }
+        }
+    }
+
+    for (; n < End; n++) {
+        if (Ranking::IsBetter(Input[n], Threshold)) {
+            Append(n);
+        }
+    }
+
+    if (Count > K) {
+        std::nth_element(Candidates, Candidates + (K - 1), Candidates + Count, Order);
+    }
+}
+
+template<typename Ranking>
+void
+MlasTopKImpl(
+    const float* Input,
+    size_t N,
+    size_t K,
+    bool Sorted,
+    float* Values,
+    int64_t* Indices,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine implements MlasTopK for the ranking of values.
+
+Arguments:
+
+    See MlasTopK.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    const MLAS_TOPK_CANDIDATE_ORDER<Ranking> Order;
+
+    //
+    // Split the vector into chunks that are scanned in parallel. Each chunk
+    // must hold at least K elements.
+    //
+
+    size_t ChunkCount = N / std::max(MLAS_TOPK_MINIMUM_CHUNK_SIZE, K);
+    ChunkCount = std::min(ChunkCount, size_t(MlasGetMaximumThreadCount(ThreadPool)));
+    ChunkCount = std::max(ChunkCount, size_t(1));
+
+    const size_t ChunkSize = N / ChunkCount;
+    const size_t ChunkCapacity = 2 * K + MLAS_TOPK_CANDIDATE_SLACK;
+
+    MlasThreadedBufAlloc(ChunkCount * ChunkCapacity * sizeof(MLAS_TOPK_CANDIDATE));
+
+    MLAS_TOPK_CANDIDATE* Candidates = reinterpret_cast<MLAS_TOPK_CANDIDATE*>(ThreadedBufHolder.get());
+
+    MlasTrySimpleParallel(ThreadPool, ptrdiff_t(ChunkCount), [&](ptrdiff_t tid) {
+
+        const size_t Start = size_t(tid) * ChunkSize;
+        const size_t End = (size_t(tid) + 1 == ChunkCount) ? N : Start + ChunkSize;
+
+        MlasTopKScan<Ranking>(Input, Start, End, K, Candidates + size_t(tid) * ChunkCapacity);
+    });
+
+    //
+    // Merge the best elements of each chunk.
+    //
+
+    size_t Count = K;
+
+    if (ChunkCount > 1) {
+
+        for (size_t chunk = 1; chunk < ChunkCount; chunk++) {
+            std::copy_n(Candidates + chunk * ChunkCapacity, K, Candidates + Count);
+            Count += K;
+        }
+
+        std::nth_element(Candidates, Candidates + (K - 1), Candidates + Count, Order);
+    }
+
+    if (Sorted) {
+        std::sort(Candidates, Candidates + K, Order);
+    }
+
+    for (size_t k = 0; k < K; k++) {
+        Values[k] = Candidates[k].Value;
+        Indices[k] = int64_t(Candidates[k].Index);
+    }
+}
+
+void
+MLASCALL
+MlasTopK(
+    const float* Input,
+    size_t N,
+    size_t K,
+    bool Largest,
+    bool Sorted,
+    float* Values,
+    int64_t* Indices,
+    MLAS_THREADPOOL* ThreadPool
+    )
+/*++
+
+Routine Description:
+
+    This routine selects the K largest or smallest elements of a vector.
+
+    Equal values are ranked by ascending index. The selection is unspecified
+    if the vector holds NaN values.
+
+Arguments:
+
+    Input - Supplies the input vector.
+
+    N - Supplies the number of elements of the input vector. This must not
+        exceed UINT32_MAX.
+
+    K - Supplies the number of elements to select. This must not exceed N.
+
+    Largest - Supplies true to select the largest elements, else the smallest
+        elements are selected.
+
+    Sorted - Supplies true to produce the selected elements from best to
+        worst, else the order of the selected elements is unspecified.
+
+    Values - Supplies the K selected values.
+
+    Indices - Supplies the K indices of the selected values.
+
+    ThreadPool - Supplies the thread pool object to use, else nullptr if the
+        base library threading support should be used.
+
+Return Value:
+
+    None.
+
+--*/
+{
+    if (K == 0) {
+        return;
+    }
+
+    if (Largest) {
+        MlasTopKImpl<MLAS_TOPK_LARGEST>(Input, N, K, Sorted, Values, Indices, ThreadPool);
+    } else {
+        MlasTopKImpl<MLAS_TOPK_SMALLEST>(Input, N, K, Sorted, Values, Indices, ThreadPool);
+    }
+}
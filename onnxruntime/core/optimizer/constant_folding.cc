@@ -1,14 +1,21 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
 #include <limits>
+#include <sstream>
 
 #include "core/optimizer/constant_folding.h"
 #include "core/optimizer/utils.h"
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/optimizer_execution_frame.h"
 #include "core/framework/op_kernel.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/path_lib.h"
 
 using namespace onnxruntime::common;
 
@@ -17,11 +24,138 @@ namespace onnxruntime {
 ConstantFolding::ConstantFolding(const IExecutionProvider& execution_provider,
                                  bool skip_dequantize_linear,
                                  const InlinedHashSet<std::string_view>& compatible_execution_providers,
-                                 const InlinedHashSet<std::string>& excluded_initializers) noexcept
+                                 const InlinedHashSet<std::string>& excluded_initializers,
+                                 const ConstantFoldingOptions& options) noexcept
     : GraphTransformer("ConstantFolding", compatible_execution_providers),
       skip_dequantize_linear_(skip_dequantize_linear),
       excluded_initializers_(excluded_initializers),
-      execution_provider_(execution_provider) {
+      execution_provider_(execution_provider),
+      options_(options) {
+}
+
+ConstantFolding::~ConstantFolding() {
+  spilled_initializers_.clear();
+  for (const auto& file : spill_files_to_delete_) {
+#ifdef _WIN32
+    _wremove(file.c_str());
+#else
+    std::remove(file.c_str());
+#endif
+  }
+}
+
+Status ConstantFolding::SpillToMappedFile(const Tensor& tensor, const std::string& name,
+                                          ONNX_NAMESPACE::TensorProto& tensor_proto) const {
+  static std::atomic<uint64_t> spill_file_id{0};
+  const size_t num_bytes = tensor.SizeInBytes();
+  const PathString file = ConcatPathComponent<PathChar>(
+      options_.spill_dir,
+      ToPathString("constant_folding_" + std::to_string(Env::Default().GetSelfPid()) + "_" +
+                   std::to_string(spill_file_id++) + ".bin"));
+
+  {
+    std::ofstream stream(file, std::ios::binary);
+    stream.write(static_cast<const char*>(tensor.DataRaw()), num_bytes);
+    ORT_RETURN_IF_NOT(stream, "Failed to write folded initializer ", name, " to ", ToUTF8String(file));
+  }
+
+  Env::MappedMemoryPtr mapped_memory;
+  const Status status = Env::Default().MapFileIntoMemory(file.c_str(), 0, num_bytes, mapped_memory);
+#ifdef _WIN32
+  spill_files_to_delete_.push_back(file);
+#else
+  // the mapping keeps the data of the unlinked file available
+  std::remove(file.c_str());
+#endif
+  ORT_RETURN_IF_ERROR(status);
+
+  tensor_proto.set_name(name);
+  tensor_proto.set_data_type(tensor.GetElementType());
+  for (auto dim : tensor.Shape().GetDims()) {
+    tensor_proto.add_dims(dim);
+  }
+
+  // uses the same in-memory external data representation as initializers that refer to the bytes of ORT format models
+  tensor_proto.set_data_location(ONNX_NAMESPACE::TensorProto_DataLocation_EXTERNAL);
+  auto* entry = tensor_proto.mutable_external_data()->Add();
+  entry->set_key("location");
+  entry->set_value(ToUTF8String(utils::kTensorProtoMemoryAddressTag));
+  entry = tensor_proto.mutable_external_data()->Add();
+  entry->set_key("offset");
+  entry->set_value(std::to_string(reinterpret_cast<intptr_t>(mapped_memory.get())));
+  entry = tensor_proto.mutable_external_data()->Add();
+  entry->set_key("length");
+  entry->set_value(std::to_string(num_bytes));
+
+  spilled_initializers_.push_back(std::move(mapped_memory));
+  return Status::OK();
+}
+
+// Get the size of the data of a tensor. Returns 0 if unknown.
+static size_t GetTensorProtoSizeInBytes(const ONNX_NAMESPACE::TensorProto& tensor_proto) {
+  size_t size = 0;
+  if (!utils::GetSizeInBytesFromTensorProto<0>(tensor_proto, &size).IsOK()) {
+    return 0;
+  }
+  return size;
+}
+
+// Get the size of the outputs of the node from the inferred output shapes. Returns false if any is unknown.
+static bool GetInferredOutputSizeInBytes(const Node& node, size_t& num_bytes) {
+  num_bytes = 0;
+  for (const auto* output_def : node.OutputDefs()) {
+    const auto* type = output_def->TypeAsProto();
+    const auto* shape = output_def->Shape();
+    if (type == nullptr || shape == nullptr || !utils::HasTensorType(*type) ||
+        !utils::HasShape(type->tensor_type())) {
+      return false;
+    }
+
+    const auto tensor_shape = utils::GetTensorShapeFromTensorShapeProto(*shape);
+    const auto num_elements = tensor_shape.Size();
+    const int32_t elem_type = type->tensor_type().elem_type();
+    if (num_elements < 0 || elem_type == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+      return false;
+    }
+
+    num_bytes += static_cast<size_t>(num_elements) *
+                 DataTypeImpl::TensorTypeFromONNXEnum(elem_type)->GetElementType()->Size();
+  }
+
+  return true;
+}
+
+// Content hash of a folded output used to find identical folded outputs. Empty if the output can't be hashed.
+static std::string GetFoldedOutputKey(const Tensor& tensor) {
+  if (tensor.IsDataTypeString() || tensor.SizeInBytes() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+    return {};
+  }
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(tensor.DataRaw(), static_cast<int>(tensor.SizeInBytes()), 0, hash);
+
+  std::ostringstream key;
+  key << tensor.GetElementType() << ":" << tensor.Shape().ToString() << ":";
+  for (auto h : hash) {
+    key << std::hex << h;
+  }
+  return key.str();
+}
+
+// Check if the existing initializer has the same data as the tensor. The type and shape are part of their key.
+static bool HasSameData(const Graph& graph, const std::string& initializer_name, const Tensor& tensor) {
+  const ONNX_NAMESPACE::TensorProto* initializer = nullptr;
+  if (!graph.GetInitializedTensor(initializer_name, initializer)) {
+    return false;
+  }
+
+  std::vector<uint8_t> data;
+  if (!utils::UnpackInitializerData(*initializer, graph.ModelPath(), data).IsOK()) {
+    return false;
+  }
+
+  return data.size() == tensor.SizeInBytes() &&
+         (data.empty() || std::memcmp(data.data(), tensor.DataRaw(), data.size()) == 0);
 }
 
 // We need to handle a Shape node separately as the input doesn't need to be a constant initializer for
@@ -100,6 +234,15 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
   };
 #endif
 
+  // folded outputs by content, so that identical outputs share an initializer
+  InlinedHashMap<std::string, std::string> folded_output_key_to_initializer;
+
+  const auto exceeds_growth_limit = [this](size_t output_size, size_t input_size) {
+    return options_.max_output_growth_ratio > 0.f &&
+           output_size > options_.min_output_bytes_for_growth_check &&
+           static_cast<double>(output_size) > options_.max_output_growth_ratio * static_cast<double>(input_size);
+  };
+
   for (NodeIndex i : order) {
     auto* node = graph.GetNode(i);
     if (!node) {
@@ -122,6 +265,8 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
     }
 
     bool converted_to_constant = false;
+    // an existing initializer with the same content as the single output of the node
+    NodeArg* identical_initializer = nullptr;
     if (node->OpType().compare("Shape") == 0) {
       converted_to_constant = ConstantFoldShapeNode(graph, *node);
     } else {
@@ -148,6 +293,24 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         continue;
       }
 
+      // skip nodes whose outputs would be much larger than their inputs, e.g. Expand or ConstantOfShape, as storing
+      // the outputs as initializers increases the memory usage.
+      size_t constant_inputs_size = 0;
+      if (options_.max_output_growth_ratio > 0.f) {
+        for (const auto& constant_input : constant_inputs) {
+          constant_inputs_size += GetTensorProtoSizeInBytes(*constant_input.second);
+        }
+
+        size_t inferred_output_size = 0;
+        if (GetInferredOutputSizeInBytes(*node, inferred_output_size) &&
+            exceeds_growth_limit(inferred_output_size, constant_inputs_size)) {
+          LOGS(logger, INFO) << "Not constant folding " << node->OpType() << " node '" << node->Name()
+                             << "' as its outputs (" << inferred_output_size << " bytes) are much larger than its "
+                             << "inputs (" << constant_inputs_size << " bytes).";
+          continue;
+        }
+      }
+
 #if !defined(DISABLE_SPARSE_TENSORS)
       // Create execution frame for executing constant nodes.
       OptimizerExecutionFrame::Info info({node}, constant_inputs, graph.ModelPath(), execution_provider_,
@@ -212,21 +375,70 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         }
       }
 
+      if (converted_to_constant && options_.max_output_growth_ratio > 0.f) {
+        // the output shapes weren't known before running the node
+        size_t output_size = 0;
+        for (const auto& fetch : fetches) {
+          output_size += fetch.Get<Tensor>().SizeInBytes();
+        }
+
+        if (exceeds_growth_limit(output_size, constant_inputs_size)) {
+          LOGS(logger, INFO) << "Not constant folding " << node->OpType() << " node '" << node->Name()
+                             << "' as its outputs (" << output_size << " bytes) are much larger than its "
+                             << "inputs (" << constant_inputs_size << " bytes).";
+          converted_to_constant = false;
+        }
+      }
+
       if (converted_to_constant) {
-        for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
-          OrtValue& ort_value = fetches[fetch_idx];
-          // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
-          auto* constant_arg_out = node->MutableOutputDefs()[fetch_idx];
-          const Tensor& out_tensor = ort_value.Get<Tensor>();
-          ONNX_NAMESPACE::TensorProto out_tensorproto = utils::TensorToTensorProto(out_tensor, constant_arg_out->Name());
-
-          ONNX_NAMESPACE::TensorShapeProto result_shape;
-          for (auto& dim : out_tensor.Shape().GetDims()) {
-            result_shape.add_dim()->set_dim_value(dim);
+        std::string folded_output_key;
+        if (fetches.size() == 1) {
+          const Tensor& out_tensor = fetches[0].Get<Tensor>();
+          folded_output_key = GetFoldedOutputKey(out_tensor);
+          auto entry = folded_output_key_to_initializer.find(folded_output_key);
+          if (!folded_output_key.empty() && entry != folded_output_key_to_initializer.end() &&
+              HasSameData(graph, entry->second, out_tensor) &&
+              graph_utils::CanReplaceNodeWithInitializer(graph, *node, entry->second, logger)) {
+            identical_initializer = graph.GetNodeArg(entry->second);
           }
+        }
 
-          constant_arg_out->SetShape(result_shape);
-          graph.AddInitializedTensor(out_tensorproto);
+        if (identical_initializer == nullptr) {
+          for (size_t fetch_idx = 0; fetch_idx < fetches.size(); ++fetch_idx) {
+            OrtValue& ort_value = fetches[fetch_idx];
+            // Build the TensorProto that corresponds to the computed OrtValue and add it as initializer to the graph.
+            auto* constant_arg_out = node->MutableOutputDefs()[fetch_idx];
+            const Tensor& out_tensor = ort_value.Get<Tensor>();
+            ONNX_NAMESPACE::TensorProto out_tensorproto;
+            bool spilled = false;
+            if (!options_.spill_dir.empty() && !out_tensor.IsDataTypeString() &&
+                out_tensor.SizeInBytes() >= options_.spill_threshold_bytes) {
+              const auto status = SpillToMappedFile(out_tensor, constant_arg_out->Name(), out_tensorproto);
+              if (status.IsOK()) {
+                spilled = true;
+              } else {
+                LOGS(logger, WARNING) << "Keeping folded initializer '" << constant_arg_out->Name()
+                                      << "' in memory. " << status.ErrorMessage();
+                out_tensorproto.Clear();
+              }
+            }
+
+            if (!spilled) {
+              out_tensorproto = utils::TensorToTensorProto(out_tensor, constant_arg_out->Name());
+            }
+
+            ONNX_NAMESPACE::TensorShapeProto result_shape;
+            for (auto& dim : out_tensor.Shape().GetDims()) {
+              result_shape.add_dim()->set_dim_value(dim);
+            }
+
+            constant_arg_out->SetShape(result_shape);
+            graph.AddInitializedTensor(out_tensorproto);
+          }
+
+          if (!folded_output_key.empty()) {
+            folded_output_key_to_initializer.emplace(std::move(folded_output_key), node->OutputDefs()[0]->Name());
+          }
         }
       }
     }
@@ -243,9 +455,14 @@ Status ConstantFolding::ApplyImpl(Graph& graph, bool& modified, int graph_level,
         graph_utils::RemoveNodesWithOneOutputBottomUp(graph, input_node);
       }
 
-      // Remove the output edges of the constant node and then remove the node itself.
-      graph_utils::RemoveNodeOutputEdges(graph, *node);
-      graph.RemoveNode(node->Index());
+      if (identical_initializer != nullptr) {
+        // the consumers use the existing initializer instead
+        graph_utils::ReplaceNodeWithInitializer(graph, *node, *identical_initializer);
+      } else {
+        // Remove the output edges of the constant node and then remove the node itself.
+        graph_utils::RemoveNodeOutputEdges(graph, *node);
+        graph.RemoveNode(node->Index());
+      }
       modified = true;
       have_updated_nodes = true;
     }
@@ -6,15 +6,31 @@
 #include "core/optimizer/graph_transformer.h"
 #include "core/framework/ort_value.h"
 #include <memory>
+#include "core/common/path_string.h"
 #include "core/framework/execution_provider.h"
+#include "core/platform/env.h"
 
 namespace onnxruntime {
 
+/** Options to bound the memory used by the initializers that ConstantFolding creates. */
+struct ConstantFoldingOptions {
+  // A node is not folded if its outputs are larger than max_output_growth_ratio times its constant inputs and
+  // larger than min_output_bytes_for_growth_check. A value of 0 disables the check.
+  float max_output_growth_ratio{0.f};
+  size_t min_output_bytes_for_growth_check{1024 * 1024};
+
+  // If set, folded outputs of at least spill_threshold_bytes are written to a file in spill_dir and the initializer
+  // refers to the memory mapped file instead of holding a copy of the data.
+  PathString spill_dir;
+  size_t spill_threshold_bytes{64 * 1024 * 1024};
+};
+
 /**
 @class ConstantFolding
 
 Transformer that traverses the graph top-down and performs constant folding, i.e.,
 it statically computes parts of the graph that rely only on constant initializers.
+Folded outputs with the same content share a single initializer.
 */
 class ConstantFolding : public GraphTransformer {
  public:
@@ -25,14 +41,27 @@ class ConstantFolding : public GraphTransformer {
   ConstantFolding(const IExecutionProvider& execution_provider,
                   bool skip_dequantize_linear,
                   const InlinedHashSet<std::string_view>& compatible_execution_providers = {},
-                  const InlinedHashSet<std::string>& excluded_initializers = {}) noexcept;
+                  const InlinedHashSet<std::string>& excluded_initializers = {},
+                  const ConstantFoldingOptions& options = {}) noexcept;
+
+  ~ConstantFolding() override;
 
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 
+  // Write the tensor to a file in the spill directory and create an initializer that refers to the mapped file.
+  Status SpillToMappedFile(const Tensor& tensor, const std::string& name,
+                           ONNX_NAMESPACE::TensorProto& tensor_proto) const;
+
   bool skip_dequantize_linear_;
   const InlinedHashSet<std::string> excluded_initializers_;
   const IExecutionProvider& execution_provider_;
+  const ConstantFoldingOptions options_;
+
+  // the memory mapped files of spilled initializers. they must stay valid as long as the graph is in use.
+  mutable InlinedVector<Env::MappedMemoryPtr> spilled_initializers_;
+  // the files can't be deleted while mapped on Windows. they are deleted in the destructor instead.
+  mutable InlinedVector<PathString> spill_files_to_delete_;
 };
 
 }  // namespace onnxruntime
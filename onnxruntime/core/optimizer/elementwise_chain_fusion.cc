@@ -0,0 +1,180 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/elementwise_chain_fusion.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+
+namespace {
+
+bool IsFusableElementwiseNode(const Node& node, const InlinedHashSet<std::string_view>& compatible_providers) {
+  if (!graph_utils::IsSupportedProvider(node, compatible_providers)) {
+    return false;
+  }
+
+  const bool is_binary = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+                         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+                         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+                         graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14});
+  const bool is_unary = graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+                        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sigmoid", {6, 13}) ||
+                        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13}) ||
+                        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Neg", {6, 13}) ||
+                        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Abs", {6, 13}) ||
+                        graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sqrt", {6, 13});
+  if ((!is_binary && !is_unary) || node.InputDefs().size() != (is_binary ? 2u : 1u)) {
+    return false;
+  }
+
+  for (const auto* input_def : node.InputDefs()) {
+    const auto* type = input_def->TypeAsProto();
+    if (type == nullptr || !type->has_tensor_type() ||
+        type->tensor_type().elem_type() != TensorProto_DataType_FLOAT) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool HaveSameDim(const TensorShapeProto_Dimension& a, const TensorShapeProto_Dimension& b) {
+  return (utils::HasDimValue(a) && utils::HasDimValue(b) && a.dim_value() == b.dim_value()) ||
+         (utils::HasDimParam(a) && utils::HasDimParam(b) && a.dim_param() == b.dim_param());
+}
+
+// The FusedElementwise kernel broadcasts an input by repeating its data, so the shape of the input without the
+// leading ones must match the trailing dimensions of the output.
+bool BroadcastsByRepeating(const NodeArg& input, const TensorShapeProto& output_shape) {
+  const auto* shape = input.Shape();
+  if (shape == nullptr || shape->dim_size() > output_shape.dim_size()) {
+    return false;
+  }
+
+  int first_dim = 0;
+  while (first_dim < shape->dim_size() && utils::HasDimValue(shape->dim(first_dim)) &&
+         shape->dim(first_dim).dim_value() == 1) {
+    ++first_dim;
+  }
+
+  const int offset = output_shape.dim_size() - shape->dim_size();
+  for (int d = first_dim; d < shape->dim_size(); ++d) {
+    if (!HaveSameDim(shape->dim(d), output_shape.dim(offset + d))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+Status ElementwiseChainFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                         const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& node = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
+
+    if (!IsFusableElementwiseNode(node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    // follow the output of each node while it is only used by the next fusable node
+    InlinedVector<Node*> chain{&node};
+    while (optimizer_utils::CheckOutputEdges(graph, *chain.back(), 1)) {
+      Node& next = *graph.GetNode(chain.back()->OutputNodesBegin()->Index());
+      if (!IsFusableElementwiseNode(next, GetCompatibleExecutionProviders()) ||
+          next.GetExecutionProviderType() != node.GetExecutionProviderType()) {
+        break;
+      }
+      chain.push_back(&next);
+    }
+
+    if (chain.size() < 2) {
+      continue;
+    }
+
+    NodeArg* output = chain.back()->MutableOutputDefs()[0];
+    const auto* output_shape = output->Shape();
+    if (output_shape == nullptr) {
+      continue;
+    }
+
+    // the inputs of the chain that are not produced by it, and the operands of each step. the step results are
+    // numbered after the inputs, so they are stored as -1 - step index until the number of inputs is known.
+    InlinedVector<NodeArg*> inputs;
+    InlinedVector<int64_t> operands;
+    std::vector<std::string> ops;
+    bool can_fuse = true;
+    for (size_t step = 0; step < chain.size() && can_fuse; ++step) {
+      const Node& step_node = *chain[step];
+      ops.push_back(step_node.OpType());
+      for (auto* input_def : step_node.InputDefs()) {
+        if (step > 0 && input_def == chain[step - 1]->OutputDefs()[0]) {
+          operands.push_back(-static_cast<int64_t>(step));
+          continue;
+        }
+
+        if (!BroadcastsByRepeating(*input_def, *output_shape)) {
+          can_fuse = false;
+          break;
+        }
+
+        // an input used by several steps is passed once per use, so the input edges of the first node can be moved
+        // to the fused node as they are
+        operands.push_back(static_cast<int64_t>(inputs.size()));
+        inputs.push_back(const_cast<NodeArg*>(input_def));
+      }
+
+      if (step_node.InputDefs().size() == 1) {
+        operands.push_back(-1);
+      }
+    }
+
+    if (!can_fuse) {
+      continue;
+    }
+
+    // the result of step i - 1 is the value inputs.size() + i - 1
+    for (size_t i = 0; i < operands.size(); ++i) {
+      const bool is_unary_padding = (i % 2 == 1) && chain[i / 2]->InputDefs().size() == 1;
+      if (operands[i] < 0 && !is_unary_padding) {
+        operands[i] = static_cast<int64_t>(inputs.size()) - operands[i] - 1;
+      }
+    }
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName("FusedElementwise"),
+                                     "FusedElementwise",
+                                     "fused elementwise chain",
+                                     inputs,
+                                     {output},
+                                     nullptr,
+                                     kMSDomain);
+    fused_node.AddAttribute("ops", ops);
+    fused_node.AddAttribute("operands", std::vector<int64_t>(operands.begin(), operands.end()));
+    fused_node.SetExecutionProviderType(node.GetExecutionProviderType());
+
+    InlinedVector<std::reference_wrapper<Node>> chain_nodes;
+    for (Node* chain_node : chain) {
+      chain_nodes.push_back(*chain_node);
+    }
+    graph_utils::FinalizeNodeFusion(graph, chain_nodes, fused_node);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ElementwiseChainFusion
+
+Fuse chains of float elementwise nodes (Add, Sub, Mul, Div, Relu, Sigmoid, Tanh, Neg, Abs, Sqrt) where each node
+consumes the single output of the previous one into a FusedElementwise node, which computes the chain in a single
+pass without materializing the intermediate tensors. The other inputs of the chain must broadcast to the output by
+repeating their data, i.e. be scalars or match the trailing dimensions of the output.
+Register it after the other elementwise fusions so they see their patterns first.
+*/
+class ElementwiseChainFusion : public GraphTransformer {
+ public:
+  ElementwiseChainFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("ElementwiseChainFusion", compatible_execution_providers) {
+  }
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/embedding_bag_fusion.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+#include "core/providers/common.h"
+
+using namespace ONNX_NAMESPACE;
+namespace onnxruntime {
+
+namespace {
+
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->has_tensor_type() &&
+         (type->tensor_type().elem_type() == TensorProto_DataType_FLOAT ||
+          type->tensor_type().elem_type() == TensorProto_DataType_FLOAT16);
+}
+
+// Gets the axes of a ReduceSum or ReduceMean node, which are an attribute before ReduceSum-13 and a constant input
+// after it. Returns false if they can not be determined.
+bool GetReduceAxes(const Graph& graph, const Node& reduce, InlinedVector<int64_t>& axes) {
+  if (reduce.OpType() == "ReduceSum" && reduce.SinceVersion() >= 13) {
+    const auto& input_defs = reduce.InputDefs();
+    if (input_defs.size() < 2 || !input_defs[1]->Exists()) {
+      return false;  // reduces all axes, or none with noop_with_empty_axes
+    }
+    return optimizer_utils::AppendTensorFromInitializer(graph, *input_defs[1], axes, true);
+  }
+
+  return graph_utils::GetRepeatedNodeAttributeValues(reduce, "axes", axes);
+}
+
+}  // namespace
+
+/*
+This transform changes the following subgraph pattern:
+  Gather(table, indices, axis=0) --> ReduceSum/ReduceMean(axes=[rank(indices) - 1])
+to
+  EmbeddingBag(table, indices, mode=sum/mean)
+where the table is 2D.
+*/
+Status EmbeddingBagFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                     const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& gather = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(gather, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(gather, "Gather", {1, 11, 13}) ||
+        !graph_utils::IsSupportedProvider(gather, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, gather, 1)) {
+      continue;
+    }
+
+    const NodeArg& table = *gather.InputDefs()[0];
+    const NodeArg& indices = *gather.InputDefs()[1];
+    if (!IsFloatTensor(table) || table.Shape() == nullptr || table.Shape()->dim_size() != 2 ||
+        indices.Shape() == nullptr || indices.Shape()->dim_size() < 1) {
+      continue;
+    }
+
+    const auto* axis_attr = graph_utils::GetNodeAttribute(gather, "axis");
+    if (axis_attr != nullptr && HandleNegativeAxis(axis_attr->i(), 2) != 0) {
+      continue;
+    }
+
+    Node& reduce = *graph.GetNode(gather.OutputNodesBegin()->Index());
+    const bool is_sum = graph_utils::IsSupportedOptypeVersionAndDomain(reduce, "ReduceSum", {1, 11, 13});
+    const bool is_mean = graph_utils::IsSupportedOptypeVersionAndDomain(reduce, "ReduceMean", {1, 11, 13});
+    if ((!is_sum && !is_mean) || reduce.GetExecutionProviderType() != gather.GetExecutionProviderType()) {
+      continue;
+    }
+
+    // the bag is the last dimension of the indices, which is the second to last dimension of the gathered rows
+    const int64_t bag_axis = indices.Shape()->dim_size() - 1;
+    InlinedVector<int64_t> axes;
+    if (!GetReduceAxes(graph, reduce, axes) || axes.size() != 1 ||
+        HandleNegativeAxis(axes[0], bag_axis + 2) != bag_axis) {
+      continue;
+    }
+
+    const auto* keepdims_attr = graph_utils::GetNodeAttribute(reduce, "keepdims");
+    const int64_t keepdims = keepdims_attr != nullptr ? keepdims_attr->i() : 1;
+
+    Node& embedding_bag = graph.AddNode(graph.GenerateNodeName("EmbeddingBag"),
+                                        "EmbeddingBag",
+                                        "fused Gather and " + reduce.OpType(),
+                                        {gather.MutableInputDefs()[0], gather.MutableInputDefs()[1]},
+                                        {reduce.MutableOutputDefs()[0]},
+                                        nullptr,
+                                        kMSDomain);
+    embedding_bag.AddAttribute("mode", std::string(is_sum ? "sum" : "mean"));
+    embedding_bag.AddAttribute("keepdims", keepdims);
+    embedding_bag.SetExecutionProviderType(gather.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, {gather, reduce}, embedding_bag);
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -21,6 +21,8 @@ class GeluFusion : public GraphTransformer {
   GeluFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
       : GraphTransformer("GeluFusion", compatible_execution_providers) {}
 
+  InlinedHashSet<std::string_view> TargetOpTypes() const override { return {"Div", "Erf", "Add", "Mul"}; }
+
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
 };
 
@@ -33,6 +33,9 @@ bool IsFusableActivation(const Node& node) {
 #ifndef DISABLE_CONTRIB_OPS
          IsSupportedOptypeVersionAndDomain(node, "ScaledTanh", {1}, kOnnxDomain) ||
          IsSupportedOptypeVersionAndDomain(node, "ParametricSoftplus", {1}, kOnnxDomain) ||
+         // applied by MLAS in the GEMM output tiles, FastGelu must not have a bias input
+         IsSupportedOptypeVersionAndDomain(node, "Gelu", {1}, kMSDomain) ||
+         (IsSupportedOptypeVersionAndDomain(node, "FastGelu", {1}, kMSDomain) && node.InputDefs().size() == 1) ||
 #endif
          IsSupportedOptypeVersionAndDomain(node, "ThresholdedRelu", {1, 10}, kOnnxDomain);
 }
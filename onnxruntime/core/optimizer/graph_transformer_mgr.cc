@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/optimizer/graph_transformer_mgr.h"
+
+#include <algorithm>
+
+#include "core/common/profiler.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 
 using namespace onnxruntime;
@@ -19,20 +23,78 @@ common::Status GraphTransformerManager::GetSteps(unsigned& steps) const {
   return Status::OK();
 }
 
+// Check if a transformer needs to be applied again given the graph modifications since it last ran at epoch.
+static bool IsAffectedByModifications(const Graph& graph, const GraphTransformer& transformer, uint64_t epoch) {
+  if (graph.ModificationEpoch() == epoch) {
+    // nothing changed since the transformer last ran, including by the transformer itself
+    return false;
+  }
+
+  const auto target_op_types = transformer.TargetOpTypes();
+  if (target_op_types.empty()) {
+    return true;
+  }
+
+  return std::any_of(target_op_types.cbegin(), target_op_types.cend(),
+                     [&graph, epoch](std::string_view op_type) { return graph.IsOpTypeModifiedSince(op_type, epoch); });
+}
+
 common::Status GraphTransformerManager::ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger) const {
   const auto& transformers = level_to_transformer_map_.find(level);
   if (transformers == level_to_transformer_map_.end()) {
     return Status::OK();
   }
 
+  // graph modification epoch at the start of the last run of each transformer
+  InlinedVector<uint64_t> last_run_epochs(transformers->second.size(), 0);
+
   for (unsigned step = 0; step < steps_; ++step) {
     bool graph_changed = false;
-    for (const auto& transformer : transformers->second) {
-      if (step > 0 && transformer->ShouldOnlyApplyOnce())
+    for (size_t i = 0, end = transformers->second.size(); i < end; ++i) {
+      const auto& transformer = transformers->second[i];
+      if (step > 0 && (transformer->ShouldOnlyApplyOnce() ||
+                       !IsAffectedByModifications(graph, *transformer, last_run_epochs[i]))) {
         continue;
+      }
+
+      const uint64_t epoch = graph.ModificationEpoch();
+      last_run_epochs[i] = epoch;
+
+      const int max_node_index = graph.MaxNodeIndex();
+      const int num_nodes = graph.NumberOfNodes();
+      const TimePoint start_time = std::chrono::high_resolution_clock::now();
 
       bool modified = false;
       ORT_RETURN_IF_ERROR(transformer->Apply(graph, modified, logger));
+
+      // new nodes get new indexes so the nodes added and removed can be derived from the index and node count changes
+      const auto duration = std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::high_resolution_clock::now() - start_time);
+      const size_t num_nodes_added = static_cast<size_t>(graph.MaxNodeIndex() - max_node_index);
+      const size_t num_nodes_removed = static_cast<size_t>(num_nodes_added + num_nodes - graph.NumberOfNodes());
+
+      auto& stats = stats_[transformer_to_stats_index_.at(transformer.get())];
+      ++stats.num_applied;
+      stats.num_modified += modified ? 1 : 0;
+      stats.num_nodes_added += num_nodes_added;
+      stats.num_nodes_removed += num_nodes_removed;
+      stats.duration += duration;
+
+      if (profiler_ != nullptr && profiler_->IsEnabled()) {
+        profiler_->EndTimeAndRecordEvent(profiling::SESSION_EVENT, transformer->Name() + "_graph_transform",
+                                         start_time,
+                                         {{"level", std::to_string(static_cast<int>(level))},
+                                          {"step", std::to_string(step)},
+                                          {"modified", modified ? "1" : "0"},
+                                          {"nodes_added", std::to_string(num_nodes_added)},
+                                          {"nodes_removed", std::to_string(num_nodes_removed)}});
+      }
+
+      if (modified && graph.ModificationEpoch() == epoch) {
+        // the transformer changed the graph in a way that is not tracked per node so treat every op type as modified
+        graph.MarkModified();
+      }
+
       graph_changed = graph_changed || modified;
     }
     if (!graph_changed) {
@@ -50,6 +112,8 @@ common::Status GraphTransformerManager::Register(std::unique_ptr<GraphTransforme
   }
 
   transformers_info_[name] = transformer.get();
+  transformer_to_stats_index_[transformer.get()] = stats_.size();
+  stats_.push_back(GraphTransformerStats{name, level});
   level_to_transformer_map_[level].push_back(std::move(transformer));
   return Status::OK();
 }
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <chrono>
+
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
 #include "core/optimizer/graph_transformer.h"
@@ -10,6 +12,23 @@
 #include "core/optimizer/rewrite_rule.h"
 
 namespace onnxruntime {
+namespace profiling {
+class Profiler;
+}
+
+// Statistics of the applications of a registered graph transformer.
+struct GraphTransformerStats {
+  std::string name;
+  TransformerLevel level;
+  // number of times the transformer was applied, and how many of those modified the graph
+  size_t num_applied{0};
+  size_t num_modified{0};
+  // number of nodes the transformer added to and removed from the main graph
+  size_t num_nodes_added{0};
+  size_t num_nodes_removed{0};
+  // total time spent in the transformer
+  std::chrono::microseconds duration{0};
+};
 
 // Manages a list of graph transformers. It is initialized with a list of graph
 // transformers. Each inference session can further register additional ones.
@@ -30,6 +49,16 @@ class GraphTransformerManager {
   // Apply all transformers registered for the given level on the given graph
   common::Status ApplyTransformers(Graph& graph, TransformerLevel level, const logging::Logger& logger) const;
 
+  // Set the profiler that records an event for each application of a transformer when profiling is enabled.
+  void SetProfiler(profiling::Profiler* profiler) {
+    profiler_ = profiler;
+  }
+
+  // Get the statistics of the registered transformers, in registration order.
+  const InlinedVector<GraphTransformerStats>& GetStats() const {
+    return stats_;
+  }
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(GraphTransformerManager);
 
@@ -38,5 +67,10 @@ class GraphTransformerManager {
 
   InlinedHashMap<TransformerLevel, InlinedVector<std::unique_ptr<GraphTransformer>>> level_to_transformer_map_;
   InlinedHashMap<std::string, GraphTransformer*> transformers_info_;
+
+  // updated by ApplyTransformers
+  mutable InlinedVector<GraphTransformerStats> stats_;
+  InlinedHashMap<const GraphTransformer*, size_t> transformer_to_stats_index_;
+  profiling::Profiler* profiler_{nullptr};
 };
 }  // namespace onnxruntime
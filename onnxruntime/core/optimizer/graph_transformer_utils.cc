@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <variant>
 
+#include "core/common/parse_string.h"
 #include "core/optimizer/conv_activation_fusion.h"
 #include "core/optimizer/nhwc_transformer.h"
 #include "core/optimizer/qdq_transformer/qdq_final_cleanup.h"
@@ -35,7 +36,9 @@
 #include "core/optimizer/div_mul_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
+#include "core/optimizer/embedding_bag_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/free_dim_override_transformer.h"
@@ -47,14 +50,18 @@
 #include "core/optimizer/gemm_transpose_fusion.h"
 #include "core/optimizer/identity_elimination.h"
 #include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/loop_invariant_code_motion.h"
 #include "core/optimizer/matmul_add_fusion.h"
+#include "core/optimizer/matmul_float8_fusion.h"
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
 #include "core/optimizer/nchwc_transformer.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
+#include "core/optimizer/packed_sequence_transformer.h"
 #include "core/optimizer/qdq_transformer/clip_quantizelinear.h"
+#include "core/optimizer/qdq_transformer/qdq_lookup_table_fusion.h"
 #include "core/optimizer/qdq_transformer/qdq_propagation.h"
 #include "core/optimizer/qdq_transformer/qdq_s8_to_u8.h"
 #include "core/optimizer/qdq_transformer/relu_quantizelinear.h"
@@ -64,8 +71,10 @@
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/tensor_parallel_transformer.h"
 #include "core/optimizer/transpose_optimizer/ort_transpose_optimizer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
+#include "core/optimizer/zipmap_elimination.h"
 #ifdef ENABLE_TRAINING
 #include "orttraining/core/optimizer/bitmask_dropout_replacement.h"
 #include "orttraining/core/optimizer/bias_softmax_dropout_fusion.h"
@@ -193,14 +202,35 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       // Put ConstantSharing before CommonSubexpressionElimination by intention as it can create more opportunities for
       // CSE. For example, if A and B nodes both do Add operation with a same value but different initializers, by
       // default, CSE will not merge them, because the different initializers are represented by different NodeArg.
+      // LoopInvariantCodeMotion moves nodes out of Loop and Scan bodies so CSE can merge them in the outer graph.
+      transformers.emplace_back(std::make_unique<LoopInvariantCodeMotion>());
       transformers.emplace_back(std::make_unique<ConstantSharing>());
       transformers.emplace_back(std::make_unique<CommonSubexpressionElimination>());
-      transformers.emplace_back(std::make_unique<ConstantFolding>(cpu_execution_provider, !disable_quant_qdq));
+      ConstantFoldingOptions constant_folding_options;
+      constant_folding_options.max_output_growth_ratio = ParseStringWithClassicLocale<float>(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConstantFoldingMaxOutputGrowthRatio,
+                                                            "0"));
+      constant_folding_options.spill_dir = ToPathString(
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConstantFoldingSpillDir, ""));
+      const std::string constant_folding_spill_threshold =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsConstantFoldingSpillThreshold, "");
+      if (!constant_folding_spill_threshold.empty()) {
+        constant_folding_options.spill_threshold_bytes =
+            ParseStringWithClassicLocale<size_t>(constant_folding_spill_threshold);
+      }
+      transformers.emplace_back(std::make_unique<ConstantFolding>(cpu_execution_provider, !disable_quant_qdq,
+                                                                  InlinedHashSet<std::string_view>{},
+                                                                  InlinedHashSet<std::string>{},
+                                                                  constant_folding_options));
       transformers.emplace_back(std::make_unique<MatMulAddFusion>());
       transformers.emplace_back(std::make_unique<ReshapeFusion>());
       transformers.emplace_back(std::make_unique<FreeDimensionOverrideTransformer>(
           session_options.free_dimension_overrides));
 
+      if (session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsDisableZipMap, "0") == "1") {
+        transformers.emplace_back(std::make_unique<ZipMapElimination>());
+      }
+
       if (!disable_quant_qdq) {
         transformers.emplace_back(std::make_unique<QDQPropagationTransformer>());
       }
@@ -224,6 +254,19 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
                                                             QDQIsInt8Allowed() ? "1" : "0") == "1";
       const bool enable_gelu_approximation =
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableGeluApproximation, "0") == "1";
+      const bool enable_packed_sequence =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnablePackedSequence, "0") == "1";
+      const bool enable_float8_matmul =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableFloat8MatMul, "0") == "1";
+      const bool enable_elementwise_chain_fusion =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsEnableElementwiseChainFusion,
+                                                            "0") == "1";
+      const int tensor_parallel_size =
+          ParseStringWithClassicLocale<int>(
+              session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsTensorParallelSize, "1"));
+      const int tensor_parallel_rank =
+          ParseStringWithClassicLocale<int>(
+              session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsTensorParallelRank, "0"));
 
       const InlinedHashSet<std::string_view> cuda_rocm_eps = {onnxruntime::kCudaExecutionProvider,
                                                               onnxruntime::kRocmExecutionProvider};
@@ -253,12 +296,18 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
         if (!qdq_is_int8_allowed) {
           transformers.emplace_back(std::make_unique<QDQS8ToU8Transformer>(avx2_precision_mode, cpu_ep));
         }
+        // runs before the selectors so that chains of elementwise ops are not split by a QLinear activation
+        transformers.emplace_back(std::make_unique<QDQLookupTableFusion>(cpu_ep));
         transformers.emplace_back(std::make_unique<QDQSelectorActionTransformer>(qdq_is_int8_allowed));
       }
 
       transformers.emplace_back(std::make_unique<GemmActivationFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<MatMulIntegerToFloatFusion>(cpu_ep));
       transformers.emplace_back(std::make_unique<DynamicQuantizeMatMulFusion>(cpu_ep));
+      if (enable_float8_matmul) {
+        const InlinedHashSet<std::string_view> cuda_ep = {onnxruntime::kCudaExecutionProvider};
+        transformers.emplace_back(std::make_unique<MatMulFloat8Fusion>(cuda_ep));
+      }
 
       transformers.emplace_back(std::make_unique<ConvActivationFusion>(cpu_cuda_rocm_acl_armnn_eps));
 
@@ -269,6 +318,7 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
       transformers.emplace_back(std::make_unique<EmbedLayerNormFusion>(cpu_cuda_dml_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherToSplitFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<GatherToSliceFusion>(cpu_cuda_rocm_eps));
+      transformers.emplace_back(std::make_unique<EmbeddingBagFusion>(cpu_ep));
 
       transformers.emplace_back(std::make_unique<MatmulTransposeFusion>(cpu_cuda_rocm_eps));
       transformers.emplace_back(std::make_unique<BiasGeluFusion>(cpu_cuda_dml_rocm_eps));
@@ -294,6 +344,28 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
         transformers.emplace_back(std::make_unique<GeluApproximation>(cpu_cuda_rocm_eps));
       }
 
+      // TensorParallelTransformer partitions the fused Attention, BiasGelu and FastGelu nodes, and the packed
+      // sequence nodes inserted after it run on the shards.
+      if (tensor_parallel_size > 1) {
+        ORT_ENFORCE(tensor_parallel_rank >= 0 && tensor_parallel_rank < tensor_parallel_size,
+                    "Invalid tensor parallel rank ", tensor_parallel_rank, " for size ", tensor_parallel_size);
+        const InlinedHashSet<std::string_view> cuda_ep = {onnxruntime::kCudaExecutionProvider};
+        transformers.emplace_back(std::make_unique<TensorParallelTransformer>(tensor_parallel_rank,
+                                                                               tensor_parallel_size, cuda_ep));
+      }
+
+      // PackedSequenceTransformer needs the fused Attention, SkipLayerNormalization and FastGelu nodes so it runs
+      // after the fusions. It is only useful when the sequences are padded, so it needs to be manually enabled.
+      if (enable_packed_sequence) {
+        const InlinedHashSet<std::string_view> cuda_ep = {onnxruntime::kCudaExecutionProvider};
+        transformers.emplace_back(std::make_unique<PackedSequenceTransformer>(cuda_ep));
+      }
+
+      // ElementwiseChainFusion runs after the other fusions so it only picks up the elementwise nodes they left.
+      if (enable_elementwise_chain_fusion) {
+        transformers.emplace_back(std::make_unique<ElementwiseChainFusion>(cpu_ep));
+      }
+
 #ifdef MLAS_TARGET_AMD64_IX86
       if (avx2_precision_mode) {
         transformers.emplace_back(std::make_unique<Avx2WeightS8ToU8Transformer>(cpu_ep));
@@ -314,7 +386,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerEnabler, "");
       const std::string probe_level =
           session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerProbeLevel, "0");
-      transformers.emplace_back(std::make_unique<MemoryOptimizer>(enable_memory_optimizer, probe_level));
+      const std::string activation_budget =
+          session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsMemoryOptimizerActivationBudget, "");
+      transformers.emplace_back(std::make_unique<MemoryOptimizer>(enable_memory_optimizer, probe_level,
+                                                                  activation_budget));
 #endif
 
     } break;
@@ -323,7 +398,10 @@ InlinedVector<std::unique_ptr<GraphTransformer>> GenerateTransformers(
 #ifndef DISABLE_CONTRIB_OPS
       // Register the NCHWc layout transformer if supported by the platform.
       if (MlasNchwcGetBlockSize() > 1) {
-        transformers.emplace_back(std::make_unique<NchwcTransformer>());
+        const bool nchwc_skip_unprofitable_regions =
+            session_options.config_options.GetConfigOrDefault(kOrtSessionOptionsNchwcSkipUnprofitableRegions,
+                                                              "0") == "1";
+        transformers.emplace_back(std::make_unique<NchwcTransformer>(nchwc_skip_unprofitable_regions));
       }
       auto cpu_allocator = cpu_execution_provider.GetAllocator(0, OrtMemTypeDefault);
       transformers.emplace_back(std::make_unique<NhwcTransformer>(std::move(cpu_allocator)));
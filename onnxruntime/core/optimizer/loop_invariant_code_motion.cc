@@ -0,0 +1,270 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/loop_invariant_code_motion.h"
+
+#include <algorithm>
+
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/optimizer/utils.h"
+
+// Exported models often repeat computations inside control flow subgraphs that only depend on values of the
+// enclosing graph, e.g. the construction of positional encodings or masks in the body of a Loop.
+//
+// outer = ...                       outer = ...
+// Loop(body = {                     inv = F1(outer)
+//   inv = F1(outer)          =>     Loop(body = {
+//   y = F2(x, inv)                    y = F2(x, inv)
+// })                                })
+//
+// The moved nodes are then visible to CommonSubexpressionElimination in the enclosing graph.
+
+namespace onnxruntime {
+
+namespace {
+
+bool CanMoveNode(const Node& node, const InlinedHashSet<std::string_view>& compatible_providers) {
+  return !node.ContainsSubgraph() &&
+         optimizer_utils::IsOperationDeterministic(node.Domain(), node.OpType()) &&
+         graph_utils::IsSupportedProvider(node, compatible_providers);
+}
+
+bool SameAttributes(const NodeAttributes& lhs, const NodeAttributes& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+
+  for (const auto& [name, attribute] : lhs) {
+    const auto other = rhs.find(name);
+    if (other == rhs.end() || attribute.SerializeAsString() != other->second.SerializeAsString()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Returns true if the nodes have the same operation and read exactly the same values.
+bool AreEquivalent(const Node& lhs, const Node& rhs) {
+  if (lhs.OpType() != rhs.OpType() || lhs.Domain() != rhs.Domain() || lhs.SinceVersion() != rhs.SinceVersion() ||
+      lhs.InputDefs().size() != rhs.InputDefs().size() || lhs.OutputDefs().size() != rhs.OutputDefs().size() ||
+      !SameAttributes(lhs.GetAttributes(), rhs.GetAttributes())) {
+    return false;
+  }
+
+  for (size_t i = 0, end = lhs.InputDefs().size(); i < end; ++i) {
+    if (lhs.InputDefs()[i]->Exists() != rhs.InputDefs()[i]->Exists() ||
+        lhs.InputDefs()[i]->Name() != rhs.InputDefs()[i]->Name()) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0, end = lhs.OutputDefs().size(); i < end; ++i) {
+    // every output used by the subgraph node must be produced by the node of the enclosing graph
+    if (lhs.OutputDefs()[i]->Exists() && !rhs.OutputDefs()[i]->Exists()) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// Moves the nodes of the body of a Loop or Scan node that don't depend on the iteration to the graph.
+bool MoveInvariantNodes(Graph& graph, Graph& body, const InlinedHashSet<std::string_view>& compatible_providers,
+                        const logging::Logger& logger) {
+  InlinedHashSet<std::string> body_outputs;
+  for (const auto* output : body.GetOutputs()) {
+    body_outputs.insert(output->Name());
+  }
+
+  // values of the body that are now produced by the graph
+  InlinedHashSet<std::string> moved_values;
+  // constant initializers of the body that were copied to the graph
+  InlinedHashSet<std::string> copied_initializers;
+
+  bool modified = false;
+  GraphViewer body_viewer(body);
+  for (NodeIndex node_index : body_viewer.GetNodesInTopologicalOrder()) {
+    Node* node = body.GetNode(node_index);
+    if (node == nullptr || !CanMoveNode(*node, compatible_providers)) {
+      continue;
+    }
+
+    // Nodes that only read constant initializers are left to ConstantFolding.
+    bool depends_on_graph_value = false;
+    bool is_invariant = true;
+    InlinedVector<const ONNX_NAMESPACE::TensorProto*> initializers_to_copy;
+    for (const NodeArg* input : node->InputDefs()) {
+      if (!input->Exists()) {
+        continue;
+      }
+
+      const auto& name = input->Name();
+      if (moved_values.count(name) > 0 || body.IsOuterScopeValue(name)) {
+        depends_on_graph_value = true;
+      } else if (const auto* initializer = graph_utils::GetConstantInitializer(body, name, false);
+                 initializer != nullptr &&
+                 (copied_initializers.count(name) > 0 || graph.GetNodeArgIncludingParentGraphs(name) == nullptr)) {
+        initializers_to_copy.push_back(initializer);
+      } else {
+        is_invariant = false;
+        break;
+      }
+    }
+
+    // the outputs must not be outputs of the body and their names must be free in the graph
+    for (const NodeArg* output : node->OutputDefs()) {
+      if (output->Exists() && (body_outputs.count(output->Name()) > 0 ||
+                               graph.GetNodeArgIncludingParentGraphs(output->Name()) != nullptr)) {
+        is_invariant = false;
+      }
+    }
+
+    if (!is_invariant || !depends_on_graph_value) {
+      continue;
+    }
+
+    for (const auto* initializer : initializers_to_copy) {
+      if (copied_initializers.insert(initializer->name()).second) {
+        graph_utils::AddInitializer(graph, *initializer);
+      }
+    }
+
+    auto get_graph_node_arg = [&graph](const NodeArg* node_arg) {
+      return node_arg->Exists() ? &graph.GetOrCreateNodeArg(node_arg->Name(), node_arg->TypeAsProto())
+                                : &graph.GetOrCreateNodeArg("", nullptr);
+    };
+
+    InlinedVector<NodeArg*> inputs;
+    inputs.reserve(node->InputDefs().size());
+    for (const NodeArg* input : node->InputDefs()) {
+      inputs.push_back(get_graph_node_arg(input));
+    }
+
+    InlinedVector<NodeArg*> outputs;
+    outputs.reserve(node->OutputDefs().size());
+    for (const NodeArg* output : node->OutputDefs()) {
+      outputs.push_back(get_graph_node_arg(output));
+      if (output->Exists()) {
+        moved_values.insert(output->Name());
+      }
+    }
+
+    Node& moved_node = graph.AddNode(graph.GenerateNodeName(node->Name()), node->OpType(), node->Description(),
+                                     inputs, outputs, &node->GetAttributes(), node->Domain());
+    moved_node.SetSinceVersion(node->SinceVersion());
+    moved_node.SetExecutionProviderType(node->GetExecutionProviderType());
+
+    LOGS(logger, VERBOSE) << "Moved loop invariant node " << node->Name() << "[" << node->OpType()
+                          << "] out of the body of " << body.ParentNode()->Name();
+
+    // the consumers in the body keep their NodeArgs which now refer to the values of the graph
+    graph_utils::RemoveNodeOutputEdges(body, *node);
+    body.RemoveNode(node_index);
+    modified = true;
+  }
+
+  return modified;
+}
+
+// Replaces the nodes of a branch of an If node with an Identity of the output of an equivalent node of the graph.
+bool ReuseGraphValues(Graph& graph, const Node& if_node, Graph& branch,
+                      const InlinedHashSet<std::string_view>& compatible_providers, const logging::Logger& logger) {
+  bool modified = false;
+  GraphViewer branch_viewer(branch);
+  for (NodeIndex node_index : branch_viewer.GetNodesInTopologicalOrder()) {
+    Node* node = branch.GetNode(node_index);
+    if (node == nullptr || node->InputDefs().empty() || !CanMoveNode(*node, compatible_providers)) {
+      continue;
+    }
+
+    const bool reads_graph_values_only =
+        std::all_of(node->InputDefs().begin(), node->InputDefs().end(), [&branch](const NodeArg* input) {
+          return !input->Exists() || branch.IsOuterScopeValue(input->Name());
+        });
+    if (!reads_graph_values_only || !node->InputDefs()[0]->Exists()) {
+      continue;
+    }
+
+    const Node* equivalent_node = nullptr;
+    for (const Node* consumer : graph.GetConsumerNodes(node->InputDefs()[0]->Name())) {
+      if (consumer != &if_node && CanMoveNode(*consumer, compatible_providers) && AreEquivalent(*node, *consumer)) {
+        equivalent_node = consumer;
+        break;
+      }
+    }
+
+    // the values of the equivalent node must not be shadowed by values of the branch
+    if (equivalent_node == nullptr ||
+        std::any_of(equivalent_node->OutputDefs().begin(), equivalent_node->OutputDefs().end(),
+                    [&branch](const NodeArg* output) {
+                      return output->Exists() && branch.GetNodeArg(output->Name()) != nullptr &&
+                             !branch.IsOuterScopeValue(output->Name());
+                    })) {
+      continue;
+    }
+
+    const std::string node_name = node->Name();
+    InlinedVector<NodeArg*> outputs(node->MutableOutputDefs().begin(), node->MutableOutputDefs().end());
+    graph_utils::RemoveNodeOutputEdges(branch, *node);
+    branch.RemoveNode(node_index);
+
+    for (size_t i = 0, end = outputs.size(); i < end; ++i) {
+      if (!outputs[i]->Exists()) {
+        continue;
+      }
+
+      const NodeArg* value = equivalent_node->OutputDefs()[i];
+      NodeArg& input = branch.GetOrCreateNodeArg(value->Name(), value->TypeAsProto());
+      branch.AddNode(branch.GenerateNodeName(node_name), "Identity", "Reuses a value of the enclosing graph.",
+                     {&input}, {outputs[i]});
+    }
+
+    LOGS(logger, VERBOSE) << "Replaced node " << node_name << " of a branch of " << if_node.Name()
+                          << " with the outputs of " << equivalent_node->Name();
+    modified = true;
+  }
+
+  return modified;
+}
+
+}  // namespace
+
+Status LoopInvariantCodeMotion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                          const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (NodeIndex node_index : node_topology_list) {
+    Node* node = graph.GetNode(node_index);
+    if (node == nullptr)
+      continue;
+
+    // handle the nested subgraphs first so their invariant nodes can move up several levels
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    if (node->Domain() != kOnnxDomain ||
+        !graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    if (node->OpType() == "Loop" || node->OpType() == "Scan") {
+      Graph* body = node->GetMutableGraphAttribute("body");
+      if (body != nullptr && MoveInvariantNodes(graph, *body, GetCompatibleExecutionProviders(), logger)) {
+        modified = true;
+      }
+    } else if (node->OpType() == "If") {
+      for (const char* branch_name : {"then_branch", "else_branch"}) {
+        Graph* branch = node->GetMutableGraphAttribute(branch_name);
+        if (branch != nullptr && ReuseGraphValues(graph, *node, *branch, GetCompatibleExecutionProviders(), logger)) {
+          modified = true;
+        }
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@class LoopInvariantCodeMotion
+
+Moves the nodes of Loop and Scan bodies that only depend on outer scope values and constant initializers
+to the graph containing the Loop or Scan node, so they are computed once instead of in every iteration.
+CommonSubexpressionElimination can then merge them with the equivalent nodes of that graph.
+
+The nodes of If branches are not moved as a branch may not be executed, but a branch node that computes the same
+value as a node of the graph containing the If node is replaced by an Identity of that value.
+*/
+class LoopInvariantCodeMotion : public GraphTransformer {
+ public:
+  LoopInvariantCodeMotion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("LoopInvariantCodeMotion", compatible_execution_providers) {
+  }
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
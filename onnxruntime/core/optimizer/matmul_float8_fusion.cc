@@ -0,0 +1,172 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/matmul_float8_fusion.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// cuBLASLt needs K and N of the float8 GEMM to be multiples of 16.
+constexpr int64_t kFloat8DimAlignment = 16;
+
+// Returns the DequantizeFloat8 node that produces the given input of node, if its output is only used by node.
+const Node* GetDequantizeFloat8Input(const Graph& graph, const Node& node, int input_index) {
+  const Node* dq = graph_utils::GetInputNode(node, input_index);
+  if (dq == nullptr ||
+      !graph_utils::IsSupportedOptypeVersionAndDomain(*dq, "DequantizeFloat8", {1}, kMSDomain) ||
+      dq->GetExecutionProviderType() != node.GetExecutionProviderType() ||
+      !optimizer_utils::CheckOutputEdges(graph, *dq, 1)) {
+    return nullptr;
+  }
+  return dq;
+}
+
+std::string GetFloat8Format(const Node& dq) {
+  const auto* attr = graph_utils::GetNodeAttribute(dq, "fp8_format");
+  return attr != nullptr ? attr->s() : "E4M3FN";
+}
+
+// Returns the float NodeArg of the constant scalar scale of a DequantizeFloat8 node, adding a float initializer
+// when the scale is float16. Returns nullptr if the scale is not a constant scalar.
+NodeArg* GetFloatScale(Graph& graph, Node& dq) {
+  NodeArg* scale_arg = dq.MutableInputDefs()[1];
+  const TensorProto* scale = graph_utils::GetConstantInitializer(graph, scale_arg->Name());
+  if (scale == nullptr || !optimizer_utils::IsScalar(*scale_arg)) {
+    return nullptr;
+  }
+
+  if (scale->data_type() == TensorProto_DataType_FLOAT) {
+    return scale_arg;
+  }
+
+  Initializer initializer(*scale, graph.ModelPath());
+  TensorProto float_scale;
+  float_scale.set_name(graph.GenerateNodeArgName(scale_arg->Name() + "_float"));
+  float_scale.set_data_type(TensorProto_DataType_FLOAT);
+  float_scale.add_float_data(initializer.data<MLFloat16>()->ToFloat());
+  return &graph_utils::AddInitializer(graph, float_scale);
+}
+
+}  // namespace
+
+/**
+MatMulFloat8Fusion fuses the subgraph below into MatMulFloat8:
+
+  A  A_Scale    B (Const, K x N) B_Scale (Const)
+   \   /            \   /
+ DequantizeFloat8  DequantizeFloat8                 A  B' (Const, N x K)  A_Scale  B_Scale
+          \          /                   ---->       \    |                 |      /
+            MatMul                                            MatMulFloat8
+              |                                                    |
+           (output)                                             (output)
+*/
+Status MatMulFloat8Fusion::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& matmul = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(matmul, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(matmul, "MatMul", {1, 9, 13}) ||
+        !graph_utils::IsSupportedProvider(matmul, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+
+    const Node* p_dq_a = GetDequantizeFloat8Input(graph, matmul, 0);
+    const Node* p_dq_b = GetDequantizeFloat8Input(graph, matmul, 1);
+    if (p_dq_a == nullptr || p_dq_b == nullptr || p_dq_a == p_dq_b) {
+      continue;
+    }
+
+    const std::string format_a = GetFloat8Format(*p_dq_a);
+    const std::string format_b = GetFloat8Format(*p_dq_b);
+    if (format_a == "E5M2" && format_b == "E5M2") {
+      continue;
+    }
+
+    // MatMulFloat8 does not broadcast 1D A
+    const auto* a_shape = p_dq_a->InputDefs()[0]->Shape();
+    if (a_shape == nullptr || a_shape->dim_size() < 2) {
+      continue;
+    }
+
+    const auto* output_type = matmul.OutputDefs()[0]->TypeAsProto();
+    if (output_type == nullptr || !output_type->tensor_type().has_elem_type()) {
+      continue;
+    }
+    const int32_t dtype = output_type->tensor_type().elem_type();
+    if (dtype != TensorProto_DataType_FLOAT && dtype != TensorProto_DataType_FLOAT16) {
+      continue;
+    }
+
+    const TensorProto* weight = graph_utils::GetConstantInitializer(graph, p_dq_b->InputDefs()[0]->Name());
+    if (weight == nullptr || weight->data_type() != TensorProto_DataType_UINT8 || weight->dims_size() != 2 ||
+        weight->dims(0) % kFloat8DimAlignment != 0 || weight->dims(1) % kFloat8DimAlignment != 0) {
+      continue;
+    }
+
+    Node& dq_a = *graph.GetNode(p_dq_a->Index());
+    Node& dq_b = *graph.GetNode(p_dq_b->Index());
+    NodeArg* a_scale = GetFloatScale(graph, dq_a);
+    NodeArg* b_scale = a_scale != nullptr ? GetFloatScale(graph, dq_b) : nullptr;
+    if (b_scale == nullptr) {
+      continue;
+    }
+
+    // transpose the weight from (K, N) to (N, K)
+    const int64_t K = weight->dims(0);
+    const int64_t N = weight->dims(1);
+    Initializer initializer(*weight, graph.ModelPath());
+    const uint8_t* src = initializer.data<uint8_t>();
+    std::string transposed(static_cast<size_t>(K * N), '\0');
+    for (int64_t k = 0; k < K; ++k) {
+      for (int64_t n = 0; n < N; ++n) {
+        transposed[n * K + k] = static_cast<char>(src[k * N + n]);
+      }
+    }
+
+    TensorProto weight_transposed;
+    weight_transposed.set_name(graph.GenerateNodeArgName(weight->name() + "_transposed"));
+    weight_transposed.set_data_type(TensorProto_DataType_UINT8);
+    weight_transposed.add_dims(N);
+    weight_transposed.add_dims(K);
+    weight_transposed.set_raw_data(std::move(transposed));
+    NodeArg& b = graph_utils::AddInitializer(graph, weight_transposed);
+
+    Node& fused_node = graph.AddNode(graph.GenerateNodeName(matmul.Name() + "_float8"),
+                                     "MatMulFloat8",
+                                     "Fused MatMul of DequantizeFloat8 inputs",
+                                     {dq_a.MutableInputDefs()[0], &b, a_scale, b_scale},
+                                     matmul.MutableOutputDefs(),
+                                     nullptr,
+                                     kMSDomain);
+    fused_node.AddAttribute("fp8_format_a", format_a);
+    fused_node.AddAttribute("fp8_format_b", format_b);
+    fused_node.AddAttribute("dtype", static_cast<int64_t>(dtype));
+    fused_node.SetExecutionProviderType(matmul.GetExecutionProviderType());
+
+    for (Node* node : {&dq_a, &dq_b, &matmul}) {
+      graph_utils::RemoveNodeOutputEdges(graph, *node);
+      graph.RemoveNode(node->Index());
+    }
+
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
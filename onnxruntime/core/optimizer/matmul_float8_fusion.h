@@ -0,0 +1,25 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MatMulFloat8Fusion
+
+Fuse the MatMul of two DequantizeFloat8 nodes into MatMulFloat8, which runs on the float8 tensor cores.
+The second input must be a constant weight of shape (K, N), which is transposed to the (N, K) layout of MatMulFloat8.
+The scales must be constant scalars, and K and N must be multiples of 16.
+*/
+class MatMulFloat8Fusion : public GraphTransformer {
+ public:
+  MatMulFloat8Fusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("MatMulFloat8Fusion", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
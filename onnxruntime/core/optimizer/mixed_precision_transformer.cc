@@ -0,0 +1,271 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/mixed_precision_transformer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <unordered_map>
+
+#include "core/framework/data_types.h"
+#include "core/framework/kernel_registry.h"
+#include "core/graph/graph_utils.h"
+#include "core/graph/graph_viewer.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace ::onnxruntime::common;
+namespace onnxruntime {
+
+namespace {
+
+// Largest finite float16 value.
+constexpr float kMaxFloat16 = 65504.0f;
+
+bool IsFloatTensor(const NodeArg& node_arg) {
+  const auto* type = node_arg.TypeAsProto();
+  return type != nullptr && type->value_case() == TypeProto::kTensorType &&
+         type->tensor_type().elem_type() == TensorProto_DataType_FLOAT;
+}
+
+// Type constraint of the i-th input or output of a node, where the last formal parameter may be variadic.
+const std::string* GetTypeStr(const std::vector<OpSchema::FormalParameter>& params, size_t i) {
+  if (i < params.size()) {
+    return &params[i].GetTypeStr();
+  }
+  if (!params.empty() && params.back().GetOption() == OpSchema::Variadic) {
+    return &params.back().GetTypeStr();
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+MixedPrecisionTransformer::MixedPrecisionTransformer(
+    TensorProto_DataType target_type, gsl::span<const std::string> allow_ops, gsl::span<const std::string> deny_ops,
+    const KernelRegistryManager& registry_manager,
+    const InlinedHashSet<std::string_view>& compatible_execution_providers)
+    : GraphTransformer("MixedPrecisionTransformer", compatible_execution_providers),
+      target_type_(target_type),
+      allow_ops_(GetDefaultAllowOps()),
+      registry_manager_(std::cref(registry_manager)) {
+  ORT_ENFORCE(target_type_ == TensorProto_DataType_FLOAT16 || target_type_ == TensorProto_DataType_BFLOAT16,
+              "Mixed precision only converts to float16 or bfloat16.");
+  allow_ops_.insert(allow_ops.begin(), allow_ops.end());
+  for (const auto& op_type : deny_ops) {
+    allow_ops_.erase(op_type);
+  }
+}
+
+const InlinedHashSet<std::string>& MixedPrecisionTransformer::GetDefaultAllowOps() {
+  static const InlinedHashSet<std::string> default_allow_ops = {
+      // compute heavy ops, which accumulate in float on the GPU execution providers
+      "MatMul", "Gemm", "Conv", "ConvTranspose",
+      // element-wise ops
+      "Add", "Sub", "Mul", "Div", "Relu", "LeakyRelu", "Sigmoid", "Tanh", "Neg", "Abs", "Clip", "Where",
+      // data movement ops
+      "Transpose", "Reshape", "Flatten", "Squeeze", "Unsqueeze", "Concat", "Split", "Slice", "Gather", "Expand",
+      "Tile", "Pad", "Identity", "MaxPool", "DepthToSpace", "SpaceToDepth"};
+  return default_allow_ops;
+}
+
+InlinedVector<std::string> MixedPrecisionTransformer::GetConvertedTypeConstraints(const Graph& graph,
+                                                                                  const Node& node) const {
+  const auto* schema = node.Op();
+  if (schema == nullptr || allow_ops_.count(node.OpType()) == 0) {
+    return {};
+  }
+
+  // the float tensors of the type constraints that also allow the target type are converted,
+  // the float only inputs and outputs, e.g. the scales of Resize, stay in float
+  const std::string target_type_str = target_type_ == TensorProto_DataType_FLOAT16 ? "tensor(float16)"
+                                                                                   : "tensor(bfloat16)";
+  const auto& type_constraint_params = schema->typeConstraintParams();
+  InlinedVector<std::string> type_strs;
+  auto add_type_strs = [&](const std::vector<OpSchema::FormalParameter>& params,
+                           ConstPointerContainer<std::vector<NodeArg*>> defs) {
+    for (size_t i = 0; i < defs.size(); ++i) {
+      const std::string* type_str = GetTypeStr(params, i);
+      if (!defs[i]->Exists() || !IsFloatTensor(*defs[i]) || type_str == nullptr ||
+          std::find(type_strs.begin(), type_strs.end(), *type_str) != type_strs.end()) {
+        continue;
+      }
+      auto type_constraint = std::find_if(type_constraint_params.begin(), type_constraint_params.end(),
+                                          [type_str](const OpSchema::TypeConstraintParam& param) {
+                                            return param.type_param_str == *type_str;
+                                          });
+      if (type_constraint != type_constraint_params.end() &&
+          std::find(type_constraint->allowed_type_strs.begin(), type_constraint->allowed_type_strs.end(),
+                    target_type_str) != type_constraint->allowed_type_strs.end()) {
+        type_strs.push_back(*type_str);
+      }
+    }
+  };
+  add_type_strs(schema->inputs(), node.InputDefs());
+  add_type_strs(schema->outputs(), node.OutputDefs());
+  if (type_strs.empty()) {
+    return {};
+  }
+
+  // keep the node in float if one of its constant inputs does not fit float16, e.g. a mask of float lowest values
+  if (target_type_ == TensorProto_DataType_FLOAT16) {
+    const auto& input_defs = node.InputDefs();
+    for (size_t i = 0; i < input_defs.size(); ++i) {
+      const std::string* type_str = GetTypeStr(schema->inputs(), i);
+      const auto* initializer = graph.GetConstantInitializer(input_defs[i]->Name(), false);
+      if (initializer == nullptr || !IsFloatTensor(*input_defs[i]) || type_str == nullptr ||
+          std::find(type_strs.begin(), type_strs.end(), *type_str) == type_strs.end()) {
+        continue;
+      }
+      Initializer values{*initializer, graph.ModelPath()};
+      const auto data = values.DataAsSpan<float>();
+      if (std::any_of(data.begin(), data.end(), [](float value) { return !(std::abs(value) <= kMaxFloat16); })) {
+        return {};
+      }
+    }
+  }
+
+  // the execution provider of the node must have a kernel for the converted types
+  const MLDataType target_data_type = target_type_ == TensorProto_DataType_FLOAT16
+                                          ? DataTypeImpl::GetTensorType<MLFloat16>()
+                                          : DataTypeImpl::GetTensorType<BFloat16>();
+  std::unordered_map<std::string, MLDataType> type_constraints;
+  for (const auto& type_str : type_strs) {
+    type_constraints[type_str] = target_data_type;
+  }
+  const auto& provider_type = node.GetExecutionProviderType();
+  for (const KernelRegistry* registry : registry_manager_.get().GetKernelRegistriesByProviderType(provider_type)) {
+    const KernelCreateInfo* kernel_create_info = nullptr;
+    if (registry->TryFindKernel(node.OpType(), node.Domain(), node.SinceVersion(), type_constraints, provider_type,
+                                &kernel_create_info)
+            .IsOK()) {
+      return type_strs;
+    }
+  }
+  return {};
+}
+
+Status MixedPrecisionTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                            const logging::Logger& logger) const {
+  const bool is_fp16 = target_type_ == TensorProto_DataType_FLOAT16;
+  const std::string suffix = is_fp16 ? "_fp16" : "_bf16";
+
+  // float values -> the same values in the target type, from a converted node, a Cast node or an initializer
+  InlinedHashMap<const NodeArg*, NodeArg*> converted_values;
+  // Cast nodes from the converted outputs back to float, which are removed if nothing consumes their float output
+  InlinedVector<NodeIndex> output_casts;
+  InlinedVector<std::string> converted_initializers;
+
+  auto create_target_node_arg = [&](const NodeArg& node_arg) -> NodeArg& {
+    TypeProto type = *node_arg.TypeAsProto();
+    type.mutable_tensor_type()->set_elem_type(target_type_);
+    return graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(node_arg.Name() + suffix), &type);
+  };
+  auto add_cast_node = [&](NodeArg& input, NodeArg& output, TensorProto_DataType to,
+                           const std::string& provider_type) -> Node& {
+    Node& cast = graph.AddNode(graph.GenerateNodeName("MixedPrecisionCast_" + input.Name()), "Cast",
+                               "cast node inserted by the mixed precision conversion", {&input}, {&output});
+    cast.AddAttribute("to", static_cast<int64_t>(to));
+    cast.SetExecutionProviderType(provider_type);
+    return cast;
+  };
+
+  GraphViewer graph_viewer(graph);
+  const auto& order = graph_viewer.GetNodesInTopologicalOrder();
+  for (NodeIndex index : order) {
+    Node* node = graph.GetNode(index);
+    if (node == nullptr) {
+      continue;
+    }
+
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders())) {
+      continue;
+    }
+    const auto type_strs = GetConvertedTypeConstraints(graph, *node);
+    if (type_strs.empty()) {
+      continue;
+    }
+
+    const auto* schema = node->Op();
+    auto is_converted = [&type_strs](const std::vector<OpSchema::FormalParameter>& params, size_t i,
+                                     const NodeArg& node_arg) {
+      const std::string* type_str = GetTypeStr(params, i);
+      return node_arg.Exists() && IsFloatTensor(node_arg) && type_str != nullptr &&
+             std::find(type_strs.begin(), type_strs.end(), *type_str) != type_strs.end();
+    };
+    const auto& provider_type = node->GetExecutionProviderType();
+    std::map<const NodeArg*, NodeArg*> replacement_defs;
+
+    auto& input_defs = node->MutableInputDefs();
+    for (size_t i = 0; i < input_defs.size(); ++i) {
+      NodeArg* input = input_defs[i];
+      if (!is_converted(schema->inputs(), i, *input) || replacement_defs.count(input) > 0) {
+        continue;
+      }
+
+      NodeArg* target_input = nullptr;
+      if (auto converted = converted_values.find(input); converted != converted_values.end()) {
+        target_input = converted->second;
+      } else if (const auto* initializer = graph.GetConstantInitializer(input->Name(), false)) {
+        Initializer values{*initializer, graph.ModelPath()};
+        const std::string name = graph.GenerateNodeArgName(input->Name() + suffix);
+        target_input = &graph_utils::AddInitializer(graph, is_fp16 ? values.ToFP16(name) : values.ToBFloat16(name));
+        converted_initializers.push_back(input->Name());
+      } else {
+        target_input = &create_target_node_arg(*input);
+        add_cast_node(*input, *target_input, target_type_, provider_type);
+      }
+      converted_values[input] = target_input;
+      replacement_defs[input] = target_input;
+    }
+
+    auto& output_defs = node->MutableOutputDefs();
+    for (size_t i = 0; i < output_defs.size(); ++i) {
+      NodeArg* output = output_defs[i];
+      if (!is_converted(schema->outputs(), i, *output)) {
+        continue;
+      }
+
+      NodeArg& target_output = create_target_node_arg(*output);
+      output_casts.push_back(add_cast_node(target_output, *output, TensorProto_DataType_FLOAT, provider_type).Index());
+      converted_values[output] = &target_output;
+      replacement_defs[output] = &target_output;
+    }
+
+    node->ReplaceDefs(replacement_defs);
+    modified = true;
+  }
+
+  if (output_casts.empty() && converted_initializers.empty()) {
+    return Status::OK();
+  }
+
+  // remove the casts back to float and the float initializers that are no longer consumed
+  InlinedHashSet<const NodeArg*> consumed_values(graph.GetOutputs().begin(), graph.GetOutputs().end());
+  for (const auto& node : graph.Nodes()) {
+    for (const auto* input_def : node.InputDefs()) {
+      consumed_values.insert(input_def);
+    }
+    for (const auto* implicit_input_def : node.ImplicitInputDefs()) {
+      consumed_values.insert(implicit_input_def);
+    }
+  }
+  for (NodeIndex cast_index : output_casts) {
+    if (consumed_values.count(graph.GetNode(cast_index)->OutputDefs()[0]) == 0) {
+      graph.RemoveNode(cast_index);
+    }
+  }
+  for (const auto& name : converted_initializers) {
+    if (consumed_values.count(graph.GetNodeArg(name)) == 0 && graph.GetConstantInitializer(name, false) != nullptr) {
+      graph.RemoveInitializedTensor(name);
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,60 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/framework/kernel_registry_manager.h"
+#include "core/graph/basic_types.h"
+#include "core/graph/constants.h"
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class MixedPrecisionTransformer
+
+Transformer that converts the float nodes of the compatible execution providers to float16 or bfloat16, for models
+that are only available in float.
+
+A node is converted if its op type is allowed, the execution provider assigned to it has a kernel for the converted
+types, and none of its constant float inputs overflow float16. The allowed op types are the compute heavy ops and the
+data movement ops, which do not lose precision in float16; reductions, Softmax, the normalizations, Exp, Log and Pow
+stay in float. The float constant inputs of a converted node are converted in place of being cast, and the other float
+inputs and outputs are cast. The converted values are reused by the later converted nodes, so a region of converted
+nodes has no casts inside it and only the values that leave the region are cast back to float.
+
+It runs after partitioning, as the nodes have to be assigned to an execution provider.
+*/
+class MixedPrecisionTransformer : public GraphTransformer {
+ public:
+  /**
+   * @param target_type TensorProto_DataType_FLOAT16 or TensorProto_DataType_BFLOAT16.
+   * @param allow_ops op types that are converted in addition to those of GetDefaultAllowOps().
+   * @param deny_ops op types that are never converted. They take precedence over the allowed op types.
+   */
+  MixedPrecisionTransformer(ONNX_NAMESPACE::TensorProto_DataType target_type,
+                            gsl::span<const std::string> allow_ops, gsl::span<const std::string> deny_ops,
+                            const KernelRegistryManager& registry_manager,
+                            const InlinedHashSet<std::string_view>& compatible_execution_providers = {
+                                kCudaExecutionProvider, kRocmExecutionProvider});
+
+  static const InlinedHashSet<std::string>& GetDefaultAllowOps();
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  // Returns the type constraints of node whose float tensors are converted, or an empty vector if node stays in float.
+  InlinedVector<std::string> GetConvertedTypeConstraints(const Graph& graph, const Node& node) const;
+
+  const ONNX_NAMESPACE::TensorProto_DataType target_type_;
+  InlinedHashSet<std::string> allow_ops_;
+  std::reference_wrapper<const KernelRegistryManager> registry_manager_;
+};
+
+}  // namespace onnxruntime
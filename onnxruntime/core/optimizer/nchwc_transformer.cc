@@ -1218,14 +1218,201 @@ void NchwcTransformerImpl::Finalize(bool& modified) {
   }
 }
 
+namespace {
+
+// Estimated gain of a NCHWc convolution per multiply-accumulate relative to the cost of reordering one element of
+// a tensor between the NCHW and NCHWc formats. The reorders are bound by the memory bandwidth and the convolutions
+// by the compute throughput, which the NCHWc kernels use better.
+constexpr double kNchwcConvGainPerMac = 0.02;
+
+bool IsNchwcRegionStart(const Node& node) {
+  const auto& op_type = node.OpType();
+  return ((op_type == "Conv" || op_type == "MaxPool" || op_type == "AveragePool") && node.Domain() == kOnnxDomain) ||
+         (op_type == "FusedConv" && node.Domain() == kMSDomain);
+}
+
+// Returns true if the node can be converted to the NCHWc format once its inputs are. See NchwcTransformerImpl.
+bool IsNchwcRegionNode(const Node& node) {
+  static const InlinedHashSet<std::string_view> op_types{"Add", "Sum", "Mul", "Concat", "Relu", "Sigmoid", "Tanh",
+                                                         "BatchNormalization", "Upsample", "Resize",
+                                                         "GlobalMaxPool", "GlobalAveragePool"};
+  return node.GetExecutionProviderType() == kCpuExecutionProvider &&
+         (IsNchwcRegionStart(node) || (node.Domain() == kOnnxDomain && op_types.count(node.OpType()) > 0));
+}
+
+// Transposes between the NHWC and NCHW formats are fused into the reorders, so they don't add a reorder.
+bool IsNhwcTranspose(const Node& node) {
+  if (node.OpType() != "Transpose" || node.Domain() != kOnnxDomain) {
+    return false;
+  }
+
+  const auto* perm_attr = graph_utils::GetNodeAttribute(node, "perm");
+  if (perm_attr == nullptr || perm_attr->ints_size() != 4) {
+    return false;
+  }
+
+  const std::vector<int64_t> perm{perm_attr->ints().begin(), perm_attr->ints().end()};
+  return perm == std::vector<int64_t>{0, 3, 1, 2} || perm == std::vector<int64_t>{0, 2, 3, 1};
+}
+
+// Returns false if the shape of the arg is not a known 4D shape.
+bool GetNchwElementCount(const NodeArg& arg, double& element_count) {
+  const auto* shape = arg.Shape();
+  if (shape == nullptr || shape->dim_size() != 4) {
+    return false;
+  }
+
+  element_count = 1.0;
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return false;
+    }
+    element_count *= static_cast<double>(dim.dim_value());
+  }
+
+  return true;
+}
+
+// Finds the connected regions of nodes that can use the NCHWc format where the estimated cost of the reorders at
+// the region boundaries is higher than the estimated gain of the convolutions in the region, and returns the nodes
+// that would start converting these regions. Regions with shapes that aren't known are converted as usual.
+InlinedHashSet<NodeIndex> FindUnprofitableNchwcRegions(const Graph& graph, const GraphViewer& graph_viewer,
+                                                       const logging::Logger& logger) {
+  InlinedHashSet<NodeIndex> skipped_nodes;
+  InlinedHashSet<NodeIndex> visited;
+
+  for (auto index : graph_viewer.GetNodesInTopologicalOrder()) {
+    const Node* start_node = graph.GetNode(index);
+    if (start_node == nullptr || !IsNchwcRegionStart(*start_node) || !IsNchwcRegionNode(*start_node) ||
+        !visited.insert(index).second) {
+      continue;
+    }
+
+    InlinedVector<const Node*> region{start_node};
+    InlinedHashSet<NodeIndex> region_nodes{index};
+    for (size_t i = 0; i < region.size(); ++i) {
+      const Node& node = *region[i];
+      auto visit = [&](const Node& neighbour) {
+        if (IsNchwcRegionNode(neighbour) && visited.insert(neighbour.Index()).second) {
+          region.push_back(&neighbour);
+          region_nodes.insert(neighbour.Index());
+        }
+      };
+
+      for (auto it = node.InputNodesBegin(); it != node.InputNodesEnd(); ++it) {
+        visit(*it);
+      }
+      for (auto it = node.OutputNodesBegin(); it != node.OutputNodesEnd(); ++it) {
+        visit(*it);
+      }
+    }
+
+    bool known_costs = true;
+    bool has_conv = false;
+    double reorder_cost = 0.0;
+    double conv_gain = 0.0;
+    InlinedHashSet<const NodeArg*> reordered_args;
+
+    auto add_reorder = [&](const NodeArg& arg) {
+      double element_count = 0.0;
+      if (!reordered_args.insert(&arg).second) {
+        return;
+      }
+      if (GetNchwElementCount(arg, element_count)) {
+        reorder_cost += element_count;
+      } else if (arg.Shape() == nullptr) {
+        known_costs = false;
+      }
+      // other ranks are not reordered
+    };
+
+    for (const Node* node : region) {
+      const ONNX_NAMESPACE::TensorProto* weights = nullptr;
+      const bool is_conv = node->OpType() == "Conv" || node->OpType() == "FusedConv";
+      if (is_conv && (node->InputDefs().size() < 2 ||
+                      !graph.GetInitializedTensor(node->InputDefs()[1]->Name(), weights) ||
+                      weights->dims_size() != 4)) {
+        weights = nullptr;
+      }
+
+      // tensors produced outside of the region are reordered to NCHWc unless they are constant
+      const auto& input_defs = node->InputDefs();
+      for (size_t i = 0; i < input_defs.size(); ++i) {
+        const auto* input_def = input_defs[i];
+        if (!input_def->Exists() || graph_utils::NodeArgIsConstant(graph, *input_def)) {
+          continue;
+        }
+
+        // a Conv with fewer input channels than the block size uses the NCHW input directly
+        if (i == 0 && weights != nullptr && static_cast<size_t>(weights->dims(1)) < MlasNchwcGetBlockSize()) {
+          continue;
+        }
+
+        const Node* producer = graph.GetProducerNode(input_def->Name());
+        if (producer == nullptr || (region_nodes.count(producer->Index()) == 0 && !IsNhwcTranspose(*producer))) {
+          add_reorder(*input_def);
+        }
+      }
+
+      // tensors used outside of the region are reordered back to NCHW
+      for (const auto* output_def : node->OutputDefs()) {
+        if (!output_def->Exists()) {
+          continue;
+        }
+
+        bool used_outside_region = graph.IsOutput(output_def);
+        for (const Node* consumer : graph.GetConsumerNodes(output_def->Name())) {
+          used_outside_region = used_outside_region ||
+                                (region_nodes.count(consumer->Index()) == 0 && !IsNhwcTranspose(*consumer));
+        }
+
+        if (used_outside_region) {
+          add_reorder(*output_def);
+        }
+      }
+
+      if (is_conv) {
+        has_conv = true;
+        double output_count = 0.0;
+        if (weights == nullptr || !GetNchwElementCount(*node->OutputDefs()[0], output_count)) {
+          known_costs = false;
+          continue;
+        }
+
+        conv_gain += output_count * weights->dims(1) * weights->dims(2) * weights->dims(3) * kNchwcConvGainPerMac;
+      }
+    }
+
+    if (has_conv && known_costs && reorder_cost > conv_gain) {
+      LOGS(logger, VERBOSE) << "Keeping " << region.size() << " node(s) starting at '" << start_node->Name()
+                            << "' in NCHW format. Estimated reorder cost " << reorder_cost << " exceeds the gain "
+                            << conv_gain << ".";
+      for (const Node* node : region) {
+        if (IsNchwcRegionStart(*node)) {
+          skipped_nodes.insert(node->Index());
+        }
+      }
+    }
+  }
+
+  return skipped_nodes;
+}
+
+}  // namespace
+
 Status NchwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
   NchwcTransformerImpl impl(graph);
   GraphViewer graph_viewer(graph);
 
+  InlinedHashSet<NodeIndex> skipped_nodes;
+  if (skip_unprofitable_regions_) {
+    skipped_nodes = FindUnprofitableNchwcRegions(graph, graph_viewer, logger);
+  }
+
   for (auto index : graph_viewer.GetNodesInTopologicalOrder()) {
     auto& node = *graph.GetNode(index);
     ORT_RETURN_IF_ERROR(Recurse(node, modified, graph_level, logger));
-    if (node.GetExecutionProviderType() == kCpuExecutionProvider) {
+    if (node.GetExecutionProviderType() == kCpuExecutionProvider && skipped_nodes.count(index) == 0) {
       impl.Transform(node);
     }
   }
@@ -13,13 +13,20 @@ namespace onnxruntime {
 
 Transformer that optimizes the graph by using NCHWc nodes instead of NCHW nodes
 and inserts nodes to reorder tensors as needed.
+
+If skip_unprofitable_regions is set, the connected regions of nodes that can use the NCHWc format are kept in the
+NCHW format when the estimated cost of reordering the tensors at the region boundaries is higher than the estimated
+gain of the NCHWc convolutions, e.g. for a single pointwise Conv between nodes that need the NCHW format.
 */
 class NchwcTransformer : public GraphTransformer {
  public:
-  NchwcTransformer() noexcept : GraphTransformer("NchwcTransformer") {}
+  explicit NchwcTransformer(bool skip_unprofitable_regions = false) noexcept
+      : GraphTransformer("NchwcTransformer"), skip_unprofitable_regions_(skip_unprofitable_regions) {}
 
  private:
   Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+  const bool skip_unprofitable_regions_;
 };
 
 }  // namespace onnxruntime
@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <deque>
+#include <unordered_set>
 #include "core/graph/graph_utils.h"
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/nhwc_transformer.h"
@@ -14,6 +16,67 @@ using namespace onnx_layout_transformation;
 
 namespace onnxruntime {
 
+namespace {
+
+enum class FloatConvKind {
+  kNone,
+  kDepthwise,
+  kPointwise,
+};
+
+// Classifies a float 2D Conv or FusedConv that the NhwcConv CPU kernel can run. Depthwise convolutions have a channel
+// multiplier of one, pointwise convolutions a 1x1 filter with unit strides and no padding.
+FloatConvKind GetFloatConvKind(const api::GraphRef& graph, const api::NodeRef& node) {
+  if (node.IsOp("Conv")) {
+    if (node.SinceVersion() != 1 && node.SinceVersion() != 11) {
+      return FloatConvKind::kNone;
+    }
+  } else if (node.IsOp("FusedConv", kMSDomain)) {
+    // The Sum input of FusedConv is not supported by NhwcConv.
+    if (node.Inputs().size() > 3) {
+      return FloatConvKind::kNone;
+    }
+  } else {
+    return FloatConvKind::kNone;
+  }
+
+  auto inputs = node.Inputs();
+  auto input_info = graph.GetValueInfo(inputs[0]);
+  auto input_shape = input_info->Shape();
+  if (input_info->DType() != api::DataType::FLOAT || !input_shape.has_value() || input_shape->size() != 4) {
+    return FloatConvKind::kNone;
+  }
+
+  auto weight = graph.GetConstant(inputs[1]);
+  if (weight == nullptr) {
+    return FloatConvKind::kNone;
+  }
+
+  auto weight_shape = weight->Shape();
+  if (weight_shape.size() != 4) {
+    return FloatConvKind::kNone;
+  }
+
+  const int64_t group = node.GetAttributeIntDefault("group", 1);
+
+  if (weight_shape[1] == 1 && group > 1 && weight_shape[0] == group && (*input_shape)[1] == group) {
+    return FloatConvKind::kDepthwise;
+  }
+
+  auto is_all = [](const std::optional<std::vector<int64_t>>& values, int64_t value) {
+    return !values.has_value() || std::all_of(values->begin(), values->end(), [&](int64_t v) { return v == value; });
+  };
+
+  if (group == 1 && weight_shape[2] == 1 && weight_shape[3] == 1 && is_all(node.GetAttributeInts("strides"), 1) &&
+      is_all(node.GetAttributeInts("pads"), 0)) {
+    return FloatConvKind::kPointwise;
+  }
+
+  return FloatConvKind::kNone;
+}
+
+}  // namespace
+
 Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const {
 #if defined(ORT_MINIMAL_BUILD)
   // update the producer/consumer info as previous optimizations may have invalidated it.
@@ -29,6 +92,39 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
 
   auto api_graph = MakeApiGraph(graph, cpu_allocator_, kCpuExecutionProvider);
 
+  // Depthwise convolutions always run in NHWC using the MLAS depthwise kernel. Pointwise convolutions run in NHWC when
+  // they are adjacent to a depthwise convolution so that an inverted bottleneck block stays channels last and the
+  // transpose optimizer can cancel the transposes between the convolutions. The convolutions are selected before the
+  // graph is modified because converting a node inserts transposes between it and its neighbours.
+  std::unordered_set<NodeIndex> depthwise_convs;
+  std::vector<std::unique_ptr<api::NodeRef>> pointwise_convs;
+  for (std::unique_ptr<api::NodeRef>& node : api_graph->Nodes()) {
+    if (node->GetExecutionProviderType() != kCpuExecutionProvider) {
+      continue;
+    }
+    FloatConvKind conv_kind = GetFloatConvKind(*api_graph, *node);
+    if (conv_kind == FloatConvKind::kDepthwise) {
+      depthwise_convs.insert(NodeFromApiNode(*node).Index());
+    } else if (conv_kind == FloatConvKind::kPointwise) {
+      pointwise_convs.push_back(std::move(node));
+    }
+  }
+
+  auto is_depthwise_conv = [&](api::NodeRef* node) {
+    return node != nullptr && depthwise_convs.count(NodeFromApiNode(*node).Index()) != 0;
+  };
+
+  std::unordered_set<NodeIndex> nhwc_convs(depthwise_convs);
+  for (std::unique_ptr<api::NodeRef>& node : pointwise_convs) {
+    bool adjacent = is_depthwise_conv(api_graph->GetNodeProducingOutput(node->Inputs()[0]).get());
+    for (const auto& consumer : api_graph->GetValueConsumers(node->Outputs()[0])->nodes) {
+      adjacent = adjacent || is_depthwise_conv(consumer.get());
+    }
+    if (adjacent) {
+      nhwc_convs.insert(NodeFromApiNode(*node).Index());
+    }
+  }
+
   modified = false;
   for (std::unique_ptr<api::NodeRef>& node : api_graph->Nodes()) {
     // If the node is not supported in the CPU EP, skip it
@@ -36,8 +132,8 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       continue;
     }
 
-    // Only QLinearConv needs to be handled explicitly. The rest will be transformed if needed during transpose
-    // optimization.
+    // Only QLinearConv and the float convolutions selected above need to be handled explicitly. The rest will be
+    // transformed if needed during transpose optimization.
     if (node->OpType() == "QLinearConv") {
       auto domain = node->Domain();
 
@@ -70,7 +166,21 @@ Status NhwcTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
       }
 
       modified = true;
+      continue;
+    }
+
+    if (nhwc_convs.count(NodeFromApiNode(*node).Index()) == 0) {
+      continue;
     }
+
+    std::vector<int64_t> input_perm = ChannelFirstToLastPerm(4);
+    std::vector<int64_t> output_perm = ChannelLastToFirstPerm(4);
+    WrapTransposesAroundNode(*api_graph, *node, {&input_perm}, {&output_perm});
+
+    // The activation attributes of FusedConv are carried over to NhwcConv.
+    SwapNodeOpTypeDomainAndSinceVersion(*api_graph, *node, "NhwcConv", kMSDomain, 1);
+
+    modified = true;
   }
 
   if (modified) {
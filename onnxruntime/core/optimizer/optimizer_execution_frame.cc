@@ -8,6 +8,7 @@
 #include "core/common/logging/macros.h"
 #include "core/common/status.h"
 #include "core/framework/callback.h"
+#include "core/framework/config_options.h"
 #include "core/framework/data_transfer_manager.h"
 #include "core/framework/data_types.h"
 #include "core/framework/fuse_nodes_funcs.h"
@@ -140,12 +141,15 @@ static Status TryCreateKernel(const Node& node,
   const KernelCreateInfo* kernel_create_info = nullptr;
   ORT_RETURN_IF_ERROR(kernel_registry.TryFindKernel(node, execution_provider.Type(), kernel_type_str_resolver,
                                                     &kernel_create_info));
+  // Kernels run by the optimizers are not affected by the session config
+  static const ConfigOptions empty_config_options{};
   OpKernelInfo kernel_info(node,
                            *kernel_create_info->kernel_def,
                            execution_provider,
                            constant_initialized_tensors,
                            ort_value_name_idx_map,
-                           data_transfer_mgr);
+                           data_transfer_mgr,
+                           empty_config_options);
   return kernel_create_info->kernel_create_func(funcs_mgr, kernel_info, op_kernel);
 }
 
@@ -175,6 +179,16 @@ OptimizerExecutionFrame::OptimizerExecutionFrame(const Info& info,
   Init(gsl::span<const int>(), gsl::span<const OrtValue>(), info.GetInitializers(), info.GetSparseInitializerLookupFunc(), fetches);
 }
 
+OptimizerExecutionFrame::OptimizerExecutionFrame(const Info& info,
+                                                 const std::vector<int>& feed_mlvalue_idxs,
+                                                 const std::vector<OrtValue>& feeds,
+                                                 const std::vector<int>& fetch_mlvalue_idxs,
+                                                 const std::vector<OrtValue>& fetches)
+    : IExecutionFrame(info.GetMLValueNameIdxMap(), info.GetNodeIndexInfo(), fetch_mlvalue_idxs),
+      info_(info) {
+  Init(feed_mlvalue_idxs, feeds, info.GetInitializers(), info.GetSparseInitializerLookupFunc(), fetches);
+}
+
 AllocatorPtr OptimizerExecutionFrame::GetAllocatorImpl(const OrtMemoryInfo& info) const {
   return info_.GetAllocator(info);
 }
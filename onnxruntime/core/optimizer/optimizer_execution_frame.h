@@ -89,6 +89,13 @@ class OptimizerExecutionFrame final : public IExecutionFrame {
                           const std::vector<int>& fetch_mlvalue_idxs,
                           const std::vector<OrtValue>& fetches = {});
 
+  // Feed "feeds" as the values of "feed_mlvalue_idxs" in addition to the initializers in "info".
+  OptimizerExecutionFrame(const Info& info,
+                          const std::vector<int>& feed_mlvalue_idxs,
+                          const std::vector<OrtValue>& feeds,
+                          const std::vector<int>& fetch_mlvalue_idxs,
+                          const std::vector<OrtValue>& fetches);
+
   ~OptimizerExecutionFrame() override = default;
 
  private:
@@ -0,0 +1,395 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/packed_sequence_transformer.h"
+
+#include <algorithm>
+
+#include "core/framework/tensorprotoutils.h"
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+bool SameDim(const TensorShapeProto_Dimension& a, const TensorShapeProto_Dimension& b) {
+  return (utils::HasDimValue(a) && utils::HasDimValue(b) && a.dim_value() == b.dim_value()) ||
+         (utils::HasDimParam(a) && utils::HasDimParam(b) && a.dim_param() == b.dim_param());
+}
+
+bool HasRankAtMost(const NodeArg* arg, int rank) {
+  return arg != nullptr && arg->Exists() && arg->Shape() != nullptr && arg->Shape()->dim_size() <= rank;
+}
+
+// Returns true if arg is a float or float16 tensor with shape (batch_size, sequence_length, hidden_size)
+// where batch_size and sequence_length are the leading dims of padded_shape.
+bool IsPadded(const NodeArg& arg, const TensorShapeProto& padded_shape) {
+  const auto* type = arg.TypeAsProto();
+  if (type == nullptr || !type->has_tensor_type() ||
+      (type->tensor_type().elem_type() != TensorProto_DataType_FLOAT &&
+       type->tensor_type().elem_type() != TensorProto_DataType_FLOAT16)) {
+    return false;
+  }
+
+  const auto* shape = arg.Shape();
+  return shape != nullptr && shape->dim_size() == 3 &&
+         SameDim(shape->dim(0), padded_shape.dim(0)) && SameDim(shape->dim(1), padded_shape.dim(1));
+}
+
+bool OutputExists(const Node& node, size_t index) {
+  return node.OutputDefs().size() > index && node.OutputDefs()[index]->Exists();
+}
+
+// Returns true if every token of the node inputs listed in activation_inputs maps to the token at the same
+// position of the outputs, so the node gives the same result on (total_tokens, hidden_size) tensors.
+// The other inputs must be parameters that are broadcast along the tokens.
+bool IsTokenWise(const Node& node, InlinedVector<int>& activation_inputs) {
+  const auto& inputs = node.InputDefs();
+  activation_inputs.clear();
+
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13})) {
+    // the weight must not have a batch dimension
+    if (!HasRankAtMost(inputs[1], 2) || inputs[1]->Shape()->dim_size() != 2) {
+      return false;
+    }
+    activation_inputs.push_back(0);
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Add", {7, 13, 14}) ||
+             graph_utils::IsSupportedOptypeVersionAndDomain(node, "Sub", {7, 13, 14}) ||
+             graph_utils::IsSupportedOptypeVersionAndDomain(node, "Mul", {7, 13, 14}) ||
+             graph_utils::IsSupportedOptypeVersionAndDomain(node, "Div", {7, 13, 14})) {
+    for (int i = 0; i < 2; ++i) {
+      if (!HasRankAtMost(inputs[i], 1)) {
+        activation_inputs.push_back(i);
+      }
+    }
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "FastGelu", {1}, kMSDomain) ||
+             graph_utils::IsSupportedOptypeVersionAndDomain(node, "BiasGelu", {1}, kMSDomain)) {
+    if (inputs.size() > 1 && inputs[1]->Exists() && !HasRankAtMost(inputs[1], 1)) {
+      return false;
+    }
+    activation_inputs.push_back(0);
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "Gelu", {1}, kMSDomain) ||
+             graph_utils::IsSupportedOptypeVersionAndDomain(node, "Relu", {6, 13, 14}) ||
+             graph_utils::IsSupportedOptypeVersionAndDomain(node, "Tanh", {6, 13})) {
+    activation_inputs.push_back(0);
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "SkipLayerNormalization", {1}, kMSDomain)) {
+    // mean and inv_std_var have a shape that depends on the layout
+    if (OutputExists(node, 1) || OutputExists(node, 2)) {
+      return false;
+    }
+    for (size_t i = 2; i < inputs.size(); ++i) {
+      if (inputs[i]->Exists() && !HasRankAtMost(inputs[i], 1)) {
+        return false;
+      }
+    }
+    activation_inputs.push_back(0);
+    activation_inputs.push_back(1);
+  } else if (graph_utils::IsSupportedOptypeVersionAndDomain(node, "LayerNormalization", {1, 17})) {
+    const auto* axis = graph_utils::GetNodeAttribute(node, "axis");
+    if ((axis != nullptr && axis->i() != -1) || OutputExists(node, 1) || OutputExists(node, 2)) {
+      return false;
+    }
+    for (size_t i = 1; i < inputs.size(); ++i) {
+      if (inputs[i]->Exists() && !HasRankAtMost(inputs[i], 1)) {
+        return false;
+      }
+    }
+    activation_inputs.push_back(0);
+  }
+
+  return !activation_inputs.empty();
+}
+
+// Returns true if the Attention node can be part of a packed encoder: it has a 1D mask_index with the token count
+// of every sequence and no past state, so its padded input and output line up with the packed tokens.
+bool IsEncoderAttention(const Node& node) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(node, "Attention", {1}, kMSDomain)) {
+    return false;
+  }
+
+  const auto& inputs = node.InputDefs();
+  if (inputs.size() < 4 || !inputs[0]->Exists() || !inputs[1]->Exists() || !inputs[3]->Exists()) {
+    return false;
+  }
+  for (size_t i = 4; i < inputs.size(); ++i) {
+    if (inputs[i]->Exists()) {
+      return false;
+    }
+  }
+
+  const auto* unidirectional = graph_utils::GetNodeAttribute(node, "unidirectional");
+  if (unidirectional != nullptr && unidirectional->i() != 0) {
+    return false;
+  }
+
+  const auto* input_shape = inputs[0]->Shape();
+  const auto* mask_shape = inputs[3]->Shape();
+  const auto* mask_type = inputs[3]->TypeAsProto();
+  return input_shape != nullptr && input_shape->dim_size() == 3 &&
+         mask_shape != nullptr && mask_shape->dim_size() == 1 && SameDim(mask_shape->dim(0), input_shape->dim(0)) &&
+         mask_type != nullptr && mask_type->tensor_type().elem_type() == TensorProto_DataType_INT32 &&
+         IsPadded(*node.OutputDefs()[0], *input_shape);
+}
+
+// Adds the edge from the producer of the given input of node, if the input is not a graph input or initializer.
+void ConnectInput(Graph& graph, Node& node, int input_index) {
+  const NodeArg* arg = node.InputDefs()[input_index];
+  const Node* producer = graph.GetProducerNode(arg->Name());
+  if (producer == nullptr) {
+    return;
+  }
+
+  const auto& outputs = producer->OutputDefs();
+  for (size_t i = 0; i < outputs.size(); ++i) {
+    if (outputs[i] == arg) {
+      graph.AddEdge(producer->Index(), node.Index(), static_cast<int>(i), input_index);
+      return;
+    }
+  }
+}
+
+// Replaces the given input of node with an output of another node, updating the edges.
+void ReplaceInput(Graph& graph, Node& node, int input_index, const Node& producer, int output_index) {
+  for (auto it = node.InputEdgesBegin(), end = node.InputEdgesEnd(); it != end; ++it) {
+    if (it->GetDstArgIndex() == input_index) {
+      graph.RemoveEdge(it->GetNode().Index(), node.Index(), it->GetSrcArgIndex(), input_index);
+      break;
+    }
+  }
+
+  graph.AddEdge(producer.Index(), node.Index(), output_index, input_index);
+}
+
+struct Encoder {
+  NodeArg* mask = nullptr;
+  TensorShapeProto padded_shape;
+  InlinedHashSet<const NodeArg*> attention_outputs;
+};
+
+// Packs the token-wise nodes that follow the Attention nodes of the encoder.
+// Returns true if the graph was modified.
+bool PackEncoder(Graph& graph, const GraphViewer& graph_viewer, const Encoder& encoder,
+                 const InlinedHashSet<std::string_view>& compatible_providers,
+                 InlinedHashSet<NodeIndex>& packed_node_indices) {
+  // find the token-wise nodes that can run on packed tokens, in topological order
+  InlinedVector<Node*> packed_nodes;
+  InlinedHashMap<NodeIndex, InlinedVector<int>> packed_node_activations;
+  InlinedHashSet<const NodeArg*> packed_args;
+  InlinedVector<NodeArg*> args_to_pack;
+  InlinedHashSet<const NodeArg*> args_to_pack_set;
+
+  for (auto node_index : graph_viewer.GetNodesInTopologicalOrder()) {
+    Node* node = graph.GetNode(node_index);
+    InlinedVector<int> activations;
+    if (node == nullptr || packed_node_indices.count(node_index) > 0 ||
+        !graph_utils::IsSupportedProvider(*node, compatible_providers) || !IsTokenWise(*node, activations)) {
+      continue;
+    }
+
+    bool follows_encoder = false;
+    bool can_pack = true;
+    for (int i : activations) {
+      const NodeArg* arg = node->InputDefs()[i];
+      if (packed_args.count(arg) > 0) {
+        follows_encoder = true;
+      } else if (IsPadded(*arg, encoder.padded_shape)) {
+        follows_encoder = follows_encoder || encoder.attention_outputs.count(arg) > 0;
+      } else {
+        can_pack = false;
+      }
+    }
+
+    // the packed outputs are restored for their consumers, which is not supported for subgraph implicit inputs
+    for (auto it = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); it != end && can_pack; ++it) {
+      can_pack = static_cast<size_t>(it->GetDstArgIndex()) < it->GetNode().InputDefs().size();
+    }
+
+    if (!follows_encoder || !can_pack) {
+      continue;
+    }
+
+    for (int i : activations) {
+      NodeArg* arg = node->MutableInputDefs()[i];
+      if (packed_args.count(arg) == 0 && args_to_pack_set.insert(arg).second) {
+        args_to_pack.push_back(arg);
+      }
+    }
+    for (const NodeArg* output : node->OutputDefs()) {
+      if (output->Exists()) {
+        packed_args.insert(output);
+      }
+    }
+    packed_nodes.push_back(node);
+    packed_node_activations[node_index] = std::move(activations);
+  }
+
+  if (packed_nodes.empty()) {
+    return false;
+  }
+
+  TypeProto int32_type;
+  int32_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT32);
+
+  // the RemovePadding node that provides the token_offset for each packed arg
+  InlinedHashMap<const NodeArg*, Node*> offset_nodes;
+  InlinedHashMap<const NodeArg*, Node*> remove_padding_nodes;
+  for (NodeArg* arg : args_to_pack) {
+    NodeArg& packed_arg = graph_utils::CreateNodeArg(graph, *arg);
+    packed_arg.ClearShape();
+    NodeArg& token_offset = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("token_offset"), &int32_type);
+    NodeArg& cumulated_seq_len = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("cumulated_seq_len"),
+                                                          &int32_type);
+    NodeArg& max_seq_len = graph.GetOrCreateNodeArg(graph.GenerateNodeArgName("max_seq_len"), &int32_type);
+
+    Node& remove_padding = graph.AddNode(graph.GenerateNodeName("RemovePadding"), "RemovePadding",
+                                         "Packed sequence of " + arg->Name(), {arg, encoder.mask},
+                                         {&packed_arg, &token_offset, &cumulated_seq_len, &max_seq_len},
+                                         nullptr, kMSDomain);
+    remove_padding.SetExecutionProviderType(kCudaExecutionProvider);
+    ConnectInput(graph, remove_padding, 0);
+    ConnectInput(graph, remove_padding, 1);
+
+    remove_padding_nodes[arg] = &remove_padding;
+    offset_nodes[&packed_arg] = &remove_padding;
+  }
+
+  // switch the packed nodes to the packed args. the shapes of their outputs are inferred again by Graph::Resolve
+  InlinedHashMap<const NodeArg*, NodeArg*> renamed_outputs;
+  InlinedHashMap<const NodeArg*, TypeProto> padded_types;
+  for (Node* node : packed_nodes) {
+    Node* offset_node = nullptr;
+    for (int i : packed_node_activations[node->Index()]) {
+      const NodeArg* arg = node->InputDefs()[i];
+      if (auto renamed = renamed_outputs.find(arg); renamed != renamed_outputs.end()) {
+        graph_utils::ReplaceNodeInput(*node, i, *renamed->second);
+      } else if (auto remove_padding = remove_padding_nodes.find(arg); remove_padding != remove_padding_nodes.end()) {
+        ReplaceInput(graph, *node, i, *remove_padding->second, 0);
+      }
+
+      if (offset_node == nullptr) {
+        offset_node = offset_nodes[node->InputDefs()[i]];
+      }
+    }
+
+    auto& outputs = node->MutableOutputDefs();
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      NodeArg* output = outputs[i];
+      if (!output->Exists()) {
+        continue;
+      }
+
+      if (graph.IsOutput(output)) {
+        // keep the padded layout for the graph output, which is produced by RestorePadding
+        NodeArg& packed_output = graph_utils::CreateNodeArg(graph, *output);
+        packed_output.ClearShape();
+        outputs[i] = &packed_output;
+        renamed_outputs[output] = &packed_output;
+        output = &packed_output;
+      } else {
+        padded_types.emplace(output, *output->TypeAsProto());
+        output->ClearShape();
+      }
+      offset_nodes[output] = offset_node;
+    }
+
+    packed_node_indices.insert(node->Index());
+  }
+
+  // restore the padding for the consumers of packed args that are not packed themselves
+  InlinedHashMap<const NodeArg*, const NodeArg*> graph_outputs;
+  for (const auto& renamed : renamed_outputs) {
+    graph_outputs[renamed.second] = renamed.first;
+  }
+
+  for (Node* node : packed_nodes) {
+    const auto& outputs = node->OutputDefs();
+    for (size_t i = 0; i < outputs.size(); ++i) {
+      NodeArg* output = node->MutableOutputDefs()[i];
+      if (!output->Exists()) {
+        continue;
+      }
+
+      InlinedVector<std::pair<NodeIndex, int>> consumers;
+      for (auto it = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); it != end; ++it) {
+        if (it->GetSrcArgIndex() == static_cast<int>(i) && packed_node_indices.count(it->GetNode().Index()) == 0) {
+          consumers.emplace_back(it->GetNode().Index(), it->GetDstArgIndex());
+        }
+      }
+
+      auto graph_output = graph_outputs.find(output);
+      if (consumers.empty() && graph_output == graph_outputs.end()) {
+        continue;
+      }
+
+      NodeArg* padded_output = graph_output != graph_outputs.end()
+                                   ? graph.GetNodeArg(graph_output->second->Name())
+                                   : &graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(output->Name() + "_padded"),
+                                                               &padded_types[output]);
+      Node* offset_node = offset_nodes[output];
+      Node& restore_padding = graph.AddNode(graph.GenerateNodeName("RestorePadding"), "RestorePadding",
+                                            "Padded sequence of " + output->Name(),
+                                            {output, offset_node->MutableOutputDefs()[1]}, {padded_output},
+                                            nullptr, kMSDomain);
+      restore_padding.SetExecutionProviderType(kCudaExecutionProvider);
+      graph.AddEdge(node->Index(), restore_padding.Index(), static_cast<int>(i), 0);
+      graph.AddEdge(offset_node->Index(), restore_padding.Index(), 1, 1);
+
+      for (const auto& consumer : consumers) {
+        graph.RemoveEdge(node->Index(), consumer.first, static_cast<int>(i), consumer.second);
+        graph.AddEdge(restore_padding.Index(), consumer.first, 0, consumer.second);
+      }
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+Status PackedSequenceTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                            const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  // group the Attention nodes of each encoder by their mask_index
+  InlinedVector<Encoder> encoders;
+  for (auto node_index : node_topology_list) {
+    auto* node = graph.GetNode(node_index);
+    if (node == nullptr) continue;
+
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedProvider(*node, GetCompatibleExecutionProviders()) || !IsEncoderAttention(*node)) {
+      continue;
+    }
+
+    NodeArg* mask = node->MutableInputDefs()[3];
+    const auto* input_shape = node->InputDefs()[0]->Shape();
+    auto encoder = std::find_if(encoders.begin(), encoders.end(), [mask](const Encoder& e) { return e.mask == mask; });
+    if (encoder == encoders.end()) {
+      encoders.push_back(Encoder{mask, *input_shape, {}});
+      encoder = encoders.end() - 1;
+    } else if (!SameDim(input_shape->dim(1), encoder->padded_shape.dim(1))) {
+      continue;
+    }
+
+    encoder->attention_outputs.insert(node->OutputDefs()[0]);
+  }
+
+  InlinedHashSet<NodeIndex> packed_node_indices;
+  for (const auto& encoder : encoders) {
+    if (PackEncoder(graph, graph_viewer, encoder, GetCompatibleExecutionProviders(), packed_node_indices)) {
+      LOGS(logger, VERBOSE) << "Packed " << encoder.attention_outputs.size()
+                            << " encoder layers using the sequence lengths in " << encoder.mask->Name();
+      modified = true;
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,29 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class PackedSequenceTransformer
+
+Run the token-wise nodes of a BERT encoder on packed tokens, i.e. without the right side padding of the sequences.
+
+The encoder is detected from Attention nodes that share a 1D mask_index with shape (batch_size), which holds the
+number of tokens of each sequence. The outputs of these Attention nodes are packed with RemovePadding, and the
+MatMul, Add, FastGelu, SkipLayerNormalization etc. nodes that follow them run on (total_tokens, hidden_size)
+tensors. RestorePadding is inserted in front of the consumers that need the padded layout, which includes the
+Attention nodes themselves, and in front of the graph outputs.
+*/
+class PackedSequenceTransformer : public GraphTransformer {
+ public:
+  PackedSequenceTransformer(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("PackedSequenceTransformer", compatible_execution_providers) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
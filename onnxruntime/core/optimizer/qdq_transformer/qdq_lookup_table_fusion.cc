@@ -0,0 +1,314 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/qdq_transformer/qdq_lookup_table_fusion.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "core/graph/graph_utils.h"
+#include "core/mlas/inc/mlas.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/qdq_transformer/qdq_util.h"
+#include "core/optimizer/utils.h"
+
+namespace onnxruntime {
+
+namespace {
+
+constexpr size_t kLookupTableSize = 256;
+
+float GetFloatAttributeOrDefault(const Node& node, const std::string& attr_name, float default_value) {
+  const auto* attr = graph_utils::GetNodeAttribute(node, attr_name);
+  return attr != nullptr ? attr->f() : default_value;
+}
+
+// Returns the value of a constant float scalar initializer, or false if `arg` is not one.
+// A single element tensor is accepted as long as it does not increase the rank of the other input.
+bool GetConstantFloatScalar(const Graph& graph, const NodeArg& arg, const NodeArg& other_arg, float& value) {
+  const ONNX_NAMESPACE::TensorProto* tensor_proto = graph_utils::GetConstantInitializer(graph, arg.Name());
+  if (tensor_proto == nullptr || tensor_proto->data_type() != ONNX_NAMESPACE::TensorProto_DataType_FLOAT) {
+    return false;
+  }
+
+  const auto* shape = arg.Shape();
+  const auto* other_shape = other_arg.Shape();
+  if (shape == nullptr || other_shape == nullptr || shape->dim_size() > other_shape->dim_size()) {
+    return false;
+  }
+
+  Initializer initializer(*tensor_proto, graph.ModelPath());
+  if (initializer.size() != 1) {
+    return false;
+  }
+
+  value = *initializer.data<float>();
+  return true;
+}
+
+// Applies `node` in place to the values of its input `chain_input`.
+// Returns false if the node is not an elementwise op with `chain_input` as its only variable input.
+bool ApplyElementwiseOp(const Graph& graph, const Node& node, const NodeArg& chain_input, gsl::span<float> values) {
+  const auto& op_type = node.OpType();
+  const auto& input_defs = node.InputDefs();
+
+  if (node.Domain() == kMSDomain) {
+    if (op_type == "Gelu" && node.SinceVersion() == 1) {
+      for (auto& x : values) {
+        x = 0.5f * x * (1.0f + std::erf(x * 0.70710678118654752440f));
+      }
+      return true;
+    }
+    return false;
+  }
+
+  if (node.Domain() != kOnnxDomain && node.Domain() != kOnnxDomainAlias) {
+    return false;
+  }
+
+  if (op_type == "Clip") {
+    float min, max;
+    if (!optimizer_utils::GetClipConstantMinMax(graph, node, min, max)) {
+      return false;
+    }
+    for (auto& x : values) {
+      x = std::min(std::max(x, min), max);
+    }
+    return true;
+  }
+
+  // Binary ops with a constant scalar on the other input.
+  if (input_defs.size() == 2) {
+    const bool chain_is_first = input_defs[0] == &chain_input;
+    const NodeArg& other = *input_defs[chain_is_first ? 1 : 0];
+    float c;
+    if (input_defs[0] == input_defs[1] || !GetConstantFloatScalar(graph, other, chain_input, c)) {
+      return false;
+    }
+
+    if (op_type == "Add") {
+      for (auto& x : values) x = x + c;
+    } else if (op_type == "Sub") {
+      for (auto& x : values) x = chain_is_first ? x - c : c - x;
+    } else if (op_type == "Mul") {
+      for (auto& x : values) x = x * c;
+    } else if (op_type == "Div") {
+      for (auto& x : values) x = chain_is_first ? x / c : c / x;
+    } else if (op_type == "Pow") {
+      for (auto& x : values) x = chain_is_first ? std::pow(x, c) : std::pow(c, x);
+    } else if (op_type == "Max") {
+      for (auto& x : values) x = std::max(x, c);
+    } else if (op_type == "Min") {
+      for (auto& x : values) x = std::min(x, c);
+    } else {
+      return false;
+    }
+    return true;
+  }
+
+  if (input_defs.size() != 1) {
+    return false;
+  }
+
+  if (op_type == "Relu") {
+    for (auto& x : values) x = std::max(x, 0.0f);
+  } else if (op_type == "LeakyRelu") {
+    const float alpha = GetFloatAttributeOrDefault(node, "alpha", 0.01f);
+    for (auto& x : values) x = x >= 0.0f ? x : alpha * x;
+  } else if (op_type == "Sigmoid") {
+    for (auto& x : values) x = 1.0f / (1.0f + std::exp(-x));
+  } else if (op_type == "Tanh") {
+    for (auto& x : values) x = std::tanh(x);
+  } else if (op_type == "Exp") {
+    for (auto& x : values) x = std::exp(x);
+  } else if (op_type == "Log") {
+    for (auto& x : values) x = std::log(x);
+  } else if (op_type == "Sqrt") {
+    for (auto& x : values) x = std::sqrt(x);
+  } else if (op_type == "Abs") {
+    for (auto& x : values) x = std::abs(x);
+  } else if (op_type == "Neg") {
+    for (auto& x : values) x = -x;
+  } else if (op_type == "Erf") {
+    for (auto& x : values) x = std::erf(x);
+  } else if (op_type == "Floor") {
+    for (auto& x : values) x = std::floor(x);
+  } else if (op_type == "Ceil") {
+    for (auto& x : values) x = std::ceil(x);
+  } else if (op_type == "Round") {
+    for (auto& x : values) x = std::nearbyint(x);
+  } else if (op_type == "Reciprocal") {
+    for (auto& x : values) x = 1.0f / x;
+  } else if (op_type == "Softplus") {
+    for (auto& x : values) x = std::log1p(std::exp(x));
+  } else if (op_type == "Softsign") {
+    for (auto& x : values) x = x / (1.0f + std::abs(x));
+  } else if (op_type == "Elu") {
+    const float alpha = GetFloatAttributeOrDefault(node, "alpha", 1.0f);
+    for (auto& x : values) x = x >= 0.0f ? x : alpha * (std::exp(x) - 1.0f);
+  } else if (op_type == "Selu") {
+    const float alpha = GetFloatAttributeOrDefault(node, "alpha", 1.67326319217681884765625f);
+    const float gamma = GetFloatAttributeOrDefault(node, "gamma", 1.05070102214813232421875f);
+    for (auto& x : values) x = gamma * (x > 0.0f ? x : alpha * (std::exp(x) - 1.0f));
+  } else if (op_type == "HardSigmoid") {
+    const float alpha = GetFloatAttributeOrDefault(node, "alpha", 0.2f);
+    const float beta = GetFloatAttributeOrDefault(node, "beta", 0.5f);
+    for (auto& x : values) x = std::max(0.0f, std::min(1.0f, alpha * x + beta));
+  } else if (op_type == "HardSwish") {
+    for (auto& x : values) x = x * std::max(0.0f, std::min(1.0f, x / 6.0f + 0.5f));
+  } else if (op_type == "Identity") {
+    // nothing to do
+  } else {
+    return false;
+  }
+  return true;
+}
+
+// Reads the constant scalar scale and zero point of a Q or DQ node. A missing zero point is a uint8 0.
+void GetScaleAndZeroPoint(const Graph& graph, const Node& node, float& scale, int32_t& zero_point, bool& is_signed) {
+  const auto& input_defs = node.InputDefs();
+  Initializer scale_initializer(*graph_utils::GetConstantInitializer(graph, input_defs[QDQ::InputIndex::SCALE_ID]->Name()),
+                                graph.ModelPath());
+  scale = *scale_initializer.data<float>();
+  zero_point = 0;
+  is_signed = false;
+
+  if (input_defs.size() > QDQ::InputIndex::ZERO_POINT_ID && input_defs[QDQ::InputIndex::ZERO_POINT_ID]->Exists()) {
+    Initializer zp_initializer(
+        *graph_utils::GetConstantInitializer(graph, input_defs[QDQ::InputIndex::ZERO_POINT_ID]->Name()),
+        graph.ModelPath());
+    is_signed = zp_initializer.data_type() == ONNX_NAMESPACE::TensorProto_DataType_INT8;
+    zero_point = is_signed ? static_cast<int32_t>(*zp_initializer.data<int8_t>())
+                           : static_cast<int32_t>(*zp_initializer.data<uint8_t>());
+  }
+}
+
+}  // namespace
+
+Status QDQLookupTableFusion::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                       const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  const auto get_const_initializer = [&graph](const std::string& initializer_name) {
+    return graph.GetConstantInitializer(initializer_name, true);
+  };
+
+  for (auto node_index : node_topology_list) {
+    auto* dq_node_ptr = graph.GetNode(node_index);
+    if (dq_node_ptr == nullptr)
+      continue;  // node removed as part of an earlier fusion
+
+    Node& dq_node = *dq_node_ptr;
+    ORT_RETURN_IF_ERROR(Recurse(dq_node, modified, graph_level, logger));
+
+    bool zero_point_exists = false;
+    if (!QDQ::MatchDQNode(dq_node) ||
+        !graph_utils::IsSupportedProvider(dq_node, GetCompatibleExecutionProviders()) ||
+        !optimizer_utils::CheckOutputEdges(graph, dq_node, 1) ||
+        !QDQ::QOrDQNodeHasConstantScalarScaleAndZeroPoint(dq_node, get_const_initializer, zero_point_exists)) {
+      continue;
+    }
+
+    // The 8 bit input type, DequantizeLinear also accepts int32.
+    const auto* dq_input_type = dq_node.InputDefs()[0]->TypeAsProto();
+    if (dq_input_type == nullptr ||
+        (dq_input_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_UINT8 &&
+         dq_input_type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_INT8)) {
+      continue;
+    }
+
+    float dq_scale;
+    int32_t dq_zero_point;
+    bool dq_is_signed;
+    GetScaleAndZeroPoint(graph, dq_node, dq_scale, dq_zero_point, dq_is_signed);
+
+    // Dequantize all the 8 bit inputs, indexed by their byte value.
+    std::array<float, kLookupTableSize> values;
+    for (size_t i = 0; i < kLookupTableSize; ++i) {
+      const int32_t q = dq_is_signed ? static_cast<int32_t>(static_cast<int8_t>(i)) : static_cast<int32_t>(i);
+      values[i] = static_cast<float>(q - dq_zero_point) * dq_scale;
+    }
+
+    // Follow the chain of single consumer elementwise ops up to a QuantizeLinear.
+    std::vector<std::reference_wrapper<Node>> nodes{dq_node};
+    const NodeArg* chain_output = dq_node.OutputDefs()[0];
+    Node* q_node = nullptr;
+    size_t num_ops = 0;
+    bool single_qlinear_op = false;
+    for (Node* node = graph.GetNode(dq_node.OutputNodesBegin()->Index());;) {
+      if (node->GetExecutionProviderType() != dq_node.GetExecutionProviderType()) {
+        break;
+      }
+
+      if (QDQ::MatchQNode(*node)) {
+        bool q_zero_point_exists = false;
+        if (node->InputDefs()[0] == chain_output &&
+            QDQ::QOrDQNodeHasConstantScalarScaleAndZeroPoint(*node, get_const_initializer, q_zero_point_exists)) {
+          q_node = node;
+        }
+        break;
+      }
+
+      if (node->OutputDefs().size() != 1 || graph.NodeProducesGraphOutput(*node) ||
+          !ApplyElementwiseOp(graph, *node, *chain_output, values)) {
+        break;
+      }
+
+      single_qlinear_op = num_ops == 0 &&
+                          (node->OpType() == "Sigmoid" || node->OpType() == "LeakyRelu" || node->OpType() == "Gelu");
+      ++num_ops;
+      nodes.push_back(*node);
+      chain_output = node->OutputDefs()[0];
+
+      if (!optimizer_utils::CheckOutputEdges(graph, *node, 1)) {
+        break;
+      }
+      node = graph.GetNode(node->OutputNodesBegin()->Index());
+    }
+
+    // A single op with a QLinear kernel is handled by the QDQ selectors.
+    if (q_node == nullptr || num_ops == 0 || (num_ops == 1 && single_qlinear_op)) {
+      continue;
+    }
+    nodes.push_back(*q_node);
+
+    float q_scale;
+    int32_t q_zero_point;
+    bool q_is_signed;
+    GetScaleAndZeroPoint(graph, *q_node, q_scale, q_zero_point, q_is_signed);
+
+    ONNX_NAMESPACE::TensorProto table_proto;
+    table_proto.set_name(graph.GenerateNodeArgName(q_node->Name() + "_lookup_table"));
+    table_proto.add_dims(static_cast<int64_t>(kLookupTableSize));
+    if (q_is_signed) {
+      std::array<int8_t, kLookupTableSize> table;
+      MlasQuantizeLinear(values.data(), table.data(), kLookupTableSize, q_scale, static_cast<int8_t>(q_zero_point));
+      table_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_INT8);
+      table_proto.set_raw_data(table.data(), table.size());
+    } else {
+      std::array<uint8_t, kLookupTableSize> table;
+      MlasQuantizeLinear(values.data(), table.data(), kLookupTableSize, q_scale, static_cast<uint8_t>(q_zero_point));
+      table_proto.set_data_type(ONNX_NAMESPACE::TensorProto_DataType_UINT8);
+      table_proto.set_raw_data(table.data(), table.size());
+    }
+    NodeArg& table_arg = graph_utils::AddInitializer(graph, table_proto);
+
+    Node& lookup_table_node = graph.AddNode(graph.GenerateNodeName(q_node->Name() + "_QLinearLookupTable"),
+                                            "QLinearLookupTable",
+                                            "Lookup table fusion of a DQ -> elementwise ops -> Q chain",
+                                            {dq_node.MutableInputDefs()[0], &table_arg},
+                                            {q_node->MutableOutputDefs()[0]},
+                                            nullptr,
+                                            kMSDomain);
+    lookup_table_node.SetExecutionProviderType(dq_node.GetExecutionProviderType());
+
+    graph_utils::FinalizeNodeFusion(graph, nodes, lookup_table_node);
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,32 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+    @Class QDQLookupTableFusion
+
+    Fuse a chain of elementwise float ops with a single variable input, between a DequantizeLinear and
+    a QuantizeLinear with constant scalar scales and zero points, into a com.microsoft QLinearLookupTable node.
+    The 256 entry table is computed by running the chain on the dequantized values of all the 8 bit inputs.
+
+    DQ -> op_1 -> ... -> op_n -> Q  =>  QLinearLookupTable(X, table)
+
+    A single Sigmoid, LeakyRelu or Gelu is left to the QDQ selectors that replace it with its QLinear op.
+*/
+class QDQLookupTableFusion : public GraphTransformer {
+ public:
+  QDQLookupTableFusion(const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("QDQLookupTableFusion", compatible_execution_providers) {
+  }
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -72,6 +72,40 @@ std::vector<NodeAndMoveInfo> ConvMoves() {
 
   return moves;
 }
+// moves for replacing LayerNormalization with a DQ input and float scale and bias with the qlinear version
+std::vector<NodeAndMoveInfo> LayerNormMoves() {
+  NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+
+  std::vector<NodeAndMoveInfo> moves = UnaryMoves();
+  moves.insert(moves.end() - 1, MoveAndAppend(target, ArgType::kInput, 1, ArgType::kInput));  // append scale
+  moves.insert(moves.end() - 1, MoveAndAppend(target, ArgType::kInput, 2, ArgType::kInput));  // append bias
+
+  return moves;
+}
+
+// moves for replacing Attention with DQ input and weights with QAttention
+std::vector<NodeAndMoveInfo> AttentionMoves(bool has_mask) {
+  NTO::NodeLocation dq_input{NTO::NodeType::kInput, 0};
+  NTO::NodeLocation dq_weight{NTO::NodeType::kInput, 1};
+  // the selector leaves this entry empty so it can be used to append an empty mask_index
+  NTO::NodeLocation no_mask{NTO::NodeType::kInput, 2};
+  NTO::NodeLocation target{NTO::NodeType::kTarget, 0};
+
+  std::vector<NodeAndMoveInfo> moves{
+      MoveAndAppend(dq_input, ArgType::kInput, 0, ArgType::kInput),   // input
+      MoveAndAppend(dq_weight, ArgType::kInput, 0, ArgType::kInput),  // weight
+      MoveAndAppend(target, ArgType::kInput, 2, ArgType::kInput),     // bias
+      MoveAndAppend(dq_input, ArgType::kInput, 1, ArgType::kInput),   // input_scale
+      MoveAndAppend(dq_weight, ArgType::kInput, 1, ArgType::kInput),  // weight_scale
+      has_mask ? MoveAndAppend(target, ArgType::kInput, 3, ArgType::kInput)
+               : MoveAndAppend(no_mask, ArgType::kInput, 0, ArgType::kInput, true, true),  // mask_index
+      MoveAndAppend(dq_input, ArgType::kInput, 2, ArgType::kInput),                       // input_zero_point
+      MoveAndAppend(dq_weight, ArgType::kInput, 2, ArgType::kInput),                      // weight_zero_point
+      MoveAll(target, ArgType::kOutput)};
+
+  return moves;
+}
+
 std::vector<NodeAndMoveInfo> WhereMoves(){
   NTO::NodeLocation dq_x{NTO::NodeType::kInput, 0};
   NTO::NodeLocation dq_y{NTO::NodeType::kInput, 1};
@@ -239,6 +273,10 @@ VariadicReplaceWithQLinear::VariadicReplaceWithQLinear(std::string domain)
 ConvReplaceWithQLinear::ConvReplaceWithQLinear()
     : ReplaceWithQLinear(kOnnxDomain, ConvMoves()) {
 }
+LayerNormReplaceWithQLinear::LayerNormReplaceWithQLinear()
+    : ReplaceWithQLinear(kMSDomain, LayerNormMoves()) {
+}
+
 WhereReplaceWithQLinear::WhereReplaceWithQLinear()
     : ReplaceWithQLinear(kMSDomain, WhereMoves()) {
 }
@@ -262,6 +300,31 @@ Status MatMulReplaceWithQLinear::Run(Graph& graph, const NodesToOptimize& select
   }
 }
 
+AttentionReplaceWithQuant::AttentionReplaceWithQuant()
+    : qattention_with_mask_replacer_(kMSDomain, "QAttention", AttentionMoves(true)),
+      qattention_without_mask_replacer_(kMSDomain, "QAttention", AttentionMoves(false)) {
+}
+
+const QDQReplaceWithNew& AttentionReplaceWithQuant::Replacer(const NodesToOptimize& selected_nodes) const {
+  const auto& input_defs = selected_nodes.Target().InputDefs();
+  const bool has_mask = input_defs.size() > 3 && input_defs[3]->Exists();
+  return has_mask ? qattention_with_mask_replacer_ : qattention_without_mask_replacer_;
+}
+
+Status AttentionReplaceWithQuant::Run(Graph& graph, const NodesToOptimize& selected_nodes) const {
+  return Replacer(selected_nodes).Run(graph, selected_nodes);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+Status AttentionReplaceWithQuant::RunForSave(Graph& graph,
+                                             const NodesToOptimize& selected_nodes,
+                                             const SatRuntimeOptimizationSaveContext& save_context,
+                                             SavedState& saved_state,
+                                             bool& graph_modified) const {
+  return Replacer(selected_nodes).RunForSave(graph, selected_nodes, save_context, saved_state, graph_modified);
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 static std::vector<NodeAndMoveInfo> GetGemmMoveInfo(bool does_q_node_exist) {
   NTO::NodeLocation dq_A{NTO::NodeType::kInput, 0};
   NTO::NodeLocation dq_B{NTO::NodeType::kInput, 1};
@@ -59,6 +59,11 @@ struct VariadicReplaceWithQLinear : ReplaceWithQLinear {
 struct ConvReplaceWithQLinear : ReplaceWithQLinear {
   ConvReplaceWithQLinear();
 };
+
+struct LayerNormReplaceWithQLinear : ReplaceWithQLinear {
+  LayerNormReplaceWithQLinear();
+};
+
 struct WhereReplaceWithQLinear : ReplaceWithQLinear {
   WhereReplaceWithQLinear();
 };
@@ -76,6 +81,25 @@ struct MatMulReplaceWithQLinear : public Action {
   BinaryReplaceWithQLinear qlinear_matmul_replacer_;
 };
 
+// replace Attention with QAttention, which has float output
+struct AttentionReplaceWithQuant : public Action {
+  AttentionReplaceWithQuant();
+
+  Status Run(Graph&, const NodesToOptimize& selected_nodes) const override;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  Status RunForSave(Graph& /*graph*/, const NodesToOptimize& /*selected_nodes*/,
+                    const SatRuntimeOptimizationSaveContext& /*save_context*/,
+                    SavedState& /*saved_state*/, bool& /*graph_modified*/) const override;
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
+ private:
+  const QDQReplaceWithNew& Replacer(const NodesToOptimize& selected_nodes) const;
+
+  QDQReplaceWithNew qattention_with_mask_replacer_;
+  QDQReplaceWithNew qattention_without_mask_replacer_;
+};
+
 struct GemmReplaceWithQuant : public Action {
   GemmReplaceWithQuant();
 
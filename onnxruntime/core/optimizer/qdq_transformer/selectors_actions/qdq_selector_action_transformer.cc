@@ -97,7 +97,9 @@ void UnaryOpQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
                                                           {"LeakyRelu", {}},
                                                           {"GlobalAveragePool", {}},
                                                           {"Sigmoid", {}},
-                                                          {"Softmax", {}}},
+                                                          {"Softmax", {}},
+                                                          // com.microsoft Gelu
+                                                          {"Gelu", {1}}},
                                                          std::move(selector),
                                                          std::move(action));
 #else
@@ -206,6 +208,44 @@ void GemmQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
 #endif
 }
 
+void LayerNormQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. DQ for X, LayerNormalization with float scale and bias, Q
+  // Replace with QLinearLayerNormalization
+  // Delete all original nodes.
+  const std::string action_name{"LayerNormalization"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::LayerNormReplaceWithQLinear>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::LayerNormSelector>();
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"LayerNormalization", {}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
+void AttentionQDQRules(SelectorActionRegistry& qdq_selector_action_registry) {
+  // 3 nodes. DQ for input, DQ for weights, com.microsoft Attention with float bias and output
+  // Replace with QAttention
+  // Delete all original nodes.
+  const std::string action_name{"Attention"};
+  std::unique_ptr<Action> action = std::make_unique<QDQ::AttentionReplaceWithQuant>();
+
+#if !defined(ORT_MINIMAL_BUILD)
+  std::unique_ptr<NodeSelector> selector = std::make_unique<QDQ::AttentionSelector>();
+  qdq_selector_action_registry.RegisterSelectorAndAction(action_name,
+                                                         {{"Attention", {1}}},
+                                                         std::move(selector),
+                                                         std::move(action));
+
+#else
+  qdq_selector_action_registry.RegisterAction(action_name, std::move(action));
+#endif
+}
+
 void WhereQDQRules (SelectorActionRegistry& qdq_selector_action_registry) {
   // 3 nodes.  2 x DQ for inputs and 1X Q for output
   // Compare to other BinaryOperators (Add, Mul), Where also have a special case that it has boolean input
@@ -238,6 +278,8 @@ SelectorActionRegistry CreateSelectorActionRegistry(bool is_int8_allowed) {
   MatMulQDQRules(qdq_selector_action_registry, is_int8_allowed);
   GemmQDQRules(qdq_selector_action_registry);
   WhereQDQRules(qdq_selector_action_registry);
+  LayerNormQDQRules(qdq_selector_action_registry);
+  AttentionQDQRules(qdq_selector_action_registry);
 
   return qdq_selector_action_registry;
 }
@@ -309,6 +309,85 @@ void GemmSelector::UpdateBuilder(NodesToOptimizeIndicesBuilder& builder) const {
   builder.input_nodes.resize(3, NodesToOptimizeIndices::kEmptyNodeIndex);
 }
 
+bool LayerNormNodeGroupSelector::Check(const GraphViewer& graph_viewer,
+                                       const Node& node,
+                                       const std::vector<const Node*>& dq_nodes,
+                                       const std::vector<const Node*>& q_nodes) const {
+  // only X is quantized. QLinearLayerNormalization requires the bias so it must exist
+  const auto& input_defs = node.InputDefs();
+  if (input_defs.size() < 3 || !input_defs[2]->Exists() ||
+      !CheckQDQNodes(graph_viewer, node, dq_nodes, q_nodes, 1)) {
+    return false;
+  }
+
+  if (dq_nodes[0]->OutputDefs()[0] != input_defs[0]) {
+    return false;
+  }
+
+  int32_t dt_input = dq_nodes[0]->InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  int32_t dt_output = q_nodes[0]->OutputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  return dt_input == dt_output;
+}
+
+bool AttentionNodeGroupSelector::Check(const GraphViewer& graph_viewer,
+                                       const Node& node,
+                                       const std::vector<const Node*>& dq_nodes,
+                                       const std::vector<const Node*>& q_nodes) const {
+  ORT_UNUSED_PARAMETER(q_nodes);
+  if (!CheckQDQNodes(graph_viewer, node, dq_nodes, {}, 2, true /*is_empty_q_nodes_allowed*/)) {
+    return false;
+  }
+
+  // QAttention has the input, weights, bias and mask_index of Attention, and only its num_heads and unidirectional
+  // attributes
+  const auto& input_defs = node.InputDefs();
+  for (size_t i = 4; i < input_defs.size(); ++i) {
+    if (input_defs[i]->Exists()) {
+      return false;
+    }
+  }
+
+  if (NumActualValues(node, false) != 1) {
+    return false;
+  }
+
+  for (const auto& [name, attr] : node.GetAttributes()) {
+    ORT_UNUSED_PARAMETER(attr);
+    if (name != "num_heads" && name != "unidirectional") {
+      return false;
+    }
+  }
+
+  const Node& dq_input = *dq_nodes[0];
+  const Node& dq_weight = *dq_nodes[1];
+  if (dq_input.OutputDefs()[0] != input_defs[0] || dq_weight.OutputDefs()[0] != input_defs[1]) {
+    return false;
+  }
+
+  // the CPU kernel takes uint8 inputs, a per-tensor input scale and per-tensor or per-column weight scales
+  int32_t dt_input = dq_input.InputDefs()[0]->TypeAsProto()->tensor_type().elem_type();
+  if (dt_input != ONNX_NAMESPACE::TensorProto_DataType::TensorProto_DataType_UINT8 ||
+      !optimizer_utils::IsScalar(*dq_input.InputDefs()[1])) {
+    return false;
+  }
+
+  if (optimizer_utils::IsScalar(*dq_weight.InputDefs()[1])) {
+    return true;
+  }
+
+  const auto& attrs = dq_weight.GetAttributes();
+  const auto axis_attr = attrs.find("axis");
+  const int64_t axis = axis_attr != attrs.end() ? axis_attr->second.i() : 1;
+  return axis == 1 || axis == -1;
+}
+
+void AttentionSelector::UpdateBuilder(NodesToOptimizeIndicesBuilder& builder) const {
+  // QAttention produces float so the Q nodes consuming the output are not part of the selection.
+  // The empty third entry provides an empty mask_index for Attention nodes without one.
+  builder.input_nodes.resize(3, NodesToOptimizeIndices::kEmptyNodeIndex);
+  builder.output_nodes.clear();
+}
+
 bool WhereNodeGroupSelector::Check(const GraphViewer &graph_viewer, const Node &node,
                                    const std::vector<const Node *> &dq_nodes,
                                    const std::vector<const Node *> &q_nodes) const {
@@ -141,6 +141,22 @@ class GemmNodeGroupSelector : public NodeGroupSelector {
              const std::vector<const Node*>& q_nodes) const override;
 };
 
+// DQ node for X -> LayerNormalization with float scale and bias -> Q
+// The optional Mean and InvStdDev outputs must not be used.
+class LayerNormNodeGroupSelector : public NodeGroupSelector {
+  bool Check(const GraphViewer& graph_viewer, const Node& node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
+// DQ nodes for the input and the weights -> Attention with float output
+// Any Q nodes consuming the output are left in place as QAttention produces float.
+class AttentionNodeGroupSelector : public NodeGroupSelector {
+  bool Check(const GraphViewer& graph_viewer, const Node& node,
+             const std::vector<const Node*>& dq_nodes,
+             const std::vector<const Node*>& q_nodes) const override;
+};
+
 /*
  * NodeSelector instances for use in the QDQ::SelectorActionTransformer.
  */
@@ -222,6 +238,19 @@ class MatMulSelector : public BaseSelector {
       : BaseSelector(std::make_unique<MatMulNodeGroupSelector>(int8_allowed, /*matmulintegertofloat_allowed*/ true)) {}
 };
 
+class LayerNormSelector : public BaseSelector {
+ public:
+  LayerNormSelector() : BaseSelector(std::make_unique<LayerNormNodeGroupSelector>()) {}
+};
+
+// DQ nodes for the input and the weights -> Attention
+class AttentionSelector : public BaseSelector {
+ public:
+  AttentionSelector() : BaseSelector(std::make_unique<AttentionNodeGroupSelector>()) {}
+
+  void UpdateBuilder(NodesToOptimizeIndicesBuilder&) const override;
+};
+
 // Input: DQ nodes for A, B and optional C
 // Output: optional Q node for Y
 class GemmSelector : public BaseSelector {
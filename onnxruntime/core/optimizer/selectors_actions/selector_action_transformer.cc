@@ -93,9 +93,9 @@ static Status MatchAndProcess(
   Status status = Status::OK();
 
   do {
-    // TODO: for now this just needs to support ONNX ops. If we ever had a transformer that was going to
-    // target non-ONNX ops we'd need to rework a few things to include the op domain in the matches
-    if (node.Domain() != kOnnxDomain) {
+    // The matches only use the op type, so the registered ops must not have the same op type in the ONNX and the
+    // Microsoft domains. Match it in the selector if that ever changes.
+    if (node.Domain() != kOnnxDomain && node.Domain() != kMSDomain) {
       break;
     }
 
@@ -0,0 +1,269 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/tensor_parallel_transformer.h"
+
+#include "core/graph/graph_utils.h"
+#include "core/optimizer/initializer.h"
+#include "core/optimizer/utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+namespace {
+
+// The shard of an initializer input of a node, which replaces the input once the whole pattern is matched.
+struct Shard {
+  Node* node;
+  int input_index;
+  TensorProto tensor;
+};
+
+// Computes the shard of rank of a constant initializer with num_dims dims, partitioned along axis.
+// The axis is first split into stride blocks, and each block is partitioned separately, e.g. the Q, K and V blocks
+// of the Attention weights. Returns false if the initializer is not supported or its axis cannot be split evenly.
+bool PartitionInitializer(Graph& graph, Node& node, int input_index, int num_dims, int axis, int64_t stride,
+                          int rank, int size, InlinedVector<Shard>& shards) {
+  const auto& inputs = node.InputDefs();
+  if (static_cast<size_t>(input_index) >= inputs.size() || !inputs[input_index]->Exists()) {
+    return false;
+  }
+
+  const NodeArg& arg = *inputs[input_index];
+  const TensorProto* tensor = graph_utils::GetConstantInitializer(graph, arg.Name());
+  if (tensor == nullptr || tensor->dims_size() != num_dims ||
+      (tensor->data_type() != TensorProto_DataType_FLOAT &&
+       tensor->data_type() != TensorProto_DataType_FLOAT16 &&
+       tensor->data_type() != TensorProto_DataType_BFLOAT16)) {
+    return false;
+  }
+
+  const int64_t dim = tensor->dims(axis);
+  if (dim <= 0 || dim % (stride * size) != 0) {
+    return false;
+  }
+
+  Initializer initializer(*tensor, graph.ModelPath());
+  const auto bytes = initializer.DataAsByteSpan();
+  int64_t outer = 1;
+  for (int i = 0; i < axis; ++i) {
+    outer *= tensor->dims(i);
+  }
+  if (outer == 0) {
+    return false;
+  }
+
+  // the bytes of one index of axis, and the indices of axis that each rank keeps out of each block
+  const size_t slice_bytes = bytes.size() / static_cast<size_t>(outer * dim);
+  const int64_t block = dim / stride;
+  const int64_t shard_dim = block / size;
+
+  std::string data;
+  data.reserve(bytes.size() / size);
+  const char* src = reinterpret_cast<const char*>(bytes.data());
+  for (int64_t o = 0; o < outer; ++o) {
+    for (int64_t s = 0; s < stride; ++s) {
+      const int64_t begin = o * dim + s * block + rank * shard_dim;
+      data.append(src + begin * slice_bytes, shard_dim * slice_bytes);
+    }
+  }
+
+  Shard shard{&node, input_index, {}};
+  shard.tensor.set_name(graph.GenerateNodeArgName(arg.Name() + "_rank" + std::to_string(rank)));
+  shard.tensor.set_data_type(tensor->data_type());
+  for (int i = 0; i < num_dims; ++i) {
+    shard.tensor.add_dims(i == axis ? dim / size : tensor->dims(i));
+  }
+  shard.tensor.set_raw_data(std::move(data));
+  shards.push_back(std::move(shard));
+  return true;
+}
+
+// Returns the only consumer of the first output of node, if it consumes it as the given input.
+Node* GetOnlyConsumer(Graph& graph, const Node& node, int input_index) {
+  if (!optimizer_utils::CheckOutputEdges(graph, node, 1)) {
+    return nullptr;
+  }
+
+  const auto& edge = *node.OutputEdgesBegin();
+  if (edge.GetSrcArgIndex() != 0 || edge.GetDstArgIndex() != input_index) {
+    return nullptr;
+  }
+  return graph.GetNode(edge.GetNode().Index());
+}
+
+bool IsMatMul(const Node& node, const InlinedHashSet<std::string_view>& compatible_providers) {
+  return graph_utils::IsSupportedOptypeVersionAndDomain(node, "MatMul", {1, 9, 13}) &&
+         graph_utils::IsSupportedProvider(node, compatible_providers);
+}
+
+// Matches MatMul -> [Add] -> activation -> MatMul starting from the first MatMul, and computes the shards of its
+// weights. Returns the second MatMul, or nullptr if the pattern is not matched.
+Node* MatchMlp(Graph& graph, Node& matmul, const InlinedHashSet<std::string_view>& compatible_providers,
+               int rank, int size, InlinedVector<Shard>& shards, InlinedVector<Node*>& column_partitioned_nodes) {
+  if (!IsMatMul(matmul, compatible_providers) ||
+      !PartitionInitializer(graph, matmul, 1, 2, 1, 1, rank, size, shards)) {
+    return nullptr;
+  }
+  column_partitioned_nodes.push_back(&matmul);
+
+  Node* node = &matmul;
+  if (optimizer_utils::CheckOutputEdges(graph, *node, 1)) {
+    const auto& edge = *node->OutputEdgesBegin();
+    Node* add = graph.GetNode(edge.GetNode().Index());
+    if (graph_utils::IsSupportedOptypeVersionAndDomain(*add, "Add", {7, 13, 14}) &&
+        graph_utils::IsSupportedProvider(*add, compatible_providers)) {
+      if (!PartitionInitializer(graph, *add, 1 - edge.GetDstArgIndex(), 1, 0, 1, rank, size, shards)) {
+        return nullptr;
+      }
+      column_partitioned_nodes.push_back(add);
+      node = add;
+    }
+  }
+
+  Node* activation = GetOnlyConsumer(graph, *node, 0);
+  if (activation == nullptr || !graph_utils::IsSupportedProvider(*activation, compatible_providers)) {
+    return nullptr;
+  }
+  if (graph_utils::IsSupportedOptypeVersionAndDomain(*activation, "FastGelu", {1}, kMSDomain) ||
+      graph_utils::IsSupportedOptypeVersionAndDomain(*activation, "BiasGelu", {1}, kMSDomain)) {
+    if (activation->InputDefs().size() > 1 && activation->InputDefs()[1]->Exists() &&
+        !PartitionInitializer(graph, *activation, 1, 1, 0, 1, rank, size, shards)) {
+      return nullptr;
+    }
+  } else if (!graph_utils::IsSupportedOptypeVersionAndDomain(*activation, "Gelu", {1}, kMSDomain) &&
+             !graph_utils::IsSupportedOptypeVersionAndDomain(*activation, "Relu", {6, 13, 14})) {
+    return nullptr;
+  }
+  column_partitioned_nodes.push_back(activation);
+
+  Node* output_matmul = GetOnlyConsumer(graph, *activation, 0);
+  if (output_matmul == nullptr || !IsMatMul(*output_matmul, compatible_providers) ||
+      !PartitionInitializer(graph, *output_matmul, 1, 2, 0, 1, rank, size, shards)) {
+    return nullptr;
+  }
+  return output_matmul;
+}
+
+// Matches Attention -> MatMul starting from the Attention node, and computes the shards of the weights.
+// Returns the MatMul, or nullptr if the pattern is not matched.
+Node* MatchAttention(Graph& graph, Node& attention, const InlinedHashSet<std::string_view>& compatible_providers,
+                     int rank, int size, InlinedVector<Shard>& shards, InlinedVector<Node*>& column_partitioned_nodes) {
+  if (!graph_utils::IsSupportedOptypeVersionAndDomain(attention, "Attention", {1}, kMSDomain) ||
+      !graph_utils::IsSupportedProvider(attention, compatible_providers)) {
+    return nullptr;
+  }
+
+  // the past state and the extra add of the heads would need to be partitioned too
+  const auto& inputs = attention.InputDefs();
+  for (size_t i = 4; i < inputs.size(); ++i) {
+    if (inputs[i]->Exists()) {
+      return nullptr;
+    }
+  }
+  if (graph_utils::IsOutputUsed(attention, 1) ||
+      graph_utils::GetNodeAttribute(attention, "qkv_hidden_sizes") != nullptr) {
+    return nullptr;
+  }
+
+  const auto* num_heads = graph_utils::GetNodeAttribute(attention, "num_heads");
+  if (num_heads == nullptr || num_heads->i() % size != 0 ||
+      !PartitionInitializer(graph, attention, 1, 2, 1, 3, rank, size, shards) ||
+      !PartitionInitializer(graph, attention, 2, 1, 0, 3, rank, size, shards)) {
+    return nullptr;
+  }
+  column_partitioned_nodes.push_back(&attention);
+
+  Node* output_matmul = GetOnlyConsumer(graph, attention, 0);
+  if (output_matmul == nullptr || !IsMatMul(*output_matmul, compatible_providers) ||
+      !PartitionInitializer(graph, *output_matmul, 1, 2, 0, 1, rank, size, shards)) {
+    return nullptr;
+  }
+  return output_matmul;
+}
+
+// Sums the partial output of the row partitioned MatMul over the ranks with an AllReduce node.
+void InsertAllReduce(Graph& graph, Node& matmul) {
+  NodeArg* output = matmul.MutableOutputDefs()[0];
+  NodeArg& partial = graph_utils::CreateNodeArg(graph, *output);
+  auto output_edges = graph_utils::GraphEdge::GetNodeOutputEdges(matmul, 0);
+  graph_utils::GraphEdge::RemoveGraphEdges(graph, output_edges);
+  matmul.MutableOutputDefs()[0] = &partial;
+
+  Node& all_reduce = graph.AddNode(graph.GenerateNodeName("AllReduce"), "AllReduce",
+                                   "Sum of the partial " + output->Name() + " of the ranks", {&partial}, {output},
+                                   nullptr, kMSDomain);
+  all_reduce.SetExecutionProviderType(matmul.GetExecutionProviderType());
+  graph.AddEdge(matmul.Index(), all_reduce.Index(), 0, 0);
+  for (const auto& edge : output_edges) {
+    graph.AddEdge(all_reduce.Index(), edge.dst_node, 0, edge.dst_arg_index);
+  }
+}
+
+}  // namespace
+
+Status TensorParallelTransformer::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                            const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  InlinedHashSet<NodeIndex> sharded_nodes;
+  int sharded_mlp_count = 0;
+  int sharded_attention_count = 0;
+  for (auto node_index : node_topology_list) {
+    auto* node = graph.GetNode(node_index);
+    if (node == nullptr) continue;
+
+    ORT_RETURN_IF_ERROR(Recurse(*node, modified, graph_level, logger));
+
+    if (sharded_nodes.count(node_index) > 0) {
+      continue;
+    }
+
+    InlinedVector<Shard> shards;
+    InlinedVector<Node*> column_partitioned_nodes;
+    const bool is_attention = node->OpType() == "Attention";
+    Node* output_matmul = is_attention
+                              ? MatchAttention(graph, *node, GetCompatibleExecutionProviders(), rank_, size_, shards,
+                                               column_partitioned_nodes)
+                              : MatchMlp(graph, *node, GetCompatibleExecutionProviders(), rank_, size_, shards,
+                                         column_partitioned_nodes);
+    if (output_matmul == nullptr || sharded_nodes.count(output_matmul->Index()) > 0) {
+      continue;
+    }
+
+    for (auto& shard : shards) {
+      NodeArg& arg = graph_utils::AddInitializer(graph, shard.tensor);
+      graph_utils::ReplaceNodeInput(*shard.node, shard.input_index, arg);
+    }
+
+    // the last dim of the outputs is partitioned. their shapes are inferred again by Graph::Resolve
+    for (Node* column_partitioned_node : column_partitioned_nodes) {
+      column_partitioned_node->MutableOutputDefs()[0]->ClearShape();
+      sharded_nodes.insert(column_partitioned_node->Index());
+    }
+
+    if (is_attention) {
+      const int64_t num_heads = graph_utils::GetNodeAttribute(*node, "num_heads")->i();
+      node->AddAttribute("num_heads", num_heads / size_);
+      ++sharded_attention_count;
+    } else {
+      ++sharded_mlp_count;
+    }
+
+    InsertAllReduce(graph, *output_matmul);
+    sharded_nodes.insert(output_matmul->Index());
+    modified = true;
+  }
+
+  if (sharded_mlp_count > 0 || sharded_attention_count > 0) {
+    LOGS(logger, VERBOSE) << "Sharded " << sharded_attention_count << " Attention and " << sharded_mlp_count
+                          << " MLP blocks for rank " << rank_ << " of " << size_;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
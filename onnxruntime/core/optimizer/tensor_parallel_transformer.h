@@ -0,0 +1,36 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class TensorParallelTransformer
+
+Shard the transformer layers of a model for tensor parallel inference, in the way of Megatron-LM.
+
+Every rank of the tensor parallel group runs its own session of the model on its own GPU. This transformer keeps the
+part of the weights of the given rank:
+  - MLP: MatMul -> [Add] -> Gelu/FastGelu/BiasGelu/Relu -> MatMul. The first weight and the biases are partitioned
+    by column and the second weight by row.
+  - Self attention: Attention -> MatMul. The heads of the Attention node are partitioned, i.e. the columns of the
+    Q, K and V blocks of its weights and bias, and the MatMul weight is partitioned by row.
+The partial results of the row partitioned MatMul nodes are summed over the ranks by an AllReduce node.
+*/
+class TensorParallelTransformer : public GraphTransformer {
+ public:
+  TensorParallelTransformer(int rank, int size,
+                            const InlinedHashSet<std::string_view>& compatible_execution_providers = {}) noexcept
+      : GraphTransformer("TensorParallelTransformer", compatible_execution_providers), rank_(rank), size_(size) {}
+
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+
+ private:
+  const int rank_;
+  const int size_;
+};
+
+}  // namespace onnxruntime
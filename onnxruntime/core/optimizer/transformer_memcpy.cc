@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "transformer_memcpy.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/kernel_registry_manager.h"
 #include "core/framework/execution_providers.h"
 #include "core/framework/utils.h"
@@ -22,6 +23,8 @@ class TransformerMemcpyImpl {
   void ProcessDefs(onnxruntime::Node& node, const KernelRegistryManager& kernel_registries, InitializedTensorSet& initializers_consumed);
   void BuildDefsMapping(const onnxruntime::NodeArg* arg, const KernelRegistryManager& kernel_registries);
   void AddCopyNode(onnxruntime::NodeArg* arg, bool is_input);
+  void AddCopyNode(gsl::span<onnxruntime::NodeArg* const> args, bool is_input);
+  void AddCopyNodes(gsl::span<onnxruntime::NodeArg* const> args, bool is_input);
   bool ProcessInitializers(const KernelRegistryManager& kernel_registries, const InitializedTensorSet& initializers_consumed);
 
  private:
@@ -133,26 +136,36 @@ bool TransformerMemcpyImpl::ModifyGraph(const KernelRegistryManager& kernel_regi
   for (auto arg : non_provider_output_defs_)
     BuildDefsMapping(arg, kernel_registries);
 
+  // collect the copies first, so that the copies crossing the same boundary can share a node
+  InlinedVector<onnxruntime::NodeArg*> graph_input_copies;
+  InlinedVector<onnxruntime::NodeArg*> from_host_copies;
+  InlinedVector<onnxruntime::NodeArg*> to_host_copies;
+
   for (auto arg : graph_.GetInputs())
     // For inputs we need to create a copy node only when the input is connected to both provider
     // and non-provider nodes. Otherwise utils::CopyInputsAcrossDevices() will do the job.
     if (provider_input_defs_.count(arg) && non_provider_input_defs_.count(arg)) {
-      AddCopyNode(const_cast<onnxruntime::NodeArg*>(arg), true);
-      modified = true;
+      graph_input_copies.push_back(const_cast<onnxruntime::NodeArg*>(arg));
     }
 
   for (auto arg : non_provider_output_defs_)
     if (provider_input_defs_.count(arg)) {
-      AddCopyNode(arg, true);
-      modified = true;
+      from_host_copies.push_back(arg);
     }
 
   for (auto arg : provider_output_defs_)
     if (non_provider_input_defs_.count(arg)) {
-      AddCopyNode(arg, false);
-      modified = true;
+      to_host_copies.push_back(arg);
     }
 
+  // the graph inputs are available before any node runs, so they are only batched together
+  AddCopyNodes(graph_input_copies, true);
+  AddCopyNodes(from_host_copies, true);
+  AddCopyNodes(to_host_copies, false);
+  if (!graph_input_copies.empty() || !from_host_copies.empty() || !to_host_copies.empty()) {
+    modified = true;
+  }
+
   // Process implicit inputs in subgraphs that is explicitly consumed
   // on both provider and non-provider nodes. This is mimicking
   // logic for explicit graph inputs.
@@ -270,7 +283,8 @@ void TransformerMemcpyImpl::ProcessDefs(onnxruntime::Node& node, const KernelReg
 //for non_provider defs, collect the nodes that expect it is provider tensor as input/output.
 void TransformerMemcpyImpl::BuildDefsMapping(const onnxruntime::NodeArg* arg, const KernelRegistryManager& kernel_registries) {
   for (auto& it : graph_.Nodes()) {
-    if (it.OpType() == "MemcpyFromHost" || it.OpType() == "MemcpyToHost") continue;
+    if (it.OpType() == "MemcpyFromHost" || it.OpType() == "MemcpyToHost" ||
+        it.OpType() == "MemcpyFromHostBatch" || it.OpType() == "MemcpyToHostBatch") continue;
     auto input_it =
         std::find(it.MutableInputDefs().begin(), it.MutableInputDefs().end(), const_cast<onnxruntime::NodeArg*>(arg));
     auto output_it =
@@ -298,31 +312,109 @@ void TransformerMemcpyImpl::BuildDefsMapping(const onnxruntime::NodeArg* arg, co
 }
 
 void TransformerMemcpyImpl::AddCopyNode(onnxruntime::NodeArg* arg, bool is_input) {
-  // create unique name for new def
-  std::string new_def_name = graph_.GenerateNodeArgName(arg->Name() + "_" + provider_);
+  AddCopyNode(gsl::make_span(&arg, 1), is_input);
+}
 
-  auto* new_arg = &graph_.GetOrCreateNodeArg(new_def_name, arg->TypeAsProto());
-  auto* src_arg = is_input ? arg : new_arg;
-  auto* dst_arg = is_input ? new_arg : arg;
+// Adds one node copying all of args, which is a batched copy when there is more than one.
+void TransformerMemcpyImpl::AddCopyNode(gsl::span<onnxruntime::NodeArg* const> args, bool is_input) {
+  std::vector<onnxruntime::NodeArg*> src_args;
+  std::vector<onnxruntime::NodeArg*> dst_args;
+  std::vector<onnxruntime::NodeArg*> new_args;
+  for (auto* arg : args) {
+    // create unique name for new def
+    std::string new_def_name = graph_.GenerateNodeArgName(arg->Name() + "_" + provider_);
+
+    auto* new_arg = &graph_.GetOrCreateNodeArg(new_def_name, arg->TypeAsProto());
+    src_args.push_back(is_input ? arg : new_arg);
+    dst_args.push_back(is_input ? new_arg : arg);
+    new_args.push_back(new_arg);
+  }
 
   // create unique name for copy node
-  std::string new_node_name = graph_.GenerateNodeName("Memcpy");
+  const bool is_batch = args.size() > 1;
+  std::string new_node_name = graph_.GenerateNodeName(is_batch ? "MemcpyBatch" : "Memcpy");
 
-  const auto op_name = is_input ? "MemcpyFromHost" : "MemcpyToHost";
-  auto& new_node = graph_.AddNode(new_node_name, op_name, "Copy from/to host memory",
-                                  std::vector<onnxruntime::NodeArg*>{src_arg},
-                                  std::vector<onnxruntime::NodeArg*>{dst_arg});
+  const auto op_name = is_input ? (is_batch ? "MemcpyFromHostBatch" : "MemcpyFromHost")
+                                : (is_batch ? "MemcpyToHostBatch" : "MemcpyToHost");
+  auto& new_node = graph_.AddNode(new_node_name, op_name, "Copy from/to host memory", src_args, dst_args);
   new_node.SetExecutionProviderType(provider_);
-  std::map<const onnxruntime::NodeArg*, onnxruntime::NodeArg*> map = {{arg, new_arg}};
-  auto it = provider_input_nodes_.find(arg);
-  if (it != provider_input_nodes_.end()) {
-    for (auto* node : it->second)
-      node->ReplaceDefs(map);
+  for (size_t i = 0; i < args.size(); ++i) {
+    const auto* arg = args[i];
+    std::map<const onnxruntime::NodeArg*, onnxruntime::NodeArg*> map = {{arg, new_args[i]}};
+    auto it = provider_input_nodes_.find(arg);
+    if (it != provider_input_nodes_.end()) {
+      for (auto* node : it->second)
+        node->ReplaceDefs(map);
+    }
+    it = provider_output_nodes_.find(arg);
+    if (it != provider_output_nodes_.end()) {
+      for (auto* node : it->second)
+        node->ReplaceDefs(map);
+    }
+  }
+}
+
+// Adds the copy nodes for args, all crossing the host/device boundary in the same direction.
+// The CUDA EP copies several tensors in one transfer, so the tensors are grouped into batched copy nodes.
+// Two tensors only share a node when neither producer depends on the other, otherwise the copy node
+// would have to run both before and after the node in between, and the graph would have a cycle.
+void TransformerMemcpyImpl::AddCopyNodes(gsl::span<onnxruntime::NodeArg* const> args, bool is_input) {
+  auto is_batchable = [this](const onnxruntime::NodeArg* arg) {
+    if (provider_ != kCudaExecutionProvider) {
+      return false;
+    }
+    const auto* type = arg->TypeAsProto();
+    return type != nullptr && type->has_tensor_type() &&
+           type->tensor_type().elem_type() != ONNX_NAMESPACE::TensorProto_DataType_STRING;
+  };
+
+  struct CopyGroup {
+    InlinedVector<onnxruntime::NodeArg*> args;
+    InlinedVector<const Node*> producers;
+  };
+  std::vector<CopyGroup> groups;
+  std::unordered_map<const Node*, InlinedHashSet<const Node*>> ancestors;
+
+  auto get_ancestors = [this, &ancestors](const Node* node) -> const InlinedHashSet<const Node*>& {
+    auto it = ancestors.find(node);
+    if (it == ancestors.end()) {
+      InlinedHashSet<const Node*> node_ancestors;
+      graph_.ReverseDFSFrom(
+          gsl::make_span(&node, 1), [&node_ancestors](const Node* n) { node_ancestors.insert(n); }, nullptr);
+      it = ancestors.emplace(node, std::move(node_ancestors)).first;
+    }
+    return it->second;
+  };
+
+  auto independent = [&get_ancestors](const Node* lhs, const Node* rhs) {
+    // graph inputs and outer scope values are produced before any node of the graph runs,
+    // and the outputs of the same node are produced together
+    if (lhs == nullptr || rhs == nullptr || lhs == rhs) {
+      return true;
+    }
+    return get_ancestors(lhs).count(rhs) == 0 && get_ancestors(rhs).count(lhs) == 0;
+  };
+
+  for (auto* arg : args) {
+    if (!is_batchable(arg)) {
+      AddCopyNode(arg, is_input);
+      continue;
+    }
+
+    const Node* producer = graph_.GetProducerNode(arg->Name());
+    auto group = std::find_if(groups.begin(), groups.end(), [&](const CopyGroup& g) {
+      return std::all_of(g.producers.begin(), g.producers.end(),
+                         [&](const Node* other) { return independent(producer, other); });
+    });
+    if (group == groups.end()) {
+      group = groups.emplace(groups.end());
+    }
+    group->args.push_back(arg);
+    group->producers.push_back(producer);
   }
-  it = provider_output_nodes_.find(arg);
-  if (it != provider_output_nodes_.end()) {
-    for (auto* node : it->second)
-      node->ReplaceDefs(map);
+
+  for (const auto& group : groups) {
+    AddCopyNode(group.args, is_input);
   }
 }
 
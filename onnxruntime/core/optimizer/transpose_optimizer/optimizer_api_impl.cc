@@ -859,6 +859,11 @@ Status TransformLayoutForEP(Graph& graph, bool& modified, const IExecutionProvid
         continue;
       }
 
+      // Skip if the EP does not have a kernel in the NHWC layout for the op
+      if (!execution_provider.ShouldConvertDataLayoutForOp(domain, node->OpType())) {
+        continue;
+      }
+
       // if already transformed then change the domain to kMSInternalNHWCDomain this way the EP
       // knows this op is in the expected format.
       if (node->GetAttributeIntDefault("channels_last", 0) == 1) {
@@ -0,0 +1,75 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/optimizer/zipmap_elimination.h"
+
+#include "core/graph/graph_utils.h"
+
+using namespace ONNX_NAMESPACE;
+using namespace onnxruntime::common;
+
+namespace onnxruntime {
+
+Status ZipMapElimination::ApplyImpl(Graph& graph, bool& modified, int graph_level,
+                                    const logging::Logger& logger) const {
+  GraphViewer graph_viewer(graph);
+  const auto& node_topology_list = graph_viewer.GetNodesInTopologicalOrder();
+
+  for (auto node_index : node_topology_list) {
+    auto* node_ptr = graph.GetNode(node_index);
+    if (nullptr == node_ptr)
+      continue;  // node was removed
+
+    auto& zipmap = *node_ptr;
+
+    ORT_RETURN_IF_ERROR(Recurse(zipmap, modified, graph_level, logger));
+
+    if (!graph_utils::IsSupportedOptypeVersionAndDomain(zipmap, "ZipMap", {1}, kMLDomain)) {
+      continue;
+    }
+
+    // the map output must only be a graph output, and the probabilities must be a float tensor
+    NodeArg& output = *zipmap.MutableOutputDefs()[0];
+    NodeArg& probabilities = *zipmap.MutableInputDefs()[0];
+    const auto* probabilities_type = probabilities.TypeAsProto();
+    if (!graph.IsOutput(&output) || zipmap.GetOutputEdgesCount() != 0 ||
+        !graph.GetConsumerNodes(output.Name()).empty() || probabilities_type == nullptr ||
+        !probabilities_type->has_tensor_type() ||
+        probabilities_type->tensor_type().elem_type() != TensorProto_DataType_FLOAT) {
+      continue;
+    }
+
+    const Node* producer = graph.GetProducerNode(probabilities.Name());
+    const bool rename_producer_output = producer != nullptr && !graph.IsOutput(&probabilities) &&
+                                        graph.GetConsumerNodes(probabilities.Name()).size() == 1;
+    const TypeProto tensor_type = *probabilities_type;
+    const std::string execution_provider_type = zipmap.GetExecutionProviderType();
+    const std::string zipmap_name = zipmap.Name();
+
+    graph.RemoveNode(zipmap.Index());
+    output.SetType(tensor_type);
+
+    if (rename_producer_output) {
+      Node& producer_node = *graph.GetNode(producer->Index());
+      const int output_index = graph_utils::GetNodeOutputIndexFromOutputName(producer_node, probabilities.Name());
+      producer_node.MutableOutputDefs()[output_index] = &output;
+      graph.UpdateProducerNode(output.Name(), producer_node.Index());
+    } else {
+      Node& identity = graph.AddNode(graph.GenerateNodeName(zipmap_name + "_Identity"), "Identity",
+                                     "Replaces a ZipMap node producing a graph output", {&probabilities},
+                                     {&output});
+      identity.SetExecutionProviderType(execution_provider_type);
+      if (producer != nullptr) {
+        graph.AddEdge(producer->Index(), identity.Index(),
+                      graph_utils::GetNodeOutputIndexFromOutputName(*producer, probabilities.Name()), 0);
+      }
+    }
+
+    LOGS(logger, VERBOSE) << "ZipMapElimination removed ZipMap node " << zipmap_name;
+    modified = true;
+  }
+
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,27 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/optimizer/graph_transformer.h"
+
+namespace onnxruntime {
+
+/**
+@Class ZipMapElimination
+
+Remove the ZipMap nodes that produce graph outputs, so that these outputs are the dense float tensor of class
+probabilities instead of a sequence of maps, one per row.
+
+The graph output keeps its name and the node producing the probabilities writes to it directly. If the
+probabilities have other consumers, the ZipMap node is replaced by an Identity node instead.
+*/
+class ZipMapElimination : public GraphTransformer {
+ public:
+  ZipMapElimination() noexcept : GraphTransformer("ZipMapElimination") {}
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int graph_level, const logging::Logger& logger) const override;
+};
+
+}  // namespace onnxruntime
@@ -91,6 +91,14 @@ struct ThreadOptions {
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
   int dynamic_block_base_ = 0;
+
+  // If spinning is allowed, let each thread tune how long it spins before blocking to its recent idle periods,
+  // instead of always spinning for the same number of iterations.
+  bool adaptive_spinning = false;
+
+  // Measure the cost per iteration of the parallel loops of each call site of ThreadPool::TryParallelFor, and use it
+  // instead of the cost given by the call site to decide how to split the loops.
+  bool calibrate_parallel_for_cost = false;
 };
 
 std::ostream& operator<<(std::ostream& os, const LogicalProcessors&);
@@ -141,6 +149,10 @@ class Env {
 
   virtual std::vector<LogicalProcessors> GetDefaultThreadAffinities() const = 0;
 
+  /// \brief Returns the NUMA node of a logical processor, or -1 if it is unknown.
+  /// Thread pools use it to group workers whose affinities lie on the same node.
+  virtual int GetNumaNodeOfLogicalProcessor(int /*logical_processor_id*/) const { return -1; }
+
   /// \brief Returns the number of micro-seconds since the Unix epoch.
   virtual uint64_t NowMicros() const {
     return env_time_->NowMicros();
@@ -18,6 +18,8 @@ limitations under the License.
 
 
 #include <assert.h>
+#include <ctype.h>
+#include <dirent.h>
 #include <dlfcn.h>
 #include <fcntl.h>
 #include <ftw.h>
@@ -326,6 +328,29 @@ class PosixEnv : public Env {
     return ret;
   }
 
+  int GetNumaNodeOfLogicalProcessor(int logical_processor_id) const override {
+#if defined(__linux__)
+    // The sysfs directory of a logical processor links to its NUMA node as "node<N>".
+    const std::string cpu_path = "/sys/devices/system/cpu/cpu" + std::to_string(logical_processor_id);
+    DIR* dir = opendir(cpu_path.c_str());
+    if (dir == nullptr) {
+      return -1;
+    }
+    int node = -1;
+    while (const dirent* entry = readdir(dir)) {
+      if (strncmp(entry->d_name, "node", 4) == 0 && isdigit(static_cast<unsigned char>(entry->d_name[4]))) {
+        node = atoi(entry->d_name + 4);
+        break;
+      }
+    }
+    closedir(dir);
+    return node;
+#else
+    ORT_UNUSED_PARAMETER(logical_processor_id);
+    return -1;
+#endif
+  }
+
   void SleepForMicroseconds(int64_t micros) const override {
     while (micros > 0) {
       timespec sleep_time;
@@ -259,6 +259,21 @@ int WindowsEnv::GetNumPhysicalCpuCores() const {
   return cores_.empty() ? DefaultNumCores() : static_cast<int>(cores_.size());
 }
 
+int WindowsEnv::GetNumaNodeOfLogicalProcessor(int global_processor_id) const {
+  const auto processor_info = GetProcessorAffinityMask(global_processor_id);
+  if (processor_info.group_id == -1) {
+    return -1;
+  }
+  PROCESSOR_NUMBER processor_number = {};
+  processor_number.Group = static_cast<WORD>(processor_info.group_id);
+  processor_number.Number = static_cast<BYTE>(processor_info.local_processor_id);
+  USHORT node_number = 0;
+  if (!GetNumaProcessorNodeEx(&processor_number, &node_number) || node_number == MAXUSHORT) {
+    return -1;
+  }
+  return static_cast<int>(node_number);
+}
+
 std::vector<LogicalProcessors> WindowsEnv::GetDefaultThreadAffinities() const {
   return cores_.empty() ? std::vector<LogicalProcessors>(DefaultNumCores(), LogicalProcessors{}) : cores_;
 }
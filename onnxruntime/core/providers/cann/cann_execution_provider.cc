@@ -1017,9 +1017,14 @@ CANNExecutionProvider::CANNExecutionProvider(const CANNExecutionProviderInfo& in
 
   soc_name_ = aclrtGetSocName();
   ORT_ENFORCE(soc_name_ != nullptr, "aclrtGetSocName return nullptr");
+
+  model_cache_path_ = onnxruntime::GetEnvironmentVar(cann_env_vars::kModelCachePath);
 }
 
 CANNExecutionProvider::~CANNExecutionProvider() {
+  for (const auto& model_id : model_ids_) {
+    ORT_IGNORE_RETURN_VALUE(CANN_CALL(aclmdlUnload(model_id.second)));
+  }
   CANN_CALL_THROW(aclrtDestroyStream(stream_));
 }
 
@@ -1320,7 +1325,15 @@ Status CANNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fuse
     graph_body_viewer.ToProto(*model_proto->mutable_graph(), true, true);
     model_proto->set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
     model_proto->SerializeToString(string_model);
+    // The compiled models depend on the subgraph, the SoC and the CANN version as well as on the input shapes.
+    int32_t major_version = 0, minor_version = 0, patch_version = 0;
+    CANN_RETURN_IF_ERROR(aclrtGetVersion(&major_version, &minor_version, &patch_version));
+    HashValue model_hash;
+    cann::GenerateHashValue(string_model + soc_name_ + "_" + std::to_string(major_version) + "." +
+                                std::to_string(minor_version) + "." + std::to_string(patch_version),
+                            model_hash);
     models_[node_name] = string_model;
+    model_hashes_[node_name] = model_hash;
 
     NodeComputeInfo compute_info;
     compute_info.create_state_func = [=](ComputeContext* context, FunctionState* state) {
@@ -1362,16 +1375,22 @@ Status CANNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fuse
       // Since the name of the input tensor of the sub-graph may exceed the maximum length required by Linux,
       // and may also contain various special characters, such as "/". So, it is reasonable to convert it to HashValue.
       HashValue hash;
-      cann::GenerateHashValue(input_shape, hash);
-      std::string filename = cann_state->node_name + "_" + std::to_string(hash);
+      cann::GenerateHashValue(std::to_string(model_hashes_[cann_state->node_name]) + input_shape, hash);
+      std::string filename = cann::GetCachePath(model_cache_path_,
+                                                cann_state->node_name + "_" + std::to_string(hash));
       std::string filename_with_suffix = filename + ".om";
 
       uint32_t modelID;
       {
         std::lock_guard<OrtMutex> lock(g_mutex);
 
-        if (cann::FileExist(filename_with_suffix)) {
+        // The model is built, or loaded from the cache directory, once for each input shape.
+        auto model_id = model_ids_.find(filename);
+        if (model_id != model_ids_.end()) {
+          modelID = model_id->second;
+        } else if (cann::FileExist(filename_with_suffix)) {
           CANN_RETURN_IF_ERROR(aclmdlLoadFromFile(filename_with_suffix.c_str(), &modelID));
+          model_ids_.emplace(filename, modelID);
         } else {
           ge::Graph graph{cann_state->node_name.c_str()};
           ORT_RETURN_IF_ERROR(ParserONNXModel(string_model, graph));
@@ -1380,6 +1399,7 @@ Status CANNExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fuse
           ORT_RETURN_IF_ERROR(BuildONNXModel(graph, input_shape, soc_name_, filename, model));
 
           CANN_RETURN_IF_ERROR(aclmdlLoadFromMem(model.data.get(), model.length, &modelID));
+          model_ids_.emplace(filename, modelID);
         }
       }
 
@@ -21,6 +21,12 @@
 
 namespace onnxruntime {
 
+namespace cann_env_vars {
+// Directory of the compiled offline models (.om) of the CANN subgraphs, which are loaded instead of being built again.
+// Defaults to the current directory.
+static const std::string kModelCachePath = "ORT_CANN_MODEL_CACHE_PATH";
+}  // namespace cann_env_vars
+
 // Information to construct kernel function state.
 struct CannFuncState {
   AllocateFunc allocate_func = nullptr;
@@ -92,8 +98,14 @@ class CANNExecutionProvider : public IExecutionProvider {
   aclrtStream stream_ = nullptr;
   const char* soc_name_ = nullptr;
 
+  std::string model_cache_path_;
+
   std::unordered_map<std::string, std::string> models_;
+  // hash of the serialized subgraph of each fused node, which is part of the key of its compiled models
+  std::unordered_map<std::string, HashValue> model_hashes_;
   std::unordered_map<std::string, std::unordered_map<std::size_t, std::string>> names_;
+  // compiled model of each fused node and input shapes, loaded once. Guarded by g_mutex.
+  std::unordered_map<std::string, uint32_t> model_ids_;
 };
 
 }  // namespace onnxruntime
@@ -217,6 +217,13 @@ bool FileExist(const std::string& file_name) {
   return (access(file_name.c_str(), F_OK) != -1);
 }
 
+std::string GetCachePath(const std::string& root, const std::string& name) {
+  if (root.empty()) {
+    return name;
+  }
+  return root.back() == '/' ? root + name : root + "/" + name;
+}
+
 void GenerateHashValue(const std::string string, HashValue& hash_value) {
   uint32_t hash[4] = {0, 0, 0, 0};
   MurmurHash3::x86_128(string.data(), gsl::narrow_cast<int32_t>(string.size()), hash[0], &hash);
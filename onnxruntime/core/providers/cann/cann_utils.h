@@ -123,6 +123,7 @@ Status aclrtblasGemmEx(aclTransType transA,
                        aclrtStream stream);
 
 bool FileExist(const std::string& file_name);
+std::string GetCachePath(const std::string& root, const std::string& name);
 void GenerateHashValue(const std::string string, HashValue& hash_value);
 std::unique_ptr<Model> CreateModel(const GraphViewer& graph_viewer, const logging::Logger& logger);
 
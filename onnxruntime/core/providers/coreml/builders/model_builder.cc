@@ -2,12 +2,15 @@
 // Licensed under the MIT License.
 
 #include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <core/common/safeint.h>
 
 #include "model_builder.h"
 #include "helper.h"
 #include "op_builder_factory.h"
 
+#include "core/framework/murmurhash3.h"
 #include "core/providers/common.h"
 #include "core/providers/coreml/model/model.h"
 #include "core/providers/coreml/model/host_utils.h"
@@ -16,10 +19,12 @@
 namespace onnxruntime {
 namespace coreml {
 
-ModelBuilder::ModelBuilder(const GraphViewer& graph_viewer, const logging::Logger& logger, uint32_t coreml_flags)
+ModelBuilder::ModelBuilder(const GraphViewer& graph_viewer, const logging::Logger& logger, uint32_t coreml_flags,
+                           const std::string& cache_dir)
     : graph_viewer_(graph_viewer),
       logger_(logger),
-      coreml_flags_(coreml_flags) {
+      coreml_flags_(coreml_flags),
+      cache_dir_(cache_dir) {
 }
 
 Status ModelBuilder::Initialize() {
@@ -210,7 +215,10 @@ Status ModelBuilder::RegisterModelOutputs() {
 
 Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& path) {
   ORT_RETURN_IF_ERROR(SaveCoreMLModel(path));
-  model.reset(new Model(path, logger_, coreml_flags_));
+  // the compiled model only depends on the CoreML model content, which makes its hash a safe cache key
+  const std::string compiled_model_cache_path =
+      cache_dir_.empty() ? "" : cache_dir_ + "/" + model_hash_ + ".mlmodelc";
+  model.reset(new Model(path, compiled_model_cache_path, logger_, coreml_flags_));
   model->SetScalarOutputs(std::move(scalar_outputs_));
   model->SetInt64Outputs(std::move(int64_outputs_));
   model->SetInputOutputInfo(std::move(input_output_info_));
@@ -219,8 +227,18 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model, const std::string& p
 
 Status ModelBuilder::SaveCoreMLModel(const std::string& path) {
   ORT_RETURN_IF_ERROR(Initialize());
+  std::string model_data;
+  ORT_RETURN_IF_NOT(coreml_model_->SerializeToString(&model_data), "Serialize the CoreML model failed");
   std::ofstream stream(path, std::ofstream::out | std::ofstream::binary);
-  ORT_RETURN_IF_NOT(coreml_model_->SerializeToOstream(&stream), "Save the CoreML model failed");
+  ORT_RETURN_IF_NOT(stream.write(model_data.data(), model_data.size()), "Save the CoreML model failed");
+
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(model_data.data(), gsl::narrow<int32_t>(model_data.size()), hash[0], &hash);
+  std::ostringstream hash_str;
+  for (const auto h : hash) {
+    hash_str << std::hex << std::setw(8) << std::setfill('0') << h;
+  }
+  model_hash_ = hash_str.str();
 
   // TODO, Delete, debug only
   if (const char* path = std::getenv("ORT_COREML_EP_CONVERTED_MODEL_PATH")) {
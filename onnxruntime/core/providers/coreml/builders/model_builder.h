@@ -17,7 +17,9 @@ struct OnnxTensorInfo;
 
 class ModelBuilder {
  public:
-  ModelBuilder(const GraphViewer& graph_viewer, const logging::Logger& logger, uint32_t coreml_flags);
+  // cache_dir is the directory to cache the compiled CoreML model in, caching is disabled if it is empty
+  ModelBuilder(const GraphViewer& graph_viewer, const logging::Logger& logger, uint32_t coreml_flags,
+               const std::string& cache_dir = "");
   ~ModelBuilder() = default;
 
   Status Compile(std::unique_ptr<Model>& model, const std::string& path) ORT_MUST_USE_RESULT;
@@ -42,6 +44,10 @@ class ModelBuilder {
   const GraphViewer& graph_viewer_;
   const logging::Logger& logger_;
   uint32_t coreml_flags_;
+  const std::string cache_dir_;
+
+  // Hex string of the hash of the serialized CoreML model, set by SaveCoreMLModel
+  std::string model_hash_;
 
   std::unique_ptr<CoreML::Specification::Model> coreml_model_;
   std::unordered_set<std::string> scalar_outputs_;
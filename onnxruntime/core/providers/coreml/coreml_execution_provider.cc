@@ -20,9 +20,10 @@ namespace onnxruntime {
 
 constexpr const char* COREML = "CoreML";
 
-CoreMLExecutionProvider::CoreMLExecutionProvider(uint32_t coreml_flags)
+CoreMLExecutionProvider::CoreMLExecutionProvider(uint32_t coreml_flags, const std::optional<std::string>& cache_dir)
     : IExecutionProvider{onnxruntime::kCoreMLExecutionProvider, true},
-      coreml_flags_(coreml_flags) {
+      coreml_flags_(coreml_flags),
+      cache_dir_(cache_dir.value_or("")) {
   AllocatorCreationInfo device_info(
       [](int) {
         return std::make_unique<CPUAllocator>(OrtMemoryInfo(COREML, OrtAllocatorType::OrtDeviceAllocator));
@@ -103,7 +104,7 @@ common::Status CoreMLExecutionProvider::Compile(const std::vector<FusedNodeAndGr
     Node& fused_node = fused_node_and_graph.fused_node;
     const onnxruntime::GraphViewer& graph_viewer(fused_node_and_graph.filtered_graph);
 
-    coreml::ModelBuilder builder(graph_viewer, *GetLogger(), coreml_flags_);
+    coreml::ModelBuilder builder(graph_viewer, *GetLogger(), coreml_flags_, cache_dir_);
     std::unique_ptr<coreml::Model> coreml_model;
     const std::string coreml_model_file_path = coreml::util::GetTemporaryFilePath();
     ORT_RETURN_IF_ERROR(builder.Compile(coreml_model, coreml_model_file_path));
@@ -3,6 +3,9 @@
 
 #pragma once
 
+#include <optional>
+#include <string>
+
 #include "core/framework/execution_provider.h"
 #include "core/providers/coreml/coreml_provider_factory.h"
 
@@ -13,7 +16,7 @@ class Model;
 
 class CoreMLExecutionProvider : public IExecutionProvider {
  public:
-  CoreMLExecutionProvider(uint32_t coreml_flags);
+  CoreMLExecutionProvider(uint32_t coreml_flags, const std::optional<std::string>& cache_dir = {});
   virtual ~CoreMLExecutionProvider();
 
   std::vector<std::unique_ptr<ComputeCapability>>
@@ -30,6 +33,9 @@ class CoreMLExecutionProvider : public IExecutionProvider {
   const uint32_t coreml_flags_;
 
  private:
+  // Directory to cache the compiled CoreML models in, empty if caching is disabled
+  const std::string cache_dir_;
+
   // <fused_node_name, <coreml_model_file_path, compiled_coreml_model>>
   #ifdef __APPLE__
   std::unordered_map<std::string, std::unique_ptr<onnxruntime::coreml::Model>> coreml_models_;
@@ -59,7 +59,10 @@ class Model {
 
   OrtMutex mutex_;
 
-  Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  // compiled_model_cache_path is where the compiled model is looked up and stored, if empty the model is compiled
+  // into a temporary location which is removed with the model
+  Model(const std::string& path, const std::string& compiled_model_cache_path,
+        const logging::Logger& logger, uint32_t coreml_flags);
   onnxruntime::common::Status LoadModel();
 
   void SetInputOutputInfo(std::unordered_map<std::string, OnnxTensorInfo>&& input_output_info) {
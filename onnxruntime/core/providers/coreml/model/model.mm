@@ -39,17 +39,20 @@ asm(".linker_option \"-framework\", \"CoreML\"");
 // Execution for a CoreML model, it performs
 // 1. Compile the model by given path for execution
 // 2. Predict using given OnnxTensorFeatureProvider input and copy the output data back ORT
-// 3. The compiled model will be removed in dealloc or removed using cleanup function
+// 3. The compiled model will be removed in dealloc or removed using cleanup function,
+//    unless it was moved to the compiled model cache
 @interface CoreMLExecution : NSObject {
   NSString* coreml_model_path_;
   NSString* compiled_model_path_;
+  NSString* compiled_model_cache_path_;
   const onnxruntime::logging::Logger* logger_;
   uint32_t coreml_flags_;
 }
 
 - (instancetype)initWithPath:(const std::string&)path
-                      logger:(const onnxruntime::logging::Logger&)logger
-                coreml_flags:(uint32_t)coreml_flags;
+    compiled_model_cache_path:(const std::string&)compiled_model_cache_path
+                       logger:(const onnxruntime::logging::Logger&)logger
+                 coreml_flags:(uint32_t)coreml_flags;
 - (void)cleanup;
 - (void)dealloc;
 - (onnxruntime::common::Status)loadModel API_AVAILABLE_OS_VERSIONS;
@@ -140,10 +143,14 @@ asm(".linker_option \"-framework\", \"CoreML\"");
 @implementation CoreMLExecution
 
 - (instancetype)initWithPath:(const std::string&)path
-                      logger:(const onnxruntime::logging::Logger&)logger
-                coreml_flags:(uint32_t)coreml_flags {
+    compiled_model_cache_path:(const std::string&)compiled_model_cache_path
+                       logger:(const onnxruntime::logging::Logger&)logger
+                 coreml_flags:(uint32_t)coreml_flags {
   if (self = [super init]) {
     coreml_model_path_ = [NSString stringWithUTF8String:path.c_str()];
+    if (!compiled_model_cache_path.empty()) {
+      compiled_model_cache_path_ = [NSString stringWithUTF8String:compiled_model_cache_path.c_str()];
+    }
     logger_ = &logger;
     coreml_flags_ = coreml_flags;
   }
@@ -178,16 +185,37 @@ asm(".linker_option \"-framework\", \"CoreML\"");
 
 - (onnxruntime::common::Status)loadModel {
   NSError* error = nil;
-  NSURL* modelUrl = [NSURL URLWithString:coreml_model_path_];
-  NSAssert(modelUrl != nil, @"modelUrl must not be nil");
-  NSURL* compileUrl = [MLModel compileModelAtURL:modelUrl error:&error];
+  NSURL* compileUrl = nil;
+  NSFileManager* file_manager = [NSFileManager defaultManager];
 
-  if (error != nil) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Error compiling model ",
-                           [[error localizedDescription] cStringUsingEncoding:NSUTF8StringEncoding]);
-  }
+  if (compiled_model_cache_path_ != nil && [file_manager fileExistsAtPath:compiled_model_cache_path_]) {
+    LOGS(*logger_, VERBOSE) << "Using the cached compiled model: " << [compiled_model_cache_path_ UTF8String];
+    compileUrl = [NSURL fileURLWithPath:compiled_model_cache_path_];
+  } else {
+    NSURL* modelUrl = [NSURL URLWithString:coreml_model_path_];
+    NSAssert(modelUrl != nil, @"modelUrl must not be nil");
+    compileUrl = [MLModel compileModelAtURL:modelUrl error:&error];
+
+    if (error != nil) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Error compiling model ",
+                             [[error localizedDescription] cStringUsingEncoding:NSUTF8StringEncoding]);
+    }
 
-  compiled_model_path_ = [compileUrl path];
+    compiled_model_path_ = [compileUrl path];
+
+    // Failing to store the compiled model is not an error, the next session will simply compile the model again.
+    // This also covers another session storing the same model concurrently.
+    if (compiled_model_cache_path_ != nil) {
+      if ([file_manager moveItemAtPath:compiled_model_path_ toPath:compiled_model_cache_path_ error:&error]) {
+        compiled_model_path_ = nil;
+        compileUrl = [NSURL fileURLWithPath:compiled_model_cache_path_];
+      } else {
+        LOGS(*logger_, WARNING) << "Failed caching the compiled model to: " << [compiled_model_cache_path_ UTF8String]
+                                << ", error message: " << [[error localizedDescription] UTF8String];
+        error = nil;
+      }
+    }
+  }
 
   MLModelConfiguration* config = [MLModelConfiguration alloc];
   config.computeUnits = MLComputeUnitsAll;
@@ -300,7 +328,8 @@ namespace coreml {
 // This class will bridge Model (c++) with CoreMLExecution (objective c++)
 class Execution {
  public:
-  Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags);
+  Execution(const std::string& path, const std::string& compiled_model_cache_path,
+            const logging::Logger& logger, uint32_t coreml_flags);
   ~Execution(){};
 
   Status LoadModel();
@@ -312,8 +341,10 @@ class Execution {
   CoreMLExecution* execution_;
 };
 
-Execution::Execution(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags) {
+Execution::Execution(const std::string& path, const std::string& compiled_model_cache_path,
+                     const logging::Logger& logger, uint32_t coreml_flags) {
   execution_ = [[CoreMLExecution alloc] initWithPath:path
+                           compiled_model_cache_path:compiled_model_cache_path
                                               logger:logger
                                         coreml_flags:coreml_flags];
 }
@@ -343,8 +374,9 @@ Status Execution::Predict(const std::unordered_map<std::string, OnnxTensorData>&
   return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Execution::LoadModel requires macos 10.15+ or ios 13+ ");
 }
 
-Model::Model(const std::string& path, const logging::Logger& logger, uint32_t coreml_flags)
-    : execution_(std::make_unique<Execution>(path, logger, coreml_flags)) {
+Model::Model(const std::string& path, const std::string& compiled_model_cache_path,
+             const logging::Logger& logger, uint32_t coreml_flags)
+    : execution_(std::make_unique<Execution>(path, compiled_model_cache_path, logger, coreml_flags)) {
 }
 
 Model::~Model() {}
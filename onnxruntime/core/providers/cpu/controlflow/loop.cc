@@ -14,6 +14,7 @@
 
 #include "core/framework/allocator.h"
 #include "core/framework/framework_common.h"
+#include "core/framework/iexecutor.h"
 #include "core/framework/op_kernel_context_internal.h"
 #include "core/framework/session_state.h"
 #include "core/framework/tensorprotoutils.h"
@@ -173,6 +174,12 @@ Loop::Info::Info(const onnxruntime::Node& node, const GraphViewer& subgraph_in)
     auto& output = subgraph_outputs[i];
     subgraph_output_names.push_back(output->Name());
   }
+
+  // exported 'for' loops return the 'cond' input directly or through an Identity node
+  const Node* cond_producer = subgraph.GetProducerNode(subgraph_output_names[0]);
+  condition_is_loop_invariant = subgraph_output_names[0] == subgraph_input_names[1] ||
+                                (cond_producer != nullptr && cond_producer->OpType() == "Identity" &&
+                                 cond_producer->InputDefs()[0]->Name() == subgraph_input_names[1]);
 }
 
 class LoopImpl {
@@ -196,6 +203,20 @@ class LoopImpl {
   // create the single Loop output from a collection of per-iteration outputs
   Status ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index);
 
+  // Loop output with the outputs of all the iterations that is allocated when the first iteration produces its
+  // output, the subgraph then writes the output of each iteration directly into its slice.
+  struct PreallocatedLoopOutput {
+    Tensor* output = nullptr;
+    TensorShape iteration_shape;
+    size_t iteration_size_in_bytes = 0;
+  };
+
+  // create the custom allocators that allocate the Loop outputs on the first iteration
+  void CreatePreallocatedOutputAllocators(std::vector<OrtValue>& fetches,
+                                          std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators);
+
+  OrtValue GetIterationSlice(const PreallocatedLoopOutput& preallocated_output, int64_t iteration) const;
+
   OpKernelContextInternal& context_;
   const SessionState& session_state_;
   const Loop::Info& info_;
@@ -212,6 +233,11 @@ class LoopImpl {
   // the order from the subgraph matches the order from the loop output
   std::vector<std::vector<OrtValue>> loop_output_tensors_;
 
+  // true if the Loop runs exactly max_trip_count_ iterations, so its outputs can be preallocated
+  bool fixed_trip_count_;
+  // the preallocated loop outputs, with a nullptr output for the ones that are concatenated after the last iteration
+  std::vector<PreallocatedLoopOutput> preallocated_outputs_;
+
   const Loop::ConcatOutput& concat_output_func_;
 };
 
@@ -372,6 +398,7 @@ LoopImpl::LoopImpl(OpKernelContextInternal& context,
       concat_output_func_(concat_output_func) {
   auto* max_trip_count_tensor = context.Input<Tensor>(0);
   max_trip_count_ = max_trip_count_tensor ? *max_trip_count_tensor->Data<int64_t>() : INT64_MAX;
+  fixed_trip_count_ = max_trip_count_tensor != nullptr && max_trip_count_ > 0 && info_.condition_is_loop_invariant;
 
   auto cond_tensor = context.Input<Tensor>(1);
   condition_ = cond_tensor ? *cond_tensor->Data<bool>() : true;
@@ -451,10 +478,63 @@ void LoopImpl::SaveOutputsAndUpdateFeeds(const std::vector<OrtValue>& last_outpu
   // save loop outputs as we have to concatenate at the end
   for (ptrdiff_t j = info_.num_loop_carried_vars; j < info_.num_outputs; ++j) {
     ORT_ENFORCE(last_outputs[j + 1].IsTensor(), "All scan outputs MUST be tensors");
-    loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(last_outputs[j + 1]);  // skip 'cond' in output
+    if (preallocated_outputs_.empty() || preallocated_outputs_[j - info_.num_loop_carried_vars].output == nullptr) {
+      loop_output_tensors_[j - info_.num_loop_carried_vars].push_back(last_outputs[j + 1]);  // skip 'cond' in output
+    }
+  }
+}
+
+void LoopImpl::CreatePreallocatedOutputAllocators(
+    std::vector<OrtValue>& fetches, std::unordered_map<size_t, IExecutor::CustomAllocator>& fetch_allocators) {
+  preallocated_outputs_.resize(loop_output_tensors_.size());
+  fetches.resize(info_.num_subgraph_outputs);
+
+  for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+    const size_t fetch_index = static_cast<size_t>(i) + 1;  // skip 'cond'
+    auto& preallocated_output = preallocated_outputs_[static_cast<size_t>(i) - info_.num_loop_carried_vars];
+
+    // only called if the output of the first iteration is a tensor allocated by the subgraph, so the outputs that
+    // are e.g. subgraph inputs or outer scope values are concatenated after the last iteration.
+    fetch_allocators[fetch_index] = [this, i, fetch_index, &preallocated_output, &fetches](
+                                        const TensorShape& shape, const OrtMemoryInfo& location,
+                                        OrtValue& ort_value, bool& allocated) {
+      std::vector<int64_t> dims;
+      dims.reserve(shape.NumDimensions() + 1);
+      dims.push_back(max_trip_count_);
+      std::copy(shape.GetDims().begin(), shape.GetDims().end(), std::back_inserter(dims));
+
+      Tensor* output = context_.Output(i, TensorShape(dims));
+      ORT_RETURN_IF(output == nullptr, "Failed to allocate output ", i, " of Loop.");
+
+      preallocated_output.output = output;
+      preallocated_output.iteration_shape = shape;
+      preallocated_output.iteration_size_in_bytes = output->SizeInBytes() / static_cast<size_t>(max_trip_count_);
+
+      OrtValue slice = GetIterationSlice(preallocated_output, 0);
+      if (output->Location().device == location.device) {
+        ort_value = slice;
+        allocated = true;
+      } else {
+        // the execution frame allocates a buffer on the device of the subgraph output, and the fetches copy logic in
+        // utils::ExecuteSubgraph moves it into the slice
+        fetches[fetch_index] = slice;
+      }
+
+      return Status::OK();
+    };
   }
 }
 
+OrtValue LoopImpl::GetIterationSlice(const PreallocatedLoopOutput& preallocated_output, int64_t iteration) const {
+  Tensor& output = *preallocated_output.output;
+  auto* data = static_cast<uint8_t*>(output.MutableDataRaw()) +
+               static_cast<size_t>(iteration) * preallocated_output.iteration_size_in_bytes;
+
+  OrtValue slice;
+  Tensor::InitOrtValue(output.DataType(), preallocated_output.iteration_shape, data, output.Location(), slice);
+  return slice;
+}
+
 Status LoopImpl::ConcatenateLoopOutput(std::vector<OrtValue>& per_iteration_output, int output_index) {
   const auto& first_output = per_iteration_output.front().Get<Tensor>();
   const auto& per_iteration_dims = first_output.Shape().GetDims();
@@ -480,18 +560,35 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
   std::vector<OrtValue> feeds;
   std::vector<OrtValue> fetches;
+  std::unordered_map<size_t, IExecutor::CustomAllocator> fetch_allocators;
 
   CreateInitialFeeds(feeds);
 
   auto& iter_num_value = *iter_num_mlvalue_.GetMutable<Tensor>()->MutableData<int64_t>();
 
+  // if the number of iterations is known the loop outputs are allocated by the first iteration and the following
+  // iterations write into them, instead of keeping the output of every iteration to concatenate them at the end
+  if (fixed_trip_count_ && info_.num_outputs > info_.num_loop_carried_vars) {
+    CreatePreallocatedOutputAllocators(fetches, fetch_allocators);
+  }
+
   while (iter_num_value < max_trip_count_ && *condition_mlvalue_.GetMutable<Tensor>()->MutableData<bool>()) {
     if (iter_num_value != 0) {
       SaveOutputsAndUpdateFeeds(fetches, feeds);
       fetches.clear();
+
+      if (!preallocated_outputs_.empty()) {
+        fetches.resize(info_.num_subgraph_outputs);
+        for (size_t j = 0, end = preallocated_outputs_.size(); j < end; ++j) {
+          if (preallocated_outputs_[j].output != nullptr) {
+            // + 1 to skip 'cond'
+            fetches[j + info_.num_loop_carried_vars + 1] = GetIterationSlice(preallocated_outputs_[j], iter_num_value);
+          }
+        }
+      }
     }
 
-    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, {},
+    status = utils::ExecuteSubgraph(session_state_, ffm, feeds, fetches, fetch_allocators,
                                     ExecutionMode::ORT_SEQUENTIAL, context_.GetTerminateFlag(), context_.Logger(),
                                     context_.GetComputeStream(),
                                     // because the fetch[0] is the loop condition which we need to access on CPU,
@@ -501,6 +598,9 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
 
     condition_mlvalue_ = fetches[0];
 
+    // the custom allocators are only used by the first iteration
+    fetch_allocators.clear();
+
     ++iter_num_value;
   }
 
@@ -580,6 +680,14 @@ Status LoopImpl::Execute(const FeedsFetchesManager& ffm) {
     }
 
     for (int i = info_.num_loop_carried_vars; i < info_.num_outputs; ++i) {
+      if (!preallocated_outputs_.empty() &&
+          preallocated_outputs_[static_cast<ptrdiff_t>(i) - info_.num_loop_carried_vars].output != nullptr) {
+        // the iterations already wrote their outputs
+        ORT_RETURN_IF(iter_num_value != max_trip_count_, "Loop ran ", iter_num_value,
+                      " iterations but its outputs were allocated for ", max_trip_count_);
+        continue;
+      }
+
       // add last output
       auto& per_iteration_outputs = loop_output_tensors_[static_cast<ptrdiff_t>(i) - info_.num_loop_carried_vars];
       per_iteration_outputs.push_back(fetches[static_cast<ptrdiff_t>(i) + 1]);  // skip cond
@@ -38,6 +38,10 @@ class Loop : public controlflow::IControlFlowKernel {
     std::vector<std::string> subgraph_output_names;
 
     std::vector<const ONNX_NAMESPACE::TypeProto*> loop_carried_vars_types;
+
+    // true if the 'cond' output of the subgraph is its 'cond' input, so a Loop with a trip count runs exactly
+    // that many iterations and its outputs can be allocated before the first iteration.
+    bool condition_is_loop_invariant;
   };
 
   // function to concatenate the OrtValue instances from each Loop iteration into a single output buffer.
@@ -0,0 +1,278 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/cpu_profiler.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "core/common/string_utils.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace onnxruntime {
+namespace profiling {
+
+namespace {
+
+// the line size used to estimate the memory traffic from the last level cache misses
+constexpr uint64_t kCacheLineSize = 64;
+
+struct HardwareCounter {
+  const char* name;
+  uint32_t type;
+  uint64_t config;
+};
+
+#if defined(__linux__)
+constexpr uint64_t LastLevelCacheConfig(uint64_t op) {
+  return PERF_COUNT_HW_CACHE_LL | (op << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+}
+
+constexpr HardwareCounter kHardwareCounters[] = {
+    {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {"cache_references", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES},
+    {"cache_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {"stalled_cycles_frontend", PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_FRONTEND},
+    {"stalled_cycles_backend", PERF_TYPE_HARDWARE, PERF_COUNT_HW_STALLED_CYCLES_BACKEND},
+    {"llc_load_misses", PERF_TYPE_HW_CACHE, LastLevelCacheConfig(PERF_COUNT_HW_CACHE_OP_READ)},
+    {"llc_store_misses", PERF_TYPE_HW_CACHE, LastLevelCacheConfig(PERF_COUNT_HW_CACHE_OP_WRITE)},
+    {"page_faults", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+};
+#else
+constexpr HardwareCounter kHardwareCounters[] = {{"", 0, 0}};
+#endif
+
+#if defined(__linux__)
+int OpenCounter(const HardwareCounter& counter, int group_fd) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = counter.type;
+  attr.config = counter.config;
+  attr.read_format = PERF_FORMAT_GROUP;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  // the leader starts disabled and enables the whole group once all counters are opened
+  attr.disabled = group_fd == -1 ? 1 : 0;
+  // the counters of the calling thread on any cpu
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+}
+
+bool ReadCounters(const std::vector<int>& fds, std::vector<uint64_t>& values) {
+  // PERF_FORMAT_GROUP: the number of counters followed by their values
+  std::vector<uint64_t> buffer(fds.size() + 1);
+  const auto size = static_cast<ssize_t>(buffer.size() * sizeof(uint64_t));
+  if (read(fds[0], buffer.data(), buffer.size() * sizeof(uint64_t)) != size || buffer[0] != fds.size()) {
+    return false;
+  }
+
+  values.assign(buffer.begin() + 1, buffer.end());
+  return true;
+}
+#endif
+
+}  // namespace
+
+Status CpuHardwareCounterProfiler::Create(const std::string& counter_names, const logging::Logger& logger,
+                                          std::unique_ptr<EpProfiler>& profiler) {
+#if defined(__linux__)
+  std::vector<size_t> counters;
+  for (const auto& name : utils::SplitString(counter_names, ",")) {
+    const auto* counter = std::find_if(std::begin(kHardwareCounters), std::end(kHardwareCounters),
+                                       [&name](const HardwareCounter& c) { return name == c.name; });
+    if (counter == std::end(kHardwareCounters)) {
+      std::ostringstream supported_names;
+      for (const auto& supported_name : GetSupportedCounterNames()) {
+        supported_names << " " << supported_name;
+      }
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported hardware counter: ", name,
+                             ". Supported counters are:", supported_names.str());
+    }
+    const auto index = static_cast<size_t>(counter - std::begin(kHardwareCounters));
+    if (std::find(counters.begin(), counters.end(), index) == counters.end()) {
+      counters.push_back(index);
+    }
+  }
+  ORT_RETURN_IF(counters.empty(), "No hardware counter was given.");
+
+  profiler.reset(new CpuHardwareCounterProfiler(std::move(counters), logger));
+  return Status::OK();
+#else
+  ORT_UNUSED_PARAMETER(counter_names);
+  ORT_UNUSED_PARAMETER(logger);
+  ORT_UNUSED_PARAMETER(profiler);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Hardware counters are only supported on Linux.");
+#endif
+}
+
+std::vector<std::string> CpuHardwareCounterProfiler::GetSupportedCounterNames() {
+  std::vector<std::string> names;
+#if defined(__linux__)
+  for (const auto& counter : kHardwareCounters) {
+    names.push_back(counter.name);
+  }
+#endif
+  return names;
+}
+
+CpuHardwareCounterProfiler::CpuHardwareCounterProfiler(std::vector<size_t> counters, const logging::Logger& logger)
+    : counters_(std::move(counters)), logger_(logger) {
+}
+
+CpuHardwareCounterProfiler::~CpuHardwareCounterProfiler() {
+#if defined(__linux__)
+  for (const auto& entry : thread_counters_) {
+    for (int fd : entry.second->fds) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+bool CpuHardwareCounterProfiler::StartProfiling(TimePoint /*profiling_start_time*/) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  stopped_events_.clear();
+  return true;
+}
+
+void CpuHardwareCounterProfiler::OpenCounters(ThreadCounters& thread_counters) {
+#if defined(__linux__)
+  for (size_t i = 0; i < counters_.size(); ++i) {
+    const auto& counter = kHardwareCounters[counters_[i]];
+    const int fd = OpenCounter(counter, thread_counters.fds.empty() ? -1 : thread_counters.fds[0]);
+    if (fd == -1) {
+      if (!logged_open_failure_) {
+        LOGS(logger_, WARNING) << "Could not open the hardware counter " << counter.name
+                               << ", check the value of /proc/sys/kernel/perf_event_paranoid. errno: " << errno;
+        logged_open_failure_ = true;
+      }
+      continue;
+    }
+
+    thread_counters.fds.push_back(fd);
+    thread_counters.counters.push_back(i);
+  }
+
+  if (!thread_counters.fds.empty()) {
+    ioctl(thread_counters.fds[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(thread_counters.fds[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    thread_counters.available = true;
+  }
+#else
+  ORT_UNUSED_PARAMETER(thread_counters);
+#endif
+}
+
+CpuHardwareCounterProfiler::ThreadCounters& CpuHardwareCounterProfiler::GetThreadCounters() {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  auto& thread_counters = thread_counters_[std::this_thread::get_id()];
+  if (thread_counters == nullptr) {
+    thread_counters = std::make_unique<ThreadCounters>();
+    // the counters of a thread can only be opened by the thread itself
+    OpenCounters(*thread_counters);
+  }
+
+  return *thread_counters;
+}
+
+void CpuHardwareCounterProfiler::Start(uint64_t id) {
+#if defined(__linux__)
+  ThreadCounters& thread_counters = GetThreadCounters();
+  std::vector<uint64_t> values;
+  if (thread_counters.available && ReadCounters(thread_counters.fds, values)) {
+    thread_counters.pending_events.emplace_back(id, std::move(values));
+  }
+#else
+  ORT_UNUSED_PARAMETER(id);
+#endif
+}
+
+void CpuHardwareCounterProfiler::Stop(uint64_t id) {
+#if defined(__linux__)
+  ThreadCounters& thread_counters = GetThreadCounters();
+  std::vector<uint64_t> values;
+  if (!thread_counters.available || !ReadCounters(thread_counters.fds, values)) {
+    return;
+  }
+
+  // the events of a thread are nested, the events that were started but never stopped are dropped
+  auto& pending_events = thread_counters.pending_events;
+  auto event = std::find_if(pending_events.rbegin(), pending_events.rend(),
+                            [id](const auto& pending_event) { return pending_event.first == id; });
+  if (event == pending_events.rend()) {
+    return;
+  }
+
+  CounterValues counter_values;
+  for (size_t i = 0; i < values.size(); ++i) {
+    counter_values.emplace_back(thread_counters.counters[i], values[i] - event->second[i]);
+  }
+  pending_events.erase(std::next(event).base(), pending_events.end());
+
+  std::lock_guard<OrtMutex> lock(mutex_);
+  stopped_events_[{static_cast<int>(logging::GetThreadId()), id}].push_back(std::move(counter_values));
+#else
+  ORT_UNUSED_PARAMETER(id);
+#endif
+}
+
+void CpuHardwareCounterProfiler::AddCounterValues(Events& events) {
+  std::lock_guard<OrtMutex> lock(mutex_);
+  for (auto& event : events) {
+    // the events record the time at which their ep profilers were started
+    auto stopped_event = stopped_events_.find({event.tid, static_cast<uint64_t>(event.ts)});
+    if (stopped_event == stopped_events_.end()) {
+      continue;
+    }
+
+    uint64_t cycles = 0;
+    uint64_t instructions = 0;
+    uint64_t llc_misses = 0;
+    for (const auto& [counter, value] : stopped_event->second.front()) {
+      const std::string name = kHardwareCounters[counters_[counter]].name;
+      event.args[name] = std::to_string(value);
+      if (name == "cycles") {
+        cycles = value;
+      } else if (name == "instructions") {
+        instructions = value;
+      } else if (name == "llc_load_misses" || name == "llc_store_misses") {
+        llc_misses += value;
+      }
+    }
+
+    if (cycles > 0 && instructions > 0) {
+      std::ostringstream ipc;
+      ipc << std::fixed << std::setprecision(2) << static_cast<double>(instructions) / static_cast<double>(cycles);
+      event.args["ipc"] = ipc.str();
+    }
+    if (llc_misses > 0) {
+      event.args["llc_miss_bytes"] = std::to_string(llc_misses * kCacheLineSize);
+    }
+
+    stopped_event->second.pop_front();
+    if (stopped_event->second.empty()) {
+      stopped_events_.erase(stopped_event);
+    }
+  }
+}
+
+void CpuHardwareCounterProfiler::Flush(TimePoint /*start_time*/, Events& events) {
+  AddCounterValues(events);
+}
+
+void CpuHardwareCounterProfiler::EndProfiling(TimePoint /*start_time*/, Events& events) {
+  AddCounterValues(events);
+  std::lock_guard<OrtMutex> lock(mutex_);
+  stopped_events_.clear();
+}
+
+}  // namespace profiling
+}  // namespace onnxruntime
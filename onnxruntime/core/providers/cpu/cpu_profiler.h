@@ -0,0 +1,83 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <deque>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/logging/logging.h"
+#include "core/common/profiler_common.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+namespace profiling {
+
+/**
+ * Reads hardware performance counters around the profiled events of the CPU execution provider and adds their
+ * values, e.g. the cycles, instructions and last level cache misses of each node run, to the event args.
+ * The counters are read with perf_event_open and are only available on Linux.
+ * They count the events of the thread that records the profiled event, so the work that a node hands to the
+ * intra-op thread pool workers is not included.
+ */
+class CpuHardwareCounterProfiler final : public EpProfiler {
+ public:
+  /*
+  Creates a profiler that reads the given comma separated counters, see GetSupportedCounterNames.
+  */
+  static Status Create(const std::string& counter_names, const logging::Logger& logger,
+                       std::unique_ptr<EpProfiler>& profiler);
+
+  static std::vector<std::string> GetSupportedCounterNames();
+
+  ~CpuHardwareCounterProfiler();
+
+  bool StartProfiling(TimePoint profiling_start_time) override;
+  void EndProfiling(TimePoint start_time, Events& events) override;
+  void Flush(TimePoint start_time, Events& events) override;
+  void Start(uint64_t id) override;
+  void Stop(uint64_t id) override;
+
+ private:
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CpuHardwareCounterProfiler);
+
+  // the counters opened for a thread, and the values read at the start of its pending events
+  struct ThreadCounters {
+    std::vector<int> fds;                   // the first one leads the group
+    std::vector<size_t> counters;           // index in counters_ of each fd
+    std::vector<std::pair<uint64_t, std::vector<uint64_t>>> pending_events;  // id, values at the start
+    bool available = false;
+  };
+
+  // counter index in counters_ and value
+  using CounterValues = std::vector<std::pair<size_t, uint64_t>>;
+
+  CpuHardwareCounterProfiler(std::vector<size_t> counters, const logging::Logger& logger);
+
+  ThreadCounters& GetThreadCounters();
+  // Requires mutex_ to be held.
+  void OpenCounters(ThreadCounters& thread_counters);
+
+  // attaches the values of the counters to the events that were stopped
+  void AddCounterValues(Events& events);
+
+  // indices of the counters in the table of supported counters
+  const std::vector<size_t> counters_;
+  const logging::Logger& logger_;
+
+  OrtMutex mutex_;
+  std::unordered_map<std::thread::id, std::unique_ptr<ThreadCounters>> thread_counters_;  // GUARDED_BY(mutex_)
+  // values of the stopped events by thread id and start time, in the order in which they were stopped
+  std::map<std::pair<int, uint64_t>, std::deque<CounterValues>> stopped_events_;  // GUARDED_BY(mutex_)
+  bool logged_open_failure_ = false;                                              // GUARDED_BY(mutex_)
+};
+
+}  // namespace profiling
+}  // namespace onnxruntime
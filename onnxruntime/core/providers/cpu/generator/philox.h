@@ -0,0 +1,136 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+
+#include "core/common/gsl.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace philox {
+
+/**
+ * Philox4x32-10 counter-based generator (Salmon et al., "Parallel random numbers: as easy as 1, 2, 3"), the
+ * generator behind the PhiloxGenerator seeds of the CUDA random kernels.
+ *
+ * Block b of the stream (seed, offset) is the 4 random words of counter offset + b under key seed, so any block
+ * can be computed on its own: the Fill functions split the blocks of the output across the threadpool and produce
+ * the same values for any number of threads. PhiloxGenerator::NextPhiloxSeeds(NumBlocks<T>(size)) returns the
+ * (seed, offset) of the next call.
+ */
+using Counter = std::array<uint32_t, 4>;
+using Key = std::array<uint32_t, 2>;
+
+inline Counter Philox4x32(Counter counter, Key key) {
+  constexpr uint32_t kMultiplier0 = 0xD2511F53;
+  constexpr uint32_t kMultiplier1 = 0xCD9E8D57;
+  constexpr uint32_t kWeyl0 = 0x9E3779B9;
+  constexpr uint32_t kWeyl1 = 0xBB67AE85;
+  constexpr int kRounds = 10;
+
+  for (int round = 0; round < kRounds; ++round) {
+    if (round > 0) {
+      key[0] += kWeyl0;
+      key[1] += kWeyl1;
+    }
+    const uint64_t product0 = static_cast<uint64_t>(kMultiplier0) * counter[0];
+    const uint64_t product1 = static_cast<uint64_t>(kMultiplier1) * counter[2];
+    counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0], static_cast<uint32_t>(product1),
+               static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1], static_cast<uint32_t>(product0)};
+  }
+  return counter;
+}
+
+inline Counter Block(uint64_t seed, uint64_t offset, uint64_t block) {
+  const uint64_t counter = offset + block;
+  return Philox4x32({static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32), 0, 0},
+                    {static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)});
+}
+
+// Number of values drawn from a block: one word per float, two words per double.
+template <typename T>
+constexpr size_t kValuesPerBlock = sizeof(T) == sizeof(uint32_t) ? 4 : 2;
+
+template <typename T>
+uint64_t NumBlocks(size_t size) {
+  static_assert(std::is_same_v<T, float> || std::is_same_v<T, double>, "Philox only generates float or double.");
+  return (static_cast<uint64_t>(size) + kValuesPerBlock<T> - 1) / kValuesPerBlock<T>;
+}
+
+// Uniform value in [0, 1) from the 24 high bits of a word.
+inline float ToUniformFloat(uint32_t x) {
+  return static_cast<float>(x >> 8) * (1.0f / 16777216.0f);
+}
+
+// Uniform value in [0, 1) from the 53 high bits of two words.
+inline double ToUniformDouble(uint32_t hi, uint32_t lo) {
+  const uint64_t x = (static_cast<uint64_t>(hi) << 32) | lo;
+  return static_cast<double>(x >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// Fills out with the values of the blocks of the stream (seed, offset). block_values(block, values) writes the
+// kValuesPerBlock<T> values of a block, for values of type T mapped to TOut; cost is that of one block.
+template <typename T, typename TOut = T, typename BlockValues>
+void Fill(uint64_t seed, uint64_t offset, gsl::span<TOut> out, const TensorOpCost& cost,
+          concurrency::ThreadPool* threadpool, BlockValues block_values) {
+  const size_t size = out.size();
+  concurrency::ThreadPool::TryParallelFor(
+      threadpool, static_cast<std::ptrdiff_t>(NumBlocks<T>(size)), cost,
+      [seed, offset, size, out = out.data(), &block_values](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t b = first; b < last; ++b) {
+          TOut values[kValuesPerBlock<T>];
+          block_values(Block(seed, offset, static_cast<uint64_t>(b)), values);
+          const size_t begin = static_cast<size_t>(b) * kValuesPerBlock<T>;
+          std::copy_n(values, std::min(kValuesPerBlock<T>, size - begin), out + begin);
+        }
+      });
+}
+
+// Fills out with values uniformly distributed in [low, high).
+template <typename T>
+void FillUniform(uint64_t seed, uint64_t offset, T low, T high, gsl::span<T> out,
+                 concurrency::ThreadPool* threadpool) {
+  const T range = high - low;
+  const TensorOpCost cost{0, static_cast<double>(sizeof(T) * kValuesPerBlock<T>), 40};
+  Fill<T>(seed, offset, out, cost, threadpool, [low, range](const Counter& words, T* values) {
+    if constexpr (std::is_same_v<T, float>) {
+      for (size_t i = 0; i < 4; ++i) {
+        values[i] = low + range * ToUniformFloat(words[i]);
+      }
+    } else {
+      values[0] = low + range * ToUniformDouble(words[0], words[1]);
+      values[1] = low + range * ToUniformDouble(words[2], words[3]);
+    }
+  });
+}
+
+// Fills out with normally distributed values, using the Box-Muller transform of pairs of uniform values.
+template <typename T>
+void FillNormal(uint64_t seed, uint64_t offset, T mean, T scale, gsl::span<T> out,
+                concurrency::ThreadPool* threadpool) {
+  constexpr T kTwoPi = static_cast<T>(6.283185307179586);
+  // one minus the uniform value is in (0, 1], so that its log is finite
+  auto box_muller = [mean, scale](T u1, T u2, T* values) {
+    const T radius = scale * std::sqrt(T(-2) * std::log(T(1) - u1));
+    values[0] = mean + radius * std::cos(kTwoPi * u2);
+    values[1] = mean + radius * std::sin(kTwoPi * u2);
+  };
+  const TensorOpCost cost{0, static_cast<double>(sizeof(T) * kValuesPerBlock<T>), 160};
+  Fill<T>(seed, offset, out, cost, threadpool, [&box_muller](const Counter& words, T* values) {
+    if constexpr (std::is_same_v<T, float>) {
+      box_muller(ToUniformFloat(words[0]), ToUniformFloat(words[1]), values);
+      box_muller(ToUniformFloat(words[2]), ToUniformFloat(words[3]), values + 2);
+    } else {
+      box_muller(ToUniformDouble(words[0], words[1]), ToUniformDouble(words[2], words[3]), values);
+    }
+  });
+}
+
+}  // namespace philox
+}  // namespace onnxruntime
@@ -28,6 +28,7 @@ limitations under the License.
 #include "core/common/eigen_common_wrapper.h"
 #include "core/common/safeint.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/providers/cpu/generator/philox.h"
 #include "core/providers/op_kernel_type_control.h"
 #include "core/util/math_cpuonly.h"
 
@@ -126,11 +127,10 @@ ONNX_CPU_OPERATOR_KERNEL(
                         BuildKernelDefConstraintsFromTypeList<EnabledMultinomialOutputTypes>()),
     Multinomial);
 
-template <typename T, typename TDistribution>
-void GenerateData(std::default_random_engine& generator, TDistribution distribution, Tensor& tensor);
-
-static Status RandomNormalCompute(float mean, float scale, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
-static Status RandomUniformCompute(float high, float low, std::default_random_engine& generator, TensorProto::DataType dtype, Tensor& Y);
+static Status RandomNormalCompute(float mean, float scale, PhiloxGenerator& generator, TensorProto::DataType dtype,
+                                  Tensor& Y, concurrency::ThreadPool* threadpool);
+static Status RandomUniformCompute(float low, float high, PhiloxGenerator& generator, TensorProto::DataType dtype,
+                                   Tensor& Y, concurrency::ThreadPool* threadpool);
 
 static Status CreateOutputTensorFromTensorShape(OpKernelContext* ctx, const Tensor& X, Tensor** Y);
 static TensorProto::DataType InferDataType(const Tensor& tensor);
@@ -138,8 +138,7 @@ static TensorProto::DataType InferDataType(const Tensor& tensor);
 Status RandomNormal::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  auto status = RandomNormalCompute(mean_, scale_, generator_, dtype_, Y);
+  auto status = RandomNormalCompute(mean_, scale_, generator_, dtype_, Y, ctx->GetOperatorThreadPool());
 
   return status;
 }
@@ -147,8 +146,7 @@ Status RandomNormal::Compute(OpKernelContext* ctx) const {
 Status RandomUniform::Compute(OpKernelContext* ctx) const {
   Tensor& Y = *ctx->Output(0, shape_);
 
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  auto status = RandomUniformCompute(low_, high_, generator_, dtype_, Y);
+  auto status = RandomUniformCompute(low_, high_, generator_, dtype_, Y, ctx->GetOperatorThreadPool());
 
   return status;
 }
@@ -169,8 +167,7 @@ Status RandomNormalLike::Compute(OpKernelContext* ctx) const {
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
 
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  status = RandomNormalCompute(mean_, scale_, generator_, dtype, *Y);
+  status = RandomNormalCompute(mean_, scale_, generator_, dtype, *Y, ctx->GetOperatorThreadPool());
 
   return status;
 }
@@ -190,8 +187,7 @@ Status RandomUniformLike::Compute(OpKernelContext* ctx) const {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
                            "Could not infer data type from input tensor with data type ",
                            X.DataType());
-  std::lock_guard<onnxruntime::OrtMutex> l(generator_mutex_);
-  status = RandomUniformCompute(low_, high_, generator_, dtype, *Y);
+  status = RandomUniformCompute(low_, high_, generator_, dtype, *Y, ctx->GetOperatorThreadPool());
 
   return status;
 }
@@ -346,23 +342,39 @@ static TensorProto::DataType InferDataType(const Tensor& tensor) {
   return static_cast<TensorProto::DataType>(dtype);
 }
 
+// Fills Y from the next range of Philox counters of generator, in parallel on threadpool.
+template <typename T>
+static void GenerateNormalData(PhiloxGenerator& generator, float mean, float scale, Tensor& Y,
+                               concurrency::ThreadPool* threadpool) {
+  auto out = Y.MutableDataAsSpan<T>();
+  const auto seeds = generator.NextPhiloxSeeds(philox::NumBlocks<T>(out.size()));
+  philox::FillNormal<T>(seeds.first, seeds.second, static_cast<T>(mean), static_cast<T>(scale), out, threadpool);
+}
+
+template <typename T>
+static void GenerateUniformData(PhiloxGenerator& generator, float low, float high, Tensor& Y,
+                                concurrency::ThreadPool* threadpool) {
+  auto out = Y.MutableDataAsSpan<T>();
+  const auto seeds = generator.NextPhiloxSeeds(philox::NumBlocks<T>(out.size()));
+  philox::FillUniform<T>(seeds.first, seeds.second, static_cast<T>(low), static_cast<T>(high), out, threadpool);
+}
+
 static Status RandomNormalCompute(float mean, float scale,
-                                  std::default_random_engine& generator,
-                                  TensorProto::DataType dtype, Tensor& Y) {
+                                  PhiloxGenerator& generator,
+                                  TensorProto::DataType dtype, Tensor& Y,
+                                  concurrency::ThreadPool* threadpool) {
   bool handled = false;
   switch (dtype) {
     case TensorProto::FLOAT: {
       if (utils::HasType<EnabledRandomNormalComputeOutputTypes, float>()) {
-        GenerateData<float, std::normal_distribution<float>>(
-            generator, std::normal_distribution<float>{mean, scale}, Y);
+        GenerateNormalData<float>(generator, mean, scale, Y, threadpool);
         handled = true;
       }
       break;
     }
     case TensorProto::DOUBLE: {
       if (utils::HasType<EnabledRandomNormalComputeOutputTypes, double>()) {
-        GenerateData<double, std::normal_distribution<double>>(
-            generator, std::normal_distribution<double>{mean, scale}, Y);
+        GenerateNormalData<double>(generator, mean, scale, Y, threadpool);
         handled = true;
       }
       break;
@@ -379,23 +391,22 @@ static Status RandomNormalCompute(float mean, float scale,
 }
 
 static Status RandomUniformCompute(float low, float high,
-                                   std::default_random_engine& generator,
+                                   PhiloxGenerator& generator,
                                    TensorProto::DataType dtype,
-                                   Tensor& Y) {
+                                   Tensor& Y,
+                                   concurrency::ThreadPool* threadpool) {
   bool handled = false;
   switch (dtype) {
     case TensorProto::FLOAT: {
       if (utils::HasType<EnabledRandomUniformComputeOutputTypes, float>()) {
-        GenerateData<float, std::uniform_real_distribution<float>>(
-            generator, std::uniform_real_distribution<float>{low, high}, Y);
+        GenerateUniformData<float>(generator, low, high, Y, threadpool);
         handled = true;
       }
       break;
     }
     case TensorProto::DOUBLE: {
       if (utils::HasType<EnabledRandomUniformComputeOutputTypes, double>()) {
-        GenerateData<double, std::uniform_real_distribution<double>>(
-            generator, std::uniform_real_distribution<double>{low, high}, Y);
+        GenerateUniformData<double>(generator, low, high, Y, threadpool);
         handled = true;
       }
       break;
@@ -411,15 +422,6 @@ static Status RandomUniformCompute(float low, float high,
   return Status::OK();
 }
 
-template <typename T, typename TDistribution>
-void GenerateData(std::default_random_engine& generator, TDistribution distribution, Tensor& tensor) {
-  T* out = tensor.MutableData<T>();
-  for (int64_t i = 0, end = tensor.Shape().Size(); i < end; ++i) {
-    *out = distribution(generator);
-    ++out;
-  }
-}
-
 template Status MultinomialComputeShared<int64_t>(AllocatorPtr& alloc,
                                                   const Tensor& X,
                                                   const int64_t batch_size,
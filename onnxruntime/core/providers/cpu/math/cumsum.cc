@@ -3,49 +3,95 @@
 
 #include "cumsum.h"
 #include "core/providers/common.h"
-#include "core/providers/cpu/tensor/utils.h"
 #include "core/framework/op_kernel.h"
 #include "core/framework/tensorprotoutils.h"
+#include "core/platform/threadpool.h"
+
+#include <algorithm>
+#include <numeric>
 
 using namespace onnxruntime;
 
 namespace {
 // static section
-std::vector<int64_t> GetStarts(int64_t rank, int64_t axis, int64_t index) {
-  std::vector<int64_t> starts(onnxruntime::narrow<size_t>(rank), 0);
-  starts[onnxruntime::narrow<size_t>(axis)] = index;
-  return starts;
-}
+
+// Rows of the axis longer than this are scanned in parallel blocks when there are too few rows to keep the threads
+// busy.
+constexpr int64_t kScanBlockSize = 16384;
+
+// Scans `count` contiguous columns of a (dim, stride) view, one row of the axis at a time, so that the inner loop
+// runs over contiguous memory and is vectorized by the compiler.
 template <typename T>
-void ZeroOutSliceAtIndex(Tensor& output, int64_t rank, int64_t axis, int64_t index,
-                         gsl::span<const int64_t> slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  T zero{};
-  auto output_starts(GetStarts(rank, axis, index));
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator) {
-    *output_iterator = zero;
+void ScanColumns(const T* input, T* output, int64_t dim, int64_t stride, int64_t count, bool exclusive, bool reverse) {
+  int64_t previous = 0;
+  for (int64_t step = 0; step < dim; ++step) {
+    const int64_t index = reverse ? dim - 1 - step : step;
+    T* out = output + index * stride;
+    if (step == 0) {
+      if (exclusive) {
+        std::fill_n(out, count, T{});
+      } else {
+        std::copy_n(input + index * stride, count, out);
+      }
+    } else {
+      // inclusive: out[i] = out[i - 1] + in[i], exclusive: out[i] = out[i - 1] + in[i - 1]
+      const T* in = input + (exclusive ? previous : index) * stride;
+      const T* prev = output + previous * stride;
+      for (int64_t k = 0; k < count; ++k) {
+        out[k] = prev[k] + in[k];
+      }
+    }
+    previous = index;
   }
 }
+
+// Scans the contiguous range [begin, end) of a row starting from `carry`, in the direction given by `reverse`.
 template <typename T>
-void CopySlices(const Tensor& input, Tensor& output,
-                const std::vector<int64_t>& input_starts, const std::vector<int64_t>& output_starts,
-                gsl::span<const int64_t> slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  SliceIterator<T> input_iterator(input, input_starts, slice_dims, steps);
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator, ++input_iterator) {
-    *output_iterator = *input_iterator;
+void ScanRange(const T* input, T* output, int64_t begin, int64_t end, T carry, bool exclusive, bool reverse) {
+  for (int64_t step = begin; step < end; ++step) {
+    const int64_t index = reverse ? end - 1 - (step - begin) : step;
+    if (exclusive) {
+      output[index] = carry;
+      carry += input[index];
+    } else {
+      carry += input[index];
+      output[index] = carry;
+    }
   }
 }
+
+// Two pass blocked scan of one contiguous row: the sums of the blocks are computed in parallel, scanned
+// sequentially, then each block is scanned in parallel from the sum of the blocks before it.
 template <typename T>
-void SumSlices(const Tensor& input, Tensor& output,
-               const std::vector<int64_t>& input_starts, const std::vector<int64_t>& output_starts, const std::vector<int64_t>& previous_output_starts,
-               gsl::span<const int64_t> slice_dims, const std::vector<int64_t>& steps, const int64_t slice_size) {
-  SliceIterator<T> input_iterator(input, input_starts, slice_dims, steps);
-  WritableSliceIterator<T> output_iterator(output, output_starts, slice_dims, steps);
-  SliceIterator<T> previous_output_iterator(output, previous_output_starts, slice_dims, steps);
-  for (int64_t k = 0; k < slice_size; ++k, ++output_iterator, ++input_iterator, ++previous_output_iterator) {
-    *output_iterator = *input_iterator + *previous_output_iterator;
+void ScanRowBlocked(const T* input, T* output, int64_t dim, bool exclusive, bool reverse,
+                    concurrency::ThreadPool* tp) {
+  const int64_t num_blocks = (dim + kScanBlockSize - 1) / kScanBlockSize;
+  std::vector<T> carries(onnxruntime::narrow<size_t>(num_blocks));
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_blocks, static_cast<double>(kScanBlockSize), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t b = first; b < last; ++b) {
+          const int64_t begin = b * kScanBlockSize;
+          const int64_t end = std::min(begin + kScanBlockSize, dim);
+          carries[b] = std::accumulate(input + begin, input + end, T{});
+        }
+      });
+
+  T carry{};
+  for (int64_t step = 0; step < num_blocks; ++step) {
+    const int64_t b = reverse ? num_blocks - 1 - step : step;
+    const T block_sum = carries[onnxruntime::narrow<size_t>(b)];
+    carries[onnxruntime::narrow<size_t>(b)] = carry;
+    carry += block_sum;
   }
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_blocks, static_cast<double>(kScanBlockSize), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t b = first; b < last; ++b) {
+          const int64_t begin = b * kScanBlockSize;
+          const int64_t end = std::min(begin + kScanBlockSize, dim);
+          ScanRange(input, output, begin, end, carries[b], exclusive, reverse);
+        }
+      });
 }
 }  // namespace
 
@@ -200,64 +246,39 @@ Status CumSum<T>::Compute(OpKernelContext* ctx) const {
   int64_t axis = 0;
   ORT_THROW_IF_ERROR(cumsum_op::GetAxis(axis_tensor, rank, axis));
 
-  auto dim(output_tensor.Shape()[onnxruntime::narrow<size_t>(axis)]);    // dimension size for the axis
-  TensorShape slice_shape(input->Shape());  // the shape of one slice of input/output for the given value of the axis
-  slice_shape[onnxruntime::narrow<size_t>(axis)] = 1;
-  auto slice_size(slice_shape.Size());     // total number of elements in each slice
-  auto slice_dims(slice_shape.GetDims());  // dim array for the slice
-
-  std::vector<int64_t> steps(onnxruntime::narrow<size_t>(rank), 1);  // steps for the slice -- always set to 1
-
-  if (!reverse_) {
-    int64_t index(0);  // the index we use as we walkthrough the given axis
-    // If (exclusive == true) the first slice is always 0
-    if (exclusive_) {
-      ::ZeroOutSliceAtIndex<T>(output_tensor, rank, axis, index, slice_dims, steps, slice_size);
-      ++index;
-    }
-    {
-      // The next slice is a copy of the input (if exclusive == false then this is the first slice)
-      auto input_starts(::GetStarts(rank, axis, 0));
-      auto output_starts(::GetStarts(rank, axis, index));
-      ::CopySlices<T>(*input, output_tensor, input_starts, output_starts, slice_dims, steps, slice_size);
-      ++index;
-    }
-
-    for (; index < dim; ++index) {
-      // Each output slice is the sum of corresponding input slice and the previous output slice
-      auto input_starts(::GetStarts(rank, axis, exclusive_ ? index - 1 : index));
-      auto output_starts(::GetStarts(rank, axis, index));
-      auto previous_starts(::GetStarts(rank, axis, index - 1));
-      ::SumSlices<T>(*input, output_tensor, input_starts, output_starts, previous_starts,
-                     slice_dims, steps, slice_size);
-    }
-  } else {
-    //_reverse == true
-    int64_t index(dim - 1);  // the index we use as we walkthrough the given axis
-    // If (exclusive == true) the first slice is always 0
-    if (exclusive_) {
-      ::ZeroOutSliceAtIndex<T>(output_tensor, rank, axis, index, slice_dims, steps, slice_size);
-      --index;
-    }
-
-    if (index >= 0) {
-      // The next slice is a copy of the input (if exclusive == false then this is the first slice)
-      auto input_starts(::GetStarts(rank, axis, dim - 1));
-      auto output_starts(::GetStarts(rank, axis, index));
-      ::CopySlices<T>(*input, output_tensor, input_starts, output_starts, slice_dims, steps, slice_size);
-      --index;
-    }
-
-    for (; index >= 0; --index) {
-      // Each output slice is the sum of corresponding input slice and the previous output slice
-      auto input_starts(::GetStarts(rank, axis, exclusive_ ? index + 1 : index));
-      auto output_starts(::GetStarts(rank, axis, index));
-      auto previous_starts(::GetStarts(rank, axis, index + 1));
-      ::SumSlices<T>(*input, output_tensor, input_starts, output_starts, previous_starts,
-                     slice_dims, steps, slice_size);
+  // View the tensor as (outer, dim, stride), where dim is the size of the axis.
+  const auto& dims = input->Shape();
+  const int64_t dim = dims[onnxruntime::narrow<size_t>(axis)];
+  const int64_t outer = dims.SizeToDimension(onnxruntime::narrow<size_t>(axis));
+  const int64_t stride = dims.SizeFromDimension(onnxruntime::narrow<size_t>(axis) + 1);
+
+  const T* input_data = input->Data<T>();
+  T* output_data = output_tensor.MutableData<T>();
+  const bool exclusive = exclusive_ != 0;
+  const bool reverse = reverse_ != 0;
+  auto* tp = ctx->GetOperatorThreadPool();
+
+  if (stride == 1 && dim >= 2 * kScanBlockSize && outer < concurrency::ThreadPool::DegreeOfParallelism(tp)) {
+    for (int64_t o = 0; o < outer; ++o) {
+      ::ScanRowBlocked<T>(input_data + o * dim, output_data + o * dim, dim, exclusive, reverse, tp);
     }
+    return Status::OK();
   }
 
+  // Otherwise the (outer, stride) columns are split between the threads, and each thread scans its columns along
+  // the axis in runs of contiguous columns within the same outer index.
+  concurrency::ThreadPool::TryParallelFor(
+      tp, outer * stride, static_cast<double>(dim), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (int64_t column = first; column < last;) {
+          const int64_t o = column / stride;
+          const int64_t k = column % stride;
+          const int64_t count = std::min(stride - k, static_cast<int64_t>(last) - column);
+          const size_t offset = onnxruntime::narrow<size_t>(o * dim * stride + k);
+          ::ScanColumns<T>(input_data + offset, output_data + offset, dim, stride, count, exclusive, reverse);
+          column += count;
+        }
+      });
+
   return Status::OK();
 }
 
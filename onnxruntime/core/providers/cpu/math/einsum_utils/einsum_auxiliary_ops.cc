@@ -3,6 +3,9 @@
 
 #include "einsum_auxiliary_ops.h"
 
+#include "core/mlas/inc/mlas.h"
+#include "core/util/math_cpuonly.h"
+
 using namespace onnxruntime::common;
 
 namespace onnxruntime {
@@ -32,16 +35,66 @@ Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input
 template <typename T>
 Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+              size_t num_batches, size_t M, size_t K, size_t N, bool trans_left, bool trans_right,
+              concurrency::ThreadPool* tp,
               void* /*einsum_cuda_assets*/) {
-  for (size_t i = 0; i < num_batches; ++i) {
-    math::MatMul<T>(
-        static_cast<int>(M),
-        static_cast<int>(N),
-        static_cast<int>(K),
-        input_1_data + i * left_stride,
-        input_2_data + i * right_stride,
-        output_data + i * output_stride, tp);
+  if constexpr (std::is_same<T, float>::value) {
+    // Hand all the batches to MLAS at once so that small matrices are still spread across the thread pool
+    std::vector<MLAS_SGEMM_DATA_PARAMS> data(num_batches);
+    for (size_t i = 0; i < num_batches; ++i) {
+      data[i].A = input_1_data + i * left_stride;
+      data[i].lda = trans_left ? M : K;
+      data[i].B = input_2_data + i * right_stride;
+      data[i].ldb = trans_right ? K : N;
+      data[i].C = output_data + i * output_stride;
+      data[i].ldc = N;
+    }
+    MlasGemmBatch(trans_left ? CblasTrans : CblasNoTrans, trans_right ? CblasTrans : CblasNoTrans,
+                  M, N, K, data.data(), num_batches, tp);
+  } else if constexpr (std::is_same<T, double>::value) {
+    for (size_t i = 0; i < num_batches; ++i) {
+      math::Gemm<T, concurrency::ThreadPool>(
+          trans_left ? CblasTrans : CblasNoTrans,
+          trans_right ? CblasTrans : CblasNoTrans,
+          static_cast<ptrdiff_t>(M),
+          static_cast<ptrdiff_t>(N),
+          static_cast<ptrdiff_t>(K),
+          1.0,
+          input_1_data + i * left_stride,
+          input_2_data + i * right_stride,
+          0.0,
+          output_data + i * output_stride, tp);
+    }
+  } else if (!trans_left && !trans_right) {
+    for (size_t i = 0; i < num_batches; ++i) {
+      math::MatMul<T>(
+          static_cast<int>(M),
+          static_cast<int>(N),
+          static_cast<int>(K),
+          input_1_data + i * left_stride,
+          input_2_data + i * right_stride,
+          output_data + i * output_stride, tp);
+    }
+  } else {
+    // Eigen maps are column major, so compute the transpose of the output as op(B)^T * op(A)^T
+    const auto m = static_cast<ptrdiff_t>(M);
+    const auto n = static_cast<ptrdiff_t>(N);
+    const auto k = static_cast<ptrdiff_t>(K);
+    for (size_t i = 0; i < num_batches; ++i) {
+      auto output_mat = EigenMatrixMap<T>(output_data + i * output_stride, n, m);
+      const T* left_data = input_1_data + i * left_stride;
+      const T* right_data = input_2_data + i * right_stride;
+      if (trans_left && trans_right) {
+        output_mat.noalias() = ConstEigenMatrixMap<T>(right_data, k, n).transpose() *
+                               ConstEigenMatrixMap<T>(left_data, m, k).transpose();
+      } else if (trans_left) {
+        output_mat.noalias() = ConstEigenMatrixMap<T>(right_data, n, k) *
+                               ConstEigenMatrixMap<T>(left_data, m, k).transpose();
+      } else {
+        output_mat.noalias() = ConstEigenMatrixMap<T>(right_data, k, n).transpose() *
+                               ConstEigenMatrixMap<T>(left_data, k, m);
+      }
+    }
   }
 
   return Status::OK();
@@ -303,7 +356,8 @@ std::unique_ptr<Tensor> Transpose(const Tensor& input, const TensorShape& input_
 template <typename T>
 std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
                                const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
-                               AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
+                               bool trans_left, bool trans_right, AllocatorPtr allocator,
+                               concurrency::ThreadPool* tp, void* einsum_cuda_assets,
                                const DeviceHelpers::MatMul<T>& device_matmul_func) {
   // Sanity checks before the actual MatMul
   ORT_ENFORCE(input_1.DataType() == input_2.DataType(), "Data types of the inputs must match for MatMul");
@@ -335,7 +389,8 @@ std::unique_ptr<Tensor> MatMul(const Tensor& input_1, const gsl::span<const int6
   T* output_data = output->MutableData<T>();
 
   auto status = device_matmul_func(input_1_data, input_2_data, output_data,
-                                   left_offset, right_offset, output_offset, batches, M, K, N, tp, einsum_cuda_assets);
+                                   left_offset, right_offset, output_offset, batches, M, K, N,
+                                   trans_left, trans_right, tp, einsum_cuda_assets);
 
   if (!status.IsOK()) {
     ORT_THROW(ONNXRUNTIME, FAIL, "Einsum op: Exception during MatMul operation: ",
@@ -359,13 +414,14 @@ std::unique_ptr<Tensor> ReduceSum(const Tensor& input, const TensorShape& input_
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<float>(
     const float* input_1_data, const float* input_2_data, float* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_left, bool trans_right,
+    concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<float>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
-    AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
+    bool trans_left, bool trans_right, AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
     const DeviceHelpers::MatMul<float>& device_matmul_func);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<float>(
@@ -383,13 +439,14 @@ template std::unique_ptr<Tensor> ReduceSum<float>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<int32_t>(
     const int32_t* input_1_data, const int32_t* input_2_data, int32_t* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_left, bool trans_right,
+    concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<int32_t>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
-    AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
+    bool trans_left, bool trans_right, AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
     const DeviceHelpers::MatMul<int32_t>& device_matmul_func);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<int32_t>(
@@ -408,13 +465,14 @@ template std::unique_ptr<Tensor> ReduceSum<int32_t>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<double>(
     const double* input_1_data, const double* input_2_data, double* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_left, bool trans_right,
+    concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> MatMul<double>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
-    AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
+    bool trans_left, bool trans_right, AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
     const DeviceHelpers::MatMul<double>& device_matmul_func);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<double>(
@@ -433,7 +491,8 @@ template std::unique_ptr<Tensor> ReduceSum<double>(
 template Status DeviceHelpers::CpuDeviceHelpers::MatMul<int64_t>(
     const int64_t* input_1_data, const int64_t* input_2_data, int64_t* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_left, bool trans_right,
+    concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<int64_t>(
@@ -445,7 +504,7 @@ template std::unique_ptr<Tensor> DeviceHelpers::CpuDeviceHelpers::ReduceSum<int6
 template std::unique_ptr<Tensor> MatMul<int64_t>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
-    AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
+    bool trans_left, bool trans_right, AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
     const DeviceHelpers::MatMul<int64_t>& device_matmul_func);
 
 template std::unique_ptr<Tensor> ReduceSum<int64_t>(
@@ -457,7 +516,7 @@ template std::unique_ptr<Tensor> ReduceSum<int64_t>(
 template std::unique_ptr<Tensor> MatMul<MLFloat16>(
     const Tensor& input_1, const gsl::span<const int64_t>& input_shape_1_override,
     const Tensor& input_2, const gsl::span<const int64_t>& input_shape_2_override,
-    AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
+    bool trans_left, bool trans_right, AllocatorPtr allocator, concurrency::ThreadPool* tp, void* einsum_cuda_assets,
     const DeviceHelpers::MatMul<MLFloat16>& device_matmul_func);
 
 template std::unique_ptr<Tensor> ReduceSum<MLFloat16>(
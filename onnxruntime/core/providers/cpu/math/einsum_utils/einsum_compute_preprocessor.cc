@@ -48,6 +48,10 @@ const std::vector<TensorShape>& EinsumComputePreprocessor::GetHomogenizedInputDi
   return homogenized_input_dims_;
 }
 
+const std::vector<std::vector<int64_t>>& EinsumComputePreprocessor::GetInputSubscriptOrders() const {
+  return input_subscript_orders_;
+}
+
 const std::vector<int64_t>& EinsumComputePreprocessor::GetMappedSubscriptIndicesToLastInputIndex() const {
   return subscript_indices_to_last_input_;
 }
@@ -60,6 +64,10 @@ int64_t EinsumComputePreprocessor::GetNumSubscriptIndices() const {
   return num_subscript_indices_;
 }
 
+EinsumOp::ContractionPathCache& EinsumComputePreprocessor::GetContractionPathCache() {
+  return *einsum_equation_preprocessor_.contraction_path_cache_;
+}
+
 void EinsumComputePreprocessor::SetDeviceHelpers(const EinsumOp::DeviceHelpers::Diagonal& device_diagonal_func,
                                                  const EinsumOp::DeviceHelpers::Transpose& device_transpose_func) {
   device_diagonal_func_ = device_diagonal_func;
@@ -404,9 +412,10 @@ Status EinsumComputePreprocessor::CalculateOutputShape() {
 Status EinsumComputePreprocessor::PreprocessInputs() {
   preprocessed_inputs_.reserve(inputs_.size());
   homogenized_input_dims_.reserve(inputs_.size());
+  input_subscript_orders_.reserve(inputs_.size());
   // As part of input preprocessing we "homogenize" them by
-  // 1) Making them all of the same rank
-  // 2) The axes order in all the inputs are to be made the same
+  // 1) Parsing diagonals so that each subscript index occurs at most once in an input
+  // 2) Making them all of the same rank
   int64_t input_iter = 0;
   for (const auto* input : inputs_) {
     // Eventually will hold the "preprocessed" version of the original input
@@ -423,7 +432,7 @@ Status EinsumComputePreprocessor::PreprocessInputs() {
 
     std::vector<int64_t> subscript_indices_to_input_index(onnxruntime::narrow<size_t>(num_subscript_indices_), -1);
 
-    // This is the input dims after re-ordering so that all inputs have same axes order
+    // This is the dim value of each subscript index in this input (dims of value 1 for the ones it does not have)
     TensorShapeVector homogenized_input_dims(onnxruntime::narrow<size_t>(num_subscript_indices_), 1);
 
     // Preprocessed dim rank may not be the same as original input rank if we need to parse diagonals along the way
@@ -445,30 +454,31 @@ Status EinsumComputePreprocessor::PreprocessInputs() {
       ++dim_index_in_original_input;
     }
 
-    std::vector<size_t> permutation;
-    permutation.reserve(input_dims.size());
-    for (auto& d : subscript_indices_to_input_index) {
-      if (d != -1) {
-        permutation.push_back(static_cast<size_t>(d));
-      }
+    // Rather than transposing the input to the axes order shared by all inputs, record the order its axes are in.
+    // The operands are only transposed during the contraction if the MatMul cannot consume their layout directly.
+    // The subscript indices not in this input are appended as dims of value 1.
+    std::vector<int64_t> subscript_order(onnxruntime::narrow<size_t>(num_subscript_indices_), -1);
+    size_t absent_index = onnxruntime::narrow<size_t>(dim_index_in_preprocessed_input);
+    for (size_t subscript_index = 0; subscript_index < subscript_indices_to_input_index.size(); ++subscript_index) {
+      auto d = subscript_indices_to_input_index[subscript_index];
+      subscript_order[d != -1 ? onnxruntime::narrow<size_t>(d) : absent_index++] = static_cast<int64_t>(subscript_index);
     }
 
-    // (Identify no-op transpose and prevent triggering the transpose)
-    if (EinsumOp::IsTransposeRequired(preprocessed ? preprocessed->Shape().GetDims().size() : inputs_[onnxruntime::narrow<size_t>(input_iter)]->Shape().GetDims().size(),
-                                      permutation)) {
-      preprocessed = EinsumOp::Transpose(preprocessed ? *preprocessed : *inputs_[onnxruntime::narrow<size_t>(input_iter)],
-                                         preprocessed ? preprocessed->Shape().GetDims() : inputs_[onnxruntime::narrow<size_t>(input_iter)]->Shape().GetDims(),
-                                         permutation, allocator_, einsum_ep_assets_, device_transpose_func_);
+    TensorShapeVector ordered_input_dims;
+    ordered_input_dims.reserve(subscript_order.size());
+    for (auto subscript_index : subscript_order) {
+      ordered_input_dims.push_back(homogenized_input_dims[onnxruntime::narrow<size_t>(subscript_index)]);
     }
 
-    // pre-processed may be null if the input didn't have need diagonals parsed and didn't need transposing
-    // If the pre-processed inputs are null, we will use raw inputs in conjunction with "homogenized_input_dims" for
+    // pre-processed may be null if the input didn't have need diagonals parsed
+    // If the pre-processed inputs are null, we will use raw inputs in conjunction with "ordered_input_dims" for
     // downstream compute
-    if (preprocessed) {  // If the pre-processed version of the operand exists, reshape it to homogenized_input_dims
-      preprocessed->Reshape(homogenized_input_dims);
+    if (preprocessed) {  // If the pre-processed version of the operand exists, reshape it to ordered_input_dims
+      preprocessed->Reshape(ordered_input_dims);
     }
     preprocessed_inputs_.push_back(std::move(preprocessed));
-    homogenized_input_dims_.emplace_back(homogenized_input_dims);
+    homogenized_input_dims_.emplace_back(ordered_input_dims);
+    input_subscript_orders_.push_back(std::move(subscript_order));
 
     ++input_iter;
   }
@@ -14,6 +14,7 @@
 #pragma once
 
 #include "einsum_auxiliary_ops.h"
+#include "einsum_contraction_path.h"
 
 namespace onnxruntime {
 
@@ -76,9 +77,6 @@ struct EinsumEquationPreprocessor {
   }
 
   // Holds the pre-processed equation string
-  // In theory, we could re-write the einsum equation to lower overall cost of intermediate arrays
-  // See numpy.einsum_path for details/examples
-  // These are very advanced optimizations that we don't require for the average use-case
   std::string einsum_preprocessed_equation_;
 
   // In explicit form, holds the left side of the einsum equation
@@ -95,6 +93,11 @@ struct EinsumEquationPreprocessor {
 
   // Flag indicating if the Einsum op is being used in explicit form (i.e.) contains '->'
   bool is_explicit_ = false;
+
+  // Holds the contraction paths chosen for the input shapes seen so far (see numpy.einsum_path)
+  // Shared so that the copies made by each EinsumComputePreprocessor update the kernel's cache
+  std::shared_ptr<EinsumOp::ContractionPathCache> contraction_path_cache_ =
+      std::make_shared<EinsumOp::ContractionPathCache>();
 };
 
 // Prologue:
@@ -121,7 +124,6 @@ class EinsumComputePreprocessor final {
 
   // Pre-process inputs if needed - preprocessing includes -
   // 1) Parsing diagonals from raw inputs
-  // 2) Transposing some axes to match a chosen fixed ordering
   // This must be used in conjunction with its corresponding entry in homogenized_input_dims_
   // (returned by GetHomogenizedInputDims()).
   // If a particular entry is null, use raw inputs in conjunction with homogenized_input_dims_.
@@ -131,8 +133,13 @@ class EinsumComputePreprocessor final {
   const std::vector<const Tensor*>& GetRawInputTensors();
 
   // Get the "homogenized input dims" for each preprocessed/raw input
+  // All of them have a rank equal to the number of subscript indices, with the axes in the order given by
+  // GetInputSubscriptOrders() and a dim value of 1 for the subscript indices that the input doesn't have
   const std::vector<TensorShape>& GetHomogenizedInputDims();
 
+  // For each preprocessed/raw input, hold the subscript index of each axis of its homogenized dims
+  const std::vector<std::vector<int64_t>>& GetInputSubscriptOrders() const;
+
   // For each subscript index, hold the last input the subscript index was seen in
   const std::vector<int64_t>& GetMappedSubscriptIndicesToLastInputIndex() const;
 
@@ -142,6 +149,9 @@ class EinsumComputePreprocessor final {
   // Get the number of subscript indices (subscript labels) in the einsum equation
   int64_t GetNumSubscriptIndices() const;
 
+  // Get the cache of contraction paths of the Einsum kernel
+  EinsumOp::ContractionPathCache& GetContractionPathCache();
+
   // Pass-in device specific functions
   // (Pass-in CPU implementation or CUDA implementation function depending on the kernel using this class)
   void SetDeviceHelpers(const EinsumOp::DeviceHelpers::Diagonal& diagonal_func,
@@ -180,6 +190,9 @@ class EinsumComputePreprocessor final {
   // Holds the preprocessed inputs' homogenized dims
   std::vector<TensorShape> homogenized_input_dims_;
 
+  // Holds the subscript index of each axis of the preprocessed inputs' homogenized dims
+  std::vector<std::vector<int64_t>> input_subscript_orders_;
+
   // Count of unique subscript labels (subscript indices)
   // E.g. 1 : With equation -> 'ij, jk -> ik'
   // num_subscript_indices_ = 3 (i, j, k)
@@ -0,0 +1,241 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "einsum_contraction_path.h"
+
+#include <limits>
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+namespace {
+
+// Subscript indices are tracked as bits of a mask
+using LabelMask = uint64_t;
+constexpr size_t max_labels_for_path_search = 64;
+
+// Contract the operands in the order they were given: ((0, 1), 2), ...
+ContractionPath LeftToRightPath(size_t num_inputs) {
+  ContractionPath path;
+  if (num_inputs < 2) {
+    return path;
+  }
+  path.reserve(num_inputs - 1);
+  path.emplace_back(0, 1);
+  for (size_t input = 2; input < num_inputs; ++input) {
+    path.emplace_back(num_inputs + path.size() - 1, input);
+  }
+  return path;
+}
+
+class PathSearch {
+ public:
+  PathSearch(const std::vector<std::vector<int64_t>>& homogenized_input_dims,
+             const std::vector<int64_t>& subscript_indices_to_output_indices)
+      : num_inputs_(homogenized_input_dims.size()),
+        label_dims_(subscript_indices_to_output_indices.size(), 1.0),
+        input_labels_(num_inputs_, 0) {
+    for (size_t label = 0; label < subscript_indices_to_output_indices.size(); ++label) {
+      if (subscript_indices_to_output_indices[label] != -1) {
+        output_labels_ |= LabelMask{1} << label;
+      }
+    }
+
+    // Only non-trivial dims take part in the contractions, dims of value 1 are broadcasted
+    for (size_t input = 0; input < num_inputs_; ++input) {
+      const auto& dims = homogenized_input_dims[input];
+      for (size_t label = 0; label < dims.size(); ++label) {
+        if (dims[label] > 1) {
+          input_labels_[input] |= LabelMask{1} << label;
+          label_dims_[label] = static_cast<double>(dims[label]);
+        }
+      }
+    }
+  }
+
+  // Exhaustive search over all subsets of the inputs
+  ContractionPath Optimal() {
+    const size_t num_subsets = size_t{1} << num_inputs_;
+
+    // For each subset of inputs, the labels that remain after contracting the subset into a single operand
+    // (i.e.) the labels that are still needed by the output or by an input outside of the subset
+    std::vector<LabelMask> subset_labels(num_subsets, 0);
+    for (size_t subset = 1; subset < num_subsets; ++subset) {
+      LabelMask inside = 0;
+      LabelMask outside = 0;
+      for (size_t input = 0; input < num_inputs_; ++input) {
+        if (subset & (size_t{1} << input)) {
+          inside |= input_labels_[input];
+        } else {
+          outside |= input_labels_[input];
+        }
+      }
+      subset_labels[subset] = inside & (output_labels_ | outside);
+    }
+
+    cost_.assign(num_subsets, std::numeric_limits<double>::infinity());
+    split_.assign(num_subsets, 0);
+
+    for (size_t subset = 1; subset < num_subsets; ++subset) {
+      if ((subset & (subset - 1)) == 0) {
+        cost_[subset] = 0.0;  // A single input costs nothing
+        continue;
+      }
+
+      const size_t lowest = subset & (~subset + 1);
+      size_t highest = subset;
+      while (highest & (highest - 1)) {
+        highest &= highest - 1;
+      }
+
+      auto try_split = [&](size_t left) {
+        const size_t right = subset ^ left;
+        const double cost = cost_[left] + cost_[right] +
+                            Size(subset_labels[left] | subset_labels[right]);
+        if (cost < cost_[subset]) {
+          cost_[subset] = cost;
+          split_[subset] = left;
+        }
+      };
+
+      // Evaluate the left-to-right order first so that it is kept when nothing is cheaper
+      try_split(subset ^ highest);
+
+      // Enumerate the splits whose left part holds the lowest input of the subset so each split is seen once
+      for (size_t left = (subset - 1) & subset; left != 0; left = (left - 1) & subset) {
+        if ((left & lowest) != 0 && left != (subset ^ highest)) {
+          try_split(left);
+        }
+      }
+    }
+
+    ContractionPath path;
+    path.reserve(num_inputs_ - 1);
+    BuildPath(num_subsets - 1, path);
+    return path;
+  }
+
+  // Repeatedly contract the pair of remaining operands that shrinks the intermediate data the most
+  ContractionPath Greedy() const {
+    struct Operand {
+      size_t id;
+      LabelMask labels;
+    };
+
+    std::vector<Operand> remaining;
+    remaining.reserve(num_inputs_);
+    for (size_t input = 0; input < num_inputs_; ++input) {
+      remaining.push_back({input, input_labels_[input] & (output_labels_ | LabelsOutside(input))});
+    }
+
+    ContractionPath path;
+    path.reserve(num_inputs_ - 1);
+
+    while (remaining.size() > 1) {
+      size_t best_left = 0;
+      size_t best_right = 1;
+      LabelMask best_labels = 0;
+      double best_score = std::numeric_limits<double>::infinity();
+      double best_cost = std::numeric_limits<double>::infinity();
+
+      for (size_t left = 0; left < remaining.size(); ++left) {
+        for (size_t right = left + 1; right < remaining.size(); ++right) {
+          LabelMask outside = output_labels_;
+          for (size_t other = 0; other < remaining.size(); ++other) {
+            if (other != left && other != right) {
+              outside |= remaining[other].labels;
+            }
+          }
+
+          const LabelMask involved = remaining[left].labels | remaining[right].labels;
+          const LabelMask result = involved & outside;
+          const double score = Size(result) - Size(remaining[left].labels) - Size(remaining[right].labels);
+          const double cost = Size(involved);
+
+          if (score < best_score || (score == best_score && cost < best_cost)) {
+            best_left = left;
+            best_right = right;
+            best_labels = result;
+            best_score = score;
+            best_cost = cost;
+          }
+        }
+      }
+
+      path.emplace_back(remaining[best_left].id, remaining[best_right].id);
+
+      // best_left < best_right, so erasing best_right first keeps best_left valid
+      remaining.erase(remaining.begin() + best_right);
+      remaining.erase(remaining.begin() + best_left);
+      remaining.push_back({num_inputs_ + path.size() - 1, best_labels});
+    }
+
+    return path;
+  }
+
+ private:
+  double Size(LabelMask labels) const {
+    double size = 1.0;
+    for (size_t label = 0; labels != 0; ++label, labels >>= 1) {
+      if (labels & 1) {
+        size *= label_dims_[label];
+      }
+    }
+    return size;
+  }
+
+  LabelMask LabelsOutside(size_t input) const {
+    LabelMask labels = 0;
+    for (size_t other = 0; other < num_inputs_; ++other) {
+      if (other != input) {
+        labels |= input_labels_[other];
+      }
+    }
+    return labels;
+  }
+
+  // Appends the steps that contract `subset` to `path` and returns the id of the resulting operand
+  size_t BuildPath(size_t subset, ContractionPath& path) const {
+    if ((subset & (subset - 1)) == 0) {
+      size_t input = 0;
+      while ((subset >> input) != 1) {
+        ++input;
+      }
+      return input;
+    }
+
+    const size_t left = BuildPath(split_[subset], path);
+    const size_t right = BuildPath(subset ^ split_[subset], path);
+    path.emplace_back(left, right);
+    return num_inputs_ + path.size() - 1;
+  }
+
+  size_t num_inputs_;
+  std::vector<double> label_dims_;
+  std::vector<LabelMask> input_labels_;
+  LabelMask output_labels_ = 0;
+
+  // Best cost and split of each subset of inputs found by the exhaustive search
+  std::vector<double> cost_;
+  std::vector<size_t> split_;
+};
+
+}  // namespace
+
+ContractionPath FindContractionPath(const std::vector<std::vector<int64_t>>& homogenized_input_dims,
+                                    const std::vector<int64_t>& subscript_indices_to_output_indices) {
+  const size_t num_inputs = homogenized_input_dims.size();
+
+  // There is no choice to be made for fewer than 3 operands
+  if (num_inputs < 3 || subscript_indices_to_output_indices.size() > max_labels_for_path_search) {
+    return LeftToRightPath(num_inputs);
+  }
+
+  PathSearch search(homogenized_input_dims, subscript_indices_to_output_indices);
+  return num_inputs <= max_operands_for_optimal_path ? search.Optimal() : search.Greedy();
+}
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
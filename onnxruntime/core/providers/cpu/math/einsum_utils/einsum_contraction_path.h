@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// This module hosts the following abstractions -
+
+// 1) FindContractionPath - Chooses the order in which the Einsum operands are contracted pair-wise
+// so as to minimize the total number of multiply-adds (similar to numpy.einsum_path / opt_einsum)
+
+// 2) ContractionPathCache - Remembers the chosen path for each set of input shapes seen by a kernel
+
+#pragma once
+
+#include "core/platform/ort_mutex.h"
+
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace onnxruntime {
+
+namespace EinsumOp {
+
+// A contraction path is a sequence of pair-wise contractions.
+// Operands are identified by ids: the inputs are 0 ... num_inputs - 1 and the result of the i-th step of the path
+// is given the id num_inputs + i. Each step contracts the two operands it names and neither is used again.
+using ContractionPath = std::vector<std::pair<size_t, size_t>>;
+
+// Operands are exhaustively searched for the cheapest path up to this count and greedily beyond it
+constexpr size_t max_operands_for_optimal_path = 8;
+
+// Finds the contraction path for operands with the given homogenized dims (i.e.) each entry holds one dim value
+// per subscript index with `1` for indices that do not appear in the operand.
+// `subscript_indices_to_output_indices` holds -1 for subscript indices that are not part of the output.
+ContractionPath FindContractionPath(const std::vector<std::vector<int64_t>>& homogenized_input_dims,
+                                    const std::vector<int64_t>& subscript_indices_to_output_indices);
+
+// Caches contraction paths keyed by the homogenized dims of all inputs.
+// The path only depends on the equation and the input shapes, hence a kernel can re-use it across Compute() calls.
+class ContractionPathCache {
+ public:
+  using Key = std::vector<int64_t>;
+
+  // Returns true and fills `path` if a path has been cached for `key`
+  bool Lookup(const Key& key, ContractionPath& path) const {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    auto it = paths_.find(key);
+    if (it == paths_.end()) {
+      return false;
+    }
+    path = it->second;
+    return true;
+  }
+
+  void Insert(const Key& key, const ContractionPath& path) {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    // Bound the memory held for models that see a large variety of input shapes
+    if (paths_.size() >= max_cached_paths_) {
+      paths_.clear();
+    }
+    paths_.emplace(key, path);
+  }
+
+ private:
+  static constexpr size_t max_cached_paths_ = 64;
+
+  mutable OrtMutex mutex_;
+  std::map<Key, ContractionPath> paths_;
+};
+
+}  // namespace EinsumOp
+
+}  // namespace onnxruntime
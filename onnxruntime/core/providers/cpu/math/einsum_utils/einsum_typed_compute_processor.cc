@@ -95,10 +95,13 @@ static bool IsTransposeReshapeForEinsum(const gsl::span<const size_t>& perm,
 template <typename T>
 std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(const Tensor& left,
                                                                                const TensorShape& left_shape_override,
+                                                                               const gsl::span<const int64_t>& left_subscript_order,
                                                                                const Tensor& right,
                                                                                const TensorShape& right_shape_override,
+                                                                               const gsl::span<const int64_t>& right_subscript_order,
                                                                                const gsl::span<const int64_t>& reduce_dims,
-                                                                               bool is_final_pair) {
+                                                                               bool is_final_pair,
+                                                                               TensorShapeVector& output_subscript_order) {
   // Use the provided dim overrides instead of the actual shapes of the operands
   ORT_ENFORCE(left.Shape().Size() == left_shape_override.Size(),
               "The override dims are not compatible with given tensor's shape. ",
@@ -120,6 +123,17 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   ORT_ENFORCE(left_rank == right_rank,
               "Ranks of pair-wise operands must be equal. ",
               "Left shape: ", left.Shape(), " Right shape: ", right.Shape());
+  ORT_ENFORCE(left_subscript_order.size() == left_dims.size() && right_subscript_order.size() == right_dims.size(),
+              "Einsum op: Each axis of the pair-wise operands must be mapped to a subscript index");
+
+  // The operands need not have their axes in the same order.
+  // Following vectors hold the axis of each subscript index in the left and right operands.
+  InlinedVector<size_t> left_axes(left_dims.size());
+  InlinedVector<size_t> right_axes(right_dims.size());
+  for (size_t axis = 0; axis < left_dims.size(); ++axis) {
+    left_axes[onnxruntime::narrow<size_t>(left_subscript_order[axis])] = axis;
+    right_axes[onnxruntime::narrow<size_t>(right_subscript_order[axis])] = axis;
+  }
 
   // Following vectors hold:
   // lro: dim indices that are present in left, right, and reduce_dims
@@ -144,8 +158,10 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   size_t reduce_dims_size = reduce_dims.size();
 
   for (int64_t i = 0; i < left_rank; ++i) {
-    int64_t left_dim = left_dims[onnxruntime::narrow<size_t>(i)];
-    int64_t right_dim = right_dims[onnxruntime::narrow<size_t>(i)];
+    size_t left_axis = left_axes[onnxruntime::narrow<size_t>(i)];
+    size_t right_axis = right_axes[onnxruntime::narrow<size_t>(i)];
+    int64_t left_dim = left_dims[left_axis];
+    int64_t right_dim = right_dims[right_axis];
 
     bool has_left_dim = left_dim > 1;    // non-trivial dimension (dim_value != 1)
     bool has_right_dim = right_dim > 1;  // non-trivial dimension (dim_value != 1)
@@ -164,13 +180,15 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
         auto tensor_to_be_reduced_dims = current_left ? current_left->Shape().GetDims() : left_dims;
 
         current_left = EinsumOp::ReduceSum<T>(
-            tensor_to_be_reduced, tensor_to_be_reduced_dims, AsSpan({i}), allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
+            tensor_to_be_reduced, tensor_to_be_reduced_dims, AsSpan({static_cast<int64_t>(left_axis)}),
+            allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
       } else if (has_right_dim) {
         const Tensor& tensor_to_be_reduced = current_right ? *current_right : right;
         auto tensor_to_be_reduced_dims = current_right ? current_right->Shape().GetDims() : right_dims;
 
         current_right = EinsumOp::ReduceSum<T>(
-            tensor_to_be_reduced, tensor_to_be_reduced_dims, AsSpan({i}), allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
+            tensor_to_be_reduced, tensor_to_be_reduced_dims, AsSpan({static_cast<int64_t>(right_axis)}),
+            allocator_, tp_, einsum_ep_assets_, device_reduce_sum_func_);
       }
     } else {  // This dimension is not reduced (i.e.) it appears in the output after processing these 2 operands
       // Both the left and right operands have non-trivial dimension value along this axis
@@ -193,60 +211,67 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
     }
   }
 
-  // Permutate the left operand so that the axes order go like this: [lro, lo, reduce_dims, ro]
-  TensorShapeVector reshaped_dims;
-  InlinedVector<size_t> left_permutation;
-  left_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
-  left_permutation.insert(left_permutation.end(), lro.begin(), lro.end());
-  left_permutation.insert(left_permutation.end(), lo.begin(), lo.end());
-//  left_permutation.insert(left_permutation.end(), reduce_dims.begin(), reduce_dims.end());
-  for(auto & a : reduce_dims){
-    left_permutation.push_back(onnxruntime::narrow<size_t>(a));
+  // Returns the axes of an operand holding the given groups of subscript indices in turn
+  auto to_axes = [](const InlinedVector<size_t>& operand_axes,
+                    std::initializer_list<gsl::span<const size_t>> subscript_index_groups) {
+    InlinedVector<size_t> permutation;
+    permutation.reserve(operand_axes.size());
+    for (const auto& group : subscript_index_groups) {
+      for (auto subscript_index : group) {
+        permutation.push_back(operand_axes[subscript_index]);
+      }
+    }
+    return permutation;
+  };
+
+  InlinedVector<size_t> reduced;
+  reduced.reserve(reduce_dims.size());
+  for (auto& a : reduce_dims) {
+    reduced.push_back(onnxruntime::narrow<size_t>(a));
   }
-  left_permutation.insert(left_permutation.end(), ro.begin(), ro.end());
-  if (EinsumOp::IsTransposeRequired(current_left ? current_left->Shape().NumDimensions() : left_dims.size(),
-                                    left_permutation)) {
-    if (current_left && IsTransposeReshapeForEinsum(left_permutation,
-                                                    current_left->Shape().GetDims(),
-                                                    reshaped_dims)) {
-      // This can be done because curent_* tensors (if they exist) and output tensors are
-      // intermediate tensors and cannot be input tensors to the Einsum node itself
-      // (which are immutable).
-      // Covered by ExplicitEinsumAsTensorContractionReshapeLeft.
-      current_left->Reshape(reshaped_dims);
-    } else {
-      // Covered by ExplicitEinsumAsTensorContraction, DiagonalWithMatmul, ...
-      current_left = EinsumOp::Transpose(current_left ? *current_left : left,
-                                         current_left ? current_left->Shape().GetDims() : left_dims,
-                                         left_permutation, allocator_, einsum_ep_assets_,
-                                         device_transpose_func_);
+
+  TensorShapeVector reshaped_dims;
+
+  // Permutate the left operand so that the axes order go like this: [lro, lo, reduce_dims, ro]
+  // If the data is already laid out as [lro, reduce_dims, lo] instead, let the MatMul read it transposed
+  bool trans_left = false;
+  {
+    auto left_permutation = to_axes(left_axes, {lro, lo, reduced, ro});
+    auto current_left_dims = current_left ? current_left->Shape().GetDims() : left_dims;
+    // If the permutation only moves around dims with value 1, the data is already in the required order.
+    // The MatMul only looks at the shape overrides, so neither the input nor an intermediate needs to be reshaped.
+    // Covered by ExplicitEinsumAsTensorContractionReshapeLeft.
+    if (!IsTransposeReshapeForEinsum(left_permutation, current_left_dims, reshaped_dims)) {
+      if (IsTransposeReshapeForEinsum(to_axes(left_axes, {lro, reduced, lo, ro}), current_left_dims, reshaped_dims)) {
+        // Covered by ExplicitEinsumAsMatmulWithTransposedLeft, ...
+        trans_left = true;
+      } else {
+        // Covered by ExplicitEinsumAsTensorContraction, DiagonalWithMatmul, ...
+        current_left = EinsumOp::Transpose(current_left ? *current_left : left, current_left_dims,
+                                           left_permutation, allocator_, einsum_ep_assets_,
+                                           device_transpose_func_);
+      }
     }
   }
 
   // Permutate the right operand so that the axes order go like this: [lro, reduce_dims, ro, lo]
-  InlinedVector<size_t> right_permutation;
-  right_permutation.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
-  right_permutation.insert(right_permutation.end(), lro.begin(), lro.end());
-//  right_permutation.insert(right_permutation.end(), reduce_dims.begin(), reduce_dims.end());
-  for(auto & a : reduce_dims){
-    right_permutation.push_back(onnxruntime::narrow<size_t>(a));
-  }
-  right_permutation.insert(right_permutation.end(), ro.begin(), ro.end());
-  right_permutation.insert(right_permutation.end(), lo.begin(), lo.end());
-  if (EinsumOp::IsTransposeRequired(current_right ? current_right->Shape().GetDims().size() : right_dims.size(),
-                                    right_permutation)) {
-    if (current_right && IsTransposeReshapeForEinsum(right_permutation,
-                                                     current_right->Shape().GetDims(),
-                                                     reshaped_dims)) {
-      // See note following the previous call of function IsTransposeReshapeForEinsum.
-      // Covered by ExplicitEinsumAsBatchedMatmulWithBroadcasting_1, ExplicitEinsumAsMatmul_2, ...
-      current_right->Reshape(reshaped_dims);
-    } else {
-      // Covered by DiagonalWithMatmul, ExplicitEinsumAsBatchedMatmul, ...
-      current_right = EinsumOp::Transpose(current_right ? *current_right : right,
-                                          current_right ? current_right->Shape().GetDims() : right_dims,
-                                          right_permutation, allocator_, einsum_ep_assets_,
-                                          device_transpose_func_);
+  // If the data is already laid out as [lro, ro, reduce_dims] instead, let the MatMul read it transposed
+  bool trans_right = false;
+  {
+    auto right_permutation = to_axes(right_axes, {lro, reduced, ro, lo});
+    auto current_right_dims = current_right ? current_right->Shape().GetDims() : right_dims;
+    // See note preceding the previous call of function IsTransposeReshapeForEinsum.
+    // Covered by ExplicitEinsumAsBatchedMatmulWithBroadcasting_1, ExplicitEinsumAsMatmul_2, ...
+    if (!IsTransposeReshapeForEinsum(right_permutation, current_right_dims, reshaped_dims)) {
+      if (IsTransposeReshapeForEinsum(to_axes(right_axes, {lro, ro, reduced, lo}), current_right_dims, reshaped_dims)) {
+        // Covered by ExplicitEinsumAsMatmulWithTransposedRight, ...
+        trans_right = true;
+      } else {
+        // Covered by DiagonalWithMatmul, ExplicitEinsumAsBatchedMatmul, ...
+        current_right = EinsumOp::Transpose(current_right ? *current_right : right, current_right_dims,
+                                            right_permutation, allocator_, einsum_ep_assets_,
+                                            device_transpose_func_);
+      }
     }
   }
 
@@ -260,10 +285,10 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   TensorShapeVector output_dims;
   output_dims.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
   for (size_t i = 0; i < lro.size(); ++i) {
-    output_dims.push_back(left_dims[lro[i]]);
+    output_dims.push_back(left_dims[left_axes[lro[i]]]);
   }
   for (size_t i = 0; i < lo.size(); ++i) {
-    output_dims.push_back(left_dims[lo[i]]);
+    output_dims.push_back(left_dims[left_axes[lo[i]]]);
   }
 
   for (size_t i = 0; i < reduce_dims.size(); ++i) {
@@ -271,62 +296,28 @@ std::unique_ptr<Tensor> EinsumTypedComputeProcessor<T>::PairwiseOperandProcess(c
   }
 
   for (size_t i = 0; i < ro.size(); ++i) {
-    output_dims.push_back(right_dims[ro[i]]);
+    output_dims.push_back(right_dims[right_axes[ro[i]]]);
   }
 
-  TensorShapeVector current_subscript_order;
-
-  // Calculate output permutation
-  // After the MatMul op, the because the two operands have been permutated,
-  // the output is permutated as well with respect to the original ordering of the axes.
-  // The permutated order will be the dims in: [lro, lo, reduced_dims, ro]
-  // Hence invert the permutation by a permutation that puts the axes in the same ordering
-  InlinedVector<size_t> output_permutation;
-  if (!is_final_pair) {  // If this is not the final pair, we need to permutate the result to match the pre-fixed order for the next iteration
-    output_permutation.resize(lro.size() + lo.size() + reduce_dims.size() + ro.size(), 0);
-    size_t iter = 0;
-    for (size_t i = 0; i < lro.size(); ++i) {
-      output_permutation[lro[i]] = iter++;
-    }
-    for (size_t i = 0; i < lo.size(); ++i) {
-      output_permutation[lo[i]] = iter++;
-    }
-    for (size_t i = 0; i < reduce_dims.size(); ++i) {
-      output_permutation[onnxruntime::narrow<size_t>(reduce_dims[i])] = iter++;
-    }
-    for (size_t i = 0; i < ro.size(); ++i) {
-      output_permutation[ro[i]] = iter++;
-    }
-  } else {
-    current_subscript_order.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
-    current_subscript_order.insert(current_subscript_order.end(), lro.begin(), lro.end());
-    current_subscript_order.insert(current_subscript_order.end(), lo.begin(), lo.end());
-    current_subscript_order.insert(current_subscript_order.end(), reduce_dims.begin(), reduce_dims.end());
-    current_subscript_order.insert(current_subscript_order.end(), ro.begin(), ro.end());
-  }
+  // After the MatMul op, the axes of the output are the subscript indices in: [lro, lo, reduced_dims, ro]
+  // The output is left in this order as the next pair-wise operation accepts operands with any axes order
+  // (and permutes them only if required)
+  output_subscript_order.clear();
+  output_subscript_order.reserve(lro.size() + lo.size() + reduce_dims.size() + ro.size());
+  output_subscript_order.insert(output_subscript_order.end(), lro.begin(), lro.end());
+  output_subscript_order.insert(output_subscript_order.end(), lo.begin(), lo.end());
+  output_subscript_order.insert(output_subscript_order.end(), reduce_dims.begin(), reduce_dims.end());
+  output_subscript_order.insert(output_subscript_order.end(), ro.begin(), ro.end());
 
   // Multiply the mutated inputs
   auto output = EinsumOp::MatMul<T>(current_left ? *current_left : left, TensorShapeVector{lro_size, lo_size, reduced_size},
                                     current_right ? *current_right : right, TensorShapeVector{lro_size, reduced_size, ro_size},
-                                    allocator_, tp_, einsum_ep_assets_, device_matmul_func_);
+                                    trans_left, trans_right, allocator_, tp_, einsum_ep_assets_, device_matmul_func_);
 
   output->Reshape(output_dims);
 
-  if (!is_final_pair) {  // This is not the final pair - so bring the axes order to what the inputs conformed to
-    if (EinsumOp::IsTransposeRequired(output_dims.size(), output_permutation)) {
-      if (IsTransposeReshapeForEinsum(output_permutation,
-                                      output_dims,
-                                      reshaped_dims)) {
-        // See note following the previous call of function IsTransposeReshapeForEinsum.
-        // Covered by ExplicitEinsumAsTensorContractionReshapeFinal.
-        output->Reshape(reshaped_dims);
-      } else {
-        output = EinsumOp::Transpose(*output, output_dims, output_permutation, allocator_,
-                                     einsum_ep_assets_, device_transpose_func_);
-      }
-    }
-  } else {  // This is the final pair - Transpose directly to the output ordering required and copy the contents to the op's output
-    FinalizeOutput(*output, current_subscript_order);
+  if (is_final_pair) {  // This is the final pair - Transpose directly to the output ordering required and copy the contents to the op's output
+    FinalizeOutput(*output, output_subscript_order);
   }
 
   return output;
@@ -345,7 +336,7 @@ void EinsumTypedComputeProcessor<T>::SetDeviceHelpers(const EinsumOp::DeviceHelp
 
 template <typename T>
 Status EinsumTypedComputeProcessor<T>::Run() {
-  const auto& mapped_indices_to_last_input_index = einsum_compute_preprocessor_.GetMappedSubscriptIndicesToLastInputIndex();
+  const auto& subscript_indices_to_output_indices = einsum_compute_preprocessor_.GetMappedSubscriptIndicesToOutputindices();
 
   auto& preprocessed_inputs = einsum_compute_preprocessor_.GetPreprocessedInputTensors();
 
@@ -353,74 +344,144 @@ Status EinsumTypedComputeProcessor<T>::Run() {
 
   const auto& homogenized_input_dims = einsum_compute_preprocessor_.GetHomogenizedInputDims();
 
-  auto num_subscript_labels = einsum_compute_preprocessor_.GetNumSubscriptIndices();
-
-  auto num_inputs = context_->InputCount();
+  const auto& input_subscript_orders = einsum_compute_preprocessor_.GetInputSubscriptOrders();
+
+  auto num_subscript_labels = onnxruntime::narrow<size_t>(einsum_compute_preprocessor_.GetNumSubscriptIndices());
+
+  auto num_inputs = onnxruntime::narrow<size_t>(context_->InputCount());
+
+  // Operands are addressed by the ids used in the contraction path -
+  // the inputs come first and the result of each pair-wise contraction is appended after them
+  struct Operand {
+    const Tensor* tensor;  // null once the operand has been contracted
+    TensorShape dims;
+    TensorShapeVector subscript_order;           // The subscript index of each axis in `dims`
+    std::unique_ptr<const Tensor> intermediate;  // Owns `tensor` if it is not one of the raw inputs
+  };
+
+  std::vector<Operand> operands;
+  operands.reserve(2 * num_inputs - 1);
+  for (size_t input = 0; input < num_inputs; ++input) {
+    // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
+    Operand operand{raw_inputs[input], homogenized_input_dims[input],
+                    TensorShapeVector(input_subscript_orders[input].begin(), input_subscript_orders[input].end()),
+                    std::move(preprocessed_inputs[input])};
+    if (operand.intermediate) {
+      operand.tensor = operand.intermediate.get();
+    }
+    operands.push_back(std::move(operand));
+  }
 
-  // Pre-process the first input so as to reduce any dims that only it has
-  std::unique_ptr<const Tensor> result;
+  auto get_axis = [](const Operand& operand, size_t subscript_index) {
+    auto it = std::find(operand.subscript_order.begin(), operand.subscript_order.end(),
+                        static_cast<int64_t>(subscript_index));
+    return static_cast<size_t>(it - operand.subscript_order.begin());
+  };
 
-  {
-    TensorShapeVector reduced_dims;
-    TensorShapeVector preserved_dims;              // dims which were not reduced
-    TensorShapeVector preserved_shape;             // shape pertaining to only the dims that were preserved (not reduced)
-    reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));    // num_subscript_labels is the upper bound. No harm in over-reserving.
-    preserved_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving.
-
-    for (size_t i = 0; i < onnxruntime::narrow<size_t>(num_subscript_labels); ++i) {
-      if (mapped_indices_to_last_input_index[i] == 0) {
-        reduced_dims.push_back(i);
-      } else {
-        preserved_dims.push_back(i);
+  // A dim can be summed out as soon as no other remaining operand has it and it doesn't occur in the output
+  auto is_reducible = [&](size_t subscript_index, std::initializer_list<size_t> operand_ids) {
+    if (subscript_indices_to_output_indices[subscript_index] != -1) {
+      return false;
+    }
+    for (size_t id = 0; id < operands.size(); ++id) {
+      if (operands[id].tensor != nullptr &&
+          std::find(operand_ids.begin(), operand_ids.end(), id) == operand_ids.end() &&
+          operands[id].dims[get_axis(operands[id], subscript_index)] > 1) {
+        return false;
       }
     }
-
-    // Reduce the dims that are last seen in the first input alone
-    if (reduced_dims.size() != 0) {
-      result = EinsumOp::ReduceSum<T>(preprocessed_inputs[0] ? *preprocessed_inputs[0] : *raw_inputs[0],
-                                      homogenized_input_dims[0].GetDims(), reduced_dims, allocator_, tp_,
-                                      einsum_ep_assets_, device_reduce_sum_func_);
-    } else {
-      // Check if there is a pre-processed version of this input
-      // If so assign it to result
-      if (preprocessed_inputs[0]) {
-        result = std::move(preprocessed_inputs[0]);
+    return true;
+  };
+
+  // Pre-process each input so as to reduce any dims that only it has
+  for (size_t input = 0; input < num_inputs; ++input) {
+    TensorShapeVector reduced_axes;
+    reduced_axes.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving.
+    for (size_t axis = 0; axis < num_subscript_labels; ++axis) {
+      if (operands[input].dims[axis] > 1 &&
+          is_reducible(onnxruntime::narrow<size_t>(operands[input].subscript_order[axis]), {input})) {
+        reduced_axes.push_back(static_cast<int64_t>(axis));
       }
     }
 
-    // Finalize the output at this stage if num_inputs == 1
-    if (num_inputs == 1) {
-      // Finalize the output by applying any transpose required to get
-      // it to the required output ordering and move it to the op's output
-      FinalizeOutput(result ? *result : *raw_inputs[0], preserved_dims);
-
-      return Status::OK();
+    if (reduced_axes.size() != 0) {
+      std::unique_ptr<const Tensor> reduced = EinsumOp::ReduceSum<T>(*operands[input].tensor, operands[input].dims,
+                                                                     reduced_axes, allocator_, tp_,
+                                                                     einsum_ep_assets_, device_reduce_sum_func_);
+      operands[input].dims = reduced->Shape();
+      operands[input].tensor = reduced.get();
+      operands[input].intermediate = std::move(reduced);
     }
   }
 
-  // Process the operands in a pair-wise fashion
-  {
-    bool is_final_pair = false;
-    // Keep processing each input pair-wise
-    for (int input = 1; input < num_inputs; ++input) {
-      TensorShapeVector reduced_dims;
-      reduced_dims.reserve(onnxruntime::narrow<size_t>(num_subscript_labels));  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
-      for (int64_t dim = 0; dim < num_subscript_labels; ++dim) {
-        if (mapped_indices_to_last_input_index[onnxruntime::narrow<size_t>(dim)] == input) {
-          // This is the last input we are seeing this dimension (and it doesn't occur in the output), so reduce along the dimension
-          reduced_dims.push_back(dim);
+  // Finalize the output at this stage if num_inputs == 1
+  if (num_inputs == 1) {
+    // Finalize the output by applying any transpose required to get
+    // it to the required output ordering and move it to the op's output
+    FinalizeOutput(*operands[0].tensor, operands[0].subscript_order);
+
+    return Status::OK();
+  }
+
+  // Choose the order in which the operands are contracted. This only depends on the input shapes,
+  // so the path is searched for at the first Compute() call with a set of shapes and re-used afterwards.
+  EinsumOp::ContractionPath path;
+  if (num_inputs == 2) {
+    path.emplace_back(0, 1);
+  } else {
+    EinsumOp::ContractionPathCache::Key key;
+    key.reserve(num_inputs * num_subscript_labels);
+    for (size_t input = 0; input < num_inputs; ++input) {
+      const auto dims = homogenized_input_dims[input].GetDims();
+      key.insert(key.end(), dims.begin(), dims.end());
+    }
+
+    auto& contraction_path_cache = einsum_compute_preprocessor_.GetContractionPathCache();
+    if (!contraction_path_cache.Lookup(key, path)) {
+      // Search using the dims left after the pre-processing above, indexed by subscript index
+      std::vector<std::vector<int64_t>> operand_dims(num_inputs, std::vector<int64_t>(num_subscript_labels, 1));
+      for (size_t input = 0; input < num_inputs; ++input) {
+        for (size_t axis = 0; axis < num_subscript_labels; ++axis) {
+          operand_dims[input][onnxruntime::narrow<size_t>(operands[input].subscript_order[axis])] =
+              operands[input].dims[axis];
         }
       }
-      if (input == num_inputs - 1) {
-        is_final_pair = true;
+      path = EinsumOp::FindContractionPath(operand_dims, subscript_indices_to_output_indices);
+      contraction_path_cache.Insert(key, path);
+    }
+  }
+
+  // Process the operands in a pair-wise fashion following the contraction path
+  for (size_t step = 0; step < path.size(); ++step) {
+    const size_t left_id = path[step].first;
+    const size_t right_id = path[step].second;
+
+    TensorShapeVector reduced_dims;
+    reduced_dims.reserve(num_subscript_labels);  // num_subscript_labels is the upper bound. No harm in over-reserving by a small margin.
+    for (size_t subscript_index = 0; subscript_index < num_subscript_labels; ++subscript_index) {
+      // This is the last pair we are seeing this dimension in (and it doesn't occur in the output), so reduce along the dimension
+      if (is_reducible(subscript_index, {left_id, right_id})) {
+        reduced_dims.push_back(static_cast<int64_t>(subscript_index));
       }
-      // Use either the preprocessed inputs (if it is available) or the corresponding raw inputs
-      result = PairwiseOperandProcess(result ? *result : *raw_inputs[0],
-                                      result ? result->Shape() : homogenized_input_dims[0],
-                                      preprocessed_inputs[input] ? *preprocessed_inputs[input] : *raw_inputs[input],
-                                      homogenized_input_dims[input],
-                                      reduced_dims, is_final_pair);
     }
+
+    const bool is_final_pair = step == path.size() - 1;
+
+    TensorShapeVector result_subscript_order;
+    std::unique_ptr<const Tensor> result = PairwiseOperandProcess(*operands[left_id].tensor, operands[left_id].dims,
+                                                                  operands[left_id].subscript_order,
+                                                                  *operands[right_id].tensor, operands[right_id].dims,
+                                                                  operands[right_id].subscript_order,
+                                                                  reduced_dims, is_final_pair, result_subscript_order);
+
+    // Release the contracted operands as they are not used again
+    for (size_t id : {left_id, right_id}) {
+      operands[id].tensor = nullptr;
+      operands[id].intermediate.reset();
+    }
+
+    const Tensor* result_tensor = result.get();
+    operands.push_back(Operand{result_tensor, result->Shape(), std::move(result_subscript_order), std::move(result)});
   }
 
   return Status::OK();
@@ -40,13 +40,18 @@ class EinsumTypedComputeProcessor {
 
   // Processes Einsum operands in a pair-wise fashion
   // Employs Transpose, ReduceSum, and MatMul under the hood
-  // to achieve MatMul(a, b) and reduces (by summing) along specified axes
+  // to achieve MatMul(a, b) and reduces (by summing) along specified subscript indices
+  // Each operand comes with the subscript index of each of its axes and
+  // `output_subscript_order` receives the subscript index of each axis of the result
   std::unique_ptr<Tensor> PairwiseOperandProcess(const Tensor& left,
                                                  const TensorShape& left_shape_override,
+                                                 const gsl::span<const int64_t>& left_subscript_order,
                                                  const Tensor& right,
                                                  const TensorShape& right_shape_override,
+                                                 const gsl::span<const int64_t>& right_subscript_order,
                                                  const gsl::span<const int64_t>& reduce_dims,
-                                                 bool is_final_pair);
+                                                 bool is_final_pair,
+                                                 TensorShapeVector& output_subscript_order);
 
   // Here we take a "candidate output"(candidate output is a tensor that is a permutation and / or a reshape away from the final output),
   // and after a few operations to get it to the required output structure, copy it to the op's output
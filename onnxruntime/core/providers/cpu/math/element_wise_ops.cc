@@ -102,6 +102,30 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
       KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()),                    \
       KERNEL_CLASS<TYPE>);
 
+// The binary arithmetic ops compute each output element from the input elements at the same position, or from a
+// broadcast one, so the output can overwrite an input that has the output's shape.
+#define REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(OP_TYPE, VERSION, TYPE, KERNEL_CLASS) \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                  \
+      OP_TYPE,                                                                     \
+      VERSION,                                                                     \
+      TYPE,                                                                        \
+      KernelDefBuilder()                                                           \
+          .MayInplace(0, 0)                                                        \
+          .MayInplace(1, 0)                                                        \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()),               \
+      KERNEL_CLASS<TYPE>);
+
+#define REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS) \
+  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                                                   \
+      OP_TYPE,                                                                                                \
+      VERSION_FROM, VERSION_TO,                                                                               \
+      TYPE,                                                                                                   \
+      KernelDefBuilder()                                                                                      \
+          .MayInplace(0, 0)                                                                                   \
+          .MayInplace(1, 0)                                                                                   \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()),                                          \
+      KERNEL_CLASS<TYPE>);
+
 #define REG_ELEMENTWISE_LOGICALOP_VERSIONED_TYPED_KERNEL(OP_TYPE, VERSION_FROM, VERSION_TO, TYPE, KERNEL_CLASS) \
   ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                                                     \
       OP_TYPE,                                                                                                  \
@@ -153,57 +177,57 @@ void Exp<float>::operator()(std::ptrdiff_t first, std::ptrdiff_t last) const {
           .TypeConstraint("T1", T2_CONSTRAINTS),                                                 \
       KERNEL_CLASS);
 
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, float, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, double, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int64_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, float, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, double, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int32_t, Add);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int64_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, float, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, double, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int32_t, Add);
-REG_ELEMENTWISE_TYPED_KERNEL(Add, 14, int64_t, Add);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, float, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, double, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int64_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, float, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, double, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int32_t, Sub);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int64_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, float, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, double, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int32_t, Sub);
-REG_ELEMENTWISE_TYPED_KERNEL(Sub, 14, int64_t, Sub);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, float, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, double, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int64_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, float, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, double, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int32_t, Mul);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int64_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, float, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, double, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int32_t, Mul);
-REG_ELEMENTWISE_TYPED_KERNEL(Mul, 14, int64_t, Mul);
-
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, float, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, double, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int64_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, float, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, double, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int32_t, Div);
-REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int64_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, float, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, double, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int32_t, Div);
-REG_ELEMENTWISE_TYPED_KERNEL(Div, 14, int64_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, float, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, double, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int32_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 7, 12, int64_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, float, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, double, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int32_t, Add);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Add, 13, 13, int64_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, float, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, double, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, int32_t, Add);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Add, 14, int64_t, Add);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, float, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, double, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int32_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 7, 12, int64_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, float, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, double, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int32_t, Sub);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Sub, 13, 13, int64_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, float, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, double, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, int32_t, Sub);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Sub, 14, int64_t, Sub);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, float, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, double, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int32_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 7, 12, int64_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, float, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, double, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int32_t, Mul);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Mul, 13, 13, int64_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, float, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, double, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, int32_t, Mul);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Mul, 14, int64_t, Mul);
+
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, float, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, double, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int32_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 7, 12, int64_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, float, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, double, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int32_t, Div);
+REG_ELEMENTWISE_INPLACE_VERSIONED_TYPED_KERNEL(Div, 13, 13, int64_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, float, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, double, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, int32_t, Div);
+REG_ELEMENTWISE_INPLACE_TYPED_KERNEL(Div, 14, int64_t, Div);
 
 REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, float, Abs);
 REG_ELEMENTWISE_VERSIONED_TYPED_KERNEL(Abs, 6, 12, double, Abs);
@@ -196,6 +196,29 @@ Status Gemm<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prep
   return Status::OK();
 }
 
+template <typename T>
+Status Gemm<T>::UseCachedPrePackedBuffers(const Tensor& /*tensor*/, int /*input_idx*/,
+                                          std::vector<BufferUniquePtr>& /*prepacked_buffers*/,
+                                          /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+  return Status::OK();
+}
+
+template <>
+Status Gemm<float>::UseCachedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                              std::vector<BufferUniquePtr>& prepacked_buffers,
+                                              /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  // PrePack() only packs a 2D matrix B, see GemmPackBFp32()
+  if (input_idx == 1 && tensor.Shape().NumDimensions() == 2 && prepacked_buffers.size() == 1) {
+    used_cached_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+  }
+  return Status::OK();
+}
+
 template <typename T>
 void Gemm<T>::ComputeActivation(T* y_data, size_t y_size, concurrency::ThreadPool* thread_pool) const {
   if (activation_) {
@@ -279,7 +302,22 @@ Status Gemm<float>::Compute(OpKernelContext* context) const {
   const float* c_data = C != nullptr ? C->Data<float>() : nullptr;
   const TensorShape* c_shape = C != nullptr ? &C->Shape() : nullptr;
 
-  if (B) {
+  if (mlas_activation_.ActivationKind != MlasIdentityActivation) {
+    GemmBroadcastBias(M, N, beta_, c_data, c_shape, y_data);
+    MLAS_SGEMM_DATA_PARAMS data;
+    data.BIsPacked = !B;
+    data.A = A->Data<float>();
+    data.lda = static_cast<size_t>(trans_A_ != CblasNoTrans ? M : K);
+    data.B = B ? B->Data<float>() : static_cast<const float*>(packed_b_.get());
+    data.ldb = static_cast<size_t>(trans_B_ != CblasNoTrans ? K : N);
+    data.C = y_data;
+    data.ldc = static_cast<size_t>(N);
+    data.alpha = alpha_;
+    data.beta = c_data != nullptr ? beta_ : 0.0f;
+    data.Activation = &mlas_activation_;
+    MlasGemm(trans_A_, trans_B_, static_cast<size_t>(M), static_cast<size_t>(N), static_cast<size_t>(K), data,
+             thread_pool);
+  } else if (B) {
     ComputeGemm(trans_A_, trans_B_, M, N, K, alpha_, A->Data<float>(), B->Data<float>(), beta_,
                 c_data, c_shape, y_data, thread_pool);
   } else {
@@ -8,6 +8,7 @@
 #include "core/framework/op_kernel.h"
 #include "core/common/common.h"
 #include "core/util/math.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/cpu/activation/activations.h"
 
 namespace onnxruntime {
@@ -16,6 +17,7 @@ template <typename T>
 class Gemm : protected GemmBase, public OpKernel {
  public:
   Gemm(const OpKernelInfo& info) : GemmBase(info), OpKernel(info) {
+    mlas_activation_.ActivationKind = MlasIdentityActivation;
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -28,6 +30,10 @@ class Gemm : protected GemmBase, public OpKernel {
                                    int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UseCachedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                   std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   /*out*/ bool& used_cached_buffers) override;
+
   static void ComputeGemm(CBLAS_TRANSPOSE trans_a, CBLAS_TRANSPOSE trans_b,
                           int64_t M, int64_t N, int64_t K,
                           float alpha,
@@ -43,6 +49,8 @@ class Gemm : protected GemmBase, public OpKernel {
 
   // For fused gemm + activation
   std::unique_ptr<functors::ElementWiseRangedTransform<T>> activation_;
+  // For fused gemm + activation where MLAS applies the activation to each tile of the output
+  MLAS_ACTIVATION mlas_activation_;
 
   void ComputeActivation(T* y_data, size_t y_size, concurrency::ThreadPool* thread_pool) const;
 };
@@ -2,6 +2,10 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/math/matmul.h"
+
+#include <optional>
+
+#include "core/framework/copy.h"
 #include "core/providers/cpu/math/gemm_matmul_common.h"
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/util/math.h"
@@ -10,11 +14,17 @@
 
 namespace onnxruntime {
 
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_MATMUL_FLOAT_KERNEL_DEF KernelDefBuilder().MayStridedInput(0).MayStridedInput(1)
+#else
+#define CREATE_MATMUL_FLOAT_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     MatMul,
     1, 8,
     float,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    CREATE_MATMUL_FLOAT_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     MatMul<float>);
 
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
@@ -24,13 +34,20 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     MatMul<double>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    1, 8,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
 // opset 9 supports more types
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     MatMul,
     9,
     12,
     float,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    CREATE_MATMUL_FLOAT_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     MatMul<float>);
 
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
@@ -41,6 +58,14 @@ ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     MatMul<double>);
 
+ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
+    MatMul,
+    9,
+    12,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
 ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(
     MatMul,
     9,
@@ -63,7 +88,7 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     MatMul,
     13,
     float,
-    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+    CREATE_MATMUL_FLOAT_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     MatMul<float>);
 
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
@@ -73,6 +98,20 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<double>()),
     MatMul<double>);
 
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    MLFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<MLFloat16>()),
+    MatMul<MLFloat16>);
+
+ONNX_CPU_OPERATOR_TYPED_KERNEL(
+    MatMul,
+    13,
+    BFloat16,
+    KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<BFloat16>()),
+    MatMul<BFloat16>);
+
 ONNX_CPU_OPERATOR_TYPED_KERNEL(
     MatMul,
     13,
@@ -89,6 +128,55 @@ ONNX_CPU_OPERATOR_TYPED_KERNEL(
         .TypeConstraint("T", BuildKernelDefConstraints<int64_t, uint64_t>()),
     MatMul<int64_t>);
 
+#undef CREATE_MATMUL_FLOAT_KERNEL_DEF
+
+#ifdef ENABLE_STRIDED_TENSORS
+namespace {
+// A strided input (see KernelDefBuilder::MayStridedInput) that is a view on a contiguous buffer with the last two dims
+// swapped, e.g. the output of a Transpose, is read as a transposed matrix of that buffer. Any other strided input is
+// copied to a contiguous buffer first.
+Status PrepareStridedInput(OpKernelContext* ctx, const Tensor*& input, TensorShape& buffer_shape, bool& trans,
+                           std::optional<Tensor>& contiguous_input) {
+  if (input->IsContiguous()) {
+    return Status::OK();
+  }
+
+  const auto strides = input->Strides();
+  const size_t rank = buffer_shape.NumDimensions();
+  if (rank >= 2) {
+    TensorShapeVector buffer_dims = buffer_shape.AsShapeVector();
+    std::swap(buffer_dims[rank - 2], buffer_dims[rank - 1]);
+    TensorShapeVector transposed_strides(rank);
+    int64_t running_size = 1;
+    for (size_t i = rank; i > 0; --i) {
+      transposed_strides[i - 1] = running_size;
+      running_size *= buffer_dims[i - 1];
+    }
+    std::swap(transposed_strides[rank - 2], transposed_strides[rank - 1]);
+
+    bool is_transposed_view = true;
+    for (size_t i = 0; i < rank && is_transposed_view; ++i) {
+      is_transposed_view = buffer_shape[i] == 1 || strides[i] == transposed_strides[i];
+    }
+    if (is_transposed_view) {
+      buffer_shape = TensorShape(buffer_dims);
+      trans = !trans;
+      return Status::OK();
+    }
+  }
+
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+  contiguous_input.emplace(input->DataType(), buffer_shape, std::move(alloc));
+  ORT_RETURN_IF_ERROR(DispatchStridedCopy<TypeList<float>>(ctx->GetOperatorThreadPool(), *contiguous_input, 0,
+                                                           StridesForTensor(*contiguous_input), buffer_shape,
+                                                           *input, 0, ToShapeVector(strides)));
+  input = &*contiguous_input;
+  return Status::OK();
+}
+}  // namespace
+#endif
+
 template <typename T>
 Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
@@ -126,6 +214,103 @@ Status MatMul<T>::Compute(OpKernelContext* ctx) const {
   return Status::OK();
 }
 
+// MLFloat16 and BFloat16 stay in their 16-bit format end to end, MLAS widens
+// the elements in registers and accumulates using single precision.
+template <typename T>
+static Status ComputeHalfMatMul(OpKernelContext* ctx,
+                                void(MLASCALL* gemm_batch)(size_t, size_t, size_t, const MLAS_HALF_GEMM_DATA_PARAMS*,
+                                                           size_t, MLAS_THREADPOOL*)) {
+  concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
+
+  const auto* a = ctx->Input<Tensor>(0);
+  const auto* b = ctx->Input<Tensor>(1);
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const auto* a_data = reinterpret_cast<const uint16_t*>(a->Data<T>());
+  const auto* b_data = reinterpret_cast<const uint16_t*>(b->Data<T>());
+  auto* y_data = reinterpret_cast<uint16_t*>(y->MutableData<T>());
+
+  const size_t max_len = helper.OutputOffsets().size();
+  const size_t M = static_cast<size_t>(helper.M());
+  const size_t N = static_cast<size_t>(helper.N());
+  const size_t K = static_cast<size_t>(helper.K());
+
+  std::vector<MLAS_HALF_GEMM_DATA_PARAMS> data(max_len);
+  for (size_t i = 0; i < max_len; i++) {
+    data[i].A = a_data + helper.LeftOffsets()[i];
+    data[i].lda = K;
+    data[i].B = b_data + helper.RightOffsets()[i];
+    data[i].ldb = N;
+    data[i].C = y_data + helper.OutputOffsets()[i];
+    data[i].ldc = N;
+  }
+  gemm_batch(M, N, K, data.data(), max_len, thread_pool);
+
+  return Status::OK();
+}
+
+template <>
+Status MatMul<MLFloat16>::Compute(OpKernelContext* ctx) const {
+  return ComputeHalfMatMul<MLFloat16>(ctx, MlasHalfGemmBatch);
+}
+
+template <>
+Status MatMul<BFloat16>::Compute(OpKernelContext* ctx) const {
+  return ComputeHalfMatMul<BFloat16>(ctx, MlasBf16GemmBatch);
+}
+
+// A constant B with at most this fraction of nonzero blocks is multiplied by the block sparse kernels. Below it
+// skipping the zero blocks outweighs the lower efficiency per multiply compared to the dense kernels.
+static constexpr double kMaxBlockSparseDensity = 0.3;
+
+static bool IsBlockSparseFp32(const Tensor& tensor_b, bool trans_b, size_t& block_count) {
+  if (tensor_b.Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  const size_t K = static_cast<size_t>(tensor_b.Shape()[trans_b ? 1 : 0]);
+  const size_t N = static_cast<size_t>(tensor_b.Shape()[trans_b ? 0 : 1]);
+  const size_t total_block_count = K * ((N + MLAS_BLOCK_SPARSE_GEMM_BLOCK_N - 1) / MLAS_BLOCK_SPARSE_GEMM_BLOCK_N);
+  if (total_block_count == 0) {
+    return false;
+  }
+
+  block_count = MlasBlockSparseSgemmCountBlocks(trans_b ? CblasTrans : CblasNoTrans, N, K, tensor_b.Data<float>(),
+                                                trans_b ? K : N, 0.0f);
+  return static_cast<double>(block_count) <= kMaxBlockSparseDensity * static_cast<double>(total_block_count) &&
+         MlasBlockSparseSgemmPackBSize(N, K, block_count) != 0;
+}
+
+static bool GemmPackBBlockSparseFp32(AllocatorPtr& alloc,
+                                     const Tensor& tensor_b,
+                                     bool trans_b,
+                                     BufferUniquePtr& packed_b,
+                                     size_t& packed_b_size,
+                                     TensorShape& b_shape) {
+  size_t block_count;
+  if (!IsBlockSparseFp32(tensor_b, trans_b, block_count)) {
+    return false;
+  }
+  b_shape = tensor_b.Shape();
+
+  const size_t K = static_cast<size_t>(b_shape[trans_b ? 1 : 0]);
+  const size_t N = static_cast<size_t>(b_shape[trans_b ? 0 : 1]);
+
+  packed_b_size = MlasBlockSparseSgemmPackBSize(N, K, block_count);
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasBlockSparseSgemmPackB(trans_b ? CblasTrans : CblasNoTrans, N, K, tensor_b.Data<float>(), trans_b ? K : N,
+                            0.0f, packed_b_data);
+  return true;
+}
+
 Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ AllocatorPtr alloc,
                               /*out*/ bool& is_packed,
                               /*out*/ PrePackedWeights* prepacked_weights) {
@@ -134,7 +319,12 @@ Status MatMul<float>::PrePack(const Tensor& tensor, int input_idx, /*out*/ Alloc
   // only pack Matrix B
   if (input_idx == 1) {
     size_t packed_b_size;
-    is_packed = GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
+    // The block sparse kernels don't handle a transposed A or batch transposes.
+    b_is_block_sparse_ = trans_a_attr_ == 0 && !trans_batch_a_ && !trans_batch_b_ &&
+                         GemmPackBBlockSparseFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size,
+                                                  b_shape_);
+    is_packed = b_is_block_sparse_ ||
+                GemmPackBFp32(alloc, tensor, trans_b_attr_ != 0, packed_b_, packed_b_size, b_shape_);
     bool share_prepacked_weights = (prepacked_weights != nullptr);
     if (is_packed && share_prepacked_weights) {
       prepacked_weights->buffers_.push_back(std::move(packed_b_));
@@ -157,6 +347,25 @@ Status MatMul<float>::UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& pr
   return Status::OK();
 }
 
+Status MatMul<float>::UseCachedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                                std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  // PrePack() only packs a 2D matrix B, see GemmPackBFp32()
+  if (input_idx == 1 && tensor.Shape().NumDimensions() == 2 && prepacked_buffers.size() == 1) {
+    used_cached_buffers = true;
+    b_shape_ = tensor.Shape();
+    packed_b_ = std::move(prepacked_buffers[0]);
+    // Make the same choice of format as PrePack() did for this tensor.
+    size_t block_count;
+    b_is_block_sparse_ = trans_a_attr_ == 0 && !trans_batch_a_ && !trans_batch_b_ &&
+                         IsBlockSparseFp32(tensor, trans_b_attr_ != 0, block_count);
+  }
+
+  return Status::OK();
+}
+
 Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   concurrency::ThreadPool* thread_pool = ctx->GetOperatorThreadPool();
 
@@ -165,11 +374,23 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const auto& b_shape = b ? b->Shape() : b_shape_;
 
   // match CUDA kernel implementation, ignore transpose for vectors
-  const bool trans_a = trans_a_attr_ && a->Shape().NumDimensions() != 1;
-  const bool trans_b = trans_b_attr_ && b_shape.NumDimensions() != 1;
+  bool trans_a = trans_a_attr_ && a->Shape().NumDimensions() != 1;
+  bool trans_b = trans_b_attr_ && b_shape.NumDimensions() != 1;
 
   MatMulComputeHelper helper;
+#ifdef ENABLE_STRIDED_TENSORS
+  TensorShape a_buffer_shape = a->Shape();
+  TensorShape b_buffer_shape = b_shape;
+  std::optional<Tensor> a_contiguous, b_contiguous;
+  ORT_RETURN_IF_ERROR(PrepareStridedInput(ctx, a, a_buffer_shape, trans_a, a_contiguous));
+  if (b) {
+    ORT_RETURN_IF_ERROR(PrepareStridedInput(ctx, b, b_buffer_shape, trans_b, b_contiguous));
+  }
+  ORT_RETURN_IF_ERROR(helper.Compute(a_buffer_shape, b_buffer_shape, trans_a, trans_b, trans_batch_a_,
+                                     trans_batch_b_));
+#else
   ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b_shape, trans_a, trans_b, trans_batch_a_, trans_batch_b_));
+#endif
   Tensor* y = ctx->Output(0, helper.OutputShape());
 
   // Bail out early if the output is going to be empty
@@ -186,6 +407,24 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
   const size_t K = static_cast<size_t>(helper.K());
   const size_t lda = helper.Lda(trans_a);
   const size_t ldb = helper.Ldb(trans_b);
+  const MLAS_ACTIVATION* activation = activation_.ActivationKind != MlasIdentityActivation ? &activation_ : nullptr;
+
+  if (b_is_block_sparse_) {
+    std::vector<MLAS_BLOCK_SPARSE_SGEMM_DATA_PARAMS> data(max_len);
+    for (size_t i = 0; i < max_len; i++) {
+      data[i].A = a_data + helper.LeftOffsets()[i];
+      data[i].lda = lda;
+      data[i].PackedB = packed_b_.get();
+      data[i].C = y_data + helper.OutputOffsets()[i];
+      data[i].ldc = N;
+      data[i].alpha = alpha_attr_;
+    }
+    MlasBlockSparseSgemmBatch(M, N, K, data.data(), max_len, thread_pool);
+    if (activation != nullptr) {
+      MlasActivation(activation, y_data, nullptr, max_len * M, N, N);
+    }
+    return Status::OK();
+  }
 
   std::vector<MLAS_SGEMM_DATA_PARAMS> data(max_len);
   for (size_t i = 0; i < max_len; i++) {
@@ -198,6 +437,7 @@ Status MatMul<float>::Compute(OpKernelContext* ctx) const {
     data[i].ldc = N;
     data[i].alpha = alpha_attr_;
     data[i].beta = 0.0f;
+    data[i].Activation = activation;
   }
   MlasGemmBatch(trans_a ? CblasTrans : CblasNoTrans, trans_b ? CblasTrans : CblasNoTrans,
                 M, N, K, data.data(), max_len, thread_pool);
@@ -4,6 +4,10 @@
 #pragma once
 
 #include "core/framework/op_kernel.h"
+#include "core/mlas/inc/mlas.h"
+#if !defined(DISABLE_CONTRIB_OPS)
+#include "contrib_ops/cpu/fused_activation.h"
+#endif
 
 namespace onnxruntime {
 
@@ -15,6 +19,12 @@ class MatMul final : public OpKernel {
   Status Compute(OpKernelContext* context) const override;
 };
 
+template <>
+Status MatMul<MLFloat16>::Compute(OpKernelContext* context) const;
+
+template <>
+Status MatMul<BFloat16>::Compute(OpKernelContext* context) const;
+
 template <>
 class MatMul<float> final : public OpKernel {
  public:
@@ -27,6 +37,10 @@ class MatMul<float> final : public OpKernel {
     info.GetAttrOrDefault<int64_t>("transBatchB", &trans_batch_b_attr, 0);
     trans_batch_a_ = trans_batch_a_attr != 0;
     trans_batch_b_ = trans_batch_b_attr != 0;
+    activation_.ActivationKind = MlasIdentityActivation;
+#if !defined(DISABLE_CONTRIB_OPS)
+    ORT_THROW_IF_ERROR(GetFusedActivationAttr(info, activation_));
+#endif
   }
 
   Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
@@ -36,11 +50,16 @@ class MatMul<float> final : public OpKernel {
   Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UseCachedPrePackedBuffers(const Tensor& tensor, int input_idx, std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   /*out*/ bool& used_cached_buffers) override;
+
   Status Compute(OpKernelContext* context) const override;
 
  private:
   TensorShape b_shape_;
   BufferUniquePtr packed_b_;
+  // packed_b_ holds the nonzero blocks of a sparse B for MlasBlockSparseSgemmBatch
+  bool b_is_block_sparse_{false};
 
   // For FusedMatMul contrib ops
   float alpha_attr_;
@@ -48,6 +67,8 @@ class MatMul<float> final : public OpKernel {
   int64_t trans_b_attr_;
   bool trans_batch_a_;
   bool trans_batch_b_;
+  // applied by MLAS to each tile of the output as it is computed
+  MLAS_ACTIVATION activation_;
 };
 
 }  // namespace onnxruntime
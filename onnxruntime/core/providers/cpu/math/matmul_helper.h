@@ -4,6 +4,7 @@
 #pragma once
 #ifndef SHARED_PROVIDER
 #include "core/common/common.h"
+#include "core/common/inlined_containers.h"
 #include "core/framework/tensor.h"
 #endif
 
@@ -62,8 +63,8 @@ class MatMulComputeHelper {
       return Status::OK();
     }
 
-    std::vector<int64_t> dims_left(left_num_dims);
-    std::vector<int64_t> dims_right(right_num_dims);
+    TensorShapeVector dims_left(left_num_dims);
+    TensorShapeVector dims_right(right_num_dims);
     orig_left_shape.CopyDims(&dims_left[0], left_num_dims);
     orig_right_shape.CopyDims(&dims_right[0], right_num_dims);
     left_stride_factor_ = right_stride_factor_ = 1;
@@ -109,8 +110,8 @@ class MatMulComputeHelper {
     // output shape would squeeze the reduced 1D dimension
     size_t num_output_dims = num_input_dims - (has_1D_input ? 1 : 0);
 
-    left_padded_dims_ = std::vector<ptrdiff_t>(num_dims_with_pad, 1);
-    right_padded_dims_ = std::vector<ptrdiff_t>(num_dims_with_pad, 1);
+    left_padded_dims_.assign(num_dims_with_pad, 1);
+    right_padded_dims_.assign(num_dims_with_pad, 1);
 
     if (right_num_dims == 1) {
       // right padded to (1,...,K,1)
@@ -133,7 +134,7 @@ class MatMulComputeHelper {
     }
 
     // validate input shape and generate output shape
-    std::vector<int64_t> output_dims(num_output_dims);
+    TensorShapeVector output_dims(num_output_dims);
 
     // broadcasting for all output dims except last two
     for (size_t idx_dim = 0; idx_dim < num_dims_with_pad - 2; ++idx_dim) {
@@ -287,13 +288,14 @@ class MatMulComputeHelper {
 
   size_t num_broadcasted_dims_ = 0;
 
-  std::vector<ptrdiff_t> left_padded_dims_;
-  std::vector<ptrdiff_t> right_padded_dims_;
-  std::vector<ptrdiff_t> output_broadcast_dims_;
+  // sized by the rank, inline storage avoids heap allocations in the shape computation of every run
+  InlinedVector<ptrdiff_t, kTensorShapeSmallBufferElementsSize> left_padded_dims_;
+  InlinedVector<ptrdiff_t, kTensorShapeSmallBufferElementsSize> right_padded_dims_;
+  InlinedVector<ptrdiff_t, kTensorShapeSmallBufferElementsSize> output_broadcast_dims_;
 
-  std::vector<size_t> left_padded_strides_;
-  std::vector<size_t> right_padded_strides_;
-  std::vector<size_t> output_broadcast_strides_;
+  InlinedVector<size_t, kTensorShapeSmallBufferElementsSize> left_padded_strides_;
+  InlinedVector<size_t, kTensorShapeSmallBufferElementsSize> right_padded_strides_;
+  InlinedVector<size_t, kTensorShapeSmallBufferElementsSize> output_broadcast_strides_;
 
   TensorShape output_shape_;
 
@@ -0,0 +1,107 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/inlined_containers.h"
+#include "core/platform/threadpool.h"
+
+namespace onnxruntime {
+namespace ml {
+
+/**
+ * Constant key to value table of the label mapping kernels (LabelEncoder, CategoryMapper).
+ *
+ * The entries are kept in an open addressing hash map. Integer keys that cover a dense range are instead
+ * mapped with a direct array indexed by key - min_key. Call Finalize once all the entries are inserted.
+ */
+template <typename TKey, typename TValue>
+class LabelLookup {
+ public:
+  void Reserve(size_t num_entries) {
+    map_.reserve(num_entries);
+  }
+
+  // Sets the value of key, replacing the value of an earlier entry with the same key.
+  void Insert(const TKey& key, const TValue& value) {
+    map_[key] = value;
+  }
+
+  void Finalize() {
+    if constexpr (std::is_integral_v<TKey>) {
+      if (map_.empty()) {
+        return;
+      }
+      const auto [min_entry, max_entry] = std::minmax_element(
+          map_.begin(), map_.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+      const TKey min_key = min_entry->first;
+      const TKey max_key = max_entry->first;
+
+      // no more than kMaxDenseSlotsPerEntry unused slots per entry, so that the array stays about the size of
+      // the hash map
+      constexpr uint64_t kMaxDenseSlotsPerEntry = 4;
+      const uint64_t range = static_cast<uint64_t>(max_key) - static_cast<uint64_t>(min_key) + 1;
+      if (range == 0 || range > kMaxDenseSlotsPerEntry * map_.size()) {
+        return;
+      }
+
+      dense_min_key_ = min_key;
+      dense_values_.resize(static_cast<size_t>(range));
+      dense_present_.assign(static_cast<size_t>(range), false);
+      for (const auto& entry : map_) {
+        const auto index = static_cast<size_t>(static_cast<uint64_t>(entry.first) - static_cast<uint64_t>(min_key));
+        dense_values_[index] = entry.second;
+        dense_present_[index] = true;
+      }
+      map_.clear();
+    }
+  }
+
+  // Returns the value of key or nullptr if there is no entry for it.
+  const TValue* Find(const TKey& key) const {
+    if constexpr (std::is_integral_v<TKey>) {
+      if (!dense_values_.empty()) {
+        const uint64_t index = static_cast<uint64_t>(key) - static_cast<uint64_t>(dense_min_key_);
+        return index < dense_values_.size() && dense_present_[static_cast<size_t>(index)]
+                   ? &dense_values_[static_cast<size_t>(index)]
+                   : nullptr;
+      }
+    }
+    auto found = map_.find(key);
+    return found == map_.end() ? nullptr : &found->second;
+  }
+
+  // Maps each input to its value or default_value, in parallel on threadpool for large inputs.
+  void Map(gsl::span<const TKey> input, gsl::span<TValue> output, const TValue& default_value,
+           concurrency::ThreadPool* threadpool) const {
+    // a lookup costs a hash and a probe, plus a copy for string values
+    constexpr bool has_string = std::is_same_v<TKey, std::string> || std::is_same_v<TValue, std::string>;
+    const TensorOpCost cost{static_cast<double>(sizeof(TKey)), static_cast<double>(sizeof(TValue)),
+                            has_string ? 50.0 : 10.0};
+    concurrency::ThreadPool::TryParallelFor(
+        threadpool, static_cast<std::ptrdiff_t>(input.size()), cost,
+        [this, in = input.data(), out = output.data(), &default_value](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t i = first; i < last; ++i) {
+            const TValue* value = Find(in[i]);
+            out[i] = value != nullptr ? *value : default_value;
+          }
+        });
+  }
+
+ private:
+  InlinedHashMap<TKey, TValue> map_;
+
+  TKey dense_min_key_{};
+  std::vector<TValue> dense_values_;
+  std::vector<bool> dense_present_;
+};
+
+}  // namespace ml
+}  // namespace onnxruntime
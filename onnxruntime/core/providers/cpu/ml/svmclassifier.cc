@@ -74,6 +74,39 @@ SVMClassifier::SVMClassifier(const OpKernelInfo& info)
   ORT_ENFORCE(coefficients_.size() > 0);
   weights_are_all_positive_ = std::all_of(coefficients_.cbegin(), coefficients_.cend(),
                                           [](float value) { return value >= 0.f; });
+
+  if (mode_ == SVM_TYPE::SVM_SVC) {
+    if (get_kernel_type() == KERNEL::RBF) {
+      support_vector_squared_norms_ = RowSquaredNorms<float>(support_vectors_, vector_count_, feature_count_);
+    }
+
+    // The score of the classifier of classes i and j combines the coefficients of row j - 1 for the support vectors
+    // of class i with the coefficients of row i for the support vectors of class j, see ComputeImpl.
+    constexpr size_t max_classifier_coefficients = 1 << 22;
+    const size_t num_classes = onnxruntime::narrow<size_t>(class_count_);
+    const size_t num_vectors = onnxruntime::narrow<size_t>(vector_count_);
+    const size_t num_classifiers = num_classes * (num_classes - 1) / 2;
+    if (num_classifiers > 0 && vectors_per_class_.size() == num_classes &&
+        num_vectors * num_classifiers <= max_classifier_coefficients &&
+        coefficients_.size() >= num_vectors * (num_classes - 1)) {
+      classifier_coefficients_.resize(num_vectors * num_classifiers, 0.f);
+      size_t classifier_idx = 0;
+      for (size_t i = 0; i < num_classes - 1; i++) {
+        for (size_t j = i + 1; j < num_classes; j++, classifier_idx++) {
+          auto set_coefficients = [&](size_t vectors_class, size_t coefficients_row) {
+            const size_t start = onnxruntime::narrow<size_t>(starting_vector_[vectors_class]);
+            const size_t end = start + onnxruntime::narrow<size_t>(vectors_per_class_[vectors_class]);
+            for (size_t v = start; v < end; ++v) {
+              classifier_coefficients_[v * num_classifiers + classifier_idx] =
+                  coefficients_[num_vectors * coefficients_row + v];
+            }
+          };
+          set_coefficients(i, j - 1);
+          set_coefficients(j, i);
+        }
+      }
+    }
+  }
 }
 
 template <typename LabelType>
@@ -245,63 +278,90 @@ Status SVMClassifier::ComputeImpl(OpKernelContext& ctx,
     // combine the input data with the support vectors and apply the kernel type
     // output is {num_batches, vector_count_}
     batched_kernel_dot<float>(x_data, support_vectors_, num_batches, vector_count_, feature_count_, 0.f, kernels_span,
-                              threadpool);
+                              threadpool, support_vector_squared_norms_);
 
-    for (int64_t n = 0; n < num_batches; n++) {
-      // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
-      // per class.
-      // coefficients: [num_classes - 1, vector_count_]
-      //
-      // e.g. say you have 3 classes, with 3 x 3 coefficients
-      //
-      // AA AB AC
-      // BA BB BC
-      // CA CB CC
-      //
-      // you can remove the diagonal line of items comparing a class with itself leaving one less row.
-      //
-      // BA AB AC
-      // CA CB BC
-      //
-      // for each class there is a coefficient per support vector, and a class has one or more support vectors.
-      //
-      // Combine the scores for the two combinations for two classes with their coefficient.
-      // e.g. AB combines with BA.
-      // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
-
-      auto cur_kernels = kernels_span.subspan(n * SafeInt<size_t>(vector_count_), onnxruntime::narrow<size_t>(vector_count_));
-      auto cur_scores = classifier_scores.subspan(n * SafeInt<size_t>(num_slots_per_iteration), onnxruntime::narrow<size_t>(num_classifiers));
-      auto cur_votes = votes_span.subspan(n * SafeInt<size_t>(class_count_), onnxruntime::narrow<size_t>(class_count_));
-      auto scores_iter = cur_scores.begin();
+    if (!classifier_coefficients_.empty()) {
+      // scores = kernels x classifier coefficients + rho, written with the row stride of the scores
+      const size_t scores_stride = onnxruntime::narrow<size_t>(num_slots_per_iteration);
+      for (int64_t n = 0; n < num_batches; n++) {
+        std::copy(rho_.begin(), rho_.begin() + num_classifiers, classifier_scores.data() + n * scores_stride);
+      }
+      MlasGemm(CblasNoTrans, CblasNoTrans, onnxruntime::narrow<size_t>(num_batches),
+               onnxruntime::narrow<size_t>(num_classifiers), onnxruntime::narrow<size_t>(vector_count_),
+               1.f, kernels_data.data(), onnxruntime::narrow<size_t>(vector_count_),
+               classifier_coefficients_.data(), onnxruntime::narrow<size_t>(num_classifiers),
+               1.f, classifier_scores.data(), scores_stride, threadpool);
 
+      // one-vs-one votes, one classifier at a time over all the rows
       size_t classifier_idx = 0;
       for (int64_t i = 0; i < class_count_ - 1; i++) {
-        int64_t start_index_i = starting_vector_[onnxruntime::narrow<size_t>(i)];  // start of support vectors for class i
-        int64_t class_i_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(i)];
-        int64_t i_coeff_row_offset = vector_count_ * i;
-
-        for (int64_t j = i + 1; j < class_count_; j++) {
-          int64_t start_index_j = starting_vector_[onnxruntime::narrow<size_t>(j)];  // start of support vectors for class j
-          int64_t class_j_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(j)];
-          int64_t j_coeff_row_offset = vector_count_ * (j - 1);
-
-          double sum = 0;
-
-          const float* val1 = &(coefficients_[j_coeff_row_offset + SafeInt<size_t>(start_index_i)]);
-          const float* val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_i)]);
-          for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          val1 = &(coefficients_[i_coeff_row_offset + SafeInt<size_t>(start_index_j)]);
-          val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_j)]);
-
-          for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
-            sum += *val1 * *val2;
-
-          sum += rho_[classifier_idx++];
-
-          *scores_iter++ = static_cast<float>(sum);
-          ++(cur_votes[onnxruntime::narrow<size_t>(sum > 0 ? i : j)]);
+        for (int64_t j = i + 1; j < class_count_; j++, classifier_idx++) {
+          const float* scores = classifier_scores.data() + classifier_idx;
+          int64_t* votes = votes_data.data();
+          for (int64_t n = 0; n < num_batches; n++) {
+            ++votes[scores[0] > 0 ? i : j];
+            scores += scores_stride;
+            votes += class_count_;
+          }
+        }
+      }
+    } else {
+      for (int64_t n = 0; n < num_batches; n++) {
+        // reduce scores from kernels using coefficients, taking into account the varying number of support vectors
+        // per class.
+        // coefficients: [num_classes - 1, vector_count_]
+        //
+        // e.g. say you have 3 classes, with 3 x 3 coefficients
+        //
+        // AA AB AC
+        // BA BB BC
+        // CA CB CC
+        //
+        // you can remove the diagonal line of items comparing a class with itself leaving one less row.
+        //
+        // BA AB AC
+        // CA CB BC
+        //
+        // for each class there is a coefficient per support vector, and a class has one or more support vectors.
+        //
+        // Combine the scores for the two combinations for two classes with their coefficient.
+        // e.g. AB combines with BA.
+        // If A has 3 support vectors and B has 2, there's a 3x2 block for AB and a 2x3 block for BA to combine
+
+        auto cur_kernels = kernels_span.subspan(n * SafeInt<size_t>(vector_count_), onnxruntime::narrow<size_t>(vector_count_));
+        auto cur_scores = classifier_scores.subspan(n * SafeInt<size_t>(num_slots_per_iteration), onnxruntime::narrow<size_t>(num_classifiers));
+        auto cur_votes = votes_span.subspan(n * SafeInt<size_t>(class_count_), onnxruntime::narrow<size_t>(class_count_));
+        auto scores_iter = cur_scores.begin();
+
+        size_t classifier_idx = 0;
+        for (int64_t i = 0; i < class_count_ - 1; i++) {
+          int64_t start_index_i = starting_vector_[onnxruntime::narrow<size_t>(i)];  // start of support vectors for class i
+          int64_t class_i_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(i)];
+          int64_t i_coeff_row_offset = vector_count_ * i;
+
+          for (int64_t j = i + 1; j < class_count_; j++) {
+            int64_t start_index_j = starting_vector_[onnxruntime::narrow<size_t>(j)];  // start of support vectors for class j
+            int64_t class_j_support_count = vectors_per_class_[onnxruntime::narrow<size_t>(j)];
+            int64_t j_coeff_row_offset = vector_count_ * (j - 1);
+
+            double sum = 0;
+
+            const float* val1 = &(coefficients_[j_coeff_row_offset + SafeInt<size_t>(start_index_i)]);
+            const float* val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_i)]);
+            for (int64_t m = 0; m < class_i_support_count; ++m, ++val1, ++val2)
+              sum += *val1 * *val2;
+
+            val1 = &(coefficients_[i_coeff_row_offset + SafeInt<size_t>(start_index_j)]);
+            val2 = &(cur_kernels[onnxruntime::narrow<size_t>(start_index_j)]);
+
+            for (int64_t m = 0; m < class_j_support_count; ++m, ++val1, ++val2)
+              sum += *val1 * *val2;
+
+            sum += rho_[classifier_idx++];
+
+            *scores_iter++ = static_cast<float>(sum);
+            ++(cur_votes[onnxruntime::narrow<size_t>(sum > 0 ? i : j)]);
+          }
         }
       }
     }
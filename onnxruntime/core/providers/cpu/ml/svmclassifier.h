@@ -30,37 +30,60 @@ class SVMCommon {
   void set_kernel_type(KERNEL new_kernel_type) { kernel_type_ = new_kernel_type; }
   KERNEL get_kernel_type() const { return kernel_type_; }
 
+  // Squared L2 norm of each of the n rows of k values in b.
+  template <typename T>
+  static std::vector<T> RowSquaredNorms(const gsl::span<const T> b, int64_t n, int64_t k) {
+    std::vector<T> norms(onnxruntime::narrow<size_t>(n));
+    const T* row = b.data();
+    for (auto& norm : norms) {
+      T sum = 0.f;
+      for (int64_t i = 0; i < k; ++i) {
+        sum += row[i] * row[i];
+      }
+      norm = sum;
+      row += k;
+    }
+    return norms;
+  }
+
+  // b_squared_norms optionally supplies RowSquaredNorms(b, n, k) for the RBF kernel, which computes it otherwise.
   template <typename T>
   void batched_kernel_dot(const gsl::span<const T> a, const gsl::span<const T> b,
                           int64_t m, int64_t n, int64_t k,
                           float scalar_C,
                           const gsl::span<T> out,
-                          concurrency::ThreadPool* threadpool) const {
+                          concurrency::ThreadPool* threadpool,
+                          gsl::span<const T> b_squared_norms = {}) const {
     assert(a.size() == size_t(m * k) && b.size() == size_t(k * n) && out.size() == size_t(m * n));
 
     if (kernel_type_ == KERNEL::RBF) {
-      T* cur_out = out.data();
-      const T* cur_batch = a.data();
+      // |a - b|^2 = |a|^2 + |b|^2 - 2 a.b, so that the distances to all the support vectors come from one GEMM
+      std::vector<T> computed_b_norms;
+      if (b_squared_norms.empty()) {
+        computed_b_norms = RowSquaredNorms(b, n, k);
+        b_squared_norms = computed_b_norms;
+      }
+      assert(b_squared_norms.size() == size_t(n));
+      const std::vector<T> a_squared_norms = RowSquaredNorms(a, m, k);
 
-      // each batch has 'k' features
-      for (int64_t batch = 0; batch < m; ++batch) {
-        const T* cur_support_vector = b.data();
+      onnxruntime::Gemm<T>::ComputeGemm(CBLAS_TRANSPOSE::CblasNoTrans, CBLAS_TRANSPOSE::CblasTrans,
+                                        m, n, k,
+                                        -2.f, a.data(), b.data(), 0.f,
+                                        nullptr, nullptr,
+                                        out.data(),
+                                        threadpool);
 
-        // broadcast the support vectors against the k features in each batch. output is one value per support vector
+      T* cur_out = out.data();
+      for (int64_t batch = 0; batch < m; ++batch) {
+        const T a_norm = a_squared_norms[onnxruntime::narrow<size_t>(batch)];
         for (int64_t support_vector = 0; support_vector < n; ++support_vector) {
-          T sum = 0.f;
-          const T* cur_input = cur_batch;
-
-          for (int64_t feature = 0; feature < k; ++feature) {
-            T val = *cur_input++ - *cur_support_vector++;
-            sum += val * val;
-          }
-
-          *cur_out++ = std::exp(-gamma_ * sum);
+          // the rounding errors of the expansion may make the distance of nearby vectors slightly negative
+          const T distance = std::max(cur_out[support_vector] + a_norm + b_squared_norms[support_vector], T{0});
+          cur_out[support_vector] = -gamma_ * distance;
         }
-
-        cur_batch += k;  // move to start of next batch
+        cur_out += n;
       }
+      MlasComputeExp(out.data(), out.data(), out.size());
     } else {
       float alpha = 1.f;
       float beta = 1.f;
@@ -104,6 +127,7 @@ class SVMCommon {
 
 class SVMClassifier final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
+  using SVMCommon::RowSquaredNorms;
   using SVMCommon::set_kernel_type;
   using SVMCommon::get_kernel_type;
 
@@ -126,6 +150,11 @@ class SVMClassifier final : public OpKernel, private SVMCommon {
   std::vector<float> probb_;
   std::vector<float> coefficients_;
   std::vector<float> support_vectors_;
+  std::vector<float> support_vector_squared_norms_;  // for the RBF kernel
+  // [vector_count_, num_classifiers] coefficients of the support vectors for each one-vs-one classifier, zero for
+  // the support vectors of the other classes, so that the classifier scores of a batch take one GEMM.
+  // Empty if the matrix would be too large, e.g. with many classes.
+  std::vector<float> classifier_coefficients_;
   std::vector<int64_t> classlabels_ints_;
   std::vector<std::string> classlabels_strings_;
   POST_EVAL_TRANSFORM post_transform_;
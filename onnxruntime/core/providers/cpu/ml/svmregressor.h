@@ -15,6 +15,7 @@ namespace ml {
 template <typename T>
 class SVMRegressor final : public OpKernel, private SVMCommon {
   using SVMCommon::batched_kernel_dot;
+  using SVMCommon::RowSquaredNorms;
   using SVMCommon::set_kernel_type;
   using SVMCommon::get_kernel_type;
 
@@ -29,6 +30,7 @@ class SVMRegressor final : public OpKernel, private SVMCommon {
   std::vector<float> rho_;
   std::vector<float> coefficients_;
   std::vector<float> support_vectors_;
+  std::vector<float> support_vector_squared_norms_;  // for the RBF kernel
   POST_EVAL_TRANSFORM post_transform_;
   SVM_TYPE mode_;  //how are we computing SVM? 0=LibSVC, 1=LibLinear
 };
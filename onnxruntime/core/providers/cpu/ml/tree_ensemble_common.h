@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 #include "tree_ensemble_aggregator.h"
 #include "core/platform/ort_mutex.h"
 #include "core/platform/threadpool.h"
@@ -43,6 +47,21 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   std::vector<TreeNodeElement<ThresholdType>> nodes_;
   std::vector<TreeNodeElement<ThresholdType>*> roots_;
 
+  // Breadth-first struct-of-arrays copy of the trees, built at Init when all the branch nodes share one mode.
+  // The children of a branch node are adjacent: the true child is at flat_children_[i] and the false child right
+  // after it. For a leaf, flat_feature_ids_ is -1 and flat_children_ is the index of the leaf in nodes_.
+  // It is empty if the trees can't be flattened, and the traversal goes through nodes_ instead.
+  std::vector<int32_t> flat_feature_ids_;
+  std::vector<ThresholdType> flat_values_;
+  std::vector<int32_t> flat_children_;
+  std::vector<uint8_t> flat_missing_tracks_true_;  // empty if there are no missing tracks
+  std::vector<int32_t> flat_roots_;
+  NODE_MODE flat_mode_;
+
+  // Number of rows that go down a tree together. Walking several independent paths at once hides the latency
+  // of loading the nodes and the features.
+  static constexpr int64_t kRowBlockSize = 16;
+
  public:
   TreeEnsembleCommon() {}
 
@@ -77,6 +96,16 @@ class TreeEnsembleCommon : public TreeEnsembleCommonAttributes {
   TreeNodeElement<ThresholdType>* ProcessTreeNodeLeave(TreeNodeElement<ThresholdType>* root,
                                                        const InputType* x_data) const;
 
+  // Finds the leaves of tree tree_index for the rows [0, n_rows) of x_data, n_rows <= kRowBlockSize.
+  void ProcessTreeNodeLeaves(size_t tree_index, const InputType* x_data, int64_t stride, int64_t n_rows,
+                             const TreeNodeElement<ThresholdType>** leaves) const;
+
+  template <bool has_missing_tracks, typename CMP>
+  void ProcessFlatTreeNodeLeaves(int32_t root, const InputType* x_data, int64_t stride, int64_t n_rows,
+                                 const TreeNodeElement<ThresholdType>** leaves, CMP cmp) const;
+
+  void FlattenTrees();
+
   template <typename AGG>
   void ComputeAgg(concurrency::ThreadPool* ttp, const Tensor* X, Tensor* Y, Tensor* label, const AGG& agg) const;
 };
@@ -302,9 +331,73 @@ Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::Init(int parall
       break;
     }
   }
+
+  FlattenTrees();
   return Status::OK();
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::FlattenTrees() {
+  flat_feature_ids_.clear();
+  flat_values_.clear();
+  flat_children_.clear();
+  flat_missing_tracks_true_.clear();
+  flat_roots_.clear();
+  flat_mode_ = NODE_MODE::BRANCH_LEQ;
+
+  // A node reachable from two parents is copied, so bound the size in case the trees are not actual trees.
+  const size_t max_flat_nodes = nodes_.size() * 2;
+  if (!same_mode_ || max_flat_nodes > static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    return;
+  }
+
+  flat_feature_ids_.reserve(nodes_.size());
+  flat_values_.reserve(nodes_.size());
+  flat_children_.reserve(nodes_.size());
+  flat_roots_.reserve(roots_.size());
+
+  bool flattened = true;
+  std::vector<const TreeNodeElement<ThresholdType>*> queue;
+  for (const auto* root : roots_) {
+    const int32_t base = static_cast<int32_t>(flat_feature_ids_.size());
+    flat_roots_.push_back(base);
+
+    // The nodes of a tree are stored in the order they are visited.
+    queue.clear();
+    queue.push_back(root);
+    for (size_t q = 0; q < queue.size() && flattened; ++q) {
+      const auto* node = queue[q];
+      if (!node->is_not_leaf) {
+        flat_feature_ids_.push_back(-1);
+        flat_values_.push_back(0);
+        flat_children_.push_back(static_cast<int32_t>(node - nodes_.data()));
+      } else if (node->truenode == nullptr || node->falsenode == nullptr ||
+                 base + queue.size() + 2 > max_flat_nodes) {
+        flattened = false;
+      } else {
+        flat_mode_ = node->mode;
+        flat_feature_ids_.push_back(node->feature_id);
+        flat_values_.push_back(node->value);
+        flat_children_.push_back(base + static_cast<int32_t>(queue.size()));
+        queue.push_back(node->truenode);
+        queue.push_back(node->falsenode);
+      }
+      if (has_missing_tracks_) {
+        flat_missing_tracks_true_.push_back(node->is_missing_track_true ? 1 : 0);
+      }
+    }
+
+    if (!flattened) {
+      flat_feature_ids_.clear();
+      flat_values_.clear();
+      flat_children_.clear();
+      flat_missing_tracks_true_.clear();
+      flat_roots_.clear();
+      return;
+    }
+  }
+}
+
 template <typename InputType, typename ThresholdType, typename OutputType>
 Status TreeEnsembleCommon<InputType, ThresholdType, OutputType>::compute(OpKernelContext* ctx,
                                                                          const Tensor* X,
@@ -368,16 +461,20 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
     if (N == 1) {
       ScoreValue<ThresholdType> score = {0, 0};
       if (n_trees_ <= parallel_tree_) { /* section A: 1 output, 1 row and not enough trees to parallelize */
+        const TreeNodeElement<ThresholdType>* leaf;
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data));
+          ProcessTreeNodeLeaves(onnxruntime::narrow<size_t>(j), x_data, stride, 1, &leaf);
+          agg.ProcessTreeNodePrediction1(score, *leaf);
         }
       } else { /* section B: 1 output, 1 row and enough trees to parallelize */
         std::vector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_trees_), {0, 0});
         concurrency::ThreadPool::TryBatchParallelFor(
             ttp,
             SafeInt<int32_t>(n_trees_),
-            [this, &scores, &agg, x_data](ptrdiff_t j) {
-              agg.ProcessTreeNodePrediction1(scores[j], *ProcessTreeNodeLeave(roots_[j], x_data));
+            [this, &scores, &agg, x_data, stride](ptrdiff_t j) {
+              const TreeNodeElement<ThresholdType>* leaf;
+              ProcessTreeNodeLeaves(j, x_data, stride, 1, &leaf);
+              agg.ProcessTreeNodePrediction1(scores[j], *leaf);
             },
             0);
 
@@ -387,17 +484,23 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
       }
       agg.FinalizeScores1(z_data, score, label_data);
     } else if (N <= parallel_N_) { /* section C: 1 output, 2+ rows but not enough rows to parallelize */
-      ScoreValue<ThresholdType> score;
-      size_t j;
+      ScoreValue<ThresholdType> scores[kRowBlockSize];
+      const TreeNodeElement<ThresholdType>* leaves[kRowBlockSize];
 
-      for (int64_t i = 0; i < N; ++i) {
-        score = {0, 0};
-        for (j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-          agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+      for (int64_t i = 0; i < N; i += kRowBlockSize) {
+        const int64_t n_rows = std::min(kRowBlockSize, N - i);
+        std::fill_n(scores, n_rows, ScoreValue<ThresholdType>({0, 0}));
+        for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
+          ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+          for (int64_t r = 0; r < n_rows; ++r) {
+            agg.ProcessTreeNodePrediction1(scores[r], *leaves[r]);
+          }
         }
 
-        agg.FinalizeScores1(z_data + i, score,
-                            label_data == nullptr ? nullptr : (label_data + i));
+        for (int64_t r = 0; r < n_rows; ++r) {
+          agg.FinalizeScores1(z_data + i + r, scores[r],
+                              label_data == nullptr ? nullptr : (label_data + i + r));
+        }
       }
     } else if (n_trees_ > max_num_threads) { /* section D: 1 output, 2+ rows and enough trees to parallelize */
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
@@ -410,10 +513,14 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             for (int64_t i = 0; i < N; ++i) {
               scores[batch_num * SafeInt<ptrdiff_t>(N) + i] = {0, 0};
             }
+            const TreeNodeElement<ThresholdType>* leaves[kRowBlockSize];
             for (auto j = work.start; j < work.end; ++j) {
-              for (int64_t i = 0; i < N; ++i) {
-                agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                               *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+              for (int64_t i = 0; i < N; i += kRowBlockSize) {
+                const int64_t n_rows = std::min(kRowBlockSize, N - i);
+                ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+                for (int64_t r = 0; r < n_rows; ++r) {
+                  agg.ProcessTreeNodePrediction1(scores[batch_num * SafeInt<ptrdiff_t>(N) + i + r], *leaves[r]);
+                }
               }
             }
           });
@@ -431,18 +538,27 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
                                   label_data == nullptr ? nullptr : (label_data + i));
             }
           });
-    } else { /* section E: 1 output, 2+ rows, parallelization by rows */
+    } else { /* section E: 1 output, 2+ rows, parallelization by blocks of rows */
       concurrency::ThreadPool::TryBatchParallelFor(
           ttp,
-          SafeInt<int32_t>(N),
-          [this, &agg, x_data, z_data, stride, label_data](ptrdiff_t i) {
-            ScoreValue<ThresholdType> score = {0, 0};
+          SafeInt<int32_t>((N + kRowBlockSize - 1) / kRowBlockSize),
+          [this, &agg, x_data, z_data, stride, label_data, N](ptrdiff_t block) {
+            const int64_t i = block * kRowBlockSize;
+            const int64_t n_rows = std::min(kRowBlockSize, N - i);
+            ScoreValue<ThresholdType> scores[kRowBlockSize];
+            const TreeNodeElement<ThresholdType>* leaves[kRowBlockSize];
+            std::fill_n(scores, n_rows, ScoreValue<ThresholdType>({0, 0}));
             for (size_t j = 0; j < static_cast<size_t>(n_trees_); ++j) {
-              agg.ProcessTreeNodePrediction1(score, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+              ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+              for (int64_t r = 0; r < n_rows; ++r) {
+                agg.ProcessTreeNodePrediction1(scores[r], *leaves[r]);
+              }
             }
 
-            agg.FinalizeScores1(z_data + i, score,
-                                label_data == nullptr ? nullptr : (label_data + i));
+            for (int64_t r = 0; r < n_rows; ++r) {
+              agg.FinalizeScores1(z_data + i + r, scores[r],
+                                  label_data == nullptr ? nullptr : (label_data + i + r));
+            }
           },
           0);
     }
@@ -450,8 +566,10 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
     if (N == 1) {                       /* section A2: 2+ outputs, 1 row, not enough trees to parallelize */
       if (n_trees_ <= parallel_tree_) { /* section A2 */
         InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
+        const TreeNodeElement<ThresholdType>* leaf;
         for (int64_t j = 0; j < n_trees_; ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[onnxruntime::narrow<size_t>(j)], x_data));
+          ProcessTreeNodeLeaves(onnxruntime::narrow<size_t>(j), x_data, stride, 1, &leaf);
+          agg.ProcessTreeNodePrediction(scores, *leaf);
         }
         agg.FinalizeScores(scores, z_data, -1, label_data);
       } else { /* section B2: 2+ outputs, 1 row, enough trees to parallelize */
@@ -460,11 +578,13 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
         concurrency::ThreadPool::TrySimpleParallelFor(
             ttp,
             num_threads,
-            [this, &agg, &scores, num_threads, x_data](ptrdiff_t batch_num) {
+            [this, &agg, &scores, num_threads, x_data, stride](ptrdiff_t batch_num) {
               scores[batch_num].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
               auto work = concurrency::ThreadPool::PartitionWork(batch_num, num_threads, onnxruntime::narrow<size_t>(n_trees_));
+              const TreeNodeElement<ThresholdType>* leaf;
               for (auto j = work.start; j < work.end; ++j) {
-                agg.ProcessTreeNodePrediction(scores[batch_num], *ProcessTreeNodeLeave(roots_[j], x_data));
+                ProcessTreeNodeLeaves(j, x_data, stride, 1, &leaf);
+                agg.ProcessTreeNodePrediction(scores[batch_num], *leaf);
               }
             });
         for (size_t i = 1, limit = scores.size(); i < limit; ++i) {
@@ -473,17 +593,26 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
         agg.FinalizeScores(scores[0], z_data, -1, label_data);
       }
     } else if (N <= parallel_N_) { /* section C2: 2+ outputs, 2+ rows, not enough rows to parallelize */
-      InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_));
-      size_t j, limit;
+      std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(
+          kRowBlockSize, InlinedVector<ScoreValue<ThresholdType>>(onnxruntime::narrow<size_t>(n_targets_or_classes_)));
+      const TreeNodeElement<ThresholdType>* leaves[kRowBlockSize];
 
-      for (int64_t i = 0; i < N; ++i) {
-        std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
-        for (j = 0, limit = roots_.size(); j < limit; ++j) {
-          agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+      for (int64_t i = 0; i < N; i += kRowBlockSize) {
+        const int64_t n_rows = std::min(kRowBlockSize, N - i);
+        for (int64_t r = 0; r < n_rows; ++r) {
+          std::fill(scores[r].begin(), scores[r].end(), ScoreValue<ThresholdType>({0, 0}));
+        }
+        for (size_t j = 0, limit = roots_.size(); j < limit; ++j) {
+          ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+          for (int64_t r = 0; r < n_rows; ++r) {
+            agg.ProcessTreeNodePrediction(scores[r], *leaves[r]);
+          }
         }
 
-        agg.FinalizeScores(scores, z_data + i * n_targets_or_classes_, -1,
-                           label_data == nullptr ? nullptr : (label_data + i));
+        for (int64_t r = 0; r < n_rows; ++r) {
+          agg.FinalizeScores(scores[r], z_data + (i + r) * n_targets_or_classes_, -1,
+                             label_data == nullptr ? nullptr : (label_data + i + r));
+        }
       }
     } else if (n_trees_ >= max_num_threads) { /* section: D2: 2+ outputs, 2+ rows, enough trees to parallelize*/
       auto num_threads = std::min<int32_t>(max_num_threads, SafeInt<int32_t>(n_trees_));
@@ -496,10 +625,14 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
             for (int64_t i = 0; i < N; ++i) {
               scores[batch_num * SafeInt<ptrdiff_t>(N) + i].resize(onnxruntime::narrow<size_t>(n_targets_or_classes_), {0, 0});
             }
+            const TreeNodeElement<ThresholdType>* leaves[kRowBlockSize];
             for (auto j = work.start; j < work.end; ++j) {
-              for (int64_t i = 0; i < N; ++i) {
-                agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i],
-                                              *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+              for (int64_t i = 0; i < N; i += kRowBlockSize) {
+                const int64_t n_rows = std::min(kRowBlockSize, N - i);
+                ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+                for (int64_t r = 0; r < n_rows; ++r) {
+                  agg.ProcessTreeNodePrediction(scores[batch_num * SafeInt<ptrdiff_t>(N) + i + r], *leaves[r]);
+                }
               }
             }
           });
@@ -523,19 +656,28 @@ void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ComputeAgg(concur
           ttp,
           num_threads,
           [this, &agg, num_threads, x_data, z_data, label_data, N, stride](ptrdiff_t batch_num) {
-            size_t j, limit;
-            InlinedVector<ScoreValue<ThresholdType>> scores(onnxruntime::narrow<size_t>(n_targets_or_classes_));
+            std::vector<InlinedVector<ScoreValue<ThresholdType>>> scores(
+                kRowBlockSize, InlinedVector<ScoreValue<ThresholdType>>(onnxruntime::narrow<size_t>(n_targets_or_classes_)));
+            const TreeNodeElement<ThresholdType>* leaves[kRowBlockSize];
             auto work = concurrency::ThreadPool::PartitionWork(batch_num, onnxruntime::narrow<ptrdiff_t>(num_threads), onnxruntime::narrow<ptrdiff_t>(N));
 
-            for (auto i = work.start; i < work.end; ++i) {
-              std::fill(scores.begin(), scores.end(), ScoreValue<ThresholdType>({0, 0}));
-              for (j = 0, limit = roots_.size(); j < limit; ++j) {
-                agg.ProcessTreeNodePrediction(scores, *ProcessTreeNodeLeave(roots_[j], x_data + i * stride));
+            for (auto i = work.start; i < work.end; i += kRowBlockSize) {
+              const int64_t n_rows = std::min<int64_t>(kRowBlockSize, work.end - i);
+              for (int64_t r = 0; r < n_rows; ++r) {
+                std::fill(scores[r].begin(), scores[r].end(), ScoreValue<ThresholdType>({0, 0}));
+              }
+              for (size_t j = 0, limit = roots_.size(); j < limit; ++j) {
+                ProcessTreeNodeLeaves(j, x_data + i * stride, stride, n_rows, leaves);
+                for (int64_t r = 0; r < n_rows; ++r) {
+                  agg.ProcessTreeNodePrediction(scores[r], *leaves[r]);
+                }
               }
 
-              agg.FinalizeScores(scores,
-                                 z_data + i * n_targets_or_classes_, -1,
-                                 label_data == nullptr ? nullptr : (label_data + i));
+              for (int64_t r = 0; r < n_rows; ++r) {
+                agg.FinalizeScores(scores[r],
+                                   z_data + (i + r) * n_targets_or_classes_, -1,
+                                   label_data == nullptr ? nullptr : (label_data + i + r));
+              }
             }
           });
     }
@@ -648,6 +790,85 @@ TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeave(
   return root;
 }
 
+template <typename InputType, typename ThresholdType, typename OutputType>
+template <bool has_missing_tracks, typename CMP>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessFlatTreeNodeLeaves(
+    int32_t root, const InputType* x_data, int64_t stride, int64_t n_rows,
+    const TreeNodeElement<ThresholdType>** leaves, CMP cmp) const {
+  const int32_t* feature_ids = flat_feature_ids_.data();
+  const ThresholdType* values = flat_values_.data();
+  const int32_t* children = flat_children_.data();
+  const uint8_t* missing_tracks_true = flat_missing_tracks_true_.data();
+
+  // Every row of the block moves down one level per pass, so the loads of the rows are independent.
+  int32_t ids[kRowBlockSize];
+  std::fill_n(ids, n_rows, root);
+  bool active = true;
+  while (active) {
+    active = false;
+    for (int64_t r = 0; r < n_rows; ++r) {
+      const int32_t id = ids[r];
+      const int32_t feature_id = feature_ids[id];
+      if (feature_id >= 0) {
+        const InputType val = x_data[r * stride + feature_id];
+        const bool is_true = cmp(val, values[id]) ||
+                             (has_missing_tracks && missing_tracks_true[id] && _isnan_(val));
+        ids[r] = children[id] + (is_true ? 0 : 1);
+        active = true;
+      }
+    }
+  }
+
+  for (int64_t r = 0; r < n_rows; ++r) {
+    leaves[r] = &nodes_[children[ids[r]]];
+  }
+}
+
+#define TREE_FIND_LEAVES(CMP)                                                                        \
+  {                                                                                                  \
+    auto cmp = [](InputType val, ThresholdType threshold) { return val CMP threshold; };            \
+    if (has_missing_tracks_) {                                                                       \
+      ProcessFlatTreeNodeLeaves<true>(flat_roots_[tree_index], x_data, stride, n_rows, leaves, cmp);  \
+    } else {                                                                                         \
+      ProcessFlatTreeNodeLeaves<false>(flat_roots_[tree_index], x_data, stride, n_rows, leaves, cmp); \
+    }                                                                                                \
+  }
+
+template <typename InputType, typename ThresholdType, typename OutputType>
+void TreeEnsembleCommon<InputType, ThresholdType, OutputType>::ProcessTreeNodeLeaves(
+    size_t tree_index, const InputType* x_data, int64_t stride, int64_t n_rows,
+    const TreeNodeElement<ThresholdType>** leaves) const {
+  if (flat_roots_.empty()) {
+    for (int64_t r = 0; r < n_rows; ++r) {
+      leaves[r] = ProcessTreeNodeLeave(roots_[tree_index], x_data + r * stride);
+    }
+    return;
+  }
+
+  switch (flat_mode_) {
+    case NODE_MODE::BRANCH_LEQ:
+      TREE_FIND_LEAVES(<=)
+      break;
+    case NODE_MODE::BRANCH_LT:
+      TREE_FIND_LEAVES(<)
+      break;
+    case NODE_MODE::BRANCH_GTE:
+      TREE_FIND_LEAVES(>=)
+      break;
+    case NODE_MODE::BRANCH_GT:
+      TREE_FIND_LEAVES(>)
+      break;
+    case NODE_MODE::BRANCH_EQ:
+      TREE_FIND_LEAVES(==)
+      break;
+    case NODE_MODE::BRANCH_NEQ:
+      TREE_FIND_LEAVES(!=)
+      break;
+    case NODE_MODE::LEAF:
+      break;
+  }
+}
+
 // TI: input type
 // TH: threshold type, double if T==double, float otherwise
 // TO: output type
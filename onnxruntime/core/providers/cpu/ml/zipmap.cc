@@ -2,6 +2,11 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/ml/zipmap.h"
+
+#include <algorithm>
+#include <numeric>
+
+#include "core/platform/threadpool.h"
 #include "core/util/math_cpuonly.h"
 /**
 https://github.com/onnx/onnx/blob/main/onnx/defs/traditionalml/defs.cc
@@ -35,6 +40,30 @@ ONNX_CPU_OPERATOR_ML_KERNEL(
                                             DataTypeImpl::GetType<std::vector<std::map<std::int64_t, float>>>()}),
     ZipMapOp);
 
+namespace {
+
+// Returns the indices of the labels in ascending label order. A repeated label keeps its last index,
+// which is the value the map of the label ends up with when the labels are inserted in order.
+template <typename TLabel>
+std::vector<size_t> SortedLabelIndices(const std::vector<TLabel>& labels) {
+  std::vector<size_t> indices(labels.size());
+  std::iota(indices.begin(), indices.end(), size_t{0});
+  std::stable_sort(indices.begin(), indices.end(),
+                   [&labels](size_t a, size_t b) { return labels[a] < labels[b]; });
+
+  std::vector<size_t> unique_indices;
+  unique_indices.reserve(indices.size());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    if (i + 1 < indices.size() && labels[indices[i + 1]] == labels[indices[i]]) {
+      continue;
+    }
+    unique_indices.push_back(indices[i]);
+  }
+  return unique_indices;
+}
+
+}  // namespace
+
 ZipMapOp::ZipMapOp(const OpKernelInfo& info)
     : OpKernel(info),
       classlabels_int64s_(info.GetAttrsOrDefault<int64_t>("classlabels_int64s")),
@@ -42,6 +71,40 @@ ZipMapOp::ZipMapOp(const OpKernelInfo& info)
   ORT_ENFORCE(classlabels_strings_.empty() ^ classlabels_int64s_.empty(),
               "Must provide classlabels_strings or classlabels_int64s but not both.");
   using_strings_ = !classlabels_strings_.empty();
+  sorted_label_indices_ = using_strings_ ? SortedLabelIndices(classlabels_strings_)
+                                         : SortedLabelIndices(classlabels_int64s_);
+}
+
+template <typename TLabel>
+common::Status ZipMapOp::ComputeImpl(OpKernelContext* context, const std::vector<TLabel>& labels,
+                                     const float* x_data, int64_t batch_size) const {
+  auto* y_data = context->Output<std::vector<std::map<TLabel, float>>>(0);
+  if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
+
+  const size_t num_labels = labels.size();
+  y_data->resize(onnxruntime::narrow<size_t>(batch_size));
+
+  // the labels are appended in ascending order, so each insertion is a constant time append at the end of the map
+  // instead of a search from its root
+  auto* maps = y_data->data();
+  const double num_entries = static_cast<double>(sorted_label_indices_.size());
+  const TensorOpCost cost{static_cast<double>(num_labels * sizeof(float)),
+                          num_entries * static_cast<double>(sizeof(std::pair<const TLabel, float>)),
+                          num_entries * (std::is_same_v<TLabel, std::string> ? 40.0 : 20.0)};
+  concurrency::ThreadPool::TryParallelFor(
+      context->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(batch_size), cost,
+      [this, &labels, maps, x_data, num_labels](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t n = first; n < last; ++n) {
+          const float* x_row = x_data + static_cast<size_t>(n) * num_labels;
+          std::map<TLabel, float> row;
+          for (size_t j : sorted_label_indices_) {
+            row.emplace_hint(row.end(), labels[j], x_row[j]);
+          }
+          maps[n] = std::move(row);
+        }
+      });
+
+  return common::Status::OK();
 }
 
 common::Status ZipMapOp::Compute(OpKernelContext* context) const {
@@ -67,49 +130,16 @@ common::Status ZipMapOp::Compute(OpKernelContext* context) const {
 
   const auto* x_data = X.Data<float>();
 
-  if (using_strings_) {
-    if (features_per_batch != static_cast<int64_t>(classlabels_strings_.size())) {
-      return Status(ONNXRUNTIME,
-                    INVALID_ARGUMENT,
-                    "Input features_per_batch[" + std::to_string(features_per_batch) +
-                        "] != number of classlabels[" + std::to_string(classlabels_strings_.size()) + "]");
-    }
-    auto* y_data = context->Output<std::vector<std::map<std::string, float>>>(0);
-    if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-
-    //auto* y_data = Y->MutableData<std::vector<std::map<std::string, float>>>();
-    y_data->resize(onnxruntime::narrow<size_t>(batch_size));
-    int64_t current_weight_0 = 0;
-    for (int64_t n = 0; n < batch_size; n++) {
-      std::map<std::string, float> map1;
-      for (int64_t j = 0; j < features_per_batch; j++) {
-        map1[classlabels_strings_[onnxruntime::narrow<size_t>(j)]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[onnxruntime::narrow<size_t>(n)] = std::move(map1);
-    }
-  } else {
-    if (features_per_batch != static_cast<int64_t>(classlabels_int64s_.size())) {
-      return Status(ONNXRUNTIME,
-                    INVALID_ARGUMENT,
-                    "Input features_per_batch[" + std::to_string(features_per_batch) +
-                        "] != number of classlabels[" + std::to_string(classlabels_int64s_.size()) + "]");
-    }
-    auto* y_data = context->Output<std::vector<std::map<std::int64_t, float>>>(0);
-    if (y_data == nullptr) return Status(common::ONNXRUNTIME, common::FAIL, "input count mismatch");
-    //auto* y_data = Y->MutableData<std::vector<std::map<int64_t, float>>>();
-    y_data->resize(onnxruntime::narrow<size_t>(batch_size));
-    int64_t current_weight_0 = 0;
-    for (int n = 0; n < batch_size; n++) {
-      std::map<int64_t, float> map2;
-      for (int j = 0; j < features_per_batch; j++) {
-        map2[classlabels_int64s_[j]] = x_data[current_weight_0 + j];
-      }
-      current_weight_0 += features_per_batch;
-      (*y_data)[n] = std::move(map2);
-    }
+  const size_t num_labels = using_strings_ ? classlabels_strings_.size() : classlabels_int64s_.size();
+  if (features_per_batch != static_cast<int64_t>(num_labels)) {
+    return Status(ONNXRUNTIME,
+                  INVALID_ARGUMENT,
+                  "Input features_per_batch[" + std::to_string(features_per_batch) +
+                      "] != number of classlabels[" + std::to_string(num_labels) + "]");
   }
-  return common::Status::OK();
+
+  return using_strings_ ? ComputeImpl(context, classlabels_strings_, x_data, batch_size)
+                        : ComputeImpl(context, classlabels_int64s_, x_data, batch_size);
 }
 }  // namespace ml
 }  // namespace onnxruntime
@@ -13,9 +13,17 @@ class ZipMapOp final : public OpKernel {
   common::Status Compute(OpKernelContext* context) const override;
 
  private:
+  template <typename TLabel>
+  common::Status ComputeImpl(OpKernelContext* context, const std::vector<TLabel>& labels, const float* x_data,
+                             int64_t batch_size) const;
+
   bool using_strings_;
   std::vector<int64_t> classlabels_int64s_;
   std::vector<std::string> classlabels_strings_;
+
+  // indices of the labels in ascending label order, with the last index of a repeated label,
+  // so each map is built by appending at its end
+  std::vector<size_t> sorted_label_indices_;
 };
 
 }  // namespace ml
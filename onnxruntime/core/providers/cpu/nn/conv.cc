@@ -17,6 +17,8 @@
 
 #include "core/providers/cpu/nn/conv.h"
 
+#include <algorithm>
+
 #include "core/common/narrow.h"
 #include "core/common/safeint.h"
 #include "core/util/math_cpuonly.h"
@@ -153,15 +155,48 @@ Status Conv<T>::Compute(OpKernelContext* context) const {
   return Status::OK();
 }
 
+Status Conv<float>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                            /*out*/ bool& is_packed,
+                            /*out*/ PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+
+  // only transform the filter of 2D 3x3 convolutions with unit strides and dilations
+  const auto& filter_shape = tensor.Shape();
+  if (input_idx != 1 || filter_shape.NumDimensions() != 4 || filter_shape[2] != 3 || filter_shape[3] != 3) {
+    return Status::OK();
+  }
+  const auto is_one = [](int64_t value) { return value == 1; };
+  if (!std::all_of(conv_attrs_.strides.begin(), conv_attrs_.strides.end(), is_one) ||
+      !std::all_of(conv_attrs_.dilations.begin(), conv_attrs_.dilations.end(), is_one)) {
+    return Status::OK();
+  }
+
+  const size_t group_count = onnxruntime::narrow<size_t>(conv_attrs_.group);
+  const size_t filter_count = onnxruntime::narrow<size_t>(filter_shape[0]) / group_count;
+  const size_t input_channels = onnxruntime::narrow<size_t>(filter_shape[1]);
+  const size_t tile_size = MlasConvWinogradTileSize(input_channels, filter_count);
+  if (tile_size == 0) {
+    return Status::OK();
+  }
+
+  const size_t packed_filter_size =
+      SafeInt<size_t>(MlasConvWinogradPackedFilterSize(tile_size, group_count, filter_count, input_channels)) *
+      sizeof(float);
+  auto* packed_filter_data = alloc->Alloc(packed_filter_size);
+  MlasConvWinogradPackFilter(tile_size, group_count, filter_count, input_channels, tensor.Data<float>(),
+                             static_cast<float*>(packed_filter_data));
+  winograd_filter_ = BufferUniquePtr(packed_filter_data, BufferDeleter(std::move(alloc)));
+  winograd_tile_size_ = tile_size;
+
+  return Status::OK();
+}
+
 Status Conv<float>::Compute(OpKernelContext* context) const {
   size_t num_inputs = OpKernel::Node().InputDefs().size();
   const Tensor* X = context->Input<Tensor>(0);
   const Tensor* W = context->Input<Tensor>(1);
   const Tensor* B = num_inputs >= 3 ? context->Input<Tensor>(2) : nullptr;
   const Tensor* Sum = num_inputs >= 4 ? context->Input<Tensor>(3) : nullptr;
-  const int64_t N = X->Shape()[0];
-  const int64_t C = X->Shape()[1];
-  const int64_t M = W->Shape()[0];
   ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
 
   // kernel_shape is an optional attribute and has to be inferred from W if not provided
@@ -181,20 +216,56 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
     strides.resize(kernel_shape.size(), 1);
   }
 
+  AllocatorPtr alloc;
+  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+  // In streaming mode the innermost axis is not padded, its leading pad is the initial left context instead.
+  std::unique_lock<OrtMutex> streaming_lock;
+  Tensor streaming_input;
+  const size_t time_axis = kernel_shape.size() - 1;
+  if (streaming_context_ != nullptr && !kernel_shape.empty()) {
+    streaming_lock = std::unique_lock<OrtMutex>(streaming_context_->Mutex());
+    streaming_context_->Prepend(*X, pads[time_axis], alloc, streaming_input);
+    pads[time_axis] = 0;
+    pads[time_axis + kernel_shape.size()] = 0;
+    X = &streaming_input;
+  }
+
+  const int64_t N = X->Shape()[0];
+  const int64_t C = X->Shape()[1];
+  const int64_t M = W->Shape()[0];
+
   TensorShapeVector Y_dims({N, M});
   TensorShape input_shape = X->Shape().Slice(2);
+
+  if (streaming_lock.owns_lock()) {
+    // Until the frames fill the kernel there are no outputs and all the frames are kept for the next run.
+    const int64_t time_extent = dilations[time_axis] * (kernel_shape[time_axis] - 1) + 1;
+    if (input_shape[time_axis] < time_extent) {
+      TensorShape filled_shape(input_shape);
+      filled_shape[time_axis] = time_extent;
+      ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(filled_shape, kernel_shape, strides, dilations, pads, Y_dims));
+      Y_dims.back() = 0;
+      context->Output(0, TensorShape(Y_dims));
+      streaming_context_->Keep(*X, 0);
+      return Status::OK();
+    }
+  }
+
   ORT_RETURN_IF_ERROR(conv_attrs_.InferPadsAndOutputShape(input_shape, kernel_shape, strides, dilations, pads, Y_dims));
   Tensor* Y = context->Output(0, TensorShape(Y_dims));
   TensorShape output_shape = Y->Shape().Slice(2);
 
+  // The frames from the first one of the next output onwards are the left context of the next run.
+  if (streaming_lock.owns_lock()) {
+    streaming_context_->Keep(*X, output_shape[time_axis] * strides[time_axis]);
+  }
+
   // Bail out early if one of the dimensions is zero.
   if (Y->Shape().Size() == 0) {
     return Status::OK();
   }
 
-  AllocatorPtr alloc;
-  ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
-
   const auto* Xdata = X->Data<float>();
   const auto* Bdata = B != nullptr ? B->Data<float>() : nullptr;
   auto* Ydata = Y->MutableData<float>();
@@ -233,6 +304,11 @@ Status Conv<float>::Compute(OpKernelContext* context) const {
                     Beta,
                     thread_pool);
 
+    if (winograd_filter_ != nullptr) {
+      MlasConvPrepareWinograd(&Parameters, winograd_tile_size_, static_cast<const float*>(winograd_filter_.get()),
+                              &WorkingBufferSize, thread_pool);
+    }
+
     auto* working_data = WorkingBufferSize > 0 ? alloc->Alloc(sizeof(float) * SafeInt<size_t>(WorkingBufferSize))
                                                : nullptr;
     BufferUniquePtr working_buffer(working_data, BufferDeleter(std::move(alloc)));
@@ -5,6 +5,7 @@
 
 #include "core/framework/op_kernel.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
+#include "core/providers/cpu/nn/streaming_context.h"
 #include "core/mlas/inc/mlas.h"
 
 namespace onnxruntime {
@@ -26,14 +27,32 @@ class Conv<float> : public OpKernel {
  public:
   Conv(const OpKernelInfo& info) : OpKernel(info), conv_attrs_(info) {
     activation_.ActivationKind = MlasIdentityActivation;
+    if (IsStreamingNode(info)) {
+      ORT_ENFORCE(conv_attrs_.auto_pad == AutoPadType::NOTSET || conv_attrs_.auto_pad == AutoPadType::VALID,
+                  "A streaming Conv node must have explicit pads");
+      streaming_context_ = std::make_unique<StreamingContext>();
+    }
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
   Status Compute(OpKernelContext* context) const override;
-  
+
  protected:
   MLAS_ACTIVATION activation_;
 
   ConvAttributes conv_attrs_;
+
+ private:
+  // Left context of the innermost axis kept between runs if the node is run in streaming mode
+  std::unique_ptr<StreamingContext> streaming_context_;
+
+  // Filter transformed for the Winograd algorithm of 3x3 convolutions, the original filter is kept for the
+  // input shapes the algorithm doesn't support.
+  BufferUniquePtr winograd_filter_;
+  size_t winograd_tile_size_{0};
 };
 
 }  // namespace onnxruntime
@@ -17,6 +17,8 @@
 
 #include "core/providers/cpu/nn/conv_transpose.h"
 
+#include <algorithm>
+
 #include "core/mlas/inc/mlas.h"
 #include "core/common/safeint.h"
 #include "core/util/math.h"
@@ -36,6 +38,210 @@ ONNX_CPU_OPERATOR_KERNEL(
     KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
     ConvTranspose<float>);
 
+namespace {
+
+// Returns the number of filter taps with an index congruent to residue modulo stride.
+inline int64_t SubpixelTapCount(int64_t kernel, int64_t stride, int64_t residue) {
+  return residue < kernel ? (kernel - residue + stride - 1) / stride : 0;
+}
+
+// A 2D ConvTranspose with unit dilations and a stride greater than one is computed by decomposing the output into
+// stride_h x stride_w phases. The outputs of one phase are a stride one convolution of the input with the filter taps
+// of one residue class modulo the strides, so every phase is a GEMM whose results are stored to the output directly
+// instead of accumulating a column buffer of the whole filter into the output with col2im.
+bool UseSubpixelConvTranspose(const ConvTransposeAttributes& attrs, const TensorShape& filter_shape) {
+  if (filter_shape.NumDimensions() != 4 || attrs.strides.size() != 2 ||
+      attrs.strides[0] < 1 || attrs.strides[1] < 1 || (attrs.strides[0] == 1 && attrs.strides[1] == 1)) {
+    return false;
+  }
+  return std::all_of(attrs.dilations.begin(), attrs.dilations.end(), [](int64_t d) { return d == 1; });
+}
+
+// Packs the filter [C][M/group][KH][KW] for each residue class (rh, rw) of the filter taps and each group as the
+// GEMM A matrix [M/group][C/group][TH][TW] that holds the taps (rh + th * stride_h, rw + tw * stride_w).
+void PackSubpixelFilter(const float* filter, float* packed, const TensorShape& filter_shape, int64_t group,
+                        int64_t stride_h, int64_t stride_w) {
+  const int64_t group_input_channels = filter_shape[0] / group;
+  const int64_t group_output_channels = filter_shape[1];
+  const int64_t kernel_h = filter_shape[2];
+  const int64_t kernel_w = filter_shape[3];
+
+  for (int64_t rh = 0; rh < stride_h; rh++) {
+    const int64_t taps_h = SubpixelTapCount(kernel_h, stride_h, rh);
+    for (int64_t rw = 0; rw < stride_w; rw++) {
+      const int64_t taps_w = SubpixelTapCount(kernel_w, stride_w, rw);
+      for (int64_t group_id = 0; group_id < group; group_id++) {
+        for (int64_t m = 0; m < group_output_channels; m++) {
+          for (int64_t c = 0; c < group_input_channels; c++) {
+            const float* f = filter + ((group_id * group_input_channels + c) * group_output_channels + m) *
+                                          kernel_h * kernel_w;
+            for (int64_t th = 0; th < taps_h; th++) {
+              for (int64_t tw = 0; tw < taps_w; tw++) {
+                *packed++ = f[(rh + th * stride_h) * kernel_w + (rw + tw * stride_w)];
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+Status SubpixelConvTranspose(const ConvTransposeAttributes::Prepare& p, int64_t group, const float* packed_filter,
+                             const AllocatorPtr& alloc, concurrency::ThreadPool* thread_pool) {
+  const int64_t group_input_channels = p.num_input_channels / group;
+  const int64_t group_output_channels = p.num_output_channels / group;
+  const int64_t input_h = p.input_shape[0];
+  const int64_t input_w = p.input_shape[1];
+  const int64_t input_image_size = input_h * input_w;
+  const int64_t output_h = p.Y->Shape()[2];
+  const int64_t output_w = p.Y->Shape()[3];
+  const int64_t output_image_size = output_h * output_w;
+  const int64_t kernel_h = p.kernel_shape[0];
+  const int64_t kernel_w = p.kernel_shape[1];
+  const int64_t stride_h = p.strides[0];
+  const int64_t stride_w = p.strides[1];
+
+  // Find the offset of the packed filter of each residue class.
+  std::vector<int64_t> residue_offsets;
+  int64_t residue_offset = 0;
+  for (int64_t rh = 0; rh < stride_h; rh++) {
+    for (int64_t rw = 0; rw < stride_w; rw++) {
+      residue_offsets.push_back(residue_offset);
+      residue_offset += p.num_output_channels * group_input_channels * SubpixelTapCount(kernel_h, stride_h, rh) *
+                        SubpixelTapCount(kernel_w, stride_w, rw);
+    }
+  }
+
+  // Batch the GEMMs of all groups and of as many images as fit in the column buffer that col2im needs for one
+  // image.
+  const int64_t max_phase_size = ((output_h + stride_h - 1) / stride_h) * ((output_w + stride_w - 1) / stride_w);
+  const int64_t max_taps = group_input_channels * ((kernel_h + stride_h - 1) / stride_h) *
+                           ((kernel_w + stride_w - 1) / stride_w);
+  const int64_t image_buffer_size = group * (max_taps + group_output_channels) * max_phase_size;
+  const int64_t col2im_buffer_size = group_output_channels * kernel_h * kernel_w * input_image_size;
+  const int64_t images_per_batch = std::clamp<int64_t>(col2im_buffer_size / std::max<int64_t>(image_buffer_size, 1),
+                                                       1, p.N);
+
+  auto* phase_output = static_cast<float*>(
+      alloc->Alloc(SafeInt<size_t>(sizeof(float)) * images_per_batch * p.num_output_channels * max_phase_size));
+  BufferUniquePtr phase_output_buffer(phase_output, BufferDeleter(alloc));
+  float* col_data = nullptr;
+  BufferUniquePtr col_buffer;
+
+  std::vector<MLAS_SGEMM_DATA_PARAMS> gemm_params(narrow<size_t>(images_per_batch * group));
+
+  const float* Bdata = p.B != nullptr ? p.B->Data<float>() : nullptr;
+
+  for (int64_t image_start = 0; image_start < p.N; image_start += images_per_batch) {
+    const int64_t image_count = std::min(images_per_batch, p.N - image_start);
+    const int64_t batch_count = image_count * group;
+    const float* Xdata = p.X->Data<float>() + image_start * p.num_input_channels * input_image_size;
+    float* Ydata = p.Y->MutableData<float>() + image_start * p.num_output_channels * output_image_size;
+
+    for (int64_t ph = 0; ph < std::min(stride_h, output_h); ph++) {
+      for (int64_t pw = 0; pw < std::min(stride_w, output_w); pw++) {
+        const int64_t phase_h = (output_h - ph + stride_h - 1) / stride_h;
+        const int64_t phase_w = (output_w - pw + stride_w - 1) / stride_w;
+        const int64_t phase_size = phase_h * phase_w;
+
+        // The output (ph + j * stride_h) is reached by the filter taps (rh + th * stride_h) from the input rows
+        // (j + base_h - th), and likewise for the columns.
+        const int64_t rh = ((ph + p.pads[0]) % stride_h + stride_h) % stride_h;
+        const int64_t rw = ((pw + p.pads[1]) % stride_w + stride_w) % stride_w;
+        const int64_t base_h = (ph + p.pads[0] - rh) / stride_h;
+        const int64_t base_w = (pw + p.pads[1] - rw) / stride_w;
+        const int64_t taps_h = SubpixelTapCount(kernel_h, stride_h, rh);
+        const int64_t taps_w = SubpixelTapCount(kernel_w, stride_w, rw);
+        const int64_t taps = group_input_channels * taps_h * taps_w;
+
+        if (taps > 0) {
+          // A filter no larger than the strides without padding reads the input directly.
+          const bool direct = taps_h == 1 && taps_w == 1 && base_h == 0 && base_w == 0 &&
+                              phase_h == input_h && phase_w == input_w;
+
+          if (!direct) {
+            if (col_data == nullptr) {
+              col_data = static_cast<float*>(
+                  alloc->Alloc(SafeInt<size_t>(sizeof(float)) * images_per_batch * group * max_taps * max_phase_size));
+              col_buffer = BufferUniquePtr(col_data, BufferDeleter(alloc));
+            }
+
+            const double row_bytes = static_cast<double>(phase_size * sizeof(float));
+            concurrency::ThreadPool::TryParallelFor(
+                thread_pool, static_cast<std::ptrdiff_t>(batch_count * taps),
+                TensorOpCost{row_bytes, row_bytes, static_cast<double>(phase_size)},
+                [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+                  for (std::ptrdiff_t row = first; row < last; row++) {
+                    const int64_t tap = row % taps;
+                    const int64_t th = (tap / taps_w) % taps_h;
+                    const int64_t tw = tap % taps_w;
+                    const float* input_plane = Xdata + (row / taps_h / taps_w) * input_image_size;
+                    float* col_row = col_data + row * phase_size;
+
+                    const int64_t w_start = std::clamp<int64_t>(tw - base_w, 0, phase_w);
+                    const int64_t w_end = std::clamp<int64_t>(input_w + tw - base_w, w_start, phase_w);
+
+                    for (int64_t j = 0; j < phase_h; j++) {
+                      const int64_t ih = j + base_h - th;
+                      if (ih < 0 || ih >= input_h) {
+                        std::fill_n(col_row, phase_w, 0.0f);
+                      } else {
+                        const float* input_row = input_plane + ih * input_w + (w_start + base_w - tw);
+                        std::fill_n(col_row, w_start, 0.0f);
+                        std::copy_n(input_row, w_end - w_start, col_row + w_start);
+                        std::fill(col_row + w_end, col_row + phase_w, 0.0f);
+                      }
+                      col_row += phase_w;
+                    }
+                  }
+                });
+          }
+
+          const float* residue_filter = packed_filter + residue_offsets[narrow<size_t>(rh * stride_w + rw)];
+          for (int64_t batch = 0; batch < batch_count; batch++) {
+            auto& params = gemm_params[narrow<size_t>(batch)];
+            params.A = residue_filter + (batch % group) * group_output_channels * taps;
+            params.lda = narrow<size_t>(taps);
+            params.B = direct ? Xdata + batch * group_input_channels * input_image_size
+                              : col_data + batch * taps * phase_size;
+            params.ldb = narrow<size_t>(phase_size);
+            params.C = phase_output + batch * group_output_channels * phase_size;
+            params.ldc = narrow<size_t>(phase_size);
+          }
+
+          MlasGemmBatch(CblasNoTrans, CblasNoTrans, narrow<size_t>(group_output_channels), narrow<size_t>(phase_size),
+                        narrow<size_t>(taps), gemm_params.data(), narrow<size_t>(batch_count), thread_pool);
+        }
+
+        // Store the phase to the strided output pixels with the bias. Outputs reached by no filter taps only hold
+        // the bias.
+        const double row_bytes = static_cast<double>(phase_size * sizeof(float));
+        concurrency::ThreadPool::TryParallelFor(
+            thread_pool, static_cast<std::ptrdiff_t>(image_count * p.num_output_channels),
+            TensorOpCost{row_bytes, row_bytes, static_cast<double>(phase_size)},
+            [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+              for (std::ptrdiff_t row = first; row < last; row++) {
+                const float bias = Bdata != nullptr ? Bdata[row % p.num_output_channels] : 0.0f;
+                const float* phase_row = phase_output + row * phase_size;
+                float* output_plane = Ydata + row * output_image_size;
+                for (int64_t j = 0; j < phase_h; j++) {
+                  float* output_row = output_plane + (ph + j * stride_h) * output_w + pw;
+                  for (int64_t i = 0; i < phase_w; i++) {
+                    output_row[i * stride_w] = taps > 0 ? phase_row[j * phase_w + i] + bias : bias;
+                  }
+                }
+              }
+            });
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+}  // namespace
+
 template <typename T>
 Status ConvTranspose<T>::PrePack(const Tensor& /*tensor*/, int /*input_idx*/, AllocatorPtr /*alloc*/,
                                  /*out*/ bool& is_packed,
@@ -58,6 +264,24 @@ Status ConvTranspose<float>::PrePack(const Tensor& tensor, int input_idx, Alloca
     }
     filter_shape_ = tensor.Shape();
 
+    if (UseSubpixelConvTranspose(conv_transpose_attrs_, filter_shape_)) {
+      size_t packed_filter_data_size = SafeInt<size_t>(filter_shape_.Size()) * sizeof(float);
+      auto* packed_filter_data = alloc->Alloc(packed_filter_data_size);
+      transposed_filter_ = BufferUniquePtr(packed_filter_data, BufferDeleter(std::move(alloc)));
+
+      PackSubpixelFilter(tensor.Data<float>(), static_cast<float*>(packed_filter_data), filter_shape_,
+                         conv_transpose_attrs_.group, conv_transpose_attrs_.strides[0],
+                         conv_transpose_attrs_.strides[1]);
+
+      if (prepacked_weights != nullptr) {
+        prepacked_weights->buffers_.push_back(std::move(transposed_filter_));
+        prepacked_weights->buffer_sizes_.push_back(packed_filter_data_size);
+      }
+
+      is_packed = true;
+      return Status::OK();
+    }
+
     const size_t K = static_cast<size_t>(filter_shape_[0]) / onnxruntime::narrow<size_t>(conv_transpose_attrs_.group);
     const size_t N = onnxruntime::narrow<size_t>(filter_shape_.SizeFromDimension(1));
     auto packed_elements_per_group = N * K;
@@ -233,6 +457,25 @@ Status ConvTranspose<float>::DoConvTranspose(OpKernelContext* context, bool dyna
     return Status::OK();
   }
 
+  if (UseSubpixelConvTranspose(conv_transpose_attrs_, p.F ? p.F->Shape() : filter_shape_)) {
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+
+    // Pack the filter if it couldn't be packed ahead of time.
+    const float* packed_filter = static_cast<const float*>(transposed_filter_.get());
+    BufferUniquePtr packed_filter_buffer;
+    if (p.F != nullptr) {
+      auto* packed_filter_data = static_cast<float*>(
+          alloc->Alloc(SafeInt<size_t>(sizeof(float)) * p.F->Shape().Size()));
+      packed_filter_buffer = BufferUniquePtr(packed_filter_data, BufferDeleter(alloc));
+      PackSubpixelFilter(p.F->Data<float>(), packed_filter_data, p.F->Shape(), conv_transpose_attrs_.group,
+                         p.strides[0], p.strides[1]);
+      packed_filter = packed_filter_data;
+    }
+
+    return SubpixelConvTranspose(p, conv_transpose_attrs_.group, packed_filter, alloc, thread_pool);
+  }
+
   const int64_t input_image_size = p.input_shape.Size();
   const int64_t X_offset = p.num_input_channels / conv_transpose_attrs_.group * input_image_size;
   const int64_t Y_offset = p.Y->Shape().Size() / p.Y->Shape()[0] / conv_transpose_attrs_.group;
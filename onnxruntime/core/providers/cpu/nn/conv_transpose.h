@@ -43,7 +43,8 @@ class ConvTranspose : public OpKernel {
  private:
   ConvTransposeAttributes conv_transpose_attrs_;
 
-  // for pre-packing usage
+  // for pre-packing usage. The filter is transposed for the col2im path or packed by residue class of the filter
+  // taps for the sub-pixel path of strided 2D convolutions.
   TensorShape filter_shape_;
   BufferUniquePtr transposed_filter_;
 };
@@ -17,6 +17,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "core/providers/cpu/nn/conv_attributes.h"
 
 namespace onnxruntime {
@@ -43,16 +45,20 @@ struct ConvTransposeAttributes : public ConvAttributes {
     TensorShapeVector strides;
   };
 
+  // With channels_last the input X and the output Y have the channels last layout, filter_shape is expected to give
+  // the filter dims in the channels first order then.
   Status PrepareForCompute(OpKernelContext* context, bool has_bias, Prepare& p,
-                           bool dynamic_padding = false, const TensorShape* filter_shape = nullptr) const {
+                           bool dynamic_padding = false, const TensorShape* filter_shape = nullptr,
+                           bool channels_last = false) const {
     const Tensor* X = context->Input<Tensor>(0);
     const Tensor* F = (filter_shape != nullptr) ? nullptr : context->Input<Tensor>(1);
     const TensorShape& F_Shape = (filter_shape != nullptr) ? *filter_shape : F->Shape();
     const Tensor* Pads = dynamic_padding ? context->Input<Tensor>(2) : nullptr;
     const Tensor* B = has_bias ? (dynamic_padding ? context->Input<Tensor>(3) : context->Input<Tensor>(2)) : nullptr;
-    TensorShape input_shape = X->Shape().Slice(2);
+    const size_t x_rank = X->Shape().NumDimensions();
+    TensorShape input_shape = channels_last ? X->Shape().Slice(1, x_rank - 1) : X->Shape().Slice(2);
 
-    const int64_t num_input_channels = X->Shape()[1];
+    const int64_t num_input_channels = channels_last ? X->Shape()[x_rank - 1] : X->Shape()[1];
     const int64_t N = X->Shape()[0];
     const int64_t num_output_channels_multiplier = F_Shape[1];
     const int64_t num_output_channels = num_output_channels_multiplier * group;
@@ -116,6 +122,9 @@ struct ConvTransposeAttributes : public ConvAttributes {
 
     ComputePadsAndOutputShape(input_shape, num_output_channels, kernel_shape,
                               local_strides, local_dilations, local_output_padding, N, &local_pads, &Y_dims);
+    if (channels_last) {
+      std::rotate(Y_dims.begin() + 1, Y_dims.begin() + 2, Y_dims.end());
+    }
     TensorShape Yshape(Y_dims);
     Tensor* Y = context->Output(0, Yshape);
 
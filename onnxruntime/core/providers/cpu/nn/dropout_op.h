@@ -5,8 +5,7 @@
 
 #include "core/framework/op_kernel.h"
 #include "core/framework/random_generator.h"
-#include <chrono>
-#include <random>
+#include "core/providers/cpu/generator/philox.h"
 #include "core/util/math_cpuonly.h"
 
 namespace onnxruntime {
@@ -17,14 +16,14 @@ class Dropout final: public OpKernel {
   Dropout(const OpKernelInfo& info) : OpKernel{info} {
     int64_t seed = 0;
     if (info.GetAttr<int64_t>("seed", &seed).IsOK()) {
-      generator_ = std::make_unique<RandomGenerator>(seed);
+      generator_ = std::make_unique<PhiloxGenerator>(static_cast<uint64_t>(seed));
     }
   }
 
   Status Compute(OpKernelContext* context) const override;
 
  private:
-  mutable std::unique_ptr<RandomGenerator> generator_;
+  mutable std::unique_ptr<PhiloxGenerator> generator_;
 };
 
 namespace {
@@ -81,14 +80,17 @@ Status Dropout<T1, T2>::Compute(OpKernelContext* context) const {
     EigenVectorArrayMap<T1> Y_arr(Y_span.data(), Y_span.size());
     EigenVectorArrayMap<bool> mask_arr(mask_span.data(), mask_span.size());
 
-    // generate mask
+    // generate mask, from one uniform value per element drawn in parallel from the Philox counters of generator
     {
-      RandomGenerator& generator = generator_ != nullptr ? *generator_.get() : RandomGenerator::Default();
-      std::default_random_engine rng(generator.NextSeed());
-      std::uniform_real_distribution<float> dist{0.0f, 1.0f};
-      mask_arr = Eigen::ArrayX<bool>::NullaryExpr(
-          mask_arr.size(),
-          [ratio_value, &dist, &rng]() { return dist(rng) >= ratio_value; });
+      PhiloxGenerator& generator = generator_ != nullptr ? *generator_.get() : PhiloxGenerator::Default();
+      const auto seeds = generator.NextPhiloxSeeds(philox::NumBlocks<float>(mask_span.size()));
+      const TensorOpCost cost{0, static_cast<double>(philox::kValuesPerBlock<float>), 40};
+      philox::Fill<float, bool>(seeds.first, seeds.second, mask_span, cost, context->GetOperatorThreadPool(),
+                                [ratio_value](const philox::Counter& words, bool* values) {
+                                  for (size_t i = 0; i < words.size(); ++i) {
+                                    values[i] = philox::ToUniformFloat(words[i]) >= ratio_value;
+                                  }
+                                });
     }
 
     Y_arr = mask_arr.cast<T1>() * X_arr / (1.0f - ratio_value);
@@ -5,6 +5,7 @@
 
 #include "core/common/safeint.h"
 #include "core/framework/tensor.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/util/math_cpuonly.h"
@@ -74,6 +75,20 @@ Status ComputeImpl(OpKernelContext* p_ctx, int64_t orig_axis, float epsilon, boo
     inv_std_dev_data = inv_std_dev->MutableData<U>();
   }
 
+  if constexpr (std::is_same_v<T, float> && std::is_same_v<U, float>) {
+    // MLAS computes the statistics and normalizes each row in a single pass while the row is in the cache
+    MLAS_LAYERNORM_PARAMETERS parameters{};
+    parameters.Scale = scale_data;
+    parameters.Shift = bias_data;
+    parameters.Mean = mean_data;
+    parameters.InvStdDev = inv_std_dev_data;
+    parameters.Epsilon = epsilon;
+    parameters.Simplified = simplified;
+    MlasLayerNormalization(X_data, Y_data, onnxruntime::narrow<size_t>(norm_count),
+                           onnxruntime::narrow<size_t>(norm_size), &parameters, p_ctx->GetOperatorThreadPool());
+    return Status::OK();
+  }
+
   concurrency::ThreadPool::TryBatchParallelFor(
       p_ctx->GetOperatorThreadPool(), static_cast<int32_t>(norm_count),
       [&](ptrdiff_t task_idx) {
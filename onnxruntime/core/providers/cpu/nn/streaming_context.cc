@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/nn/streaming_context.h"
+
+#include <algorithm>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/common/string_utils.h"
+#include "core/framework/config_options.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
+
+namespace onnxruntime {
+
+bool IsStreamingNode(const OpKernelInfo& info) {
+  const std::string streaming_nodes =
+      info.GetConfigOptions().GetConfigOrDefault(kOrtSessionOptionsConfigStreamingNodes, "");
+  if (streaming_nodes.empty() || info.node().Name().empty()) {
+    return false;
+  }
+
+  const auto names = utils::SplitString(streaming_nodes, ",");
+  return std::find(names.begin(), names.end(), info.node().Name()) != names.end();
+}
+
+bool StreamingContext::StartRun(const TensorShape& shape, int64_t initial_frames) {
+  const auto outer_dims = shape.GetDims().first(shape.NumDimensions() - 1);
+  if (started_ && std::equal(outer_dims.begin(), outer_dims.end(), outer_dims_.begin(), outer_dims_.end())) {
+    return false;
+  }
+
+  started_ = true;
+  outer_dims_.assign(outer_dims.begin(), outer_dims.end());
+  frame_count_ = initial_frames;
+  frames_.assign(SafeInt<size_t>(shape.SizeToDimension(shape.NumDimensions() - 1)) * initial_frames, 0.0f);
+  frames_to_skip_ = 0;
+  return true;
+}
+
+void StreamingContext::Prepend(const Tensor& X, int64_t initial_frames, AllocatorPtr alloc, Tensor& input) {
+  const auto& shape = X.Shape();
+  StartRun(shape, initial_frames);
+
+  const int64_t new_frames = shape[shape.NumDimensions() - 1];
+  const int64_t skipped_frames = std::min(frames_to_skip_, new_frames);
+  frames_to_skip_ -= skipped_frames;
+
+  TensorShapeVector input_dims = shape.AsShapeVector();
+  input_dims.back() = frame_count_ + new_frames - skipped_frames;
+  input = Tensor(X.DataType(), TensorShape(input_dims), std::move(alloc));
+
+  const size_t rows = narrow<size_t>(shape.SizeToDimension(shape.NumDimensions() - 1));
+  const auto* context_data = frames_.data();
+  const auto* x_data = X.Data<float>() + skipped_frames;
+  auto* input_data = input.MutableData<float>();
+
+  for (size_t row = 0; row < rows; ++row) {
+    input_data = std::copy_n(context_data, frame_count_, input_data);
+    input_data = std::copy_n(x_data, new_frames - skipped_frames, input_data);
+    context_data += frame_count_;
+    x_data += new_frames;
+  }
+}
+
+void StreamingContext::Keep(const Tensor& input, int64_t first_frame) {
+  const auto& shape = input.Shape();
+  const int64_t frames = shape[shape.NumDimensions() - 1];
+
+  frames_to_skip_ = std::max<int64_t>(first_frame - frames, 0);
+  first_frame = std::min(first_frame, frames);
+  frame_count_ = frames - first_frame;
+
+  const size_t rows = narrow<size_t>(shape.SizeToDimension(shape.NumDimensions() - 1));
+  frames_.resize(SafeInt<size_t>(rows) * frame_count_);
+
+  const auto* input_data = input.Data<float>() + first_frame;
+  auto* context_data = frames_.data();
+
+  for (size_t row = 0; row < rows; ++row) {
+    context_data = std::copy_n(input_data, frame_count_, context_data);
+    input_data += frames;
+  }
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <vector>
+
+#include "core/framework/op_kernel.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+// Returns true if the node of the kernel is listed in the kOrtSessionOptionsConfigStreamingNodes session config entry
+bool IsStreamingNode(const OpKernelInfo& info);
+
+// State of a node that is run in streaming mode: each run provides the next chunk of frames of a stream along the
+// innermost axis of its input. The state belongs to the stream whose other axes have the dims seen by StartRun.
+class StreamingContext {
+ public:
+  // Starts a run for an input of `shape`. If the dims of the other axes than the innermost one changed, a new
+  // stream starts with `initial_frames` zero frames as left context and true is returned.
+  bool StartRun(const TensorShape& shape, int64_t initial_frames);
+
+  // Starts a run and fills `input` with the left context followed by the frames of `X` along the innermost axis.
+  void Prepend(const Tensor& X, int64_t initial_frames, AllocatorPtr alloc, Tensor& input);
+
+  // Keeps the frames of `input` from `first_frame` onwards as the left context of the next run.
+  // If `first_frame` is past the end of `input`, the frames in between are dropped from the next run.
+  void Keep(const Tensor& input, int64_t first_frame);
+
+  // Runs of the same stream update the state so they must be serialized.
+  OrtMutex& Mutex() const { return mutex_; }
+
+ private:
+  mutable OrtMutex mutex_;
+  bool started_ = false;
+  TensorShapeVector outer_dims_;
+  // Left context: frame_count_ float frames for each row of outer_dims_
+  std::vector<float> frames_;
+  int64_t frame_count_ = 0;
+  // Number of leading frames of the next run that are not used by the node
+  int64_t frames_to_skip_ = 0;
+};
+
+}  // namespace onnxruntime
@@ -11,7 +11,6 @@
 #elif defined(__APPLE__) || defined(__ANDROID__)
 #include <codecvt>
 #else
-#include <limits>
 #include <iconv.h>
 #endif  // _MSC_VER
 
@@ -115,39 +114,51 @@ using Utf8Converter = std::wstring_convert<std::codecvt_utf8<wchar_t>>;
 #else
 
 // All others (Linux)
+// The conversion descriptors are opened once per converter and the strings are converted
+// directly into the result, so converting a string allocates nothing but the result.
 class Utf8Converter {
  public:
-  Utf8Converter(const std::string&, const std::wstring&) {}
+  Utf8Converter(const std::string&, const std::wstring&)
+      : to_wchar_(iconv_open("WCHAR_T", "UTF-8")),
+        to_utf8_(iconv_open("UTF-8", "WCHAR_T")) {}
+
+  ~Utf8Converter() {
+    if (IsValid(to_wchar_)) {
+      iconv_close(to_wchar_);
+    }
+    if (IsValid(to_utf8_)) {
+      iconv_close(to_utf8_);
+    }
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(Utf8Converter);
 
   std::wstring from_bytes(const std::string& s) const {
     std::wstring result;
     if (s.empty()) {
       return result;
     }
-    // Order of arguments is to, from
-    auto icvt = iconv_open("WCHAR_T", "UTF-8");
-    // CentOS is not happy with -1
-    if (std::numeric_limits<iconv_t>::max() == icvt) {
+    if (!IsValid(to_wchar_)) {
       return wconv_error;
     }
+    // Reset the shift state a previous failed conversion may have left
+    iconv(to_wchar_, nullptr, nullptr, nullptr, nullptr);
 
     char* iconv_in = const_cast<char*>(s.c_str());
     size_t iconv_in_bytes = s.length();
-    // Temporary buffer assumes 1 byte to 1 wchar_t
-    // to make sure it is enough.
-    const size_t buffer_len = iconv_in_bytes * sizeof(wchar_t);
-    auto buffer = std::make_unique<char[]>(buffer_len);
-    char* iconv_out = buffer.get();
+    // Assumes 1 byte to 1 wchar_t to make sure it is enough,
+    // the result is shrunk to the converted length.
+    result.resize(iconv_in_bytes);
+    const size_t buffer_len = result.size() * sizeof(wchar_t);
+    char* iconv_out = reinterpret_cast<char*>(&result[0]);
     size_t iconv_out_bytes = buffer_len;
-    auto ret = iconv(icvt, &iconv_in, &iconv_in_bytes, &iconv_out, &iconv_out_bytes);
+    auto ret = iconv(to_wchar_, &iconv_in, &iconv_in_bytes, &iconv_out, &iconv_out_bytes);
     if (static_cast<size_t>(-1) == ret) {
-      result = wconv_error;
-    } else {
-      size_t converted_bytes = buffer_len - iconv_out_bytes;
-      assert((converted_bytes % sizeof(wchar_t)) == 0);
-      result.assign(reinterpret_cast<const wchar_t*>(buffer.get()), converted_bytes / sizeof(wchar_t));
+      return wconv_error;
     }
-    iconv_close(icvt);
+    size_t converted_bytes = buffer_len - iconv_out_bytes;
+    assert((converted_bytes % sizeof(wchar_t)) == 0);
+    result.resize(converted_bytes / sizeof(wchar_t));
     return result;
   }
 
@@ -156,34 +167,36 @@ class Utf8Converter {
     if (wstr.empty()) {
       return result;
     }
-    // Order of arguments is to, from
-    auto icvt = iconv_open("UTF-8", "WCHAR_T");
-    // CentOS is not happy with -1
-    if (std::numeric_limits<iconv_t>::max() == icvt) {
+    if (!IsValid(to_utf8_)) {
       return conv_error;
     }
+    iconv(to_utf8_, nullptr, nullptr, nullptr, nullptr);
 
     // I hope this does not modify the incoming buffer
     wchar_t* non_const_in = const_cast<wchar_t*>(wstr.c_str());
     char* iconv_in = reinterpret_cast<char*>(non_const_in);
     size_t iconv_in_bytes = wstr.length() * sizeof(wchar_t);
-    // Temp buffer, assume every code point converts into 3 bytes, this should be enough
+    // Every code point converts into at most 4 bytes
     // We do not convert terminating zeros
-    const size_t buffer_len = wstr.length() * 3;
-    auto buffer = std::make_unique<char[]>(buffer_len);
-
-    char* iconv_out = buffer.get();
+    result.resize(wstr.length() * 4);
+    const size_t buffer_len = result.size();
+    char* iconv_out = &result[0];
     size_t iconv_out_bytes = buffer_len;
-    auto ret = iconv(icvt, &iconv_in, &iconv_in_bytes, &iconv_out, &iconv_out_bytes);
+    auto ret = iconv(to_utf8_, &iconv_in, &iconv_in_bytes, &iconv_out, &iconv_out_bytes);
     if (static_cast<size_t>(-1) == ret) {
-      result = conv_error;
-    } else {
-      size_t converted_len = buffer_len - iconv_out_bytes;
-      result.assign(buffer.get(), converted_len);
+      return conv_error;
     }
-    iconv_close(icvt);
+    result.resize(buffer_len - iconv_out_bytes);
     return result;
   }
+
+ private:
+  static bool IsValid(iconv_t icvt) {
+    return reinterpret_cast<iconv_t>(-1) != icvt;
+  }
+
+  iconv_t to_wchar_;
+  iconv_t to_utf8_;
 };
 
 #endif  // __APPLE__
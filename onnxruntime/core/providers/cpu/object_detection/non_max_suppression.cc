@@ -13,8 +13,10 @@ limitations under the License.
 
 #include "non_max_suppression.h"
 #include "non_max_suppression_helper.h"
-#include <queue>
+#include <algorithm>
 #include <utility>
+#include <vector>
+#include "core/platform/threadpool.h"
 //TODO:fix the warnings
 #ifdef _MSC_VER
 #pragma warning(disable : 4244)
@@ -114,6 +116,114 @@ Status NonMaxSuppressionBase::GetThresholdsFromInputs(const PrepareContext& pc,
   return Status::OK();
 }
 
+namespace {
+
+// The corners and areas of the boxes are kept in separate arrays so that the IOU of a candidate against a block of
+// boxes compiles to vector instructions.
+struct BoxCorners {
+  void Resize(size_t n) {
+    x_min.resize(n);
+    y_min.resize(n);
+    x_max.resize(n);
+    y_max.resize(n);
+    area.resize(n);
+  }
+
+  void Clear() {
+    x_min.clear();
+    y_min.clear();
+    x_max.clear();
+    y_max.clear();
+    area.clear();
+  }
+
+  void PushBack(const BoxCorners& boxes, size_t index) {
+    x_min.push_back(boxes.x_min[index]);
+    y_min.push_back(boxes.y_min[index]);
+    x_max.push_back(boxes.x_max[index]);
+    y_max.push_back(boxes.y_max[index]);
+    area.push_back(boxes.area[index]);
+  }
+
+  std::vector<float> x_min;
+  std::vector<float> y_min;
+  std::vector<float> x_max;
+  std::vector<float> y_max;
+  std::vector<float> area;
+};
+
+// Converts the boxes to corners with the same arithmetic as nms_helpers::SuppressByIOU.
+void ComputeBoxCorners(const float* boxes_data, int64_t num_boxes, int64_t center_point_box, BoxCorners& corners) {
+  corners.Resize(static_cast<size_t>(num_boxes));
+  for (int64_t i = 0; i < num_boxes; ++i) {
+    const float* box = boxes_data + 4 * i;
+    float x_min, x_max, y_min, y_max;
+    // center_point_box_ only support 0 or 1
+    if (0 == center_point_box) {
+      // boxes data format [y1, x1, y2, x2],
+      MaxMin(box[1], box[3], x_min, x_max);
+      MaxMin(box[0], box[2], y_min, y_max);
+    } else {
+      // 1 == center_point_box_ => boxes data format [x_center, y_center, width, height]
+      const float width_half = box[2] / 2;
+      const float height_half = box[3] / 2;
+      x_min = box[0] - width_half;
+      x_max = box[0] + width_half;
+      y_min = box[1] - height_half;
+      y_max = box[1] + height_half;
+    }
+    corners.x_min[i] = x_min;
+    corners.y_min[i] = y_min;
+    corners.x_max[i] = x_max;
+    corners.y_max[i] = y_max;
+    corners.area[i] = (x_max - x_min) * (y_max - y_min);
+  }
+}
+
+// Returns true if the IOU of the box with any of the selected boxes exceeds the threshold. The conditions match
+// nms_helpers::SuppressByIOU, evaluated without branches over blocks of the selected boxes.
+bool SuppressByIOU(const BoxCorners& boxes, size_t index, const BoxCorners& selected, float iou_threshold) {
+  const float x_min = boxes.x_min[index];
+  const float y_min = boxes.y_min[index];
+  const float x_max = boxes.x_max[index];
+  const float y_max = boxes.y_max[index];
+  const float area = boxes.area[index];
+
+  if (!(area > .0f)) {
+    return false;
+  }
+
+  constexpr size_t kBlockSize = 16;
+  const size_t count = selected.area.size();
+
+  for (size_t start = 0; start < count; start += kBlockSize) {
+    const size_t end = std::min(start + kBlockSize, count);
+    int suppressed = 0;
+    for (size_t j = start; j < end; ++j) {
+      const float intersection_x_min = std::max(x_min, selected.x_min[j]);
+      const float intersection_x_max = std::min(x_max, selected.x_max[j]);
+      const float intersection_y_min = std::max(y_min, selected.y_min[j]);
+      const float intersection_y_max = std::min(y_max, selected.y_max[j]);
+      const float intersection_area = (intersection_x_max - intersection_x_min) *
+                                      (intersection_y_max - intersection_y_min);
+      const float union_area = area + selected.area[j] - intersection_area;
+      suppressed |= static_cast<int>(intersection_x_max > intersection_x_min) &
+                    static_cast<int>(intersection_y_max > intersection_y_min) &
+                    static_cast<int>(intersection_area > .0f) &
+                    static_cast<int>(selected.area[j] > .0f) &
+                    static_cast<int>(union_area > .0f) &
+                    static_cast<int>(intersection_area / union_area > iou_threshold);
+    }
+    if (suppressed) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+}  // namespace
+
 Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
   PrepareContext pc;
   ORT_RETURN_IF_ERROR(PrepareCompute(ctx, pc));
@@ -145,61 +255,85 @@ Status NonMaxSuppression::Compute(OpKernelContext* ctx) const {
 
   const auto center_point_box = GetCenterPointBox();
 
-  std::vector<SelectedIndex> selected_indices;
-  std::vector<BoxInfoPtr> selected_boxes_inside_class;
-  selected_boxes_inside_class.reserve(std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_));
-
+  // the corners of the boxes are shared by the classes of a batch
+  std::vector<BoxCorners> batch_corners(static_cast<size_t>(pc.num_batches_));
   for (int64_t batch_index = 0; batch_index < pc.num_batches_; ++batch_index) {
-    for (int64_t class_index = 0; class_index < pc.num_classes_; ++class_index) {
-      int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
-      const float* batch_boxes = boxes_data + (batch_index * pc.num_boxes_ * 4);
-      std::vector<BoxInfoPtr> candidate_boxes;
-      candidate_boxes.reserve(pc.num_boxes_);
-
-      // Filter by score_threshold_
-      const auto* class_scores = scores_data + box_score_offset;
-      if (pc.score_threshold_ != nullptr) {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          if (*class_scores > score_threshold) {
-            candidate_boxes.emplace_back(*class_scores, box_index);
-          }
-        }
-      } else {
-        for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
-          candidate_boxes.emplace_back(*class_scores, box_index);
-        }
-      }
-      std::priority_queue<BoxInfoPtr, std::vector<BoxInfoPtr>> sorted_boxes(std::less<BoxInfoPtr>(), std::move(candidate_boxes));
-
-      selected_boxes_inside_class.clear();
-      // Get the next box with top score, filter by iou_threshold
-      while (!sorted_boxes.empty() && static_cast<int64_t>(selected_boxes_inside_class.size()) < max_output_boxes_per_class) {
-        const BoxInfoPtr& next_top_score = sorted_boxes.top();
-
-        bool selected = true;
-        // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union) threshold
-        for (const auto& selected_index : selected_boxes_inside_class) {
-          if (SuppressByIOU(batch_boxes, next_top_score.index_, selected_index.index_, center_point_box, iou_threshold)) {
-            selected = false;
-            break;
+    ComputeBoxCorners(boxes_data + (batch_index * pc.num_boxes_ * 4), pc.num_boxes_, center_point_box,
+                      batch_corners[batch_index]);
+  }
+
+  // each batch and class is selected independently, and the results are concatenated in order afterwards
+  const int64_t num_tasks = pc.num_batches_ * pc.num_classes_;
+  std::vector<std::vector<SelectedIndex>> task_selected_indices(static_cast<size_t>(num_tasks));
+  const size_t max_selected = std::min<size_t>(static_cast<size_t>(max_output_boxes_per_class), pc.num_boxes_);
+
+  const TensorOpCost cost{static_cast<double>(pc.num_boxes_ * sizeof(float)), 0,
+                          static_cast<double>(pc.num_boxes_) * 16.0};
+
+  concurrency::ThreadPool::TryParallelFor(
+      ctx->GetOperatorThreadPool(), static_cast<std::ptrdiff_t>(num_tasks), cost,
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<BoxInfoPtr> candidate_boxes;
+        BoxCorners selected_boxes_inside_class;
+
+        for (std::ptrdiff_t task = first; task < last; ++task) {
+          const int64_t batch_index = task / pc.num_classes_;
+          const int64_t class_index = task % pc.num_classes_;
+          int64_t box_score_offset = (batch_index * pc.num_classes_ + class_index) * pc.num_boxes_;
+          const BoxCorners& corners = batch_corners[batch_index];
+          auto& selected_indices = task_selected_indices[task];
+
+          candidate_boxes.clear();
+          candidate_boxes.reserve(pc.num_boxes_);
+
+          // Filter by score_threshold_
+          const auto* class_scores = scores_data + box_score_offset;
+          if (pc.score_threshold_ != nullptr) {
+            for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
+              if (*class_scores > score_threshold) {
+                candidate_boxes.emplace_back(*class_scores, box_index);
+              }
+            }
+          } else {
+            for (int64_t box_index = 0; box_index < pc.num_boxes_; ++box_index, ++class_scores) {
+              candidate_boxes.emplace_back(*class_scores, box_index);
+            }
           }
+          // a heap over the candidates, so that only the boxes that are visited get sorted
+          std::make_heap(candidate_boxes.begin(), candidate_boxes.end());
+
+          selected_boxes_inside_class.Clear();
+          // Get the next box with top score, filter by iou_threshold
+          while (!candidate_boxes.empty() && selected_boxes_inside_class.area.size() < max_selected) {
+            const BoxInfoPtr next_top_score = candidate_boxes.front();
+            const auto box_index = static_cast<size_t>(next_top_score.index_);
+
+            // Check with existing selected boxes for this class, suppress if exceed the IOU (Intersection Over Union)
+            // threshold
+            if (!SuppressByIOU(corners, box_index, selected_boxes_inside_class, iou_threshold)) {
+              selected_boxes_inside_class.PushBack(corners, box_index);
+              selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
+            }
+            std::pop_heap(candidate_boxes.begin(), candidate_boxes.end());
+            candidate_boxes.pop_back();
+          }  //while
         }
+      });
 
-        if (selected) {
-          selected_boxes_inside_class.push_back(next_top_score);
-          selected_indices.emplace_back(batch_index, class_index, next_top_score.index_);
-        }
-        sorted_boxes.pop();
-      }  //while
-    }    //for class_index
-  }      //for batch_index
+  size_t num_selected = 0;
+  for (const auto& selected_indices : task_selected_indices) {
+    num_selected += selected_indices.size();
+  }
 
   constexpr auto last_dim = 3;
-  const auto num_selected = selected_indices.size();
   Tensor* output = ctx->Output(0, {static_cast<int64_t>(num_selected), last_dim});
   ORT_ENFORCE(output != nullptr);
   static_assert(last_dim * sizeof(int64_t) == sizeof(SelectedIndex), "Possible modification of SelectedIndex");
-  memcpy(output->MutableData<int64_t>(), selected_indices.data(), num_selected * sizeof(SelectedIndex));
+  auto* output_data = reinterpret_cast<SelectedIndex*>(output->MutableData<int64_t>());
+  for (const auto& selected_indices : task_selected_indices) {
+    memcpy(output_data, selected_indices.data(), selected_indices.size() * sizeof(SelectedIndex));
+    output_data += selected_indices.size();
+  }
 
   return Status::OK();
 }
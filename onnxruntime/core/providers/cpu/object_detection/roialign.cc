@@ -154,6 +154,52 @@ static void PreCalcForBilinearInterpolate(const int64_t height, const int64_t wi
   }
 }
 
+// Pools the bins of a ROI for a group of channels. The channels share the sampling positions and weights, so each
+// entry of pre_calc is loaded once for the whole group while the channels accumulate independently.
+template <typename T, int64_t ChannelCount>
+void RoiAlignPoolChannels(const PreCalc<T>* pre_calc, const T* bottom_data, int64_t channel_stride, T* top_data,
+                          int64_t pooled_size, int64_t sample_count, int64_t count, RoiAlignMode mode) {
+  for (int64_t index = 0; index < pooled_size; index++) {
+    T output_val[ChannelCount];
+
+    if (mode == RoiAlignMode::avg) {  // avg pooling
+      for (int64_t c = 0; c < ChannelCount; c++) {
+        output_val[c] = 0.;
+      }
+      for (int64_t s = 0; s < sample_count; s++, pre_calc++) {
+        const auto& pc = *pre_calc;
+        for (int64_t c = 0; c < ChannelCount; c++) {
+          const T* offset_bottom_data = bottom_data + c * channel_stride;
+          output_val[c] += pc.w1 * offset_bottom_data[pc.pos1] + pc.w2 * offset_bottom_data[pc.pos2] +
+                           pc.w3 * offset_bottom_data[pc.pos3] + pc.w4 * offset_bottom_data[pc.pos4];
+        }
+      }
+      for (int64_t c = 0; c < ChannelCount; c++) {
+        output_val[c] /= count;
+      }
+    } else {  // max pooling
+      for (int64_t c = 0; c < ChannelCount; c++) {
+        output_val[c] = 0.;
+      }
+      for (int64_t s = 0; s < sample_count; s++, pre_calc++) {
+        const auto& pc = *pre_calc;
+        for (int64_t c = 0; c < ChannelCount; c++) {
+          const T* offset_bottom_data = bottom_data + c * channel_stride;
+          T val = std::max(
+              std::max(std::max(pc.w1 * offset_bottom_data[pc.pos1], pc.w2 * offset_bottom_data[pc.pos2]),
+                       pc.w3 * offset_bottom_data[pc.pos3]),
+              pc.w4 * offset_bottom_data[pc.pos4]);
+          output_val[c] = (s == 0) ? val : std::max(output_val[c], val);
+        }
+      }
+    }
+
+    for (int64_t c = 0; c < ChannelCount; c++) {
+      top_data[c * pooled_size + index] = output_val[c];
+    }
+  }
+}
+
 template <typename T>
 void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, float spatial_scale, int64_t height,
                      int64_t width, int64_t sampling_ratio, const T* bottom_rois, int64_t num_roi_cols, T* top_data,
@@ -163,97 +209,85 @@ void RoiAlignForward(const TensorShape& output_shape, const T* bottom_data, floa
   int64_t pooled_height = output_shape[2];
   int64_t pooled_width = output_shape[3];
 
-  //100 is a random chosed value, need be tuned
-  double cost = static_cast<double>(channels * pooled_width * pooled_height * 100);
-
-  ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois), cost, [&](ptrdiff_t n, ptrdiff_t end) {
-    for (; n != end; ++n) {
-      int64_t index_n = n * channels * pooled_width * pooled_height;
+  // The work is split into blocks of channels of a ROI, so that a few ROIs with many channels still use the thread
+  // pool. The sampling positions and weights are computed once per ROI by each thread.
+  constexpr int64_t kChannelBlock = 16;
+  constexpr int64_t kChannelGroup = 4;
+  const int64_t channel_blocks = (channels + kChannelBlock - 1) / kChannelBlock;
 
-      const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
+  //100 is a random chosed value, need be tuned
+  double cost = static_cast<double>(std::min(channels, kChannelBlock) * pooled_width * pooled_height * 100);
+
+  ThreadPool::TryParallelFor(ttp, static_cast<ptrdiff_t>(n_rois * channel_blocks), cost, [&](ptrdiff_t task,
+                                                                                             ptrdiff_t end) {
+    std::vector<PreCalc<T>> pre_calc;
+    int64_t pre_calc_roi = -1;
+    int64_t roi_bin_grid_h = 0;
+    int64_t roi_bin_grid_w = 0;
+    int64_t count = 1;
+
+    for (; task != end; ++task) {
+      const int64_t n = task / channel_blocks;
+      const int64_t channel_start = (task % channel_blocks) * kChannelBlock;
+      const int64_t channel_end = std::min(channel_start + kChannelBlock, channels);
       const auto roi_batch_ind = batch_indices_ptr[n];
 
-      // Do not using rounding; this implementation detail is critical
-      T offset = half_pixel ? (T)0.5 : (T)0.0;
-      T roi_start_w = offset_bottom_rois[0] * spatial_scale - offset;
-      T roi_start_h = offset_bottom_rois[1] * spatial_scale - offset;
-      T roi_end_w = offset_bottom_rois[2] * spatial_scale - offset;
-      T roi_end_h = offset_bottom_rois[3] * spatial_scale - offset;
-
-      T roi_width = roi_end_w - roi_start_w;
-      T roi_height = roi_end_h - roi_start_h;
-      if (!half_pixel) {
-        // Force malformed ROIs to be 1x1
-        roi_width = std::max(roi_width, (T)1.);
-        roi_height = std::max(roi_height, (T)1.);
+      if (n != pre_calc_roi) {
+        const T* offset_bottom_rois = bottom_rois + n * num_roi_cols;
+
+        // Do not using rounding; this implementation detail is critical
+        T offset = half_pixel ? (T)0.5 : (T)0.0;
+        T roi_start_w = offset_bottom_rois[0] * spatial_scale - offset;
+        T roi_start_h = offset_bottom_rois[1] * spatial_scale - offset;
+        T roi_end_w = offset_bottom_rois[2] * spatial_scale - offset;
+        T roi_end_h = offset_bottom_rois[3] * spatial_scale - offset;
+
+        T roi_width = roi_end_w - roi_start_w;
+        T roi_height = roi_end_h - roi_start_h;
+        if (!half_pixel) {
+          // Force malformed ROIs to be 1x1
+          roi_width = std::max(roi_width, (T)1.);
+          roi_height = std::max(roi_height, (T)1.);
+        }
+
+        T bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
+        T bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
+
+        // We use roi_bin_grid to sample the grid and mimic integral, e.g., = 2
+        roi_bin_grid_h =
+            (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_height / pooled_height));
+        roi_bin_grid_w =
+            (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_width / pooled_width));
+
+        // We do average (integral) pooling inside a bin
+        count = std::max(roi_bin_grid_h * roi_bin_grid_w, static_cast<int64_t>(1));  // e.g. = 4
+
+        // we want to precalculate indices and weights shared by all channels,
+        // this is the key point of optimization
+        pre_calc.resize(roi_bin_grid_h * roi_bin_grid_w * pooled_width * SafeInt<size_t>(pooled_height));
+        PreCalcForBilinearInterpolate(height, width, pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w,
+                                      roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h,
+                                      roi_bin_grid_w, pre_calc);
+        pre_calc_roi = n;
       }
 
-      T bin_size_h = static_cast<T>(roi_height) / static_cast<T>(pooled_height);
-      T bin_size_w = static_cast<T>(roi_width) / static_cast<T>(pooled_width);
-
-      // We use roi_bin_grid to sample the grid and mimic integral
-      int64_t roi_bin_grid_h = (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_height / pooled_height));  // e.g., = 2
-      int64_t roi_bin_grid_w =
-          (sampling_ratio > 0) ? sampling_ratio : static_cast<int64_t>(std::ceil(roi_width / pooled_width));
-
-      // We do average (integral) pooling inside a bin
-      const int64_t count = std::max(roi_bin_grid_h * roi_bin_grid_w, static_cast<int64_t>(1)); // e.g. = 4
-
-      // we want to precalculate indices and weights shared by all channels,
-      // this is the key point of optimization
-      std::vector<PreCalc<T>> pre_calc(roi_bin_grid_h * roi_bin_grid_w * pooled_width * SafeInt<size_t>(pooled_height));
-      PreCalcForBilinearInterpolate(height, width, pooled_height, pooled_width, roi_bin_grid_h, roi_bin_grid_w,
-                                    roi_start_h, roi_start_w, bin_size_h, bin_size_w, roi_bin_grid_h,
-                                    roi_bin_grid_w, pre_calc);
-
-      for (int64_t c = 0; c < channels; c++) {
-        int64_t index_n_c = index_n + c * pooled_width * pooled_height;
-        const T* offset_bottom_data =
-            bottom_data + static_cast<int64_t>((roi_batch_ind * channels + c) * height * width);
-        int64_t pre_calc_index = 0;
-
-        for (int64_t ph = 0; ph < pooled_height; ph++) {
-          for (int64_t pw = 0; pw < pooled_width; pw++) {
-            int64_t index = index_n_c + ph * pooled_width + pw;
-
-            T output_val = 0.;
-            if (mode == RoiAlignMode::avg) {  // avg pooling
-              for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-                for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                  const auto& pc = pre_calc[onnxruntime::narrow<size_t>(pre_calc_index)];
-                  output_val += pc.w1 * offset_bottom_data[pc.pos1] + pc.w2 * offset_bottom_data[pc.pos2] +
-                                pc.w3 * offset_bottom_data[pc.pos3] + pc.w4 * offset_bottom_data[pc.pos4];
-
-                  pre_calc_index += 1;
-                }
-              }
-              output_val /= count;
-            } else {  // max pooling
-              bool max_flag = false;
-              for (int64_t iy = 0; iy < roi_bin_grid_h; iy++) {
-                for (int64_t ix = 0; ix < roi_bin_grid_w; ix++) {
-                  const auto& pc = pre_calc[onnxruntime::narrow<size_t>(pre_calc_index)];
-                  T val = std::max(
-                      std::max(std::max(pc.w1 * offset_bottom_data[pc.pos1], pc.w2 * offset_bottom_data[pc.pos2]),
-                               pc.w3 * offset_bottom_data[pc.pos3]),
-                      pc.w4 * offset_bottom_data[pc.pos4]);
-                  if (!max_flag) {
-                    output_val = val;
-                    max_flag = true;
-                  } else {
-                    output_val = std::max(output_val, val);
-                  }
-
-                  pre_calc_index += 1;
-                }
-              }
-            }
-
-            top_data[index] = output_val;
-          }  // for pw
-        }    // for ph
-      }      // for c
-    }        // for n
+      const int64_t pooled_size = pooled_height * pooled_width;
+      const int64_t channel_stride = height * width;
+      const int64_t sample_count = roi_bin_grid_h * roi_bin_grid_w;
+
+      int64_t c = channel_start;
+      for (; c + kChannelGroup <= channel_end; c += kChannelGroup) {
+        RoiAlignPoolChannels<T, kChannelGroup>(pre_calc.data(),
+                                               bottom_data + (roi_batch_ind * channels + c) * channel_stride,
+                                               channel_stride, top_data + (n * channels + c) * pooled_size,
+                                               pooled_size, sample_count, count, mode);
+      }
+      for (; c < channel_end; c++) {
+        RoiAlignPoolChannels<T, 1>(pre_calc.data(), bottom_data + (roi_batch_ind * channels + c) * channel_stride,
+                                   channel_stride, top_data + (n * channels + c) * pooled_size, pooled_size,
+                                   sample_count, count, mode);
+      }
+    }
   });
 }
 }  // namespace
@@ -13,6 +13,10 @@ class MatMulInteger final : public MatMulIntegerBase {
  public:
   MatMulInteger(const OpKernelInfo& info) : MatMulIntegerBase(info) {}
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed,
+                 /*out*/ PrePackedWeights* prepacked_weights) override;
+
   Status Compute(OpKernelContext* context) const override;
 
   enum InputTensors : int {
@@ -26,6 +30,13 @@ class MatMulInteger final : public MatMulIntegerBase {
 
  protected:
   int GetBIdx() const override { return IN_B; }
+
+ private:
+  bool TryPackBBlockSparse(const Tensor& tensor, AllocatorPtr& alloc, size_t& packed_b_size);
+
+  // packed_b_ holds the nonzero blocks of a sparse B for MlasBlockSparseQgemmBatch, with the zero point of B
+  // subtracted from the elements
+  bool b_is_block_sparse_{false};
 };
 
 ONNX_OPERATOR_TYPED_KERNEL_EX(
@@ -52,6 +63,74 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
     MatMulInteger);
 
+// A constant B with at most this fraction of nonzero blocks is multiplied by the block sparse kernels. The dense
+// kernels multiply 8-bit elements, so the block sparse kernels only pay off for a very sparse B.
+static constexpr double kMaxBlockSparseDensity = 0.1;
+
+bool MatMulInteger::TryPackBBlockSparse(const Tensor& tensor, AllocatorPtr& alloc, size_t& packed_b_size) {
+  if (tensor.Shape().NumDimensions() != 2) {
+    return false;
+  }
+
+  // The zero point of B is folded into the packed elements, so it must be a constant as well.
+  const Tensor* b_zero_point = nullptr;
+  const auto& input_defs = Node().InputDefs();
+  const bool has_b_zero_point = input_defs.size() > IN_B_ZERO_POINT && input_defs[IN_B_ZERO_POINT]->Exists();
+  if (has_b_zero_point && (!Info().TryGetConstantInput(IN_B_ZERO_POINT, &b_zero_point) ||
+                           !IsBQuantParamSupported(b_zero_point->Shape(), tensor.Shape()))) {
+    return false;
+  }
+
+  const uint8_t b_default_offset = 0;
+  const uint8_t* b_offset_ptr = b_zero_point ? static_cast<const uint8_t*>(b_zero_point->DataRaw()) : &b_default_offset;
+  const bool is_b_zp_per_column = b_zero_point != nullptr && !IsScalarOr1ElementVector(b_zero_point);
+  const bool b_is_signed = tensor.IsDataType<int8_t>();
+
+  const size_t K = static_cast<size_t>(tensor.Shape()[0]);
+  const size_t N = static_cast<size_t>(tensor.Shape()[1]);
+  const size_t total_block_count = K * ((N + MLAS_BLOCK_SPARSE_GEMM_BLOCK_N - 1) / MLAS_BLOCK_SPARSE_GEMM_BLOCK_N);
+  if (total_block_count == 0) {
+    return false;
+  }
+
+  const auto* b_data = static_cast<const uint8_t*>(tensor.DataRaw());
+  const size_t block_count = MlasBlockSparseQgemmCountBlocks(N, K, b_data, N, b_is_signed, b_offset_ptr,
+                                                             is_b_zp_per_column);
+  if (static_cast<double>(block_count) > kMaxBlockSparseDensity * static_cast<double>(total_block_count)) {
+    return false;
+  }
+
+  packed_b_size = MlasBlockSparseQgemmPackBSize(N, K, block_count);
+  if (packed_b_size == 0) {
+    return false;
+  }
+
+  auto* packed_b_data = alloc->Alloc(packed_b_size);
+  packed_b_ = BufferUniquePtr(packed_b_data, BufferDeleter(alloc));
+  MlasBlockSparseQgemmPackB(N, K, b_data, N, b_is_signed, b_offset_ptr, is_b_zp_per_column, packed_b_data);
+  b_shape_ = tensor.Shape();
+  return true;
+}
+
+Status MatMulInteger::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                              /*out*/ bool& is_packed,
+                              /*out*/ PrePackedWeights* prepacked_weights) {
+  is_packed = false;
+
+  size_t packed_b_size;
+  if (input_idx == IN_B && TryPackBBlockSparse(tensor, alloc, packed_b_size)) {
+    b_is_block_sparse_ = true;
+    if (prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(packed_b_));
+      prepacked_weights->buffer_sizes_.push_back(packed_b_size);
+    }
+    is_packed = true;
+    return Status::OK();
+  }
+
+  return MatMulIntegerBase::PrePack(tensor, input_idx, std::move(alloc), is_packed, prepacked_weights);
+}
+
 Status MatMulInteger::Compute(OpKernelContext* ctx) const {
   const auto* a = ctx->Input<Tensor>(IN_A);
   const auto* b = packed_b_ ? nullptr : ctx->Input<Tensor>(IN_B);
@@ -97,6 +176,24 @@ Status MatMulInteger::Compute(OpKernelContext* ctx) const {
   const uint8_t* a_data = static_cast<const uint8_t*>(a->DataRaw());
   auto* y_data = y->MutableData<int32_t>();
 
+  if (b_is_block_sparse_) {
+    const size_t batch_size = helper.OutputOffsets().size();
+    std::vector<MLAS_BLOCK_SPARSE_QGEMM_DATA_PARAMS> gemm_data_vec(batch_size);
+    for (size_t batch = 0; batch < batch_size; batch++) {
+      auto& gemm_params = gemm_data_vec[batch];
+      gemm_params.A = a_data + helper.LeftOffsets()[batch];
+      gemm_params.lda = static_cast<size_t>(helper.K());
+      gemm_params.ZeroPointA = a_offset;
+      gemm_params.PackedB = packed_b_.get();
+      gemm_params.C = y_data + helper.OutputOffsets()[batch];
+      gemm_params.ldc = static_cast<size_t>(helper.N());
+    }
+    MlasBlockSparseQgemmBatch(static_cast<size_t>(helper.M()), static_cast<size_t>(helper.N()),
+                              static_cast<size_t>(helper.K()), a->IsDataType<int8_t>(), gemm_data_vec.data(),
+                              batch_size, ctx->GetOperatorThreadPool());
+    return Status::OK();
+  }
+
   MLAS_GEMM_QUANT_SHAPE_PARAMS gemm_shape;
   gemm_shape.M = static_cast<size_t>(helper.M());
   gemm_shape.N = static_cast<size_t>(helper.N());
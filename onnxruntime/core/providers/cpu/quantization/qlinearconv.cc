@@ -11,6 +11,8 @@
 #include "core/util/qmath.h"
 #include "core/mlas/inc/mlas.h"
 
+#include <memory>
+#include <mutex>
 
 namespace onnxruntime {
 
@@ -33,6 +35,10 @@ class QLinearConv : public OpKernel {
                                    int input_idx,
                                    /*out*/ bool& used_shared_buffers) override;
 
+  Status UseCachedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                   std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   /*out*/ bool& used_cached_buffers) override;
+
  private:
   enum InputTensors : int {
     IN_X = 0,
@@ -167,13 +173,9 @@ class QLinearConv : public OpKernel {
     return output_stride;
   }
 
-  bool TryConvSymPrepack(const uint8_t* Wdata,
-                         AllocatorPtr alloc,
-                         size_t output_channels,
-                         size_t group_count,
-                         size_t group_input_channels,
-                         size_t group_output_channels,
-                         size_t kernel_size) {
+  // Returns true if the activation and weight zero points are constant and the weight zero points are all zero,
+  // as the symmetric weight convolution paths require.
+  bool TryGetSymmetricZeroPoint(size_t output_channels, ActType& X_zero_point_value) const {
     const Tensor* X_zero_point = nullptr;
     const Tensor* W_zero_point = nullptr;
 
@@ -183,33 +185,55 @@ class QLinearConv : public OpKernel {
       return false;
     }
 
-    auto X_zero_point_value = *(X_zero_point->Data<ActType>());
+    X_zero_point_value = *(X_zero_point->Data<ActType>());
     const size_t W_zero_point_size = static_cast<size_t>(W_zero_point->Shape().Size());
     const auto* W_zero_point_data = W_zero_point->Data<int8_t>();
-    if (!std::all_of(W_zero_point_data, W_zero_point_data + W_zero_point_size, [](int8_t v) { return v == 0; })) {
-      // Symmetric means weight zero point must be zero
+    // Symmetric means weight zero point must be zero
+    return std::all_of(W_zero_point_data, W_zero_point_data + W_zero_point_size, [](int8_t v) { return v == 0; });
+  }
+
+  // Computes the bias adjusted for the input zero point that MlasConvSym consumes.
+  void ComputeConvSymColumnSums(const uint8_t* Wdata, size_t output_channels, size_t kernel_dim,
+                                ActType X_zero_point_value) {
+    const Tensor* B = nullptr;
+    Info().TryGetConstantInput(8, &B);
+    const auto* Bdata = B != nullptr ? B->Data<int32_t>() : nullptr;
+
+    column_sums_.resize(output_channels);
+    const int8_t* sdata = (const int8_t*)Wdata;
+    int32_t X_zero_point_fixup = MlasConvSymFixupInputZeroPoint(X_zero_point_value, std::is_signed<ActType>::value);
+    for (size_t oc = 0; oc < output_channels; oc++) {
+      int32_t sum = 0;
+      for (size_t ks = 0; ks < kernel_dim; ks++) {
+        sum += *sdata++;
+      }
+      column_sums_[oc] = (Bdata != nullptr ? Bdata[oc] : 0) - sum * X_zero_point_fixup;
+    }
+  }
+
+  bool TryConvSymPrepack(const uint8_t* Wdata,
+                         AllocatorPtr alloc,
+                         size_t output_channels,
+                         size_t group_count,
+                         size_t group_input_channels,
+                         size_t group_output_channels,
+                         size_t kernel_size,
+                         PrePackedWeights* prepacked_weights) {
+    ActType X_zero_point_value{};
+    if (!TryGetSymmetricZeroPoint(output_channels, X_zero_point_value)) {
       return false;
     }
 
     // Try indirect conv packing
     size_t packed_size = MlasConvSymPackWSize(group_count, group_input_channels, group_output_channels, kernel_size, std::is_signed<ActType>::value);
     if (packed_size != 0) {
-      const Tensor* B = nullptr;
-      Info().TryGetConstantInput(8, &B);
-      const auto* Bdata = B != nullptr ? B->Data<int32_t>() : nullptr;
-
-      column_sums_.resize(output_channels);
-      const int8_t* sdata = (const int8_t*)Wdata;
-      int32_t X_zero_point_fixup = MlasConvSymFixupInputZeroPoint(X_zero_point_value, std::is_signed<ActType>::value);
-      for (size_t oc = 0; oc < output_channels; oc++) {
-        int32_t sum = 0;
-        for (size_t ks = 0; ks < kernel_size * group_input_channels; ks++) {
-          sum += *sdata++;
-        }
-        column_sums_[oc] = (Bdata != nullptr ? Bdata[oc] : 0) - sum * X_zero_point_fixup;
-      }
+      ComputeConvSymColumnSums(Wdata, output_channels, kernel_size * group_input_channels, X_zero_point_value);
 
       auto* packed_W = static_cast<uint8_t*>(alloc->Alloc(packed_size));
+
+      // Initialize memory to 0 so that any padding doesn't make the hash differ if this buffer is cached.
+      memset(packed_W, 0, packed_size);
+
       packed_W_buffer_ = BufferUniquePtr(packed_W, BufferDeleter(alloc));
 
       MlasConvSymPackW(group_count,
@@ -221,6 +245,16 @@ class QLinearConv : public OpKernel {
                        packed_size,
                        std::is_signed<ActType>::value);
 
+      if (prepacked_weights != nullptr) {
+        // The two "place-holder" buffers tell this layout apart from the ones below, see UseSharedPrePackedBuffers().
+        prepacked_weights->buffers_.push_back(nullptr);
+        prepacked_weights->buffer_sizes_.push_back(0);
+        prepacked_weights->buffers_.push_back(nullptr);
+        prepacked_weights->buffer_sizes_.push_back(0);
+        prepacked_weights->buffers_.push_back(std::move(packed_W_buffer_));
+        prepacked_weights->buffer_sizes_.push_back(packed_size);
+      }
+
       is_symmetric_conv_ = true;
       is_W_packed_ = true;
       return true;
@@ -300,6 +334,16 @@ class QLinearConv : public OpKernel {
   bool is_symmetric_gemm_{false};
   bool channels_last_{false};
   std::vector<int32_t> column_sums_;
+
+  // Offsets into the channels last input image of the indirection buffer entries, -1 for the padding vector.
+  // They only depend on the shape of the input, so the indirection buffer of an image is built by adding them to
+  // the address of the image instead of redoing the im2col transform. Only the last input shape is kept.
+  struct IndirectionOffsets {
+    TensorShape input_shape;
+    std::vector<ptrdiff_t> offsets;
+  };
+  mutable std::mutex indirection_offsets_mutex_;
+  mutable std::shared_ptr<const IndirectionOffsets> indirection_offsets_;
 };
 
 // uint8_t kernel supports weight being either uint8_t or int8_t
@@ -409,7 +453,8 @@ Status QLinearConv<ActType>::PrePack(const Tensor& tensor, int input_idx, Alloca
                                         group_count,
                                         group_input_channels,
                                         group_output_channels,
-                                        kernel_size)) {
+                                        kernel_size,
+                                        prepacked_weights)) {
     is_packed = true;
     return Status::OK();
   }
@@ -508,8 +553,76 @@ Status QLinearConv<ActType>::UseSharedPrePackedBuffers(std::vector<BufferUniqueP
     // Enforce that the first "placeholder" buffer is nullptr
     ORT_ENFORCE(prepacked_buffers[0].get() == nullptr);
     reordered_W_buffer_ = std::move(prepacked_buffers[1]);
+  } else if (prepacked_buffers.size() == 3) {  // This means that packed_W_ for MlasConvSym exists
+    // Enforce that the "placeholder" buffers are nullptr
+    ORT_ENFORCE(prepacked_buffers[0].get() == nullptr && prepacked_buffers[1].get() == nullptr);
+    packed_W_buffer_ = std::move(prepacked_buffers[2]);
+  }
+
+  return Status::OK();
+}
+
+template <typename ActType>
+Status QLinearConv<ActType>::UseCachedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                                       std::vector<BufferUniquePtr>& prepacked_buffers,
+                                                       /*out*/ bool& used_cached_buffers) {
+  used_cached_buffers = false;
+
+  if (input_idx != InputTensors::IN_W) {
+    return Status::OK();
+  }
+
+  // Set up the same state as PrePack(), which took the path that the layout of the buffers tells.
+  const auto& shape = tensor.Shape().GetDims();
+  const size_t rank = shape.size();
+  if (rank <= 2 || shape[0] % conv_attrs_.group != 0) {
+    return Status::OK();
+  }
+
+  const bool is_W_signed = tensor.IsDataType<int8_t>();
+  const size_t output_channels = static_cast<size_t>(shape[0]);
+  const size_t group_input_channels = static_cast<size_t>(shape[1]);
+  const size_t kernel_size =
+      static_cast<size_t>(std::accumulate(shape.data() + 2, shape.data() + rank, 1LL, std::multiplies<int64_t>()));
+  const size_t group_count = static_cast<size_t>(conv_attrs_.group);
+  const size_t group_output_channels = output_channels / group_count;
+  const size_t kernel_dim = group_input_channels * kernel_size;
+
+  // The zero points aren't part of the cache key. If they now allow the symmetric paths, which PrePack() tries
+  // first, only a cached MlasConvSym buffer matches, and otherwise it doesn't.
+  ActType X_zero_point_value{};
+  const bool is_symmetric = is_W_signed && TryGetSymmetricZeroPoint(output_channels, X_zero_point_value);
+
+  if (prepacked_buffers.size() == 3) {
+    if (!is_symmetric) {
+      return Status::OK();
+    }
+    ComputeConvSymColumnSums(static_cast<const uint8_t*>(tensor.DataRaw()), output_channels, kernel_dim,
+                             X_zero_point_value);
+    packed_W_buffer_ = std::move(prepacked_buffers[2]);
+    is_symmetric_conv_ = true;
+  } else if (prepacked_buffers.size() == 1) {
+    if (is_symmetric) {
+      return Status::OK();
+    }
+    packed_W_size_ = MlasGemmPackBSize(group_output_channels,
+                                       kernel_dim,
+                                       std::is_same<ActType, int8_t>::value,
+                                       is_W_signed);
+    packed_W_buffer_ = std::move(prepacked_buffers[0]);
+  } else if (prepacked_buffers.size() == 2) {
+    if (is_symmetric) {
+      return Status::OK();
+    }
+    reordered_W_buffer_ = std::move(prepacked_buffers[1]);
+  } else {
+    return Status::OK();
   }
 
+  W_shape_ = shape;
+  is_W_signed_ = is_W_signed;
+  is_W_packed_ = true;
+  used_cached_buffers = true;
   return Status::OK();
 }
 
@@ -648,8 +761,11 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
   BufferUniquePtr indirection_buffer;
   std::vector<ActType> padding_data;
 
+  // MlasConvSym reads the input of a grouped convolution through one indirection buffer per group.
+  const int64_t indirection_group_count = (is_symmetric_conv_ && !is_depthwise_conv) ? group_count : 1;
+
   bool use_indirection_buffer = false;
-  if (is_depthwise_conv) {
+  if (is_depthwise_conv || indirection_group_count > 1) {
     use_indirection_buffer = true;
   } else if (kernel_size != 1 || !conv_attrs_.HasStridesOneAndNoPadding()) {
     if (is_symmetric_conv_) {
@@ -664,12 +780,45 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
       memset(col_data, 0, SafeInt<size_t>(sizeof(ActType)) * group_col_buffer_size);
     }
   }
+  std::shared_ptr<const IndirectionOffsets> indirection_offsets;
   if (use_indirection_buffer) {
     // Allocate indirection buffer pointers and prepare a padding vector for
     // the im2col transform.
-    auto* indirection_data = alloc->Alloc(SafeInt<size_t>(sizeof(const ActType*)) * kernel_size * output_image_size);
+    auto* indirection_data = alloc->Alloc(SafeInt<size_t>(sizeof(const ActType*)) * kernel_size * output_image_size *
+                                          indirection_group_count);
     indirection_buffer = BufferUniquePtr(indirection_data, BufferDeleter(alloc));
     padding_data.resize(static_cast<size_t>(C), X_zero_point_value);
+
+    const TensorShape image_shape = X->Shape().Slice(1);
+    std::lock_guard<std::mutex> lock(indirection_offsets_mutex_);
+    if (indirection_offsets_ == nullptr || indirection_offsets_->input_shape != image_shape) {
+      // Run the im2col transform once on the address of the first image, which is a valid base for the offsets.
+      const auto* base = channels_last_ ? Xdata : static_cast<const ActType*>(transpose_input_buffer.get());
+      auto** pointers = static_cast<ActType const**>(indirection_data);
+      math::Im2col<ActType, StorageOrder::NHWC>()(
+          base,
+          C,
+          input_shape.GetDims().data(),
+          output_shape.GetDims().data(),
+          kernel_shape.data(),
+          strides.data(),
+          dilations.data(),
+          pads.data(),
+          static_cast<ptrdiff_t>(kernel_rank),
+          0,
+          output_image_size,
+          pointers,
+          padding_data.data());
+
+      auto new_offsets = std::make_shared<IndirectionOffsets>();
+      new_offsets->input_shape = image_shape;
+      new_offsets->offsets.resize(SafeInt<size_t>(kernel_size) * output_image_size);
+      for (size_t i = 0; i < new_offsets->offsets.size(); ++i) {
+        new_offsets->offsets[i] = pointers[i] == padding_data.data() ? -1 : pointers[i] - base;
+      }
+      indirection_offsets_ = std::move(new_offsets);
+    }
+    indirection_offsets = indirection_offsets_;
   }
 
   concurrency::ThreadPool* thread_pool = context->GetOperatorThreadPool();
@@ -750,21 +899,18 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
 
       ActType const** worker_indirection_buffer = nullptr;
       if (indirection_buffer) {
-        worker_indirection_buffer = static_cast<ActType const**>(indirection_buffer.get()) + output_start * kernel_size;
-        math::Im2col<ActType, StorageOrder::NHWC>()(
-            input_data,
-            C,
-            input_shape.GetDims().data(),
-            output_shape.GetDims().data(),
-            kernel_shape.data(),
-            strides.data(),
-            dilations.data(),
-            pads.data(),
-            static_cast<ptrdiff_t>(kernel_rank),
-            output_start,
-            output_count,
-            worker_indirection_buffer,
-            padding_data.data());
+        worker_indirection_buffer = static_cast<ActType const**>(indirection_buffer.get()) +
+                                    output_start * kernel_size * indirection_group_count;
+        const size_t worker_entries = static_cast<size_t>(output_count * kernel_size);
+        const ptrdiff_t* worker_offsets = indirection_offsets->offsets.data() + output_start * kernel_size;
+        for (int64_t group_id = 0; group_id < indirection_group_count; ++group_id) {
+          const ActType* group_input_data = input_data + group_id * group_input_channels;
+          const ActType* group_padding_data = padding_data.data() + group_id * group_input_channels;
+          ActType const** group_indirection_buffer = worker_indirection_buffer + group_id * worker_entries;
+          for (size_t i = 0; i < worker_entries; ++i) {
+            group_indirection_buffer[i] = worker_offsets[i] < 0 ? group_padding_data : group_input_data + worker_offsets[i];
+          }
+        }
       }
 
       auto* worker_output = output_data + output_start * M;
@@ -778,8 +924,9 @@ Status QLinearConv<ActType>::Compute(OpKernelContext* context) const {
         }
         conv_params.Filter = packed_W_buffer_.get();
         conv_params.Output = worker_output;
-        conv_params.InputChannels = static_cast<size_t>(C);
-        conv_params.OutputChannels = static_cast<size_t>(M);
+        conv_params.InputChannels = static_cast<size_t>(group_input_channels);
+        conv_params.OutputChannels = static_cast<size_t>(group_output_channels);
+        conv_params.GroupCount = static_cast<size_t>(group_count);
         conv_params.OutputCount = static_cast<size_t>(output_count);
         conv_params.KernelSize = static_cast<size_t>(kernel_size);
         conv_params.Bias = column_sums_.data();
@@ -6,6 +6,7 @@
 #include "core/common/inlined_containers.h"
 #include "core/common/narrow.h"
 #include "core/common/span_utils.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/providers/common.h"
 //TODO: fix the warnings
 #if defined(_MSC_VER) && !defined(__clang__)
@@ -531,6 +532,242 @@ void NoTransposeReduce2Loops(Tensor* output, const TensorShape& new_input_shape,
   concurrency::ThreadPool::TryParallelFor(tp, onnxruntime::narrow<std::ptrdiff_t>(count), cost, fn);
 }
 
+// Describes a float reduction over any set of axes for the MLAS reduce kernels. The shape produced by
+// OptimizeShapeForFastReduce() alternates kept and reduced segments. The two innermost segments form one matrix
+// per combination of the outer indices: either the reduced elements are contiguous (rows) or the kept elements
+// are contiguous (columns). The outer indices are enumerated into offsets of the kept and of the reduced segments.
+struct MlasReducePlan {
+  bool columns;
+  size_t inner;
+  size_t middle;
+  InlinedVector<size_t> kept_offsets;
+  InlinedVector<size_t> reduced_offsets;
+
+  // Output elements produced by one kept offset.
+  size_t BlockSize() const { return columns ? inner : middle; }
+  // Reduced elements of the matrix for one reduced offset.
+  size_t MatrixReduceCount() const { return columns ? middle : inner; }
+  size_t OutputCount() const { return kept_offsets.size() * BlockSize(); }
+  size_t ReduceCount() const { return reduced_offsets.size() * MatrixReduceCount(); }
+};
+
+static MlasReducePlan PlanMlasReduce(gsl::span<const int64_t> fast_shape, gsl::span<const int64_t> fast_axes) {
+  const size_t rank = fast_shape.size();
+  InlinedVector<bool> reduced(rank, false);
+  for (auto a : fast_axes) {
+    reduced[narrow<size_t>(a)] = true;
+  }
+
+  MlasReducePlan plan;
+  plan.columns = !reduced[rank - 1];
+  plan.inner = narrow<size_t>(fast_shape[rank - 1]);
+  plan.middle = rank >= 2 ? narrow<size_t>(fast_shape[rank - 2]) : 1;
+  plan.kept_offsets.push_back(0);
+  plan.reduced_offsets.push_back(0);
+
+  if (rank > 2) {
+    InlinedVector<size_t> strides(rank);
+    strides[rank - 1] = 1;
+    for (size_t i = rank - 1; i > 0; --i) {
+      strides[i - 1] = strides[i] * narrow<size_t>(fast_shape[i]);
+    }
+    // Later dimensions vary fastest so that the kept offsets follow the layout of the output.
+    for (size_t i = 0; i < rank - 2; ++i) {
+      auto& offsets = reduced[i] ? plan.reduced_offsets : plan.kept_offsets;
+      InlinedVector<size_t> expanded;
+      expanded.reserve(offsets.size() * narrow<size_t>(fast_shape[i]));
+      for (size_t offset : offsets) {
+        for (size_t j = 0; j < narrow<size_t>(fast_shape[i]); ++j) {
+          expanded.push_back(offset + j * strides[i]);
+        }
+      }
+      offsets = std::move(expanded);
+    }
+  }
+
+  return plan;
+}
+
+// Reduces the output elements [begin, end) of the block of kept offset `o` over the reduced elements
+// [reduce_begin, reduce_end), where both ranges follow the order of MlasReducePlan.
+static void MlasReduceRange(MLAS_REDUCE_KIND kind, const MlasReducePlan& plan, const float* input, const float* bias,
+                            float* output, size_t o, size_t begin, size_t end,
+                            size_t reduce_begin, size_t reduce_end) {
+  const size_t matrix_reduce_count = plan.MatrixReduceCount();
+  bool accumulate = false;
+  for (size_t r = reduce_begin; r < reduce_end;) {
+    const size_t q = r / matrix_reduce_count;
+    const size_t r0 = r % matrix_reduce_count;
+    const size_t r1 = std::min(matrix_reduce_count, r0 + (reduce_end - r));
+    const float* matrix = input + plan.kept_offsets[o] + plan.reduced_offsets[q];
+    if (plan.columns) {
+      MlasReduceColumnsF32(kind, matrix + r0 * plan.inner + begin, plan.inner, r1 - r0, end - begin, bias, output,
+                           accumulate);
+    } else {
+      MlasReduceRowsF32(kind, matrix + begin * plan.inner + r0, plan.inner, end - begin, r1 - r0, bias, output,
+                        accumulate);
+    }
+    accumulate = true;
+    r += r1 - r0;
+  }
+}
+
+// A reduction producing fewer outputs than threads is split over its reduced elements above this many elements.
+static constexpr size_t kMlasReduceMinSplitElements = 16 * 1024;
+
+static void MlasReduce(MLAS_REDUCE_KIND kind, const MlasReducePlan& plan, const float* input, const float* bias,
+                       float* output, concurrency::ThreadPool* tp) {
+  const size_t block_size = plan.BlockSize();
+  const size_t output_count = plan.OutputCount();
+  const size_t reduce_count = plan.ReduceCount();
+  const size_t dop = static_cast<size_t>(concurrency::ThreadPool::DegreeOfParallelism(tp));
+
+  const size_t partitions = std::min({dop, reduce_count, output_count * reduce_count / kMlasReduceMinSplitElements});
+  if (output_count >= dop || partitions <= 1) {
+    // Parallelize over the output elements.
+    auto fn = [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      size_t o = static_cast<size_t>(first) / block_size;
+      size_t begin = static_cast<size_t>(first) % block_size;
+      size_t remaining = static_cast<size_t>(last - first);
+      while (remaining > 0) {
+        const size_t end = std::min(block_size, begin + remaining);
+        const size_t index = o * block_size + begin;
+        MlasReduceRange(kind, plan, input, bias ? bias + index : nullptr, output + index, o, begin, end,
+                        0, reduce_count);
+        remaining -= end - begin;
+        begin = 0;
+        ++o;
+      }
+    };
+    concurrency::ThreadPool::TryParallelFor(tp, narrow<std::ptrdiff_t>(output_count),
+                                            ParallelReduceFastCost(1, narrow<int64_t>(reduce_count), sizeof(float), 6),
+                                            fn);
+    return;
+  }
+
+  // Few output elements with much to reduce: each partition reduces a range of the reduced elements into its own
+  // partial outputs, and the partial outputs are combined afterwards.
+  std::vector<float> partials(partitions * output_count);
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, narrow<std::ptrdiff_t>(partitions), [&](std::ptrdiff_t p) {
+    const size_t reduce_begin = reduce_count * static_cast<size_t>(p) / partitions;
+    const size_t reduce_end = reduce_count * static_cast<size_t>(p + 1) / partitions;
+    float* partial = partials.data() + static_cast<size_t>(p) * output_count;
+    for (size_t o = 0; o < plan.kept_offsets.size(); ++o) {
+      const size_t index = o * block_size;
+      MlasReduceRange(kind, plan, input, bias ? bias + index : nullptr, partial + index, o, 0, block_size,
+                      reduce_begin, reduce_end);
+    }
+  });
+
+  MLAS_REDUCE_KIND combine_kind;
+  switch (kind) {
+    case MlasReduceMaximum:
+    case MlasReduceMaximumFinite:
+      combine_kind = MlasReduceMaximum;
+      break;
+    case MlasReduceMinimum:
+      combine_kind = MlasReduceMinimum;
+      break;
+    default:
+      combine_kind = MlasReduceSum;
+      break;
+  }
+  MlasReduceColumnsF32(combine_kind, partials.data(), output_count, partitions, output_count, nullptr, output, false);
+}
+
+// Aggregators computed by MlasReduce() for float tensors.
+template <typename AGG>
+struct MlasReduceAggregator {
+  static constexpr bool kSupported = false;
+  static void Reduce(const MlasReducePlan&, const float*, float*, concurrency::ThreadPool*) {}
+};
+
+template <MLAS_REDUCE_KIND Kind>
+struct MlasReduceAggregatorKind {
+  static constexpr bool kSupported = true;
+  static void Reduce(const MlasReducePlan& plan, const float* input, float* output, concurrency::ThreadPool* tp) {
+    MlasReduce(Kind, plan, input, nullptr, output, tp);
+  }
+};
+
+template <>
+struct MlasReduceAggregator<ReduceAggregatorSum<float>> : MlasReduceAggregatorKind<MlasReduceSum> {};
+
+template <>
+struct MlasReduceAggregator<ReduceAggregatorSumSquare<float>> : MlasReduceAggregatorKind<MlasReduceSumSquare> {};
+
+template <>
+struct MlasReduceAggregator<ReduceAggregatorMax<float>> : MlasReduceAggregatorKind<MlasReduceMaximum> {};
+
+template <>
+struct MlasReduceAggregator<ReduceAggregatorMin<float>> : MlasReduceAggregatorKind<MlasReduceMinimum> {};
+
+template <>
+struct MlasReduceAggregator<ReduceAggregatorMean<float>> {
+  static constexpr bool kSupported = true;
+  static void Reduce(const MlasReducePlan& plan, const float* input, float* output, concurrency::ThreadPool* tp) {
+    MlasReduce(MlasReduceSum, plan, input, nullptr, output, tp);
+    const float count = static_cast<float>(plan.ReduceCount());
+    for (size_t i = 0; i < plan.OutputCount(); ++i) {
+      output[i] /= count;
+    }
+  }
+};
+
+template <>
+struct MlasReduceAggregator<ReduceAggregatorL2<float>> {
+  static constexpr bool kSupported = true;
+  static void Reduce(const MlasReducePlan& plan, const float* input, float* output, concurrency::ThreadPool* tp) {
+    MlasReduce(MlasReduceSumSquare, plan, input, nullptr, output, tp);
+    for (size_t i = 0; i < plan.OutputCount(); ++i) {
+      output[i] = std::sqrt(output[i]);
+    }
+  }
+};
+
+template <>
+struct MlasReduceAggregator<ReduceAggregatorLogSumExp<float>> {
+  static constexpr bool kSupported = true;
+  static void Reduce(const MlasReducePlan& plan, const float* input, float* output, concurrency::ThreadPool* tp) {
+    // Like ReduceAggregatorLogSumExp, shift by the maximum of the finite elements, or by 0 if there are none.
+    std::vector<float> maximum(plan.OutputCount());
+    MlasReduce(MlasReduceMaximumFinite, plan, input, nullptr, maximum.data(), tp);
+    for (auto& m : maximum) {
+      if (m == std::numeric_limits<float>::lowest()) {
+        m = 0.0f;
+      }
+    }
+    MlasReduce(MlasReduceSumExp, plan, input, maximum.data(), output, tp);
+    for (size_t i = 0; i < plan.OutputCount(); ++i) {
+      output[i] = std::log(output[i]) + maximum[i];
+    }
+  }
+};
+
+// Returns true if the reduction was computed by the MLAS reduce kernels.
+template <typename AGG>
+bool TryMlasReduce(Tensor* output, const TensorShapeVector& fast_shape, const Tensor& input,
+                   const TensorShapeVector& fast_axes, concurrency::ThreadPool* tp) {
+  if constexpr (MlasReduceAggregator<AGG>::kSupported) {
+    if (fast_axes.empty() || output->Shape().Size() == 0) {
+      return false;
+    }
+    MlasReducePlan plan = PlanMlasReduce(fast_shape, fast_axes);
+    if (narrow<int64_t>(plan.OutputCount()) != output->Shape().Size()) {
+      return false;
+    }
+    MlasReduceAggregator<AGG>::Reduce(plan, input.Data<float>(), output->MutableData<float>(), tp);
+    return true;
+  } else {
+    ORT_UNUSED_PARAMETER(output);
+    ORT_UNUSED_PARAMETER(fast_shape);
+    ORT_UNUSED_PARAMETER(input);
+    ORT_UNUSED_PARAMETER(fast_axes);
+    ORT_UNUSED_PARAMETER(tp);
+    return false;
+  }
+}
+
 void DropDimensions(const gsl::span<const int64_t>& input_shape,
                     const gsl::span<const int64_t>& axes,
                     TensorShapeVector& dropped_axes) {
@@ -802,6 +1039,10 @@ void CommonReduce1Loop(OpKernelContext* ctx,
     return;
   }
 
+  if (TryMlasReduce<AGG>(output, fast_shape, *input, fast_axes, ctx->GetOperatorThreadPool())) {
+    return;
+  }
+
   ResultsNoTransposePrepareForReduce last_results;
   NoTransposeReduce1Loop<AGG>(output, fast_shape, *input, fast_axes, ctx->GetOperatorThreadPool(), last_results);
 }
@@ -834,6 +1075,10 @@ void CommonReduce2Loops(OpKernelContext* ctx,
     return;
   }
 
+  if (TryMlasReduce<AGG>(output, fast_shape, *input, fast_axes, ctx->GetOperatorThreadPool())) {
+    return;
+  }
+
   ResultsNoTransposePrepareForReduce last_results;
   NoTransposeReduce2Loops<AGG>(output, fast_shape, *input, fast_axes, ctx->GetOperatorThreadPool(), last_results);
 }
@@ -963,6 +1208,10 @@ std::unique_ptr<Tensor> ReduceSum<T>::Impl(const Tensor& input, gsl::span<const
     }
   }
 
+  if (TryMlasReduce<ReduceAggregatorSum<T>>(output.get(), fast_shape, input, fast_axes, tp)) {
+    return output;
+  }
+
   ResultsNoTransposePrepareForReduce last_results;
   NoTransposeReduce1Loop<ReduceAggregatorSum<T>>(output.get(), fast_shape, input, fast_axes, tp, last_results);
   return output;
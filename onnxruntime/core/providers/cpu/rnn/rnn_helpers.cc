@@ -554,6 +554,35 @@ void merge_lstm_gates_to_memory(const float* pprev, const float* restrict pi, co
   }
 }
 
+// Computes one row of an LSTM step for the default activations (f = sigmoid, g = tanh, h = tanh) when there are
+// no peepholes and the input and forget gates are not coupled. In that case the i, o and f gates share an activation
+// and are adjacent in piofc, so the gate activations and the state update take a handful of passes over the row.
+// piofc holds the i, o, f and c gate inputs of the row (4 * c values) and pb the matching fused bias or nullptr.
+// pcurr holds Ct-1 on input and Ct on output, and Ht is written to ph.
+void lstm_cell_sigmoid_tanh(const float b, const float* pb, float* restrict piofc, float* restrict pcurr,
+                            float* restrict ph, int c) {
+  if (pb != nullptr) {
+    clip_add_bias(b, pb, piofc, 4 * c);
+  } else {
+    clip_ignore_bias(b, nullptr, piofc, 4 * c);
+  }
+
+  const float* pi = piofc;
+  const float* po = piofc + c;
+  const float* pf = piofc + 2 * c;
+  float* pg = piofc + 3 * c;
+
+  MlasComputeLogistic(piofc, piofc, static_cast<size_t>(3) * c);
+  MlasComputeTanh(pg, pg, c);
+
+  merge_lstm_gates_to_memory_in_place(pi, pf, pg, pcurr, c);
+
+  MlasComputeTanh(pcurr, ph, c);
+  for (int i = 0; i < c; i++) {
+    ph[i] *= po[i];
+  }
+}
+
 void gru_reset_gate_tanh(const float* ps1, float* ps2, float* pd, int c, float alpha, float beta) {
   ORT_UNUSED_PARAMETER(alpha);
   ORT_UNUSED_PARAMETER(beta);
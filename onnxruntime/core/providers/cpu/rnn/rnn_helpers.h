@@ -383,6 +383,7 @@ void sigmoid_exact(float* pd, int c, float alpha, float beta);
 void tanh_exact(float* pd, int c, float alpha, float beta);
 void merge_lstm_gates_to_memory(const float* pprev, const float* pi, const float* pf, const float* pg, float* pcurr,
                                 int c);
+void lstm_cell_sigmoid_tanh(float b, const float* pb, float* piofc, float* pcurr, float* ph, int c);
 void gru_reset_gate_tanh(const float* ps1, float* ps2, float* pd, int c, float alpha, float beta);
 void gru_reset_gate_sigmoid(const float* ps1, float* ps2, float* pd, int c, float alpha, float beta);
 void gru_reset_gate_relu(const float* ps1, const float* ps2, float* pd, int c, float alpha, float beta);
@@ -73,6 +73,11 @@ UniDirectionalLstm<T>::UniDirectionalLstm(
 
   clip_with_bias_ptr_ = use_bias_ ? deepcpu::clip_add_bias : deepcpu::clip_ignore_bias;
 
+  use_fused_gates_ = !use_peepholes_ && !input_forget_ &&
+                     activation_f_.func == deepcpu::sigmoid &&
+                     activation_g_.func == deepcpu::tanh &&
+                     activation_h_.func == deepcpu::tanh_m;
+
   SetNumThreads();
   AllocateBuffers();
   InitializeBuffers(initial_hidden_state, initial_cell_state);
@@ -99,10 +104,12 @@ void UniDirectionalLstm<T>::AllocateBuffers() {
   output_iofc_ = Allocate(allocator_, hidden_size_ * 4 * batch_size_ * seq_length_, output_iofc_ptr_);
 
   if (use_bias_) {
-    bias_WRi_ = Allocate(allocator_, hidden_size_, bias_WRi_ptr_);
-    bias_WRf_ = Allocate(allocator_, hidden_size_, bias_WRf_ptr_);
-    bias_WRo_ = Allocate(allocator_, hidden_size_, bias_WRo_ptr_);
-    bias_WRc_ = Allocate(allocator_, hidden_size_, bias_WRc_ptr_);
+    // keep the fused biases adjacent in the same order as the gates in output_iofc_
+    bias_WR_ = Allocate(allocator_, hidden_size_ * 4, bias_WR_ptr_);
+    bias_WRi_ = bias_WR_.subspan(0 * hidden_size_, hidden_size_);
+    bias_WRo_ = bias_WR_.subspan(1 * hidden_size_, hidden_size_);
+    bias_WRf_ = bias_WR_.subspan(2 * hidden_size_, hidden_size_);
+    bias_WRc_ = bias_WR_.subspan(3 * hidden_size_, hidden_size_);
   }
 
   if (direction_ == kReverse) {
@@ -453,6 +460,17 @@ void UniDirectionalLstm<T>::GateComputations(
 
     // check that we have hidden_size_x4 left starting at cur_out + b * hidden_size_x4, and get a raw pointer to that
     float* pi = SafeRawPointer<T>(out + b * hidden_size_x4, out_end, hidden_size_x4);
+
+    if (use_fused_gates_) {
+      // update Ct-1 in-place to Ct and write Ht
+      float* pC_cur = SafeRawPointer<T>(C_prev + b * hidden_size_, C_prev_end, hidden_size_);
+      float* pH =
+          SafeRawPointer<T>(batched_output + row * hidden_size_ + b * hidden_size_, batched_output_end, hidden_size_);
+      const float* pB = use_bias_ ? SafeRawConstPointer<T>(bias_WR_, 0, hidden_size_x4) : nullptr;
+      deepcpu::lstm_cell_sigmoid_tanh(clip_, pB, pi, pC_cur, pH, hidden_size_);
+      continue;
+    }
+
     float* po = pi + hidden_size_;
     float* pf = po + hidden_size_;
     float* pc = pf + hidden_size_;
@@ -17,8 +17,9 @@ using namespace onnxruntime::common;
 
 namespace onnxruntime {
 
-// TODO: The current implementation of sequence ops relies on tensor copies. Ideally we should try to avoid
-// these copies. This has been postponed due to lack of time.
+// The sequence ops share the tensors of their input sequences with their output sequences (see TensorSeq), and
+// only copy the tensors that they take from a tensor input, as the buffer of an input may be reused once the node
+// has run.
 
 // SequenceLength
 ONNX_CPU_OPERATOR_KERNEL(
@@ -219,24 +220,22 @@ Status SequenceInsert::Compute(OpKernelContext* context) const {
   }
 
   auto* Y = context->Output<TensorSeq>(0);
+  Y->SetType(S->DataType());
+  Y->Reserve(SafeInt<size_t>(num_tensors_input_seq) + 1);
 
-  std::vector<Tensor> tensors;
-  tensors.reserve(SafeInt<size_t>(num_tensors_input_seq) + 1);
+  // only the inserted tensor is copied, so that appending to a sequence in a Loop takes linear time
+  std::vector<Tensor> inserted_tensor;
+  ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, inserted_tensor));
   for (int i = 0; i < num_tensors_input_seq; ++i) {
     if (i == input_seq_idx) {
-      ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, tensors));
-      ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors));
-    } else {
-      ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors));
+      Y->Add(std::move(inserted_tensor.front()));
     }
+    Y->Add(S->GetShared(i));
   }
   if (input_seq_idx == num_tensors_input_seq) {
-    ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(*X, context, tensors));
+    Y->Add(std::move(inserted_tensor.front()));
   }
 
-  Y->SetType(S->DataType());
-  Y->SetElements(std::move(tensors));
-
   return Status::OK();
 }
 
@@ -272,15 +271,13 @@ Status SequenceErase::Compute(OpKernelContext* context) const {
   auto* Y = context->Output<TensorSeq>(0);
   Y->SetType(S->DataType());
 
-  std::vector<Tensor> tensors;
-  tensors.reserve(SafeInt<size_t>(num_tensors_input_seq) - 1);
+  Y->Reserve(SafeInt<size_t>(num_tensors_input_seq) - 1);
   for (int i = 0; i < num_tensors_input_seq; ++i) {
     if (i == input_seq_idx) {
       continue;
     }
-    ORT_RETURN_IF_ERROR(CreateCopyAndAppendCpuTensor(S->Get(i), context, tensors));
+    Y->Add(S->GetShared(i));
   }
-  Y->SetElements(std::move(tensors));
   return Status::OK();
 }
 
@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
 #include <string>
@@ -23,9 +24,8 @@
 #include "Eigen/src/Core/arch/Default/BFloat16.h"
 #include "Eigen/src/Core/arch/Default/Half.h"
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
 #include "core/mlas/inc/mlas.h"
-#endif
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
@@ -168,19 +168,97 @@ struct EigenCastType<BFloat16> {
   using type = Eigen::bfloat16;
 };
 
+// cast a contiguous span of elements
+template <typename SrcType, typename DstType>
+void CastSpan(const SrcType* in, DstType* out, std::ptrdiff_t count) {
+  using SrcEigenCastType = typename EigenCastType<SrcType>::type;
+  using DstEigenCastType = typename EigenCastType<DstType>::type;
+
+  const auto in_vector = ConstEigenVectorMap<SrcEigenCastType>(reinterpret_cast<const SrcEigenCastType*>(in), count);
+  auto out_vector = EigenVectorMap<DstEigenCastType>(reinterpret_cast<DstEigenCastType*>(out), count);
+  out_vector = in_vector.template cast<DstEigenCastType>();
+}
+
+// use the vectorized MLAS routines for the conversions between float and the 16-bit float types
+
+template <>
+void CastSpan<MLFloat16, float>(const MLFloat16* in, float* out, std::ptrdiff_t count) {
+  MlasConvertHalfToFloatBuffer(&in[0].val, out, static_cast<size_t>(count));
+}
+
+template <>
+void CastSpan<float, MLFloat16>(const float* in, MLFloat16* out, std::ptrdiff_t count) {
+  MlasConvertFloatToHalfBuffer(in, &out[0].val, static_cast<size_t>(count));
+}
+
+template <>
+void CastSpan<BFloat16, float>(const BFloat16* in, float* out, std::ptrdiff_t count) {
+  MlasConvertBFloat16ToFloatBuffer(&in[0].val, out, static_cast<size_t>(count));
+}
+
+template <>
+void CastSpan<float, BFloat16>(const float* in, BFloat16* out, std::ptrdiff_t count) {
+  MlasConvertFloatToBFloat16Buffer(in, &out[0].val, static_cast<size_t>(count));
+}
+
+// cast a contiguous span of elements where either type is a 16-bit float type by going through a small float buffer,
+// which matches the conversions of the Eigen float16 types
+template <typename SrcType, typename DstType>
+void CastSpanThroughFloat(const SrcType* in, DstType* out, std::ptrdiff_t count) {
+  constexpr std::ptrdiff_t kBlockSize = 256;
+  float buffer[kBlockSize];
+
+  for (std::ptrdiff_t i = 0; i < count; i += kBlockSize) {
+    const std::ptrdiff_t block_count = std::min(count - i, kBlockSize);
+    CastSpan<SrcType, float>(in + i, buffer, block_count);
+    CastSpan<float, DstType>(buffer, out + i, block_count);
+  }
+}
+
+// split the tensor into spans that are cast in parallel
+template <typename SrcType, typename DstType, typename SpanCaster>
+void ParallelCast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out,
+                  SpanCaster span_caster) {
+  const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
+  const auto* in_data = in.Data<SrcType>();
+  auto* out_data = out.MutableData<DstType>();
+
+  concurrency::ThreadPool::TryParallelFor(
+      context.GetOperatorThreadPool(), shape_size,
+      TensorOpCost{static_cast<double>(sizeof(SrcType)), static_cast<double>(sizeof(DstType)), 1.0},
+      [in_data, out_data, &span_caster](std::ptrdiff_t first, std::ptrdiff_t last) {
+        span_caster(in_data + first, out_data + first, last - first);
+      });
+}
+
 // generic tensor X -> Y
 template <typename SrcType, typename DstType, typename Enable = void>
 struct TensorCaster {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    using SrcEigenCastType = typename EigenCastType<SrcType>::type;
-    using DstEigenCastType = typename EigenCastType<DstType>::type;
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    ParallelCast<SrcType, DstType>(context, shape, in, out, CastSpan<SrcType, DstType>);
+  }
+};
 
-    const std::ptrdiff_t shape_size = narrow<std::ptrdiff_t>(shape.Size());
-    const auto in_vector =
-        ConstEigenVectorMap<SrcEigenCastType>(reinterpret_cast<const SrcEigenCastType*>(in.Data<SrcType>()), shape_size);
-    auto out_vector =
-        EigenVectorMap<DstEigenCastType>(reinterpret_cast<DstEigenCastType*>(out.MutableData<DstType>()), shape_size);
-    out_vector = in_vector.template cast<DstEigenCastType>();
+// tensor MLFloat16/BFloat16 -> X, where X is neither float nor string
+template <typename SrcType, typename DstType>
+struct TensorCaster<SrcType, DstType,
+                    std::enable_if_t<IsOrtFloat16Type<SrcType>::value &&
+                                     !std::is_same<DstType, float>::value &&
+                                     !std::is_same<DstType, std::string>::value>> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    ParallelCast<SrcType, DstType>(context, shape, in, out, CastSpanThroughFloat<SrcType, DstType>);
+  }
+};
+
+// tensor X -> MLFloat16/BFloat16, where X is neither float, string nor a 16-bit float type
+template <typename SrcType, typename DstType>
+struct TensorCaster<SrcType, DstType,
+                    std::enable_if_t<IsOrtFloat16Type<DstType>::value &&
+                                     !IsOrtFloat16Type<SrcType>::value &&
+                                     !std::is_same<SrcType, float>::value &&
+                                     !std::is_same<SrcType, std::string>::value>> {
+  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
+    ParallelCast<SrcType, DstType>(context, shape, in, out, CastSpanThroughFloat<SrcType, DstType>);
   }
 };
 
@@ -210,55 +288,6 @@ struct TensorCaster<std::string, DstType> {
   }
 };
 
-#if defined(_M_AMD64) && !defined(_M_ARM64EC)
-// specializations to use optimized and Windows x64-specific
-// MlasConvertHalfToFloatBuffer() routine for MLFloat16 -> float conversion
-
-// tensor MLFloat16 -> float
-template <>
-struct TensorCaster<MLFloat16, float> {
-  void Cast(const OpKernelContext&, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    auto out_data = out.MutableData<float>();
-    auto in_data = in.Data<MLFloat16>();
-    const size_t shape_size = narrow<size_t>(shape.Size());
-    MlasConvertHalfToFloatBuffer(&in_data[0].val, out_data, shape_size);
-  }
-};
-
-Tensor GetIntermediateMLFloat16ToFloatTensor(
-    const OpKernelContext& context, const TensorShape& shape, const Tensor& in) {
-  AllocatorPtr allocator;
-  ORT_THROW_IF_ERROR(context.GetTempSpaceAllocator(&allocator));
-  Tensor out{DataTypeImpl::GetType<float>(), shape, allocator};
-  TensorCaster<MLFloat16, float>{}.Cast(context, shape, in, out);
-  return out;
-}
-
-template <typename DstType>
-void CastMLFloat16ThroughFloatTensor(
-    const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) {
-  // use optimized MLFloat16 -> float, then float -> DstType
-  Tensor intermediate_tensor = GetIntermediateMLFloat16ToFloatTensor(context, shape, in);
-  TensorCaster<float, DstType>{}.Cast(context, shape, intermediate_tensor, out);
-}
-
-// tensor MLFloat16 -> X
-template <typename DstType>
-struct TensorCaster<MLFloat16, DstType> {
-  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    CastMLFloat16ThroughFloatTensor<DstType>(context, shape, in, out);
-  }
-};
-
-// tensor MLFloat16 -> string
-template <>
-struct TensorCaster<MLFloat16, std::string> {
-  void Cast(const OpKernelContext& context, const TensorShape& shape, const Tensor& in, Tensor& out) const {
-    CastMLFloat16ThroughFloatTensor<std::string>(context, shape, in, out);
-  }
-};
-#endif
-
 class Cast final : public OpKernel {
  public:
   Cast(const OpKernelInfo& info) : OpKernel(info) {
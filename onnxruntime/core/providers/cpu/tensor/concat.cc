@@ -256,6 +256,13 @@ Status ConcatBase::ComputeImpl(Prepare& p, OpKernelContext* ctx) const {
   // Note that output_strides_full is only used later when is_stack_ is true, so it's safe to move
   auto output_strides_for_copy = is_stack_ ? StridesForStack(output_strides_full, p.axis) : std::move(output_strides_full);
 
+  // each input is a contiguous block of the output if all the dims before the axis are 1. the allocation planner may
+  // have had the producers of such inputs write directly into their block, in which case there is nothing to copy.
+  const bool inputs_are_contiguous_in_output =
+      !is_stack_ && p.output_tensor->Shape().SizeToDimension(onnxruntime::narrow<size_t>(p.axis)) == 1;
+  const auto* output_data = static_cast<const char*>(p.output_tensor->DataRaw());
+  const auto element_size = static_cast<int64_t>(p.output_tensor->DataType()->Size());
+
   for (int input_index = 0; input_index < input_count; input_index++) {
     const auto& prep = p.inputs[input_index];
 
@@ -263,6 +270,13 @@ Status ConcatBase::ComputeImpl(Prepare& p, OpKernelContext* ctx) const {
     if (prep.num_elements == 0)
       continue;
 
+    if (inputs_are_contiguous_in_output &&
+        prep.tensor->DataRaw() == output_data + initial_output_offset * element_size) {
+      initial_output_offset += prep.tensor->Shape()[onnxruntime::narrow<size_t>(p.axis)] *
+                               output_strides_for_copy[onnxruntime::narrow<size_t>(p.axis)];
+      continue;
+    }
+
     // parallel copy the data across
     auto status = DispatchStridedCopy<EnabledDataTypes>(ctx->GetOperatorThreadPool(),
                                                         *p.output_tensor,
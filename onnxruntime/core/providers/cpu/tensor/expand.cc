@@ -4,22 +4,29 @@
 #include "expand.h"
 #include <cmath>
 #include <core/common/safeint.h>
+#include "core/framework/copy.h"
 
 namespace onnxruntime {
 
-#define REG_EXPAND_KERNEL(TYPE)                                                    \
-  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                        \
-      Expand,                                                                      \
-      8,                                                                           \
-      12,                                                                          \
-      TYPE,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
-      Expand<TYPE>);                                                               \
-  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                  \
-      Expand,                                                                      \
-      13,                                                                          \
-      TYPE,                                                                        \
-      KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_EXPAND_KERNEL_DEF KernelDefBuilder().MayStridedOutput(0, 0)
+#else
+#define CREATE_EXPAND_KERNEL_DEF KernelDefBuilder()
+#endif
+
+#define REG_EXPAND_KERNEL(TYPE)                                                          \
+  ONNX_CPU_OPERATOR_VERSIONED_TYPED_KERNEL(                                              \
+      Expand,                                                                            \
+      8,                                                                                 \
+      12,                                                                                \
+      TYPE,                                                                              \
+      CREATE_EXPAND_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
+      Expand<TYPE>);                                                                     \
+  ONNX_CPU_OPERATOR_TYPED_KERNEL(                                                        \
+      Expand,                                                                            \
+      13,                                                                                \
+      TYPE,                                                                              \
+      CREATE_EXPAND_KERNEL_DEF.TypeConstraint("T", DataTypeImpl::GetTensorType<TYPE>()), \
       Expand<TYPE>);
 
 REG_EXPAND_KERNEL(float)
@@ -35,6 +42,8 @@ REG_EXPAND_KERNEL(uint64_t)
 REG_EXPAND_KERNEL(bool)
 REG_EXPAND_KERNEL(MLFloat16)
 
+#undef CREATE_EXPAND_KERNEL_DEF
+
 template <typename T>
 Status Expand<T>::Compute(OpKernelContext* context) const {
   const auto* input_tensor = context->Input<Tensor>(0);
@@ -46,7 +55,7 @@ Status Expand<T>::Compute(OpKernelContext* context) const {
 
   const auto* shape_tensor = context->Input<Tensor>(1);
   const auto* shape_dims = shape_tensor->Data<int64_t>();
-  std::vector<int64_t> output_shape{shape_dims, shape_dims + shape_tensor->Shape().Size()};
+  TensorShapeVector output_shape(shape_dims, shape_dims + shape_tensor->Shape().Size());
 
   if (input_shape.size() > output_shape.size()) {
     output_shape.insert(output_shape.begin(), input_shape.size() - output_shape.size(), 1);
@@ -69,6 +78,24 @@ Status Expand<T>::Compute(OpKernelContext* context) const {
 
   TensorShape output_tensor_shape(output_shape);
   auto* output_tensor = context->Output(0, output_tensor_shape);
+
+#ifdef ENABLE_STRIDED_TENSORS
+  // Strided output, a view on the input with 0 strides for the broadcast dims.
+  if (IsStridedViewOf(*output_tensor, *input_tensor)) {
+    const auto input_strides = input_tensor->Strides();
+    const size_t rank_diff = output_shape.size() - input_shape.size();
+    TensorShapeVector output_strides(output_shape.size(), 0);
+    for (size_t i = 0; i < input_shape.size(); ++i) {
+      if (input_shape[i] == output_shape[rank_diff + i]) {
+        output_strides[rank_diff + i] = input_strides[i];
+      }
+    }
+    output_tensor->SetByteOffset(input_tensor->ByteOffset());
+    output_tensor->SetShapeAndStrides(output_tensor_shape, output_strides);
+    return Status::OK();
+  }
+#endif
+
   auto* output_data = output_tensor->MutableData<T>();
   auto* output_dims = output_shape.data();
   auto output_dims_size = static_cast<int64_t>(output_shape.size());
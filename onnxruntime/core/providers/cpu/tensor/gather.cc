@@ -65,7 +65,7 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
   const auto input_rank = input_data_shape.NumDimensions();
   p.axis = HandleNegativeAxis(axis_, narrow<int64_t>(input_rank));
 
-  std::vector<int64_t> shape;
+  TensorShapeVector shape;
   shape.reserve(input_rank - 1 + indices_shape.NumDimensions());
 
   // replace the dimension for p.axis with the shape from the indices
@@ -78,7 +78,7 @@ Status GatherBase::PrepareForCompute(OpKernelContext* context, Prepare& p) const
   for (int64_t i = p.axis + 1; i < static_cast<int64_t>(input_rank); ++i)
     shape.push_back(input_data_shape[narrow<size_t>(i)]);
 
-  p.output_tensor = context->Output(0, TensorShape(std::move(shape)));
+  p.output_tensor = context->Output(0, TensorShape(shape));
 
   return Status::OK();
 }
@@ -3,11 +3,17 @@
 
 #include "core/providers/cpu/tensor/grid_sample.h"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "core/common/safeint.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/TensorSeq.h"
 #include "core/providers/common.h"
 #include "core/framework/copy.h"
 #include "core/providers/op_kernel_type_control.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 
@@ -85,35 +91,39 @@ void GsGetCubicCoeffs(float x, float coeffs[4]) {
   coeffs[3] = ((cubic_alpha * (2 - x) - 5 * cubic_alpha) * (2 - x) + 8 * cubic_alpha) * (2 - x) - 4 * cubic_alpha;
 }
 
-template <typename T>
-T GsBicubicInterpolate(T p[4][4], float x, float y) {
-  float v[4] = {};
-  float coeffs[4] = {};
-  GsGetCubicCoeffs(x, coeffs);
-  for (int64_t i = 0; i < 4; i++) {
-    v[i] = coeffs[0] * p[i][0] + coeffs[1] * p[i][1] + coeffs[2] * p[i][2] + coeffs[3] * p[i][3];
+// Gathers the taps of `count` consecutive output locations from the image and interpolates them.
+// There are no bounds checks or branches, so the compiler can vectorize the loop over the output locations with
+// gathers.
+template <typename T, int64_t Taps>
+void GsSampleRow(const T* __restrict image, const int32_t* __restrict row_offsets,
+                 const int32_t* __restrict col_offsets, const T* __restrict row_weights,
+                 const T* __restrict col_weights, T* __restrict output, int64_t count) {
+  for (int64_t i = 0; i < count; i++) {
+    T value{};
+    for (int64_t r = 0; r < Taps; r++) {
+      const int32_t row = row_offsets[i * Taps + r];
+      T row_value{};
+      for (int64_t c = 0; c < Taps; c++) {
+        row_value += col_weights[i * Taps + c] * image[row + col_offsets[i * Taps + c]];
+      }
+      value += row_weights[i * Taps + r] * row_value;
+    }
+    output[i] = value;
   }
-  GsGetCubicCoeffs(y, coeffs);
-  return static_cast<T>(coeffs[0] * v[0] + coeffs[1] * v[1] + coeffs[2] * v[2] + coeffs[3] * v[3]);
 }
 
+// Input coordinate read by a tap at integer coordinate v, or -1 if it is in the zero padding.
+// A tap in the zero padding is given a weight of 0 and reads coordinate 0 instead.
 template <typename T>
-T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, float border[/* 4 */]) const {
-  T pixel = {};  // default 0
+int64_t GridSample<T>::TapCoordinate(int64_t v, int64_t length, float v_min, float v_max) const {
   if (padding_mode_ == Zeros) {
-    if (c >= 0 && c < W && r >= 0 && r < H) {
-      pixel = image[r * W + c];
-    }
-  } else if (padding_mode_ == Border) {
-    c = std::clamp<int64_t>(c, 0, W - 1);
-    r = std::clamp<int64_t>(r, 0, H - 1);
-    pixel = image[r * W + c];
-  } else {  // (padding_mode_ == Reflection)
-    c = static_cast<int64_t>(GsReflect(static_cast<T>(c), border[0], border[2]));
-    r = static_cast<int64_t>(GsReflect(static_cast<T>(r), border[1], border[3]));
-    pixel = image[r * W + c];
+    return (v >= 0 && v < length) ? v : -1;
   }
-  return pixel;
+  if (padding_mode_ == Border) {
+    return std::clamp<int64_t>(v, 0, length - 1);
+  }
+  // (padding_mode_ == Reflection)
+  return static_cast<int64_t>(GsReflect(static_cast<T>(v), v_min, v_max));
 }
 
 // When grid sampling, padding is applied before interpolation.
@@ -127,6 +137,129 @@ T GridSample<T>::PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, in
 //         ...
 // would be interpolated as p = p00 / 4
 //
+// The plan records where the taps of each output location are and how they are weighted, so the per channel work
+// in Compute is a plain gather and multiply-add.
+template <typename T>
+std::shared_ptr<const typename GridSample<T>::SamplingPlan> GridSample<T>::BuildSamplingPlan(
+    const T* grid_data, int64_t N, int64_t H_in, int64_t W_in, int64_t H_out, int64_t W_out,
+    concurrency::ThreadPool* tp) const {
+  // Force float here to avoid possible issue in integer T case
+  float x_min = -0.5f;
+  float x_max = W_in - 0.5f;
+  float y_min = -0.5f;
+  float y_max = H_in - 0.5f;
+
+  if (align_corners_) {
+    x_min = 0.f;
+    x_max = W_in - 1.f;
+    y_min = 0.f;
+    y_max = H_in - 1.f;
+  }
+
+  const int64_t taps = mode_ == Bicubic ? 4 : (mode_ == Bilinear ? 2 : 1);
+
+  auto plan = std::make_shared<SamplingPlan>();
+  plan->H_in = H_in;
+  plan->W_in = W_in;
+  plan->taps = taps;
+  const size_t plan_size = SafeInt<size_t>(N) * H_out * W_out * taps;
+  plan->row_offsets.resize(plan_size);
+  plan->col_offsets.resize(plan_size);
+  plan->row_weights.resize(plan_size);
+  plan->col_weights.resize(plan_size);
+
+  // set the offset of a row or column tap and return false if it is in the zero padding
+  auto row_offset = [&](int64_t r, int32_t& offset) {
+    r = TapCoordinate(r, H_in, y_min, y_max);
+    offset = r < 0 ? 0 : static_cast<int32_t>(r * W_in);
+    return r >= 0;
+  };
+  auto col_offset = [&](int64_t c, int32_t& offset) {
+    c = TapCoordinate(c, W_in, x_min, x_max);
+    offset = c < 0 ? 0 : static_cast<int32_t>(c);
+    return c >= 0;
+  };
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(N * H_out),
+      TensorOpCost{static_cast<double>(W_out * 2 * sizeof(T)),
+                   static_cast<double>(W_out * taps * 2 * (sizeof(int32_t) + sizeof(T))),
+                   static_cast<double>(W_out * taps * 16)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t grid_row = first; grid_row < last; grid_row++) {
+          const T* gridpoint = grid_data + grid_row * W_out * 2;
+          const size_t plan_index = SafeInt<size_t>(grid_row) * W_out * taps;
+          int32_t* row_offsets = plan->row_offsets.data() + plan_index;
+          int32_t* col_offsets = plan->col_offsets.data() + plan_index;
+          T* row_weights = plan->row_weights.data() + plan_index;
+          T* col_weights = plan->col_weights.data() + plan_index;
+
+          for (int64_t ox = 0; ox < W_out; ox++) {
+            auto nx = gridpoint[0];  // normalized location
+            auto ny = gridpoint[1];
+            auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
+            auto y = GsDenormalize<T>(ny, H_in, align_corners_);
+
+            if (mode_ == Nearest) {
+              x = static_cast<T>(std::nearbyintf(static_cast<float>(x)));
+              y = static_cast<T>(std::nearbyintf(static_cast<float>(y)));
+            }
+
+            if (x < x_min || x > x_max || y < y_min || y > y_max) {  // out of bound
+              if (padding_mode_ == Border) {
+                // use original border in both align_corner cases
+                x = std::clamp(x, static_cast<T>(0), static_cast<T>(W_in - 1));
+                y = std::clamp(y, static_cast<T>(0), static_cast<T>(H_in - 1));
+              } else if (padding_mode_ == Reflection) {
+                x = GsReflect(x, x_min, x_max);
+                y = GsReflect(y, y_min, y_max);
+              }
+            }  // out of bound
+
+            if (mode_ == Nearest) {
+              // x, y are integers in all padding modes
+              const bool inside = row_offset(static_cast<int64_t>(y), row_offsets[0]) &
+                                  col_offset(static_cast<int64_t>(x), col_offsets[0]);
+              row_weights[0] = static_cast<T>(inside ? 1 : 0);
+              col_weights[0] = static_cast<T>(1);
+            } else if (mode_ == Bilinear) {
+              int64_t x1 = static_cast<int64_t>(std::floor(x));
+              int64_t y1 = static_cast<int64_t>(std::floor(y));
+              int64_t x2 = x1 + 1;
+              int64_t y2 = y1 + 1;
+
+              col_weights[0] = col_offset(x1, col_offsets[0]) ? static_cast<T>(x2) - x : T{};
+              col_weights[1] = col_offset(x2, col_offsets[1]) ? x - static_cast<T>(x1) : T{};
+              row_weights[0] = row_offset(y1, row_offsets[0]) ? static_cast<T>(y2) - y : T{};
+              row_weights[1] = row_offset(y2, row_offsets[1]) ? y - static_cast<T>(y1) : T{};
+            } else {  // (mode_ == Bicubic)
+              int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
+              int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
+              T dx = static_cast<T>(x - x0 - 1);
+              T dy = static_cast<T>(y - y0 - 1);
+              float coeffs[4] = {};
+              GsGetCubicCoeffs(static_cast<float>(dx), coeffs);
+              for (int64_t i = 0; i < 4; i++) {
+                col_weights[i] = col_offset(x0 + i, col_offsets[i]) ? static_cast<T>(coeffs[i]) : T{};
+              }
+              GsGetCubicCoeffs(static_cast<float>(dy), coeffs);
+              for (int64_t i = 0; i < 4; i++) {
+                row_weights[i] = row_offset(y0 + i, row_offsets[i]) ? static_cast<T>(coeffs[i]) : T{};
+              }
+            }
+
+            gridpoint += 2;
+            row_offsets += taps;
+            col_offsets += taps;
+            row_weights += taps;
+            col_weights += taps;
+          }
+        }
+      });
+
+  return plan;
+}
+
 template <typename T>
 Status GridSample<T>::Compute(OpKernelContext* context) const {
   const auto* input = context->Input<Tensor>(0);
@@ -146,6 +279,9 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
   auto W_out = grid_dims[2];
   ORT_ENFORCE(grid_dims[0] == N, "Grid batch size ", grid_dims[0], " does not match input batch size ", N);
   ORT_ENFORCE(grid_dims[3] == 2, "Last dimension of grid: ", grid_dims[3], ", expect 2");
+  // the plan stores offsets within an image as int32_t
+  ORT_RETURN_IF(H_in * W_in > std::numeric_limits<int32_t>::max(),
+                "Input image of ", H_in, "x", W_in, " is too large for GridSample");
 
   TensorShape Y_shape = {N, C, H_out, W_out};
   auto& Y = *context->Output(0, Y_shape);
@@ -154,94 +290,53 @@ Status GridSample<T>::Compute(OpKernelContext* context) const {
     return Status::OK();
   }
 
-  // Force float here to avoid possible issue in integer T case
-  float x_min = -0.5f;
-  float x_max = W_in - 0.5f;
-  float y_min = -0.5f;
-  float y_max = H_in - 0.5f;
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
 
-  if (align_corners_) {
-    x_min = 0.f;
-    x_max = W_in - 1.f;
-    y_min = 0.f;
-    y_max = H_in - 1.f;
+  std::shared_ptr<const SamplingPlan> plan;
+  if (grid_is_constant_) {
+    std::lock_guard<std::mutex> lock(sampling_plan_mutex_);
+    if (sampling_plan_ == nullptr || sampling_plan_->H_in != H_in || sampling_plan_->W_in != W_in) {
+      sampling_plan_ = BuildSamplingPlan(grid->Data<T>(), N, H_in, W_in, H_out, W_out, tp);
+    }
+    plan = sampling_plan_;
+  } else {
+    plan = BuildSamplingPlan(grid->Data<T>(), N, H_in, W_in, H_out, W_out, tp);
   }
-  float border[] = {x_min, y_min, x_max, y_max};  // l-t-r-b
-
-  concurrency::ThreadPool* tp = H_out * W_out > 64 ? context->GetOperatorThreadPool() : nullptr;
-  for (int64_t n = 0; n < N; n++) {
-    const T* grid_data = grid->Data<T>() + n * (H_out * W_out) * 2;
-    concurrency::ThreadPool::TrySimpleParallelFor(
-        tp, onnxruntime::narrow<std::ptrdiff_t>(C),
-        [&](std::ptrdiff_t c) {
-          const T* X_data = input->Data<T>() + (n * C + c) * (H_in * W_in);
-          T* Y_data = Y.MutableData<T>() + (n * C + c) * (H_out * W_out);
-
-          for (int64_t oy = 0; oy < H_out; oy++) {
-            for (int64_t ox = 0; ox < W_out; ox++) {
-              const T* gridpoint = grid_data + (oy * W_out + ox) * 2;
-              T* Y_gridpoint = Y_data + oy * W_out + ox;
-              auto nx = gridpoint[0];  // normalized location
-              auto ny = gridpoint[1];
-              auto x = GsDenormalize<T>(nx, W_in, align_corners_);  // actual location
-              auto y = GsDenormalize<T>(ny, H_in, align_corners_);
-
-              if (mode_ == Nearest) {
-                x = static_cast<T>(std::nearbyintf(static_cast<float>(x)));
-                y = static_cast<T>(std::nearbyintf(static_cast<float>(y)));
-              }
 
-              if (x < x_min || x > x_max || y < y_min || y > y_max) {  // out of bound
-                if (padding_mode_ == Border) {
-                  // use original border in both align_corner cases
-                  x = std::clamp(x, static_cast<T>(0), static_cast<T>(W_in - 1));
-                  y = std::clamp(y, static_cast<T>(0), static_cast<T>(H_in - 1));
-                } else if (padding_mode_ == Reflection) {
-                  x = GsReflect(x, x_min, x_max);
-                  y = GsReflect(y, y_min, y_max);
-                }
-              }  // out of bound
-
-              if (mode_ == Nearest) {
-                // x, y are integers in all padding modes
-                *Y_gridpoint = PixelAtGrid(X_data, static_cast<int64_t>(y), static_cast<int64_t>(x), H_in, W_in, border);
-                continue;
-              }
+  const int64_t taps = plan->taps;
+  const T* X_data = input->Data<T>();
+  T* Y_data = Y.MutableData<T>();
 
-              if (mode_ == Bilinear) {
-                int64_t x1 = static_cast<int64_t>(std::floor(x));
-                int64_t y1 = static_cast<int64_t>(std::floor(y));
-                int64_t x2 = x1 + 1;
-                int64_t y2 = y1 + 1;
-
-                T p11 = PixelAtGrid(X_data, y1, x1, H_in, W_in, border);
-                T p12 = PixelAtGrid(X_data, y1, x2, H_in, W_in, border);
-                T p21 = PixelAtGrid(X_data, y2, x1, H_in, W_in, border);
-                T p22 = PixelAtGrid(X_data, y2, x2, H_in, W_in, border);
-
-                T dx2 = static_cast<T>(x2) - x;
-                T dx1 = x - static_cast<T>(x1);
-                T dy2 = static_cast<T>(y2) - y;
-                T dy1 = y - static_cast<T>(y1);
-                *Y_gridpoint = dy2 * (dx2 * p11 + dx1 * p12) + dy1 * (dx2 * p21 + dx1 * p22);
-              }
-              if (mode_ == Bicubic) {
-                int64_t x0 = static_cast<int64_t>(std::floor(x)) - 1;  // top-left corner of the bbox
-                int64_t y0 = static_cast<int64_t>(std::floor(y)) - 1;
-                T p[4][4] = {};  // [H][W]
-                for (int64_t h = 0; h < 4; h++) {
-                  for (int64_t w = 0; w < 4; w++) {
-                    p[h][w] = PixelAtGrid(X_data, h + y0, w + x0, H_in, W_in, border);
-                  }
-                }
-                T dx = static_cast<T>(x - x0 - 1);
-                T dy = static_cast<T>(y - y0 - 1);
-                *Y_gridpoint = GsBicubicInterpolate(p, static_cast<float>(dx), static_cast<float>(dy));
-              }
-            }
+  // one unit of work is an output row of one channel
+  concurrency::ThreadPool::TryParallelFor(
+      tp, onnxruntime::narrow<std::ptrdiff_t>(N * C * H_out),
+      TensorOpCost{static_cast<double>(W_out * taps * (taps * sizeof(T) + 2 * (sizeof(int32_t) + sizeof(T)))),
+                   static_cast<double>(W_out * sizeof(T)),
+                   static_cast<double>(W_out * taps * taps * 3)},
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t row = first; row < last; row++) {
+          const int64_t nc = row / H_out;
+          const int64_t n = nc / C;
+          const int64_t oy = row % H_out;
+          const T* image = X_data + nc * (H_in * W_in);
+          T* output = Y_data + row * W_out;
+
+          const size_t plan_index = SafeInt<size_t>(n * H_out + oy) * W_out * taps;
+          const int32_t* row_offsets = plan->row_offsets.data() + plan_index;
+          const int32_t* col_offsets = plan->col_offsets.data() + plan_index;
+          const T* row_weights = plan->row_weights.data() + plan_index;
+          const T* col_weights = plan->col_weights.data() + plan_index;
+
+          if (taps == 1) {
+            GsSampleRow<T, 1>(image, row_offsets, col_offsets, row_weights, col_weights, output, W_out);
+          } else if (taps == 2) {
+            GsSampleRow<T, 2>(image, row_offsets, col_offsets, row_weights, col_weights, output, W_out);
+          } else {
+            GsSampleRow<T, 4>(image, row_offsets, col_offsets, row_weights, col_weights, output, W_out);
           }
-        });
-  }
+        }
+      });
+
   return Status::OK();
 }
 
@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
 #include "core/util/math_cpuonly.h"
@@ -36,6 +40,10 @@ class GridSample final : public OpKernel {
     } else {
       padding_mode_ = Zeros;
     }
+
+    // the sampling plan only depends on the grid and the spatial size of the input, so it can be kept across runs
+    const Tensor* grid = nullptr;
+    grid_is_constant_ = info.TryGetConstantInput(1, &grid);
   }
 
   Status Compute(OpKernelContext* context) const override;
@@ -53,11 +61,33 @@ class GridSample final : public OpKernel {
     Reflection
   };
 
-  T PixelAtGrid(const T* image, int64_t r, int64_t c, int64_t H, int64_t W, float border[/* 4 */]) const;
+  // Input locations and weights of the taps for every output location of every batch in the grid.
+  // All modes are separable, so a location has `taps` rows and `taps` columns and its output is
+  //   sum_i row_weights[i] * (sum_j col_weights[j] * X[row_offsets[i] + col_offsets[j]])
+  // A row or column in the zero padding has a weight of 0.
+  struct SamplingPlan {
+    int64_t H_in;
+    int64_t W_in;
+    int64_t taps;
+    std::vector<int32_t> row_offsets;
+    std::vector<int32_t> col_offsets;
+    std::vector<T> row_weights;
+    std::vector<T> col_weights;
+  };
+
+  int64_t TapCoordinate(int64_t v, int64_t length, float v_min, float v_max) const;
+
+  std::shared_ptr<const SamplingPlan> BuildSamplingPlan(const T* grid_data, int64_t N, int64_t H_in, int64_t W_in,
+                                                        int64_t H_out, int64_t W_out,
+                                                        concurrency::ThreadPool* tp) const;
 
   GridSampleInterpolationMode mode_{Bilinear};
   GridSamplePaddingMode padding_mode_{Zeros};
   bool align_corners_{0};
+
+  bool grid_is_constant_{false};
+  mutable std::mutex sampling_plan_mutex_;
+  mutable std::shared_ptr<const SamplingPlan> sampling_plan_;
 };
 
 }  // namespace onnxruntime
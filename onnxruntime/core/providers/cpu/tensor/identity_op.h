@@ -88,22 +88,12 @@ class IdentityOp final : public OpKernel {
       // different before copying over the contents while
       // processing Tensors.
       if (X != output) {
+        // the tensors of a sequence are not modified once added, so the output sequence can share them
         output->SetType(X->DataType());
-
-        AllocatorPtr alloc;
-        auto status = context->GetTempSpaceAllocator(&alloc);
-        if (!status.IsOK()) {
-          ORT_THROW("Unable to get an allocator");
-        }
-        std::vector<Tensor> tensors;
-        for (auto it = X->begin(), end = X->end(); it != end; ++it) {
-          Tensor tmp(it->DataType(), onnxruntime::TensorShape(it->Shape()), alloc);
-          size_t bytes = it->SizeInBytes();
-          memcpy(tmp.MutableDataRaw(), it->DataRaw(), bytes);
-          tensors.push_back(std::move(tmp));
+        output->Reserve(X->Size());
+        for (size_t i = 0; i < X->Size(); ++i) {
+          output->Add(X->GetShared(i));
         }
-
-        output->SetElements(std::move(tensors));
       }
     }
 
@@ -3,10 +3,12 @@
 
 #include "core/providers/cpu/tensor/nonzero_op.h"
 
+#include <algorithm>
 #include <cassert>
+#include <numeric>
 #include <vector>
 #include <core/common/safeint.h>
-#include "core/util/math_cpuonly.h"
+#include "core/platform/threadpool.h"
 
 namespace onnxruntime {
 // kernel builder functions
@@ -51,6 +53,21 @@ NONZERO_TYPED_KERNEL(float)
 #undef NONZERO_9_TYPED_KERNEL
 #undef NONZERO_TYPED_KERNEL
 
+namespace {
+// Number of elements of X counted, then scattered, by a single task.
+constexpr std::ptrdiff_t kNonZeroBlockSize = 16384;
+
+template <typename T>
+int64_t CountNonZero(const T* data, std::ptrdiff_t count) {
+  // written as a plain reduction so that the compare and add are vectorized
+  int64_t non_zero = 0;
+  for (std::ptrdiff_t i = 0; i < count; ++i) {
+    non_zero += data[i] != T{} ? 1 : 0;
+  }
+  return non_zero;
+}
+}  // namespace
+
 template <typename T>
 Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto X = context->Input<Tensor>(0);
@@ -59,59 +76,84 @@ Status NonZero<T>::Compute(OpKernelContext* context) const {
   const auto& X_shape = X->Shape();
   assert(X_shape.Size() >= 0);
 
-  const Eigen::Index coordinate_size = X_shape.IsScalar() ? 1 : onnxruntime::narrow<Eigen::Index>(X_shape.NumDimensions());
-  std::vector<int64_t> non_zero_indices_buffer{};
-  // reserve enough space for indices for every element of X
-  non_zero_indices_buffer.reserve(SafeInt<size_t>(X_shape.Size()) * coordinate_size);
-
+  const int64_t coordinate_size = X_shape.IsScalar() ? 1 : static_cast<int64_t>(X_shape.NumDimensions());
+  const std::ptrdiff_t size = onnxruntime::narrow<std::ptrdiff_t>(X_shape.Size());
+  const std::ptrdiff_t num_blocks = (size + kNonZeroBlockSize - 1) / kNonZeroBlockSize;
   const T* data = X->Data<T>();
-
-  if (X_shape.IsScalar()) {
-    const T& value = *data;
-    if (value != T{}) {
-      non_zero_indices_buffer.push_back(0);
-    }
-  } else {
-    std::vector<int64_t> coordinate(coordinate_size, 0);
-
-    // as we iterate the entries, increment the coordinate for the current entry
-    // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
-    auto increment_coordinate = [&coordinate, &coordinate_size, &X_shape]() {
-      for (Eigen::Index idx = coordinate_size - 1; idx >= 0; --idx) {
-        int64_t& cur_coord = coordinate[idx];
-        if (cur_coord != X_shape[idx] - 1) {
-          ++cur_coord;
-          break;
+  concurrency::ThreadPool* tp = context->GetOperatorThreadPool();
+
+  // Two passes over X: count the non-zero values of each block, then turn the counts into the offset of each
+  // block in the output so that the blocks can write their coordinates independently.
+  std::vector<int64_t> block_offsets(SafeInt<size_t>(num_blocks) + 1, 0);
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_blocks, static_cast<double>(kNonZeroBlockSize), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const std::ptrdiff_t begin = block * kNonZeroBlockSize;
+          const std::ptrdiff_t end = std::min(begin + kNonZeroBlockSize, size);
+          block_offsets[block + 1] = CountNonZero(data + begin, end - begin);
         }
-        cur_coord = 0;
-      }
-    };
-
-    for (size_t i = 0, end = onnxruntime::narrow<size_t>(X_shape.Size()); i < end; ++i) {
-      const T& value = *data++;
-      if (value != T{}) {
-        non_zero_indices_buffer.insert(non_zero_indices_buffer.end(),
-                                       coordinate.begin(), coordinate.end());
-      }
-
-      increment_coordinate();
-    }
-  }
-
-  const Eigen::Index num_non_zero_values = onnxruntime::narrow<Eigen::Index>(non_zero_indices_buffer.size()) / coordinate_size;
-
-  // transpose result for output
-  ConstEigenMatrixMapRowMajor<int64_t> non_zero_indices_matrix{
-      non_zero_indices_buffer.data(),
-      num_non_zero_values, coordinate_size};
+      });
+  std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
 
+  const int64_t num_non_zero_values = block_offsets.back();
   Tensor* const Y = context->Output(0, {coordinate_size, num_non_zero_values});
   ORT_ENFORCE(Y, "failed to get first output!");
 
-  EigenMatrixMapRowMajor<int64_t> y_matrix{
-      Y->MutableData<int64_t>(),
-      coordinate_size, num_non_zero_values};
-  y_matrix = non_zero_indices_matrix.transpose();
+  if (num_non_zero_values == 0) {
+    return Status::OK();
+  }
+
+  // Y has shape (coordinate_size, num_non_zero_values), so dimension d of the coordinate of the i-th non-zero
+  // value is written to y_data[d * num_non_zero_values + i].
+  int64_t* y_data = Y->MutableData<int64_t>();
+
+  if (X_shape.IsScalar()) {
+    y_data[0] = 0;
+    return Status::OK();
+  }
+
+  const auto dims = X_shape.GetDims();
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_blocks, static_cast<double>(kNonZeroBlockSize), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        std::vector<int64_t> coordinate(onnxruntime::narrow<size_t>(coordinate_size), 0);
+
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          int64_t output_index = block_offsets[block];
+          if (output_index == block_offsets[block + 1]) {
+            continue;
+          }
+
+          const std::ptrdiff_t begin = block * kNonZeroBlockSize;
+          const std::ptrdiff_t end = std::min(begin + kNonZeroBlockSize, size);
+
+          // coordinate of the first entry of the block
+          int64_t remaining = begin;
+          for (int64_t idx = coordinate_size - 1; idx >= 0; --idx) {
+            coordinate[onnxruntime::narrow<size_t>(idx)] = remaining % dims[onnxruntime::narrow<size_t>(idx)];
+            remaining /= dims[onnxruntime::narrow<size_t>(idx)];
+          }
+
+          for (std::ptrdiff_t i = begin; i < end; ++i) {
+            if (data[i] != T{}) {
+              for (int64_t idx = 0; idx < coordinate_size; ++idx) {
+                y_data[idx * num_non_zero_values + output_index] = coordinate[onnxruntime::narrow<size_t>(idx)];
+              }
+              ++output_index;
+            }
+
+            // as we iterate the entries, increment the coordinate for the current entry
+            // e.g. if shape is {2,2}, we start with 0,0 increment to 0,1 increment to 1,0 and finally 1,1
+            for (int64_t idx = coordinate_size - 1; idx >= 0; --idx) {
+              int64_t& cur_coord = coordinate[onnxruntime::narrow<size_t>(idx)];
+              if (cur_coord != dims[onnxruntime::narrow<size_t>(idx)] - 1) {
+                ++cur_coord;
+                break;
+              }
+              cur_coord = 0;
+            }
+          }
+        }
+      });
 
   return Status::OK();
 }
@@ -536,6 +536,26 @@ Status Pad::Compute(OpKernelContext* ctx) const {
     slices_to_use = &slices_;
   }
 
+  // In streaming mode the innermost axis is only padded at the start of the stream
+  std::unique_lock<OrtMutex> streaming_lock;
+  const size_t data_rank = input_tensor.Shape().NumDimensions();
+  if (streaming_context_ != nullptr && data_rank > 0) {
+    streaming_lock = std::unique_lock<OrtMutex>(streaming_context_->Mutex());
+    const bool stream_started = streaming_context_->StartRun(input_tensor.Shape(), 0);
+    if (pads_to_use != &pads) {
+      pads = *pads_to_use;
+      slices = *slices_to_use;
+      pads_to_use = &pads;
+      slices_to_use = &slices;
+    }
+    if (!stream_started) {
+      pads[data_rank - 1] = 0;
+      slices[data_rank - 1] = 0;
+    }
+    pads[2 * data_rank - 1] = 0;
+    slices[2 * data_rank - 1] = 0;
+  }
+
   Status pad_status{};
   switch (element_size) {
     case sizeof(uint32_t):
@@ -5,14 +5,23 @@
 
 #include "core/common/common.h"
 #include "core/framework/op_kernel.h"
+#include "core/providers/cpu/nn/streaming_context.h"
 #include "padbase.h"
 
 namespace onnxruntime {
 
 struct Pad final : public OpKernel, public PadBase {
-  explicit Pad(const OpKernelInfo& info) : OpKernel(info), PadBase(info) {}
+  explicit Pad(const OpKernelInfo& info) : OpKernel(info), PadBase(info) {
+    if (IsStreamingNode(info)) {
+      streaming_context_ = std::make_unique<StreamingContext>();
+    }
+  }
 
   Status Compute(OpKernelContext* context) const override;
+
+ private:
+  // Tracks the stream of the innermost axis if the node is run in streaming mode
+  std::unique_ptr<StreamingContext> streaming_context_;
 };
 
 }  // namespace onnxruntime
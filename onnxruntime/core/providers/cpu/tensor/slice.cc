@@ -7,11 +7,11 @@
 #include <unordered_map>
 
 #include "core/common/narrow.h"
+#include "core/framework/copy.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/op_kernel_type_control_utils.h"
 #include "core/providers/common.h"
 #include "core/providers/cpu/tensor/slice_helper.h"
-#include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/op_kernel_type_control.h"
 
 using namespace ::onnxruntime::common;
@@ -39,16 +39,22 @@ using EnabledIndicesTypes = ORT_OP_KERNEL_ARG_ENABLED_TYPE_LIST_ALL_OPSETS(kCpuE
                                                                            Slice, Input, 1);
 }  // namespace
 
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_SLICE_KERNEL_DEF KernelDefBuilder().MayStridedOutput(0, 0)
+#else
+#define CREATE_SLICE_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     1, 9,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    CREATE_SLICE_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
     Slice1);
 
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     10, 10,
-    KernelDefBuilder()
+    CREATE_SLICE_KERNEL_DEF
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
         .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
     Slice10);
@@ -57,7 +63,7 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Slice,
     11,
     12,
-    KernelDefBuilder()
+    CREATE_SLICE_KERNEL_DEF
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
         .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
     Slice10);
@@ -65,11 +71,13 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
 ONNX_CPU_OPERATOR_KERNEL(
     Slice,
     13,
-    KernelDefBuilder()
+    CREATE_SLICE_KERNEL_DEF
         .TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>())
         .TypeConstraint("Tind", BuildKernelDefConstraintsFromTypeList<EnabledIndicesTypes>()),
     Slice10);
 
+#undef CREATE_SLICE_KERNEL_DEF
+
 // Coalesce contiguous non-slice dimensions into a single dimension.
 // Set p_flattened_input_dims_ and p_flattened_output_dims_ to nullptr if nothing coalesced.
 // Updates starts and steps to match the new dimensions.
@@ -235,30 +243,33 @@ static Status SliceImpl(OpKernelContext* ctx,
   if (output_shape.Size() == 0)
     return Status::OK();
 
-  // use MutableDataRaw as actual data type in tensor may not match as we templatize on data size
-  T* output = reinterpret_cast<T*>(output_tensor.MutableDataRaw());
-  const auto* output_end = output + output_tensor.Shape().Size();
-
-  auto create_output = [&output, &output_end](SliceIterator<T>& slice_input_iterator) {
-    while (output < output_end) {
-      output = slice_input_iterator.CopyContiguousInnermostAxes(output);
-    }
-
-     ORT_ENFORCE(output == output_end);
-  };
-
-  if (compute_metadata.p_flattened_input_dims_) {
-    // If we were able to coalesce the input and output shapes, use the new shapes.
-    auto input_iterator2 =
-        SliceIterator<T>(input_tensor, TensorShape(compute_metadata.flattened_input_dims_), compute_metadata.starts_,
-                         compute_metadata.flattened_output_dims_, compute_metadata.steps_);
-    create_output(input_iterator2);
-  } else {
-    auto input_iterator2 = SliceIterator<T>(input_tensor, compute_metadata.starts_, compute_metadata.output_dims_,
-                                            compute_metadata.steps_);
-    create_output(input_iterator2);
+  // the slice is a strided copy of the input, with the input strides times the steps from the offset of the starts.
+  // use the coalesced shapes if there are some
+  const bool flattened = compute_metadata.p_flattened_input_dims_ != nullptr;
+  const gsl::span<const int64_t> input_dims =
+      flattened ? gsl::span<const int64_t>(compute_metadata.flattened_input_dims_) : input_tensor.Shape().GetDims();
+  const TensorShapeVector& output_dims =
+      flattened ? compute_metadata.flattened_output_dims_ : compute_metadata.output_dims_;
+  const size_t rank = input_dims.size();
+
+  TensorShapeVector src_strides(rank);
+  TensorShapeVector dst_strides(rank);
+  std::ptrdiff_t src_offset = 0;
+  int64_t input_pitch = 1;
+  int64_t output_pitch = 1;
+  for (size_t i = rank; i > 0; --i) {
+    src_strides[i - 1] = input_pitch * compute_metadata.steps_[i - 1];
+    src_offset += narrow<std::ptrdiff_t>(input_pitch * compute_metadata.starts_[i - 1]);
+    dst_strides[i - 1] = output_pitch;
+    input_pitch *= input_dims[i - 1];
+    output_pitch *= output_dims[i - 1];
   }
 
+  // use MutableDataRaw as actual data type in tensor may not match as we templatize on data size
+  StridedCopy<T>(ctx->GetOperatorThreadPool(), reinterpret_cast<T*>(output_tensor.MutableDataRaw()), dst_strides,
+                 TensorShape(output_dims), reinterpret_cast<const T*>(input_tensor.DataRaw()) + src_offset,
+                 src_strides);
+
   return Status::OK();
 }
 
@@ -286,12 +297,12 @@ Status SliceBase::Compute(OpKernelContext* ctx) const {
 
   SliceOp::PrepareForComputeMetadata compute_metadata(input_dimensions);
 
+  TensorShapeVector input_starts;
+  TensorShapeVector input_ends;
+  TensorShapeVector input_axes;
+  TensorShapeVector input_steps;
   // Slice V10 & DynamicSlice
   if (dynamic_) {
-    TensorShapeVector input_starts;
-    TensorShapeVector input_ends;
-    TensorShapeVector input_axes;
-    TensorShapeVector input_steps;
     ORT_RETURN_IF_ERROR(FillVectorsFromInput(*ctx->Input<Tensor>(1), *ctx->Input<Tensor>(2),
                                              ctx->Input<Tensor>(3), ctx->Input<Tensor>(4),
                                              input_starts, input_ends,
@@ -304,6 +315,35 @@ Status SliceBase::Compute(OpKernelContext* ctx) const {
     ORT_RETURN_IF_ERROR(PrepareForCompute(attr_starts_, attr_ends_, attr_axes_, compute_metadata));
   }
 
+#ifdef ENABLE_STRIDED_TENSORS
+  // Strided output, a view on the sliced part of the input.
+  Tensor& output_tensor = *ctx->Output(0, TensorShape(compute_metadata.output_dims_));
+  if (IsStridedViewOf(output_tensor, input_tensor)) {
+    // compute_metadata has the starts and steps of coalesced dims, get the ones of all the dims
+    SliceOp::PrepareForComputeMetadata view_metadata(input_dimensions);
+    if (dynamic_) {
+      ORT_RETURN_IF_ERROR(SliceOp::PrepareForComputeHelper(input_starts, input_ends, input_axes, input_steps,
+                                                           view_metadata));
+    } else {
+      ORT_RETURN_IF_ERROR(SliceOp::PrepareForComputeHelper(attr_starts_, attr_ends_, attr_axes_, view_metadata));
+    }
+
+    const auto input_strides = input_tensor.Strides();
+    TensorShapeVector output_strides(input_strides.size());
+    int64_t offset = 0;
+    for (size_t i = 0; i < input_strides.size(); ++i) {
+      output_strides[i] = input_strides[i] * view_metadata.steps_[i];
+      offset += view_metadata.starts_[i] * input_strides[i];
+    }
+    if (output_tensor.Shape().Size() > 0) {
+      output_tensor.SetByteOffset(input_tensor.ByteOffset() +
+                                  static_cast<ptrdiff_t>(offset * input_tensor.DataType()->Size()));
+    }
+    output_tensor.SetShapeAndStrides(output_tensor.Shape(), output_strides);
+    return Status::OK();
+  }
+#endif
+
   Status status = Status::OK();
 
   bool supported = false;
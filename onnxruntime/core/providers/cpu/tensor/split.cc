@@ -28,12 +28,17 @@ ORT_SPECIFY_OP_KERNEL_ARG_REQUIRED_TYPES_ALL_OPSETS(
 using EnabledSplitDataTypes = ORT_OP_KERNEL_ARG_ENABLED_TYPE_LIST_ALL_OPSETS(
     kCpuExecutionProvider, kOnnxDomain, Split, Input, 0);
 
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_SPLIT_KERNEL_DEF KernelDefBuilder().MayStridedInput(0)
+#else
+#define CREATE_SPLIT_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Split,
     2,
     10,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    CREATE_SPLIT_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
     Split);
 
 // Opset 11 starts to support Neg Axis.
@@ -41,18 +46,18 @@ ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Split,
     11,
     12,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    CREATE_SPLIT_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
     Split);
 
 // Opset 13 starts to supports 'split' as optional input.
 ONNX_CPU_OPERATOR_KERNEL(
     Split,
     13,
-    KernelDefBuilder().TypeConstraint("T",
-                                      BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
+    CREATE_SPLIT_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledSplitDataTypes>()),
     Split);
 
+#undef CREATE_SPLIT_KERNEL_DEF
+
 Status SplitBase::PrepareForCompute(const TensorShape& input_shape, int num_outputs, int64_t& axis, int& before_dims,
                                     int& after_dims_including_split_axis, int& after_dims_excluding_split,
                                     std::vector<int64_t>& split_sizes) const {
@@ -136,12 +141,19 @@ Status Split::Compute(OpKernelContext* context) const {
     Tensor* output = context->Output(i, TensorShape{output_dimensions});
     const auto output_strides = StridesForTensor(*output);
 
-    ORT_RETURN_IF_ERROR(DispatchStridedCopy<EnabledSplitDataTypes>(context->GetOperatorThreadPool(),
-                                                                   *output, /* dst_offset */ 0, output_strides,
-                                                                   output->Shape(),
-                                                                   input, input_offset, input_strides));
+    // the allocation planner may have placed the output as a view on its part of the input, nothing to copy then
+    const auto* part_data = static_cast<const char*>(input.DataRaw()) +
+                            static_cast<ptrdiff_t>(input_offset) * static_cast<ptrdiff_t>(input.DataType()->Size());
+    const bool is_view_on_input = before_dims == 1 && output->DataRaw() == part_data;
+    if (!is_view_on_input) {
+      ORT_RETURN_IF_ERROR(DispatchStridedCopy<EnabledSplitDataTypes>(context->GetOperatorThreadPool(),
+                                                                     *output, /* dst_offset */ 0, output_strides,
+                                                                     output->Shape(),
+                                                                     input, input_offset, input_strides));
+    }
 
-    input_offset += SafeInt<ptrdiff_t>(split_size) * after_dims_excluding_split;  // offset by the data we used in this iteration
+    // offset by the data we used in this iteration. the input may be strided if it's a view (ENABLE_STRIDED_TENSORS).
+    input_offset += SafeInt<ptrdiff_t>(split_size) * input_strides[narrow<size_t>(axis)];
   }
 
   return Status::OK();
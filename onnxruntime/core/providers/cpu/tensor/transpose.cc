@@ -3,6 +3,7 @@
 
 #include "core/providers/cpu/tensor/transpose.h"
 
+#include "core/framework/copy.h"
 #include "core/framework/element_type_lists.h"
 #include "core/framework/utils.h"
 #include "core/framework/transpose_helper.h"
@@ -389,9 +390,36 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   TensorShape output_shape{output_dims};
   Tensor& Y = *ctx->Output(0, output_shape);
 
+#ifdef ENABLE_STRIDED_TENSORS
+  // Strided output, a view on the input with permuted strides.
+  if (IsStridedViewOf(Y, X)) {
+    const auto input_strides = X.Strides();
+    TensorShapeVector output_strides(rank);
+    for (size_t i = 0; i < rank; ++i) {
+      output_strides[i] = input_strides[(*p_perm)[i]];
+    }
+    Y.SetByteOffset(X.ByteOffset());
+    Y.SetShapeAndStrides(output_shape, output_strides);
+    return Status::OK();
+  }
+#endif
+
   if (output_shape.Size() == 0)
     return Status::OK();
 
+#ifdef ENABLE_STRIDED_TENSORS
+  // Strided input, gather it with the permuted strides.
+  if (!X.IsContiguous()) {
+    const auto input_strides = X.Strides();
+    TensorShapeVector permuted_input_strides(rank);
+    for (size_t i = 0; i < rank; ++i) {
+      permuted_input_strides[i] = input_strides[(*p_perm)[i]];
+    }
+    return DispatchStridedCopy<EnabledDataTypes>(ctx->GetOperatorThreadPool(), Y, 0, StridesForTensor(Y), output_shape,
+                                                 X, 0, permuted_input_strides);
+  }
+#endif
+
   if (IsTransposeReshape(*p_perm, input_dims)) {
     // As long as the dims with values > 1 stay in the same order, it's a reshape.
     // Example: Shape=(1,1,1024,4096) -> perm=(2,0,3,1).
@@ -412,17 +440,25 @@ Status Transpose::Compute(OpKernelContext* ctx) const {
   return status;
 }
 
+#ifdef ENABLE_STRIDED_TENSORS
+#define CREATE_TRANSPOSE_KERNEL_DEF KernelDefBuilder().MayStridedInput(0).MayStridedOutput(0, 0)
+#else
+#define CREATE_TRANSPOSE_KERNEL_DEF KernelDefBuilder()
+#endif
+
 ONNX_CPU_OPERATOR_VERSIONED_KERNEL(
     Transpose,
     1,
     12,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    CREATE_TRANSPOSE_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
     Transpose);
 
 ONNX_CPU_OPERATOR_KERNEL(
     Transpose,
     13,
-    KernelDefBuilder().TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
+    CREATE_TRANSPOSE_KERNEL_DEF.TypeConstraint("T", BuildKernelDefConstraintsFromTypeList<EnabledDataTypes>()),
     Transpose);
 
+#undef CREATE_TRANSPOSE_KERNEL_DEF
+
 }  // namespace onnxruntime
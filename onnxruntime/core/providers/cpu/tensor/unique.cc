@@ -2,10 +2,13 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cpu/tensor/unique.h"
+#include <algorithm>
 #include <map>
+#include <numeric>
 #include <core/common/safeint.h>
 #include "core/common/gsl.h"
 #include "core/framework/op_kernel_type_control_utils.h"
+#include "core/platform/threadpool.h"
 #include "core/providers/common.h"
 #include "core/providers/op_kernel_type_control.h"
 
@@ -142,6 +145,185 @@ class Subtensor {
   std::vector<T> items_;
 };
 
+// Number of elements handled by a single task in the parallel passes of the flattened implementation.
+constexpr std::ptrdiff_t kUniqueBlockSize = 16384;
+
+// Calls emit(i, output_index) for every i in [0, n) for which is_selected(i) is true, where output_index is the
+// number of selected entries before i. The entries are counted per block first, so that the blocks can then be
+// processed in parallel from their offset in the output. Returns the number of selected entries.
+template <typename IsSelected, typename Emit>
+static int64_t ParallelCompact(std::ptrdiff_t n, concurrency::ThreadPool* tp,
+                               const IsSelected& is_selected, const Emit& emit) {
+  const std::ptrdiff_t num_blocks = (n + kUniqueBlockSize - 1) / kUniqueBlockSize;
+  std::vector<int64_t> block_offsets(SafeInt<size_t>(num_blocks) + 1, 0);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_blocks, static_cast<double>(kUniqueBlockSize), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const std::ptrdiff_t end = std::min((block + 1) * kUniqueBlockSize, n);
+          int64_t count = 0;
+          for (std::ptrdiff_t i = block * kUniqueBlockSize; i < end; ++i) {
+            count += is_selected(i) ? 1 : 0;
+          }
+          block_offsets[block + 1] = count;
+        }
+      });
+  std::partial_sum(block_offsets.begin(), block_offsets.end(), block_offsets.begin());
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_blocks, static_cast<double>(kUniqueBlockSize), [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t block = first; block < last; ++block) {
+          const std::ptrdiff_t end = std::min((block + 1) * kUniqueBlockSize, n);
+          int64_t output_index = block_offsets[block];
+          for (std::ptrdiff_t i = block * kUniqueBlockSize; i < end; ++i) {
+            if (is_selected(i)) {
+              emit(i, output_index++);
+            }
+          }
+        }
+      });
+
+  return block_offsets.back();
+}
+
+// Sorts the indices of data by value, and by index for equal values. The blocks of one task per thread are sorted
+// in parallel, then merged pairwise.
+template <typename T>
+static void ParallelSortIndices(gsl::span<const T> data, gsl::span<int64_t> order, concurrency::ThreadPool* tp) {
+  const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(order.size());
+  std::iota(order.begin(), order.end(), int64_t{0});
+
+  auto less = [&data](int64_t a, int64_t b) {
+    const T& value_a = data[onnxruntime::narrow<size_t>(a)];
+    const T& value_b = data[onnxruntime::narrow<size_t>(b)];
+    return value_a < value_b || (!(value_b < value_a) && a < b);
+  };
+
+  const std::ptrdiff_t num_blocks = std::max<std::ptrdiff_t>(
+      1, std::min<std::ptrdiff_t>(concurrency::ThreadPool::DegreeOfParallelism(tp), n / kUniqueBlockSize));
+  auto block_begin = [n, num_blocks](std::ptrdiff_t block) { return n * block / num_blocks; };
+
+  int64_t* src = order.data();
+  concurrency::ThreadPool::TrySimpleParallelFor(tp, num_blocks, [&](std::ptrdiff_t block) {
+    std::sort(src + block_begin(block), src + block_begin(block + 1), less);
+  });
+
+  if (num_blocks == 1) {
+    return;
+  }
+
+  std::vector<int64_t> buffer(order.size());
+  int64_t* dst = buffer.data();
+  for (std::ptrdiff_t width = 1; width < num_blocks; width *= 2) {
+    const std::ptrdiff_t num_merges = (num_blocks + 2 * width - 1) / (2 * width);
+    concurrency::ThreadPool::TrySimpleParallelFor(tp, num_merges, [&](std::ptrdiff_t merge) {
+      const std::ptrdiff_t begin = block_begin(merge * 2 * width);
+      const std::ptrdiff_t middle = block_begin(std::min(merge * 2 * width + width, num_blocks));
+      const std::ptrdiff_t end = block_begin(std::min(merge * 2 * width + 2 * width, num_blocks));
+      std::merge(src + begin, src + middle, src + middle, src + end, dst + begin, less);
+    });
+    std::swap(src, dst);
+  }
+
+  if (src != order.data()) {
+    std::copy_n(src, n, order.data());
+  }
+}
+
+// Flattened Unique for types that can be sorted cheaply. The indices of the input are sorted by value, so equal
+// values are in runs that start with their first occurrence, and the runs are in the order of the sorted output.
+// For unsorted output, the runs are ranked by the position of their first occurrence.
+// The result matches the std::map based implementation below.
+template <typename T>
+static void ComputeFlattenedSorted(OpKernelContext& context, gsl::span<const T> data, bool sorted) {
+  concurrency::ThreadPool* tp = context.GetOperatorThreadPool();
+  const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(data.size());
+
+  std::vector<int64_t> order(data.size());
+  ParallelSortIndices<T>(data, order, tp);
+
+  auto value_at = [&](std::ptrdiff_t j) -> const T& { return data[onnxruntime::narrow<size_t>(order[j])]; };
+  auto is_run_start = [&](std::ptrdiff_t j) { return j == 0 || value_at(j - 1) < value_at(j); };
+
+  // start of each run in order, and the index of the run of each input entry in the sorted output
+  std::vector<int64_t> run_starts(data.size() + 1);
+  std::vector<int64_t> inverse_index(data.size());
+  const int64_t num_unique = ParallelCompact(n, tp, is_run_start, [&](std::ptrdiff_t j, int64_t run) {
+    run_starts[onnxruntime::narrow<size_t>(run)] = j;
+  });
+  run_starts[onnxruntime::narrow<size_t>(num_unique)] = n;
+  run_starts.resize(onnxruntime::narrow<size_t>(num_unique) + 1);
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_unique, static_cast<double>(n) / std::max<int64_t>(num_unique, 1),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t run = first; run < last; ++run) {
+          for (int64_t j = run_starts[run], end = run_starts[run + 1]; j < end; ++j) {
+            inverse_index[onnxruntime::narrow<size_t>(order[onnxruntime::narrow<size_t>(j)])] = run;
+          }
+        }
+      });
+
+  // position of each run in the output
+  std::vector<int64_t> output_index;
+  if (!sorted) {
+    std::vector<int64_t> run_first_seen_at(data.size(), -1);
+    concurrency::ThreadPool::TryParallelFor(
+        tp, num_unique, 1.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+          for (std::ptrdiff_t run = first; run < last; ++run) {
+            run_first_seen_at[onnxruntime::narrow<size_t>(order[onnxruntime::narrow<size_t>(run_starts[run])])] = run;
+          }
+        });
+
+    output_index.resize(onnxruntime::narrow<size_t>(num_unique));
+    ParallelCompact(
+        n, tp, [&](std::ptrdiff_t i) { return run_first_seen_at[i] >= 0; },
+        [&](std::ptrdiff_t i, int64_t position) {
+          output_index[onnxruntime::narrow<size_t>(run_first_seen_at[i])] = position;
+        });
+  }
+
+  Tensor& Y = *context.Output(0, {num_unique});
+  Tensor* indices_out = context.Output(1, {num_unique});
+  Tensor* inverse_indices = context.Output(2, {static_cast<int64_t>(n)});
+  Tensor* counts = context.Output(3, {num_unique});
+
+  auto Y_data = Y.MutableDataAsSpan<T>();
+  gsl::span<int64_t> indices_data = indices_out != nullptr ? indices_out->MutableDataAsSpan<int64_t>()
+                                                           : gsl::span<int64_t>();
+  gsl::span<int64_t> counts_data = counts != nullptr ? counts->MutableDataAsSpan<int64_t>()
+                                                     : gsl::span<int64_t>();
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, num_unique, 1.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        for (std::ptrdiff_t run = first; run < last; ++run) {
+          const size_t idx = onnxruntime::narrow<size_t>(sorted ? run : output_index[run]);
+          const int64_t start = run_starts[run];
+          Y_data[idx] = value_at(onnxruntime::narrow<std::ptrdiff_t>(start));
+          if (indices_out) {
+            indices_data[idx] = order[onnxruntime::narrow<size_t>(start)];
+          }
+          if (counts) {
+            counts_data[idx] = run_starts[run + 1] - start;
+          }
+        }
+      });
+
+  if (inverse_indices) {
+    auto inverse_indices_data = inverse_indices->MutableDataAsSpan<int64_t>();
+    if (sorted) {
+      std::copy(inverse_index.begin(), inverse_index.end(), inverse_indices_data.begin());
+    } else {
+      concurrency::ThreadPool::TryParallelFor(
+          tp, n, 1.0, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+            for (std::ptrdiff_t i = first; i < last; ++i) {
+              inverse_indices_data[i] = output_index[onnxruntime::narrow<size_t>(inverse_index[i])];
+            }
+          });
+    }
+  }
+}
+
 template <typename T>
 static void CreateFlattenedOutput(OpKernelContext& context,
                                   const std::map<const T, int64_t>& offsets,         // map sorted key to unsorted idx
@@ -305,6 +487,13 @@ Status Unique::ComputeImpl(OpKernelContext& context) const {
   const Tensor& input = *context.Input<Tensor>(0);
   auto data = input.DataAsSpan<T>();
 
+  if constexpr (!std::is_same<T, std::string>::value) {
+    if (flatten_) {
+      ComputeFlattenedSorted<T>(context, data, sort_);
+      return Status::OK();
+    }
+  }
+
   if (flatten_) {
     std::map<const T, int64_t> offsets;  // offset of entry in indices. provides map between sorted and unsorted values
     std::vector<std::vector<int64_t>> indices;
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/common/safeint.h"
+#include "core/mlas/inc/mlas.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/tensor/upsample.h"
 
@@ -619,6 +620,155 @@ BilinearParamsInteger SetupUpsampleBilinearInteger(const int32_t input_height,
   return p;
 }
 
+SeparableResizeTaps<float> GetBilinearResizeTaps(const BilinearParams& p,
+                                                 const int32_t input_width,
+                                                 const int32_t output_height,
+                                                 const int32_t output_width) {
+  // in_*1 is weighted by d*2 and in_*2 by d*1, see UpsampleBilinear
+  SeparableResizeTaps<float> taps;
+  taps.tap_count = 2;
+  taps.y_indices.reserve(narrow<size_t>(output_height) * 2);
+  taps.y_weights.reserve(narrow<size_t>(output_height) * 2);
+  for (int32_t y = 0; y < output_height; ++y) {
+    taps.y_indices.insert(taps.y_indices.end(),
+                          {p.input_width_mul_y1[y] / input_width, p.input_width_mul_y2[y] / input_width});
+    taps.y_weights.insert(taps.y_weights.end(), {p.dy2[y], p.dy1[y]});
+  }
+  taps.x_indices.reserve(narrow<size_t>(output_width) * 2);
+  taps.x_weights.reserve(narrow<size_t>(output_width) * 2);
+  for (int32_t x = 0; x < output_width; ++x) {
+    taps.x_indices.insert(taps.x_indices.end(), {p.in_x1[x], p.in_x2[x]});
+    taps.x_weights.insert(taps.x_weights.end(), {p.dx2[x], p.dx1[x]});
+  }
+  return taps;
+}
+
+SeparableResizeTaps<int32_t> GetBilinearResizeTaps(const BilinearParamsInteger& p,
+                                                   const int32_t input_width,
+                                                   const int32_t output_height,
+                                                   const int32_t output_width) {
+  SeparableResizeTaps<int32_t> taps;
+  taps.tap_count = 2;
+  taps.y_indices.reserve(narrow<size_t>(output_height) * 2);
+  taps.y_weights.reserve(narrow<size_t>(output_height) * 2);
+  for (int32_t y = 0; y < output_height; ++y) {
+    taps.y_indices.insert(taps.y_indices.end(),
+                          {p.input_width_mul_y1[y] / input_width, p.input_width_mul_y2[y] / input_width});
+    taps.y_weights.insert(taps.y_weights.end(), {p.dy2_scale_10[y], p.dy1_scale_10[y]});
+  }
+  taps.x_indices.reserve(narrow<size_t>(output_width) * 2);
+  taps.x_weights.reserve(narrow<size_t>(output_width) * 2);
+  for (int32_t x = 0; x < output_width; ++x) {
+    taps.x_indices.insert(taps.x_indices.end(), {p.in_x1[x], p.in_x2[x]});
+    taps.x_weights.insert(taps.x_weights.end(), {p.dx2_scale_10[x], p.dx1_scale_10[x]});
+  }
+  return taps;
+}
+
+template <typename T, typename WeightT>
+void SeparableResize(const SeparableResizeTaps<WeightT>& taps,
+                     int64_t image_count,
+                     int64_t num_channels,
+                     int64_t input_height,
+                     int64_t input_width,
+                     int64_t output_height,
+                     int64_t output_width,
+                     bool use_extrapolation,
+                     float extrapolation_value,
+                     const std::vector<float>& y_original,
+                     const std::vector<float>& x_original,
+                     const T* XdataBase,
+                     T* YdataBase,
+                     concurrency::ThreadPool* tp) {
+  const size_t tap_count = taps.tap_count;
+  const size_t channels = narrow<size_t>(num_channels);
+  const size_t row_size = narrow<size_t>(output_width) * channels;
+  const int64_t input_image_size = input_height * input_width * num_channels;
+  const int64_t output_image_size = output_height * output_width * num_channels;
+
+  concurrency::ThreadPool::TryParallelFor(
+      tp, static_cast<std::ptrdiff_t>(image_count * output_height),
+      static_cast<double>(row_size * tap_count * 2),
+      [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+        // Consecutive output rows mostly blend the same input rows, so keep the last tap_count
+        // horizontally resized rows keyed by their index over all the images.
+        std::vector<WeightT> row_buffer(tap_count * row_size);
+        InlinedVector<int64_t> cached_rows(tap_count, -1);
+        InlinedVector<int64_t> needed_rows(tap_count);
+        InlinedVector<const WeightT*> rows(tap_count);
+
+        for (std::ptrdiff_t i = first; i < last; ++i) {
+          const int64_t image = i / output_height;
+          const int64_t y = i % output_height;
+          const T* Xdata = XdataBase + image * input_image_size;
+          T* Ydata = YdataBase + image * output_image_size + y * output_width * num_channels;
+
+          // when use_extrapolation is set and original index of y is out of the dim range
+          // then use extrapolation_value as the output value.
+          const float in_y = y_original[narrow<size_t>(y)];
+          if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
+            std::fill_n(Ydata, row_size, static_cast<T>(extrapolation_value));
+            continue;
+          }
+
+          const int32_t* y_indices = taps.y_indices.data() + y * tap_count;
+          for (size_t t = 0; t < tap_count; ++t) {
+            needed_rows[t] = image * input_height + y_indices[t];
+          }
+
+          for (size_t t = 0; t < tap_count; ++t) {
+            size_t slot = 0;
+            while (slot < tap_count && cached_rows[slot] != needed_rows[t]) {
+              ++slot;
+            }
+            if (slot == tap_count) {
+              // Evict a row that the current output row doesn't blend. One always exists because
+              // there are as many slots as taps.
+              slot = 0;
+              while (std::find(needed_rows.begin(), needed_rows.end(), cached_rows[slot]) != needed_rows.end()) {
+                ++slot;
+              }
+              MlasResizeHorizontal(Xdata + y_indices[t] * input_width * num_channels, channels,
+                                   taps.x_indices.data(), taps.x_weights.data(), tap_count,
+                                   narrow<size_t>(output_width), row_buffer.data() + slot * row_size);
+              cached_rows[slot] = needed_rows[t];
+            }
+            rows[t] = row_buffer.data() + slot * row_size;
+          }
+
+          const WeightT* y_weights = taps.y_weights.data() + y * tap_count;
+          if constexpr (std::is_same_v<WeightT, float>) {
+            MlasResizeVertical(rows.data(), y_weights, tap_count, row_size, Ydata);
+          } else {
+            // The horizontal and vertical weights each have 10 fractional bits.
+            MlasResizeVertical(rows.data(), y_weights, tap_count, row_size, 20, Ydata);
+          }
+
+          if (use_extrapolation) {
+            for (int64_t x = 0; x < output_width; ++x) {
+              const float in_x = x_original[narrow<size_t>(x)];
+              if (in_x < 0 || in_x > static_cast<float>(input_width - 1)) {
+                std::fill_n(Ydata + x * num_channels, channels, static_cast<T>(extrapolation_value));
+              }
+            }
+          }
+        }
+      });
+}
+
+template void SeparableResize<float, float>(const SeparableResizeTaps<float>&, int64_t, int64_t, int64_t,
+                                            int64_t, int64_t, int64_t, bool, float, const std::vector<float>&,
+                                            const std::vector<float>&, const float*, float*,
+                                            concurrency::ThreadPool*);
+template void SeparableResize<uint8_t, int32_t>(const SeparableResizeTaps<int32_t>&, int64_t, int64_t, int64_t,
+                                                int64_t, int64_t, int64_t, bool, float, const std::vector<float>&,
+                                                const std::vector<float>&, const uint8_t*, uint8_t*,
+                                                concurrency::ThreadPool*);
+template void SeparableResize<int8_t, int32_t>(const SeparableResizeTaps<int32_t>&, int64_t, int64_t, int64_t,
+                                               int64_t, int64_t, int64_t, bool, float, const std::vector<float>&,
+                                               const std::vector<float>&, const int8_t*, int8_t*,
+                                               concurrency::ThreadPool*);
+
 struct TrilinearParams {
   std::vector<float> x_original;
   std::vector<float> y_original;
@@ -873,50 +1023,46 @@ std::array<float, CubicModeGridLength> GetCubicCoeffs(float s, float cubic_coeff
   return coeffs;
 }
 
-// Get the tensor data at the requested coordinate
-template <typename T>
-T GetDataForCoordinate(const T* Xdata,
-                       int64_t x, int64_t y,
-                       int64_t input_height, int64_t input_width) {
-  x = std::max(static_cast<int64_t>(0), std::min(x, input_width - 1));
-  y = std::max(static_cast<int64_t>(0), std::min(y, input_height - 1));
-  return Xdata[y * input_width + x];
-}
+// Gets the taps of bicubic resize along one axis. The 4 samples around each original coordinate are clamped to
+// the input and, when exclude_outside is set, the samples outside the input are dropped and the remaining
+// weights are renormalized so that their sum is 1.0
+static void GetBiCubicResizeTaps(int64_t input_size,
+                                 const std::vector<float>& original,
+                                 float cubic_coeff_a,
+                                 bool exclude_outside,
+                                 std::vector<int32_t>& indices,
+                                 std::vector<float>& weights) {
+  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
+  indices.reserve(original.size() * CubicModeGridLength);
+  weights.reserve(original.size() * CubicModeGridLength);
+
+  for (const float in_pos : original) {
+    const auto pos_int = static_cast<int64_t>(std::floor(in_pos));
+    const float s = in_pos - static_cast<float>(pos_int);
+    auto coeffs_it = cubic_coeffs.find(s);
+    if (coeffs_it == cubic_coeffs.end()) {
+      coeffs_it = cubic_coeffs.emplace(s, GetCubicCoeffs(s, cubic_coeff_a)).first;
+    }
 
-// Computes cubic convolution interpolation in 1D
-template <typename T>
-float CubicInterpolation1D(const T* Xdata,
-                           int64_t x,
-                           int64_t y,
-                           int64_t input_height,
-                           int64_t input_width,
-                           std::array<float, CubicModeGridLength>& coeff_array,
-                           float coeff_sum,
-                           std::unordered_map<int64_t, float>& cache) {
-  // When calculating cubic interpolation we move the 4*4 grid across the original data and therefore there is
-  // opportunity to cache the results for previously seen combinations.
-  // Check if the result is already available in the cache
-  auto grid_start_pos = (y)*input_width + (x - 1);
-  if (cache.find(grid_start_pos) != cache.end()) {
-    return cache[grid_start_pos];
-  }
+    std::array<float, CubicModeGridLength> coeffs = coeffs_it->second;
+    float coeff_sum = 1;
+    if (exclude_outside) {
+      coeff_sum = 0;
+      for (int64_t i = 0, pos_val = pos_int - 1; pos_val <= pos_int + 2; pos_val++, i++) {
+        if (pos_val < 0 || pos_val >= input_size) {
+          coeffs[narrow<size_t>(i)] = 0.0f;
+        }
+        coeff_sum += coeffs[narrow<size_t>(i)];
+      }
+    }
 
-  // get the neighbors in 1D and find interpolation for this dimension
-  // for 1D cubic interpolation 4 samples are used. 2 on the left and 2 on the right of x
-  float result = 0;
-  for (int i = 0, j = -1; i < static_cast<int>(CubicModeGridLength); i++, j++) {
-    auto orig_data = GetDataForCoordinate(Xdata, x + j, y, input_height, input_width);
-    result += coeff_array[narrow<size_t>(i)] / coeff_sum * orig_data;
+    for (int64_t i = 0, pos_val = pos_int - 1; pos_val <= pos_int + 2; pos_val++, i++) {
+      indices.push_back(static_cast<int32_t>(std::max(static_cast<int64_t>(0), std::min(pos_val, input_size - 1))));
+      weights.push_back(coeffs[narrow<size_t>(i)] / coeff_sum);
+    }
   }
-  cache[grid_start_pos] = result;
-
-  return result;
 }
-#if defined(_MSC_VER)
-#pragma warning(push)
-#pragma warning(disable : 6001)
-#endif
-template <typename T>
+
 void ResizeBiCubic(int64_t batch_size,
                    int64_t num_channels,
                    int64_t input_height,
@@ -930,23 +1076,21 @@ void ResizeBiCubic(int64_t batch_size,
                    float extrapolation_value,
                    bool exclude_outside,
                    const std::vector<float>& roi,
-                   const T* Xdata,
-                   T* Ydata,
-                   const GetOriginalCoordinateFunc& get_original_coordinate) {
+                   const float* Xdata,
+                   float* Ydata,
+                   const GetOriginalCoordinateFunc& get_original_coordinate,
+                   concurrency::ThreadPool* tp) {
   std::vector<float> y_original;
   y_original.reserve(narrow<size_t>(output_height));
 
   std::vector<float> x_original;
   x_original.reserve(narrow<size_t>(output_width));
 
-  std::unordered_map<float, std::array<float, CubicModeGridLength>> cubic_coeffs;
-  std::unordered_map<float, std::unordered_map<int64_t, float>> coeff_to_1Dinterpolation_map;
   auto roi_y_start = roi.size() / 2 - 2;
   auto roi_y_end = roi.size() - 2;
   auto roi_x_start = roi.size() / 2 - 1;
   auto roi_x_end = roi.size() - 1;
 
-  // generate coefficients in y direction
   for (int64_t y = 0; y < output_height; ++y) {
     float in_y = height_scale == 1 ? static_cast<float>(y)
                                    : get_original_coordinate(static_cast<float>(y), height_scale,
@@ -954,14 +1098,8 @@ void ResizeBiCubic(int64_t batch_size,
                                                              static_cast<float>(input_height),
                                                              roi[roi_y_start], roi[roi_y_end]);
     y_original.emplace_back(in_y);
-    auto s = y_original[narrow<size_t>(y)] - std::floor(y_original[narrow<size_t>(y)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
   }
 
-  // generate coefficients in x direction
   for (int64_t x = 0; x < output_width; ++x) {
     float in_x = width_scale == 1 ? static_cast<float>(x)
                                   : get_original_coordinate(static_cast<float>(x),
@@ -970,100 +1108,18 @@ void ResizeBiCubic(int64_t batch_size,
                                                             static_cast<float>(input_width),
                                                             roi[roi_x_start], roi[roi_x_end]);
     x_original.emplace_back(in_x);
-    auto s = x_original[narrow<size_t>(x)] - std::floor(x_original[narrow<size_t>(x)]);
-    if (cubic_coeffs.find(s) == cubic_coeffs.end()) {
-      cubic_coeffs[s] = GetCubicCoeffs(s, cubic_coeff_a);
-      coeff_to_1Dinterpolation_map[s] = {};
-    }
   }
 
-  // setup up temp arrays to hold coefficients when exclude_outside is set to true
-  std::array<float, CubicModeGridLength> y_coeff_holder;
-  std::array<float, CubicModeGridLength> x_coeff_holder;
-  float y_coeff_sum = 1;
-  float x_coeff_sum = 1;
-
-  for (int64_t n = 0; n < batch_size; n++) {
-    for (int64_t c = 0; c < num_channels; c++) {
-      for (int64_t y = 0; y < output_height; ++y) {
-        auto in_y = y_original[narrow<size_t>(y)];
+  // Cubic interpolation is separable: the 4x4 grid is first interpolated in the x dimension for each of
+  // its rows, and the results are then interpolated in the y dimension.
+  SeparableResizeTaps<float> taps;
+  taps.tap_count = CubicModeGridLength;
+  GetBiCubicResizeTaps(input_height, y_original, cubic_coeff_a, exclude_outside, taps.y_indices, taps.y_weights);
+  GetBiCubicResizeTaps(input_width, x_original, cubic_coeff_a, exclude_outside, taps.x_indices, taps.x_weights);
 
-        // when use_extrapolation is set and original index is out of the dim range
-        // then use extrapolation_value as the output value.
-        if (use_extrapolation && (in_y < 0 || in_y > static_cast<float>(input_height - 1))) {
-          for (int64_t x = 0; x < output_width; ++x) {
-            Ydata[y * output_width + x] = extrapolation_value;
-          }
-          continue;
-        }
-
-        auto y_int = static_cast<int64_t>(std::floor(in_y));
-        auto& coeff_y = exclude_outside ? y_coeff_holder : cubic_coeffs[in_y - y_int];
-        y_coeff_sum = 1;
-
-        if (exclude_outside) {
-          // When true, the weight of sampling locations outside the grid will be set to 0
-          // and the weight will be renormalized so that their sum is 1.0
-          y_coeff_sum = 0;
-          auto& orig_y_coeffs = cubic_coeffs[in_y - y_int];
-          for (int64_t i = 0, y_val = y_int - 1; y_val <= y_int + 2; y_val++, i++) {
-            y_coeff_holder[narrow<size_t>(i)] = (y_val < 0 || y_val >= static_cast<float>(input_height)) ? 0.0f : orig_y_coeffs[narrow<size_t>(i)];
-            y_coeff_sum += y_coeff_holder[narrow<size_t>(i)];
-          }
-        }
-
-        for (int64_t x = 0; x < output_width; ++x) {
-          auto in_x = x_original[narrow<size_t>(x)];
-
-          // when use_extrapolation is set and original index is out of the dim range
-          // then use extrapolation_value as the output value.
-          if (use_extrapolation && (in_x < 0 || in_x > static_cast<float>(input_width - 1))) {
-            Ydata[y * output_width + x] = extrapolation_value;
-            continue;
-          }
-
-          auto x_int = static_cast<int64_t>(std::floor(in_x));
-          auto s_x = static_cast<float>(in_x - x_int);
-          auto& coeff_x = exclude_outside ? x_coeff_holder : cubic_coeffs[s_x];
-          x_coeff_sum = 1;
-
-          if (exclude_outside) {
-            // When true, the weight of sampling locations outside the grid will be set to 0
-            // and the weight will be renormalized so that their sum is 1.0
-            x_coeff_sum = 0;
-            auto& orig_x_coeff = cubic_coeffs[s_x];
-            for (int64_t i = 0, x_val = x_int - 1; x_val <= x_int + 2; x_val++, i++) {
-              x_coeff_holder[narrow<size_t>(i)] = (x_val < 0 || x_val >= static_cast<float>(input_width)) ? 0.0f : orig_x_coeff[narrow<size_t>(i)];
-              x_coeff_sum += x_coeff_holder[narrow<size_t>(i)];
-            }
-          }
-
-          // Compute cubic interpolation in x dimension using the x coefficients.
-          // From the result of cubic interpolation in x dim, compute cubic interpolation in y dimension
-          auto& interpolation_result_cache = coeff_to_1Dinterpolation_map[s_x];
-          float result = 0;
-          for (int64_t y_val = y_int - 1, i = 0; y_val <= y_int + 2; y_val++, i++) {
-            auto x_interpolation_result = CubicInterpolation1D(Xdata, x_int, y_val,
-                                                               input_height, input_width, coeff_x, x_coeff_sum,
-                                                               interpolation_result_cache);
-            result += x_interpolation_result * coeff_y[narrow<size_t>(i)] / y_coeff_sum;
-          }
-
-          Ydata[y * output_width + x] = static_cast<T>(result);
-        }
-      }
-
-      Xdata += input_height * input_width;
-      Ydata += output_height * output_width;
-
-      // clear the cache when moving to the next channel
-      coeff_to_1Dinterpolation_map.clear();
-    }
-  }
+  SeparableResize(taps, batch_size * num_channels, 1, input_height, input_width, output_height, output_width,
+                  use_extrapolation, extrapolation_value, y_original, x_original, Xdata, Ydata, tp);
 }
-#if defined(_MSC_VER)
-#pragma warning(pop)
-#endif
 
 template <typename T>
 Status Upsample<T>::BaseCompute(OpKernelContext* context,
@@ -1262,7 +1318,8 @@ Status Upsample<T>::BaseCompute(OpKernelContext* context,
       ResizeBiCubic(batch_size, num_channels, input_height, input_width, output_height, output_width,
                     is_2D ? scales[0] : scales[2], is_2D ? scales[1] : scales[3], cubic_coeff_a_, use_extrapolation_,
                     extrapolation_value_, exclude_outside_, roi, X->Data<float>(),
-                    Y->MutableData<float>(), get_original_coordinate_);
+                    Y->MutableData<float>(), get_original_coordinate_,
+                    output_height * output_width > 64 ? context->GetOperatorThreadPool() : nullptr);
       return Status::OK();
     }
     default:
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <type_traits>
 #include <vector>
 #ifndef SHARED_PROVIDER
 #include "core/framework/op_kernel.h"
@@ -58,6 +59,40 @@ struct BilinearParamsInteger {
   int32_t* dy2_scale_10{nullptr};
 };
 
+// Indices and weights of a separable resize. Output row y blends tap_count horizontally resized input rows
+// y_indices[y * tap_count + t] with the weights y_weights[y * tap_count + t]. Likewise, output column x of a
+// horizontally resized row blends the input pixels x_indices[x * tap_count + t] with x_weights.
+template <typename WeightT>
+struct SeparableResizeTaps {
+  size_t tap_count{0};
+
+  std::vector<int32_t> y_indices;
+  std::vector<WeightT> y_weights;
+
+  std::vector<int32_t> x_indices;
+  std::vector<WeightT> x_weights;
+};
+
+// Resizes image_count images of input_height x input_width pixels of num_channels interleaved elements with
+// the MLAS separable resize kernels. Float images use float weights and quantized images use weights with 10
+// fractional bits per axis. Output pixels whose original coordinate is out of the input range are set to
+// extrapolation_value when use_extrapolation is set.
+template <typename T, typename WeightT>
+void SeparableResize(const SeparableResizeTaps<WeightT>& taps,
+                     int64_t image_count,
+                     int64_t num_channels,
+                     int64_t input_height,
+                     int64_t input_width,
+                     int64_t output_height,
+                     int64_t output_width,
+                     bool use_extrapolation,
+                     float extrapolation_value,
+                     const std::vector<float>& y_original,
+                     const std::vector<float>& x_original,
+                     const T* XdataBase,
+                     T* YdataBase,
+                     concurrency::ThreadPool* tp);
+
 template <typename T>
 class Upsample : public UpsampleBase, public OpKernel {
  public:
@@ -81,6 +116,11 @@ BilinearParams SetupUpsampleBilinear(const int32_t input_height,
                                      const GetOriginalCoordinateFunc& get_original_coordinate,
                                      const bool is_nchw);
 
+SeparableResizeTaps<float> GetBilinearResizeTaps(const BilinearParams& p,
+                                                 const int32_t input_width,
+                                                 const int32_t output_height,
+                                                 const int32_t output_width);
+
 template <typename T>
 void UpsampleBilinear(const int32_t batch_size,
                       const int32_t num_channels,
@@ -101,6 +141,13 @@ void UpsampleBilinear(const int32_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, true);
+  if constexpr (std::is_same_v<T, float>) {
+    SeparableResize(GetBilinearResizeTaps(p, input_width, output_height, output_width),
+                    static_cast<int64_t>(batch_size) * num_channels, 1, input_height, input_width,
+                    output_height, output_width, use_extrapolation, extrapolation_value,
+                    p.y_original, p.x_original, XdataBase, YdataBase, tp);
+    return;
+  }
   for (int32_t n = 0; n < batch_size; ++n) {
     concurrency::ThreadPool::TrySimpleParallelFor(
         tp, num_channels,
@@ -154,6 +201,13 @@ void NhwcUpsampleBilinear(const int32_t batch_size,
   BilinearParams p = SetupUpsampleBilinear(input_height, input_width, output_height, output_width,
                                            height_scale, width_scale, roi,
                                            alloc, get_original_coordinate, false);
+  if constexpr (std::is_same_v<T, float>) {
+    SeparableResize(GetBilinearResizeTaps(p, input_width, output_height, output_width),
+                    batch_size, num_channels, input_height, input_width,
+                    output_height, output_width, UseExtrapolation, extrapolation_value,
+                    p.y_original, p.x_original, XdataBase, YdataBase, tp);
+    return;
+  }
   for (int32_t n = 0; n < batch_size; ++n) {
     const T* const Xdata = XdataBase + n * (input_height * input_width) * num_channels;
     T* const Ydata = YdataBase + n * (output_height * output_width) * num_channels;
@@ -232,6 +286,11 @@ BilinearParamsInteger SetupUpsampleBilinearInteger(const int32_t input_height,
                                                    const GetOriginalCoordinateFunc& get_original_coordinate,
                                                    const bool is_nchw);
 
+SeparableResizeTaps<int32_t> GetBilinearResizeTaps(const BilinearParamsInteger& p,
+                                                   const int32_t input_width,
+                                                   const int32_t output_height,
+                                                   const int32_t output_width);
+
 template <typename T, bool UseExtrapolation>
 void NhwcUpsampleBilinearInteger(const int32_t batch_size,
                                  const int32_t num_channels,
@@ -251,6 +310,13 @@ void NhwcUpsampleBilinearInteger(const int32_t batch_size,
   BilinearParamsInteger p = SetupUpsampleBilinearInteger(input_height, input_width, output_height, output_width,
                                                          height_scale, width_scale, roi,
                                                          alloc, get_original_coordinate, false);
+  if constexpr (std::is_same_v<T, float>) {
+    SeparableResize(GetBilinearResizeTaps(p, input_width, output_height, output_width),
+                    batch_size, num_channels, input_height, input_width,
+                    output_height, output_width, UseExtrapolation, extrapolation_value,
+                    p.y_original, p.x_original, XdataBase, YdataBase, tp);
+    return;
+  }
   for (int32_t n = 0; n < batch_size; ++n) {
     const T* const Xdata = XdataBase + n * (input_height * input_width) * num_channels;
     T* const Ydata = YdataBase + n * (output_height * output_width) * num_channels;
@@ -0,0 +1,81 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cu_inc/common.cuh"
+
+/**
+ * Helpers for the kernels that move whole rows, e.g. the gathered rows of an embedding lookup, with one warp per
+ * row. The lanes of the warp copy consecutive vectors of the row, so each warp instruction moves a contiguous
+ * 512 bytes with 16 byte vectors instead of computing the index math of every element.
+ */
+
+namespace onnxruntime {
+namespace cuda {
+
+// rows shorter than this are copied per element, as most lanes of a warp per row would be idle
+constexpr size_t kMinWarpRowCopyBytes = 128;
+
+constexpr int kWarpRowCopyWarpsPerBlock = 8;
+
+// Returns the vector size of 16, 8 or 4 bytes with which rows of row_bytes bytes can be copied by the row kernels,
+// which needs the size and the base addresses to be multiples of it, or 0 if the rows are to be copied per element.
+inline int GetRowCopyVectorSize(size_t row_bytes, std::initializer_list<const void*> data) {
+  if (row_bytes < kMinWarpRowCopyBytes) {
+    return 0;
+  }
+
+  uintptr_t address_bits = row_bytes;
+  for (const void* p : data) {
+    address_bits |= reinterpret_cast<uintptr_t>(p);
+  }
+
+  for (int vector_size : {16, 8, 4}) {
+    if (address_bits % vector_size == 0) {
+      return vector_size;
+    }
+  }
+  return 0;
+}
+
+// Returns the grid of a row kernel launched with kWarpRowCopyWarpsPerBlock warps per block, which loops over the
+// rows when there are more than the blocks of the grid cover.
+inline int GetRowCopyBlocks(int64_t num_rows) {
+  constexpr int64_t max_blocks = 65535;
+  return static_cast<int>(std::min(CeilDiv(num_rows, int64_t{kWarpRowCopyWarpsPerBlock}), max_blocks));
+}
+
+template <typename VecT>
+__device__ __forceinline__ void WarpCopyRow(VecT* dst, const VecT* src, int64_t row_size, int lane) {
+  for (int64_t i = lane; i < row_size; i += GPU_WARP_SIZE) {
+    dst[i] = src[i];
+  }
+}
+
+template <typename VecT>
+__device__ __forceinline__ void WarpZeroRow(VecT* dst, int64_t row_size, int lane) {
+  for (int64_t i = lane; i < row_size; i += GPU_WARP_SIZE) {
+    dst[i] = VecT{};
+  }
+}
+
+// Calls launch with a value of the unsigned vector type of the given size, for a generic lambda that launches the
+// row kernel instantiated with decltype of its argument.
+template <typename Launch>
+void DispatchRowCopyVectorSize(int vector_size, Launch&& launch) {
+  switch (vector_size) {
+    case 16:
+      launch(uint4{});
+      break;
+    case 8:
+      launch(uint2{});
+      break;
+    default:
+      launch(uint32_t{});
+      break;
+  }
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
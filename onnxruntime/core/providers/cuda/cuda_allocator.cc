@@ -4,6 +4,7 @@
 #include "cuda_allocator.h"
 #include "cuda_common.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/stream_handles.h"
 #include "gpu_data_transfer.h"
 
 namespace onnxruntime {
@@ -87,6 +88,99 @@ void* CUDAExternalAllocator::Reserve(size_t size) {
   return p;
 }
 
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11020
+CUDAMemPoolAllocator::CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name,
+                                           size_t mem_limit, size_t release_threshold)
+    : IAllocator(
+          OrtMemoryInfo(name, OrtAllocatorType::OrtDeviceAllocator,
+                        OrtDevice(OrtDevice::GPU, OrtDevice::MemType::DEFAULT, device_id),
+                        device_id, OrtMemTypeDefault)),
+      mem_limit_(mem_limit) {
+  int supports_mem_pools = 0;
+  CUDA_CALL_THROW(cudaDeviceGetAttribute(&supports_mem_pools, cudaDevAttrMemoryPoolsSupported, device_id));
+  ORT_ENFORCE(supports_mem_pools != 0, "CUDA device ", device_id, " does not support memory pools.");
+
+  CUDA_CALL_THROW(cudaDeviceGetDefaultMemPool(&pool_, device_id));
+  // The pool is shared by the device, so the last allocator that is created sets the threshold for all its users.
+  uint64_t threshold = release_threshold;
+  CUDA_CALL_THROW(cudaMemPoolSetAttribute(pool_, cudaMemPoolAttrReleaseThreshold, &threshold));
+
+  stats_.bytes_limit = static_cast<int64_t>(mem_limit_);
+}
+
+void* CUDAMemPoolAllocator::AllocInternal(size_t size, Stream* stream) {
+  if (size == 0) {
+    return nullptr;
+  }
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  if (size > mem_limit_ - static_cast<size_t>(stats_.bytes_in_use)) {
+    ORT_THROW("Available memory of ", mem_limit_ - static_cast<size_t>(stats_.bytes_in_use),
+              " is smaller than requested bytes of ", size);
+  }
+
+  void* p = nullptr;
+  if (stream) {
+    CUDA_CALL_THROW(cudaMallocFromPoolAsync(&p, size, pool_, static_cast<cudaStream_t>(stream->GetHandle())));
+  } else {
+    // Without a stream the memory may be used on any stream, so wait for it to be ready.
+    CUDA_CALL_THROW(cudaMallocFromPoolAsync(&p, size, pool_, nullptr));
+    CUDA_CALL_THROW(cudaStreamSynchronize(nullptr));
+  }
+
+  allocations_[p] = Allocation{size, stream};
+  stats_.num_allocs++;
+  stats_.bytes_in_use += size;
+  stats_.total_allocated_bytes += size;
+  stats_.max_bytes_in_use = std::max(stats_.max_bytes_in_use, stats_.bytes_in_use);
+  stats_.max_alloc_size = std::max<int64_t>(stats_.max_alloc_size, size);
+  return p;
+}
+
+void* CUDAMemPoolAllocator::Alloc(size_t size) {
+  return AllocInternal(size, nullptr);
+}
+
+void* CUDAMemPoolAllocator::AllocOnStream(size_t size, Stream* stream, WaitNotificationFn /*wait_fn*/) {
+  return AllocInternal(size, stream);
+}
+
+void CUDAMemPoolAllocator::Free(void* p) {
+  if (p == nullptr) {
+    return;
+  }
+
+  std::lock_guard<OrtMutex> lock(lock_);
+  auto it = allocations_.find(p);
+  ORT_ENFORCE(it != allocations_.end(), "Freeing memory that was not allocated by ", Info().name);
+  stats_.bytes_in_use -= it->second.size;
+
+  // do not throw error since it's OK for the free to fail during shutdown
+  if (it->second.stream) {
+    // The memory returns to the pool once the work queued on its stream so far is done.
+    cudaFreeAsync(p, static_cast<cudaStream_t>(it->second.stream->GetHandle()));
+  } else {
+    cudaFree(p);
+  }
+  allocations_.erase(it);
+}
+
+void CUDAMemPoolAllocator::ReleaseStreamBuffers(Stream* stream) {
+  // The stream may be destroyed after this, so the memory that is still in use is freed synchronously.
+  std::lock_guard<OrtMutex> lock(lock_);
+  for (auto& allocation : allocations_) {
+    if (allocation.second.stream == stream) {
+      allocation.second.stream = nullptr;
+    }
+  }
+}
+
+void CUDAMemPoolAllocator::GetStats(AllocatorStats* stats) {
+  std::lock_guard<OrtMutex> lock(lock_);
+  *stats = stats_;
+}
+#endif
+
 void* CUDAPinnedAllocator::Alloc(size_t size) {
   void* p = nullptr;
   if (size > 0) {
@@ -7,6 +7,7 @@
 #include "core/common/inlined_containers.h"
 #include "core/framework/allocator.h"
 #include "core/platform/ort_mutex.h"
+#include "core/providers/cuda/cuda_pch.h"
 
 namespace onnxruntime {
 
@@ -50,6 +51,40 @@ class CUDAExternalAllocator : public CUDAAllocator {
   InlinedHashSet<void*> reserved_;
 };
 
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11020
+// Allocates from the default memory pool of the device with cudaMallocAsync instead of keeping an arena.
+// Memory allocated on a stream returns to the pool in the order of that stream when freed, and the pool is shared by
+// every user of the device, e.g. all the sessions on it, so they do not each hold on to their peak usage.
+// The pool keeps up to `release_threshold` bytes of unused memory when a stream synchronizes and releases the rest.
+class CUDAMemPoolAllocator : public IAllocator {
+ public:
+  CUDAMemPoolAllocator(OrtDevice::DeviceId device_id, const char* name, size_t mem_limit, size_t release_threshold);
+
+  void* Alloc(size_t size) override;
+  void Free(void* p) override;
+  void GetStats(AllocatorStats* stats) override;
+
+  bool IsStreamAware() const override { return true; }
+  void* AllocOnStream(size_t size, Stream* stream, WaitNotificationFn wait_fn) override;
+  void ReleaseStreamBuffers(Stream* stream) override;
+
+ private:
+  void* AllocInternal(size_t size, Stream* stream);
+
+  struct Allocation {
+    size_t size;
+    // Stream the memory is freed on, nullptr if it must be freed synchronously.
+    Stream* stream;
+  };
+
+  cudaMemPool_t pool_{};
+  const size_t mem_limit_;
+  OrtMutex lock_;
+  InlinedHashMap<void*, Allocation> allocations_;
+  AllocatorStats stats_;
+};
+#endif
+
 //TODO: add a default constructor
 class CUDAPinnedAllocator : public IAllocator {
  public:
@@ -8,6 +8,7 @@
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/cuda_allocator.h"
 #include "core/providers/cuda/cuda_fwd.h"
+#include "core/providers/cuda/cuda_nhwc_kernels.h"
 #include "core/providers/cuda/gpu_data_transfer.h"
 #include "core/providers/cuda/cuda_profiler.h"
 
@@ -20,6 +21,7 @@
 #endif
 
 #include "core/providers/cuda/cuda_stream_handle.h"
+#include "onnxruntime_config.h"
 
 using namespace onnxruntime::common;
 
@@ -123,7 +125,8 @@ AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId devi
                                                         size_t gpu_mem_limit,
                                                         ArenaExtendStrategy arena_extend_strategy,
                                                         CUDAExecutionProviderExternalAllocatorInfo external_allocator_info,
-                                                        OrtArenaCfg* default_memory_arena_cfg) {
+                                                        OrtArenaCfg* default_memory_arena_cfg,
+                                                        bool enable_cross_stream_reusing) {
   if (external_allocator_info.UseExternalAllocator()) {
     AllocatorCreationInfo default_memory_info(
         [external_allocator_info](OrtDevice::DeviceId id) {
@@ -147,14 +150,53 @@ AllocatorPtr CUDAExecutionProvider::CreateCudaAllocator(OrtDevice::DeviceId devi
                                   : OrtArenaCfg(gpu_mem_limit, static_cast<int>(arena_extend_strategy), -1, -1, -1)},
         // make it stream aware
         true,
-        // enable cross stream sharing?
-        false);
+        // a free chunk of another stream is secured with a wait on the stream that is taking it
+        enable_cross_stream_reusing);
 
     // CUDA malloc/free is expensive so always use an arena
     return CreateAllocator(default_memory_info);
   }
 }
 
+AllocatorPtr CUDAExecutionProvider::CreateCudaMemPoolAllocator(OrtDevice::DeviceId device_id,
+                                                               size_t gpu_mem_limit,
+                                                               size_t release_threshold,
+                                                               OrtArenaCfg* default_memory_arena_cfg) {
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11020
+  // the memory limit of the arena config applies to the memory that is allocated from the pool
+  const size_t mem_limit = default_memory_arena_cfg && default_memory_arena_cfg->max_mem != 0
+                               ? default_memory_arena_cfg->max_mem
+                               : gpu_mem_limit;
+  AllocatorCreationInfo default_memory_info(
+      [mem_limit, release_threshold](OrtDevice::DeviceId id) {
+        return std::make_unique<CUDAMemPoolAllocator>(id, CUDA, mem_limit, release_threshold);
+      },
+      device_id,
+      // the pool does its own sub-allocation
+      false);
+
+  return CreateAllocator(default_memory_info);
+#else
+  ORT_UNUSED_PARAMETER(device_id);
+  ORT_UNUSED_PARAMETER(gpu_mem_limit);
+  ORT_UNUSED_PARAMETER(release_threshold);
+  ORT_UNUSED_PARAMETER(default_memory_arena_cfg);
+  ORT_THROW("The CUDA memory pool requires CUDA 11.2 or later.");
+#endif
+}
+
+AllocatorPtr CUDAExecutionProvider::CreateDefaultCudaAllocator(const CUDAExecutionProviderInfo& info) {
+  if (info.use_cuda_mem_pool) {
+    return CreateCudaMemPoolAllocator(info.device_id, info.gpu_mem_limit, info.cuda_mem_pool_release_threshold,
+                                      info.default_memory_arena_cfg);
+  }
+
+  // with several compute streams the chunks freed by one stream are reused by the others instead of growing the arena
+  return CreateCudaAllocator(info.device_id, info.gpu_mem_limit, info.arena_extend_strategy,
+                             info.external_allocator_info, info.default_memory_arena_cfg,
+                             info.max_compute_streams > 1);
+}
+
 CUDAExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId device_id, cudaStream_t stream, size_t /*gpu_mem_limit*/,
                                                           ArenaExtendStrategy /*arena_extend_strategy*/, CUDAExecutionProviderExternalAllocatorInfo /*external_allocator_info*/,
                                                           OrtArenaCfg* /*default_memory_arena_cfg*/) {
@@ -181,31 +223,54 @@ CUDAExecutionProvider::PerThreadContext::~PerThreadContext() {
 }
 
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+void CUDAExecutionProvider::PerThreadContext::SetMaxGraphs(size_t max_graphs) {
+  cuda_graph_.SetMaxGraphs(max_graphs);
+}
+
+void CUDAExecutionProvider::PerThreadContext::SetGraphCaptureKey(const CudaGraphKey_t& graph_key) {
+  graph_capture_key_ = graph_key;
+}
+
 bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptureAllowed() const {
-  return regular_run_count_before_graph_capture_ >= min_num_runs_before_cuda_graph_capture_;
+  if (graph_capture_key_.empty()) {
+    return false;
+  }
+  auto it = regular_run_counts_before_graph_capture_.find(graph_capture_key_);
+  return it != regular_run_counts_before_graph_capture_.end() &&
+         it->second >= min_num_runs_before_cuda_graph_capture_;
 }
 
 void CUDAExecutionProvider::PerThreadContext::CaptureBegin() {
-  cuda_graph_.Reset();
-  cuda_graph_.CaptureBegin();
+  cuda_graph_.CaptureBegin(graph_capture_key_);
 }
 
 void CUDAExecutionProvider::PerThreadContext::CaptureEnd() {
   cuda_graph_.CaptureEnd();
-  is_graph_captured_ = true;
+  // The warm-up runs are only counted until the graph is captured
+  regular_run_counts_before_graph_capture_.erase(graph_capture_key_);
+}
+
+bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptured(const CudaGraphKey_t& graph_key) const {
+  return cuda_graph_.IsCaptured(graph_key);
 }
 
 bool CUDAExecutionProvider::PerThreadContext::IsGraphCaptured() const {
-  return is_graph_captured_;
+  return !graph_capture_key_.empty() && IsGraphCaptured(graph_capture_key_);
+}
+
+Status CUDAExecutionProvider::PerThreadContext::ReplayGraph(const CudaGraphKey_t& graph_key) {
+  ORT_ENFORCE(IsGraphCaptured(graph_key));
+  return cuda_graph_.Replay(graph_key);
 }
 
 Status CUDAExecutionProvider::PerThreadContext::ReplayGraph() {
-  ORT_ENFORCE(IsGraphCaptured());
-  return cuda_graph_.Replay();
+  return ReplayGraph(graph_capture_key_);
 }
 
 void CUDAExecutionProvider::PerThreadContext::IncrementRegularRunCountBeforeGraphCapture() {
-  ++regular_run_count_before_graph_capture_;
+  if (!graph_capture_key_.empty()) {
+    ++regular_run_counts_before_graph_capture_[graph_capture_key_];
+  }
 }
 #endif
 
@@ -229,6 +294,11 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
 
   // This scenario is not supported.
   ORT_ENFORCE(!(info.has_user_compute_stream && info.external_allocator_info.UseExternalAllocator()));
+  ORT_ENFORCE(!(info.use_cuda_mem_pool && info.external_allocator_info.UseExternalAllocator()),
+              "The CUDA memory pool can not be used with an external allocator.");
+  // Allocations in a captured graph must not change between replays, which the memory pool does not guarantee.
+  ORT_ENFORCE(!(info.use_cuda_mem_pool && info.enable_cuda_graph),
+              "The CUDA memory pool can not be used with CUDA graph capture.");
 
   if (info.has_user_compute_stream) {
     external_stream_ = true;
@@ -253,9 +323,14 @@ CUDAExecutionProvider::CUDAExecutionProvider(const CUDAExecutionProviderInfo& in
   CUDA_CALL_THROW(cudaMemGetInfo(&free, &total));
 
   OverrideTunableOpInfoByEnv(info_);
+  LoadTuningResults();
+  LoadCudnnConvAlgoCache();
 }
 
 CUDAExecutionProvider::~CUDAExecutionProvider() {
+  SaveTuningResults();
+  SaveCudnnConvAlgoCache();
+
   // clean up thread local context caches
   {
     std::lock_guard<OrtMutex> lock(context_state_.mutex);
@@ -285,6 +360,96 @@ bool CUDAExecutionProvider::IsTunableOpEnabled() const {
   return info_.tunable_op.enabled;
 }
 
+tunable::TuningResults* CUDAExecutionProvider::GetTuningResults() const {
+  return info_.tunable_op.enabled || tuning_results_loaded_ ? &tuning_results_ : nullptr;
+}
+
+tunable::TuningResults::Validators CUDAExecutionProvider::GetTuningResultsValidators() const {
+  int runtime_version = 0;
+  CUDA_CALL_THROW(cudaRuntimeGetVersion(&runtime_version));
+  return {
+#ifdef ORT_VERSION
+      {"ORT_VERSION", ORT_VERSION},
+#endif
+      {"DEVICE", device_prop_.name},
+      {"SM", MakeString(device_prop_.major, device_prop_.minor)},
+      {"CUDA_RUNTIME_VERSION", std::to_string(runtime_version)},
+      {"CUBLASLT_VERSION", std::to_string(cublasLtGetVersion())},
+  };
+}
+
+void CUDAExecutionProvider::LoadTuningResults() {
+  const auto& path = info_.tunable_op.tuning_results_file;
+  if (path.empty() || !std::ifstream(path).good()) {
+    return;
+  }
+
+  auto status = tuning_results_.Load(path, GetTuningResultsValidators());
+  if (status.IsOK()) {
+    LOGS_DEFAULT(INFO) << "Loaded TunableOp tuning results from " << path;
+    tuning_results_loaded_ = true;
+  } else {
+    LOGS_DEFAULT(WARNING) << "Ignoring TunableOp tuning results: " << status.ErrorMessage();
+  }
+}
+
+void CUDAExecutionProvider::SaveTuningResults() {
+  const auto& path = info_.tunable_op.tuning_results_file;
+  if (path.empty() || !tuning_results_.IsModified()) {
+    return;
+  }
+
+  auto status = tuning_results_.Save(path, GetTuningResultsValidators());
+  if (status.IsOK()) {
+    LOGS_DEFAULT(INFO) << "Saved TunableOp tuning results to " << path;
+  } else {
+    LOGS_DEFAULT(WARNING) << "Failed to save TunableOp tuning results: " << status.ErrorMessage();
+  }
+}
+
+tunable::TuningResults* CUDAExecutionProvider::GetCudnnConvAlgoCache() const {
+  return info_.cudnn_conv_algo_cache_file.empty() ? nullptr : &cudnn_conv_algo_cache_;
+}
+
+tunable::TuningResults::Validators CUDAExecutionProvider::GetCudnnConvAlgoCacheValidators() const {
+  return {
+#ifdef ORT_VERSION
+      {"ORT_VERSION", ORT_VERSION},
+#endif
+      {"DEVICE", device_prop_.name},
+      {"SM", MakeString(device_prop_.major, device_prop_.minor)},
+      {"CUDNN_VERSION", std::to_string(cudnnGetVersion())},
+  };
+}
+
+void CUDAExecutionProvider::LoadCudnnConvAlgoCache() {
+  const auto& path = info_.cudnn_conv_algo_cache_file;
+  if (path.empty() || !std::ifstream(path).good()) {
+    return;
+  }
+
+  auto status = cudnn_conv_algo_cache_.Load(path, GetCudnnConvAlgoCacheValidators());
+  if (status.IsOK()) {
+    LOGS_DEFAULT(INFO) << "Loaded cuDNN conv algo cache from " << path;
+  } else {
+    LOGS_DEFAULT(WARNING) << "Ignoring cuDNN conv algo cache: " << status.ErrorMessage();
+  }
+}
+
+void CUDAExecutionProvider::SaveCudnnConvAlgoCache() {
+  const auto& path = info_.cudnn_conv_algo_cache_file;
+  if (path.empty() || !cudnn_conv_algo_cache_.IsModified()) {
+    return;
+  }
+
+  auto status = cudnn_conv_algo_cache_.Save(path, GetCudnnConvAlgoCacheValidators());
+  if (status.IsOK()) {
+    LOGS_DEFAULT(INFO) << "Saved cuDNN conv algo cache to " << path;
+  } else {
+    LOGS_DEFAULT(WARNING) << "Failed to save cuDNN conv algo cache: " << status.ErrorMessage();
+  }
+}
+
 std::unique_ptr<profiling::EpProfiler> CUDAExecutionProvider::GetProfiler() {
   return std::make_unique<profiling::CudaProfiler>();
 }
@@ -319,6 +484,9 @@ CUDAExecutionProvider::PerThreadContext& CUDAExecutionProvider::GetPerThreadCont
     if (context_state_.retired_context_pool.empty()) {
       context = std::make_shared<PerThreadContext>(info_.device_id, stream_, info_.gpu_mem_limit,
                                                    info_.arena_extend_strategy, info_.external_allocator_info, info_.default_memory_arena_cfg);
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+      context->SetMaxGraphs(static_cast<size_t>(info_.max_cuda_graphs));
+#endif
     } else {
       context = context_state_.retired_context_pool.back();
       context_state_.retired_context_pool.pop_back();
@@ -366,8 +534,7 @@ AllocatorPtr CUDAExecutionProvider::GetAllocator(int id, OrtMemType mem_type) co
       // which only happnens in some UTs.
       // here is a hack to return another allocator instance.
       // need to fix this in the future.
-      return CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
-                                 info_.external_allocator_info, info_.default_memory_arena_cfg);
+      return CreateDefaultCudaAllocator(info_);
     }
   }
 
@@ -427,12 +594,16 @@ bool CUDAExecutionProvider::IsGraphCaptureEnabled() const {
   return info_.enable_cuda_graph;
 }
 
-bool CUDAExecutionProvider::IsGraphCaptured() const {
-  return GetPerThreadContext().IsGraphCaptured();
+bool CUDAExecutionProvider::IsGraphCaptured(const std::string& graph_key) const {
+  return GetPerThreadContext().IsGraphCaptured(graph_key);
+}
+
+Status CUDAExecutionProvider::ReplayGraph(const std::string& graph_key) {
+  return GetPerThreadContext().ReplayGraph(graph_key);
 }
 
-Status CUDAExecutionProvider::ReplayGraph() {
-  return GetPerThreadContext().ReplayGraph();
+void CUDAExecutionProvider::SetGraphCaptureKey(const std::string& graph_key) {
+  GetPerThreadContext().SetGraphCaptureKey(graph_key);
 }
 #endif
 
@@ -440,6 +611,8 @@ namespace cuda {
 // opset 1 to 9
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyFromHost);
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyToHost);
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyFromHostBatch);
+class ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyToHostBatch);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 7, float, Cos);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 7, double, Cos);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 7, MLFloat16, Cos);
@@ -466,6 +639,7 @@ class ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kO
 class ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, 12, double, MatMul);
 class ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, 12, MLFloat16, MatMul);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, int8_t, MatMulInteger);
+class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, int8_t, QLinearMatMul);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, float, Elu);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, double, Elu);
 class ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, MLFloat16, Elu);
@@ -1320,6 +1494,8 @@ static Status RegisterCudaKernels(KernelRegistry& kernel_registry) {
       BuildKernelCreateInfo<void>,  // default entry to avoid the list become empty after ops-reducing
       BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyFromHost)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyToHost)>,
+      BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyFromHostBatch)>,
+      BuildKernelCreateInfo<ONNX_OPERATOR_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, MemcpyToHostBatch)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 4, 10, Concat)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, 10, Unsqueeze)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 1, 8, Flatten)>,
@@ -1346,6 +1522,7 @@ static Status RegisterCudaKernels(KernelRegistry& kernel_registry) {
       BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, 12, double, MatMul)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 9, 12, MLFloat16, MatMul)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, int8_t, MatMulInteger)>,
+      BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 10, int8_t, QLinearMatMul)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, 10, float, Clip)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, float, Elu)>,
       BuildKernelCreateInfo<ONNX_OPERATOR_TYPED_KERNEL_CLASS_NAME(kCudaExecutionProvider, kOnnxDomain, 6, double, Elu)>,
@@ -2198,6 +2375,8 @@ static Status RegisterCudaKernels(KernelRegistry& kernel_registry) {
     }
   }
 
+  ORT_RETURN_IF_ERROR(RegisterCudaNhwcKernels(kernel_registry));
+
 #ifndef DISABLE_CONTRIB_OPS
   ORT_RETURN_IF_ERROR(::onnxruntime::contrib::cuda::RegisterCudaContribKernels(kernel_registry));
 #endif
@@ -2351,6 +2530,24 @@ static bool CastNeedFallbackToCPU(const onnxruntime::Node& node) {
   return false;
 }
 
+static bool QLinearMatMulNeedFallbackToCPU(const onnxruntime::Node& node) {
+  // the CUDA kernel only supports a per tensor weight scale and zero point
+  auto input_defs = node.InputDefs();
+  for (int i : {4, 5}) {
+    const auto* shape = input_defs.at(i)->Shape();
+    if (shape == nullptr) {
+      return true;
+    }
+    for (int d = 0; d < shape->dim_size(); d++) {
+      if (!shape->dim(d).has_dim_value() || shape->dim(d).dim_value() != 1) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
 std::unique_ptr<onnxruntime::IDataTransfer> CUDAExecutionProvider::GetDataTransfer() const {
   return std::make_unique<onnxruntime::GPUDataTransfer>();
 }
@@ -2365,7 +2562,7 @@ CUDAExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph,
       continue;
 
     const auto& node = *p_node;
-    if (!node.GetExecutionProviderType().empty()) {
+    if (!node.GetExecutionProviderType().empty() && node.GetExecutionProviderType() != Type()) {
       continue;
     }
 
@@ -2376,6 +2573,13 @@ CUDAExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph,
       continue;
     }
 
+    // The nodes assigned in the first call are requested again in the second call that follows the layout
+    // transformation when the NHWC layout is preferred, which includes the nodes converted to the NHWC domain.
+    if (node.GetExecutionProviderType() == Type()) {
+      candidates.push_back(node.Index());
+      continue;
+    }
+
     bool not_supported = false;
     bool force_inside = false;  // for some compute heavy ops, we'll force it to run inside CUDA
     if ("LSTM" == node.OpType()) {
@@ -2397,6 +2601,8 @@ CUDAExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph,
     } else if ("Cast" == node.OpType()) {
       not_supported = CastNeedFallbackToCPU(node);
       // cast is not compute heavy, and may be placed outside
+    } else if ("QLinearMatMul" == node.OpType()) {
+      not_supported = QLinearMatMulNeedFallbackToCPU(node);
     }
 
     if (!force_inside && not_supported) {
@@ -2414,7 +2620,7 @@ CUDAExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph,
   auto cpu_nodes = GetCpuPreferredNodes(graph, kernel_lookup, candidates);
   std::vector<std::unique_ptr<ComputeCapability>> result;
   for (auto& node_index : candidates) {
-    if (cpu_nodes.count(node_index) > 0)
+    if (cpu_nodes.count(node_index) > 0 && graph.GetNode(node_index)->GetExecutionProviderType() != Type())
       continue;
 
     auto sub_graph = IndexedSubGraph::Create();
@@ -2431,6 +2637,24 @@ CUDAExecutionProvider::GetCapability(const onnxruntime::GraphViewer& graph,
   return result;
 }
 
+DataLayout CUDAExecutionProvider::GetPreferredLayout() const {
+  return info_.prefer_nhwc ? DataLayout::NHWC : DataLayout::NCHW;
+}
+
+bool CUDAExecutionProvider::ShouldConvertDataLayoutForOp(std::string_view node_domain,
+                                                         std::string_view node_op_type) const {
+  // The ops that have kernels in the kMSInternalNHWCDomain.
+  static const std::unordered_set<std::string_view> cuda_nhwc_ops = {
+      "BatchNormalization", "Conv", "ConvTranspose", "AveragePool", "GlobalAveragePool", "MaxPool", "GlobalMaxPool"};
+
+  return node_domain == kOnnxDomain && cuda_nhwc_ops.count(node_op_type) != 0;
+}
+
+int CUDAExecutionProvider::GetMaxComputeStreams() const {
+  // all the work stays on the one stream of a user compute stream or a captured graph
+  return use_ep_level_unified_stream_ ? 1 : info_.max_compute_streams;
+}
+
 void CUDAExecutionProvider::RegisterAllocator(AllocatorManager& allocator_manager) {
   OrtDevice cuda_device{OrtDevice::GPU, OrtDevice::MemType::DEFAULT, info_.device_id};
   OrtDevice pinned_device{OrtDevice::CPU, OrtDevice::MemType::CUDA_PINNED, DEFAULT_CPU_ALLOCATOR_DEVICE_ID};
@@ -2446,8 +2670,7 @@ void CUDAExecutionProvider::RegisterAllocator(AllocatorManager& allocator_manage
     cuda_alloc = allocator_manager.GetAllocator(OrtMemTypeDefault, cuda_device);
 
     if (!cuda_alloc) {
-      cuda_alloc = CreateCudaAllocator(info_.device_id, info_.gpu_mem_limit, info_.arena_extend_strategy,
-                                       info_.external_allocator_info, info_.default_memory_arena_cfg);
+      cuda_alloc = CreateDefaultCudaAllocator(info_);
       // enable sharing of our allocator
       allocator_manager.InsertAllocator(cuda_alloc);
     }
@@ -2511,6 +2734,8 @@ void CUDAExecutionProvider::RegisterStreamHandlers(IStreamCommandHandleRegistry&
   // This allocator must be the same to the allocator
   // used in AllocateBufferOnCPUPinned.
   auto allocator = GetAllocator(DEFAULT_CPU_ALLOCATOR_DEVICE_ID, OrtMemTypeCPU);
+  // the copies of a captured graph must stay on the captured stream, and their staging buffers have to outlive the run
+  const bool use_copy_streams = !info_.do_copy_in_default_stream && !IsGraphCaptureEnabled();
   if (use_ep_level_unified_stream_)
     RegisterCudaStreamHandles(stream_handle_registry,
                               OrtDevice::GPU,
@@ -2519,7 +2744,8 @@ void CUDAExecutionProvider::RegisterStreamHandlers(IStreamCommandHandleRegistry&
                               stream_,
                               use_ep_level_unified_stream_,
                               GetPerThreadContext().CudnnHandle(),
-                              GetPerThreadContext().CublasHandle());
+                              GetPerThreadContext().CublasHandle(),
+                              use_copy_streams);
   else
     RegisterCudaStreamHandles(stream_handle_registry,
                               OrtDevice::GPU,
@@ -2528,7 +2754,8 @@ void CUDAExecutionProvider::RegisterStreamHandlers(IStreamCommandHandleRegistry&
                               stream_,
                               use_ep_level_unified_stream_,
                               GetPerThreadContext().CudnnHandle(),
-                              GetPerThreadContext().CublasHandle());
+                              GetPerThreadContext().CublasHandle(),
+                              use_copy_streams);
 }
 
 }  // namespace onnxruntime
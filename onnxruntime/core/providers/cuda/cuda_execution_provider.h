@@ -9,6 +9,7 @@
 #include "core/framework/allocatormgr.h"
 #include "core/framework/arena_extend_strategy.h"
 #include "core/framework/execution_provider.h"
+#include "core/framework/tunable.h"
 #include "core/platform/ort_mutex.h"
 #include "core/providers/cuda/cuda_execution_provider_info.h"
 #include "core/providers/cuda/cuda_graph.h"
@@ -96,30 +97,55 @@ class CUDAExecutionProvider : public IExecutionProvider {
   bool GetCudnnConvUseMaxWorkspace() const { return info_.cudnn_conv_use_max_workspace; }
   bool GetCudnnConv1dPadToNc1d() const { return info_.cudnn_conv1d_pad_to_nc1d; }
 
+  DataLayout GetPreferredLayout() const override;
+  bool ShouldConvertDataLayoutForOp(std::string_view node_domain, std::string_view node_op_type) const override;
+  int GetMaxComputeStreams() const override;
+
   ProviderOptions GetProviderOptions() const override {
     return CUDAExecutionProviderInfo::ToProviderOptions(info_);
   }
 
   void RegisterAllocator(AllocatorManager& allocator_manager) override;
   static AllocatorPtr CreateCudaAllocator(OrtDevice::DeviceId device_id, size_t cuda_mem_limit, ArenaExtendStrategy arena_extend_strategy,
-                                          CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg);
+                                          CUDAExecutionProviderExternalAllocatorInfo external_alloc_info, OrtArenaCfg* arena_cfg,
+                                          bool enable_cross_stream_reusing = false);
+  static AllocatorPtr CreateCudaMemPoolAllocator(OrtDevice::DeviceId device_id, size_t cuda_mem_limit, size_t release_threshold,
+                                                 OrtArenaCfg* arena_cfg);
+  // Creates the allocator for OrtMemTypeDefault that is selected by `info`
+  static AllocatorPtr CreateDefaultCudaAllocator(const CUDAExecutionProviderInfo& info);
 
   void EnableTunableOp();
   void DisableTunableOp();
   bool IsTunableOpEnabled() const;
+  // The results shared by the TunableOps of the provider, nullptr if TunableOp is disabled and no results were loaded.
+  tunable::TuningResults* GetTuningResults() const;
+
+  // The cuDNN conv algos that persist across sessions in the cudnn_conv_algo_cache_file, nullptr if it is not set.
+  tunable::TuningResults* GetCudnnConvAlgoCache() const;
 
   std::unique_ptr<profiling::EpProfiler> GetProfiler() override;
 
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
   bool IsGraphCaptureEnabled() const override;
-  bool IsGraphCaptured() const override;
-  Status ReplayGraph() override;
+  bool IsGraphCaptured(const std::string& graph_key) const override;
+  Status ReplayGraph(const std::string& graph_key) override;
+  void SetGraphCaptureKey(const std::string& graph_key) override;
 #endif
   void RegisterStreamHandlers(IStreamCommandHandleRegistry& stream_handle_registry) const override;
 
  private:
+  tunable::TuningResults::Validators GetTuningResultsValidators() const;
+  void LoadTuningResults();
+  void SaveTuningResults();
+  tunable::TuningResults::Validators GetCudnnConvAlgoCacheValidators() const;
+  void LoadCudnnConvAlgoCache();
+  void SaveCudnnConvAlgoCache();
+
   CUDAExecutionProviderInfo info_;
   cudaDeviceProp device_prop_;
+  mutable tunable::TuningResults tuning_results_;
+  bool tuning_results_loaded_ = false;
+  mutable tunable::TuningResults cudnn_conv_algo_cache_;
   bool external_stream_ = false;
   // only used when set user external stream or cuda graph
   cudaStream_t stream_ = nullptr;
@@ -172,10 +198,14 @@ class CUDAExecutionProvider : public IExecutionProvider {
     }
 
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+    void SetMaxGraphs(size_t max_graphs);
+    void SetGraphCaptureKey(const CudaGraphKey_t& graph_key);
     bool IsGraphCaptureAllowed() const;
     void CaptureBegin();
     void CaptureEnd();
+    bool IsGraphCaptured(const CudaGraphKey_t& graph_key) const;
     bool IsGraphCaptured() const;
+    Status ReplayGraph(const CudaGraphKey_t& graph_key);
     Status ReplayGraph();
     void IncrementRegularRunCountBeforeGraphCapture();
 #endif
@@ -191,11 +221,12 @@ class CUDAExecutionProvider : public IExecutionProvider {
     std::unique_ptr<cuda::IConstantBuffer<BFloat16>> constant_ones_bfloat16_;
 
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
-    // Cuda graph with multi threads will be supported in the future, so cuda_graph_
+    // The graphs are captured with the cuBLAS and cuDNN handles of this thread, so cuda_graph_
     // is put under PerThreadContext.
     CUDAGraph cuda_graph_;
-    bool is_graph_captured_ = false;
-    int regular_run_count_before_graph_capture_ = 0;
+    // Graph captured by the current run, empty if the run does not capture a graph.
+    CudaGraphKey_t graph_capture_key_;
+    std::unordered_map<CudaGraphKey_t, int> regular_run_counts_before_graph_capture_;
     const int min_num_runs_before_cuda_graph_capture_ = 1;  // required min regular runs before graph capture for the necessary memory allocations.
 
 #endif
@@ -16,6 +16,8 @@ namespace provider_option_names {
 constexpr const char* kDeviceId = "device_id";
 constexpr const char* kMemLimit = "gpu_mem_limit";
 constexpr const char* kArenaExtendStrategy = "arena_extend_strategy";
+constexpr const char* kUseCudaMemPool = "use_cuda_mem_pool";
+constexpr const char* kCudaMemPoolReleaseThreshold = "cuda_mem_pool_release_threshold";
 constexpr const char* kCudnnConvAlgoSearch = "cudnn_conv_algo_search";
 constexpr const char* kDoCopyInDefaultStream = "do_copy_in_default_stream";
 constexpr const char* kGpuExternalAlloc = "gpu_external_alloc";
@@ -23,8 +25,13 @@ constexpr const char* kGpuExternalFree = "gpu_external_free";
 constexpr const char* kGpuExternalEmptyCache = "gpu_external_empty_cache";
 constexpr const char* kCudnnConvUseMaxWorkspace = "cudnn_conv_use_max_workspace";
 constexpr const char* kEnableCudaGraph = "enable_cuda_graph";
+constexpr const char* kMaxCudaGraphs = "max_cuda_graphs";
 constexpr const char* kCudnnConv1dPadToNc1d = "cudnn_conv1d_pad_to_nc1d";
 constexpr const char* kTunableOpEnabled = "tunable_op_enabled";
+constexpr const char* kTunableOpTuningResultsFile = "tunable_op_tuning_results_file";
+constexpr const char* kCudnnConvAlgoCacheFile = "cudnn_conv_algo_cache_file";
+constexpr const char* kPreferNHWC = "prefer_nhwc";
+constexpr const char* kMaxComputeStreams = "max_compute_streams";
 }  // namespace provider_option_names
 }  // namespace cuda
 
@@ -86,12 +93,23 @@ CUDAExecutionProviderInfo CUDAExecutionProviderInfo::FromProviderOptions(const P
           .AddAssignmentToEnumReference(
               cuda::provider_option_names::kArenaExtendStrategy,
               arena_extend_strategy_mapping, info.arena_extend_strategy)
+          .AddAssignmentToReference(cuda::provider_option_names::kUseCudaMemPool, info.use_cuda_mem_pool)
+          .AddAssignmentToReference(cuda::provider_option_names::kCudaMemPoolReleaseThreshold,
+                                    info.cuda_mem_pool_release_threshold)
           .AddAssignmentToEnumReference(
               cuda::provider_option_names::kCudnnConvAlgoSearch,
               ort_cudnn_conv_algo_search_mapping, info.cudnn_conv_algo_search)
           .AddAssignmentToReference(cuda::provider_option_names::kDoCopyInDefaultStream, info.do_copy_in_default_stream)
           .AddAssignmentToReference(cuda::provider_option_names::kCudnnConvUseMaxWorkspace, info.cudnn_conv_use_max_workspace)
           .AddAssignmentToReference(cuda::provider_option_names::kEnableCudaGraph, info.enable_cuda_graph)
+          .AddValueParser(
+              cuda::provider_option_names::kMaxCudaGraphs,
+              [&info](const std::string& value_str) -> Status {
+                ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(value_str, info.max_cuda_graphs));
+                ORT_RETURN_IF_NOT(info.max_cuda_graphs > 0, "Invalid max_cuda_graphs: ", info.max_cuda_graphs,
+                                  ", must be positive.");
+                return Status::OK();
+              })
           .AddAssignmentToReference(cuda::provider_option_names::kCudnnConv1dPadToNc1d, info.cudnn_conv1d_pad_to_nc1d)
           .AddValueParser(
               cuda::provider_option_names::kTunableOpEnabled,
@@ -99,6 +117,19 @@ CUDAExecutionProviderInfo CUDAExecutionProviderInfo::FromProviderOptions(const P
                 ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(value_str, info.tunable_op.enabled));
                 return Status::OK();
               })
+          .AddAssignmentToReference(cuda::provider_option_names::kTunableOpTuningResultsFile,
+                                    info.tunable_op.tuning_results_file)
+          .AddAssignmentToReference(cuda::provider_option_names::kCudnnConvAlgoCacheFile,
+                                    info.cudnn_conv_algo_cache_file)
+          .AddAssignmentToReference(cuda::provider_option_names::kPreferNHWC, info.prefer_nhwc)
+          .AddValueParser(
+              cuda::provider_option_names::kMaxComputeStreams,
+              [&info](const std::string& value_str) -> Status {
+                ORT_RETURN_IF_ERROR(ParseStringWithClassicLocale(value_str, info.max_compute_streams));
+                ORT_RETURN_IF_NOT(info.max_compute_streams > 0, "max_compute_streams must be positive, got ",
+                                  info.max_compute_streams);
+                return Status::OK();
+              })
           .Parse(options));
 
   CUDAExecutionProviderExternalAllocatorInfo alloc_info{alloc, free, empty_cache};
@@ -115,13 +146,21 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const CUDAExecution
       {cuda::provider_option_names::kGpuExternalEmptyCache, MakeStringWithClassicLocale(reinterpret_cast<size_t>(info.external_allocator_info.empty_cache))},
       {cuda::provider_option_names::kArenaExtendStrategy,
        EnumToName(arena_extend_strategy_mapping, info.arena_extend_strategy)},
+      {cuda::provider_option_names::kUseCudaMemPool, MakeStringWithClassicLocale(info.use_cuda_mem_pool)},
+      {cuda::provider_option_names::kCudaMemPoolReleaseThreshold,
+       MakeStringWithClassicLocale(info.cuda_mem_pool_release_threshold)},
       {cuda::provider_option_names::kCudnnConvAlgoSearch,
        EnumToName(ort_cudnn_conv_algo_search_mapping, info.cudnn_conv_algo_search)},
       {cuda::provider_option_names::kDoCopyInDefaultStream, MakeStringWithClassicLocale(info.do_copy_in_default_stream)},
       {cuda::provider_option_names::kCudnnConvUseMaxWorkspace, MakeStringWithClassicLocale(info.cudnn_conv_use_max_workspace)},
       {cuda::provider_option_names::kEnableCudaGraph, MakeStringWithClassicLocale(info.enable_cuda_graph)},
+      {cuda::provider_option_names::kMaxCudaGraphs, MakeStringWithClassicLocale(info.max_cuda_graphs)},
       {cuda::provider_option_names::kCudnnConv1dPadToNc1d, MakeStringWithClassicLocale(info.cudnn_conv1d_pad_to_nc1d)},
       {cuda::provider_option_names::kTunableOpEnabled, MakeStringWithClassicLocale(info.tunable_op.enabled)},
+      {cuda::provider_option_names::kTunableOpTuningResultsFile, info.tunable_op.tuning_results_file},
+      {cuda::provider_option_names::kCudnnConvAlgoCacheFile, info.cudnn_conv_algo_cache_file},
+      {cuda::provider_option_names::kPreferNHWC, MakeStringWithClassicLocale(info.prefer_nhwc)},
+      {cuda::provider_option_names::kMaxComputeStreams, MakeStringWithClassicLocale(info.max_compute_streams)},
   };
 
   return options;
@@ -132,10 +171,19 @@ ProviderOptions CUDAExecutionProviderInfo::ToProviderOptions(const OrtCUDAProvid
       {cuda::provider_option_names::kDeviceId, MakeStringWithClassicLocale(info.device_id)},
       {cuda::provider_option_names::kMemLimit, MakeStringWithClassicLocale(info.gpu_mem_limit)},
       {cuda::provider_option_names::kArenaExtendStrategy, EnumToName(arena_extend_strategy_mapping, info.arena_extend_strategy)},
+      {cuda::provider_option_names::kUseCudaMemPool, MakeStringWithClassicLocale(info.use_cuda_mem_pool)},
+      {cuda::provider_option_names::kCudaMemPoolReleaseThreshold, MakeStringWithClassicLocale(info.cuda_mem_pool_release_threshold)},
       {cuda::provider_option_names::kCudnnConvAlgoSearch, EnumToName(ort_cudnn_conv_algo_search_mapping, info.cudnn_conv_algo_search)},
       {cuda::provider_option_names::kDoCopyInDefaultStream, MakeStringWithClassicLocale(info.do_copy_in_default_stream)},
       {cuda::provider_option_names::kCudnnConvUseMaxWorkspace, MakeStringWithClassicLocale(info.cudnn_conv_use_max_workspace)},
-      {cuda::provider_option_names::kCudnnConv1dPadToNc1d, MakeStringWithClassicLocale(info.cudnn_conv1d_pad_to_nc1d)}
+      {cuda::provider_option_names::kCudnnConv1dPadToNc1d, MakeStringWithClassicLocale(info.cudnn_conv1d_pad_to_nc1d)},
+      {cuda::provider_option_names::kTunableOpEnabled, MakeStringWithClassicLocale(info.tunable_op_enabled)},
+      {cuda::provider_option_names::kTunableOpTuningResultsFile,
+       info.tunable_op_tuning_results_file != nullptr ? info.tunable_op_tuning_results_file : ""},
+      {cuda::provider_option_names::kCudnnConvAlgoCacheFile,
+       info.cudnn_conv_algo_cache_file != nullptr ? info.cudnn_conv_algo_cache_file : ""},
+      {cuda::provider_option_names::kPreferNHWC, MakeStringWithClassicLocale(info.prefer_nhwc)},
+      {cuda::provider_option_names::kMaxComputeStreams, MakeStringWithClassicLocale(info.max_compute_streams)}
   };
 
   return options;
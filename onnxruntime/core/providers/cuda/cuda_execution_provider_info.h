@@ -5,6 +5,7 @@
 
 #include <functional>
 #include <limits>
+#include <string>
 
 #include "core/common/hash_combine.h"
 #include "core/framework/arena_extend_strategy.h"
@@ -39,6 +40,9 @@ struct CUDAExecutionProviderExternalAllocatorInfo {
 namespace cuda {
 struct TunableOpInfo {
   bool enabled{false};
+  // If set, the tuning results are loaded from the file when the provider is created, and the results of the
+  // tuning are saved to it when the provider is destroyed.
+  std::string tuning_results_file{};
 };
 }  // namespace cuda
 
@@ -47,6 +51,8 @@ struct CUDAExecutionProviderInfo {
   size_t gpu_mem_limit{std::numeric_limits<size_t>::max()};                         // Will be over-ridden by contents of `default_memory_arena_cfg` (if specified)
   ArenaExtendStrategy arena_extend_strategy{ArenaExtendStrategy::kNextPowerOfTwo};  // Will be over-ridden by contents of `default_memory_arena_cfg` (if specified)
   OrtCudnnConvAlgoSearch cudnn_conv_algo_search{OrtCudnnConvAlgoSearchExhaustive};
+  // If set to false, the copies between host and device run on dedicated copy streams with pinned staging buffers
+  // instead of the compute stream. It is ignored when CUDA graph capture is enabled.
   bool do_copy_in_default_stream{true};
   bool has_user_compute_stream{false};
   void* user_compute_stream{nullptr};
@@ -57,17 +63,39 @@ struct CUDAExecutionProviderInfo {
   OrtArenaCfg* default_memory_arena_cfg{nullptr};
   CUDAExecutionProviderExternalAllocatorInfo external_allocator_info{};
 
+  // If set, allocate the device memory from the CUDA memory pool of the device instead of an arena.
+  // The memory limit given by `gpu_mem_limit` or `default_memory_arena_cfg` still applies.
+  bool use_cuda_mem_pool{false};
+  // Bytes of unused memory the CUDA memory pool keeps when a stream synchronizes, the rest is released.
+  size_t cuda_mem_pool_release_threshold{std::numeric_limits<size_t>::max()};
+
   // By default, try to use as much as possible memory for algo search.
   // If set to false, use fix workspace size (32M) for Conv algo search, the final algo might not be the best.
   bool cudnn_conv_use_max_workspace{true};
 
   bool enable_cuda_graph{false};
 
+  // Maximum number of CUDA graphs kept per thread, the least recently used graph is destroyed beyond it.
+  int max_cuda_graphs{8};
+
   // By default, for Conv1D, will pad [N,C,D] to [N,C,D,1], if turn on, will pad to [N,C,1,D].
   bool cudnn_conv1d_pad_to_nc1d{false};
 
   cuda::TunableOpInfo tunable_op{};
 
+  // If set, the cuDNN conv algos found by the exhaustive search are loaded from the file when the provider is created
+  // and the algos found for new convolutions are saved to it when the provider is destroyed.
+  std::string cudnn_conv_algo_cache_file{};
+
+  // If set, the provider prefers the NHWC layout and the layout transformer converts the Conv, ConvTranspose,
+  // pooling and BatchNormalization nodes it runs to their NHWC kernels, which use the cuDNN channels last formats.
+  bool prefer_nhwc{false};
+
+  // The maximum number of CUDA compute streams per session. If it is larger than 1, the independent branches of the
+  // graph are placed on separate streams that synchronize with events, so that their kernels overlap on the GPU.
+  // It has no effect when all work has to stay on one stream, i.e. with a user compute stream or CUDA graph capture.
+  int max_compute_streams{1};
+
   static CUDAExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
   static ProviderOptions ToProviderOptions(const CUDAExecutionProviderInfo& info);
   static ProviderOptions ToProviderOptions(const OrtCUDAProviderOptionsV2& info);
@@ -79,6 +107,7 @@ struct std::hash<::onnxruntime::cuda::TunableOpInfo> {
   size_t operator()(const ::onnxruntime::cuda::TunableOpInfo& info) const {
     size_t seed_and_value{0xbc9f1d34};
     onnxruntime::HashCombine(info.enabled, seed_and_value);
+    onnxruntime::HashCombine(info.tuning_results_file, seed_and_value);
     return seed_and_value;
   }
 };
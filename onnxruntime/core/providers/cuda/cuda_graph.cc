@@ -20,48 +20,84 @@ void CUDAGraph::SetStream(cudaStream_t stream) {
   stream_ = stream;
 }
 
-void CUDAGraph::CaptureBegin() {
+void CUDAGraph::SetMaxGraphs(size_t max_graphs) {
+  ORT_ENFORCE(max_graphs > 0, "At least one CUDA graph must be kept.");
+  max_graphs_ = max_graphs;
+}
+
+void CUDAGraph::CaptureBegin(const CudaGraphKey_t& key) {
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
-  ORT_ENFORCE(!has_graph_exec_,
-              "This cuda graph has already captured a graph. "
-              "Create a new instance to capture a new graph.");
+  ORT_ENFORCE(!IsCaptured(key),
+              "This cuda graph has already captured a graph for this key. "
+              "Replay it instead of capturing a new graph.");
+  ORT_ENFORCE(!is_capturing_, "A cuda graph is already being captured.");
 
   CUDA_CALL_THROW(cudaStreamSynchronize(stream_));
-  // For now cuda graph can only work with a single thread. In the future, we
-  // will support multiple threads. For multiple threads with multiple graphs
-  // and streams, `cudaStreamCaptureModeGlobal` needs to be changed to
-  // `cudaStreamCaptureModeThreadLocal`
-  CUDA_CALL_THROW(cudaStreamBeginCapture(stream_, cudaStreamCaptureModeGlobal));
+  // The runs that capture and replay the graphs on this stream are serialized by the session. The thread local
+  // mode keeps the capture from failing on unrelated CUDA calls of other threads, e.g. of other sessions.
+  CUDA_CALL_THROW(cudaStreamBeginCapture(stream_, cudaStreamCaptureModeThreadLocal));
+  capture_key_ = key;
+  is_capturing_ = true;
 #else
+  ORT_UNUSED_PARAMETER(key);
   ORT_THROW("CUDA graphs can only be used in Onnxruntime built with CUDA >= 10.0");
 #endif
 }
 
 void CUDAGraph::CaptureEnd() {
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
-  CUDA_CALL_THROW(cudaStreamEndCapture(stream_, &graph_));
-  if (graph_ == NULL) {
-    ORT_THROW("CUDAGraph::CaptureEnd: graph_ is NULL");
+  ORT_ENFORCE(is_capturing_, "CUDAGraph::CaptureEnd: no graph is being captured");
+  is_capturing_ = false;
+
+  cudaGraph_t graph = NULL;
+  CUDA_CALL_THROW(cudaStreamEndCapture(stream_, &graph));
+  if (graph == NULL) {
+    ORT_THROW("CUDAGraph::CaptureEnd: graph is NULL");
   }
 
-  has_graph_ = true;
-  CUDA_CALL_THROW(cudaGraphInstantiate(&graph_exec_, graph_, NULL, NULL, 0));
-  has_graph_exec_ = true;
-  CUDA_CALL_THROW(cudaGraphDestroy(graph_));
-  has_graph_ = false;
+  cudaGraphExec_t graph_exec = NULL;
+  const auto instantiate_result = cudaGraphInstantiate(&graph_exec, graph, NULL, NULL, 0);
+  CUDA_CALL_THROW(cudaGraphDestroy(graph));
+  CUDA_CALL_THROW(instantiate_result);
+
+  // Make room for the new graph by destroying the least recently used ones
+  while (graph_execs_.size() >= max_graphs_) {
+    CUDA_CALL_THROW(cudaGraphExecDestroy(graph_execs_.back().second));
+    graph_exec_lookup_.erase(graph_execs_.back().first);
+    graph_execs_.pop_back();
+  }
+
+  graph_execs_.emplace_front(capture_key_, graph_exec);
+  graph_exec_lookup_[capture_key_] = graph_execs_.begin();
 #else
   ORT_THROW("CUDA graphs can only be used in Onnxruntime built with CUDA >= 10.0");
 #endif
 }
 
-Status CUDAGraph::Replay() {
+bool CUDAGraph::IsCaptured(const CudaGraphKey_t& key) const {
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
+  return graph_exec_lookup_.find(key) != graph_exec_lookup_.end();
+#else
+  ORT_UNUSED_PARAMETER(key);
+  return false;
+#endif
+}
+
+Status CUDAGraph::Replay(const CudaGraphKey_t& key) {
   // Although this function is not thread safe, the lock is not needed here because
-  // CUDA EP maintains a separate cuda graph per thread
+  // the session serializes the runs that capture and replay graphs
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
-  LOGS_DEFAULT(INFO) << "Replaying CUDA graph on stream " << stream_;
-  CUDA_RETURN_IF_ERROR(cudaGraphLaunch(graph_exec_, stream_));
+  auto it = graph_exec_lookup_.find(key);
+  ORT_RETURN_IF(it == graph_exec_lookup_.end(), "No CUDA graph has been captured for key ", key);
+
+  // Keep the most recently used graph at the front
+  graph_execs_.splice(graph_execs_.begin(), graph_execs_, it->second);
+
+  LOGS_DEFAULT(INFO) << "Replaying CUDA graph " << key << " on stream " << stream_;
+  CUDA_RETURN_IF_ERROR(cudaGraphLaunch(it->second->second, stream_));
   CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(stream_));
 #else
+  ORT_UNUSED_PARAMETER(key);
   ORT_THROW("CUDA graphs can only be used in Onnxruntime built with CUDA >= 10.0");
 #endif
   return Status::OK();
@@ -69,14 +105,11 @@ Status CUDAGraph::Replay() {
 
 void CUDAGraph::Reset() {
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
-  if (has_graph_) {
-    CUDA_CALL_THROW(cudaGraphDestroy(graph_));
-    has_graph_ = false;
-  }
-  if (has_graph_exec_) {
-    CUDA_CALL_THROW(cudaGraphExecDestroy(graph_exec_));
-    has_graph_exec_ = false;
+  for (auto& graph_exec : graph_execs_) {
+    CUDA_CALL_THROW(cudaGraphExecDestroy(graph_exec.second));
   }
+  graph_execs_.clear();
+  graph_exec_lookup_.clear();
 #else
   ORT_THROW("CUDA graphs can only be used in Onnxruntime built with CUDA >= 10.0");
 #endif
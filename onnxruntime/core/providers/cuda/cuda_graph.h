@@ -3,6 +3,11 @@
 
 #pragma once
 
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
 #include "core/common/common.h"
 #include "core/platform/ort_mutex.h"
 #include "core/providers/cuda/cuda_pch.h"
@@ -11,25 +16,36 @@ namespace onnxruntime {
 
 using CaptureId_t = unsigned long long;
 
+// Identifies one of the graphs captured on a stream
+using CudaGraphKey_t = std::string;
+
+// The graphs captured on a stream. Up to a maximum number of graphs are kept, the least recently used graph
+// is destroyed to make room for a new one.
 struct CUDAGraph {
   CUDAGraph() {};
   CUDAGraph(cudaStream_t stream);
   ~CUDAGraph();
 
   void SetStream(cudaStream_t stream);
-  void CaptureBegin();
+  void SetMaxGraphs(size_t max_graphs);
+  void CaptureBegin(const CudaGraphKey_t& key);
   void CaptureEnd();
-  Status Replay();
+  bool IsCaptured(const CudaGraphKey_t& key) const;
+  Status Replay(const CudaGraphKey_t& key);
   void Reset();
 
 private:
 #if defined(CUDA_VERSION) && CUDA_VERSION >= 10000
-  cudaGraph_t graph_ = NULL;
-  cudaGraphExec_t graph_exec_ = NULL;
+  using GraphList = std::list<std::pair<CudaGraphKey_t, cudaGraphExec_t>>;
+
+  // Instantiated graphs, the most recently used first
+  GraphList graph_execs_;
+  std::unordered_map<CudaGraphKey_t, GraphList::iterator> graph_exec_lookup_;
 #endif
 
-  bool has_graph_ = false;
-  bool has_graph_exec_ = false;
+  CudaGraphKey_t capture_key_;
+  bool is_capturing_ = false;
+  size_t max_graphs_ = 1;
 
   cudaStream_t stream_ = nullptr; // Does not own the stream
 };
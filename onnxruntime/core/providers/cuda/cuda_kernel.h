@@ -89,6 +89,8 @@ class CudaKernel : public OpKernel {
 
   bool IsTunableOpEnabled() const { return provider_->IsTunableOpEnabled(); }
 
+  ::onnxruntime::tunable::TuningResults* GetTuningResults() const { return provider_->GetTuningResults(); }
+
   // To support cudaMemcpyAsync, the cpu memory should be allocated in pinned memory
   // and it can only be released after the copy has finished
   template <typename T>
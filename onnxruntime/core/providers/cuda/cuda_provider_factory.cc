@@ -6,6 +6,7 @@
 #include "core/providers/cuda/cuda_provider_factory_creator.h"
 #include "core/providers/cuda/cuda_provider_options.h"
 
+#include <algorithm>
 #include <memory>
 #include <chrono>
 
@@ -202,6 +203,10 @@ struct ProviderInfo_CUDA_Impl : ProviderInfo_CUDA {
       return false;
     }
 
+    if (!onnxruntime::cuda::test::TestPagedKVCache()) {
+      return false;
+    }
+
     // TODO(wechi): brings disabled tests in onnxruntime/test/providers/cuda/*
     // back alive here.
     return true;
@@ -245,8 +250,17 @@ struct CUDA_Provider : Provider {
     info.default_memory_arena_cfg = params->default_memory_arena_cfg;
     info.cudnn_conv_use_max_workspace = params->cudnn_conv_use_max_workspace != 0;
     info.enable_cuda_graph = params->enable_cuda_graph != 0;
+    info.max_cuda_graphs = params->max_cuda_graphs;
+    info.use_cuda_mem_pool = params->use_cuda_mem_pool != 0;
+    info.cuda_mem_pool_release_threshold = params->cuda_mem_pool_release_threshold;
     info.cudnn_conv1d_pad_to_nc1d = params->cudnn_conv1d_pad_to_nc1d != 0;
     info.tunable_op.enabled = params->tunable_op_enabled;
+    info.tunable_op.tuning_results_file =
+        params->tunable_op_tuning_results_file == nullptr ? "" : params->tunable_op_tuning_results_file;
+    info.cudnn_conv_algo_cache_file =
+        params->cudnn_conv_algo_cache_file == nullptr ? "" : params->cudnn_conv_algo_cache_file;
+    info.prefer_nhwc = params->prefer_nhwc != 0;
+    info.max_compute_streams = std::max(params->max_compute_streams, 1);
 
     return std::make_shared<CUDAProviderFactory>(info);
   }
@@ -265,7 +279,27 @@ struct CUDA_Provider : Provider {
     cuda_options.default_memory_arena_cfg = internal_options.default_memory_arena_cfg;
     cuda_options.cudnn_conv_use_max_workspace = internal_options.cudnn_conv_use_max_workspace;
     cuda_options.enable_cuda_graph = internal_options.enable_cuda_graph;
+    cuda_options.max_cuda_graphs = internal_options.max_cuda_graphs;
+    cuda_options.use_cuda_mem_pool = internal_options.use_cuda_mem_pool;
+    cuda_options.cuda_mem_pool_release_threshold = internal_options.cuda_mem_pool_release_threshold;
     cuda_options.cudnn_conv1d_pad_to_nc1d = internal_options.cudnn_conv1d_pad_to_nc1d;
+    cuda_options.tunable_op_enabled = internal_options.tunable_op.enabled;
+    cuda_options.prefer_nhwc = internal_options.prefer_nhwc;
+    cuda_options.max_compute_streams = internal_options.max_compute_streams;
+
+    // The strings are owned by the options and freed by ReleaseCUDAProviderOptions.
+    auto assign_string = [](const char*& dest, const std::string& value) {
+      delete[] dest;
+      dest = nullptr;
+      if (!value.empty()) {
+        char* copy = new char[value.size() + 1];
+        std::copy(value.begin(), value.end(), copy);
+        copy[value.size()] = '\0';
+        dest = copy;
+      }
+    };
+    assign_string(cuda_options.tunable_op_tuning_results_file, internal_options.tunable_op.tuning_results_file);
+    assign_string(cuda_options.cudnn_conv_algo_cache_file, internal_options.cudnn_conv_algo_cache_file);
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
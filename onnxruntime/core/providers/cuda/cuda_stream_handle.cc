@@ -42,10 +42,12 @@ CudaStream::CudaStream(cudaStream_t stream,
                        bool release_cpu_buffer_on_cuda_stream,
                        bool own_flag,
                        cudnnHandle_t external_cudnn_handle,
-                       cublasHandle_t external_cublas_handle) : Stream(stream, device),
-                                                                own_stream_(own_flag),
-                                                                cpu_allocator_(cpu_allocator),
-                                                                release_cpu_buffer_on_cuda_stream_(release_cpu_buffer_on_cuda_stream) {
+                       cublasHandle_t external_cublas_handle,
+                       bool use_copy_streams) : Stream(stream, device),
+                                                own_stream_(own_flag),
+                                                cpu_allocator_(cpu_allocator),
+                                                release_cpu_buffer_on_cuda_stream_(release_cpu_buffer_on_cuda_stream),
+                                                use_copy_streams_(use_copy_streams) {
   if (own_flag) {
     CUBLAS_CALL_THROW(cublasCreate(&cublas_handle_));
     CUBLAS_CALL_THROW(cublasSetStream(cublas_handle_, stream));
@@ -61,6 +63,14 @@ CudaStream::CudaStream(cudaStream_t stream,
 
 CudaStream::~CudaStream() {
   ORT_IGNORE_RETURN_VALUE(CleanUpOnRunEnd());
+  for (auto* copy_stream : {&h2d_copy_stream_, &d2h_copy_stream_}) {
+    if (copy_stream->stream) {
+      cudaStreamSynchronize(copy_stream->stream);
+      cudaEventDestroy(copy_stream->ready);
+      cudaEventDestroy(copy_stream->done);
+      cudaStreamDestroy(copy_stream->stream);
+    }
+  }
   if (own_stream_) {
     cublasDestroy(cublas_handle_);
     cudnnDestroy(cudnn_handle_);
@@ -86,6 +96,32 @@ void CudaStream::EnqueDeferredCPUBuffer(void* cpu_buffer) {
   deferred_cpu_buffers_.push_back(cpu_buffer);
 }
 
+Status CudaStream::CopyOnCopyStream(void* dst, const void* src, size_t bytes, cudaMemcpyKind kind) {
+  auto& copy_stream = kind == cudaMemcpyHostToDevice ? h2d_copy_stream_ : d2h_copy_stream_;
+  // stream is per thread, so the copy streams are created on first use without a lock
+  if (!copy_stream.stream) {
+    CUDA_RETURN_IF_ERROR(cudaStreamCreateWithFlags(&copy_stream.stream, cudaStreamNonBlocking));
+    CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&copy_stream.ready, cudaEventDisableTiming));
+    CUDA_RETURN_IF_ERROR(cudaEventCreateWithFlags(&copy_stream.done, cudaEventDisableTiming));
+  }
+
+  // the buffers may be reused from memory that was released by the kernels queued on this stream,
+  // and the kernels queued afterwards may consume or release them.
+  cudaStream_t stream = static_cast<cudaStream_t>(GetHandle());
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(copy_stream.ready, stream));
+  CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(copy_stream.stream, copy_stream.ready));
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst, src, bytes, kind, copy_stream.stream));
+  CUDA_RETURN_IF_ERROR(cudaEventRecord(copy_stream.done, copy_stream.stream));
+  CUDA_RETURN_IF_ERROR(cudaStreamWaitEvent(stream, copy_stream.done));
+  return Status::OK();
+}
+
+void* CudaStream::AllocateStagingBuffer(size_t bytes) {
+  void* buffer = cpu_allocator_->Alloc(bytes);
+  EnqueDeferredCPUBuffer(buffer);
+  return buffer;
+}
+
 struct CpuBuffersInfo {
   // This struct stores the information needed
   // to release CPU buffers allocated for GPU kernels.
@@ -165,25 +201,27 @@ void RegisterCudaStreamHandles(IStreamCommandHandleRegistry& stream_handle_regis
                                cudaStream_t external_stream,
                                bool use_existing_stream,
                                cudnnHandle_t external_cudnn_handle,
-                               cublasHandle_t external_cublas_handle) {
+                               cublasHandle_t external_cublas_handle,
+                               bool use_copy_streams) {
   // wait cuda notification on cuda ep
   stream_handle_registry.RegisterWaitFn(device_type, device_type, WaitCudaNotificationOnDevice);
   // wait cuda notification on cpu ep
   stream_handle_registry.RegisterWaitFn(device_type, OrtDevice::CPU, WaitCudaNotificationOnHost);
   if (!use_existing_stream)
-    stream_handle_registry.RegisterCreateStreamFn(device_type, [cpu_allocator, release_cpu_buffer_on_cuda_stream](const OrtDevice& device) {
+    stream_handle_registry.RegisterCreateStreamFn(device_type, [cpu_allocator, release_cpu_buffer_on_cuda_stream, use_copy_streams](const OrtDevice& device) {
       cudaStream_t stream = nullptr;
       // CUDA_CALL_THROW(cudaStreamCreateWithFlags(&stream, cudaStreamNonBlocking));
       CUDA_CALL_THROW(cudaStreamCreate(&stream));
-      return std::make_unique<CudaStream>(stream, device, cpu_allocator, release_cpu_buffer_on_cuda_stream, true, nullptr, nullptr);
+      return std::make_unique<CudaStream>(stream, device, cpu_allocator, release_cpu_buffer_on_cuda_stream, true, nullptr, nullptr, use_copy_streams);
     });
   else
     stream_handle_registry.RegisterCreateStreamFn(device_type, [cpu_allocator,
                                                                 release_cpu_buffer_on_cuda_stream,
                                                                 external_stream,
                                                                 external_cudnn_handle,
-                                                                external_cublas_handle](const OrtDevice& device) {
-      return std::make_unique<CudaStream>(external_stream, device, cpu_allocator, release_cpu_buffer_on_cuda_stream, false, external_cudnn_handle, external_cublas_handle);
+                                                                external_cublas_handle,
+                                                                use_copy_streams](const OrtDevice& device) {
+      return std::make_unique<CudaStream>(external_stream, device, cpu_allocator, release_cpu_buffer_on_cuda_stream, false, external_cudnn_handle, external_cublas_handle, use_copy_streams);
     });
 }
 
@@ -15,7 +15,8 @@ struct CudaStream : Stream {
              bool release_cpu_buffer_on_cuda_stream,
              bool own_flag,
              cudnnHandle_t external_cudnn_handle,
-             cublasHandle_t external_cublass_handle);
+             cublasHandle_t external_cublass_handle,
+             bool use_copy_streams = false);
 
   ~CudaStream();
 
@@ -27,6 +28,18 @@ struct CudaStream : Stream {
 
   void EnqueDeferredCPUBuffer(void* cpu_buffer);
 
+  // If set, the copies between host and device run on dedicated copy streams, one per direction, so they can
+  // overlap with the kernels of other streams and with the copies in the other direction.
+  bool UseCopyStreams() const { return use_copy_streams_; }
+
+  // Copies bytes on the copy stream of the direction given by kind. The copy starts after the work queued on this
+  // stream so far, and the work queued on this stream afterwards waits for the copy.
+  Status CopyOnCopyStream(void* dst, const void* src, size_t bytes, cudaMemcpyKind kind);
+
+  // Returns a pinned host buffer to stage a copy from pageable memory. It is released with the deferred CPU buffers,
+  // after the work queued on this stream.
+  void* AllocateStagingBuffer(size_t bytes);
+
   bool own_stream_{true};
 
   cudnnHandle_t cudnn_handle_{};
@@ -37,6 +50,17 @@ struct CudaStream : Stream {
   std::vector<void*> deferred_cpu_buffers_;
   AllocatorPtr cpu_allocator_;
   bool release_cpu_buffer_on_cuda_stream_{true};
+
+  struct CopyStream {
+    cudaStream_t stream{};
+    // recorded on this stream before a copy, and on the copy stream after it
+    cudaEvent_t ready{};
+    cudaEvent_t done{};
+  };
+
+  bool use_copy_streams_{false};
+  CopyStream h2d_copy_stream_;
+  CopyStream d2h_copy_stream_;
 };
 
 void RegisterCudaStreamHandles(IStreamCommandHandleRegistry& stream_handle_registry,
@@ -46,6 +70,7 @@ void RegisterCudaStreamHandles(IStreamCommandHandleRegistry& stream_handle_regis
                                cudaStream_t external_stream,
                                bool use_existing_stream,
                                cudnnHandle_t external_cudnn_handle,
-                               cublasHandle_t external_cublass_handle);
+                               cublasHandle_t external_cublass_handle,
+                               bool use_copy_streams = false);
 void WaitCudaNotificationOnDevice(Stream& stream, synchronize::Notification& notification);
 }  // namespace onnxruntime
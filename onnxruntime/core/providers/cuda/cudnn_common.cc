@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "cudnn_common.h"
+
+#include <algorithm>
+
 #include "core/common/inlined_containers.h"
 #include "core/common/gsl.h"
 #include "shared_inc/cuda_call.h"
@@ -27,7 +30,7 @@ Status CudnnTensor::CreateTensorIfNeeded() {
   return Status::OK();
 }
 
-Status CudnnTensor::Set(gsl::span<const int64_t> input_dims, cudnnDataType_t dataType) {
+Status CudnnTensor::Set(gsl::span<const int64_t> input_dims, cudnnDataType_t dataType, bool is_nhwc) {
   ORT_RETURN_IF_ERROR(CreateTensorIfNeeded());
 
   int rank = gsl::narrow_cast<int>(input_dims.size());
@@ -38,6 +41,17 @@ Status CudnnTensor::Set(gsl::span<const int64_t> input_dims, cudnnDataType_t dat
     dims[i] = gsl::narrow_cast<int>(input_dims[i]);
     strides[i] = gsl::narrow_cast<int>(pitches[i]);
   }
+  if (is_nhwc && rank > 2) {
+    // the channels are innermost, followed by the spatial dims and then the batch
+    int64_t stride = 1;
+    strides[1] = gsl::narrow_cast<int>(stride);
+    stride *= input_dims[1];
+    for (int i = rank - 1; i >= 2; i--) {
+      strides[i] = gsl::narrow_cast<int>(stride);
+      stride *= input_dims[i];
+    }
+    strides[0] = gsl::narrow_cast<int>(stride);
+  }
   CUDNN_RETURN_IF_ERROR(cudnnSetTensorNdDescriptor(tensor_, dataType, static_cast<int>(rank), dims.data(), strides.data()));
   return Status::OK();
 }
@@ -95,7 +109,7 @@ CudnnFilterDescriptor::~CudnnFilterDescriptor() {
   }
 }
 
-Status CudnnFilterDescriptor::Set(gsl::span<const int64_t> filter_dims, cudnnDataType_t data_type) {
+Status CudnnFilterDescriptor::Set(gsl::span<const int64_t> filter_dims, cudnnDataType_t data_type, bool is_nhwc) {
   if (!desc_)
     CUDNN_RETURN_IF_ERROR(cudnnCreateFilterDescriptor(&desc_));
 
@@ -107,12 +121,28 @@ Status CudnnFilterDescriptor::Set(gsl::span<const int64_t> filter_dims, cudnnDat
 
   CUDNN_RETURN_IF_ERROR(cudnnSetFilterNdDescriptor(desc_,
                                                    data_type,
-                                                   CUDNN_TENSOR_NCHW,
+                                                   is_nhwc ? CUDNN_TENSOR_NHWC : CUDNN_TENSOR_NCHW,
                                                    rank,
                                                    w_dims.data()));
   return Status::OK();
 }
 
+TensorShapeVector ChannelsLastToFirstDims(gsl::span<const int64_t> dims) {
+  TensorShapeVector result(dims.begin(), dims.end());
+  if (dims.size() > 2) {
+    std::rotate(result.begin() + 1, result.end() - 1, result.end());
+  }
+  return result;
+}
+
+TensorShapeVector ChannelsFirstToLastDims(gsl::span<const int64_t> dims) {
+  TensorShapeVector result(dims.begin(), dims.end());
+  if (dims.size() > 2) {
+    std::rotate(result.begin() + 1, result.begin() + 2, result.end());
+  }
+  return result;
+}
+
 template <typename ElemType>
 cudnnDataType_t CudnnTensor::GetDataType() {
   ORT_THROW("cuDNN engine currently supports only single/double/half/int8/uint8 precision data types. Got:",
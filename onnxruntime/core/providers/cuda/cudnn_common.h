@@ -16,7 +16,8 @@ class CudnnTensor final {
   ~CudnnTensor();
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudnnTensor);
 
-  Status Set(gsl::span<const int64_t> input_dims, cudnnDataType_t dataType);
+  // input_dims are in the NCHW order, if is_nhwc is true the data of the tensor is in the channels last layout.
+  Status Set(gsl::span<const int64_t> input_dims, cudnnDataType_t dataType, bool is_nhwc = false);
   Status Set(const CudnnTensor& x_desc, cudnnBatchNormMode_t mode);
 
   operator cudnnTensorDescriptor_t() const { return tensor_; }
@@ -56,7 +57,8 @@ class CudnnFilterDescriptor final {
   ~CudnnFilterDescriptor();
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CudnnFilterDescriptor);
 
-  Status Set(gsl::span<const int64_t> filter_dims, cudnnDataType_t data_typ);
+  // filter_dims are in the KCRS order, if is_nhwc is true the data of the filter is in the KRSC layout.
+  Status Set(gsl::span<const int64_t> filter_dims, cudnnDataType_t data_typ, bool is_nhwc = false);
 
   operator cudnnFilterDescriptor_t() const { return desc_; }
 
@@ -112,6 +114,10 @@ class CudnnDropout final {
   cudnnDropoutDescriptor_t dropout_desc_;
 };
 
+// Converts the dims of a channels last tensor, e.g. NHWC, to the channels first order, e.g. NCHW, and back.
+TensorShapeVector ChannelsLastToFirstDims(gsl::span<const int64_t> dims);
+TensorShapeVector ChannelsFirstToLastDims(gsl::span<const int64_t> dims);
+
 template <typename ElemType>
 struct Consts {
   static const ElemType Zero;
@@ -110,7 +110,7 @@ void CUPTIManager::ProcessActivityBuffers(const std::vector<ProfilerActivityBuff
           new (&event) EventRecord{
               /* cat = */ EventCategory::KERNEL_EVENT,
               /* pid = */ -1,
-              /* tid = */ -1,
+              /* tid = */ static_cast<int>(kernel->streamId),  // one track per stream
               /* name = */ std::move(name),
               /* ts = */ (int64_t)(kernel->start - start_time_ns) / 1000,
               /* dur = */ (int64_t)(kernel->end - kernel->start) / 1000,
@@ -131,7 +131,7 @@ void CUPTIManager::ProcessActivityBuffers(const std::vector<ProfilerActivityBuff
           new (&event) EventRecord{
               /* cat = */ EventCategory::KERNEL_EVENT,
               /* pid = */ -1,
-              /* tid = */ -1,
+              /* tid = */ static_cast<int>(mmcpy->streamId),
               /* name = */ std::move(name),
               /* ts = */ (int64_t)(mmcpy->start - start_time_ns) / 1000,
               /* dur = */ (int64_t)(mmcpy->end - mmcpy->start) / 1000,
@@ -4,9 +4,23 @@
 #include "core/providers/shared_library/provider_api.h"
 
 #include "core/providers/cuda/gpu_data_transfer.h"
+#include "core/providers/cuda/cuda_stream_handle.h"
 #include "cuda_common.h"
 
 namespace onnxruntime {
+
+namespace {
+// Returns the CUDA stream if the copies between host and device are placed on its copy streams.
+CudaStream* GetStreamWithCopyStreams(Stream& stream) {
+  if (stream.GetDevice().Type() != OrtDevice::GPU) {
+    return nullptr;
+  }
+
+  auto* cuda_stream = static_cast<CudaStream*>(&stream);
+  return cuda_stream->UseCopyStreams() ? cuda_stream : nullptr;
+}
+}  // namespace
+
 GPUDataTransfer::GPUDataTransfer() {}
 
 GPUDataTransfer::~GPUDataTransfer() {}
@@ -59,6 +73,16 @@ common::Status GPUDataTransfer::CopyTensorAsync(const Tensor& src, Tensor& dst,
 
   if (dst_device.Type() == OrtDevice::GPU) {
     if (src_device.Type() == OrtDevice::CPU) {
+      if (auto* cuda_stream = GetStreamWithCopyStreams(stream); cuda_stream != nullptr && bytes > 0) {
+        // stage pageable memory in a pinned buffer, so the copy neither blocks the host nor the other streams
+        if (src_device.MemType() != OrtDevice::MemType::CUDA_PINNED) {
+          void* staging_buffer = cuda_stream->AllocateStagingBuffer(bytes);
+          memcpy(staging_buffer, src_data, bytes);
+          src_data = staging_buffer;
+        }
+        return cuda_stream->CopyOnCopyStream(dst_data, src_data, bytes, cudaMemcpyHostToDevice);
+      }
+
       // copy from pinned memory to GPU, this is non-blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyHostToDevice, static_cast<cudaStream_t>(stream.GetHandle())));
     } else if (src_device.Type() == OrtDevice::GPU) {
@@ -69,6 +93,10 @@ common::Status GPUDataTransfer::CopyTensorAsync(const Tensor& src, Tensor& dst,
     }
   } else if (src_device.Type() == OrtDevice::GPU) {
     if (dst_device.Type() == OrtDevice::CPU) {
+      if (auto* cuda_stream = GetStreamWithCopyStreams(stream); cuda_stream != nullptr && bytes > 0) {
+        return cuda_stream->CopyOnCopyStream(dst_data, src_data, bytes, cudaMemcpyDeviceToHost);
+      }
+
       // copying from GPU to pinned memory, this is non-blocking
       CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(dst_data, src_data, bytes, cudaMemcpyDeviceToHost, static_cast<cudaStream_t>(stream.GetHandle())));
     }
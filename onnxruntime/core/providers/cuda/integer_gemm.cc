@@ -60,5 +60,109 @@ Status GemmInt8(int m, int n, int k,
       CUBLAS_GEMM_DFALT));
   return Status::OK();
 }
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11040
+
+bool CanUseGemmInt8Lt(const cudaDeviceProp& prop, int n, int k) {
+  return prop.major * 10 + prop.minor >= 75 && n % 4 == 0 && k % 4 == 0;
+}
+
+// cuBLASLt is column major, so this computes the column major [n, m] c^T = b_transposed^T * a^T. The row major
+// [n, k] b_transposed and [m, k] a are the column major [k, n] and [k, m] matrices, and transposing the first
+// operand gives the "TN" form the IMMA kernels require.
+static Status GemmInt8LtImpl(cublasLtHandle_t handle, cudaStream_t stream, int m, int n, int k,
+                             cudaDataType_t scale_type, const void* alpha, const void* beta, const float* bias,
+                             const int8_t* a, const int8_t* b_transposed, void* c, cudaDataType_t c_type) {
+  cublasLtMatmulDesc_t matmul_desc = nullptr;
+  auto clean_matmul_desc = gsl::finally([&matmul_desc]() {if (matmul_desc) cublasLtMatmulDescDestroy(matmul_desc); });
+
+  cublasLtMatrixLayout_t desc_a = nullptr;
+  auto clean_desc_a = gsl::finally([&desc_a]() {if (desc_a) cublasLtMatrixLayoutDestroy(desc_a); });
+
+  cublasLtMatrixLayout_t desc_b = nullptr;
+  auto clean_desc_b = gsl::finally([&desc_b]() {if (desc_b) cublasLtMatrixLayoutDestroy(desc_b); });
+
+  cublasLtMatrixLayout_t desc_c = nullptr;
+  auto clean_desc_c = gsl::finally([&desc_c]() {if (desc_c) cublasLtMatrixLayoutDestroy(desc_c); });
+
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescCreate(&matmul_desc, CUBLAS_COMPUTE_32I, scale_type));
+
+  const cublasOperation_t transpose_op = CUBLAS_OP_T;
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(matmul_desc,
+                                                        CUBLASLT_MATMUL_DESC_TRANSA,
+                                                        &transpose_op, sizeof(transpose_op)));
+
+  if (bias != nullptr) {
+    // with an int8 c the bias has the float type of the scale
+    cublasLtEpilogue_t epilogue_bias = CUBLASLT_EPILOGUE_BIAS;
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(matmul_desc,
+                                                          CUBLASLT_MATMUL_DESC_EPILOGUE,
+                                                          &epilogue_bias, sizeof(epilogue_bias)));
+
+    CUBLAS_RETURN_IF_ERROR(cublasLtMatmulDescSetAttribute(matmul_desc,
+                                                          CUBLASLT_MATMUL_DESC_BIAS_POINTER,
+                                                          &bias, sizeof(bias)));
+  }
+
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&desc_b, CUDA_R_8I, k, n, k));
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&desc_a, CUDA_R_8I, k, m, k));
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatrixLayoutCreate(&desc_c, c_type, n, m, n));
+
+  CUBLAS_RETURN_IF_ERROR(cublasLtMatmul(handle, matmul_desc, alpha,
+                                        b_transposed, desc_b,
+                                        a, desc_a,
+                                        beta, c, desc_c,
+                                        c, desc_c,
+                                        nullptr, nullptr, 0, stream));
+  return Status::OK();
+}
+
+Status GemmInt8Lt(int m, int n, int k,
+                  int32_t alpha, int32_t beta,
+                  const int8_t* a, const int8_t* b_transposed, int32_t* c,
+                  const CudaKernel* cuda_kernel, onnxruntime::Stream* ort_stream) {
+  ORT_ENFORCE(a != nullptr && b_transposed != nullptr && c != nullptr, "input matrix should not be null");
+  ORT_ENFORCE(cuda_kernel != nullptr, "kernel is null");
+
+  cudaStream_t stream = ort_stream ? static_cast<cudaStream_t>(ort_stream->GetHandle()) : nullptr;
+  return GemmInt8LtImpl(cuda_kernel->CublasLtHandle(), stream, m, n, k, CUDA_R_32I, &alpha, &beta, nullptr,
+                        a, b_transposed, c, CUDA_R_32I);
+}
+
+Status GemmInt8LtQuantized(int m, int n, int k,
+                           float scale, const float* bias,
+                           const int8_t* a, const int8_t* b_transposed, int8_t* c,
+                           const CudaKernel* cuda_kernel, onnxruntime::Stream* ort_stream) {
+  ORT_ENFORCE(a != nullptr && b_transposed != nullptr && c != nullptr, "input matrix should not be null");
+  ORT_ENFORCE(cuda_kernel != nullptr, "kernel is null");
+
+  cudaStream_t stream = ort_stream ? static_cast<cudaStream_t>(ort_stream->GetHandle()) : nullptr;
+  constexpr float beta = 0.0f;
+  return GemmInt8LtImpl(cuda_kernel->CublasLtHandle(), stream, m, n, k, CUDA_R_32F, &scale, &beta, bias,
+                        a, b_transposed, c, CUDA_R_8I);
+}
+
+#else
+
+bool CanUseGemmInt8Lt(const cudaDeviceProp& /*prop*/, int /*n*/, int /*k*/) {
+  return false;
+}
+
+Status GemmInt8Lt(int /*m*/, int /*n*/, int /*k*/,
+                  int32_t /*alpha*/, int32_t /*beta*/,
+                  const int8_t* /*a*/, const int8_t* /*b_transposed*/, int32_t* /*c*/,
+                  const CudaKernel* /*cuda_kernel*/, onnxruntime::Stream* /*ort_stream*/) {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "GemmInt8Lt needs CUDA 11.4 or later");
+}
+
+Status GemmInt8LtQuantized(int /*m*/, int /*n*/, int /*k*/,
+                           float /*scale*/, const float* /*bias*/,
+                           const int8_t* /*a*/, const int8_t* /*b_transposed*/, int8_t* /*c*/,
+                           const CudaKernel* /*cuda_kernel*/, onnxruntime::Stream* /*ort_stream*/) {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "GemmInt8LtQuantized needs CUDA 11.4 or later");
+}
+
+#endif
+
 }  // namespace cuda
 }  // namespace onnxruntime
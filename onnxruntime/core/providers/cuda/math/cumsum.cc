@@ -76,6 +76,12 @@ Status CumSum::ComputeInternal(OpKernelContext* ctx) const {
   fast_divmod fast_divmod_input_dim_along_axis(static_cast<int>(input_dims[axis]));
   fast_divmod fast_divmod_input_stride_along_axis(static_cast<int>(input_stride_along_axis));
 
+  const size_t scratch_size = CumSumScratchBufferSize(input_dims[axis], input_stride_along_axis, output_shape.Size());
+  auto scratch_buffer = GetScratchBuffer<void>(scratch_size, ctx->GetComputeStream());
+  if (scratch_size > 0) {
+    CUDA_RETURN_IF_ERROR(cudaMemsetAsync(scratch_buffer.get(), 0, scratch_size, Stream(ctx)));
+  }
+
   if (input->IsDataType<float>()) {
     CumSumImpl(Stream(ctx), reinterpret_cast<const typename ToCudaType<float>::MappedType*>(input->Data<float>()),
                fast_divmod_input_dim_along_axis,
@@ -83,7 +89,8 @@ Status CumSum::ComputeInternal(OpKernelContext* ctx) const {
                reinterpret_cast<typename ToCudaType<float>::MappedType*>(output.MutableData<float>()),
                output_shape.Size(),
                exclusive_,
-               reverse_);
+               reverse_,
+               scratch_buffer.get());
   } else if (input->IsDataType<double>()) {
     CumSumImpl(Stream(ctx), reinterpret_cast<const typename ToCudaType<double>::MappedType*>(input->Data<double>()),
                fast_divmod_input_dim_along_axis,
@@ -91,7 +98,8 @@ Status CumSum::ComputeInternal(OpKernelContext* ctx) const {
                reinterpret_cast<typename ToCudaType<double>::MappedType*>(output.MutableData<double>()),
                output_shape.Size(),
                exclusive_,
-               reverse_);
+               reverse_,
+               scratch_buffer.get());
   } else if (input->IsDataType<int32_t>()) {
     CumSumImpl(Stream(ctx), reinterpret_cast<const typename ToCudaType<int32_t>::MappedType*>(input->Data<int32_t>()),
                fast_divmod_input_dim_along_axis,
@@ -99,7 +107,8 @@ Status CumSum::ComputeInternal(OpKernelContext* ctx) const {
                reinterpret_cast<typename ToCudaType<int32_t>::MappedType*>(output.MutableData<int32_t>()),
                output_shape.Size(),
                exclusive_,
-               reverse_);
+               reverse_,
+               scratch_buffer.get());
   } else if (input->IsDataType<int64_t>()) {
     CumSumImpl(Stream(ctx), reinterpret_cast<const typename ToCudaType<int64_t>::MappedType*>(input->Data<int64_t>()),
                fast_divmod_input_dim_along_axis,
@@ -107,7 +116,8 @@ Status CumSum::ComputeInternal(OpKernelContext* ctx) const {
                reinterpret_cast<typename ToCudaType<int64_t>::MappedType*>(output.MutableData<int64_t>()),
                output_shape.Size(),
                exclusive_,
-               reverse_);
+               reverse_,
+               scratch_buffer.get());
   } else if (input->IsDataType<uint32_t>()) {
     CumSumImpl(Stream(ctx), reinterpret_cast<const typename ToCudaType<uint32_t>::MappedType*>(input->Data<uint32_t>()),
                fast_divmod_input_dim_along_axis,
@@ -115,7 +125,8 @@ Status CumSum::ComputeInternal(OpKernelContext* ctx) const {
                reinterpret_cast<typename ToCudaType<uint32_t>::MappedType*>(output.MutableData<uint32_t>()),
                output_shape.Size(),
                exclusive_,
-               reverse_);
+               reverse_,
+               scratch_buffer.get());
   } else if (input->IsDataType<uint64_t>()) {
     CumSumImpl(Stream(ctx), reinterpret_cast<const typename ToCudaType<uint64_t>::MappedType*>(input->Data<uint64_t>()),
                fast_divmod_input_dim_along_axis,
@@ -123,7 +134,8 @@ Status CumSum::ComputeInternal(OpKernelContext* ctx) const {
                reinterpret_cast<typename ToCudaType<uint64_t>::MappedType*>(output.MutableData<uint64_t>()),
                output_shape.Size(),
                exclusive_,
-               reverse_);
+               reverse_,
+               scratch_buffer.get());
   } else if (input->IsDataType<MLFloat16>()) {
     CumSumImpl(Stream(ctx), reinterpret_cast<const typename ToCudaType<MLFloat16>::MappedType*>(input->Data<MLFloat16>()),
                fast_divmod_input_dim_along_axis,
@@ -131,7 +143,8 @@ Status CumSum::ComputeInternal(OpKernelContext* ctx) const {
                reinterpret_cast<typename ToCudaType<MLFloat16>::MappedType*>(output.MutableData<MLFloat16>()),
                output_shape.Size(),
                exclusive_,
-               reverse_);
+               reverse_,
+               scratch_buffer.get());
   } else {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported input data type to the CumSum op: ",
                            input->DataType());
@@ -10,63 +10,193 @@ namespace onnxruntime {
 namespace cuda {
 
 template <typename T>
-__global__ void _CumSumKernel(
+struct CumSumAccumulationType { using type = T; };
+template <>
+struct CumSumAccumulationType<half> { using type = float; };
+
+constexpr int kScanThreadsPerBlock = 256;
+constexpr int kScanItemsPerThread = 8;
+constexpr int kScanTileSize = kScanThreadsPerBlock * kScanItemsPerThread;
+
+// Status of a tile in the decoupled look-back
+constexpr int kTileNotReady = 0;
+constexpr int kTileAggregateReady = 1;  // the sum of the tile is available
+constexpr int kTilePrefixReady = 2;     // the sum of the tile and all the tiles before it in the row is available
+
+// Scan along an axis that is not the innermost one. Each thread scans one column along the axis, and the threads
+// of a warp read adjacent columns so the accesses are coalesced.
+template <typename T>
+__global__ void _CumSumStridedKernel(
     const T* input_data,
-    const fast_divmod fast_divmod_input_dim_along_axis,
     const fast_divmod fast_divmod_input_stride_along_axis,
+    const int input_dim_along_axis,
     T* output_data,
-    const int64_t output_size,
+    const int64_t column_count,
     const bool exclusive,
     const bool reverse) {
-  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(indices_index, output_size);
+  using AccT = typename CumSumAccumulationType<T>::type;
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(column, column_count);
 
-  int input_dim_along_axis = fast_divmod_input_dim_along_axis.d_;
-  int input_stride_along_axis = fast_divmod_input_stride_along_axis.d_;
+  const int stride = fast_divmod_input_stride_along_axis.d_;
+  int outer = 0;
+  int inner = 0;
+  fast_divmod_input_stride_along_axis.divmod(static_cast<int>(column), outer, inner);
+  const int64_t offset = static_cast<int64_t>(outer) * input_dim_along_axis * stride + inner;
 
-  int axis_dim = 0;
-  int div = fast_divmod_input_stride_along_axis.div(static_cast<int>(indices_index));
-  fast_divmod_input_dim_along_axis.divmod(div, div, axis_dim);
+  AccT sum = 0;
+  for (int step = 0; step < input_dim_along_axis; ++step) {
+    const int axis_dim = reverse ? input_dim_along_axis - 1 - step : step;
+    const int64_t index = offset + static_cast<int64_t>(axis_dim) * stride;
+    const AccT value = static_cast<AccT>(input_data[index]);
+    if (exclusive) {
+      output_data[index] = static_cast<T>(sum);
+      sum += value;
+    } else {
+      sum += value;
+      output_data[index] = static_cast<T>(sum);
+    }
+  }
+}
 
-  int start = 0;
-  int end = 0;
+// Single pass scan along the innermost axis with decoupled look-back. Every row is split into tiles of
+// kScanTileSize elements, and each block scans one tile. The tiles are taken in order from a global counter, so
+// the tiles before a tile in its row are always running or done. After scanning its tile, a block publishes the
+// sum of the tile, then looks back at the preceding tiles until it finds one that published its inclusive prefix,
+// adding up the sums on the way. Reverse scans walk the row from its end.
+template <typename T>
+__global__ void _CumSumDecoupledLookBackKernel(
+    const T* input_data,
+    const int input_dim_along_axis,
+    const int tiles_per_row,
+    T* output_data,
+    typename CumSumAccumulationType<T>::type* tile_aggregates,
+    typename CumSumAccumulationType<T>::type* tile_prefixes,
+    int* tile_status,
+    int* tile_counter,
+    const bool exclusive,
+    const bool reverse) {
+  using AccT = typename CumSumAccumulationType<T>::type;
+  __shared__ int tile_shared;
+  __shared__ AccT tile_prefix_shared;
+  __shared__ AccT items[kScanTileSize];
+  __shared__ AccT thread_sums[kScanThreadsPerBlock];
 
-  if (!reverse && !exclusive) {
-    start = 0;
-    end = axis_dim;
-  
-  } else if (reverse && !exclusive) {
-    start = axis_dim;
-    end = input_dim_along_axis - 1;
+  if (threadIdx.x == 0) {
+    tile_shared = atomicAdd(tile_counter, 1);
+  }
+  __syncthreads();
 
-  } else if (!reverse && exclusive) {
-    start = 0;
-    end = axis_dim - 1;
+  const int tile = tile_shared;
+  const int row = tile / tiles_per_row;
+  const int tile_in_row = tile - row * tiles_per_row;
+  const int tile_begin = tile_in_row * kScanTileSize;
+  const T* row_input = input_data + static_cast<int64_t>(row) * input_dim_along_axis;
+  T* row_output = output_data + static_cast<int64_t>(row) * input_dim_along_axis;
 
-  } else { // reverse && exclusive
-    start = axis_dim + 1;
-    end = input_dim_along_axis - 1;
+  // Coalesced load of the tile in scan order.
+#pragma unroll
+  for (int i = 0; i < kScanItemsPerThread; ++i) {
+    const int item = i * kScanThreadsPerBlock + threadIdx.x;
+    const int step = tile_begin + item;
+    const int axis_dim = reverse ? input_dim_along_axis - 1 - step : step;
+    items[item] = step < input_dim_along_axis ? static_cast<AccT>(row_input[axis_dim]) : AccT(0);
+  }
+  __syncthreads();
 
+  // Each thread sums its consecutive items, then the sums of the threads are scanned across the block.
+  AccT* thread_items = items + threadIdx.x * kScanItemsPerThread;
+  AccT thread_sum = 0;
+#pragma unroll
+  for (int i = 0; i < kScanItemsPerThread; ++i) {
+    thread_sum += thread_items[i];
   }
+  thread_sums[threadIdx.x] = thread_sum;
+  __syncthreads();
 
-  // count the number of elements to accumulate the sum
-  int count = end - start + 1;
-  if (count <= 0) {
-    output_data[indices_index] = 0;
-    return;  
+  for (int offset = 1; offset < kScanThreadsPerBlock; offset <<= 1) {
+    const AccT addend = threadIdx.x >= offset ? thread_sums[threadIdx.x - offset] : AccT(0);
+    __syncthreads();
+    thread_sums[threadIdx.x] += addend;
+    __syncthreads();
   }
 
-  // adjust start index based on the above identified start dim value along the axis of interest
-  int data_index = static_cast<int>(indices_index) + (start - axis_dim) * input_stride_along_axis;
-  T sum = 0;
+  if (threadIdx.x == 0) {
+    const AccT aggregate = thread_sums[kScanThreadsPerBlock - 1];
+    AccT prefix = 0;
+    if (tile_in_row == 0) {
+      tile_prefixes[tile] = aggregate;
+      __threadfence();
+      atomicExch(&tile_status[tile], kTilePrefixReady);
+    } else {
+      tile_aggregates[tile] = aggregate;
+      __threadfence();
+      atomicExch(&tile_status[tile], kTileAggregateReady);
+
+      // The first tile of the row always publishes its prefix, so the look-back stays within the row.
+      for (int predecessor = tile - 1;; --predecessor) {
+        int status;
+        do {
+          status = *reinterpret_cast<volatile int*>(&tile_status[predecessor]);
+        } while (status == kTileNotReady);
+        __threadfence();
+        if (status == kTilePrefixReady) {
+          prefix += *reinterpret_cast<volatile AccT*>(&tile_prefixes[predecessor]);
+          break;
+        }
+        prefix += *reinterpret_cast<volatile AccT*>(&tile_aggregates[predecessor]);
+      }
 
-  // keep accumulating values from the start index for 'count' times and skip appropriately 
-  while (count != 0) {
-    sum += input_data[data_index];
-    data_index += input_stride_along_axis;
-    --count;
+      tile_prefixes[tile] = prefix + aggregate;
+      __threadfence();
+      atomicExch(&tile_status[tile], kTilePrefixReady);
+    }
+    tile_prefix_shared = prefix;
   }
+  __syncthreads();
 
-  output_data[indices_index] = sum;
+  AccT running = tile_prefix_shared + (threadIdx.x > 0 ? thread_sums[threadIdx.x - 1] : AccT(0));
+#pragma unroll
+  for (int i = 0; i < kScanItemsPerThread; ++i) {
+    const AccT value = thread_items[i];
+    if (exclusive) {
+      thread_items[i] = running;
+      running += value;
+    } else {
+      running += value;
+      thread_items[i] = running;
+    }
+  }
+  __syncthreads();
+
+#pragma unroll
+  for (int i = 0; i < kScanItemsPerThread; ++i) {
+    const int item = i * kScanThreadsPerBlock + threadIdx.x;
+    const int step = tile_begin + item;
+    if (step < input_dim_along_axis) {
+      const int axis_dim = reverse ? input_dim_along_axis - 1 - step : step;
+      row_output[axis_dim] = static_cast<T>(items[item]);
+    }
+  }
+}
+
+namespace {
+
+int CumSumTileCount(int64_t input_dim_along_axis, int64_t output_size) {
+  const int64_t tiles_per_row = (input_dim_along_axis + kScanTileSize - 1) / kScanTileSize;
+  return static_cast<int>(output_size / input_dim_along_axis * tiles_per_row);
+}
+
+}  // namespace
+
+size_t CumSumScratchBufferSize(int64_t input_dim_along_axis, int64_t input_stride_along_axis, int64_t output_size) {
+  if (input_stride_along_axis != 1 || output_size == 0) {
+    return 0;
+  }
+
+  // aggregates and inclusive prefixes of the tiles, with room for 8 byte accumulators, then the status of the
+  // tiles and the tile counter
+  const size_t tile_count = static_cast<size_t>(CumSumTileCount(input_dim_along_axis, output_size));
+  return 2 * tile_count * sizeof(int64_t) + (tile_count + 1) * sizeof(int);
 }
 
 template <typename T>
@@ -78,17 +208,36 @@ void CumSumImpl(
     T* output_data,
     int64_t output_size,
     bool exclusive,
-    bool reverse) {
-  if (output_size > 0) {
-    int blocksPerGrid = static_cast<int>((output_size + GridDim::maxThreadsPerBlock - 1) / GridDim::maxThreadsPerBlock);
-
-    _CumSumKernel<T><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(input_data,
-                                                                        input_dim_along_axis,
-                                                                        input_stride_along_axis,
-                                                                        output_data,
-                                                                        output_size,
-                                                                        exclusive,
-                                                                        reverse);
+    bool reverse,
+    void* scratch_buffer) {
+  if (output_size == 0) {
+    return;
+  }
+
+  using AccT = typename CumSumAccumulationType<T>::type;
+  const int dim = input_dim_along_axis.d_;
+  const int stride = input_stride_along_axis.d_;
+  if (stride == 1) {
+    // The scratch buffer is zeroed by the caller.
+    const int tile_count = CumSumTileCount(dim, output_size);
+    const int tiles_per_row = (dim + kScanTileSize - 1) / kScanTileSize;
+    auto* tile_aggregates = static_cast<AccT*>(scratch_buffer);
+    auto* tile_prefixes = reinterpret_cast<AccT*>(static_cast<int64_t*>(scratch_buffer) + tile_count);
+    auto* tile_status = reinterpret_cast<int*>(static_cast<int64_t*>(scratch_buffer) + 2 * tile_count);
+    int* tile_counter = tile_status + tile_count;
+    _CumSumDecoupledLookBackKernel<T><<<tile_count, kScanThreadsPerBlock, 0, stream>>>(
+        input_data, dim, tiles_per_row, output_data, tile_aggregates, tile_prefixes, tile_status, tile_counter,
+        exclusive, reverse);
+  } else {
+    const int64_t column_count = output_size / dim;
+    int blocksPerGrid = static_cast<int>((column_count + GridDim::maxThreadsPerBlock - 1) / GridDim::maxThreadsPerBlock);
+    _CumSumStridedKernel<T><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(input_data,
+                                                                                      input_stride_along_axis,
+                                                                                      dim,
+                                                                                      output_data,
+                                                                                      column_count,
+                                                                                      exclusive,
+                                                                                      reverse);
   }
 }
 
@@ -100,7 +249,8 @@ template void CumSumImpl<int32_t>(
     int32_t* output_data,
     int64_t output_size,
     bool exclusive,
-    bool reverse);
+    bool reverse,
+    void* scratch_buffer);
 
 template void CumSumImpl<int64_t>(
     cudaStream_t stream,
@@ -110,7 +260,8 @@ template void CumSumImpl<int64_t>(
     int64_t* output_data,
     int64_t output_size,
     bool exclusive,
-    bool reverse);
+    bool reverse,
+    void* scratch_buffer);
 
 template void CumSumImpl<uint32_t>(
     cudaStream_t stream,
@@ -120,7 +271,8 @@ template void CumSumImpl<uint32_t>(
     uint32_t* output_data,
     int64_t output_size,
     bool exclusive,
-    bool reverse);
+    bool reverse,
+    void* scratch_buffer);
 
 template void CumSumImpl<uint64_t>(
     cudaStream_t stream,
@@ -130,7 +282,8 @@ template void CumSumImpl<uint64_t>(
     uint64_t* output_data,
     int64_t output_size,
     bool exclusive,
-    bool reverse);
+    bool reverse,
+    void* scratch_buffer);
 
 template void CumSumImpl<float>(
     cudaStream_t stream,
@@ -140,7 +293,8 @@ template void CumSumImpl<float>(
     float* output_data,
     int64_t output_size,
     bool exclusive,
-    bool reverse);
+    bool reverse,
+    void* scratch_buffer);
 
 template void CumSumImpl<double>(
     cudaStream_t stream,
@@ -150,7 +304,8 @@ template void CumSumImpl<double>(
     double* output_data,
     int64_t output_size,
     bool exclusive,
-    bool reverse);
+    bool reverse,
+    void* scratch_buffer);
 
 template void CumSumImpl<half>(
     cudaStream_t stream,
@@ -160,7 +315,8 @@ template void CumSumImpl<half>(
     half* output_data,
     int64_t output_size,
     bool exclusive,
-    bool reverse);
+    bool reverse,
+    void* scratch_buffer);
 
 }  // namespace cuda
 }  // namespace onnxruntime
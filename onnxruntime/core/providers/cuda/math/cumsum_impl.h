@@ -9,6 +9,9 @@
 namespace onnxruntime {
 namespace cuda {
 
+// Size in bytes of the zero initialized scratch buffer needed by CumSumImpl.
+size_t CumSumScratchBufferSize(int64_t input_dim_along_axis, int64_t input_stride_along_axis, int64_t output_size);
+
 template <typename T>
 void CumSumImpl(
     cudaStream_t stream,
@@ -18,7 +21,8 @@ void CumSumImpl(
     T* output_data,
     int64_t output_size,
     bool exclusive,
-    bool reverse);
+    bool reverse,
+    void* scratch_buffer);
 
 }  // namespace cuda
 }  // namespace onnxruntime
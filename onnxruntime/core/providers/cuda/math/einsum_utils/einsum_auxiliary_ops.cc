@@ -44,7 +44,8 @@ Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input
 template <typename T>
 Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* /*tp*/,
+              size_t num_batches, size_t M, size_t K, size_t N, bool trans_left, bool trans_right,
+              concurrency::ThreadPool* /*tp*/,
               void* einsum_cuda_assets) {
   typedef typename cuda::ToCudaType<T>::MappedType CudaT;
 
@@ -52,17 +53,17 @@ Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
   CudaT zero = cuda::ToCudaType<T>::FromFloat(0.0f);
 
   CUBLAS_RETURN_IF_ERROR(cublasGemmStridedBatchedHelper(static_cast<EinsumCudaAssets*>(einsum_cuda_assets)->cublas_handle_,
-                                                        CUBLAS_OP_N,
-                                                        CUBLAS_OP_N,
+                                                        trans_right ? CUBLAS_OP_T : CUBLAS_OP_N,
+                                                        trans_left ? CUBLAS_OP_T : CUBLAS_OP_N,
                                                         static_cast<int>(N),
                                                         static_cast<int>(M),
                                                         static_cast<int>(K),
                                                         &one,
                                                         reinterpret_cast<const CudaT*>(input_2_data),
-                                                        static_cast<int>(N),
+                                                        static_cast<int>(trans_right ? K : N),
                                                         static_cast<int>(right_stride),
                                                         reinterpret_cast<const CudaT*>(input_1_data),
-                                                        static_cast<int>(K),
+                                                        static_cast<int>(trans_left ? M : K),
                                                         static_cast<int>(left_stride),
                                                         &zero,
                                                         reinterpret_cast<CudaT*>(output_data),
@@ -150,7 +151,8 @@ std::unique_ptr<Tensor> Diagonal(const Tensor& input, int64_t dim_1, int64_t dim
 template Status DeviceHelpers::CudaDeviceHelpers::MatMul<float>(
     const float* input_1_data, const float* input_2_data, float* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_left, bool trans_right,
+    concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CudaDeviceHelpers::ReduceSum<float>(
@@ -163,7 +165,8 @@ template std::unique_ptr<Tensor> DeviceHelpers::CudaDeviceHelpers::ReduceSum<flo
 template Status DeviceHelpers::CudaDeviceHelpers::MatMul<double>(
     const double* input_1_data, const double* input_2_data, double* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_left, bool trans_right,
+    concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CudaDeviceHelpers::ReduceSum<double>(
@@ -176,7 +179,8 @@ template std::unique_ptr<Tensor> DeviceHelpers::CudaDeviceHelpers::ReduceSum<dou
 template Status DeviceHelpers::CudaDeviceHelpers::MatMul<MLFloat16>(
     const MLFloat16* input_1_data, const MLFloat16* input_2_data, MLFloat16* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_left, bool trans_right,
+    concurrency::ThreadPool* tp,
     void* einsum_cuda_assets);
 
 template std::unique_ptr<Tensor> DeviceHelpers::CudaDeviceHelpers::ReduceSum<MLFloat16>(
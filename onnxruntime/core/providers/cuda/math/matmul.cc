@@ -5,6 +5,7 @@
 #include "core/providers/cpu/math/matmul_helper.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
 #include "core/providers/cuda/cuda_allocator.h"
+#include "core/providers/cuda/tunable/gemm.h"
 
 namespace onnxruntime {
 namespace cuda {
@@ -125,6 +126,30 @@ Status MatMul<T>::ComputeInternal(OpKernelContext* ctx) const {
   int64_t stride_A, stride_B, stride_C, batch_count;
   auto& device_prop = GetDeviceProp();
 
+  if constexpr (std::is_same_v<CudaT, float> || std::is_same_v<CudaT, half>) {
+    auto* tuning_results = GetTuningResults();
+    if (tuning_results != nullptr) {
+      using tunable::blas::BlasOp;
+      const BlasOp opa = transa ? BlasOp::T : BlasOp::N;
+      const BlasOp opb = transb ? BlasOp::T : BlasOp::N;
+      const auto* a = reinterpret_cast<const CudaT*>(left_X->Data<T>());
+      const auto* b = reinterpret_cast<const CudaT*>(right_X->Data<T>());
+      auto* c = reinterpret_cast<CudaT*>(Y->MutableData<T>());
+      if (helper.OutputOffsets().size() == 1) {
+        return tunable::blas::row_major::Gemm(
+            IsTunableOpEnabled(), tuning_results, Stream(ctx), GetCublasHandle(ctx), CublasLtHandle(), device_prop,
+            opa, opb, helper.M(), helper.N(), helper.K(),
+            alpha_, a, lda, b, ldb, 0.0f, c, ldc);
+      } else if (CanUseStridedBatchedGemm(left_X->Shape(), right_X->Shape(), transa, transb,
+                                          trans_batch_a_, trans_batch_b_, stride_A, stride_B, stride_C, batch_count)) {
+        return tunable::blas::row_major::StridedBatchedGemm(
+            IsTunableOpEnabled(), tuning_results, Stream(ctx), GetCublasHandle(ctx), CublasLtHandle(), device_prop,
+            opa, opb, helper.M(), helper.N(), helper.K(),
+            alpha_, a, lda, stride_A, b, ldb, stride_B, 0.0f, c, ldc, stride_C, batch_count);
+      }
+    }
+  }
+
   if (helper.OutputOffsets().size() == 1) {
     CUBLAS_RETURN_IF_ERROR(cublasGemmHelper(
                                GetCublasHandle(ctx),
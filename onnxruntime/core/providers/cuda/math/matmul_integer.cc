@@ -7,6 +7,7 @@
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
 #include "core/providers/cuda/shared_inc/integer_gemm.h"
 #include "core/providers/cuda/cuda_allocator.h"
+#include "core/providers/cuda/tensor/transpose.h"
 #include "core/providers/common.h"
 
 namespace onnxruntime {
@@ -26,39 +27,17 @@ ONNX_OPERATOR_TYPED_KERNEL_EX(
         .TypeConstraint("T3", DataTypeImpl::GetTensorType<int32_t>()),
     MatMulInteger<int8_t, int8_t>);
 
-template <>
-Status MatMulInteger<int8_t, int8_t>::ComputeInternal(OpKernelContext* ctx) const {
-  auto a = ctx->Input<Tensor>(0);
-  auto b = ctx->Input<Tensor>(1);
-  ORT_ENFORCE(a != nullptr && b != nullptr);
-
-  MatMulComputeHelper helper;
-  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b->Shape()));
-  Tensor* Y = ctx->Output(0, helper.OutputShape());
-
-  // Bail out early if the output is going to be empty
-  if (Y->Shape().Size() == 0)
-    return Status::OK();
-
-  const int8_t* a_ptr = a->Data<int8_t>();
-  const int8_t* b_ptr = b->Data<int8_t>();
-  int32_t* output_ptr = Y->MutableData<int32_t>();
+Status TransposeMatrixB(const cudaDeviceProp& prop, cudaStream_t stream, cublasHandle_t cublas_handle,
+                        const Tensor& b, AllocatorPtr alloc, std::unique_ptr<Tensor>& b_transposed) {
+  const auto& dims = b.Shape().GetDims();
+  b_transposed = Tensor::Create(b.DataType(), TensorShape({dims[1], dims[0]}), std::move(alloc));
+  const size_t perm[] = {1, 0};
+  return Transpose::DoTranspose(prop, stream, cublas_handle, perm, b, *b_transposed);
+}
 
-  // validate zero points
-  int8_t a_offset = 0;
-  int8_t b_offset = 0;
-  if (has_a_zero_point_) {
-    auto a_zero_point = ctx->Input<Tensor>(2);
-    ORT_ENFORCE(IsScalarOr1ElementVector(a_zero_point),
-                "MatmulInteger : input1 zero point must be a scalar or 1D tensor of size 1");
-    a_offset = *(a_zero_point->Data<int8_t>());
-  }
-  if (has_b_zero_point_) {
-    auto b_zero_point = ctx->Input<Tensor>(3);
-    ORT_ENFORCE(IsScalarOr1ElementVector(b_zero_point),
-                "MatmulInteger : input2 zero point must be a scalar or 1D tensor of size 1");
-    b_offset = *(b_zero_point->Data<int8_t>());
-  }
+Status ComputeMatMulInteger(const CudaKernel* kernel, OpKernelContext* ctx, const int8_t* a_ptr, const int8_t* b_ptr,
+                            int8_t a_offset, int8_t b_offset, const MatMulComputeHelper& helper, int32_t* output_ptr) {
+  cudaStream_t stream = kernel->Stream(ctx);
 
   // offset output c[i,j] to
   // k*a_offset*b_offset -
@@ -69,20 +48,20 @@ Status MatMulInteger<int8_t, int8_t>::ComputeInternal(OpKernelContext* ctx) cons
   // OffsetOutput computes gets the final result
   IAllocatorUniquePtr<int32_t> a_row_buf;
   if (b_offset != 0) {
-    a_row_buf = GetScratchBuffer<int32_t>(helper.OutputShape().Size() / helper.N(), ctx->GetComputeStream());
-    ORT_RETURN_IF_ERROR(ReduceRowSumOnMatrixA(Stream(ctx), a_ptr, a_row_buf.get(), b_offset, helper));
+    a_row_buf = kernel->GetScratchBuffer<int32_t>(helper.OutputShape().Size() / helper.N(), ctx->GetComputeStream());
+    ORT_RETURN_IF_ERROR(ReduceRowSumOnMatrixA(stream, a_ptr, a_row_buf.get(), b_offset, helper));
   }
 
   IAllocatorUniquePtr<int32_t> b_col_buf;
   if (a_offset != 0) {
-    b_col_buf = GetScratchBuffer<int32_t>(helper.OutputShape().Size() / helper.M(), ctx->GetComputeStream());
-    ORT_RETURN_IF_ERROR(ReduceColSumOnMatrixB(Stream(ctx), b_ptr, b_col_buf.get(), a_offset, helper));
+    b_col_buf = kernel->GetScratchBuffer<int32_t>(helper.OutputShape().Size() / helper.M(), ctx->GetComputeStream());
+    ORT_RETURN_IF_ERROR(ReduceColSumOnMatrixB(stream, b_ptr, b_col_buf.get(), a_offset, helper));
   }
 
   int alpha = 1;
   int beta = 0;
   if (a_offset != 0 || b_offset != 0) {
-    ORT_RETURN_IF_ERROR(OffsetOutput(Stream(ctx),
+    ORT_RETURN_IF_ERROR(OffsetOutput(stream,
                                      a_row_buf.get(),
                                      b_col_buf.get(),
                                      output_ptr,
@@ -104,12 +83,94 @@ Status MatMulInteger<int8_t, int8_t>::ComputeInternal(OpKernelContext* ctx) cons
                                  static_cast<int>(helper.N()),
                                  output_ptr + helper.OutputOffsets()[batch],
                                  static_cast<int>(helper.N()),
-                                 this,
+                                 kernel,
                                  ctx->GetComputeStream()));
   }
 
   return Status::OK();
 }
 
+template <>
+Status MatMulInteger<int8_t, int8_t>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                              bool& is_packed, PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+  if (input_idx == 1 && tensor.Shape().NumDimensions() == 2 &&
+      CanUseGemmInt8Lt(GetDeviceProp(), static_cast<int>(tensor.Shape()[1]), static_cast<int>(tensor.Shape()[0]))) {
+    ORT_RETURN_IF_ERROR(TransposeMatrixB(GetDeviceProp(), nullptr, DefaultCublasHandle(), tensor, alloc,
+                                         b_transposed_));
+    // b is released after PrePack, so wait for the transpose on the default stream
+    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(nullptr));
+    b_shape_ = tensor.Shape();
+    is_packed = true;
+  }
+  return Status::OK();
+}
+
+template <>
+Status MatMulInteger<int8_t, int8_t>::ComputeInternal(OpKernelContext* ctx) const {
+  auto a = ctx->Input<Tensor>(0);
+  auto b = b_transposed_ ? nullptr : ctx->Input<Tensor>(1);
+  ORT_ENFORCE(a != nullptr && (b != nullptr || b_transposed_));
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b ? b->Shape() : b_shape_));
+  Tensor* Y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (Y->Shape().Size() == 0)
+    return Status::OK();
+
+  const int8_t* a_ptr = a->Data<int8_t>();
+  int32_t* output_ptr = Y->MutableData<int32_t>();
+
+  // validate zero points
+  int8_t a_offset = 0;
+  int8_t b_offset = 0;
+  if (has_a_zero_point_) {
+    auto a_zero_point = ctx->Input<Tensor>(2);
+    ORT_ENFORCE(IsScalarOr1ElementVector(a_zero_point),
+                "MatmulInteger : input1 zero point must be a scalar or 1D tensor of size 1");
+    a_offset = *(a_zero_point->Data<int8_t>());
+  }
+  if (has_b_zero_point_) {
+    auto b_zero_point = ctx->Input<Tensor>(3);
+    ORT_ENFORCE(IsScalarOr1ElementVector(b_zero_point),
+                "MatmulInteger : input2 zero point must be a scalar or 1D tensor of size 1");
+    b_offset = *(b_zero_point->Data<int8_t>());
+  }
+
+  if (b == nullptr) {
+    // the 2D b is shared by all the batches of a, so they are folded into the rows of a single IMMA GEMM
+    const int m = static_cast<int>(helper.OutputShape().Size() / helper.N());
+    const int n = static_cast<int>(helper.N());
+    const int k = static_cast<int>(helper.K());
+    const int8_t* b_transposed_ptr = b_transposed_->Data<int8_t>();
+
+    IAllocatorUniquePtr<int32_t> a_row_buf;
+    if (b_offset != 0) {
+      a_row_buf = GetScratchBuffer<int32_t>(m, ctx->GetComputeStream());
+      ORT_RETURN_IF_ERROR(ReduceRowSumOnMatrixA(Stream(ctx), a_ptr, a_row_buf.get(), b_offset, helper));
+    }
+
+    // the column sums of b are the row sums of its transpose
+    IAllocatorUniquePtr<int32_t> b_col_buf;
+    if (a_offset != 0) {
+      b_col_buf = GetScratchBuffer<int32_t>(n, ctx->GetComputeStream());
+      ORT_RETURN_IF_ERROR(ReduceRowSumOnMatrix(Stream(ctx), b_transposed_ptr, b_col_buf.get(), a_offset, n, k));
+    }
+
+    int beta = 0;
+    if (a_offset != 0 || b_offset != 0) {
+      ORT_RETURN_IF_ERROR(OffsetOutput(Stream(ctx), a_row_buf.get(), b_col_buf.get(), output_ptr,
+                                       a_offset, b_offset, m, n, k));
+      beta = 1;
+    }
+
+    return GemmInt8Lt(m, n, k, 1, beta, a_ptr, b_transposed_ptr, output_ptr, this, ctx->GetComputeStream());
+  }
+
+  return ComputeMatMulInteger(this, ctx, a_ptr, b->Data<int8_t>(), a_offset, b_offset, helper, output_ptr);
+}
+
 }  // namespace cuda
 }  // namespace onnxruntime
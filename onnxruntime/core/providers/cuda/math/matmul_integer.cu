@@ -37,6 +37,14 @@ Status ReduceRowSumOnMatrixA(cudaStream_t stream, const int8_t* matrix, int32_t*
   return CUDA_CALL(cudaGetLastError());
 }
 
+Status ReduceRowSumOnMatrix(cudaStream_t stream, const int8_t* matrix, int32_t* row_sum, const int8_t offset,
+                            int rows, int cols) {
+  ReduceRowSumOnMatrixAKernel<static_cast<int>(GridDim::maxThreadsPerBlock)>
+      <<<rows, GridDim::maxThreadsPerBlock, 0, stream>>>(matrix, row_sum, offset, cols);
+
+  return CUDA_CALL(cudaGetLastError());
+}
+
 template <int TPB>
 __global__ void ReduceColSumOnMatrixBKernel(const int8_t* matrix, int32_t* col_sum, const int8_t offset, int32_t row, int32_t col) {
   int32_t thread_data = 0;
@@ -99,30 +107,86 @@ Status OffsetOutput(cudaStream_t stream,
                     const int8_t a_offset,
                     const int8_t b_offset,
                     const MatMulComputeHelper& helper) {
+  for (size_t batch = 0; batch < helper.OutputOffsets().size(); batch++) {
+    ORT_RETURN_IF_ERROR(OffsetOutput(stream,
+                                     b_offset ? row_sum + batch * helper.M() : nullptr,
+                                     a_offset ? col_sum + batch * helper.N() : nullptr,
+                                     output + helper.OutputOffsets()[batch],
+                                     a_offset,
+                                     b_offset,
+                                     static_cast<int>(helper.M()),
+                                     static_cast<int>(helper.N()),
+                                     static_cast<int>(helper.K())));
+  }
+
+  return Status::OK();
+}
+
+Status OffsetOutput(cudaStream_t stream,
+                    const int32_t* row_sum,
+                    const int32_t* col_sum,
+                    int32_t* output,
+                    const int8_t a_offset,
+                    const int8_t b_offset,
+                    int m,
+                    int n,
+                    int k) {
   if (a_offset && b_offset) {
-    for (size_t batch = 0; batch < helper.OutputOffsets().size(); batch++) {
-      ComputeOffsetOfMatrixAB<<<static_cast<int>(helper.M()), GridDim::maxThreadsPerBlock, 0, stream>>>(
-          row_sum + batch * helper.M(),
-          col_sum + batch * helper.N(),
-          output + helper.OutputOffsets()[batch],
-          static_cast<int32_t>(helper.K()) * a_offset * b_offset,
-          static_cast<int32_t>(helper.N()));
-    }
+    ComputeOffsetOfMatrixAB<<<m, GridDim::maxThreadsPerBlock, 0, stream>>>(row_sum, col_sum, output,
+                                                                          k * a_offset * b_offset, n);
   } else if (a_offset) {
-    for (size_t batch = 0; batch < helper.OutputOffsets().size(); batch++) {
-      ComputeOffsetOfMatrixA<<<static_cast<int>(helper.M()), GridDim::maxThreadsPerBlock, 0, stream>>>(
-          col_sum + batch * helper.N(),
-          output + helper.OutputOffsets()[batch],
-          static_cast<int32_t>(helper.N()));
-    }
+    ComputeOffsetOfMatrixA<<<m, GridDim::maxThreadsPerBlock, 0, stream>>>(col_sum, output, n);
   } else if (b_offset) {
-    for (size_t batch = 0; batch < helper.OutputOffsets().size(); batch++) {
-      ComputeOffsetOfMatrixB<<<static_cast<int>(helper.M()), GridDim::maxThreadsPerBlock, 0, stream>>>(
-          row_sum + batch * helper.M(),
-          output + helper.OutputOffsets()[batch],
-          static_cast<int32_t>(helper.N()));
-    }
+    ComputeOffsetOfMatrixB<<<m, GridDim::maxThreadsPerBlock, 0, stream>>>(row_sum, output, n);
+  }
+
+  return CUDA_CALL(cudaGetLastError());
+}
+
+template <int TPB>
+__global__ void ComputeQLinearMatMulBiasKernel(const int8_t* b_transposed, float* bias, int32_t K, float scale,
+                                               int32_t K_A_B, int32_t a_offset, float y_offset) {
+  int32_t thread_data = 0;
+  const int8_t* row_ptr = b_transposed + blockIdx.x * K;
+  for (int i = threadIdx.x; i < K; i += TPB) {
+    thread_data += *(row_ptr + i);
+  }
+
+  using BlockReduce = cub::BlockReduce<int32_t, TPB>;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+  int32_t sum = BlockReduce(temp_storage).Sum(thread_data);
+
+  if (threadIdx.x == 0) {
+    bias[blockIdx.x] = scale * static_cast<float>(K_A_B - a_offset * sum) + y_offset;
   }
+}
+
+Status ComputeQLinearMatMulBias(cudaStream_t stream, const int8_t* b_transposed, float* bias, int n, int k,
+                                float scale, const int8_t a_offset, const int8_t b_offset, const int8_t y_offset) {
+  ComputeQLinearMatMulBiasKernel<static_cast<int>(GridDim::maxThreadsPerBlock)>
+      <<<n, GridDim::maxThreadsPerBlock, 0, stream>>>(b_transposed, bias, k, scale, k * a_offset * b_offset,
+                                                      a_offset, static_cast<float>(y_offset));
+
+  return CUDA_CALL(cudaGetLastError());
+}
+
+__global__ void RequantizeOutputKernel(const int32_t* input, const int32_t* row_offset, const float* bias,
+                                       int8_t* output, int32_t N, float scale, float zero_point, CUDA_LONG count) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, count);
+
+  const int32_t row = id / N;
+  const int32_t col = id - row * N;
+  const int32_t value = input[id] - (row_offset != nullptr ? row_offset[row] : 0);
+  const float y = rintf(scale * static_cast<float>(value) + (bias != nullptr ? bias[col] : zero_point));
+  output[id] = static_cast<int8_t>(fminf(fmaxf(y, -128.0f), 127.0f));
+}
+
+Status RequantizeOutput(cudaStream_t stream, const int32_t* input, const int32_t* row_offset, const float* bias,
+                        int8_t* output, int m, int n, float scale, const int8_t zero_point) {
+  const CUDA_LONG count = static_cast<CUDA_LONG>(m) * n;
+  const int blocks = static_cast<int>(CeilDiv(count, GridDim::maxThreadsPerBlock));
+  RequantizeOutputKernel<<<blocks, GridDim::maxThreadsPerBlock, 0, stream>>>(
+      input, row_offset, bias, output, n, scale, static_cast<float>(zero_point), count);
 
   return CUDA_CALL(cudaGetLastError());
 }
@@ -21,5 +21,32 @@ Status OffsetOutput(cudaStream_t stream,
                     const int8_t b_offset,
                     const MatMulComputeHelper& helper);
 
+// Computes offset * the row sums of a row major [rows, cols] matrix.
+Status ReduceRowSumOnMatrix(cudaStream_t stream, const int8_t* matrix, int32_t* row_sum, const int8_t offset,
+                            int rows, int cols);
+
+// Initializes the row major [m, n] output of a single [m, k] x [k, n] GEMM with the zero point adjustment.
+Status OffsetOutput(cudaStream_t stream,
+                    const int32_t* row_sum,
+                    const int32_t* col_sum,
+                    int32_t* output,
+                    const int8_t a_offset,
+                    const int8_t b_offset,
+                    int m,
+                    int n,
+                    int k);
+
+// Computes the per column bias that requantizes the int32 product of a and b to the y quantization together with
+// the zero point adjustment of the a and b offsets that does not depend on the row,
+// bias[j] = scale * (k * a_offset * b_offset - a_offset * sum(b[:, j])) + y_offset, for b given as its row major
+// [n, k] transpose.
+Status ComputeQLinearMatMulBias(cudaStream_t stream, const int8_t* b_transposed, float* bias, int n, int k,
+                                float scale, const int8_t a_offset, const int8_t b_offset, const int8_t y_offset);
+
+// Requantizes a row major [m, n] int32 product, output[i, j] = saturate(round(scale * (input[i, j] - row_offset[i]) +
+// bias[j])). The row offsets are optional and without a bias the zero point is added instead.
+Status RequantizeOutput(cudaStream_t stream, const int32_t* input, const int32_t* row_offset, const float* bias,
+                        int8_t* output, int m, int n, float scale, const int8_t zero_point);
+
 }  // namespace cuda
 }  // namespace onnxruntime
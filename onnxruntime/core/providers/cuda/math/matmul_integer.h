@@ -4,9 +4,20 @@
 #pragma once
 
 #include "core/providers/cuda/cuda_kernel.h"
+#include "core/providers/cpu/math/matmul_helper.h"
 
 namespace onnxruntime {
 namespace cuda {
+
+// Transposes a 2D b to the row major [n, k] layout of the cuBLASLt IMMA kernels.
+Status TransposeMatrixB(const cudaDeviceProp& prop, cudaStream_t stream, cublasHandle_t cublas_handle,
+                        const Tensor& b, AllocatorPtr alloc, std::unique_ptr<Tensor>& b_transposed);
+
+// Computes the int32 product of a and b adjusted for the zero points with one GEMM per batch of the helper.
+Status ComputeMatMulInteger(const CudaKernel* kernel, OpKernelContext* ctx, const int8_t* a, const int8_t* b,
+                            int8_t a_offset, int8_t b_offset, const MatMulComputeHelper& helper, int32_t* output);
+
+// A constant 2D b is transposed once by PrePack when the cuBLASLt IMMA kernels can multiply it.
 template <typename T1, typename T2>
 class MatMulInteger final : public CudaKernel {
   using Base = CudaKernel;
@@ -25,9 +36,14 @@ class MatMulInteger final : public CudaKernel {
 
   Status ComputeInternal(OpKernelContext* context) const override;
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 bool& is_packed, PrePackedWeights* prepacked_weights) override;
+
  private:
   bool has_a_zero_point_;
   bool has_b_zero_point_;
+  std::unique_ptr<Tensor> b_transposed_;
+  TensorShape b_shape_;
 };
 
 }  // namespace cuda
@@ -0,0 +1,123 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "quantize_linear_matmul.h"
+#include "matmul_integer.h"
+#include "matmul_integer.cuh"
+#include "core/providers/cpu/math/matmul_helper.h"
+#include "core/providers/cuda/shared_inc/integer_gemm.h"
+#include "core/providers/common.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+ONNX_OPERATOR_TYPED_KERNEL_EX(
+    QLinearMatMul,
+    kOnnxDomain,
+    10,
+    int8_t,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .InputMemoryType(OrtMemTypeCPUInput, QLinearMatMul::IN_A_SCALE)
+        .InputMemoryType(OrtMemTypeCPUInput, QLinearMatMul::IN_A_ZERO_POINT)
+        .InputMemoryType(OrtMemTypeCPUInput, QLinearMatMul::IN_B_SCALE)
+        .InputMemoryType(OrtMemTypeCPUInput, QLinearMatMul::IN_B_ZERO_POINT)
+        .InputMemoryType(OrtMemTypeCPUInput, QLinearMatMul::IN_Y_SCALE)
+        .InputMemoryType(OrtMemTypeCPUInput, QLinearMatMul::IN_Y_ZERO_POINT)
+        .TypeConstraint("T1", DataTypeImpl::GetTensorType<int8_t>())
+        .TypeConstraint("T2", DataTypeImpl::GetTensorType<int8_t>())
+        .TypeConstraint("T3", DataTypeImpl::GetTensorType<int8_t>()),
+    QLinearMatMul);
+
+Status QLinearMatMul::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                              bool& is_packed, PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+  if (input_idx == IN_B && tensor.Shape().NumDimensions() == 2 &&
+      CanUseGemmInt8Lt(GetDeviceProp(), static_cast<int>(tensor.Shape()[1]), static_cast<int>(tensor.Shape()[0]))) {
+    ORT_RETURN_IF_ERROR(TransposeMatrixB(GetDeviceProp(), nullptr, DefaultCublasHandle(), tensor, alloc,
+                                         b_transposed_));
+    // b is released after PrePack, so wait for the transpose on the default stream
+    CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(nullptr));
+    b_shape_ = tensor.Shape();
+    is_packed = true;
+  }
+  return Status::OK();
+}
+
+Status QLinearMatMul::ComputeInternal(OpKernelContext* ctx) const {
+  const auto* a = ctx->Input<Tensor>(IN_A);
+  const auto* b = b_transposed_ ? nullptr : ctx->Input<Tensor>(IN_B);
+
+  const auto* a_scale = ctx->Input<Tensor>(IN_A_SCALE);
+  const auto* a_zero_point = ctx->Input<Tensor>(IN_A_ZERO_POINT);
+  const auto* b_scale = ctx->Input<Tensor>(IN_B_SCALE);
+  const auto* b_zero_point = ctx->Input<Tensor>(IN_B_ZERO_POINT);
+  const auto* y_scale = ctx->Input<Tensor>(IN_Y_SCALE);
+  const auto* y_zero_point = ctx->Input<Tensor>(IN_Y_ZERO_POINT);
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(a_scale) && IsScalarOr1ElementVector(a_zero_point),
+                    "QLinearMatMul : input scale and zero point must be a scalar or 1D tensor of size 1");
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(b_scale) && IsScalarOr1ElementVector(b_zero_point),
+                    "QLinearMatMul : the CUDA kernel only supports a per tensor weight scale and zero point");
+  ORT_RETURN_IF_NOT(IsScalarOr1ElementVector(y_scale) && IsScalarOr1ElementVector(y_zero_point),
+                    "QLinearMatMul : result scale and zero point must be a scalar or 1D tensor of size 1");
+
+  MatMulComputeHelper helper;
+  ORT_RETURN_IF_ERROR(helper.Compute(a->Shape(), b ? b->Shape() : b_shape_));
+  Tensor* y = ctx->Output(0, helper.OutputShape());
+
+  // Bail out early if the output is going to be empty
+  if (y->Shape().Size() == 0)
+    return Status::OK();
+
+  const int8_t a_offset = *(a_zero_point->Data<int8_t>());
+  const int8_t b_offset = *(b_zero_point->Data<int8_t>());
+  const int8_t y_offset = *(y_zero_point->Data<int8_t>());
+  const float scale = *(a_scale->Data<float>()) * *(b_scale->Data<float>()) / *(y_scale->Data<float>());
+
+  const int8_t* a_ptr = a->Data<int8_t>();
+  int8_t* y_ptr = y->MutableData<int8_t>();
+  const int m = static_cast<int>(helper.OutputShape().Size() / helper.N());
+  const int n = static_cast<int>(helper.N());
+  const int k = static_cast<int>(helper.K());
+
+  const bool use_lt = b == nullptr || (b->Shape().NumDimensions() == 2 && CanUseGemmInt8Lt(GetDeviceProp(), n, k));
+  if (!use_lt) {
+    IAllocatorUniquePtr<int32_t> product = GetScratchBuffer<int32_t>(static_cast<size_t>(m) * n,
+                                                                     ctx->GetComputeStream());
+    ORT_RETURN_IF_ERROR(ComputeMatMulInteger(this, ctx, a_ptr, b->Data<int8_t>(), a_offset, b_offset, helper,
+                                             product.get()));
+    return RequantizeOutput(Stream(ctx), product.get(), nullptr, nullptr, y_ptr, m, n, scale, y_offset);
+  }
+
+  // the 2D b is shared by all the batches of a, so they are folded into the rows of a single IMMA GEMM
+  std::unique_ptr<Tensor> b_transposed;
+  if (b != nullptr) {
+    AllocatorPtr alloc;
+    ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
+    ORT_RETURN_IF_ERROR(TransposeMatrixB(GetDeviceProp(), Stream(ctx), GetCublasHandle(ctx), *b, alloc,
+                                         b_transposed));
+  }
+  const int8_t* b_transposed_ptr = b != nullptr ? b_transposed->Data<int8_t>() : b_transposed_->Data<int8_t>();
+
+  IAllocatorUniquePtr<float> bias = GetScratchBuffer<float>(n, ctx->GetComputeStream());
+  ORT_RETURN_IF_ERROR(ComputeQLinearMatMulBias(Stream(ctx), b_transposed_ptr, bias.get(), n, k, scale,
+                                               a_offset, b_offset, y_offset));
+
+  if (b_offset == 0) {
+    return GemmInt8LtQuantized(m, n, k, scale, bias.get(), a_ptr, b_transposed_ptr, y_ptr, this,
+                               ctx->GetComputeStream());
+  }
+
+  // the b zero point adjusts every row by a different amount, which the epilogue bias cannot express
+  IAllocatorUniquePtr<int32_t> a_row_buf = GetScratchBuffer<int32_t>(m, ctx->GetComputeStream());
+  ORT_RETURN_IF_ERROR(ReduceRowSumOnMatrixA(Stream(ctx), a_ptr, a_row_buf.get(), b_offset, helper));
+
+  IAllocatorUniquePtr<int32_t> product = GetScratchBuffer<int32_t>(static_cast<size_t>(m) * n,
+                                                                   ctx->GetComputeStream());
+  ORT_RETURN_IF_ERROR(GemmInt8Lt(m, n, k, 1, 0, a_ptr, b_transposed_ptr, product.get(), this,
+                                 ctx->GetComputeStream()));
+  return RequantizeOutput(Stream(ctx), product.get(), a_row_buf.get(), bias.get(), y_ptr, m, n, scale, y_offset);
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// QLinearMatMul with per tensor quantization. A 2D b is multiplied by the cuBLASLt IMMA kernels in its transposed
+// layout, which PrePack computes once for a constant b, and without a b zero point the zero point adjustment and
+// the requantization are done by the GEMM epilogue.
+class QLinearMatMul final : public CudaKernel {
+ public:
+  QLinearMatMul(const OpKernelInfo& info) : CudaKernel(info) {}
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 bool& is_packed, PrePackedWeights* prepacked_weights) override;
+
+  enum InputTensors : int {
+    IN_A = 0,
+    IN_A_SCALE = 1,
+    IN_A_ZERO_POINT = 2,
+    IN_B = 3,
+    IN_B_SCALE = 4,
+    IN_B_ZERO_POINT = 5,
+    IN_Y_SCALE = 6,
+    IN_Y_ZERO_POINT = 7
+  };
+
+ private:
+  std::unique_ptr<Tensor> b_transposed_;
+  TensorShape b_shape_;
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -52,8 +52,49 @@ namespace cuda {
           .TypeConstraint("T2", DataTypeImpl::GetTensorType<T>()), \
       BatchNorm<T>);
 
-template <typename T>
-Status BatchNorm<T>::ComputeInternal(OpKernelContext* p_op_kernel_context) const {
+#define REGISTER_KERNEL_TYPED_NHWC(T)                              \
+  ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                         \
+      BatchNormalization,                                          \
+      kMSInternalNHWCDomain,                                       \
+      7, 8,                                                        \
+      T,                                                           \
+      kCudaExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),  \
+      BatchNorm<T, true>);                                         \
+  ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                         \
+      BatchNormalization,                                          \
+      kMSInternalNHWCDomain,                                       \
+      9, 13,                                                       \
+      T,                                                           \
+      kCudaExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>()),  \
+      BatchNorm<T, true>);                                         \
+  ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                         \
+      BatchNormalization,                                          \
+      kMSInternalNHWCDomain,                                       \
+      14, 14,                                                      \
+      T,                                                           \
+      kCudaExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())   \
+          .TypeConstraint("U", DataTypeImpl::GetTensorType<T>()),  \
+      BatchNorm<T, true>);                                         \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                   \
+      BatchNormalization,                                          \
+      kMSInternalNHWCDomain,                                       \
+      15,                                                          \
+      T,                                                           \
+      kCudaExecutionProvider,                                      \
+      (*KernelDefBuilder::Create())                                \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<T>())   \
+          .TypeConstraint("T1", DataTypeImpl::GetTensorType<T>())  \
+          .TypeConstraint("T2", DataTypeImpl::GetTensorType<T>()), \
+      BatchNorm<T, true>);
+
+template <typename T, bool NHWC>
+Status BatchNorm<T, NHWC>::ComputeInternal(OpKernelContext* p_op_kernel_context) const {
   typedef typename ToCudaType<T>::MappedType CudaT;
 
   const Tensor* X = p_op_kernel_context->Input<Tensor>(0);
@@ -62,12 +103,13 @@ Status BatchNorm<T>::ComputeInternal(OpKernelContext* p_op_kernel_context) const
   const Tensor* mean = p_op_kernel_context->Input<Tensor>(3);
   const Tensor* var = p_op_kernel_context->Input<Tensor>(4);
 
-  ORT_RETURN_IF_ERROR(BatchNormHelper::ValidateInputs(X, scale, B, mean, var, spatial_ == 1));
+  ORT_RETURN_IF_ERROR(BatchNormHelper::ValidateInputs(X, scale, B, mean, var, spatial_ == 1, NHWC));
 
-  const TensorShape& x_shape = X->Shape();
+  // The dims are normalized in the NCHW order, the cuDNN descriptor gives the channels last layout for NHWC.
+  const TensorShape x_shape = NHWC ? TensorShape(ChannelsLastToFirstDims(X->Shape().GetDims())) : X->Shape();
   const TensorShape& channel_shape = mean->Shape();
 
-  Tensor* Y = p_op_kernel_context->Output(0, x_shape);
+  Tensor* Y = p_op_kernel_context->Output(0, X->Shape());
   Tensor* running_mean = p_op_kernel_context->Output(1, channel_shape);
   Tensor* running_var = p_op_kernel_context->Output(2, channel_shape);
   Tensor* saved_mean = p_op_kernel_context->Output(3, channel_shape);
@@ -87,7 +129,7 @@ Status BatchNorm<T>::ComputeInternal(OpKernelContext* p_op_kernel_context) const
   CudnnTensor data_desc;
   vector<int64_t> new_dims;
   BatchNormHelper::NormalizeDims(x_shape, new_dims);
-  ORT_RETURN_IF_ERROR(data_desc.Set(new_dims, CudnnTensor::GetDataType<CudaT>()));
+  ORT_RETURN_IF_ERROR(data_desc.Set(new_dims, CudnnTensor::GetDataType<CudaT>(), NHWC));
 
   // For half data type, the alpha, beta, scale, B, mean, var need to be float type
   if (X->IsDataType<MLFloat16>()) {
@@ -179,9 +221,15 @@ Status BatchNorm<T>::ComputeInternal(OpKernelContext* p_op_kernel_context) const
   REGISTER_KERNEL_TYPED(T)     \
   template Status BatchNorm<T>::ComputeInternal(OpKernelContext* ctx) const;
 
+#define SPECIALIZED_COMPUTE_NHWC(T) \
+  REGISTER_KERNEL_TYPED_NHWC(T)     \
+  template Status BatchNorm<T, true>::ComputeInternal(OpKernelContext* ctx) const;
+
 SPECIALIZED_COMPUTE(float)
 SPECIALIZED_COMPUTE(double)
 SPECIALIZED_COMPUTE(MLFloat16)
+SPECIALIZED_COMPUTE_NHWC(float)
+SPECIALIZED_COMPUTE_NHWC(MLFloat16)
 
 }  // namespace cuda
 }  // namespace onnxruntime
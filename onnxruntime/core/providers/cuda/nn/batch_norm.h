@@ -9,7 +9,8 @@
 namespace onnxruntime {
 namespace cuda {
 
-template <typename T>
+// If NHWC is true, the input and output are in the channels last layout of the kMSInternalNHWCDomain op.
+template <typename T, bool NHWC = false>
 class BatchNorm final : public CudaKernel {
  public:
   BatchNorm(const OpKernelInfo& op_kernel_info)
@@ -27,6 +28,8 @@ class BatchNorm final : public CudaKernel {
     }
 
     if (spatial_ == 0) {
+      // the scale, B, mean and var inputs of the non spatial form are not converted by the layout transformer
+      ORT_ENFORCE(!NHWC, "BatchNormalization in the NHWC layout requires spatial to be 1.");
       cudnn_batch_norm_mode_ = CUDNN_BATCHNORM_PER_ACTIVATION;
     }
 
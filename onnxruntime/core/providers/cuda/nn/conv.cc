@@ -6,6 +6,9 @@
 #include "core/providers/cuda/cuda_common.h"
 #include "core/providers/cuda/shared_inc/fpgeneric.h"
 #include "core/providers/cuda/tensor/slice.h"
+#include "core/providers/cuda/tensor/transpose.h"
+
+#include <sstream>
 
 namespace onnxruntime {
 namespace cuda {
@@ -30,12 +33,32 @@ namespace cuda {
       (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
       Conv<T>);
 
+#define REGISTER_KERNEL_TYPED_NHWC(T)                                                      \
+  ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                                                 \
+      Conv,                                                                                \
+      kMSInternalNHWCDomain,                                                               \
+      1, 10,                                                                               \
+      T,                                                                                   \
+      kCudaExecutionProvider,                                                              \
+      (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      Conv<T, true>);                                                                      \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                           \
+      Conv,                                                                                \
+      kMSInternalNHWCDomain,                                                               \
+      11,                                                                                  \
+      T,                                                                                   \
+      kCudaExecutionProvider,                                                              \
+      (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      Conv<T, true>);
+
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
 REGISTER_KERNEL_TYPED(MLFloat16)
+REGISTER_KERNEL_TYPED_NHWC(float)
+REGISTER_KERNEL_TYPED_NHWC(MLFloat16)
 
-template <typename T>
-const cudnnConvolutionFwdAlgo_t Conv<T>::kAllAlgos[] = {
+template <typename T, bool NHWC>
+const cudnnConvolutionFwdAlgo_t Conv<T, NHWC>::kAllAlgos[] = {
     CUDNN_CONVOLUTION_FWD_ALGO_GEMM,
     CUDNN_CONVOLUTION_FWD_ALGO_FFT,
     CUDNN_CONVOLUTION_FWD_ALGO_FFT_TILING,
@@ -68,6 +91,31 @@ size_t GetMaxWorkspaceSize(cudnnHandle_t handle, const CudnnConvState<cudnnConvo
   return max_ws_size;
 }
 
+std::string CudnnConvAlgoCacheKey(cudnnDataType_t data_type,
+                                  gsl::span<const int64_t> x_dims,
+                                  gsl::span<const int64_t> w_dims,
+                                  gsl::span<const int64_t> pads,
+                                  gsl::span<const int64_t> strides,
+                                  gsl::span<const int64_t> dilations,
+                                  int64_t group,
+                                  bool use_max_workspace) {
+  std::ostringstream key;
+  auto append_dims = [&key](const char* name, gsl::span<const int64_t> dims) {
+    key << '_' << name;
+    for (auto dim : dims) {
+      key << '_' << dim;
+    }
+  };
+  key << "type_" << static_cast<int>(data_type);
+  append_dims("x", x_dims);
+  append_dims("w", w_dims);
+  append_dims("pads", pads);
+  append_dims("strides", strides);
+  append_dims("dilations", dilations);
+  key << "_group_" << group << "_maxws_" << use_max_workspace;
+  return key.str();
+}
+
 Status SliceOutUnwantedOutputSection(cudaStream_t stream,
                                      const void* input_data, gsl::span<const int64_t> input_dims,
                                      void* output_data,
@@ -86,17 +134,65 @@ Status SliceOutUnwantedOutputSection(cudaStream_t stream,
   return SliceCuda::Impl(stream, input_data, input_dims, output_data, compute_metadata, element_size);
 }
 
-template <typename T>
-Status Conv<T>::UpdateState(OpKernelContext* context, bool bias_expected) const {
+Status TransposeFilterToChannelsLast(const cudaDeviceProp& prop, cudaStream_t stream, cublasHandle_t cublas_handle,
+                                     const Tensor& filter, AllocatorPtr alloc, std::unique_ptr<Tensor>& output) {
+  const size_t rank = filter.Shape().NumDimensions();
+  ORT_RETURN_IF_NOT(rank > 2, "The filter must have spatial dims, got rank ", rank);
+  InlinedVector<size_t> perm(rank);
+  perm[0] = 0;
+  for (size_t i = 1; i + 1 < rank; i++) {
+    perm[i] = i + 1;
+  }
+  perm[rank - 1] = 1;
+  output = Tensor::Create(filter.DataType(), TensorShape(ChannelsFirstToLastDims(filter.Shape().GetDims())),
+                          std::move(alloc));
+  return Transpose::DoTranspose(prop, stream, cublas_handle, perm, filter, *output);
+}
+
+template <typename T, bool NHWC>
+Status Conv<T, NHWC>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                              bool& is_packed, PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+  if constexpr (NHWC) {
+    if (input_idx == 1) {
+      ORT_RETURN_IF_ERROR(TransposeFilterToChannelsLast(GetDeviceProp(), nullptr, DefaultCublasHandle(), tensor,
+                                                        alloc, W_));
+      // the filter is released after PrePack, so wait for the transpose on the default stream
+      CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(nullptr));
+      is_W_packed_ = true;
+      is_packed = true;
+    }
+  } else {
+    ORT_UNUSED_PARAMETER(tensor);
+    ORT_UNUSED_PARAMETER(input_idx);
+    ORT_UNUSED_PARAMETER(alloc);
+  }
+  return Status::OK();
+}
+
+template <typename T, bool NHWC>
+Status Conv<T, NHWC>::UpdateState(OpKernelContext* context, bool bias_expected) const {
   //set X
   const Tensor* X = context->Input<Tensor>(0);
-  const TensorShape& x_shape = X->Shape();
+  // The dims are in the NCHW order. With NHWC the cuDNN descriptors describe the channels last layout of the data.
+  const TensorShape x_shape = NHWC ? TensorShape(ChannelsLastToFirstDims(X->Shape().GetDims())) : X->Shape();
   const auto x_dims = x_shape.AsShapeVector();
   s_.x_data = reinterpret_cast<const CudaT*>(X->Data<T>());
   s_.element_size = X->DataType()->Size();
   // set W
-  const Tensor* W = context->Input<Tensor>(1);
-  const TensorShape& w_shape = W->Shape();
+  const Tensor* W = nullptr;
+  if constexpr (NHWC) {
+    if (!is_W_packed_) {
+      AllocatorPtr alloc;
+      ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+      ORT_RETURN_IF_ERROR(TransposeFilterToChannelsLast(GetDeviceProp(), Stream(context), GetCublasHandle(context),
+                                                        *context->Input<Tensor>(1), alloc, W_));
+    }
+    W = W_.get();
+  } else {
+    W = context->Input<Tensor>(1);
+  }
+  const TensorShape w_shape = NHWC ? TensorShape(ChannelsLastToFirstDims(W->Shape().GetDims())) : W->Shape();
   auto w_dims = w_shape.AsShapeVector();
   s_.w_data = reinterpret_cast<const CudaT*>(W->Data<T>());
   // set B
@@ -125,13 +221,13 @@ Status Conv<T>::UpdateState(OpKernelContext* context, bool bias_expected) const
       s_.cached_benchmark_results.clear();
     }
 
-    const int64_t N = X->Shape()[0];
-    const int64_t M = W->Shape()[0];
+    const int64_t N = x_shape[0];
+    const int64_t M = w_shape[0];
 
-    ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(X, W));
+    ORT_RETURN_IF_ERROR(conv_attrs_.ValidateInputShape(x_shape, w_shape));
 
     TensorShapeVector kernel_shape;
-    ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(W->Shape(), kernel_shape));
+    ORT_RETURN_IF_ERROR(conv_attrs_.ComputeKernelShape(w_shape, kernel_shape));
     auto rank = kernel_shape.size();
     ConvPadVector pads(conv_attrs_.pads);
     if (pads.empty()) {
@@ -168,12 +264,22 @@ Status Conv<T>::UpdateState(OpKernelContext* context, bool bias_expected) const
                                                                      strides, dilations, pads, y_dims, y_dims_with_adjusted_pads,
                                                                      post_slicing_required, slice_starts, slice_ends, slice_axes));
     ORT_ENFORCE(y_dims.size() == y_dims_with_adjusted_pads.size());
-    s_.y_dims = gsl::make_span(y_dims);
-    s_.y_dims_with_adjusted_pads = y_dims_with_adjusted_pads;
     s_.post_slicing_required = post_slicing_required;
     s_.slice_starts = slice_starts;
     s_.slice_ends = slice_ends;
-    s_.slice_axes = slice_axes;
+    if constexpr (NHWC) {
+      // the output and the slicing use the channels last dims
+      s_.y_dims = TensorShape(ChannelsFirstToLastDims(y_dims));
+      s_.y_dims_with_adjusted_pads = ChannelsFirstToLastDims(y_dims_with_adjusted_pads);
+      s_.slice_axes.clear();
+      for (auto axis : slice_axes) {
+        s_.slice_axes.push_back(axis - 1);
+      }
+    } else {
+      s_.y_dims = gsl::make_span(y_dims);
+      s_.y_dims_with_adjusted_pads = y_dims_with_adjusted_pads;
+      s_.slice_axes = slice_axes;
+    }
 
     s_.Y = context->Output(0, TensorShape(s_.y_dims));
     if (post_slicing_required) {
@@ -221,15 +327,15 @@ Status Conv<T>::UpdateState(OpKernelContext* context, bool bias_expected) const
     }
 
     if (w_dims_changed)
-      ORT_RETURN_IF_ERROR(s_.w_desc.Set(w_dims, CudnnTensor::GetDataType<CudaT>()));
+      ORT_RETURN_IF_ERROR(s_.w_desc.Set(w_dims, CudnnTensor::GetDataType<CudaT>(), NHWC));
 
     // We must delay returning early until here so that the weight dims have been cached properly
     if (s_.Y->Shape().Size() == 0) {
       return Status::OK();
     }
 
-    ORT_RETURN_IF_ERROR(s_.x_tensor.Set(x_dims_cudnn, CudnnTensor::GetDataType<CudaT>()));
-    ORT_RETURN_IF_ERROR(s_.y_tensor.Set(y_dims_cudnn, CudnnTensor::GetDataType<CudaT>()));
+    ORT_RETURN_IF_ERROR(s_.x_tensor.Set(x_dims_cudnn, CudnnTensor::GetDataType<CudaT>(), NHWC));
+    ORT_RETURN_IF_ERROR(s_.y_tensor.Set(y_dims_cudnn, CudnnTensor::GetDataType<CudaT>(), NHWC));
     ORT_RETURN_IF_ERROR(s_.conv_desc.Set(kernel_shape.size(), pads, strides, dilations,
                                          gsl::narrow_cast<int>(conv_attrs_.group),
                                          CUDNN_CROSS_CORRELATION, CudnnTensor::GetDataType<CudaT>()));
@@ -264,50 +370,73 @@ Status Conv<T>::UpdateState(OpKernelContext* context, bool bias_expected) const
       int algo_count = 1;
       int cudnn_conv_algo = cuda_ep->GetCudnnConvAlgo();
       ORT_ENFORCE(cudnn_conv_algo > -1 && cudnn_conv_algo < 3, "cudnn_conv_algo should be 0, 1 or 2, but got ", cudnn_conv_algo);
-      switch (cudnn_conv_algo) {
-        case 0: {
-          static constexpr int num_algos = CUDNN_CONVOLUTION_FWD_ALGO_COUNT;
-          size_t max_ws_size = cuda_ep->GetCudnnConvUseMaxWorkspace() ? GetMaxWorkspaceSize(GetCudnnHandle(context), s_, kAllAlgos, num_algos)
-                                                                      : AlgoSearchWorkspaceSize;
-          // Use GetTransientScratchBuffer() so the workspace can be freed instead of cached.
-          // Because the benchmarking uses a huge amount of memory, e.g. a few GBs.
-          IAllocatorUniquePtr<void> algo_search_workspace = GetTransientScratchBuffer<void>(max_ws_size);
-          CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionForwardAlgorithmEx(
-              GetCudnnHandle(context),
-              s_.x_tensor,
-              s_.x_data,
-              s_.w_desc,
-              s_.w_data,
-              s_.conv_desc,
-              s_.y_tensor,
-              s_.y_data,
-              1,            // requestedAlgoCount
-              &algo_count,  // returnedAlgoCount
-              &perf,
-              algo_search_workspace.get(),
-              max_ws_size));
-          break;
-        }
-        case 1:
-          CUDNN_RETURN_IF_ERROR(cudnnGetConvolutionForwardAlgorithm_v7(
-              GetCudnnHandle(context),
-              s_.x_tensor,
-              s_.w_desc,
-              s_.conv_desc,
-              s_.y_tensor,
-              1,            // requestedAlgoCount
-              &algo_count,  // returnedAlgoCount
-              &perf));
-          break;
-
-        default:
-          perf.algo = kDefaultConvAlgo;
-          CUDNN_RETURN_IF_ERROR(GetWorkspaceSize(GetCudnnHandle(context), s_, perf.algo, &perf.memory));
-          if (std::is_same<T, MLFloat16>::value) {
-            perf.mathType = CUDNN_TENSOR_OP_MATH;
-          } else {
-            perf.mathType = CUDNN_DEFAULT_MATH;
+
+      // The exhaustive search is expensive, so its result is looked up in and added to the algo cache that
+      // persists across sessions.
+      // the algos of the NHWC layout are cached apart from the NCHW ones of the same shapes
+      constexpr const char* kAlgoCacheOp = NHWC ? "CudnnConvFwdNhwc" : "CudnnConvFwd";
+      onnxruntime::tunable::TuningResults* algo_cache =
+          cudnn_conv_algo == 0 ? cuda_ep->GetCudnnConvAlgoCache() : nullptr;
+      std::string algo_cache_key;
+      int cached_algo = -1;
+      if (algo_cache != nullptr) {
+        algo_cache_key = CudnnConvAlgoCacheKey(CudnnTensor::GetDataType<CudaT>(), x_dims_cudnn, w_dims, pads, strides,
+                                               dilations, conv_attrs_.group, cuda_ep->GetCudnnConvUseMaxWorkspace());
+        cached_algo = algo_cache->Lookup(kAlgoCacheOp, algo_cache_key);
+      }
+
+      if (cached_algo >= 0) {
+        DecodeCudnnConvAlgo(cached_algo, perf.algo, perf.mathType);
+        CUDNN_RETURN_IF_ERROR(GetWorkspaceSize(GetCudnnHandle(context), s_, perf.algo, &perf.memory));
+      } else {
+        switch (cudnn_conv_algo) {
+          case 0: {
+            static constexpr int num_algos = CUDNN_CONVOLUTION_FWD_ALGO_COUNT;
+            size_t max_ws_size = cuda_ep->GetCudnnConvUseMaxWorkspace() ? GetMaxWorkspaceSize(GetCudnnHandle(context), s_, kAllAlgos, num_algos)
+                                                                        : AlgoSearchWorkspaceSize;
+            // Use GetTransientScratchBuffer() so the workspace can be freed instead of cached.
+            // Because the benchmarking uses a huge amount of memory, e.g. a few GBs.
+            IAllocatorUniquePtr<void> algo_search_workspace = GetTransientScratchBuffer<void>(max_ws_size);
+            CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionForwardAlgorithmEx(
+                GetCudnnHandle(context),
+                s_.x_tensor,
+                s_.x_data,
+                s_.w_desc,
+                s_.w_data,
+                s_.conv_desc,
+                s_.y_tensor,
+                s_.y_data,
+                1,            // requestedAlgoCount
+                &algo_count,  // returnedAlgoCount
+                &perf,
+                algo_search_workspace.get(),
+                max_ws_size));
+            if (algo_cache != nullptr) {
+              algo_cache->Add(kAlgoCacheOp, algo_cache_key, EncodeCudnnConvAlgo(perf.algo, perf.mathType));
+            }
+            break;
           }
+          case 1:
+            CUDNN_RETURN_IF_ERROR(cudnnGetConvolutionForwardAlgorithm_v7(
+                GetCudnnHandle(context),
+                s_.x_tensor,
+                s_.w_desc,
+                s_.conv_desc,
+                s_.y_tensor,
+                1,            // requestedAlgoCount
+                &algo_count,  // returnedAlgoCount
+                &perf));
+            break;
+
+          default:
+            perf.algo = kDefaultConvAlgo;
+            CUDNN_RETURN_IF_ERROR(GetWorkspaceSize(GetCudnnHandle(context), s_, perf.algo, &perf.memory));
+            if (std::is_same<T, MLFloat16>::value) {
+              perf.mathType = CUDNN_TENSOR_OP_MATH;
+            } else {
+              perf.mathType = CUDNN_DEFAULT_MATH;
+            }
+        }
       }
       s_.cached_benchmark_results.insert(x_dims_cudnn, {perf.algo, perf.memory, perf.mathType});
     }
@@ -331,8 +460,8 @@ Status Conv<T>::UpdateState(OpKernelContext* context, bool bias_expected) const
   return Status::OK();
 }
 
-template <typename T>
-Status Conv<T>::ComputeInternal(OpKernelContext* context) const {
+template <typename T, bool NHWC>
+Status Conv<T, NHWC>::ComputeInternal(OpKernelContext* context) const {
   std::lock_guard<OrtMutex> lock(s_.mutex);
   ORT_RETURN_IF_ERROR(UpdateState(context));
   if (s_.Y->Shape().Size() == 0) {
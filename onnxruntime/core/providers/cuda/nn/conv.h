@@ -8,6 +8,7 @@
 #include "core/providers/cuda/cudnn_common.h"
 #include "core/providers/cpu/nn/conv_attributes.h"
 #include <list>
+#include <string>
 
 namespace onnxruntime {
 
@@ -177,7 +178,38 @@ enum : size_t {
   AlgoSearchWorkspaceSize = 32 * 1024 * 1024,
 };
 
-template <typename T>
+// The algos found by the exhaustive search persist across sessions in the cuDNN conv algo cache of the provider.
+// An entry is keyed by the operation, the data type and the cuDNN shapes and parameters of the convolution, and
+// its value packs the algo with the math type. The workspace size is recomputed for a cached algo.
+std::string CudnnConvAlgoCacheKey(cudnnDataType_t data_type,
+                                  gsl::span<const int64_t> x_dims,
+                                  gsl::span<const int64_t> w_dims,
+                                  gsl::span<const int64_t> pads,
+                                  gsl::span<const int64_t> strides,
+                                  gsl::span<const int64_t> dilations,
+                                  int64_t group,
+                                  bool use_max_workspace);
+
+constexpr int kCudnnMathTypeCount = 16;
+
+inline int EncodeCudnnConvAlgo(int algo, cudnnMathType_t math_type) {
+  return algo * kCudnnMathTypeCount + static_cast<int>(math_type);
+}
+
+template <typename AlgoT>
+inline void DecodeCudnnConvAlgo(int value, AlgoT& algo, cudnnMathType_t& math_type) {
+  algo = static_cast<AlgoT>(value / kCudnnMathTypeCount);
+  math_type = static_cast<cudnnMathType_t>(value % kCudnnMathTypeCount);
+}
+
+// Transposes a filter with the channels first layout [K, C, spatial...] of the ONNX Conv to the channels last layout
+// [K, spatial..., C] of the cuDNN NHWC filter format. For ConvTranspose the first two dims are swapped.
+Status TransposeFilterToChannelsLast(const cudaDeviceProp& prop, cudaStream_t stream, cublasHandle_t cublas_handle,
+                                     const Tensor& filter, AllocatorPtr alloc, std::unique_ptr<Tensor>& output);
+
+// With NHWC the kernel is registered in the internal NHWC domain, the input and output are channels last and the
+// filter is transposed to the channels last layout, once by PrePack for a constant filter.
+template <typename T, bool NHWC = false>
 class Conv : public CudaKernel {
  public:
   using CudaT = typename ToCudaType<T>::MappedType;
@@ -189,6 +221,9 @@ class Conv : public CudaKernel {
 
   Status ComputeInternal(OpKernelContext* context) const override;
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 bool& is_packed, PrePackedWeights* prepacked_weights) override;
+
  protected:
   inline IAllocatorUniquePtr<void> GetWorkSpace(onnxruntime::Stream* stream) const {
     return GetScratchBuffer<void>(s_.workspace_bytes, stream);
@@ -197,6 +232,9 @@ class Conv : public CudaKernel {
   Status UpdateState(OpKernelContext* context, bool bias_expected = false) const;
   ConvAttributes conv_attrs_;
   mutable CudnnConvState<cudnnConvolutionFwdAlgoPerf_t> s_;
+  // the channels last filter of NHWC, which is transposed again for every run if the filter is not constant
+  mutable std::unique_ptr<Tensor> W_;
+  bool is_W_packed_ = false;
   constexpr static auto kDefaultConvAlgo = CUDNN_CONVOLUTION_FWD_ALGO_IMPLICIT_PRECOMP_GEMM;
   static const cudnnConvolutionFwdAlgo_t kAllAlgos[];
 };
@@ -35,21 +35,63 @@ namespace cuda {
       (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
       ConvTranspose<T>);
 
+#define REGISTER_KERNEL_TYPED_NHWC(T)                                                      \
+  ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                                                 \
+      ConvTranspose,                                                                       \
+      kMSInternalNHWCDomain,                                                               \
+      1, 10,                                                                               \
+      T,                                                                                   \
+      kCudaExecutionProvider,                                                              \
+      (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      ConvTranspose<T, true>);                                                             \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                           \
+      ConvTranspose,                                                                       \
+      kMSInternalNHWCDomain,                                                               \
+      11,                                                                                  \
+      T,                                                                                   \
+      kCudaExecutionProvider,                                                              \
+      (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<T>()), \
+      ConvTranspose<T, true>);
+
 REGISTER_KERNEL_TYPED(float)
 REGISTER_KERNEL_TYPED(double)
 REGISTER_KERNEL_TYPED(MLFloat16)
+REGISTER_KERNEL_TYPED_NHWC(float)
+REGISTER_KERNEL_TYPED_NHWC(MLFloat16)
 
-template <typename T>
-Status ConvTranspose<T>::ComputeInternal(OpKernelContext* context) const {
+template <typename T, bool NHWC>
+Status ConvTranspose<T, NHWC>::ComputeInternal(OpKernelContext* context) const {
   return DoConvTranspose(context, false);
 }
 
-template <typename T>
-Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_padding) const {
+template <typename T, bool NHWC>
+Status ConvTranspose<T, NHWC>::PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                                       bool& is_packed, PrePackedWeights* /*prepacked_weights*/) {
+  is_packed = false;
+  if constexpr (NHWC) {
+    if (input_idx == 1) {
+      ORT_RETURN_IF_ERROR(TransposeFilterToChannelsLast(GetDeviceProp(), nullptr, DefaultCublasHandle(), tensor,
+                                                        alloc, W_));
+      // the filter is released after PrePack, so wait for the transpose on the default stream
+      CUDA_RETURN_IF_ERROR(cudaStreamSynchronize(nullptr));
+      is_W_packed_ = true;
+      is_packed = true;
+    }
+  } else {
+    ORT_UNUSED_PARAMETER(tensor);
+    ORT_UNUSED_PARAMETER(input_idx);
+    ORT_UNUSED_PARAMETER(alloc);
+  }
+  return Status::OK();
+}
+
+template <typename T, bool NHWC>
+Status ConvTranspose<T, NHWC>::DoConvTranspose(OpKernelContext* context, bool dynamic_padding) const {
   typedef typename ToCudaType<T>::MappedType CudaT;
 
   const Tensor* X = context->Input<Tensor>(0);
-  const TensorShape& x_shape = X->Shape();
+  // The dims are in the NCHW order. With NHWC the cuDNN descriptors describe the channels last layout of the data.
+  const TensorShape x_shape = NHWC ? TensorShape(ChannelsLastToFirstDims(X->Shape().GetDims())) : X->Shape();
   auto x_dims = x_shape.AsShapeVector();
   auto x_data = reinterpret_cast<const CudaT*>(X->Data<T>());
 
@@ -59,8 +101,20 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Input X must be 3-, 4- or 5-dimensional.",
                            " X: ", X->Shape().ToString().c_str());
   }
-  const Tensor* W = context->Input<Tensor>(1);
-  const TensorShape& w_shape = W->Shape();
+  const Tensor* W = nullptr;
+  std::unique_ptr<Tensor> transposed_W;
+  if constexpr (NHWC) {
+    if (!is_W_packed_) {
+      AllocatorPtr alloc;
+      ORT_RETURN_IF_ERROR(context->GetTempSpaceAllocator(&alloc));
+      ORT_RETURN_IF_ERROR(TransposeFilterToChannelsLast(GetDeviceProp(), Stream(context), GetCublasHandle(context),
+                                                        *context->Input<Tensor>(1), alloc, transposed_W));
+    }
+    W = is_W_packed_ ? W_.get() : transposed_W.get();
+  } else {
+    W = context->Input<Tensor>(1);
+  }
+  const TensorShape w_shape = NHWC ? TensorShape(ChannelsLastToFirstDims(W->Shape().GetDims())) : W->Shape();
   TensorShapeVector w_dims = w_shape.AsShapeVector();
   auto w_data = reinterpret_cast<const CudaT*>(W->Data<T>());
 
@@ -89,9 +143,10 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
       }
 
       ConvTransposeAttributes::Prepare p;
-      ORT_RETURN_IF_ERROR(conv_transpose_attrs_.PrepareForCompute(context, has_bias, p, dynamic_padding));
+      ORT_RETURN_IF_ERROR(conv_transpose_attrs_.PrepareForCompute(context, has_bias, p, dynamic_padding,
+                                                                  NHWC ? &w_shape : nullptr, NHWC));
 
-      auto y_dims = p.Y->Shape().AsShapeVector();
+      auto y_dims = NHWC ? ChannelsLastToFirstDims(p.Y->Shape().GetDims()) : p.Y->Shape().AsShapeVector();
       if (x_dimensions == 3) {
         y_dims.insert(y_dims.begin() + 2, 1);
         p.kernel_shape.insert(p.kernel_shape.begin(), 1);
@@ -103,7 +158,7 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
       s_.y_dims = gsl::make_span(y_dims);
 
       if (w_dims_changed)
-        ORT_RETURN_IF_ERROR(s_.w_desc.Set(w_dims, CudnnTensor::GetDataType<CudaT>()));
+        ORT_RETURN_IF_ERROR(s_.w_desc.Set(w_dims, CudnnTensor::GetDataType<CudaT>(), NHWC));
 
       // Special case when there is a dim value of 0 in the shape.
       // Return only after we have cached the following for subsequent runs :
@@ -113,8 +168,8 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
         return Status::OK();
       }
 
-      ORT_RETURN_IF_ERROR(s_.x_tensor.Set(x_dims, CudnnTensor::GetDataType<CudaT>()));
-      ORT_RETURN_IF_ERROR(s_.y_tensor.Set(y_dims, CudnnTensor::GetDataType<CudaT>()));
+      ORT_RETURN_IF_ERROR(s_.x_tensor.Set(x_dims, CudnnTensor::GetDataType<CudaT>(), NHWC));
+      ORT_RETURN_IF_ERROR(s_.y_tensor.Set(y_dims, CudnnTensor::GetDataType<CudaT>(), NHWC));
 
       cudnnConvolutionMode_t mode = CUDNN_CROSS_CORRELATION;
       ORT_RETURN_IF_ERROR(s_.conv_desc.Set(p.kernel_shape.size(), p.pads, p.strides, p.dilations,
@@ -136,28 +191,49 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
       y_data = reinterpret_cast<CudaT*>(p.Y->MutableData<T>());
 
       if (!s_.cached_benchmark_results.contains(x_dims)) {
-        IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(AlgoSearchWorkspaceSize, context->GetComputeStream());
-
         // set math type to tensor core before algorithm search
         if constexpr (std::is_same<T, MLFloat16>::value)
           CUDNN_RETURN_IF_ERROR(cudnnSetConvolutionMathType(s_.conv_desc, CUDNN_TENSOR_OP_MATH));
 
+        // The result of the search is looked up in and added to the algo cache that persists across sessions.
+        const auto* cuda_ep = static_cast<const CUDAExecutionProvider*>(this->Info().GetExecutionProvider());
+        onnxruntime::tunable::TuningResults* algo_cache = cuda_ep->GetCudnnConvAlgoCache();
+        // the algos of the NHWC layout are cached apart from the NCHW ones of the same shapes
+        constexpr const char* kAlgoCacheOp = NHWC ? "CudnnConvBwdDataNhwc" : "CudnnConvBwdData";
+        std::string algo_cache_key;
+        int cached_algo = -1;
+        if (algo_cache != nullptr) {
+          algo_cache_key = CudnnConvAlgoCacheKey(CudnnTensor::GetDataType<CudaT>(), x_dims, w_dims, p.pads, p.strides,
+                                                 p.dilations, conv_transpose_attrs_.group, false);
+          cached_algo = algo_cache->Lookup(kAlgoCacheOp, algo_cache_key);
+        }
+
         cudnnConvolutionBwdDataAlgoPerf_t perf;
-        int algo_count = 1;
-        CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionBackwardDataAlgorithmEx(
-            GetCudnnHandle(context),
-            s_.w_desc,
-            w_data,
-            s_.x_tensor,
-            x_data,
-            s_.conv_desc,
-            s_.y_tensor,
-            y_data,
-            1,
-            &algo_count,
-            &perf,
-            algo_search_workspace.get(),
-            AlgoSearchWorkspaceSize));
+        if (cached_algo >= 0) {
+          DecodeCudnnConvAlgo(cached_algo, perf.algo, perf.mathType);
+          CUDNN_RETURN_IF_ERROR(cudnnGetConvolutionBackwardDataWorkspaceSize(
+              GetCudnnHandle(context), s_.w_desc, s_.x_tensor, s_.conv_desc, s_.y_tensor, perf.algo, &perf.memory));
+        } else {
+          IAllocatorUniquePtr<void> algo_search_workspace = GetScratchBuffer<void>(AlgoSearchWorkspaceSize, context->GetComputeStream());
+          int algo_count = 1;
+          CUDNN_RETURN_IF_ERROR(cudnnFindConvolutionBackwardDataAlgorithmEx(
+              GetCudnnHandle(context),
+              s_.w_desc,
+              w_data,
+              s_.x_tensor,
+              x_data,
+              s_.conv_desc,
+              s_.y_tensor,
+              y_data,
+              1,
+              &algo_count,
+              &perf,
+              algo_search_workspace.get(),
+              AlgoSearchWorkspaceSize));
+          if (algo_cache != nullptr) {
+            algo_cache->Add(kAlgoCacheOp, algo_cache_key, EncodeCudnnConvAlgo(perf.algo, perf.mathType));
+          }
+        }
         s_.cached_benchmark_results.insert(x_dims, {perf.algo, perf.memory, perf.mathType});
       }
 
@@ -174,6 +250,9 @@ Status ConvTranspose<T>::DoConvTranspose(OpKernelContext* context, bool dynamic_
       if (x_dimensions == 3) {
         y_dims.erase(y_dims.begin() + 2);
       }
+      if constexpr (NHWC) {
+        y_dims = ChannelsFirstToLastDims(y_dims);
+      }
       Tensor* Y = context->Output(0, TensorShape(y_dims));
       y_data = reinterpret_cast<CudaT*>(Y->MutableData<T>());
 
@@ -12,17 +12,23 @@
 namespace onnxruntime {
 namespace cuda {
 
-template <typename T>
+// With NHWC the input and output are channels last and the filter is transposed like the one of Conv.
+template <typename T, bool NHWC = false>
 class ConvTranspose : public CudaKernel {
  public:
   ConvTranspose(const OpKernelInfo& info) : CudaKernel(info), conv_transpose_attrs_(info) {};
   Status ComputeInternal(OpKernelContext* context) const override;
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 bool& is_packed, PrePackedWeights* prepacked_weights) override;
   Status DoConvTranspose(OpKernelContext* context, bool dynamic_padding) const;
 
  private:
   ConvTransposeAttributes conv_transpose_attrs_;
 
   mutable CudnnConvState<cudnnConvolutionBwdDataAlgoPerf_t> s_;
+  // the channels last filter of NHWC prepacked from a constant filter
+  std::unique_ptr<Tensor> W_;
+  bool is_W_packed_ = false;
 };
 
 }  // namespace cuda
@@ -10,7 +10,7 @@
 
 namespace onnxruntime {
 namespace cuda {
-template <typename T>
+template <typename T, bool NHWC>
 __global__ void MaxPoolWithIndexKernel(
     int64_t batch,
     int64_t channels,
@@ -65,28 +65,36 @@ __global__ void MaxPoolWithIndexKernel(
   int64_t w_index_max = -1;
   int64_t h_index_max = -1;
   int64_t offset = (n_index * channels + c_index) * height * width * depth;
-  const T* p_slice = p_input + offset;
-  T maxval = p_slice[h_start * width * depth + w_start * depth + d_start] - (T)1;
+  // the input pixels of a channel are contiguous in NCHW and strided by the channels in NHWC
+  const T* p_slice = NHWC ? p_input + n_index * height * width * depth * channels + c_index : p_input + offset;
+  const int64_t pixel_stride = NHWC ? channels : 1;
+  T maxval = p_slice[(h_start * width * depth + w_start * depth + d_start) * pixel_stride] - (T)1;
   for (int64_t d = d_start; d < d_end; d += dilation_d) {
     for (int64_t w = w_start; w < w_end; w += dilation_w) {
       for (int64_t h = h_start; h < h_end; h += dilation_h) {
-        if (p_slice[h * width * depth + w * depth + d] > maxval) {
+        if (p_slice[(h * width * depth + w * depth + d) * pixel_stride] > maxval) {
           h_index_max = h;
           w_index_max = w;
           d_index_max = d;
-          maxval = static_cast<float>(p_slice[h * width * depth + w * depth + d]);
+          maxval = static_cast<float>(p_slice[(h * width * depth + w * depth + d) * pixel_stride]);
         }
       }
     }
   }
-  p_output[id] = p_input[offset + h_index_max * width * depth + w_index_max * depth + d_index_max];
+  const T result = p_slice[(h_index_max * width * depth + w_index_max * depth + d_index_max) * pixel_stride];
+  if (NHWC) {
+    const int64_t pooled_index = (h_index * pooled_width + w_index) * pooled_depth + d_index;
+    p_output[(n_index * pooled_height * pooled_width * pooled_depth + pooled_index) * channels + c_index] = result;
+  } else {
+    p_output[id] = result;
+  }
   if (p_indices) {
     p_indices[id] = storage_order == 0 ? offset + h_index_max * width * depth + w_index_max * depth + d_index_max
                                        : offset + h_index_max + w_index_max * height + d_index_max * width * height;
   }
 }
 
-template <typename T>
+template <typename T, bool NHWC>
 void MaxPoolWithIndex(
     cudaStream_t stream,
     const TensorShape& input_shape,
@@ -130,7 +138,7 @@ void MaxPoolWithIndex(
   fast_divmod fdm_d(static_cast<int>(pooled_depth));
 
   int blocksPerGrid = (int)((output_size + GridDim::maxThreadsPerBlock - 1) / GridDim::maxThreadsPerBlock);
-  MaxPoolWithIndexKernel<<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+  MaxPoolWithIndexKernel<T, NHWC><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
       batchs,
       channels,
       height,
@@ -162,8 +170,8 @@ void MaxPoolWithIndex(
       p_indices);
 }
 
-#define INSTANTIATEMAXPOOLWITHINDEX(T)              \
-  template void MaxPoolWithIndex<T>(                \
+#define INSTANTIATEMAXPOOLWITHINDEX(T, NHWC)        \
+  template void MaxPoolWithIndex<T, NHWC>(          \
       cudaStream_t stream,                          \
       const TensorShape& input_shape,               \
       const TensorShape& output_shape,              \
@@ -176,11 +184,13 @@ void MaxPoolWithIndex(
       T* p_output,                                  \
       int64_t* p_indices);
 
-INSTANTIATEMAXPOOLWITHINDEX(float)
-INSTANTIATEMAXPOOLWITHINDEX(double)
-INSTANTIATEMAXPOOLWITHINDEX(half)
-INSTANTIATEMAXPOOLWITHINDEX(int8_t)
-INSTANTIATEMAXPOOLWITHINDEX(uint8_t)
+INSTANTIATEMAXPOOLWITHINDEX(float, false)
+INSTANTIATEMAXPOOLWITHINDEX(double, false)
+INSTANTIATEMAXPOOLWITHINDEX(half, false)
+INSTANTIATEMAXPOOLWITHINDEX(int8_t, false)
+INSTANTIATEMAXPOOLWITHINDEX(uint8_t, false)
+INSTANTIATEMAXPOOLWITHINDEX(float, true)
+INSTANTIATEMAXPOOLWITHINDEX(half, true)
 
 }  // namespace cuda
 }  // namespace onnxruntime
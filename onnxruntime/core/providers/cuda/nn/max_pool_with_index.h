@@ -7,7 +7,9 @@
 
 namespace onnxruntime {
 namespace cuda {
-template <typename T>
+// The shapes are in the NCHW order. If NHWC is true, the input and output are in the channels last layout while
+// the indices are in the NCHW order.
+template <typename T, bool NHWC = false>
 void MaxPoolWithIndex(
     cudaStream_t stream,
     const TensorShape& input_shape,
@@ -58,6 +58,53 @@ namespace cuda {
           .TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()),                                  \
       Pool<data_type, pool_type>);
 
+#define POOLING_KERNEL_NHWC(op_name, data_type, pool_type, since_version)                          \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                                   \
+      op_name,                                                                                     \
+      kMSInternalNHWCDomain,                                                                       \
+      since_version,                                                                               \
+      data_type,                                                                                   \
+      kCudaExecutionProvider,                                                                      \
+      (*KernelDefBuilder::Create()).TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()), \
+      Pool<data_type, pool_type, true>);
+
+#define POOLING_KERNEL_VERSIONED_NHWC(op_name, data_type, pool_type, since_version, end_version) \
+  ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                                                       \
+      op_name,                                                                                   \
+      kMSInternalNHWCDomain,                                                                     \
+      since_version,                                                                             \
+      end_version,                                                                               \
+      data_type,                                                                                 \
+      kCudaExecutionProvider,                                                                    \
+      (*KernelDefBuilder::Create())                                                              \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>()),                        \
+      Pool<data_type, pool_type, true>);
+
+#define POOLING_KERNEL_WITH_INDICES_NHWC(op_name, data_type, pool_type, since_version) \
+  ONNX_OPERATOR_TYPED_KERNEL_EX(                                                       \
+      op_name,                                                                         \
+      kMSInternalNHWCDomain,                                                           \
+      since_version,                                                                   \
+      data_type,                                                                       \
+      kCudaExecutionProvider,                                                          \
+      (*KernelDefBuilder::Create())                                                    \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>())               \
+          .TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()),                \
+      Pool<data_type, pool_type, true>);
+
+#define POOLING_KERNEL_VERSIONED_WITH_INDICES_NHWC(op_name, data_type, pool_type, since_version, end_version) \
+  ONNX_OPERATOR_VERSIONED_TYPED_KERNEL_EX(                                                                    \
+      op_name,                                                                                                \
+      kMSInternalNHWCDomain,                                                                                  \
+      since_version,                                                                                          \
+      end_version,                                                                                            \
+      data_type,                                                                                              \
+      kCudaExecutionProvider,                                                                                 \
+      (*KernelDefBuilder::Create())                                                                           \
+          .TypeConstraint("T", DataTypeImpl::GetTensorType<data_type>())                                      \
+          .TypeConstraint("I", DataTypeImpl::GetTensorType<int64_t>()),                                       \
+      Pool<data_type, pool_type, true>);
+
 POOLING_KERNEL_VERSIONED(AveragePool, float, AveragePool, 7, 9)
 POOLING_KERNEL_VERSIONED(AveragePool, double, AveragePool, 7, 9)
 POOLING_KERNEL_VERSIONED(AveragePool, MLFloat16, AveragePool, 7, 9)
@@ -93,6 +140,22 @@ POOLING_KERNEL(GlobalMaxPool, float, MaxPool<1>, 1)
 POOLING_KERNEL(GlobalMaxPool, double, MaxPool<1>, 1)
 POOLING_KERNEL(GlobalMaxPool, MLFloat16, MaxPool<1>, 1)
 
+// The NHWC kernels of the ops the layout transformer converts when the NHWC layout is preferred.
+#define POOLING_KERNELS_NHWC(data_type)                                                  \
+  POOLING_KERNEL_VERSIONED_NHWC(AveragePool, data_type, AveragePool, 7, 9)               \
+  POOLING_KERNEL_VERSIONED_NHWC(AveragePool, data_type, AveragePool, 10, 10)             \
+  POOLING_KERNEL_NHWC(AveragePool, data_type, AveragePool, 11)                           \
+  POOLING_KERNEL_NHWC(GlobalAveragePool, data_type, AveragePool, 1)                      \
+  POOLING_KERNEL_VERSIONED_NHWC(MaxPool, data_type, MaxPool<1>, 1, 7)                    \
+  POOLING_KERNEL_VERSIONED_WITH_INDICES_NHWC(MaxPool, data_type, MaxPool<8>, 8, 9)       \
+  POOLING_KERNEL_VERSIONED_WITH_INDICES_NHWC(MaxPool, data_type, MaxPool<8>, 10, 10)     \
+  POOLING_KERNEL_VERSIONED_WITH_INDICES_NHWC(MaxPool, data_type, MaxPool<8>, 11, 11)     \
+  POOLING_KERNEL_WITH_INDICES_NHWC(MaxPool, data_type, MaxPool<8>, 12)                   \
+  POOLING_KERNEL_NHWC(GlobalMaxPool, data_type, MaxPool<1>, 1)
+
+POOLING_KERNELS_NHWC(float)
+POOLING_KERNELS_NHWC(MLFloat16)
+
 class CudnnPoolingDescriptor final {
  public:
   CudnnPoolingDescriptor() : desc_(nullptr) {
@@ -146,17 +209,19 @@ class CudnnPoolingDescriptor final {
   cudnnPoolingDescriptor_t desc_;
 };
 
-template <typename T, typename PoolType>
-Status Pool<T, PoolType>::ComputeInternal(OpKernelContext* context) const {
+template <typename T, typename PoolType, bool NHWC>
+Status Pool<T, PoolType, NHWC>::ComputeInternal(OpKernelContext* context) const {
   typedef typename ToCudaType<T>::MappedType CudaT;
   const Tensor* X = context->Input<Tensor>(0);
-  const TensorShape& x_shape = X->Shape();
-  const auto x_dims = x_shape.GetDims();
 
-  if (x_shape.NumDimensions() < 3) {
+  if (X->Shape().NumDimensions() < 3) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Input dimension cannot be less than 3.");
   }
 
+  // The shapes are computed in the NCHW order, the cuDNN descriptors give the channels last layout for NHWC.
+  const TensorShape x_shape = NHWC ? TensorShape(ChannelsLastToFirstDims(X->Shape().GetDims())) : X->Shape();
+  const auto x_dims = x_shape.GetDims();
+
   auto kernel_shape = pool_attrs_.kernel_shape;
   auto pads = pool_attrs_.pads;
   auto strides = pool_attrs_.strides;
@@ -169,7 +234,7 @@ Status Pool<T, PoolType>::ComputeInternal(OpKernelContext* context) const {
 
   auto y_dims = pool_attrs_.SetOutputSize(x_shape, x_shape[1], &pads);
   TensorShape y_shape(y_dims);
-  Tensor* Y = context->Output(0, y_shape);
+  Tensor* Y = context->Output(0, NHWC ? TensorShape(ChannelsFirstToLastDims(y_dims)) : y_shape);
   // special case when there is a dim value of 0 in the shape.
   if (y_shape.Size() == 0)
     return Status::OK();
@@ -203,8 +268,8 @@ Status Pool<T, PoolType>::ComputeInternal(OpKernelContext* context) const {
     const auto beta = Consts<float>::Zero;
     CudnnTensor x_tensor;
     CudnnTensor y_tensor;
-    ORT_RETURN_IF_ERROR(x_tensor.Set(x_dims_cudnn, CudnnTensor::GetDataType<float>()));
-    ORT_RETURN_IF_ERROR(y_tensor.Set(y_dims_cudnn, CudnnTensor::GetDataType<float>()));
+    ORT_RETURN_IF_ERROR(x_tensor.Set(x_dims_cudnn, CudnnTensor::GetDataType<float>(), NHWC));
+    ORT_RETURN_IF_ERROR(y_tensor.Set(y_dims_cudnn, CudnnTensor::GetDataType<float>(), NHWC));
 
     const auto input_count = x_shape.Size();
     const auto output_count = y_shape.Size();
@@ -219,8 +284,8 @@ Status Pool<T, PoolType>::ComputeInternal(OpKernelContext* context) const {
     const auto beta = Consts<CudaT>::Zero;
     CudnnTensor x_tensor;
     CudnnTensor y_tensor;
-    ORT_RETURN_IF_ERROR(x_tensor.Set(x_dims_cudnn, CudnnTensor::GetDataType<CudaT>()));
-    ORT_RETURN_IF_ERROR(y_tensor.Set(y_dims_cudnn, CudnnTensor::GetDataType<CudaT>()));
+    ORT_RETURN_IF_ERROR(x_tensor.Set(x_dims_cudnn, CudnnTensor::GetDataType<CudaT>(), NHWC));
+    ORT_RETURN_IF_ERROR(y_tensor.Set(y_dims_cudnn, CudnnTensor::GetDataType<CudaT>(), NHWC));
 
     CUDNN_RETURN_IF_ERROR(PoolingForwardHelper(GetCudnnHandle(context), pooling_desc, &alpha, x_tensor, x_data, &beta, y_tensor, y_data));
   }
@@ -228,17 +293,18 @@ Status Pool<T, PoolType>::ComputeInternal(OpKernelContext* context) const {
   return Status::OK();
 }
 
-template <typename T>
-Status Pool<T, MaxPool<8>>::ComputeInternal(OpKernelContext* context) const {
+template <typename T, bool NHWC>
+Status Pool<T, MaxPool<8>, NHWC>::ComputeInternal(OpKernelContext* context) const {
   typedef typename ToCudaType<T>::MappedType CudaT;
   const Tensor* X = context->Input<Tensor>(0);
-  const TensorShape& x_shape = X->Shape();
-  const auto& x_dims = x_shape.GetDims();
 
-  if (x_shape.NumDimensions() < 3) {
+  if (X->Shape().NumDimensions() < 3) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Input dimension cannot be less than 3.");
   }
 
+  const TensorShape x_shape = NHWC ? TensorShape(ChannelsLastToFirstDims(X->Shape().GetDims())) : X->Shape();
+  const auto x_dims = x_shape.GetDims();
+
   auto kernel_shape = this->pool_attrs_.kernel_shape;
   auto pads = this->pool_attrs_.pads;
   auto strides = this->pool_attrs_.strides;
@@ -250,7 +316,7 @@ Status Pool<T, MaxPool<8>>::ComputeInternal(OpKernelContext* context) const {
   }
 
   auto y_dims = this->pool_attrs_.SetOutputSize(x_shape, x_shape[1], &pads);
-  Tensor* Y = context->Output(0, TensorShape(y_dims));
+  Tensor* Y = context->Output(0, NHWC ? TensorShape(ChannelsFirstToLastDims(y_dims)) : TensorShape(y_dims));
 
   // special case when there is a dim value of 0 in the shape.
   if (Y->Shape().Size() == 0)
@@ -259,10 +325,11 @@ Status Pool<T, MaxPool<8>>::ComputeInternal(OpKernelContext* context) const {
   auto x_data = reinterpret_cast<const CudaT*>(X->Data<T>());
   auto y_data = reinterpret_cast<CudaT*>(Y->MutableData<T>());
 
+  // The indices are not converted by the layout transformer, so they stay in the NCHW order of the original op.
   Tensor* I = context->Output(1, TensorShape(y_dims));
   if (nullptr != I || !this->pool_attrs_.default_dilations) {
     auto i_data = nullptr == I ? nullptr : I->MutableData<int64_t>();
-    MaxPoolWithIndex<CudaT>(
+    MaxPoolWithIndex<CudaT, NHWC>(
         this->Stream(context),
         x_shape,
         TensorShape(y_dims),
@@ -275,7 +342,7 @@ Status Pool<T, MaxPool<8>>::ComputeInternal(OpKernelContext* context) const {
         y_data,
         i_data);
   } else {
-    ORT_RETURN_IF_ERROR((Pool<T, MaxPool<1>>::ComputeInternal(context)));
+    ORT_RETURN_IF_ERROR((Pool<T, MaxPool<1>, NHWC>::ComputeInternal(context)));
   }
   return Status::OK();
 }
@@ -10,7 +10,8 @@
 namespace onnxruntime {
 namespace cuda {
 
-template <typename T, typename PoolType>
+// If NHWC is true, the input and output are in the channels last layout of the kMSInternalNHWCDomain ops.
+template <typename T, typename PoolType, bool NHWC = false>
 class Pool : public CudaKernel, public PoolBase {
  public:
   Pool(const OpKernelInfo& info) : CudaKernel(info), PoolBase(info) {}
@@ -19,10 +20,10 @@ class Pool : public CudaKernel, public PoolBase {
 
 };
 
-template <typename T>
-class Pool<T, MaxPool<8>> final : public Pool<T, MaxPool<1>> {
+template <typename T, bool NHWC>
+class Pool<T, MaxPool<8>, NHWC> final : public Pool<T, MaxPool<1>, NHWC> {
  public:
-  Pool(const OpKernelInfo& info) : Pool<T, MaxPool<1>>(info) {}
+  Pool(const OpKernelInfo& info) : Pool<T, MaxPool<1>, NHWC>(info) {}
 
   Status ComputeInternal(OpKernelContext* context) const override;
 };
@@ -86,20 +86,12 @@ optional<std::pair<int64_t, int64_t>> GetMinAndMaxContiguousAxes(
 
   return std::make_pair(min_axis, max_axis);
 }
-}  // namespace
 
-ApplicableMatrixReduction get_applicable_matrix_reduction(
-    const cudnnReduceTensorOp_t cudnn_reduce_op,
+// Removes all dims with value 1. This can help to optimize case like:
+// dims=[2,3,1,4,1,5] and axes=[0,2,4], which is same as dims=[2,3,4,5] and axes=[0].
+void SqueezeReductionDims(
     gsl::span<const int64_t> dims, gsl::span<const int64_t> original_axes,
-    int& m_out, int& n_out) {
-  if (cudnn_reduce_op != CUDNN_REDUCE_TENSOR_ADD && cudnn_reduce_op != CUDNN_REDUCE_TENSOR_AVG) {
-    return ApplicableMatrixReduction::None;
-  }
-
-  // Remove all dims with value 1. This can help to optimize case like:
-  // dims=[2,3,1,4,1,5] and axes=[0,2,4], which is same as dims=[2,3,4,5] and axes=[0].
-  std::vector<int64_t> new_dims;
-  std::vector<int64_t> new_axes;
+    std::vector<int64_t>& new_dims, std::vector<int64_t>& new_axes) {
   const auto original_rank = gsl::narrow<int64_t>(dims.size());
   std::set<int64_t> original_axes_set;
   for (const auto axis : original_axes) {
@@ -128,6 +120,20 @@ ApplicableMatrixReduction get_applicable_matrix_reduction(
   if (!dims.empty() && new_dims.empty()) {
     new_dims.emplace_back(1);
   }
+}
+}  // namespace
+
+ApplicableMatrixReduction get_applicable_matrix_reduction(
+    const cudnnReduceTensorOp_t cudnn_reduce_op,
+    gsl::span<const int64_t> dims, gsl::span<const int64_t> original_axes,
+    int& m_out, int& n_out) {
+  if (cudnn_reduce_op != CUDNN_REDUCE_TENSOR_ADD && cudnn_reduce_op != CUDNN_REDUCE_TENSOR_AVG) {
+    return ApplicableMatrixReduction::None;
+  }
+
+  std::vector<int64_t> new_dims;
+  std::vector<int64_t> new_axes;
+  SqueezeReductionDims(dims, original_axes, new_dims, new_axes);
 
   const auto rank = gsl::narrow<int64_t>(new_dims.size());
   const auto min_and_max_axes = GetMinAndMaxContiguousAxes(rank, new_dims, new_axes);
@@ -171,5 +177,71 @@ ApplicableMatrixReduction get_applicable_matrix_reduction(
              : ApplicableMatrixReduction::Columns;
 }
 
+bool get_reduction_kind(
+    cudnnReduceTensorOp_t cudnn_reduce_op, bool calculate_log, bool calculate_sqt, bool log_sum_exp,
+    ReductionKind& kind) {
+  if (cudnn_reduce_op == CUDNN_REDUCE_TENSOR_ADD) {
+    if (static_cast<int>(calculate_log) + static_cast<int>(calculate_sqt) + static_cast<int>(log_sum_exp) > 1) {
+      return false;
+    }
+    kind = log_sum_exp     ? ReductionKind::LogSumExp
+           : calculate_sqt ? ReductionKind::SumSquare
+           : calculate_log ? ReductionKind::LogSum
+                           : ReductionKind::Sum;
+    return true;
+  }
+
+  if (calculate_log || calculate_sqt || log_sum_exp) {
+    return false;
+  }
+
+  switch (cudnn_reduce_op) {
+    case CUDNN_REDUCE_TENSOR_AVG:
+      kind = ReductionKind::Mean;
+      return true;
+    case CUDNN_REDUCE_TENSOR_NORM1:
+      kind = ReductionKind::L1;
+      return true;
+    case CUDNN_REDUCE_TENSOR_NORM2:
+      kind = ReductionKind::L2;
+      return true;
+    case CUDNN_REDUCE_TENSOR_MAX:
+      kind = ReductionKind::Max;
+      return true;
+    case CUDNN_REDUCE_TENSOR_MIN:
+      kind = ReductionKind::Min;
+      return true;
+    case CUDNN_REDUCE_TENSOR_MUL:
+      kind = ReductionKind::Prod;
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool get_canonical_reduction(
+    gsl::span<const int64_t> dims, gsl::span<const int64_t> original_axes,
+    CanonicalReduction& canonical_reduction) {
+  std::vector<int64_t> new_dims;
+  std::vector<int64_t> new_axes;
+  SqueezeReductionDims(dims, original_axes, new_dims, new_axes);
+
+  const auto rank = gsl::narrow<int64_t>(new_dims.size());
+  const auto min_and_max_axes = GetMinAndMaxContiguousAxes(rank, new_dims, new_axes);
+  if (!min_and_max_axes.has_value()) {
+    return false;
+  }
+
+  const auto shape = TensorShape::FromExistingBuffer(new_dims);
+  const auto min_axis = gsl::narrow<size_t>(min_and_max_axes->first);
+  const auto inner_axis = gsl::narrow<size_t>(min_and_max_axes->second + 1);
+
+  canonical_reduction.outer = shape.SizeToDimension(min_axis);
+  canonical_reduction.reduce = shape.SizeHelper(min_axis, inner_axis);
+  canonical_reduction.inner = shape.SizeFromDimension(inner_axis);
+
+  return true;
+}
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -7,6 +7,7 @@
 
 #include <cuda.h>
 #include <cuda_fp16.h>
+#include <cub/cub.cuh>
 #include "core/common/common.h"
 #include "core/providers/cuda/atomic/common.cuh"
 #include "core/providers/cuda/cu_inc/common.cuh"
@@ -511,5 +512,414 @@ INSTANTIATE_REDUCE_MATRIX_COLUMNS(double);
 INSTANTIATE_REDUCE_MATRIX_COLUMNS(BFloat16);
 #undef INSTANTIATE_REDUCE_MATRIX_COLUMNS
 
+namespace detail {
+// Reducers define the accumulation of a canonical reduction: Init() is the identity of Combine(), Transform() maps
+// an input value to an accumulator and Finalize() computes the output value from the accumulator of `size` inputs.
+template <typename T>
+struct ScalarReducer {
+  using ValueType = T;
+  using AccType = T;
+  __device__ __forceinline__ static T ShuffleDown(T value, int delta) { return WARP_SHFL_DOWN(value, delta); }
+};
+
+template <typename T, typename TPreOp, typename TPostOp>
+struct SumReducer : ScalarReducer<T> {
+  __device__ __forceinline__ static T Init() { return T(0); }
+  __device__ __forceinline__ static T Transform(T value) { return TPreOp()(value); }
+  __device__ __forceinline__ static T Combine(T a, T b) { return a + b; }
+  __device__ __forceinline__ static T Finalize(T value, int64_t) { return TPostOp()(value); }
+};
+
+template <typename T>
+struct MeanReducer : SumReducer<T, Identity, Identity> {
+  __device__ __forceinline__ static T Finalize(T value, int64_t size) { return value / static_cast<T>(size); }
+};
+
+struct Abs {
+  template <typename T>
+  __forceinline__ __device__ T operator()(const T& value) {
+    return _Abs(value);
+  }
+};
+
+struct Log {
+  template <typename T>
+  __forceinline__ __device__ T operator()(const T& value) {
+    return _Log(value);
+  }
+};
+
+template <typename T>
+struct MaxReducer : ScalarReducer<T> {
+  __device__ __forceinline__ static T Init() { return -std::numeric_limits<T>::infinity(); }
+  __device__ __forceinline__ static T Transform(T value) { return value; }
+  __device__ __forceinline__ static T Combine(T a, T b) { return _Max(a, b); }
+  __device__ __forceinline__ static T Finalize(T value, int64_t) { return value; }
+};
+
+template <typename T>
+struct MinReducer : ScalarReducer<T> {
+  __device__ __forceinline__ static T Init() { return std::numeric_limits<T>::infinity(); }
+  __device__ __forceinline__ static T Transform(T value) { return value; }
+  __device__ __forceinline__ static T Combine(T a, T b) { return _Min(a, b); }
+  __device__ __forceinline__ static T Finalize(T value, int64_t) { return value; }
+};
+
+template <typename T>
+struct ProdReducer : ScalarReducer<T> {
+  __device__ __forceinline__ static T Init() { return T(1); }
+  __device__ __forceinline__ static T Transform(T value) { return value; }
+  __device__ __forceinline__ static T Combine(T a, T b) { return a * b; }
+  __device__ __forceinline__ static T Finalize(T value, int64_t) { return value; }
+};
+
+template <typename T>
+struct LogSumExpAccumulator {
+  T max;
+  T sum;
+};
+
+// Computes the log of the sum of exponentials in a single pass by rescaling the running sum whenever the running
+// maximum grows, so the input is read once instead of once for the maximum and once for the sum.
+template <typename T>
+struct LogSumExpReducer {
+  using ValueType = T;
+  using AccType = LogSumExpAccumulator<T>;
+  __device__ __forceinline__ static AccType Init() { return {-std::numeric_limits<T>::infinity(), T(0)}; }
+  __device__ __forceinline__ static AccType Transform(T value) { return {value, T(1)}; }
+  __device__ __forceinline__ static AccType Combine(AccType a, AccType b) {
+    const T max = _Max(a.max, b.max);
+    if (max == -std::numeric_limits<T>::infinity()) {
+      return a;
+    }
+    return {max, a.sum * _Exp(a.max - max) + b.sum * _Exp(b.max - max)};
+  }
+  __device__ __forceinline__ static T Finalize(AccType value, int64_t) { return value.max + _Log(value.sum); }
+  __device__ __forceinline__ static AccType ShuffleDown(AccType value, int delta) {
+    return {WARP_SHFL_DOWN(value.max, delta), WARP_SHFL_DOWN(value.sum, delta)};
+  }
+};
+
+template <typename TReducer>
+struct CombineOp {
+  __device__ __forceinline__ typename TReducer::AccType operator()(
+      const typename TReducer::AccType& a, const typename TReducer::AccType& b) const {
+    return TReducer::Combine(a, b);
+  }
+};
+
+// The first pass of a reduction transforms the input values, a second pass combines the partial accumulators the
+// first pass stored in the intermediate buffer.
+template <typename TReducer, bool TransformInput, typename TIn>
+__device__ __forceinline__ typename TReducer::AccType load_value(const TIn* input, int64_t offset) {
+  if constexpr (TransformInput) {
+    return TReducer::Transform(static_cast<typename TReducer::ValueType>(input[offset]));
+  } else {
+    return input[offset];
+  }
+}
+
+template <typename TReducer, bool FinalizeOutput, typename TOut>
+__device__ __forceinline__ void store_value(
+    TOut* output, int64_t offset, const typename TReducer::AccType& value, int64_t reduced_size) {
+  if constexpr (FinalizeOutput) {
+    output[offset] = TOut(TReducer::Finalize(value, reduced_size));
+  } else {
+    output[offset] = value;
+  }
+}
+
+constexpr int kCanonicalReductionThreadsPerBlock = 256;
+constexpr int kCanonicalReductionRowsPerBlock = 8;
+constexpr int kCanonicalReductionMaxRowSizePerWarp = 512;
+constexpr int kCanonicalReductionMinElementsPerThread = 16;
+constexpr int kCanonicalReductionTargetBlocks = 256;
+constexpr int kCanonicalReductionMaxGridDim = 65535;
+
+// Reduces contiguous rows of [outer, reduce] with a warp per row.
+template <typename TReducer, bool TransformInput, bool FinalizeOutput, typename TIn, typename TOut>
+__global__ void reduce_rows_by_warp_kernel(
+    const TIn* input, TOut* output, int64_t num_rows, int64_t row_size, int64_t reduced_size) {
+  for (int64_t row = static_cast<int64_t>(blockIdx.x) * blockDim.y + threadIdx.y; row < num_rows;
+       row += static_cast<int64_t>(gridDim.x) * blockDim.y) {
+    const TIn* row_input = input + row * row_size;
+    auto value = TReducer::Init();
+    for (int64_t i = threadIdx.x; i < row_size; i += GPU_WARP_SIZE) {
+      value = TReducer::Combine(value, load_value<TReducer, TransformInput>(row_input, i));
+    }
+
+#pragma unroll
+    for (int stride = GPU_WARP_SIZE / 2; stride > 0; stride /= 2) {
+      value = TReducer::Combine(value, TReducer::ShuffleDown(value, stride));
+    }
+
+    if (threadIdx.x == 0) {
+      store_value<TReducer, FinalizeOutput>(output, row, value, reduced_size);
+    }
+  }
+}
+
+// Reduces contiguous rows of [outer, reduce] with a thread block per row segment. The row is split into gridDim.x
+// segments, each producing a partial accumulator unless there is a single segment.
+template <typename TReducer, bool TransformInput, bool FinalizeOutput, typename TIn, typename TOut>
+__global__ void reduce_rows_by_block_kernel(
+    const TIn* input, TOut* output, int64_t num_rows, int64_t row_size, int64_t reduced_size) {
+  using BlockReduce = cub::BlockReduce<typename TReducer::AccType, kCanonicalReductionThreadsPerBlock>;
+  __shared__ typename BlockReduce::TempStorage temp_storage;
+
+  const int64_t segment_size = (row_size + gridDim.x - 1) / gridDim.x;
+  const int64_t segment_begin = blockIdx.x * segment_size;
+  const int64_t segment_end = std::min(segment_begin + segment_size, row_size);
+
+  for (int64_t row = blockIdx.y; row < num_rows; row += gridDim.y) {
+    const TIn* row_input = input + row * row_size;
+    auto value = TReducer::Init();
+    for (int64_t i = segment_begin + threadIdx.x; i < segment_end; i += kCanonicalReductionThreadsPerBlock) {
+      value = TReducer::Combine(value, load_value<TReducer, TransformInput>(row_input, i));
+    }
+
+    value = BlockReduce(temp_storage).Reduce(value, CombineOp<TReducer>());
+
+    if (threadIdx.x == 0) {
+      store_value<TReducer, FinalizeOutput>(output, row * gridDim.x + blockIdx.x, value, reduced_size);
+    }
+
+    // the temporary storage is reused by the next row
+    __syncthreads();
+  }
+}
+
+// Reduces the middle dimension of [outer, reduce, inner] with a tile of blockDim.x outputs along the inner dimension
+// per thread block, so the loads are coalesced. The threads along blockDim.y split the reduce dimension and combine
+// their accumulators through shared memory. The reduce dimension is split into gridDim.z segments, each producing
+// a partial accumulator unless there is a single segment.
+template <typename TReducer, bool TransformInput, bool FinalizeOutput, typename TIn, typename TOut>
+__global__ void reduce_strided_kernel(
+    const TIn* input, TOut* output, int64_t num_outer, int64_t reduce_size, int64_t inner_size,
+    int64_t reduced_size) {
+  using AccType = typename TReducer::AccType;
+  extern __shared__ unsigned char strided_shared_memory_bytes[];
+  AccType* shared_memory = reinterpret_cast<AccType*>(strided_shared_memory_bytes);
+
+  const int64_t inner = static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x;
+  const int tid_in_block = threadIdx.y * blockDim.x + threadIdx.x;
+  const int64_t segment_size = (reduce_size + gridDim.z - 1) / gridDim.z;
+  const int64_t segment_begin = blockIdx.z * segment_size;
+  const int64_t segment_end = std::min(segment_begin + segment_size, reduce_size);
+
+  for (int64_t outer = blockIdx.y; outer < num_outer; outer += gridDim.y) {
+    auto value = TReducer::Init();
+    if (inner < inner_size) {
+      const TIn* outer_input = input + outer * reduce_size * inner_size + inner;
+      for (int64_t i = segment_begin + threadIdx.y; i < segment_end; i += blockDim.y) {
+        value = TReducer::Combine(value, load_value<TReducer, TransformInput>(outer_input, i * inner_size));
+      }
+    }
+
+    if (blockDim.y > 1) {
+      shared_memory[tid_in_block] = value;
+      __syncthreads();
+      for (int stride = blockDim.y / 2; stride > 0; stride /= 2) {
+        if (threadIdx.y < stride) {
+          value = TReducer::Combine(value, shared_memory[tid_in_block + stride * blockDim.x]);
+          shared_memory[tid_in_block] = value;
+        }
+        __syncthreads();
+      }
+    }
+
+    if (threadIdx.y == 0 && inner < inner_size) {
+      store_value<TReducer, FinalizeOutput>(
+          output, (outer * gridDim.z + blockIdx.z) * inner_size + inner, value, reduced_size);
+    }
+  }
+}
+
+enum class CanonicalReductionKernel {
+  RowsByWarp,
+  RowsByBlock,
+  Strided,
+};
+
+struct CanonicalReductionPlan {
+  CanonicalReductionKernel kernel;
+  dim3 grid_dim;
+  dim3 block_dim;
+  // the number of segments the reduce dimension is split into, each producing a partial accumulator
+  int num_segments;
+};
+
+int64_t ceil_div(int64_t a, int64_t b) { return (a + b - 1) / b; }
+
+// Picks the kernel for a canonical reduction by shape. A split of the reduce dimension is considered when the
+// outputs alone don't create enough thread blocks and each thread still reduces a minimum number of elements.
+CanonicalReductionPlan compute_canonical_reduction_plan(const CanonicalReduction& shape, bool allow_split) {
+  CanonicalReductionPlan plan{};
+  plan.num_segments = 1;
+
+  const auto get_num_segments = [allow_split, &shape](int64_t num_blocks, int64_t num_threads_per_segment) {
+    if (!allow_split || num_blocks >= kCanonicalReductionTargetBlocks) {
+      return 1;
+    }
+    const int64_t max_num_segments = shape.reduce / (num_threads_per_segment * kCanonicalReductionMinElementsPerThread);
+    const int64_t num_segments = std::min(ceil_div(kCanonicalReductionTargetBlocks, num_blocks), max_num_segments);
+    return static_cast<int>(std::max<int64_t>(1, std::min<int64_t>(num_segments, kCanonicalReductionMaxGridDim)));
+  };
+
+  if (shape.inner == 1 && shape.reduce <= kCanonicalReductionMaxRowSizePerWarp) {
+    plan.kernel = CanonicalReductionKernel::RowsByWarp;
+    plan.block_dim = dim3(GPU_WARP_SIZE_HOST, kCanonicalReductionRowsPerBlock);
+    plan.grid_dim = dim3(static_cast<unsigned int>(
+        std::min<int64_t>(ceil_div(shape.outer, kCanonicalReductionRowsPerBlock), kCanonicalReductionMaxGridDim)));
+  } else if (shape.inner == 1) {
+    const int64_t num_rows = std::min<int64_t>(shape.outer, kCanonicalReductionMaxGridDim);
+    plan.kernel = CanonicalReductionKernel::RowsByBlock;
+    plan.num_segments = get_num_segments(num_rows, kCanonicalReductionThreadsPerBlock);
+    plan.block_dim = dim3(kCanonicalReductionThreadsPerBlock);
+    plan.grid_dim = dim3(plan.num_segments, static_cast<unsigned int>(num_rows));
+  } else {
+    const int block_x = least_pow2_bound(static_cast<int>(std::min<int64_t>(shape.inner, GPU_WARP_SIZE_HOST)));
+    const int max_block_y = kCanonicalReductionThreadsPerBlock / block_x;
+    const int block_y = least_pow2_bound(static_cast<int>(std::min<int64_t>(shape.reduce, max_block_y)));
+    const int64_t num_tiles = ceil_div(shape.inner, block_x);
+    const int64_t num_outer = std::min<int64_t>(shape.outer, kCanonicalReductionMaxGridDim);
+    plan.kernel = CanonicalReductionKernel::Strided;
+    plan.num_segments = get_num_segments(num_tiles * num_outer, block_y);
+    plan.block_dim = dim3(block_x, block_y);
+    plan.grid_dim = dim3(static_cast<unsigned int>(num_tiles), static_cast<unsigned int>(num_outer),
+                         plan.num_segments);
+  }
+
+  return plan;
+}
+
+template <typename TReducer, bool TransformInput, bool FinalizeOutput, typename TIn, typename TOut>
+void launch_canonical_reduction_kernel(
+    cudaStream_t stream, const CanonicalReductionPlan& plan, const TIn* input, TOut* output,
+    const CanonicalReduction& shape, int64_t reduced_size) {
+  switch (plan.kernel) {
+    case CanonicalReductionKernel::RowsByWarp:
+      reduce_rows_by_warp_kernel<TReducer, TransformInput, FinalizeOutput>
+          <<<plan.grid_dim, plan.block_dim, 0, stream>>>(input, output, shape.outer, shape.reduce, reduced_size);
+      break;
+    case CanonicalReductionKernel::RowsByBlock:
+      reduce_rows_by_block_kernel<TReducer, TransformInput, FinalizeOutput>
+          <<<plan.grid_dim, plan.block_dim, 0, stream>>>(input, output, shape.outer, shape.reduce, reduced_size);
+      break;
+    case CanonicalReductionKernel::Strided: {
+      const size_t shared_memory_size =
+          sizeof(typename TReducer::AccType) * plan.block_dim.x * plan.block_dim.y;
+      reduce_strided_kernel<TReducer, TransformInput, FinalizeOutput>
+          <<<plan.grid_dim, plan.block_dim, shared_memory_size, stream>>>(
+              input, output, shape.outer, shape.reduce, shape.inner, reduced_size);
+    } break;
+  }
+}
+
+size_t compute_canonical_reduction_intermediate_buffer_size(
+    int element_size, const CanonicalReduction& canonical_reduction) {
+  ORT_ENFORCE(element_size >= 0 && canonical_reduction.outer >= 0 && canonical_reduction.reduce >= 0 &&
+              canonical_reduction.inner >= 0);
+
+  const auto plan = compute_canonical_reduction_plan(canonical_reduction, true);
+  if (plan.num_segments == 1) {
+    return 0;
+  }
+
+  return static_cast<size_t>(canonical_reduction.outer) * plan.num_segments * canonical_reduction.inner *
+             element_size +
+         alignof(max_align_t) - 1;
+}
+
+template <typename TReducer, typename TIn, typename TOut>
+Status call_reduce_canonical(
+    cudaStream_t stream, const TIn* input, TOut* output, const CanonicalReduction& shape,
+    void* buffer, size_t buffer_size) {
+  using AccType = typename TReducer::AccType;
+
+  const auto plan = compute_canonical_reduction_plan(shape, true);
+  if (plan.num_segments == 1) {
+    launch_canonical_reduction_kernel<TReducer, true, true>(stream, plan, input, output, shape, shape.reduce);
+    return CUDA_CALL(cudaGetLastError());
+  }
+
+  const uintptr_t begin_addr = reinterpret_cast<uintptr_t>(buffer);
+  const uintptr_t partial_addr = round_up_to_aligned(begin_addr, alignof(AccType));
+  const size_t required_size =
+      partial_addr - begin_addr + static_cast<size_t>(shape.outer) * plan.num_segments * shape.inner * sizeof(AccType);
+  ORT_RETURN_IF_NOT(
+      required_size <= buffer_size,
+      "Buffer size is too small (", buffer_size, " bytes). ",
+      "At least ", required_size, " bytes are needed from the given base address (", buffer, ").");
+  AccType* partial = reinterpret_cast<AccType*>(partial_addr);
+
+  launch_canonical_reduction_kernel<TReducer, true, false>(stream, plan, input, partial, shape, shape.reduce);
+
+  // the partial accumulators form an [outer, num_segments, inner] reduction
+  const CanonicalReduction partial_shape{shape.outer, plan.num_segments, shape.inner};
+  const auto partial_plan = compute_canonical_reduction_plan(partial_shape, false);
+  launch_canonical_reduction_kernel<TReducer, false, true>(
+      stream, partial_plan, static_cast<const AccType*>(partial), output, partial_shape, shape.reduce);
+
+  return CUDA_CALL(cudaGetLastError());
+}
+}  // namespace detail
+
+template <typename TIn, typename TOut>
+Status reduce_canonical(
+    cudaStream_t stream, ReductionKind kind, const TIn* input, TOut* output,
+    const CanonicalReduction& canonical_reduction, void* buffer, size_t buffer_size) {
+  using TBuf = AccumulationType_t<TIn>;
+
+  if (canonical_reduction.outer * canonical_reduction.inner == 0) {
+    return Status::OK();
+  }
+
+  switch (kind) {
+    case ReductionKind::Sum:
+      return detail::call_reduce_canonical<detail::SumReducer<TBuf, Identity, Identity>>(
+          stream, input, output, canonical_reduction, buffer, buffer_size);
+    case ReductionKind::Mean:
+      return detail::call_reduce_canonical<detail::MeanReducer<TBuf>>(
+          stream, input, output, canonical_reduction, buffer, buffer_size);
+    case ReductionKind::SumSquare:
+      return detail::call_reduce_canonical<detail::SumReducer<TBuf, Square, Identity>>(
+          stream, input, output, canonical_reduction, buffer, buffer_size);
+    case ReductionKind::L1:
+      return detail::call_reduce_canonical<detail::SumReducer<TBuf, detail::Abs, Identity>>(
+          stream, input, output, canonical_reduction, buffer, buffer_size);
+    case ReductionKind::L2:
+      return detail::call_reduce_canonical<detail::SumReducer<TBuf, Square, Sqrt>>(
+          stream, input, output, canonical_reduction, buffer, buffer_size);
+    case ReductionKind::LogSum:
+      return detail::call_reduce_canonical<detail::SumReducer<TBuf, Identity, detail::Log>>(
+          stream, input, output, canonical_reduction, buffer, buffer_size);
+    case ReductionKind::LogSumExp:
+      return detail::call_reduce_canonical<detail::LogSumExpReducer<TBuf>>(
+          stream, input, output, canonical_reduction, buffer, buffer_size);
+    case ReductionKind::Max:
+      return detail::call_reduce_canonical<detail::MaxReducer<TBuf>>(
+          stream, input, output, canonical_reduction, buffer, buffer_size);
+    case ReductionKind::Min:
+      return detail::call_reduce_canonical<detail::MinReducer<TBuf>>(
+          stream, input, output, canonical_reduction, buffer, buffer_size);
+    case ReductionKind::Prod:
+      return detail::call_reduce_canonical<detail::ProdReducer<TBuf>>(
+          stream, input, output, canonical_reduction, buffer, buffer_size);
+  }
+
+  return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Unsupported reduction kind: ", static_cast<int>(kind));
+}
+
+#define INSTANTIATE_REDUCE_CANONICAL(T)                                                                  \
+  template Status reduce_canonical<T, T>(cudaStream_t stream, ReductionKind kind, const T* input, T* output, \
+                                         const CanonicalReduction& canonical_reduction, void* buffer,      \
+                                         size_t buffer_size)
+INSTANTIATE_REDUCE_CANONICAL(half);
+INSTANTIATE_REDUCE_CANONICAL(float);
+INSTANTIATE_REDUCE_CANONICAL(double);
+INSTANTIATE_REDUCE_CANONICAL(BFloat16);
+#undef INSTANTIATE_REDUCE_CANONICAL
+
 }  // namespace cuda
 }  // namespace onnxruntime
@@ -9,9 +9,42 @@
 namespace onnxruntime {
 namespace cuda {
 
+/**
+ * A reduction over a single contiguous range of axes, canonicalized to the reduction of the middle dimension of an
+ * [outer, reduce, inner] tensor.
+ */
+struct CanonicalReduction {
+  int64_t outer;
+  int64_t reduce;
+  int64_t inner;
+};
+
+/** The reductions computed by reduce_canonical(), including the elementwise ops fused before and after them. */
+enum class ReductionKind {
+  Sum,
+  Mean,
+  SumSquare,
+  L1,
+  L2,
+  LogSum,
+  LogSumExp,
+  Max,
+  Min,
+  Prod,
+};
+
 namespace detail {
 size_t compute_reduce_matrix_columns_intermediate_buffer_size(
     int element_size, int num_rows, int num_cols);
+
+size_t compute_canonical_reduction_intermediate_buffer_size(
+    int element_size, const CanonicalReduction& canonical_reduction);
+
+template <typename TIn>
+constexpr int get_canonical_reduction_element_size(ReductionKind kind) {
+  // ReduceLogSumExp accumulates the running maximum and sum of exponentials
+  return (kind == ReductionKind::LogSumExp ? 2 : 1) * static_cast<int>(sizeof(AccumulationType_t<TIn>));
+}
 }  // namespace detail
 
 /**
@@ -80,6 +113,61 @@ ApplicableMatrixReduction get_applicable_matrix_reduction(
     gsl::span<const int64_t> dims, gsl::span<const int64_t> axes,
     int& m, int& n);
 
+/**
+ * Maps a cuDNN reduction op and the elementwise ops applied before or after it to a ReductionKind.
+ * @param cudnn_reduce_op The cuDNN reduction op type.
+ * @param calculate_log Whether the log of the reduction is computed.
+ * @param calculate_sqt Whether the input is squared before the reduction.
+ * @param log_sum_exp Whether the log of the sum of exponentials is computed.
+ * @param[out] kind The reduction kind if there is one.
+ * @return Whether reduce_canonical() computes the reduction.
+ */
+bool get_reduction_kind(
+    cudnnReduceTensorOp_t cudnn_reduce_op, bool calculate_log, bool calculate_sqt, bool log_sum_exp,
+    ReductionKind& kind);
+
+/**
+ * Canonicalizes a reduction to the [outer, reduce, inner] form. Dims with value 1 are ignored, so the reduction
+ * axes only need to be contiguous over the other dims.
+ * @param dims The input dimensions.
+ * @param axes The reduction axes, empty means all axes.
+ * @param[out] canonical_reduction The canonical form if there is one.
+ * @return Whether the reduction axes form a single contiguous range.
+ */
+bool get_canonical_reduction(
+    gsl::span<const int64_t> dims, gsl::span<const int64_t> axes,
+    CanonicalReduction& canonical_reduction);
+
+/**
+ * Computes the size in bytes of the intermediate buffer needed by reduce_canonical().
+ * @tparam TIn The input data type.
+ * @param kind The reduction kind.
+ * @param canonical_reduction The canonical form of the reduction.
+ * @return The size of the intermediate buffer, 0 if none is needed.
+ */
+template <typename TIn>
+size_t compute_canonical_reduction_buffer_size(ReductionKind kind, const CanonicalReduction& canonical_reduction) {
+  return detail::compute_canonical_reduction_intermediate_buffer_size(
+      detail::get_canonical_reduction_element_size<TIn>(kind), canonical_reduction);
+}
+
+/**
+ * Computes a reduction in the canonical [outer, reduce, inner] form to an [outer, inner] output.
+ * The kernel is picked by shape: a warp or a thread block per output for contiguous reductions and a tile of outputs
+ * for strided ones. Reductions that would leave the device underutilized are split into partial results that are
+ * combined by a second pass through the intermediate buffer.
+ * @param kind The reduction kind.
+ * @param input The input data.
+ * @param output The output data.
+ * @param canonical_reduction The canonical form of the reduction.
+ * @param buffer The intermediate buffer.
+ * @param buffer_size The size of the intermediate buffer in bytes.
+ */
+template <typename TIn, typename TOut>
+Status reduce_canonical(
+    cudaStream_t stream, ReductionKind kind, const TIn* input, TOut* output,
+    const CanonicalReduction& canonical_reduction, void* buffer, size_t buffer_size);
+
 /**
  * Reduces the rows in a row-major matrix to a single row containing the sum of each column.
  * @param input The input data.
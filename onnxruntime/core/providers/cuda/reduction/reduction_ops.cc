@@ -464,55 +464,20 @@ Status ReduceComputeCore(const CUDAExecutionProvider& cuda_ep, const Tensor& inp
     return Status::OK();
   }
 
-  // Block of fast matrix reduction.
-  if (fast_reduction) {
-    int m{}, n{};
-    const auto applicable_matrix_reduction =
-        get_applicable_matrix_reduction(cudnn_reduce_op, input_shape.GetDims(), axes, m, n);
-    if (applicable_matrix_reduction != ApplicableMatrixReduction::None) {
-      IAllocatorUniquePtr<T> input_data_buffer(nullptr, [](T*) {});
-      const CudaT* input_data = reinterpret_cast<const CudaT*>(input.Data<T>());
-      if (calculate_sqt) {
-        input_data_buffer = cuda_ep.GetScratchBuffer<T>(input_count, ort_stream, WaitCudaNotificationOnDevice);
-        input_data = reinterpret_cast<CudaT*>(input_data_buffer.get());
-        fast_divmod tmp_div;
-        Impl_Mul<CudaT>(stream, static_cast<int32_t>(SimpleBroadcast::NoBroadcast), nullptr,
-                        reinterpret_cast<const CudaT*>(input.Data<T>()), nullptr,
-                        reinterpret_cast<const CudaT*>(input.Data<T>()), nullptr, tmp_div, tmp_div,
-                        reinterpret_cast<CudaT*>(input_data_buffer.get()), input_count);
-        input_data = reinterpret_cast<const CudaT*>(input_data_buffer.get());
-      }
-
-      switch (applicable_matrix_reduction) {
-        case ApplicableMatrixReduction::Rows: {
-          ORT_RETURN_IF_ERROR(reduce_matrix_rows(
-              stream, input_data, reinterpret_cast<CudaT*>(output.MutableData<T>()), m, n));
-        } break;
-        case ApplicableMatrixReduction::Columns: {
-          const auto buffer_size_bytes = compute_reduce_matrix_columns_buffer_size<CudaT>(m, n);
-          auto buffer = cuda_ep.GetScratchBuffer<void>(buffer_size_bytes, ort_stream, WaitCudaNotificationOnDevice);
-          ORT_RETURN_IF_ERROR(reduce_matrix_columns(stream, input_data,
-                                                    reinterpret_cast<CudaT*>(output.MutableData<T>()), m, n,
-                                                    buffer.get(), buffer_size_bytes));
-        } break;
-        default: {
-          ORT_ENFORCE(false, "Invild matrix reduction type.");
-        }
-      }
-
-      if (calculate_log) {
-        Impl_Log<CudaT>(stream, reinterpret_cast<const CudaT*>(output.Data<T>()),
-                        reinterpret_cast<CudaT*>(output.MutableData<T>()), output_count);
-      } else if (cudnn_reduce_op == CUDNN_REDUCE_TENSOR_AVG) {
-        float denominator_float = applicable_matrix_reduction == ApplicableMatrixReduction::Rows
-                                      ? static_cast<float>(m)
-                                      : static_cast<float>(n);
-        CudaT denominator = ToCudaType<T>::FromFloat(denominator_float);
-        UnaryDiv(stream, reinterpret_cast<const CudaT*>(output.Data<T>()),
-                 reinterpret_cast<CudaT*>(output.MutableData<T>()), denominator, output_count);
-      }
-
-      return Status::OK();
+  // Reductions over a single contiguous range of axes, ignoring dims with value 1, are computed in the canonical
+  // [outer, reduce, inner] form with the elementwise ops before and after the reduction fused into the kernels.
+  // The kernels are deterministic, so they also run when `fast_reduction` is disabled for deterministic compute.
+  ORT_UNUSED_PARAMETER(fast_reduction);
+  if constexpr (ReduceTensorIndices == CUDNN_REDUCE_TENSOR_NO_INDICES) {
+    ReductionKind kind{};
+    CanonicalReduction canonical_reduction{};
+    if (get_reduction_kind(cudnn_reduce_op, calculate_log, calculate_sqt, log_sum_exp, kind) &&
+        get_canonical_reduction(input_shape.GetDims(), axes, canonical_reduction)) {
+      const auto buffer_size_bytes = compute_canonical_reduction_buffer_size<CudaT>(kind, canonical_reduction);
+      auto buffer = cuda_ep.GetScratchBuffer<void>(buffer_size_bytes, ort_stream, WaitCudaNotificationOnDevice);
+      return reduce_canonical(stream, kind, reinterpret_cast<const CudaT*>(input.Data<T>()),
+                              reinterpret_cast<CudaT*>(output.MutableData<T>()), canonical_reduction,
+                              buffer.get(), buffer_size_bytes);
     }
   }
 
@@ -20,5 +20,36 @@ Status GemmInt8(int m,
                 int ldc,
                 const CudaKernel* cuda_kernel,
                 onnxruntime::Stream* stream);
-}
-}
\ No newline at end of file
+
+// Returns true if the cuBLASLt IMMA kernels of GemmInt8Lt and GemmInt8LtQuantized can run on the device for
+// a [n, k] b_transposed. They need Turing or later and, as every matrix is addressed with a leading dimension of
+// k or n, both must be multiples of 4 to keep the matrices 32-bit aligned.
+bool CanUseGemmInt8Lt(const cudaDeviceProp& prop, int n, int k);
+
+// Computes c = alpha * a * b + beta * c with the cuBLASLt IMMA kernels for a row major [m, k] a, a row major
+// [m, n] c and b given as its row major [n, k] transpose, which is the only int8 layout they support.
+Status GemmInt8Lt(int m,
+                  int n,
+                  int k,
+                  int32_t alpha,
+                  int32_t beta,
+                  const int8_t* a,
+                  const int8_t* b_transposed,
+                  int32_t* c,
+                  const CudaKernel* cuda_kernel,
+                  onnxruntime::Stream* stream);
+
+// Same as GemmInt8Lt with the int32 result requantized in the epilogue:
+// c[i, j] = saturate(round(scale * (a * b)[i, j] + bias[j])) for an int8 c and a float bias of n elements.
+Status GemmInt8LtQuantized(int m,
+                           int n,
+                           int k,
+                           float scale,
+                           const float* bias,
+                           const int8_t* a,
+                           const int8_t* b_transposed,
+                           int8_t* c,
+                           const CudaKernel* cuda_kernel,
+                           onnxruntime::Stream* stream);
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "core/providers/cuda/cu_inc/common.cuh"
+#include "core/providers/cuda/cu_inc/row_copy.cuh"
 #include "gather_impl.h"
 
 namespace onnxruntime {
@@ -51,6 +52,36 @@ __global__ void _GatherKernel(
   output_data[id] = input_data[input_index];
 }
 
+// Gathers whole rows of block_size elements, viewed as row_size vectors, with a warp per output row.
+template <typename VecT>
+__global__ void _GatherRowsKernel(
+    const int64_t input_block_size,
+    const int64_t indices_max,
+    const fast_divmod indices_count,
+    const int64_t row_size,
+    const void* indices_data,
+    const size_t index_element_size,
+    const VecT* input_data,
+    VecT* output_data,
+    const int64_t num_rows) {
+  const int lane = threadIdx.x % GPU_WARP_SIZE;
+  const int64_t warps_per_grid = static_cast<int64_t>(gridDim.x) * blockDim.x / GPU_WARP_SIZE;
+  for (int64_t row = (static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x) / GPU_WARP_SIZE;
+       row < num_rows; row += warps_per_grid) {
+    int input_block_index, indices_index;
+    indices_count.divmod(static_cast<int>(row), input_block_index, indices_index);
+    int64_t idx = GetIndexValue(indices_data, index_element_size, indices_index);
+    idx = idx < 0 ? idx + indices_max : idx;
+    VecT* output_row = output_data + row * row_size;
+    if (idx < 0 || idx >= indices_max) {
+      WarpZeroRow(output_row, row_size, lane);
+      continue;
+    }
+
+    WarpCopyRow(output_row, input_data + input_block_index * input_block_size + idx * row_size, row_size, lane);
+  }
+}
+
 void GatherImpl(
     cudaStream_t stream,
     const int64_t input_block_size,
@@ -63,6 +94,22 @@ void GatherImpl(
     size_t element_size,
     void* output_data,
     const size_t N) {
+  // rows of at least kMinWarpRowCopyBytes, like the rows of an embedding lookup, are copied with vectors
+  const size_t row_bytes = static_cast<size_t>(block_size.d_) * element_size;
+  const int vector_size = GetRowCopyVectorSize(row_bytes, {input_data, output_data});
+  if (vector_size != 0) {
+    const int64_t row_size = static_cast<int64_t>(row_bytes / vector_size);
+    const fast_divmod indices_count(output_block_size.d_ / block_size.d_);
+    const int64_t num_rows = static_cast<int64_t>(N) / block_size.d_;
+    DispatchRowCopyVectorSize(vector_size, [&](auto vector) {
+      using VecT = decltype(vector);
+      _GatherRowsKernel<VecT><<<GetRowCopyBlocks(num_rows), kWarpRowCopyWarpsPerBlock * GPU_WARP_SIZE_HOST, 0,
+                                stream>>>(
+          indices_max * row_size, indices_max, indices_count, row_size, indices_data, index_element_size,
+          reinterpret_cast<const VecT*>(input_data), reinterpret_cast<VecT*>(output_data), num_rows);
+    });
+    return;
+  }
 
   int blocksPerGrid = (int)(ceil(static_cast<float>(N) / GridDim::maxThreadsPerBlock));
 
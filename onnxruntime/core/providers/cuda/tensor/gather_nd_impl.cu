@@ -3,6 +3,7 @@
 
 #include "core/providers/cuda/tensor/gather_nd_impl.h"
 #include "core/providers/cuda/cu_inc/common.cuh"
+#include "core/providers/cuda/cu_inc/row_copy.cuh"
 #include "core/providers/cuda/atomic/common.cuh"
 
 namespace onnxruntime {
@@ -50,6 +51,25 @@ __global__ void _GatherNDKernel(
   output_data[i] = input_data[slice_offset + i % slice_size];
 };
 
+// Gathers the slices, viewed as slice_size vectors, with a warp per slice. The slice offsets are multiples of the
+// slice size in elements, so vector_elements divides them.
+template <typename VecT>
+__global__ void _GatherNDRowsKernel(
+    const int64_t num_slices,
+    const VecT* input_data,
+    VecT* output_data,
+    const int64_t slice_size,
+    const int64_t vector_elements,
+    const int64_t* slice_offsets) {
+  const int lane = threadIdx.x % GPU_WARP_SIZE;
+  const int64_t warps_per_grid = static_cast<int64_t>(gridDim.x) * blockDim.x / GPU_WARP_SIZE;
+  for (int64_t slice = (static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x) / GPU_WARP_SIZE;
+       slice < num_slices; slice += warps_per_grid) {
+    WarpCopyRow(output_data + slice * slice_size, input_data + slice_offsets[slice] / vector_elements, slice_size,
+                lane);
+  }
+}
+
 template <typename TIndex>
 void ComputeSliceOffsetsImpl(
     cudaStream_t stream,
@@ -83,6 +103,20 @@ void GatherNDImpl(
     void* output_data,
     const size_t slice_size,
     const int64_t* input_slice_offsets_data) {
+  const int vector_size = GetRowCopyVectorSize(slice_size * sizeof(T), {input_data, output_data});
+  if (vector_size != 0) {
+    const int64_t vector_elements = vector_size / sizeof(T);
+    const int64_t num_rows = static_cast<int64_t>(num_slices);
+    DispatchRowCopyVectorSize(vector_size, [&](auto vector) {
+      using VecT = decltype(vector);
+      _GatherNDRowsKernel<VecT><<<GetRowCopyBlocks(num_rows), kWarpRowCopyWarpsPerBlock * GPU_WARP_SIZE_HOST, 0,
+                                  stream>>>(
+          num_rows, static_cast<const VecT*>(input_data), static_cast<VecT*>(output_data),
+          static_cast<int64_t>(slice_size) / vector_elements, vector_elements, input_slice_offsets_data);
+    });
+    return;
+  }
+
   const unsigned int blocks_per_grid = static_cast<unsigned int>(CeilDiv(num_slices * slice_size, GridDim::maxThreadsPerBlock));
   _GatherNDKernel<T><<<blocks_per_grid, GridDim::maxThreadsPerBlock, 0, stream>>>(
       num_slices, static_cast<const T*>(input_data), static_cast<T*>(output_data), slice_size, input_slice_offsets_data);
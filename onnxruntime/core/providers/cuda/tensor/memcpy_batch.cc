@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/tensor/memcpy_batch.h"
+#include "core/providers/cuda/tensor/memcpy_batch_impl.h"
+
+#include <algorithm>
+
+namespace onnxruntime {
+namespace cuda {
+
+ONNX_OPERATOR_KERNEL_EX(
+    MemcpyFromHostBatch,
+    kOnnxDomain,
+    1,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .SetDefaultInputsMemoryType(OrtMemTypeCPUInput)
+        .TypeConstraint("T", DataTypeImpl::AllFixedSizeTensorTypes()),
+    MemcpyBatch<true>);
+
+ONNX_OPERATOR_KERNEL_EX(
+    MemcpyToHostBatch,
+    kOnnxDomain,
+    1,
+    kCudaExecutionProvider,
+    (*KernelDefBuilder::Create())
+        .SetDefaultOutputMemoryType(OrtMemTypeCPUOutput)
+        .TypeConstraint("T", DataTypeImpl::AllFixedSizeTensorTypes()),
+    MemcpyBatch<false>);
+
+namespace {
+// tensors larger than this are copied on their own
+constexpr size_t kMaxBatchedTensorBytes = 64 * 1024;
+// alignment of the tensors packed in the staging buffer, so that the copy kernel can use vector loads
+constexpr size_t kStagingAlignment = 16;
+
+Status CopyTensor(const OpKernelInfo& info, const Tensor& src, Tensor& dst, onnxruntime::Stream& stream) {
+  auto* data_transfer = info.GetDataTransferManager().GetDataTransfer(src.Location().device, dst.Location().device);
+  return data_transfer->CopyTensorAsync(src, dst, stream);
+}
+
+void LaunchInChunks(cudaStream_t stream, gsl::span<const MemcpyBatchEntry> entries) {
+  MemcpyBatchTable table;
+  for (size_t first = 0; first < entries.size(); first += kMaxMemcpyBatchEntries) {
+    table.count = static_cast<int>(std::min(entries.size() - first, static_cast<size_t>(kMaxMemcpyBatchEntries)));
+    std::copy_n(entries.begin() + first, table.count, table.entries);
+    MemcpyBatchImpl(stream, table);
+  }
+}
+}  // namespace
+
+template <>
+Status MemcpyBatch<true>::ComputeInternal(OpKernelContext* ctx) const {
+  auto* stream = ctx->GetComputeStream();
+  ORT_ENFORCE(stream != nullptr, "MemcpyFromHostBatch: a compute stream is required.");
+
+  // the small inputs are packed in one pinned buffer, which is uploaded with a single copy
+  // and scattered into the outputs on the device
+  InlinedVector<std::pair<const Tensor*, Tensor*>> batched;
+  InlinedVector<size_t> offsets;
+  size_t staging_bytes = 0;
+  for (int i = 0; i < ctx->InputCount(); ++i) {
+    const auto* X = ctx->Input<Tensor>(i);
+    ORT_ENFORCE(X != nullptr, "MemcpyFromHostBatch: Input tensor is nullptr.");
+    Tensor* Y = ctx->Output(i, X->Shape());
+    ORT_ENFORCE(Y != nullptr, "MemcpyFromHostBatch: Failed to allocate output tensor.");
+
+    const size_t bytes = X->SizeInBytes();
+    if (bytes == 0) {
+      continue;
+    }
+    if (bytes > kMaxBatchedTensorBytes) {
+      ORT_RETURN_IF_ERROR(CopyTensor(Info(), *X, *Y, *stream));
+      continue;
+    }
+    batched.emplace_back(X, Y);
+    offsets.push_back(staging_bytes);
+    staging_bytes += (bytes + kStagingAlignment - 1) / kStagingAlignment * kStagingAlignment;
+  }
+
+  if (batched.empty()) {
+    return Status::OK();
+  }
+
+  auto host_staging = AllocateBufferOnCPUPinned<uint8_t>(staging_bytes);
+  auto device_staging = GetScratchBuffer<uint8_t>(staging_bytes, stream);
+  InlinedVector<MemcpyBatchEntry> entries;
+  entries.reserve(batched.size());
+  for (size_t i = 0; i < batched.size(); ++i) {
+    const Tensor& X = *batched[i].first;
+    memcpy(host_staging.get() + offsets[i], X.DataRaw(), X.SizeInBytes());
+    entries.push_back({device_staging.get() + offsets[i], batched[i].second->MutableDataRaw(), X.SizeInBytes()});
+  }
+
+  CUDA_RETURN_IF_ERROR(cudaMemcpyAsync(device_staging.get(), host_staging.get(), staging_bytes,
+                                       cudaMemcpyHostToDevice, Stream(ctx)));
+  AddDeferredReleaseCPUPtr(host_staging.release(), stream);
+  LaunchInChunks(Stream(ctx), entries);
+  return Status::OK();
+}
+
+template <>
+Status MemcpyBatch<false>::ComputeInternal(OpKernelContext* ctx) const {
+  auto* stream = ctx->GetComputeStream();
+  ORT_ENFORCE(stream != nullptr, "MemcpyToHostBatch: a compute stream is required.");
+
+  // the outputs are allocated by cudaMallocHost, so they are mapped in the device address space
+  // and the small inputs are all written to them by a single kernel
+  InlinedVector<MemcpyBatchEntry> entries;
+  for (int i = 0; i < ctx->InputCount(); ++i) {
+    const auto* X = ctx->Input<Tensor>(i);
+    ORT_ENFORCE(X != nullptr, "MemcpyToHostBatch: Input tensor is nullptr.");
+    Tensor* Y = ctx->Output(i, X->Shape());
+    ORT_ENFORCE(Y != nullptr, "MemcpyToHostBatch: Failed to allocate output tensor.");
+
+    const size_t bytes = X->SizeInBytes();
+    if (bytes == 0) {
+      continue;
+    }
+    if (bytes > kMaxBatchedTensorBytes || Y->Location().device.MemType() != OrtDevice::MemType::CUDA_PINNED) {
+      ORT_RETURN_IF_ERROR(CopyTensor(Info(), *X, *Y, *stream));
+      continue;
+    }
+    entries.push_back({X->DataRaw(), Y->MutableDataRaw(), bytes});
+  }
+
+  LaunchInChunks(Stream(ctx), entries);
+  return Status::OK();
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
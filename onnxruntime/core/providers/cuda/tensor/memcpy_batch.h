@@ -0,0 +1,24 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/shared_library/provider_api.h"
+#include "core/providers/cuda/cuda_kernel.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+// Copies all the tensors crossing a host/device boundary at once, see MemcpyFromHostBatch and MemcpyToHostBatch.
+// Small tensors are packed so that the whole boundary costs one transfer instead of one per tensor,
+// larger ones are copied individually as the transfer cost dominates the per copy overhead.
+template <bool FromHost>
+class MemcpyBatch final : public CudaKernel {
+ public:
+  MemcpyBatch(const OpKernelInfo& info) : CudaKernel(info) {}
+
+  Status ComputeInternal(OpKernelContext* context) const override;
+};
+
+}  // namespace cuda
+}  // namespace onnxruntime
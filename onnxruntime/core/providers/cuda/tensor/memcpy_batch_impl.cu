@@ -0,0 +1,40 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cuda/cu_inc/common.cuh"
+#include "memcpy_batch_impl.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+constexpr int kMemcpyBatchThreadsPerBlock = 256;
+
+__global__ void _MemcpyBatchKernel(const MemcpyBatchTable table) {
+  const MemcpyBatchEntry& entry = table.entries[blockIdx.x];
+  const uint8_t* src = static_cast<const uint8_t*>(entry.src);
+  uint8_t* dst = static_cast<uint8_t*>(entry.dst);
+  size_t head = 0;
+
+  if (((reinterpret_cast<uintptr_t>(src) | reinterpret_cast<uintptr_t>(dst)) % sizeof(uint4)) == 0) {
+    const size_t vector_count = entry.bytes / sizeof(uint4);
+    const uint4* src_vector = reinterpret_cast<const uint4*>(src);
+    uint4* dst_vector = reinterpret_cast<uint4*>(dst);
+    for (size_t i = threadIdx.x; i < vector_count; i += blockDim.x) {
+      dst_vector[i] = src_vector[i];
+    }
+    head = vector_count * sizeof(uint4);
+  }
+
+  for (size_t i = head + threadIdx.x; i < entry.bytes; i += blockDim.x) {
+    dst[i] = src[i];
+  }
+}
+
+void MemcpyBatchImpl(cudaStream_t stream, const MemcpyBatchTable& table) {
+  if (table.count > 0) {
+    _MemcpyBatchKernel<<<table.count, kMemcpyBatchThreadsPerBlock, 0, stream>>>(table);
+  }
+}
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -0,0 +1,30 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+#include <stdint.h>
+#include "core/providers/cuda/shared_inc/cuda_utils.h"
+
+namespace onnxruntime {
+namespace cuda {
+
+struct MemcpyBatchEntry {
+  const void* src;
+  void* dst;
+  size_t bytes;
+};
+
+// passed by value as a kernel argument, so it must stay below the 4KB kernel parameter limit
+constexpr int kMaxMemcpyBatchEntries = 128;
+
+struct MemcpyBatchTable {
+  MemcpyBatchEntry entries[kMaxMemcpyBatchEntries];
+  int count;
+};
+
+// copies every entry of the table with one kernel launch, one block per entry.
+// src and dst may be device memory or pinned host memory that is mapped in the device address space.
+void MemcpyBatchImpl(cudaStream_t stream, const MemcpyBatchTable& table);
+
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -3,22 +3,17 @@
 
 #include "core/providers/cuda/tensor/scatter_nd_impl.h"
 #include "core/providers/cuda/cu_inc/common.cuh"
+#include "core/providers/cuda/cu_inc/row_copy.cuh"
 #include "core/providers/cuda/atomic/common.cuh"
 
 namespace onnxruntime {
 namespace cuda {
 
-template <typename T>
-__global__ void _ScatterNDKernel(
-    T* output_data,
-    const size_t num_indices,
+__device__ __forceinline__ int64_t GetScatterNDOffset(
+    const size_t id,
     const int64_t* indices_data,
     const int64_t last_index_dimension,
-    const int64_t* element_counts_and_input_dims,
-    const T* updates_data,
-    const size_t num_updates_elements) {
-  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, num_indices);
-
+    const int64_t* element_counts_and_input_dims) {
   // Compute the base offset into the output data
   int64_t data_offset = 0;
 
@@ -51,6 +46,23 @@ __global__ void _ScatterNDKernel(
     data_offset += (index * element_count_dim);
   }
 
+  return data_offset;
+}
+
+template <typename T>
+__global__ void _ScatterNDKernel(
+    T* output_data,
+    const size_t num_indices,
+    const int64_t* indices_data,
+    const int64_t last_index_dimension,
+    const int64_t* element_counts_and_input_dims,
+    const T* updates_data,
+    const size_t num_updates_elements) {
+  CALCULATE_ELEMENTWISE_INDEX_OR_EXIT(id, num_indices);
+
+  const int64_t data_offset =
+      GetScatterNDOffset(id, indices_data, last_index_dimension, element_counts_and_input_dims);
+
   const T* updates_data_base = updates_data + num_updates_elements * id;
   T* output_data_base = output_data + data_offset;
 
@@ -59,6 +71,30 @@ __global__ void _ScatterNDKernel(
   }
 }
 
+// Scatters the update slices, viewed as num_updates_elements vectors, with a warp per slice. The data offsets are
+// multiples of the slice size in elements, so vector_elements divides them. The indices of ScatterND are unique, so
+// the slices are written without atomics.
+template <typename VecT>
+__global__ void _ScatterNDRowsKernel(
+    VecT* output_data,
+    const size_t num_indices,
+    const int64_t* indices_data,
+    const int64_t last_index_dimension,
+    const int64_t* element_counts_and_input_dims,
+    const VecT* updates_data,
+    const int64_t num_updates_elements,
+    const int64_t vector_elements) {
+  const int lane = threadIdx.x % GPU_WARP_SIZE;
+  const int64_t warps_per_grid = static_cast<int64_t>(gridDim.x) * blockDim.x / GPU_WARP_SIZE;
+  for (int64_t id = (static_cast<int64_t>(blockIdx.x) * blockDim.x + threadIdx.x) / GPU_WARP_SIZE;
+       id < static_cast<int64_t>(num_indices); id += warps_per_grid) {
+    const int64_t data_offset =
+        GetScatterNDOffset(id, indices_data, last_index_dimension, element_counts_and_input_dims);
+    WarpCopyRow(output_data + data_offset / vector_elements, updates_data + id * num_updates_elements,
+                num_updates_elements, lane);
+  }
+}
+
 Status ScatterNDImpl(
     cudaStream_t stream,
     void* output_data,
@@ -72,6 +108,25 @@ Status ScatterNDImpl(
   if (num_indices == 0)
     return Status::OK();
 
+  const int vector_size = GetRowCopyVectorSize(num_updates_elements * element_size, {output_data, updates_data});
+  if (vector_size != 0) {
+    const int64_t vector_elements = vector_size / element_size;
+    DispatchRowCopyVectorSize(vector_size, [&](auto vector) {
+      using VecT = decltype(vector);
+      _ScatterNDRowsKernel<VecT><<<GetRowCopyBlocks(static_cast<int64_t>(num_indices)),
+                                   kWarpRowCopyWarpsPerBlock * GPU_WARP_SIZE_HOST, 0, stream>>>(
+          reinterpret_cast<VecT*>(output_data),
+          num_indices,
+          indices_data,
+          last_index_dimension,
+          element_counts_and_input_dims,
+          reinterpret_cast<const VecT*>(updates_data),
+          static_cast<int64_t>(num_updates_elements) / vector_elements,
+          vector_elements);
+    });
+    return Status::OK();
+  }
+
   // Parallelize on number of indices
   int blocksPerGrid = static_cast<int>(ceil(static_cast<float>(num_indices) / GridDim::maxThreadsPerBlock));
 
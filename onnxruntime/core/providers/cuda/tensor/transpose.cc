@@ -215,6 +215,13 @@ Status Transpose::DoTranspose(const cudaDeviceProp& prop,
                            input.DataRaw(), output.MutableDataRaw(), output.Shape().Size(), grid_size, block_size);
   }
 
+  // Any other permutation that moves the innermost dim is transposed through shared memory tiles.
+  if (CanDoTransposeTiled(prop, static_cast<size_t>(new_rank), new_input_dims, new_permutations, grid_size,
+                          block_size)) {
+    return TransposeTiledImpl(stream, element_size, static_cast<size_t>(new_rank), new_input_dims, new_permutations,
+                              input.DataRaw(), output.MutableDataRaw(), grid_size, block_size);
+  }
+
   // 3D-Transpose can treated as a special case of 4D-Transpose with first dimension being 1.
   if (new_rank == 3) {
     new_permutations[0]++;
@@ -248,6 +255,27 @@ Status Transpose::DoTranspose(const cudaDeviceProp& prop,
   // and even much slower than generic case for some cases.
 
   // General cases
+  // When the innermost dim stays innermost, the rows are copied with the widest vector up to 128 bits that divides
+  // them.
+  int N = gsl::narrow<int>(output.Shape().Size());
+  if (new_permutations[new_rank - 1] == static_cast<size_t>(new_rank - 1)) {
+    const auto row_bytes = static_cast<size_t>(new_input_dims[new_rank - 1]) * element_size;
+    const auto address = reinterpret_cast<uintptr_t>(input.DataRaw()) | reinterpret_cast<uintptr_t>(output.DataRaw());
+    size_t vector_size = 16;
+    while (vector_size > element_size && (row_bytes % vector_size != 0 || address % vector_size != 0)) {
+      vector_size /= 2;
+    }
+    if (vector_size > element_size) {
+      const auto elements_per_vector = static_cast<int64_t>(vector_size / element_size);
+      new_input_dims[new_rank - 1] /= elements_per_vector;
+      new_output_dims[new_rank - 1] /= elements_per_vector;
+      new_input_strides = TensorPitches(new_input_dims);
+      new_output_strides = TensorPitches(new_output_dims);
+      N /= gsl::narrow<int>(elements_per_vector);
+      element_size = vector_size;
+    }
+  }
+
   TArray<int64_t> input_strides(new_rank);
   for (auto i = 0; i < new_rank; i++) {
     input_strides[i] = new_input_strides[new_permutations[i]];
@@ -259,7 +287,7 @@ Status Transpose::DoTranspose(const cudaDeviceProp& prop,
   }
 
   auto status = TransposeImpl(stream, element_size, new_rank, input_strides, input.DataRaw(),
-                              output_strides, output.MutableDataRaw(), gsl::narrow<int>(output.Shape().Size()));
+                              output_strides, output.MutableDataRaw(), N);
 
   return status;
 }
@@ -95,6 +95,153 @@ Status Transpose3DImpl(cudaStream_t stream, size_t element_size, const TArray<in
   return Status::OK();
 }
 
+// Transpose of any rank where the innermost input dim moves. The innermost input dim (cols) and the input dim that
+// becomes the innermost output dim (rows) are transposed through a shared memory tile, so both the reads and the
+// writes are coalesced. All other dims are flattened into the batch, which is decoded with batch_pitches.
+template <typename T, unsigned int TileSize>
+__global__ void TransposeTiledKernel(const int32_t num_batch_dims, const TArray<fast_divmod> batch_pitches,
+                                     const TArray<int64_t> batch_input_strides,
+                                     const TArray<int64_t> batch_output_strides, const int64_t num_batches,
+                                     const int64_t rows, const int64_t cols, const int64_t input_row_stride,
+                                     const int64_t output_col_stride, const T* input_data, T* output_data) {
+  __shared__ T tile[TileSize][TileSize + 1];
+
+  for (int64_t batch = blockIdx.z; batch < num_batches; batch += gridDim.z) {
+    int64_t input_offset = 0;
+    int64_t output_offset = 0;
+    int remaining = static_cast<int>(batch);
+#pragma unroll
+    for (auto dim = 0; dim < batch_pitches.Capacity(); ++dim) {
+      if (dim >= num_batch_dims) {
+        break;
+      }
+      int coord, r;
+      batch_pitches[dim].divmod(remaining, coord, r);
+      remaining = r;
+      input_offset += coord * batch_input_strides[dim];
+      output_offset += coord * batch_output_strides[dim];
+    }
+
+    int64_t x = blockIdx.x * TileSize + threadIdx.x;
+    int64_t y = blockIdx.y * TileSize + threadIdx.y;
+
+    if (x < cols) {
+#pragma unroll
+      for (unsigned int i = 0; i < TileSize; i += (TileSize / kNumElementsPerThread)) {
+        if (y + i < rows) {
+          tile[threadIdx.y + i][threadIdx.x] = input_data[input_offset + (y + i) * input_row_stride + x];
+        }
+      }
+    }
+    __syncthreads();
+
+    x = blockIdx.y * TileSize + threadIdx.x;
+    y = blockIdx.x * TileSize + threadIdx.y;
+
+    if (x < rows) {
+#pragma unroll
+      for (unsigned int i = 0; i < TileSize; i += (TileSize / kNumElementsPerThread)) {
+        if (y + i < cols) {
+          output_data[output_offset + (y + i) * output_col_stride + x] = tile[threadIdx.x][threadIdx.y + i];
+        }
+      }
+    }
+    // the tile is reused by the next batch of this block.
+    __syncthreads();
+  }
+}
+
+bool CanDoTransposeTiled(const cudaDeviceProp& prop, size_t rank, const gsl::span<const int64_t>& input_dims,
+                         const gsl::span<const size_t>& permutations, dim3& grid_size, dim3& block_size) {
+  if (rank < 2 || rank > static_cast<size_t>(TArray<int64_t>::Capacity()) || permutations[rank - 1] == rank - 1) {
+    return false;
+  }
+
+  const int64_t cols = input_dims[rank - 1];
+  const int64_t rows = input_dims[permutations[rank - 1]];
+  // With narrow dims most of each tile is idle and the generic kernel is faster.
+  if (cols < kTileSize / kNumElementsPerThread || rows < kTileSize / kNumElementsPerThread) {
+    return false;
+  }
+
+  int64_t num_batches = 1;
+  for (size_t i = 0; i < rank; ++i) {
+    if (i != rank - 1 && i != permutations[rank - 1]) {
+      num_batches *= input_dims[i];
+    }
+  }
+
+  const int64_t grid_size_x = CeilDiv(cols, static_cast<int64_t>(kTileSize));
+  const int64_t grid_size_y = CeilDiv(rows, static_cast<int64_t>(kTileSize));
+  if (grid_size_x > prop.maxGridSize[0] || grid_size_y > prop.maxGridSize[1] ||
+      num_batches > std::numeric_limits<int>::max()) {
+    return false;
+  }
+
+  // Blocks loop over the batches beyond maxGridSize.z.
+  const int64_t grid_size_z = std::min(num_batches, static_cast<int64_t>(prop.maxGridSize[2]));
+  block_size = dim3(kTileSize, kTileSize / kNumElementsPerThread);
+  grid_size = dim3(static_cast<unsigned int>(grid_size_x), static_cast<unsigned int>(grid_size_y),
+                   static_cast<unsigned int>(grid_size_z));
+  return true;
+}
+
+#define HANDLE_TRANSPOSE_TILED_DIM(type)                                                                          \
+  case sizeof(type): {                                                                                            \
+    TransposeTiledKernel<type, kTileSize>                                                                         \
+        <<<grid_size, block_size, 0, stream>>>(num_batch_dims, batch_pitches, batch_input_strides,                \
+                                               batch_output_strides, num_batches, rows, cols,                     \
+                                               input_strides[permutations[rank - 1]], output_col_stride,          \
+                                               reinterpret_cast<const ToCudaType<type>::MappedType*>(input_data), \
+                                               reinterpret_cast<ToCudaType<type>::MappedType*>(output_data));     \
+  } break
+
+Status TransposeTiledImpl(cudaStream_t stream, size_t element_size, size_t rank,
+                          const gsl::span<const int64_t>& input_dims, const gsl::span<const size_t>& permutations,
+                          const void* input_data, void* output_data, const dim3& grid_size, const dim3& block_size) {
+  TArray<int64_t> input_strides(static_cast<int32_t>(rank));
+  TArray<int64_t> output_strides(static_cast<int32_t>(rank));  // indexed by the input dim
+  int64_t input_pitch = 1;
+  int64_t output_pitch = 1;
+  for (auto i = static_cast<int32_t>(rank) - 1; i >= 0; --i) {
+    input_strides[i] = input_pitch;
+    input_pitch *= input_dims[i];
+    output_strides[static_cast<int32_t>(permutations[i])] = output_pitch;
+    output_pitch *= input_dims[permutations[i]];
+  }
+
+  const int64_t cols = input_dims[rank - 1];
+  const int64_t rows = input_dims[permutations[rank - 1]];
+  const int64_t output_col_stride = output_strides[static_cast<int32_t>(rank) - 1];
+
+  const auto num_batch_dims = static_cast<int32_t>(rank) - 2;
+  TArray<int64_t> batch_input_strides(num_batch_dims);
+  TArray<int64_t> batch_output_strides(num_batch_dims);
+  TArray<fast_divmod> batch_pitches(num_batch_dims);
+  int64_t num_batches = 1;
+  for (auto i = static_cast<int32_t>(rank) - 1, j = num_batch_dims; i >= 0; --i) {
+    if (i != static_cast<int32_t>(rank) - 1 && i != static_cast<int32_t>(permutations[rank - 1])) {
+      --j;
+      batch_input_strides[j] = input_strides[i];
+      batch_output_strides[j] = output_strides[i];
+      batch_pitches[j] = fast_divmod(static_cast<int>(num_batches));
+      num_batches *= input_dims[i];
+    }
+  }
+
+  switch (element_size) {
+    HANDLE_TRANSPOSE_TILED_DIM(int8_t);
+    HANDLE_TRANSPOSE_TILED_DIM(int16_t);
+    HANDLE_TRANSPOSE_TILED_DIM(int32_t);
+    HANDLE_TRANSPOSE_TILED_DIM(int64_t);
+    default:
+      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Type not supported for transpose on CUDA. Element size was ",
+                             element_size);
+  }
+
+  return Status::OK();
+}
+
 template <int element_size>
 __global__ void Transpose4DKernelParallelizeMultipleElementsPerThreadInInnermostDim(
     const TArray<int64_t> input_strides, const void* input_data,
@@ -361,6 +508,15 @@ Status TransposeImpl(cudaStream_t stream, size_t element_size, int32_t shape_ran
           reinterpret_cast<ToCudaType<int64_t>::MappedType*>(output_data),
           N);
       break;
+    case sizeof(int4):
+      // rows of a permutation that keeps the innermost dim, copied as 128-bit vectors.
+      TransposeKernel<int4><<<blocksPerGrid, GridDim::maxThreadsPerBlock, 0, stream>>>(
+          shape_rank, input_strides,
+          reinterpret_cast<const int4*>(input_data),
+          fdm_output_strides,
+          reinterpret_cast<int4*>(output_data),
+          N);
+      break;
     default:
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Type not supported for transpose on CUDA. Element size was ",
                              element_size);
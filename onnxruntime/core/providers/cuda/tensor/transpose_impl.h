@@ -15,6 +15,15 @@ Status Transpose3DImpl(cudaStream_t stream, size_t element_size, const TArray<in
                        void* output_data, int64_t N,
                        const dim3& grid_size, const dim3& block_size);
 
+bool CanDoTransposeTiled(const cudaDeviceProp& prop,
+                         size_t rank, const gsl::span<const int64_t>& input_dims,
+                         const gsl::span<const size_t>& permutations,
+                         dim3& grid_size, dim3& block_size);
+Status TransposeTiledImpl(cudaStream_t stream, size_t element_size, size_t rank,
+                          const gsl::span<const int64_t>& input_dims, const gsl::span<const size_t>& permutations,
+                          const void* input_data, void* output_data,
+                          const dim3& grid_size, const dim3& block_size);
+
 bool CanDoTranspose4DParallelizeMultipleElementsPerThreadInInnermostDim(const cudaDeviceProp& prop,
                                                                         size_t element_size,
                                                                         int32_t rank,
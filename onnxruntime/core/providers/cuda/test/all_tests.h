@@ -9,6 +9,7 @@ namespace test {
 bool TestDeferredRelease();
 bool TestDeferredReleaseWithoutArena();
 bool TestBeamSearchTopK();
+bool TestPagedKVCache();
 
 }  // namespace test
 }  // namespace cuda
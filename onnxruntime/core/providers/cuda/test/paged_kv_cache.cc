@@ -0,0 +1,70 @@
+#ifndef NDEBUG
+
+#include "contrib_ops/cuda/transformers/paged_kv_cache.h"
+
+#include <vector>
+
+namespace onnxruntime {
+namespace cuda {
+namespace test {
+
+bool TestPagedKVCache() {
+  using contrib::cuda::PagedKVCache;
+  constexpr int max_blocks = 3;
+  PagedKVCache cache(/*num_blocks*/ 4, /*block_size*/ 2);
+  std::vector<PagedKVCache::BlockCopy> copies;
+
+  // a prompt of 3 tokens takes 2 blocks
+  int prompt = cache.AddSequence();
+  if (!cache.AppendTokens(prompt, 3, copies).IsOK() || !copies.empty() || cache.NumFreeBlocks() != 2) {
+    return false;
+  }
+
+  // two beams share the blocks of the prompt
+  std::vector<int> beams{prompt, cache.ForkSequence(prompt)};
+  if (cache.NumFreeBlocks() != 2) {
+    return false;
+  }
+
+  // the first beam to append copies the shared last block, the other one then owns it
+  if (!cache.AppendTokens(beams[0], 1, copies).IsOK() || copies.size() != 1 || cache.NumFreeBlocks() != 1) {
+    return false;
+  }
+  if (!cache.AppendTokens(beams[1], 1, copies).IsOK() || copies.size() != 1 || cache.NumFreeBlocks() != 1) {
+    return false;
+  }
+
+  std::vector<int32_t> block_table(beams.size() * max_blocks);
+  std::vector<int32_t> lengths(beams.size());
+  if (!cache.FillBlockTable(beams, max_blocks, block_table, lengths).IsOK()) {
+    return false;
+  }
+  // the beams share the first block, the second block of beam 0 is the copy of the one of beam 1
+  const std::vector<int32_t> expected_block_table{0, 2, 0, 0, 1, 0};
+  if (block_table != expected_block_table || lengths != std::vector<int32_t>{4, 4} ||
+      copies[0].src != 1 || copies[0].dst != 2) {
+    return false;
+  }
+
+  // both beams continue from beam 1, the blocks of beam 0 that are not shared are released
+  cache.ReorderSequences(beams, std::vector<int32_t>{1, 1});
+  if (cache.NumFreeBlocks() != 2 || cache.SequenceLength(beams[0]) != 4) {
+    return false;
+  }
+
+  // there are not enough free blocks for 6 more tokens, the sequence is left unchanged
+  copies.clear();
+  if (cache.AppendTokens(beams[0], 6, copies).IsOK() || cache.SequenceLength(beams[0]) != 4) {
+    return false;
+  }
+
+  for (int beam : beams) {
+    cache.ReleaseSequence(beam);
+  }
+  return cache.NumFreeBlocks() == 4;
+}
+
+}  // namespace test
+}  // namespace cuda
+}  // namespace onnxruntime
+#endif
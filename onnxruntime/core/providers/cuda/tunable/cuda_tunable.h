@@ -17,6 +17,8 @@ namespace tunable {
 
 using OpParams = ::onnxruntime::tunable::OpParams<cudaStream_t>;
 
+using TuningResults = ::onnxruntime::tunable::TuningResults;
+
 template <typename ParamsT>
 using Op = ::onnxruntime::tunable::Op<ParamsT>;
 
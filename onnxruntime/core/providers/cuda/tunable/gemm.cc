@@ -0,0 +1,134 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#define _GEMM_H_KEEP_SIGNATURE_DEFINES
+#include "core/providers/cuda/tunable/gemm.h"
+
+#include "core/providers/cuda/tunable/gemm_cublas.h"
+#include "core/providers/cuda/tunable/gemm_tunable.h"
+
+namespace onnxruntime {
+namespace cuda {
+namespace tunable {
+namespace blas {
+
+namespace row_major {
+
+namespace {
+
+template <typename TunableOpT, typename ParamsT>
+Status RunTunableOp(bool tunable, const ParamsT* params) {
+  // TunableOp keeps the results of its own tuning unsynchronized, so there is one op per thread. The threads share
+  // their results through params->tuning_results.
+  thread_local static TunableOpT op{};
+  if (tunable) {
+    op.EnableTuning();
+  } else {
+    op.DisableTuning();
+  }
+  return op(params);
+}
+
+}  // namespace
+
+template <typename T>
+inline GEMM(T) {
+  GemmParams<T> params;
+  params.stream = stream;
+  params.handle = handle;
+  params.lt_handle = lt_handle;
+  params.device_prop = &device_prop;
+  params.tuning_results = tuning_results;
+
+  params.opa = opa;
+  params.opb = opb;
+  params.m = m;
+  params.n = n;
+  params.k = k;
+  params.alpha = alpha;
+  params.a = a;
+  params.lda = lda;
+  params.b = b;
+  params.ldb = ldb;
+  params.beta = beta;
+  params.c = c;
+  params.ldc = ldc;
+
+  if (tunable || tuning_results != nullptr) {
+    return RunTunableOp<internal::GemmTunableOp<T>>(tunable, &params);
+  }
+
+  return internal::CublasGemmOp(&params);
+}
+
+template <typename T>
+inline STRIDED_BATCHED_GEMM(T) {
+  StridedBatchedGemmParams<T> params;
+  params.stream = stream;
+  params.handle = handle;
+  params.lt_handle = lt_handle;
+  params.device_prop = &device_prop;
+  params.tuning_results = tuning_results;
+
+  params.opa = opa;
+  params.opb = opb;
+  params.m = m;
+  params.n = n;
+  params.k = k;
+  params.alpha = alpha;
+  params.a = a;
+  params.lda = lda;
+  params.stride_a = stride_a;
+  params.b = b;
+  params.ldb = ldb;
+  params.stride_b = stride_b;
+  params.beta = beta;
+  params.c = c;
+  params.ldc = ldc;
+  params.stride_c = stride_c;
+  params.batch = batch;
+
+  if (tunable || tuning_results != nullptr) {
+    return RunTunableOp<internal::StridedBatchedGemmTunableOp<T>>(tunable, &params);
+  }
+
+  return internal::CublasStridedBatchedGemmOp(&params);
+}
+
+#define CALL_GEMM(T)                                        \
+  Gemm<T>(tunable, tuning_results, stream,                  \
+          handle, lt_handle, device_prop,                   \
+          opa, opb,                                         \
+          m, n, k,                                          \
+          alpha, a, lda, b, ldb,                            \
+          beta, c, ldc)
+
+#define CALL_STRIDED_BATCHED_GEMM(T)                        \
+  StridedBatchedGemm<T>(tunable, tuning_results, stream,    \
+                        handle, lt_handle, device_prop,     \
+                        opa, opb,                           \
+                        m, n, k,                            \
+                        alpha,                              \
+                        a, lda, stride_a,                   \
+                        b, ldb, stride_b,                   \
+                        beta,                               \
+                        c, ldc, stride_c,                   \
+                        batch)
+
+// clang-format off
+GEMM(float) { return CALL_GEMM(float); }
+GEMM(half)  { return CALL_GEMM(half); }
+
+STRIDED_BATCHED_GEMM(float) { return CALL_STRIDED_BATCHED_GEMM(float); }
+STRIDED_BATCHED_GEMM(half)  { return CALL_STRIDED_BATCHED_GEMM(half); }
+// clang-format on
+
+#undef CALL_GEMM
+#undef CALL_STRIDED_BATCHED_GEMM
+
+}  // namespace row_major
+
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cuda
+}  // namespace onnxruntime
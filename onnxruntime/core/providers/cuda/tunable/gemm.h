@@ -0,0 +1,57 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/cuda/tunable/gemm_common.h"
+
+namespace onnxruntime {
+namespace cuda {
+namespace tunable {
+namespace blas {
+
+// If tunable is true, the algo is tuned for the shape on its first use. The results of the tuning are shared through
+// tuning_results if it is not nullptr, which also makes the GEMM use the results loaded from a file without tuning.
+#define GEMM(T)                                                                \
+  common::Status Gemm(                                                         \
+      bool tunable, TuningResults* tuning_results, cudaStream_t stream,        \
+      cublasHandle_t handle, cublasLtHandle_t lt_handle,                       \
+      const cudaDeviceProp& device_prop,                                       \
+      BlasOp opa, BlasOp opb,                                                  \
+      std::int64_t m, std::int64_t n, std::int64_t k,                          \
+      float alpha, const T* a, std::int64_t lda, const T* b, std::int64_t ldb, \
+      float beta, T* c, std::int64_t ldc)
+
+#define STRIDED_BATCHED_GEMM(T)                                         \
+  common::Status StridedBatchedGemm(                                    \
+      bool tunable, TuningResults* tuning_results, cudaStream_t stream, \
+      cublasHandle_t handle, cublasLtHandle_t lt_handle,                \
+      const cudaDeviceProp& device_prop,                                \
+      BlasOp opa, BlasOp opb,                                           \
+      std::int64_t m, std::int64_t n, std::int64_t k,                   \
+      float alpha,                                                      \
+      const T* a, std::int64_t lda, std::int64_t stride_a,              \
+      const T* b, std::int64_t ldb, std::int64_t stride_b,              \
+      float beta,                                                       \
+      T* c, std::int64_t ldc, std::int64_t stride_c,                    \
+      std::int64_t batch)
+
+namespace row_major {
+
+GEMM(float);
+GEMM(half);
+
+STRIDED_BATCHED_GEMM(float);
+STRIDED_BATCHED_GEMM(half);
+
+}  // namespace row_major
+
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cuda
+}  // namespace onnxruntime
+
+#ifndef _GEMM_H_KEEP_SIGNATURE_DEFINES
+#undef GEMM
+#undef STRIDED_BATCHED_GEMM
+#endif
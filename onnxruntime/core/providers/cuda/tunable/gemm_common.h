@@ -0,0 +1,84 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+
+#include "core/providers/cuda/cuda_common.h"
+#include "core/providers/cuda/tunable/cuda_tunable.h"
+
+namespace onnxruntime {
+namespace cuda {
+namespace tunable {
+namespace blas {
+
+enum class BlasOp {
+  N = 0,
+  T = 1,
+  NonTrans = 0,
+  Trans = 1,
+};
+
+inline std::string BlasOpToString(BlasOp op) {
+  switch (op) {
+    case BlasOp::N:
+      return "N";
+    case BlasOp::T:
+      return "T";
+    // following is unreachable, compiler is producing false-positive warning, unfortunately.
+    default:
+      ORT_THROW("unreachable");
+  }
+}
+
+inline cublasOperation_t ToCublasOp(BlasOp op) {
+  return op == BlasOp::N ? CUBLAS_OP_N : CUBLAS_OP_T;
+}
+
+// The params follow the row-majored convention, C = alpha * op(A) * op(B) + beta * C with C of m x n, as numpy and
+// pytorch do. The implementations swap A and B to call the column-majored cuBLAS.
+template <typename T>
+struct GemmParams : OpParams {
+  std::string Signature() const override {
+    return MakeString(BlasOpToString(opa), BlasOpToString(opb), "_", m, "_", n, "_", k);
+  }
+
+  TuningResults* GetTuningResults() const override { return tuning_results; }
+
+  cublasHandle_t handle;
+  cublasLtHandle_t lt_handle;
+  const cudaDeviceProp* device_prop;
+  TuningResults* tuning_results{nullptr};
+  BlasOp opa;
+  BlasOp opb;
+  int64_t m;
+  int64_t n;
+  int64_t k;
+  float alpha;
+  const T* a;
+  int64_t lda;
+  const T* b;
+  int64_t ldb;
+  float beta;
+  T* c;
+  int64_t ldc;
+};
+
+// batch GEMMs of the same shape, the i-th GEMM uses a + i * stride_a, b + i * stride_b and c + i * stride_c.
+template <typename T>
+struct StridedBatchedGemmParams : GemmParams<T> {
+  std::string Signature() const override {
+    return MakeString(GemmParams<T>::Signature(), "_B", batch);
+  }
+
+  int64_t stride_a;
+  int64_t stride_b;
+  int64_t stride_c;
+  int64_t batch;
+};
+
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cuda
+}  // namespace onnxruntime
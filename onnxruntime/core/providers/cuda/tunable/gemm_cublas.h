@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <type_traits>
+
+#include "core/providers/cuda/shared_inc/fpgeneric.h"
+#include "core/providers/cuda/tunable/gemm_common.h"
+
+namespace onnxruntime {
+namespace cuda {
+namespace tunable {
+namespace blas {
+namespace internal {
+
+// NOTE: cublas assumes the storage is column-majored, swapping A and B makes it have the same interface
+// as those with row-majored convention. That is, if you treat the storage as row-majored but view the matrices as
+// transposed, then by using the property Transpose(A*B) = Tranpose(B)*Transpose(A), the correctness is obvious.
+
+template <typename T>
+Status CublasGemmOp(const GemmParams<T>* params) {
+  return CUBLAS_CALL(cublasGemmHelper(
+      params->handle,
+      ToCublasOp(params->opb), ToCublasOp(params->opa),
+      static_cast<int>(params->n), static_cast<int>(params->m), static_cast<int>(params->k),
+      &(params->alpha),
+      params->b, static_cast<int>(params->ldb),
+      params->a, static_cast<int>(params->lda),
+      &(params->beta),
+      params->c, static_cast<int>(params->ldc),
+      *params->device_prop));
+}
+
+template <typename T>
+Status CublasStridedBatchedGemmOp(const StridedBatchedGemmParams<T>* params) {
+  return CUBLAS_CALL(cublasGemmStridedBatchedHelper(
+      params->handle,
+      ToCublasOp(params->opb), ToCublasOp(params->opa),
+      static_cast<int>(params->n), static_cast<int>(params->m), static_cast<int>(params->k),
+      &(params->alpha),
+      params->b, static_cast<int>(params->ldb), params->stride_b,
+      params->a, static_cast<int>(params->lda), params->stride_a,
+      &(params->beta),
+      params->c, static_cast<int>(params->ldc), params->stride_c,
+      static_cast<int>(params->batch),
+      *params->device_prop));
+}
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11000
+
+template <typename T>
+constexpr cudaDataType_t CudaDataTypeFor() {
+  static_assert(std::is_same_v<T, float> || std::is_same_v<T, half>, "Unsupported type for tunable GEMM.");
+  return std::is_same_v<T, float> ? CUDA_R_32F : CUDA_R_16F;
+}
+
+// Same precision as cublasGemmHelper: TF32 for float on Ampere or newer, and float accumulation for half.
+template <typename T>
+cublasComputeType_t CublasComputeTypeFor(const cudaDeviceProp& prop) {
+  if constexpr (std::is_same_v<T, float>) {
+    return prop.major >= 8 ? CUBLAS_COMPUTE_32F_FAST_TF32 : CUBLAS_COMPUTE_32F;
+  } else {
+    return CUBLAS_COMPUTE_32F;
+  }
+}
+
+template <typename T>
+bool IsCublasComputeTypeSupported() {
+  // the half GEMMs that accumulate in half precision only go through cublasGemmHelper
+  return std::is_same_v<T, float> || !HalfGemmOptions::GetInstance()->IsCompute16F();
+}
+
+// Number of algos of cublasGemmEx that are tuned: CUBLAS_GEMM_DEFAULT_TENSOR_OP, CUBLAS_GEMM_ALGO0_TENSOR_OP, ...
+constexpr int kCublasGemmAlgoCount = CUBLAS_GEMM_ALGO15_TENSOR_OP - CUBLAS_GEMM_DEFAULT_TENSOR_OP + 1;
+
+// Runs cublasGemmEx or cublasGemmStridedBatchedEx with a given algo.
+template <typename T>
+class CublasGemmAlgoOp {
+ public:
+  explicit CublasGemmAlgoOp(int algo_index)
+      : algo_{static_cast<cublasGemmAlgo_t>(CUBLAS_GEMM_DEFAULT_TENSOR_OP + algo_index)} {}
+
+  Status operator()(const GemmParams<T>* params) {
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(!IsCublasComputeTypeSupported<T>(), "half compute type is not tuned");
+    return ToStatus(cublasGemmEx(
+        params->handle,
+        ToCublasOp(params->opb), ToCublasOp(params->opa),
+        static_cast<int>(params->n), static_cast<int>(params->m), static_cast<int>(params->k),
+        &(params->alpha),
+        params->b, CudaDataTypeFor<T>(), static_cast<int>(params->ldb),
+        params->a, CudaDataTypeFor<T>(), static_cast<int>(params->lda),
+        &(params->beta),
+        params->c, CudaDataTypeFor<T>(), static_cast<int>(params->ldc),
+        CublasComputeTypeFor<T>(*params->device_prop), algo_));
+  }
+
+  Status operator()(const StridedBatchedGemmParams<T>* params) {
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(!IsCublasComputeTypeSupported<T>(), "half compute type is not tuned");
+    return ToStatus(cublasGemmStridedBatchedEx(
+        params->handle,
+        ToCublasOp(params->opb), ToCublasOp(params->opa),
+        static_cast<int>(params->n), static_cast<int>(params->m), static_cast<int>(params->k),
+        &(params->alpha),
+        params->b, CudaDataTypeFor<T>(), static_cast<int>(params->ldb), params->stride_b,
+        params->a, CudaDataTypeFor<T>(), static_cast<int>(params->lda), params->stride_a,
+        &(params->beta),
+        params->c, CudaDataTypeFor<T>(), static_cast<int>(params->ldc), params->stride_c,
+        static_cast<int>(params->batch),
+        CublasComputeTypeFor<T>(*params->device_prop), algo_));
+  }
+
+ private:
+  Status ToStatus(cublasStatus_t status) const {
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(status == CUBLAS_STATUS_NOT_SUPPORTED,
+                                              "cublasGemmEx algo ", algo_, " is not supported");
+    return CUBLAS_CALL(status);
+  }
+
+  cublasGemmAlgo_t algo_;
+};
+
+#endif
+
+}  // namespace internal
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -0,0 +1,169 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+#include "core/providers/cuda/tunable/gemm_common.h"
+#include "core/providers/cuda/tunable/gemm_cublas.h"
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11000
+
+namespace onnxruntime {
+namespace cuda {
+namespace tunable {
+namespace blas {
+namespace internal {
+
+// Number of the best algos by the cuBLASLt heuristics that are tuned.
+constexpr int kCublasLtHeuristicCount = 8;
+
+// Owns the cuBLASLt descriptors of a GEMM, following the cuBLAS convention of CublasGemmOp.
+class CublasLtGemmDescriptors {
+ public:
+  template <typename T>
+  CublasLtGemmDescriptors(const GemmParams<T>* params, int64_t batch,
+                          int64_t stride_a, int64_t stride_b, int64_t stride_c) {
+    constexpr cudaDataType_t data_type = CudaDataTypeFor<T>();
+    CUBLAS_CALL_THROW(cublasLtMatmulDescCreate(&matmul_, CublasComputeTypeFor<T>(*params->device_prop), CUDA_R_32F));
+    const cublasOperation_t trans_a = ToCublasOp(params->opb);
+    const cublasOperation_t trans_b = ToCublasOp(params->opa);
+    CUBLAS_CALL_THROW(cublasLtMatmulDescSetAttribute(matmul_, CUBLASLT_MATMUL_DESC_TRANSA, &trans_a, sizeof(trans_a)));
+    CUBLAS_CALL_THROW(cublasLtMatmulDescSetAttribute(matmul_, CUBLASLT_MATMUL_DESC_TRANSB, &trans_b, sizeof(trans_b)));
+
+    // cuBLAS A is b of n x k, cuBLAS B is a of k x m, and C is n x m
+    CreateLayout(&a_, data_type, params->opb == BlasOp::N ? params->n : params->k,
+                 params->opb == BlasOp::N ? params->k : params->n, params->ldb, batch, stride_b);
+    CreateLayout(&b_, data_type, params->opa == BlasOp::N ? params->k : params->m,
+                 params->opa == BlasOp::N ? params->m : params->k, params->lda, batch, stride_a);
+    CreateLayout(&c_, data_type, params->n, params->m, params->ldc, batch, stride_c);
+  }
+
+  ~CublasLtGemmDescriptors() {
+    if (c_) cublasLtMatrixLayoutDestroy(c_);
+    if (b_) cublasLtMatrixLayoutDestroy(b_);
+    if (a_) cublasLtMatrixLayoutDestroy(a_);
+    if (matmul_) cublasLtMatmulDescDestroy(matmul_);
+  }
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CublasLtGemmDescriptors);
+
+  cublasLtMatmulDesc_t matmul_{};
+  cublasLtMatrixLayout_t a_{};
+  cublasLtMatrixLayout_t b_{};
+  cublasLtMatrixLayout_t c_{};
+
+ private:
+  static void CreateLayout(cublasLtMatrixLayout_t* layout, cudaDataType_t data_type,
+                           int64_t rows, int64_t cols, int64_t ld, int64_t batch, int64_t stride) {
+    CUBLAS_CALL_THROW(cublasLtMatrixLayoutCreate(layout, data_type, rows, cols, ld));
+    if (batch > 1) {
+      const int32_t batch_count = static_cast<int32_t>(batch);
+      CUBLAS_CALL_THROW(cublasLtMatrixLayoutSetAttribute(*layout, CUBLASLT_MATRIX_LAYOUT_BATCH_COUNT,
+                                                         &batch_count, sizeof(batch_count)));
+      CUBLAS_CALL_THROW(cublasLtMatrixLayoutSetAttribute(*layout, CUBLASLT_MATRIX_LAYOUT_STRIDED_BATCH_OFFSET,
+                                                         &stride, sizeof(stride)));
+    }
+  }
+};
+
+// Runs cublasLtMatmul with the heuristic_index-th best algo returned by the cuBLASLt heuristics for the problem.
+// The algos are queried once per problem and kept by the op, so the op must not be shared by threads.
+template <typename T>
+class CublasLtGemmOp {
+ public:
+  explicit CublasLtGemmOp(int heuristic_index) : heuristic_index_{heuristic_index} {}
+
+  Status operator()(const GemmParams<T>* params) {
+    return Run(params, 1, 0, 0, 0);
+  }
+
+  Status operator()(const StridedBatchedGemmParams<T>* params) {
+    return Run(params, params->batch, params->stride_a, params->stride_b, params->stride_c);
+  }
+
+ private:
+  static uint32_t AlignmentOf(const void* p) {
+    // cuBLASLt assumes 256 bytes aligned pointers by default
+    uint32_t alignment = 256;
+    while (reinterpret_cast<uintptr_t>(p) % alignment != 0) {
+      alignment /= 2;
+    }
+    return alignment;
+  }
+
+  Status Run(const GemmParams<T>* params, int64_t batch, int64_t stride_a, int64_t stride_b, int64_t stride_c) {
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(!IsCublasComputeTypeSupported<T>(), "half compute type is not tuned");
+
+    CublasLtGemmDescriptors descriptors(params, batch, stride_a, stride_b, stride_c);
+
+    const uint32_t alignment_a = AlignmentOf(params->b);
+    const uint32_t alignment_b = AlignmentOf(params->a);
+    const uint32_t alignment_c = AlignmentOf(params->c);
+    const std::string key = MakeString(params->Signature(), "_", params->lda, "_", params->ldb, "_", params->ldc, "_",
+                                       stride_a, "_", stride_b, "_", stride_c, "_",
+                                       alignment_a, "_", alignment_b, "_", alignment_c);
+    auto it = algos_.find(key);
+    if (it == algos_.end()) {
+      cublasLtMatmulPreference_t preference = nullptr;
+      CUBLAS_RETURN_IF_ERROR(cublasLtMatmulPreferenceCreate(&preference));
+      // the algos run without workspace
+      const uint64_t workspace_size = 0;
+      cublasLtMatmulPreferenceSetAttribute(preference, CUBLASLT_MATMUL_PREF_MAX_WORKSPACE_BYTES,
+                                           &workspace_size, sizeof(workspace_size));
+      cublasLtMatmulPreferenceSetAttribute(preference, CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_A_BYTES,
+                                           &alignment_a, sizeof(alignment_a));
+      cublasLtMatmulPreferenceSetAttribute(preference, CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_B_BYTES,
+                                           &alignment_b, sizeof(alignment_b));
+      cublasLtMatmulPreferenceSetAttribute(preference, CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_C_BYTES,
+                                           &alignment_c, sizeof(alignment_c));
+      cublasLtMatmulPreferenceSetAttribute(preference, CUBLASLT_MATMUL_PREF_MIN_ALIGNMENT_D_BYTES,
+                                           &alignment_c, sizeof(alignment_c));
+
+      cublasLtMatmulHeuristicResult_t results[kCublasLtHeuristicCount] = {};
+      int result_count = 0;
+      const cublasStatus_t status = cublasLtMatmulAlgoGetHeuristic(
+          params->lt_handle, descriptors.matmul_, descriptors.a_, descriptors.b_, descriptors.c_, descriptors.c_,
+          preference, kCublasLtHeuristicCount, results, &result_count);
+      cublasLtMatmulPreferenceDestroy(preference);
+
+      Algo algo{};
+      if (status == CUBLAS_STATUS_SUCCESS && heuristic_index_ < result_count) {
+        algo.found = true;
+        algo.algo = results[heuristic_index_].algo;
+      }
+      it = algos_.emplace(key, algo).first;
+    }
+
+    TUNABLE_OP_RETURN_UNSUPPORTED_ARGUMENT_IF(!it->second.found, "cuBLASLt has no algo ", heuristic_index_,
+                                              " for ", key);
+    return CUBLAS_CALL(cublasLtMatmul(
+        params->lt_handle, descriptors.matmul_,
+        &(params->alpha),
+        params->b, descriptors.a_,
+        params->a, descriptors.b_,
+        &(params->beta),
+        params->c, descriptors.c_,
+        params->c, descriptors.c_,
+        &(it->second.algo), nullptr, 0, params->stream));
+  }
+
+  struct Algo {
+    bool found;
+    cublasLtMatmulAlgo_t algo;
+  };
+
+  int heuristic_index_;
+  std::unordered_map<std::string, Algo> algos_;
+};
+
+}  // namespace internal
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cuda
+}  // namespace onnxruntime
+
+#endif
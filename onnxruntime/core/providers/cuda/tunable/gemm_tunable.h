@@ -0,0 +1,95 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "core/providers/cuda/tunable/cuda_tunable.h"
+#include "core/providers/cuda/tunable/gemm_common.h"
+#include "core/providers/cuda/tunable/gemm_cublas.h"
+#include "core/providers/cuda/tunable/gemm_cublaslt.h"
+
+namespace onnxruntime {
+namespace cuda {
+namespace tunable {
+namespace blas {
+namespace internal {
+
+// The ids of the ops are persisted in the tuning results, so the ops must always be registered in the same order:
+// the default cuBLAS GEMM, the cublasGemmEx algos and then the cuBLASLt algos by heuristic rank.
+template <typename T, typename ParamsT, typename OpT>
+void RegisterGemmOps(std::vector<Op<ParamsT>>& ops, OpT&& default_op) {
+  ops.emplace_back(std::forward<OpT>(default_op));
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11000
+  for (int i = 0; i < kCublasGemmAlgoCount; i++) {
+    ops.emplace_back(CublasGemmAlgoOp<T>(i));
+  }
+  for (int i = 0; i < kCublasLtHeuristicCount; i++) {
+    ops.emplace_back(CublasLtGemmOp<T>(i));
+  }
+#endif
+}
+
+template <typename T>
+class GemmTunableOp : public TunableOp<GemmParams<T>> {
+ public:
+  GemmTunableOp() {
+    RegisterGemmOps<T>(this->ops_, CublasGemmOp<T>);
+  }
+
+  const GemmParams<T>* PreTuning(const GemmParams<T>* params) override {
+    if (params->beta != 0.0f) {
+      // When beta != 0, C buffer is used as an input as well as an output. Tuning over it would accumulate
+      // alpha * A * B into C at each iteration, so the tuning runs on a proxy C buffer.
+      GemmParams<T>* proxy = new GemmParams<T>();
+      *proxy = *params;
+      CUDA_CALL_THROW(cudaMalloc(&(proxy->c), proxy->m * proxy->ldc * sizeof(T)));
+      return proxy;
+    }
+
+    return params;
+  }
+
+  void PostTuning(const GemmParams<T>* params) override {
+    if (params->beta != 0.0f) {
+      CUDA_CALL_THROW(cudaFree(params->c));
+      delete params;
+    }
+  }
+};
+
+template <typename T>
+class StridedBatchedGemmTunableOp : public TunableOp<StridedBatchedGemmParams<T>> {
+ public:
+  StridedBatchedGemmTunableOp() {
+    RegisterGemmOps<T>(this->ops_, CublasStridedBatchedGemmOp<T>);
+  }
+
+  const StridedBatchedGemmParams<T>* PreTuning(const StridedBatchedGemmParams<T>* params) override {
+    if (params->beta != 0.0f) {
+      // See GemmTunableOp<T>::PreTuning.
+      StridedBatchedGemmParams<T>* proxy = new StridedBatchedGemmParams<T>();
+      *proxy = *params;
+      CUDA_CALL_THROW(cudaMalloc(&(proxy->c),
+                                 (proxy->stride_c * (proxy->batch - 1) + proxy->m * proxy->ldc) * sizeof(T)));
+      return proxy;
+    }
+
+    return params;
+  }
+
+  void PostTuning(const StridedBatchedGemmParams<T>* params) override {
+    if (params->beta != 0.0f) {
+      CUDA_CALL_THROW(cudaFree(params->c));
+      delete params;
+    }
+  }
+};
+
+}  // namespace internal
+}  // namespace blas
+}  // namespace tunable
+}  // namespace cuda
+}  // namespace onnxruntime
@@ -87,18 +87,38 @@ namespace Dml
                 [&](ComPtr<ID3D12Resource>& resource){ m_winmlProvider->QueueReference(WRAP_GRAPHICS_UNKNOWN(resource).Get()); }
             );
 
+            m_reuseCommandList = reuseCommandList;
             if (reuseCommandList)
             {
-                BuildReusableCommandList();
+                m_reusableCommandLists.push_back(BuildReusableCommandList());
             }
         }
 
         onnxruntime::Status Compute(onnxruntime::OpKernelContext* kernelContext) const override
         {
-            // Only re-use the cached command list if its prior execution is complete on the GPU.
-            // This requirement can be avoided by mantaining ring buffers.
-            if (!m_graphicsCommandList ||
-                (m_fence != nullptr && m_fence->GetCompletedValue() < m_completionValue))
+            // Only re-use a cached command list if its prior execution is complete on the GPU. A small ring of
+            // command lists is kept so back-to-back executions don't fall back to re-recording while the previous
+            // one is still in flight.
+            ReusableCommandList* reusableCommandList = nullptr;
+            if (m_reuseCommandList)
+            {
+                for (auto& candidate : m_reusableCommandLists)
+                {
+                    if (candidate->fence == nullptr || candidate->fence->GetCompletedValue() >= candidate->completionValue)
+                    {
+                        reusableCommandList = candidate.get();
+                        break;
+                    }
+                }
+
+                if (!reusableCommandList && m_reusableCommandLists.size() < c_maxReusableCommandLists)
+                {
+                    m_reusableCommandLists.push_back(BuildReusableCommandList());
+                    reusableCommandList = m_reusableCommandLists.back().get();
+                }
+            }
+
+            if (!reusableCommandList)
             {
                 // Wrap tensors as required by Dml::IExecutionProvider::ExecuteOperator
                 OpKernelContextWrapper contextWrapper(
@@ -147,7 +167,7 @@ namespace Dml
             }
             else
             {
-                ExecuteReusableCommandList(kernelContext);
+                ExecuteReusableCommandList(kernelContext, *reusableCommandList);
             }
 
             return onnxruntime::Status::OK();
@@ -217,8 +237,30 @@ namespace Dml
             }
 
     private:
-        void BuildReusableCommandList()
+        // Re-usable command list, supporting descriptor heap, and DML binding table to update that heap.
+        struct ReusableCommandList
         {
+            ComPtr<ID3D12GraphicsCommandList> graphicsCommandList;
+            ComPtr<ID3D12CommandAllocator> commandAllocator;
+            ComPtr<ID3D12DescriptorHeap> heap;
+            ComPtr<IDMLBindingTable> bindingTable;
+
+            // Bindings from previous executions of the command list, used to skip re-binding the descriptor table
+            // when the same resources are used again.
+            std::vector<uint64_t> inputBindingAllocIds;
+            std::vector<uint64_t> outputBindingAllocIds;
+            uint64_t tempBindingAllocId = 0;
+
+            // Fence tracking the status of the command list's last execution, and whether its descriptor heap
+            // can safely be updated.
+            ComPtr<ID3D12Fence> fence;
+            uint64_t completionValue = 0;
+        };
+
+        std::unique_ptr<ReusableCommandList> BuildReusableCommandList() const
+        {
+            auto commandList = std::make_unique<ReusableCommandList>();
+
             ComPtr<IDMLDevice> device;
             ORT_THROW_IF_FAILED(m_provider->GetDmlDevice(device.GetAddressOf()));
 
@@ -232,47 +274,48 @@ namespace Dml
             ComPtr<ID3D12Device> d3dDevice;
             ORT_THROW_IF_FAILED(m_provider->GetD3DDevice(d3dDevice.GetAddressOf()));
 
-            ORT_THROW_IF_FAILED(d3dDevice->CreateDescriptorHeap(&desc, IID_GRAPHICS_PPV_ARGS(m_heap.ReleaseAndGetAddressOf())));
+            ORT_THROW_IF_FAILED(d3dDevice->CreateDescriptorHeap(&desc, IID_GRAPHICS_PPV_ARGS(commandList->heap.ReleaseAndGetAddressOf())));
 
             // Create a binding table for execution.
             DML_BINDING_TABLE_DESC bindingTableDesc = {};
             bindingTableDesc.Dispatchable = m_compiledExecutionPlanOperator.Get();
-            bindingTableDesc.CPUDescriptorHandle = m_heap->GetCPUDescriptorHandleForHeapStart();
-            bindingTableDesc.GPUDescriptorHandle = m_heap->GetGPUDescriptorHandleForHeapStart();
+            bindingTableDesc.CPUDescriptorHandle = commandList->heap->GetCPUDescriptorHandleForHeapStart();
+            bindingTableDesc.GPUDescriptorHandle = commandList->heap->GetGPUDescriptorHandleForHeapStart();
             bindingTableDesc.SizeInDescriptors = execBindingProps.RequiredDescriptorCount;
 
-            ORT_THROW_IF_FAILED(device->CreateBindingTable(&bindingTableDesc, IID_PPV_ARGS(&m_bindingTable)));
+            ORT_THROW_IF_FAILED(device->CreateBindingTable(&bindingTableDesc, IID_PPV_ARGS(&commandList->bindingTable)));
 
             ORT_THROW_IF_FAILED(d3dDevice->CreateCommandAllocator(
                 m_provider->GetCommandListTypeForQueue(),
-                IID_GRAPHICS_PPV_ARGS(m_commandAllocator.ReleaseAndGetAddressOf())));
+                IID_GRAPHICS_PPV_ARGS(commandList->commandAllocator.ReleaseAndGetAddressOf())));
 
             ORT_THROW_IF_FAILED(d3dDevice->CreateCommandList(
                 0,
                 m_provider->GetCommandListTypeForQueue(),
-                m_commandAllocator.Get(),
+                commandList->commandAllocator.Get(),
                 nullptr,
-                IID_GRAPHICS_PPV_ARGS(m_graphicsCommandList.ReleaseAndGetAddressOf())));
+                IID_GRAPHICS_PPV_ARGS(commandList->graphicsCommandList.ReleaseAndGetAddressOf())));
 
             if (m_persistentResource)
             {
                 DML_BINDING_DESC persistentResourceBindingDesc =
                     { DML_BINDING_TYPE_BUFFER, m_persistentResourceBinding ? &*m_persistentResourceBinding : nullptr };
-                m_bindingTable->BindPersistentResource(&persistentResourceBindingDesc);
+                commandList->bindingTable->BindPersistentResource(&persistentResourceBindingDesc);
             }
 
-            ID3D12DescriptorHeap* descriptorHeaps[] = { m_heap.Get() };
-            m_graphicsCommandList->SetDescriptorHeaps(ARRAYSIZE(descriptorHeaps), descriptorHeaps);
+            ID3D12DescriptorHeap* descriptorHeaps[] = { commandList->heap.Get() };
+            commandList->graphicsCommandList->SetDescriptorHeaps(ARRAYSIZE(descriptorHeaps), descriptorHeaps);
 
             ComPtr<IDMLCommandRecorder> recorder;
             ORT_THROW_IF_FAILED(device->CreateCommandRecorder(IID_PPV_ARGS(recorder.GetAddressOf())));
 
-            recorder->RecordDispatch(m_graphicsCommandList.Get(), m_compiledExecutionPlanOperator.Get(), m_bindingTable.Get());
+            recorder->RecordDispatch(commandList->graphicsCommandList.Get(), m_compiledExecutionPlanOperator.Get(), commandList->bindingTable.Get());
 
-            ORT_THROW_IF_FAILED(m_graphicsCommandList->Close());
+            ORT_THROW_IF_FAILED(commandList->graphicsCommandList->Close());
+            return commandList;
         }
 
-        void ExecuteReusableCommandList(onnxruntime::OpKernelContext* kernelContext) const
+        void ExecuteReusableCommandList(onnxruntime::OpKernelContext* kernelContext, ReusableCommandList& commandList) const
         {
             DML_BINDING_PROPERTIES execBindingProps = m_compiledExecutionPlanOperator->GetBindingProperties();
 
@@ -287,7 +330,7 @@ namespace Dml
 
             // Populate input bindings, excluding those which were specified as owned by DML and provided
             // at initialization instead.
-            m_inputBindingAllocIds.resize(inputBindings.size());
+            commandList.inputBindingAllocIds.resize(inputBindings.size());
             bool inputBindingsChanged = false;
 
             for (uint32_t i = 0; i < inputBindings.size(); ++i)
@@ -306,25 +349,25 @@ namespace Dml
 
                         uint64_t allocId;
                         DmlGraphFusionHelper::UnwrapTensor(m_winmlProvider.Get(), tensor, &inputBindings[i].Buffer, &allocId);
-                        inputBindingsChanged = inputBindingsChanged || (!allocId || m_inputBindingAllocIds[i] != allocId);
+                        inputBindingsChanged = inputBindingsChanged || (!allocId || commandList.inputBindingAllocIds[i] != allocId);
                         inputBindings[i].Buffer->Release(); // Avoid holding an additional reference
                         inputBindings[i].SizeInBytes = DmlGraphFusionHelper::AlignToPow2<size_t>(tensor->SizeInBytes(), 4);
                         inputBindingDescs[i] = {DML_BINDING_TYPE_BUFFER, &inputBindings[i]};
-                        m_inputBindingAllocIds[i] = allocId;
+                        commandList.inputBindingAllocIds[i] = allocId;
                     }
                 }
             }
 
             if (inputBindingsChanged)
             {
-                m_bindingTable->BindInputs(gsl::narrow_cast<uint32_t>(inputBindingDescs.size()), inputBindingDescs.data());
+                commandList.bindingTable->BindInputs(gsl::narrow_cast<uint32_t>(inputBindingDescs.size()), inputBindingDescs.data());
             }
 
             // Populate Output bindings
             std::vector<DML_BUFFER_BINDING> outputBindings(kernelContext->OutputCount());
             std::vector<DML_BINDING_DESC> outputBindingDescs(kernelContext->OutputCount());
 
-            m_outputBindingAllocIds.resize(outputBindings.size());
+            commandList.outputBindingAllocIds.resize(outputBindings.size());
             bool outputBindingsChanged = false;
 
             for (uint32_t i = 0; i < outputBindings.size(); ++i)
@@ -343,16 +386,16 @@ namespace Dml
 
                 uint64_t allocId;
                 DmlGraphFusionHelper::UnwrapTensor(m_winmlProvider.Get(), tensor, &outputBindings[i].Buffer, &allocId);
-                outputBindingsChanged = outputBindingsChanged || (!allocId || m_outputBindingAllocIds[i] != allocId);
+                outputBindingsChanged = outputBindingsChanged || (!allocId || commandList.outputBindingAllocIds[i] != allocId);
                 outputBindings[i].Buffer->Release(); // Avoid holding an additional reference
                 outputBindings[i].SizeInBytes = DmlGraphFusionHelper::AlignToPow2<size_t>(tensor->SizeInBytes(), 4);
                 outputBindingDescs[i] = {DML_BINDING_TYPE_BUFFER, &outputBindings[i]};
-                m_outputBindingAllocIds[i] = allocId;
+                commandList.outputBindingAllocIds[i] = allocId;
             }
 
             if (outputBindingsChanged)
             {
-                m_bindingTable->BindOutputs(gsl::narrow_cast<uint32_t>(outputBindingDescs.size()), outputBindingDescs.data());
+                commandList.bindingTable->BindOutputs(gsl::narrow_cast<uint32_t>(outputBindingDescs.size()), outputBindingDescs.data());
             }
 
             if (execBindingProps.TemporaryResourceSize > 0)
@@ -372,19 +415,19 @@ namespace Dml
                 DML_BUFFER_BINDING tempBufferBinding = {tempResource.Get(), 0, execBindingProps.TemporaryResourceSize};
                 DML_BINDING_DESC tempBindingDesc = { DML_BINDING_TYPE_BUFFER, &tempBufferBinding };
 
-                if (!tempAllocId || m_tempBindingAllocId != tempAllocId)
+                if (!tempAllocId || commandList.tempBindingAllocId != tempAllocId)
                 {
-                    m_bindingTable->BindTemporaryResource(&tempBindingDesc);
+                    commandList.bindingTable->BindTemporaryResource(&tempBindingDesc);
                 }
 
-                m_tempBindingAllocId = tempAllocId;
+                commandList.tempBindingAllocId = tempAllocId;
             }
 
             // Execute the command list and if it succeeds, update the fence value at which this command may be
             // re-used.
             ComPtr<ID3D12Fence> fence;
             uint64_t completionValue;
-            HRESULT hr = m_provider->ExecuteCommandList(m_graphicsCommandList.Get(), fence.GetAddressOf(), &completionValue);
+            HRESULT hr = m_provider->ExecuteCommandList(commandList.graphicsCommandList.Get(), fence.GetAddressOf(), &completionValue);
 
             if (hr == DXGI_ERROR_DEVICE_REMOVED)
             {
@@ -394,13 +437,13 @@ namespace Dml
             }
 
             ORT_THROW_IF_FAILED(hr);
-            m_fence = fence;
-            m_completionValue = completionValue;
+            commandList.fence = fence;
+            commandList.completionValue = completionValue;
 
             // Queue references to objects which must be kept alive until resulting GPU work completes
-            m_winmlProvider->QueueReference(WRAP_GRAPHICS_UNKNOWN(m_graphicsCommandList).Get());
-            m_winmlProvider->QueueReference(WRAP_GRAPHICS_UNKNOWN(m_heap).Get());
-            m_winmlProvider->QueueReference(m_bindingTable.Get());
+            m_winmlProvider->QueueReference(WRAP_GRAPHICS_UNKNOWN(commandList.graphicsCommandList).Get());
+            m_winmlProvider->QueueReference(WRAP_GRAPHICS_UNKNOWN(commandList.heap).Get());
+            m_winmlProvider->QueueReference(commandList.bindingTable.Get());
             m_winmlProvider->QueueReference(m_persistentResourceAllocatorUnk.Get());
         }
 
@@ -411,25 +454,15 @@ namespace Dml
         ComPtr<Dml::IExecutionProvider> m_provider;
         Windows::AI::MachineLearning::Adapter::EdgeShapes& m_outputShapes;
 
-        // Re-usable command list, supporting descriptor heap, and DML binding table to update that heap.
-        ComPtr<ID3D12GraphicsCommandList> m_graphicsCommandList;
-        ComPtr<ID3D12CommandAllocator> m_commandAllocator;
-        ComPtr<ID3D12DescriptorHeap> m_heap;
-        ComPtr<IDMLBindingTable> m_bindingTable;
+        // Ring of re-usable command lists, grown on demand up to c_maxReusableCommandLists entries.
+        static constexpr size_t c_maxReusableCommandLists = 3;
+        bool m_reuseCommandList = false;
+        mutable std::vector<std::unique_ptr<ReusableCommandList>> m_reusableCommandLists;
+
         std::optional<DML_BUFFER_BINDING> m_persistentResourceBinding;
         ComPtr<ID3D12Resource> m_persistentResource;
         ComPtr<IUnknown> m_persistentResourceAllocatorUnk; // Controls when the persistent resource is returned to the allocator
 
-        // Bindings from previous executions of a re-used command list
-        mutable std::vector<uint64_t> m_inputBindingAllocIds;
-        mutable std::vector<uint64_t> m_outputBindingAllocIds;
-        mutable uint64_t m_tempBindingAllocId = 0;
-
-        // Fence tracking the status of the command list's last execution, and whether its descriptor heap
-        // can safely be updated.
-        mutable ComPtr<ID3D12Fence> m_fence;
-        mutable uint64_t m_completionValue = 0;
-
         std::vector<uint8_t> m_isInputsUploadedByDmlEP;
         std::vector<ComPtr<ID3D12Resource>> m_nonOwnedGraphInputsFromInitializers;
     };
@@ -13,6 +13,28 @@ void DnnlBinary::CreatePrimitive(DnnlSubgraphPrimitive& sp, DnnlNode& node) {
 
   dnnl::algorithm algo = dnnl_util::OrtOperatorToDnnlAlgorithm(node.OpType());
 
+  // When both inputs have the same shape and data type there is no broadcasting, so the op can run in whatever
+  // layout IN_A was produced in (e.g. the blocked output of a Conv) and IN_B is reordered to match it.
+  // This keeps the blocked layout flowing through residual Add/Mul instead of reordering to plain and back.
+  auto src_0_desc = sp.GetMemory(node.Input(IN_A)).get_desc();
+  auto src_1_desc = sp.GetMemory(node.Input(IN_B)).get_desc();
+  if (src_0_desc.dims() == src_1_desc.dims() && src_0_desc.data_type() == src_1_desc.data_type() &&
+      !sp.IsScalar(node.Input(IN_A)) && !sp.IsScalar(node.Input(IN_B))) {
+    auto binary_src0_mem = sp.GetMemoryAndReshape(node.Input(IN_A), src_0_desc, eng);
+    auto binary_src1_mem = sp.GetMemoryAndReshape(node.Input(IN_B), src_0_desc, eng);
+
+    auto dst_md = dnnl::memory::desc(src_0_desc.dims(), node.Output(OUT_Y).Type(), dnnl::memory::format_tag::any);
+    auto binary_d = dnnl::binary::desc(algo, src_0_desc, src_0_desc, dst_md);
+    auto binary_pd = dnnl::binary::primitive_desc(binary_d, eng);
+
+    auto binary_dst_mem = dnnl::memory(binary_pd.dst_desc(), eng);
+    sp.AddPrimitive(dnnl::binary(binary_pd), {{DNNL_ARG_SRC_0, binary_src0_mem},
+                                              {DNNL_ARG_SRC_1, binary_src1_mem},
+                                              {DNNL_ARG_DST, binary_dst_mem}});
+    sp.SetMemory(node.Output(OUT_Y), binary_dst_mem);
+    return;
+  }
+
   // GetMemory in OrtFormat. Broadcasting and mix format binary ops can result in computation failure
   auto binary_src0_mem = sp.GetMemoryInOrtFormat(node.Input(IN_A), eng);
   auto binary_src1_mem = sp.GetMemoryInOrtFormat(node.Input(IN_B), eng);
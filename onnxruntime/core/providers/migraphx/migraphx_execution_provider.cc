@@ -6,6 +6,7 @@
 #include "core/session/onnxruntime_cxx_api.h"
 #include "core/common/safeint.h"
 #include "core/common/logging/severity.h"
+#include "core/framework/murmurhash3.h"
 #include "migraphx_execution_provider.h"
 #include "migraphx_execution_provider_utils.h"
 #include "hip_allocator.h"
@@ -119,6 +120,17 @@ MIGraphXExecutionProvider::MIGraphXExecutionProvider(const MIGraphXExecutionProv
     dump_model_ops_ = (std::stoi(dump_model_ops_env) == 0 ? false : true);
   }
 
+  model_cache_path_ = onnxruntime::GetEnvironmentVar(migraphx_env_vars::kModelCachePath);
+  if (!model_cache_path_.empty()) {
+    hipDeviceProp_t device_prop;
+    HIP_CALL_THROW(hipGetDeviceProperties(&device_prop, device_id_));
+    program_cache_key_ = info.target_device + "_" + device_prop.gcnArchName;
+#if defined(MIGRAPHX_VERSION_MAJOR) && defined(MIGRAPHX_VERSION_MINOR) && defined(MIGRAPHX_VERSION_PATCH)
+    program_cache_key_ += "_" + std::to_string(MIGRAPHX_VERSION_MAJOR) + "." + std::to_string(MIGRAPHX_VERSION_MINOR) +
+                          "." + std::to_string(MIGRAPHX_VERSION_PATCH);
+#endif
+  }
+
   ROCBLAS_CALL_THROW(rocblas_create_handle(&external_rocblas_handle_));
   ROCBLAS_CALL_THROW(rocblas_set_stream(external_rocblas_handle_, stream_));
 
@@ -973,6 +985,53 @@ bool get_input_output_names(const GraphViewer& graph,
   return no_input_shape;
 }
 
+migraphx::program MIGraphXExecutionProvider::CompileProgram(const std::string& onnx_string,
+                                                            const migraphx::onnx_options& options,
+                                                            const std::string& input_shapes,
+                                                            bool fp16_enable) const {
+  std::string cache_file;
+  if (!model_cache_path_.empty()) {
+    const std::string key = program_cache_key_ + (fp16_enable ? "_fp16_" : "_") + input_shapes;
+    uint32_t hash[4] = {0, 0, 0, 0};
+    MurmurHash3::x86_128(onnx_string.data(), gsl::narrow_cast<int32_t>(onnx_string.size()), hash[0], &hash);
+    MurmurHash3::x86_128(key.data(), gsl::narrow_cast<int32_t>(key.size()), hash[0], &hash);
+    const uint64_t program_hash = hash[0] | (uint64_t(hash[1]) << 32);
+    cache_file = model_cache_path_ + "/migraphx_" + std::to_string(program_hash) + ".mxr";
+
+    std::ifstream cached_program(cache_file, std::ios::binary);
+    if (cached_program.good()) {
+      cached_program.close();
+      try {
+        auto prog = migraphx::load(cache_file.c_str());
+        LOGS_DEFAULT(VERBOSE) << "[MIGraphX EP] Loaded compiled program from " << cache_file;
+        return prog;
+      } catch (const std::exception& ex) {
+        // a stale or truncated cache file is compiled and written again
+        LOGS_DEFAULT(WARNING) << "[MIGraphX EP] Failed to load compiled program from " << cache_file << ": "
+                              << ex.what();
+      }
+    }
+  }
+
+  auto prog = migraphx::parse_onnx_buffer(onnx_string, options);
+  if (fp16_enable) {
+    migraphx::quantize_fp16(prog);
+  }
+  prog.compile(t_);
+
+  if (!cache_file.empty()) {
+    try {
+      migraphx::save(prog, cache_file.c_str());
+      LOGS_DEFAULT(VERBOSE) << "[MIGraphX EP] Saved compiled program to " << cache_file;
+    } catch (const std::exception& ex) {
+      // the cache only saves the compile time of the next session
+      LOGS_DEFAULT(WARNING) << "[MIGraphX EP] Failed to save compiled program to " << cache_file << ": "
+                            << ex.what();
+    }
+  }
+  return prog;
+}
+
 Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused_nodes,
                                           std::vector<NodeComputeInfo>& node_compute_funcs) {
   migraphx::onnx_options options;
@@ -1010,12 +1069,8 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>&
     migraphx::program prog;
 
     if (!no_input_shape) {
-      prog = migraphx::parse_onnx_buffer(onnx_string_buffer, options);
-      if (fp16_enable_) {
-        migraphx::quantize_fp16(prog);
-      }
-
-      prog.compile(t_);
+      // the input shapes are those of the serialized subgraph
+      prog = CompileProgram(onnx_string_buffer, options, "", fp16_enable_);
       auto prog_output_shapes = prog.get_output_shapes();
       for (std::size_t i = 0; i < output_names.size(); ++i) {
         auto out_len = prog_output_shapes[i].lengths();
@@ -1060,6 +1115,15 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>&
       // from input data
       bool input_shape_match = true;
       migraphx::program_parameter_shapes param_shapes;
+      // input shapes of the program, which are part of the key of the compiled program cache
+      std::string input_shapes;
+      auto add_input_shape = [&input_shapes](const std::string& name, const std::vector<std::size_t>& lens) {
+        input_shapes += name + ":";
+        for (auto len : lens) {
+          input_shapes += std::to_string(len) + ",";
+        }
+        input_shapes += ";";
+      };
       if (no_input_shape) {
         for (auto& it : map_input_name_index) {
           auto& name = it.first;
@@ -1069,6 +1133,7 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>&
           const auto tensor_shape = tensor_info.GetShape();
           std::vector<std::size_t> ort_lens(tensor_shape.begin(), tensor_shape.end());
           cmp_options.set_input_parameter_shape(name, ort_lens);
+          add_input_shape(name, ort_lens);
           input_shape_match = false;
         }
       } else {
@@ -1097,6 +1162,7 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>&
                 cmp_options.set_input_parameter_shape(name, ort_lens);
                 input_shape_match = false;
               }
+              add_input_shape(name, ort_lens);
             }
           }
         }
@@ -1105,12 +1171,7 @@ Status MIGraphXExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>&
       // input shapes are different, needs to re-parse onnx and
       // re-compile the program
       if (!input_shape_match) {
-        prog = migraphx::parse_onnx_buffer(onnx_string, cmp_options);
-        if (fp16_enable) {
-          migraphx::quantize_fp16(prog);
-        }
-
-        prog.compile(t);
+        prog = CompileProgram(onnx_string, cmp_options, input_shapes, fp16_enable);
         mgx_state->prog = prog;
         param_shapes = prog.get_parameter_shapes();
         no_input_shape = false;
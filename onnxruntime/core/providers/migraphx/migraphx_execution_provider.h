@@ -21,6 +21,9 @@ namespace onnxruntime {
 namespace migraphx_env_vars {
 static const std::string kFP16Enable = "ORT_MIGRAPHX_FP16_ENABLE";
 static const std::string dumpModelOps = "ORT_MIGRAPHX_DUMP_MODEL_OPS";
+// Directory of the compiled programs of the subgraphs, which are loaded instead of being compiled again.
+// Programs are not cached if it is not set.
+static const std::string kModelCachePath = "ORT_MIGRAPHX_MODEL_CACHE_PATH";
 };
 
 // Information to construct kernel function state.
@@ -67,12 +70,20 @@ class MIGraphXExecutionProvider : public IExecutionProvider {
   void RegisterAllocator(AllocatorManager& allocator_manager) override;
 
   std::unique_ptr<IndexedSubGraph> GetSubGraph(const std::vector<std::size_t>& graph_nodes_index, const GraphViewer& graph) const;
+
+  // Parses and compiles the program of a subgraph, or loads it from the model cache directory if it was compiled
+  // before with the same input shapes, fp16 setting, device architecture and MIGraphX version.
+  migraphx::program CompileProgram(const std::string& onnx_string, const migraphx::onnx_options& options,
+                                   const std::string& input_shapes, bool fp16_enable) const;
   void RegisterStreamHandlers(IStreamCommandHandleRegistry& stream_handle_registry) const override;
 
 private:
   bool fp16_enable_ = false;
   bool dump_model_ops_ = false;
   int device_id_;
+  std::string model_cache_path_;
+  // the target, the device architecture and the MIGraphX version, which the compiled programs depend on
+  std::string program_cache_key_;
   migraphx::target t_;
   OrtMutex mgx_mu_;
   hipStream_t stream_ = nullptr;
@@ -3,10 +3,14 @@
 
 #include "model_builder.h"
 
+#include <algorithm>
+#include <cstring>
+
 #include "core/common/logging/logging.h"
 #include "core/common/safeint.h"
 #include "core/common/status.h"
 #include "core/framework/execution_provider.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/graph/graph_viewer.h"
 #include "core/providers/common.h"
@@ -593,6 +597,15 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model) {
         "on create");
   }
 
+  // compilation caching and burst execution are only available on API 29+
+  if (!cache_dir_.empty() && GetNNAPIFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_3) {
+    uint8_t token[ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN];
+    GetCacheToken(token);
+    RETURN_STATUS_ON_ERROR_WITH_NOTE(
+        nnapi_->ANeuralNetworksCompilation_setCaching(nnapi_model_->compilation_, cache_dir_.c_str(), token),
+        "on setCaching");
+  }
+
   RETURN_STATUS_ON_ERROR_WITH_NOTE(
       nnapi_->ANeuralNetworksCompilation_setPreference(
           nnapi_model_->compilation_, static_cast<int32_t>(exe_pref_)),
@@ -602,10 +615,76 @@ Status ModelBuilder::Compile(std::unique_ptr<Model>& model) {
       nnapi_->ANeuralNetworksCompilation_finish(nnapi_model_->compilation_),
       "on compilation finish");
 
+  // A burst object keeps the driver resources alive between executions, which helps the repeated inference
+  // all the executions are serialized by the model mutex, so a single burst object is enough per model
+  if (GetNNAPIFeatureLevel() >= ANEURALNETWORKS_FEATURE_LEVEL_3) {
+    RETURN_STATUS_ON_ERROR_WITH_NOTE(
+        nnapi_->ANeuralNetworksBurst_create(nnapi_model_->compilation_, &nnapi_model_->burst_),
+        "on burst create");
+  }
+
   model.reset(nnapi_model_.release());
   return Status::OK();
 }
 
+void ModelBuilder::GetCacheToken(uint8_t* token) const {
+  uint32_t graph_hash[4] = {0, 0, 0, 0};
+  uint32_t initializer_hash[4] = {0, 0, 0, 0};
+  auto hash_str = [](const std::string& str, uint32_t (&hash)[4]) {
+    MurmurHash3::x86_128(str.data(), gsl::narrow_cast<int32_t>(str.size()), hash[0], &hash);
+  };
+
+  // the options used to build the NNAPI model change the compiled result
+  hash_str(std::to_string(use_nchw_) + std::to_string(use_fp16_) +
+               std::to_string(static_cast<int32_t>(exe_pref_)) +
+               std::to_string(static_cast<int32_t>(target_device_option_)),
+           graph_hash);
+
+  for (const auto node_idx : graph_viewer_.GetNodesInTopologicalOrder()) {
+    const auto* node = graph_viewer_.GetNode(node_idx);
+    hash_str(node->Domain() + ":" + node->OpType() + ":" + std::to_string(node->SinceVersion()), graph_hash);
+    for (const auto* def : node->InputDefs()) {
+      hash_str(def->Name(), graph_hash);
+    }
+    for (const auto* def : node->OutputDefs()) {
+      hash_str(def->Name(), graph_hash);
+    }
+
+    // NodeAttributes is unordered, sort by name to keep the token stable
+    std::vector<const ONNX_NAMESPACE::AttributeProto*> attrs;
+    attrs.reserve(node->GetAttributes().size());
+    for (const auto& entry : node->GetAttributes()) {
+      attrs.push_back(&entry.second);
+    }
+    std::sort(attrs.begin(), attrs.end(), [](const auto* a, const auto* b) { return a->name() < b->name(); });
+    for (const auto* attr : attrs) {
+      hash_str(attr->SerializeAsString(), graph_hash);
+    }
+  }
+
+  for (const auto* def : graph_viewer_.GetInputs()) {
+    hash_str(def->Name(), graph_hash);
+  }
+  for (const auto* def : graph_viewer_.GetOutputs()) {
+    hash_str(def->Name(), graph_hash);
+  }
+
+  const auto& initializers = graph_viewer_.GetAllInitializedTensors();
+  std::vector<std::string> initializer_names;
+  initializer_names.reserve(initializers.size());
+  for (const auto& entry : initializers) {
+    initializer_names.push_back(entry.first);
+  }
+  std::sort(initializer_names.begin(), initializer_names.end());
+  for (const auto& name : initializer_names) {
+    hash_str(initializers.at(name)->SerializeAsString(), initializer_hash);
+  }
+
+  static_assert(sizeof(graph_hash) + sizeof(initializer_hash) == ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN);
+  std::memcpy(token, graph_hash, sizeof(graph_hash));
+  std::memcpy(token + sizeof(graph_hash), initializer_hash, sizeof(initializer_hash));
+}
+
 int32_t ModelBuilder::FindActivation(const NodeUnit& node_unit) {
   const auto& output_def_size = node_unit.Outputs().size();
   if (output_def_size != 1) {
@@ -88,6 +88,10 @@ class ModelBuilder {
 
   void SetTargetDeviceOption(TargetDeviceOption option) { target_device_option_ = option; }
 
+  // Directory for the NNAPI compilation cache, caching is disabled if empty
+  // This is only available after Android API level 29, and will be ignored for Android API level 28-
+  void SetCacheDir(const std::string& cache_dir) { cache_dir_ = cache_dir; }
+
   // Set NNAPI execution preference
   // Default preference is PREFER_SUSTAINED_SPEED
   void ExecutePreference(
@@ -160,6 +164,8 @@ class ModelBuilder {
   std::vector<ANeuralNetworksDevice*> nnapi_target_devices_;
   std::string nnapi_target_devices_detail_;  // Debug info for target devices
 
+  std::string cache_dir_;
+
   // The number of nnapi operations in this model
   size_t num_nnapi_ops_ = 0;
   uint32_t next_index_ = 0;
@@ -169,6 +175,10 @@ class ModelBuilder {
 
   common::Status GetTargetDevices();
 
+  // Fill the ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN bytes token identifying this model in the compilation cache
+  // The token covers the nodes, the initializer values and the build options of the underlying graph_viewer
+  void GetCacheToken(uint8_t* token) const;
+
   // If a NNAPI operation will use initializers directly, we will add the initializers to the skip list
   void PreprocessInitializers();
   // Preprocess all the activation nodes (Relu/Relu1/Relu6) for easy query later
@@ -113,6 +113,8 @@ class Model {
 
   ANeuralNetworksModel* model_{nullptr};
   ANeuralNetworksCompilation* compilation_{nullptr};
+  // Reused by all the executions of this model, is null if burst execution is not available (API 28-)
+  ANeuralNetworksBurst* burst_{nullptr};
 
   size_t dynamic_output_buffer_size_{1024};
 
@@ -161,7 +163,8 @@ class Execution {
   };
 
  public:
-  explicit Execution(ANeuralNetworksExecution& execution /* , const Shaper& shaper */);
+  // burst is optional and not owned by this object, if provided the execution will be computed using it
+  Execution(ANeuralNetworksExecution& execution, ANeuralNetworksBurst* burst /* , const Shaper& shaper */);
   ~Execution();
   Execution(const Execution&) = delete;
   Execution& operator=(const Execution&) = delete;
@@ -185,6 +188,7 @@ class Execution {
 
   const NnApi* nnapi_{nullptr};
   ANeuralNetworksExecution* execution_;
+  ANeuralNetworksBurst* burst_{nullptr};
   /* Shaper shaper_; */
 };
 
@@ -47,10 +47,12 @@ std::unordered_set<std::string> GetPartitioningStopOps(const optional<std::strin
 }  // namespace
 
 NnapiExecutionProvider::NnapiExecutionProvider(uint32_t nnapi_flags,
-                                               const optional<std::string>& partitioning_stop_ops_list)
+                                               const optional<std::string>& partitioning_stop_ops_list,
+                                               const optional<std::string>& cache_dir)
     : IExecutionProvider{onnxruntime::kNnapiExecutionProvider, true},
       nnapi_flags_(nnapi_flags),
-      partitioning_stop_ops_(GetPartitioningStopOps(partitioning_stop_ops_list)) {
+      partitioning_stop_ops_(GetPartitioningStopOps(partitioning_stop_ops_list)),
+      cache_dir_(cache_dir.value_or("")) {
   AllocatorCreationInfo device_info(
       [](int) {
         return std::make_unique<CPUAllocator>(OrtMemoryInfo(NNAPI, OrtAllocatorType::OrtDeviceAllocator));
@@ -247,6 +249,7 @@ common::Status NnapiExecutionProvider::Compile(const std::vector<FusedNodeAndGra
     nnapi::ModelBuilder builder(graph_viewer);
     builder.SetUseNCHW(nnapi_flags_ & NNAPI_FLAG_USE_NCHW);
     builder.SetUseFp16(nnapi_flags_ & NNAPI_FLAG_USE_FP16);
+    builder.SetCacheDir(cache_dir_);
 
     bool cpu_disabled = nnapi_flags_ & NNAPI_FLAG_CPU_DISABLED;
     bool cpu_only = nnapi_flags_ & NNAPI_FLAG_CPU_ONLY;
@@ -15,7 +15,8 @@ class Model;
 class NnapiExecutionProvider : public IExecutionProvider {
  public:
   explicit NnapiExecutionProvider(uint32_t nnapi_flags,
-                                  const optional<std::string>& partitioning_stop_ops_list = {});
+                                  const optional<std::string>& partitioning_stop_ops_list = {},
+                                  const optional<std::string>& cache_dir = {});
 
   virtual ~NnapiExecutionProvider();
 
@@ -39,6 +40,9 @@ class NnapiExecutionProvider : public IExecutionProvider {
 
   const std::unordered_set<std::string> partitioning_stop_ops_;
 
+  // Directory for the NNAPI compilation cache, empty if caching is disabled
+  const std::string cache_dir_;
+
   std::unordered_map<std::string, std::unique_ptr<onnxruntime::nnapi::Model>> nnapi_models_;
 };
 }  // namespace onnxruntime
@@ -172,6 +172,15 @@ enum {
   ANEURALNETWORKS_PREFER_SUSTAINED_SPEED = 2,
 };
 
+/**
+ * The number of cache token bytes, see ANeuralNetworksCompilation_setCaching.
+ *
+ * Available since API level 29.
+ */
+enum {
+  ANEURALNETWORKS_BYTE_SIZE_OF_CACHE_TOKEN = 32,
+};
+
 /**
  * Result codes.
  */
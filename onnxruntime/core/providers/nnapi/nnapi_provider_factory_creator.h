@@ -12,6 +12,7 @@
 namespace onnxruntime {
 struct NnapiProviderFactoryCreator {
   static std::shared_ptr<IExecutionProviderFactory> Create(
-      uint32_t nnapi_flags, const std::optional<std::string>& partitioning_stop_ops_list);
+      uint32_t nnapi_flags, const std::optional<std::string>& partitioning_stop_ops_list,
+      const std::optional<std::string>& cache_dir = {});
 };
 }  // namespace onnxruntime
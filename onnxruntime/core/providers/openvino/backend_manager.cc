@@ -282,6 +282,9 @@ void BackendManager::Compute(OrtKernelContext* context) {
     std::vector<std::vector<int64_t>> tensor_shapes = GetInputTensorShapes(ctx);
     auto key = MakeMapKeyString(tensor_shapes, GetGlobalContext().device_type);
 
+    std::shared_ptr<IBackend> dynamic_backend;
+    {
+    std::lock_guard<std::mutex> lock(backend_map_mutex_);
     if (GetGlobalContext().device_type.find("MYRIAD") != std::string::npos) {
       for (size_t i = 0; i < subgraph_context_.input_indexes.size(); i++) {
         if (tensor_shapes[i].size() != 4)
@@ -289,7 +292,6 @@ void BackendManager::Compute(OrtKernelContext* context) {
       }
     }
 
-    std::shared_ptr<IBackend> dynamic_backend;
     auto search = backend_map_.find(key);
     if (search == backend_map_.end()) {
       LOGS_DEFAULT(INFO) << "[OpenVINO-EP] "
@@ -303,6 +305,7 @@ void BackendManager::Compute(OrtKernelContext* context) {
     } else {
       dynamic_backend = search->second;
     }
+    }
 
     dynamic_backend->Infer(context);
   } else {
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "ov_interface.h"
 #include "contexts.h"
 #include "ibackend.h"
@@ -35,6 +37,8 @@ class BackendManager {
   std::unique_ptr<ONNX_NAMESPACE::ModelProto> model_proto_;
   std::shared_ptr<IBackend> concrete_backend_;
   std::map<std::string, std::shared_ptr<IBackend>> backend_map_;
+  // Guards backend_map_ so that concurrent Compute calls don't create the same backend twice
+  std::mutex backend_map_mutex_;
   SubGraphContext subgraph_context_;
 };
 
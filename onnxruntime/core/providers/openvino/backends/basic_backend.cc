@@ -1,6 +1,9 @@
 // Copyright (C) 2019-2022 Intel Corporation
 // Licensed under the MIT License
 
+#include <algorithm>
+#include <cctype>
+#include <iomanip>
 #include <map>
 #include <string>
 #include <memory>
@@ -8,6 +11,7 @@
 #include <fstream>
 
 #include "core/providers/shared_library/provider_api.h"
+#include "core/framework/murmurhash3.h"
 #include "../backend_utils.h"
 #include <ngraph/pass/constant_folding.hpp>
 #include "basic_backend.h"
@@ -25,8 +29,6 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
     : global_context_(global_context), subgraph_context_(subgraph_context) {
   std::string& hw_target = (global_context_.device_id != "") ? global_context_.device_id : global_context_.device_type;
   bool vpu_status = false;
-  std::string model_blob_name;
-  std::string ov_compiled_blobs_dir = "";
 
   if (hw_target == "MYRIAD")
     vpu_status = true;
@@ -46,8 +48,25 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
   OVConfig config;
   PopulateConfigValue(config);
 
-  //Enable caching
-  EnableCaching();
+  // A blob exported by a previous session for the same model and device is imported instead of recompiling
+  std::string compiled_blob_path = GetCompiledBlobPath(model_proto, hw_target);
+  bool blob_imported = false;
+  if (!compiled_blob_path.empty() && std::ifstream(compiled_blob_path).good()) {
+    try {
+      exe_network_ = global_context_.ie_core.ImportModel(compiled_blob_path, hw_target,
+                                                         subgraph_context_.subgraph_name);
+      blob_imported = true;
+      LOGS_DEFAULT(INFO) << log_tag << "Imported the compiled blob " << compiled_blob_path;
+    } catch (const std::exception& e) {
+      LOGS_DEFAULT(WARNING) << log_tag << "Could not import the compiled blob " << compiled_blob_path
+                            << ", recompiling the model: " << e.what();
+    }
+  }
+
+  if (!blob_imported) {
+  //Enable caching when the device can't export the compiled blob itself
+  if (compiled_blob_path.empty())
+    EnableCaching();
 
   //Setting OpenCL queue throttling for GPU
   #if defined (OV_API_20)
@@ -73,11 +92,25 @@ BasicBackend::BasicBackend(const ONNX_NAMESPACE::ModelProto& model_proto,
     exe_network_ = global_context_.ie_core.LoadNetwork(ie_cnn_network_, hw_target, config, subgraph_context_.subgraph_name);
   #endif
   LOGS_DEFAULT(INFO) << log_tag << "Loaded model to the plugin";
+
+  if (!compiled_blob_path.empty()) {
+    try {
+      exe_network_.ExportModel(compiled_blob_path, subgraph_context_.subgraph_name);
+      LOGS_DEFAULT(INFO) << log_tag << "Exported the compiled blob to " << compiled_blob_path;
+    } catch (const std::exception& e) {
+      LOGS_DEFAULT(WARNING) << log_tag << "Could not export the compiled blob: " << e.what();
+    }
+  }
+  }
   }
 
-  //The infer_requests_ pool will be intialized with a default value of 8 infer_request's
-  //The nireq value can also be configured to any num_of_threads during runtime
+  //The infer_requests_ pool is sized to num_of_threads when it is configured. Otherwise it holds at least 8
+  //infer_request's, or more if the device reports a higher optimal number (e.g. throughput streams on a
+  //multi-socket CPU or several VPUs), so concurrent Run calls map onto parallel infer requests
   size_t nireq = global_context_.num_of_threads;
+  if (nireq == 0) {
+    nireq = std::max<size_t>(8, exe_network_.GetOptimalNumberOfInferRequests());
+  }
   LOGS_DEFAULT(INFO) << log_tag << "The value of nireq being used is: " << nireq;
 #ifndef NDEBUG
   if (openvino_ep::backend_utils::IsDebugEnabled()) {
@@ -97,40 +130,47 @@ bool BasicBackend::ValidateSubgraph(std::map<std::string, std::shared_ptr<ngraph
   return false;
 }
 
-void BasicBackend::PopulateCompiledDirectory(std::string hw_target, std::string& ov_compiled_blobs_dir,
-  std::string& model_blob_name, bool& vpu_status) {
-  std::ifstream blob_path;
-  if(hw_target == "MYRIAD" && global_context_.use_compiled_network == true) {
-    if(!openvino_ep::backend_utils::UseCompiledNetwork()) {
-      std::size_t model_index = global_context_.onnx_model_path_name.find_last_of("/\\");
-      std::string model_name= global_context_.onnx_model_path_name.substr(model_index+1);
-      std::size_t model_extension_index = model_name.find_last_of(".");
-      if(openvino_ep::BackendManager::GetGlobalContext().is_wholly_supported_graph) {
-          model_blob_name = global_context_.onnx_model_name + "_" + "op_v_" + std::to_string(global_context_.onnx_opset_version) + "_" + model_name.substr(0,model_extension_index) + "_" + hw_target + "_" + subgraph_context_.subgraph_name + "_ov_" + "fully" + ".blob";
-      }
-      else {
-          model_blob_name = global_context_.onnx_model_name + "_" + "op_v_" + std::to_string(global_context_.onnx_opset_version) + "_" + model_name.substr(0,model_extension_index) + "_" + hw_target + "_" + subgraph_context_.subgraph_name + "_ov_" + "partially" + ".blob";
-      }
-      if(global_context_.blob_dump_path == "" || global_context_.blob_dump_path == "\"" || global_context_.blob_dump_path.empty()) {
-        ov_compiled_blobs_dir = openvino_ep::backend_utils::GetCurrentWorkingDir() + "/ov_compiled_blobs/";
-      } else {
-        ov_compiled_blobs_dir = global_context_.blob_dump_path + "/ov_compiled_blobs";
-      }
-      if(openvino_ep::backend_utils::IsDirExists(ov_compiled_blobs_dir)) {
-        LOGS_DEFAULT(INFO) << log_tag << "'ov_compiled_blobs' directory already exists at the executable path";
-      }
-      else {
-        CreateDirectory(ov_compiled_blobs_dir);
-      }
-      blob_path.open(ov_compiled_blobs_dir + "/" + model_blob_name);
-      if (!blob_path.is_open()) {
-          LOGS_DEFAULT(INFO) << log_tag << "Device specific Compiled blob doesn't exist for this model";
-      } else {
-          LOGS_DEFAULT(INFO) << log_tag << "Device specific Compiled blob already exists for this model";
-          vpu_status = true;
-      }
+// Returns the path of the exported blob for this subgraph, keyed by a hash of the model and the device config, or
+// an empty string when compiled blobs can't be cached for this backend.
+std::string BasicBackend::GetCompiledBlobPath(const ONNX_NAMESPACE::ModelProto& model_proto,
+                                              const std::string& hw_target) {
+  if (global_context_.use_compiled_network == false)
+    return "";
+  #if defined(IO_BUFFER_ENABLED)
+  // Networks compiled on a remote context can't be re-imported without it
+  if (global_context_.context != nullptr)
+    return "";
+  #endif
+  if (!global_context_.ie_core.IsImportExportSupported(hw_target))
+    return "";
+
+  std::string ov_compiled_blobs_dir = global_context_.blob_dump_path.empty() ? "ov_compiled_blobs"
+                                                                             : global_context_.blob_dump_path;
+  if (!openvino_ep::backend_utils::IsDirExists(ov_compiled_blobs_dir)) {
+    try {
+      CreateDirectory(ov_compiled_blobs_dir);
+    } catch (const std::exception& e) {
+      LOGS_DEFAULT(WARNING) << log_tag << "Compiled blobs will not be cached: " << e.what();
+      return "";
     }
   }
+
+  std::string key = model_proto.SerializeAsString();
+  key += "|" + hw_target + "|" + global_context_.precision_str;
+  key += global_context_.enable_vpu_fast_compile ? "|fast_compile" : "";
+  key += subgraph_context_.set_vpu_config ? "|vpu_config" : "";
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(key.data(), static_cast<int>(key.size()), hash[0], &hash);
+
+  std::string device_name = hw_target;
+  std::replace_if(device_name.begin(), device_name.end(), [](unsigned char c) { return !std::isalnum(c); }, '_');
+  std::ostringstream blob_name;
+  blob_name << subgraph_context_.subgraph_name << "_" << device_name << "_" << std::hex << std::setfill('0');
+  for (auto h : hash) {
+    blob_name << std::setw(8) << h;
+  }
+  blob_name << ".blob";
+  return ov_compiled_blobs_dir + "/" + blob_name.str();
 }
 
 bool BasicBackend::ImportBlob(std::string hw_target, bool vpu_status) {
@@ -30,7 +30,7 @@ class BasicBackend : public IBackend {
 
  private:
   bool ImportBlob(std::string hw_target, bool vpu_status);
-  void PopulateCompiledDirectory(std::string, std::string&, std::string&, bool&);
+  std::string GetCompiledBlobPath(const ONNX_NAMESPACE::ModelProto& model_proto, const std::string& hw_target);
   bool ValidateSubgraph(std::map<std::string, std::shared_ptr<ngraph::Node>>& const_outputs_map);
   void PopulateConfigValue(OVConfig& config);
   void EnableCaching();
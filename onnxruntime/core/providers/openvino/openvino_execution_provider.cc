@@ -27,7 +27,8 @@ OpenVINOExecutionProvider::OpenVINOExecutionProvider(const OpenVINOExecutionProv
 
 
   if ((int)info.num_of_threads_ <= 0) {
-    openvino_ep::BackendManager::GetGlobalContext().num_of_threads = 8;
+    // The backends size their infer request pool from the compiled network
+    openvino_ep::BackendManager::GetGlobalContext().num_of_threads = 0;
   } else {
     openvino_ep::BackendManager::GetGlobalContext().num_of_threads = info.num_of_threads_;
   }
@@ -2,6 +2,7 @@
 // Licensed under the MIT License
 
 #include "ov_interface.h"
+#include <algorithm>
 #include <fstream>
 #define ORT_API_MANUAL_INIT
 #include "core/session/onnxruntime_cxx_api.h"
@@ -60,7 +61,7 @@ namespace onnxruntime {
     OVExeNetwork OVCore::ImportModel(const std::string& compiled_blob, std::string hw_target, std::string name) {
         try {
             #if defined (OV_API_20)
-            std::ifstream blob_stream_obj(compiled_blob); 
+            std::ifstream blob_stream_obj(compiled_blob, std::ios::in | std::ios::binary);
             auto obj = oe.import_model(blob_stream_obj, hw_target, {});
             return OVExeNetwork(obj);
             #else
@@ -82,6 +83,21 @@ namespace onnxruntime {
         #endif
     }
 
+    bool OVCore::IsImportExportSupported(const std::string& hw_target) {
+        try {
+            #if defined(OV_API_20)
+            auto capabilities = oe.get_property(hw_target, ov::device::capabilities);
+            return std::find(capabilities.begin(), capabilities.end(),
+                             ov::device::capability::EXPORT_IMPORT) != capabilities.end();
+            #else
+            return oe.GetMetric(hw_target, METRIC_KEY(IMPORT_EXPORT_SUPPORT)).as<bool>();
+            #endif
+        } catch (...) {
+            // Composite devices (HETERO, MULTI, ...) don't always report the capability.
+            return false;
+        }
+    }
+
     #ifdef IO_BUFFER_ENABLED
     OVExeNetwork OVCore::LoadNetwork(std::shared_ptr<OVNetwork>& model, OVRemoteContextPtr context, std::string& name) {
         try {
@@ -128,6 +144,33 @@ namespace onnxruntime {
         }
     }
    
+    void OVExeNetwork::ExportModel(const std::string& compiled_blob, std::string name) {
+        try {
+            #if defined (OV_API_20)
+            std::ofstream blob_stream_obj(compiled_blob, std::ios::out | std::ios::binary);
+            obj.export_model(blob_stream_obj);
+            #else
+            obj.Export(compiled_blob);
+            #endif
+        } catch (const Exception& e) {
+            ORT_THROW(log_tag + " Exception while Exporting Network for graph: " + name + ": " + e.what());
+        } catch (...) {
+            ORT_THROW(log_tag + " Exception while Exporting Network for graph: " + name);
+        }
+    }
+
+    size_t OVExeNetwork::GetOptimalNumberOfInferRequests() {
+        try {
+            #if defined (OV_API_20)
+            return obj.get_property(ov::optimal_number_of_infer_requests);
+            #else
+            return obj.GetMetric(METRIC_KEY(OPTIMAL_NUMBER_OF_INFER_REQUESTS)).as<unsigned int>();
+            #endif
+        } catch (...) {
+            return 0;
+        }
+    }
+
     OVTensorPtr OVInferRequest::GetTensor(const std::string& input_name) {
         try {
           #if defined (OV_API_20)
@@ -65,6 +65,7 @@ class OVExeNetwork;
         OVExeNetwork LoadNetwork(std::shared_ptr<OVNetwork>& ie_cnn_network, std::string& hw_target, OVConfig config, std::string name);
         OVExeNetwork ImportModel(const std::string& compiled_blob, std::string hw_target, std::string name);
         void SetCache(std::string cache_dir_path);
+        bool IsImportExportSupported(const std::string& hw_target);
         #ifdef IO_BUFFER_ENABLED
         OVExeNetwork LoadNetwork(std::shared_ptr<OVNetwork>& model, OVRemoteContextPtr context, std::string& name);
         #endif
@@ -97,6 +98,8 @@ class OVExeNetwork;
         InferenceEngine::ExecutableNetwork& Get() { return obj ; }
     #endif
         OVInferRequest CreateInferRequest();
+        void ExportModel(const std::string& compiled_blob, std::string name);
+        size_t GetOptimalNumberOfInferRequests();
     };
 
     class OVInferRequest {
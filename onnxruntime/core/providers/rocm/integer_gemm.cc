@@ -64,5 +64,24 @@ Status GemmInt8(int m, int n, int k,
       0, 0));
   return Status::OK();
 }
+
+// the integer kernels shared with CUDA only use the cuBLASLt IMMA kernels when this returns true
+bool CanUseGemmInt8Lt(const hipDeviceProp_t& /*prop*/, int /*n*/, int /*k*/) {
+  return false;
+}
+
+Status GemmInt8Lt(int /*m*/, int /*n*/, int /*k*/,
+                  int32_t /*alpha*/, int32_t /*beta*/,
+                  const int8_t* /*a*/, const int8_t* /*b_transposed*/, int32_t* /*c*/,
+                  const RocmKernel* /*rocm_kernel*/, onnxruntime::Stream* /*ort_stream*/) {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "GemmInt8Lt is not supported on ROCm");
+}
+
+Status GemmInt8LtQuantized(int /*m*/, int /*n*/, int /*k*/,
+                           float /*scale*/, const float* /*bias*/,
+                           const int8_t* /*a*/, const int8_t* /*b_transposed*/, int8_t* /*c*/,
+                           const RocmKernel* /*rocm_kernel*/, onnxruntime::Stream* /*ort_stream*/) {
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "GemmInt8LtQuantized is not supported on ROCm");
+}
 }  // namespace rocm
 }  // namespace onnxruntime
@@ -44,7 +44,8 @@ Status Transpose(const gsl::span<const size_t>& permutation, const Tensor& input
 template <typename T>
 Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
               size_t left_stride, size_t right_stride, size_t output_stride,
-              size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* /*tp*/,
+              size_t num_batches, size_t M, size_t K, size_t N, bool trans_left, bool trans_right,
+              concurrency::ThreadPool* /*tp*/,
               void* einsum_rocm_assets) {
   typedef typename rocm::ToHipType<T>::MappedType HipT;
 
@@ -52,17 +53,17 @@ Status MatMul(const T* input_1_data, const T* input_2_data, T* output_data,
   HipT zero = rocm::ToHipType<T>::FromFloat(0.0f);
 
   ROCBLAS_RETURN_IF_ERROR(rocblasGemmStridedBatchedHelper(static_cast<EinsumRocmAssets*>(einsum_rocm_assets)->rocblas_handle_,
-                                                        rocblas_operation_none,
-                                                        rocblas_operation_none,
+                                                        trans_right ? rocblas_operation_transpose : rocblas_operation_none,
+                                                        trans_left ? rocblas_operation_transpose : rocblas_operation_none,
                                                         static_cast<int>(N),
                                                         static_cast<int>(M),
                                                         static_cast<int>(K),
                                                         &one,
                                                         reinterpret_cast<const HipT*>(input_2_data),
-                                                        static_cast<int>(N),
+                                                        static_cast<int>(trans_right ? K : N),
                                                         static_cast<int>(right_stride),
                                                         reinterpret_cast<const HipT*>(input_1_data),
-                                                        static_cast<int>(K),
+                                                        static_cast<int>(trans_left ? M : K),
                                                         static_cast<int>(left_stride),
                                                         &zero,
                                                         reinterpret_cast<HipT*>(output_data),
@@ -149,7 +150,8 @@ std::unique_ptr<Tensor> Diagonal(const Tensor& input, int64_t dim_1, int64_t dim
 template Status DeviceHelpers::RocmDeviceHelpers::MatMul<float>(
     const float* input_1_data, const float* input_2_data, float* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_left, bool trans_right,
+    concurrency::ThreadPool* tp,
     void* einsum_rocm_assets);
 
 template std::unique_ptr<Tensor> DeviceHelpers::RocmDeviceHelpers::ReduceSum<float>(
@@ -162,7 +164,8 @@ template std::unique_ptr<Tensor> DeviceHelpers::RocmDeviceHelpers::ReduceSum<flo
 template Status DeviceHelpers::RocmDeviceHelpers::MatMul<MLFloat16>(
     const MLFloat16* input_1_data, const MLFloat16* input_2_data, MLFloat16* output_data,
     size_t left_stride, size_t right_stride, size_t output_stride,
-    size_t num_batches, size_t M, size_t K, size_t N, concurrency::ThreadPool* tp,
+    size_t num_batches, size_t M, size_t K, size_t N, bool trans_left, bool trans_right,
+    concurrency::ThreadPool* tp,
     void* einsum_rocm_assets);
 
 template std::unique_ptr<Tensor> DeviceHelpers::RocmDeviceHelpers::ReduceSum<MLFloat16>(
@@ -2,6 +2,9 @@
 // Licensed under the MIT License.
 
 #include "miopen_common.h"
+
+#include <algorithm>
+
 #include "core/common/gsl.h"
 #include "core/providers/cpu/tensor/utils.h"
 #include "core/providers/rocm/shared_inc/rocm_call.h"
@@ -26,7 +29,7 @@ Status MiopenTensor::CreateTensorIfNeeded() {
   return Status::OK();
 }
 
-Status MiopenTensor::Set(gsl::span<const int64_t> input_dims, miopenDataType_t dataType) {
+Status MiopenTensor::Set(gsl::span<const int64_t> input_dims, miopenDataType_t dataType, bool is_nhwc) {
   ORT_RETURN_IF_ERROR(CreateTensorIfNeeded());
 
   int rank = gsl::narrow_cast<int>(input_dims.size());
@@ -37,6 +40,17 @@ Status MiopenTensor::Set(gsl::span<const int64_t> input_dims, miopenDataType_t d
     dims[i] = gsl::narrow_cast<int>(input_dims[i]);
     strides[i] = gsl::narrow_cast<int>(pitches[i]);
   }
+  if (is_nhwc && rank > 2) {
+    // the channels are innermost, followed by the spatial dims and then the batch
+    int64_t stride = 1;
+    strides[1] = gsl::narrow_cast<int>(stride);
+    stride *= input_dims[1];
+    for (int i = rank - 1; i >= 2; i--) {
+      strides[i] = gsl::narrow_cast<int>(stride);
+      stride *= input_dims[i];
+    }
+    strides[0] = gsl::narrow_cast<int>(stride);
+  }
   MIOPEN_RETURN_IF_ERROR(miopenSetTensorDescriptor(tensor_, dataType, static_cast<int>(rank), dims.data(), strides.data()));
   return Status::OK();
 }
@@ -47,6 +61,22 @@ Status MiopenTensor::Set(const MiopenTensor& x_desc, miopenBatchNormMode_t mode)
   return Status::OK();
 }
 
+TensorShapeVector ChannelsLastToFirstDims(gsl::span<const int64_t> dims) {
+  TensorShapeVector result(dims.begin(), dims.end());
+  if (dims.size() > 2) {
+    std::rotate(result.begin() + 1, result.end() - 1, result.end());
+  }
+  return result;
+}
+
+TensorShapeVector ChannelsFirstToLastDims(gsl::span<const int64_t> dims) {
+  TensorShapeVector result(dims.begin(), dims.end());
+  if (dims.size() > 2) {
+    std::rotate(result.begin() + 1, result.begin() + 2, result.end());
+  }
+  return result;
+}
+
 MiopenTensorDescriptor::MiopenTensorDescriptor() : desc_(nullptr) {
   miopenCreateTensorDescriptor(&desc_);
 }
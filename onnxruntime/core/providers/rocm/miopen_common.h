@@ -24,7 +24,8 @@ class MiopenTensor final {
   ~MiopenTensor();
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(MiopenTensor);
 
-  Status Set(gsl::span<const int64_t> input_dims, miopenDataType_t dataType);
+  // input_dims are in the NCHW order, if is_nhwc is true the data of the tensor is in the channels last layout.
+  Status Set(gsl::span<const int64_t> input_dims, miopenDataType_t dataType, bool is_nhwc = false);
   Status Set(const MiopenTensor& x_desc, miopenBatchNormMode_t mode);
 
   operator miopenTensorDescriptor_t() const { return tensor_; }
@@ -52,6 +53,10 @@ class MiopenTensorDescriptor final {
   miopenTensorDescriptor_t desc_;
 };
 
+// Converts the dims of a channels last tensor, e.g. NHWC, to the channels first order, e.g. NCHW, and back.
+TensorShapeVector ChannelsLastToFirstDims(gsl::span<const int64_t> dims);
+TensorShapeVector ChannelsFirstToLastDims(gsl::span<const int64_t> dims);
+
 template <typename ElemType>
 struct Consts {
   static const constexpr ElemType Zero{0};
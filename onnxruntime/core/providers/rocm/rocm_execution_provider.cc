@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <fstream>
+
 #include "core/providers/shared_library/provider_api.h"
 #include "core/platform/env_var_utils.h"
 #include "core/providers/rocm/rocm_execution_provider.h"
@@ -136,6 +138,8 @@ ROCMExecutionProvider::PerThreadContext::PerThreadContext(OrtDevice::DeviceId de
 
   MIOPEN_CALL_THROW(miopenCreate(&miopen_handle_));
   MIOPEN_CALL_THROW(miopenSetStream(miopen_handle_, stream));
+
+  hip_graph_.SetStream(stream);
 }
 
 ROCMExecutionProvider::PerThreadContext::~PerThreadContext() {
@@ -155,6 +159,56 @@ ROCMExecutionProvider::PerThreadContext::~PerThreadContext() {
   }
 }
 
+void ROCMExecutionProvider::PerThreadContext::SetMaxGraphs(size_t max_graphs) {
+  hip_graph_.SetMaxGraphs(max_graphs);
+}
+
+void ROCMExecutionProvider::PerThreadContext::SetGraphCaptureKey(const HipGraphKey_t& graph_key) {
+  graph_capture_key_ = graph_key;
+}
+
+bool ROCMExecutionProvider::PerThreadContext::IsGraphCaptureAllowed() const {
+  if (graph_capture_key_.empty()) {
+    return false;
+  }
+  auto it = regular_run_counts_before_graph_capture_.find(graph_capture_key_);
+  return it != regular_run_counts_before_graph_capture_.end() &&
+         it->second >= min_num_runs_before_hip_graph_capture_;
+}
+
+void ROCMExecutionProvider::PerThreadContext::CaptureBegin() {
+  hip_graph_.CaptureBegin(graph_capture_key_);
+}
+
+void ROCMExecutionProvider::PerThreadContext::CaptureEnd() {
+  hip_graph_.CaptureEnd();
+  // The warm-up runs are only counted until the graph is captured
+  regular_run_counts_before_graph_capture_.erase(graph_capture_key_);
+}
+
+bool ROCMExecutionProvider::PerThreadContext::IsGraphCaptured(const HipGraphKey_t& graph_key) const {
+  return hip_graph_.IsCaptured(graph_key);
+}
+
+bool ROCMExecutionProvider::PerThreadContext::IsGraphCaptured() const {
+  return !graph_capture_key_.empty() && IsGraphCaptured(graph_capture_key_);
+}
+
+Status ROCMExecutionProvider::PerThreadContext::ReplayGraph(const HipGraphKey_t& graph_key) {
+  ORT_ENFORCE(IsGraphCaptured(graph_key));
+  return hip_graph_.Replay(graph_key);
+}
+
+Status ROCMExecutionProvider::PerThreadContext::ReplayGraph() {
+  return ReplayGraph(graph_capture_key_);
+}
+
+void ROCMExecutionProvider::PerThreadContext::IncrementRegularRunCountBeforeGraphCapture() {
+  if (!graph_capture_key_.empty()) {
+    ++regular_run_counts_before_graph_capture_[graph_capture_key_];
+  }
+}
+
 void OverrideTunableOpInfoByEnv(ROCMExecutionProviderInfo& info) {
   auto env_tunable_op_enabled = onnxruntime::ParseTestOnlyEnvironmentVariable<bool>(
       "ORT_ROCM_TUNABLE_OP_ENABLED", {"0", "1"}, "Use provider_options \"tunable_op_enabled\" instead.");
@@ -184,6 +238,11 @@ ROCMExecutionProvider::ROCMExecutionProvider(const ROCMExecutionProviderInfo& in
     if (info.external_allocator_info.UseExternalAllocator()) {
       use_ep_level_unified_stream_ = true;
       stream_ = nullptr;
+    } else if (info.enable_hip_graph) {
+      // current hip graph implementation only works with single stream
+      // use EP level unified stream for all the reqeust
+      HIP_CALL_THROW(hipStreamCreateWithFlags(&stream_, hipStreamNonBlocking));
+      use_ep_level_unified_stream_ = true;
     } else {
       stream_ = nullptr;
     }
@@ -194,9 +253,12 @@ ROCMExecutionProvider::ROCMExecutionProvider(const ROCMExecutionProviderInfo& in
   HIP_CALL_THROW(hipMemGetInfo(&free, &total));
 
   OverrideTunableOpInfoByEnv(info_);
+  LoadTuningResults();
 }
 
 ROCMExecutionProvider::~ROCMExecutionProvider() {
+  SaveTuningResults();
+
   // clean up thread local context caches
   {
     std::lock_guard<OrtMutex> lock(context_state_.mutex);
@@ -226,6 +288,52 @@ bool ROCMExecutionProvider::IsTunableOpEnabled() const {
   return info_.tunable_op.enabled;
 }
 
+tunable::TuningResults* ROCMExecutionProvider::GetTuningResults() const {
+  return info_.tunable_op.enabled || tuning_results_loaded_ ? &tuning_results_ : nullptr;
+}
+
+tunable::TuningResults::Validators ROCMExecutionProvider::GetTuningResultsValidators() const {
+  int runtime_version = 0;
+  HIP_CALL_THROW(hipRuntimeGetVersion(&runtime_version));
+  return {
+#ifdef ORT_VERSION
+      {"ORT_VERSION", ORT_VERSION},
+#endif
+      {"DEVICE", device_prop_.name},
+      {"GCN_ARCH", device_prop_.gcnArchName},
+      {"HIP_RUNTIME_VERSION", std::to_string(runtime_version)},
+  };
+}
+
+void ROCMExecutionProvider::LoadTuningResults() {
+  const auto& path = info_.tunable_op.tuning_results_file;
+  if (path.empty() || !std::ifstream(path).good()) {
+    return;
+  }
+
+  auto status = tuning_results_.Load(path, GetTuningResultsValidators());
+  if (status.IsOK()) {
+    LOGS_DEFAULT(INFO) << "Loaded TunableOp tuning results from " << path;
+    tuning_results_loaded_ = true;
+  } else {
+    LOGS_DEFAULT(WARNING) << "Ignoring TunableOp tuning results: " << status.ErrorMessage();
+  }
+}
+
+void ROCMExecutionProvider::SaveTuningResults() {
+  const auto& path = info_.tunable_op.tuning_results_file;
+  if (path.empty() || !tuning_results_.IsModified()) {
+    return;
+  }
+
+  auto status = tuning_results_.Save(path, GetTuningResultsValidators());
+  if (status.IsOK()) {
+    LOGS_DEFAULT(INFO) << "Saved TunableOp tuning results to " << path;
+  } else {
+    LOGS_DEFAULT(WARNING) << "Failed to save TunableOp tuning results: " << status.ErrorMessage();
+  }
+}
+
 std::unique_ptr<profiling::EpProfiler> ROCMExecutionProvider::GetProfiler() {
   return std::make_unique<profiling::RocmProfiler>();
 }
@@ -250,6 +358,7 @@ ROCMExecutionProvider::PerThreadContext& ROCMExecutionProvider::GetPerThreadCont
     if (context_state_.retired_context_pool.empty()) {
       context = std::make_shared<PerThreadContext>(info_.device_id, stream_, info_.gpu_mem_limit,
                                                    info_.arena_extend_strategy, info_.external_allocator_info, info_.default_memory_arena_cfg);
+      context->SetMaxGraphs(static_cast<size_t>(info_.max_hip_graphs));
     } else {
       context = context_state_.retired_context_pool.back();
       context_state_.retired_context_pool.pop_back();
@@ -304,25 +413,62 @@ Status ROCMExecutionProvider::Sync() const {
 Status ROCMExecutionProvider::OnRunStart() {
   // always set ROCM device when session::Run() in case it runs in a worker thread
   HIP_RETURN_IF_ERROR(hipSetDevice(GetDeviceId()));
+  if (IsGraphCaptureEnabled() && GetPerThreadContext().IsGraphCaptureAllowed() && !GetPerThreadContext().IsGraphCaptured()) {
+    LOGS_DEFAULT(INFO) << "Capturing the hip graph for this model";
+    GetPerThreadContext().CaptureBegin();
+  }
   return Status::OK();
 }
 
 Status ROCMExecutionProvider::OnRunEnd(bool sync_stream) {
+  if (IsGraphCaptureEnabled() && !GetPerThreadContext().IsGraphCaptured()) {
+    if (GetPerThreadContext().IsGraphCaptureAllowed()) {
+      GetPerThreadContext().CaptureEnd();
+      // HIP work issued to a capturing stream doesn't actually run on the GPU,
+      // so run the captured graph here to actually execute the work.
+      ORT_RETURN_IF_ERROR(GetPerThreadContext().ReplayGraph());
+    } else {
+      GetPerThreadContext().IncrementRegularRunCountBeforeGraphCapture();
+    }
+  }
+
   if (sync_stream) {
     HIP_RETURN_IF_ERROR(hipStreamSynchronize(stream_));
   }
 
-  // In extreme cases (e.g., 1-op graph and that op fallbacks to CPU),
-  // PerThreadContext won't be created and there is nothing to
-  // release. This didn't happen before because we always call
-  // GetPerThreadContext in OnRunStart.
-  if (PerThreadContextCache()->find(this) != PerThreadContextCache()->end()) {
+  // The reason of !IsGraphCaptureEnabled():
+  //  If hip graph is enabled, the per thread context will not be released
+  //  because the per thread hip graph needs to be maintained and replayed for
+  //  the next run.
+  // The reason of PerThreadContextCache()->find(this) != PerThreadContextCache()->end():
+  //  In extreme cases (e.g., 1-op graph and that op fallbacks to CPU),
+  //  PerThreadContext won't be created and there is nothing to
+  //  release. This didn't happen before because we always call
+  //  GetPerThreadContext in OnRunStart.
+  if (!IsGraphCaptureEnabled() &&
+      PerThreadContextCache()->find(this) != PerThreadContextCache()->end()) {
     ReleasePerThreadContext();
   }
 
   return Status::OK();
 }
 
+bool ROCMExecutionProvider::IsGraphCaptureEnabled() const {
+  return info_.enable_hip_graph;
+}
+
+bool ROCMExecutionProvider::IsGraphCaptured(const std::string& graph_key) const {
+  return GetPerThreadContext().IsGraphCaptured(graph_key);
+}
+
+Status ROCMExecutionProvider::ReplayGraph(const std::string& graph_key) {
+  return GetPerThreadContext().ReplayGraph(graph_key);
+}
+
+void ROCMExecutionProvider::SetGraphCaptureKey(const std::string& graph_key) {
+  GetPerThreadContext().SetGraphCaptureKey(graph_key);
+}
+
 namespace rocm {
 // opset 1 to 9
 class ONNX_OPERATOR_KERNEL_CLASS_NAME(kRocmExecutionProvider, kOnnxDomain, 1, MemcpyFromHost);
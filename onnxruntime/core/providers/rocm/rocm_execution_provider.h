@@ -9,8 +9,10 @@
 #include "core/framework/allocatormgr.h"
 #include "core/framework/arena_extend_strategy.h"
 #include "core/framework/execution_provider.h"
+#include "core/framework/tunable.h"
 #include "core/platform/ort_mutex.h"
 #include "core/providers/rocm/rocm_execution_provider_info.h"
+#include "core/providers/rocm/rocm_graph.h"
 #include "core/providers/rocm/rocm_pch.h"
 #include "core/providers/rocm/shared_inc/rocm_utils.h"
 #include "core/providers/rocm/shared_inc/rocm_call.h"
@@ -102,15 +104,28 @@ class ROCMExecutionProvider : public IExecutionProvider {
   void EnableTunableOp();
   void DisableTunableOp();
   bool IsTunableOpEnabled() const;
+  // The results shared by the TunableOps of the provider, nullptr if TunableOp is disabled and no results were loaded.
+  tunable::TuningResults* GetTuningResults() const;
 
   std::unique_ptr<profiling::EpProfiler> GetProfiler() override;
 
+  bool IsGraphCaptureEnabled() const override;
+  bool IsGraphCaptured(const std::string& graph_key) const override;
+  Status ReplayGraph(const std::string& graph_key) override;
+  void SetGraphCaptureKey(const std::string& graph_key) override;
   void RegisterStreamHandlers(IStreamCommandHandleRegistry& stream_handle_registry) const override;
 
  private:
+  tunable::TuningResults::Validators GetTuningResultsValidators() const;
+  void LoadTuningResults();
+  void SaveTuningResults();
+
   ROCMExecutionProviderInfo info_;
   hipDeviceProp_t device_prop_;
+  mutable tunable::TuningResults tuning_results_;
+  bool tuning_results_loaded_ = false;
   bool external_stream_ = false;
+  // only used when set user external stream or hip graph
   hipStream_t stream_ = nullptr;
 
   bool use_ep_level_unified_stream_ = false;
@@ -151,6 +166,17 @@ class ROCMExecutionProvider : public IExecutionProvider {
       }
     }
 
+    void SetMaxGraphs(size_t max_graphs);
+    void SetGraphCaptureKey(const HipGraphKey_t& graph_key);
+    bool IsGraphCaptureAllowed() const;
+    void CaptureBegin();
+    void CaptureEnd();
+    bool IsGraphCaptured(const HipGraphKey_t& graph_key) const;
+    bool IsGraphCaptured() const;
+    Status ReplayGraph(const HipGraphKey_t& graph_key);
+    Status ReplayGraph();
+    void IncrementRegularRunCountBeforeGraphCapture();
+
    private:
     rocblas_handle rocblas_handle_ = nullptr;
     miopenHandle_t miopen_handle_ = nullptr;
@@ -158,6 +184,14 @@ class ROCMExecutionProvider : public IExecutionProvider {
     std::unique_ptr<rocm::IConstantBuffer<float>> constant_ones_float_;
     std::unique_ptr<rocm::IConstantBuffer<double>> constant_ones_double_;
     std::unique_ptr<rocm::IConstantBuffer<half>> constant_ones_half_;
+
+    // The graphs are captured with the rocBLAS and MIOpen handles of this thread, so hip_graph_
+    // is put under PerThreadContext.
+    ROCMGraph hip_graph_;
+    // Graph captured by the current run, empty if the run does not capture a graph.
+    HipGraphKey_t graph_capture_key_;
+    std::unordered_map<HipGraphKey_t, int> regular_run_counts_before_graph_capture_;
+    const int min_num_runs_before_hip_graph_capture_ = 1;  // required min regular runs before graph capture for the necessary memory allocations.
   };
 
   using PerThreadContextMap = std::unordered_map<const ROCMExecutionProvider*, std::weak_ptr<PerThreadContext>>;
@@ -5,6 +5,7 @@
 
 #include <functional>
 #include <limits>
+#include <string>
 
 #include "core/common/hash_combine.h"
 #include "core/framework/arena_extend_strategy.h"
@@ -39,6 +40,9 @@ struct ROCMExecutionProviderExternalAllocatorInfo {
 namespace rocm {
 struct TunableOpInfo {
   bool enabled{false};
+  // If set, the tuning results are loaded from the file when the provider is created, and the results of the
+  // tuning are saved to it when the provider is destroyed.
+  std::string tuning_results_file{};
 };
 }  // namespace rocm
 
@@ -58,6 +62,11 @@ struct ROCMExecutionProviderInfo {
   ROCMExecutionProviderExternalAllocatorInfo external_allocator_info{};
   bool miopen_conv_use_max_workspace{false};
 
+  bool enable_hip_graph{false};
+
+  // Maximum number of HIP graphs kept per thread, the least recently used graph is destroyed beyond it.
+  int max_hip_graphs{8};
+
   rocm::TunableOpInfo tunable_op{};
 
   static ROCMExecutionProviderInfo FromProviderOptions(const ProviderOptions& options);
@@ -70,6 +79,7 @@ struct std::hash<::onnxruntime::rocm::TunableOpInfo> {
   size_t operator()(const ::onnxruntime::rocm::TunableOpInfo& info) const {
     size_t seed_and_value{0xbc9f1d34};
     onnxruntime::HashCombine(info.enabled, seed_and_value);
+    onnxruntime::HashCombine(info.tuning_results_file, seed_and_value);
     return seed_and_value;
   }
 };
@@ -0,0 +1,93 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/rocm/rocm_graph.h"
+
+#include "core/providers/rocm/rocm_common.h"
+
+namespace onnxruntime {
+
+ROCMGraph::ROCMGraph(hipStream_t stream) : stream_(stream) {
+}
+
+void ROCMGraph::SetStream(hipStream_t stream) {
+  stream_ = stream;
+}
+
+void ROCMGraph::SetMaxGraphs(size_t max_graphs) {
+  ORT_ENFORCE(max_graphs > 0, "At least one HIP graph must be kept.");
+  max_graphs_ = max_graphs;
+}
+
+void ROCMGraph::CaptureBegin(const HipGraphKey_t& key) {
+  ORT_ENFORCE(!IsCaptured(key),
+              "This hip graph has already captured a graph for this key. "
+              "Replay it instead of capturing a new graph.");
+  ORT_ENFORCE(!is_capturing_, "A hip graph is already being captured.");
+
+  HIP_CALL_THROW(hipStreamSynchronize(stream_));
+  // The runs that capture and replay the graphs on this stream are serialized by the session. The thread local
+  // mode keeps the capture from failing on unrelated HIP calls of other threads, e.g. of other sessions.
+  HIP_CALL_THROW(hipStreamBeginCapture(stream_, hipStreamCaptureModeThreadLocal));
+  capture_key_ = key;
+  is_capturing_ = true;
+}
+
+void ROCMGraph::CaptureEnd() {
+  ORT_ENFORCE(is_capturing_, "ROCMGraph::CaptureEnd: no graph is being captured");
+  is_capturing_ = false;
+
+  hipGraph_t graph = nullptr;
+  HIP_CALL_THROW(hipStreamEndCapture(stream_, &graph));
+  if (graph == nullptr) {
+    ORT_THROW("ROCMGraph::CaptureEnd: graph is NULL");
+  }
+
+  hipGraphExec_t graph_exec = nullptr;
+  const auto instantiate_result = hipGraphInstantiate(&graph_exec, graph, nullptr, nullptr, 0);
+  HIP_CALL_THROW(hipGraphDestroy(graph));
+  HIP_CALL_THROW(instantiate_result);
+
+  // Make room for the new graph by destroying the least recently used ones
+  while (graph_execs_.size() >= max_graphs_) {
+    HIP_CALL_THROW(hipGraphExecDestroy(graph_execs_.back().second));
+    graph_exec_lookup_.erase(graph_execs_.back().first);
+    graph_execs_.pop_back();
+  }
+
+  graph_execs_.emplace_front(capture_key_, graph_exec);
+  graph_exec_lookup_[capture_key_] = graph_execs_.begin();
+}
+
+bool ROCMGraph::IsCaptured(const HipGraphKey_t& key) const {
+  return graph_exec_lookup_.find(key) != graph_exec_lookup_.end();
+}
+
+Status ROCMGraph::Replay(const HipGraphKey_t& key) {
+  // Although this function is not thread safe, the lock is not needed here because
+  // the session serializes the runs that capture and replay graphs
+  auto it = graph_exec_lookup_.find(key);
+  ORT_RETURN_IF(it == graph_exec_lookup_.end(), "No HIP graph has been captured for key ", key);
+
+  // Keep the most recently used graph at the front
+  graph_execs_.splice(graph_execs_.begin(), graph_execs_, it->second);
+
+  LOGS_DEFAULT(INFO) << "Replaying HIP graph " << key << " on stream " << stream_;
+  HIP_RETURN_IF_ERROR(hipGraphLaunch(it->second->second, stream_));
+  HIP_RETURN_IF_ERROR(hipStreamSynchronize(stream_));
+  return Status::OK();
+}
+
+void ROCMGraph::Reset() {
+  for (auto& graph_exec : graph_execs_) {
+    HIP_CALL_THROW(hipGraphExecDestroy(graph_exec.second));
+  }
+  graph_execs_.clear();
+  graph_exec_lookup_.clear();
+}
+
+ROCMGraph::~ROCMGraph() {
+  Reset();
+}
+
+}  // namespace onnxruntime
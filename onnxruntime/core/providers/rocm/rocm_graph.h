@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "core/common/common.h"
+#include "core/platform/ort_mutex.h"
+#include "core/providers/rocm/rocm_pch.h"
+
+namespace onnxruntime {
+
+// Identifies one of the graphs captured on a stream
+using HipGraphKey_t = std::string;
+
+// The HIP counterpart of CUDAGraph: the graphs captured on a stream. Up to a maximum number of graphs are kept,
+// the least recently used graph is destroyed to make room for a new one.
+struct ROCMGraph {
+  ROCMGraph() {};
+  ROCMGraph(hipStream_t stream);
+  ~ROCMGraph();
+
+  void SetStream(hipStream_t stream);
+  void SetMaxGraphs(size_t max_graphs);
+  void CaptureBegin(const HipGraphKey_t& key);
+  void CaptureEnd();
+  bool IsCaptured(const HipGraphKey_t& key) const;
+  Status Replay(const HipGraphKey_t& key);
+  void Reset();
+
+ private:
+  using GraphList = std::list<std::pair<HipGraphKey_t, hipGraphExec_t>>;
+
+  // Instantiated graphs, the most recently used first
+  GraphList graph_execs_;
+  std::unordered_map<HipGraphKey_t, GraphList::iterator> graph_exec_lookup_;
+
+  HipGraphKey_t capture_key_;
+  bool is_capturing_ = false;
+  size_t max_graphs_ = 1;
+
+  hipStream_t stream_ = nullptr;  // Does not own the stream
+};
+
+}  // namespace onnxruntime
@@ -82,6 +82,7 @@ class RocmKernel : public OpKernel {
   }
 
   bool IsTunableOpEnabled() const { return provider_->IsTunableOpEnabled(); }
+  ::onnxruntime::tunable::TuningResults* GetTuningResults() const { return provider_->GetTuningResults(); }
 
   // To support hipMemcpyAsync, the cpu memory should be allocated in pinned memory
   // and it can only be released after the copy has finished
@@ -18,6 +18,8 @@ namespace tunable {
 
 using OpParams = ::onnxruntime::tunable::OpParams<hipStream_t>;
 
+using TuningResults = ::onnxruntime::tunable::TuningResults;
+
 template <typename ParamsT>
 using Op = ::onnxruntime::tunable::Op<ParamsT>;
 
@@ -491,6 +491,8 @@ struct ProviderHost {
   virtual void KernelDefBuilder__InputMemoryType(KernelDefBuilder* p, OrtMemType type, const std::vector<int>& input_indexes) = 0;
   virtual void KernelDefBuilder__OutputMemoryType(KernelDefBuilder* p, OrtMemType type, int input_index) = 0;
   virtual void KernelDefBuilder__ExecQueueId(KernelDefBuilder* p, int queue_id) = 0;
+  virtual void KernelDefBuilder__SetDefaultInputsMemoryType(KernelDefBuilder* p, OrtMemType mem_type) = 0;
+  virtual void KernelDefBuilder__SetDefaultOutputMemoryType(KernelDefBuilder* p, OrtMemType mem_type) = 0;
   virtual void KernelDefBuilder__MayInplace(KernelDefBuilder* p, int input_index, int output_index) = 0;
   virtual void KernelDefBuilder__Alias(KernelDefBuilder* p, int input_index, int output_index) = 0;
   virtual void KernelDefBuilder__Alias(KernelDefBuilder* p, const std::vector<std::pair<int, int>>& aliases) = 0;
@@ -884,7 +886,7 @@ struct ProviderHost {
   virtual std::unique_ptr<Model> cann__CreateModel(const GraphViewer& graph_viewer, const logging::Logger& logger) = 0;
 #endif
 
-#if defined(USE_TENSORRT)
+#if defined(USE_TENSORRT) || defined(USE_OPENVINO)
   virtual void MurmurHash3__x86_128(const void* key, int len, uint32_t seed, void* out) = 0;
 #endif
 
@@ -459,6 +459,14 @@ struct KernelDefBuilder final {
     g_host->KernelDefBuilder__ExecQueueId(this, queue_id);
     return *this;
   }
+  KernelDefBuilder& SetDefaultInputsMemoryType(OrtMemType mem_type) {
+    g_host->KernelDefBuilder__SetDefaultInputsMemoryType(this, mem_type);
+    return *this;
+  }
+  KernelDefBuilder& SetDefaultOutputMemoryType(OrtMemType mem_type) {
+    g_host->KernelDefBuilder__SetDefaultOutputMemoryType(this, mem_type);
+    return *this;
+  }
   KernelDefBuilder& MayInplace(int input_index, int output_index) {
     g_host->KernelDefBuilder__MayInplace(this, input_index, output_index);
     return *this;
@@ -1,5 +1,6 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
+#include <atomic>
 #include <fstream>
 #include <list>
 #include <unordered_set>
@@ -312,7 +313,7 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     }
     dump_subgraphs_ = info.dump_subgraphs;
     engine_cache_enable_ = info.engine_cache_enable;
-    if (engine_cache_enable_ || int8_enable_) {
+    if (engine_cache_enable_ || int8_enable_ || max_optimization_profiles_ > 0) {
       cache_path_ = info.engine_cache_path;
     }
     engine_decryption_enable_ = info.engine_decryption_enable;
@@ -320,6 +321,9 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
       engine_decryption_lib_path_ = info.engine_decryption_lib_path;
     }
     force_sequential_engine_build_ = info.force_sequential_engine_build;
+    engine_build_thread_count_ = info.engine_build_thread_count;
+    engine_build_in_background_ = info.engine_build_in_background;
+    max_optimization_profiles_ = info.max_optimization_profiles;
     context_memory_sharing_enable_ = info.context_memory_sharing_enable;
     if (fp16_enable_) {
       layer_norm_fp32_fallback_ = info.layer_norm_fp32_fallback;
@@ -386,7 +390,12 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
       engine_cache_enable_ = (std::stoi(engine_cache_enable_env) == 0 ? false : true);
     }
 
-    if (engine_cache_enable_ || int8_enable_) {
+    const std::string max_optimization_profiles_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kMaxOptimizationProfiles);
+    if (!max_optimization_profiles_env.empty()) {
+      max_optimization_profiles_ = std::stoi(max_optimization_profiles_env);
+    }
+
+    if (engine_cache_enable_ || int8_enable_ || max_optimization_profiles_ > 0) {
       const std::string engine_cache_path = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kEngineCachePath);
       cache_path_ = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kCachePath);
       if (!engine_cache_path.empty() && cache_path_.empty()) {
@@ -409,6 +418,16 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
       force_sequential_engine_build_ = (std::stoi(force_sequential_engine_build_env) == 0 ? false : true);
     }
 
+    const std::string engine_build_thread_count_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kEngineBuildThreadCount);
+    if (!engine_build_thread_count_env.empty()) {
+      engine_build_thread_count_ = std::stoi(engine_build_thread_count_env);
+    }
+
+    const std::string engine_build_in_background_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kEngineBuildInBackground);
+    if (!engine_build_in_background_env.empty()) {
+      engine_build_in_background_ = (std::stoi(engine_build_in_background_env) == 0 ? false : true);
+    }
+
     const std::string context_memory_sharing_enable_env = onnxruntime::GetEnvironmentVar(tensorrt_env_vars::kContextMemorySharingEnable);
     if (!context_memory_sharing_enable_env.empty()) {
       context_memory_sharing_enable_ = (std::stoi(context_memory_sharing_enable_env) == 0 ? false : true);
@@ -437,8 +456,22 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
     LOGS_DEFAULT(WARNING) << "[TensorRT EP] TensorRT option trt_dla_core must be a non-negative integer value. Set it to 0";
     dla_core_ = 0;
   }
+  if (engine_build_thread_count_ < 0) {
+    LOGS_DEFAULT(WARNING) << "[TensorRT EP] TensorRT option trt_engine_build_thread_count must be a non-negative integer value. Set it to 1";
+    engine_build_thread_count_ = 1;
+  } else if (engine_build_thread_count_ == 0) {
+    engine_build_thread_count_ = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+  }
+  if (force_sequential_engine_build_) {
+    engine_build_thread_count_ = 1;
+    engine_build_in_background_ = false;
+  }
+  if (max_optimization_profiles_ < 0) {
+    LOGS_DEFAULT(WARNING) << "[TensorRT EP] TensorRT option trt_max_optimization_profiles must be a non-negative integer value. Set it to 0";
+    max_optimization_profiles_ = 0;
+  }
 
-  if (engine_cache_enable_ || int8_enable_) {
+  if (engine_cache_enable_ || int8_enable_ || max_optimization_profiles_ > 0) {
     if (!cache_path_.empty() && !fs::is_directory(cache_path_)) {
       if (!fs::create_directory(cache_path_)) {
         throw std::runtime_error("Failed to create directory " + cache_path_);
@@ -482,11 +515,17 @@ TensorrtExecutionProvider::TensorrtExecutionProvider(const TensorrtExecutionProv
                         << ", trt_engine_decryption_enable: " << engine_decryption_enable_
                         << ", trt_engine_decryption_lib_path: " << engine_decryption_lib_path_
                         << ", trt_force_sequential_engine_build: " << force_sequential_engine_build_
+                        << ", trt_engine_build_thread_count: " << engine_build_thread_count_
+                        << ", trt_engine_build_in_background: " << engine_build_in_background_
+                        << ", trt_max_optimization_profiles: " << max_optimization_profiles_
                         << ", trt_context_memory_sharing_enable: " << context_memory_sharing_enable_
                         << ", trt_layer_norm_fp32_fallback: " << layer_norm_fp32_fallback_;
 }
 
 TensorrtExecutionProvider::~TensorrtExecutionProvider() {
+  for (auto& engine_build_thread : engine_build_threads_) {
+    engine_build_thread.join();
+  }
   if (external_stream_) {
     ORT_IGNORE_RETURN_VALUE(CUBLAS_CALL(cublasDestroy(external_cublas_handle_)));
     ORT_IGNORE_RETURN_VALUE(CUDNN_CALL(cudnnDestroy(external_cudnn_handle_)));
@@ -1212,8 +1251,36 @@ TensorrtExecutionProvider::GetCapability(const GraphViewer& graph,
   return result;
 }
 
+namespace {
+// Engine build of one static shape subgraph. The jobs are run by the engine build threads started in Compile.
+struct EngineBuildJob {
+  std::string fused_node_name;
+  std::function<Status()> build;
+  std::promise<Status> status;
+};
+}  // namespace
+
+Status TensorrtExecutionProvider::CreateExecutionContext(nvinfer1::ICudaEngine* trt_engine,
+                                                         tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>* trt_context) {
+  if (context_memory_sharing_enable_) {
+    size_t mem_size = trt_engine->getDeviceMemorySize();
+    if (mem_size > max_ctx_mem_size_) {
+      max_ctx_mem_size_ = mem_size;
+      context_memory_ = IAllocator::MakeUniquePtr<void>(allocator_, max_ctx_mem_size_);
+    }
+    *trt_context = tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>(trt_engine->createExecutionContextWithoutDeviceMemory());
+  } else {
+    *trt_context = tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>(trt_engine->createExecutionContext());
+  }
+  if (*trt_context == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP could not build execution context.");
+  }
+  return Status::OK();
+}
+
 common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAndGraph>& fused_nodes_and_graphs,
                                                   std::vector<NodeComputeInfo>& node_compute_funcs) {
+  auto engine_build_jobs = std::make_shared<std::vector<EngineBuildJob>>();
   for (auto& fused_node_graph : fused_nodes_and_graphs) {
     const GraphViewer& graph_body_viewer = fused_node_graph.filtered_graph;
     const Node& fused_node = fused_node_graph.fused_node;
@@ -1362,98 +1429,97 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
     }
 
     // Build TRT engine here if the graph doesn't have dynamic shape input. Otherwise engine will
-    // be built at runtime
-    tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine> trt_engine;
-    tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext> trt_context;
+    // be built at runtime. Every subgraph has its own builder, network and config, so the engines of
+    // static shape subgraphs are built by the engine build jobs after all fused nodes are processed.
+    engines_.emplace(fused_node.Name(), nullptr);
+    contexts_.emplace(fused_node.Name(), nullptr);
     if (!has_dynamic_shape) {
       const std::string cache_path = GetCachePath(cache_path_, trt_node_name_with_precision);
       const std::string engine_cache_path = cache_path + ".engine";
-      {
-        // ifstream file check, engine serialization/deserialization and engine build are in critical section. It needs lock protection to prevent race condition when inferencing with multithreading.
-        auto lock = GetApiLock();
+      const bool set_dynamic_range = int8_enable_ && trt_builder->platformHasFastInt8() && int8_calibration_cache_available_;
+      std::shared_ptr<nvinfer1::IBuilderConfig> build_config(trt_config.release(), tensorrt_ptr::TensorrtInferDeleter());
+      auto build_engine = [this, trt_builder = trt_builder.get(), trt_network = trt_network.get(), build_config,
+                           trt_engine = &engines_[fused_node.Name()], engine_cache_path, set_dynamic_range,
+                           dynamic_range_map, fused_node_name = fused_node.Name()]() -> Status {
+        CUDA_RETURN_IF_ERROR(cudaSetDevice(device_id_));
+        {
+          // ifstream file check and engine deserialization are in critical section. It needs lock protection to prevent race condition when inferencing with multithreading.
+          auto lock = GetApiLock();
 
-        std::ifstream engine_file(engine_cache_path, std::ios::binary | std::ios::in);
-        if (engine_cache_enable_ && engine_file) {
-          engine_file.seekg(0, std::ios::end);
-          size_t engine_size = engine_file.tellg();
-          engine_file.seekg(0, std::ios::beg);
-          std::unique_ptr<char[]> engine_buf{new char[engine_size]};
-          engine_file.read((char*)engine_buf.get(), engine_size);
-          trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(engine_buf.get(), engine_size, nullptr));
-          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
-          if (trt_engine == nullptr) {
-            return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                   "TensorRT EP could not deserialize engine from cache: " + engine_cache_path);
-          }
-        } else if (engine_decryption_enable_ && engine_cache_enable_ && !engine_file) {
-          // Decrypt engine
-          size_t engine_size = 0;
-          if (!engine_decryption_(engine_cache_path.c_str(), nullptr, &engine_size)) {
-            return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                   "TensorRT EP could not get engine buffer size");
-          }
-          std::unique_ptr<char[]> engine_buf{new char[engine_size]};
-          if (!engine_decryption_(engine_cache_path.c_str(), &engine_buf[0], &engine_size)) {
-            return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                   "TensorRT EP could not call engine decryption function decrypt");
-          }
-          // Deserialize engine
-          trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(engine_buf.get(), engine_size, nullptr));
-          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
-          if (trt_engine == nullptr) {
-            return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                   "TensorRT EP could not deserialize engine from encrypted cache: " + engine_cache_path);
-          }
-        } else {
-          // Set INT8 per tensor dynamic range
-          if (int8_enable_ && trt_builder->platformHasFastInt8() && int8_calibration_cache_available_) {
-            trt_config->setInt8Calibrator(nullptr);
-            if (!SetDynamicRange(*trt_network, dynamic_range_map)) {
+          std::ifstream engine_file(engine_cache_path, std::ios::binary | std::ios::in);
+          if (engine_cache_enable_ && engine_file) {
+            engine_file.seekg(0, std::ios::end);
+            size_t engine_size = engine_file.tellg();
+            engine_file.seekg(0, std::ios::beg);
+            std::unique_ptr<char[]> engine_buf{new char[engine_size]};
+            engine_file.read((char*)engine_buf.get(), engine_size);
+            *trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(engine_buf.get(), engine_size, nullptr));
+            LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
+            if (*trt_engine == nullptr) {
+              return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                                     "TensorRT EP could not deserialize engine from cache: " + engine_cache_path);
+            }
+            return Status::OK();
+          } else if (engine_decryption_enable_ && engine_cache_enable_ && !engine_file) {
+            // Decrypt engine
+            size_t engine_size = 0;
+            if (!engine_decryption_(engine_cache_path.c_str(), nullptr, &engine_size)) {
+              return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                                     "TensorRT EP could not get engine buffer size");
+            }
+            std::unique_ptr<char[]> engine_buf{new char[engine_size]};
+            if (!engine_decryption_(engine_cache_path.c_str(), &engine_buf[0], &engine_size)) {
+              return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                                     "TensorRT EP could not call engine decryption function decrypt");
+            }
+            // Deserialize engine
+            *trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(runtime_->deserializeCudaEngine(engine_buf.get(), engine_size, nullptr));
+            LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] DeSerialized " + engine_cache_path;
+            if (*trt_engine == nullptr) {
               return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                     "TensorRT EP could not set INT8 dynamic range for fused node: " + fused_node.Name());
+                                     "TensorRT EP could not deserialize engine from encrypted cache: " + engine_cache_path);
             }
+            return Status::OK();
           }
+        }
 
-          // Build engine
-          trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(trt_builder->buildEngineWithConfig(*trt_network, *trt_config));
-          if (trt_engine == nullptr) {
+        // Set INT8 per tensor dynamic range
+        if (set_dynamic_range) {
+          build_config->setInt8Calibrator(nullptr);
+          if (!SetDynamicRange(*trt_network, dynamic_range_map)) {
             return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                   "TensorRT EP could not build engine for fused node: " + fused_node.Name());
-          }
-          if (engine_cache_enable_) {
-            nvinfer1::IHostMemory* serializedModel = trt_engine->serialize();
-            size_t engine_size = serializedModel->size();
-            if (engine_decryption_enable_) {
-              // Encrypt engine
-              if (!engine_encryption_(engine_cache_path.c_str(), reinterpret_cast<char*>(serializedModel->data()), engine_size)) {
-                return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                                       "TensorRT EP could not call engine encryption function encrypt");
-              }
-            } else {
-              std::ofstream file(engine_cache_path, std::ios::binary | std::ios::out);
-              file.write(reinterpret_cast<char*>(serializedModel->data()), engine_size);
-            }
-            serializedModel->destroy();
-            LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + engine_cache_path;
+                                   "TensorRT EP could not set INT8 dynamic range for fused node: " + fused_node_name);
           }
         }
-      }
 
-      // Build context
-      if (context_memory_sharing_enable_) {
-        size_t mem_size = trt_engine->getDeviceMemorySize();
-        if (mem_size > max_ctx_mem_size_) {
-          max_ctx_mem_size_ = mem_size;
-          context_memory_ = IAllocator::MakeUniquePtr<void>(allocator_, max_ctx_mem_size_);
+        // Build engine. This doesn't need the api lock since the builder is only used by this job.
+        *trt_engine = tensorrt_ptr::unique_pointer<nvinfer1::ICudaEngine>(trt_builder->buildEngineWithConfig(*trt_network, *build_config));
+        if (*trt_engine == nullptr) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                                 "TensorRT EP could not build engine for fused node: " + fused_node_name);
         }
-        trt_context = tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>(trt_engine->createExecutionContextWithoutDeviceMemory());
-      } else {
-        trt_context = tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>(trt_engine->createExecutionContext());
-      }
-      if (trt_context == nullptr) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
-                               "TensorRT EP could not build execution context for fused node: " + fused_node.Name());
-      }
+        if (engine_cache_enable_) {
+          auto lock = GetApiLock();
+          nvinfer1::IHostMemory* serializedModel = (*trt_engine)->serialize();
+          size_t engine_size = serializedModel->size();
+          if (engine_decryption_enable_) {
+            // Encrypt engine
+            if (!engine_encryption_(engine_cache_path.c_str(), reinterpret_cast<char*>(serializedModel->data()), engine_size)) {
+              serializedModel->destroy();
+              return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL,
+                                     "TensorRT EP could not call engine encryption function encrypt");
+            }
+          } else {
+            std::ofstream file(engine_cache_path, std::ios::binary | std::ios::out);
+            file.write(reinterpret_cast<char*>(serializedModel->data()), engine_size);
+          }
+          serializedModel->destroy();
+          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Serialized " + engine_cache_path;
+        }
+        return Status::OK();
+      };
+      engine_build_jobs->push_back({fused_node.Name(), std::move(build_engine), std::promise<Status>()});
+      engine_build_status_[fused_node.Name()] = engine_build_jobs->back().status.get_future().share();
     }
 
     // Create input to index map
@@ -1480,8 +1546,6 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
 
     // Save engine, context and input/output info to map
     parsers_.emplace(fused_node.Name(), std::move(trt_parser));
-    engines_.emplace(fused_node.Name(), std::move(trt_engine));
-    contexts_.emplace(fused_node.Name(), std::move(trt_context));
     builders_.emplace(fused_node.Name(), std::move(trt_builder));
     networks_.emplace(fused_node.Name(), std::move(trt_network));
     input_info_[fused_node.Name()].push_back(input_indexes);
@@ -1501,13 +1565,41 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
             dla_enable_, dla_core_, &max_workspace_size_, trt_node_name_with_precision, engine_cache_enable_, cache_path_,
             runtime_.get(), nullptr, allocator_, context_memory_sharing_enable_, &max_ctx_mem_size_, &context_memory_,
             dynamic_range_map, engine_decryption_enable_, engine_decryption_, engine_encryption_};
+      const auto& engine_build_status = engine_build_status_.find(context->node_name);
+      if (engine_build_status != engine_build_status_.end()) {
+        p->engine_build_status = engine_build_status->second;
+      }
+
+      // Learn optimization profiles of dynamic shape subgraphs, continuing from the shapes observed by earlier sessions.
+      // Shape tensor inputs keep using the single profile built from the input shape ranges.
+      bool has_shape_tensor_input = false;
+      auto trt_network = networks_[context->node_name].get();
+      for (int i = 0, end = trt_network->getNbInputs(); i < end; ++i) {
+        has_shape_tensor_input = has_shape_tensor_input || trt_network->getInput(i)->isShapeTensor();
+      }
+      if (max_optimization_profiles_ > 0 && !p->input_shape_ranges.empty() && !has_shape_tensor_input) {
+        p->max_optimization_profiles = max_optimization_profiles_;
+        const std::string shapes_cache_path = GetCachePath(cache_path_, trt_node_name_with_precision) + ".shapes";
+        std::ifstream shapes_file(shapes_cache_path, std::ios::in);
+        if (shapes_file && !DeserializeShapes(shapes_file, p->learned_profiles, p->shape_histogram)) {
+          LOGS_DEFAULT(WARNING) << "[TensorRT EP] Ignore malformed shapes cache " + shapes_cache_path;
+          p->learned_profiles.clear();
+          p->shape_histogram.clear();
+        }
+      }
       *state = p.release();
       return 0;
     };
 
     // Release function state
     compute_info.release_state_func = [](FunctionState state) {
-      delete static_cast<TensorrtFuncState*>(state);
+      auto trt_state = static_cast<TensorrtFuncState*>(state);
+      // Persist the observed shapes for the next session
+      if (trt_state->max_optimization_profiles > 0 && !trt_state->shape_histogram.empty()) {
+        SerializeShapes(GetCachePath(trt_state->engine_cache_path, trt_state->trt_node_name_with_precision) + ".shapes",
+                        trt_state->learned_profiles, trt_state->shape_histogram);
+      }
+      delete trt_state;
     };
 
     // Create compute function
@@ -1515,7 +1607,14 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
       Ort::KernelContext ctx(context);
 
       TensorrtFuncState* trt_state = reinterpret_cast<TensorrtFuncState*>(state);
+      // Wait for the engine if it is still being built in the background
+      if (trt_state->engine_build_status.valid()) {
+        ORT_RETURN_IF_ERROR(trt_state->engine_build_status.get());
+      }
       std::lock_guard<OrtMutex> lock(*(trt_state->tensorrt_mu_ptr));
+      if (*(trt_state->engine) != nullptr && *(trt_state->context) == nullptr) {
+        ORT_RETURN_IF_ERROR(CreateExecutionContext(trt_state->engine->get(), trt_state->context));
+      }
       const std::unordered_map<std::string, size_t>& input_indexes = (trt_state->input_info)[0];
       const std::unordered_map<std::string, size_t>& output_indexes = (trt_state->output_info)[0];
       const std::unordered_map<std::string, size_t>& output_types = (trt_state->output_info)[1];
@@ -1612,6 +1711,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         }
       }
 
+      std::vector<int64_t> dynamic_dims;
       for (int i = 0, end = num_inputs; i < end; ++i) {
         auto input = trt_state->network->get()->getInput(i);
         const std::string& input_name = input->getName();
@@ -1711,6 +1811,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
             for (int j = 0, end = nb_dims; j < end; ++j) {
               const auto& tensor_shape = tensor_shapes[j];
               if (shape_range.find(j) != shape_range.end()) {
+                dynamic_dims.push_back(tensor_shape);
                 dims_min.d[j] = static_cast<int32_t>(shape_range[j].first);
                 dims_opt.d[j] = static_cast<int32_t>(shape_range[j].second);
                 dims_max.d[j] = static_cast<int32_t>(shape_range[j].second);
@@ -1741,14 +1842,58 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         }
       }
 
+      // Use the learned optimization profile covering the shapes of this run. The profiles are learned again
+      // from all the observed shapes only if none of them covers the shapes.
+      const bool learn_profiles = trt_state->max_optimization_profiles > 0;
+      int profile_index = 0;
+      if (learn_profiles) {
+        ++trt_state->shape_histogram[dynamic_dims];
+        profile_index = FindProfile(trt_state->learned_profiles, dynamic_dims);
+        engine_update = profile_index < 0 || trt_engine == nullptr ||
+                        trt_engine->getNbOptimizationProfiles() != static_cast<int>(trt_state->learned_profiles.size());
+        if (engine_update) {
+          trt_state->learned_profiles = LearnProfiles(trt_state->shape_histogram, trt_state->max_optimization_profiles);
+          profile_index = FindProfile(trt_state->learned_profiles, dynamic_dims);
+          LOGS_DEFAULT(VERBOSE) << "[TensorRT EP] Learned " << trt_state->learned_profiles.size() << " optimization profiles from "
+                                << trt_state->shape_histogram.size() << " observed shapes";
+        }
+      }
+
       // Regenerate engine
-      // Only one profile is generated, so no need to explicitly set optimization profile
+      // Without profile learning only one profile is generated, so no need to explicitly set optimization profile
       if (engine_update) {
         trt_state->context->reset();
         trt_state->engine->reset();
         auto trt_config = tensorrt_ptr::unique_pointer<nvinfer1::IBuilderConfig>(trt_builder->createBuilderConfig());
         trt_config->setMaxWorkspaceSize(*(trt_state->max_workspace_size_ptr));
-        trt_config->addOptimizationProfile(*trt_profile);
+        if (learn_profiles) {
+          for (const auto& learned_profile : trt_state->learned_profiles) {
+            auto profile = trt_builder->createOptimizationProfile();
+            size_t dim_index = 0;
+            for (int i = 0, end = num_inputs; i < end; ++i) {
+              auto input = trt_state->network->get()->getInput(i);
+              const auto& shape_range = shape_ranges.find(input->getName());
+              if (shape_range == shape_ranges.end()) {
+                continue;
+              }
+              nvinfer1::Dims dims_min = input->getDimensions(), dims_opt = dims_min, dims_max = dims_min;
+              for (int j = 0, nb_dims = dims_min.nbDims; j < nb_dims; ++j) {
+                if (shape_range->second.find(j) != shape_range->second.end()) {
+                  dims_min.d[j] = static_cast<int32_t>(learned_profile.min[dim_index]);
+                  dims_opt.d[j] = static_cast<int32_t>(learned_profile.opt[dim_index]);
+                  dims_max.d[j] = static_cast<int32_t>(learned_profile.max[dim_index]);
+                  ++dim_index;
+                }
+              }
+              profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMIN, dims_min);
+              profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kMAX, dims_max);
+              profile->setDimensions(input->getName(), nvinfer1::OptProfileSelector::kOPT, dims_opt);
+            }
+            trt_config->addOptimizationProfile(profile);
+          }
+        } else {
+          trt_config->addOptimizationProfile(*trt_profile);
+        }
 
         // Set INT8 Per Tensor Dynamic range
         if (trt_state->int8_enable && trt_builder->platformHasFastInt8() && trt_state->int8_calibration_cache_available) {
@@ -1805,6 +1950,10 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
           }
           serializedModel->destroy();
         }
+        if (learn_profiles) {
+          // Keep the learned profiles in sync with the cached engine
+          SerializeShapes(cache_path + ".shapes", trt_state->learned_profiles, trt_state->shape_histogram);
+        }
 
         // Build context
         if (trt_state->context_memory_sharing_enable) {
@@ -1820,11 +1969,22 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         trt_context = trt_state->context->get();
       }
 
-      // Get input and output binding names
+      // Select the optimization profile. The bindings of profile k are offset by k times the bindings of one profile.
       int total_bindings = trt_engine->getNbBindings();
+      int bindings_per_profile = total_bindings / trt_engine->getNbOptimizationProfiles();
+      int binding_offset = 0;
+      if (learn_profiles) {
+        if (trt_context->getOptimizationProfile() != profile_index &&
+            !trt_context->setOptimizationProfileAsync(profile_index, stream)) {
+          return ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to set optimization profile " + std::to_string(profile_index));
+        }
+        binding_offset = profile_index * bindings_per_profile;
+      }
+
+      // Get input and output binding names
       std::vector<void*> buffers(total_bindings);
       std::vector<std::string> input_binding_names, output_binding_names;
-      for (int i = 0, end = total_bindings; i < end; ++i) {
+      for (int i = 0, end = bindings_per_profile; i < end; ++i) {
         if (trt_engine->bindingIsInput(i)) {
           input_binding_names.push_back(trt_engine->getBindingName(i));
         } else {
@@ -1840,6 +2000,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         if (binding_index == -1) {
           continue;
         }
+        binding_index += binding_offset;
 
         size_t input_index = 0;
         const auto iter = input_indexes.find(input_name);
@@ -1993,6 +2154,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
         if (binding_index == -1) {
           continue;
         }
+        binding_index += binding_offset;
 
         size_t output_index = 0;
         const auto& index_iter = output_indexes.find(output_name);
@@ -2145,7 +2307,7 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
       // Cast INT64 input to INT32 because TensorRT doesn't fully support INT64
       for (size_t i = 0, end = output_binding_names.size(); i < end; ++i) {
         const std::string& output_name = output_binding_names[i];
-        size_t binding_index = trt_engine->getBindingIndex(output_name.c_str());
+        size_t binding_index = trt_engine->getBindingIndex(output_name.c_str()) + binding_offset;
         size_t output_type = 0;
         const auto& iter = output_types.find(output_name);
         if (iter != output_types.end()) {
@@ -2169,6 +2331,52 @@ common::Status TensorrtExecutionProvider::Compile(const std::vector<FusedNodeAnd
 
     node_compute_funcs.push_back(compute_info);
   }
+
+  if (engine_build_jobs->empty()) {
+    return Status::OK();
+  }
+
+  // Run the engine build jobs. The threads pick the next job until all of them are done.
+  auto next_job = std::make_shared<std::atomic<size_t>>(0);
+  auto run_engine_build_jobs = [engine_build_jobs, next_job]() {
+    for (size_t i = (*next_job)++; i < engine_build_jobs->size(); i = (*next_job)++) {
+      auto& job = (*engine_build_jobs)[i];
+      Status status;
+      ORT_TRY {
+        status = job.build();
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          status = ORT_MAKE_STATUS(ONNXRUNTIME, EP_FAIL, "TensorRT EP failed to build engine for fused node: ",
+                                   job.fused_node_name, ". ", ex.what());
+        });
+      }
+      job.status.set_value(status);
+    }
+  };
+  const size_t num_threads = std::min(static_cast<size_t>(engine_build_thread_count_), engine_build_jobs->size());
+  if (engine_build_in_background_) {
+    // The first run of each subgraph waits for its engine in compute_func
+    for (size_t i = 0; i < num_threads; ++i) {
+      engine_build_threads_.emplace_back(run_engine_build_jobs);
+    }
+    return Status::OK();
+  }
+
+  std::vector<std::thread> engine_build_threads;
+  for (size_t i = 1; i < num_threads; ++i) {
+    engine_build_threads.emplace_back(run_engine_build_jobs);
+  }
+  run_engine_build_jobs();
+  for (auto& engine_build_thread : engine_build_threads) {
+    engine_build_thread.join();
+  }
+
+  // Build contexts
+  for (const auto& job : *engine_build_jobs) {
+    ORT_RETURN_IF_ERROR(engine_build_status_[job.fused_node_name].get());
+    ORT_RETURN_IF_ERROR(CreateExecutionContext(engines_[job.fused_node_name].get(), &contexts_[job.fused_node_name]));
+  }
   return Status::OK();
 }
 
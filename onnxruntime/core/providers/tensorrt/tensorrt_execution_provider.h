@@ -3,6 +3,9 @@
 
 #pragma once
 #include <ctime>
+#include <map>
+#include <future>
+#include <thread>
 #include <cudnn.h>
 #include <cublas_v2.h>
 #include "NvInfer.h"
@@ -30,6 +33,9 @@ static const std::string kDecryptionLibPath = "ORT_TENSORRT_ENGINE_DECRYPTION_LI
 static const std::string kForceSequentialEngineBuild= "ORT_TENSORRT_FORCE_SEQUENTIAL_ENGINE_BUILD";
 static const std::string kContextMemorySharingEnable= "ORT_TENSORRT_CONTEXT_MEMORY_SHARING_ENABLE";
 static const std::string kLayerNormFP32Fallback= "ORT_TENSORRT_LAYER_NORM_FP32_FALLBACK";
+static const std::string kEngineBuildThreadCount = "ORT_TENSORRT_ENGINE_BUILD_THREAD_COUNT";
+static const std::string kEngineBuildInBackground = "ORT_TENSORRT_ENGINE_BUILD_IN_BACKGROUND";
+static const std::string kMaxOptimizationProfiles = "ORT_TENSORRT_MAX_OPTIMIZATION_PROFILES";
 // Old env variable for backward compatibility
 static const std::string kEngineCachePath = "ORT_TENSORRT_ENGINE_CACHE_PATH";
 }  // namespace tensorrt_env_vars
@@ -81,6 +87,20 @@ template <typename T>
 using unique_pointer = std::unique_ptr<T, TensorrtInferDeleter>;
 };  // namespace tensorrt_ptr
 
+/*
+ * Input shapes observed at runtime, used to learn optimization profiles
+ * Each key holds the dynamic shape dimensions of all execution tensor inputs, ordered by input and then by
+ * dimension, and the value is the number of runs with these dimensions.
+ */
+using ShapeHistogram = std::map<std::vector<int64_t>, size_t>;
+
+// Optimization profile learned from observed shapes. Dimensions are ordered like the keys of ShapeHistogram.
+struct LearnedProfile {
+  std::vector<int64_t> min;
+  std::vector<int64_t> opt;
+  std::vector<int64_t> max;
+};
+
 // Information to construct kernel function state.
 struct TensorrtFuncState {
   AllocateFunc test_allocate_func = nullptr;
@@ -114,6 +134,12 @@ struct TensorrtFuncState {
   bool engine_decryption_enable;
   int (*engine_decryption)(const char*, char*, size_t*);
   int (*engine_encryption)(const char*, char*, size_t);
+  // Result of the engine build started in Compile. Only valid for static shape subgraphs.
+  std::shared_future<Status> engine_build_status;
+  // Optimization profiles learned from the observed input shapes. Only used if max_optimization_profiles > 0.
+  int max_optimization_profiles = 0;
+  std::vector<LearnedProfile> learned_profiles;
+  ShapeHistogram shape_histogram;
 };
 
 // Logical device representation.
@@ -158,6 +184,9 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   bool dla_enable_ = false;
   int dla_core_ = 0;
   bool force_sequential_engine_build_ = false;
+  int engine_build_thread_count_ = 1;
+  bool engine_build_in_background_ = false;
+  int max_optimization_profiles_ = 0;
   std::string int8_calibration_cache_name_;
   bool int8_calibration_cache_available_ = false;
   bool int8_use_native_tensorrt_calibration_table_ = false;
@@ -186,6 +215,11 @@ class TensorrtExecutionProvider : public IExecutionProvider {
   std::unordered_map<std::string, std::vector<std::unordered_map<std::string, size_t>>> input_info_;
   std::unordered_map<std::string, std::vector<std::unordered_map<std::string, size_t>>> output_info_;
   std::unordered_map<std::string, std::unordered_map<std::string, std::unordered_map<size_t, std::pair<int64_t, int64_t>>>> input_shape_ranges_;
+  std::unordered_map<std::string, std::shared_future<Status>> engine_build_status_;
+
+  // Threads building the engines of static shape subgraphs when trt_engine_build_in_background is set.
+  // They are joined in the destructor.
+  std::vector<std::thread> engine_build_threads_;
 
   // for external stream, we need to create its cudnn/cublass handle before cuda EP enable cuda graph capture
   cudnnHandle_t external_cudnn_handle_ = nullptr;
@@ -222,5 +256,9 @@ class TensorrtExecutionProvider : public IExecutionProvider {
 
   /**Check whether all the nodes of subgraph are supported*/
   bool IsSubGraphFullySupported(SubGraphCollection_t supported_nodes_vector, const int number_of_ort_nodes) const;
+
+  /**Create the execution context of a built engine. The device memory is shared by all contexts if context memory sharing is enabled*/
+  Status CreateExecutionContext(nvinfer1::ICudaEngine* trt_engine,
+                                tensorrt_ptr::unique_pointer<nvinfer1::IExecutionContext>* trt_context);
 };
 }  // namespace onnxruntime
@@ -30,6 +30,9 @@ constexpr const char* kForceSequentialEngineBuild = "trt_force_sequential_engine
 // add new provider option name here. 
 constexpr const char* kContextMemorySharingEnable = "trt_context_memory_sharing_enable";
 constexpr const char* kLayerNormFP32Fallback = "trt_layer_norm_fp32_fallback";
+constexpr const char* kEngineBuildThreadCount = "trt_engine_build_thread_count";
+constexpr const char* kEngineBuildInBackground = "trt_engine_build_in_background";
+constexpr const char* kMaxOptimizationProfiles = "trt_max_optimization_profiles";
 }  // namespace provider_option_names
 }  // namespace tensorrt 
 
@@ -66,6 +69,9 @@ TensorrtExecutionProviderInfo TensorrtExecutionProviderInfo::FromProviderOptions
           .AddAssignmentToReference(tensorrt::provider_option_names::kForceSequentialEngineBuild, info.force_sequential_engine_build)
           .AddAssignmentToReference(tensorrt::provider_option_names::kContextMemorySharingEnable, info.context_memory_sharing_enable)
           .AddAssignmentToReference(tensorrt::provider_option_names::kLayerNormFP32Fallback, info.layer_norm_fp32_fallback)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kEngineBuildThreadCount, info.engine_build_thread_count)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kEngineBuildInBackground, info.engine_build_in_background)
+          .AddAssignmentToReference(tensorrt::provider_option_names::kMaxOptimizationProfiles, info.max_optimization_profiles)
           .Parse(options)); // add new provider option here.
 
   return info;
@@ -93,6 +99,9 @@ ProviderOptions TensorrtExecutionProviderInfo::ToProviderOptions(const TensorrtE
       // add new provider option here.
       {tensorrt::provider_option_names::kContextMemorySharingEnable, MakeStringWithClassicLocale(info.context_memory_sharing_enable)},
       {tensorrt::provider_option_names::kLayerNormFP32Fallback, MakeStringWithClassicLocale(info.layer_norm_fp32_fallback)},
+      {tensorrt::provider_option_names::kEngineBuildThreadCount, MakeStringWithClassicLocale(info.engine_build_thread_count)},
+      {tensorrt::provider_option_names::kEngineBuildInBackground, MakeStringWithClassicLocale(info.engine_build_in_background)},
+      {tensorrt::provider_option_names::kMaxOptimizationProfiles, MakeStringWithClassicLocale(info.max_optimization_profiles)},
   };
   return options;
 }
@@ -1,7 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <fstream>
+#include <map>
 #include <unordered_map>
 #include <string>
 #include <iostream>
@@ -153,6 +155,149 @@ std::unordered_map<std::string, std::unordered_map<size_t, std::pair<int64_t, in
   return shape_ranges;
 }
 
+/*
+ * Split the observed shapes into at most max_profiles optimization profiles
+ * The shapes are sorted by their number of elements and cut into groups with similar number of runs,
+ * so the frequent shapes get tight profiles. Each profile covers all the shapes of its group and is
+ * optimized for the most frequent one.
+ */
+std::vector<LearnedProfile> LearnProfiles(const ShapeHistogram& shape_histogram, size_t max_profiles) {
+  std::vector<std::pair<int64_t, ShapeHistogram::const_iterator>> shapes;
+  size_t total_runs = 0;
+  for (auto it = shape_histogram.begin(); it != shape_histogram.end(); ++it) {
+    int64_t volume = 1;
+    for (auto dim : it->first) {
+      volume *= dim;
+    }
+    shapes.emplace_back(volume, it);
+    total_runs += it->second;
+  }
+  std::stable_sort(shapes.begin(), shapes.end(),
+                   [](const auto& a, const auto& b) { return a.first < b.first; });
+
+  std::vector<LearnedProfile> profiles;
+  size_t runs = 0;
+  size_t opt_runs = 0;
+  for (size_t i = 0, end = shapes.size(); i < end; ++i) {
+    const auto& dims = shapes[i].second->first;
+    const size_t count = shapes[i].second->second;
+    const bool new_profile = profiles.empty() ||
+                             (profiles.size() < max_profiles &&
+                              runs * max_profiles >= profiles.size() * total_runs) ||
+                             (end - i <= max_profiles - std::min(max_profiles, profiles.size()));
+    if (new_profile) {
+      profiles.push_back({dims, dims, dims});
+      opt_runs = count;
+    } else {
+      auto& profile = profiles.back();
+      for (size_t j = 0, num_dims = dims.size(); j < num_dims; ++j) {
+        profile.min[j] = std::min(profile.min[j], dims[j]);
+        profile.max[j] = std::max(profile.max[j], dims[j]);
+      }
+      if (count > opt_runs) {
+        profile.opt = dims;
+        opt_runs = count;
+      }
+    }
+    runs += count;
+  }
+  return profiles;
+}
+
+/*
+ * Find the optimization profile for the dynamic shape dimensions of a run
+ * Among the profiles covering the dimensions, the one with the smallest max shape is the best match.
+ * Returns -1 if no profile covers the dimensions.
+ */
+int FindProfile(const std::vector<LearnedProfile>& profiles, const std::vector<int64_t>& dims) {
+  int best_index = -1;
+  double best_volume = 0;
+  for (size_t i = 0, end = profiles.size(); i < end; ++i) {
+    const auto& profile = profiles[i];
+    if (profile.min.size() != dims.size()) {
+      continue;
+    }
+    bool covered = true;
+    double volume = 1;
+    for (size_t j = 0, num_dims = dims.size(); j < num_dims && covered; ++j) {
+      covered = dims[j] >= profile.min[j] && dims[j] <= profile.max[j];
+      volume *= static_cast<double>(profile.max[j]);
+    }
+    if (covered && (best_index == -1 || volume < best_volume)) {
+      best_index = static_cast<int>(i);
+      best_volume = volume;
+    }
+  }
+  return best_index;
+}
+
+/*
+ * Serialize learned profiles and observed shapes
+ * The file is text. The first line holds the number of dynamic dimensions and the number of profiles,
+ * followed by the min, opt and max dimensions of each profile and by one "count dims..." line per shape.
+ * For example, with one dynamic dimension and one profile,
+ *   1 1
+ *   profile 1 8 32
+ *   90 8
+ *   10 32
+ */
+void SerializeShapes(const std::string& file_name, const std::vector<LearnedProfile>& profiles, const ShapeHistogram& shape_histogram) {
+  const size_t num_dims = shape_histogram.empty() ? 0 : shape_histogram.begin()->first.size();
+  std::ofstream file(file_name, std::ios::out | std::ios::trunc);
+  file << num_dims << " " << profiles.size() << "\n";
+  auto write_dims = [&file](const std::vector<int64_t>& dims) {
+    for (auto dim : dims) {
+      file << " " << dim;
+    }
+  };
+  for (const auto& profile : profiles) {
+    file << "profile";
+    write_dims(profile.min);
+    write_dims(profile.opt);
+    write_dims(profile.max);
+    file << "\n";
+  }
+  for (const auto& shape : shape_histogram) {
+    file << shape.second;
+    write_dims(shape.first);
+    file << "\n";
+  }
+}
+
+// Deserialize learned profiles and observed shapes. Returns false if the file is malformed.
+bool DeserializeShapes(std::ifstream& infile, std::vector<LearnedProfile>& profiles, ShapeHistogram& shape_histogram) {
+  size_t num_dims = 0, num_profiles = 0;
+  if (!(infile >> num_dims >> num_profiles)) {
+    return false;
+  }
+  auto read_dims = [&infile, num_dims](std::vector<int64_t>& dims) {
+    dims.resize(num_dims);
+    for (auto& dim : dims) {
+      if (!(infile >> dim)) {
+        return false;
+      }
+    }
+    return true;
+  };
+  profiles.resize(num_profiles);
+  for (auto& profile : profiles) {
+    std::string tag;
+    if (!(infile >> tag) || tag != "profile" ||
+        !read_dims(profile.min) || !read_dims(profile.opt) || !read_dims(profile.max)) {
+      return false;
+    }
+  }
+  size_t count = 0;
+  while (infile >> count) {
+    std::vector<int64_t> dims;
+    if (!read_dims(dims)) {
+      return false;
+    }
+    shape_histogram[dims] += count;
+  }
+  return true;
+}
+
 /*
  * Get cache by name
  *
@@ -70,6 +70,9 @@ struct Tensorrt_Provider : Provider {
     info.force_sequential_engine_build = options.trt_force_sequential_engine_build != 0;
     info.context_memory_sharing_enable = options.trt_context_memory_sharing_enable != 0;
     info.layer_norm_fp32_fallback = options.trt_layer_norm_fp32_fallback != 0;
+    info.engine_build_thread_count = options.trt_engine_build_thread_count;
+    info.engine_build_in_background = options.trt_engine_build_in_background != 0;
+    info.max_optimization_profiles = options.trt_max_optimization_profiles;
     return std::make_shared<TensorrtProviderFactory>(info);
   }
 
@@ -137,6 +140,9 @@ struct Tensorrt_Provider : Provider {
     trt_options.trt_force_sequential_engine_build = internal_options.force_sequential_engine_build;
     trt_options.trt_context_memory_sharing_enable = internal_options.context_memory_sharing_enable;
     trt_options.trt_layer_norm_fp32_fallback = internal_options.layer_norm_fp32_fallback;
+    trt_options.trt_engine_build_thread_count = internal_options.engine_build_thread_count;
+    trt_options.trt_engine_build_in_background = internal_options.engine_build_in_background;
+    trt_options.trt_max_optimization_profiles = internal_options.max_optimization_profiles;
   }
 
   ProviderOptions GetProviderOptions(const void* provider_options) override {
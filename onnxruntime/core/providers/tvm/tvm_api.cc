@@ -33,7 +33,8 @@ TvmModule TVMCompile(const TvmEPOptions& options,
                      const std::string& onnx_txt,
                      const std::string& model_path,
                      int opset,
-                     const TVMTensorShapes& input_shapes)
+                     const TVMTensorShapes& input_shapes,
+                     const std::string& artifacts_dir)
 {
   ::tvm::Array<TvmIntArray> shapes;
   for (size_t i = 0; i < input_shapes.size(); ++i)
@@ -59,7 +60,8 @@ TvmModule TVMCompile(const TvmEPOptions& options,
                              shapes,
                              options.to_nhwc,
                              options.tuning_file_path,
-                             options.tuning_type);
+                             options.tuning_type,
+                             artifacts_dir);
   ORT_ENFORCE(mod.get() != nullptr, "Compiled TVM Module is nullptr!");
   return mod;
 }
@@ -136,13 +138,28 @@ static std::unordered_map<std::string, uint64_t> str2dev_type = {
   {"webgpu", 15}
 };
 
-TvmModule TVMSoCompile(const TvmEPOptions& options) {
-  const std::string& dir = options.so_folder;
 #ifdef _WIN32
-  std::string lib_ext = "dll";
+static const std::string lib_ext = "dll";
 #else
-  std::string lib_ext = "so";
+static const std::string lib_ext = "so";
 #endif
+
+static uint64_t getDeviceType(const std::string& target) {
+  size_t pos = target.find(" ");
+  const std::string dev_type_str = target.substr(0, pos);
+  ORT_ENFORCE(!dev_type_str.empty(), "Device was not found in target string");
+  return str2dev_type[dev_type_str];
+}
+
+static std::string readFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  ORT_ENFORCE(file.is_open(), "Unable to open file: " + path);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+}
+
+static TvmModule loadVMExecutable(const std::string& dir, const std::string& target) {
   const std::string lib_path = filter_lib_paths(glob(dir, lib_ext), lib_ext);
   const std::string consts_path = dir +
                                   ToUTF8String(PathString{k_preferred_path_separator}) +
@@ -153,11 +170,7 @@ TvmModule TVMSoCompile(const TvmEPOptions& options) {
 
   TvmModule lib = TvmModule::LoadFromFile(lib_path);
 
-  std::ifstream code(vm_exec_code_path, std::ios::binary);
-  std::stringstream ss;
-  ss << code.rdbuf();
-
-  auto exec_mod = tvm_rt_vm::Executable::Load(ss.str(), lib);
+  auto exec_mod = tvm_rt_vm::Executable::Load(readFile(vm_exec_code_path), lib);
   const tvm_rt_vm::Executable* tmp = exec_mod.as<tvm_rt_vm::Executable>();
   auto exec = tvm_rt::GetObjectPtr<tvm_rt_vm::Executable>(const_cast<tvm_rt_vm::Executable*>(tmp));
   exec->LoadLateBoundConstantsFromFile(consts_path);
@@ -165,10 +178,7 @@ TvmModule TVMSoCompile(const TvmEPOptions& options) {
   auto vm = tvm_rt::make_object<tvm_rt_vm::VirtualMachine>();
   vm->LoadExecutable(exec);
 
-  size_t pos = options.target.find(" ");
-  const std::string dev_type_str = options.target.substr(0, pos);
-  ORT_ENFORCE(!dev_type_str.empty(), "Device was not found in target string");
-  uint64_t dev_type = str2dev_type[dev_type_str];
+  uint64_t dev_type = getDeviceType(target);
   const uint64_t cpu_type = str2dev_type["cpu"];
   // Initialize the VM for the specified device. If the device is not a CPU,
   // We'll need to add a CPU context to drive it.
@@ -201,6 +211,35 @@ TvmModule TVMSoCompile(const TvmEPOptions& options) {
   return TvmModule(vm);
 }
 
+static TvmModule loadGraphExecutor(const std::string& dir, const std::string& target) {
+  const std::string sep = ToUTF8String(PathString{k_preferred_path_separator});
+  TvmModule lib = TvmModule::LoadFromFile(dir + sep + "deploy." + lib_ext);
+  const std::string graph_json = readFile(dir + sep + "deploy.json");
+  const std::string params = readFile(dir + sep + "deploy.params");
+
+  const TvmPackedFunc* create = tvm_rt::Registry::Get("tvm.graph_executor.create");
+  ORT_ENFORCE(create != nullptr, "Unable to retrieve 'tvm.graph_executor.create'.");
+  // TODO(vchernov): multiple devices using and using device with specified id are not supported
+  uint64_t device_id = 0;
+  TvmModule mod = (*create)(graph_json, lib, getDeviceType(target), device_id);
+  TvmPackedFunc load_params = mod.GetFunction("load_params", false);
+  load_params(TVMByteArray{params.data(), params.size()});
+  return mod;
+}
+
+TvmModule TVMSoCompile(const TvmEPOptions& options) {
+  return loadVMExecutable(options.so_folder, options.target);
+}
+
+TvmModule TVMLoadArtifacts(const TvmEPOptions& options, const std::string& artifacts_dir) {
+  if (options.executor == "vm") {
+    return loadVMExecutable(artifacts_dir, options.target);
+  } else if (options.executor == "graph") {
+    return loadGraphExecutor(artifacts_dir, options.target);
+  }
+  ORT_NOT_IMPLEMENTED("Loading of compiled artifacts is not supported for executor ", options.executor);
+}
+
 void TVMSetInputs(TvmModule& mod,
                   std::vector<size_t>& inds,
                   std::vector<DLTensor>& inputs)
@@ -19,8 +19,10 @@ namespace tvm {
                        const std::string& onnx_txt,
                        const std::string& model_path,
                        int opset,
-                       const TVMTensorShapes& input_shapes);
+                       const TVMTensorShapes& input_shapes,
+                       const std::string& artifacts_dir = "");
   TvmModule TVMSoCompile(const TvmEPOptions& options);
+  TvmModule TVMLoadArtifacts(const TvmEPOptions& options, const std::string& artifacts_dir);
 
   void TVMSetInputs(TvmModule& mod, std::vector<size_t>& inds, std::vector<DLTensor>& inputs);
   void TVM_VM_SetInputs(TvmModule& mod, std::vector<size_t>& inds, std::vector<DLTensor>& inputs);
@@ -3,6 +3,9 @@
 
 #include <utility>
 
+#include "core/common/logging/logging.h"
+#include "core/platform/env.h"
+
 #include "tvm_compiler.h"
 #include "tvm_api.h"
 
@@ -24,19 +27,29 @@ auto TVMCompilerBase::operator()(const TvmEPOptions& options,
 
 TVMCompiler::TVMCompiler(std::string&& onnx_model_str,
                          const std::string& model_path,
-                         int opset) :
+                         int opset,
+                         const std::string& artifacts_dir) :
 onnx_model_str_(std::move(onnx_model_str)),
 model_path_(model_path),
-opset_(opset) {
+opset_(opset),
+artifacts_dir_(artifacts_dir) {
 }
 
 void TVMCompiler::compileTVMModule(const TvmEPOptions& options,
                                    const TVMTensorShapes& input_shapes) {
+  if (!artifacts_dir_.empty() && Env::Default().FolderExists(ToPathString(artifacts_dir_))) {
+    LOGS_DEFAULT(INFO) << "Loading compiled TVM module from " << artifacts_dir_;
+    *mod_ = tvm::TVMLoadArtifacts(options, artifacts_dir_);
+    onnx_model_str_.clear();
+    return;
+  }
+
   *mod_ = tvm::TVMCompile(options,
                           onnx_model_str_,
                           model_path_,
                           opset_,
-                          input_shapes);
+                          input_shapes,
+                          artifacts_dir_);
 
   onnx_model_str_.clear();
 }
@@ -35,9 +35,12 @@ class TVMCompiler : public TVMCompilerBase {
   TVMCompiler() = delete;
   ~TVMCompiler() = default;
 
+  // If artifacts_dir is not empty the module is loaded from it when it exists, otherwise the compiled module is
+  // exported there so that following sessions can skip the compilation.
   TVMCompiler(std::string&& onnx_model_str,
               const std::string& model_path,
-              int opset);
+              int opset,
+              const std::string& artifacts_dir = "");
 
   void compileTVMModule(const TvmEPOptions& options,
                         const TVMTensorShapes& input_shapes) final;
@@ -46,6 +49,7 @@ class TVMCompiler : public TVMCompilerBase {
   std::string onnx_model_str_;
   std::string model_path_;
   int opset_;
+  std::string artifacts_dir_;
 };
 
 class TVMSoCompiler : public TVMCompilerBase {
@@ -17,6 +17,7 @@ namespace tvm {
 namespace provider_option_names {
 constexpr const char* kExecutor = "executor";
 constexpr const char* kSoFolder = "so_folder";
+constexpr const char* kArtifactsFolder = "artifacts_folder";
 constexpr const char* kCheckHash = "check_hash";
 constexpr const char* kHashFilePath = "hash_file_path";
 constexpr const char* kTarget = "target";
@@ -32,6 +33,7 @@ constexpr const char* kInputShapes = "input_shapes";
 static const std::unordered_set<std::string> valid_keys {
   std::string{kExecutor},
   std::string{kSoFolder},
+  std::string{kArtifactsFolder},
   std::string{kCheckHash},
   std::string{kHashFilePath},
   std::string{kTarget},
@@ -118,6 +120,7 @@ TvmEPOptions TvmEPOptionsHelper::FromProviderOptions(const ProviderOptions& pr_o
     ProviderOptionsParser{}
       .AddAssignmentToReference(tvm::provider_option_names::kExecutor, options.executor)
       .AddAssignmentToReference(tvm::provider_option_names::kSoFolder, options.so_folder)
+      .AddAssignmentToReference(tvm::provider_option_names::kArtifactsFolder, options.artifacts_folder)
       .AddAssignmentToReference(tvm::provider_option_names::kCheckHash, options.check_hash)
       .AddAssignmentToReference(tvm::provider_option_names::kHashFilePath, options.hash_file_path)
       .AddAssignmentToReference(tvm::provider_option_names::kTarget, options.target)
@@ -255,6 +258,7 @@ std::ostream& operator<<(std::ostream& out, const TvmEPOptions& options) {
   out << "TVM EP options:\n" <<
   "executor type: " << options.executor << "\n" <<
   "so_folder: " << options.so_folder << "\n" <<
+  "artifacts_folder: " << options.artifacts_folder << "\n" <<
   "check_hash: " << options.check_hash << "\n" <<
   "hash_file_path: " << options.hash_file_path << "\n" <<
   "target: " << options.target << "\n" <<
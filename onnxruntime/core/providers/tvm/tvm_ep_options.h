@@ -34,6 +34,7 @@ using InputsInfoMap = std::unordered_map<size_t, TensorShapeVector>;
 struct TvmEPOptions {
   std::string executor{tvm::default_executor_type};
   std::string so_folder{""};
+  std::string artifacts_folder{""};
   bool check_hash = false;
   std::string hash_file_path{""};
   std::string target{tvm::default_target_str};
@@ -2,14 +2,18 @@
 // Licensed under the MIT License.
 
 #include <fstream>
+#include <iomanip>
 #include <map>
+#include <sstream>
 #include <utility>
 
 #include "core/common/common.h"
+#include "core/common/path.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/kernel_registry.h"
 #include "core/framework/compute_capability.h"
+#include "core/framework/murmurhash3.h"
 #include "core/graph/graph_proto_serializer.h"
 #include "core/platform/env.h"
 #include "core/graph/model.h"
@@ -123,9 +127,11 @@ common::Status TvmExecutionProvider::Compile(const std::vector<FusedNodeAndGraph
 
     std::string onnx_model_str;
     model_proto.SerializeToString(&onnx_model_str);
+    const std::string artifacts_dir = getArtifactsDir(onnx_model_str);
     compilers_[func_name] = std::make_shared<TVMCompiler>(std::move(onnx_model_str),
                               ToUTF8String(fused_node.ModelPath().ToPathString()),
-                              int(opset->version()));
+                              int(opset->version()),
+                              artifacts_dir);
     InputsInfoMap all_input_shapes;
     auto mod = compileModel(func_name, graph_body_viewer, all_input_shapes);
 
@@ -168,6 +174,30 @@ void TvmExecutionProvider::printOptions() {
   LOGS(*GetLogger(), INFO) << options_;
 }
 
+// Compiled artifacts are keyed by the subgraph and the options which affect its compilation.
+// The tuning log is not part of the key, so that hosts without it can load artifacts tuned offline.
+std::string TvmExecutionProvider::getArtifactsDir(const std::string& onnx_model_str) const {
+  if (options_.artifacts_folder.empty()) {
+    return "";
+  }
+
+  std::stringstream key;
+  key << onnx_model_str << options_.executor << "|" << options_.target << "|" << options_.target_host << "|" <<
+    options_.opt_level << "|" << options_.freeze_weights << "|" << options_.to_nhwc << "|" <<
+    options_.input_names_str << "|" << options_.input_shapes_str;
+  const std::string key_str = key.str();
+  uint32_t hash[4] = {0, 0, 0, 0};
+  MurmurHash3::x86_128(key_str.data(), int(key_str.size()), hash[0], &hash);
+
+  std::stringstream dir;
+  dir << options_.artifacts_folder << ToUTF8String(PathString{k_preferred_path_separator}) <<
+    std::hex << std::setfill('0');
+  for (auto h : hash) {
+    dir << std::setw(8) << h;
+  }
+  return dir.str();
+}
+
 std::shared_ptr<TvmModule> TvmExecutionProvider::compileModel(const std::string& func_name,
                                                               const GraphViewer& graph_viewer,
                                                               InputsInfoMap& all_input_shapes) {
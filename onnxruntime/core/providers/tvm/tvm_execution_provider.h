@@ -43,6 +43,7 @@ class TvmExecutionProvider : public IExecutionProvider {
 
  private:
   void printOptions();
+  std::string getArtifactsDir(const std::string& onnx_model_str) const;
   std::shared_ptr<TvmModule> compileModel(const std::string& func_name,
                                           const GraphViewer& graph_viewer,
                                           InputsInfoMap& inputs_info);    // NOLINT
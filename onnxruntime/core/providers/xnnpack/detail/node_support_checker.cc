@@ -18,6 +18,7 @@
 #include "core/providers/xnnpack/nn/conv.h"
 #include "core/providers/xnnpack/nn/conv_transpose.h"
 #include "core/providers/xnnpack/nn/max_pool.h"
+#include "core/providers/xnnpack/math/elementwise.h"
 #include "core/providers/xnnpack/math/gemm.h"
 #include "core/providers/xnnpack/math/matmul.h"
 #include "core/providers/xnnpack/nn/average_pool.h"
@@ -100,6 +101,9 @@ bool NodeSupportChecker::IsNodeSupported(const NodeUnit& nodeunit) {
       {"Resize", Resize::IsOnnxNodeSupported},
       {"Gemm", Gemm::IsOnnxNodeSupported},
       {"MatMul", MatMul::IsOnnxNodeSupported},
+      {"Add", BinaryElementwise::IsOnnxNodeSupported},
+      {"Mul", BinaryElementwise::IsOnnxNodeSupported},
+      {"Sigmoid", Sigmoid::IsOnnxNodeSupported},
   };
 
   bool supported = false;
@@ -0,0 +1,283 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Implementation of the pthreadpool API on top of onnxruntime::concurrency::ThreadPool.
+// It's built as the "pthreadpool" library XNNPACK links against when onnxruntime_XNNPACK_USE_ORT_THREADPOOL
+// is ON, instead of the upstream pthreadpool implementation.
+
+#include "core/providers/xnnpack/detail/ort_pthreadpool.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include <pthreadpool.h>
+
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+
+using onnxruntime::concurrency::ThreadPool;
+
+namespace {
+
+size_t DivideRoundUp(size_t n, size_t q) {
+  return n / q + (n % q != 0 ? 1 : 0);
+}
+
+// Run fn(start, size) for every tile of the N-dimensional range. Dimensions that are not tiled use a tile of 1,
+// in which case start[d] is the index along that dimension. pthreadpool has no ordering guarantees either, so
+// tiles are claimed dynamically by the threads of the pool.
+template <size_t N, typename F>
+void ParallelizeTiled(pthreadpool_t threadpool, const std::array<size_t, N>& range,
+                      const std::array<size_t, N>& tile, F&& fn) {
+  std::array<size_t, N> tile_count;
+  size_t total = 1;
+  for (size_t d = 0; d < N; ++d) {
+    tile_count[d] = DivideRoundUp(range[d], tile[d]);
+    total *= tile_count[d];
+  }
+  if (total == 0) {
+    return;
+  }
+
+  ThreadPool* tp = threadpool ? threadpool->ort_thread_pool : nullptr;
+  ThreadPool::TrySimpleParallelFor(tp, static_cast<std::ptrdiff_t>(total), [&](std::ptrdiff_t linear) {
+    std::array<size_t, N> start;
+    std::array<size_t, N> size;
+    size_t remaining = static_cast<size_t>(linear);
+    for (size_t d = N; d-- > 0;) {
+      start[d] = (remaining % tile_count[d]) * tile[d];
+      size[d] = std::min(tile[d], range[d] - start[d]);
+      remaining /= tile_count[d];
+    }
+    fn(start, size);
+  });
+}
+
+}  // namespace
+
+extern "C" {
+
+pthreadpool_t pthreadpool_create(size_t threads_count) {
+  if (threads_count == 0) {
+    threads_count = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  }
+  auto* threadpool = new pthreadpool();
+  if (threads_count > 1) {
+    threadpool->ort_thread_pool = new ThreadPool(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions(),
+                                                 ORT_TSTR("xnnpack"), static_cast<int>(threads_count), true);
+    threadpool->owns_thread_pool = true;
+  }
+  return threadpool;
+}
+
+size_t pthreadpool_get_threads_count(pthreadpool_t threadpool) {
+  if (threadpool == nullptr) {
+    return 1;
+  }
+  return static_cast<size_t>(ThreadPool::DegreeOfParallelism(threadpool->ort_thread_pool));
+}
+
+void pthreadpool_destroy(pthreadpool_t threadpool) {
+  if (threadpool == nullptr) {
+    return;
+  }
+  if (threadpool->owns_thread_pool) {
+    delete threadpool->ort_thread_pool;
+  }
+  delete threadpool;
+}
+
+// The flags (PTHREADPOOL_FLAG_DISABLE_DENORMALS, PTHREADPOOL_FLAG_YIELD_WORKERS) are hints and are ignored:
+// denormal handling and spinning are controlled by the ORT session options instead.
+
+void pthreadpool_parallelize_1d(pthreadpool_t threadpool, pthreadpool_task_1d_t function, void* context,
+                                size_t range, uint32_t /*flags*/) {
+  ParallelizeTiled<1>(threadpool, {range}, {1}, [&](const auto& start, const auto&) {
+    function(context, start[0]);
+  });
+}
+
+void pthreadpool_parallelize_1d_with_uarch(pthreadpool_t threadpool, pthreadpool_task_1d_with_id_t function,
+                                           void* context, uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                           size_t range, uint32_t /*flags*/) {
+  // Without cpuinfo's per-core micro-architecture detection, every thread runs the default variant,
+  // which is what pthreadpool does on platforms it cannot query either.
+  ParallelizeTiled<1>(threadpool, {range}, {1}, [&](const auto& start, const auto&) {
+    function(context, default_uarch_index, start[0]);
+  });
+}
+
+void pthreadpool_parallelize_1d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_1d_tile_1d_t function,
+                                        void* context, size_t range, size_t tile, uint32_t /*flags*/) {
+  ParallelizeTiled<1>(threadpool, {range}, {tile}, [&](const auto& start, const auto& size) {
+    function(context, start[0], size[0]);
+  });
+}
+
+void pthreadpool_parallelize_2d(pthreadpool_t threadpool, pthreadpool_task_2d_t function, void* context,
+                                size_t range_i, size_t range_j, uint32_t /*flags*/) {
+  ParallelizeTiled<2>(threadpool, {range_i, range_j}, {1, 1}, [&](const auto& start, const auto&) {
+    function(context, start[0], start[1]);
+  });
+}
+
+void pthreadpool_parallelize_2d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_2d_tile_1d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t tile_j,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiled<2>(threadpool, {range_i, range_j}, {1, tile_j}, [&](const auto& start, const auto& size) {
+    function(context, start[0], start[1], size[1]);
+  });
+}
+
+void pthreadpool_parallelize_2d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_2d_tile_2d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t tile_i, size_t tile_j,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiled<2>(threadpool, {range_i, range_j}, {tile_i, tile_j}, [&](const auto& start, const auto& size) {
+    function(context, start[0], start[1], size[0], size[1]);
+  });
+}
+
+void pthreadpool_parallelize_2d_tile_2d_with_uarch(pthreadpool_t threadpool,
+                                                   pthreadpool_task_2d_tile_2d_with_id_t function, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t tile_i, size_t tile_j,
+                                                   uint32_t /*flags*/) {
+  ParallelizeTiled<2>(threadpool, {range_i, range_j}, {tile_i, tile_j}, [&](const auto& start, const auto& size) {
+    function(context, default_uarch_index, start[0], start[1], size[0], size[1]);
+  });
+}
+
+void pthreadpool_parallelize_3d(pthreadpool_t threadpool, pthreadpool_task_3d_t function, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, uint32_t /*flags*/) {
+  ParallelizeTiled<3>(threadpool, {range_i, range_j, range_k}, {1, 1, 1}, [&](const auto& start, const auto&) {
+    function(context, start[0], start[1], start[2]);
+  });
+}
+
+void pthreadpool_parallelize_3d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_3d_tile_1d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t tile_k,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiled<3>(threadpool, {range_i, range_j, range_k}, {1, 1, tile_k},
+                      [&](const auto& start, const auto& size) {
+                        function(context, start[0], start[1], start[2], size[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_3d_tile_2d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t tile_j,
+                                        size_t tile_k, uint32_t /*flags*/) {
+  ParallelizeTiled<3>(threadpool, {range_i, range_j, range_k}, {1, tile_j, tile_k},
+                      [&](const auto& start, const auto& size) {
+                        function(context, start[0], start[1], start[2], size[1], size[2]);
+                      });
+}
+
+void pthreadpool_parallelize_3d_tile_2d_with_uarch(pthreadpool_t threadpool,
+                                                   pthreadpool_task_3d_tile_2d_with_id_t function, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t range_k, size_t tile_j,
+                                                   size_t tile_k, uint32_t /*flags*/) {
+  ParallelizeTiled<3>(threadpool, {range_i, range_j, range_k}, {1, tile_j, tile_k},
+                      [&](const auto& start, const auto& size) {
+                        function(context, default_uarch_index, start[0], start[1], start[2], size[1], size[2]);
+                      });
+}
+
+void pthreadpool_parallelize_4d(pthreadpool_t threadpool, pthreadpool_task_4d_t function, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, size_t range_l, uint32_t /*flags*/) {
+  ParallelizeTiled<4>(threadpool, {range_i, range_j, range_k, range_l}, {1, 1, 1, 1},
+                      [&](const auto& start, const auto&) {
+                        function(context, start[0], start[1], start[2], start[3]);
+                      });
+}
+
+void pthreadpool_parallelize_4d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_4d_tile_1d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t tile_l, uint32_t /*flags*/) {
+  ParallelizeTiled<4>(threadpool, {range_i, range_j, range_k, range_l}, {1, 1, 1, tile_l},
+                      [&](const auto& start, const auto& size) {
+                        function(context, start[0], start[1], start[2], start[3], size[3]);
+                      });
+}
+
+void pthreadpool_parallelize_4d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_4d_tile_2d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t tile_k, size_t tile_l, uint32_t /*flags*/) {
+  ParallelizeTiled<4>(threadpool, {range_i, range_j, range_k, range_l}, {1, 1, tile_k, tile_l},
+                      [&](const auto& start, const auto& size) {
+                        function(context, start[0], start[1], start[2], start[3], size[2], size[3]);
+                      });
+}
+
+void pthreadpool_parallelize_4d_tile_2d_with_uarch(pthreadpool_t threadpool,
+                                                   pthreadpool_task_4d_tile_2d_with_id_t function, void* context,
+                                                   uint32_t default_uarch_index, uint32_t /*max_uarch_index*/,
+                                                   size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                                   size_t tile_k, size_t tile_l, uint32_t /*flags*/) {
+  ParallelizeTiled<4>(threadpool, {range_i, range_j, range_k, range_l}, {1, 1, tile_k, tile_l},
+                      [&](const auto& start, const auto& size) {
+                        function(context, default_uarch_index, start[0], start[1], start[2], start[3],
+                                 size[2], size[3]);
+                      });
+}
+
+void pthreadpool_parallelize_5d(pthreadpool_t threadpool, pthreadpool_task_5d_t function, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, size_t range_l, size_t range_m,
+                                uint32_t /*flags*/) {
+  ParallelizeTiled<5>(threadpool, {range_i, range_j, range_k, range_l, range_m}, {1, 1, 1, 1, 1},
+                      [&](const auto& start, const auto&) {
+                        function(context, start[0], start[1], start[2], start[3], start[4]);
+                      });
+}
+
+void pthreadpool_parallelize_5d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_5d_tile_1d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t tile_m, uint32_t /*flags*/) {
+  ParallelizeTiled<5>(threadpool, {range_i, range_j, range_k, range_l, range_m}, {1, 1, 1, 1, tile_m},
+                      [&](const auto& start, const auto& size) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], size[4]);
+                      });
+}
+
+void pthreadpool_parallelize_5d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_5d_tile_2d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t tile_l, size_t tile_m, uint32_t /*flags*/) {
+  ParallelizeTiled<5>(threadpool, {range_i, range_j, range_k, range_l, range_m}, {1, 1, 1, tile_l, tile_m},
+                      [&](const auto& start, const auto& size) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], size[3], size[4]);
+                      });
+}
+
+void pthreadpool_parallelize_6d(pthreadpool_t threadpool, pthreadpool_task_6d_t function, void* context,
+                                size_t range_i, size_t range_j, size_t range_k, size_t range_l, size_t range_m,
+                                size_t range_n, uint32_t /*flags*/) {
+  ParallelizeTiled<6>(threadpool, {range_i, range_j, range_k, range_l, range_m, range_n}, {1, 1, 1, 1, 1, 1},
+                      [&](const auto& start, const auto&) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], start[5]);
+                      });
+}
+
+void pthreadpool_parallelize_6d_tile_1d(pthreadpool_t threadpool, pthreadpool_task_6d_tile_1d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t range_n, size_t tile_n, uint32_t /*flags*/) {
+  ParallelizeTiled<6>(threadpool, {range_i, range_j, range_k, range_l, range_m, range_n}, {1, 1, 1, 1, 1, tile_n},
+                      [&](const auto& start, const auto& size) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], start[5], size[5]);
+                      });
+}
+
+void pthreadpool_parallelize_6d_tile_2d(pthreadpool_t threadpool, pthreadpool_task_6d_tile_2d_t function,
+                                        void* context, size_t range_i, size_t range_j, size_t range_k, size_t range_l,
+                                        size_t range_m, size_t range_n, size_t tile_m, size_t tile_n,
+                                        uint32_t /*flags*/) {
+  ParallelizeTiled<6>(threadpool, {range_i, range_j, range_k, range_l, range_m, range_n},
+                      {1, 1, 1, 1, tile_m, tile_n}, [&](const auto& start, const auto& size) {
+                        function(context, start[0], start[1], start[2], start[3], start[4], start[5],
+                                 size[4], size[5]);
+                      });
+}
+
+}  // extern "C"
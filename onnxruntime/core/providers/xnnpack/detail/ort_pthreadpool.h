@@ -0,0 +1,21 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+namespace onnxruntime {
+namespace concurrency {
+class ThreadPool;
+}  // namespace concurrency
+}  // namespace onnxruntime
+
+// When building with onnxruntime_XNNPACK_USE_ORT_THREADPOOL, the pthreadpool library XNNPACK links
+// against is replaced by ort_pthreadpool.cc, which runs XNNPACK's parallel work on an ORT thread pool.
+// A pthreadpool_t is then a thin handle over that thread pool, so XNNPACK kernels and CPU EP kernels
+// share the session's intra-op threads.
+struct pthreadpool {
+  // Thread pool to run on. nullptr runs everything on the calling thread.
+  onnxruntime::concurrency::ThreadPool* ort_thread_pool{nullptr};
+  // True if ort_thread_pool was created by pthreadpool_create and is deleted by pthreadpool_destroy.
+  bool owns_thread_pool{false};
+};
@@ -0,0 +1,196 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/xnnpack/math/elementwise.h"
+
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "core/framework/op_kernel.h"
+
+namespace onnxruntime {
+namespace xnnpack {
+namespace {
+bool IsFloatTensor(const NodeArg& arg) {
+  const auto* type = arg.TypeAsProto();
+  return type != nullptr && type->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT;
+}
+
+Status ComputeBroadcastOutputShape(const std::string& node_name, const TensorShape& lhs_shape,
+                                   const TensorShape& rhs_shape, TensorShape& out_shape) {
+  size_t lhs_rank = lhs_shape.NumDimensions();
+  size_t rhs_rank = rhs_shape.NumDimensions();
+  size_t out_rank = std::max(lhs_rank, rhs_rank);
+
+  std::vector<int64_t> output_dims(out_rank, 0);
+  for (size_t i = 0; i < out_rank; ++i) {
+    int64_t lhs_dim = i < lhs_rank ? lhs_shape[lhs_rank - 1 - i] : 1;
+    int64_t rhs_dim = i < rhs_rank ? rhs_shape[rhs_rank - 1 - i] : 1;
+    int64_t out_dim = std::min(lhs_dim, rhs_dim) == 0 ? 0 : std::max(lhs_dim, rhs_dim);  // a dim value of 0 wins
+    if ((lhs_dim != out_dim && lhs_dim != 1) || (rhs_dim != out_dim && rhs_dim != 1)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, node_name, ": cannot broadcast on dim ",
+                             out_rank - 1 - i, " LeftShape: ", lhs_shape.ToString(),
+                             ", RightShape: ", rhs_shape.ToString());
+    }
+    output_dims[out_rank - 1 - i] = out_dim;
+  }
+  out_shape = TensorShape(output_dims);
+  return Status::OK();
+}
+}  // namespace
+
+bool BinaryElementwise::IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& /*graph*/) {
+  bool supported = false;
+  // use do {} while(false) so it's easier to set a breakpoint on the return
+  do {
+    // QDQ Add/Mul is not supported yet
+    if (node_unit.UnitType() != NodeUnit::Type::SingleNode) {
+      break;
+    }
+
+    const auto& inputs = node_unit.Inputs();
+    if (inputs.size() != 2 || !IsFloatTensor(inputs[0].node_arg) || !IsFloatTensor(inputs[1].node_arg)) {
+      break;
+    }
+
+    // xnnpack broadcasts up to XNN_MAX_TENSOR_DIMS dims. the rank has to be known so we can check that here.
+    const auto* a_shape = inputs[0].node_arg.Shape();
+    const auto* b_shape = inputs[1].node_arg.Shape();
+    if (a_shape == nullptr || b_shape == nullptr ||
+        a_shape->dim_size() > XNN_MAX_TENSOR_DIMS || b_shape->dim_size() > XNN_MAX_TENSOR_DIMS) {
+      break;
+    }
+
+    supported = true;
+  } while (false);
+
+  return supported;
+}
+
+BinaryElementwise::BinaryElementwise(const OpKernelInfo& info) : XnnpackKernel{info} {
+  const auto& op_type = info.node().OpType();
+  if (op_type == "Add") {
+    op_type_ = OpType::Add;
+  } else if (op_type == "Mul") {
+    op_type_ = OpType::Mul;
+  } else {
+    ORT_THROW("unsupported elementwise op in xnnpack EP: ", op_type);
+  }
+
+  const float output_min = -std::numeric_limits<float>::infinity();
+  const float output_max = std::numeric_limits<float>::infinity();
+  struct xnn_operator* p = nullptr;
+  xnn_status status = op_type_ == OpType::Add
+                          ? xnn_create_add_nd_f32(output_min, output_max, 0, &p)
+                          : xnn_create_multiply_nd_f32(output_min, output_max, 0, &p);
+  ORT_ENFORCE(status == xnn_status_success, "xnn_create_", op_type, "_nd_f32 failed. Status:", status);
+  op0_.reset(p);
+}
+
+Status BinaryElementwise::Compute(OpKernelContext* ctx) const {
+  const auto* A = ctx->Input<Tensor>(0);
+  const auto* B = ctx->Input<Tensor>(1);
+
+  TensorShape output_shape;
+  ORT_RETURN_IF_ERROR(ComputeBroadcastOutputShape(Node().Name(), A->Shape(), B->Shape(), output_shape));
+  auto* Y = ctx->Output(0, output_shape);
+
+  // edge case. one or more dims with value of 0. nothing to do
+  if (output_shape.Size() == 0) {
+    return Status::OK();
+  }
+
+  // xnnpack expects the dims as size_t
+  auto to_dims = [](const TensorShape& shape) {
+    const auto dims = shape.GetDims();
+    return std::vector<size_t>(dims.begin(), dims.end());
+  };
+  const auto a_dims = to_dims(A->Shape());
+  const auto b_dims = to_dims(B->Shape());
+
+  pthreadpool_t t_pool = GetThreadPool(ctx);
+  xnn_status status = xnn_status_invalid_state;
+  if (op_type_ == OpType::Add) {
+    status = xnn_setup_add_nd_f32(op0_.get(), a_dims.size(), a_dims.data(), b_dims.size(), b_dims.data(),
+                                  A->Data<float>(), B->Data<float>(), Y->MutableData<float>(), t_pool);
+  } else {
+    status = xnn_setup_multiply_nd_f32(op0_.get(), a_dims.size(), a_dims.data(), b_dims.size(), b_dims.data(),
+                                       A->Data<float>(), B->Data<float>(), Y->MutableData<float>(), t_pool);
+  }
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_setup_", Node().OpType(), "_nd_f32 returned ", status);
+  }
+
+  status = xnn_run_operator(op0_.get(), t_pool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_run_operator returned ", status);
+  }
+  return Status::OK();
+}
+
+bool Sigmoid::IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& /*graph*/) {
+  return node_unit.UnitType() == NodeUnit::Type::SingleNode && IsFloatTensor(node_unit.Inputs()[0].node_arg);
+}
+
+Sigmoid::Sigmoid(const OpKernelInfo& info) : XnnpackKernel{info} {
+  // a single channel with unit strides. xnnpack treats the input as one contiguous range when the channel count
+  // matches the strides, so the batch size is simply the element count.
+  struct xnn_operator* p = nullptr;
+  xnn_status status = xnn_create_sigmoid_nc_f32(1, 1, 1, 0, &p);
+  ORT_ENFORCE(status == xnn_status_success, "xnn_create_sigmoid_nc_f32 failed. Status:", status);
+  op0_.reset(p);
+}
+
+Status Sigmoid::Compute(OpKernelContext* ctx) const {
+  const auto* X = ctx->Input<Tensor>(0);
+  auto* Y = ctx->Output(0, X->Shape());
+
+  const size_t N = gsl::narrow<size_t>(X->Shape().Size());
+  if (N == 0) {
+    return Status::OK();
+  }
+
+  pthreadpool_t t_pool = GetThreadPool(ctx);
+  xnn_status status = xnn_setup_sigmoid_nc_f32(op0_.get(), N, X->Data<float>(), Y->MutableData<float>(), t_pool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_setup_sigmoid_nc_f32 returned ", status);
+  }
+
+  status = xnn_run_operator(op0_.get(), t_pool);
+  if (status != xnn_status_success) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "xnn_run_operator returned ", status);
+  }
+  return Status::OK();
+}
+
+ONNX_OPERATOR_VERSIONED_KERNEL_EX(Add, kOnnxDomain, 7, 12, kXnnpackExecutionProvider,
+                                  KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+                                  BinaryElementwise);
+ONNX_OPERATOR_VERSIONED_KERNEL_EX(Add, kOnnxDomain, 13, 13, kXnnpackExecutionProvider,
+                                  KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+                                  BinaryElementwise);
+ONNX_OPERATOR_KERNEL_EX(Add, kOnnxDomain, 14, kXnnpackExecutionProvider,
+                        KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+                        BinaryElementwise);
+
+ONNX_OPERATOR_VERSIONED_KERNEL_EX(Mul, kOnnxDomain, 7, 12, kXnnpackExecutionProvider,
+                                  KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+                                  BinaryElementwise);
+ONNX_OPERATOR_VERSIONED_KERNEL_EX(Mul, kOnnxDomain, 13, 13, kXnnpackExecutionProvider,
+                                  KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+                                  BinaryElementwise);
+ONNX_OPERATOR_KERNEL_EX(Mul, kOnnxDomain, 14, kXnnpackExecutionProvider,
+                        KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+                        BinaryElementwise);
+
+ONNX_OPERATOR_VERSIONED_KERNEL_EX(Sigmoid, kOnnxDomain, 6, 12, kXnnpackExecutionProvider,
+                                  KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+                                  Sigmoid);
+ONNX_OPERATOR_KERNEL_EX(Sigmoid, kOnnxDomain, 13, kXnnpackExecutionProvider,
+                        KernelDefBuilder().TypeConstraint("T", DataTypeImpl::GetTensorType<float>()),
+                        Sigmoid);
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
@@ -0,0 +1,46 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/providers/xnnpack/xnnpack_kernel.h"
+#include "core/framework/allocator.h"
+#include "core/providers/xnnpack/detail/utils.h"
+
+namespace onnxruntime {
+class GraphViewer;
+namespace xnnpack {
+
+// fp32 Add and Mul with numpy style broadcasting. The input shapes are passed to xnnpack at Compute time so they can
+// change between runs.
+class BinaryElementwise final : public XnnpackKernel {
+ public:
+  BinaryElementwise(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* ctx) const override;
+  static bool IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& graph);
+
+ private:
+  enum class OpType {
+    Add,
+    Mul,
+  };
+
+  OpType op_type_;
+  XnnpackOperator op0_;
+};
+
+// fp32 Sigmoid. The input is treated as a flat buffer so the shape does not have to be known up front.
+class Sigmoid final : public XnnpackKernel {
+ public:
+  Sigmoid(const OpKernelInfo& info);
+
+  Status Compute(OpKernelContext* ctx) const override;
+  static bool IsOnnxNodeSupported(const NodeUnit& node_unit, const GraphViewer& graph);
+
+ private:
+  XnnpackOperator op0_;
+};
+
+}  // namespace xnnpack
+}  // namespace onnxruntime
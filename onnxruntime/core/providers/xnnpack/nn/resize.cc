@@ -251,7 +251,7 @@ Status Resize::ComputeInternal(OpKernelContext* ctx, const Tensor* input,
   auto W = is_NHWC_ ? X_shape[2] : X_shape[3];
   Tensor* output = ctx->Output(0, TensorShape(output_dims));
 
-  pthreadpool_t t_pool = GetThreadPool();
+  pthreadpool_t t_pool = GetThreadPool(ctx);
   xnn_status status = xnn_status_invalid_state;
   if (op_type_ == OpComputeType::op_compute_type_fp32) {
     auto oH = is_NHWC_ ? output_dims[1] : output_dims[2];
@@ -5,7 +5,11 @@
 #include "core/framework/op_kernel.h"
 #include "core/providers/xnnpack/xnnpack_execution_provider.h"
 
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+#include "core/providers/xnnpack/detail/ort_pthreadpool.h"
+#else
 struct pthreadpool;
+#endif
 
 namespace onnxruntime {
 namespace xnnpack {
@@ -18,12 +22,24 @@ class XnnpackKernel : public OpKernel {
             static_cast<const XnnpackExecutionProvider*>(info.GetExecutionProvider())
                 ->GetPrivateThreadPool()) {
   }
-  [[nodiscard]] pthreadpool* GetThreadPool() const {
+  // Thread pool to pass to xnn_setup_* and xnn_run_operator while computing with "context".
+  [[nodiscard]] pthreadpool* GetThreadPool(OpKernelContext* context) const {
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+    // Run on the session's intra-op threads. The EP does not support concurrent runs,
+    // so a single handle per kernel is enough.
+    ort_threadpool_.ort_thread_pool = context->GetOperatorThreadPool();
+    return &ort_threadpool_;
+#else
+    ORT_UNUSED_PARAMETER(context);
     return xnnpack_threadpool_;
+#endif
   }
 
  private:
   pthreadpool* xnnpack_threadpool_;
+#if defined(XNNPACK_USE_ORT_THREADPOOL)
+  mutable pthreadpool ort_threadpool_;
+#endif
 };
 }  // namespace xnnpack
 }  // namespace onnxruntime
@@ -5,9 +5,16 @@
 #include "core/session/inference_session.h"
 #include "core/session/ort_env.h"
 #include "core/session/ort_apis.h"
+#include "core/framework/bfc_arena.h"
 #include "core/framework/error_code_helper.h"
 
 namespace onnxruntime {
+namespace {
+const OrtMemoryInfo* ORT_API_CALL WrappedIAllocatorInfo(const OrtAllocator* this_) {
+  return static_cast<const OrtAllocatorImplWrappingIAllocator*>(this_)->Info();
+}
+}  // namespace
+
 OrtAllocatorImplWrappingIAllocator::OrtAllocatorImplWrappingIAllocator(onnxruntime::AllocatorPtr&& i_allocator)
     : i_allocator_(std::move(i_allocator)) {
   OrtAllocator::version = ORT_API_VERSION;
@@ -15,8 +22,14 @@ OrtAllocatorImplWrappingIAllocator::OrtAllocatorImplWrappingIAllocator(onnxrunti
       [](OrtAllocator* this_, size_t size) { return static_cast<OrtAllocatorImplWrappingIAllocator*>(this_)->Alloc(size); };
   OrtAllocator::Free =
       [](OrtAllocator* this_, void* p) { static_cast<OrtAllocatorImplWrappingIAllocator*>(this_)->Free(p); };
-  OrtAllocator::Info =
-      [](const OrtAllocator* this_) { return static_cast<const OrtAllocatorImplWrappingIAllocator*>(this_)->Info(); };
+  OrtAllocator::Info = &WrappedIAllocatorInfo;
+}
+
+const OrtAllocatorImplWrappingIAllocator* OrtAllocatorImplWrappingIAllocator::FromOrtAllocator(
+    const OrtAllocator* ort_allocator) {
+  return ort_allocator->Info == &WrappedIAllocatorInfo
+             ? static_cast<const OrtAllocatorImplWrappingIAllocator*>(ort_allocator)
+             : nullptr;
 }
 
 void* OrtAllocatorImplWrappingIAllocator::Alloc(size_t size) {
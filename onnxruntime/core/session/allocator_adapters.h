@@ -32,6 +32,11 @@ struct OrtAllocatorImplWrappingIAllocator final : public OrtAllocatorImpl {
 
   onnxruntime::AllocatorPtr GetWrappedIAllocator();
 
+  // Returns ort_allocator if it is an OrtAllocatorImplWrappingIAllocator, nullptr if it is implemented by the user.
+  static const OrtAllocatorImplWrappingIAllocator* FromOrtAllocator(const OrtAllocator* ort_allocator);
+
+  const onnxruntime::AllocatorPtr& WrappedIAllocator() const { return i_allocator_; }
+
  private:
   onnxruntime::AllocatorPtr i_allocator_;
 };
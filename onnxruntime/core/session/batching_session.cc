@@ -0,0 +1,305 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/batching_session.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "core/common/narrow.h"
+#include "core/common/safeint.h"
+#include "core/framework/tensor.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Copies `count` elements of a tensor with the given element type.
+void CopyElements(const Tensor& src, size_t src_offset, Tensor& dst, size_t dst_offset, size_t count) {
+  if (src.IsDataTypeString()) {
+    const auto* src_data = src.Data<std::string>() + src_offset;
+    std::copy(src_data, src_data + count, dst.MutableData<std::string>() + dst_offset);
+  } else {
+    const size_t element_size = src.DataType()->Size();
+    std::memcpy(static_cast<char*>(dst.MutableDataRaw()) + dst_offset * element_size,
+                static_cast<const char*>(src.DataRaw()) + src_offset * element_size, count * element_size);
+  }
+}
+
+// Copies `src` into the rows of `dst` starting at `row_offset`. The dims of `dst` after dim 0 are at least as
+// large as those of `src`; the elements of `dst` past the extent of `src` are left untouched.
+void CopyIntoBatch(const Tensor& src, Tensor& dst, int64_t row_offset) {
+  const auto src_dims = src.Shape().GetDims();
+  const auto dst_dims = dst.Shape().GetDims();
+  const size_t rank = src_dims.size();
+
+  const int64_t dst_row_size = dst.Shape().SizeFromDimension(1);
+  if (std::equal(src_dims.begin() + 1, src_dims.end(), dst_dims.begin() + 1)) {
+    CopyElements(src, 0, dst, narrow<size_t>(row_offset * dst_row_size), narrow<size_t>(src.Shape().Size()));
+    return;
+  }
+
+  // Copy the innermost dim of the source one block at a time.
+  const int64_t block_size = src_dims[rank - 1];
+  const int64_t num_blocks = src.Shape().SizeToDimension(rank - 1);
+  for (int64_t block = 0; block < num_blocks; ++block) {
+    int64_t remaining = block;
+    int64_t dst_offset = 0;
+    int64_t dst_stride = dst_dims[rank - 1];
+    for (size_t d = rank - 1; d-- > 0;) {
+      int64_t index = remaining % src_dims[d];
+      remaining /= src_dims[d];
+      if (d == 0) {
+        index += row_offset;
+      }
+      dst_offset += index * dst_stride;
+      dst_stride *= dst_dims[d];
+    }
+    CopyElements(src, narrow<size_t>(block * block_size), dst, narrow<size_t>(dst_offset),
+                 narrow<size_t>(block_size));
+  }
+}
+
+}  // namespace
+
+BatchingSession::BatchingSession(InferenceSession& session, const BatchingSessionOptions& options)
+    : session_(session), options_(options), cpu_allocator_(std::make_shared<CPUAllocator>()) {
+  ORT_ENFORCE(options_.max_batch_size > 0, "max_batch_size must be positive. Got ", options_.max_batch_size);
+  ORT_ENFORCE(options_.max_queue_delay.count() >= 0, "max_queue_delay must not be negative.");
+  dispatcher_ = std::thread([this]() { DispatchLoop(); });
+}
+
+BatchingSession::~BatchingSession() {
+  {
+    std::lock_guard<OrtMutex> lock(queue_mutex_);
+    shutdown_ = true;
+  }
+  queue_cv_.notify_all();
+  dispatcher_.join();
+}
+
+common::Status BatchingSession::ValidateRequest(gsl::span<const std::string> feed_names,
+                                                gsl::span<const OrtValue> feeds, int64_t& rows) {
+  ORT_RETURN_IF_NOT(feed_names.size() == feeds.size(), "The number of feed names (", feed_names.size(),
+                    ") does not match the number of feeds (", feeds.size(), ").");
+  ORT_RETURN_IF(feeds.empty(), "A batched request needs at least one feed.");
+
+  rows = -1;
+  for (size_t i = 0, end = feeds.size(); i < end; ++i) {
+    ORT_RETURN_IF_NOT(feeds[i].IsTensor(), "Feed ", feed_names[i], " is not a tensor.");
+    const auto& tensor = feeds[i].Get<Tensor>();
+    ORT_RETURN_IF_NOT(tensor.Location().device.Type() == OrtDevice::CPU, "Feed ", feed_names[i],
+                      " is not a CPU tensor.");
+    ORT_RETURN_IF(tensor.Shape().NumDimensions() == 0, "Feed ", feed_names[i], " has no batch dimension.");
+    const int64_t feed_rows = tensor.Shape()[0];
+    ORT_RETURN_IF_NOT(rows == -1 || feed_rows == rows, "Feed ", feed_names[i], " has ", feed_rows,
+                      " rows but the previous feeds have ", rows, ".");
+    rows = feed_rows;
+  }
+  return Status::OK();
+}
+
+bool BatchingSession::CanBatch(const Request& first, const Request& other) const {
+  if (!std::equal(first.feed_names.begin(), first.feed_names.end(),
+                  other.feed_names.begin(), other.feed_names.end()) ||
+      !std::equal(first.output_names.begin(), first.output_names.end(),
+                  other.output_names.begin(), other.output_names.end())) {
+    return false;
+  }
+
+  for (size_t i = 0, end = first.feeds.size(); i < end; ++i) {
+    const auto& a = first.feeds[i].Get<Tensor>();
+    const auto& b = other.feeds[i].Get<Tensor>();
+    if (a.DataType() != b.DataType() || a.Shape().NumDimensions() != b.Shape().NumDimensions()) {
+      return false;
+    }
+    if (options_.padded_inputs.count(first.feed_names[i]) == 0) {
+      const auto a_dims = a.Shape().GetDims();
+      const auto b_dims = b.Shape().GetDims();
+      if (!std::equal(a_dims.begin() + 1, a_dims.end(), b_dims.begin() + 1)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+common::Status BatchingSession::Run(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                    gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches) {
+  Request request;
+  ORT_RETURN_IF_ERROR(ValidateRequest(feed_names, feeds, request.rows));
+  request.feed_names = feed_names;
+  request.feeds = feeds;
+  request.output_names = output_names;
+  request.fetches = &fetches;
+
+  std::unique_lock<OrtMutex> lock(queue_mutex_);
+  ORT_RETURN_IF(shutdown_, "The batching session is shutting down.");
+  request.enqueue_time = std::chrono::steady_clock::now();
+  queue_.push_back(&request);
+  queue_cv_.notify_all();
+  done_cv_.wait(lock, [&request]() { return request.done; });
+  return request.status;
+}
+
+int64_t BatchingSession::SelectBatch(std::vector<Request*>& batch) const {
+  batch.clear();
+  Request* first = queue_.front();
+  batch.push_back(first);
+  int64_t rows = first->rows;
+
+  for (auto it = queue_.begin() + 1, end = queue_.end(); it != end && rows < options_.max_batch_size; ++it) {
+    Request* request = *it;
+    if (rows + request->rows <= options_.max_batch_size && CanBatch(*first, *request)) {
+      batch.push_back(request);
+      rows += request->rows;
+    }
+  }
+  return rows;
+}
+
+void BatchingSession::DispatchLoop() {
+  std::vector<Request*> batch;
+
+  std::unique_lock<OrtMutex> lock(queue_mutex_);
+  while (true) {
+    queue_cv_.wait(lock, [this]() { return shutdown_ || !queue_.empty(); });
+    if (shutdown_) {
+      break;
+    }
+
+    // Wait for the batch to fill up or for the oldest request to reach its deadline.
+    const auto deadline = queue_.front()->enqueue_time + options_.max_queue_delay;
+    while (!shutdown_ && SelectBatch(batch) < options_.max_batch_size) {
+      const auto now = std::chrono::steady_clock::now();
+      if (now >= deadline) {
+        break;
+      }
+      queue_cv_.wait_for(lock, deadline - now);
+    }
+    if (shutdown_) {
+      break;
+    }
+
+    for (Request* request : batch) {
+      queue_.erase(std::find(queue_.begin(), queue_.end(), request));
+    }
+
+    lock.unlock();
+    Status status;
+    ORT_TRY {
+      status = RunBatch(batch);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+      });
+    }
+    lock.lock();
+
+    for (Request* request : batch) {
+      if (!status.IsOK()) {
+        request->status = status;
+      }
+      request->done = true;
+    }
+    done_cv_.notify_all();
+  }
+
+  for (Request* request : queue_) {
+    request->status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "The batching session was destroyed before the request ran.");
+    request->done = true;
+  }
+  queue_.clear();
+  done_cv_.notify_all();
+}
+
+common::Status BatchingSession::RunBatch(gsl::span<Request* const> batch) {
+  const Request& first = *batch[0];
+
+  // A request that runs on its own does not need to be copied.
+  if (batch.size() == 1) {
+    first.fetches->clear();
+    return session_.Run(options_.run_options, first.feed_names, first.feeds, first.output_names, first.fetches);
+  }
+
+  std::vector<OrtValue> feeds;
+  ORT_RETURN_IF_ERROR(ConcatFeeds(batch, feeds));
+
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(session_.Run(options_.run_options, first.feed_names, feeds, first.output_names, &fetches));
+
+  return ScatterFetches(batch, fetches);
+}
+
+common::Status BatchingSession::ConcatFeeds(gsl::span<Request* const> batch, std::vector<OrtValue>& feeds) const {
+  const Request& first = *batch[0];
+  feeds.resize(first.feeds.size());
+
+  for (size_t i = 0, end = first.feeds.size(); i < end; ++i) {
+    const auto& first_tensor = first.feeds[i].Get<Tensor>();
+
+    TensorShapeVector batch_dims = first_tensor.Shape().AsShapeVector();
+    batch_dims[0] = 0;
+    for (const Request* request : batch) {
+      const auto dims = request->feeds[i].Get<Tensor>().Shape().GetDims();
+      batch_dims[0] += dims[0];
+      for (size_t d = 1; d < dims.size(); ++d) {
+        batch_dims[d] = std::max(batch_dims[d], dims[d]);
+      }
+    }
+
+    Tensor::InitOrtValue(first_tensor.DataType(), TensorShape(batch_dims), cpu_allocator_, feeds[i]);
+    auto& batch_tensor = *feeds[i].GetMutable<Tensor>();
+
+    // Zero the padding. String tensors are initialized to empty strings already.
+    const bool padded = options_.padded_inputs.count(first.feed_names[i]) != 0;
+    if (padded && !batch_tensor.IsDataTypeString()) {
+      std::memset(batch_tensor.MutableDataRaw(), 0, batch_tensor.SizeInBytes());
+    }
+
+    int64_t row_offset = 0;
+    for (const Request* request : batch) {
+      const auto& tensor = request->feeds[i].Get<Tensor>();
+      CopyIntoBatch(tensor, batch_tensor, row_offset);
+      row_offset += request->rows;
+    }
+  }
+  return Status::OK();
+}
+
+common::Status BatchingSession::ScatterFetches(gsl::span<Request* const> batch,
+                                               gsl::span<const OrtValue> fetches) const {
+  int64_t total_rows = 0;
+  for (const Request* request : batch) {
+    total_rows += request->rows;
+    request->fetches->clear();
+    request->fetches->resize(fetches.size());
+  }
+
+  const auto& output_names = batch[0]->output_names;
+  for (size_t i = 0, end = fetches.size(); i < end; ++i) {
+    ORT_RETURN_IF_NOT(fetches[i].IsTensor(), "Output ", output_names[i], " is not a tensor and can not be batched.");
+    const auto& batch_tensor = fetches[i].Get<Tensor>();
+    const auto& batch_shape = batch_tensor.Shape();
+    ORT_RETURN_IF_NOT(batch_shape.NumDimensions() > 0 && batch_shape[0] == total_rows,
+                      "Output ", output_names[i], " with shape ", batch_shape,
+                      " does not have the batch of ", total_rows, " rows as its first dimension.");
+
+    TensorShapeVector dims = batch_shape.AsShapeVector();
+    const int64_t row_size = batch_shape.SizeFromDimension(1);
+    int64_t row_offset = 0;
+    for (Request* request : batch) {
+      dims[0] = request->rows;
+      OrtValue& fetch = (*request->fetches)[i];
+      Tensor::InitOrtValue(batch_tensor.DataType(), TensorShape(dims), cpu_allocator_, fetch);
+      CopyElements(batch_tensor, narrow<size_t>(row_offset * row_size), *fetch.GetMutable<Tensor>(), 0,
+                   narrow<size_t>(SafeInt<int64_t>(request->rows) * row_size));
+      row_offset += request->rows;
+    }
+  }
+  return Status::OK();
+}
+
+}  // namespace onnxruntime
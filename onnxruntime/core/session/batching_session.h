@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <chrono>
+#include <deque>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/status.h"
+#include "core/framework/allocator.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+#include "core/platform/ort_mutex.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+struct BatchingSessionOptions {
+  // Maximum number of rows, i.e. the sum of the dim 0 of the requests, that are run together.
+  // A request with more rows than this is run on its own.
+  int64_t max_batch_size = 32;
+
+  // How long the oldest queued request waits for more requests before its batch is run.
+  std::chrono::microseconds max_queue_delay{1000};
+
+  // Inputs whose dims after dim 0 may differ between requests. They are padded with zeros
+  // (empty strings for string tensors) up to the largest dims in the batch.
+  std::unordered_set<std::string> padded_inputs;
+
+  // Run options used for every batch.
+  RunOptions run_options;
+};
+
+/**
+ * Dynamic request batching over an initialized InferenceSession.
+ *
+ * Requests that have the same input and output names, element types and non-batch dims (modulo padded inputs)
+ * are queued, concatenated along dim 0 into one Run, and the fetches are sliced back along dim 0 for each request.
+ * Every feed of a request must be a CPU tensor with the same dim 0, and every fetch of the model must have the
+ * batch as its dim 0. Fetches are returned as CPU tensors, one per output name.
+ *
+ * Usage is as follows:
+ *
+ * BatchingSession batching_session(session, options);
+ * // from any number of threads
+ * std::vector<OrtValue> fetches;
+ * ORT_RETURN_IF_ERROR(batching_session.Run(feed_names, feeds, output_names, fetches));
+ */
+class BatchingSession {
+ public:
+  BatchingSession(InferenceSession& session, const BatchingSessionOptions& options);
+
+  // Fails the requests that are still queued and waits for the batch in flight.
+  ~BatchingSession();
+
+  /**
+   * Queues a request and blocks until its batch has run.
+   * @param feed_names names of the inputs, in the same order as feeds.
+   * @param feeds CPU tensors for the inputs.
+   * @param output_names names of the outputs to fetch.
+   * @param fetches overwritten with one tensor per output name.
+   */
+  common::Status Run(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                     gsl::span<const std::string> output_names, std::vector<OrtValue>& fetches);
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(BatchingSession);
+
+ private:
+  struct Request {
+    gsl::span<const std::string> feed_names;
+    gsl::span<const OrtValue> feeds;
+    gsl::span<const std::string> output_names;
+    std::vector<OrtValue>* fetches;
+    int64_t rows;
+    std::chrono::steady_clock::time_point enqueue_time;
+    common::Status status;
+    bool done = false;
+  };
+
+  static common::Status ValidateRequest(gsl::span<const std::string> feed_names, gsl::span<const OrtValue> feeds,
+                                        int64_t& rows);
+  bool CanBatch(const Request& first, const Request& other) const;
+
+  void DispatchLoop();
+
+  // Selects the queued requests that can be run together with the oldest one and returns their total rows.
+  // Called with queue_mutex_ held.
+  int64_t SelectBatch(std::vector<Request*>& batch) const;
+
+  common::Status RunBatch(gsl::span<Request* const> batch);
+  common::Status ConcatFeeds(gsl::span<Request* const> batch, std::vector<OrtValue>& feeds) const;
+  common::Status ScatterFetches(gsl::span<Request* const> batch, gsl::span<const OrtValue> fetches) const;
+
+  InferenceSession& session_;
+  const BatchingSessionOptions options_;
+  AllocatorPtr cpu_allocator_;
+
+  OrtMutex queue_mutex_;
+  OrtCondVar queue_cv_;  // signaled when a request is queued or on shutdown
+  OrtCondVar done_cv_;   // signaled when a batch completes
+  std::deque<Request*> queue_;
+  bool shutdown_ = false;
+
+  std::thread dispatcher_;
+};
+
+}  // namespace onnxruntime
@@ -50,6 +50,35 @@ ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetOutput, _Inout_ OrtKernelContext*
   return nullptr;
 };
 
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetInputs, _In_ const OrtKernelContext* context,
+                    _Out_writes_all_(num_values) const OrtValue** values, size_t num_values) {
+  const auto* ctx = reinterpret_cast<const onnxruntime::OpKernelContextInternal*>(context);
+  if (num_values != static_cast<size_t>(ctx->InputCount())) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "The number of values must be the input count of the kernel");
+  }
+  for (size_t i = 0; i < num_values; ++i) {
+    values[i] = reinterpret_cast<const OrtValue*>(ctx->GetInputMLValue(static_cast<int>(i)));
+  }
+  return nullptr;
+};
+
+ORT_API_STATUS_IMPL(OrtApis::KernelContext_GetOutputs, _Inout_ OrtKernelContext* context,
+                    _In_reads_(num_values) const int64_t* const* dim_values,
+                    _In_reads_(num_values) const size_t* dim_counts, size_t num_values,
+                    _Out_writes_all_(num_values) OrtValue** values) {
+  API_IMPL_BEGIN
+  auto* ctx = reinterpret_cast<onnxruntime::OpKernelContextInternal*>(context);
+  if (num_values != static_cast<size_t>(ctx->OutputCount())) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "The number of values must be the output count of the kernel");
+  }
+  for (size_t i = 0; i < num_values; ++i) {
+    onnxruntime::TensorShape shape(dim_values[i], dim_counts[i]);
+    values[i] = reinterpret_cast<OrtValue*>(ctx->OutputMLValue(static_cast<int>(i), shape));
+  }
+  return nullptr;
+  API_IMPL_END
+};
+
 ORT_API_STATUS_IMPL(OrtApis::KernelInfoGetAttribute_string, _In_ const OrtKernelInfo* info, _In_ const char* name, _Out_ char* out, _Inout_ size_t* size) {
   std::string value;
   auto status = reinterpret_cast<const onnxruntime::OpKernelInfo*>(info)->GetAttr<std::string>(name, &value);
@@ -125,7 +154,9 @@ ORT_API_STATUS_IMPL(OrtApis::KernelInfoGetAttributeArray_int64, _In_ const OrtKe
 }
 
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_MINIMAL_BUILD_CUSTOM_OPS)
+#include "core/common/inlined_containers.h"
 #include "core/framework/customregistry.h"
+#include "core/session/allocator_adapters.h"
 namespace onnxruntime {
 
 struct CustomOpKernel : OpKernel {
@@ -145,11 +176,79 @@ struct CustomOpKernel : OpKernel {
     return Status::OK();
   }
 
+  Status PrePack(const Tensor& tensor, int input_idx, AllocatorPtr alloc,
+                 /*out*/ bool& is_packed, /*out*/ PrePackedWeights* prepacked_weights) override {
+    is_packed = false;
+    if (op_.version < min_ort_version_with_prepack_and_inplace_support || op_.KernelPrePack == nullptr ||
+        op_.KernelUsePrePackedBuffer == nullptr) {
+      return Status::OK();
+    }
+
+    // the input is a view of the initializer
+    OrtValue input;
+    Tensor::InitOrtValue(tensor.DataType(), tensor.Shape(), const_cast<void*>(tensor.DataRaw()), tensor.Location(),
+                         input);
+    OrtAllocatorImplWrappingIAllocator allocator{AllocatorPtr(alloc)};
+    void* packed_buffer = nullptr;
+    size_t packed_buffer_size = 0;
+    ORT_RETURN_IF_ERROR(ToStatus(op_.KernelPrePack(op_kernel_, &input, input_idx, &allocator, &packed_buffer,
+                                                   &packed_buffer_size)));
+    if (packed_buffer == nullptr) {
+      return Status::OK();
+    }
+
+    is_packed = true;
+    BufferUniquePtr buffer(packed_buffer, BufferDeleter(std::move(alloc)));
+    // the size is needed again if the buffer comes back through UseSharedPrePackedBuffers
+    packed_buffer_sizes_[input_idx] = packed_buffer_size;
+    if (prepacked_weights != nullptr) {
+      prepacked_weights->buffers_.push_back(std::move(buffer));
+      prepacked_weights->buffer_sizes_.push_back(packed_buffer_size);
+      return Status::OK();
+    }
+
+    packed_buffers_.push_back(std::move(buffer));
+    return ToStatus(op_.KernelUsePrePackedBuffer(op_kernel_, input_idx, packed_buffer, packed_buffer_size));
+  }
+
+  Status UseSharedPrePackedBuffers(std::vector<BufferUniquePtr>& prepacked_buffers, int input_idx,
+                                   /*out*/ bool& used_shared_buffers) override {
+    used_shared_buffers = false;
+    // the input was packed by PrePack, which only packs inputs of ops with the callbacks
+    auto size = packed_buffer_sizes_.find(input_idx);
+    if (size == packed_buffer_sizes_.end() || prepacked_buffers.size() != 1) {
+      return Status::OK();
+    }
+
+    used_shared_buffers = true;
+    // the buffer has no deleter if it is owned by the shared container
+    void* packed_buffer = prepacked_buffers[0].get();
+    packed_buffers_.push_back(std::move(prepacked_buffers[0]));
+    return ToStatus(op_.KernelUsePrePackedBuffer(op_kernel_, input_idx, packed_buffer, size->second));
+  }
+
+  static constexpr uint32_t min_ort_version_with_prepack_and_inplace_support = 14;
+
  private:
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(CustomOpKernel);
 
+  // Converts the status returned by a callback of the custom op, and releases it.
+  static Status ToStatus(OrtStatusPtr ort_status) {
+    if (ort_status == nullptr) {
+      return Status::OK();
+    }
+    Status status(common::ONNXRUNTIME, static_cast<common::StatusCode>(OrtApis::GetErrorCode(ort_status)),
+                  OrtApis::GetErrorMessage(ort_status));
+    OrtApis::ReleaseStatus(ort_status);
+    return status;
+  }
+
   const OrtCustomOp& op_;
   void* op_kernel_;
+
+  // packed buffers of the inputs, which the kernel uses until it is destroyed
+  std::vector<BufferUniquePtr> packed_buffers_;
+  InlinedHashMap<int, size_t> packed_buffer_sizes_;
 };
 
 common::Status CreateCustomRegistry(gsl::span<OrtCustomOpDomain* const> op_domains,
@@ -302,6 +401,23 @@ common::Status CreateCustomRegistry(gsl::span<OrtCustomOpDomain* const> op_domai
         }
       }
 
+      // An output may reuse the buffer of an input only if the allocation planner knows about it from the kernel def.
+      if (op->version >= CustomOpKernel::min_ort_version_with_prepack_and_inplace_support) {
+        const auto output_count = op->GetOutputTypeCount(op);
+        for (size_t i = 0; i < output_count; i++) {
+          if (op->GetMayInplaceInput != nullptr) {
+            if (const int input_index = op->GetMayInplaceInput(op, i); input_index >= 0) {
+              def_builder.MayInplace(input_index, static_cast<int>(i));
+            }
+          }
+          if (op->GetAliasInput != nullptr) {
+            if (const int input_index = op->GetAliasInput(op, i); input_index >= 0) {
+              def_builder.Alias(input_index, static_cast<int>(i));
+            }
+          }
+        }
+      }
+
       for (auto& id : type_constraint_ids[op]) {
         def_builder.TypeConstraint(id, DataTypeImpl::AllTensorTypes());
       }
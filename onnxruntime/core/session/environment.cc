@@ -4,6 +4,7 @@
 #include "core/session/environment.h"
 #include "core/session/allocator_adapters.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/bfc_arena.h"
 #include "core/graph/constants.h"
 #include "core/graph/op.h"
 
@@ -27,6 +28,13 @@
 #include "core/platform/env.h"
 #include "core/util/thread_utils.h"
 
+#if defined(USE_CUDA)
+#include "core/providers/cuda/cuda_provider_factory.h"
+namespace onnxruntime {
+ProviderInfo_CUDA* TryGetProviderInfo_CUDA();
+}
+#endif
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
 #include "core/platform/tracing.h"
 #endif
@@ -79,9 +87,12 @@ static bool AreOrtMemoryInfosEquivalent(
 Status Environment::RegisterAllocator(AllocatorPtr allocator) {
   const auto& mem_info = allocator->Info();
 
-  if (mem_info.device.Type() != OrtDevice::CPU) {
+  // GPU memory is only picked up by the CUDA EP (see CreateAndRegisterAllocator) so other GPU allocators are rejected
+  // rather than silently left unused.
+  if (mem_info.device.Type() != OrtDevice::CPU &&
+      !(mem_info.device.Type() == OrtDevice::GPU && strcmp(mem_info.name, CUDA) == 0)) {
     return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
-                           "Only CPU allocators can be shared between "
+                           "Only CPU and CUDA allocators can be shared between "
                            "multiple sessions for now.");
   }
 
@@ -110,10 +121,120 @@ Status Environment::RegisterAllocator(AllocatorPtr allocator) {
   return Status::OK();
 }
 
+// Returns the arena settings to use, with the user supplied values in arena_cfg (which may be nullptr) validated and
+// applied over the defaults.
+static Status GetArenaCfgForSharedAllocator(const OrtArenaCfg* arena_cfg, OrtArenaCfg& l_arena_cfg) {
+  // defaults in case arena_cfg is nullptr (not supplied by the user)
+  size_t max_mem = 0;
+  int arena_extend_strategy = -1;
+  int initial_chunk_size_bytes = -1;
+  int max_dead_bytes_per_chunk = -1;
+  int initial_growth_chunk_size_bytes = -1;
+  int thread_cache_max_chunk_bytes = -1;
+
+  // override with values from the user supplied arena_cfg object
+  if (arena_cfg) {
+    max_mem = arena_cfg->max_mem;
+
+    arena_extend_strategy = arena_cfg->arena_extend_strategy;
+    // validate the value here
+    if (!(arena_extend_strategy == -1 || arena_extend_strategy == 0 || arena_extend_strategy == 1)) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Received invalid value for arena extend strategy."
+                             " Valid values can be either 0, 1 or -1.");
+    }
+
+    initial_chunk_size_bytes = arena_cfg->initial_chunk_size_bytes;
+    max_dead_bytes_per_chunk = arena_cfg->max_dead_bytes_per_chunk;
+    initial_growth_chunk_size_bytes = arena_cfg->initial_growth_chunk_size_bytes;
+    thread_cache_max_chunk_bytes = arena_cfg->thread_cache_max_chunk_bytes;
+    if (thread_cache_max_chunk_bytes < -1 ||
+        thread_cache_max_chunk_bytes > BFCArena::MAX_THREAD_CACHE_MAX_CHUNK_BYTES) {
+      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                             "Received invalid value for thread_cache_max_chunk_bytes."
+                             " Valid values are in the range [-1, ",
+                             BFCArena::MAX_THREAD_CACHE_MAX_CHUNK_BYTES, "].");
+    }
+  }
+
+  l_arena_cfg = OrtArenaCfg{max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk,
+                            initial_growth_chunk_size_bytes, thread_cache_max_chunk_bytes};
+  if (arena_cfg) {
+    l_arena_cfg.shrink_idle_ms = arena_cfg->shrink_idle_ms;
+    l_arena_cfg.shrink_low_usage_percent = arena_cfg->shrink_low_usage_percent;
+    l_arena_cfg.shrink_window_ms = arena_cfg->shrink_window_ms;
+    l_arena_cfg.shrink_retain_bytes = arena_cfg->shrink_retain_bytes;
+  }
+
+  return Status::OK();
+}
+
+// Creates an allocator for CUDA device memory (OrtMemTypeDefault) or CUDA pinned memory (OrtMemTypeCPUOutput).
+// These are the allocators the CUDA EP looks up in the AllocatorManager before creating its own, so sessions
+// that use the environment allocators share them instead of growing an arena each.
+static Status CreateCudaAllocatorForSharing(const OrtMemoryInfo& mem_info, const OrtArenaCfg* arena_cfg,
+                                            AllocatorPtr& allocator_ptr) {
+#if defined(USE_CUDA)
+  const bool is_pinned = strcmp(mem_info.name, CUDA_PINNED) == 0;
+  const OrtMemType expected_mem_type = is_pinned ? OrtMemTypeCPUOutput : OrtMemTypeDefault;
+  if (mem_info.mem_type != expected_mem_type) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "The OrtMemType of a shared ", mem_info.name,
+                           " allocator must be ", expected_mem_type, " to be used by the CUDA execution provider.");
+  }
+
+  auto* provider_info = TryGetProviderInfo_CUDA();
+  if (provider_info == nullptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
+                           "The CUDA execution provider could not be loaded to create the shared allocator.");
+  }
+
+  const bool create_arena = mem_info.alloc_type == OrtArenaAllocator;
+  OrtArenaCfg l_arena_cfg;
+  ORT_RETURN_IF_ERROR(GetArenaCfgForSharedAllocator(arena_cfg, l_arena_cfg));
+
+  if (is_pinned) {
+    AllocatorCreationInfo alloc_creation_info{
+        [provider_info](OrtDevice::DeviceId id) { return provider_info->CreateCUDAPinnedAllocator(id, CUDA_PINNED); },
+        mem_info.device.Id(),
+        create_arena,
+        l_arena_cfg};
+    allocator_ptr = CreateAllocator(alloc_creation_info);
+  } else {
+    // Each session runs on its own streams, so the arena is stream aware. A chunk freed on the stream of one session
+    // can be taken by another after waiting on that stream, which keeps the arena at the peak of the concurrent
+    // requests rather than the sum of the peaks of the sessions.
+    AllocatorCreationInfo alloc_creation_info{
+        [provider_info](OrtDevice::DeviceId id) { return provider_info->CreateCUDAAllocator(id, CUDA); },
+        mem_info.device.Id(),
+        create_arena,
+        l_arena_cfg,
+        /*stream_aware_arena*/ true,
+        /*cross_stream_reusing*/ true};
+    allocator_ptr = CreateAllocator(alloc_creation_info);
+  }
+
+  if (!allocator_ptr) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to create the shared ", mem_info.name, " allocator.");
+  }
+
+  return Status::OK();
+#else
+  ORT_UNUSED_PARAMETER(arena_cfg);
+  ORT_UNUSED_PARAMETER(allocator_ptr);
+  return ORT_MAKE_STATUS(ONNXRUNTIME, NOT_IMPLEMENTED, "Sharing of ", mem_info.name,
+                         " allocators requires a build with the CUDA execution provider.");
+#endif
+}
+
 Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, const OrtArenaCfg* arena_cfg) {
-  // TODO should we allow sharing of non-CPU allocators?
+  if (strcmp(mem_info.name, CUDA) == 0 || strcmp(mem_info.name, CUDA_PINNED) == 0) {
+    AllocatorPtr allocator_ptr;
+    ORT_RETURN_IF_ERROR(CreateCudaAllocatorForSharing(mem_info, arena_cfg, allocator_ptr));
+    return RegisterAllocator(allocator_ptr);
+  }
+
   if (mem_info.device.Type() != OrtDevice::CPU) {
-    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Only CPU devices are supported for now.");
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Only CPU and CUDA devices are supported for now.");
   }
 
   // determine if arena should be used
@@ -130,32 +251,8 @@ Status Environment::CreateAndRegisterAllocator(const OrtMemoryInfo& mem_info, co
   AllocatorPtr allocator_ptr;
   // create appropriate DeviceAllocatorRegistrationInfo and allocator based on create_arena
   if (create_arena) {
-    // defaults in case arena_cfg is nullptr (not supplied by the user)
-    size_t max_mem = 0;
-    int arena_extend_strategy = -1;
-    int initial_chunk_size_bytes = -1;
-    int max_dead_bytes_per_chunk = -1;
-    int initial_growth_chunk_size_bytes = -1;
-
-    // override with values from the user supplied arena_cfg object
-    if (arena_cfg) {
-      max_mem = arena_cfg->max_mem;
-
-      arena_extend_strategy = arena_cfg->arena_extend_strategy;
-      // validate the value here
-      if (!(arena_extend_strategy == -1 || arena_extend_strategy == 0 || arena_extend_strategy == 1)) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
-                               "Received invalid value for arena extend strategy."
-                               " Valid values can be either 0, 1 or -1.");
-      }
-
-      initial_chunk_size_bytes = arena_cfg->initial_chunk_size_bytes;
-      max_dead_bytes_per_chunk = arena_cfg->max_dead_bytes_per_chunk;
-      initial_growth_chunk_size_bytes = arena_cfg->initial_growth_chunk_size_bytes;
-    }
-
-    OrtArenaCfg l_arena_cfg{max_mem, arena_extend_strategy, initial_chunk_size_bytes, max_dead_bytes_per_chunk,
-                            initial_growth_chunk_size_bytes};
+    OrtArenaCfg l_arena_cfg;
+    ORT_RETURN_IF_ERROR(GetArenaCfgForSharedAllocator(arena_cfg, l_arena_cfg));
     AllocatorCreationInfo alloc_creation_info{
         [mem_info](int) { return std::make_unique<CPUAllocator>(mem_info); },
         0,
@@ -310,6 +407,46 @@ Internal copy node
         .TypeAndShapeInferenceFunction(propagateShapeAndTypeFromFirstInput)
         .SetDoc(R"DOC(
 Internal copy node
+)DOC");
+
+    static std::vector<std::string> all_fixed_size_tensor_types = []() {
+      std::vector<std::string> all_types = OpSchema::all_tensor_types_with_bfloat();
+      all_types.erase(std::remove_if(all_types.begin(), all_types.end(),
+                      [](const std::string& s) { return s.find("string") != std::string::npos; }), all_types.end());
+      return all_types; }();
+
+    // the i-th output has the type and shape of the i-th input
+    static auto propagate_shapes_and_types_per_input = [](ONNX_NAMESPACE::InferenceContext& ctx) {
+      for (size_t i = 0; i < ctx.getNumInputs(); ++i) {
+        propagateElemTypeFromInputToOutput(ctx, i, i);
+        if (hasInputShape(ctx, i)) {
+          propagateShapeFromInputToOutput(ctx, i, i);
+        }
+      }
+    };
+
+    ORT_ATTRIBUTE_UNUSED ONNX_OPERATOR_SCHEMA(MemcpyFromHostBatch)
+        .Input(0, "X", "inputs", "T", OpSchema::Variadic, /*is_homogeneous*/ false, /*min_arity*/ 1)
+        .Output(0, "Y", "outputs", "T", OpSchema::Variadic, /*is_homogeneous*/ false, /*min_arity*/ 1)
+        .TypeConstraint(
+            "T",
+            all_fixed_size_tensor_types,
+            "Constrain to all fixed size tensor types.")
+        .TypeAndShapeInferenceFunction(propagate_shapes_and_types_per_input)
+        .SetDoc(R"DOC(
+Internal copy node, copying several tensors to the device in one transfer
+)DOC");
+
+    ORT_ATTRIBUTE_UNUSED ONNX_OPERATOR_SCHEMA(MemcpyToHostBatch)
+        .Input(0, "X", "inputs", "T", OpSchema::Variadic, /*is_homogeneous*/ false, /*min_arity*/ 1)
+        .Output(0, "Y", "outputs", "T", OpSchema::Variadic, /*is_homogeneous*/ false, /*min_arity*/ 1)
+        .TypeConstraint(
+            "T",
+            all_fixed_size_tensor_types,
+            "Constrain to all fixed size tensor types.")
+        .TypeAndShapeInferenceFunction(propagate_shapes_and_types_per_input)
+        .SetDoc(R"DOC(
+Internal copy node, copying several tensors to the host in one transfer
 )DOC");
 
 #endif  // !defined(ORT_MINIMAL_BUILD)
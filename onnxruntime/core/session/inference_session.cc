@@ -4,7 +4,13 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/session/inference_session.h"
 
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <limits>
+#include <map>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <unordered_set>
 #include <list>
@@ -15,6 +21,7 @@
 #include "core/common/logging/logging.h"
 #include "core/common/parse_string.h"
 #include "core/common/path_string.h"
+#include "core/common/string_utils.h"
 #include "core/flatbuffers/flatbuffers_utils.h"
 #include "core/flatbuffers/ort_format_version.h"
 #include "core/framework/allocatormgr.h"
@@ -28,6 +35,7 @@
 #include "core/framework/kernel_type_str_resolver.h"
 #include "core/framework/kernel_type_str_resolver_utils.h"
 #include "core/framework/mldata_type_utils.h"
+#include "core/framework/murmurhash3.h"
 #include "core/framework/TensorSeq.h"
 #include "core/framework/tensorprotoutils.h"
 #include "core/framework/tensor_type_and_shape.h"
@@ -39,15 +47,18 @@
 #include "core/optimizer/graph_transformer_utils.h"
 #include "core/optimizer/graph_transformer.h"
 #include "core/optimizer/insert_cast_transformer.h"
+#include "core/optimizer/mixed_precision_transformer.h"
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/selectors_actions/selector_action_transformer_apply_contexts.h"
 #include "core/optimizer/transformer_memcpy.h"
 #include "core/optimizer/transpose_optimizer/optimizer_utils.h"
 #include "core/platform/Barrier.h"
 #include "core/platform/ort_mutex.h"
+#include "core/platform/path_lib.h"
 #include "core/platform/threadpool.h"
 #include "core/providers/cpu/controlflow/utils.h"
 #include "core/providers/cpu/cpu_execution_provider.h"
+#include "core/providers/cpu/cpu_profiler.h"
 #ifdef USE_DML  // TODO: This is necessary for the workaround in TransformGraph
 #include "core/providers/dml/DmlExecutionProvider/src/DmlGraphFusionTransformer.h"
 #include "core/providers/dml/DmlExecutionProvider/src/GraphTransformer.h"
@@ -253,6 +264,7 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
 #if !defined(ORT_MINIMAL_BUILD)
   // Update the number of steps for the graph transformer manager using the "finalized" session options
   ORT_ENFORCE(graph_transformation_mgr_.SetSteps(session_options_.max_num_graph_transformation_steps).IsOK());
+  graph_transformation_mgr_.SetProfiler(&session_profiler_);
 #endif
 
   bool set_denormal_as_zero =
@@ -290,6 +302,12 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         // If the thread pool can use all the processors, then
         // we set affinity of each thread to each processor.
         to.allow_spinning = allow_intra_op_spinning;
+        to.adaptive_spinning =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpAdaptiveSpinning, "0") ==
+            "1";
+        to.calibrate_parallel_for_cost =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigIntraOpCalibrateCost, "0") ==
+            "1";
         to.dynamic_block_base_ = std::stoi(session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigDynamicBlockBase, "0"));
         LOGS(*session_logger_, INFO) << "Dynamic block base set to " << to.dynamic_block_base_;
 
@@ -297,6 +315,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
         to.custom_thread_creation_options = session_options.custom_thread_creation_options;
         to.custom_join_thread_fn = session_options_.custom_join_thread_fn;
+        to.custom_schedule_fn = session_options_.custom_schedule_fn;
+        to.custom_scheduler_param = session_options_.custom_scheduler_param;
         if (session_options_.config_options.TryGetConfigEntry(kOrtSessionOptionsConfigIntraOpThreadAffinities, to.affinity_str)) {
           ORT_ENFORCE(!to.affinity_str.empty(), "Affinity string must not be empty");
         }
@@ -333,6 +353,8 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
         to.custom_create_thread_fn = session_options_.custom_create_thread_fn;
         to.custom_thread_creation_options = session_options.custom_thread_creation_options;
         to.custom_join_thread_fn = session_options_.custom_join_thread_fn;
+        to.custom_schedule_fn = session_options_.custom_schedule_fn;
+        to.custom_scheduler_param = session_options_.custom_scheduler_param;
 
         if (to.custom_create_thread_fn) {
           ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set for inter op thread pool");
@@ -355,10 +377,55 @@ void InferenceSession::ConstructorCommon(const SessionOptions& session_options,
   }
 
   session_profiler_.Initialize(session_logger_);
+  const std::string profiling_streaming_batch_size =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsProfilingStreamingBatchSize, "0");
+  size_t streaming_batch_size = 0;
+  ORT_ENFORCE(TryParseStringWithClassicLocale(profiling_streaming_batch_size, streaming_batch_size),
+              "Invalid value for ", kOrtSessionOptionsProfilingStreamingBatchSize, ": ",
+              profiling_streaming_batch_size);
+  session_profiler_.SetStreamingBatchSize(streaming_batch_size);
+  session_profiler_.EnableTimelineTracks(
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsProfilingTimelineTracks, "0") == "1");
+  const std::string hardware_counters =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsProfilingHardwareCounters, "");
+  if (!hardware_counters.empty()) {
+    std::unique_ptr<profiling::EpProfiler> hardware_counter_profiler;
+    ORT_THROW_IF_ERROR(profiling::CpuHardwareCounterProfiler::Create(hardware_counters, *session_logger_,
+                                                                     hardware_counter_profiler));
+    session_profiler_.AddEpProfilers(std::move(hardware_counter_profiler));
+  }
   if (session_options_.enable_profiling) {
     StartProfiling(session_options_.profile_file_prefix);
   }
 
+  const std::string sampling_rate =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsSamplingProfilerRate, "0");
+  const std::string sampling_export_interval =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsSamplingProfilerExportIntervalMs, "0");
+  profiling::SamplingOptions sampling_options;
+  int64_t sampling_export_interval_ms = 0;
+  ORT_ENFORCE(TryParseStringWithClassicLocale(sampling_rate, sampling_options.sample_every_n),
+              "Invalid value for ", kOrtSessionOptionsSamplingProfilerRate, ": ", sampling_rate);
+  ORT_ENFORCE(TryParseStringWithClassicLocale(sampling_export_interval, sampling_export_interval_ms),
+              "Invalid value for ", kOrtSessionOptionsSamplingProfilerExportIntervalMs, ": ",
+              sampling_export_interval);
+  if (sampling_options.sample_every_n > 0) {
+    sampling_options.export_interval = std::chrono::milliseconds(sampling_export_interval_ms);
+    // by default the slowest nodes are logged, SetSamplingProfilerExportCallback replaces it
+    sampling_options.export_callback = [logger = session_logger_](
+                                           const std::vector<profiling::NodeLatencyStats>& stats) {
+      constexpr size_t kNumLoggedNodes = 10;
+      for (size_t i = 0, end = std::min(stats.size(), kNumLoggedNodes); i < end; ++i) {
+        LOGS(*logger, INFO) << "Sampled latency of " << stats[i].node_name << " [" << stats[i].op_type
+                            << "]: count=" << stats[i].count << " mean_us=" << stats[i].total_ns / stats[i].count / 1000
+                            << " p50_us<=" << stats[i].GetPercentileUpperBoundNs(50) / 1000
+                            << " p99_us<=" << stats[i].GetPercentileUpperBoundNs(99) / 1000
+                            << " max_us=" << stats[i].max_ns / 1000;
+      }
+    };
+    session_profiler_.StartSampling(std::move(sampling_options));
+  }
+
   telemetry_ = {};
 }
 
@@ -444,6 +511,27 @@ InferenceSession::InferenceSession(const SessionOptions& session_options, const
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 InferenceSession::~InferenceSession() {
+  {
+    // The async runs use the session and its thread pools, so let them finish first.
+    std::unique_lock<onnxruntime::OrtMutex> lock(async_runs_mutex_);
+    async_runs_cv_.wait(lock, [this]() { return num_async_runs_ == 0; });
+  }
+
+#if !defined(ORT_MINIMAL_BUILD)
+  {
+    // The shape specialized sessions use the thread pools of this session.
+    std::vector<std::thread> shape_specialization_threads;
+    {
+      std::lock_guard<OrtMutex> l(shape_specializations_mutex_);
+      shape_specialization_threads.swap(shape_specialization_threads_);
+    }
+    for (auto& thread : shape_specialization_threads) {
+      thread.join();
+    }
+    shape_specializations_.clear();
+  }
+#endif
+
   if (session_options_.enable_profiling) {
     ORT_TRY {
       EndProfiling();
@@ -600,10 +688,17 @@ common::Status InferenceSession::SaveToOrtFormat(const PathString& filepath) con
   ORT_RETURN_IF_ERROR(
       kernel_type_str_resolver.SaveToOrtFormat(builder, fbs_kernel_type_str_resolver));
 
+  // the memory patterns of a model with static input shapes, so that loading it needs no first run to trace them
+  flatbuffers::Offset<fbs::SessionMemoryPatterns> fbs_memory_patterns;
+  if (session_options_.enable_mem_pattern) {
+    ORT_RETURN_IF_ERROR(session_state_->SaveMemoryPatternsToOrtFormat(builder, fbs_memory_patterns));
+  }
+
   fbs::InferenceSessionBuilder sb(builder);
   sb.add_ort_version(ort_model_version);
   sb.add_model(fbs_model);
   sb.add_kernel_type_str_resolver(fbs_kernel_type_str_resolver);
+  sb.add_memory_patterns(fbs_memory_patterns);
   auto session = sb.Finish();
   builder.Finish(session, fbs::InferenceSessionIdentifier());
 
@@ -893,8 +988,30 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph,
                                                     ? layout_transformer::TransformLayoutForEP
                                                     : nullptr;
 
+  // optionally refine the node assignment with the node latencies of a previous profiling run
+  PartitioningCostModel partitioning_cost_model;
+  const std::string partitioning_cost_model_file =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsPartitioningCostModelFile, "");
+  if (!partitioning_cost_model_file.empty()) {
+    ORT_RETURN_IF_ERROR_SESSIONID_(inference_session_utils::LoadPartitioningCostModelFromProfile(
+        ToPathString(partitioning_cost_model_file), partitioning_cost_model));
+
+    const std::string copy_overhead =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsPartitioningCopyOverheadUs, "");
+    const std::string copy_bandwidth =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsPartitioningCopyBytesPerUs, "");
+    ORT_RETURN_IF_NOT(copy_overhead.empty() ||
+                          TryParseStringWithClassicLocale(copy_overhead, partitioning_cost_model.copy_overhead_us),
+                      "Invalid value for ", kOrtSessionOptionsPartitioningCopyOverheadUs, ": ", copy_overhead);
+    ORT_RETURN_IF_NOT((copy_bandwidth.empty() ||
+                       TryParseStringWithClassicLocale(copy_bandwidth, partitioning_cost_model.copy_bytes_per_us)) &&
+                          partitioning_cost_model.copy_bytes_per_us > 0,
+                      "Invalid value for ", kOrtSessionOptionsPartitioningCopyBytesPerUs, ": ", copy_bandwidth);
+  }
+
   // Do partitioning based on execution providers' capabilities.
-  GraphPartitioner partitioner(kernel_registry_manager, providers);
+  GraphPartitioner partitioner(kernel_registry_manager, providers,
+                               partitioning_cost_model_file.empty() ? nullptr : &partitioning_cost_model);
   ORT_RETURN_IF_ERROR_SESSIONID_(partitioner.Partition(graph, session_state.GetMutableFuncMgr(), transform_layout_fn,
                                                        mode));
 
@@ -906,6 +1023,29 @@ common::Status InferenceSession::TransformGraph(onnxruntime::Graph& graph,
   }
 
   bool modified = false;
+  // Optionally convert the float nodes of the GPU execution providers to float16 or bfloat16.
+  const std::string mixed_precision =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsMixedPrecision, "");
+  if (!mixed_precision.empty()) {
+    ORT_RETURN_IF_NOT(mixed_precision == "fp16" || mixed_precision == "bf16",
+                      "Invalid value for ", kOrtSessionOptionsMixedPrecision, ": ", mixed_precision);
+    auto get_op_types = [this](const char* config_key) {
+      const std::string op_types = session_options_.config_options.GetConfigOrDefault(config_key, "");
+      std::vector<std::string> result;
+      for (const auto& op_type : utils::SplitString(op_types, ",")) {
+        result.emplace_back(op_type);
+      }
+      return result;
+    };
+    const auto allow_ops = get_op_types(kOrtSessionOptionsMixedPrecisionAllowOps);
+    const auto deny_ops = get_op_types(kOrtSessionOptionsMixedPrecisionDenyOps);
+    MixedPrecisionTransformer mixed_precision_transformer{
+        mixed_precision == "fp16" ? ONNX_NAMESPACE::TensorProto_DataType_FLOAT16
+                                  : ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16,
+        allow_ops, deny_ops, kernel_registry_manager};
+    ORT_RETURN_IF_ERROR_SESSIONID_(mixed_precision_transformer.Apply(graph, modified, *session_logger_));
+  }
+
   // Insert cast node/s.
   ORT_RETURN_IF_ERROR_SESSIONID_(insert_cast_transformer.Apply(graph, modified, *session_logger_));
 
@@ -944,12 +1084,33 @@ static Status LoadOrtModelBytes(const PathString& model_uri,
   return Status::OK();
 }
 
+static Status MapOrtModelBytes(const PathString& model_uri,
+                               gsl::span<const uint8_t>& bytes,
+                               Env::MappedMemoryPtr& mapped_bytes) {
+  size_t num_bytes = 0;
+  ORT_RETURN_IF_ERROR(Env::Default().GetFileLength(model_uri.c_str(), num_bytes));
+  ORT_RETURN_IF(num_bytes == 0, "Load model from ", ToUTF8String(model_uri), " failed. The file is empty.");
+
+  ORT_RETURN_IF_ERROR(Env::Default().MapFileIntoMemory(model_uri.c_str(), 0, num_bytes, mapped_bytes));
+
+  bytes = gsl::span<const uint8_t>(reinterpret_cast<const uint8_t*>(mapped_bytes.get()), num_bytes);
+
+  return Status::OK();
+}
+
 Status InferenceSession::LoadOrtModel(const PathString& model_uri) {
   return LoadOrtModelWithLoader(
       [&]() {
         model_location_ = model_uri;
-        ORT_RETURN_IF_ERROR(
-            LoadOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+        const bool memory_map_model =
+            session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMemoryMapOrtModel, "0") == "1";
+        if (memory_map_model) {
+          ORT_RETURN_IF_ERROR(
+              MapOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_mapped_bytes_));
+        } else {
+          ORT_RETURN_IF_ERROR(
+              LoadOrtModelBytes(model_location_, ort_format_model_bytes_, ort_format_model_bytes_data_holder_));
+        }
         return Status::OK();
       });
 }
@@ -994,6 +1155,10 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
 
   ORT_RETURN_IF_ERROR(load_ort_format_model_bytes());
 
+  return LoadOrtModelFromBytes();
+}
+
+Status InferenceSession::LoadOrtModelFromBytes() {
   // Verify the ort_format_model_bytes_ is a valid InferenceSessionBuffer before we access the data
   flatbuffers::Verifier verifier(ort_format_model_bytes_.data(), ort_format_model_bytes_.size());
   ORT_RETURN_IF_NOT(fbs::VerifyInferenceSessionBuffer(verifier), "ORT model verification failed.");
@@ -1057,11 +1222,14 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
   // provided an existing buffer of bytes when creating the InferenceSession, ort_format_model_bytes_data_holder_
   // will be empty.
   // if that is the case we also allow creating initializers that directly use those bytes.
+  // if the model file is memory mapped the initializers always use the mapped bytes, as avoiding the copies is the
+  // point of mapping it.
   const auto& config_options = session_options_.config_options;
   using_ort_model_bytes_for_initializers_ =
       load_options.can_use_flatbuffer_for_initializers =
-          ort_format_model_bytes_data_holder_.empty() &&
-          config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "0") == "1";
+          ort_format_model_mapped_bytes_ != nullptr ||
+          (ort_format_model_bytes_data_holder_.empty() &&
+           config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseORTModelBytesForInitializers, "0") == "1");
 
   // need to go from unique_ptr to shared_ptr when moving into model_
   std::unique_ptr<Model> tmp_model;
@@ -1101,6 +1269,397 @@ Status InferenceSession::LoadOrtModelWithLoader(std::function<Status()> load_ort
   return Status::OK();
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+namespace {
+// Incrementally computes the 128-bit hash used as the optimized model cache key.
+class OptimizedModelCacheKeyHasher {
+ public:
+  void Update(const void* data, size_t num_bytes) {
+    // MurmurHash3 takes an int length so hash large buffers in chunks, chaining the previous hash as the seed.
+    constexpr size_t kMaxChunkSize = 1 << 30;
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    do {
+      const size_t chunk_size = std::min(num_bytes, kMaxChunkSize);
+      MurmurHash3::x86_128(bytes, static_cast<int>(chunk_size), hash_[0], hash_);
+      bytes += chunk_size;
+      num_bytes -= chunk_size;
+    } while (num_bytes > 0);
+  }
+
+  void Update(const std::string& str) {
+    // include the size so that the boundaries between consecutive strings are part of the key
+    const uint64_t size = str.size();
+    Update(&size, sizeof(size));
+    Update(str.data(), str.size());
+  }
+
+  std::string HexDigest() const {
+    std::ostringstream ss;
+    for (const auto h : hash_) {
+      ss << std::hex << std::setw(8) << std::setfill('0') << h;
+    }
+    return ss.str();
+  }
+
+ private:
+  uint32_t hash_[4] = {0, 0, 0, 0};
+};
+
+void RemoveFile(const PathString& path) {
+#ifdef _WIN32
+  _wremove(path.c_str());
+#else
+  std::remove(path.c_str());
+#endif
+}
+
+Status RenameFile(const PathString& from, const PathString& to) {
+#ifdef _WIN32
+  // _wrename fails if the target exists. Another process may have saved the same entry concurrently.
+  RemoveFile(to);
+  const int ret = _wrename(from.c_str(), to.c_str());
+#else
+  const int ret = std::rename(from.c_str(), to.c_str());
+#endif
+  ORT_RETURN_IF(ret != 0, "Failed to rename ", ToUTF8String(from), " to ", ToUTF8String(to));
+  return Status::OK();
+}
+}  // namespace
+
+Status InferenceSession::GetOptimizedModelCachePath(PathString& cache_path) const {
+  cache_path.clear();
+
+  const auto& config_options = session_options_.config_options;
+  const std::string cache_dir = config_options.GetConfigOrDefault(kOrtSessionOptionsOptimizedModelCacheDir, "");
+  if (cache_dir.empty()) {
+    return Status::OK();
+  }
+
+  const auto skip_cache = [this](const char* reason) {
+    LOGS(*session_logger_, INFO) << "The optimized model cache is not used as " << reason << ".";
+    return Status::OK();
+  };
+
+  if (!ort_format_model_bytes_.empty()) {
+    return skip_cache("the model is in ORT format");
+  }
+
+  if (!session_options_.optimized_model_filepath.empty()) {
+    return skip_cache("optimized_model_filepath is set");
+  }
+
+  if (!config_options.GetConfigOrDefault(kOrtSessionOptionsConfigMinimalBuildOptimizations, "").empty()) {
+    return skip_cache("minimal build optimizations are configured");
+  }
+
+#if !defined(DISABLE_EXTERNAL_INITIALIZERS)
+  if (!session_options_.external_initializers.empty()) {
+    return skip_cache("external initializers were added to the session options");
+  }
+#endif
+
+  for (const auto& provider : execution_providers_) {
+    if (provider->IsGraphCaptureEnabled()) {
+      return skip_cache("graph capture is enabled");
+    }
+  }
+
+  OptimizedModelCacheKeyHasher hasher;
+
+  // model content. initializers with external data are hashed separately as only their location is in the proto.
+  {
+    const auto model_proto = model_->ToProto();
+    const std::string model_bytes = model_proto.SerializeAsString();
+    hasher.Update(model_bytes);
+
+    const Graph& graph = model_->MainGraph();
+    std::map<std::string, const ONNX_NAMESPACE::TensorProto*> external_initializers;
+    for (const auto& [name, tensor_proto] : graph.GetAllInitializedTensors()) {
+      if (utils::HasExternalData(*tensor_proto)) {
+        external_initializers.emplace(name, tensor_proto);
+      }
+    }
+
+    for (const auto& [name, tensor_proto] : external_initializers) {
+      std::vector<uint8_t> unpacked_tensor;
+      ORT_RETURN_IF_ERROR(utils::UnpackInitializerData(*tensor_proto, graph.ModelPath(), unpacked_tensor));
+      hasher.Update(name);
+      hasher.Update(unpacked_tensor.data(), unpacked_tensor.size());
+    }
+  }
+
+  // settings that affect the optimized graph
+  {
+    std::ostringstream settings;
+    settings << "ort_version:" << ORT_VERSION << ";ort_model_version:" << kOrtModelVersion
+             << ";graph_optimization_level:" << static_cast<int>(session_options_.graph_optimization_level) << ";";
+
+    const std::map<std::string, std::string> configurations(config_options.configurations.begin(),
+                                                            config_options.configurations.end());
+    for (const auto& [key, value] : configurations) {
+      if (key != kOrtSessionOptionsOptimizedModelCacheDir) {
+        settings << "config:" << key << "=" << value << ";";
+      }
+    }
+
+    for (const auto& free_dim_override : session_options_.free_dimension_overrides) {
+      settings << "free_dimension_override:" << static_cast<int>(free_dim_override.dim_identifer_type) << ":"
+               << free_dim_override.dim_identifier << "=" << free_dim_override.dim_value << ";";
+    }
+
+    const std::set<std::string> optimizers_to_disable(optimizers_to_disable_.begin(), optimizers_to_disable_.end());
+    for (const auto& optimizer : optimizers_to_disable) {
+      settings << "disabled_optimizer:" << optimizer << ";";
+    }
+
+    // the order of the execution providers determines the partitioning so it is part of the key
+    for (const auto& provider : execution_providers_) {
+      settings << "ep:" << provider->Type() << "(";
+      const auto provider_options = provider->GetProviderOptions();
+      const std::map<std::string, std::string> sorted_provider_options(provider_options.begin(),
+                                                                       provider_options.end());
+      for (const auto& [key, value] : sorted_provider_options) {
+        settings << key << "=" << value << ";";
+      }
+      settings << ");";
+    }
+
+    hasher.Update(settings.str());
+  }
+
+  const PathString cache_dir_path = ToPathString(cache_dir);
+  if (!Env::Default().FolderExists(cache_dir_path)) {
+    ORT_RETURN_IF_ERROR(Env::Default().CreateFolder(cache_dir_path));
+  }
+
+  cache_path = ConcatPathComponent<PathChar>(cache_dir_path, ToPathString(hasher.HexDigest() + ".ort"));
+  return Status::OK();
+}
+
+Status InferenceSession::LoadFromOptimizedModelCache(const PathString& cache_path, bool& loaded) {
+  loaded = false;
+
+  size_t num_bytes = 0;
+  if (!Env::Default().GetFileLength(cache_path.c_str(), num_bytes).IsOK() || num_bytes == 0) {
+    LOGS(*session_logger_, INFO) << "The optimized model cache has no entry for this model: "
+                                 << ToUTF8String(cache_path);
+    return Status::OK();
+  }
+
+  const auto* original_model = model_.get();
+  Status status = LoadOrtModelBytes(cache_path, ort_format_model_bytes_, ort_format_model_bytes_data_holder_);
+  if (status.IsOK()) {
+    status = LoadOrtModelFromBytes();
+  }
+
+  if (!status.IsOK()) {
+    // the ONNX model is still usable unless it was already replaced
+    ORT_RETURN_IF(model_.get() != original_model, "Failed to load the optimized model from the cache: ",
+                  ToUTF8String(cache_path), ". ", status.ErrorMessage());
+
+    LOGS(*session_logger_, WARNING) << "Failed to load the optimized model from the cache: "
+                                    << ToUTF8String(cache_path) << ". " << status.ErrorMessage()
+                                    << " The model will be optimized and the cache entry replaced.";
+    ort_format_model_bytes_ = gsl::span<const uint8_t>();
+    std::vector<uint8_t>{}.swap(ort_format_model_bytes_data_holder_);
+    return Status::OK();
+  }
+
+  LOGS(*session_logger_, INFO) << "Loaded the optimized model from the cache: " << ToUTF8String(cache_path);
+  loaded = true;
+  return Status::OK();
+}
+
+void InferenceSession::SaveToOptimizedModelCache(const PathString& cache_path) const {
+  if (session_state_->GetFuncMgr().NumFuncs() > 0) {
+    LOGS(*session_logger_, INFO) << "The optimized model is not saved to the cache as it contains compiled nodes.";
+    return;
+  }
+
+  // write to a temporary file first so other processes never load a partially written entry
+  const PathString tmp_path = cache_path + ToPathString("." + std::to_string(Env::Default().GetSelfPid()) + ".tmp");
+  Status status = SaveToOrtFormat(tmp_path);
+  if (status.IsOK()) {
+    status = RenameFile(tmp_path, cache_path);
+  }
+
+  if (!status.IsOK()) {
+    LOGS(*session_logger_, WARNING) << "Failed to save the optimized model to the cache: " << ToUTF8String(cache_path)
+                                    << ". " << status.ErrorMessage();
+    RemoveFile(tmp_path);
+    return;
+  }
+
+  LOGS(*session_logger_, INFO) << "Saved the optimized model to the cache: " << ToUTF8String(cache_path);
+}
+
+Status InferenceSession::InitializeShapeSpecialization() {
+  const std::string warmup_runs =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsShapeSpecializationWarmupRuns, "0");
+  const std::string max_sessions =
+      session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsShapeSpecializationMaxSessions, "4");
+  size_t num_warmup_runs = 0;
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(warmup_runs, num_warmup_runs),
+                    "Invalid value for ", kOrtSessionOptionsShapeSpecializationWarmupRuns, ": ", warmup_runs);
+  ORT_RETURN_IF_NOT(TryParseStringWithClassicLocale(max_sessions, shape_specialization_max_sessions_),
+                    "Invalid value for ", kOrtSessionOptionsShapeSpecializationMaxSessions, ": ", max_sessions);
+  if (num_warmup_runs == 0 || shape_specialization_max_sessions_ == 0) {
+    return Status::OK();
+  }
+
+  // the specialized sessions only get the default CPU EP, and the free dimension overrides are applied by a
+  // Level1 transformer
+  const char* reason = nullptr;
+  if (execution_providers_.NumProviders() != 1 || execution_providers_.Get(kCpuExecutionProvider) == nullptr) {
+    reason = "it uses execution providers other than the CPU execution provider";
+  } else if (session_options_.graph_optimization_level < TransformerLevel::Level1) {
+    reason = "graph optimizations are disabled";
+  }
+
+  // the model is reloaded by the specialized sessions, keep a copy if it can't be loaded from the file again
+  if (reason == nullptr && model_location_.empty()) {
+    const auto model_proto = model_->ToProto();
+    if (model_proto.ByteSizeLong() > static_cast<size_t>(std::numeric_limits<int>::max())) {
+      reason = "the model is too large to be kept in memory";
+    } else {
+      shape_specialization_model_bytes_ = model_proto.SerializeAsString();
+    }
+  }
+
+  if (reason != nullptr) {
+    LOGS(*session_logger_, WARNING) << "Shape specialization is disabled as " << reason << ".";
+    return Status::OK();
+  }
+
+  shape_specialization_warmup_runs_ = num_warmup_runs;
+  return Status::OK();
+}
+
+std::string InferenceSession::GetShapeSpecializationKey(gsl::span<const std::string> feed_names,
+                                                        gsl::span<const OrtValue> feeds) const {
+  std::map<std::string, int64_t> dim_values;
+  for (size_t i = 0, end = feed_names.size(); i < end; ++i) {
+    const auto input = input_def_map_.find(feed_names[i]);
+    if (input == input_def_map_.end() || !feeds[i].IsTensor()) {
+      continue;
+    }
+
+    const auto* shape = input->second.node_arg->Shape();
+    const auto& feed_shape = feeds[i].Get<Tensor>().Shape();
+    if (shape == nullptr || static_cast<size_t>(shape->dim_size()) != feed_shape.NumDimensions()) {
+      continue;
+    }
+
+    for (int j = 0, num_dims = shape->dim_size(); j < num_dims; ++j) {
+      const auto& dim = shape->dim(j);
+      if (!utils::HasDimParam(dim)) {
+        continue;
+      }
+
+      const auto inserted = dim_values.insert({dim.dim_param(), feed_shape[j]});
+      if (!inserted.second && inserted.first->second != feed_shape[j]) {
+        return {};
+      }
+    }
+  }
+
+  std::ostringstream key;
+  for (const auto& [dim_param, dim_value] : dim_values) {
+    key << dim_param << "=" << dim_value << ";";
+  }
+  return key.str();
+}
+
+InferenceSession* InferenceSession::GetShapeSpecializedSession(const std::string& key) {
+  std::lock_guard<OrtMutex> l(shape_specializations_mutex_);
+  const auto entry = shape_specializations_.find(key);
+  return entry != shape_specializations_.end() ? entry->second.session.get() : nullptr;
+}
+
+size_t InferenceSession::GetNumShapeSpecializedSessions() const {
+  std::lock_guard<OrtMutex> l(shape_specializations_mutex_);
+  return static_cast<size_t>(std::count_if(shape_specializations_.begin(), shape_specializations_.end(),
+                                           [](const auto& entry) { return entry.second.session != nullptr; }));
+}
+
+void InferenceSession::OnShapeSpecializationRun(const std::string& key) {
+  std::lock_guard<OrtMutex> l(shape_specializations_mutex_);
+  auto& entry = shape_specializations_[key];
+  if (entry.building || entry.failed || entry.session ||
+      ++entry.num_runs < shape_specialization_warmup_runs_ ||
+      num_shape_specialized_sessions_ >= shape_specialization_max_sessions_) {
+    return;
+  }
+
+  LOGS(*session_logger_, INFO) << "Building a shape specialized session for " << key;
+  entry.building = true;
+  ++num_shape_specialized_sessions_;
+  shape_specialization_threads_.emplace_back([this, key]() { BuildShapeSpecializedSession(key); });
+}
+
+void InferenceSession::BuildShapeSpecializedSession(const std::string& key) {
+  SessionOptions options = session_options_;
+  options.config_options.configurations[kOrtSessionOptionsShapeSpecializationWarmupRuns] = "0";
+  options.optimized_model_filepath.clear();
+  options.enable_profiling = false;
+  options.session_logid += "-" + key;
+
+  // keys are of the form "dim_param=value;"
+  std::istringstream dims(key);
+  std::string dim;
+  while (std::getline(dims, dim, ';')) {
+    const auto separator = dim.rfind('=');
+    options.free_dimension_overrides.push_back(
+        onnxruntime::FreeDimensionOverride{dim.substr(0, separator), onnxruntime::FreeDimensionOverrideType::Name,
+                                           std::stoll(dim.substr(separator + 1))});
+  }
+
+  std::unique_ptr<InferenceSession> session;
+  Status status = Status::OK();
+  ORT_TRY {
+    // the specialized session shares the thread pools and the pre-packed weights with this session
+    session = std::make_unique<InferenceSession>(options, environment_, GetIntraOpThreadPoolToUse(),
+                                                 GetInterOpThreadPoolToUse());
+    for (const auto& custom_registry : custom_registries_) {
+      if (status.IsOK()) {
+        status = session->RegisterCustomRegistry(custom_registry);
+      }
+    }
+    if (status.IsOK() && prepacked_weights_container_ != nullptr) {
+      status = session->AddPrePackedWeightsContainer(prepacked_weights_container_);
+    }
+    if (status.IsOK()) {
+      status = model_location_.empty()
+                   ? session->Load(shape_specialization_model_bytes_.data(),
+                                   static_cast<int>(shape_specialization_model_bytes_.size()))
+                   : session->Load(model_location_);
+    }
+    if (status.IsOK()) {
+      status = session->Initialize();
+    }
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, e.what());
+    });
+  }
+
+  std::lock_guard<OrtMutex> l(shape_specializations_mutex_);
+  auto& entry = shape_specializations_[key];
+  entry.building = false;
+  if (status.IsOK()) {
+    LOGS(*session_logger_, INFO) << "The shape specialized session for " << key << " is ready.";
+    entry.session = std::move(session);
+  } else {
+    // failures are not fatal as the runs keep using this session
+    LOGS(*session_logger_, WARNING) << "Failed to build the shape specialized session for " << key << ". "
+                                    << status.ErrorMessage();
+    entry.failed = true;
+    --num_shape_specialized_sessions_;
+  }
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 bool InferenceSession::IsInitialized() const {
   std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
   return is_inited_;
@@ -1235,6 +1794,8 @@ common::Status InferenceSession::Initialize() {
     env.GetTelemetryProvider().LogSessionCreationStart();
 
     bool have_cpu_ep = false;
+    PathString optimized_model_cache_path;
+    bool saving_to_optimized_model_cache = false;
 
     {
       std::lock_guard<onnxruntime::OrtMutex> initial_guard(session_mutex_);
@@ -1250,6 +1811,16 @@ common::Status InferenceSession::Initialize() {
       }
 
       have_cpu_ep = execution_providers_.Get(onnxruntime::kCpuExecutionProvider) != nullptr;
+
+#if !defined(ORT_MINIMAL_BUILD)
+      // replace the ONNX model with the previously optimized model if it's in the optimized model cache.
+      ORT_RETURN_IF_ERROR_SESSIONID_(GetOptimizedModelCachePath(optimized_model_cache_path));
+      if (!optimized_model_cache_path.empty()) {
+        bool loaded_from_cache = false;
+        ORT_RETURN_IF_ERROR_SESSIONID_(LoadFromOptimizedModelCache(optimized_model_cache_path, loaded_from_cache));
+        saving_to_optimized_model_cache = !loaded_from_cache;
+      }
+#endif  // !defined(ORT_MINIMAL_BUILD)
     }
 
     // Verify that there are no external initializers in the graph if external data is disabled.
@@ -1284,10 +1855,24 @@ common::Status InferenceSession::Initialize() {
     }
 #endif
 
+    bool use_env_allocators =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvAllocators, "0") == "1";
+
     // Ensure all registered EPs have created their allocators and shared them where possible.
     // Allocator creation may be delayed until IExecutionProvider::RegisterAllocator is called.
     {
       AllocatorManager allocator_manager;
+      if (use_env_allocators) {
+        // EPs that look up the AllocatorManager before creating an allocator (e.g. CUDA) pick up the shared
+        // allocators here, so they don't create an arena of their own that would only be replaced below.
+        for (const auto& shared_alloc : environment_.GetRegisteredSharedAllocators()) {
+          const auto& info = shared_alloc->Info();
+          if (!allocator_manager.GetAllocator(info.mem_type, info.device)) {
+            allocator_manager.InsertAllocator(shared_alloc);
+          }
+        }
+      }
+
       for (const auto& provider : execution_providers_) {
         provider->RegisterAllocator(allocator_manager);
       }
@@ -1308,13 +1893,18 @@ common::Status InferenceSession::Initialize() {
     //
     // NOTE: UpdateProvidersWithSharedAllocators is replace-only and will not insert a new allocator into the EP, so
     // it must be called after RegisterAllocator.
-    bool use_env_allocators =
-        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvAllocators, "0") == "1";
     if (use_env_allocators) {
       LOGS(*session_logger_, INFO) << "This session will use the allocator registered with the environment.";
       UpdateProvidersWithSharedAllocators();
     }
 
+    const bool use_env_initializer_store =
+        session_options_.config_options.GetConfigOrDefault(kOrtSessionOptionsConfigUseEnvInitializerStore, "0") == "1";
+    if (use_env_initializer_store && prepacked_weights_container_ == nullptr) {
+      // share the pre-packed forms of the deduplicated initializers too
+      prepacked_weights_container_ = &environment_.GetSharedInitializerStore().GetPrepackedWeightsContainer();
+    }
+
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
     TraceLoggingWriteStart(session_activity, "OrtInferenceSessionActivity");
     session_activity_started_ = true;
@@ -1361,14 +1951,19 @@ common::Status InferenceSession::Initialize() {
       }
       return false;
     }();
+    // the optimized model cache stores ORT format models so the graph is prepared as if saving one
+    const bool preparing_ort_format = saving_ort_format || saving_to_optimized_model_cache;
 
     if (!loading_ort_format) {
 #if !defined(ORT_MINIMAL_BUILD)
+      // decided before the graph is transformed as the specialized sessions may need to keep the original model
+      ORT_RETURN_IF_ERROR_SESSIONID_(InitializeShapeSpecialization());
+
       const auto minimal_build_opt_config_value = session_options_.config_options.GetConfigOrDefault(
           kOrtSessionOptionsConfigMinimalBuildOptimizations, "");
       MinimalBuildOptimizationHandling minimal_build_optimization_handling{};
       ORT_RETURN_IF_ERROR_SESSIONID_(GetMinimalBuildOptimizationHandling(minimal_build_opt_config_value,
-                                                                         saving_ort_format,
+                                                                         preparing_ort_format,
                                                                          minimal_build_optimization_handling));
 
       auto record_runtime_optimization_produced_op_schema = [this](const ONNX_NAMESPACE::OpSchema& op_schema) {
@@ -1412,43 +2007,49 @@ common::Status InferenceSession::Initialize() {
                                                     execution_providers_, kernel_registry_manager_,
                                                     insert_cast_transformer_,
                                                     *session_state_,
-                                                    saving_ort_format));
+                                                    preparing_ort_format));
 
       // now that all the transforms are done, call Resolve on the main graph. this will recurse into the subgraphs.
       ORT_RETURN_IF_ERROR_SESSIONID_(graph.Resolve());
 
-      // Currently only the CUDA EP is considered.
-      // If the CUDA EP is part of the providers list for this session AND
-      // The CUDA EP is configured to do a graph capture AND
-      // All the graph nodes have been assigned to the CUDA EP,
-      // Then the CUDA EP is cached for triggering a ReplayGraph() in Run().
-      auto* cuda_ep = execution_providers_.Get(onnxruntime::kCudaExecutionProvider);
-      if (cuda_ep && cuda_ep->IsGraphCaptureEnabled()) {
-        if (cuda_ep->IsGraphCaptureEnabled()) {
+      // Currently only the CUDA and ROCm EPs are considered.
+      // If the EP is part of the providers list for this session AND
+      // The EP is configured to do a graph capture AND
+      // All the graph nodes have been assigned to the EP,
+      // Then the EP is cached for triggering a ReplayGraph() in Run().
+      for (const auto* graph_capture_ep_type : {onnxruntime::kCudaExecutionProvider,
+                                                onnxruntime::kRocmExecutionProvider}) {
+        auto* graph_capture_ep = execution_providers_.Get(graph_capture_ep_type);
+        if (graph_capture_ep && graph_capture_ep->IsGraphCaptureEnabled()) {
           if (HasControlflowNodes(graph)) {
-            LOGS(*session_logger_, ERROR) << "This session cannot use the CUDA Graph feature as requested by the user "
-                                          << " as the model has control flow nodes which can't be supported by CUDA Graphs.";
+            LOGS(*session_logger_, ERROR) << "This session cannot use the graph capture feature of the "
+                                          << graph_capture_ep_type << " as requested by the user "
+                                          << " as the model has control flow nodes which can't be captured.";
 
             // Return error status as we don't want the session initialization to complete successfully
-            // if the user has requested usage of CUDA Graph feature and we cannot honor that.
+            // if the user has requested usage of the graph capture feature and we cannot honor that.
             ORT_RETURN_IF_ERROR_SESSIONID_(
                 ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
-                                "This session cannot use the CUDA Graph feature as requested by the user "
-                                " as the model has control flow nodes which can't be supported by CUDA Graphs."));
-          } else if (!AreAllNodesInMainGraphAssignedToOneEp(graph, onnxruntime::kCudaExecutionProvider)) {
-            LOGS(*session_logger_, ERROR) << "This session cannot use the CUDA Graph feature as requested by the user "
-                                          << " as all the graph nodes have not been partitioned to the CUDA EP.";
+                                "This session cannot use the graph capture feature of the ", graph_capture_ep_type,
+                                " as requested by the user as the model has control flow nodes which can't be"
+                                " captured."));
+          } else if (!AreAllNodesInMainGraphAssignedToOneEp(graph, graph_capture_ep_type)) {
+            LOGS(*session_logger_, ERROR) << "This session cannot use the graph capture feature of the "
+                                          << graph_capture_ep_type << " as requested by the user "
+                                          << " as all the graph nodes have not been partitioned to it.";
 
             // Return error status as we don't want the session initialization to complete successfully
-            // if the user has requested usage of CUDA Graph feature and we cannot honor that.
+            // if the user has requested usage of the graph capture feature and we cannot honor that.
             ORT_RETURN_IF_ERROR_SESSIONID_(
                 ORT_MAKE_STATUS(ONNXRUNTIME, FAIL,
-                                "This session cannot use the CUDA Graph feature as requested by the user "
-                                " as all the graph nodes have not been partitioned to the CUDA EP."));
+                                "This session cannot use the graph capture feature of the ", graph_capture_ep_type,
+                                " as requested by the user as all the graph nodes have not been partitioned to it."));
 
           } else {
-            LOGS(*session_logger_, INFO) << "This session will use the CUDA Graph feature as requested by the user.";
-            cached_execution_provider_for_graph_replay_.SetExecutionProvider(cuda_ep);
+            LOGS(*session_logger_, INFO) << "This session will use the graph capture feature of the "
+                                         << graph_capture_ep_type << " as requested by the user.";
+            cached_execution_provider_for_graph_replay_.SetExecutionProvider(graph_capture_ep);
+            break;
           }
         }
       }
@@ -1472,12 +2073,17 @@ common::Status InferenceSession::Initialize() {
 #endif  // !defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
     }
 
+    if (use_env_initializer_store) {
+      LOGS(*session_logger_, INFO) << "This session will share its initializers using the store of the environment.";
+      ORT_RETURN_IF_ERROR_SESSIONID_(AddInitializersFromEnvStore(graph));
+    }
+
     ORT_RETURN_IF_ERROR_SESSIONID_(
         session_state_->FinalizeSessionState(model_location_, kernel_registry_manager_,
                                              session_options_,
                                              // need to keep the initializers if saving the optimized model
-                                             !saving_model,
-                                             saving_ort_format));
+                                             !saving_model && !saving_to_optimized_model_cache,
+                                             preparing_ort_format));
 
 #if !defined(ORT_MINIMAL_BUILD)
     if (saving_model) {
@@ -1503,16 +2109,28 @@ common::Status InferenceSession::Initialize() {
         ORT_RETURN_IF_ERROR_SESSIONID_(Model::Save(*model_, session_options_.optimized_model_filepath));
       }
     }
+
+    if (saving_to_optimized_model_cache) {
+      SaveToOptimizedModelCache(optimized_model_cache_path);
+    }
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
     // Resolve memory pattern flags of the main graph and subgraph session states
     ResolveMemoryPatternFlags(*session_state_);
 
+    if (loading_ort_format && session_state_->GetEnableMemoryPattern()) {
+      const auto* fbs_session = fbs::GetInferenceSession(ort_format_model_bytes_.data());
+      if (const auto* fbs_memory_patterns = fbs_session->memory_patterns(); fbs_memory_patterns != nullptr) {
+        ORT_RETURN_IF_ERROR_SESSIONID_(session_state_->LoadMemoryPatternsFromOrtFormat(*fbs_memory_patterns));
+      }
+    }
+
     is_inited_ = true;
 
     if (!using_ort_model_bytes_for_initializers_) {
       ort_format_model_bytes_ = gsl::span<const uint8_t>();
       std::vector<uint8_t>().swap(ort_format_model_bytes_data_holder_);
+      ort_format_model_mapped_bytes_.reset();
     }
 
     // and log telemetry
@@ -1571,6 +2189,61 @@ void InferenceSession::UpdateProvidersWithSharedAllocators() {
   }
 }
 
+Status InferenceSession::AddInitializersFromEnvStore(const onnxruntime::Graph& graph) {
+  // the shared initializers are looked up by name in the subgraphs too, where a local initializer may shadow
+  // the one of the main graph. leave out the names used by any subgraph initializer.
+  InlinedHashSet<std::string_view> subgraph_initializer_names;
+  std::function<void(const Graph&)> collect_subgraph_initializer_names = [&](const Graph& g) {
+    for (const auto& node : g.Nodes()) {
+      for (const auto& subgraph : node.GetSubgraphs()) {
+        for (const auto& entry : subgraph->GetAllInitializedTensors()) {
+          subgraph_initializer_names.insert(entry.first);
+        }
+        collect_subgraph_initializer_names(*subgraph);
+      }
+    }
+  };
+  collect_subgraph_initializer_names(graph);
+
+  // the user supplied initializers are only used if they are on the planned device, so just consider the
+  // initializers consumed by CPU nodes
+  InlinedHashMap<std::string_view, bool> consumed_on_cpu_only;
+  for (const auto& node : graph.Nodes()) {
+    const bool on_cpu = node.GetExecutionProviderType() == kCpuExecutionProvider;
+    auto update = [&consumed_on_cpu_only, on_cpu](const NodeArg& arg) {
+      auto result = consumed_on_cpu_only.insert({arg.Name(), on_cpu});
+      result.first->second = result.first->second && on_cpu;
+    };
+    for (const auto* input_def : node.InputDefs()) {
+      update(*input_def);
+    }
+    for (const auto* implicit_input_def : node.ImplicitInputDefs()) {
+      update(*implicit_input_def);
+    }
+  }
+
+  auto& store = environment_.GetSharedInitializerStore();
+  size_t num_shared = 0;
+  for (const auto& [name, tensor_proto] : graph.GetAllInitializedTensors()) {
+    auto consumed = consumed_on_cpu_only.find(name);
+    if (consumed == consumed_on_cpu_only.end() || !consumed->second ||
+        tensor_proto->data_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING ||
+        subgraph_initializer_names.count(name) != 0 ||
+        session_options_.initializers_to_share_map.count(name) != 0) {
+      continue;
+    }
+
+    const OrtValue* value = nullptr;
+    ORT_RETURN_IF_ERROR(store.GetOrAdd(model_->ModelPath(), *tensor_proto, value));
+    session_options_.initializers_to_share_map[name] = value;
+    ++num_shared;
+  }
+
+  LOGS(*session_logger_, INFO) << "Shared " << num_shared << " initializers using the store of the environment, "
+                               << store.GetNumberOfInitializers() << " distinct initializers are stored.";
+  return Status::OK();
+}
+
 int InferenceSession::GetCurrentNumRuns() const {
   return current_num_runs_.load();
 }
@@ -1869,6 +2542,45 @@ struct ThreadPoolSpinningSwitch {
     }
   }
 };
+
+// Identifies the graph captured for a run in graph capturing mode, see kOrtRunOptionsConfigCudaGraphAnnotation.
+// Empty if the run must neither capture nor replay a graph.
+std::string GetGraphCaptureKey(const RunOptions& run_options, gsl::span<const OrtValue> feeds) {
+  const std::string annotation_id =
+      run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigCudaGraphAnnotation, "");
+  if (!annotation_id.empty()) {
+    return annotation_id == "-1" ? std::string{} : "id:" + annotation_id;
+  }
+
+  std::ostringstream key;
+  key << "shapes:";
+  for (const auto& feed : feeds) {
+    if (feed.IsTensor()) {
+      key << feed.Get<Tensor>().Shape();
+    } else {
+      key << "{?}";
+    }
+  }
+  return key.str();
+}
+
+// Parses the priority of the run set with kOrtRunOptionsConfigRunPriority, if any.
+Status ParseRunPriority(const RunOptions& run_options, std::optional<concurrency::ThreadPoolPriority>& priority) {
+  const std::string value = run_options.config_options.GetConfigOrDefault(kOrtRunOptionsConfigRunPriority, "");
+  if (value.empty()) {
+    priority.reset();
+  } else if (value == "low") {
+    priority = concurrency::ThreadPoolPriority::kLow;
+  } else if (value == "normal") {
+    priority = concurrency::ThreadPoolPriority::kNormal;
+  } else if (value == "high") {
+    priority = concurrency::ThreadPoolPriority::kHigh;
+  } else {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Invalid value '", value, "' for run option '",
+                           kOrtRunOptionsConfigRunPriority, "'. Expected one of: low, normal, high.");
+  }
+  return Status::OK();
+}
 }  // namespace
 
 Status InferenceSession::Run(const RunOptions& run_options,
@@ -1888,21 +2600,45 @@ Status InferenceSession::Run(const RunOptions& run_options,
   Status retval = Status::OK();
   const Env& env = Env::Default();
 
+#if !defined(ORT_MINIMAL_BUILD)
+  // Forward the run to the session specialized for the values of the symbolic input dims if it is ready.
+  std::string shape_specialization_key;
+  if (shape_specialization_warmup_runs_ > 0) {
+    shape_specialization_key = GetShapeSpecializationKey(feed_names, feeds);
+    if (!shape_specialization_key.empty()) {
+      if (auto* specialized_session = GetShapeSpecializedSession(shape_specialization_key)) {
+        return specialized_session->Run(run_options, feed_names, feeds, output_names, p_fetches,
+                                        p_fetches_device_info);
+      }
+    }
+  }
+#endif
+
+  // In graph capturing mode a graph is captured for each key and the runs are serialized.
+  const bool graph_capture_enabled = cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled();
+  std::string graph_key;
+  std::unique_lock<OrtMutex> graph_capture_lock;
+  if (graph_capture_enabled) {
+    graph_key = GetGraphCaptureKey(run_options, feeds);
+    graph_capture_lock = std::unique_lock<OrtMutex>(graph_capture_mutex_);
+  }
+  const bool replay_graph = graph_capture_enabled && cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_key);
+
   // Increment/decrement concurrent_num_runs_ and control
   // session threads spinning as configured. Do nothing for graph replay except the counter.
   const bool control_spinning = use_per_session_threads_ &&
                                 force_spinning_stop_between_runs_ &&
-                                !cached_execution_provider_for_graph_replay_.IsGraphCaptured();
+                                !replay_graph;
   auto* intra_tp = (control_spinning) ? thread_pool_.get() : nullptr;
   auto* inter_tp = (control_spinning) ? inter_op_thread_pool_.get() : nullptr;
   ThreadPoolSpinningSwitch runs_refcounter_and_tp_spin_control(intra_tp, inter_tp, current_num_runs_);
 
   // Check if this Run() is simply going to be a CUDA Graph replay.
-  if (cached_execution_provider_for_graph_replay_.IsGraphCaptured()) {
+  if (replay_graph) {
     LOGS(*session_logger_, INFO) << "Replaying the captured "
                                  << cached_execution_provider_for_graph_replay_.Type()
                                  << " CUDA Graph for this model with tag: " << run_options.run_tag;
-    ORT_RETURN_IF_ERROR_SESSIONID_(cached_execution_provider_for_graph_replay_.ReplayGraph());
+    ORT_RETURN_IF_ERROR_SESSIONID_(cached_execution_provider_for_graph_replay_.ReplayGraph(graph_key));
   } else {
     InlinedVector<IExecutionProvider*> exec_providers_to_stop;
     exec_providers_to_stop.reserve(execution_providers_.NumProviders());
@@ -1929,6 +2665,9 @@ Status InferenceSession::Run(const RunOptions& run_options,
         ORT_RETURN_IF_ERROR_SESSIONID_(ValidateAndParseShrinkArenaString(shrink_memory_arenas, arenas_to_shrink));
       }
 
+      std::optional<concurrency::ThreadPoolPriority> run_priority;
+      ORT_RETURN_IF_ERROR_SESSIONID_(ParseRunPriority(run_options, run_priority));
+
       FeedsFetchesInfo info(feed_names, output_names, session_state_->GetOrtValueNameIdxMap());
       FeedsFetchesManager feeds_fetches_manager{std::move(info)};
 
@@ -1956,6 +2695,10 @@ Status InferenceSession::Run(const RunOptions& run_options,
         sequential_run_lock.emplace(session_mutex_);
       }
 
+      if (graph_capture_enabled) {
+        cached_execution_provider_for_graph_replay_.SetGraphCaptureKey(graph_key);
+      }
+
       // info all execution providers InferenceSession:Run started
       // TODO: only call OnRunStart for all providers in-use
       for (auto& xp : execution_providers_) {
@@ -1985,6 +2728,16 @@ Status InferenceSession::Run(const RunOptions& run_options,
       session_state_->IncrementGraphExecutionCounter();
 #endif
 
+      // a clone runs the shared session state on its own thread pools
+      const ThreadPoolOverride thread_pool_override{GetIntraOpThreadPoolToUse(), GetInterOpThreadPoolToUse()};
+      SessionState::ThreadPoolOverrideScope thread_pool_override_scope(is_clone_ ? &thread_pool_override : nullptr);
+
+      // the tasks the thread pools run for the graph inherit the priority of the run
+      std::optional<concurrency::ThreadPool::PriorityScope> priority_scope;
+      if (run_priority.has_value()) {
+        priority_scope.emplace(*run_priority);
+      }
+
       ORT_CHECK_AND_SET_RETVAL(utils::ExecuteGraph(*session_state_, feeds_fetches_manager, feeds, *p_fetches,
                                                    session_options_.execution_mode, run_options.terminate, run_logger,
                                                    run_options.synchronize_execution_providers,
@@ -2040,16 +2793,78 @@ Status InferenceSession::Run(const RunOptions& run_options,
   // are needed before replaying the captured graph, here run the inference again
   // to capture the graph, so that users just need one session run to capture
   // the graph.
-  if (retval.IsOK() && cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled() &&
-      !cached_execution_provider_for_graph_replay_.IsGraphCaptured()) {
+  if (retval.IsOK() && graph_capture_enabled && !graph_key.empty() &&
+      !cached_execution_provider_for_graph_replay_.IsGraphCaptured(graph_key)) {
     LOGS(*session_logger_, INFO) << "Start the second Run() to capture the graph. "
                                     "The first one is for necessary memory allocation;"
                                     "The second one is for capturing the graph.";
+    graph_capture_lock.unlock();
     ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, p_fetches, p_fetches_device_info));
   }
+
+#if !defined(ORT_MINIMAL_BUILD)
+  if (retval.IsOK() && !shape_specialization_key.empty()) {
+    OnShapeSpecializationRun(shape_specialization_key);
+  }
+#endif
   return retval;
 }
 
+common::Status InferenceSession::RunAsync(const RunOptions* run_options, std::vector<std::string> feed_names,
+                                          std::vector<OrtValue> feeds, std::vector<std::string> output_names,
+                                          std::vector<OrtValue> fetches, RunAsyncCallback callback) {
+  auto* tp = GetInterOpThreadPoolToUse();
+  if (concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
+    tp = GetIntraOpThreadPoolToUse();
+  }
+  // Without a worker thread the run would be executed inline by the caller.
+  if (concurrency::ThreadPool::DegreeOfParallelism(tp) < 2) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "RunAsync requires the inter-op or the intra-op thread pool to have at least one "
+                           "worker thread, i.e. 2 or more threads.");
+  }
+
+  {
+    std::lock_guard<onnxruntime::OrtMutex> lock(async_runs_mutex_);
+    ++num_async_runs_;
+  }
+
+  concurrency::ThreadPool::Schedule(
+      tp, [this, run_options, feed_names = std::move(feed_names), feeds = std::move(feeds),
+           output_names = std::move(output_names), fetches = std::move(fetches),
+           callback = std::move(callback)]() mutable {
+        Status status;
+        ORT_TRY {
+          if (run_options != nullptr) {
+            status = Run(*run_options, feed_names, feeds, output_names, &fetches, nullptr);
+          } else {
+            RunOptions default_run_options;
+            status = Run(default_run_options, feed_names, feeds, output_names, &fetches, nullptr);
+          }
+        }
+        ORT_CATCH(const std::exception& ex) {
+          ORT_HANDLE_EXCEPTION([&]() {
+            status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+          });
+        }
+        ORT_CATCH(...) {
+          status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, "Unknown exception in RunAsync.");
+        }
+
+        // The session may be released as soon as the caller learns about the completion, so it must not be
+        // touched after this.
+        {
+          std::lock_guard<onnxruntime::OrtMutex> lock(async_runs_mutex_);
+          --num_async_runs_;
+          async_runs_cv_.notify_all();
+        }
+
+        callback(std::move(status), fetches);
+      });
+
+  return Status::OK();
+}
+
 common::Status InferenceSession::Run(const NameMLValMap& feeds, gsl::span<const std::string> output_names,
                                      std::vector<OrtValue>* p_fetches) {
   return Run(RunOptions(), feeds, output_names, p_fetches);
@@ -2181,10 +2996,213 @@ std::string InferenceSession::EndProfiling() {
   return std::string();
 }
 
+Status InferenceSession::SetSamplingProfilerExportCallback(profiling::SamplingExportCallback export_callback) {
+  auto* sampling_profiler = session_profiler_.GetSamplingProfiler();
+  ORT_RETURN_IF(sampling_profiler == nullptr, "The sampling profiler is not enabled. Set ",
+                kOrtSessionOptionsSamplingProfilerRate, " to enable it.");
+  sampling_profiler->SetExportCallback(std::move(export_callback));
+  return Status::OK();
+}
+
+Status InferenceSession::GetResourceStats(SessionResourceStats& stats) {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    ORT_RETURN_IF_NOT(is_inited_, "Session was not initialized");
+  }
+
+  std::lock_guard<OrtMutex> lock(resource_stats_mutex_);
+  stats = SessionResourceStats{};
+
+  for (BFCArena* arena : GetArenas()) {
+    AllocatorStats allocator_stats;
+    arena->GetStats(&allocator_stats);
+    stats.arena_peak_bytes_in_use += static_cast<size_t>(allocator_stats.max_bytes_in_use);
+    arena->ResetMaxBytesInUse();
+  }
+
+  auto* intra_op_thread_pool = GetIntraOpThreadPoolToUse();
+  const auto now = std::chrono::steady_clock::now();
+  if (intra_op_thread_pool != nullptr) {
+    if (resource_stats_start_.has_value()) {
+      const uint64_t busy_ns = intra_op_thread_pool->GetAverageWorkerBusyTimeNs();
+      const auto interval_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(now - *resource_stats_start_);
+      if (interval_ns.count() > 0) {
+        // a task is accounted for when it completes, so one that started in the previous interval can push
+        // the value slightly above 1
+        stats.intra_op_thread_pool_utilization =
+            std::min(1.0, static_cast<double>(busy_ns - resource_stats_start_busy_ns_) /
+                              static_cast<double>(interval_ns.count()));
+      }
+      resource_stats_start_busy_ns_ = busy_ns;
+    } else {
+      intra_op_thread_pool->EnableBusyTimeTracking();
+      resource_stats_start_busy_ns_ = intra_op_thread_pool->GetAverageWorkerBusyTimeNs();
+    }
+  }
+  resource_stats_start_ = now;
+
+  return Status::OK();
+}
+
+Status InferenceSession::PredictMemoryUsage(const InlinedHashMap<std::string, TensorShape>& input_shapes,
+                                            MemoryUsagePrediction& prediction) const {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    ORT_RETURN_IF_NOT(is_inited_, "Session was not initialized");
+  }
+
+  return session_state_->PredictMemoryUsage(input_shapes, prediction);
+}
+
+Status InferenceSession::Warmup(const RunOptions& run_options,
+                                gsl::span<const InlinedHashMap<std::string, TensorShape>> shape_sets,
+                                size_t num_runs_per_shape_set, WarmupStats& stats) {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    ORT_RETURN_IF_NOT(is_inited_, "Session was not initialized");
+  }
+  ORT_RETURN_IF(num_runs_per_shape_set == 0, "The number of runs per shape set must be at least 1.");
+
+  stats = WarmupStats{};
+  const auto arenas = GetArenas();
+  auto get_arena_stats = [&arenas]() {
+    AllocatorStats total;
+    for (BFCArena* arena : arenas) {
+      AllocatorStats allocator_stats;
+      arena->GetStats(&allocator_stats);
+      total.total_allocated_bytes += allocator_stats.total_allocated_bytes;
+      total.num_arena_extensions += allocator_stats.num_arena_extensions;
+    }
+    return total;
+  };
+  const AllocatorStats arena_stats_before = get_arena_stats();
+
+  std::vector<std::string> output_names;
+  output_names.reserve(output_def_list_.size());
+  for (const auto* output : output_def_list_) {
+    output_names.push_back(output->Name());
+  }
+
+  // the feeds are on the CPU, and copied to the devices of the nodes consuming them as in any run
+  const AllocatorPtr cpu_allocator = session_state_->GetAllocator(OrtDevice());
+  for (const auto& input_shapes : shape_sets) {
+    for (const auto& name : required_inputs_) {
+      ORT_RETURN_IF(input_shapes.find(name) == input_shapes.end(), "No shape for the input ", name, " of the model.");
+    }
+
+    std::vector<std::string> feed_names;
+    std::vector<OrtValue> feeds;
+    feed_names.reserve(input_shapes.size());
+    feeds.reserve(input_shapes.size());
+    for (const auto& [name, shape] : input_shapes) {
+      auto it = input_def_map_.find(name);
+      ORT_RETURN_IF(it == input_def_map_.end(), "Invalid input name: ", name);
+      ORT_RETURN_IF(it->second.ml_data_type == nullptr || !it->second.ml_data_type->IsTensorType(),
+                    "Warmup only supports tensor inputs, ", name, " is not a tensor.");
+
+      OrtValue feed;
+      Tensor::InitOrtValue(it->second.ml_data_type->AsTensorType()->GetElementType(), shape, cpu_allocator, feed);
+      auto* tensor = feed.GetMutable<Tensor>();
+      // string tensors are initialized to empty strings
+      if (!tensor->IsDataTypeString()) {
+        memset(tensor->MutableDataRaw(), 0, tensor->SizeInBytes());
+      }
+      feed_names.push_back(name);
+      feeds.push_back(std::move(feed));
+    }
+
+    WarmupStats::ShapeSetStats shape_set_stats;
+    for (size_t i = 0; i < num_runs_per_shape_set; ++i) {
+      const auto start = std::chrono::steady_clock::now();
+      std::vector<OrtValue> fetches;
+      ORT_RETURN_IF_ERROR(Run(run_options, feed_names, feeds, output_names, &fetches));
+      const double run_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      if (i == 0) {
+        shape_set_stats.first_run_ms = run_ms;
+      }
+      shape_set_stats.last_run_ms = run_ms;
+    }
+    stats.shape_sets.push_back(shape_set_stats);
+  }
+
+  const AllocatorStats arena_stats_after = get_arena_stats();
+  stats.arena_allocated_bytes = static_cast<size_t>(arena_stats_after.total_allocated_bytes);
+  // the extensions count down on shrinkage, which would make the difference negative
+  stats.arena_num_extensions = static_cast<size_t>(
+      std::max<int64_t>(arena_stats_after.num_arena_extensions - arena_stats_before.num_arena_extensions, 0));
+  return Status::OK();
+}
+
+Status InferenceSession::Clone(const SessionOptions& session_options,
+                               std::unique_ptr<InferenceSession>& clone) const {
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(session_mutex_);
+    ORT_RETURN_IF_NOT(is_inited_, "Session was not initialized");
+  }
+  // the kernels record their events in the profiler of the session state, which belongs to this session
+  ORT_RETURN_IF(session_options.enable_profiling, "Profiling is not supported for a cloned session.");
+  ORT_RETURN_IF_NOT(is_concurrent_run_supported_,
+                    "The execution providers of the session don't support concurrent runs, so it can't be cloned.");
+  ORT_RETURN_IF(cached_execution_provider_for_graph_replay_.IsGraphCaptureEnabled(),
+                "The session captures graphs, so it can't be cloned.");
+
+  // the execution mode also decides whether the clone gets an inter-op thread pool
+  SessionOptions clone_options = session_options;
+  clone_options.execution_mode = session_options_.execution_mode;
+  auto cloned_session = std::make_unique<InferenceSession>(clone_options, environment_);
+
+  const auto& provider_ids = execution_providers_.GetIds();
+  auto provider_id = provider_ids.begin();
+  for (const auto& provider : execution_providers_) {
+    ORT_RETURN_IF_ERROR(cloned_session->execution_providers_.Add(*provider_id++, provider));
+  }
+  cloned_session->execution_providers_.SetCpuProviderWasImplicitlyAdded(
+      execution_providers_.GetCpuProviderWasImplicitlyAdded());
+
+#if !defined(ORT_MINIMAL_BUILD) || defined(ORT_MINIMAL_BUILD_CUSTOM_OPS)
+  // the kernels of the custom ops are owned by the registries
+  cloned_session->custom_registries_ = custom_registries_;
+#endif
+  cloned_session->model_ = model_;
+  ORT_RETURN_IF_ERROR(cloned_session->SaveModelMetadata(*model_));
+  cloned_session->session_state_ = session_state_;
+  cloned_session->is_clone_ = true;
+
+  {
+    std::lock_guard<onnxruntime::OrtMutex> l(cloned_session->session_mutex_);
+    cloned_session->is_model_loaded_ = true;
+    cloned_session->is_inited_ = true;
+  }
+
+  LOGS(*session_logger_, INFO) << "Cloned the session to session " << cloned_session->session_id_;
+  clone = std::move(cloned_session);
+  return Status::OK();
+}
+
+InlinedVector<BFCArena*> InferenceSession::GetArenas() const {
+  // an arena may be shared by several execution providers
+  InlinedVector<BFCArena*> arenas;
+  InlinedHashSet<const IAllocator*> seen;
+  for (const auto& provider : execution_providers_) {
+    for (const auto& allocator : provider->GetAllocators()) {
+      if (allocator->Info().alloc_type == OrtAllocatorType::OrtArenaAllocator && seen.insert(allocator.get()).second) {
+        arenas.push_back(static_cast<BFCArena*>(allocator.get()));
+      }
+    }
+  }
+  return arenas;
+}
+
 const profiling::Profiler& InferenceSession::GetProfiling() const {
   return session_profiler_;
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+const InlinedVector<GraphTransformerStats>& InferenceSession::GetGraphTransformerStats() const {
+  return graph_transformation_mgr_.GetStats();
+}
+#endif
+
 AllocatorPtr InferenceSession::GetAllocator(const OrtMemoryInfo& mem_info) const {
   return session_state_->GetAllocator(mem_info);
 }
@@ -3,7 +3,11 @@
 
 #pragma once
 
+#include <chrono>
+#include <functional>
+#include <optional>
 #include <string>
+#include <thread>
 #include <unordered_map>
 
 #include "core/common/common.h"
@@ -27,6 +31,7 @@
 #include "core/language_interop_ops/language_interop_ops.h"
 #endif
 #ifdef ONNXRUNTIME_ENABLE_INSTRUMENT
+#include "core/platform/env.h"
 #include "core/platform/tracing.h"
 #include <TraceLoggingActivity.h>
 #endif
@@ -46,6 +51,7 @@ struct OrtCustomOpDomain {
 };
 
 namespace onnxruntime {
+class BFCArena;
 class IExecutionProvider;  // forward decl
 class IOBinding;
 class CustomRegistry;
@@ -78,6 +84,34 @@ struct ModelMetadata {
   std::unordered_map<std::string, std::string> custom_metadata_map;
 };
 
+/**
+ * Usage of the memory arenas and the intra-op thread pool of a session over an interval,
+ * see InferenceSession::GetResourceStats.
+ */
+struct SessionResourceStats {
+  // Sum over the memory arenas of the session of the highest number of bytes in use during the interval.
+  size_t arena_peak_bytes_in_use = 0;
+  // Fraction of the interval that the worker threads of the intra-op thread pool spent running tasks,
+  // averaged over the worker threads. 0 if the pool has no worker threads.
+  double intra_op_thread_pool_utilization = 0;
+};
+
+/**
+ * What the runs of InferenceSession::Warmup took, and how they grew the memory arenas of the session.
+ */
+struct WarmupStats {
+  struct ShapeSetStats {
+    double first_run_ms = 0;  // includes the arena extensions, kernel tuning and lazy initialization
+    double last_run_ms = 0;   // what a run with these shapes takes once the session is warm
+  };
+
+  std::vector<ShapeSetStats> shape_sets;  // in the order of the given shape sets
+  // Bytes allocated by the memory arenas of the session after the warmup, which later runs reuse.
+  size_t arena_allocated_bytes = 0;
+  // Number of times the memory arenas of the session were extended during the warmup.
+  size_t arena_num_extensions = 0;
+};
+
 /**
  * @brief This is the main class used to Run a model.
  * Sample simple usage:
@@ -332,6 +366,21 @@ class InferenceSession {
                      gsl::span<const std::string> output_names,
                      std::vector<OrtValue>* p_fetches) ORT_MUST_USE_RESULT;
 
+  using RunAsyncCallback = std::function<void(common::Status status, std::vector<OrtValue>& fetches)>;
+
+  /**
+   * Schedule a Run of a pre-loaded and pre-intialized model on the session's inter-op thread pool, or on the
+   * intra-op thread pool if there's no inter-op thread pool, and return without waiting for it.
+   * @param run_options use this to tune the Run call to your needs. Optional. If not null, it must remain valid
+   *        until the callback is invoked.
+   * @param callback invoked on a thread pool thread with the status of the Run and, if it succeeded, the fetches.
+   *        It must not release the session.
+   * @return OK if the Run was scheduled. Fails if neither thread pool has a worker thread to run it on.
+   */
+  common::Status RunAsync(const RunOptions* run_options, std::vector<std::string> feed_names,
+                          std::vector<OrtValue> feeds, std::vector<std::string> output_names,
+                          std::vector<OrtValue> fetches, RunAsyncCallback callback) ORT_MUST_USE_RESULT;
+
   /**
    * Creates a new binding object for binding inputs and outputs.
    * @param provider_type specifies the location where the inputs need to be potentially copied.
@@ -400,6 +449,14 @@ class InferenceSession {
    */
   int GetCurrentNumRuns() const;
 
+#if !defined(ORT_MINIMAL_BUILD)
+  /**
+   * Get the number of shape specialized sessions that are ready to be used by Run calls.
+   * See kOrtSessionOptionsShapeSpecializationWarmupRuns.
+   */
+  size_t GetNumShapeSpecializedSessions() const;
+#endif
+
   /**
    * Get the names of registered Execution Providers. The returned vector is ordered by Execution Provider
    * priority. The first provider in the vector has the highest priority.
@@ -448,6 +505,75 @@ class InferenceSession {
     */
   const profiling::Profiler& GetProfiling() const;
 
+  /**
+    * Replace the function the sampling profiler passes the node latencies to at the export interval
+    * (see kOrtSessionOptionsSamplingProfilerRate). The latencies can also be queried with
+    * GetProfiling().GetSamplingProfiler()->GetNodeLatencies().
+    @return an error if the sampling profiler is not enabled.
+    */
+  common::Status SetSamplingProfilerExportCallback(profiling::SamplingExportCallback export_callback);
+
+  /**
+    * Get the usage of the memory arenas and of the intra-op thread pool since the previous call, and start a new
+    * interval. The first call only starts the measurement of the thread pool utilization, which adds two clock reads
+    * per task that the pool runs, so its utilization is 0. Calling it after each Run gives per-run values when the
+    * runs don't overlap.
+    @param stats the usage since the previous call.
+    @return an error if the session is not initialized.
+    */
+  common::Status GetResourceStats(SessionResourceStats& stats);
+
+  /**
+    * Warm the session up before serving requests, by running it on synthetic inputs of zeros for each of the given
+    * sets of input shapes. The runs extend the memory arenas to what these shapes need, tune the kernels and fill
+    * the caches of the execution providers, e.g. the cuDNN algorithms and the memory patterns, initialize the lazily
+    * initialized kernels, and touch the pages of the weights. The parts of the model whose work depends on the values
+    * of its inputs are only warmed up for inputs of zeros.
+    @param run_options the options of the warmup runs.
+    @param shape_sets the shape of each input of the model by name, for each shape bucket to warm up.
+    @param num_runs_per_shape_set number of runs with each shape set, at least 1.
+    @param stats the duration of the runs and the growth of the arenas.
+    @return an error if the session is not initialized, an input is missing or isn't a tensor, or a run fails.
+    */
+  common::Status Warmup(const RunOptions& run_options,
+                        gsl::span<const InlinedHashMap<std::string, TensorShape>> shape_sets,
+                        size_t num_runs_per_shape_set, WarmupStats& stats);
+
+  /**
+    * Create a session that shares the initialized state of this session, i.e. the optimized graph, the kernels,
+    * the initializers and pre-packed weights and the execution providers with their allocators, so that it costs
+    * little time and memory. The clone runs the kernels on the thread pools of its own session options, and has its
+    * own logger and session id. The options that the graph was prepared with, like the optimization level and
+    * the execution mode, are the ones of this session.
+    * This session must outlive the clone.
+    @param session_options the options of the clone.
+    @param clone the created session, which is initialized.
+    @return an error if this session is not initialized, profiling is enabled for the clone, or the execution
+    providers of this session don't support concurrent runs or capture graphs.
+    */
+  common::Status Clone(const SessionOptions& session_options, std::unique_ptr<InferenceSession>& clone) const;
+
+  /**
+    * Predict the memory a run of the main graph needs for the given input shapes, without running any kernel, e.g.
+    * to decide how many sessions fit on a host before running them.
+    * The initializers are counted by location, and the activations are laid out as the memory pattern of a
+    * sequential run would, with their shapes inferred from the input shapes.
+    @param input_shapes the shape of each input of the model, by name.
+    @param prediction the predicted memory usage by location.
+    @return an error if the session is not initialized or an input is missing.
+    */
+  common::Status PredictMemoryUsage(const InlinedHashMap<std::string, TensorShape>& input_shapes,
+                                    MemoryUsagePrediction& prediction) const;
+
+#if !defined(ORT_MINIMAL_BUILD)
+  /**
+    * Get the statistics of the graph transformers: how often each was applied, how many nodes it added and removed,
+    * and the time spent in it. The graph transformers are applied in Initialize.
+    @return the statistics of the registered graph transformers, in registration order.
+    */
+  const InlinedVector<GraphTransformerStats>& GetGraphTransformerStats() const;
+#endif
+
 #if !defined(ORT_MINIMAL_BUILD) && defined(ORT_MEMORY_PROFILE)
   MemoryProfiler& GetMemoryProfiler() {
     return memory_profiler_;
@@ -568,6 +694,29 @@ class InferenceSession {
   }
 
   common::Status SaveToOrtFormat(const PathString& filepath) const;
+
+  // Optimized model cache (see kOrtSessionOptionsOptimizedModelCacheDir).
+  // The cache path is empty if the cache is not enabled or can't be used for this session.
+  common::Status GetOptimizedModelCachePath(PathString& cache_path) const ORT_MUST_USE_RESULT;
+  // Replaces the loaded ONNX model with the cached ORT format model if the cache contains it.
+  // Requires session_mutex_ to be held.
+  common::Status LoadFromOptimizedModelCache(const PathString& cache_path, bool& loaded) ORT_MUST_USE_RESULT;
+  // Failures are not fatal as the session can still be used. They are logged as warnings.
+  void SaveToOptimizedModelCache(const PathString& cache_path) const;
+
+  // Shape specialization (see kOrtSessionOptionsShapeSpecializationWarmupRuns).
+  // Decides at Initialize whether the session can be specialized and keeps what is needed to reload the model.
+  common::Status InitializeShapeSpecialization() ORT_MUST_USE_RESULT;
+  // Returns the values of the symbolic dims of the graph inputs for the feeds, e.g. "batch=1;seq=128;".
+  // Empty if the feeds bind no symbolic dim or bind one to different values.
+  std::string GetShapeSpecializationKey(gsl::span<const std::string> feed_names,
+                                        gsl::span<const OrtValue> feeds) const;
+  // Returns the specialized session for the key if it has been built, nullptr otherwise.
+  InferenceSession* GetShapeSpecializedSession(const std::string& key);
+  // Counts a successful run with the key and starts building the specialized session once the key is hot.
+  void OnShapeSpecializationRun(const std::string& key);
+  // Builds the specialized session for the key on the calling thread.
+  void BuildShapeSpecializedSession(const std::string& key);
 #endif
 
   /**
@@ -589,6 +738,9 @@ class InferenceSession {
 
   common::Status LoadOrtModelWithLoader(std::function<Status()> load_ort_format_model_bytes) ORT_MUST_USE_RESULT;
 
+  // Parse ort_format_model_bytes_ and create model_ from it. Requires session_mutex_ to be held.
+  common::Status LoadOrtModelFromBytes() ORT_MUST_USE_RESULT;
+
   // Create a Logger for a single execution if possible. Otherwise use the default logger.
   // If a new logger is created, it will also be stored in new_run_logger,
   // which must remain valid for the duration of the execution.
@@ -616,6 +768,10 @@ class InferenceSession {
   // Updates all providers with the allocators from the env based on OrtMemoryInfo
   void UpdateProvidersWithSharedAllocators();
 
+  // Replaces the initializers of the main graph consumed only by CPU nodes with the identical ones from the env's
+  // SharedInitializerStore, via the initializers_to_share_map of the session options.
+  common::Status AddInitializersFromEnvStore(const onnxruntime::Graph& graph) ORT_MUST_USE_RESULT;
+
   /*
    * Validate and parses the shrink arena request string from the user
    * List format: "device_0:device_id_0;device_1:device_id_1"
@@ -632,6 +788,9 @@ class InferenceSession {
    */
   void ShrinkMemoryArenas(gsl::span<const AllocatorPtr> arenas_to_shrink);
 
+  // Returns the memory arenas of the execution providers, each once as an arena may be shared by several of them.
+  InlinedVector<BFCArena*> GetArenas() const;
+
 #if !defined(ORT_MINIMAL_BUILD)
   virtual common::Status AddPredefinedTransformers(
       GraphTransformerManager& transformer_manager,
@@ -671,9 +830,12 @@ class InferenceSession {
   MemoryProfiler memory_profiler_;
 #endif
 
-  // Immutable state for each op in the model. Shared by all executors.
+  // Immutable state for each op in the model. Shared by all executors, and by the clones of this session.
   // It has a dependency on execution_providers_.
-  std::unique_ptr<SessionState> session_state_;
+  std::shared_ptr<SessionState> session_state_;
+
+  // Whether the session was created by Clone, and runs the shared session state on its own thread pools.
+  bool is_clone_ = false;
 
   // Threadpools per session. These are initialized and used for the entire duration of the session
   // when use_per_session_threads is true.
@@ -737,6 +899,11 @@ class InferenceSession {
   // Number of concurrently running executors
   std::atomic<int> current_num_runs_ = 0;
 
+  // Number of RunAsync calls that have not completed yet. The destructor waits for them.
+  onnxruntime::OrtMutex async_runs_mutex_;
+  onnxruntime::OrtCondVar async_runs_cv_;
+  int num_async_runs_ = 0;  // GUARDED_BY(async_runs_mutex_)
+
   mutable onnxruntime::OrtMutex session_mutex_;  // to ensure only one thread can invoke Load/Initialize
   bool is_model_loaded_ = false;                 // GUARDED_BY(session_mutex_)
   bool is_inited_ = false;                       // GUARDED_BY(session_mutex_)
@@ -798,6 +965,11 @@ class InferenceSession {
   // "session.use_ort_model_bytes_directly" to "1", this will be empty
   std::vector<uint8_t> ort_format_model_bytes_data_holder_;
 
+  // This holds the mapping of the model file if the session was started with a model_uri and the caller set the
+  // session config option "session.memory_map_ort_model" to "1". The initializers refer to it, so it is kept until
+  // the InferenceSession goes away.
+  Env::MappedMemoryPtr ort_format_model_mapped_bytes_;
+
   bool using_ort_model_bytes_for_initializers_{false};
 
   // Container to store pre-packed weights to share between sessions.
@@ -822,18 +994,25 @@ class InferenceSession {
       return cached_execution_provider_for_graph_replay_ != nullptr && cached_execution_provider_for_graph_replay_->IsGraphCaptureEnabled();
     }
 
-    bool IsGraphCaptured() const {
-      return cached_execution_provider_for_graph_replay_ != nullptr && cached_execution_provider_for_graph_replay_->IsGraphCaptured();
+    bool IsGraphCaptured(const std::string& graph_key) const {
+      return cached_execution_provider_for_graph_replay_ != nullptr &&
+             cached_execution_provider_for_graph_replay_->IsGraphCaptured(graph_key);
     }
 
-    Status ReplayGraph() {
-      ORT_ENFORCE(IsGraphCaptured());
+    Status ReplayGraph(const std::string& graph_key) {
+      ORT_ENFORCE(IsGraphCaptured(graph_key));
       if (cached_execution_provider_for_graph_replay_) {
-        return cached_execution_provider_for_graph_replay_->ReplayGraph();
+        return cached_execution_provider_for_graph_replay_->ReplayGraph(graph_key);
       }
       return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Cached EP instance for graph replay is not set yet before calling ReplayGraph()");
     }
 
+    void SetGraphCaptureKey(const std::string& graph_key) {
+      if (cached_execution_provider_for_graph_replay_) {
+        cached_execution_provider_for_graph_replay_->SetGraphCaptureKey(graph_key);
+      }
+    }
+
     const std::string& Type() const {
       return cached_execution_provider_for_graph_replay_->Type();
     }
@@ -842,6 +1021,35 @@ class InferenceSession {
   };
 
   CachedExecutionProviderForGraphReplay cached_execution_provider_for_graph_replay_;
+
+  // Serializes the runs in graph capturing mode as the captured graphs share the stream of the execution provider
+  OrtMutex graph_capture_mutex_;
+
+  // Start of the current interval of GetResourceStats, and the busy time of the intra-op thread pool at that time.
+  OrtMutex resource_stats_mutex_;
+  std::optional<std::chrono::steady_clock::time_point> resource_stats_start_;  // GUARDED_BY(resource_stats_mutex_)
+  uint64_t resource_stats_start_busy_ns_ = 0;                                  // GUARDED_BY(resource_stats_mutex_)
+
+#if !defined(ORT_MINIMAL_BUILD)
+  // Sessions of the model specialized for the values of its symbolic input dims.
+  // A specialized session is built in the background once the same values were seen in
+  // shape_specialization_warmup_runs_ runs and then serves the runs with these values.
+  struct ShapeSpecialization {
+    size_t num_runs = 0;
+    bool building = false;
+    bool failed = false;
+    std::unique_ptr<InferenceSession> session;
+  };
+
+  size_t shape_specialization_warmup_runs_ = 0;  // 0 if shape specialization is disabled
+  size_t shape_specialization_max_sessions_ = 0;
+  std::string shape_specialization_model_bytes_;  // the serialized model if it was not loaded from a file
+  // the members below are GUARDED_BY(shape_specializations_mutex_)
+  mutable OrtMutex shape_specializations_mutex_;
+  std::unordered_map<std::string, ShapeSpecialization> shape_specializations_;
+  size_t num_shape_specialized_sessions_ = 0;  // built or being built
+  std::vector<std::thread> shape_specialization_threads_;
+#endif
 };
 
 struct SessionIOBinding {
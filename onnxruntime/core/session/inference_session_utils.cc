@@ -5,6 +5,8 @@
 
 #include "core/session/inference_session_utils.h"
 
+#include <fstream>
+
 namespace onnxruntime {
 
 //---------------------
@@ -227,6 +229,54 @@ Status JsonConfigParser::ParseRunOptionsFromModelProto(RunOptions& /*run_options
                          "Parsing RunOptions from ModelProto is not supported yet");
 }
 
+Status LoadPartitioningCostModelFromProfile(const PathString& profile_file, PartitioningCostModel& cost_model) {
+  std::ifstream stream(profile_file);
+  ORT_RETURN_IF_NOT(stream.good(), "Failed to open the profile file ", ToUTF8String(profile_file));
+
+  json events;
+  auto status = Status::OK();
+  ORT_TRY {
+    events = json::parse(stream);
+  }
+  ORT_CATCH(const std::exception& e) {
+    ORT_HANDLE_EXCEPTION([&]() {
+      status = ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "Failed to parse the profile file ",
+                               ToUTF8String(profile_file), ". Error message: ", e.what());
+    });
+  }
+  ORT_RETURN_IF_ERROR(status);
+  ORT_RETURN_IF_NOT(events.is_array(), "The profile file ", ToUTF8String(profile_file), " is not a list of events.");
+
+  // total latency and number of node runs per op type and EP
+  InlinedHashMap<std::string, InlinedHashMap<std::string, std::pair<double, size_t>>> latencies;
+  for (const auto& event : events) {
+    // the SequentialExecutor records an event with the kernel time of each node run
+    if (!event.is_object() || event.value("cat", "") != "Node" || !event.contains("dur") ||
+        !event["dur"].is_number() || !event.contains("args") || !event["args"].is_object()) {
+      continue;
+    }
+
+    const auto& args = event["args"];
+    const std::string op_type = args.value("op_name", "");
+    const std::string provider = args.value("provider", "");
+    if (op_type.empty() || provider.empty()) {
+      continue;
+    }
+
+    auto& entry = latencies[op_type][provider];
+    entry.first += event["dur"].get<double>();
+    ++entry.second;
+  }
+
+  for (const auto& op_entry : latencies) {
+    for (const auto& ep_entry : op_entry.second) {
+      cost_model.op_costs[op_entry.first][ep_entry.first] = ep_entry.second.first / ep_entry.second.second;
+    }
+  }
+
+  return Status::OK();
+}
+
 }  // namespace inference_session_utils
 }  // namespace onnxruntime
 
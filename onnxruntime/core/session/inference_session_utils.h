@@ -13,6 +13,8 @@
 #include "core/session/inference_session.h"
 #include "core/framework/session_options.h"
 #include "core/common/common.h"
+#include "core/common/path_string.h"
+#include "core/framework/graph_partitioner.h"
 #include "nlohmann/json.hpp"
 using json = nlohmann::json;
 #endif
@@ -56,6 +58,10 @@ class JsonConfigParser {
   bool is_ort_config_json_available_ = false;
 };
 
+// Read the average node latencies per op type and execution provider from a profile file written by the session
+// profiler into cost_model.op_costs.
+Status LoadPartitioningCostModelFromProfile(const PathString& profile_file, PartitioningCostModel& cost_model);
+
 #endif  // !defined(ORT_MINIMAL_BUILD)
 
 }  // namespace inference_session_utils
@@ -6,6 +6,7 @@
 #include "core/session/inference_session_utils.h"
 #include "core/session/IOBinding.h"
 #include "core/framework/allocator.h"
+#include "core/framework/bfc_arena.h"
 #include "core/framework/error_code_helper.h"
 #include "core/framework/execution_provider.h"
 #include "core/framework/tensor_type_and_shape.h"
@@ -768,16 +769,14 @@ ORT_API_STATUS_IMPL(OrtApis::CreateSessionFromArray, _In_ const OrtEnv* env, _In
   API_IMPL_END
 }
 
-ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
-                    _In_reads_(input_len) const char* const* input_names,
-                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
-                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
-                    _Inout_updates_all_(output_names_len) OrtValue** output) {
-  API_IMPL_BEGIN
-  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
-
-  std::vector<std::string> feed_names(input_len);
-  std::vector<OrtValue> feeds(input_len);
+namespace {
+// Validates the arguments of OrtApis::Run/RunAsync and copies them into the containers InferenceSession expects.
+OrtStatus* CollectRunArgs(const char* const* input_names, const OrtValue* const* input, size_t input_len,
+                          const char* const* output_names1, size_t output_names_len, OrtValue* const* output,
+                          std::vector<std::string>& feed_names, std::vector<OrtValue>& feeds,
+                          std::vector<std::string>& output_names, std::vector<OrtValue>& fetches) {
+  feed_names.resize(input_len);
+  feeds.resize(input_len);
 
   for (size_t i = 0; i != input_len; ++i) {
     if (input_names[i] == nullptr || input_names[i][0] == '\0') {
@@ -795,7 +794,7 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
   }
 
   // Create output feed
-  std::vector<std::string> output_names(output_names_len);
+  output_names.resize(output_names_len);
   for (size_t i = 0; i != output_names_len; ++i) {
     if (output_names1[i] == nullptr || output_names1[i][0] == '\0') {
       return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "output name cannot be empty");
@@ -803,13 +802,45 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
     output_names[i] = output_names1[i];
   }
 
-  std::vector<OrtValue> fetches(output_names_len);
+  fetches.resize(output_names_len);
   for (size_t i = 0; i != output_names_len; ++i) {
     if (output[i] != nullptr) {
       ::OrtValue& value = *(output[i]);
       fetches[i] = value;
     }
   }
+  return nullptr;
+}
+
+// Hands the fetches the caller did not pre-allocate over to the caller.
+void ReturnFetches(std::vector<OrtValue>& fetches, OrtValue** output) {
+  for (size_t i = 0, end = fetches.size(); i != end; ++i) {
+    ::OrtValue& value = fetches[i];
+    if (output[i] == nullptr) {
+      GSL_SUPPRESS(r .11)
+      output[i] = new OrtValue(value);
+    }
+  }
+}
+}  // namespace
+
+ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  std::vector<std::string> output_names;
+  std::vector<OrtValue> fetches;
+  if (auto* arg_status = CollectRunArgs(input_names, input, input_len, output_names1, output_names_len, output,
+                                        feed_names, feeds, output_names, fetches)) {
+    return arg_status;
+  }
+
   Status status;
   if (run_options == nullptr) {
     OrtRunOptions op;
@@ -820,12 +851,54 @@ ORT_API_STATUS_IMPL(OrtApis::Run, _Inout_ OrtSession* sess, _In_opt_ const OrtRu
 
   if (!status.IsOK())
     return ToOrtStatus(status);
-  for (size_t i = 0; i != output_names_len; ++i) {
-    ::OrtValue& value = fetches[i];
-    if (output[i] == nullptr) {
-      GSL_SUPPRESS(r .11)
-      output[i] = new OrtValue(value);
+  ReturnFetches(fetches, output);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names1, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data) {
+  API_IMPL_BEGIN
+  if (run_async_callback == nullptr) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "run_async_callback cannot be null");
+  }
+
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  std::vector<std::string> output_names;
+  std::vector<OrtValue> fetches;
+  if (auto* arg_status = CollectRunArgs(input_names, input, input_len, output_names1, output_names_len, output,
+                                        feed_names, feeds, output_names, fetches)) {
+    return arg_status;
+  }
+
+  auto callback = [output, run_async_callback, user_data](Status status, std::vector<OrtValue>& run_fetches) {
+    if (!status.IsOK()) {
+      run_async_callback(user_data, output, 0, ToOrtStatus(status));
+      return;
+    }
+    OrtStatus* fetch_status = nullptr;
+    ORT_TRY {
+      ReturnFetches(run_fetches, output);
+    }
+    ORT_CATCH(const std::exception& ex) {
+      ORT_HANDLE_EXCEPTION([&]() {
+        fetch_status = OrtApis::CreateStatus(ORT_RUNTIME_EXCEPTION, ex.what());
+      });
     }
+    run_async_callback(user_data, output, fetch_status == nullptr ? run_fetches.size() : 0, fetch_status);
+  };
+
+  auto status = session->RunAsync(run_options, std::move(feed_names), std::move(feeds), std::move(output_names),
+                                  std::move(fetches), std::move(callback));
+  if (!status.IsOK()) {
+    return ToOrtStatus(status);
   }
   return nullptr;
   API_IMPL_END
@@ -1314,6 +1387,129 @@ ORT_API_STATUS_IMPL(OrtApis::SessionEndProfiling, _In_ OrtSession* sess, _Inout_
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionGetResourceStats, _Inout_ OrtSession* sess, _Out_ size_t* arena_peak_bytes_in_use,
+                    _Out_ double* intra_op_thread_pool_utilization) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  onnxruntime::SessionResourceStats stats;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->GetResourceStats(stats));
+  *arena_peak_bytes_in_use = stats.arena_peak_bytes_in_use;
+  *intra_op_thread_pool_utilization = stats.intra_op_thread_pool_utilization;
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionPredictMemoryUsage, _In_ const OrtSession* sess,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const int64_t* const* input_shapes,
+                    _In_reads_(input_len) const size_t* input_shape_lens, size_t input_len,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** prediction) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  onnxruntime::InlinedHashMap<std::string, onnxruntime::TensorShape> shapes;
+  shapes.reserve(input_len);
+  for (size_t i = 0; i < input_len; ++i) {
+    shapes.emplace(input_names[i], onnxruntime::TensorShape(input_shapes[i], input_shape_lens[i]));
+  }
+
+  onnxruntime::MemoryUsagePrediction memory_usage;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->PredictMemoryUsage(shapes, memory_usage));
+  std::ostringstream json;
+  json << "{\"locations\": [";
+  for (size_t i = 0; i < memory_usage.locations.size(); ++i) {
+    const auto& usage = memory_usage.locations[i];
+    json << (i == 0 ? "" : ", ") << "{\"name\": \"" << usage.location.name
+         << "\", \"device_id\": " << usage.location.id
+         << ", \"mem_type\": " << static_cast<int>(usage.location.mem_type)
+         << ", \"initializer_bytes\": " << usage.initializer_bytes
+         << ", \"peak_activation_bytes\": " << usage.peak_activation_bytes << "}";
+  }
+  json << "], \"num_unresolved_tensors\": " << memory_usage.num_unresolved_tensors << "}";
+  *prediction = StrDup(json.str(), allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::SessionWarmup, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(num_shape_sets* input_len) const int64_t* const* input_shapes,
+                    _In_reads_(num_shape_sets* input_len) const size_t* input_shape_lens, size_t num_shape_sets,
+                    size_t num_runs_per_shape_set, _Inout_ OrtAllocator* allocator, _Outptr_ char** stats) {
+  API_IMPL_BEGIN
+  auto session = reinterpret_cast<::onnxruntime::InferenceSession*>(sess);
+  std::vector<onnxruntime::InlinedHashMap<std::string, onnxruntime::TensorShape>> shape_sets(num_shape_sets);
+  for (size_t s = 0; s < num_shape_sets; ++s) {
+    shape_sets[s].reserve(input_len);
+    for (size_t i = 0; i < input_len; ++i) {
+      const size_t index = s * input_len + i;
+      shape_sets[s].emplace(input_names[i], onnxruntime::TensorShape(input_shapes[index], input_shape_lens[index]));
+    }
+  }
+
+  onnxruntime::WarmupStats warmup_stats;
+  OrtRunOptions default_run_options;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(session->Warmup(run_options == nullptr ? default_run_options : *run_options,
+                                                  shape_sets, num_runs_per_shape_set, warmup_stats));
+  std::ostringstream json;
+  json << "{\"shape_sets\": [";
+  for (size_t i = 0; i < warmup_stats.shape_sets.size(); ++i) {
+    json << (i == 0 ? "" : ", ") << "{\"first_run_ms\": " << warmup_stats.shape_sets[i].first_run_ms
+         << ", \"last_run_ms\": " << warmup_stats.shape_sets[i].last_run_ms << "}";
+  }
+  json << "], \"arena_allocated_bytes\": " << warmup_stats.arena_allocated_bytes
+       << ", \"arena_num_extensions\": " << warmup_stats.arena_num_extensions << "}";
+  *stats = StrDup(json.str(), allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::CloneSession, _In_ const OrtSession* sess, _In_opt_ const OrtSessionOptions* options,
+                    _Outptr_ OrtSession** out) {
+  API_IMPL_BEGIN
+  *out = nullptr;
+  auto session = reinterpret_cast<const ::onnxruntime::InferenceSession*>(sess);
+  std::unique_ptr<onnxruntime::InferenceSession> clone;
+  ORT_API_RETURN_IF_STATUS_NOT_OK(
+      session->Clone(options == nullptr ? onnxruntime::SessionOptions() : options->value, clone));
+  *out = reinterpret_cast<OrtSession*>(clone.release());
+  return nullptr;
+  API_IMPL_END
+}
+
+ORT_API_STATUS_IMPL(OrtApis::AllocatorGetArenaStats, _In_ const OrtAllocator* allocator, _In_ int reset_window,
+                    _Inout_ OrtAllocator* string_allocator, _Outptr_ char** stats) {
+  API_IMPL_BEGIN
+  const auto* wrapper = onnxruntime::OrtAllocatorImplWrappingIAllocator::FromOrtAllocator(allocator);
+  if (wrapper == nullptr || wrapper->WrappedIAllocator()->Info().alloc_type != OrtArenaAllocator) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "The allocator is not an arena allocator of onnxruntime");
+  }
+
+  auto* arena = static_cast<onnxruntime::BFCArena*>(wrapper->WrappedIAllocator().get());
+  onnxruntime::AllocatorStats allocator_stats;
+  arena->GetStats(&allocator_stats);
+  onnxruntime::ArenaFragmentationStats fragmentation;
+  arena->GetFragmentationStats(&fragmentation, reset_window != 0);
+
+  std::ostringstream json;
+  json << "{\"num_regions\": " << fragmentation.num_regions
+       << ", \"region_bytes\": " << fragmentation.region_bytes
+       << ", \"bytes_in_use\": " << allocator_stats.bytes_in_use
+       << ", \"free_bytes\": " << fragmentation.free_bytes
+       << ", \"largest_free_chunk_bytes\": " << fragmentation.largest_free_chunk_bytes
+       << ", \"window_num_allocs\": " << fragmentation.window_num_allocs << ", \"bins\": [";
+  for (size_t i = 0; i < fragmentation.bins.size(); ++i) {
+    const auto& bin = fragmentation.bins[i];
+    json << (i == 0 ? "" : ", ") << "{\"bin_size\": " << bin.bin_size
+         << ", \"num_free_chunks\": " << bin.num_free_chunks
+         << ", \"free_bytes\": " << bin.free_bytes
+         << ", \"num_allocs\": " << bin.num_allocs << "}";
+  }
+  json << "]}";
+  *stats = StrDup(json.str(), string_allocator);
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API_STATUS_IMPL(OrtApis::SessionGetModelMetadata, _In_ const OrtSession* sess,
                     _Outptr_ OrtModelMetadata** out) {
   API_IMPL_BEGIN
@@ -2167,6 +2363,19 @@ ORT_API_STATUS_IMPL(OrtApis::CreateArenaCfgV2, _In_reads_(num_keys) const char*
       cfg->max_dead_bytes_per_chunk = static_cast<int>(arena_config_values[i]);
     } else if (strcmp(arena_config_keys[i], "initial_growth_chunk_size_bytes") == 0) {
       cfg->initial_growth_chunk_size_bytes = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "thread_cache_max_chunk_bytes") == 0) {
+      cfg->thread_cache_max_chunk_bytes = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "shrink_idle_ms") == 0) {
+      cfg->shrink_idle_ms = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "shrink_low_usage_percent") == 0) {
+      if (arena_config_values[i] > 100) {
+        return CreateStatus(ORT_INVALID_ARGUMENT, "shrink_low_usage_percent must be at most 100");
+      }
+      cfg->shrink_low_usage_percent = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "shrink_window_ms") == 0) {
+      cfg->shrink_window_ms = static_cast<int>(arena_config_values[i]);
+    } else if (strcmp(arena_config_keys[i], "shrink_retain_bytes") == 0) {
+      cfg->shrink_retain_bytes = arena_config_values[i];
     } else {
       std::ostringstream oss;
       oss << "Invalid key found: " << arena_config_keys[i];
@@ -2276,6 +2485,15 @@ ORT_API_STATUS_IMPL(OrtApis::SessionOptionsSetCustomJoinThreadFn, _Inout_ OrtSes
   API_IMPL_END
 }
 
+ORT_API_STATUS_IMPL(OrtApis::SessionOptionsSetCustomScheduler, _Inout_ OrtSessionOptions* options,
+                    _In_opt_ OrtCustomScheduleFn ort_custom_schedule_fn, _In_opt_ void* ort_custom_scheduler_param) {
+  API_IMPL_BEGIN
+  options->value.custom_schedule_fn = ort_custom_schedule_fn;
+  options->value.custom_scheduler_param = ort_custom_scheduler_param;
+  return nullptr;
+  API_IMPL_END
+}
+
 ORT_API(const OrtTrainingApi*, OrtApis::GetTrainingApi, uint32_t version) {
 #ifdef ENABLE_TRAINING_ON_DEVICE
   return OrtTrainingApis::GetTrainingApi(version);
@@ -2610,6 +2828,16 @@ static constexpr OrtApi ort_api_1_to_14 = {
     &OrtApis::MemoryInfoGetDeviceType,
     &OrtApis::UpdateEnvWithCustomLogLevel,
     &OrtApis::SetGlobalIntraOpThreadAffinity,
+    &OrtApis::RunAsync,
+    &OrtApis::SessionGetResourceStats,
+    &OrtApis::SessionOptionsSetCustomScheduler,
+    &OrtApis::SetGlobalCustomScheduler,
+    &OrtApis::SessionPredictMemoryUsage,
+    &OrtApis::AllocatorGetArenaStats,
+    &OrtApis::SessionWarmup,
+    &OrtApis::CloneSession,
+    &OrtApis::KernelContext_GetInputs,
+    &OrtApis::KernelContext_GetOutputs,
 };
 
 // Asserts to do a some checks to ensure older Versions of the OrtApi never change (will detect an addition or deletion but not if they cancel out each other)
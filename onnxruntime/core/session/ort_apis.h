@@ -406,4 +406,36 @@ ORT_API(void, MemoryInfoGetDeviceType, _In_ const OrtMemoryInfo* ptr, _Out_ OrtM
 ORT_API_STATUS_IMPL(UpdateEnvWithCustomLogLevel, _In_ OrtEnv* ort_env, OrtLoggingLevel log_severity_level);
 
 ORT_API_STATUS_IMPL(SetGlobalIntraOpThreadAffinity, _Inout_ OrtThreadingOptions* tp_options, const char* affinity_string);
+ORT_API_STATUS_IMPL(RunAsync, _Inout_ OrtSession* sess, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const OrtValue* const* input, size_t input_len,
+                    _In_reads_(output_names_len) const char* const* output_names, size_t output_names_len,
+                    _Inout_updates_all_(output_names_len) OrtValue** output,
+                    _In_ RunAsyncCallbackFn run_async_callback, _In_opt_ void* user_data);
+ORT_API_STATUS_IMPL(SessionGetResourceStats, _Inout_ OrtSession* sess, _Out_ size_t* arena_peak_bytes_in_use,
+                    _Out_ double* intra_op_thread_pool_utilization);
+ORT_API_STATUS_IMPL(SessionOptionsSetCustomScheduler, _Inout_ OrtSessionOptions* options,
+                    _In_opt_ OrtCustomScheduleFn ort_custom_schedule_fn, _In_opt_ void* ort_custom_scheduler_param);
+ORT_API_STATUS_IMPL(SetGlobalCustomScheduler, _Inout_ OrtThreadingOptions* tp_options,
+                    _In_opt_ OrtCustomScheduleFn ort_custom_schedule_fn, _In_opt_ void* ort_custom_scheduler_param);
+ORT_API_STATUS_IMPL(SessionPredictMemoryUsage, _In_ const OrtSession* session,
+                    _In_reads_(input_len) const char* const* input_names,
+                    _In_reads_(input_len) const int64_t* const* input_shapes,
+                    _In_reads_(input_len) const size_t* input_shape_lens, size_t input_len,
+                    _Inout_ OrtAllocator* allocator, _Outptr_ char** prediction);
+ORT_API_STATUS_IMPL(AllocatorGetArenaStats, _In_ const OrtAllocator* allocator, _In_ int reset_window,
+                    _Inout_ OrtAllocator* string_allocator, _Outptr_ char** stats);
+ORT_API_STATUS_IMPL(SessionWarmup, _Inout_ OrtSession* session, _In_opt_ const OrtRunOptions* run_options,
+                    _In_reads_(input_len) const char* const* input_names, size_t input_len,
+                    _In_reads_(num_shape_sets* input_len) const int64_t* const* input_shapes,
+                    _In_reads_(num_shape_sets* input_len) const size_t* input_shape_lens, size_t num_shape_sets,
+                    size_t num_runs_per_shape_set, _Inout_ OrtAllocator* allocator, _Outptr_ char** stats);
+ORT_API_STATUS_IMPL(CloneSession, _In_ const OrtSession* session, _In_opt_ const OrtSessionOptions* options,
+                    _Outptr_ OrtSession** out);
+ORT_API_STATUS_IMPL(KernelContext_GetInputs, _In_ const OrtKernelContext* context,
+                    _Out_writes_all_(num_values) const OrtValue** values, size_t num_values);
+ORT_API_STATUS_IMPL(KernelContext_GetOutputs, _Inout_ OrtKernelContext* context,
+                    _In_reads_(num_values) const int64_t* const* dim_values,
+                    _In_reads_(num_values) const size_t* dim_counts, size_t num_values,
+                    _Out_writes_all_(num_values) OrtValue** values);
 }  // namespace OrtApis
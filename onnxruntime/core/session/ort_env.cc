@@ -10,7 +10,9 @@
 #include "core/session/environment.h"
 #include "core/session/allocator_adapters.h"
 #include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/async_sink.h"
 #include "core/framework/provider_shutdown.h"
+#include "core/platform/env_var_utils.h"
 #include "core/platform/logging/make_platform_default_log_sink.h"
 
 using namespace onnxruntime;
@@ -20,6 +22,11 @@ std::unique_ptr<OrtEnv> OrtEnv::p_instance_;
 int OrtEnv::ref_count_ = 0;
 onnxruntime::OrtMutex OrtEnv::m_;
 
+namespace {
+// Environment variable that enables AsyncSink for the default logger. See OrtEnv::GetInstance.
+constexpr const char* kAsyncLoggingBufferSize = "ORT_ASYNC_LOGGING_BUFFER_SIZE";
+}  // namespace
+
 LoggingWrapper::LoggingWrapper(OrtLoggingFunction logging_function, void* logger_param)
     : logging_function_(logging_function), logger_param_(logger_param) {
 }
@@ -47,25 +54,26 @@ OrtEnv* OrtEnv::GetInstance(const OrtEnv::LoggingManagerConstructionInfo& lm_inf
                             const OrtThreadingOptions* tp_options) {
   std::lock_guard<onnxruntime::OrtMutex> lock(m_);
   if (!p_instance_) {
-    std::unique_ptr<LoggingManager> lmgr;
     std::string name = lm_info.logid;
+    std::unique_ptr<ISink> sink;
     if (lm_info.logging_function) {
-      std::unique_ptr<ISink> logger = std::make_unique<LoggingWrapper>(lm_info.logging_function,
-                                                                       lm_info.logger_param);
-      lmgr = std::make_unique<LoggingManager>(std::move(logger),
-                                              static_cast<Severity>(lm_info.default_warning_level),
-                                              false,
-                                              LoggingManager::InstanceType::Default,
-                                              &name);
+      sink = std::make_unique<LoggingWrapper>(lm_info.logging_function, lm_info.logger_param);
     } else {
-      auto sink = MakePlatformDefaultLogSink();
+      sink = MakePlatformDefaultLogSink();
+    }
 
-      lmgr = std::make_unique<LoggingManager>(std::move(sink),
-                                              static_cast<Severity>(lm_info.default_warning_level),
-                                              false,
-                                              LoggingManager::InstanceType::Default,
-                                              &name);
+    // Optionally move the writes to the sink off the calling threads so that verbose logging can be enabled
+    // under load. The value is the number of messages that can be buffered.
+    const auto async_log_capacity = ParseEnvironmentVariableWithDefault<size_t>(kAsyncLoggingBufferSize, 0);
+    if (async_log_capacity > 0) {
+      sink = std::make_unique<AsyncSink>(std::move(sink), async_log_capacity);
     }
+
+    auto lmgr = std::make_unique<LoggingManager>(std::move(sink),
+                                                 static_cast<Severity>(lm_info.default_warning_level),
+                                                 false,
+                                                 LoggingManager::InstanceType::Default,
+                                                 &name);
     std::unique_ptr<onnxruntime::Environment> env;
     if (!tp_options) {
       status = onnxruntime::Environment::Create(std::move(lmgr), env);
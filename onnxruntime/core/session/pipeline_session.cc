@@ -0,0 +1,235 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/session/pipeline_session.h"
+
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "core/platform/ort_mutex.h"
+#include "core/session/inference_session.h"
+
+namespace onnxruntime {
+
+namespace {
+
+// Queue of the indices of the micro-batches that a stage has finished, for the next stage.
+class MicroBatchQueue {
+ public:
+  explicit MicroBatchQueue(size_t capacity) : capacity_(capacity) {}
+
+  // Blocks while the queue is full. Returns false if the pipeline was cancelled.
+  bool Push(size_t micro_batch) {
+    std::unique_lock<OrtMutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return cancelled_ || items_.size() < capacity_; });
+    if (cancelled_) {
+      return false;
+    }
+    items_.push_back(micro_batch);
+    cv_.notify_all();
+    return true;
+  }
+
+  // Blocks until a micro-batch is queued. Returns false once the queue is closed and empty,
+  // or if the pipeline was cancelled.
+  bool Pop(size_t& micro_batch) {
+    std::unique_lock<OrtMutex> lock(mutex_);
+    cv_.wait(lock, [this]() { return cancelled_ || closed_ || !items_.empty(); });
+    if (cancelled_ || items_.empty()) {
+      return false;
+    }
+    micro_batch = items_.front();
+    items_.pop_front();
+    cv_.notify_all();
+    return true;
+  }
+
+  // No more micro-batches are pushed.
+  void Close() {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    closed_ = true;
+    cv_.notify_all();
+  }
+
+  void Cancel() {
+    std::lock_guard<OrtMutex> lock(mutex_);
+    cancelled_ = true;
+    cv_.notify_all();
+  }
+
+ private:
+  const size_t capacity_;
+  OrtMutex mutex_;
+  OrtCondVar cv_;
+  std::deque<size_t> items_;
+  bool closed_ = false;
+  bool cancelled_ = false;
+};
+
+}  // namespace
+
+PipelineSession::PipelineSession(std::vector<PipelineStage> stages, const PipelineSessionOptions& options)
+    : options_(options) {
+  ORT_ENFORCE(!stages.empty(), "A pipeline needs at least one stage.");
+  ORT_ENFORCE(options_.queue_capacity > 0, "queue_capacity must be positive.");
+
+  stages_.reserve(stages.size());
+  for (auto& config : stages) {
+    ORT_ENFORCE(config.session != nullptr, "The session of pipeline stage ", stages_.size(), " is null.");
+    Stage stage;
+
+    const auto inputs = config.session->GetModelInputs();
+    ORT_THROW_IF_ERROR(inputs.first);
+    const auto overridable_initializers = config.session->GetOverridableInitializers();
+    ORT_THROW_IF_ERROR(overridable_initializers.first);
+    for (const auto* input_defs : {inputs.second, overridable_initializers.second}) {
+      for (const auto* input_def : *input_defs) {
+        stage.input_names.push_back(input_def->Name());
+      }
+    }
+
+    const auto outputs = config.session->GetModelOutputs();
+    ORT_THROW_IF_ERROR(outputs.first);
+    for (const auto* output_def : *outputs.second) {
+      stage.output_names.push_back(output_def->Name());
+    }
+
+    stage.config = std::move(config);
+    stages_.push_back(std::move(stage));
+  }
+}
+
+common::Status PipelineSession::RunStage(const Stage& stage, MicroBatchValues& values) const {
+  // inputs without a value, e.g. overridable initializers, are left to the session
+  std::vector<std::string> feed_names;
+  std::vector<OrtValue> feeds;
+  for (const auto& input_name : stage.input_names) {
+    auto source = stage.config.input_sources.find(input_name);
+    const std::string& value_name = source != stage.config.input_sources.end() ? source->second : input_name;
+    auto value = values.find(value_name);
+    if (value != values.end()) {
+      feed_names.push_back(input_name);
+      feeds.push_back(value->second);
+    }
+  }
+
+  std::vector<OrtValue> fetches;
+  ORT_RETURN_IF_ERROR(stage.config.session->Run(stage.config.run_options, feed_names, feeds, stage.output_names,
+                                                &fetches, nullptr));
+  for (size_t i = 0, end = stage.output_names.size(); i < end; ++i) {
+    values[stage.output_names[i]] = std::move(fetches[i]);
+  }
+  return Status::OK();
+}
+
+common::Status PipelineSession::Run(gsl::span<const std::string> feed_names,
+                                    gsl::span<const std::vector<OrtValue>> micro_batch_feeds,
+                                    gsl::span<const std::string> output_names,
+                                    std::vector<std::vector<OrtValue>>& fetches) const {
+  const size_t num_micro_batches = micro_batch_feeds.size();
+  std::vector<MicroBatchValues> micro_batches(num_micro_batches);
+  for (size_t i = 0; i < num_micro_batches; ++i) {
+    ORT_RETURN_IF_NOT(micro_batch_feeds[i].size() == feed_names.size(), "Micro-batch ", i, " has ",
+                      micro_batch_feeds[i].size(), " feeds but there are ", feed_names.size(), " feed names.");
+    for (size_t j = 0, end = feed_names.size(); j < end; ++j) {
+      micro_batches[i][feed_names[j]] = micro_batch_feeds[i][j];
+    }
+  }
+
+  fetches.clear();
+  fetches.resize(num_micro_batches);
+
+  const size_t num_stages = stages_.size();
+  std::vector<std::unique_ptr<MicroBatchQueue>> queues;
+  for (size_t s = 0; s + 1 < num_stages; ++s) {
+    queues.push_back(std::make_unique<MicroBatchQueue>(options_.queue_capacity));
+  }
+
+  OrtMutex status_mutex;
+  Status status;
+  auto fail = [&](Status stage_status) {
+    {
+      std::lock_guard<OrtMutex> lock(status_mutex);
+      if (status.IsOK()) {
+        status = std::move(stage_status);
+      }
+    }
+    for (auto& queue : queues) {
+      queue->Cancel();
+    }
+  };
+
+  // Takes the fetches of a micro-batch that went through all the stages and releases its other values.
+  auto take_fetches = [&](size_t i) -> Status {
+    auto& values = micro_batches[i];
+    auto& micro_batch_fetches = fetches[i];
+    micro_batch_fetches.reserve(output_names.size());
+    for (const auto& output_name : output_names) {
+      auto value = values.find(output_name);
+      ORT_RETURN_IF(value == values.end(), "Output ", output_name,
+                    " is neither fed to the pipeline nor produced by any of its stages.");
+      micro_batch_fetches.push_back(value->second);
+    }
+    values.clear();
+    return Status::OK();
+  };
+
+  auto run_stage = [&](size_t s) {
+    size_t next_micro_batch = 0;
+    while (true) {
+      size_t i;
+      if (s == 0) {
+        if (next_micro_batch == num_micro_batches) {
+          break;
+        }
+        i = next_micro_batch++;
+      } else if (!queues[s - 1]->Pop(i)) {
+        break;
+      }
+
+      Status stage_status;
+      ORT_TRY {
+        stage_status = RunStage(stages_[s], micro_batches[i]);
+        if (stage_status.IsOK() && s + 1 == num_stages) {
+          stage_status = take_fetches(i);
+        }
+      }
+      ORT_CATCH(const std::exception& ex) {
+        ORT_HANDLE_EXCEPTION([&]() {
+          stage_status = ORT_MAKE_STATUS(ONNXRUNTIME, RUNTIME_EXCEPTION, ex.what());
+        });
+      }
+      if (!stage_status.IsOK()) {
+        fail(ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Pipeline stage ", s, " failed on micro-batch ", i, ": ",
+                             stage_status.ErrorMessage()));
+        break;
+      }
+
+      if (s + 1 < num_stages && !queues[s]->Push(i)) {
+        break;
+      }
+    }
+    if (s + 1 < num_stages) {
+      queues[s]->Close();
+    }
+  };
+
+  // the first stage runs on the calling thread
+  std::vector<std::thread> stage_threads;
+  for (size_t s = 1; s < num_stages; ++s) {
+    stage_threads.emplace_back(run_stage, s);
+  }
+  run_stage(0);
+  for (auto& stage_thread : stage_threads) {
+    stage_thread.join();
+  }
+
+  if (!status.IsOK()) {
+    fetches.clear();
+  }
+  return status;
+}
+
+}  // namespace onnxruntime
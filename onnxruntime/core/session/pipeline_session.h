@@ -0,0 +1,86 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/common/status.h"
+#include "core/framework/ort_value.h"
+#include "core/framework/run_options.h"
+
+namespace onnxruntime {
+
+class InferenceSession;
+
+struct PipelineStage {
+  // Initialized session running the stage. Its execution providers and thread pools are those of the stage.
+  InferenceSession* session = nullptr;
+
+  // Names of the values fed to the inputs of the session where they differ from the input names,
+  // keyed by input name.
+  std::unordered_map<std::string, std::string> input_sources;
+
+  // Run options used for every micro-batch of the stage.
+  RunOptions run_options;
+};
+
+struct PipelineSessionOptions {
+  // Maximum number of micro-batches that wait between two stages for the next stage to take them.
+  // It bounds the intermediate values held by the pipeline.
+  size_t queue_capacity = 2;
+};
+
+/**
+ * Pipelined execution of a model cut into stages, e.g. the part of a large model that runs on the CPU and the
+ * part that runs on a GPU, each loaded into its own InferenceSession.
+ *
+ * The micro-batches of a Run flow through the stages in order, each stage running on its own thread, so that
+ * stage k of micro-batch i + 1 runs while stage k + 1 of micro-batch i is executing. The stages are connected
+ * by value names: the inputs of a stage are fed from the feeds of the micro-batch and from the outputs of the
+ * earlier stages, where the outputs of a later stage replace the values with the same name.
+ *
+ * Usage is as follows:
+ *
+ * PipelineSession pipeline({{&cpu_stage_session}, {&gpu_stage_session}}, options);
+ * std::vector<std::vector<OrtValue>> fetches;
+ * ORT_RETURN_IF_ERROR(pipeline.Run(feed_names, micro_batch_feeds, output_names, fetches));
+ */
+class PipelineSession {
+ public:
+  PipelineSession(std::vector<PipelineStage> stages, const PipelineSessionOptions& options);
+
+  /**
+   * Runs the micro-batches through the stages and blocks until all of them are done or a stage failed.
+   * Run may be called concurrently; each call pipelines its own micro-batches.
+   * @param feed_names names of the values fed to the pipeline, in the same order as the feeds of each micro-batch.
+   * @param micro_batch_feeds the feeds of each micro-batch.
+   * @param output_names names of the values to fetch, from the outputs of any stage.
+   * @param fetches overwritten with one vector of fetches per micro-batch, one value per output name.
+   */
+  common::Status Run(gsl::span<const std::string> feed_names,
+                     gsl::span<const std::vector<OrtValue>> micro_batch_feeds,
+                     gsl::span<const std::string> output_names, std::vector<std::vector<OrtValue>>& fetches) const;
+
+  ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(PipelineSession);
+
+ private:
+  struct Stage {
+    PipelineStage config;
+    std::vector<std::string> input_names;
+    std::vector<std::string> output_names;
+  };
+
+  using MicroBatchValues = std::unordered_map<std::string, OrtValue>;
+
+  common::Status RunStage(const Stage& stage, MicroBatchValues& values) const;
+
+  std::vector<Stage> stages_;
+  const PipelineSessionOptions options_;
+};
+
+}  // namespace onnxruntime
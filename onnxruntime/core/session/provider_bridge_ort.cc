@@ -578,6 +578,8 @@ struct ProviderHostImpl : ProviderHost {
   void KernelDefBuilder__InputMemoryType(KernelDefBuilder* p, OrtMemType type, const std::vector<int>& input_indexes) override { p->InputMemoryType(type, input_indexes); }
   void KernelDefBuilder__OutputMemoryType(KernelDefBuilder* p, OrtMemType type, int input_index) override { p->OutputMemoryType(type, input_index); }
   void KernelDefBuilder__ExecQueueId(KernelDefBuilder* p, int queue_id) override { p->ExecQueueId(queue_id); }
+  void KernelDefBuilder__SetDefaultInputsMemoryType(KernelDefBuilder* p, OrtMemType mem_type) override { p->SetDefaultInputsMemoryType(mem_type); }
+  void KernelDefBuilder__SetDefaultOutputMemoryType(KernelDefBuilder* p, OrtMemType mem_type) override { p->SetDefaultOutputMemoryType(mem_type); }
   void KernelDefBuilder__MayInplace(KernelDefBuilder* p, int input_index, int output_index) override { p->MayInplace(input_index, output_index); }
   void KernelDefBuilder__Alias(KernelDefBuilder* p, int input_index, int output_index) override { p->Alias(input_index, output_index); }
   void KernelDefBuilder__Alias(KernelDefBuilder* p, const std::vector<std::pair<int, int>>& aliases) override { p->Alias(aliases); }
@@ -1033,7 +1035,7 @@ struct ProviderHostImpl : ProviderHost {
   }
 #endif
 
-#if defined(USE_TENSORRT)
+#if defined(USE_TENSORRT) || defined(USE_OPENVINO)
   void MurmurHash3__x86_128(const void* key, int len, uint32_t seed, void* out) {
     MurmurHash3::x86_128(key, len, seed, out);
   }
@@ -1211,7 +1213,15 @@ OrtCUDAProviderOptionsV2 OrtCUDAProviderOptionsToOrtCUDAProviderOptionsV2(const
   // Use default value as this field is not available in OrtCUDAProviderOptions
   cuda_options_converted.cudnn_conv_use_max_workspace = 1;
   cuda_options_converted.enable_cuda_graph = 0;
+  cuda_options_converted.max_cuda_graphs = 8;
+  cuda_options_converted.use_cuda_mem_pool = 0;
+  cuda_options_converted.cuda_mem_pool_release_threshold = std::numeric_limits<size_t>::max();
   cuda_options_converted.cudnn_conv1d_pad_to_nc1d = 0;
+  cuda_options_converted.tunable_op_enabled = 0;
+  cuda_options_converted.tunable_op_tuning_results_file = nullptr;
+  cuda_options_converted.cudnn_conv_algo_cache_file = nullptr;
+  cuda_options_converted.prefer_nhwc = 0;
+  cuda_options_converted.max_compute_streams = 1;
 
   return cuda_options_converted;
 }
@@ -1272,6 +1282,9 @@ OrtTensorRTProviderOptionsV2 OrtTensorRTProviderOptionsToOrtTensorRTProviderOpti
   // Use default value as this field is not available in OrtTensorRTProviderOptionsV
   trt_options_converted.trt_context_memory_sharing_enable = 0;
   trt_options_converted.trt_layer_norm_fp32_fallback = 0;
+  trt_options_converted.trt_engine_build_thread_count = 1;
+  trt_options_converted.trt_engine_build_in_background = 0;
+  trt_options_converted.trt_max_optimization_profiles = 0;
   return trt_options_converted;
 }
 
@@ -1578,6 +1591,9 @@ ORT_API_STATUS_IMPL(OrtApis::CreateTensorRTProviderOptions, _Outptr_ OrtTensorRT
   (*out)->trt_force_sequential_engine_build = false;
   (*out)->trt_context_memory_sharing_enable = false;
   (*out)->trt_layer_norm_fp32_fallback = false;
+  (*out)->trt_engine_build_thread_count = 1;
+  (*out)->trt_engine_build_in_background = false;
+  (*out)->trt_max_optimization_profiles = 0;
   return nullptr;
 #else
   ORT_UNUSED_PARAMETER(out);
@@ -1697,7 +1713,15 @@ ORT_API_STATUS_IMPL(OrtApis::CreateCUDAProviderOptions, _Outptr_ OrtCUDAProvider
   (*out)->default_memory_arena_cfg = nullptr;
   (*out)->cudnn_conv_use_max_workspace = 1;
   (*out)->enable_cuda_graph = 0;
+  (*out)->max_cuda_graphs = 8;
+  (*out)->use_cuda_mem_pool = 0;
+  (*out)->cuda_mem_pool_release_threshold = std::numeric_limits<size_t>::max();
   (*out)->cudnn_conv1d_pad_to_nc1d = 0;
+  (*out)->tunable_op_enabled = 0;
+  (*out)->tunable_op_tuning_results_file = nullptr;
+  (*out)->cudnn_conv_algo_cache_file = nullptr;
+  (*out)->prefer_nhwc = 0;
+  (*out)->max_compute_streams = 1;
   return nullptr;
 #else
   ORT_UNUSED_PARAMETER(out);
@@ -1771,6 +1795,11 @@ ORT_API_STATUS_IMPL(OrtApis::GetCUDAProviderOptionsAsString, _In_ const OrtCUDAP
 
 ORT_API(void, OrtApis::ReleaseCUDAProviderOptions, _Frees_ptr_opt_ OrtCUDAProviderOptionsV2* ptr) {
 #ifdef USE_CUDA
+  if (ptr != nullptr) {
+    delete[] ptr->tunable_op_tuning_results_file;
+    delete[] ptr->cudnn_conv_algo_cache_file;
+  }
+
   delete ptr;
 #else
   ORT_UNUSED_PARAMETER(ptr);
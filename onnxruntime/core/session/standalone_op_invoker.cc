@@ -82,64 +82,17 @@ using NodePtr = std::unique_ptr<onnxruntime::Node>;
 using ArgPtr = std::unique_ptr<onnxruntime::NodeArg>;
 using ArgPtrs = onnxruntime::InlinedVector<ArgPtr>;
 
-using NodeResource = std::pair<NodePtr, ArgPtrs>;
-using NodeResourceMap = InlinedHashMap<const onnxruntime::OpKernel*, NodeResource>;
-
-class NodeRepo {
- public:
-  static NodeRepo& GetInstance() {
-    static NodeRepo node_repo;
-    return node_repo;
-  }
-
-  onnxruntime::Status AddNode(const onnxruntime::OpKernel* kernel, NodePtr&& node_ptr, ArgPtrs&& args) {
-    std::lock_guard<std::mutex> guard(mutex_);
-    auto ret = resource_map_.try_emplace(kernel, NodeResource{std::move(node_ptr), std::move(args)});
-    if (!ret.second) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "kernel already mapped to existing node");
-    }
-    return Status::OK();
-  }
-
-  onnxruntime::Status ValidateInputOutputCounts(const onnxruntime::OpKernel* kernel,
-                                                int input_count,
-                                                int output_count) {
-    size_t expect_input_count{};
-    size_t expect_output_count{};
-    {
-      std::lock_guard<std::mutex> guard(mutex_);
-      auto iter = resource_map_.find(kernel);
-      if (iter == resource_map_.end()) {
-        return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT, "matching node is missing");
-      }
-      auto* node = iter->second.first.get();
-      expect_input_count = node->InputDefs().size();
-      expect_output_count = node->OutputDefs().size();
-    }
-    if (expect_input_count != static_cast<size_t>(input_count)) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
-                             "invalid node input count: ", input_count,
-                             ", expect: ", expect_input_count);
-    }
-    if (expect_output_count != static_cast<size_t>(output_count)) {
-      return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
-                             "invalid node output count", output_count,
-                             ", expect: ", expect_output_count);
-    }
-    return Status::OK();
-  }
-
-  void RemoveNode(const onnxruntime::OpKernel* kernel) {
-    std::lock_guard<std::mutex> guard(mutex_);
-    resource_map_.erase(kernel);
-  }
-
- private:
-  explicit NodeRepo() = default;
-  ~NodeRepo() = default;
-
-  std::mutex mutex_;
-  NodeResourceMap resource_map_;
+// The OrtOp handle of CreateOp. It owns the kernel along with the node and the kernel def that the kernel info of
+// the kernel refers to, and the expected input and output counts, so that InvokeOp only reads the handle and
+// dispatches to the kernel without any lookup or lock.
+struct StandAloneOp {
+  NodePtr node;
+  ArgPtrs args;
+  std::unique_ptr<KernelDef> kernel_def;
+  // declared after the node and the kernel def so that it is destroyed before them
+  std::unique_ptr<onnxruntime::OpKernel> kernel;
+  int input_count{};
+  int output_count{};
 };
 
 // For invoking kernels without a graph
@@ -365,30 +318,33 @@ onnxruntime::Status CreateOp(const OrtKernelInfo* info,
     output_args.push_back(arg_ptrs.back().get());
   }
 
-  NodePtr node_ptr = std::make_unique<onnxruntime::Node>(std::string("standalone_") + op_name, op_name, "", input_args, output_args, nullptr, domain);
+  auto standalone_op = std::make_unique<StandAloneOp>();
+  standalone_op->args = std::move(arg_ptrs);
+  standalone_op->input_count = input_count;
+  standalone_op->output_count = output_count;
+  standalone_op->node = std::make_unique<onnxruntime::Node>(std::string("standalone_") + op_name, op_name, "",
+                                                            input_args, output_args, nullptr, domain);
   for (int i = 0; i < attr_count; ++i) {
     auto attr_proto = reinterpret_cast<const ONNX_NAMESPACE::AttributeProto*>(attr_values[i]);
-    node_ptr->AddAttributeProto(*attr_proto);
+    standalone_op->node->AddAttributeProto(*attr_proto);
   }
 
   auto kernel_def_builder = KernelDefBuilder::Create();
   kernel_def_builder->SetName(op_name);
   kernel_def_builder->SetDomain(domain);
   kernel_def_builder->SinceVersion(version);
-  auto kernel_def = kernel_def_builder->Build();
+  standalone_op->kernel_def = kernel_def_builder->Build();
 
   static std::unordered_map<int, OrtValue> kEmptyValueMap;
   static OrtValueNameIdxMap kEmptyNameMap;
 
-  OpKernelInfo tmp_kernel_info(*node_ptr.get(), *kernel_def, *ep, kEmptyValueMap, kEmptyNameMap, kernel_info->GetDataTransferManager());
-  std::unique_ptr<onnxruntime::OpKernel> op_kernel;
+  OpKernelInfo tmp_kernel_info(*standalone_op->node, *standalone_op->kernel_def, *ep, kEmptyValueMap, kEmptyNameMap,
+                               kernel_info->GetDataTransferManager(), kernel_info->GetConfigOptions());
 
   static FuncManager kFuncMgr;
-  status = kernel_create_info->kernel_create_func(kFuncMgr, tmp_kernel_info, op_kernel);
-  ORT_RETURN_IF_ERROR(status);
-  status = NodeRepo::GetInstance().AddNode(op_kernel.get(), std::move(node_ptr), std::move(arg_ptrs));
+  status = kernel_create_info->kernel_create_func(kFuncMgr, tmp_kernel_info, standalone_op->kernel);
   ORT_RETURN_IF_ERROR(status);
-  *op = reinterpret_cast<OrtOp*>(op_kernel.release());
+  *op = reinterpret_cast<OrtOp*>(standalone_op.release());
   return status;
 }
 
@@ -401,8 +357,17 @@ onnxruntime::Status InvokeOp(_In_ const OrtKernelContext* context,
   auto ctx = reinterpret_cast<const OpKernelContext*>(context);
   AllocatorPtr allocator{};
   ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&allocator));
-  auto kernel = reinterpret_cast<const OpKernel*>(ort_op);
-  ORT_RETURN_IF_ERROR(NodeRepo::GetInstance().ValidateInputOutputCounts(kernel, input_count, output_count));
+  const auto* standalone_op = reinterpret_cast<const StandAloneOp*>(ort_op);
+  if (standalone_op->input_count != input_count) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "invalid node input count: ", input_count,
+                           ", expect: ", standalone_op->input_count);
+  }
+  if (standalone_op->output_count != output_count) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, INVALID_ARGUMENT,
+                           "invalid node output count: ", output_count,
+                           ", expect: ", standalone_op->output_count);
+  }
   StandAloneKernelContext standalone_kernel_ctx(input_values,
                                                 input_count,
                                                 output_values,
@@ -411,7 +376,7 @@ onnxruntime::Status InvokeOp(_In_ const OrtKernelContext* context,
                                                 ctx->GetOperatorThreadPool(),
                                                 ctx->Logger(),
                                                 ctx->GetComputeStream());
-  return kernel->Compute(&standalone_kernel_ctx);
+  return standalone_op->kernel->Compute(&standalone_kernel_ctx);
 }
 
 }  // namespace standalone
@@ -492,9 +457,7 @@ ORT_API_STATUS_IMPL(OrtApis::InvokeOp,
 
 ORT_API(void, OrtApis::ReleaseOp, _Frees_ptr_opt_ OrtOp* op) {
   if (op) {
-    auto kernel = reinterpret_cast<onnxruntime::OpKernel*>(op);
-    onnxruntime::standalone::NodeRepo::GetInstance().RemoveNode(kernel);
-    delete kernel;
+    delete reinterpret_cast<onnxruntime::standalone::StandAloneOp*>(op);
   }
 }
 
@@ -87,6 +87,10 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   if (options.thread_pool_size <= 1) {
     return nullptr;
   }
+  if (options.custom_schedule_fn) {
+    return std::make_unique<ThreadPool>(options.custom_schedule_fn, options.custom_scheduler_param,
+                                        options.thread_pool_size);
+  }
   // override affinity setting if specified from customer
   if (!options.affinity_str.empty()) {
 #if defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
@@ -116,6 +120,8 @@ CreateThreadPoolHelper(Env* env, OrtThreadPoolParams options) {
   to.custom_thread_creation_options = options.custom_thread_creation_options;
   to.custom_join_thread_fn = options.custom_join_thread_fn;
   to.dynamic_block_base_ = options.dynamic_block_base_;
+  to.adaptive_spinning = options.adaptive_spinning;
+  to.calibrate_parallel_for_cost = options.calibrate_parallel_for_cost;
   if (to.custom_create_thread_fn) {
     ORT_ENFORCE(to.custom_join_thread_fn, "custom join thread function not set");
   }
@@ -211,6 +217,18 @@ ORT_API_STATUS_IMPL(SetGlobalCustomJoinThreadFn, _Inout_ OrtThreadingOptions* tp
   return nullptr;
 }
 
+ORT_API_STATUS_IMPL(SetGlobalCustomScheduler, _Inout_ OrtThreadingOptions* tp_options,
+                    _In_opt_ OrtCustomScheduleFn ort_custom_schedule_fn, _In_opt_ void* ort_custom_scheduler_param) {
+  if (!tp_options) {
+    return OrtApis::CreateStatus(ORT_INVALID_ARGUMENT, "Received null OrtThreadingOptions");
+  }
+  tp_options->inter_op_thread_pool_params.custom_schedule_fn = ort_custom_schedule_fn;
+  tp_options->inter_op_thread_pool_params.custom_scheduler_param = ort_custom_scheduler_param;
+  tp_options->intra_op_thread_pool_params.custom_schedule_fn = ort_custom_schedule_fn;
+  tp_options->intra_op_thread_pool_params.custom_scheduler_param = ort_custom_scheduler_param;
+  return nullptr;
+}
+
 ORT_API_STATUS_IMPL(SetGlobalIntraOpThreadAffinity, _Inout_ OrtThreadingOptions* tp_options, const char* affinity_string) {
 #if defined(ORT_MINIMAL_BUILD) || defined(ORT_EXTENDED_MINIMAL_BUILD)
   ORT_UNUSED_PARAMETER(tp_options);
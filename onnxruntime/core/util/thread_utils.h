@@ -21,6 +21,12 @@ struct OrtThreadPoolParams {
   //If it is true, the thread pool will spin a while after the queue became empty.
   bool allow_spinning = true;
 
+  //If it is true and allow_spinning is true, the time the threads spin is derived from their recent idle periods.
+  bool adaptive_spinning = false;
+
+  //If it is true, TryParallelFor splits loops based on their measured cost rather than the cost given by the caller.
+  bool calibrate_parallel_for_cost = false;
+
   //It it is non-negative, thread pool will split a task by a decreasing block size
   //of remaining_of_total_iterations / (num_of_threads * dynamic_block_base_)
   int dynamic_block_base_ = 0;
@@ -46,6 +52,11 @@ struct OrtThreadPoolParams {
   OrtCustomCreateThreadFn custom_create_thread_fn = nullptr;
   void* custom_thread_creation_options = nullptr;
   OrtCustomJoinThreadFn custom_join_thread_fn = nullptr;
+
+  // If set, the pool runs its work on the scheduler of the host application instead of creating threads,
+  // and thread_pool_size is the degree of parallelism of its loops.
+  OrtCustomScheduleFn custom_schedule_fn = nullptr;
+  void* custom_scheduler_param = nullptr;
 };
 
 struct OrtThreadingOptions {
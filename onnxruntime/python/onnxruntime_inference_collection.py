@@ -4,6 +4,7 @@
 # --------------------------------------------------------------------------
 import collections
 import collections.abc
+import copy
 import os
 import warnings
 
@@ -209,6 +210,51 @@ class Session:
             else:
                 raise
 
+    def run_batch(self, output_names, input_feeds, run_options=None, max_concurrency=0):
+        """
+        Compute the predictions for a batch of requests.
+
+        The inputs of all the requests are converted first, then the runs are executed concurrently
+        with the GIL released for the whole batch, which scales better than calling :meth:`run`
+        from several python threads.
+
+        :param output_names: name of the outputs
+        :param input_feeds: list of dictionaries ``{ input_name: input_value }``, one per run
+        :param run_options: See :class:`onnxruntime.RunOptions`, shared by all the runs.
+        :param max_concurrency: maximum number of runs executed at the same time,
+            0 means the number of hardware threads.
+        :return: list with the results of every run, in the order of *input_feeds*.
+            See :meth:`run` for the results of a single run.
+
+        ::
+
+            sess.run_batch([output_name], [{input_name: x1}, {input_name: x2}])
+        """
+        num_required_inputs = len(self._inputs_meta)
+        for input_feed in input_feeds:
+            num_inputs = len(input_feed)
+            # the graph may have optional inputs used to override initializers. allow for that.
+            if num_inputs < num_required_inputs:
+                raise ValueError(
+                    "Model requires {} inputs. Input Feed contains {}".format(num_required_inputs, num_inputs)
+                )
+        if max_concurrency < 0:
+            raise ValueError("max_concurrency must be non-negative. Got {}".format(max_concurrency))
+        if not output_names:
+            output_names = [output.name for output in self._outputs_meta]
+        try:
+            return self._sess.run_batch(output_names, input_feeds, run_options, max_concurrency)
+        except C.EPFail as err:
+            if self._enable_fallback:
+                print("EP Error: {} using {}".format(str(err), self._providers))
+                print("Falling back to {} and retrying.".format(self._fallback_providers))
+                self.set_providers(self._fallback_providers)
+                # Fallback only once.
+                self.disable_fallback()
+                return self._sess.run_batch(output_names, input_feeds, run_options, max_concurrency)
+            else:
+                raise
+
     def run_with_ort_values(self, output_names, input_dict_ort_values, run_options=None):
         """
         Compute the predictions.
@@ -273,6 +319,24 @@ class Session:
         """
         return self._sess.get_profiling_start_time_ns
 
+    def warmup(self, shape_sets, num_runs_per_shape_set=2, run_options=None):
+        """
+        Warm the session up before serving requests, by running it on inputs of zeros with each set of input shapes.
+        The runs extend the memory arenas, tune the kernels and fill the caches of the execution providers, so that
+        the first requests don't pay for it.
+
+        :param shape_sets: List of dictionaries ``{input name: shape}``, e.g. one per shape bucket of the requests.
+        :param num_runs_per_shape_set: Number of runs with each shape set.
+        :param run_options: See :class:`onnxruntime.RunOptions`.
+        :return: Dictionary with the ``first_run_ms`` and ``last_run_ms`` of each shape set in ``shape_sets``,
+            and the ``arena_allocated_bytes`` and ``arena_num_extensions`` of the memory arenas.
+
+        ::
+
+            sess.warmup([{"input": [1, 3, 224, 224]}, {"input": [8, 3, 224, 224]}])
+        """
+        return self._sess.warmup(shape_sets, num_runs_per_shape_set, run_options)
+
     def io_binding(self):
         "Return an onnxruntime.IOBinding object`."
         return IOBinding(self)
@@ -417,6 +481,29 @@ class InferenceSession(Session):
         self._provider_options = self._sess.get_provider_options()
         self._profiling_start_time_ns = self._sess.get_profiling_start_time_ns
 
+    def clone(self, sess_options=None):
+        """
+        Create a session that shares the initialized model of this session, i.e. the optimized graph, the kernels,
+        the weights and the execution providers, so that it costs little time and memory. The clone runs on the thread
+        pools of its own session options, e.g. to serve a tenant with a thread pool of its own. The options the graph
+        was prepared with, like the graph optimization level and the execution providers, are the ones of this session.
+
+        :param sess_options: Session options of the clone, the thread pool and logging ones are used.
+        :return: The cloned :class:`onnxruntime.InferenceSession`.
+
+        ::
+
+            tenant_options = onnxruntime.SessionOptions()
+            tenant_options.intra_op_num_threads = 2
+            tenant_sess = sess.clone(tenant_options)
+        """
+        clone = copy.copy(self)
+        clone._sess = self._sess.clone(sess_options if sess_options else C.get_default_session_options())
+        clone._sess_options = clone._sess.session_options
+        clone._sess_options_initial = sess_options
+        clone._profiling_start_time_ns = clone._sess.get_profiling_start_time_ns
+        return clone
+
     def _reset_session(self, providers, provider_options):
         "release underlying session object."
         # meta data references session internal structures
@@ -485,6 +572,17 @@ class IOBinding:
         """
         self._iobinding.bind_ortvalue_input(name, ortvalue._ortvalue)
 
+    def bind_dlpack_input(self, name, value, stream=None):
+        """
+        Binds an input to a tensor of another framework (PyTorch, CuPy, JAX...) on CPU or GPU
+        without copying it, see :meth:`OrtValue.from_dlpack`.
+
+        :param name: input name
+        :param value: object implementing ``__dlpack__`` or a DLPack capsule
+        :param stream: stream passed to ``value.__dlpack__``
+        """
+        self._iobinding.bind_ortvalue_input(name, OrtValue.from_dlpack(value, stream)._ortvalue)
+
     def synchronize_inputs(self):
         self._iobinding.synchronize_inputs()
 
@@ -543,6 +641,17 @@ class IOBinding:
         """
         self._iobinding.bind_ortvalue_output(name, ortvalue._ortvalue)
 
+    def bind_dlpack_output(self, name, value, stream=None):
+        """
+        Binds an output to a pre-allocated tensor of another framework (PyTorch, CuPy, JAX...)
+        on CPU or GPU, the run writes into its memory. See :meth:`OrtValue.from_dlpack`.
+
+        :param name: output name
+        :param value: object implementing ``__dlpack__`` or a DLPack capsule
+        :param stream: stream passed to ``value.__dlpack__``
+        """
+        self._iobinding.bind_ortvalue_output(name, OrtValue.from_dlpack(value, stream)._ortvalue)
+
     def synchronize_outputs(self):
         self._iobinding.synchronize_outputs()
 
@@ -642,6 +751,39 @@ class OrtValue:
             )
         )
 
+    @staticmethod
+    def from_dlpack(data, stream=None, is_bool_tensor=None):
+        """
+        Factory method to construct an OrtValue (which holds a Tensor) sharing the memory of a tensor
+        of another framework (PyTorch, CuPy, JAX, numpy...) by means of the DLPack protocol.
+        No data is copied, whether the tensor is on CPU or on GPU.
+
+        :param data: object implementing ``__dlpack__`` or a DLPack capsule
+        :param stream: passed on as ``data.__dlpack__(stream=stream)`` so the producer orders its
+            pending work before the work submitted to that stream. For CUDA, use the integer handle of
+            the stream the session runs on. None lets the producer synchronize with its default.
+        :param is_bool_tensor: DLPack describes boolean tensors as uint8 tensors, set to True to
+            create a boolean OrtValue. By default it is deduced from ``data.dtype``.
+        """
+        if is_bool_tensor is None:
+            is_bool_tensor = str(getattr(data, "dtype", "")).endswith("bool")
+        if hasattr(data, "__dlpack__"):
+            data = data.__dlpack__() if stream is None else data.__dlpack__(stream=stream)
+        return OrtValue(C.OrtValue.from_dlpack(data, is_bool_tensor))
+
+    def __dlpack__(self, stream=None):
+        """
+        Returns a DLPack capsule sharing the memory of the tensor (part of the DLPack protocol),
+        so ``torch.from_dlpack(ortvalue)`` or ``cupy.from_dlpack(ortvalue)`` do not copy the data.
+        """
+        return self._ortvalue.__dlpack__(stream)
+
+    def __dlpack_device__(self):
+        """
+        Returns a tuple of integers, (device type, device index) (part of the DLPack protocol).
+        """
+        return self._ortvalue.__dlpack_device__()
+
     @staticmethod
     def ort_value_from_sparse_tensor(sparse_tensor):
         """
@@ -15,7 +15,7 @@
 #include "core/framework/tensor.h"
 #include "core/framework/sparse_tensor.h"
 #include "core/framework/TensorSeq.h"
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
 #include "core/dlpack/dlpack_converter.h"
 #endif
 
@@ -279,7 +279,7 @@ void addOrtValueMethods(pybind11::module& m) {
 #endif
         return obj;
       })
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
       .def("to_dlpack", [](OrtValue* ort_value) -> py::object {
         return py::reinterpret_steal<py::object>(ToDlpack(*ort_value));
       }, "Returns a DLPack representing the tensor. This method does not copy the pointer shape, "
@@ -294,7 +294,9 @@ void addOrtValueMethods(pybind11::module& m) {
        }, py::arg("stream")=py::none(),
        "Returns a DLPack representing the tensor (part of __dlpack__ protocol). "
        "This method does not copy the pointer shape, instead, it copies the pointer value. "
-       "The OrtValue must persist until the dlpack structure is consumed.")
+       "The OrtValue must persist until the dlpack structure is consumed. "
+       "The stream argument is ignored: the execution providers synchronize their streams at the end of a run, "
+       "so the data of an OrtValue produced by a run is ready on any stream.")
       .def("__dlpack_device__", [](const OrtValue* ort_value) -> py::tuple {
         ORT_ENFORCE(ort_value->IsTensor(), "Only tensor type OrtValues are supported");
         const onnxruntime::Tensor& tensor = ort_value->Get<Tensor>();
@@ -309,11 +311,13 @@ void addOrtValueMethods(pybind11::module& m) {
       .def("push_back", [](std::vector<OrtValue>* v, const OrtValue& ortvalue) {
         v->push_back(ortvalue);
       })
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
       .def("push_back", [](std::vector<OrtValue>* v, py::object dlpack_tensor, const bool is_bool_tensor) {
         v->push_back(FromDlpack(dlpack_tensor.ptr(), is_bool_tensor));
       }, "Add a new OrtValue after being ownership was transferred from the DLPack structure.",
       py::arg("dlpack_tensor"), py::arg("is_bool_tensor") = false)
+#endif
+#ifdef ENABLE_TRAINING
       .def("push_back_batch", [](
           std::vector<OrtValue>* v,
           std::vector<py::object>& torch_tensors,
@@ -370,7 +374,7 @@ void addOrtValueMethods(pybind11::module& m) {
           "In case of a boolean tensor, method to_dlpacks returns a uint8 tensor instead of a boolean tensor. "
           "If torch consumes the dlpack structure, `.to(torch.bool)` must be applied to the torch tensor "
           "to get a boolean tensor.")
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
       .def("dlpack_at", [](std::vector<OrtValue>* v, const size_t idx) {
         return py::reinterpret_steal<py::object>(ToDlpack(v->at(idx)));
       })
@@ -384,7 +388,7 @@ void addOrtValueMethods(pybind11::module& m) {
           "(such as onnx.TensorProto.FLOAT)."
           "Raises an exception in any other case.",
           py::arg("idx"))
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
       .def(
           "to_dlpacks", [](const std::vector<OrtValue>& v, py::object to_tensor) -> py::list {
             if (v.size() == 0)
@@ -455,7 +459,7 @@ for every transferred tensor.
 #endif
   ;
 
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
   m.def("is_dlpack_uint8_tensor", [](py::capsule cap) -> bool {
     // case ONNX_NAMESPACE::TensorProto_DataType_BOOL:
     // dtype.code = DLDataTypeCode::kDLUInt;
@@ -48,7 +48,10 @@ namespace onnxruntime {
 #pragma warning(disable : 4267 4996 4503 4003)
 #endif  // _MSC_VER
 
+#include <algorithm>
+#include <atomic>
 #include <iterator>
+#include <thread>
 
 #if defined(_MSC_VER)
 #pragma warning(disable : 4267 4996 4503 4003)
@@ -414,6 +417,9 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
             nullptr,
             0,
             0,
+            0,
+            1,
+            0,
             0};
         for (auto option : it->second) {
           if (option.first == "device_id") {
@@ -547,6 +553,26 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
             } else {
               ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_layer_norm_fp32_fallback' should be 'True' or 'False'. Default value is 'False'.\n");
             }
+          } else if (option.first == "trt_engine_build_thread_count") {
+            if (!option.second.empty()) {
+              params.trt_engine_build_thread_count = std::stoi(option.second);
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_engine_build_thread_count' should be a non-negative integer number i.e. '4'.\n");
+            }
+          } else if (option.first == "trt_engine_build_in_background") {
+            if (option.second == "True" || option.second == "true") {
+              params.trt_engine_build_in_background = true;
+            } else if (option.second == "False" || option.second == "false") {
+              params.trt_engine_build_in_background = false;
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_engine_build_in_background' should be 'True' or 'False'. Default value is 'False'.\n");
+            }
+          } else if (option.first == "trt_max_optimization_profiles") {
+            if (!option.second.empty()) {
+              params.trt_max_optimization_profiles = std::stoi(option.second);
+            } else {
+              ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_max_optimization_profiles' should be a non-negative integer number i.e. '4'.\n");
+            }
           } else {
             ORT_THROW("Invalid TensorRT EP option: ", option.first);
           }
@@ -757,7 +783,9 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
 #endif
     const auto partitioning_stop_ops_list = session_options.config_options.GetConfigEntry(
         kOrtSessionOptionsConfigNnapiEpPartitioningStopOps);
-    return onnxruntime::NnapiProviderFactoryCreator::Create(0, partitioning_stop_ops_list)->CreateProvider();
+    const auto cache_dir = session_options.config_options.GetConfigEntry(kOrtSessionOptionsConfigNnapiEpCacheDir);
+    return onnxruntime::NnapiProviderFactoryCreator::Create(0, partitioning_stop_ops_list, cache_dir)
+        ->CreateProvider();
 #endif
   } else if (type == kRknpuExecutionProvider) {
 #ifdef USE_RKNPU
@@ -768,7 +796,8 @@ std::unique_ptr<IExecutionProvider> CreateExecutionProviderInstance(
 #if !defined(__APPLE__)
     LOGS_DEFAULT(WARNING) << "CoreML execution provider can only be used to generate ORT format model in this build.";
 #endif
-    return onnxruntime::CoreMLProviderFactoryCreator::Create(0)->CreateProvider();
+    const auto cache_dir = session_options.config_options.GetConfigEntry(kOrtSessionOptionsConfigCoreMLEpCacheDir);
+    return onnxruntime::CoreMLProviderFactoryCreator::Create(0, cache_dir)->CreateProvider();
 #endif
   } else if (type == kXnnpackExecutionProvider) {
 #if defined(USE_XNNPACK)
@@ -921,6 +950,52 @@ static void LogDeprecationWarning(
 }
 #endif
 
+// Converts the python feeds of a run to OrtValues. Numpy arrays that are usable as they are share their memory with
+// the OrtValues, so the python objects must outlive the run. Must be called with the GIL held.
+static NameMLValMap CreateFeedsFromPyObjects(PyInferenceSession* sess,
+                                             const std::map<std::string, py::object>& pyfeeds) {
+  NameMLValMap feeds;
+  for (const auto& feed : pyfeeds) {
+    // No need to process 'None's sent in by the user
+    // to feed Optional inputs in the graph.
+    // We just won't include anything in the feed and ORT
+    // will handle such implicit 'None's internally.
+    if (!feed.second.is(py::none())) {
+      OrtValue ml_value;
+      auto px = sess->GetSessionHandle()->GetModelInputs();
+      if (!px.first.IsOK() || !px.second) {
+        throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
+      }
+      CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
+      ThrowIfPyErrOccured();
+      feeds.insert(std::make_pair(feed.first, ml_value));
+    }
+  }
+  return feeds;
+}
+
+// Converts the fetches of a run to python objects. Must be called with the GIL held.
+static std::vector<py::object> CreatePyObjectsFromFetches(const std::vector<OrtValue>& fetches) {
+  std::vector<py::object> rfetch;
+  rfetch.reserve(fetches.size());
+  size_t pos = 0;
+  for (const auto& fet : fetches) {
+    if (fet.IsAllocated()) {
+      if (fet.IsTensor()) {
+        rfetch.push_back(AddTensorAsPyObj(fet, nullptr, nullptr));
+      } else if (fet.IsSparseTensor()) {
+        rfetch.push_back(GetPyObjectFromSparseTensor(pos, fet, nullptr));
+      } else {
+        rfetch.push_back(AddNonTensorAsPyObj(fet, nullptr, nullptr));
+      }
+    } else {  // Send back None because the corresponding OrtValue was empty
+      rfetch.push_back(py::none());
+    }
+    ++pos;
+  }
+  return rfetch;
+}
+
 void addGlobalMethods(py::module& m, Environment& env) {
   m.def("get_default_session_options", &GetDefaultCPUSessionOptions, "Return a default session_options instance.");
   m.def("get_session_initializer", &SessionObjectInitializer::Get, "Return a default session object initializer.");
@@ -1116,6 +1191,8 @@ void addObjectMethods(py::module& m, Environment& env, ExecutionProviderRegistra
         ort_arena_cfg->max_dead_bytes_per_chunk = kvp.second.cast<int>();
       } else if (key == "initial_growth_chunk_size_bytes") {
         ort_arena_cfg->initial_growth_chunk_size_bytes = kvp.second.cast<int>();
+      } else if (key == "thread_cache_max_chunk_bytes") {
+        ort_arena_cfg->thread_cache_max_chunk_bytes = kvp.second.cast<int>();
         } else {
         ORT_THROW("Invalid OrtArenaCfg option: ", key);
       }
@@ -1126,7 +1203,8 @@ void addObjectMethods(py::module& m, Environment& env, ExecutionProviderRegistra
       .def_readwrite("arena_extend_strategy", &OrtArenaCfg::arena_extend_strategy)
       .def_readwrite("initial_chunk_size_bytes", &OrtArenaCfg::initial_chunk_size_bytes)
       .def_readwrite("max_dead_bytes_per_chunk", &OrtArenaCfg::max_dead_bytes_per_chunk)
-      .def_readwrite("initial_growth_chunk_size_bytes", &OrtArenaCfg::initial_growth_chunk_size_bytes);
+      .def_readwrite("initial_growth_chunk_size_bytes", &OrtArenaCfg::initial_growth_chunk_size_bytes)
+      .def_readwrite("thread_cache_max_chunk_bytes", &OrtArenaCfg::thread_cache_max_chunk_bytes);
 
   py::class_<OrtMemoryInfo> ort_memory_info_binding(m, "OrtMemoryInfo");
   ort_memory_info_binding.def(py::init([](const char* name, OrtAllocatorType type, int id, OrtMemType mem_type) {
@@ -1490,23 +1568,7 @@ including arg name, arg type (contains both type and shape).)pbdoc")
            [](PyInferenceSession* sess, std::vector<std::string> output_names,
               std::map<std::string, py::object> pyfeeds, RunOptions* run_options = nullptr)
                -> std::vector<py::object> {
-             NameMLValMap feeds;
-             for (auto feed : pyfeeds) {
-               // No need to process 'None's sent in by the user
-               // to feed Optional inputs in the graph.
-               // We just won't include anything in the feed and ORT
-               // will handle such implicit 'None's internally.
-               if (!feed.second.is(py::none())) {
-                 OrtValue ml_value;
-                 auto px = sess->GetSessionHandle()->GetModelInputs();
-                 if (!px.first.IsOK() || !px.second) {
-                   throw std::runtime_error("Either failed to get model inputs from the session object or the input def list was null");
-                 }
-                 CreateGenericMLValue(px.second, GetAllocator(), feed.first, feed.second, &ml_value);
-                 ThrowIfPyErrOccured();
-                 feeds.insert(std::make_pair(feed.first, ml_value));
-               }
-             }
+             NameMLValMap feeds = CreateFeedsFromPyObjects(sess, pyfeeds);
 
              std::vector<OrtValue> fetches;
              common::Status status;
@@ -1521,24 +1583,63 @@ including arg name, arg type (contains both type and shape).)pbdoc")
                }
              }
 
-             std::vector<py::object> rfetch;
-             rfetch.reserve(fetches.size());
-             size_t pos = 0;
-             for (auto fet : fetches) {
-               if (fet.IsAllocated()) {
-                 if (fet.IsTensor()) {
-                   rfetch.push_back(AddTensorAsPyObj(fet, nullptr, nullptr));
-                 } else if (fet.IsSparseTensor()) {
-                   rfetch.push_back(GetPyObjectFromSparseTensor(pos, fet, nullptr));
-                 } else {
-                   rfetch.push_back(AddNonTensorAsPyObj(fet, nullptr, nullptr));
+             return CreatePyObjectsFromFetches(fetches);
+           })
+      /// This method runs the model once for every feed dictionary of the batch. All the feeds are converted
+      /// first, then the runs are executed concurrently on up to max_concurrency threads with the GIL released,
+      /// and the outputs are converted once all the runs have completed.
+      .def("run_batch",
+           [](PyInferenceSession* sess, std::vector<std::string> output_names,
+              std::vector<std::map<std::string, py::object>> pyfeeds_batch, RunOptions* run_options,
+              size_t max_concurrency) -> std::vector<std::vector<py::object>> {
+             const size_t batch_size = pyfeeds_batch.size();
+             std::vector<NameMLValMap> feeds_batch;
+             feeds_batch.reserve(batch_size);
+             for (const auto& pyfeeds : pyfeeds_batch) {
+               feeds_batch.push_back(CreateFeedsFromPyObjects(sess, pyfeeds));
+             }
+
+             std::vector<std::vector<OrtValue>> fetches_batch(batch_size);
+             std::vector<common::Status> statuses(batch_size);
+             {
+               // release GIL for the whole batch so the runs, and other python threads, proceed in parallel.
+               py::gil_scoped_release release;
+               InferenceSession* session = sess->GetSessionHandle();
+               std::atomic<size_t> next_run{0};
+               auto run_worker = [&]() {
+                 for (size_t i = next_run++; i < batch_size; i = next_run++) {
+                   statuses[i] = run_options != nullptr
+                                     ? session->Run(*run_options, feeds_batch[i], output_names, &fetches_batch[i])
+                                     : session->Run(feeds_batch[i], output_names, &fetches_batch[i]);
                  }
-               } else {  // Send back None because the corresponding OrtValue was empty
-                 rfetch.push_back(py::none());
+               };
+
+               if (max_concurrency == 0) {
+                 max_concurrency = std::max<size_t>(1, std::thread::hardware_concurrency());
+               }
+               // the calling thread runs its share of the batch as well
+               const size_t num_threads = std::min(max_concurrency, batch_size);
+               std::vector<std::thread> workers;
+               workers.reserve(num_threads > 0 ? num_threads - 1 : 0);
+               for (size_t i = 1; i < num_threads; ++i) {
+                 workers.emplace_back(run_worker);
                }
-               ++pos;
+               run_worker();
+               for (auto& worker : workers) {
+                 worker.join();
+               }
+             }
+
+             for (const auto& status : statuses) {
+               OrtPybindThrowIfError(status);
              }
-             return rfetch;
+
+             std::vector<std::vector<py::object>> rfetches;
+             rfetches.reserve(batch_size);
+             for (const auto& fetches : fetches_batch) {
+               rfetches.push_back(CreatePyObjectsFromFetches(fetches));
+             }
+             return rfetches;
            })
       /// This method accepts a dictionary of feeds (name -> OrtValue) and the list of output_names
       /// and returns a list of python objects representing OrtValues. Each name may represent either
@@ -1631,6 +1732,43 @@ including arg name, arg type (contains both type and shape).)pbdoc")
             return *(res.second);
           },
           py::return_value_policy::reference_internal)
+      .def(
+          "clone", [](const PyInferenceSession* sess, const PySessionOptions& sess_options) {
+            std::unique_ptr<InferenceSession> clone;
+            OrtPybindThrowIfError(sess->GetSessionHandle()->Clone(sess_options, clone));
+            return std::make_unique<PyInferenceSession>(std::move(clone));
+          },
+          // the session must outlive its clone
+          py::keep_alive<0, 1>())
+      .def("warmup", [](PyInferenceSession* sess, const std::vector<std::map<std::string, std::vector<int64_t>>>& shape_sets, size_t num_runs_per_shape_set, RunOptions* run_options = nullptr) -> py::dict {
+        std::vector<InlinedHashMap<std::string, TensorShape>> input_shapes(shape_sets.size());
+        for (size_t i = 0; i < shape_sets.size(); ++i) {
+          for (const auto& [name, dims] : shape_sets[i]) {
+            input_shapes[i].emplace(name, TensorShape(dims));
+          }
+        }
+
+        WarmupStats stats;
+        {
+          py::gil_scoped_release release;
+          RunOptions default_run_options;
+          OrtPybindThrowIfError(sess->GetSessionHandle()->Warmup(run_options ? *run_options : default_run_options,
+                                                                 input_shapes, num_runs_per_shape_set, stats));
+        }
+
+        py::list shape_set_stats;
+        for (const auto& shape_set : stats.shape_sets) {
+          py::dict entry;
+          entry["first_run_ms"] = shape_set.first_run_ms;
+          entry["last_run_ms"] = shape_set.last_run_ms;
+          shape_set_stats.append(entry);
+        }
+        py::dict result;
+        result["shape_sets"] = shape_set_stats;
+        result["arena_allocated_bytes"] = stats.arena_allocated_bytes;
+        result["arena_num_extensions"] = stats.arena_num_extensions;
+        return result;
+      })
       .def("run_with_iobinding", [](PyInferenceSession* sess, SessionIOBinding& io_binding, RunOptions* run_options = nullptr) -> void {
         Status status;
         // release GIL to allow multiple python threads to invoke Run() in parallel.
@@ -10,7 +10,7 @@
 #include "core/framework/session_options.h"
 #include "core/session/environment.h"
 #include "core/session/inference_session.h"
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
 #include "core/dlpack/dlpack_converter.h"
 #endif
 
@@ -287,15 +287,15 @@ struct PyInferenceSession {
   }
 #endif
 
+  // Wraps an already created session, e.g. a clone of another session.
+  explicit PyInferenceSession(std::unique_ptr<InferenceSession> sess) {
+    sess_ = std::move(sess);
+  }
+
   InferenceSession* GetSessionHandle() const { return sess_.get(); }
 
   virtual ~PyInferenceSession() {}
 
- protected:
-  PyInferenceSession(std::unique_ptr<InferenceSession> sess) {
-    sess_ = std::move(sess);
-  }
-
  private:
 #if !defined(ORT_MINIMAL_BUILD) || defined(ORT_MINIMAL_BUILD_CUSTOM_OPS)
   // Hold CustomOpLibrary resources so as to tie it to the life cycle of the InferenceSession needing it.
@@ -466,7 +466,7 @@ bool CheckIfTensor(const std::vector<const NodeArg*>& def_list,
                    const std::string& name,
                    /*out*/ ONNX_NAMESPACE::TypeProto& type_proto);
 
-#ifdef ENABLE_TRAINING
+#ifdef ENABLE_DLPACK
 
 // Allocate a new Capsule object, which takes the ownership of OrtValue.
 // Caller is responsible for releasing.
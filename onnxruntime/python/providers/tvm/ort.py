@@ -8,6 +8,8 @@ import collections
 import copy
 import logging
 import os
+import shutil
+import tempfile
 
 import onnx
 import tvm
@@ -35,6 +37,7 @@ def onnx_compile(
     nhwc=False,
     tuning_logfile="",
     tuning_type=AUTO_TVM_TYPE,
+    artifacts_dir="",
 ):
     def get_tvm_executor(irmod, executor, target, params):
         if executor == "vm":
@@ -127,6 +130,9 @@ def onnx_compile(
     if lib is None:
         return None
 
+    if artifacts_dir:
+        export_artifacts(lib, executor, artifacts_dir)
+
     ctx = tvm.device(target, 0)
     if executor == "vm":
         m = tvm.runtime.vm.VirtualMachine(lib, ctx)
@@ -140,3 +146,37 @@ def onnx_compile(
         return None
 
     return m.module
+
+
+def export_artifacts(lib, executor, artifacts_dir):
+    """
+    Saves the compiled module in the layout the TVM EP loads from its artifacts_folder.
+    Files are written to a temporary folder first, so a partially exported module is never picked up.
+    """
+    lib_name = "deploy.dll" if os.name == "nt" else "deploy.so"
+    parent_dir = os.path.dirname(os.path.abspath(artifacts_dir))
+    os.makedirs(parent_dir, exist_ok=True)
+    tmp_dir = tempfile.mkdtemp(dir=parent_dir)
+    try:
+        if executor == "vm":
+            consts_path = os.path.join(tmp_dir, "consts")
+            lib.move_late_bound_consts(consts_path, byte_limit=256)
+            code, vm_lib = lib.save()
+            vm_lib.export_library(os.path.join(tmp_dir, lib_name))
+            # The executable is still used by this session, give it back its constants
+            lib.load_late_bound_consts(consts_path)
+            with open(os.path.join(tmp_dir, "code.ro"), "wb") as code_file:
+                code_file.write(code)
+        else:
+            lib.export_library(os.path.join(tmp_dir, lib_name))
+            with open(os.path.join(tmp_dir, "deploy.json"), "w") as graph_file:
+                graph_file.write(lib.get_graph_json())
+            with open(os.path.join(tmp_dir, "deploy.params"), "wb") as params_file:
+                params_file.write(tvm.runtime.save_param_dict(lib.get_params()))
+        os.replace(tmp_dir, artifacts_dir)
+        log.info("Exported compiled module to %s", artifacts_dir)
+    except OSError as e:
+        # Another session may have exported the same module concurrently
+        log.warning("Unable to export compiled module to %s: %s", artifacts_dir, e)
+    finally:
+        shutil.rmtree(tmp_dir, ignore_errors=True)
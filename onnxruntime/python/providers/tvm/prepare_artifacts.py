@@ -0,0 +1,66 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation.  All rights reserved.
+# Licensed under the MIT License.  See License.txt in the project root for
+# license information.
+# --------------------------------------------------------------------------
+"""
+Offline compilation of the TVM EP subgraphs of a model.
+
+Creates an inference session with the given tuning log, so that every subgraph taken by the TVM EP is compiled
+and exported to the artifacts folder. Sessions created with the same options and artifacts_folder then load the
+exported modules instead of compiling them, and don't need the tuning log nor the TVM compiler.
+
+Example:
+    python -m onnxruntime.providers.tvm.prepare_artifacts model.onnx ./tvm_artifacts \\
+        --target "llvm -mcpu=skylake-avx512" --tuning_file_path tuning.log --tuning_type Ansor
+"""
+import argparse
+
+import onnxruntime
+
+from .ort import ANSOR_TYPE, AUTO_TVM_TYPE
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("model_path", help="ONNX model to compile")
+    parser.add_argument("artifacts_folder", help="Folder to export the compiled modules to")
+    parser.add_argument("--executor", default="vm", choices=["vm", "graph"])
+    parser.add_argument("--target", default="llvm")
+    parser.add_argument("--target_host", default="llvm")
+    parser.add_argument("--opt_level", type=int, default=3)
+    parser.add_argument("--freeze_weights", type=lambda v: v.lower() == "true", default=True)
+    parser.add_argument("--to_nhwc", type=lambda v: v.lower() == "true", default=False)
+    parser.add_argument("--tuning_file_path", default="")
+    parser.add_argument("--tuning_type", default=AUTO_TVM_TYPE, choices=[AUTO_TVM_TYPE, ANSOR_TYPE])
+    parser.add_argument("--input_names", default="")
+    parser.add_argument("--input_shapes", default="")
+    return parser.parse_args()
+
+
+def main():
+    args = parse_arguments()
+    provider_options = dict(
+        executor=args.executor,
+        artifacts_folder=args.artifacts_folder,
+        target=args.target,
+        target_host=args.target_host,
+        opt_level=args.opt_level,
+        freeze_weights=args.freeze_weights,
+        to_nhwc=args.to_nhwc,
+        tuning_file_path=args.tuning_file_path,
+        tuning_type=args.tuning_type,
+        input_names=args.input_names,
+        input_shapes=args.input_shapes,
+    )
+    # Tuning logs match the original model, ORT graph optimizations would change the subgraphs
+    so = onnxruntime.SessionOptions()
+    so.graph_optimization_level = onnxruntime.GraphOptimizationLevel.ORT_DISABLE_ALL
+    onnxruntime.InferenceSession(
+        args.model_path, sess_options=so, providers=["TvmExecutionProvider"], provider_options=[provider_options]
+    )
+    print("Compiled modules were exported to", args.artifacts_folder)
+
+
+if __name__ == "__main__":
+    main()
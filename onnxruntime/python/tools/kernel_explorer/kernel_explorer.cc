@@ -5,6 +5,8 @@
 #include <pybind11/numpy.h>
 #include "python/tools/kernel_explorer/device_array.h"
 #include "python/tools/kernel_explorer/kernels/vector_add.h"
+#include "python/tools/kernel_explorer/kernels/cpu/mlas.h"
+#include "python/tools/kernel_explorer/kernels/rocm/attention_softmax.h"
 #include "python/tools/kernel_explorer/kernels/rocm/fast_gelu.h"
 #include "python/tools/kernel_explorer/kernels/rocm/gemm.h"
 #include "python/tools/kernel_explorer/kernels/rocm/skip_layer_norm.h"
@@ -15,15 +17,19 @@ namespace py = pybind11;
 namespace onnxruntime {
 
 PYBIND11_MODULE(_kernel_explorer, m) {
+#if USE_CUDA || USE_ROCM
   py::class_<DeviceArray>(m, "DeviceArray")
       .def(py::init<py::array>())
       .def("UpdateHostNumpyArray", &DeviceArray::UpdateHostNumpyArray);
   InitVectorAdd(m);
+#endif
+  InitMlas(m);
 #if USE_ROCM
   InitFastGelu(m);
   InitGemm(m);
   InitSkipLayerNorm(m);
   InitGemmFastGelu(m);
+  InitAttentionSoftmax(m);
 #endif
 }
 
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <chrono>
+
 #ifdef USE_CUDA
 #include <cuda_runtime_api.h>
 #include "core/providers/cuda/tunable/cuda_tunable.h"
@@ -21,6 +23,7 @@ using onnxruntime::rocm::tunable::Timer;
 using StreamT = hipStream_t;
 #endif
 
+#if USE_CUDA || USE_ROCM
 /// Wrapping around Op and TunableOp
 class IKernelExplorer {
  public:
@@ -53,3 +56,32 @@ class IKernelExplorer {
   StreamT stream_{0};
   int repeats_{100};
 };
+#endif
+
+/// Wrapping around CPU routines, which are timed on the host
+class ICpuKernelExplorer {
+ public:
+  virtual void Run() = 0;
+
+  void SetRepeats(int n) {
+    repeats_ = n;
+  }
+
+  float Profile() {
+    // warm up
+    for (int i = 0; i < 5; i++) {
+      Run();
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < repeats_; i++) {
+      Run();
+    }
+    std::chrono::duration<float, std::milli> duration = std::chrono::steady_clock::now() - start;
+    return duration.count() / repeats_;
+  }
+
+  virtual ~ICpuKernelExplorer() = default;
+
+ private:
+  int repeats_{100};
+};
@@ -0,0 +1,131 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+# --------------------------------------------------------------------------
+
+import re
+import sys
+from dataclasses import dataclass
+from itertools import product
+
+import kernel_explorer as ke
+import numpy as np
+import pytest
+from utils import dtype_to_bytes
+
+
+def get_bert_sizes_test():
+    batch_sizes = [1, 3]
+    num_heads = [2, 12]
+    seq_lens = [1, 7, 64, 384, 1030]
+    return product(batch_sizes, num_heads, seq_lens)
+
+
+def get_bert_sizes_profile():
+    batch_sizes = [1, 8, 64]
+    num_heads = [12, 16]
+    seq_lens = [128, 384, 512, 2048]
+    return product(batch_sizes, num_heads, seq_lens)
+
+
+def dtype_to_funcs(dtype):
+    type_map = {
+        "float16": list(filter(lambda x: re.search("AttentionSoftmax.*_half", x), dir(ke))),
+        "float32": list(filter(lambda x: re.search("AttentionSoftmax.*_float", x), dir(ke))),
+    }
+    return type_map[dtype]
+
+
+def softmax(x):
+    x = x.astype("float32")
+    e = np.exp(x - np.max(x, axis=-1, keepdims=True))
+    return e / np.sum(e, axis=-1, keepdims=True)
+
+
+def run_attention_softmax(batch_size: int, num_heads: int, seq_len: int, dtype: str, func):
+    np.random.seed(0)
+    scores = (np.random.rand(batch_size, num_heads, seq_len, seq_len) * 10).astype(dtype)
+    output = np.zeros_like(scores)
+
+    scores_d = ke.DeviceArray(scores)
+    output_d = ke.DeviceArray(output)
+    f = getattr(ke, func)
+    my_op = f(output_d, scores_d, batch_size, num_heads, seq_len, seq_len, False)
+    if my_op.IsSupported():
+        my_op.Run()
+        output_d.UpdateHostNumpyArray()
+
+        atol = 1e-3 if dtype == "float16" else 1e-6
+        np.testing.assert_allclose(softmax(scores), output.astype("float32"), atol=atol)
+
+
+dtypes = ["float32", "float16"]
+
+
+@pytest.mark.parametrize("bert_sizes", get_bert_sizes_test())
+@pytest.mark.parametrize("dtype", dtypes)
+def test_attention_softmax(bert_sizes, dtype):
+    for func in dtype_to_funcs(dtype):
+        run_attention_softmax(*bert_sizes, dtype, func)
+
+
+@dataclass
+class AttentionSoftmaxMetric(ke.BandwidthMetric):
+    batch_size: int
+    num_heads: int
+    seq_len: int
+
+    def report(self):
+        prefix = f"{self.name:<50} {self.dtype}  batch_size={self.batch_size:<4} num_heads={self.num_heads:<4} seq_len={self.seq_len:<4} "
+        if self.duration > 0:
+            return prefix + f"{self.duration:.2f} us, {self.gbps:.2f} GB/s"
+        return prefix + "not supported or redundant"
+
+
+def profile_attention_softmax_func(batch_size, num_heads, seq_len, dtype, func):
+    np.random.seed(0)
+    scores = np.random.rand(batch_size, num_heads, seq_len, seq_len).astype(dtype)
+    output = np.zeros_like(scores)
+
+    scores_d = ke.DeviceArray(scores)
+    output_d = ke.DeviceArray(output)
+    f = getattr(ke, func)
+    my_op = f(output_d, scores_d, batch_size, num_heads, seq_len, seq_len, False)
+
+    duration_ms = -1
+    if my_op.IsSupported():
+        duration_ms = my_op.Profile()
+    total_bytes = scores.size * 2 * dtype_to_bytes(dtype)
+
+    ke.report(AttentionSoftmaxMetric(func, dtype, duration_ms, total_bytes, batch_size, num_heads, seq_len))
+
+
+def profile_with_args(batch_size, num_heads, seq_len, dtype, sort=True):
+    with ke.benchmark(sort):
+        for func in dtype_to_funcs(dtype):
+            profile_attention_softmax_func(batch_size, num_heads, seq_len, dtype, func)
+
+
+def profile():
+    for dtype in dtypes:
+        for bert_size in get_bert_sizes_profile():
+            profile_with_args(*bert_size, dtype)
+            print()
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    group = parser.add_argument_group("profile with args")
+    group.add_argument("batch_size", type=int)
+    group.add_argument("num_heads", type=int)
+    group.add_argument("seq_len", type=int)
+    group.add_argument("dtype", choices=dtypes)
+    group.add_argument("--sort", action="store_true")
+
+    if len(sys.argv) == 1:
+        profile()
+    else:
+        args = parser.parse_args()
+        profile_with_args(args.batch_size, args.num_heads, args.seq_len, args.dtype, args.sort)
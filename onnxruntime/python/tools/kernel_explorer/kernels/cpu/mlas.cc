@@ -0,0 +1,116 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "python/tools/kernel_explorer/kernels/cpu/mlas.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+#include "core/util/thread_utils.h"
+#include "python/tools/kernel_explorer/kernels/cpu/mlas_conv.h"
+#include "python/tools/kernel_explorer/kernels/cpu/mlas_gemm.h"
+#include "python/tools/kernel_explorer/kernels/cpu/mlas_kernel.h"
+#include "python/tools/kernel_explorer/kernels/cpu/mlas_softmax.h"
+#include "python/tools/kernel_explorer/kernels/cpu/mlas_transpose.h"
+
+namespace py = pybind11;
+
+namespace onnxruntime {
+
+namespace {
+
+std::unique_ptr<concurrency::ThreadPool> mlas_thread_pool;
+
+#if defined(MLAS_TARGET_AMD64_IX86)
+const std::pair<const char*, MLAS_ISA> kMlasIsas[] = {
+    {"SSE2", MlasIsaSse2},
+    {"AVX", MlasIsaAvx},
+    {"AVX2", MlasIsaAvx2},
+    {"AVXVNNI", MlasIsaAvxVnni},
+    {"AVX512F", MlasIsaAvx512F},
+    {"AVX512Core", MlasIsaAvx512Core},
+    {"AVX512VNNI", MlasIsaAvx512Vnni},
+    {"AMX", MlasIsaAmx},
+};
+
+MLAS_ISA selected_isa = MlasIsaNative;
+#endif
+
+// 0 or 1 runs the routines on the calling thread
+void SetMlasNumThreads(int num_threads) {
+  mlas_thread_pool.reset();
+  if (num_threads > 1) {
+    OrtThreadPoolParams params;
+    params.thread_pool_size = num_threads;
+    mlas_thread_pool = concurrency::CreateThreadPool(&Env::Default(), params, concurrency::ThreadPoolType::INTRA_OP);
+  }
+}
+
+int GetMlasNumThreads() {
+  return static_cast<int>(concurrency::ThreadPool::DegreeOfParallelism(mlas_thread_pool.get()));
+}
+
+}  // namespace
+
+MLAS_THREADPOOL* GetMlasThreadPool() {
+  return mlas_thread_pool.get();
+}
+
+const std::vector<std::string>& ListMlasIsas() {
+  static const std::vector<std::string> isas = []() {
+    std::vector<std::string> names;
+#if defined(MLAS_TARGET_AMD64_IX86)
+    // a level is listed when capping the selection to it selects kernels of that level, as the processor may
+    // support a higher level without a lower one (e.g. AVX512 without AVX-VNNI)
+    for (const auto& isa : kMlasIsas) {
+      MlasSetMaximumIsa(isa.second);
+      if (MlasGetIsa() == isa.second) {
+        names.emplace_back(isa.first);
+      }
+    }
+    MlasSetMaximumIsa(MlasIsaNative);
+    selected_isa = MlasIsaNative;
+#else
+    names.emplace_back("Default");
+#endif
+    return names;
+  }();
+  return isas;
+}
+
+bool SelectMlasIsa(const std::string& name) {
+  const auto& isas = ListMlasIsas();
+  if (std::find(isas.begin(), isas.end(), name) == isas.end()) {
+    return false;
+  }
+#if defined(MLAS_TARGET_AMD64_IX86)
+  for (const auto& isa : kMlasIsas) {
+    if (name == isa.first && selected_isa != isa.second) {
+      MlasSetMaximumIsa(isa.second);
+      selected_isa = isa.second;
+    }
+  }
+#endif
+  return true;
+}
+
+void InitMlas(py::module mod) {
+  auto mlas = mod.def_submodule("mlas");
+  mlas.def("set_num_threads", &SetMlasNumThreads, "Number of threads the MLAS routines run on");
+  mlas.def("get_num_threads", &GetMlasNumThreads);
+  mlas.def("list_isas", &ListMlasIsas, "Instruction set levels with distinct kernels on this processor");
+
+  InitMlasGemm(mod);
+  InitMlasConv(mod);
+  InitMlasSoftmax(mod);
+  InitMlasTranspose(mod);
+}
+
+}  // namespace onnxruntime
@@ -0,0 +1,94 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "python/tools/kernel_explorer/kernels/cpu/mlas_conv.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <vector>
+
+#include "python/tools/kernel_explorer/kernels/cpu/mlas_kernel.h"
+
+namespace py = pybind11;
+
+namespace onnxruntime {
+
+// 2D NCHW float convolution, Y = Conv(X, W) + B
+class MlasConv2D : public MlasKernelExplorer {
+ public:
+  MlasConv2D(int64_t batch, int64_t group, int64_t input_channels, int64_t input_h, int64_t input_w,
+             int64_t filter_count, int64_t kernel_h, int64_t kernel_w,
+             int64_t pad_h, int64_t pad_w, int64_t stride_h, int64_t stride_w, int64_t dilation_h, int64_t dilation_w,
+             py::array x, py::array w, py::array b, py::array y)
+      : batch_(batch),
+        group_(group),
+        input_channels_(input_channels),
+        filter_count_(filter_count),
+        input_shape_{input_h, input_w},
+        kernel_shape_{kernel_h, kernel_w},
+        dilations_{dilation_h, dilation_w},
+        pads_{pad_h, pad_w, pad_h, pad_w},
+        strides_{stride_h, stride_w},
+        x_(x),
+        w_(w),
+        b_(b),
+        y_(y) {
+    for (size_t i = 0; i < 2; i++) {
+      const int64_t kernel_extent = dilations_[i] * (kernel_shape_[i] - 1) + 1;
+      output_shape_[i] = (input_shape_[i] + pads_[i] + pads_[i + 2] - kernel_extent) / strides_[i] + 1;
+    }
+    ORT_ENFORCE(y_.size() == batch * filter_count * output_shape_[0] * output_shape_[1], "unexpected output size");
+    x_data_ = GetMlasArrayData<float>(x_);
+    w_data_ = GetMlasArrayData<float>(w_);
+    b_data_ = GetMlasArrayData<float>(b_);
+    y_data_ = GetMlasArrayData<float>(y_);
+    activation_.ActivationKind = MlasIdentityActivation;
+  }
+
+ protected:
+  void RunKernel() override {
+    // the convolution is prepared for each run, as the algorithm depends on the selected kernels
+    size_t working_buffer_size = 0;
+    MlasConvPrepare(&parameters_, 2, batch_, group_, input_channels_ / group_,
+                    input_shape_, kernel_shape_, dilations_, pads_, strides_, output_shape_,
+                    filter_count_ / group_, &activation_, &working_buffer_size, 0.0f, GetMlasThreadPool());
+    if (working_buffer_.size() < working_buffer_size) {
+      working_buffer_.resize(working_buffer_size);
+    }
+    MlasConv(&parameters_, x_data_, w_data_, b_data_, working_buffer_.data(), y_data_, GetMlasThreadPool());
+  }
+
+ private:
+  size_t batch_;
+  size_t group_;
+  size_t input_channels_;
+  size_t filter_count_;
+  int64_t input_shape_[2];
+  int64_t kernel_shape_[2];
+  int64_t dilations_[2];
+  int64_t pads_[4];
+  int64_t strides_[2];
+  int64_t output_shape_[2];
+  py::array x_;
+  py::array w_;
+  py::array b_;
+  py::array y_;
+  const float* x_data_;
+  const float* w_data_;
+  const float* b_data_;
+  float* y_data_;
+  MLAS_ACTIVATION activation_;
+  MLAS_CONV_PARAMETERS parameters_;
+  std::vector<float> working_buffer_;
+};
+
+void InitMlasConv(py::module mod) {
+  REGISTER_MLAS_OP("MlasConv2D", MlasConv2D)
+      .def(py::init<int64_t, int64_t, int64_t, int64_t, int64_t, int64_t, int64_t, int64_t,
+                    int64_t, int64_t, int64_t, int64_t, int64_t, int64_t,
+                    py::array, py::array, py::array, py::array>());
+}
+
+}  // namespace onnxruntime
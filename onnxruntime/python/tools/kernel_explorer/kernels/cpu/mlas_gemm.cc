@@ -0,0 +1,111 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "python/tools/kernel_explorer/kernels/cpu/mlas_gemm.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include <type_traits>
+
+#include "python/tools/kernel_explorer/kernels/cpu/mlas_kernel.h"
+
+namespace py = pybind11;
+
+namespace onnxruntime {
+
+class MlasSgemm : public MlasKernelExplorer {
+ public:
+  MlasSgemm(bool transa, bool transb,
+            int64_t m, int64_t n, int64_t k,
+            float alpha,
+            py::array a, int64_t lda,
+            py::array b, int64_t ldb,
+            float beta,
+            py::array c, int64_t ldc)
+      : transa_(transa ? CblasTrans : CblasNoTrans),
+        transb_(transb ? CblasTrans : CblasNoTrans),
+        m_(m), n_(n), k_(k), a_(a), b_(b), c_(c) {
+    params_.A = GetMlasArrayData<float>(a_);
+    params_.lda = lda;
+    params_.B = GetMlasArrayData<float>(b_);
+    params_.ldb = ldb;
+    params_.C = GetMlasArrayData<float>(c_);
+    params_.ldc = ldc;
+    params_.alpha = alpha;
+    params_.beta = beta;
+  }
+
+ protected:
+  void RunKernel() override {
+    MlasGemm(transa_, transb_, m_, n_, k_, params_, GetMlasThreadPool());
+  }
+
+ private:
+  CBLAS_TRANSPOSE transa_;
+  CBLAS_TRANSPOSE transb_;
+  size_t m_;
+  size_t n_;
+  size_t k_;
+  py::array a_;
+  py::array b_;
+  py::array c_;
+  MLAS_SGEMM_DATA_PARAMS params_;
+};
+
+// C (int32) = (A - zero_point_a) * (B - zero_point_b)
+template <typename AType, typename BType>
+class MlasQgemm : public MlasKernelExplorer {
+ public:
+  MlasQgemm(int64_t m, int64_t n, int64_t k,
+            py::array a, int64_t lda, AType zero_point_a,
+            py::array b, int64_t ldb, BType zero_point_b,
+            py::array c, int64_t ldc)
+      : a_(a), b_(b), c_(c), zero_point_b_(static_cast<uint8_t>(zero_point_b)) {
+    shape_.M = m;
+    shape_.N = n;
+    shape_.K = k;
+    shape_.AIsSigned = std::is_signed<AType>::value;
+    shape_.BIsSigned = std::is_signed<BType>::value;
+    params_.A = reinterpret_cast<const uint8_t*>(GetMlasArrayData<AType>(a_));
+    params_.lda = lda;
+    params_.ZeroPointA = static_cast<uint8_t>(zero_point_a);
+    params_.B = GetMlasArrayData<BType>(b_);
+    params_.ldb = ldb;
+    params_.ZeroPointB = &zero_point_b_;
+    params_.C = GetMlasArrayData<int32_t>(c_);
+    params_.ldc = ldc;
+  }
+
+ protected:
+  void RunKernel() override {
+    MlasGemm(shape_, params_, GetMlasThreadPool());
+  }
+
+ private:
+  py::array a_;
+  py::array b_;
+  py::array c_;
+  uint8_t zero_point_b_;
+  MLAS_GEMM_QUANT_SHAPE_PARAMS shape_;
+  MLAS_GEMM_QUANT_DATA_PARAMS params_;
+};
+
+void InitMlasGemm(py::module mod) {
+  REGISTER_MLAS_OP("MlasSgemm", MlasSgemm)
+      .def(py::init<bool, bool, int64_t, int64_t, int64_t, float,
+                    py::array, int64_t, py::array, int64_t, float, py::array, int64_t>());
+
+  using MlasQgemmU8U8 = MlasQgemm<uint8_t, uint8_t>;
+  REGISTER_MLAS_OP("MlasQgemm_U8U8", MlasQgemmU8U8)
+      .def(py::init<int64_t, int64_t, int64_t, py::array, int64_t, uint8_t,
+                    py::array, int64_t, uint8_t, py::array, int64_t>());
+
+  using MlasQgemmU8S8 = MlasQgemm<uint8_t, int8_t>;
+  REGISTER_MLAS_OP("MlasQgemm_U8S8", MlasQgemmU8S8)
+      .def(py::init<int64_t, int64_t, int64_t, py::array, int64_t, uint8_t,
+                    py::array, int64_t, int8_t, py::array, int64_t>());
+}
+
+}  // namespace onnxruntime
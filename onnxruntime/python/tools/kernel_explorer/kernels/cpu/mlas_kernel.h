@@ -0,0 +1,76 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "core/common/common.h"
+#include "core/mlas/inc/mlas.h"
+#include "python/tools/kernel_explorer/kernel_explorer_interface.h"
+
+namespace py = pybind11;
+
+namespace onnxruntime {
+
+/// Thread pool the MLAS routines run on, nullptr when they run on the calling thread.
+MLAS_THREADPOOL* GetMlasThreadPool();
+
+/// Names of the instruction set levels with distinct kernels on this processor, from the lowest to the highest.
+const std::vector<std::string>& ListMlasIsas();
+
+/// Selects the kernels of the named instruction set level, false if the processor does not support it.
+bool SelectMlasIsa(const std::string& name);
+
+/// Numpy arrays are used in place, so the outputs are visible from Python without a copy back.
+template <typename T>
+T* GetMlasArrayData(py::array& array) {
+  ORT_ENFORCE(py::isinstance<py::array_t<T>>(array), "unexpected array dtype");
+  ORT_ENFORCE((array.flags() & py::array::c_style) != 0, "array must be C contiguous");
+  return static_cast<T*>(array.mutable_data());
+}
+
+/// Wrapping around an MLAS routine. The ops are the instruction set levels the kernels of the routine are selected
+/// from, so that the same shape can be compared across e.g. AVX2, AVX512 and VNNI. The kernels are selected for the
+/// whole process, so the level of the op is selected again before each run.
+class MlasKernelExplorer : public ICpuKernelExplorer {
+ public:
+  void Run() override {
+    ORT_ENFORCE(SelectMlasIsa(isa_));
+    RunKernel();
+  }
+
+  std::vector<std::string> ListOps() const {
+    return ListMlasIsas();
+  }
+
+  bool SelectOp(const std::string& name) {
+    const auto& isas = ListMlasIsas();
+    if (std::find(isas.begin(), isas.end(), name) == isas.end()) {
+      return false;
+    }
+    isa_ = name;
+    return true;
+  }
+
+ protected:
+  virtual void RunKernel() = 0;
+
+ private:
+  std::string isa_{ListMlasIsas().back()};
+};
+
+#define REGISTER_MLAS_OP(name, type)        \
+  py::class_<type>(mod, name)               \
+      .def("SetRepeats", &type::SetRepeats) \
+      .def("Profile", &type::Profile)       \
+      .def("Run", &type::Run)               \
+      .def("ListOps", &type::ListOps)       \
+      .def("SelectOp", &type::SelectOp)
+
+}  // namespace onnxruntime
@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "python/tools/kernel_explorer/kernels/cpu/mlas_softmax.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include "python/tools/kernel_explorer/kernels/cpu/mlas_kernel.h"
+
+namespace py = pybind11;
+
+namespace onnxruntime {
+
+// Softmax or LogSoftmax over the last dimension of a (n, d) input
+class MlasSoftmax : public MlasKernelExplorer {
+ public:
+  MlasSoftmax(int64_t n, int64_t d, bool log_softmax, py::array x, py::array y)
+      : n_(n), d_(d), log_softmax_(log_softmax), x_(x), y_(y) {
+    x_data_ = GetMlasArrayData<float>(x_);
+    y_data_ = GetMlasArrayData<float>(y_);
+  }
+
+ protected:
+  void RunKernel() override {
+    MlasComputeSoftmax(x_data_, y_data_, n_, d_, log_softmax_, GetMlasThreadPool());
+  }
+
+ private:
+  size_t n_;
+  size_t d_;
+  bool log_softmax_;
+  py::array x_;
+  py::array y_;
+  const float* x_data_;
+  float* y_data_;
+};
+
+void InitMlasSoftmax(py::module mod) {
+  REGISTER_MLAS_OP("MlasSoftmax", MlasSoftmax)
+      .def(py::init<int64_t, int64_t, bool, py::array, py::array>());
+}
+
+}  // namespace onnxruntime
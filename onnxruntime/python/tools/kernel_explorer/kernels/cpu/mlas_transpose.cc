@@ -0,0 +1,49 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "python/tools/kernel_explorer/kernels/cpu/mlas_transpose.h"
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+
+#include "python/tools/kernel_explorer/kernels/cpu/mlas_kernel.h"
+
+namespace py = pybind11;
+
+namespace onnxruntime {
+
+// Y (n, m) = transpose of X (m, n)
+template <typename T>
+class MlasTranspose2D : public MlasKernelExplorer {
+ public:
+  MlasTranspose2D(int64_t m, int64_t n, py::array x, py::array y) : m_(m), n_(n), x_(x), y_(y) {
+    x_data_ = GetMlasArrayData<T>(x_);
+    y_data_ = GetMlasArrayData<T>(y_);
+  }
+
+ protected:
+  void RunKernel() override {
+    MlasTranspose(x_data_, y_data_, m_, n_);
+  }
+
+ private:
+  size_t m_;
+  size_t n_;
+  py::array x_;
+  py::array y_;
+  const T* x_data_;
+  T* y_data_;
+};
+
+void InitMlasTranspose(py::module mod) {
+  using MlasTransposeFloat = MlasTranspose2D<float>;
+  REGISTER_MLAS_OP("MlasTranspose_float", MlasTransposeFloat)
+      .def(py::init<int64_t, int64_t, py::array, py::array>());
+
+  using MlasTransposeUint8 = MlasTranspose2D<uint8_t>;
+  REGISTER_MLAS_OP("MlasTranspose_uint8", MlasTransposeUint8)
+      .def(py::init<int64_t, int64_t, py::array, py::array>());
+}
+
+}  // namespace onnxruntime
@@ -5,3 +5,11 @@ class DeviceArray:
 class blas_op:
     T: int
     N: int
+
+class mlas:
+    @staticmethod
+    def set_num_threads(num_threads: int) -> None: ...
+    @staticmethod
+    def get_num_threads() -> int: ...
+    @staticmethod
+    def list_isas() -> list[str]: ...
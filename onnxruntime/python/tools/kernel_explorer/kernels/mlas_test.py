@@ -0,0 +1,234 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License.
+# --------------------------------------------------------------------------
+
+import sys
+from dataclasses import dataclass
+from itertools import product
+
+import kernel_explorer as ke
+import numpy as np
+import pytest
+from utils import get_gemm_basic_sizes, get_gemm_bert_sizes, transab_to_suffix
+
+# Every MLAS op is run with the kernels of each instruction set level the processor supports, see ke.mlas.list_isas()
+
+
+def _run_all_isas(op, check):
+    failures = {}
+    for isa in op.ListOps():
+        assert op.SelectOp(isa)
+        op.Run()
+        try:
+            check()
+        except Exception as err:
+            failures[isa] = str(err)
+    if failures:
+        raise Exception(failures)
+
+
+def _test_sgemm(m, n, k, transa, transb):
+    a_shape = (k, m) if transa else (m, k)
+    b_shape = (n, k) if transb else (k, n)
+
+    np.random.seed(0)
+    a = (np.random.rand(*a_shape) * 2 - 1).astype("float32")
+    b = (np.random.rand(*b_shape) * 2 - 1).astype("float32")
+    ref_c = (a.T if transa else a).astype("float64") @ (b.T if transb else b).astype("float64")
+    c = np.zeros((m, n), dtype="float32")
+
+    op = ke.MlasSgemm(transa, transb, m, n, k, 1.0, a, a_shape[1], b, b_shape[1], 0.0, c, n)
+    _run_all_isas(op, lambda: np.testing.assert_allclose(c, ref_c, rtol=1e-4, atol=1e-4 * k))
+
+
+def _test_qgemm(m, n, k, b_dtype):
+    np.random.seed(0)
+    a = np.random.randint(0, 256, size=(m, k)).astype("uint8")
+    # the u8s8 kernels of AVX2 saturate the sum of two products, keep B in a range where they are exact
+    b_range = (-64, 64) if b_dtype == "int8" else (0, 256)
+    b = np.random.randint(*b_range, size=(k, n)).astype(b_dtype)
+    zero_point_a = 128
+    zero_point_b = 3
+    ref_c = (a.astype("int32") - zero_point_a) @ (b.astype("int32") - zero_point_b)
+    c = np.zeros((m, n), dtype="int32")
+
+    f = ke.MlasQgemm_U8S8 if b_dtype == "int8" else ke.MlasQgemm_U8U8
+    op = f(m, n, k, a, k, zero_point_a, b, n, zero_point_b, c, n)
+    _run_all_isas(op, lambda: np.testing.assert_array_equal(c, ref_c))
+
+
+def _conv2d_reference(x, w, b, pads, strides, dilations, group):
+    batch, channels, height, width = x.shape
+    filter_count, group_channels, kernel_h, kernel_w = w.shape
+    x = np.pad(x.astype("float64"), ((0, 0), (0, 0), (pads[0], pads[0]), (pads[1], pads[1])))
+    out_h = (height + 2 * pads[0] - dilations[0] * (kernel_h - 1) - 1) // strides[0] + 1
+    out_w = (width + 2 * pads[1] - dilations[1] * (kernel_w - 1) - 1) // strides[1] + 1
+    y = np.zeros((batch, filter_count, out_h, out_w))
+    group_filters = filter_count // group
+    for g, kh, kw in product(range(group), range(kernel_h), range(kernel_w)):
+        h0 = kh * dilations[0]
+        w0 = kw * dilations[1]
+        patch = x[
+            :,
+            g * group_channels : (g + 1) * group_channels,
+            h0 : h0 + strides[0] * (out_h - 1) + 1 : strides[0],
+            w0 : w0 + strides[1] * (out_w - 1) + 1 : strides[1],
+        ]
+        filters = w[g * group_filters : (g + 1) * group_filters, :, kh, kw]
+        y[:, g * group_filters : (g + 1) * group_filters] += np.einsum("bchw,fc->bfhw", patch, filters)
+    return y + b.reshape(1, -1, 1, 1)
+
+
+def _test_conv2d(batch, group, channels, size, filter_count, kernel, pad, stride, dilation):
+    np.random.seed(0)
+    x = (np.random.rand(batch, channels, size, size) * 2 - 1).astype("float32")
+    w = (np.random.rand(filter_count, channels // group, kernel, kernel) * 2 - 1).astype("float32")
+    b = (np.random.rand(filter_count) * 2 - 1).astype("float32")
+    ref_y = _conv2d_reference(x, w, b, (pad, pad), (stride, stride), (dilation, dilation), group)
+    y = np.zeros(ref_y.shape, dtype="float32")
+
+    op = ke.MlasConv2D(
+        batch, group, channels, size, size, filter_count, kernel, kernel,
+        pad, pad, stride, stride, dilation, dilation, x, w, b, y,
+    )  # fmt: skip
+    _run_all_isas(op, lambda: np.testing.assert_allclose(y, ref_y, rtol=1e-4, atol=1e-4))
+
+
+def _test_softmax(n, d, log_softmax):
+    np.random.seed(0)
+    x = (np.random.rand(n, d) * 20 - 10).astype("float32")
+    shifted = x.astype("float64") - x.max(axis=1, keepdims=True)
+    log_sum = np.log(np.exp(shifted).sum(axis=1, keepdims=True))
+    ref_y = shifted - log_sum if log_softmax else np.exp(shifted - log_sum)
+    y = np.zeros((n, d), dtype="float32")
+
+    op = ke.MlasSoftmax(n, d, log_softmax, x, y)
+    _run_all_isas(op, lambda: np.testing.assert_allclose(y, ref_y, rtol=1e-5, atol=1e-6))
+
+
+def _test_transpose(m, n, dtype):
+    np.random.seed(0)
+    x = np.random.randint(0, 256, size=(m, n)).astype(dtype)
+    y = np.zeros((n, m), dtype=dtype)
+
+    f = ke.MlasTranspose_uint8 if dtype == "uint8" else ke.MlasTranspose_float
+    op = f(m, n, x, y)
+    _run_all_isas(op, lambda: np.testing.assert_array_equal(y, x.T))
+
+
+all_transabs = list(product([True, False], repeat=2))
+
+
+@pytest.mark.parametrize("size", get_gemm_basic_sizes(full=False))
+@pytest.mark.parametrize("transab", all_transabs)
+def test_mlas_sgemm(size, transab):
+    _test_sgemm(*size, *transab)
+
+
+@pytest.mark.parametrize("size", get_gemm_basic_sizes(full=False))
+@pytest.mark.parametrize("b_dtype", ["uint8", "int8"])
+def test_mlas_qgemm(size, b_dtype):
+    _test_qgemm(*size, b_dtype)
+
+
+@pytest.mark.parametrize(
+    "batch, group, channels, size, filter_count, kernel, pad, stride, dilation",
+    [
+        (1, 1, 3, 17, 8, 3, 1, 1, 1),
+        (2, 1, 16, 14, 32, 3, 1, 2, 1),
+        (1, 1, 32, 7, 64, 1, 0, 1, 1),
+        (1, 4, 16, 9, 8, 3, 2, 1, 2),
+        (1, 16, 16, 12, 16, 3, 1, 1, 1),
+    ],
+)
+def test_mlas_conv2d(batch, group, channels, size, filter_count, kernel, pad, stride, dilation):
+    _test_conv2d(batch, group, channels, size, filter_count, kernel, pad, stride, dilation)
+
+
+@pytest.mark.parametrize("n, d", [(1, 1), (3, 17), (128, 128), (7, 1000)])
+@pytest.mark.parametrize("log_softmax", [False, True])
+def test_mlas_softmax(n, d, log_softmax):
+    _test_softmax(n, d, log_softmax)
+
+
+@pytest.mark.parametrize("m, n", [(1, 1), (3, 17), (16, 16), (129, 65)])
+@pytest.mark.parametrize("dtype", ["float32", "uint8"])
+def test_mlas_transpose(m, n, dtype):
+    _test_transpose(m, n, dtype)
+
+
+@dataclass
+class MlasGemmMetric(ke.ComputeMetric):
+    transa: bool
+    transb: bool
+    m: int
+    n: int
+    k: int
+
+    def report(self):
+        prefix = f"{self.name:<50} {self.dtype} {transab_to_suffix((self.transa, self.transb))} "
+        return prefix + f"m={self.m:<4} n={self.n:<4} k={self.k:<4} {self.duration:>10.2f} us {self.tflops:>6.3f} tflops"
+
+
+def profile_sgemm(transa, transb, m, n, k):
+    a_shape = (k, m) if transa else (m, k)
+    b_shape = (n, k) if transb else (k, n)
+    np.random.seed(0)
+    a = (np.random.rand(*a_shape) * 2 - 1).astype("float32")
+    b = (np.random.rand(*b_shape) * 2 - 1).astype("float32")
+    c = np.zeros((m, n), dtype="float32")
+
+    op = ke.MlasSgemm(transa, transb, m, n, k, 1.0, a, a_shape[1], b, b_shape[1], 0.0, c, n)
+    for isa in op.ListOps():
+        op.SelectOp(isa)
+        ke.report(MlasGemmMetric("MlasSgemm_" + isa, "float32", op.Profile(), m * n * k * 2, transa, transb, m, n, k))
+
+
+def profile_qgemm(m, n, k, b_dtype):
+    np.random.seed(0)
+    a = np.random.randint(0, 256, size=(m, k)).astype("uint8")
+    b = np.random.randint(0, 128, size=(k, n)).astype(b_dtype)
+    c = np.zeros((m, n), dtype="int32")
+
+    f = ke.MlasQgemm_U8S8 if b_dtype == "int8" else ke.MlasQgemm_U8U8
+    op = f(m, n, k, a, k, 128, b, n, 0, c, n)
+    for isa in op.ListOps():
+        op.SelectOp(isa)
+        name = f"MlasQgemm_U8{'S8' if b_dtype == 'int8' else 'U8'}_{isa}"
+        ke.report(MlasGemmMetric(name, "uint8", op.Profile(), m * n * k * 2, False, False, m, n, k))
+
+
+def profile_with_args(transa, transb, m, n, k, threads, sort):
+    ke.mlas.set_num_threads(threads)
+    with ke.benchmark(sort):
+        profile_sgemm(transa, transb, m, n, k)
+        if not transa and not transb:
+            profile_qgemm(m, n, k, "uint8")
+            profile_qgemm(m, n, k, "int8")
+
+
+def profile(threads):
+    for m, n, k in get_gemm_bert_sizes(full=False):
+        profile_with_args(False, False, m, n, k, threads, True)
+        print()
+
+
+if __name__ == "__main__":
+    import argparse
+
+    parser = argparse.ArgumentParser()
+    group = parser.add_argument_group("profile with args")
+    group.add_argument("transa", choices="NT")
+    group.add_argument("transb", choices="NT")
+    group.add_argument("m", type=int)
+    group.add_argument("n", type=int)
+    group.add_argument("k", type=int)
+    group.add_argument("--sort", action="store_true")
+    parser.add_argument("--threads", type=int, default=1, help="number of threads the MLAS routines run on")
+
+    if len(sys.argv) == 1:
+        profile(threads=1)
+    else:
+        args = parser.parse_args()
+        profile_with_args(args.transa == "T", args.transb == "T", args.m, args.n, args.k, args.threads, args.sort)
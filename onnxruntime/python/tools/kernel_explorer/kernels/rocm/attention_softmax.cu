@@ -0,0 +1,142 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "python/tools/kernel_explorer/kernels/rocm/attention_softmax.h"
+
+#include <hip/hip_fp16.h>
+#include <pybind11/pybind11.h>
+
+#include "contrib_ops/rocm/bert/attention_softmax_tunable_op.h"
+#include "python/tools/kernel_explorer/device_array.h"
+#include "python/tools/kernel_explorer/kernel_explorer_interface.h"
+
+namespace py = pybind11;
+
+namespace onnxruntime {
+
+template <typename T>
+class AttentionSoftmaxBase : public IKernelExplorer {
+ public:
+  AttentionSoftmaxBase(DeviceArray& output, DeviceArray& input, int batch_size, int num_heads,
+                       int sequence_length, int all_sequence_length, bool is_unidirectional)
+      : params_(this->Stream(), nullptr, all_sequence_length, sequence_length, batch_size, num_heads,
+                nullptr, static_cast<T*>(input.ptr()), static_cast<T*>(output.ptr()), is_unidirectional) {}
+
+ protected:
+  using ParamsT = contrib::rocm::AttentionSoftmaxParams<T>;
+  ParamsT params_;
+};
+
+template <typename T, int ThreadsPerBlock>
+class AttentionSoftmaxBlock : public AttentionSoftmaxBase<T> {
+ public:
+  using AttentionSoftmaxBase<T>::AttentionSoftmaxBase;
+
+  void Run() override {
+    ORT_THROW_IF_ERROR((contrib::rocm::AttentionSoftmaxBlockOp<T, ThreadsPerBlock>(&this->params_)));
+  }
+
+  bool IsSupported() {
+    Status status = contrib::rocm::AttentionSoftmaxBlockOp<T, ThreadsPerBlock>(&this->params_);
+    return status.IsOK();
+  }
+};
+
+template <typename T, int ThreadsPerBlock, int VecSize>
+class AttentionSoftmaxVec : public AttentionSoftmaxBase<T> {
+ public:
+  using AttentionSoftmaxBase<T>::AttentionSoftmaxBase;
+
+  void Run() override {
+    ORT_THROW_IF_ERROR((contrib::rocm::AttentionSoftmaxVecOp<T, ThreadsPerBlock, VecSize>(&this->params_)));
+  }
+
+  bool IsSupported() {
+    Status status = contrib::rocm::AttentionSoftmaxVecOp<T, ThreadsPerBlock, VecSize>(&this->params_);
+    return status.IsOK();
+  }
+};
+
+template <typename T>
+class AttentionSoftmaxStaticSelection : public AttentionSoftmaxBase<T> {
+ public:
+  using AttentionSoftmaxBase<T>::AttentionSoftmaxBase;
+
+  void Run() override {
+    ORT_THROW_IF_ERROR((contrib::rocm::AttentionSoftmaxStaticSelection<T>(&this->params_)));
+  }
+
+  bool IsSupported() {
+    return true;
+  }
+};
+
+template <typename T>
+class AttentionSoftmaxTunable : public AttentionSoftmaxBase<T> {
+ public:
+  AttentionSoftmaxTunable(DeviceArray& output, DeviceArray& input, int batch_size, int num_heads,
+                          int sequence_length, int all_sequence_length, bool is_unidirectional)
+      : AttentionSoftmaxBase<T>(output, input, batch_size, num_heads, sequence_length, all_sequence_length,
+                                is_unidirectional) {
+    op_.EnableTuning();
+  }
+
+  void Run() override {
+    ORT_THROW_IF_ERROR(op_(&this->params_));
+  }
+
+  bool IsSupported() {
+    return true;
+  }
+
+ private:
+  contrib::rocm::AttentionSoftmaxTunableOp<T> op_{};
+};
+
+#define REGISTER_BLOCK_OP(type, threads_per_block)                                                  \
+  py::class_<AttentionSoftmaxBlock<type, threads_per_block>>(                                       \
+      m, "AttentionSoftmaxBlock_" #type "_" #threads_per_block)                                     \
+      .def(py::init<DeviceArray&, DeviceArray&, int, int, int, int, bool>())                        \
+      .def("SetRepeats", &AttentionSoftmaxBlock<type, threads_per_block>::SetRepeats)               \
+      .def("Profile", &AttentionSoftmaxBlock<type, threads_per_block>::Profile)                     \
+      .def("Run", &AttentionSoftmaxBlock<type, threads_per_block>::Run)                             \
+      .def("IsSupported", &AttentionSoftmaxBlock<type, threads_per_block>::IsSupported);
+
+#define REGISTER_VEC_OP(type, threads_per_block, vec_size)                                          \
+  py::class_<AttentionSoftmaxVec<type, threads_per_block, vec_size>>(                               \
+      m, "AttentionSoftmaxVec_" #type "_" #threads_per_block "_" #vec_size)                         \
+      .def(py::init<DeviceArray&, DeviceArray&, int, int, int, int, bool>())                        \
+      .def("SetRepeats", &AttentionSoftmaxVec<type, threads_per_block, vec_size>::SetRepeats)       \
+      .def("Profile", &AttentionSoftmaxVec<type, threads_per_block, vec_size>::Profile)             \
+      .def("Run", &AttentionSoftmaxVec<type, threads_per_block, vec_size>::Run)                     \
+      .def("IsSupported", &AttentionSoftmaxVec<type, threads_per_block, vec_size>::IsSupported);
+
+#define REGISTER_OPS_FOR_THREADS_PER_BLOCK(type, threads_per_block) \
+  REGISTER_BLOCK_OP(type, threads_per_block)                        \
+  REGISTER_VEC_OP(type, threads_per_block, 2)                       \
+  REGISTER_VEC_OP(type, threads_per_block, 4)                       \
+  REGISTER_VEC_OP(type, threads_per_block, 8)
+
+#define REGISTER_OP_TYPED(name, type)                                        \
+  py::class_<name<type>>(m, #name "_" #type)                                 \
+      .def(py::init<DeviceArray&, DeviceArray&, int, int, int, int, bool>()) \
+      .def("SetRepeats", &name<type>::SetRepeats)                            \
+      .def("Profile", &name<type>::Profile)                                  \
+      .def("Run", &name<type>::Run)                                          \
+      .def("IsSupported", &name<type>::IsSupported);
+
+#define REGISTER_OPS_TYPED(type)                        \
+  REGISTER_OPS_FOR_THREADS_PER_BLOCK(type, 64)          \
+  REGISTER_OPS_FOR_THREADS_PER_BLOCK(type, 128)         \
+  REGISTER_OPS_FOR_THREADS_PER_BLOCK(type, 256)         \
+  REGISTER_OPS_FOR_THREADS_PER_BLOCK(type, 512)         \
+  REGISTER_OPS_FOR_THREADS_PER_BLOCK(type, 1024)        \
+  REGISTER_OP_TYPED(AttentionSoftmaxStaticSelection, type) \
+  REGISTER_OP_TYPED(AttentionSoftmaxTunable, type)
+
+void InitAttentionSoftmax(py::module m) {
+  REGISTER_OPS_TYPED(half)
+  REGISTER_OPS_TYPED(float)
+}
+
+}  // namespace onnxruntime
@@ -166,6 +166,7 @@ class MinMaxCalibrater(CalibraterBase):
         use_external_data_format=False,
         moving_average=False,
         averaging_constant=0.01,
+        max_intermediate_outputs=None,
     ):
         """
         :param model: ONNX model to calibrate. It can be a ModelProto or a model path
@@ -175,6 +176,7 @@ class MinMaxCalibrater(CalibraterBase):
         :param use_external_data_format: use external data format to store model which size is >= 2Gb
         :param moving_average: compute the moving average of the minimum and maximum values instead of the global minimum and maximum.
         :param averaging_constant: constant smoothing factor to use when computing the moving average.
+        :param max_intermediate_outputs: maximum number of intermediate outputs kept before computing the range.
         """
         super(MinMaxCalibrater, self).__init__(
             model,
@@ -191,6 +193,7 @@ class MinMaxCalibrater(CalibraterBase):
         if moving_average and (averaging_constant < 0 or averaging_constant > 1):
             raise ValueError("Invalid averaging constant, which should not be < 0 or > 1.")
         self.averaging_constant = averaging_constant
+        self.max_intermediate_outputs = max_intermediate_outputs
 
     def augment_graph(self):
         """
@@ -247,8 +250,14 @@ class MinMaxCalibrater(CalibraterBase):
             if not inputs:
                 break
             self.intermediate_outputs.append(self.infer_session.run(None, inputs))
-
-        if len(self.intermediate_outputs) == 0:
+            if (
+                self.max_intermediate_outputs is not None
+                and len(self.intermediate_outputs) == self.max_intermediate_outputs
+            ):
+                self.compute_range()
+                self.clear_collected_data()
+
+        if len(self.intermediate_outputs) == 0 and self.calibrate_tensors_range is None:
             raise ValueError("No data is collected.")
 
         self.compute_range()
@@ -338,6 +347,7 @@ class HistogramCalibrater(CalibraterBase):
         num_bins=128,
         num_quantized_bins=2048,
         percentile=99.999,
+        max_intermediate_outputs=None,
     ):
         """
         :param model: ONNX model to calibrate. It can be a ModelProto or a model path
@@ -349,6 +359,7 @@ class HistogramCalibrater(CalibraterBase):
         :param num_bins: number of bins to create a new histogram for collecting tensor values.
         :param num_quantized_bins: number of quantized bins. Default 128.
         :param percentile: A float number between [0, 100]. Default 99.99.
+        :param max_intermediate_outputs: maximum number of intermediate outputs kept before adding them to histograms.
         """
         super(HistogramCalibrater, self).__init__(
             model,
@@ -367,6 +378,7 @@ class HistogramCalibrater(CalibraterBase):
         self.num_quantized_bins = num_quantized_bins
         self.percentile = percentile
         self.tensors_to_calibrate = None
+        self.max_intermediate_outputs = max_intermediate_outputs
 
     def augment_graph(self):
         """
@@ -394,26 +406,33 @@ class HistogramCalibrater(CalibraterBase):
         """
         Entropy Calibrator collects operators' tensors as well as generates tensor histogram for each operator.
         """
+        # Only fetch the tensors to calibrate. Outputs of the original model that are not calibrated are not needed.
+        output_names = list(self.tensors_to_calibrate)
         while True:
             inputs = data_reader.get_next()
             if not inputs:
                 break
-            self.intermediate_outputs.append(self.infer_session.run(None, inputs))
-
-        if len(self.intermediate_outputs) == 0:
+            self.intermediate_outputs.append(self.infer_session.run(output_names, inputs))
+            if (
+                self.max_intermediate_outputs is not None
+                and len(self.intermediate_outputs) == self.max_intermediate_outputs
+            ):
+                self.collect_intermediate_outputs(output_names)
+
+        if len(self.intermediate_outputs) == 0 and self.collector is None:
             raise ValueError("No data is collected.")
 
-        output_names = [self.infer_session.get_outputs()[i].name for i in range(len(self.intermediate_outputs[0]))]
-        output_dicts_list = [
-            dict(zip(output_names, intermediate_output)) for intermediate_output in self.intermediate_outputs
-        ]
-
-        merged_dict = {}
-        for d in output_dicts_list:
-            for k, v in d.items():
-                merged_dict.setdefault(k, []).append(v)
+        if len(self.intermediate_outputs) > 0:
+            self.collect_intermediate_outputs(output_names)
 
-        clean_merged_dict = dict((i, merged_dict[i]) for i in merged_dict if i in self.tensors_to_calibrate)
+    def collect_intermediate_outputs(self, output_names):
+        """
+        Add the intermediate outputs collected so far to the histograms, then release them.
+        """
+        clean_merged_dict = {}
+        for intermediate_output in self.intermediate_outputs:
+            for k, v in zip(output_names, intermediate_output):
+                clean_merged_dict.setdefault(k, []).append(v)
 
         if not self.collector:
             self.collector = HistogramCollector(
@@ -449,6 +468,7 @@ class EntropyCalibrater(HistogramCalibrater):
         symmetric=False,
         num_bins=128,
         num_quantized_bins=128,
+        max_intermediate_outputs=None,
     ):
         """
         :param model: ONNX model to calibrate. It can be a ModelProto or a model path
@@ -459,6 +479,7 @@ class EntropyCalibrater(HistogramCalibrater):
         :param symmetric: make range of tensor symmetric (central point is 0).
         :param num_bins: number of bins to create a new histogram for collecting tensor values.
         :param num_quantized_bins: number of quantized bins. Default 128.
+        :param max_intermediate_outputs: maximum number of intermediate outputs kept before adding them to histograms.
         """
         super(EntropyCalibrater, self).__init__(
             model,
@@ -469,6 +490,7 @@ class EntropyCalibrater(HistogramCalibrater):
             symmetric=symmetric,
             num_bins=num_bins,
             num_quantized_bins=num_quantized_bins,
+            max_intermediate_outputs=max_intermediate_outputs,
         )
 
 
@@ -483,6 +505,7 @@ class PercentileCalibrater(HistogramCalibrater):
         symmetric=False,
         num_bins=2048,
         percentile=99.999,
+        max_intermediate_outputs=None,
     ):
         """
         :param model: ONNX model to calibrate. It can be a ModelProto or a model path
@@ -493,6 +516,7 @@ class PercentileCalibrater(HistogramCalibrater):
         :param symmetric: make range of tensor symmetric (central point is 0).
         :param num_quantized_bins: number of quantized bins. Default 128.
         :param percentile: A float number between [0, 100]. Default 99.99.
+        :param max_intermediate_outputs: maximum number of intermediate outputs kept before adding them to histograms.
         """
         super(PercentileCalibrater, self).__init__(
             model,
@@ -503,6 +527,7 @@ class PercentileCalibrater(HistogramCalibrater):
             symmetric=symmetric,
             num_bins=num_bins,
             percentile=percentile,
+            max_intermediate_outputs=max_intermediate_outputs,
         )
 
 
@@ -851,6 +876,7 @@ def create_calibrator(
 ):
 
     calibrator = None
+    max_intermediate_outputs = extra_options.get("max_intermediate_outputs", None)
     if calibrate_method == CalibrationMethod.MinMax:
         # default settings for min-max algorithm
         symmetric = False if "symmetric" not in extra_options else extra_options["symmetric"]
@@ -864,6 +890,7 @@ def create_calibrator(
             symmetric=symmetric,
             moving_average=moving_average,
             averaging_constant=averaging_constant,
+            max_intermediate_outputs=max_intermediate_outputs,
         )
     elif calibrate_method == CalibrationMethod.Entropy:
         # default settings for entropy algorithm
@@ -878,6 +905,7 @@ def create_calibrator(
             symmetric=symmetric,
             num_bins=num_bins,
             num_quantized_bins=num_quantized_bins,
+            max_intermediate_outputs=max_intermediate_outputs,
         )
     elif calibrate_method == CalibrationMethod.Percentile:
         # default settings for percentile algorithm
@@ -892,6 +920,7 @@ def create_calibrator(
             symmetric=symmetric,
             num_bins=num_bins,
             percentile=percentile,
+            max_intermediate_outputs=max_intermediate_outputs,
         )
 
     if calibrator:
@@ -0,0 +1,319 @@
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See License.txt in the project root for
+# license information.
+# --------------------------------------------------------------------------
+"""
+Weight only quantization of MatMul nodes.
+
+Every MatMul whose second input is a constant 2D float weight is replaced with a com.microsoft MatMulNBits node.
+The weight is quantized to 4 bits blockwise along the input feature dimension, with one scale (and zero point when
+asymmetric) per block. The activations stay in float.
+
+Two algorithms are supported:
+    RTN: round to nearest, needs no calibration data.
+    GPTQ: quantizes the weight column by column and compensates the quantization error of each column on the
+          remaining ones, using the Hessian H = 2 * X^T * X of the MatMul input X collected on calibration data.
+          See https://arxiv.org/abs/2210.17323.
+"""
+
+import argparse
+import logging
+import tempfile
+from pathlib import Path
+from typing import List, Optional
+
+import numpy as np
+import onnx
+from onnx import ModelProto, TensorProto, helper, numpy_helper
+
+import onnxruntime
+
+from .calibrate import CalibrationDataReader
+from .onnx_model import ONNXModel
+from .quant_utils import ms_domain
+
+logger = logging.getLogger(__name__)
+
+QUANT_BITS = 4
+QUANT_MAX = (1 << QUANT_BITS) - 1
+SYMMETRIC_ZERO_POINT = 1 << (QUANT_BITS - 1)
+
+
+def _compute_scale_zero_point(blocks: np.ndarray, is_symmetric: bool):
+    """
+    Compute the scale and zero point of every block along the last axis of blocks.
+    """
+    if is_symmetric:
+        abs_max = np.abs(blocks).max(axis=-1)
+        scale = abs_max / (SYMMETRIC_ZERO_POINT - 1)
+        zero_point = np.full(scale.shape, SYMMETRIC_ZERO_POINT, dtype=np.float64)
+    else:
+        min_value = np.minimum(blocks.min(axis=-1), 0.0)
+        max_value = np.maximum(blocks.max(axis=-1), 0.0)
+        scale = (max_value - min_value) / QUANT_MAX
+        zero_point = np.zeros(scale.shape, dtype=np.float64)
+        np.divide(-min_value, scale, out=zero_point, where=scale != 0)
+        zero_point = np.clip(np.round(zero_point), 0, QUANT_MAX)
+
+    # All zero blocks quantize to the zero point with any scale.
+    scale = np.where(scale == 0, 1.0, scale)
+    return scale, zero_point
+
+
+def _quantize(values: np.ndarray, scale: np.ndarray, zero_point: np.ndarray):
+    return np.clip(np.round(values / scale) + zero_point, 0, QUANT_MAX)
+
+
+def _pack_nibbles(values: np.ndarray):
+    """
+    Pack pairs of 4 bits values along the last axis, the even element in the low nibble.
+    """
+    if values.shape[-1] % 2 != 0:
+        pad = [(0, 0)] * (values.ndim - 1) + [(0, 1)]
+        values = np.pad(values, pad, constant_values=SYMMETRIC_ZERO_POINT)
+    values = values.astype(np.uint8)
+    return values[..., 0::2] | (values[..., 1::2] << 4)
+
+
+def quantize_blockwise_rtn(weight: np.ndarray, block_size: int, is_symmetric: bool):
+    """
+    Round to nearest blockwise quantization of a (K, N) weight.
+    :return: the quantized weight, of shape (N, n_blocks, block_size / 2), and the scales and zero points of
+             shape (N, n_blocks)
+    """
+    k, n = weight.shape
+    n_blocks = (k + block_size - 1) // block_size
+    transposed = np.zeros((n, n_blocks * block_size), dtype=np.float64)
+    transposed[:, :k] = weight.T
+    blocks = transposed.reshape(n, n_blocks, block_size)
+
+    scale, zero_point = _compute_scale_zero_point(blocks, is_symmetric)
+    quantized = _quantize(blocks, scale[..., np.newaxis], zero_point[..., np.newaxis])
+    return _pack_nibbles(quantized), scale, zero_point
+
+
+def quantize_blockwise_gptq(
+    weight: np.ndarray, hessian: np.ndarray, block_size: int, is_symmetric: bool, percdamp: float = 0.01
+):
+    """
+    GPTQ blockwise quantization of a (K, N) weight, given the (K, K) Hessian of the MatMul input.
+    The scale and zero point of a block are computed from the weight updated by the previous blocks.
+    :return: same as quantize_blockwise_rtn
+    """
+    k, n = weight.shape
+    n_blocks = (k + block_size - 1) // block_size
+    padded_k = n_blocks * block_size
+
+    w = np.zeros((n, padded_k), dtype=np.float64)
+    w[:, :k] = weight.T
+    h = np.zeros((padded_k, padded_k), dtype=np.float64)
+    h[:k, :k] = hessian
+
+    # Input features that are always zero (including the padding) don't contribute to the output.
+    dead = np.diag(h) == 0
+    h[dead, dead] = 1.0
+    w[:, dead] = 0.0
+
+    diagonal = np.arange(padded_k)
+    h[diagonal, diagonal] += percdamp * np.mean(np.diag(h))
+    h_inv = np.linalg.cholesky(np.linalg.inv(h)).T
+
+    scale = np.empty((n, n_blocks), dtype=np.float64)
+    zero_point = np.empty((n, n_blocks), dtype=np.float64)
+    quantized = np.empty((n, padded_k), dtype=np.float64)
+    for b in range(n_blocks):
+        start = b * block_size
+        end = start + block_size
+        block_scale, block_zero_point = _compute_scale_zero_point(w[:, start:end], is_symmetric)
+        scale[:, b] = block_scale
+        zero_point[:, b] = block_zero_point
+
+        errors = np.empty((n, block_size), dtype=np.float64)
+        for i in range(start, end):
+            q = _quantize(w[:, i], block_scale, block_zero_point)
+            quantized[:, i] = q
+            error = (w[:, i] - (q - block_zero_point) * block_scale) / h_inv[i, i]
+            errors[:, i - start] = error
+            # Lazy update: only the rest of this block now, the following blocks once the block is done.
+            w[:, i + 1 : end] -= np.outer(error, h_inv[i, i + 1 : end])
+        w[:, end:] -= errors @ h_inv[start:end, end:]
+
+    return _pack_nibbles(quantized.reshape(n, n_blocks, block_size)), scale, zero_point
+
+
+class MatMulWeight4Quantizer:
+    """
+    Replace MatMul nodes with constant float weights by MatMulNBits nodes with 4 bits blockwise quantized weights.
+    """
+
+    def __init__(
+        self,
+        model: ModelProto,
+        block_size: int = 32,
+        is_symmetric: bool = False,
+        algorithm: str = "RTN",
+        calibration_data_reader: Optional[CalibrationDataReader] = None,
+        percdamp: float = 0.01,
+        nodes_to_exclude: Optional[List[str]] = None,
+    ):
+        """
+        :param model: ONNX model to quantize. Tensors with external data must already be loaded.
+        :param block_size: number of weights sharing a scale and zero point. A power of 2 in [32, 256].
+        :param is_symmetric: use a fixed zero point of 8 and do not emit the zero_points input.
+        :param algorithm: "RTN" or "GPTQ".
+        :param calibration_data_reader: data reader feeding the model inputs, required by GPTQ.
+        :param percdamp: dampening added to the Hessian diagonal by GPTQ, relative to the mean of the diagonal.
+        :param nodes_to_exclude: names of MatMul nodes to keep in float.
+        """
+        if block_size < 32 or block_size > 256 or (block_size & (block_size - 1)) != 0:
+            raise ValueError(f"block_size must be a power of 2 in [32, 256]. Got {block_size}")
+        if algorithm not in ("RTN", "GPTQ"):
+            raise ValueError(f"Unsupported weight only quantization algorithm {algorithm}")
+        if algorithm == "GPTQ" and calibration_data_reader is None:
+            raise ValueError("GPTQ needs a calibration data reader.")
+
+        self.model = ONNXModel(model)
+        self.block_size = block_size
+        self.is_symmetric = is_symmetric
+        self.algorithm = algorithm
+        self.calibration_data_reader = calibration_data_reader
+        self.percdamp = percdamp
+        self.nodes_to_exclude = set(nodes_to_exclude or [])
+
+    def _get_quantizable_matmul_nodes(self):
+        nodes = []
+        for node in self.model.nodes():
+            if node.op_type != "MatMul" or node.name in self.nodes_to_exclude:
+                continue
+            weight = self.model.get_initializer(node.input[1])
+            if weight is None or weight.data_type != TensorProto.FLOAT or len(weight.dims) != 2:
+                continue
+            nodes.append(node)
+        return nodes
+
+    def _collect_hessians(self, nodes):
+        """
+        Run the calibration data and accumulate X^T * X for the input X of every MatMul to quantize.
+        """
+        input_names = list(dict.fromkeys(node.input[0] for node in nodes))
+
+        augmented_model = ModelProto()
+        augmented_model.CopyFrom(self.model.model)
+        graph_outputs = set(output.name for output in augmented_model.graph.output)
+        for name in input_names:
+            if name not in graph_outputs:
+                augmented_model.graph.output.append(helper.make_empty_tensor_value_info(name))
+
+        hessians = {}
+        num_rows = {}
+        with tempfile.TemporaryDirectory(prefix="ort.quant.") as quant_tmp_dir:
+            augmented_model_path = Path(quant_tmp_dir).joinpath("augmented_model.onnx").as_posix()
+            onnx.save_model(
+                augmented_model,
+                augmented_model_path,
+                save_as_external_data=True,
+                all_tensors_to_one_file=True,
+                location="augmented_model.onnx.data",
+            )
+            del augmented_model
+
+            session = onnxruntime.InferenceSession(augmented_model_path, providers=["CPUExecutionProvider"])
+            while True:
+                inputs = self.calibration_data_reader.get_next()
+                if not inputs:
+                    break
+                for name, value in zip(input_names, session.run(input_names, inputs)):
+                    x = value.reshape(-1, value.shape[-1]).astype(np.float64)
+                    hessians[name] = hessians.get(name, 0) + x.T @ x
+                    num_rows[name] = num_rows.get(name, 0) + x.shape[0]
+            del session
+
+        if not hessians:
+            raise ValueError("No data is collected.")
+
+        return {name: 2 * h / num_rows[name] for name, h in hessians.items()}
+
+    def _quantize_node(self, node, hessians):
+        weight_tensor = self.model.get_initializer(node.input[1])
+        weight = numpy_helper.to_array(weight_tensor)
+        k, n = weight.shape
+
+        if self.algorithm == "GPTQ":
+            packed, scale, zero_point = quantize_blockwise_gptq(
+                weight, hessians[node.input[0]], self.block_size, self.is_symmetric, self.percdamp
+            )
+        else:
+            packed, scale, zero_point = quantize_blockwise_rtn(weight, self.block_size, self.is_symmetric)
+
+        b_name = weight_tensor.name + "_Q4"
+        scales_name = weight_tensor.name + "_scales"
+        self.model.add_initializer(numpy_helper.from_array(packed, b_name))
+        self.model.add_initializer(numpy_helper.from_array(scale.reshape(-1).astype(np.float32), scales_name))
+        inputs = [node.input[0], b_name, scales_name]
+        if not self.is_symmetric:
+            zero_points_name = weight_tensor.name + "_zero_points"
+            self.model.add_initializer(numpy_helper.from_array(_pack_nibbles(zero_point).reshape(-1), zero_points_name))
+            inputs.append(zero_points_name)
+
+        return helper.make_node(
+            "MatMulNBits",
+            inputs=inputs,
+            outputs=node.output,
+            name=node.name + "_Q4" if node.name else "",
+            domain=ms_domain,
+            K=k,
+            N=n,
+            bits=QUANT_BITS,
+            block_size=self.block_size,
+        )
+
+    def process(self):
+        nodes = self._get_quantizable_matmul_nodes()
+        hessians = self._collect_hessians(nodes) if self.algorithm == "GPTQ" and nodes else {}
+
+        for node in nodes:
+            logger.info(f"Quantizing {node.name} with {self.algorithm}")
+            self.model.add_node(self._quantize_node(node, hessians))
+            self.model.remove_node(node)
+
+        if nodes and not any(opset.domain == ms_domain for opset in self.model.opset_import()):
+            self.model.opset_import().extend([helper.make_opsetid(ms_domain, 1)])
+
+        # Drop the float weights that are not used anymore.
+        self.model.remove_unused_constant()
+        return self.model.model
+
+
+def parse_arguments():
+    parser = argparse.ArgumentParser(
+        description="""Weight only blockwise quantization of MatMul nodes to 4 bits MatMulNBits.
+GPTQ needs calibration data, and is available through the MatMulWeight4Quantizer API."""
+    )
+
+    parser.add_argument("--input", required=True, help="Path to the input model file")
+    parser.add_argument("--output", required=True, help="Path to the output model file")
+    parser.add_argument("--block_size", required=False, default=32, type=int, help="Block size for quantization")
+    parser.add_argument(
+        "--symmetric", required=False, default=False, action="store_true", help="Use symmetric quantization"
+    )
+    parser.add_argument(
+        "--use_external_data_format",
+        required=False,
+        default=False,
+        action="store_true",
+        help="Save the model with external data, needed for models >= 2GB",
+    )
+    parser.add_argument("--nodes_to_exclude", nargs="+", type=str, default=[], help="MatMul nodes to keep in float")
+    return parser.parse_args()
+
+
+if __name__ == "__main__":
+    args = parse_arguments()
+
+    model = onnx.load(args.input)
+    quantizer = MatMulWeight4Quantizer(
+        model, block_size=args.block_size, is_symmetric=args.symmetric, nodes_to_exclude=args.nodes_to_exclude
+    )
+    quantizer.process()
+    quantizer.model.save_model_to_file(args.output, args.use_external_data_format)
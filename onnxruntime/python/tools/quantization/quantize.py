@@ -139,6 +139,10 @@ class StaticQuantConfig(QuantConfig):
                         Default is 0.01. Constant smoothing factor to use when computing the moving average of the
                         minimum and maximum values. Effective only when the calibration method selected is MinMax and
                         when CalibMovingAverage is set to True.
+                    CalibMaxIntermediateOutputs = Optional[int] :
+                        Default is None. If set, the calibrator computes the ranges or histograms every time this many
+                        batches have been run and releases their intermediate outputs, so the memory used by calibration
+                        does not grow with the size of the calibration data set.
             execution_provider : A enum indicates the Execution Provider such as: CPU, TRT, NNAPI, SNE, etc.
         Raises:
             ValueError: Raise ValueError if execution provider is unknown
@@ -325,6 +329,10 @@ def quantize_static(
                     Default is 0.01. Constant smoothing factor to use when computing the moving average of the
                     minimum and maximum values. Effective only when the calibration method selected is MinMax and
                     when CalibMovingAverage is set to True.
+                CalibMaxIntermediateOutputs = Optional[int] :
+                    Default is None. If set, the calibrator computes the ranges or histograms every time this many
+                    batches have been run and releases their intermediate outputs, so the memory used by calibration
+                    does not grow with the size of the calibration data set.
     """
 
     extra_options = extra_options or {}
@@ -350,6 +358,7 @@ def quantize_static(
         ("CalibTensorRangeSymmetric", "symmetric"),
         ("CalibMovingAverage", "moving_average"),
         ("CalibMovingAverageConstant", "averaging_constant"),
+        ("CalibMaxIntermediateOutputs", "max_intermediate_outputs"),
     ]
     calib_extra_options = {
         key: extra_options.get(name) for (name, key) in calib_extra_options_keys if name in extra_options
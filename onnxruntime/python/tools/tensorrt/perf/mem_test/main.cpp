@@ -29,6 +29,9 @@ std::unique_ptr<OrtTensorRTProviderOptions> get_default_trt_provider_options() {
   tensorrt_options->trt_force_sequential_engine_build = false;
   tensorrt_options->trt_context_memory_sharing_enable = false;
   tensorrt_options->trt_layer_norm_fp32_fallback = false;
+  tensorrt_options->trt_engine_build_thread_count = 1;
+  tensorrt_options->trt_engine_build_in_background = false;
+  tensorrt_options->trt_max_optimization_profiles = 0;
   return tensorrt_options;
 }
 
@@ -3,6 +3,7 @@
 
 #include "core/common/logging/capture.h"
 #include "core/common/logging/logging.h"
+#include "core/common/logging/sinks/async_sink.h"
 #include "core/common/logging/sinks/cerr_sink.h"
 #include "core/common/logging/sinks/clog_sink.h"
 #include "core/common/logging/sinks/composite_sink.h"
@@ -10,6 +11,8 @@
 
 #include "test/common/logging/helpers.h"
 
+#include <future>
+
 using namespace ::onnxruntime::logging;
 using InstanceType = LoggingManager::InstanceType;
 
@@ -163,3 +166,91 @@ TEST(LoggingTests, TestCompositeSink) {
 
   LOGS_CATEGORY(*logger, WARNING, "ArbitraryCategory") << "Warning";
 }
+
+namespace {
+// Sink that records the messages and the writing threads, and can hold up the writer until released.
+class RecordingSink : public ISink {
+ public:
+  struct Record {
+    std::string message;
+    std::thread::id thread_id;
+  };
+
+  explicit RecordingSink(std::vector<Record>& records, std::shared_future<void> release = {})
+      : records_{records}, release_{std::move(release)} {}
+
+ private:
+  void SendImpl(const Timestamp&, const std::string&, const Capture& message) override {
+    if (release_.valid()) {
+      release_.wait();
+    }
+    records_.push_back({message.Message(), std::this_thread::get_id()});
+  }
+
+  std::vector<Record>& records_;
+  std::shared_future<void> release_;
+};
+}  // namespace
+
+/// <summary>
+/// Tests that AsyncSink writes the messages in order from its own thread.
+/// </summary>
+TEST(LoggingTests, TestAsyncSink) {
+  const std::string logid{"TestAsyncSink"};
+  const Severity min_log_level = Severity::kVERBOSE;
+  constexpr int kNumMessages = 100;
+
+  std::vector<RecordingSink::Record> records;
+  auto* async_sink = new AsyncSink(std::make_unique<RecordingSink>(records), kNumMessages);
+  LoggingManager manager{std::unique_ptr<ISink>(async_sink), min_log_level, false, InstanceType::Temporal};
+
+  auto logger = manager.CreateLogger(logid);
+  for (int i = 0; i < kNumMessages; ++i) {
+    LOGS(*logger, VERBOSE) << "Message " << i;
+  }
+
+  async_sink->Flush();
+
+  ASSERT_EQ(records.size(), static_cast<size_t>(kNumMessages));
+  for (int i = 0; i < kNumMessages; ++i) {
+    EXPECT_EQ(records[i].message, "Message " + std::to_string(i));
+    EXPECT_NE(records[i].thread_id, std::this_thread::get_id());
+  }
+  EXPECT_EQ(async_sink->DroppedMessageCount(), 0u);
+}
+
+/// <summary>
+/// Tests that AsyncSink drops and reports messages when the buffer is full instead of blocking the caller.
+/// </summary>
+TEST(LoggingTests, TestAsyncSinkDropsWhenFull) {
+  const std::string logid{"TestAsyncSinkDropsWhenFull"};
+  const Severity min_log_level = Severity::kVERBOSE;
+  constexpr size_t kCapacity = 4;
+  constexpr size_t kNumMessages = 64;
+
+  std::vector<RecordingSink::Record> records;
+  std::promise<void> release;
+  size_t dropped = 0;
+
+  // create scoped manager so the sink writes everything it buffered once done
+  {
+    auto* async_sink = new AsyncSink(std::make_unique<RecordingSink>(records, release.get_future().share()),
+                                     kCapacity);
+    LoggingManager manager{std::unique_ptr<ISink>(async_sink), min_log_level, false, InstanceType::Temporal};
+
+    auto logger = manager.CreateLogger(logid);
+    for (size_t i = 0; i < kNumMessages; ++i) {
+      LOGS(*logger, VERBOSE) << "Message " << i;
+    }
+
+    // the blocked writer holds at most one message outside of the buffer
+    dropped = async_sink->DroppedMessageCount();
+    EXPECT_GE(dropped, kNumMessages - kCapacity - 1);
+
+    release.set_value();
+  }
+
+  // everything that was not dropped, plus the report of the dropped messages
+  EXPECT_EQ(records.size(), kNumMessages - dropped + 1);
+  EXPECT_EQ(records.back().message.find("Dropped " + std::to_string(dropped)), 0u);
+}
@@ -0,0 +1,72 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/profiler.h"
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace profiling {
+namespace test {
+
+namespace {
+std::string ReadFile(const std::string& file_name) {
+  std::ifstream file(file_name);
+  std::stringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+size_t CountEvents(const std::string& trace) {
+  size_t num_events = 0;
+  for (size_t pos = trace.find("\"ph\""); pos != std::string::npos; pos = trace.find("\"ph\"", pos + 1)) {
+    ++num_events;
+  }
+  return num_events;
+}
+}  // namespace
+
+TEST(ProfilerTest, StreamsEventsInBatches) {
+  const std::string file_name = "profiler_streaming_test.json";
+  Profiler profiler;
+  profiler.SetStreamingBatchSize(2);
+  profiler.StartProfiling(file_name);
+
+  profiler.EndTimeAndRecordEvent(NODE_EVENT, "first", profiler.Start());
+  EXPECT_EQ(CountEvents(ReadFile(file_name)), 0u);
+  profiler.EndTimeAndRecordEvent(NODE_EVENT, "second", profiler.Start());
+  EXPECT_EQ(CountEvents(ReadFile(file_name)), 2u);
+  profiler.EndTimeAndRecordEvent(NODE_EVENT, "third", profiler.Start());
+  EXPECT_EQ(CountEvents(ReadFile(file_name)), 2u);
+
+  ASSERT_EQ(profiler.EndProfiling(), file_name);
+  const std::string trace = ReadFile(file_name);
+  EXPECT_EQ(CountEvents(trace), 3u);
+  EXPECT_EQ(trace.front(), '[');
+  EXPECT_EQ(trace.substr(trace.size() - 2), "]\n");
+  EXPECT_NE(trace.find("\"name\" :\"third\""), std::string::npos);
+}
+
+TEST(ProfilerTest, RecordsCountersAndEventsOfOtherThreads) {
+  const std::string file_name = "profiler_tracks_test.json";
+  Profiler profiler;
+  profiler.StartProfiling(file_name);
+
+  const auto start_time = profiler.Start();
+  profiler.RecordEvent(NODE_EVENT, "worker_run", 1234, start_time, start_time + std::chrono::microseconds(10));
+  profiler.RecordCounter("Cpu_arena", "bytes_in_use", 4096);
+
+  ASSERT_EQ(profiler.EndProfiling(), file_name);
+  const std::string trace = ReadFile(file_name);
+  EXPECT_EQ(CountEvents(trace), 2u);
+  EXPECT_NE(trace.find("\"tid\" :1234,\"dur\" :10,"), std::string::npos);
+  EXPECT_NE(trace.find(R"("ph" : "C","name" :"Cpu_arena","args" : {"bytes_in_use" : 4096})"), std::string::npos);
+}
+
+}  // namespace test
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -0,0 +1,112 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/common/sampling_profiler.h"
+
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace profiling {
+namespace test {
+
+TEST(SamplingProfilerTest, SamplesOneInNRuns) {
+  SamplingOptions options;
+  options.sample_every_n = 4;
+  SamplingProfiler profiler{options};
+
+  int num_sampled_runs = 0;
+  for (int i = 0; i < 20; ++i) {
+    num_sampled_runs += profiler.ShouldSampleRun() ? 1 : 0;
+  }
+  EXPECT_EQ(num_sampled_runs, 5);
+}
+
+TEST(SamplingProfilerTest, AggregatesLatencyHistograms) {
+  SamplingProfiler profiler{SamplingOptions{}};
+  const std::string fast_node = "fast";
+  const std::string slow_node = "slow";
+  const std::string unnamed_node;
+  const std::string op_type = "Add";
+
+  for (int i = 0; i < 10; ++i) {
+    profiler.RecordNodeLatency(fast_node, op_type, 0, std::chrono::nanoseconds(100));
+    profiler.RecordNodeLatency(slow_node, op_type, 1, std::chrono::nanoseconds(i < 9 ? 1000 : 100000));
+  }
+  profiler.RecordNodeLatency(unnamed_node, op_type, 2, std::chrono::nanoseconds(10));
+  profiler.OnSampledRunEnd();
+
+  const auto stats = profiler.GetNodeLatencies();
+  ASSERT_EQ(stats.size(), 3u);
+
+  // sorted by the total latency
+  EXPECT_EQ(stats[0].node_name, "slow");
+  EXPECT_EQ(stats[0].count, 10u);
+  EXPECT_EQ(stats[0].total_ns, 9u * 1000 + 100000);
+  EXPECT_EQ(stats[0].max_ns, 100000u);
+  EXPECT_EQ(stats[0].buckets[NodeLatencyStats::GetBucket(1000)], 9u);
+  EXPECT_EQ(stats[0].buckets[NodeLatencyStats::GetBucket(100000)], 1u);
+  EXPECT_LE(stats[0].GetPercentileUpperBoundNs(50), 1023u);
+  EXPECT_GE(stats[0].GetPercentileUpperBoundNs(50), 1000u);
+  EXPECT_EQ(stats[0].GetPercentileUpperBoundNs(100), 100000u);
+
+  EXPECT_EQ(stats[1].node_name, "fast");
+  EXPECT_EQ(stats[2].node_name, "Add_2");
+
+  profiler.Reset();
+  EXPECT_TRUE(profiler.GetNodeLatencies().empty());
+}
+
+TEST(SamplingProfilerTest, RecordsFromMultipleThreads) {
+  SamplingProfiler profiler{SamplingOptions{}};
+  const std::string node = "node";
+  const std::string op_type = "MatMul";
+
+  constexpr int kNumThreads = 4;
+  constexpr int kNumSamplesPerThread = 1000;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&]() {
+      for (int i = 0; i < kNumSamplesPerThread; ++i) {
+        profiler.RecordNodeLatency(node, op_type, 0, std::chrono::nanoseconds(50));
+        if (i % 100 == 0) {
+          profiler.OnSampledRunEnd();
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto stats = profiler.GetNodeLatencies();
+  ASSERT_EQ(stats.size(), 1u);
+  EXPECT_EQ(stats[0].count + profiler.GetNumDroppedSamples(), uint64_t{kNumThreads * kNumSamplesPerThread});
+}
+
+TEST(SamplingProfilerTest, ExportsAtInterval) {
+  std::vector<NodeLatencyStats> exported;
+  SamplingOptions options;
+  options.export_interval = std::chrono::milliseconds(1);
+  options.export_callback = [&exported](const std::vector<NodeLatencyStats>& stats) { exported = stats; };
+  SamplingProfiler profiler{options};
+
+  const std::string node = "node";
+  const std::string op_type = "Relu";
+  profiler.RecordNodeLatency(node, op_type, 0, std::chrono::nanoseconds(500));
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  profiler.OnSampledRunEnd();
+
+  ASSERT_EQ(exported.size(), 1u);
+  EXPECT_EQ(exported[0].node_name, "node");
+  EXPECT_EQ(exported[0].count, 1u);
+
+  // the stats are reset after the export
+  EXPECT_TRUE(profiler.GetNodeLatencies().empty());
+}
+
+}  // namespace test
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -41,5 +41,27 @@ TEST(Utf8UtilTest, Validate) {
   }
 }
 
+TEST(Utf8UtilTest, ValidateLongStrings) {
+  using namespace utf8_util;
+  // ASCII runs longer than a word, with multibyte characters at every alignment
+  const std::string ascii(21, 'a');
+  const std::string two_bytes("\xc3\xb1");
+  for (size_t pos = 0; pos <= ascii.size(); ++pos) {
+    std::string s = ascii;
+    s.insert(pos, two_bytes);
+    size_t chars = 0;
+    ASSERT_TRUE(utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(), chars));
+    ASSERT_EQ(ascii.size() + 1, chars);
+    chars = 0;
+    ASSERT_TRUE(utf8_len(reinterpret_cast<const unsigned char*>(s.data()), s.size(), chars));
+    ASSERT_EQ(ascii.size() + 1, chars);
+
+    // an invalid sequence after an ASCII run is still found
+    s = ascii;
+    s.insert(pos, "\xc3\x28");
+    ASSERT_FALSE(utf8_validate(reinterpret_cast<const unsigned char*>(s.data()), s.size(), chars));
+  }
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -664,6 +664,74 @@ TEST(AttentionTest, AttentionNoMaskIndex) {
                    batch_size, sequence_length, hidden_size, number_of_heads);
 }
 
+// Runs Attention with rotary position embedding or ALiBi on the data of AttentionBatch1 plus a third token.
+static void RunAttentionPositionEmbeddingTest(const std::vector<float>& output_data,
+                                              int rotary_embedding_dim, bool use_alibi, bool is_unidirectional) {
+  constexpr int batch_size = 1;
+  constexpr int sequence_length = 3;
+  constexpr int hidden_size = 4;
+  constexpr int number_of_heads = 2;
+
+  std::vector<float> input_data = {
+      0.8f, -0.5f, 0.0f, 1.f,
+      0.5f, 0.2f, 0.3f, -0.6f,
+      -0.3f, 0.4f, 0.9f, 0.1f};
+
+  std::vector<float> weight_data = {
+      0.1f, -0.2f, 0.3f, 1.0f, 1.1f, 0.3f, 0.5f, 0.2f, 0.3f, -0.6f, 1.5f, 2.0f,
+      0.5f, 0.1f, 0.4f, 1.6f, 1.0f, 2.0f, 0.4f, 0.8f, 0.9f, 0.1f, -1.3f, 0.7f,
+      0.3f, 0.2f, 4.0f, 2.2f, 1.6f, 1.1f, 0.7f, 0.2f, 0.4f, 1.0f, 1.2f, 0.5f,
+      0.2f, 0.1f, 0.4f, 1.6f, 2.4f, 3.3f, 2.1f, 4.2f, 8.4f, 0.0f, 2.1f, 3.2f};
+
+  std::vector<float> bias_data = {
+      -0.5f, 0.6f, 1.2f, 2.1f, 0.5f, 0.7f, 0.2f, 1.2f, 0.5f, 0.4f, 0.3f, 1.2f};
+
+  OpTester tester("Attention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+  tester.AddAttribute<int64_t>("unidirectional", static_cast<int64_t>(is_unidirectional ? 1 : 0));
+  tester.AddAttribute<int64_t>("rotary_embedding_dim", static_cast<int64_t>(rotary_embedding_dim));
+  tester.AddAttribute<int64_t>("use_alibi", static_cast<int64_t>(use_alibi ? 1 : 0));
+
+  tester.AddInput<float>("input", {batch_size, sequence_length, hidden_size}, input_data);
+  tester.AddInput<float>("weight", {hidden_size, 3 * hidden_size}, weight_data);
+  tester.AddInput<float>("bias", {3 * hidden_size}, bias_data);
+  tester.AddOutput<float>("output", {batch_size, sequence_length, hidden_size}, output_data);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCpuExecutionProvider());
+  if (HasCudaEnvironment(0)) {
+    execution_providers.push_back(DefaultCudaExecutionProvider());
+  }
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(AttentionTest, AttentionRotaryEmbedding) {
+  std::vector<float> output_data = {
+      2.253880f, 1.090193f, 4.250000f, 5.650000f,
+      1.355129f, 1.303179f, 4.249613f, 5.649573f,
+      1.285391f, 1.365990f, 0.620023f, 1.650025f};
+
+  RunAttentionPositionEmbeddingTest(output_data, 2, false, false);
+}
+
+TEST(AttentionTest, AttentionAlibi) {
+  std::vector<float> output_data = {
+      2.535766f, 0.712193f, 4.249796f, 5.649775f,
+      2.997799f, 0.703964f, 4.248989f, 5.648886f,
+      5.030556f, 0.614026f, 4.249999f, 5.649999f};
+
+  RunAttentionPositionEmbeddingTest(output_data, 0, true, false);
+}
+
+TEST(AttentionTest, AttentionUnidirectionalAlibi) {
+  std::vector<float> output_data = {
+      8.690000f, -0.130000f, 4.250000f, 5.650000f,
+      3.782155f, 0.081214f, 4.250000f, 5.650000f,
+      5.030556f, 0.614026f, 4.249999f, 5.649999f};
+
+  RunAttentionPositionEmbeddingTest(output_data, 0, true, true);
+}
+
 TEST(AttentionTest, AttentionUnidirectional) {
   int batch_size = 1;
   int sequence_length = 2;
@@ -852,7 +920,7 @@ void RawAttentionEmptyPastState(bool past_present_share_buffer) {
     RunAttentionTest(input_data, weight_data, bias_data, mask_index_data, output_data,
                     batch_size, sequence_length, hidden_size, number_of_heads, false, is_unidirectional,
                     use_past_state, past_sequence_length, &past_data, &present_data,
-                    kMaskIndexEnd, 0, sequence_length, true, false, true, {}, {}, 0, nullptr, nullptr,
+                    kMaskIndexEnd, 0, sequence_length, false, false, true, {}, {}, 0, nullptr, nullptr,
                     true);
   }
 }
@@ -968,7 +1036,7 @@ void RawAttentionPastStateBatch1(bool past_present_share_buffer) {
                     batch_size, sequence_length, hidden_size, number_of_heads, false, is_unidirectional,
                     use_past_state, past_sequence_length, &past_data, &present_data,
                     kMaskIndexEnd, 0, past_sequence_length + sequence_length + 4,
-                    true, false, true, {}, {}, 0, nullptr, nullptr,
+                    false, false, true, {}, {}, 0, nullptr, nullptr,
                     true);
   }
 }
@@ -1098,7 +1166,7 @@ void RawAttentionPastStateBatch2(bool past_present_share_buffer) {
                     batch_size, sequence_length, hidden_size, number_of_heads, false, is_unidirectional,
                     use_past_state, past_sequence_length, &past_data, &present_data,
                     kMaskIndexEnd, 0, past_sequence_length + sequence_length,
-                    true, false, true, {}, {}, 0, nullptr, nullptr,
+                    false, false, true, {}, {}, 0, nullptr, nullptr,
                     true);
   }
 }
@@ -1218,7 +1286,7 @@ void RawAttentionPastStateBatch2WithPadding(bool past_present_share_buffer) {
                     batch_size, sequence_length, hidden_size, number_of_heads, false, is_unidirectional,
                     use_past_state, past_sequence_length, &past_data, &present_data, kMaskIndexEndAndStart,
                     0, past_sequence_length + sequence_length + 4,
-                    true, false, true, {}, {}, 0, nullptr, nullptr,
+                    false, false, true, {}, {}, 0, nullptr, nullptr,
                     true);
   }
 }
@@ -2123,6 +2191,27 @@ TEST(AttentionTest, Attention_Mask1D_Fp32_B2_S64) {
       false);
 }
 
+// The sequence spans several query and key tiles of the tiled CPU attention.
+TEST(AttentionTest, Attention_Mask1D_Fp32_B2_S320) {
+  constexpr int batch_size = 2;
+  constexpr int sequence_length = 320;
+
+  std::vector<int64_t> mask_index_dims{batch_size};
+  std::vector<int32_t> mask_index_data;
+  for (int i = 0; i < batch_size; i++) {
+    mask_index_data.push_back(i == 0 ? sequence_length : (sequence_length / 2 + 7));
+  }
+
+  std::string onnx_model = "testdata/attention_mask1d_fp32.onnx";
+  RunModelWithRandomInput(
+      batch_size,
+      sequence_length,
+      mask_index_dims,
+      mask_index_data,
+      onnx_model,
+      false);
+}
+
 TEST(AttentionTest, DISABLED_Attention_Mask1D_Fp16_B2_FusedNoPadding) {
   constexpr int batch_size = 2;
 
@@ -411,6 +411,90 @@ TEST(DecoderAttentionTest, SelfAttentionNoStateNoCachePaddingMask) {
                    nullptr, nullptr, nullptr, nullptr, &key_padding_mask_data);
 }
 
+TEST(DecoderAttentionTest, SelfAttentionWithPagedCache) {
+  if (!HasCudaEnvironment(0)) {
+    return;
+  }
+
+  // Two beams of the sequence of SelfAttentionWithCache: they share the block of the past tokens and
+  // append the two query tokens to their own block.
+  constexpr int batch_size = 2;
+  constexpr int sequence_length = 2;
+  constexpr int hidden_size = 4;
+  constexpr int number_of_heads = 2;
+  constexpr int head_size = hidden_size / number_of_heads;
+  constexpr int num_blocks = 3;
+  constexpr int block_size = 2;
+  constexpr int max_blocks_per_sequence = 2;
+
+  std::vector<float> input_data = {
+      0.8f, -0.5f, 0.0f, 1.f,
+      0.8f, -0.5f, 0.0f, 1.f,
+      0.5f, 0.2f, 0.3f, -0.6f,
+      0.5f, 0.2f, 0.3f, -0.6f};
+
+  std::vector<float> q_weight_data = {
+      0.1f, -0.2f, 0.3f, 1.0f,
+      0.5f, 0.1f, 0.4f, 1.6f,
+      0.3f, 0.2f, 4.0f, 2.2f,
+      0.2f, 0.1f, 0.4f, 1.6f};
+
+  std::vector<float> kv_weight_data = {
+      1.1f, 0.3f, 0.5f, 0.2f, 0.3f, -0.6f, 1.5f, 2.0f,
+      1.0f, 2.0f, 0.4f, 0.8f, 0.9f, 0.1f, -1.3f, 0.7f,
+      1.6f, 1.1f, 0.7f, 0.2f, 0.4f, 1.0f, 1.2f, 0.5f,
+      2.4f, 3.3f, 2.1f, 4.2f, 8.4f, 0.0f, 2.1f, 3.2f};
+
+  std::vector<float> bias_data = {
+      -0.5f, 0.6f, 1.2f, 2.1f, 0.5f, 0.7f, 0.2f, 1.2f, 0.5f, 0.4f, 0.3f, 1.2f};
+
+  std::vector<float> output_data = {
+      1.502f, 0.05172f, 4.25f, 5.6499996185302734f,
+      1.502f, 0.05172f, 4.25f, 5.6499996185302734f,
+      2.0621f, 0.037995f, 4.2499995231628418f, 5.6499991416931152f,
+      2.0621f, 0.037995f, 4.2499995231628418f, 5.6499991416931152f};
+
+  std::vector<float> cache(num_blocks * number_of_heads * block_size * head_size, 0.0f);
+
+  std::vector<float> new_key_cache = {
+      0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+      3.2800f, 3.2400f, 0.2900f, -0.4000f, 2.5000f, 5.1600f, -0.5200f, -1.0000f,
+      3.2800f, 3.2400f, 0.2900f, -0.4000f, 2.5000f, 5.1600f, -0.5200f, -1.0000f};
+
+  std::vector<float> new_value_cache = {
+      0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f,
+      8.6900f, -0.1300f, -4.0900f, 0.4200f, 4.2500f, 5.6500f, -0.1100f, 0.5700f,
+      8.6900f, -0.1300f, -4.0900f, 0.4200f, 4.2500f, 5.6500f, -0.1100f, 0.5700f};
+
+  OpTester tester("DecoderAttention", 1, onnxruntime::kMSDomain);
+  tester.AddAttribute<int64_t>("num_heads", static_cast<int64_t>(number_of_heads));
+
+  const std::vector<int64_t> query_dims = {sequence_length, batch_size, hidden_size};
+  const std::vector<int64_t> cache_dims = {num_blocks, number_of_heads, block_size, head_size};
+  tester.AddInput<float>("query", query_dims, input_data);
+  tester.AddInput<float>("key", query_dims, input_data);
+  tester.AddInput<float>("q_weight", {hidden_size, hidden_size}, q_weight_data);
+  tester.AddInput<float>("kv_weight", {hidden_size, 2 * hidden_size}, kv_weight_data);
+  tester.AddInput<float>("bias", {3 * hidden_size}, bias_data);
+  tester.AddOptionalInputEdge<bool>();
+  tester.AddInput<float>("key_cache", cache_dims, cache);
+  tester.AddInput<float>("value_cache", cache_dims, cache);
+  tester.AddInput<bool>("static_kv", {1}, {false});
+  tester.AddInput<bool>("use_past", {1}, {true});
+  tester.AddInput<bool>("has_layer_state", {1}, {true});
+  tester.AddInput<bool>("has_key_padding_mask", {1}, {false});
+  tester.AddInput<int32_t>("cache_block_table", {batch_size, max_blocks_per_sequence}, {0, 1, 0, 2});
+  tester.AddInput<int32_t>("cache_sequence_lengths", {batch_size}, {2, 2});
+
+  tester.AddOutput<float>("output", query_dims, output_data);
+  tester.AddOutput<float>("new_key_cache", cache_dims, new_key_cache);
+  tester.AddOutput<float>("new_value_cache", cache_dims, new_value_cache);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  tester.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
 
 }  // namespace test
 }  // namespace onnxruntime
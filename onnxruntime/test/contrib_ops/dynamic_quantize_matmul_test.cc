@@ -11,7 +11,9 @@
 #include "test/util/include/default_providers.h"
 #include "core/util/qmath.h"
 
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <random>
 
 #include "gtest/gtest.h"
@@ -142,6 +144,79 @@ TEST(DynamicQuantizeMatMul, UInt8_test_with_empty_input) {
                                      true /*is_matrix_b_constant*/);
 }
 
+template <typename T>
+void TestDynamicQuantizeMatMulPerRow(const std::vector<int64_t>& A_dims, const std::vector<int64_t>& B_dims,
+                                     bool is_matrix_b_constant, bool per_column) {
+  RandomValueGenerator random{};
+
+  std::vector<float> A_data = random.Uniform<float>(A_dims, -1.0f, 1.0f);
+  // Make the ranges of the rows very different, which is where per row scales help.
+  const int64_t K = A_dims.back();
+  for (size_t i = 0; i < A_data.size(); i++) {
+    A_data[i] *= static_cast<float>(i / K % 7 + 1) * 0.5f;
+  }
+
+  std::vector<T> B_data;
+  std::vector<int> tmp_B_data = random.Uniform<int32_t>(B_dims, std::numeric_limits<T>::min(),
+                                                        std::numeric_limits<T>::max());
+  std::transform(tmp_B_data.begin(), tmp_B_data.end(), std::back_inserter(B_data), [](int32_t v) -> T {
+    return static_cast<T>(v);
+  });
+
+  const int64_t N = B_dims.back();
+  const int64_t b_scale_zp_size = per_column ? N : 1;
+  std::vector<float> B_scale = random.Uniform<float>(AsSpan({b_scale_zp_size}), -0.1f, 0.1f);
+  std::vector<int> tmp_B_zp = random.Uniform<int32_t>(AsSpan({b_scale_zp_size}), std::numeric_limits<T>::min(),
+                                                      std::numeric_limits<T>::max());
+  std::vector<T> B_zero_point(tmp_B_zp.begin(), tmp_B_zp.end());
+  std::vector<float> Bias = random.Uniform<float>(AsSpan({N}), -0.1f, 0.1f);
+
+  // Reference: every row is quantized to uint8 around 128 with scale max(|row|) / 127.
+  const int64_t M = static_cast<int64_t>(A_data.size()) / K;
+  std::vector<int64_t> Y_dims(A_dims);
+  Y_dims.back() = N;
+  std::vector<float> Y_data(static_cast<size_t>(M * N));
+  for (int64_t m = 0; m < M; m++) {
+    const float* row = A_data.data() + m * K;
+    float max_abs = 0.0f;
+    for (int64_t k = 0; k < K; k++) {
+      max_abs = std::max(max_abs, std::fabs(row[k]));
+    }
+    const float a_scale = max_abs > 0.0f ? max_abs / 127.0f : 1.0f;
+    for (int64_t n = 0; n < N; n++) {
+      const int64_t p = per_column ? n : 0;
+      int32_t sum = 0;
+      for (int64_t k = 0; k < K; k++) {
+        int32_t a_q = static_cast<int32_t>(std::nearbyintf(row[k] / a_scale));
+        a_q = std::clamp(a_q, -128, 127);
+        sum += a_q * (static_cast<int32_t>(B_data[k * N + n]) - static_cast<int32_t>(B_zero_point[p]));
+      }
+      Y_data[m * N + n] = static_cast<float>(sum) * a_scale * B_scale[p] + Bias[n];
+    }
+  }
+
+  OpTester test("DynamicQuantizeMatMul", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("per_row_quantization", 1);
+  test.AddInput<float>("A", A_dims, A_data);
+  test.AddInput<T>("B", B_dims, B_data, is_matrix_b_constant);
+  test.AddInput<float>("b_scale", {b_scale_zp_size}, B_scale);
+  test.AddInput<T>("b_zero_point", {b_scale_zp_size}, B_zero_point);
+  test.AddInput<float>("bias", {N}, Bias);
+  test.AddOutput<float>("Y", Y_dims, Y_data);
+  test.SetOutputAbsErr("Y", 1e-3f);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
+TEST(DynamicQuantizeMatMul, PerRowQuantization) {
+  for (bool is_matrix_b_constant : {false, true}) {
+    for (bool per_column : {false, true}) {
+      TestDynamicQuantizeMatMulPerRow<uint8_t>({4, 64}, {64, 32}, is_matrix_b_constant, per_column);
+      TestDynamicQuantizeMatMulPerRow<int8_t>({4, 64}, {64, 32}, is_matrix_b_constant, per_column);
+      TestDynamicQuantizeMatMulPerRow<int8_t>({2, 3, 64}, {64, 16}, is_matrix_b_constant, per_column);
+    }
+  }
+}
+
 TEST(DynamicQuantizeMatMul, B_PerColumn_ND) {
   auto test_case = [&](const std::vector<int64_t>& input_shape,
                        const std::vector<int64_t>& weights_shape,
@@ -0,0 +1,89 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// 4 rows of 3 elements where row r is {r, 10 * r, -r}
+const std::vector<float> kTable{0.0f, 0.0f, -0.0f,
+                                1.0f, 10.0f, -1.0f,
+                                2.0f, 20.0f, -2.0f,
+                                3.0f, 30.0f, -3.0f};
+
+}  // namespace
+
+TEST(EmbeddingBagTest, Sum) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("table", {4, 3}, kTable);
+  test.AddInput<int64_t>("indices", {2, 3}, {1, 2, 3, 0, 3, -1});
+  test.AddOutput<float>("Y", {2, 3}, {6.0f, 60.0f, -6.0f, 6.0f, 60.0f, -6.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, MeanKeepDims) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddAttribute<int64_t>("keepdims", 1);
+  test.AddInput<float>("table", {4, 3}, kTable);
+  test.AddInput<int32_t>("indices", {2, 2}, {1, 3, 2, 2});
+  test.AddOutput<float>("Y", {2, 1, 3}, {2.0f, 20.0f, -2.0f, 2.0f, 20.0f, -2.0f});
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, Float16Table) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<MLFloat16>("table", {4, 3}, ToFloat16(kTable));
+  test.AddInput<int64_t>("indices", {3}, {0, 1, 3});
+  test.AddOutput<MLFloat16>("Y", {3}, ToFloat16({4.0f, 40.0f, -4.0f}));
+  test.Run();
+}
+
+TEST(EmbeddingBagTest, QuantizedTable) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("mode", "mean");
+  test.AddInput<uint8_t>("table", {3, 2}, {10, 20, 130, 126, 0, 255});
+  test.AddInput<int64_t>("indices", {2, 2}, {0, 1, 2, 2});
+  test.AddInput<float>("scale", {3}, {0.5f, 0.25f, 2.0f});
+  test.AddInput<uint8_t>("zero_point", {3}, {10, 128, 0});
+  // the dequantized rows are {0, 5}, {0.5, -0.5} and {0, 510}
+  test.AddOutput<float>("Y", {2, 2}, {0.25f, 2.25f, 0.0f, 510.0f});
+  test.Run();
+}
+
+// an empty bag sums to zero, and the longer bags cross the prefetch distance of the kernel
+TEST(EmbeddingBagTest, BagSizes) {
+  for (int64_t bag_size : {0, 1, 7, 8, 9, 40}) {
+    OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+    const int64_t num_bags = 5;
+    std::vector<int64_t> indices(num_bags * bag_size);
+    std::vector<float> expected(num_bags * 3, 0.0f);
+    for (int64_t i = 0; i < num_bags * bag_size; ++i) {
+      indices[i] = (i * 7 + i / 3) % 4;
+      for (int64_t d = 0; d < 3; ++d) {
+        expected[(i / bag_size) * 3 + d] += kTable[indices[i] * 3 + d];
+      }
+    }
+
+    test.AddInput<float>("table", {4, 3}, kTable);
+    test.AddInput<int64_t>("indices", {num_bags, bag_size}, indices);
+    test.AddOutput<float>("Y", {num_bags, 3}, expected);
+    test.Run();
+  }
+}
+
+TEST(EmbeddingBagTest, IndexOutOfRange) {
+  OpTester test("EmbeddingBag", 1, onnxruntime::kMSDomain);
+  test.AddInput<float>("table", {4, 3}, kTable);
+  test.AddInput<int64_t>("indices", {1, 2}, {1, 4});
+  test.AddOutput<float>("Y", {1, 3}, {0.0f, 0.0f, 0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "indices element out of data bounds");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -0,0 +1,146 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "gtest/gtest.h"
+#include "test/common/cuda_op_test_utils.h"
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+#if defined(USE_CUDA)
+
+#include <cuda.h>
+
+#if defined(CUDA_VERSION) && CUDA_VERSION >= 11080
+
+namespace onnxruntime {
+namespace test {
+
+// The float8 ops are only implemented by the CUDA execution provider.
+static void RunOnCuda(OpTester& test) {
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.push_back(DefaultCudaExecutionProvider());
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+}
+
+TEST(Float8OpTest, QuantizeFloat8_E4M3FN) {
+  OpTester test("QuantizeFloat8", 1, onnxruntime::kMSDomain);
+  std::vector<int64_t> dims{8};
+  test.AddInput<float>("x", dims, {0.f, 2.f, -4.f, 1.f,
+                                   896.f,             // largest finite value
+                                   2000.f,            // saturate case
+                                   2.125f, 2.375f});  // rounding half to even
+  test.AddInput<float>("y_scale", {}, {2.0f});
+  test.AddOutput<uint8_t>("y", dims, {0x00, 0x38, 0xC0, 0x30, 0x7E, 0x7E, 0x38, 0x3A});
+  RunOnCuda(test);
+}
+
+TEST(Float8OpTest, QuantizeFloat8_E4M3FN_NoSaturate) {
+  OpTester test("QuantizeFloat8", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("saturate", 0);
+  std::vector<int64_t> dims{3};
+  test.AddInput<float>("x", dims, {1.f, 448.f, 1000.f});
+  test.AddInput<float>("y_scale", {}, {1.0f});
+  test.AddOutput<uint8_t>("y", dims, {0x38, 0x7E, 0x7F});  // E4M3FN has no infinity, overflows become NaN
+  RunOnCuda(test);
+}
+
+TEST(Float8OpTest, QuantizeFloat8_E5M2) {
+  OpTester test("QuantizeFloat8", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("fp8_format", "E5M2");
+  std::vector<int64_t> dims{8};
+  test.AddInput<float>("x", dims, {1.f, -2.f, 0.5f,
+                                   57344.f,         // largest finite value
+                                   100000.f,        // saturate case
+                                   1.125f, 1.375f,  // rounding half to even
+                                   0.f});
+  test.AddInput<float>("y_scale", {}, {1.0f});
+  test.AddOutput<uint8_t>("y", dims, {0x3C, 0xC0, 0x38, 0x7B, 0x7B, 0x3C, 0x3E, 0x00});
+  RunOnCuda(test);
+}
+
+TEST(Float8OpTest, QuantizeFloat8_half) {
+  OpTester test("QuantizeFloat8", 1, onnxruntime::kMSDomain);
+  std::vector<int64_t> dims{4};
+  test.AddInput<MLFloat16>("x", dims, ToFloat16({0.f, 2.f, -4.f, 1.f}));
+  test.AddInput<MLFloat16>("y_scale", {}, ToFloat16({2.0f}));
+  test.AddOutput<uint8_t>("y", dims, {0x00, 0x38, 0xC0, 0x30});
+  RunOnCuda(test);
+}
+
+TEST(Float8OpTest, DequantizeFloat8_E4M3FN) {
+  OpTester test("DequantizeFloat8", 1, onnxruntime::kMSDomain);
+  std::vector<int64_t> dims{6};
+  test.AddInput<uint8_t>("x", dims, {0x00, 0x38, 0xC0, 0x30, 0x7E,
+                                     0x01});  // smallest subnormal value
+  test.AddInput<float>("x_scale", {}, {2.0f});
+  test.AddOutput<float>("y", dims, {0.f, 2.f, -4.f, 1.f, 896.f, 0.00390625f});
+  RunOnCuda(test);
+}
+
+TEST(Float8OpTest, DequantizeFloat8_E5M2_half) {
+  OpTester test("DequantizeFloat8", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::string>("fp8_format", "E5M2");
+  std::vector<int64_t> dims{4};
+  test.AddInput<uint8_t>("x", dims, {0x3C, 0xC0, 0x38, 0x7B});
+  test.AddInput<MLFloat16>("x_scale", {}, ToFloat16({0.5f}));
+  test.AddOutput<MLFloat16>("y", dims, ToFloat16({0.5f, -1.f, 0.25f, 28672.f}));
+  RunOnCuda(test);
+}
+
+template <typename T>
+static void RunMatMulFloat8Test(int64_t dtype) {
+  // Needs Ada or higher architecture
+  if (NeedSkipIfCudaArchLowerThan(890)) {
+    return;
+  }
+
+  constexpr int64_t M = 2;
+  constexpr int64_t K = 16;
+  constexpr int64_t N = 16;
+
+  // the rows of A are 1.0 and 2.0, the rows of B are 0.5 and -1.0 in turn
+  std::vector<uint8_t> a(M * K);
+  for (int64_t m = 0; m < M; ++m) {
+    std::fill_n(a.begin() + m * K, K, m == 0 ? 0x38 : 0x40);
+  }
+  std::vector<uint8_t> b(N * K);
+  for (int64_t n = 0; n < N; ++n) {
+    std::fill_n(b.begin() + n * K, K, n % 2 == 0 ? 0x30 : 0xB8);
+  }
+
+  // Y[m][n] = K * (A[m] * a_scale) * (B[n] * b_scale)
+  std::vector<float> y(M * N);
+  for (int64_t m = 0; m < M; ++m) {
+    for (int64_t n = 0; n < N; ++n) {
+      y[m * N + n] = K * (m == 0 ? 2.f : 4.f) * (n % 2 == 0 ? 0.25f : -0.5f);
+    }
+  }
+
+  OpTester test("MatMulFloat8", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<int64_t>("dtype", dtype);
+  test.AddInput<uint8_t>("A", {1, M, K}, a);
+  test.AddInput<uint8_t>("B", {N, K}, b, true);
+  test.AddInput<float>("a_scale", {}, {2.0f});
+  test.AddInput<float>("b_scale", {}, {0.5f});
+  if constexpr (std::is_same<T, MLFloat16>::value) {
+    test.AddOutput<MLFloat16>("Y", {1, M, N}, ToFloat16(y));
+  } else {
+    test.AddOutput<float>("Y", {1, M, N}, y);
+  }
+  RunOnCuda(test);
+}
+
+TEST(Float8OpTest, MatMulFloat8_float) {
+  RunMatMulFloat8Test<float>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+}
+
+TEST(Float8OpTest, MatMulFloat8_half) {
+  RunMatMulFloat8Test<MLFloat16>(ONNX_NAMESPACE::TensorProto_DataType_FLOAT16);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
+
+#endif  // CUDA_VERSION >= 11080
+
+#endif  // USE_CUDA
@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <cmath>
+
+#include "gtest/gtest.h"
+#include "test/providers/provider_test_utils.h"
+
+namespace onnxruntime {
+namespace test {
+
+TEST(FusedElementwiseTest, BroadcastInputs) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  // Y = Relu(X + B) * S
+  test.AddAttribute<std::vector<std::string>>("ops", {"Add", "Relu", "Mul"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, 1, 3, -1, 4, 2});
+  test.AddInput<float>("X", {2, 3}, {-1.0f, 2.0f, -3.0f, 4.0f, -5.0f, 6.0f});
+  test.AddInput<float>("B", {3}, {0.5f, -1.0f, 1.0f});
+  test.AddInput<float>("S", {}, {2.0f});
+  test.AddOutput<float>("Y", {2, 3}, {0.0f, 2.0f, 0.0f, 9.0f, 0.0f, 14.0f});
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, nullptr);
+}
+
+TEST(FusedElementwiseTest, LongChainAcrossBlocks) {
+  // more elements than one block of the kernel so the chain is evaluated in several blocks
+  constexpr int64_t rows = 3;
+  constexpr int64_t cols = 1000;
+  std::vector<float> x(rows * cols);
+  std::vector<float> d(cols);
+  std::vector<float> y(rows * cols);
+  for (int64_t c = 0; c < cols; ++c) {
+    d[c] = 1.0f + static_cast<float>(c % 7);
+  }
+  for (int64_t i = 0; i < rows * cols; ++i) {
+    x[i] = static_cast<float>(i % 13) - 6.0f;
+    // Y = (D - Sigmoid(Sqrt(Abs(X)))) / D
+    const float sigmoid = 1.0f / (1.0f + std::exp(-std::sqrt(std::abs(x[i]))));
+    y[i] = (d[i % cols] - sigmoid) / d[i % cols];
+  }
+
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Abs", "Sqrt", "Sigmoid", "Sub", "Div"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, -1, 2, -1, 3, -1, 1, 4, 5, 1});
+  test.AddInput<float>("X", {rows, cols}, x);
+  test.AddInput<float>("D", {cols}, d);
+  test.AddOutput<float>("Y", {rows, cols}, y);
+  test.SetOutputAbsErr("Y", 1e-5f);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, nullptr);
+}
+
+TEST(FusedElementwiseTest, InvalidOperand) {
+  OpTester test("FusedElementwise", 1, onnxruntime::kMSDomain);
+  test.AddAttribute<std::vector<std::string>>("ops", {"Add"});
+  test.AddAttribute<std::vector<int64_t>>("operands", {0, 2});
+  test.AddInput<float>("X", {2}, {1.0f, 2.0f});
+  test.AddInput<float>("B", {2}, {1.0f, 2.0f});
+  test.AddOutput<float>("Y", {2}, {2.0f, 4.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "Invalid operand 2 of step 0");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -292,6 +292,50 @@ TEST(FusedMatMulOpTest, FloatTypeTransposeBatch) {
   RunFusedMatMulTest<float>("FusedMatMul", 1, true, true, true, true);
 }
 
+// The CPU kernel applies the activation to the output tiles as MLAS computes them.
+TEST(FusedMatMulOpTest, FloatTypeGeluActivation) {
+  const std::vector<int64_t> a_dims{2, 3, 4};
+  const std::vector<int64_t> b_dims{4, 5};
+  std::vector<float> a_vals(24);
+  std::vector<float> b_vals(20);
+  for (size_t i = 0; i < a_vals.size(); i++) {
+    a_vals[i] = 0.25f * static_cast<float>(static_cast<int>(i % 7) - 3);
+  }
+  for (size_t i = 0; i < b_vals.size(); i++) {
+    b_vals[i] = 0.5f * static_cast<float>(static_cast<int>(i % 5) - 2);
+  }
+
+  for (const char* activation : {"Gelu", "FastGelu"}) {
+    const bool is_fast = std::string(activation) == "FastGelu";
+    std::vector<float> expected_vals(30);
+    for (size_t m = 0; m < 6; m++) {
+      for (size_t n = 0; n < 5; n++) {
+        double x = 0.0;
+        for (size_t k = 0; k < 4; k++) {
+          x += a_vals[m * 4 + k] * b_vals[k * 5 + n];
+        }
+        x *= 0.5;
+        const double y = is_fast ? std::tanh(0.7978845608028654 * (x + 0.044715 * x * x * x))
+                                 : std::erf(x * 0.70710678118654752440);
+        expected_vals[m * 5 + n] = static_cast<float>(0.5 * x * (1.0 + y));
+      }
+    }
+
+    for (bool is_b_constant : {false, true}) {
+      OpTester test("FusedMatMul", 1, onnxruntime::kMSDomain);
+      test.AddInput<float>("A", a_dims, a_vals);
+      test.AddInput<float>("B", b_dims, b_vals, is_b_constant);
+      test.AddAttribute("alpha", 0.5f);
+      test.AddAttribute("activation", std::string(activation));
+      test.AddOutput<float>("Y", {2, 3, 5}, expected_vals);
+
+      std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+      execution_providers.push_back(DefaultCpuExecutionProvider());
+      test.Run(OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+    }
+  }
+}
+
 #if defined(USE_CUDA) || defined(USE_ROCM)
 TEST(FusedMatMulOpTest, Float16_NoTranspose) {
 #ifdef USE_CUDA
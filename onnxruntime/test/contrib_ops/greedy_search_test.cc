@@ -2,11 +2,14 @@
 // Licensed under the MIT License.
 
 #include <memory>
+#include <string>
 #include <vector>
 #include "gtest/gtest.h"
 #include "core/common/gsl.h"
+#include "core/graph/model.h"
 #include "core/session/onnxruntime_cxx_api.h"
 #include "test/common/cuda_op_test_utils.h"
+#include "test/util/include/asserts.h"
 
 extern std::unique_ptr<Ort::Env> ort_env;
 
@@ -143,5 +146,74 @@ TEST(GreedySearchTest, GptGreedySearchFp32) {
   }
 }
 
+// The decoder subgraph is used as its own draft model, so the draft tokens are accepted in a single decoder run.
+// Sequences shall be the same as generating one token per decoder run.
+TEST(GreedySearchTest, GptGreedySearchFp32WithDraftDecoder) {
+  const ORTCHAR_T* model_path = ORT_TSTR("testdata/transformers/tiny_gpt2_greedysearch_with_init_decoder.onnx");
+  ONNX_NAMESPACE::ModelProto model_proto;
+  ASSERT_STATUS_OK(Model::Load(model_path, model_proto));
+
+  ONNX_NAMESPACE::NodeProto* greedy_search_node = nullptr;
+  for (auto& node : *model_proto.mutable_graph()->mutable_node()) {
+    if (node.op_type() == "GreedySearch") {
+      greedy_search_node = &node;
+    }
+  }
+  ASSERT_NE(greedy_search_node, nullptr);
+
+  for (const auto& attribute : greedy_search_node->attribute()) {
+    if (attribute.name() == "decoder") {
+      ONNX_NAMESPACE::AttributeProto draft_decoder = attribute;
+      draft_decoder.set_name("draft_decoder");
+      *greedy_search_node->add_attribute() = std::move(draft_decoder);
+      break;
+    }
+  }
+  auto* num_draft_tokens = greedy_search_node->add_attribute();
+  num_draft_tokens->set_name("num_draft_tokens");
+  num_draft_tokens->set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+  num_draft_tokens->set_i(3);
+
+  std::string model_with_draft;
+  ASSERT_TRUE(model_proto.SerializeToString(&model_with_draft));
+
+  std::vector<int64_t> input_ids_shape{2, 4};
+  std::vector<int32_t> input_ids{
+      0, 0, 0, 52, 0, 0, 195, 731};
+
+  std::vector<int64_t> parameter_shape{1};
+  std::vector<int32_t> max_length{12};
+  std::vector<int32_t> min_length{1};
+  std::vector<float> repetition_penalty{1.0f};
+
+  Ort::MemoryInfo info("Cpu", OrtDeviceAllocator, 0, OrtMemTypeDefault);
+  std::vector<Ort::Value> ort_inputs;
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, input_ids.data(), input_ids.size(), input_ids_shape.data(), input_ids_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, max_length.data(), max_length.size(), parameter_shape.data(), parameter_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, min_length.data(), min_length.size(), parameter_shape.data(), parameter_shape.size()));
+  ort_inputs.push_back(Ort::Value::CreateTensor(
+      info, repetition_penalty.data(), repetition_penalty.size(), parameter_shape.data(), parameter_shape.size()));
+  const char* input_names[] = {"input_ids", "max_length", "min_length", "repetition_penalty"};
+  const char* const output_names[] = {"sequences"};
+
+  auto run = [&](Ort::Session& session) {
+    auto ort_outputs = session.Run(Ort::RunOptions{}, input_names, ort_inputs.data(), ort_inputs.size(),
+                                   output_names, 1);
+    EXPECT_EQ(ort_outputs.size(), 1U);
+    const auto& sequences = ort_outputs[0];
+    EXPECT_EQ(sequences.GetTensorTypeAndShapeInfo().GetShape(),
+              (std::vector<int64_t>{input_ids_shape[0], max_length[0]}));
+    const auto* result_vals = sequences.GetTensorData<int32_t>();
+    return std::vector<int32_t>(result_vals, result_vals + input_ids_shape[0] * max_length[0]);
+  };
+
+  Ort::Session session(*ort_env, model_path, Ort::SessionOptions{});
+  Ort::Session session_with_draft(*ort_env, model_with_draft.data(), model_with_draft.size(), Ort::SessionOptions{});
+  EXPECT_EQ(run(session), run(session_with_draft));
+}
+
 }  // namespace test
 }  // namespace onnxruntime
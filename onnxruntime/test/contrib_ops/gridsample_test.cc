@@ -128,6 +128,32 @@ TEST(GridsampleContribOpTest, gridsample_mode_bicubic) {
   test.Run();
 }
 
+TEST(GridsampleContribOpTest, gridsample_constant_grid) {
+  // the grid is an initializer, so the kernel reuses the sampling plan it built for it
+  OpTester test("GridSample", 1, kMSDomain);
+  const std::vector<float> image = {0.0f, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f};
+  const std::vector<float> grid = {-1.0000f, -1.0000f, -0.5000f, -0.5000f,
+                                   -0.2000f, -0.2000f, 0.0000f, 0.0000f,
+                                   0.0000f, 0.0000f, -0.2000f, -0.2000f,
+                                   0.5000f, 0.5000f, 1.0000f, 1.0000f};
+  const std::vector<float> expected = {-0.1406f, 0.3828f, 1.7556f, 2.9688f, 2.9688f, 1.7556f, 5.1445f, 1.3906f};
+
+  std::vector<float> X_data, grid_data, Y_data;
+  for (int n = 0; n < 2; n++) {
+    grid_data.insert(grid_data.end(), grid.begin(), grid.end());
+    for (int c = 0; c < 3; c++) {
+      X_data.insert(X_data.end(), image.begin(), image.end());
+      Y_data.insert(Y_data.end(), expected.begin(), expected.end());
+    }
+  }
+
+  test.AddInput<float>("X", {2, 3, 3, 2}, X_data);
+  test.AddInput<float>("Grid", {2, 2, 4, 2}, grid_data, true);
+  test.AddAttribute("mode", "bicubic");
+  test.AddOutput<float>("Y", {2, 3, 2, 4}, Y_data);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
 
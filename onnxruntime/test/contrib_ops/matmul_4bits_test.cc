@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test/common/tensor_op_test_utils.h"
+#include "test/providers/provider_test_utils.h"
+
+#include "gtest/gtest.h"
+
+namespace onnxruntime {
+namespace test {
+
+void RunMatMulNBitsTest(const std::vector<int64_t>& A_dims, int64_t N, int64_t block_size,
+                        bool has_zero_point, bool are_weights_constant) {
+  RandomValueGenerator random{1234};
+
+  const int64_t K = A_dims.back();
+  const int64_t M = TensorShape(A_dims).SizeToDimension(A_dims.size() - 1);
+  const int64_t block_count_k = (K + block_size - 1) / block_size;
+  const int64_t blob_size = block_size / 2;
+
+  std::vector<float> A_data = random.Uniform<float>(A_dims, -1.0f, 1.0f);
+
+  std::vector<int32_t> tmp_B_data = random.Uniform<int32_t>(AsSpan({N * block_count_k * blob_size}), 0, 256);
+  std::vector<uint8_t> B_data(tmp_B_data.begin(), tmp_B_data.end());
+
+  std::vector<float> scales = random.Uniform<float>(AsSpan({N * block_count_k}), 0.01f, 0.1f);
+
+  const int64_t zero_point_stride = (block_count_k + 1) / 2;
+  std::vector<int32_t> tmp_zero_points = random.Uniform<int32_t>(AsSpan({N * zero_point_stride}), 0, 256);
+  std::vector<uint8_t> zero_points(tmp_zero_points.begin(), tmp_zero_points.end());
+
+  // Dequantize matrix B to compute the expected output.
+  std::vector<float> B_dequant(static_cast<size_t>(K * N));
+  for (int64_t n = 0; n < N; n++) {
+    for (int64_t k = 0; k < K; k++) {
+      const int64_t blk = k / block_size;
+      const int64_t idx = k % block_size;
+      const uint8_t byte = B_data[static_cast<size_t>((n * block_count_k + blk) * blob_size + idx / 2)];
+      const int quant = (idx & 1) ? (byte >> 4) : (byte & 0x0F);
+      int zero_point = 8;
+      if (has_zero_point) {
+        const uint8_t pair = zero_points[static_cast<size_t>(n * zero_point_stride + blk / 2)];
+        zero_point = (blk & 1) ? (pair >> 4) : (pair & 0x0F);
+      }
+      B_dequant[static_cast<size_t>(k * N + n)] =
+          static_cast<float>(quant - zero_point) * scales[static_cast<size_t>(n * block_count_k + blk)];
+    }
+  }
+
+  std::vector<float> expected(static_cast<size_t>(M * N));
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      float sum = 0.0f;
+      for (int64_t k = 0; k < K; k++) {
+        sum += A_data[static_cast<size_t>(m * K + k)] * B_dequant[static_cast<size_t>(k * N + n)];
+      }
+      expected[static_cast<size_t>(m * N + n)] = sum;
+    }
+  }
+
+  std::vector<int64_t> Y_dims(A_dims);
+  Y_dims.back() = N;
+
+  OpTester test("MatMulNBits", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", K);
+  test.AddAttribute<int64_t>("N", N);
+  test.AddAttribute<int64_t>("block_size", block_size);
+  test.AddAttribute<int64_t>("bits", 4);
+  test.AddInput<float>("A", A_dims, A_data);
+  test.AddInput<uint8_t>("B", {N, block_count_k, blob_size}, B_data, are_weights_constant);
+  test.AddInput<float>("scales", {N * block_count_k}, scales, are_weights_constant);
+  if (has_zero_point) {
+    test.AddInput<uint8_t>("zero_points", {N * zero_point_stride}, zero_points, are_weights_constant);
+  } else {
+    test.AddOptionalInputEdge<uint8_t>();
+  }
+  test.AddOutput<float>("Y", Y_dims, expected);
+  test.SetOutputAbsErr("Y", 1e-3f);
+  test.Run();
+}
+
+TEST(MatMulNBits, Float32) {
+  for (int64_t block_size : {32, 64, 128, 256}) {
+    for (bool has_zero_point : {false, true}) {
+      for (bool are_weights_constant : {false, true}) {
+        RunMatMulNBitsTest({1, 1, 64}, 1, block_size, has_zero_point, are_weights_constant);
+        RunMatMulNBitsTest({2, 3, 100}, 17, block_size, has_zero_point, are_weights_constant);
+        RunMatMulNBitsTest({16, 257}, 40, block_size, has_zero_point, are_weights_constant);
+      }
+    }
+  }
+}
+
+TEST(MatMulNBits, InvalidBlockSize) {
+  OpTester test("MatMulNBits", 1, kMSDomain);
+  test.AddAttribute<int64_t>("K", 16);
+  test.AddAttribute<int64_t>("N", 1);
+  test.AddAttribute<int64_t>("block_size", 16);
+  test.AddAttribute<int64_t>("bits", 4);
+  test.AddInput<float>("A", {1, 16}, std::vector<float>(16, 1.0f));
+  test.AddInput<uint8_t>("B", {1, 1, 8}, std::vector<uint8_t>(8, 0x88), true);
+  test.AddInput<float>("scales", {1}, {1.0f}, true);
+  test.AddOutput<float>("Y", {1, 1}, {0.0f});
+  test.Run(OpTester::ExpectResult::kExpectFailure, "block_size must be a power of 2");
+}
+
+}  // namespace test
+}  // namespace onnxruntime
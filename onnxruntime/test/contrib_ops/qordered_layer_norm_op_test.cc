@@ -13,7 +13,8 @@ template <typename T>  // MLFloat16 or float
 static void RunQOrdered_LayerNorm_RowMajor(std::vector<int64_t> const& shape, int axis, float epsilon,
                                            const std::vector<int8_t>& vec_x, float scale_x,
                                            const std::vector<T>& gamma, const std::vector<T>* beta,
-                                           float scale_y, const std::vector<int8_t>& vec_y) {
+                                           float scale_y, const std::vector<int8_t>& vec_y,
+                                           const std::vector<int8_t>* vec_r = nullptr, float scale_r = 1.0f) {
   std::vector<int64_t> bias_shape = {shape.back()};
   OpTester test_qorder("QOrderedLayerNormalization", 1, onnxruntime::kMSDomain);
   test_qorder.AddAttribute("axis", (int64_t)axis);
@@ -27,7 +28,12 @@ static void RunQOrdered_LayerNorm_RowMajor(std::vector<int64_t> const& shape, in
     test_qorder.AddOptionalInputEdge<T>();
   }
   test_qorder.AddInput<float>("scale_Y", {}, {scale_y});
-  test_qorder.AddOutput<int8_t>("Y", shape, vec_y, false, 0.0f, 0.0f /* abs error */);
+  if (vec_r) {
+    test_qorder.AddInput<int8_t>("R", shape, *vec_r);
+    test_qorder.AddInput<float>("scale_R", {}, {scale_r});
+  }
+  // The residual path accumulates in float, so allow the last bit of the quantized output to differ.
+  test_qorder.AddOutput<int8_t>("Y", shape, vec_y, false, 0.0f, vec_r ? 1.0f : 0.0f /* abs error */);
 
   std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
   execution_providers.push_back(DefaultCudaExecutionProvider());
@@ -104,6 +110,13 @@ TEST(QOrderedTest, LayerNormalization_RowMajor) {
 
   RunQOrdered_LayerNorm_RowMajor({batch, sequence, hidden}, -1, 0.00001f, vec_x, scale_x,
                                  gamma_fp32, &beta_fp32, scale_y, vec_y);
+
+  // X * 0.5 + R * 0.5 with R == X normalizes the same values as above.
+  RunQOrdered_LayerNorm_RowMajor({batch, sequence, hidden}, -1, 0.00001f, vec_x, scale_x * 0.5f,
+                                 gamma_fp16, &beta_fp16, scale_y, vec_y, &vec_x, scale_x * 0.5f);
+
+  RunQOrdered_LayerNorm_RowMajor({batch, sequence, hidden}, -1, 0.00001f, vec_x, scale_x * 0.5f,
+                                 gamma_fp32, &beta_fp32, scale_y, vec_y, &vec_x, scale_x * 0.5f);
 }
 
 #endif
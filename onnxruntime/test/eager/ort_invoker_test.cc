@@ -80,6 +80,39 @@ TEST(InvokerTest, Inplace) {
   }
 }
 
+TEST(InvokerTest, ReuseKernel) {
+  std::unique_ptr<IExecutionProvider> cpu_execution_provider = std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false));
+  const std::string logger_id{"InvokerTest"};
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<logging::ISink>{new logging::CLogSink{}},
+      logging::Severity::kVERBOSE, false,
+      logging::LoggingManager::InstanceType::Default,
+      &logger_id);
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+  IOnnxRuntimeOpSchemaRegistryList tmp_op_registry = {};
+  ORTInvoker kernel_invoker(std::move(cpu_execution_provider), env->GetLoggingManager()->DefaultLogger(), tmp_op_registry);
+
+  // The second call hits the cached kernel, so it must compute with its own inputs and shapes.
+  auto allocator = kernel_invoker.GetCurrentExecutionProvider().GetAllocator(0, OrtMemTypeDefault);
+  OrtValue A, B;
+  CreateMLValue<float>(allocator, {3, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &A);
+  CreateMLValue<float>(allocator, {3, 2}, {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f}, &B);
+  std::vector<OrtValue> result(1);
+  ASSERT_STATUS_OK(kernel_invoker.Invoke("Add", {A, B}, result, nullptr));
+
+  std::vector<int64_t> dims_x = {2};
+  OrtValue X, Y;
+  CreateMLValue<float>(allocator, dims_x, {10.0f, 20.0f}, &X);
+  CreateMLValue<float>(allocator, dims_x, {1.0f, 2.0f}, &Y);
+  std::vector<OrtValue> second_result(1);
+  ASSERT_STATUS_OK(kernel_invoker.Invoke("Add", {X, Y}, second_result, nullptr));
+  const Tensor& Z = second_result.back().Get<Tensor>();
+  EXPECT_TRUE(SpanEq(Z.Shape().GetDims(), gsl::make_span(dims_x)));
+  EXPECT_EQ(Z.Data<float>()[0], 11.0f);
+  EXPECT_EQ(Z.Data<float>()[1], 22.0f);
+}
+
 class TestKernel final : public OpKernel {
  public:
   TestKernel(const OpKernelInfo& info) : OpKernel(info) {}
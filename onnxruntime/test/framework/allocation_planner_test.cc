@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -103,15 +104,21 @@ typedef std::unordered_map<const onnxruntime::NodeArg*, TensorShapeProto*> Shape
 
 class SequentialPlannerTestContext : public ISequentialPlannerContext {
  public:
-  SequentialPlannerTestContext(ShapeMap* shape_map) : shape_map_(shape_map) {}
+  SequentialPlannerTestContext(ShapeMap* shape_map, int max_cpu_streams = 1, int max_gpu_streams = 1)
+      : shape_map_(shape_map), max_cpu_streams_(max_cpu_streams), max_gpu_streams_(max_gpu_streams) {}
 
   TensorShapeProto* GetShape(const onnxruntime::NodeArg& arg) const override {
     auto iter = shape_map_->find(&arg);
     return (shape_map_->end() != iter) ? iter->second : nullptr;
   }
 
+  int GetMaxCpuStreams() const override { return max_cpu_streams_; }
+  int GetMaxGpuStreams() const override { return max_gpu_streams_; }
+
  private:
   ShapeMap* shape_map_;
+  int max_cpu_streams_;
+  int max_gpu_streams_;
 };
 
 class ParallelPlannerTestContext : public SequentialPlannerTestContext {
@@ -138,6 +145,7 @@ class PlannerTest : public ::testing::Test {
   std::unique_ptr<::onnxruntime::KernelDef> std_kernel_;               // a unary kernel with no-aliasing and no-in-place
   std::unique_ptr<::onnxruntime::KernelDef> in_place_kernel_;          // a unary kernel with in-place
   std::unique_ptr<::onnxruntime::KernelDef> external_outputs_kernel_;  // an unary kernel with external outputs
+  std::unique_ptr<::onnxruntime::KernelDef> concat_kernel_;
 #ifdef ENABLE_STRIDED_TENSORS
   std::unique_ptr<::onnxruntime::KernelDef> may_strided_input_kernel_;   // an uinary kernel with may_strided_input
   std::unique_ptr<::onnxruntime::KernelDef> may_strided_output_kernel_;  // an unary kernel with may_strided_output
@@ -166,6 +174,7 @@ class PlannerTest : public ::testing::Test {
         KernelDefBuilder().SetName("Relu").Provider(kCpuExecutionProvider).SinceVersion(1, 10).MayInplace(0, 0).Build();
     external_outputs_kernel_ =
         KernelDefBuilder().SetName("Tanh").Provider(kCpuExecutionProvider).SinceVersion(1, 10).ExternalOutputs().Build();
+    concat_kernel_ = KernelDefBuilder().SetName("Concat").Provider(kCpuExecutionProvider).SinceVersion(4, 10).Build();
 #ifdef ENABLE_STRIDED_TENSORS
     may_strided_input_kernel_ = KernelDefBuilder()
                                     .SetName("Abs")
@@ -212,6 +221,15 @@ class PlannerTest : public ::testing::Test {
     return AddNode(*external_outputs_kernel_, input, output);
   }
 
+  onnxruntime::Node* AddConcatNode(std::string& input1, std::string& input2, std::string& output, int64_t axis) {
+    auto* p_node = &graph_.AddNode("node" + std::to_string(NodeCounter::Next()), "Concat", "test op",
+                                   {Arg(input1), Arg(input2)}, {Arg(output)});
+    p_node->AddAttribute("axis", axis);
+    p_node->SetExecutionProviderType(kCpuExecutionProvider);
+    kernel_bindings_.emplace_back(p_node, *concat_kernel_);
+    return p_node;
+  }
+
 #ifdef ENABLE_STRIDED_TENSORS
   onnxruntime::Node* AddMayStridedInputNode(std::string& input, std::string& output) {
     return AddNode(*may_strided_input_kernel_, input, output);
@@ -228,7 +246,7 @@ class PlannerTest : public ::testing::Test {
     ASSERT_NE(ep, nullptr);
     auto info = std::make_unique<OpKernelInfo>(
         *p_node, kernel_def, *ep, state_->GetInitializedTensors(), state_->GetOrtValueNameIdxMap(),
-        state_->GetDataTransferMgr());
+        state_->GetDataTransferMgr(), state_->GetConfigOptions());
 
     op_kernel_infos_.push_back(std::move(info));
     const auto kernel_type_str_resolver = OpSchemaKernelTypeStrResolver{};
@@ -255,7 +273,8 @@ class PlannerTest : public ::testing::Test {
     }
   }
 
-  void CreatePlan(const std::vector<const NodeArg*>& outer_scope_node_args = {}) {
+  void CreatePlan(const std::vector<const NodeArg*>& outer_scope_node_args = {}, int max_cpu_streams = 1,
+                  int max_gpu_streams = 1) {
     state_.reset(new SessionState(graph_, execution_providers_, false, tp_.get(), nullptr, dtm_,
                                   DefaultLoggingManager().DefaultLogger(), profiler_));
     EXPECT_EQ(graph_.Resolve(), Status::OK());
@@ -279,7 +298,7 @@ class PlannerTest : public ::testing::Test {
     status = state_->FinalizeSessionState(ORT_TSTR(""), kernel_registry_manager, {}, remove_initializers);
 
     EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
-    SequentialPlannerTestContext test_context(&shape_map_);
+    SequentialPlannerTestContext test_context(&shape_map_, max_cpu_streams, max_gpu_streams);
     plan_.emplace();
 
     class MockStreamHandleRegsitry : public IStreamCommandHandleRegistry {
@@ -315,6 +334,17 @@ class PlannerTest : public ::testing::Test {
     EXPECT_EQ(plan_->allocation_plan[id].alloc_kind, kind) << "Error in allocation kind for " << name;
   }
 
+  void CheckSubView(const std::string& name, const std::string& owner, size_t offset) {
+    int id, owner_id;
+    index(name, id);
+    index(owner, owner_id);
+    const auto& alloc_plan = plan_->allocation_plan[id];
+    EXPECT_EQ(alloc_plan.alloc_kind, AllocKind::kReuse) << "Error in allocation kind for " << name;
+    EXPECT_TRUE(alloc_plan.is_sub_view) << name << " is not a sub-view";
+    EXPECT_EQ(alloc_plan.reused_buffer, owner_id) << "Error in owner of " << name;
+    EXPECT_EQ(alloc_plan.sub_view_offset, offset) << "Error in offset of " << name;
+  }
+
   void CheckFreed(int step_number, std::initializer_list<std::string> freed_items) {
     // TODO: add the checker for new implementation of release plan
     //// create set and check equality
@@ -598,6 +628,55 @@ TEST_F(PlannerTest, InPlaceSizeMismatchTest) {
   CheckFreed(3, {X1});
 }
 
+TEST_F(PlannerTest, ConcatSubViewTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddNormalNode(X1, X2);          // X2: temporary, produced in the first half of X4
+  AddNormalNode(X1, X3);          // X3: temporary, produced in the second half of X4
+  AddConcatNode(X2, X3, X4, -2);  // X4: temporary
+  AddNormalNode(X4, X5);          // X5: output
+
+  // simulate shape-inference results:
+  Shape shape1w{1, 2, 3};
+  auto shape1 = &shape1w.value;
+  Shape shape2w{1, 4, 3};
+  auto shape2 = &shape2w.value;
+  SetShape({{X1, shape1}, {X2, shape1}, {X3, shape1}, {X4, shape2}, {X5, shape2}});
+
+  CreatePlan();
+
+  CheckAllocKind(X1, AllocKind::kPreExisting);
+  CheckSubView(X2, X4, 0);
+  CheckSubView(X3, X4, 2 * 3 * sizeof(float));
+  CheckAllocKind(X4, AllocKind::kAllocate);
+  CheckAllocKind(X5, AllocKind::kAllocateOutput);
+}
+
+TEST_F(PlannerTest, ConcatSubViewNotContiguousTest) {
+  // tensor variables:
+  std::string X1("X1"), X2("X2"), X3("X3"), X4("X4"), X5("X5");
+
+  // graph structure:
+  AddNormalNode(X1, X2);
+  AddNormalNode(X1, X3);
+  AddConcatNode(X2, X3, X4, 1);  // the inputs are interleaved in X4
+  AddNormalNode(X4, X5);
+
+  // simulate shape-inference results:
+  Shape shape1w{2, 2, 3};
+  auto shape1 = &shape1w.value;
+  Shape shape2w{2, 4, 3};
+  auto shape2 = &shape2w.value;
+  SetShape({{X1, shape1}, {X2, shape1}, {X3, shape1}, {X4, shape2}, {X5, shape2}});
+
+  CreatePlan();
+
+  CheckAllocKind(X2, AllocKind::kAllocate);
+  CheckAllocKind(X3, AllocKind::kAllocate);
+}
+
 // Test operator<< to output details of an allocation & execution plan.
 TEST_F(PlannerTest, PlanOutputTest) {
   // tensor variables:
@@ -1191,6 +1270,96 @@ TEST_F(PlannerTest, MultiStream) {
   EXPECT_NE(strstr(typeid(*GetPlan().execution_plan[1]->steps_[2]).name(), "ActivateNotificationStep"), nullptr) << "2nd step: ActivateNofiticationStep by node 3";
   EXPECT_NE(strstr(typeid(*GetPlan().execution_plan[1]->steps_[3]).name(), "TriggerDownstreamStep"), nullptr) << "3rd step: TriggerDownstreamStep for node 4";
 }
+
+// Test the branch based partition of CUDA nodes for the graph:
+//                      /-> node2(CUDA ep) -> node4(CUDA ep)
+// node1(CPU ep) -<
+//                      \-> node3(CUDA ep) -> node5(CUDA ep)
+// each CUDA branch gets its own logic stream, which waits on node1 with a barrier.
+TEST_F(PlannerTest, MultiGpuStreamBranches) {
+  ONNX_NAMESPACE::TensorProto tensor;
+  tensor.add_dims(1);
+  tensor.add_float_data(1.0f);
+  tensor.set_data_type(TensorProto_DataType_FLOAT);
+  tensor.set_name("Graph_input");
+  GetGraph().AddInitializedTensor(tensor);
+
+  std::string Graph_input("Graph_input"), Arg1("Arg1"), Arg2("Arg2"), Arg3("Arg3"), Arg4("Arg4"), Arg5("Arg5");
+  AddNormalNode(Graph_input, Arg1);
+  std::unique_ptr<::onnxruntime::KernelDef> cudaKernel =
+      KernelDefBuilder().SetName("Transpose").Provider(kCudaExecutionProvider).SinceVersion(1, 10).Build();
+  AddNode(*cudaKernel, Arg1, Arg2);
+  AddNode(*cudaKernel, Arg1, Arg3);
+  AddNode(*cudaKernel, Arg2, Arg4);
+  AddNode(*cudaKernel, Arg3, Arg5);
+
+  CUDAExecutionProviderInfo epi;
+  onnxruntime::ProviderInfo_CUDA& ep = onnxruntime::GetProviderInfo_CUDA();
+  auto epFactory = ep.CreateExecutionProviderFactory(epi);
+  std::unique_ptr<IExecutionProvider> execution_provider = epFactory->CreateProvider();
+  AllocatorManager am;
+  execution_provider->RegisterAllocator(am);
+  ORT_THROW_IF_ERROR(GetExecutionProviders().Add("CUDAExecutionProvider", std::move(execution_provider)));
+
+  CreatePlan({}, 1, 2);
+  ASSERT_EQ(GetPlan().execution_plan.size(), 3U) << "one CPU stream and one CUDA stream per branch";
+
+  auto count_steps = [](const SequentialExecutionPlan::LogicStream& stream, const char* step_type) {
+    return std::count_if(stream.steps_.begin(), stream.steps_.end(), [step_type](const auto& step) {
+      return strstr(typeid(*step).name(), step_type) != nullptr;
+    });
+  };
+
+  EXPECT_EQ(count_steps(*GetPlan().execution_plan[0], "LaunchKernelStep"), 1) << "node1";
+  EXPECT_EQ(count_steps(*GetPlan().execution_plan[0], "TriggerDownstreamStep"), 1) << "node1 triggers the CUDA streams";
+  for (size_t i = 1; i < 3; ++i) {
+    const auto& stream = *GetPlan().execution_plan[i];
+    EXPECT_EQ(count_steps(stream, "LaunchKernelStep"), 2) << "CUDA stream " << i << " runs one branch";
+    EXPECT_NE(strstr(typeid(*stream.steps_[0]).name(), "BarrierStep"), nullptr) << "CUDA stream " << i << " waits for node1";
+  }
+  EXPECT_EQ(GetPlan().num_barriers, 2U);
+}
+#endif
+
+#ifdef ENABLE_STREAM
+// Test the branch based partition of CPU nodes for the graph:
+//         /-> node2 -> node4
+// node1 -<
+//         \-> node3 -> node5
+// node1 starts a chain on the 1st stream and one of the branches continues it,
+// the other branch is placed on the 2nd stream and waits on node1 with a barrier.
+TEST_F(PlannerTest, MultiCpuStreamBranches) {
+  ONNX_NAMESPACE::TensorProto tensor;
+  tensor.add_dims(1);
+  tensor.add_float_data(1.0f);
+  tensor.set_data_type(TensorProto_DataType_FLOAT);
+  tensor.set_name("Graph_input");
+  GetGraph().AddInitializedTensor(tensor);
+
+  std::string Graph_input("Graph_input"), Arg1("Arg1"), Arg2("Arg2"), Arg3("Arg3"), Arg4("Arg4"), Arg5("Arg5");
+  AddNormalNode(Graph_input, Arg1);
+  AddNormalNode(Arg1, Arg2);
+  AddNormalNode(Arg1, Arg3);
+  AddNormalNode(Arg2, Arg4);
+  AddNormalNode(Arg3, Arg5);
+
+  CreatePlan({}, 4);
+  ASSERT_EQ(GetPlan().execution_plan.size(), 2U) << "one CPU stream per branch";
+
+  auto count_steps = [](const SequentialExecutionPlan::LogicStream& stream, const char* step_type) {
+    return std::count_if(stream.steps_.begin(), stream.steps_.end(), [step_type](const auto& step) {
+      return strstr(typeid(*step).name(), step_type) != nullptr;
+    });
+  };
+
+  const auto& stream_0 = *GetPlan().execution_plan[0];
+  const auto& stream_1 = *GetPlan().execution_plan[1];
+  EXPECT_EQ(count_steps(stream_0, "LaunchKernelStep"), 3) << "node1 and the branch continuing its chain";
+  EXPECT_EQ(count_steps(stream_0, "TriggerDownstreamStep"), 1) << "node1 triggers the 2nd stream";
+  EXPECT_EQ(count_steps(stream_1, "LaunchKernelStep"), 2) << "the other branch";
+  EXPECT_NE(strstr(typeid(*stream_1.steps_[0]).name(), "BarrierStep"), nullptr) << "2nd stream waits for node1";
+  EXPECT_EQ(GetPlan().num_barriers, 1U);
+}
 #endif
 
 #if not defined(__wasm__)
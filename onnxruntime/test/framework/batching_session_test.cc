@@ -0,0 +1,154 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <sstream>
+#include <thread>
+
+#include "asserts.h"
+#include "core/graph/model.h"
+#include "core/session/batching_session.h"
+#include "core/session/inference_session.h"
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+#include "test/util/include/default_providers.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Loads a model computing Y = Relu(X) with dynamic dims.
+void LoadReluModel(InferenceSession& session) {
+  onnxruntime::Model model("relu", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& input_arg = graph.GetOrCreateNodeArg("X", &tensor_type);
+  auto& output_arg = graph.GetOrCreateNodeArg("Y", &tensor_type);
+  graph.AddNode("relu", "Relu", "Relu", {&input_arg}, {&output_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&serialized));
+  std::stringstream model_stream(serialized);
+
+  ASSERT_STATUS_OK(session.RegisterExecutionProvider(DefaultCpuExecutionProvider()));
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+}
+
+OrtValue MakeFeed(const TensorShape& shape, std::vector<float>& data) {
+  OrtValue value;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), shape, data.data(), OrtMemoryInfo(CPU, OrtDeviceAllocator),
+                       value);
+  return value;
+}
+
+}  // namespace
+
+TEST(BatchingSessionTest, ConcurrentRequests) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  LoadReluModel(session);
+
+  BatchingSessionOptions options;
+  options.max_batch_size = 6;
+  options.max_queue_delay = std::chrono::milliseconds(50);
+  BatchingSession batching_session(session, options);
+
+  constexpr int kNumRequests = 4;
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<std::vector<float>> inputs(kNumRequests);
+  std::vector<std::vector<OrtValue>> fetches(kNumRequests);
+  std::vector<Status> statuses(kNumRequests);
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < kNumRequests; ++i) {
+    // Request i has i + 1 rows of 3 elements with alternating signs.
+    for (int j = 0; j < (i + 1) * 3; ++j) {
+      inputs[i].push_back(static_cast<float>((j % 2 == 0 ? 1 : -1) * (i * 100 + j)));
+    }
+    threads.emplace_back([&, i]() {
+      std::vector<OrtValue> feeds{MakeFeed(TensorShape({i + 1, 3}), inputs[i])};
+      statuses[i] = batching_session.Run(feed_names, feeds, output_names, fetches[i]);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int i = 0; i < kNumRequests; ++i) {
+    ASSERT_STATUS_OK(statuses[i]);
+    ASSERT_EQ(fetches[i].size(), 1u);
+    const auto& output = fetches[i][0].Get<Tensor>();
+    ASSERT_EQ(output.Shape(), TensorShape({i + 1, 3}));
+    auto values = output.DataAsSpan<float>();
+    for (size_t j = 0; j < values.size(); ++j) {
+      EXPECT_EQ(values[j], std::max(inputs[i][j], 0.0f)) << "request " << i << " element " << j;
+    }
+  }
+}
+
+TEST(BatchingSessionTest, PaddedInputs) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  LoadReluModel(session);
+
+  BatchingSessionOptions options;
+  options.max_batch_size = 2;
+  options.max_queue_delay = std::chrono::seconds(10);
+  options.padded_inputs.insert("X");
+  BatchingSession batching_session(session, options);
+
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<float> short_input{1.0f, 2.0f};
+  std::vector<float> long_input{3.0f, 4.0f, 5.0f};
+  std::vector<OrtValue> short_fetches;
+  std::vector<OrtValue> long_fetches;
+  Status short_status;
+
+  // The batch is full once both requests are queued, so neither waits for the delay.
+  std::thread short_thread([&]() {
+    std::vector<OrtValue> feeds{MakeFeed(TensorShape({1, 2}), short_input)};
+    short_status = batching_session.Run(feed_names, feeds, output_names, short_fetches);
+  });
+  std::vector<OrtValue> feeds{MakeFeed(TensorShape({1, 3}), long_input)};
+  ASSERT_STATUS_OK(batching_session.Run(feed_names, feeds, output_names, long_fetches));
+  short_thread.join();
+  ASSERT_STATUS_OK(short_status);
+
+  const auto& short_output = short_fetches[0].Get<Tensor>();
+  ASSERT_EQ(short_output.Shape(), TensorShape({1, 3}));
+  EXPECT_EQ(std::vector<float>(short_output.DataAsSpan<float>().begin(), short_output.DataAsSpan<float>().end()),
+            (std::vector<float>{1.0f, 2.0f, 0.0f}));
+
+  const auto& long_output = long_fetches[0].Get<Tensor>();
+  ASSERT_EQ(long_output.Shape(), TensorShape({1, 3}));
+  EXPECT_EQ(std::vector<float>(long_output.DataAsSpan<float>().begin(), long_output.DataAsSpan<float>().end()),
+            long_input);
+}
+
+TEST(BatchingSessionTest, InvalidRequest) {
+  SessionOptions so;
+  InferenceSession session{so, GetEnvironment()};
+  LoadReluModel(session);
+
+  BatchingSession batching_session(session, BatchingSessionOptions{});
+
+  std::vector<float> input{1.0f};
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<OrtValue> feeds{MakeFeed(TensorShape({}), input)};
+  std::vector<OrtValue> fetches;
+  auto status = batching_session.Run(feed_names, feeds, output_names, fetches);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_NE(status.ErrorMessage().find("has no batch dimension"), std::string::npos);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
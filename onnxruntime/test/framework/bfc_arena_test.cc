@@ -4,7 +4,10 @@
 #include "core/framework/bfc_arena.h"
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
+#include <atomic>
 #include <cstdlib>
+#include <cstring>
+#include <thread>
 #include "core/framework/stream_handles.h"
 
 namespace onnxruntime {
@@ -302,6 +305,249 @@ TEST(BFCArenaTest, TestShrink) {
   EXPECT_EQ(stats.total_allocated_bytes, 10 * 1024 * 1024) << "Expect 10M bytes but actually " << stats.total_allocated_bytes << " bytes";
 }
 
+TEST(BFCArenaTest, TestResetMaxBytesInUse) {
+  AllocatorStats stats;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30);
+  void* big = a.Alloc(1 << 20);
+  void* small = a.Alloc(1024);
+  a.Free(big);
+
+  a.GetStats(&stats);
+  EXPECT_GE(stats.max_bytes_in_use, (1 << 20) + 1024);
+
+  a.ResetMaxBytesInUse();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.max_bytes_in_use, stats.bytes_in_use);
+  EXPECT_LT(stats.max_bytes_in_use, 1 << 20);
+  a.Free(small);
+}
+
+TEST(BFCArenaTest, TestShrinkPolicyIdle) {
+  using namespace std::chrono_literals;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+  BFCArena::ShrinkPolicy policy;
+  policy.idle_time = 1000ms;
+  a.SetShrinkPolicy(policy, false);
+  const auto start = std::chrono::steady_clock::now();
+
+  void* in_use = a.Alloc(1 << 20);
+  a.Free(a.Alloc(1 << 20));
+  EXPECT_FALSE(a.ApplyShrinkPolicy(start + 10ms));
+  EXPECT_FALSE(a.ApplyShrinkPolicy(start + 500ms));
+  EXPECT_TRUE(a.ApplyShrinkPolicy(start + 1010ms));
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 1 << 20);
+
+  // shrinks once per idle period
+  EXPECT_FALSE(a.ApplyShrinkPolicy(start + 3000ms));
+  a.Free(a.Alloc(1 << 20));
+  EXPECT_FALSE(a.ApplyShrinkPolicy(start + 3010ms));
+  EXPECT_TRUE(a.ApplyShrinkPolicy(start + 4010ms));
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 1 << 20);
+  a.Free(in_use);
+}
+
+TEST(BFCArenaTest, TestShrinkPolicyLowUsage) {
+  using namespace std::chrono_literals;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+  BFCArena::ShrinkPolicy policy;
+  policy.low_usage_percent = 50;
+  policy.low_usage_window = 100ms;
+  policy.retain_bytes = 2 << 20;
+  a.SetShrinkPolicy(policy, false);
+  const auto start = std::chrono::steady_clock::now();
+
+  void* in_use = a.Alloc(1 << 20);
+  void* p1 = a.Alloc(1 << 20);
+  void* p2 = a.Alloc(1 << 20);
+  a.Free(p1);
+  a.Free(p2);
+
+  // the first window saw all the memory of the arena in use
+  EXPECT_FALSE(a.ApplyShrinkPolicy(start + 100ms));
+  // the second window saw a third of it in use, the arena keeps 2 of its 3 regions to retain 2 MB
+  EXPECT_TRUE(a.ApplyShrinkPolicy(start + 200ms));
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.total_allocated_bytes, 2 << 20);
+  // half of the remaining memory is in use, which isn't below the threshold
+  EXPECT_FALSE(a.ApplyShrinkPolicy(start + 300ms));
+  a.Free(in_use);
+}
+
+TEST(BFCArenaTest, TestShrinkPolicyInBackground) {
+  using namespace std::chrono_literals;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+  BFCArena::ShrinkPolicy policy;
+  policy.idle_time = 20ms;
+  a.SetShrinkPolicy(policy);
+  a.Free(a.Alloc(1 << 20));
+
+  AllocatorStats stats;
+  for (int i = 0; i < 1000; ++i) {
+    a.GetStats(&stats);
+    if (stats.total_allocated_bytes == 0) {
+      break;
+    }
+    std::this_thread::sleep_for(10ms);
+  }
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+}
+
+TEST(BFCArenaTest, TestFragmentationStats) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested);
+  void* first = a.Alloc(1 << 20);
+  void* second = a.Alloc(1 << 20);
+  void* small = a.Alloc(1024);
+  a.Free(first);
+  a.Free(small);
+
+  // the bins of 1024 bytes and 1 MB
+  constexpr size_t small_bin = 2;
+  constexpr size_t large_bin = 12;
+
+  ArenaFragmentationStats stats;
+  a.GetFragmentationStats(&stats, true);
+  EXPECT_EQ(stats.num_regions, 3);
+  EXPECT_EQ(stats.region_bytes, (2 << 20) + 1024);
+  EXPECT_EQ(stats.free_bytes, (1 << 20) + 1024);
+  EXPECT_EQ(stats.largest_free_chunk_bytes, 1 << 20);
+  EXPECT_EQ(stats.window_num_allocs, 3);
+  ASSERT_GT(stats.bins.size(), large_bin);
+  EXPECT_EQ(stats.bins[small_bin].bin_size, 1024u);
+  EXPECT_EQ(stats.bins[small_bin].num_free_chunks, 1);
+  EXPECT_EQ(stats.bins[small_bin].num_allocs, 1);
+  EXPECT_EQ(stats.bins[large_bin].bin_size, size_t{1} << 20);
+  EXPECT_EQ(stats.bins[large_bin].num_free_chunks, 1);
+  EXPECT_EQ(stats.bins[large_bin].free_bytes, 1 << 20);
+  EXPECT_EQ(stats.bins[large_bin].num_allocs, 2);
+
+  // the window was reset, the free chunks are unchanged
+  void* reused = a.Alloc(1000);
+  a.GetFragmentationStats(&stats, false);
+  EXPECT_EQ(stats.window_num_allocs, 1);
+  EXPECT_EQ(stats.bins[small_bin].num_allocs, 1);
+  EXPECT_EQ(stats.bins[small_bin].num_free_chunks, 0);
+  EXPECT_EQ(stats.bins[large_bin].num_allocs, 0);
+  EXPECT_EQ(stats.num_regions, 3);
+
+  a.Free(reused);
+  a.Free(second);
+}
+
+TEST(BFCArenaTest, ThreadCache) {
+  AllocatorStats stats;
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kSameAsRequested,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, 4096);
+
+  // The first allocation refills the cache with a batch of chunks, and freeing it keeps it in the cache.
+  void* p1 = a.Alloc(1000);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_allocs, 1);
+  EXPECT_EQ(stats.num_thread_cache_refills, 1);
+  EXPECT_EQ(stats.num_allocs, 16);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 15 * 1024);
+  EXPECT_EQ(a.AllocatedSize(p1), 1024u);
+
+  a.Free(p1);
+  void* p2 = a.Alloc(1024);
+  EXPECT_EQ(p1, p2);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_allocs, 2);
+  EXPECT_EQ(stats.num_thread_cache_refills, 1);
+
+  // Larger allocations bypass the cache.
+  void* large = a.Alloc(8192);
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_allocs, 2);
+  a.Free(large);
+
+  // A chunk freed on another thread goes back to the cache it came from.
+  std::thread([&a, p2]() { a.Free(p2); }).join();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 15 * 1024);
+  EXPECT_EQ(a.Alloc(1024), p2);
+  a.Free(p2);
+
+  // The chunks of a thread's cache go back to the arena when the thread exits, including one still in use.
+  void* from_other_thread = nullptr;
+  std::thread([&a, &from_other_thread]() {
+    a.Free(a.Alloc(256));
+    from_other_thread = a.Alloc(256);
+  }).join();
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.num_thread_cache_allocs, 5);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 16 * 1024);
+  EXPECT_EQ(stats.bytes_in_use, 16 * 1024 + 256);
+  a.Free(from_other_thread);
+
+  // Shrink releases the cache of the calling thread, so the region can be freed.
+  EXPECT_EQ(a.Shrink(), Status::OK());
+  a.GetStats(&stats);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+  EXPECT_EQ(stats.total_allocated_bytes, 0);
+}
+
+TEST(BFCArenaTest, ThreadCacheConcurrentAllocations) {
+  BFCArena a(std::unique_ptr<IAllocator>(new CPUAllocator()), 1 << 30, ArenaExtendStrategy::kNextPowerOfTwo,
+             BFCArena::DEFAULT_INITIAL_CHUNK_SIZE_BYTES, BFCArena::DEFAULT_MAX_DEAD_BYTES_PER_CHUNK,
+             BFCArena::DEFAULT_INITIAL_GROWTH_CHUNK_SIZE_BYTES, 64 * 1024);
+
+  // Each thread frees half of its allocations right away, and the other half are freed by the next thread while
+  // their owner is still running.
+  constexpr int kNumThreads = 8;
+  constexpr int kNumIterations = 200;
+  std::vector<std::vector<void*>> handed_over(kNumThreads);
+  std::atomic<int> num_ready{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([&a, &handed_over, &num_ready, t]() {
+      auto allocate = [&a, t](int i) {
+        const size_t size = 1 + static_cast<size_t>((i * 7919 + t * 104729) % (70 * 1024));
+        void* p = a.Alloc(size);
+        memset(p, t, size);
+        return p;
+      };
+
+      for (int i = 0; i < kNumIterations; ++i) {
+        void* p = allocate(i);
+        if (i % 2 == 0) {
+          a.Free(p);
+        } else {
+          handed_over[t].push_back(p);
+        }
+      }
+
+      ++num_ready;
+      while (num_ready < kNumThreads) {
+        std::this_thread::yield();
+      }
+
+      for (void* p : handed_over[(t + 1) % kNumThreads]) {
+        a.Free(p);
+      }
+
+      // Pick up the chunks freed by the other threads.
+      for (int i = 0; i < kNumIterations; ++i) {
+        a.Free(allocate(i));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  AllocatorStats stats;
+  a.GetStats(&stats);
+  EXPECT_GT(stats.num_thread_cache_allocs, 0);
+  EXPECT_EQ(stats.bytes_in_use, 0);
+  EXPECT_EQ(stats.bytes_in_thread_caches, 0);
+}
+
 class BadAllocator : public IAllocator {
  public:
   BadAllocator() : IAllocator(OrtMemoryInfo(CPU, OrtAllocatorType::OrtDeviceAllocator)) {}
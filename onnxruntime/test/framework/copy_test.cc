@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <numeric>
+
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include "core/framework/copy.h"
@@ -109,6 +111,38 @@ TEST_F(CopyTest, Concat2D) {
   }
 }
 
+TEST_F(CopyTest, Broadcast2D) {
+  // test performing a Tile of a [3, 1] tensor by [2, 5] using source strides of 0 for the repeats
+  int src[3] = {1, 2, 3};
+  int dst[6 * 5];
+
+  StridedCopy<int>(tp.get(), dst, {15, 5, 1, 1}, {2, 3, 5, 1}, src, {0, 1, 0, 1});
+
+  for (int i0 = 0; i0 < 6; i0++) {
+    for (int i1 = 0; i1 < 5; i1++) {
+      EXPECT_EQ(src[i0 % 3], dst[i0 * 5 + i1]);
+    }
+  }
+}
+
+TEST_F(CopyTest, LargeNonTemporal2D) {
+  // test a copy large enough to use non-temporal stores, into a destination that is not 16 byte aligned
+  constexpr int64_t rows = 4000;
+  constexpr int64_t cols = 300;
+  std::vector<int32_t> src(rows * cols);
+  std::iota(src.begin(), src.end(), 0);
+  std::vector<int32_t> dst(rows * (cols + 1) + 1, -1);
+
+  StridedCopy<int32_t>(tp.get(), dst.data() + 1, {cols + 1, 1}, {rows, cols}, src.data(), {cols, 1});
+
+  for (int64_t i0 = 0; i0 < rows; i0++) {
+    for (int64_t i1 = 0; i1 < cols; i1++) {
+      ASSERT_EQ(src[i0 * cols + i1], dst[1 + i0 * (cols + 1) + i1]);
+    }
+    ASSERT_EQ(-1, dst[1 + i0 * (cols + 1) + cols]);
+  }
+}
+
 TEST_F(CopyTest, CoalesceTensorsTest) {
   {
     TensorShapeVector strides_a{3, 1};
@@ -55,6 +55,7 @@
 #include "test/optimizer/dummy_graph_transformer.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/inference_session_wrapper.h"
+#include "test/util/include/temp_dir.h"
 
 #include "gtest/gtest.h"
 
@@ -615,6 +616,98 @@ TEST(InferenceSessionTests, CheckRunLogger) {
 #endif
 }
 
+#if !defined(ORT_MINIMAL_BUILD)
+TEST(InferenceSessionTests, OptimizedModelCache) {
+  TemporaryDirectory cache_dir{ORT_TSTR("optimized_model_cache_test_dir")};
+
+  // returns true if a log message of the session contains expected_msg
+  auto run_session = [&](TransformerLevel optimization_level, const std::string& expected_msg) {
+    SessionOptions so;
+    so.session_logid = "OptimizedModelCache";
+    so.graph_optimization_level = optimization_level;
+    EXPECT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsOptimizedModelCacheDir,
+                                                      ToUTF8String(cache_dir.Path()).c_str()));
+
+    // LoggingManager owns the sink, the pointer stays valid as long as env is alive.
+    auto capturing_sink = new CapturingSink();
+    auto logging_manager = std::make_unique<logging::LoggingManager>(
+        std::unique_ptr<ISink>(capturing_sink), logging::Severity::kVERBOSE, false,
+        LoggingManager::InstanceType::Temporal);
+    std::unique_ptr<Environment> env;
+    EXPECT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+
+    InferenceSession session_object{so, *env};
+    EXPECT_STATUS_OK(session_object.Load(MODEL_URI));
+    EXPECT_STATUS_OK(session_object.Initialize());
+
+    RunOptions run_options;
+    RunModel(session_object, run_options);
+
+    const auto& msgs = capturing_sink->Messages();
+    return std::any_of(msgs.begin(), msgs.end(),
+                       [&](const std::string& msg) { return msg.find(expected_msg) != std::string::npos; });
+  };
+
+  // the first session optimizes the model and saves it, the second one loads it from the cache
+  ASSERT_TRUE(run_session(TransformerLevel::Level2, "Saved the optimized model to the cache"));
+  ASSERT_TRUE(run_session(TransformerLevel::Level2, "Loaded the optimized model from the cache"));
+
+  // different session options produce a different cache entry
+  ASSERT_TRUE(run_session(TransformerLevel::Level1, "Saved the optimized model to the cache"));
+}
+
+TEST(InferenceSessionTests, ShapeSpecialization) {
+  SessionOptions so;
+  so.session_logid = "ShapeSpecialization";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsShapeSpecializationWarmupRuns, "2"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsShapeSpecializationMaxSessions, "1"));
+
+  // the input has the shape [Dim1, Dim2, 5]
+  InferenceSession session_object{so, GetEnvironment()};
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/abs_free_dimensions.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  auto run = [&](int64_t dim1, int64_t dim2) {
+    std::vector<int64_t> dims{dim1, dim2, 5};
+    std::vector<float> values(static_cast<size_t>(dim1 * dim2 * 5));
+    std::vector<float> expected_values(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+      values[i] = i % 2 == 0 ? -static_cast<float>(i) : static_cast<float>(i);
+      expected_values[i] = static_cast<float>(i);
+    }
+
+    OrtValue ml_value;
+    CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), dims, values, &ml_value);
+    NameMLValMap feeds{{"x", ml_value}};
+    std::vector<std::string> output_names{"y"};
+    std::vector<OrtValue> fetches;
+    ASSERT_STATUS_OK(session_object.Run(RunOptions{}, feeds, output_names, &fetches));
+    VerifyOutputs(fetches, dims, expected_values);
+  };
+
+  // no specialized session is built before the shape is hot
+  run(1, 42);
+  ASSERT_EQ(session_object.GetNumShapeSpecializedSessions(), 0u);
+  run(2, 3);
+  run(1, 42);
+
+  // the specialized session for Dim1=1, Dim2=42 is built in the background
+  for (int i = 0; i < 1000 && session_object.GetNumShapeSpecializedSessions() == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_EQ(session_object.GetNumShapeSpecializedSessions(), 1u);
+
+  // both the specialized and the generic session produce the right outputs
+  run(1, 42);
+  run(2, 3);
+  run(2, 3);
+  run(3, 1);
+
+  // the limit on the number of specialized sessions is respected
+  ASSERT_EQ(session_object.GetNumShapeSpecializedSessions(), 1u);
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 // WebAssembly will emit profiling data into console
 #if !defined(__wasm__)
 TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions) {
@@ -732,6 +825,94 @@ TEST(InferenceSessionTests, CheckRunProfilerWithSessionOptions2) {
 #endif
 }
 
+TEST(InferenceSessionTests, CheckRunProfilerStreamingWithTimelineTracks) {
+  SessionOptions so;
+
+  so.session_logid = "CheckRunProfiler";
+  so.enable_profiling = true;
+  so.profile_file_prefix = ORT_TSTR("onnxprofile_streaming_test");
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsProfilingStreamingBatchSize, "2"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsProfilingTimelineTracks, "1"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  run_options.run_tag = "RunTag";
+
+  RunModel(session_object, run_options);
+  std::string profile_file = session_object.EndProfiling();
+
+  std::ifstream profile(profile_file);
+  ASSERT_TRUE(profile);
+  std::string line;
+  std::vector<std::string> lines;
+
+  while (std::getline(profile, line)) {
+    lines.push_back(line);
+  }
+
+  auto size = lines.size();
+  ASSERT_TRUE(size > 1);
+  ASSERT_TRUE(lines[0].find("[") != string::npos);
+  ASSERT_TRUE(lines[1].find("model_loading_uri") != string::npos);
+  ASSERT_TRUE(lines[size - 1].find("]") != string::npos);
+
+  // the CPU allocator is an arena by default, its bytes in use are recorded after each node
+  bool has_kernel_time = false;
+  bool has_arena_counter = false;
+  for (size_t i = 1; i < size - 1; ++i) {
+    has_kernel_time = has_kernel_time || lines[i].find("mul_1_kernel_time") != string::npos;
+    has_arena_counter = has_arena_counter || (lines[i].find("\"ph\" : \"C\"") != string::npos &&
+                                              lines[i].find("\"bytes_in_use\" : ") != string::npos);
+  }
+  ASSERT_TRUE(has_kernel_time);
+  ASSERT_TRUE(has_arena_counter);
+}
+
+#if !defined(ORT_MINIMAL_BUILD)
+TEST(InferenceSessionTests, PartitioningCostModelFromProfile) {
+  std::string profile_file;
+  {
+    SessionOptions so;
+    so.session_logid = "PartitioningCostModelFromProfile";
+    so.enable_profiling = true;
+    so.profile_file_prefix = ORT_TSTR("onnxprofile_partitioning_cost_model_test");
+
+    InferenceSession session_object(so, GetEnvironment());
+    ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+    ASSERT_STATUS_OK(session_object.Initialize());
+
+    RunOptions run_options;
+    RunModel(session_object, run_options);
+    profile_file = session_object.EndProfiling();
+  }
+
+  PartitioningCostModel cost_model;
+  ASSERT_STATUS_OK(inference_session_utils::LoadPartitioningCostModelFromProfile(ToPathString(profile_file),
+                                                                                 cost_model));
+  ASSERT_EQ(cost_model.op_costs.count("Mul"), 1u);
+  ASSERT_EQ(cost_model.op_costs["Mul"].count(kCpuExecutionProvider), 1u);
+  ASSERT_GE(cost_model.op_costs["Mul"][kCpuExecutionProvider], 0.0);
+
+  // a session using the profile partitions and runs as usual
+  SessionOptions so;
+  so.session_logid = "PartitioningCostModelFromProfile";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsPartitioningCostModelFile,
+                                                    profile_file.c_str()));
+  InferenceSession session_object(so, GetEnvironment());
+#ifdef USE_CUDA
+  ASSERT_STATUS_OK(session_object.RegisterExecutionProvider(DefaultCudaExecutionProvider()));
+#endif
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+}
+#endif  // !defined(ORT_MINIMAL_BUILD)
+
 
 TEST(InferenceSessionTests, CheckRunProfilerWithStartProfile) {
   SessionOptions so;
@@ -798,6 +979,158 @@ TEST(InferenceSessionTests, CheckRunProfilerStartTime) {
   ASSERT_TRUE(before_start_time <= profiling_start_time && profiling_start_time <= after_start_time);
 }
 
+TEST(InferenceSessionTests, SamplingProfiler) {
+  SessionOptions so;
+  so.session_logid = "SamplingProfiler";
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsSamplingProfilerRate, "2"));
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  RunOptions run_options;
+  for (int i = 0; i < 4; ++i) {
+    RunModel(session_object, run_options);
+  }
+
+  // the nodes of every second run are timed
+  const auto* sampling_profiler = session_object.GetProfiling().GetSamplingProfiler();
+  ASSERT_NE(sampling_profiler, nullptr);
+  const auto stats = sampling_profiler->GetNodeLatencies();
+  ASSERT_FALSE(stats.empty());
+  for (const auto& node_stats : stats) {
+    EXPECT_EQ(node_stats.count, 2u);
+    EXPECT_GE(node_stats.max_ns * node_stats.count, node_stats.total_ns);
+  }
+
+  // the sampling profiler is disabled by default
+  InferenceSession session_without_sampling(SessionOptions{}, GetEnvironment());
+  EXPECT_EQ(session_without_sampling.GetProfiling().GetSamplingProfiler(), nullptr);
+  EXPECT_FALSE(session_without_sampling.SetSamplingProfilerExportCallback(nullptr).IsOK());
+}
+
+TEST(InferenceSessionTests, ResourceStats) {
+  SessionOptions so;
+  so.session_logid = "ResourceStats";
+  so.intra_op_param.thread_pool_size = 2;
+
+  InferenceSession session_object(so, GetEnvironment());
+  SessionResourceStats stats;
+  EXPECT_FALSE(session_object.GetResourceStats(stats).IsOK());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // starts the interval
+  ASSERT_STATUS_OK(session_object.GetResourceStats(stats));
+  EXPECT_EQ(stats.intra_op_thread_pool_utilization, 0.0);
+
+  RunOptions run_options;
+  RunModel(session_object, run_options);
+  ASSERT_STATUS_OK(session_object.GetResourceStats(stats));
+  EXPECT_GT(stats.arena_peak_bytes_in_use, 0u);
+  EXPECT_GE(stats.intra_op_thread_pool_utilization, 0.0);
+  EXPECT_LE(stats.intra_op_thread_pool_utilization, 1.0);
+}
+
+TEST(InferenceSessionTests, PredictMemoryUsage) {
+  SessionOptions so;
+  so.session_logid = "PredictMemoryUsage";
+
+  InferenceSession session_object(so, GetEnvironment());
+  const InlinedHashMap<std::string, TensorShape> input_shapes{{"X", TensorShape({3, 2})}};
+  MemoryUsagePrediction prediction;
+  EXPECT_FALSE(session_object.PredictMemoryUsage(input_shapes, prediction).IsOK());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  EXPECT_FALSE(session_object.PredictMemoryUsage({}, prediction).IsOK());
+  ASSERT_STATUS_OK(session_object.PredictMemoryUsage(input_shapes, prediction));
+  ASSERT_EQ(prediction.locations.size(), 1u);
+  EXPECT_EQ(prediction.locations[0].location.device.Type(), OrtDevice::CPU);
+  // the 3x2 float initializer W, and the output Y of the same shape
+  EXPECT_EQ(prediction.locations[0].initializer_bytes, 6 * sizeof(float));
+  EXPECT_GE(prediction.locations[0].peak_activation_bytes, 6 * sizeof(float));
+  EXPECT_EQ(prediction.num_unresolved_tensors, 0u);
+}
+
+TEST(InferenceSessionTests, PredictMemoryUsageWithUnresolvedShapes) {
+  SessionOptions so;
+  so.session_logid = "PredictMemoryUsageWithUnresolvedShapes";
+
+  InferenceSession session_object(so, GetEnvironment());
+  ASSERT_STATUS_OK(session_object.Load(ORT_TSTR("testdata/capi_symbolic_dims.onnx")));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  // the shape of the output of Reshape depends on the values of its shape input
+  MemoryUsagePrediction prediction;
+  ASSERT_STATUS_OK(session_object.PredictMemoryUsage({{"A", TensorShape({4, 2})}, {"B", TensorShape({2})}},
+                                                     prediction));
+  EXPECT_EQ(prediction.num_unresolved_tensors, 1u);
+  // the rank of the inputs must match the graph
+  EXPECT_FALSE(session_object.PredictMemoryUsage({{"A", TensorShape({8})}, {"B", TensorShape({2})}}, prediction)
+                   .IsOK());
+}
+
+TEST(InferenceSessionTests, Warmup) {
+  SessionOptions so;
+  so.session_logid = "Warmup";
+
+  InferenceSession session_object(so, GetEnvironment());
+  const std::vector<InlinedHashMap<std::string, TensorShape>> shape_sets{{{"X", TensorShape({3, 2})}},
+                                                                          {{"X", TensorShape({3, 2})}}};
+  RunOptions run_options;
+  WarmupStats stats;
+  EXPECT_FALSE(session_object.Warmup(run_options, shape_sets, 2, stats).IsOK());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  EXPECT_FALSE(session_object.Warmup(run_options, shape_sets, 0, stats).IsOK());
+  const std::vector<InlinedHashMap<std::string, TensorShape>> missing_input{{{"Y", TensorShape({3, 2})}}};
+  EXPECT_FALSE(session_object.Warmup(run_options, missing_input, 1, stats).IsOK());
+
+  ASSERT_STATUS_OK(session_object.Warmup(run_options, shape_sets, 2, stats));
+  ASSERT_EQ(stats.shape_sets.size(), 2u);
+  for (const auto& shape_set : stats.shape_sets) {
+    EXPECT_GE(shape_set.first_run_ms, 0.0);
+    EXPECT_GE(shape_set.last_run_ms, 0.0);
+  }
+
+  // the session runs as usual after the warm-up
+  RunModel(session_object, run_options);
+}
+
+TEST(InferenceSessionTests, Clone) {
+  SessionOptions so;
+  so.session_logid = "Clone";
+  so.intra_op_param.thread_pool_size = 2;
+
+  InferenceSession session_object(so, GetEnvironment());
+  SessionOptions clone_options;
+  clone_options.session_logid = "ClonedSession";
+  clone_options.intra_op_param.thread_pool_size = 3;
+  std::unique_ptr<InferenceSession> clone;
+  EXPECT_FALSE(session_object.Clone(clone_options, clone).IsOK());
+  ASSERT_STATUS_OK(session_object.Load(MODEL_URI));
+  ASSERT_STATUS_OK(session_object.Initialize());
+
+  SessionOptions profiling_options;
+  profiling_options.enable_profiling = true;
+  EXPECT_FALSE(session_object.Clone(profiling_options, clone).IsOK());
+
+  ASSERT_STATUS_OK(session_object.Clone(clone_options, clone));
+  ASSERT_NE(clone, nullptr);
+  // the clone shares the initialized state of the session, but runs on its own thread pool
+  EXPECT_EQ(&clone->GetSessionState(), &session_object.GetSessionState());
+  EXPECT_EQ(clone->GetSessionOptions().session_logid, "ClonedSession");
+  EXPECT_EQ(clone->GetModelInputs().second->size(), session_object.GetModelInputs().second->size());
+  // the clone is initialized already
+  EXPECT_FALSE(clone->Load(MODEL_URI).IsOK());
+
+  RunOptions run_options;
+  RunModel(*clone, run_options);
+  RunModel(session_object, run_options);
+}
+
 TEST(InferenceSessionTests, MultipleSessionsNoTimeout) {
   SessionOptions session_options;
 
@@ -2784,6 +3117,48 @@ TEST(InferenceSessionTests, InitializerSharing_EnsureSessionsUseUserAddedInitial
   ASSERT_NE(so3_init_buffer, val_to_share.Get<Tensor>().Data<float>());
 }
 
+TEST(InferenceSessionTests, InitializerSharing_EnsureSessionsUseEnvInitializerStore) {
+  auto logging_manager = std::make_unique<logging::LoggingManager>(
+      std::unique_ptr<ISink>(new CLogSink()), logging::Severity::kVERBOSE, false,
+      LoggingManager::InstanceType::Temporal);
+
+  std::unique_ptr<Environment> env;
+  ASSERT_STATUS_OK(Environment::Create(std::move(logging_manager), env));
+
+  const char* init_name = "W";
+  auto get_init_buffer = [init_name](const InferenceSessionWrapper& sess) {
+    int idx;
+    ORT_THROW_IF_ERROR(sess.GetSessionState().GetOrtValueNameIdxMap().GetIdx(init_name, idx));
+    return sess.GetSessionState().GetInitializedTensors().at(idx).Get<Tensor>().Data<float>();
+  };
+
+  SessionOptions so1;
+  ASSERT_STATUS_OK(so1.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseEnvInitializerStore, "1"));
+  InferenceSessionTestSharingInitializer sess1(so1, *env);
+  ASSERT_STATUS_OK(sess1.Load(MODEL_URI));
+  ASSERT_STATUS_OK(sess1.Initialize());
+  const size_t num_stored = env->GetSharedInitializerStore().GetNumberOfInitializers();
+  ASSERT_GE(num_stored, 1u);
+
+  SessionOptions so2;
+  ASSERT_STATUS_OK(so2.config_options.AddConfigEntry(kOrtSessionOptionsConfigUseEnvInitializerStore, "1"));
+  InferenceSessionTestSharingInitializer sess2(so2, *env);
+  ASSERT_STATUS_OK(sess2.Load(MODEL_URI));
+  ASSERT_STATUS_OK(sess2.Initialize());
+
+  SessionOptions so3;
+  InferenceSessionTestSharingInitializer sess3(so3, *env);
+  ASSERT_STATUS_OK(sess3.Load(MODEL_URI));
+  ASSERT_STATUS_OK(sess3.Initialize());
+
+  // The second session found all the initializers of the model in the store
+  ASSERT_EQ(env->GetSharedInitializerStore().GetNumberOfInitializers(), num_stored);
+
+  // Ensure both sessions using the store share the same data ptr, and the other session has its own copy
+  ASSERT_EQ(get_init_buffer(sess1), get_init_buffer(sess2));
+  ASSERT_NE(get_init_buffer(sess3), get_init_buffer(sess1));
+}
+
 void RunModelWithDenormalAsZero(InferenceSession& session_object,
                                 const RunOptions& run_options,
                                 bool set_denormal_as_zero) {
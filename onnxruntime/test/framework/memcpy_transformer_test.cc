@@ -448,6 +448,75 @@ TEST(TransformerTest, MemcpyTransformerTestImplicitInputConsumedOnMultipleDevice
   ASSERT_TRUE(op_count_map["MemcpyFromHost"] == 1);
 }
 
+TEST(TransformerTest, MemcpyTransformerTestBatchedCopies) {
+  // O1 and O2 are produced by independent CPU nodes and consumed by CUDA nodes,
+  // O3 is produced by a CPU node that depends on O1. O1 and O2 can cross the boundary
+  // together, while O3 must be copied after O1 is.
+  std::unordered_map<std::string, int> domain_to_version;
+  domain_to_version[kOnnxDomain] = 7;
+  auto model = std::make_shared<onnxruntime::Model>("test", false, ModelMetaData(), PathString(),
+                                                    IOnnxRuntimeOpSchemaRegistryList(),
+                                                    domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                                                    DefaultLoggingManager().DefaultLogger());
+  onnxruntime::Graph& graph = model->MainGraph();
+
+  TypeProto tensor_float_type;
+  tensor_float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  onnxruntime::NodeArg i1_def("I1", &tensor_float_type),
+      i2_def("I2", &tensor_float_type),
+      o1_def("O1", &tensor_float_type),
+      o2_def("O2", &tensor_float_type),
+      o3_def("O3", &tensor_float_type),
+      o4_def("O4", &tensor_float_type),
+      o5_def("O5", &tensor_float_type);
+
+  auto& node1 = graph.AddNode("node1", "Abs", "cpu operator1", ArgMap{&i1_def}, ArgMap{&o1_def});
+  node1.SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+  auto& node2 = graph.AddNode("node2", "Abs", "cpu operator2", ArgMap{&i2_def}, ArgMap{&o2_def});
+  node2.SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+  auto& node3 = graph.AddNode("node3", "Neg", "cpu operator3", ArgMap{&o1_def}, ArgMap{&o3_def});
+  node3.SetExecutionProviderType(onnxruntime::kCpuExecutionProvider);
+  auto& node4 = graph.AddNode("node4", "Add", "gpu operator1", ArgMap{&o1_def, &o2_def}, ArgMap{&o4_def});
+  node4.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+  auto& node5 = graph.AddNode("node5", "Add", "gpu operator2", ArgMap{&o4_def, &o3_def}, ArgMap{&o5_def});
+  node5.SetExecutionProviderType(onnxruntime::kCudaExecutionProvider);
+
+  auto status = graph.Resolve();
+  ASSERT_TRUE(status.IsOK()) << status.ErrorMessage();
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(onnxruntime::kCudaExecutionProvider, DefaultCudaExecutionProvider()));
+  ASSERT_STATUS_OK(execution_providers.Add(onnxruntime::kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo())));
+  KernelRegistryManager test_registry_manager;
+  ASSERT_STATUS_OK(test_registry_manager.RegisterKernels(execution_providers));
+
+  MemcpyTransformer transformer({onnxruntime::kCudaExecutionProvider}, test_registry_manager);
+
+  bool modified = false;
+  status = transformer.Apply(graph, modified, DefaultLoggingManager().DefaultLogger());
+  EXPECT_TRUE(status.IsOK()) << status.ErrorMessage();
+  EXPECT_TRUE(modified);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  auto op_count_map = CountOpsInGraph(graph);
+  ASSERT_EQ(op_count_map["MemcpyFromHostBatch"], 1);
+  ASSERT_EQ(op_count_map["MemcpyFromHost"], 1);
+
+  // Expect: O1 and O2 copied by the batched node, in order
+  const auto* batch_node = graph.GetProducerNode(node4.InputDefs()[0]->Name());
+  ASSERT_NE(batch_node, nullptr);
+  EXPECT_EQ(batch_node->OpType(), "MemcpyFromHostBatch");
+  ASSERT_EQ(batch_node->InputDefs().size(), 2u);
+  EXPECT_EQ(batch_node->InputDefs()[0], node1.OutputDefs()[0]);
+  EXPECT_EQ(batch_node->InputDefs()[1], node2.OutputDefs()[0]);
+  EXPECT_EQ(batch_node->OutputDefs()[0], node4.InputDefs()[0]);
+  EXPECT_EQ(batch_node->OutputDefs()[1], node4.InputDefs()[1]);
+
+  // Expect: O3 copied on its own
+  ExpectCopy(node3, "MemcpyFromHost", node5, 1);
+}
+
 #endif
 
 }  // namespace test
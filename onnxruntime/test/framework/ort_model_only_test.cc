@@ -314,6 +314,52 @@ TEST(OrtModelOnlyTests, ValidateOrtFormatModelDoesNotRunOptimizersInFullBuild) {
   RunOrtModel(test_info);
 }
 
+// The memory patterns of a model with static input shapes are saved with it and used by the first run.
+TEST(OrtModelOnlyTests, SerializeMemoryPatterns) {
+  const auto ort_file = ORT_TSTR("testdata/mnist.onnx.memory_patterns.test_output.ort");
+  SaveAndCompareModels(ORT_TSTR("testdata/mnist.onnx"), ort_file);
+
+  std::string ort_bytes;
+  ASSERT_TRUE(flatbuffers::LoadFile(ToUTF8String(ort_file).c_str(), true, &ort_bytes));
+  const auto* fbs_session = fbs::GetInferenceSession(ort_bytes.data());
+  const auto* fbs_memory_patterns = fbs_session->memory_patterns();
+  ASSERT_NE(fbs_memory_patterns, nullptr);
+  ASSERT_NE(fbs_memory_patterns->input_dims(), nullptr);
+  EXPECT_THAT(std::vector<int64_t>(fbs_memory_patterns->input_dims()->begin(),
+                                   fbs_memory_patterns->input_dims()->end()),
+              ::testing::ElementsAre(4, 1, 1, 28, 28));
+  ASSERT_NE(fbs_memory_patterns->patterns(), nullptr);
+  ASSERT_GT(fbs_memory_patterns->patterns()->size(), 0u);
+  for (const auto* fbs_pattern : *fbs_memory_patterns->patterns()) {
+    ASSERT_NE(fbs_pattern->value_names(), nullptr);
+    ASSERT_GT(fbs_pattern->value_names()->size(), 0u);
+    ASSERT_EQ(fbs_pattern->offsets()->size(), fbs_pattern->value_names()->size());
+    ASSERT_EQ(fbs_pattern->sizes()->size(), fbs_pattern->value_names()->size());
+    for (flatbuffers::uoffset_t i = 0; i < fbs_pattern->offsets()->size(); ++i) {
+      EXPECT_LE(fbs_pattern->offsets()->Get(i) + fbs_pattern->sizes()->Get(i), fbs_pattern->peak_size());
+    }
+  }
+
+  OrtModelTestInfo test_info;
+  test_info.model_filename = ort_file;
+  test_info.logid = "SerializeMemoryPatterns";
+  test_info.configs.push_back(std::make_pair(kOrtSessionOptionsConfigLoadModelFormat, "ORT"));
+
+  OrtValue ml_value;
+  std::vector<float> data(28 * 28, 1.0);
+  CreateMLValue<float>(TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault), {1, 1, 28, 28}, data,
+                       &ml_value);
+  test_info.inputs.insert(std::make_pair("Input3", ml_value));
+
+  test_info.output_names = {"Plus214_Output_0"};
+  test_info.output_verifier = [](const std::vector<OrtValue>& fetches) {
+    const auto& output = fetches[0].Get<Tensor>();
+    ASSERT_EQ(output.Shape().Size(), 10);
+  };
+
+  RunOrtModel(test_info);
+}
+
 TEST(OrtModelOnlyTests, SerializeToOrtFormat) {
   const auto ort_file = ORT_TSTR("testdata/ort_github_issue_4031.onnx.test_output.ort");
   SaveAndCompareModels(ORT_TSTR("testdata/ort_github_issue_4031.onnx"), ort_file);
@@ -576,6 +622,13 @@ TEST(OrtModelOnlyTests, LoadOrtFormatModelFromBufferNoCopyInitializersUseBuffer)
   RunOrtModel(test_info);
 }
 
+// Load the model from a file path by memory mapping it, with initializers using the mapped bytes
+TEST(OrtModelOnlyTests, LoadOrtFormatModelMemoryMapped) {
+  OrtModelTestInfo test_info = GetTestInfoForLoadOrtFormatModel();
+  test_info.configs.push_back(std::make_pair(kOrtSessionOptionsConfigMemoryMapOrtModel, "1"));
+  RunOrtModel(test_info);
+}
+
 #if !defined(DISABLE_ML_OPS)
 // test that we can deserialize and run a previously saved ORT format model
 // for a model with sequence and map outputs
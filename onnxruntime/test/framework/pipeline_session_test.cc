@@ -0,0 +1,133 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include <algorithm>
+#include <sstream>
+
+#include "asserts.h"
+#include "core/graph/model.h"
+#include "core/session/inference_session.h"
+#include "core/session/pipeline_session.h"
+#include "gtest/gtest.h"
+#include "test/test_environment.h"
+#include "test/util/include/default_providers.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Loads a model computing output = op_type(input) with dynamic dims.
+void LoadUnaryModel(InferenceSession& session, const std::string& op_type, const std::string& input,
+                    const std::string& output) {
+  onnxruntime::Model model(op_type, false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& input_arg = graph.GetOrCreateNodeArg(input, &tensor_type);
+  auto& output_arg = graph.GetOrCreateNodeArg(output, &tensor_type);
+  graph.AddNode("node", op_type, op_type, {&input_arg}, {&output_arg});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  std::string serialized;
+  ASSERT_TRUE(model.ToProto().SerializeToString(&serialized));
+  std::stringstream model_stream(serialized);
+
+  ASSERT_STATUS_OK(session.RegisterExecutionProvider(DefaultCpuExecutionProvider()));
+  ASSERT_STATUS_OK(session.Load(model_stream));
+  ASSERT_STATUS_OK(session.Initialize());
+}
+
+OrtValue MakeFeed(std::vector<float>& data) {
+  OrtValue value;
+  Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape({static_cast<int64_t>(data.size())}),
+                       data.data(), OrtMemoryInfo(CPU, OrtDeviceAllocator), value);
+  return value;
+}
+
+}  // namespace
+
+TEST(PipelineSessionTest, MicroBatches) {
+  SessionOptions so;
+  InferenceSession relu_session{so, GetEnvironment()};
+  LoadUnaryModel(relu_session, "Relu", "X", "H");
+  InferenceSession neg_session{so, GetEnvironment()};
+  LoadUnaryModel(neg_session, "Neg", "X", "Y");
+
+  // the second stage takes its input X from the output H of the first one
+  std::vector<PipelineStage> stages(2);
+  stages[0].session = &relu_session;
+  stages[1].session = &neg_session;
+  stages[1].input_sources["X"] = "H";
+  PipelineSessionOptions options;
+  options.queue_capacity = 1;
+  PipelineSession pipeline(std::move(stages), options);
+
+  constexpr int kNumMicroBatches = 7;
+  std::vector<std::vector<float>> inputs(kNumMicroBatches);
+  std::vector<std::vector<OrtValue>> micro_batch_feeds(kNumMicroBatches);
+  for (int i = 0; i < kNumMicroBatches; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      inputs[i].push_back(static_cast<float>((j % 2 == 0 ? 1 : -1) * (i * 10 + j)));
+    }
+    micro_batch_feeds[i].push_back(MakeFeed(inputs[i]));
+  }
+
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y", "H"};
+  std::vector<std::vector<OrtValue>> fetches;
+  ASSERT_STATUS_OK(pipeline.Run(feed_names, micro_batch_feeds, output_names, fetches));
+
+  ASSERT_EQ(fetches.size(), static_cast<size_t>(kNumMicroBatches));
+  for (int i = 0; i < kNumMicroBatches; ++i) {
+    ASSERT_EQ(fetches[i].size(), 2u);
+    auto y = fetches[i][0].Get<Tensor>().DataAsSpan<float>();
+    auto h = fetches[i][1].Get<Tensor>().DataAsSpan<float>();
+    ASSERT_EQ(y.size(), inputs[i].size());
+    for (size_t j = 0; j < y.size(); ++j) {
+      EXPECT_EQ(h[j], std::max(inputs[i][j], 0.0f)) << "micro-batch " << i << " element " << j;
+      EXPECT_EQ(y[j], -std::max(inputs[i][j], 0.0f)) << "micro-batch " << i << " element " << j;
+    }
+  }
+}
+
+TEST(PipelineSessionTest, StageFailure) {
+  SessionOptions so;
+  InferenceSession relu_session{so, GetEnvironment()};
+  LoadUnaryModel(relu_session, "Relu", "X", "H");
+  InferenceSession neg_session{so, GetEnvironment()};
+  LoadUnaryModel(neg_session, "Neg", "Z", "Y");
+
+  // no value feeds the input Z of the second stage
+  std::vector<PipelineStage> stages(2);
+  stages[0].session = &relu_session;
+  stages[1].session = &neg_session;
+  PipelineSession pipeline(std::move(stages), PipelineSessionOptions{});
+
+  std::vector<float> input{1.0f, -2.0f};
+  std::vector<std::vector<OrtValue>> micro_batch_feeds(5);
+  for (auto& feeds : micro_batch_feeds) {
+    feeds.push_back(MakeFeed(input));
+  }
+  const std::vector<std::string> feed_names{"X"};
+  const std::vector<std::string> output_names{"Y"};
+  std::vector<std::vector<OrtValue>> fetches;
+  auto status = pipeline.Run(feed_names, micro_batch_feeds, output_names, fetches);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_NE(status.ErrorMessage().find("Pipeline stage 1 failed"), std::string::npos) << status.ErrorMessage();
+  EXPECT_TRUE(fetches.empty());
+
+  // an output that no stage produces
+  std::vector<PipelineStage> single_stage(1);
+  single_stage[0].session = &relu_session;
+  PipelineSession single_stage_pipeline(std::move(single_stage), PipelineSessionOptions{});
+  status = single_stage_pipeline.Run(feed_names, micro_batch_feeds, output_names, fetches);
+  ASSERT_FALSE(status.IsOK());
+  EXPECT_NE(status.ErrorMessage().find("Output Y is neither fed"), std::string::npos) << status.ErrorMessage();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
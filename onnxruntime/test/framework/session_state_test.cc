@@ -20,6 +20,7 @@
 #include "gtest/gtest.h"
 #include "test/test_environment.h"
 #include "test/util/include/default_providers.h"
+#include "test/util/include/temp_dir.h"
 #include "core/optimizer/transpose_optimizer/optimizer_utils.h"
 
 using namespace ONNX_NAMESPACE;
@@ -77,7 +78,7 @@ TEST_P(SessionStateAddGetKernelTest, AddGetKernelTest) {
   auto kernel_def = KernelDefBuilder().SetName("Variable").Provider(kCpuExecutionProvider).SinceVersion(1, 10).Build();
 
   OpKernelInfo p_info(node, *kernel_def, *cpu_execution_provider, s.GetConstantInitializedTensors(),
-                      s.GetOrtValueNameIdxMap(), s.GetDataTransferMgr());
+                      s.GetOrtValueNameIdxMap(), s.GetDataTransferMgr(), s.GetConfigOptions());
   unique_ptr<TestOpKernel> p_kernel;
   p_kernel.reset(new TestOpKernel(p_info));
   size_t orig_num_outputs = p_kernel->Node().OutputDefs().size();
@@ -287,6 +288,66 @@ TEST(SessionStateTest, TestInitializerMemoryAllocatedUsingNonArenaMemory) {
 
 INSTANTIATE_TEST_SUITE_P(SessionStateTests, SessionStateTestP, testing::ValuesIn(param_list));
 
+#ifndef ENABLE_TRAINING
+// Test the memory pattern cache is keyed by the bucketed input shapes and evicts the least recently used patterns.
+TEST(SessionStateTest, MemoryPatternCache) {
+  onnxruntime::Model model("graph_1", false, DefaultLoggingManager().DefaultLogger());
+  auto& graph = model.MainGraph();
+
+  TypeProto tensor_type;
+  tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  auto& input_arg = graph.GetOrCreateNodeArg("input", &tensor_type);
+  auto& output_arg = graph.GetOrCreateNodeArg("output", &tensor_type);
+  auto& node = graph.AddNode("node_1", "Relu", "node 1.", {&input_arg}, {&output_arg});
+  node.SetExecutionProviderType(kCpuExecutionProvider);
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo(false))));
+  KernelRegistryManager krm;
+  ASSERT_STATUS_OK(krm.RegisterKernels(execution_providers));
+
+  DataTransferManager dtm;
+  profiling::Profiler profiler;
+  SessionState session_state(graph, execution_providers, true, nullptr, nullptr, dtm,
+                             DefaultLoggingManager().DefaultLogger(), profiler);
+
+  SessionOptions so;
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMemoryPatternCacheSize, "2"));
+  ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsMemoryPatternDimBucketSize, "16"));
+  ASSERT_STATUS_OK(session_state.FinalizeSessionState(ORT_TSTR(""), krm, so));
+
+  std::vector<float> buffer(64);
+  OrtMemoryInfo mem_info(CPU, OrtDeviceAllocator);
+  auto make_feeds = [&](int64_t length) {
+    std::vector<OrtValue> feeds(1);
+    Tensor::InitOrtValue(DataTypeImpl::GetType<float>(), TensorShape({1, length}), buffer.data(), mem_info, feeds[0]);
+    return feeds;
+  };
+  const std::vector<int> feed_idxs{0};
+
+  ASSERT_EQ(session_state.GetMemoryPatternGroup(make_feeds(10), feed_idxs), nullptr);
+  ASSERT_STATUS_OK(session_state.UpdateMemoryPatternGroupCache(make_feeds(10), MemoryPatternGroup{}));
+  auto entry = session_state.GetMemoryPatternGroup(make_feeds(10), feed_idxs);
+  ASSERT_NE(entry, nullptr);
+
+  // Smaller inputs in the same bucket reuse the pattern, larger ones need a new one.
+  EXPECT_EQ(session_state.GetMemoryPatternGroup(make_feeds(8), feed_idxs), entry);
+  EXPECT_EQ(session_state.GetMemoryPatternGroup(make_feeds(12), feed_idxs), nullptr);
+
+  // A third bucket evicts the least recently used pattern.
+  ASSERT_STATUS_OK(session_state.UpdateMemoryPatternGroupCache(make_feeds(20), MemoryPatternGroup{}));
+  ASSERT_STATUS_OK(session_state.UpdateMemoryPatternGroupCache(make_feeds(40), MemoryPatternGroup{}));
+  EXPECT_EQ(session_state.GetMemoryPatternGroup(make_feeds(10), feed_idxs), nullptr);
+  EXPECT_NE(session_state.GetMemoryPatternGroup(make_feeds(20), feed_idxs), nullptr);
+  EXPECT_NE(session_state.GetMemoryPatternGroup(make_feeds(40), feed_idxs), nullptr);
+
+  // The evicted entry stays alive for its holders.
+  EXPECT_EQ(entry->input_dims.size(), 3u);
+}
+#endif
+
 #ifndef ENABLE_TRAINING
 class PrePackingTestOpKernel : public OpKernel {
  public:
@@ -327,8 +388,21 @@ class PrePackingTestOpKernel : public OpKernel {
     return Status::OK();
   }
 
+  Status UseCachedPrePackedBuffers(const Tensor& tensor, int input_idx,
+                                   std::vector<BufferUniquePtr>& prepacked_buffers,
+                                   /*out*/ bool& used_cached_buffers) override {
+    ORT_UNUSED_PARAMETER(tensor);
+    ORT_UNUSED_PARAMETER(input_idx);
+
+    weight_packed_ = std::move(prepacked_buffers[0]);
+    used_cached_buffers = true;
+    ++use_cached_pre_packed_weight_calls_count;
+    return Status::OK();
+  }
+
   int prepack_calls_count = 0;
   int store_pre_packed_weight_calls_count = 0;
+  int use_cached_pre_packed_weight_calls_count = 0;
   BufferUniquePtr weight_packed_;
 };
 
@@ -779,6 +853,58 @@ TEST_F(SessionStateTestSharedInitalizersWithPrePacking, test3) {
   ASSERT_EQ(session_state_2.GetUsedSharedPrePackedWeightCounter(), static_cast<size_t>(1));
 }
 
+// Pre-packing enabled + on-disk pre-packed weights cache = later sessions use the pre-packed weights from disk
+TEST_F(SessionStateTestSharedInitalizersWithPrePacking, DiskCache) {
+  TemporaryDirectory cache_dir(ORT_TSTR("prepacked_weights_disk_cache_test"));
+
+  SessionOptions sess_options;
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigDisablePrepacking] = "0";
+  sess_options.config_options.configurations[kOrtSessionOptionsConfigPrepackedWeightsCacheDir] =
+      ToUTF8String(cache_dir.Path());
+
+  for (int session = 0; session < 2; ++session) {
+    Model model("graph_main", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+                domain_to_version, std::vector<ONNX_NAMESPACE::FunctionProto>(),
+                DefaultLoggingManager().DefaultLogger());
+
+    CreateSimpleGraph(model.MainGraph());
+    PlaceAllNodesToCPUEP(model.MainGraph());
+    SessionState session_state(model.MainGraph(),
+                               execution_providers,
+                               true, /*enable_mem_pattern*/
+                               tp.get(),
+                               nullptr, /*inter_op_thread_pool*/
+                               dtm,
+                               DefaultLoggingManager().DefaultLogger(),
+                               profiler);
+
+    ASSERT_STATUS_OK(session_state.FinalizeSessionState(std::basic_string<PATH_CHAR_TYPE>(),
+                                                        kernel_registry_manager,
+                                                        sess_options));
+
+    const auto* kernel = reinterpret_cast<const PrePackingTestOpKernel*>(session_state.GetKernel(0));
+    ASSERT_EQ(session_state.GetNumberOfPrepacksCounter(), static_cast<size_t>(1));
+    if (session == 0) {
+      // The weight is pre-packed, saved to disk and handed back to the kernel
+      ASSERT_EQ(kernel->prepack_calls_count, 1);
+      ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 1);
+      ASSERT_EQ(kernel->use_cached_pre_packed_weight_calls_count, 0);
+      ASSERT_EQ(session_state.GetUsedDiskCachedPrePackedWeightCounter(), static_cast<size_t>(0));
+    } else {
+      // The weight is loaded from disk without calling PrePack()
+      ASSERT_EQ(kernel->prepack_calls_count, 0);
+      ASSERT_EQ(kernel->store_pre_packed_weight_calls_count, 0);
+      ASSERT_EQ(kernel->use_cached_pre_packed_weight_calls_count, 1);
+      ASSERT_EQ(session_state.GetUsedDiskCachedPrePackedWeightCounter(), static_cast<size_t>(1));
+    }
+
+    const float* data_weights_packed = reinterpret_cast<const float*>(kernel->weight_packed_.get());
+    ASSERT_NE(data_weights_packed, nullptr);
+    EXPECT_EQ(data_weights_packed[0], 1.2345f);
+    EXPECT_EQ(data_weights_packed[1], 1.2345f * 2.f);
+  }
+}
+
 INSTANTIATE_TEST_SUITE_P(SessionStateTests,
                          SessionStatePrepackingTest,
                          testing::Values(PrepackingTestParam{false, false},
@@ -3,6 +3,7 @@
 
 #include "core/framework/tensor.h"
 #include "core/framework/allocatormgr.h"
+#include "core/framework/TensorSeq.h"
 #include "test_utils.h"
 
 #include "gmock/gmock.h"
@@ -256,5 +257,27 @@ TEST(TensorTest, Strided) {
 }
 #endif
 
+TEST(TensorSeqTest, SharesTensors) {
+  auto alloc = TestCPUExecutionProvider()->GetAllocator(0, OrtMemTypeDefault);
+  TensorSeq seq(DataTypeImpl::GetType<float>());
+  seq.Add(Tensor(DataTypeImpl::GetType<float>(), TensorShape({2}), alloc));
+  seq.Add(Tensor(DataTypeImpl::GetType<float>(), TensorShape({3}), alloc));
+
+  // a sequence built from the tensors of another one holds the same tensors
+  TensorSeq other(seq.DataType());
+  other.Add(seq.GetShared(1));
+  other.Add(seq.GetShared(0));
+  ASSERT_EQ(other.Size(), 2u);
+  EXPECT_EQ(&other.Get(0), &seq.Get(1));
+  EXPECT_EQ(other.Get(1).DataRaw(), seq.Get(0).DataRaw());
+  EXPECT_EQ(seq.GetShared(0).use_count(), 2);
+
+  size_t num_elements = 0;
+  for (const Tensor& tensor : other) {
+    num_elements += static_cast<size_t>(tensor.Shape().Size());
+  }
+  EXPECT_EQ(num_elements, 5u);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
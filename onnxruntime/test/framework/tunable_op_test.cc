@@ -503,6 +503,89 @@ TEST(TunableOp, HandleInplaceUpdate) {
 #endif
 }
 
+struct VecAddParamsWithResults : public VecAddParamsRecordLastRun {
+  using VecAddParamsRecordLastRun::VecAddParamsRecordLastRun;
+
+  tunable::TuningResults* GetTuningResults() const override { return results; }
+
+  tunable::TuningResults* results{nullptr};
+};
+
+class TunableVecAddSelectFastWithResults : public TunableOp<VecAddParamsWithResults> {
+ public:
+  TunableVecAddSelectFastWithResults() {
+    this->ops_.emplace_back(SlowFull);
+    this->ops_.emplace_back(FastFull);
+  }
+};
+
+TEST(TunableOp, UseSharedResults) {
+#ifdef ORT_NO_RTTI
+  GTEST_SKIP() << "TunableOp needs RTTI to work correctly";
+#else
+  constexpr const int a = 7500000;
+  constexpr const int b = 42;
+  int c{};
+  VecAddParamsWithResults params(&a, &b, &c, 1, 0);
+  std::string last_run;
+  params.last_run = &last_run;
+  tunable::TuningResults results;
+  params.results = &results;
+
+  {
+    TunableVecAddSelectFastWithResults op{};
+    op.EnableTuning();
+    ASSERT_TRUE(op(&params).IsOK());
+    ASSERT_EQ(last_run, "FastFull");
+    ASSERT_TRUE(results.IsModified());
+  }
+
+  {
+    // Another instance uses the tuned op without tuning.
+    TunableVecAddSelectFastWithResults op{};
+    op.DisableTuning();
+    ASSERT_TRUE(op(&params).IsOK());
+    ASSERT_EQ(last_run, "FastFull");
+  }
+
+  {
+    // The default op is used for params that were not tuned.
+    params.num_elem = 2;
+    TunableVecAddSelectFastWithResults op{};
+    op.DisableTuning();
+    ASSERT_TRUE(op(&params).IsOK());
+    ASSERT_EQ(last_run, "SlowFull");
+  }
+#endif
+}
+
+TEST(TunableOp, SaveAndLoadResults) {
+  const std::string path = "tunable_op_test_results.txt";
+  const tunable::TuningResults::Validators validators{{"device", "test device"}, {"version", "1"}};
+
+  tunable::TuningResults results;
+  results.Add("op", "params_1", 1);
+  results.Add("op", "params_2", 2);
+  ASSERT_TRUE(results.Save(path, validators).IsOK());
+  ASSERT_FALSE(results.IsModified());
+
+  tunable::TuningResults loaded;
+  ASSERT_TRUE(loaded.Load(path, validators).IsOK());
+  ASSERT_EQ(loaded.Lookup("op", "params_1"), 1);
+  ASSERT_EQ(loaded.Lookup("op", "params_2"), 2);
+  ASSERT_EQ(loaded.Lookup("op", "params_3"), -1);
+  ASSERT_EQ(loaded.Lookup("other_op", "params_1"), -1);
+
+  // Results of another environment are not loaded.
+  tunable::TuningResults mismatched;
+  auto status = mismatched.Load(path, {{"device", "other device"}, {"version", "1"}});
+  ASSERT_FALSE(status.IsOK());
+  ASSERT_THAT(status.ErrorMessage(), testing::HasSubstr("does not match device other device"));
+  ASSERT_EQ(mismatched.Lookup("op", "params_1"), -1);
+
+  std::remove(path.c_str());
+}
+
 }  // namespace tuning
 }  // namespace test
 }  // namespace onnxruntime
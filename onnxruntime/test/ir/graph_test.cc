@@ -391,6 +391,46 @@ TEST_F(GraphTest, UnusedValueInfoSerializes) {
   EXPECT_TRUE(Model::Save(*model, "graph_with_unused_value_info.onnx").IsOK());
 }
 
+// The attributes are moved from the NodeProtos of the model into the nodes, which recreate the NodeProtos on save.
+TEST_F(GraphTest, NodeProtosReleasedOnLoad) {
+  ModelProto m;
+  m.set_ir_version(7);
+  ImportOpset(m, "", 13);
+  GraphProto& g = *m.mutable_graph();
+  NodeProto* node = g.add_node();
+  *node->add_input() = "x";
+  *node->add_output() = "y";
+  node->set_op_type("LeakyRelu");
+  node->set_name("leaky_relu");
+  AttributeProto* alpha = node->add_attribute();
+  alpha->set_name("alpha");
+  alpha->set_type(AttributeProto_AttributeType_FLOAT);
+  alpha->set_f(0.25f);
+  ValueInfoProto* input = g.add_input();
+  input->set_name("x");
+  SetTypeAndShape(input->mutable_type()->mutable_tensor_type(), 1, {2, 3});
+  ValueInfoProto* output = g.add_output();
+  output->set_name("y");
+  SetTypeAndShape(output->mutable_type()->mutable_tensor_type(), 1, {2, 3});
+
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(std::move(m), model, nullptr, *logger_));
+  Graph& graph = model->MainGraph();
+  ASSERT_EQ(graph.NumberOfNodes(), 1);
+  const auto& attributes = graph.Nodes().begin()->GetAttributes();
+  ASSERT_EQ(attributes.count("alpha"), 1u);
+  EXPECT_EQ(attributes.at("alpha").f(), 0.25f);
+
+  // the GraphProto is synced from the nodes even though Load resolved it with no_proto_sync_required
+  EXPECT_TRUE(graph.GraphProtoSyncNeeded());
+  const auto model_proto = model->ToProto();
+  ASSERT_EQ(model_proto.graph().node_size(), 1);
+  const auto& node_proto = model_proto.graph().node(0);
+  EXPECT_EQ(node_proto.name(), "leaky_relu");
+  ASSERT_EQ(node_proto.attribute_size(), 1);
+  EXPECT_EQ(node_proto.attribute(0).f(), 0.25f);
+}
+
 TEST_F(GraphTest, WrongOpset) {
   ModelProto m;
   m.set_ir_version(3);
@@ -0,0 +1,68 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <memory>
+#include <stdexcept>
+
+static const std::vector<std::string> pool_bench_arg_names = {"N", "C", "H", "W", "K", "P", "S", "Threads"};
+
+// 2D pooling of an NCHW input with a square kernel, the same padding on all sides and the same stride on both axes.
+void POOL2D(benchmark::State& state, MLAS_POOLING_KIND kind) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("C must greater than 0!");
+  if (state.range(4) <= 0) throw std::invalid_argument("K must greater than 0!");
+  if (state.range(5) < 0) throw std::invalid_argument("P must not be negative!");
+  if (state.range(6) <= 0) throw std::invalid_argument("S must greater than 0!");
+  if (state.range(7) <= 0) throw std::invalid_argument("Threads must greater than 0!");
+
+  const int64_t kernel = state.range(4);
+  const int64_t pad = state.range(5);
+  const int64_t stride = state.range(6);
+  const int64_t input_shape[] = {state.range(0), state.range(1), state.range(2), state.range(3)};
+  const int64_t kernel_shape[] = {kernel, kernel};
+  const int64_t padding[] = {pad, pad, pad, pad};
+  const int64_t stride_shape[] = {stride, stride};
+  const int64_t output_shape[] = {input_shape[0], input_shape[1],
+                                  (input_shape[2] + 2 * pad - kernel) / stride + 1,
+                                  (input_shape[3] + 2 * pad - kernel) / stride + 1};
+  if (output_shape[2] <= 0 || output_shape[3] <= 0) throw std::invalid_argument("Kernel must fit the input!");
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = static_cast<int>(state.range(7));
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  auto input = RandomVectorUniform(std::vector<int64_t>(std::begin(input_shape), std::end(input_shape)), -1.0f, 1.0f);
+  std::vector<float> output(static_cast<size_t>(output_shape[0] * output_shape[1] * output_shape[2] * output_shape[3]));
+
+  for (auto _ : state) {
+    MlasPool(kind, 2, input_shape, kernel_shape, padding, stride_shape, output_shape, input.data(), output.data(),
+             tp.get());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(input.size() * sizeof(float)));
+}
+
+static void ModelPool2d(benchmark::internal::Benchmark* b) {
+  b->ArgNames(pool_bench_arg_names);
+  for (int64_t threads : {1, 4}) {
+    //        N,    C,   H,   W, K, P, S, Threads
+    b->Args({1,   64, 112, 112, 3, 1, 2, threads});  // ResNet50 pool1
+    b->Args({1,  192,  56,  56, 3, 1, 2, threads});  // GoogleNet pool2
+    b->Args({1,  480,  28,  28, 3, 1, 2, threads});  // GoogleNet pool3
+    b->Args({1,  256,  56,  56, 2, 0, 2, threads});  // DenseNet121 transition1
+    b->Args({1, 2048,   7,   7, 7, 0, 1, threads});  // ResNet50 global pool
+    b->Args({1, 1280,   7,   7, 7, 0, 1, threads});  // MobileNetV2 global pool
+  }
+}
+
+BENCHMARK_CAPTURE(POOL2D, Maximum, MlasMaximumPooling)->Apply(ModelPool2d)->UseRealTime();
+BENCHMARK_CAPTURE(POOL2D, AverageExcludePad, MlasAveragePoolingExcludePad)->Apply(ModelPool2d)->UseRealTime();
+BENCHMARK_CAPTURE(POOL2D, AverageIncludePad, MlasAveragePoolingIncludePad)->Apply(ModelPool2d)->UseRealTime();
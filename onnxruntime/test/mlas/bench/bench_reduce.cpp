@@ -0,0 +1,48 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> reduce_bench_arg_names = {"M", "N"};
+
+// Reduces an M x N matrix to M outputs (rows) or N outputs (columns).
+void REDUCE(benchmark::State& state, MLAS_REDUCE_KIND kind, bool columns) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+
+  auto input = RandomVectorUniform(static_cast<size_t>(M * N), -1.0f, 1.0f);
+  std::vector<float> bias(columns ? N : M, 1.0f);
+  std::vector<float> output(columns ? N : M);
+
+  for (auto _ : state) {
+    if (columns) {
+      MlasReduceColumnsF32(kind, input.data(), N, M, N, bias.data(), output.data(), false);
+    } else {
+      MlasReduceRowsF32(kind, input.data(), N, M, N, bias.data(), output.data(), false);
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(M * N * sizeof(float)));
+}
+
+static void ReduceSizes(benchmark::internal::Benchmark* b) {
+  b->ArgNames(reduce_bench_arg_names);
+  ArgsProduct(b, {{1, 16, 256}, {15, 256, 4096}});
+}
+
+BENCHMARK_CAPTURE(REDUCE, Rows_Sum, MlasReduceSum, false)->Apply(ReduceSizes)->UseRealTime();
+BENCHMARK_CAPTURE(REDUCE, Rows_SumSquare, MlasReduceSumSquare, false)->Apply(ReduceSizes)->UseRealTime();
+BENCHMARK_CAPTURE(REDUCE, Rows_Maximum, MlasReduceMaximum, false)->Apply(ReduceSizes)->UseRealTime();
+BENCHMARK_CAPTURE(REDUCE, Rows_Minimum, MlasReduceMinimum, false)->Apply(ReduceSizes)->UseRealTime();
+BENCHMARK_CAPTURE(REDUCE, Rows_SumExp, MlasReduceSumExp, false)->Apply(ReduceSizes)->UseRealTime();
+
+BENCHMARK_CAPTURE(REDUCE, Columns_Sum, MlasReduceSum, true)->Apply(ReduceSizes)->UseRealTime();
+BENCHMARK_CAPTURE(REDUCE, Columns_SumSquare, MlasReduceSumSquare, true)->Apply(ReduceSizes)->UseRealTime();
+BENCHMARK_CAPTURE(REDUCE, Columns_Maximum, MlasReduceMaximum, true)->Apply(ReduceSizes)->UseRealTime();
+BENCHMARK_CAPTURE(REDUCE, Columns_Minimum, MlasReduceMinimum, true)->Apply(ReduceSizes)->UseRealTime();
+BENCHMARK_CAPTURE(REDUCE, Columns_SumExp, MlasReduceSumExp, true)->Apply(ReduceSizes)->UseRealTime();
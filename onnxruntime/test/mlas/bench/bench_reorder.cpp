@@ -0,0 +1,54 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> reorder_bench_arg_names = {"C", "H", "W"};
+
+// Reorders a 1xCxHxW tensor between the NCHW and the NCHWc layouts of the NCHWc convolutions.
+void REORDER_NCHWC(benchmark::State& state, bool to_nchwc) {
+  if (state.range(0) <= 0) throw std::invalid_argument("C must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("H must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("W must greater than 0!");
+
+  const size_t block_size = MlasNchwcGetBlockSize();
+  if (block_size <= 1) {
+    state.SkipWithError("The NCHWc layout is not supported on this platform.");
+    return;
+  }
+
+  const size_t channels = static_cast<size_t>(state.range(0));
+  const size_t spatial_size = static_cast<size_t>(state.range(1) * state.range(2));
+  const size_t nchwc_channels = (channels + block_size - 1) / block_size * block_size;
+  const int64_t output_shape[] = {1, state.range(0), state.range(1), state.range(2)};
+
+  auto nchw = RandomVectorUniform(channels * spatial_size, -1.0f, 1.0f);
+  auto nchwc = RandomVectorUniform(nchwc_channels * spatial_size, -1.0f, 1.0f);
+
+  for (auto _ : state) {
+    if (to_nchwc) {
+      MlasReorderInputNchw(nchw.data(), nchwc.data(), channels, spatial_size);
+    } else {
+      MlasReorderOutputNchw(output_shape, nchwc.data(), nchw.data());
+    }
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(channels * spatial_size * sizeof(float)));
+}
+
+static void ModelReorder(benchmark::internal::Benchmark* b) {
+  b->ArgNames(reorder_bench_arg_names);
+  //          C,   H,   W
+  b->Args({   3, 224, 224});  // ResNet50 input
+  b->Args({  64, 112, 112});  // ResNet50 conv1
+  b->Args({ 256,  56,  56});  // ResNet50 conv2
+  b->Args({2048,   7,   7});  // ResNet50 conv5
+  b->Args({  24,  48,  80});  // TeamsModel
+}
+
+BENCHMARK_CAPTURE(REORDER_NCHWC, NchwToNchwc, true)->Apply(ModelReorder)->UseRealTime();
+BENCHMARK_CAPTURE(REORDER_NCHWC, NchwcToNchw, false)->Apply(ModelReorder)->UseRealTime();
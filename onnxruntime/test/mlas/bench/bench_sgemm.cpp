@@ -106,6 +106,22 @@ static void GemmSizeProducts(benchmark::internal::Benchmark* b) {
   ArgsProduct(b, {{63, 255, 1023}, {63, 255, 1023}, {63, 255, 1023}});
 }
 
+// The GEMMs of the MatMul and Gemm nodes of BERT-base, GPT-2 and the classifier of ResNet50.
+static void GemmSizeFromModels(benchmark::internal::Benchmark* b) {
+  b->ArgNames(sgemm_bench_arg_names);
+  //         M,     N,    K
+  b->Args({128,   768,  768});  // BERT-base attention projection, sequence length 128
+  b->Args({128,  3072,  768});  // BERT-base FFN up projection, sequence length 128
+  b->Args({128,   768, 3072});  // BERT-base FFN down projection, sequence length 128
+  b->Args({384,  2304,  768});  // BERT-base fused QKV projection, sequence length 384
+  b->Args({128,   128,   64});  // BERT-base attention scores of one head
+  b->Args({128,    64,  128});  // BERT-base attention context of one head
+  b->Args({1,    2304,  768});  // GPT-2 fused QKV projection of one new token
+  b->Args({1,    3072,  768});  // GPT-2 FFN up projection of one new token
+  b->Args({1,   50257,  768});  // GPT-2 LM head of one new token
+  b->Args({1,    1000, 2048});  // ResNet50 classifier
+}
+
 BENCHMARK_CAPTURE(SGEMM, NORMAL_NoTrans, false, false, false)->Apply(GemmSizeProducts)->UseRealTime();
 BENCHMARK_CAPTURE(SGEMM, NORMAL_TransA, false, true, false)->Apply(GemmSizeProducts)->UseRealTime();
 BENCHMARK_CAPTURE(SGEMM, NORMAL_TransB, false, false, true)->Apply(GemmSizeProducts)->UseRealTime();
@@ -118,3 +134,7 @@ BENCHMARK_CAPTURE(SGEMM, GEMV_ABTrans, false, true, true)->Apply(GemmSizeWithOne
 
 BENCHMARK_CAPTURE(SGEMM, PACKB_NoTransA, true, false, false)->Apply(GemmSizeProducts)->UseRealTime();
 BENCHMARK_CAPTURE(SGEMM, PACKB_TransA, true, true, false)->Apply(GemmSizeProducts)->UseRealTime();
+
+BENCHMARK_CAPTURE(SGEMM, MODELS_NoTrans, false, false, false)->Apply(GemmSizeFromModels)->UseRealTime();
+BENCHMARK_CAPTURE(SGEMM, MODELS_TransB, false, false, true)->Apply(GemmSizeFromModels)->UseRealTime();
+BENCHMARK_CAPTURE(SGEMM, MODELS_PACKB, true, false, false)->Apply(GemmSizeFromModels)->UseRealTime();
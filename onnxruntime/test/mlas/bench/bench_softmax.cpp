@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+#include "core/util/thread_utils.h"
+
+#include <memory>
+#include <stdexcept>
+
+static const std::vector<std::string> softmax_bench_arg_names = {"N", "D", "Threads"};
+
+// Softmax of N rows of D elements each.
+void SOFTMAX(benchmark::State& state, bool log_softmax) {
+  if (state.range(0) <= 0) throw std::invalid_argument("N must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("D must greater than 0!");
+  if (state.range(2) <= 0) throw std::invalid_argument("Threads must greater than 0!");
+  const size_t N = static_cast<size_t>(state.range(0));
+  const size_t D = static_cast<size_t>(state.range(1));
+
+  OrtThreadPoolParams tpo;
+  tpo.thread_pool_size = static_cast<int>(state.range(2));
+  tpo.auto_set_affinity = true;
+  std::unique_ptr<onnxruntime::concurrency::ThreadPool> tp(
+      onnxruntime::concurrency::CreateThreadPool(&onnxruntime::Env::Default(),
+                                                 tpo, onnxruntime::concurrency::ThreadPoolType::INTRA_OP));
+
+  auto input = RandomVectorUniform(static_cast<size_t>(N * D), -10.0f, 10.0f);
+  std::vector<float> output(N * D);
+
+  for (auto _ : state) {
+    MlasComputeSoftmax(input.data(), output.data(), N, D, log_softmax, tp.get());
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(N * D * sizeof(float)));
+}
+
+static void ModelSoftmax(benchmark::internal::Benchmark* b) {
+  b->ArgNames(softmax_bench_arg_names);
+  for (int64_t threads : {1, 4}) {
+    //          N,     D, Threads
+    b->Args({12 * 128,   128, threads});  // BERT-base attention probabilities, sequence length 128
+    b->Args({12 * 384,   384, threads});  // BERT-base attention probabilities, sequence length 384
+    b->Args({12,         512, threads});  // GPT-2 attention probabilities, one new token of 512
+    b->Args({1,        50257, threads});  // GPT-2 next token probabilities
+    b->Args({1,         1000, threads});  // ImageNet classifier
+  }
+}
+
+BENCHMARK_CAPTURE(SOFTMAX, Softmax, false)->Apply(ModelSoftmax)->UseRealTime();
+BENCHMARK_CAPTURE(SOFTMAX, LogSoftmax, true)->Apply(ModelSoftmax)->UseRealTime();
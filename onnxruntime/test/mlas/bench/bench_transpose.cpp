@@ -0,0 +1,45 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "mlas.h"
+#include "bench_util.h"
+
+#include <stdexcept>
+
+static const std::vector<std::string> transpose_bench_arg_names = {"M", "N"};
+
+// Transposes an M x N matrix.
+template <typename ElementType>
+void TRANSPOSE(benchmark::State& state) {
+  if (state.range(0) <= 0) throw std::invalid_argument("M must greater than 0!");
+  if (state.range(1) <= 0) throw std::invalid_argument("N must greater than 0!");
+  const size_t M = static_cast<size_t>(state.range(0));
+  const size_t N = static_cast<size_t>(state.range(1));
+
+  std::vector<ElementType> input(M * N);
+  for (size_t i = 0; i < input.size(); i++) {
+    input[i] = static_cast<ElementType>(i);
+  }
+  std::vector<ElementType> output(M * N);
+
+  for (auto _ : state) {
+    MlasTranspose(input.data(), output.data(), M, N);
+  }
+
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          static_cast<int64_t>(M * N * sizeof(ElementType)));
+}
+
+static void ModelTranspose(benchmark::internal::Benchmark* b) {
+  b->ArgNames(transpose_bench_arg_names);
+  //         M,    N
+  b->Args({128,  768});  // BERT-base hidden states, sequence length 128
+  b->Args({384,  768});  // BERT-base hidden states, sequence length 384
+  b->Args({128,   64});  // BERT-base key of one head
+  b->Args({768, 3072});  // BERT-base FFN weight
+  b->Args({3136,  64});  // ResNet50 NCHW to NHWC, 56x56x64
+  b->Args({49,  2048});  // ResNet50 NHWC to NCHW, 7x7x2048
+}
+
+BENCHMARK_TEMPLATE(TRANSPOSE, float)->Apply(ModelTranspose)->UseRealTime();
+BENCHMARK_TEMPLATE(TRANSPOSE, uint8_t)->Apply(ModelTranspose)->UseRealTime();
@@ -90,6 +90,48 @@ class MlasActivationTest : public MlasTestBase {
             << std::setw(8) << std::setfill('0') <<std::hex << TestData[i][kind].u;
       }
     }
+
+    //
+    // Test the GELU activations against a double precision reference, with a
+    // bias and a row stride that exercise the partial blocks.
+    //
+
+    for (MLAS_ACTIVATION_KIND kind : {MlasGeluActivation, MlasFastGeluActivation}) {
+      Activation.ActivationKind = kind;
+
+      for (size_t N : {1, 3, 4, 17, 256, 259, 600}) {
+        const size_t M = 3;
+        const size_t ldc = N + 5;
+        std::vector<float> Values(M * ldc);
+        std::vector<float> Bias(M);
+
+        for (size_t i = 0; i < Values.size(); i++) {
+          Values[i] = -8.0f + 16.0f * float(i) / float(Values.size());
+        }
+        for (size_t m = 0; m < M; m++) {
+          Bias[m] = 0.5f * float(m) - 0.5f;
+        }
+
+        std::vector<float> Output(Values);
+        MlasActivation(&Activation, Output.data(), Bias.data(), M, N, ldc);
+
+        for (size_t m = 0; m < M; m++) {
+          for (size_t n = 0; n < ldc; n++) {
+            const size_t i = m * ldc + n;
+            if (n >= N) {
+              ASSERT_EQ(Output[i], Values[i]) << "kind " << kind << " wrote past N @" << i;
+              continue;
+            }
+            const double x = double(Values[i]) + double(Bias[m]);
+            const double Expected = (kind == MlasGeluActivation)
+                                        ? 0.5 * x * (1.0 + std::erf(x * 0.70710678118654752440))
+                                        : 0.5 * x * (1.0 + std::tanh(0.7978845608028654 * (x + 0.044715 * x * x * x)));
+            EXPECT_NEAR(Output[i], Expected, 2e-6 * std::max(1.0, std::fabs(Expected)))
+                << "kind " << kind << ", N=" << N << ", x=" << x;
+          }
+        }
+      }
+    }
   }
 };
 
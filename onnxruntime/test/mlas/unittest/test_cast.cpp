@@ -0,0 +1,168 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+//
+// Tests the conversions between single precision and the 16-bit floating point
+// formats. The widening conversions are checked for every 16-bit pattern. The
+// narrowing conversions are checked for every representable value and for the
+// values around the midpoint between each pair of neighbors, which covers the
+// round to nearest even behavior.
+//
+
+template <bool IsBf16>
+class MlasCastTest : public MlasTestBase {
+ private:
+  static constexpr int MantissaBits = IsBf16 ? 7 : 10;
+  static constexpr int ExponentBias = IsBf16 ? 127 : 15;
+  static constexpr uint16_t ExponentMask = IsBf16 ? 0x7F80 : 0x7C00;
+
+  MatrixGuardBuffer<uint16_t> BufferHalf;
+  MatrixGuardBuffer<uint16_t> BufferHalfOutput;
+  MatrixGuardBuffer<float> BufferFloat;
+
+  static float ReferenceToFloat(uint16_t Value) {
+    const uint32_t Exponent = (Value & ExponentMask) >> MantissaBits;
+    const uint32_t Mantissa = Value & ((1u << MantissaBits) - 1);
+    float Magnitude;
+
+    if (Exponent == (ExponentMask >> MantissaBits)) {
+      Magnitude = (Mantissa == 0) ? std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+    } else if (Exponent == 0) {
+      Magnitude = std::ldexp(float(Mantissa), 1 - ExponentBias - MantissaBits);
+    } else {
+      Magnitude = std::ldexp(float(Mantissa + (1u << MantissaBits)), int(Exponent) - ExponentBias - MantissaBits);
+    }
+
+    return (Value & 0x8000) ? -Magnitude : Magnitude;
+  }
+
+  static void ConvertToFloat(const uint16_t* Source, float* Destination, size_t Count) {
+    if (IsBf16) {
+      MlasConvertBFloat16ToFloatBuffer(Source, Destination, Count);
+    } else {
+      MlasConvertHalfToFloatBuffer(Source, Destination, Count);
+    }
+  }
+
+  static void ConvertFromFloat(const float* Source, uint16_t* Destination, size_t Count) {
+    if (IsBf16) {
+      MlasConvertFloatToBFloat16Buffer(Source, Destination, Count);
+    } else {
+      MlasConvertFloatToHalfBuffer(Source, Destination, Count);
+    }
+  }
+
+  void TestToFloat(size_t Count) {
+    uint16_t* Input = BufferHalf.GetBuffer(65536);
+    float* Output = BufferFloat.GetBuffer(65536);
+
+    for (size_t i = 0; i < 65536; i++) {
+      Input[i] = uint16_t(i);
+    }
+
+    for (size_t start = 0; start < 65536; start += Count) {
+      ConvertToFloat(Input + start, Output + start, std::min(Count, 65536 - start));
+    }
+
+    for (size_t i = 0; i < 65536; i++) {
+      const float Expected = ReferenceToFloat(uint16_t(i));
+      if (std::isnan(Expected)) {
+        ASSERT_TRUE(std::isnan(Output[i])) << "@" << i;
+      } else {
+        ASSERT_EQ(Output[i], Expected) << "@" << i << ", count " << Count;
+      }
+    }
+  }
+
+  void TestFromFloat(size_t Count) {
+    //
+    // Build the test values from the non-negative finite values of the 16-bit
+    // format, including the largest value so that the values above it round to
+    // infinity.
+    //
+
+    std::vector<float> Values;
+    std::vector<uint16_t> Expected;
+
+    const uint16_t Infinity = ExponentMask;
+
+    for (uint16_t h = 0; h < Infinity; h++) {
+      const float Value = ReferenceToFloat(h);
+
+      // The neighbor of the largest finite value is the next power of two,
+      // which is where the 16-bit format overflows.
+      const double NextValue = (h + 1 == Infinity) ? 2.0 * Value - ReferenceToFloat(uint16_t(h - 1))
+                                                   : ReferenceToFloat(uint16_t(h + 1));
+      const float Midpoint = float((double(Value) + NextValue) / 2.0);
+      const uint16_t Even = (h & 1) ? uint16_t(h + 1) : h;
+
+      Values.push_back(Value);
+      Expected.push_back(h);
+      Values.push_back(std::nextafter(Midpoint, 0.0f));
+      Expected.push_back(h);
+      Values.push_back(Midpoint);
+      Expected.push_back(Even);
+      Values.push_back(std::nextafter(Midpoint, std::numeric_limits<float>::infinity()));
+      Expected.push_back(uint16_t(h + 1));
+    }
+
+    Values.push_back(std::numeric_limits<float>::infinity());
+    Expected.push_back(Infinity);
+    Values.push_back(std::numeric_limits<float>::max());
+    Expected.push_back(Infinity);
+
+    const size_t PositiveCount = Values.size();
+
+    for (size_t i = 0; i < PositiveCount; i++) {
+      Values.push_back(-Values[i]);
+      Expected.push_back(uint16_t(Expected[i] | 0x8000));
+    }
+
+    Values.push_back(std::numeric_limits<float>::quiet_NaN());
+    Expected.push_back(0);
+
+    const size_t N = Values.size();
+    float* Input = BufferFloat.GetBuffer(N);
+    uint16_t* Output = BufferHalfOutput.GetBuffer(N);
+
+    std::copy(Values.begin(), Values.end(), Input);
+
+    for (size_t start = 0; start < N; start += Count) {
+      ConvertFromFloat(Input + start, Output + start, std::min(Count, N - start));
+    }
+
+    for (size_t i = 0; i < N - 1; i++) {
+      ASSERT_EQ(Output[i], Expected[i]) << "@" << i << " value " << Input[i] << ", count " << Count;
+    }
+
+    const uint16_t NaNResult = Output[N - 1];
+    ASSERT_TRUE((NaNResult & ExponentMask) == ExponentMask && (NaNResult & ~(ExponentMask | 0x8000)) != 0);
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(IsBf16 ? "CastBFloat16" : "CastHalf");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t Count : {1, 7, 8, 15, 16, 23, 33, 1024}) {
+      TestToFloat(Count);
+      TestFromFloat(Count);
+    }
+  }
+};
+
+template <> MlasCastTest<false>* MlasTestFixture<MlasCastTest<false>>::mlas_tester(nullptr);
+template <> MlasCastTest<true>* MlasTestFixture<MlasCastTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasCastTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasCastTest<true>>::RegisterShortExecute();
+  }
+  return count;
+});
@@ -0,0 +1,122 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_conv2d.h"
+
+//
+// Winograd convolution does not produce bit exact results, so the output is
+// compared to the reference convolution with a tolerance.
+//
+
+template <bool Threaded>
+class MlasConv2DWinogradTest : public MlasConv2DTest<Threaded> {
+ private:
+  MatrixGuardBuffer<float> BufferPackedFilter;
+
+  void TestWinograd(size_t TileSize,
+                    size_t BatchCount,
+                    size_t GroupCount,
+                    size_t InputChannels,
+                    size_t InputHeight,
+                    size_t InputWidth,
+                    size_t FilterCount,
+                    size_t Padding) {
+    const size_t OutputHeight = InputHeight + 2 * Padding - 2;
+    const size_t OutputWidth = InputWidth + 2 * Padding - 2;
+
+    const size_t InputElements = BatchCount * GroupCount * InputChannels * InputHeight * InputWidth;
+    const size_t FilterElements = GroupCount * FilterCount * InputChannels * 9;
+    const size_t OutputElements = BatchCount * GroupCount * FilterCount * OutputHeight * OutputWidth;
+
+    const float* Input = this->BufferInput.GetBuffer(InputElements);
+    const float* Filter = this->BufferFilter.GetBuffer(FilterElements);
+    const float* Bias = this->BufferBias.GetBuffer(GroupCount * FilterCount);
+    float* Output = this->BufferOutput.GetBuffer(OutputElements);
+    float* OutputReference = this->BufferOutputReference.GetBuffer(OutputElements);
+
+    float* PackedFilter = BufferPackedFilter.GetBuffer(
+        MlasConvWinogradPackedFilterSize(TileSize, GroupCount, FilterCount, InputChannels));
+    MlasConvWinogradPackFilter(TileSize, GroupCount, FilterCount, InputChannels, Filter, PackedFilter);
+
+    int64_t InputShape[] = {int64_t(InputHeight), int64_t(InputWidth)};
+    int64_t KernelShape[] = {3, 3};
+    int64_t DilationShape[] = {1, 1};
+    int64_t Pads[] = {int64_t(Padding), int64_t(Padding), int64_t(Padding), int64_t(Padding)};
+    int64_t StrideShape[] = {1, 1};
+    int64_t OutputShape[] = {int64_t(OutputHeight), int64_t(OutputWidth)};
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = MlasIdentityActivation;
+
+    MLAS_CONV_PARAMETERS Parameters;
+    size_t WorkingBufferSize;
+
+    MlasConvPrepare(&Parameters, 2, BatchCount, GroupCount, InputChannels, InputShape, KernelShape,
+                    DilationShape, Pads, StrideShape, OutputShape, FilterCount, &Activation,
+                    &WorkingBufferSize, 0.0f, this->threadpool_);
+
+    ASSERT_TRUE(MlasConvPrepareWinograd(&Parameters, TileSize, PackedFilter, &WorkingBufferSize,
+                                        this->threadpool_));
+
+    MlasConv(&Parameters, Input, Filter, Bias, this->BufferWorking.GetBuffer(WorkingBufferSize), Output,
+             this->threadpool_);
+
+    this->ReferenceConv2D(BatchCount, GroupCount, InputChannels, InputHeight, InputWidth, FilterCount, 3, 3,
+                          Padding, Padding, 1, 1, 1, 1, OutputHeight, OutputWidth, Input, Filter, Bias,
+                          OutputReference);
+
+    //
+    // The rounding error of the transforms grows with the magnitude of the
+    // products accumulated for an output, bounded by the buffer fill values.
+    //
+
+    const float MaximumFillValue = 23.0f;
+    const float Tolerance = 1e-6f * float(InputChannels * 9) * MaximumFillValue * MaximumFillValue;
+
+    for (size_t n = 0; n < OutputElements; n++) {
+      ASSERT_NEAR(Output[n], OutputReference[n], Tolerance)
+          << "@" << n << " of " << OutputElements << ", "
+          << "T" << TileSize << "/"
+          << "B" << BatchCount << "/"
+          << "G" << GroupCount << "/"
+          << "Cpg" << InputChannels << "/"
+          << "Fpg" << FilterCount << "/"
+          << "H" << InputHeight << "/"
+          << "W" << InputWidth << "/"
+          << "Pad" << Padding;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "Conv2dWinograd_Threaded" : "Conv2dWinograd_SingleThread");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t TileSize : {2, 4}) {
+      for (size_t Padding = 0; Padding < 2; Padding++) {
+        TestWinograd(TileSize, 1, 1, 8, 6, 6, 8, Padding);
+        TestWinograd(TileSize, 1, 1, 16, 11, 9, 24, Padding);
+        TestWinograd(TileSize, 2, 1, 32, 13, 17, 40, Padding);
+        TestWinograd(TileSize, 1, 2, 24, 15, 15, 16, Padding);
+        TestWinograd(TileSize, 3, 3, 8, 7, 30, 8, Padding);
+        TestWinograd(TileSize, 1, 1, 64, 56, 56, 64, Padding);
+      }
+    }
+  }
+};
+
+template <> MlasConv2DWinogradTest<false>* MlasTestFixture<MlasConv2DWinogradTest<false>>::mlas_tester(nullptr);
+template <> MlasConv2DWinogradTest<true>* MlasTestFixture<MlasConv2DWinogradTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasConv2DWinogradTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
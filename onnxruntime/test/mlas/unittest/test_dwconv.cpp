@@ -0,0 +1,104 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasDepthwiseConvFloatTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferFilter;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<const float*> BufferIndirection;
+
+  void Test(size_t InputHeight,
+            size_t InputWidth,
+            size_t Channels,
+            size_t KernelHeight,
+            size_t KernelWidth,
+            size_t Padding,
+            size_t Stride,
+            bool UseBias,
+            MLAS_ACTIVATION_KIND ActivationKind) {
+    const size_t OutputHeight = (InputHeight + 2 * Padding - KernelHeight) / Stride + 1;
+    const size_t OutputWidth = (InputWidth + 2 * Padding - KernelWidth) / Stride + 1;
+    const size_t OutputCount = OutputHeight * OutputWidth;
+    const size_t KernelSize = KernelHeight * KernelWidth;
+
+    const float* Input = BufferInput.GetBuffer(InputHeight * InputWidth * Channels);
+    const float* Filter = BufferFilter.GetBuffer(KernelSize * Channels);
+    const float* Bias = UseBias ? BufferBias.GetBuffer(Channels) : nullptr;
+    float* Output = BufferOutput.GetBuffer(OutputCount * Channels);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputCount * Channels);
+    const float** Indirection = BufferIndirection.GetBuffer(OutputCount * KernelSize);
+    std::vector<float> PaddingRow(Channels, 0.0f);
+
+    for (size_t oh = 0; oh < OutputHeight; oh++) {
+      for (size_t ow = 0; ow < OutputWidth; ow++) {
+        for (size_t kh = 0; kh < KernelHeight; kh++) {
+          for (size_t kw = 0; kw < KernelWidth; kw++) {
+            const size_t ih = oh * Stride + kh - Padding;
+            const size_t iw = ow * Stride + kw - Padding;
+            const float* Pixel = PaddingRow.data();
+            if (ih < InputHeight && iw < InputWidth) {
+              Pixel = Input + (ih * InputWidth + iw) * Channels;
+            }
+            *Indirection++ = Pixel;
+          }
+        }
+      }
+    }
+    Indirection -= OutputCount * KernelSize;
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = ActivationKind;
+    Activation.Parameters.Values[0] = (ActivationKind == MlasClipActivation) ? -40.0f : 0.25f;
+    Activation.Parameters.Values[1] = (ActivationKind == MlasClipActivation) ? 60.0f : 0.5f;
+
+    for (size_t n = 0; n < OutputCount; n++) {
+      for (size_t c = 0; c < Channels; c++) {
+        float Accumulator = UseBias ? Bias[c] : 0.0f;
+        for (size_t k = 0; k < KernelSize; k++) {
+          Accumulator += Indirection[n * KernelSize + k][c] * Filter[k * Channels + c];
+        }
+        OutputReference[n * Channels + c] = Accumulator;
+      }
+    }
+    MlasActivation(&Activation, OutputReference, nullptr, OutputCount, Channels, Channels);
+
+    MlasConvDepthwise(Indirection, Filter, Bias, Output, Channels, OutputCount, KernelSize, &Activation);
+
+    for (size_t n = 0; n < OutputCount * Channels; n++) {
+      ASSERT_NEAR(Output[n], OutputReference[n], std::fabs(OutputReference[n]) * 1e-6f)
+          << "@" << n << " of " << OutputCount * Channels << ", "
+          << "H" << InputHeight << "/W" << InputWidth << "/C" << Channels << "/K" << KernelHeight << "x"
+          << KernelWidth << "/Pad" << Padding << "/S" << Stride << "/Bias" << UseBias << "/Act" << ActivationKind;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("DepthwiseConvFloat");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t Channels : {1, 3, 4, 8, 12, 19, 32, 67}) {
+      for (size_t Kernel : {3, 5}) {
+        Test(9, 11, Channels, Kernel, Kernel, Kernel / 2, 1, true, MlasIdentityActivation);
+        Test(9, 11, Channels, Kernel, Kernel, Kernel / 2, 2, false, MlasReluActivation);
+        Test(7, 6, Channels, Kernel, Kernel, 0, 1, true, MlasClipActivation);
+      }
+      Test(8, 8, Channels, 2, 3, 1, 1, true, MlasLeakyReluActivation);
+      Test(8, 8, Channels, 7, 1, 3, 1, true, MlasHardSigmoidActivation);
+    }
+  }
+};
+
+template <>
+MlasDepthwiseConvFloatTest* MlasTestFixture<MlasDepthwiseConvFloatTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasDepthwiseConvFloatTest>::RegisterShortExecute() : 0;
+});
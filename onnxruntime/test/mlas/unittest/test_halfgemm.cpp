@@ -0,0 +1,141 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+//
+// Reference conversion from single precision to the 16-bit formats. The test
+// values are exactly representable in both formats and accumulate without
+// rounding, so the results must match bit for bit.
+//
+
+static uint16_t
+ReferenceFloatToHalf(float Value, bool IsBf16) {
+  uint32_t Bits;
+  memcpy(&Bits, &Value, sizeof(Bits));
+
+  if (IsBf16) {
+    Bits += 0x7FFF + ((Bits >> 16) & 1);
+    return uint16_t(Bits >> 16);
+  }
+
+  if ((Bits & 0x7FFFFFFF) == 0) {
+    return uint16_t((Bits >> 16) & 0x8000);
+  }
+
+  // Test values stay within the normal range of fp16.
+  const uint32_t Sign = (Bits >> 16) & 0x8000;
+  Bits += 0xFFF + ((Bits >> 13) & 1);
+  const uint32_t Exponent = ((Bits >> 23) & 0xFF) - 127 + 15;
+  const uint32_t Mantissa = (Bits >> 13) & 0x3FF;
+
+  return uint16_t(Sign | (Exponent << 10) | Mantissa);
+}
+
+template <bool IsBf16>
+class MlasHalfGemmTest : public MlasTestBase {
+ private:
+  std::vector<uint16_t> BufferA;
+  std::vector<uint16_t> BufferB;
+  std::vector<uint16_t> BufferC;
+  std::vector<uint16_t> BufferCReference;
+  std::vector<float> FloatA;
+  std::vector<float> FloatB;
+
+  void FillBuffer(std::vector<float>& Values, std::vector<uint16_t>& Packed, size_t Count, int Seed) {
+    Values.resize(Count);
+    Packed.resize(Count);
+
+    for (size_t i = 0; i < Count; i++) {
+      // Multiples of 0.25 in the range [-2, 2].
+      const float Value = float(int((i * 7 + Seed * 13) % 17) - 8) * 0.25f;
+      Values[i] = Value;
+      Packed[i] = ReferenceFloatToHalf(Value, IsBf16);
+    }
+  }
+
+  void Test(size_t BatchSize, size_t M, size_t N, size_t K) {
+    FillBuffer(FloatA, BufferA, BatchSize * M * K, 1);
+    FillBuffer(FloatB, BufferB, BatchSize * K * N, 2);
+
+    BufferC.assign(BatchSize * M * N, uint16_t(0xFFFF));
+    BufferCReference.resize(BatchSize * M * N);
+
+    std::vector<MLAS_HALF_GEMM_DATA_PARAMS> Data(BatchSize);
+
+    for (size_t b = 0; b < BatchSize; b++) {
+      Data[b].A = BufferA.data() + b * M * K;
+      Data[b].lda = K;
+      Data[b].B = BufferB.data() + b * K * N;
+      Data[b].ldb = N;
+      Data[b].C = BufferC.data() + b * M * N;
+      Data[b].ldc = N;
+
+      for (size_t m = 0; m < M; m++) {
+        for (size_t n = 0; n < N; n++) {
+          float Sum = 0.0f;
+          for (size_t k = 0; k < K; k++) {
+            Sum += FloatA[b * M * K + m * K + k] * FloatB[b * K * N + k * N + n];
+          }
+          BufferCReference[b * M * N + m * N + n] = ReferenceFloatToHalf(Sum, IsBf16);
+        }
+      }
+    }
+
+    if (IsBf16) {
+      MlasBf16GemmBatch(M, N, K, Data.data(), BatchSize, GetMlasThreadPool());
+    } else {
+      MlasHalfGemmBatch(M, N, K, Data.data(), BatchSize, GetMlasThreadPool());
+    }
+
+    for (size_t i = 0; i < BatchSize * M * N; i++) {
+      ASSERT_EQ(BufferC[i], BufferCReference[i])
+          << " @" << i << " Batch=" << BatchSize << " M=" << M << " N=" << N << " K=" << K;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(IsBf16 ? "Bf16Gemm" : "HalfGemm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t m = 1; m <= 9; m++) {
+      for (size_t n = 1; n <= 40; n++) {
+        for (size_t k = 1; k <= 9; k++) {
+          Test(1, m, n, k);
+        }
+      }
+    }
+    Test(1, 1, 129, 33);
+    Test(1, 17, 200, 64);
+    Test(3, 16, 48, 31);
+    Test(2, 35, 160, 200);
+  }
+
+  void ExecuteLong(void) override {
+    for (size_t m = 1; m <= 40; m += 3) {
+      for (size_t n = 1; n <= 300; n += 13) {
+        for (size_t k = 1; k <= 256; k += 11) {
+          Test(1, m, n, k);
+        }
+      }
+    }
+  }
+};
+
+template <> MlasHalfGemmTest<false>* MlasTestFixture<MlasHalfGemmTest<false>>::mlas_tester(nullptr);
+template <> MlasHalfGemmTest<true>* MlasTestFixture<MlasHalfGemmTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasHalfGemmTest<false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasHalfGemmTest<true>>::RegisterShortExecute();
+  } else {
+    count += MlasLongExecuteTests<MlasHalfGemmTest<false>>::RegisterLongExecute();
+    count += MlasLongExecuteTests<MlasHalfGemmTest<true>>::RegisterLongExecute();
+  }
+  return count;
+});
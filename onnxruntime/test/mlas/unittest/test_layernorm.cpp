@@ -0,0 +1,177 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Threaded>
+class MlasLayerNormTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferSkip;
+  MatrixGuardBuffer<float> BufferVectors;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+  MatrixGuardBuffer<float> BufferSkipOutput;
+  MatrixGuardBuffer<float> BufferStatistics;
+  MatrixGuardBuffer<uint8_t> BufferQuantizedOutput;
+  MLAS_THREADPOOL* threadpool_;
+
+  enum : unsigned {
+    WithSkip = 1,
+    WithBias = 2,
+    WithShift = 4,
+    Simplified = 8,
+  };
+
+  static void ReferenceLayerNorm(const float* Input, const MLAS_LAYERNORM_PARAMETERS& Parameters, float* Output,
+                                 float* SkipOutput, float* Mean, float* InvStdDev, size_t N, size_t D) {
+    std::vector<double> X(D);
+
+    for (size_t n = 0; n < N; n++) {
+      double Sum = 0.0;
+      for (size_t d = 0; d < D; d++) {
+        float x = Input[n * D + d];
+        if (Parameters.Skip != nullptr) {
+          x += Parameters.Skip[n * D + d];
+          SkipOutput[n * D + d] = x;
+        }
+        if (Parameters.Bias != nullptr) {
+          x += Parameters.Bias[d];
+        }
+        X[d] = x;
+        Sum += x;
+      }
+
+      const double RowMean = Parameters.Simplified ? 0.0 : Sum / D;
+      double SumSquares = 0.0;
+      for (size_t d = 0; d < D; d++) {
+        SumSquares += (X[d] - RowMean) * (X[d] - RowMean);
+      }
+
+      const double RowInvStdDev = 1.0 / std::sqrt(SumSquares / D + Parameters.Epsilon);
+      Mean[n] = float(RowMean);
+      InvStdDev[n] = float(RowInvStdDev);
+
+      for (size_t d = 0; d < D; d++) {
+        double y = (X[d] - RowMean) * RowInvStdDev * Parameters.Scale[d];
+        if (Parameters.Shift != nullptr) {
+          y += Parameters.Shift[d];
+        }
+        Output[n * D + d] = float(y);
+      }
+    }
+  }
+
+  void Test(size_t N, size_t D, unsigned Flags, float Offset, float Tolerance) {
+    float* Input = BufferInput.GetBuffer(N * D);
+    float* Skip = BufferSkip.GetBuffer(N * D);
+    float* Vectors = BufferVectors.GetBuffer(3 * D);
+    float* Output = BufferOutput.GetBuffer(N * D);
+    float* OutputReference = BufferOutputReference.GetBuffer(N * D);
+    float* SkipOutput = BufferSkipOutput.GetBuffer(2 * N * D);
+    float* Statistics = BufferStatistics.GetBuffer(4 * N);
+
+    std::default_random_engine generator(static_cast<unsigned>(N * D + Flags));
+    std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+    for (size_t nd = 0; nd < N * D; nd++) {
+      Input[nd] = Offset + distribution(generator);
+      Skip[nd] = distribution(generator);
+    }
+    for (size_t d = 0; d < 3 * D; d++) {
+      Vectors[d] = distribution(generator);
+    }
+
+    MLAS_LAYERNORM_PARAMETERS Parameters{};
+    Parameters.Skip = (Flags & WithSkip) ? Skip : nullptr;
+    Parameters.Bias = (Flags & WithBias) ? Vectors : nullptr;
+    Parameters.Scale = Vectors + D;
+    Parameters.Shift = (Flags & WithShift) ? Vectors + 2 * D : nullptr;
+    Parameters.Epsilon = 1e-5f;
+    Parameters.Simplified = (Flags & Simplified) != 0;
+
+    MLAS_LAYERNORM_PARAMETERS ReferenceParameters = Parameters;
+
+    Parameters.SkipOutput = (Flags & WithSkip) ? SkipOutput : nullptr;
+    Parameters.Mean = Statistics;
+    Parameters.InvStdDev = Statistics + N;
+
+    MlasLayerNormalization(Input, Output, N, D, &Parameters, threadpool_);
+    ReferenceLayerNorm(Input, ReferenceParameters, OutputReference, SkipOutput + N * D, Statistics + 2 * N,
+                       Statistics + 3 * N, N, D);
+
+    for (size_t nd = 0; nd < N * D; nd++) {
+      float diff = std::fabs(Output[nd] - OutputReference[nd]);
+      ASSERT_TRUE(diff <= Tolerance || diff <= std::fabs(OutputReference[nd]) * Tolerance)
+          << "flags " << Flags << " @" << nd << " of " << N << "/" << D << ", got: " << Output[nd]
+          << ", expecting: " << OutputReference[nd];
+      if (Flags & WithSkip) {
+        ASSERT_EQ(SkipOutput[nd], SkipOutput[N * D + nd]) << "flags " << Flags << " @" << nd;
+      }
+    }
+
+    for (size_t n = 0; n < N; n++) {
+      if (!Parameters.Simplified) {
+        ASSERT_NEAR(Statistics[n], Statistics[2 * N + n], Tolerance * std::max(1.0f, std::fabs(Offset)));
+      }
+      ASSERT_NEAR(Statistics[N + n], Statistics[3 * N + n], Tolerance * Statistics[3 * N + n]);
+    }
+
+    //
+    // Check the quantized output against quantizing the reference output,
+    // allowing results that round the other way.
+    //
+
+    uint8_t* QuantizedOutput = BufferQuantizedOutput.GetBuffer(N * D);
+    const float OutputScale = 0.02f;
+    const uint8_t OutputZeroPoint = 128;
+    Parameters.Mean = nullptr;
+    Parameters.InvStdDev = nullptr;
+
+    MlasLayerNormalizationQuantizeLinear<uint8_t>(Input, QuantizedOutput, N, D, &Parameters, OutputScale,
+                                                  OutputZeroPoint, threadpool_);
+
+    for (size_t nd = 0; nd < N * D; nd++) {
+      float Expected = std::nearbyint(OutputReference[nd] / OutputScale) + OutputZeroPoint;
+      Expected = std::min(std::max(Expected, 0.0f), 255.0f);
+      ASSERT_LE(std::fabs(float(QuantizedOutput[nd]) - Expected), 1.0f)
+          << "flags " << Flags << " @" << nd << " of " << N << "/" << D;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "LayerNorm_Threaded" : "LayerNorm_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasLayerNormTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (unsigned Flags = 0; Flags < 16; Flags++) {
+      for (size_t d : {1, 3, 4, 7, 8, 15, 16, 17, 33, 64, 255}) {
+        Test(3, d, Flags, 0.0f, 1e-5f);
+      }
+      Test(17, 768, Flags, 0.0f, 1e-5f);
+    }
+
+    // a large mean relative to the standard deviation, where computing the
+    // variance from the sum of squares loses most of the precision
+    Test(4, 1024, 0, 1000.0f, 2e-3f);
+    Test(4, 1027, WithSkip | WithBias | WithShift, 1000.0f, 2e-3f);
+  }
+};
+
+template <> MlasLayerNormTest<false>* MlasTestFixture<MlasLayerNormTest<false>>::mlas_tester(nullptr);
+template <> MlasLayerNormTest<true>* MlasTestFixture<MlasLayerNormTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasLayerNormTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasLayerNormTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,151 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasQ4GemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  std::vector<uint8_t> QuantBData;
+  std::vector<float> QuantBScale;
+  std::vector<uint8_t> QuantBZeroPoint;
+  std::vector<float> CReference;
+  std::vector<float> CTolerance;
+  std::mt19937 Generator{1234};
+
+  void ReferenceQ4Gemm(size_t M, size_t N, size_t K, size_t BlkLen, const float* A, bool HasZeroPoint,
+                       const float* Bias) {
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+    const size_t ZeroPointStride = (BlockCountK + 1) / 2;
+
+    CReference.resize(M * N);
+    CTolerance.resize(M * N);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double Sum = (Bias != nullptr) ? Bias[n] : 0.0;
+        double Magnitude = std::fabs(Sum);
+        for (size_t k = 0; k < K; k++) {
+          const size_t blk = k / BlkLen;
+          const size_t idx = k % BlkLen;
+          const uint8_t Byte = QuantBData[(n * BlockCountK + blk) * (BlkLen / 2) + idx / 2];
+          const int Quant = (idx & 1) ? (Byte >> 4) : (Byte & 0x0F);
+          int ZeroPoint = 8;
+          if (HasZeroPoint) {
+            const uint8_t Pair = QuantBZeroPoint[n * ZeroPointStride + blk / 2];
+            ZeroPoint = (blk & 1) ? (Pair >> 4) : (Pair & 0x0F);
+          }
+          const float B = float(Quant - ZeroPoint) * QuantBScale[n * BlockCountK + blk];
+          Sum += double(A[m * K + k]) * double(B);
+          Magnitude += std::fabs(double(A[m * K + k]) * double(B));
+        }
+        // The kernels accumulate in single precision, so the error scales with the magnitude of the terms.
+        CReference[m * N + n] = float(Sum);
+        CTolerance[m * N + n] = float(Magnitude * 1e-5) + 1e-6f;
+      }
+    }
+  }
+
+  void Test(size_t M, size_t N, size_t K, size_t BlkLen, bool HasZeroPoint, bool HasBias) {
+    const size_t BlockCountK = (K + BlkLen - 1) / BlkLen;
+
+    std::uniform_int_distribution<int> QuantDistribution(0, 255);
+    std::uniform_real_distribution<float> ScaleDistribution(0.01f, 0.1f);
+
+    QuantBData.resize(N * BlockCountK * (BlkLen / 2));
+    for (auto& q : QuantBData) {
+      q = static_cast<uint8_t>(QuantDistribution(Generator));
+    }
+    QuantBScale.resize(N * BlockCountK);
+    for (auto& s : QuantBScale) {
+      s = ScaleDistribution(Generator);
+    }
+    QuantBZeroPoint.resize(N * ((BlockCountK + 1) / 2));
+    for (auto& z : QuantBZeroPoint) {
+      z = static_cast<uint8_t>(QuantDistribution(Generator));
+    }
+
+    const float* A = BufferA.GetBuffer(M * K);
+    const float* Bias = HasBias ? BufferBias.GetBuffer(N) : nullptr;
+    float* C = BufferC.GetBuffer(M * N, true);
+
+    const size_t PackedBSize = MlasQ4GemmPackBSize(N, K, BlkLen);
+    ASSERT_GT(PackedBSize, size_t(0));
+    uint8_t* PackedB = BufferPackedB.GetBuffer(PackedBSize, true);
+
+    MlasQ4GemmPackB(PackedB, QuantBData.data(), QuantBScale.data(),
+                    HasZeroPoint ? QuantBZeroPoint.data() : nullptr, N, K, BlkLen);
+
+    MLAS_Q4_GEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = K;
+    Data.PackedB = PackedB;
+    Data.C = C;
+    Data.ldc = N;
+    Data.Bias = Bias;
+
+    MlasQ4GemmBatch(M, N, K, BlkLen, &Data, 1, threadpool_);
+
+    ReferenceQ4Gemm(M, N, K, BlkLen, A, HasZeroPoint, Bias);
+
+    for (size_t i = 0; i < M * N; i++) {
+      ASSERT_LE(std::fabs(C[i] - CReference[i]), CTolerance[i])
+          << " @" << i << " M=" << M << " N=" << N << " K=" << K << " BlkLen=" << BlkLen
+          << " HasZeroPoint=" << HasZeroPoint << " HasBias=" << HasBias
+          << " C=" << C[i] << " Reference=" << CReference[i];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Q4Gemm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t BlkLen : {32, 64, 128, 256}) {
+      for (size_t M : {1, 2, 3, 4, 7, 16}) {
+        for (size_t N : {1, 3, 4, 5, 17, 64}) {
+          for (size_t K : {1, 16, 31, 32, 33, 100, 257}) {
+            Test(M, N, K, BlkLen, false, false);
+            Test(M, N, K, BlkLen, true, true);
+          }
+        }
+      }
+    }
+    Test(1, 4096, 512, 32, true, false);
+    Test(40, 300, 700, 128, false, true);
+  }
+
+  void ExecuteLong(void) override {
+    for (size_t BlkLen : {32, 64, 128, 256}) {
+      for (size_t M = 1; M <= 40; M += 3) {
+        for (size_t N = 1; N <= 160; N += 13) {
+          for (size_t K = 1; K <= 600; K += 47) {
+            Test(M, N, K, BlkLen, (M & 1) != 0, (N & 1) != 0);
+          }
+        }
+      }
+    }
+  }
+
+  MlasQ4GemmTest() : threadpool_(GetMlasThreadPool()) {}
+
+ private:
+  MLAS_THREADPOOL* threadpool_;
+};
+
+template <> MlasQ4GemmTest* MlasTestFixture<MlasQ4GemmTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasQ4GemmTest>::RegisterShortExecute();
+  } else {
+    count += MlasLongExecuteTests<MlasQ4GemmTest>::RegisterLongExecute();
+  }
+  return count;
+});
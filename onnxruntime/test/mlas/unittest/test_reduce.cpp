@@ -0,0 +1,129 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasReduceTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferBias;
+  MatrixGuardBuffer<float> BufferOutput;
+  MatrixGuardBuffer<float> BufferOutputReference;
+
+  static double Identity(MLAS_REDUCE_KIND Kind) {
+    switch (Kind) {
+      case MlasReduceMaximum:
+      case MlasReduceMaximumFinite:
+        return std::numeric_limits<float>::lowest();
+      case MlasReduceMinimum:
+        return std::numeric_limits<float>::max();
+      default:
+        return 0.0;
+    }
+  }
+
+  static double AccumulateReference(MLAS_REDUCE_KIND Kind, double Accumulator, float Value, float Bias) {
+    switch (Kind) {
+      case MlasReduceSum:
+        return Accumulator + Value;
+      case MlasReduceSumSquare:
+        return Accumulator + double(Value) * Value;
+      case MlasReduceMaximum:
+        return std::max(Accumulator, double(Value));
+      case MlasReduceMinimum:
+        return std::min(Accumulator, double(Value));
+      case MlasReduceMaximumFinite:
+        return std::isfinite(Value) ? std::max(Accumulator, double(Value)) : Accumulator;
+      case MlasReduceSumExp:
+        return Accumulator + std::exp(double(Value) - Bias);
+    }
+    return Accumulator;
+  }
+
+  static double Combine(MLAS_REDUCE_KIND Kind, double Value1, double Value2) {
+    switch (Kind) {
+      case MlasReduceMaximum:
+      case MlasReduceMaximumFinite:
+        return std::max(Value1, Value2);
+      case MlasReduceMinimum:
+        return std::min(Value1, Value2);
+      default:
+        return Value1 + Value2;
+    }
+  }
+
+  void Test(MLAS_REDUCE_KIND Kind, bool Columns, size_t M, size_t N, size_t ldInput, bool Accumulate) {
+    float* Input = BufferInput.GetBuffer(M * ldInput);
+    const size_t OutputCount = Columns ? N : M;
+    float* Bias = BufferBias.GetBuffer(OutputCount);
+    float* Output = BufferOutput.GetBuffer(OutputCount);
+    float* OutputReference = BufferOutputReference.GetBuffer(OutputCount);
+
+    std::default_random_engine generator(static_cast<unsigned>(M * 131 + N));
+    std::uniform_real_distribution<float> distribution(-5.0f, 5.0f);
+
+    for (size_t i = 0; i < M * ldInput; i++) {
+      Input[i] = distribution(generator);
+    }
+    if (Kind == MlasReduceMaximumFinite && M * N > 2) {
+      Input[0] = std::numeric_limits<float>::infinity();
+      Input[M * ldInput - 1] = std::numeric_limits<float>::quiet_NaN();
+    }
+    for (size_t i = 0; i < OutputCount; i++) {
+      Bias[i] = distribution(generator);
+      Output[i] = distribution(generator);
+      if (Kind == MlasReduceSumExp || Kind == MlasReduceSumSquare) {
+        Output[i] = std::fabs(Output[i]);
+      }
+    }
+
+    for (size_t o = 0; o < OutputCount; o++) {
+      double Accumulator = Identity(Kind);
+      const size_t ReduceCount = Columns ? M : N;
+      for (size_t r = 0; r < ReduceCount; r++) {
+        const float Value = Columns ? Input[r * ldInput + o] : Input[o * ldInput + r];
+        Accumulator = AccumulateReference(Kind, Accumulator, Value, Bias[o]);
+      }
+      OutputReference[o] = float(Accumulate ? Combine(Kind, Output[o], Accumulator) : Accumulator);
+    }
+
+    if (Columns) {
+      MlasReduceColumnsF32(Kind, Input, ldInput, M, N, Bias, Output, Accumulate);
+    } else {
+      MlasReduceRowsF32(Kind, Input, ldInput, M, N, Bias, Output, Accumulate);
+    }
+
+    for (size_t o = 0; o < OutputCount; o++) {
+      const float Tolerance = 1e-5f * std::max(1.0f, std::fabs(OutputReference[o])) * (Columns ? M : N);
+      ASSERT_LE(std::fabs(Output[o] - OutputReference[o]), Tolerance)
+          << " @" << o << " Kind=" << Kind << " Columns=" << Columns << " M=" << M << " N=" << N
+          << " Accumulate=" << Accumulate << " Output=" << Output[o] << " Reference=" << OutputReference[o];
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Reduce");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (auto Kind : {MlasReduceSum, MlasReduceSumSquare, MlasReduceMaximum, MlasReduceMinimum,
+                      MlasReduceMaximumFinite, MlasReduceSumExp}) {
+      for (bool Columns : {false, true}) {
+        for (size_t M : {1, 3, 16, 33}) {
+          for (size_t N : {1, 3, 4, 15, 16, 17, 47, 300}) {
+            Test(Kind, Columns, M, N, N, false);
+            Test(Kind, Columns, M, N, N + 5, true);
+          }
+        }
+      }
+    }
+  }
+};
+
+template <> MlasReduceTest* MlasTestFixture<MlasReduceTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasReduceTest>::RegisterShortExecute() : 0;
+});
@@ -0,0 +1,166 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasResizeTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInputFloat;
+  MatrixGuardBuffer<float> BufferOutputFloat;
+  MatrixGuardBuffer<uint8_t> BufferInputU8;
+  MatrixGuardBuffer<int8_t> BufferInputS8;
+  MatrixGuardBuffer<int32_t> BufferHorizontal;
+  MatrixGuardBuffer<uint8_t> BufferOutputU8;
+  MatrixGuardBuffer<int8_t> BufferOutputS8;
+
+  std::vector<int32_t> Indices;
+  std::vector<float> WeightsFloat;
+  std::vector<int32_t> WeightsInteger;
+
+  void GenerateTaps(size_t InputWidth, size_t TapCount, size_t CountX, std::default_random_engine& generator) {
+    std::uniform_int_distribution<int32_t> index_distribution(0, static_cast<int32_t>(InputWidth - 1));
+
+    Indices.resize(CountX * TapCount);
+    WeightsFloat.resize(CountX * TapCount);
+    WeightsInteger.resize(CountX * TapCount);
+
+    // The fixed point weights of each output pixel sum to 1 << 10 as they do for bilinear resize.
+    for (size_t x = 0; x < CountX; x++) {
+      int32_t Remaining = 1 << 10;
+      for (size_t t = 0; t < TapCount; t++) {
+        const size_t i = x * TapCount + t;
+        Indices[i] = index_distribution(generator);
+        WeightsInteger[i] = (t + 1 == TapCount)
+                                ? Remaining
+                                : std::uniform_int_distribution<int32_t>(0, Remaining)(generator);
+        Remaining -= WeightsInteger[i];
+        WeightsFloat[i] = static_cast<float>(WeightsInteger[i]) / (1 << 10) - 0.25f;
+      }
+    }
+  }
+
+  void TestFloat(size_t InputWidth, size_t Channels, size_t TapCount, size_t CountX) {
+    std::default_random_engine generator(static_cast<unsigned>(InputWidth * 131 + Channels * 7 + TapCount));
+    std::uniform_real_distribution<float> distribution(-5.0f, 5.0f);
+
+    const size_t N = CountX * Channels;
+    float* Input = BufferInputFloat.GetBuffer(InputWidth * Channels * TapCount);
+    float* Output = BufferOutputFloat.GetBuffer(N * (TapCount + 1));
+
+    for (size_t i = 0; i < InputWidth * Channels * TapCount; i++) {
+      Input[i] = distribution(generator);
+    }
+
+    GenerateTaps(InputWidth, TapCount, CountX, generator);
+
+    // Resize each input row horizontally, then blend the rows with the taps of the first output pixel.
+    std::vector<const float*> Rows(TapCount);
+    for (size_t t = 0; t < TapCount; t++) {
+      const float* InputRow = Input + t * InputWidth * Channels;
+      float* OutputRow = Output + t * N;
+      MlasResizeHorizontal(InputRow, Channels, Indices.data(), WeightsFloat.data(), TapCount, CountX, OutputRow);
+
+      for (size_t x = 0; x < CountX; x++) {
+        for (size_t c = 0; c < Channels; c++) {
+          float Reference = 0.0f;
+          for (size_t tap = 0; tap < TapCount; tap++) {
+            Reference += WeightsFloat[x * TapCount + tap] * InputRow[Indices[x * TapCount + tap] * Channels + c];
+          }
+          ASSERT_NEAR(OutputRow[x * Channels + c], Reference, 1e-5f * TapCount * 5)
+              << " Horizontal @" << x << "," << c << " Channels=" << Channels << " TapCount=" << TapCount
+              << " CountX=" << CountX;
+        }
+      }
+
+      Rows[t] = OutputRow;
+    }
+
+    float* Blended = Output + TapCount * N;
+    MlasResizeVertical(Rows.data(), WeightsFloat.data(), TapCount, N, Blended);
+
+    for (size_t n = 0; n < N; n++) {
+      float Reference = 0.0f;
+      for (size_t t = 0; t < TapCount; t++) {
+        Reference += WeightsFloat[t] * Rows[t][n];
+      }
+      ASSERT_NEAR(Blended[n], Reference, 1e-5f * TapCount * 25)
+          << " Vertical @" << n << " Channels=" << Channels << " TapCount=" << TapCount << " CountX=" << CountX;
+    }
+  }
+
+  template <typename T>
+  void TestInteger(MatrixGuardBuffer<T>& BufferInput, MatrixGuardBuffer<T>& BufferOutput,
+                   size_t InputWidth, size_t Channels, size_t TapCount, size_t CountX) {
+    std::default_random_engine generator(static_cast<unsigned>(InputWidth * 131 + Channels * 7 + TapCount));
+    std::uniform_int_distribution<int32_t> distribution(std::numeric_limits<T>::min(), std::numeric_limits<T>::max());
+
+    const size_t N = CountX * Channels;
+    T* Input = BufferInput.GetBuffer(InputWidth * Channels * TapCount);
+    int32_t* Horizontal = BufferHorizontal.GetBuffer(N * TapCount);
+    T* Output = BufferOutput.GetBuffer(N);
+
+    for (size_t i = 0; i < InputWidth * Channels * TapCount; i++) {
+      Input[i] = static_cast<T>(distribution(generator));
+    }
+
+    GenerateTaps(InputWidth, TapCount, CountX, generator);
+
+    // Blend the rows with the taps of the first output pixel, which also sum to 1 << 10.
+    const int32_t* VerticalWeights = WeightsInteger.data();
+
+    std::vector<const int32_t*> Rows(TapCount);
+    for (size_t t = 0; t < TapCount; t++) {
+      const T* InputRow = Input + t * InputWidth * Channels;
+      int32_t* HorizontalRow = Horizontal + t * N;
+      MlasResizeHorizontal(InputRow, Channels, Indices.data(), WeightsInteger.data(), TapCount, CountX, HorizontalRow);
+
+      for (size_t x = 0; x < CountX; x++) {
+        for (size_t c = 0; c < Channels; c++) {
+          int32_t Reference = 0;
+          for (size_t tap = 0; tap < TapCount; tap++) {
+            Reference += WeightsInteger[x * TapCount + tap] * InputRow[Indices[x * TapCount + tap] * Channels + c];
+          }
+          ASSERT_EQ(HorizontalRow[x * Channels + c], Reference)
+              << " Horizontal @" << x << "," << c << " Channels=" << Channels << " TapCount=" << TapCount;
+        }
+      }
+
+      Rows[t] = HorizontalRow;
+    }
+
+    MlasResizeVertical(Rows.data(), VerticalWeights, TapCount, N, 20, Output);
+
+    for (size_t n = 0; n < N; n++) {
+      int32_t Reference = 0;
+      for (size_t t = 0; t < TapCount; t++) {
+        Reference += VerticalWeights[t] * Rows[t][n];
+      }
+      ASSERT_EQ(Output[n], static_cast<T>(Reference / (1 << 20)))
+          << " Vertical @" << n << " Channels=" << Channels << " TapCount=" << TapCount;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("Resize");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (size_t TapCount : {1, 2, 4}) {
+      for (size_t Channels : {1, 3, 4, 16, 19}) {
+        for (size_t CountX : {1, 7, 32}) {
+          TestFloat(13, Channels, TapCount, CountX);
+          TestInteger(BufferInputU8, BufferOutputU8, 13, Channels, TapCount, CountX);
+          TestInteger(BufferInputS8, BufferOutputS8, 13, Channels, TapCount, CountX);
+        }
+      }
+    }
+  }
+};
+
+template <> MlasResizeTest* MlasTestFixture<MlasResizeTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  return is_short_execute ? MlasDirectShortExecuteTests<MlasResizeTest>::RegisterShortExecute() : 0;
+});
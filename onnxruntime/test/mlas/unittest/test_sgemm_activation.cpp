@@ -0,0 +1,114 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+template <bool Packed, bool Threaded>
+class MlasSgemmActivationTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferB;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<float> BufferCReference;
+  MatrixGuardBuffer<uint8_t> BufferBPacked;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(CBLAS_TRANSPOSE TransA, size_t M, size_t N, size_t K, float alpha, float beta,
+            MLAS_ACTIVATION_KIND ActivationKind) {
+    const float* A = BufferA.GetBuffer(M * K);
+    const float* B = BufferB.GetBuffer(K * N);
+    float* C = BufferC.GetBuffer(M * N);
+    float* CReference = BufferCReference.GetBuffer(M * N);
+
+    const size_t lda = (TransA == CblasNoTrans) ? K : M;
+
+    for (size_t mn = 0; mn < M * N; mn++) {
+      C[mn] = CReference[mn] = float((mn % 13) + 1) * 0.125f - 1.0f;
+    }
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        float Sum = 0.0f;
+        for (size_t k = 0; k < K; k++) {
+          const float a = (TransA == CblasNoTrans) ? A[m * lda + k] : A[k * lda + m];
+          Sum += a * B[k * N + n];
+        }
+        CReference[m * N + n] = Sum * alpha + beta * CReference[m * N + n];
+      }
+    }
+
+    MLAS_ACTIVATION Activation;
+    Activation.ActivationKind = ActivationKind;
+    Activation.Parameters.Values[0] = (ActivationKind == MlasClipActivation) ? -0.5f : 0.2f;
+    Activation.Parameters.Values[1] = 0.5f;
+
+    MlasActivation(&Activation, CReference, nullptr, M, N, N);
+
+    MLAS_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = lda;
+    Data.B = B;
+    Data.ldb = N;
+    Data.C = C;
+    Data.ldc = N;
+    Data.alpha = alpha;
+    Data.beta = beta;
+    Data.Activation = &Activation;
+
+    if (Packed) {
+      void* PackedB = BufferBPacked.GetBuffer(MlasGemmPackBSize(N, K), true);
+      MlasGemmPackB(CblasNoTrans, N, K, B, N, PackedB);
+      Data.B = static_cast<const float*>(PackedB);
+      Data.BIsPacked = true;
+    }
+
+    MlasGemmBatch(TransA, CblasNoTrans, M, N, K, &Data, 1, threadpool_);
+
+    for (size_t mn = 0; mn < M * N; mn++) {
+      ASSERT_NEAR(C[mn], CReference[mn], 1e-4f * std::max(1.0f, std::fabs(CReference[mn])))
+          << "@" << mn << " of " << M << "x" << N << "x" << K << ", TransA" << TransA << ", alpha " << alpha
+          << ", beta " << beta << ", Act" << ActivationKind;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(std::string("SGemmActivation") + (Packed ? "_Packed" : "_NoPack") +
+                                        (Threaded ? "_Threaded" : "_SingleThread"));
+    return suite_name.c_str();
+  }
+
+  MlasSgemmActivationTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (MLAS_ACTIVATION_KIND kind : {MlasReluActivation, MlasTanhActivation, MlasClipActivation,
+                                      MlasGeluActivation, MlasFastGeluActivation}) {
+      for (CBLAS_TRANSPOSE TransA : {CblasNoTrans, CblasTrans}) {
+        Test(TransA, 1, 37, 19, 1.0f, 0.0f, kind);
+        Test(TransA, 23, 1, 19, 1.0f, 1.0f, kind);
+        Test(TransA, 17, 45, 7, 0.25f, 1.0f, kind);
+        Test(TransA, 33, 300, 300, 0.25f, 0.0f, kind);
+        Test(TransA, 9, 70, 600, 0.25f, 0.5f, kind);
+        Test(TransA, 5, 8, 0, 1.0f, 0.5f, kind);
+      }
+    }
+  }
+};
+
+template <> MlasSgemmActivationTest<false, false>* MlasTestFixture<MlasSgemmActivationTest<false, false>>::mlas_tester(nullptr);
+template <> MlasSgemmActivationTest<false, true>* MlasTestFixture<MlasSgemmActivationTest<false, true>>::mlas_tester(nullptr);
+template <> MlasSgemmActivationTest<true, false>* MlasTestFixture<MlasSgemmActivationTest<true, false>>::mlas_tester(nullptr);
+template <> MlasSgemmActivationTest<true, true>* MlasTestFixture<MlasSgemmActivationTest<true, true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasSgemmActivationTest<false, false>>::RegisterShortExecute();
+    count += MlasDirectShortExecuteTests<MlasSgemmActivationTest<true, false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasSgemmActivationTest<false, true>>::RegisterShortExecute();
+      count += MlasDirectShortExecuteTests<MlasSgemmActivationTest<true, true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -0,0 +1,225 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+class MlasBlockSparseGemmTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferA;
+  MatrixGuardBuffer<float> BufferC;
+  MatrixGuardBuffer<uint8_t> BufferQuantA;
+  MatrixGuardBuffer<int32_t> BufferQuantC;
+  MatrixGuardBuffer<uint8_t> BufferPackedB;
+  std::vector<float> B;
+  std::vector<uint8_t> QuantB;
+  std::vector<uint8_t> ZeroPointB;
+  std::mt19937 Generator{1234};
+
+  // Clears whole blocks of one row by MLAS_BLOCK_SPARSE_GEMM_BLOCK_N columns with the given probability, so
+  // that about that fraction of the blocks is dropped by the packing. Returns the number of remaining blocks.
+  template <typename Fn>
+  size_t GeneratePattern(size_t N, size_t K, double Sparsity, Fn ClearElement) {
+    std::bernoulli_distribution Clear(Sparsity);
+    size_t BlockCount = 0;
+    for (size_t n = 0; n < N; n += MLAS_BLOCK_SPARSE_GEMM_BLOCK_N) {
+      for (size_t k = 0; k < K; k++) {
+        if (Clear(Generator)) {
+          for (size_t i = n; i < std::min(N, n + MLAS_BLOCK_SPARSE_GEMM_BLOCK_N); i++) {
+            ClearElement(k, i);
+          }
+        } else {
+          BlockCount++;
+        }
+      }
+    }
+    return BlockCount;
+  }
+
+  void TestSgemm(size_t M, size_t N, size_t K, double Sparsity, bool TransB, float Threshold) {
+    std::uniform_real_distribution<float> Distribution(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> SmallDistribution(-Threshold, Threshold);
+
+    B.resize(N * K);
+    for (auto& b : B) {
+      b = Distribution(Generator);
+    }
+    const size_t ldb = TransB ? K : N;
+    auto ElementB = [&](size_t k, size_t n) -> float& { return TransB ? B[n * ldb + k] : B[k * ldb + n]; };
+    const size_t ExpectedBlockCount = GeneratePattern(N, K, Sparsity, [&](size_t k, size_t n) {
+      ElementB(k, n) = (Threshold > 0.0f) ? SmallDistribution(Generator) : 0.0f;
+    });
+
+    const size_t BlockCount =
+        MlasBlockSparseSgemmCountBlocks(TransB ? CblasTrans : CblasNoTrans, N, K, B.data(), ldb, Threshold);
+    // A kept block may happen to hold only elements below the threshold.
+    if (Threshold > 0.0f) {
+      ASSERT_LE(BlockCount, ExpectedBlockCount);
+    } else {
+      ASSERT_EQ(BlockCount, ExpectedBlockCount) << " M=" << M << " N=" << N << " K=" << K;
+    }
+
+    const size_t PackedBSize = MlasBlockSparseSgemmPackBSize(N, K, BlockCount);
+    ASSERT_GT(PackedBSize, size_t(0));
+    uint8_t* PackedB = BufferPackedB.GetBuffer(PackedBSize, true);
+    MlasBlockSparseSgemmPackB(TransB ? CblasTrans : CblasNoTrans, N, K, B.data(), ldb, Threshold, PackedB);
+
+    // The elements of the dropped blocks don't contribute, the others are kept unchanged.
+    if (Threshold > 0.0f) {
+      for (size_t n = 0; n < N; n += MLAS_BLOCK_SPARSE_GEMM_BLOCK_N) {
+        for (size_t k = 0; k < K; k++) {
+          bool Dropped = true;
+          for (size_t i = n; i < std::min(N, n + MLAS_BLOCK_SPARSE_GEMM_BLOCK_N); i++) {
+            Dropped = Dropped && std::fabs(ElementB(k, i)) <= Threshold;
+          }
+          if (Dropped) {
+            for (size_t i = n; i < std::min(N, n + MLAS_BLOCK_SPARSE_GEMM_BLOCK_N); i++) {
+              ElementB(k, i) = 0.0f;
+            }
+          }
+        }
+      }
+    }
+
+    const float* A = BufferA.GetBuffer(M * K);
+    float* C = BufferC.GetBuffer(M * N, true);
+    const float alpha = 0.5f;
+
+    MLAS_BLOCK_SPARSE_SGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = K;
+    Data.PackedB = PackedB;
+    Data.C = C;
+    Data.ldc = N;
+    Data.alpha = alpha;
+
+    MlasBlockSparseSgemmBatch(M, N, K, &Data, 1, threadpool_);
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        double Sum = 0.0;
+        double Magnitude = 0.0;
+        for (size_t k = 0; k < K; k++) {
+          Sum += double(A[m * K + k]) * double(ElementB(k, n));
+          Magnitude += std::fabs(double(A[m * K + k]) * double(ElementB(k, n)));
+        }
+        const float Reference = float(alpha * Sum);
+        const float Tolerance = float(alpha * Magnitude * 1e-5) + 1e-6f;
+        ASSERT_LE(std::fabs(C[m * N + n] - Reference), Tolerance)
+            << " @[" << m << "," << n << "] M=" << M << " N=" << N << " K=" << K << " TransB=" << TransB
+            << " Threshold=" << Threshold << " C=" << C[m * N + n] << " Reference=" << Reference;
+      }
+    }
+  }
+
+  void TestQgemm(size_t M, size_t N, size_t K, double Sparsity, bool AIsSigned, bool BIsSigned,
+                 bool PerColumnZeroPoints) {
+    std::uniform_int_distribution<int> Distribution(0, 255);
+
+    QuantB.resize(N * K);
+    for (auto& b : QuantB) {
+      b = static_cast<uint8_t>(Distribution(Generator));
+    }
+    ZeroPointB.resize(PerColumnZeroPoints ? N : 1);
+    for (auto& z : ZeroPointB) {
+      z = static_cast<uint8_t>(Distribution(Generator));
+    }
+    const size_t ExpectedBlockCount = GeneratePattern(N, K, Sparsity, [&](size_t k, size_t n) {
+      QuantB[k * N + n] = ZeroPointB[PerColumnZeroPoints ? n : 0];
+    });
+
+    const size_t BlockCount = MlasBlockSparseQgemmCountBlocks(N, K, QuantB.data(), N, BIsSigned,
+                                                              ZeroPointB.data(), PerColumnZeroPoints);
+    // A kept block may happen to hold only zero points.
+    ASSERT_LE(BlockCount, ExpectedBlockCount);
+
+    const size_t PackedBSize = MlasBlockSparseQgemmPackBSize(N, K, BlockCount);
+    ASSERT_GT(PackedBSize, size_t(0));
+    uint8_t* PackedB = BufferPackedB.GetBuffer(PackedBSize, true);
+    MlasBlockSparseQgemmPackB(N, K, QuantB.data(), N, BIsSigned, ZeroPointB.data(), PerColumnZeroPoints, PackedB);
+
+    const uint8_t* A = BufferQuantA.GetBuffer(M * K);
+    int32_t* C = BufferQuantC.GetBuffer(M * N, true);
+    const uint8_t ZeroPointA = static_cast<uint8_t>(Distribution(Generator));
+
+    MLAS_BLOCK_SPARSE_QGEMM_DATA_PARAMS Data;
+    Data.A = A;
+    Data.lda = K;
+    Data.ZeroPointA = ZeroPointA;
+    Data.PackedB = PackedB;
+    Data.C = C;
+    Data.ldc = N;
+
+    MlasBlockSparseQgemmBatch(M, N, K, AIsSigned, &Data, 1, threadpool_);
+
+    auto Load = [](uint8_t v, bool IsSigned) { return IsSigned ? int32_t(int8_t(v)) : int32_t(v); };
+
+    for (size_t m = 0; m < M; m++) {
+      for (size_t n = 0; n < N; n++) {
+        int32_t Reference = 0;
+        for (size_t k = 0; k < K; k++) {
+          Reference += (Load(A[m * K + k], AIsSigned) - Load(ZeroPointA, AIsSigned)) *
+                       (Load(QuantB[k * N + n], BIsSigned) -
+                        Load(ZeroPointB[PerColumnZeroPoints ? n : 0], BIsSigned));
+        }
+        ASSERT_EQ(C[m * N + n], Reference)
+            << " @[" << m << "," << n << "] M=" << M << " N=" << N << " K=" << K << " AIsSigned=" << AIsSigned
+            << " BIsSigned=" << BIsSigned << " PerColumnZeroPoints=" << PerColumnZeroPoints;
+      }
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name("BlockSparseGemm");
+    return suite_name.c_str();
+  }
+
+  void ExecuteShort(void) override {
+    for (double Sparsity : {0.0, 0.8, 1.0}) {
+      for (size_t M : {1, 3, 4, 9}) {
+        for (size_t N : {1, 5, 16, 17, 40}) {
+          for (size_t K : {1, 7, 33}) {
+            TestSgemm(M, N, K, Sparsity, false, 0.0f);
+            TestSgemm(M, N, K, Sparsity, true, 0.0f);
+            TestQgemm(M, N, K, Sparsity, false, false, false);
+            TestQgemm(M, N, K, Sparsity, true, true, true);
+          }
+        }
+      }
+    }
+    TestSgemm(5, 33, 20, 0.5, false, 0.01f);
+    TestSgemm(5, 33, 20, 0.5, true, 0.01f);
+    TestSgemm(64, 512, 256, 0.9, false, 0.0f);
+    TestQgemm(64, 512, 256, 0.9, false, true, true);
+  }
+
+  void ExecuteLong(void) override {
+    for (double Sparsity : {0.5, 0.9}) {
+      for (size_t M = 1; M <= 40; M += 3) {
+        for (size_t N = 1; N <= 160; N += 13) {
+          for (size_t K = 1; K <= 300; K += 47) {
+            TestSgemm(M, N, K, Sparsity, (M & 1) != 0, 0.0f);
+            TestQgemm(M, N, K, Sparsity, (N & 1) != 0, (K & 1) != 0, (M & 1) != 0);
+          }
+        }
+      }
+    }
+  }
+
+  MlasBlockSparseGemmTest() : threadpool_(GetMlasThreadPool()) {}
+
+ private:
+  MLAS_THREADPOOL* threadpool_;
+};
+
+template <> MlasBlockSparseGemmTest* MlasTestFixture<MlasBlockSparseGemmTest>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasBlockSparseGemmTest>::RegisterShortExecute();
+  } else {
+    count += MlasLongExecuteTests<MlasBlockSparseGemmTest>::RegisterLongExecute();
+  }
+  return count;
+});
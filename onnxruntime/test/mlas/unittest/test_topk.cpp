@@ -0,0 +1,108 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "test_util.h"
+
+#include <numeric>
+
+template <bool Threaded>
+class MlasTopKTest : public MlasTestBase {
+ private:
+  MatrixGuardBuffer<float> BufferInput;
+  MatrixGuardBuffer<float> BufferValues;
+  MatrixGuardBuffer<int64_t> BufferIndices;
+  MLAS_THREADPOOL* threadpool_;
+
+  void Test(size_t N, size_t K, bool Largest, bool Sorted, size_t DistinctValues) {
+    std::default_random_engine generator(static_cast<unsigned>(N * 31 + K));
+    std::uniform_real_distribution<float> distribution(-100.0f, 100.0f);
+
+    float* Input = BufferInput.GetBuffer(N);
+    float* Values = BufferValues.GetBuffer(K);
+    int64_t* Indices = BufferIndices.GetBuffer(K);
+
+    // A small number of distinct values exercises the ranking of equal values by index.
+    std::vector<float> Distinct(DistinctValues);
+    for (auto& value : Distinct) {
+      value = distribution(generator);
+    }
+    Distinct[0] = 0.0f;
+    if (DistinctValues > 1) {
+      Distinct[1] = -0.0f;
+    }
+
+    std::uniform_int_distribution<size_t> pick(0, DistinctValues - 1);
+    for (size_t n = 0; n < N; n++) {
+      Input[n] = Distinct[pick(generator)];
+    }
+
+    std::vector<int64_t> Reference(N);
+    std::iota(Reference.begin(), Reference.end(), int64_t{0});
+    std::stable_sort(Reference.begin(), Reference.end(), [&](int64_t lhs, int64_t rhs) {
+      return Largest ? Input[lhs] > Input[rhs] : Input[lhs] < Input[rhs];
+    });
+
+    MlasTopK(Input, N, K, Largest, Sorted, Values, Indices, threadpool_);
+
+    if (!Sorted) {
+      std::vector<size_t> order(K);
+      std::iota(order.begin(), order.end(), size_t{0});
+      std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return Largest ? (Values[lhs] > Values[rhs] || (Values[lhs] == Values[rhs] && Indices[lhs] < Indices[rhs]))
+                       : (Values[lhs] < Values[rhs] || (Values[lhs] == Values[rhs] && Indices[lhs] < Indices[rhs]));
+      });
+      std::vector<float> SortedValues(K);
+      std::vector<int64_t> SortedIndices(K);
+      for (size_t k = 0; k < K; k++) {
+        SortedValues[k] = Values[order[k]];
+        SortedIndices[k] = Indices[order[k]];
+      }
+      std::copy(SortedValues.begin(), SortedValues.end(), Values);
+      std::copy(SortedIndices.begin(), SortedIndices.end(), Indices);
+    }
+
+    for (size_t k = 0; k < K; k++) {
+      ASSERT_EQ(Indices[k], Reference[k]) << " @" << k << " N=" << N << " K=" << K << " Largest=" << Largest
+                                          << " Sorted=" << Sorted << " DistinctValues=" << DistinctValues;
+      ASSERT_EQ(Values[k], Input[Reference[k]]) << " @" << k << " N=" << N << " K=" << K;
+    }
+  }
+
+ public:
+  static const char* GetTestSuiteName() {
+    static const std::string suite_name(Threaded ? "TopK_Threaded" : "TopK_SingleThread");
+    return suite_name.c_str();
+  }
+
+  MlasTopKTest() : threadpool_(Threaded ? GetMlasThreadPool() : nullptr) {}
+
+  void ExecuteShort(void) override {
+    for (size_t N : {1, 7, 100, 5000, 50000}) {
+      for (size_t K : {1, 2, 10, 64}) {
+        if (K > N) {
+          continue;
+        }
+        for (size_t DistinctValues : {1, 3, 1000000}) {
+          Test(N, K, true, true, DistinctValues);
+          Test(N, K, false, true, DistinctValues);
+          Test(N, K, true, false, DistinctValues);
+        }
+      }
+    }
+    Test(50000, 50000, true, true, 1000000);
+  }
+};
+
+template <> MlasTopKTest<false>* MlasTestFixture<MlasTopKTest<false>>::mlas_tester(nullptr);
+template <> MlasTopKTest<true>* MlasTestFixture<MlasTopKTest<true>>::mlas_tester(nullptr);
+
+static UNUSED_VARIABLE bool added_to_main = AddTestRegister([](bool is_short_execute) {
+  size_t count = 0;
+  if (is_short_execute) {
+    count += MlasDirectShortExecuteTests<MlasTopKTest<false>>::RegisterShortExecute();
+    if (GetMlasThreadPool() != nullptr) {
+      count += MlasDirectShortExecuteTests<MlasTopKTest<true>>::RegisterShortExecute();
+    }
+  }
+  return count;
+});
@@ -28,6 +28,18 @@ enum class EXECUTE_RESULT {
 
 std::ostream& operator<<(std::ostream& os, EXECUTE_RESULT);
 
+//timings and memory of a test case, reported by the benchmark mode of onnx_test_runner
+struct TestCaseBenchmark {
+  double session_creation_seconds = 0;
+  //the first Session::Run, which includes the one-time allocations and kernel setup
+  double first_run_seconds = 0;
+  //the Session::Run calls after the first one
+  double steady_state_total_seconds = 0;
+  size_t steady_state_runs = 0;
+  //peak working set of the process once the test case finished. it is shared by the test cases run in parallel.
+  size_t peak_working_set_size = 0;
+};
+
 class TestCaseResult {
  public:
   TestCaseResult(size_t count, EXECUTE_RESULT result, const std::string& node_name1)
@@ -55,9 +67,18 @@ class TestCaseResult {
     return node_name;
   }
 
+  const TestCaseBenchmark& GetBenchmark() const {
+    return benchmark_;
+  }
+
+  TestCaseBenchmark& MutableBenchmark() {
+    return benchmark_;
+  }
+
  private:
   //only valid for single node tests;
   std::string node_name;
   onnxruntime::TIME_SPEC spent_time_;
+  TestCaseBenchmark benchmark_;
   std::vector<EXECUTE_RESULT> execution_result_;
 };
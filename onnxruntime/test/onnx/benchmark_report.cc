@@ -0,0 +1,150 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "benchmark_report.h"
+#include "TestCase.h"
+#include "TestCaseResult.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <unordered_map>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "nlohmann/json.hpp"
+
+namespace onnxruntime {
+namespace test {
+
+size_t GetPeakWorkingSetSize() {
+#ifdef _WIN32
+  PROCESS_MEMORY_COUNTERS pmc;
+  if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+    return pmc.PeakWorkingSetSize;
+  }
+  return 0;
+#else
+  struct rusage rusage;
+  if (getrusage(RUSAGE_SELF, &rusage) != 0) {
+    return 0;
+  }
+#ifdef __APPLE__
+  // bytes on macOS, kilobytes elsewhere
+  return static_cast<size_t>(rusage.ru_maxrss);
+#else
+  return static_cast<size_t>(rusage.ru_maxrss) * 1024;
+#endif
+#endif
+}
+
+std::vector<ModelBenchmark> CollectBenchmarks(const std::vector<ITestCase*>& tests,
+                                              const std::vector<std::shared_ptr<TestCaseResult>>& results) {
+  std::vector<ModelBenchmark> benchmarks;
+  benchmarks.reserve(tests.size());
+  for (size_t i = 0; i != tests.size(); ++i) {
+    ModelBenchmark benchmark;
+    benchmark.name = tests[i]->GetTestCaseName();
+    const TestCaseResult* result = i < results.size() ? results[i].get() : nullptr;
+    if (result != nullptr) {
+      const auto& execution_results = result->GetExcutionResult();
+      benchmark.succeeded = std::all_of(execution_results.begin(), execution_results.end(),
+                                        [](EXECUTE_RESULT r) { return r == EXECUTE_RESULT::SUCCESS; });
+      const TestCaseBenchmark& stats = result->GetBenchmark();
+      benchmark.session_creation_ms = stats.session_creation_seconds * 1000;
+      benchmark.first_run_ms = stats.first_run_seconds * 1000;
+      if (stats.steady_state_runs > 0) {
+        benchmark.steady_state_ms = stats.steady_state_total_seconds * 1000 / stats.steady_state_runs;
+      }
+      benchmark.steady_state_runs = stats.steady_state_runs;
+      benchmark.peak_working_set_size = stats.peak_working_set_size;
+    }
+    benchmarks.push_back(std::move(benchmark));
+  }
+  return benchmarks;
+}
+
+common::Status WriteBenchmarkReport(const std::basic_string<PATH_CHAR_TYPE>& report_path,
+                                    gsl::span<const ModelBenchmark> benchmarks) {
+  nlohmann::json models = nlohmann::json::array();
+  for (const auto& benchmark : benchmarks) {
+    models.push_back({{"name", benchmark.name},
+                      {"succeeded", benchmark.succeeded},
+                      {"session_creation_ms", benchmark.session_creation_ms},
+                      {"first_run_ms", benchmark.first_run_ms},
+                      {"steady_state_ms", benchmark.steady_state_ms},
+                      {"steady_state_runs", benchmark.steady_state_runs},
+                      {"peak_working_set_size", benchmark.peak_working_set_size}});
+  }
+
+  std::ofstream report(report_path);
+  if (!report.good()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to open the benchmark report ", ToUTF8String(report_path));
+  }
+  report << nlohmann::json{{"models", std::move(models)}}.dump(2) << "\n";
+  return report.good() ? Status::OK()
+                       : ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to write the benchmark report ",
+                                         ToUTF8String(report_path));
+}
+
+common::Status CompareWithBaselineReport(const std::basic_string<PATH_CHAR_TYPE>& baseline_path,
+                                         gsl::span<const ModelBenchmark> benchmarks, double threshold,
+                                         size_t& num_regressions) {
+  num_regressions = 0;
+  std::ifstream baseline_stream(baseline_path);
+  if (!baseline_stream.good()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Failed to open the baseline report ", ToUTF8String(baseline_path));
+  }
+  const auto baseline = nlohmann::json::parse(baseline_stream, /*cb=*/nullptr, /*allow_exceptions=*/false);
+  if (baseline.is_discarded() || !baseline.contains("models") || !baseline["models"].is_array()) {
+    return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "Invalid baseline report ", ToUTF8String(baseline_path));
+  }
+
+  std::unordered_map<std::string, const nlohmann::json*> baseline_models;
+  for (const auto& model : baseline["models"]) {
+    if (model.contains("name") && model["name"].is_string()) {
+      baseline_models[model["name"].get<std::string>()] = &model;
+    }
+  }
+
+  for (const auto& benchmark : benchmarks) {
+    auto found = baseline_models.find(benchmark.name);
+    if (found == baseline_models.end()) {
+      continue;
+    }
+    const auto& model = *found->second;
+
+    if (model.value("succeeded", false) && !benchmark.succeeded) {
+      fprintf(stderr, "%s: regression, it succeeded in the baseline but fails now\n", benchmark.name.c_str());
+      ++num_regressions;
+      continue;
+    }
+
+    auto compare = [&](const char* metric, double current) {
+      const double base = model.value(metric, 0.0);
+      if (base <= 0 || current <= 0) {
+        return;
+      }
+      const double change = (current - base) / base;
+      const bool regressed = change > threshold;
+      fprintf(regressed ? stderr : stdout, "%s: %s %.3f -> %.3f (%+.1f%%)%s\n", benchmark.name.c_str(), metric, base,
+              current, change * 100, regressed ? " regression" : "");
+      if (regressed) {
+        ++num_regressions;
+      }
+    };
+    compare("session_creation_ms", benchmark.session_creation_ms);
+    compare("first_run_ms", benchmark.first_run_ms);
+    compare("steady_state_ms", benchmark.steady_state_ms);
+    compare("peak_working_set_size", static_cast<double>(benchmark.peak_working_set_size));
+  }
+  return Status::OK();
+}
+
+}  // namespace test
+}  // namespace onnxruntime
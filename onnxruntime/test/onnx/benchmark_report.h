@@ -0,0 +1,62 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#pragma once
+
+#include "core/common/common.h"
+#include "core/common/gsl.h"
+#include "core/platform/path_lib.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+class ITestCase;
+class TestCaseResult;
+
+namespace onnxruntime {
+namespace test {
+
+/// <summary>
+/// Benchmark of a model in the JSON report of onnx_test_runner -b
+/// </summary>
+struct ModelBenchmark {
+  std::string name;
+  bool succeeded = false;
+  double session_creation_ms = 0;
+  double first_run_ms = 0;
+  // average of the runs after the first one, 0 if there are none
+  double steady_state_ms = 0;
+  size_t steady_state_runs = 0;
+  size_t peak_working_set_size = 0;
+};
+
+/// <summary>
+/// Peak working set size of the process in bytes, 0 if it is unknown
+/// </summary>
+size_t GetPeakWorkingSetSize();
+
+/// <summary>
+/// Collects the benchmarks of the test cases from their results
+/// </summary>
+/// <param name="tests">test cases</param>
+/// <param name="results">results in the order of the test cases, see TestEnv::GetResults</param>
+std::vector<ModelBenchmark> CollectBenchmarks(const std::vector<ITestCase*>& tests,
+                                              const std::vector<std::shared_ptr<TestCaseResult>>& results);
+
+common::Status WriteBenchmarkReport(const std::basic_string<PATH_CHAR_TYPE>& report_path,
+                                    gsl::span<const ModelBenchmark> benchmarks);
+
+/// <summary>
+/// Compares the benchmarks with a report written by an earlier run and prints the regressions.
+/// A metric regresses if it grew by more than threshold (0.1 is 10%) from the baseline.
+/// A model regresses as well if it succeeded in the baseline but fails now.
+/// Models that are not in both reports are skipped.
+/// </summary>
+/// <param name="num_regressions">number of regressed metrics</param>
+common::Status CompareWithBaselineReport(const std::basic_string<PATH_CHAR_TYPE>& baseline_path,
+                                         gsl::span<const ModelBenchmark> benchmarks, double threshold,
+                                         size_t& num_regressions);
+
+}  // namespace test
+}  // namespace onnxruntime
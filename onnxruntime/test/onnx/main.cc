@@ -14,6 +14,7 @@
 #endif
 #include "TestResultStat.h"
 #include "TestCase.h"
+#include "benchmark_report.h"
 #include "testenv.h"
 #include "providers.h"
 
@@ -54,6 +55,11 @@ void usage() {
       "\t-o [optimization level]: Default is 99. Valid values are 0 (disable), 1 (basic), 2 (extended), 99 (all).\n"
       "\t\tPlease see onnxruntime_c_api.h (enum GraphOptimizationLevel) for the full list of all optimization levels. "
       "\n"
+      "\t-b [report_file]: Benchmark mode. Writes the session creation time, first run latency, steady state latency "
+      "and peak memory of each model to a JSON report. Use -c 1 and -r [repeat] for stable latencies.\n"
+      "\t-B [baseline_file]: Compares the benchmark report with the report of an earlier run and fails if a metric "
+      "regressed. Requires -b.\n"
+      "\t-T [percent]: Regression threshold of -B in percent. Default: 10.\n"
       "\t-h: help\n"
       "\n"
       "onnxruntime version: %s\n",
@@ -142,6 +148,10 @@ int real_main(int argc, char* argv[], Ort::Env& env) {
   bool user_graph_optimization_level_set = false;
   bool set_denormal_as_zero = false;
   std::basic_string<ORTCHAR_T> ep_runtime_config_string;
+  std::basic_string<ORTCHAR_T> benchmark_report_path;
+  std::basic_string<ORTCHAR_T> benchmark_baseline_path;
+  double benchmark_regression_threshold = 0.1;
+  bool benchmark_regressed = false;
 
   OrtLoggingLevel logging_level = ORT_LOGGING_LEVEL_ERROR;
   bool verbose_logging_required = false;
@@ -149,7 +159,7 @@ int real_main(int argc, char* argv[], Ort::Env& env) {
   bool pause = false;
   {
     int ch;
-    while ((ch = getopt(argc, argv, ORT_TSTR("Ac:hj:Mn:r:e:xvo:d:i:pz"))) != -1) {
+    while ((ch = getopt(argc, argv, ORT_TSTR("Ac:hj:Mn:r:e:xvo:d:i:pzb:B:T:"))) != -1) {
       switch (ch) {
         case 'A':
           enable_cpu_mem_arena = false;
@@ -267,6 +277,21 @@ int real_main(int argc, char* argv[], Ort::Env& env) {
         case 'z':
           set_denormal_as_zero = true;
           break;
+        case 'b':
+          benchmark_report_path = optarg;
+          break;
+        case 'B':
+          benchmark_baseline_path = optarg;
+          break;
+        case 'T': {
+          const auto percent = OrtStrtol<PATH_CHAR_TYPE>(optarg, nullptr);
+          if (percent < 0) {
+            usage();
+            return -1;
+          }
+          benchmark_regression_threshold = static_cast<double>(percent) / 100;
+          break;
+        }
         case '?':
         case 'h':
         default:
@@ -288,6 +313,11 @@ int real_main(int argc, char* argv[], Ort::Env& env) {
     usage();
     return -1;
   }
+  if (!benchmark_baseline_path.empty() && benchmark_report_path.empty()) {
+    fprintf(stderr, "'-B [baseline_file]' requires '-b [report_file]'\n");
+    usage();
+    return -1;
+  }
   argc -= optind;
   argv += optind;
   if (argc < 1) {
@@ -600,6 +630,28 @@ select from 'TF8', 'TF16', 'UINT8', 'FLOAT', 'ITENSOR'. \n)");
     }
     std::string res = stat.ToString();
     fwrite(res.c_str(), 1, res.size(), stdout);
+
+    if (!benchmark_report_path.empty()) {
+      const auto benchmarks = onnxruntime::test::CollectBenchmarks(test_env.GetTests(), test_env.GetResults());
+      st = onnxruntime::test::WriteBenchmarkReport(benchmark_report_path, benchmarks);
+      if (!st.IsOK()) {
+        fprintf(stderr, "%s\n", st.ErrorMessage().c_str());
+        return -1;
+      }
+      if (!benchmark_baseline_path.empty()) {
+        size_t num_regressions = 0;
+        st = onnxruntime::test::CompareWithBaselineReport(benchmark_baseline_path, benchmarks,
+                                                          benchmark_regression_threshold, num_regressions);
+        if (!st.IsOK()) {
+          fprintf(stderr, "%s\n", st.ErrorMessage().c_str());
+          return -1;
+        }
+        if (num_regressions > 0) {
+          fprintf(stderr, "%zu benchmark regressions against the baseline\n", num_regressions);
+          benchmark_regressed = true;
+        }
+      }
+    }
   }
 
   struct BrokenTest {
@@ -1031,6 +1083,9 @@ select from 'TF8', 'TF16', 'UINT8', 'FLOAT', 'ITENSOR'. \n)");
       result = -1;
     }
   }
+  if (benchmark_regressed) {
+    result = -1;
+  }
   return result;
 }
 #ifdef _WIN32
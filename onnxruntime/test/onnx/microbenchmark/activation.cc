@@ -4,6 +4,7 @@
 #include "core/session/ort_env.h"
 #include "core/graph/model.h"
 #include "core/graph/graph.h"
+#include "core/framework/config_options.h"
 #include "core/framework/ort_value_name_idx_map.h"
 #include "core/framework/fuse_nodes_funcs.h"
 #include "core/framework/data_transfer_manager.h"
@@ -69,7 +70,7 @@ struct KernelAndDef {
                   .SetDomain(domain)
                   .TypeConstraint("T", DataTypeImpl::GetTensorType<float>())
                   .Build();
-    OpKernelInfo info(main_node, *out.def, *out.a, {}, {}, {});
+    OpKernelInfo info(main_node, *out.def, *out.a, {}, {}, {}, {});
     out.kernel = std::make_unique<KernelType>(info);
     return out;
   }
@@ -0,0 +1,290 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+// Benchmarks of single node models that run the CPU kernels which dominate the inference time of transformer and
+// CNN models, with the shapes of those models. They include the session overhead of a Run call.
+
+#include <benchmark/benchmark.h>
+#include <core/graph/onnx_protobuf.h>
+#include <core/session/onnxruntime_c_api.h>
+
+#include <functional>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+extern OrtEnv* env;
+extern const OrtApi* g_ort;
+
+namespace {
+
+#define ORT_SKIP_ON_ERROR(expr)                                 \
+  do {                                                          \
+    OrtStatus* onnx_status = (expr);                            \
+    if (onnx_status != NULL) {                                  \
+      state.SkipWithError(g_ort->GetErrorMessage(onnx_status)); \
+      g_ort->ReleaseStatus(onnx_status);                        \
+      return;                                                   \
+    }                                                           \
+  } while (0)
+
+struct BenchInput {
+  std::string name;
+  std::vector<int64_t> shape;
+  std::vector<float> float_data;
+  std::vector<int64_t> int64_data;  // the data of an int64 input, float_data is empty
+};
+
+size_t ShapeSize(const std::vector<int64_t>& shape) {
+  return static_cast<size_t>(std::accumulate(shape.begin(), shape.end(), int64_t{1}, std::multiplies<int64_t>()));
+}
+
+BenchInput FloatInput(const std::string& name, const std::vector<int64_t>& shape) {
+  std::default_random_engine generator(static_cast<unsigned>(ShapeSize(shape)));
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  BenchInput input{name, shape, std::vector<float>(ShapeSize(shape)), {}};
+  for (auto& value : input.float_data) {
+    value = distribution(generator);
+  }
+  return input;
+}
+
+BenchInput Int64Input(const std::string& name, const std::vector<int64_t>& shape, int64_t max_value) {
+  std::default_random_engine generator(static_cast<unsigned>(ShapeSize(shape)));
+  std::uniform_int_distribution<int64_t> distribution(0, max_value - 1);
+  BenchInput input{name, shape, {}, std::vector<int64_t>(ShapeSize(shape))};
+  for (auto& value : input.int64_data) {
+    value = distribution(generator);
+  }
+  return input;
+}
+
+ONNX_NAMESPACE::AttributeProto IntAttribute(const std::string& name, int64_t value) {
+  ONNX_NAMESPACE::AttributeProto attribute;
+  attribute.set_name(name);
+  attribute.set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INT);
+  attribute.set_i(value);
+  return attribute;
+}
+
+ONNX_NAMESPACE::AttributeProto IntsAttribute(const std::string& name, const std::vector<int64_t>& values) {
+  ONNX_NAMESPACE::AttributeProto attribute;
+  attribute.set_name(name);
+  attribute.set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_INTS);
+  for (int64_t value : values) {
+    attribute.add_ints(value);
+  }
+  return attribute;
+}
+
+ONNX_NAMESPACE::AttributeProto StringAttribute(const std::string& name, const std::string& value) {
+  ONNX_NAMESPACE::AttributeProto attribute;
+  attribute.set_name(name);
+  attribute.set_type(ONNX_NAMESPACE::AttributeProto_AttributeType_STRING);
+  attribute.set_s(value);
+  return attribute;
+}
+
+void SetValueInfo(const std::string& name, ONNX_NAMESPACE::TensorProto_DataType type,
+                  const std::vector<int64_t>* shape, ONNX_NAMESPACE::ValueInfoProto& info) {
+  info.set_name(name);
+  auto* tensor_type = info.mutable_type()->mutable_tensor_type();
+  tensor_type->set_elem_type(type);
+  if (shape != nullptr) {
+    auto* tensor_shape = tensor_type->mutable_shape();
+    for (int64_t dim : *shape) {
+      tensor_shape->add_dim()->set_dim_value(dim);
+    }
+  }
+}
+
+// Creates a model of a single node with the given inputs, an empty name in node_inputs skips an optional input.
+// The node has the float output Y.
+std::string MakeSingleNodeModel(const std::string& op_type, const std::string& domain,
+                                const std::vector<std::string>& node_inputs, const std::vector<BenchInput>& inputs,
+                                const std::vector<ONNX_NAMESPACE::AttributeProto>& attributes) {
+  ONNX_NAMESPACE::ModelProto model;
+  model.set_ir_version(ONNX_NAMESPACE::Version::IR_VERSION);
+  auto* onnx_opset = model.add_opset_import();
+  onnx_opset->set_domain("");
+  onnx_opset->set_version(17);
+  if (!domain.empty()) {
+    auto* opset = model.add_opset_import();
+    opset->set_domain(domain);
+    opset->set_version(1);
+  }
+
+  auto* graph = model.mutable_graph();
+  graph->set_name(op_type);
+  auto* node = graph->add_node();
+  node->set_op_type(op_type);
+  node->set_domain(domain);
+  for (const auto& name : node_inputs) {
+    node->add_input(name);
+  }
+  node->add_output("Y");
+  for (const auto& attribute : attributes) {
+    *node->add_attribute() = attribute;
+  }
+
+  for (const auto& input : inputs) {
+    SetValueInfo(input.name,
+                 input.float_data.empty() ? ONNX_NAMESPACE::TensorProto_DataType_INT64
+                                          : ONNX_NAMESPACE::TensorProto_DataType_FLOAT,
+                 &input.shape, *graph->add_input());
+  }
+  SetValueInfo("Y", ONNX_NAMESPACE::TensorProto_DataType_FLOAT, nullptr, *graph->add_output());
+
+  return model.SerializeAsString();
+}
+
+void RunSingleNodeModel(benchmark::State& state, const std::string& model, std::vector<BenchInput>& inputs) {
+  OrtSessionOptions* session_options;
+  ORT_SKIP_ON_ERROR(g_ort->CreateSessionOptions(&session_options));
+  OrtSession* session;
+  ORT_SKIP_ON_ERROR(g_ort->CreateSessionFromArray(env, model.data(), model.size(), session_options, &session));
+  OrtMemoryInfo* memory_info;
+  ORT_SKIP_ON_ERROR(g_ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory_info));
+
+  std::vector<const char*> input_names;
+  std::vector<OrtValue*> input_values;
+  size_t bytes_processed = 0;
+  for (auto& input : inputs) {
+    OrtValue* value;
+    if (input.float_data.empty()) {
+      ORT_SKIP_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(
+          memory_info, input.int64_data.data(), input.int64_data.size() * sizeof(int64_t), input.shape.data(),
+          input.shape.size(), ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, &value));
+      bytes_processed += input.int64_data.size() * sizeof(int64_t);
+    } else {
+      ORT_SKIP_ON_ERROR(g_ort->CreateTensorWithDataAsOrtValue(
+          memory_info, input.float_data.data(), input.float_data.size() * sizeof(float), input.shape.data(),
+          input.shape.size(), ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &value));
+      bytes_processed += input.float_data.size() * sizeof(float);
+    }
+    input_names.push_back(input.name.c_str());
+    input_values.push_back(value);
+  }
+
+  const char* output_names[] = {"Y"};
+  for (auto _ : state) {
+    OrtValue* output = nullptr;
+    ORT_SKIP_ON_ERROR(g_ort->Run(session, nullptr, input_names.data(), input_values.data(), input_values.size(),
+                                 output_names, 1, &output));
+    g_ort->ReleaseValue(output);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(bytes_processed));
+
+  for (OrtValue* value : input_values) {
+    g_ort->ReleaseValue(value);
+  }
+  g_ort->ReleaseMemoryInfo(memory_info);
+  g_ort->ReleaseSession(session);
+  g_ort->ReleaseSessionOptions(session_options);
+}
+
+}  // namespace
+
+static void BM_LayerNormalization(benchmark::State& state) {
+  const int64_t batch = state.range(0);
+  const int64_t sequence = state.range(1);
+  const int64_t hidden = state.range(2);
+  std::vector<BenchInput> inputs{FloatInput("X", {batch, sequence, hidden}), FloatInput("Scale", {hidden}),
+                                 FloatInput("B", {hidden})};
+  const auto model = MakeSingleNodeModel("LayerNormalization", "", {"X", "Scale", "B"}, inputs,
+                                         {IntAttribute("axis", -1)});
+  RunSingleNodeModel(state, model, inputs);
+}
+
+BENCHMARK(BM_LayerNormalization)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgNames({"B", "S", "H"})
+    ->Args({1, 128, 768})    // BERT-base
+    ->Args({1, 384, 768})    // BERT-base
+    ->Args({8, 128, 1024})   // BERT-large
+    ->Args({1, 1, 768});     // GPT-2 decoding
+
+#ifndef DISABLE_CONTRIB_OPS
+static void BM_Attention(benchmark::State& state) {
+  const int64_t batch = state.range(0);
+  const int64_t sequence = state.range(1);
+  const int64_t hidden = state.range(2);
+  std::vector<BenchInput> inputs{FloatInput("input", {batch, sequence, hidden}),
+                                 FloatInput("weights", {hidden, 3 * hidden}), FloatInput("bias", {3 * hidden})};
+  const auto model = MakeSingleNodeModel("Attention", "com.microsoft", {"input", "weights", "bias"}, inputs,
+                                         {IntAttribute("num_heads", state.range(3))});
+  RunSingleNodeModel(state, model, inputs);
+}
+
+BENCHMARK(BM_Attention)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgNames({"B", "S", "H", "Heads"})
+    ->Args({1, 128, 768, 12})    // BERT-base
+    ->Args({1, 384, 768, 12})    // BERT-base
+    ->Args({8, 128, 1024, 16});  // BERT-large
+#endif
+
+static void BM_Gather(benchmark::State& state) {
+  const int64_t vocabulary = state.range(0);
+  const int64_t hidden = state.range(1);
+  std::vector<BenchInput> inputs{FloatInput("data", {vocabulary, hidden}),
+                                 Int64Input("indices", {1, state.range(2)}, vocabulary)};
+  const auto model = MakeSingleNodeModel("Gather", "", {"data", "indices"}, inputs, {IntAttribute("axis", 0)});
+  RunSingleNodeModel(state, model, inputs);
+}
+
+BENCHMARK(BM_Gather)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgNames({"Vocabulary", "H", "Tokens"})
+    ->Args({30522, 768, 128})  // BERT-base word embedding
+    ->Args({30522, 768, 384})  // BERT-base word embedding
+    ->Args({50257, 768, 1});   // GPT-2 decoding word embedding
+
+static void BM_Resize(benchmark::State& state, const char* mode) {
+  const int64_t channels = state.range(0);
+  const int64_t height = state.range(1);
+  const int64_t width = state.range(2);
+  const float scale = static_cast<float>(state.range(3));
+  std::vector<BenchInput> inputs{FloatInput("X", {1, channels, height, width}),
+                                 BenchInput{"scales", {4}, {1.0f, 1.0f, scale, scale}, {}}};
+  const auto model = MakeSingleNodeModel("Resize", "", {"X", "", "scales"}, inputs, {StringAttribute("mode", mode)});
+  RunSingleNodeModel(state, model, inputs);
+}
+
+static void ResizeSizes(benchmark::internal::Benchmark* b) {
+  b->UseRealTime()
+      ->Unit(benchmark::TimeUnit::kMicrosecond)
+      ->ArgNames({"C", "H", "W", "Scale"})
+      ->Args({256, 32, 32, 2})  // FPN top-down pathway
+      ->Args({128, 64, 64, 2})  // FPN top-down pathway
+      ->Args({21, 64, 64, 8});  // FCN upsampling of the scores
+}
+
+BENCHMARK_CAPTURE(BM_Resize, Nearest, "nearest")->Apply(ResizeSizes);
+BENCHMARK_CAPTURE(BM_Resize, Linear, "linear")->Apply(ResizeSizes);
+
+static void BM_ReduceMean(benchmark::State& state, std::vector<int64_t> axes) {
+  std::vector<BenchInput> inputs{FloatInput("X", {state.range(0), state.range(1), state.range(2), state.range(3)})};
+  const auto model = MakeSingleNodeModel("ReduceMean", "", {"X"}, inputs, {IntsAttribute("axes", axes)});
+  RunSingleNodeModel(state, model, inputs);
+}
+
+BENCHMARK_CAPTURE(BM_ReduceMean, LastAxis, std::vector<int64_t>{-1})
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgNames({"D0", "D1", "D2", "D3"})
+    ->Args({1, 1, 128, 768})  // BERT-base decomposed LayerNormalization
+    ->Args({1, 1, 384, 768})  // BERT-base decomposed LayerNormalization
+    ->Args({8, 1, 128, 1024});
+
+BENCHMARK_CAPTURE(BM_ReduceMean, Spatial, std::vector<int64_t>{2, 3})
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kMicrosecond)
+    ->ArgNames({"N", "C", "H", "W"})
+    ->Args({1, 2048, 7, 7})   // ResNet50 global pooling
+    ->Args({1, 1280, 7, 7})   // MobileNetV2 global pooling
+    ->Args({1, 64, 56, 56});  // squeeze and excitation
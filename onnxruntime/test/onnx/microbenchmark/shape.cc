@@ -0,0 +1,31 @@
+#include "core/framework/tensor_shape.h"
+#include "core/providers/cpu/math/matmul_helper.h"
+
+#include <benchmark/benchmark.h>
+
+using namespace onnxruntime;
+
+// Shape computation of the small MatMuls in control flow heavy graphs, which should not need any heap allocation
+// up to rank kTensorShapeSmallBufferElementsSize.
+static void BM_MatMulComputeHelper(benchmark::State& state) {
+  const int64_t batch = state.range(0);
+  const TensorShape left_shape{batch, 1, 4, 8};
+  const TensorShape right_shape{1, 3, 8, 4};
+
+  for (auto _ : state) {
+    MatMulComputeHelper helper;
+    auto status = helper.Compute(left_shape, right_shape);
+    benchmark::DoNotOptimize(helper.OutputShape());
+    if (!status.IsOK()) {
+      state.SkipWithError(status.ErrorMessage().c_str());
+      break;
+    }
+  }
+}
+
+BENCHMARK(BM_MatMulComputeHelper)
+    ->UseRealTime()
+    ->Unit(benchmark::TimeUnit::kNanosecond)
+    ->Arg(1)
+    ->Arg(2)
+    ->Arg(8);
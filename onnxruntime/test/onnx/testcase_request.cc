@@ -2,6 +2,7 @@
 // Licensed under the MIT License.
 
 #include "testcase_request.h"
+#include "benchmark_report.h"
 #include "dataitem_request.h"
 #include "TestCase.h"
 
@@ -36,7 +37,13 @@ bool TestCaseRequestContext::SetupSession() {
   ORT_TRY {
     const auto* test_case_name = test_case_.GetTestCaseName().c_str();
     session_opts_.SetLogId(test_case_name);
+    TIME_SPEC start_time, end_time, creation_time;
+    SetTimeSpecToZero(&creation_time);
+    GetMonotonicTimeCounter(&start_time);
     Ort::Session session{env_, test_case_.GetModelUrl(), session_opts_};
+    GetMonotonicTimeCounter(&end_time);
+    AccumulateTimeSpec(&creation_time, &start_time, &end_time);
+    result_->MutableBenchmark().session_creation_seconds = TimeSpecToSeconds(&creation_time);
     session_ = std::move(session);
     LOGF_DEFAULT(INFO, "Testing %s\n", test_case_name);
     return true;
@@ -123,6 +130,7 @@ void TestCaseRequestContext::OnDataTaskComplete(size_t task_id, EXECUTE_RESULT r
   TIME_SPEC zero;
   SetTimeSpecToZero(&zero);
   AccumulateTimeSpec(&test_case_time_, &zero, &spent_time);
+  RecordRunTime(spent_time);
   result_->SetResult(task_id, result);
 
   auto next_to_run = data_tasks_started_.fetch_add(1, std::memory_order_relaxed);
@@ -168,6 +176,7 @@ void TestCaseRequestContext::RunSequentially(size_t repeat_count) {
       auto result = DataTaskRequestContext::Run(test_case_, session_, &allocator_, idx_data);
       result_->SetResult(idx_data, result.first);
       AccumulateTimeSpec(&test_case_time_, &zero, &result.second);
+      RecordRunTime(result.second);
     }
   }
 
@@ -181,8 +190,22 @@ void TestCaseRequestContext::Wait() const {
   }
 }
 
+void TestCaseRequestContext::RecordRunTime(const TIME_SPEC& spent_time) {
+  const double seconds = TimeSpecToSeconds(&spent_time);
+  std::lock_guard<std::mutex> g(mut_);
+  auto& benchmark = result_->MutableBenchmark();
+  if (!first_run_recorded_) {
+    benchmark.first_run_seconds = seconds;
+    first_run_recorded_ = true;
+  } else {
+    benchmark.steady_state_total_seconds += seconds;
+    ++benchmark.steady_state_runs;
+  }
+}
+
 void TestCaseRequestContext::CalculateAndLogStats() const {
   result_->SetSpentTime(test_case_time_);
+  result_->MutableBenchmark().peak_working_set_size = GetPeakWorkingSetSize();
   const auto& test_case_name = test_case_.GetTestCaseName();
   const std::vector<EXECUTE_RESULT>& er = result_->GetExcutionResult();
   for (size_t i = 0; i != er.size(); ++i) {
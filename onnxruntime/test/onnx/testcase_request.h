@@ -97,6 +97,9 @@ class TestCaseRequestContext {
   void OnDataTaskComplete(size_t task_id, EXECUTE_RESULT result, const TIME_SPEC& spent_time);
   void OnTestCaseComplete();
 
+  // Adds the time of a Session::Run to the benchmark of the test case
+  void RecordRunTime(const TIME_SPEC& spent_time);
+
   void CalculateAndLogStats() const;
 
   Callback cb_;
@@ -116,6 +119,7 @@ class TestCaseRequestContext {
   mutable std::mutex mut_;
   mutable std::condition_variable cond_;
   mutable bool finished_ = false;
+  bool first_run_recorded_ = false;
 };
 
 }  //namespace test
@@ -39,6 +39,7 @@ Status TestEnv::Run(size_t parallel_models, int concurrent_runs, size_t repeat_c
   }
 
   CalculateStats(results);
+  results_ = std::move(results);
 
   return Status::OK();
 }
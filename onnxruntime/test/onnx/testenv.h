@@ -3,6 +3,7 @@
 
 #pragma once
 #include <atomic>
+#include <memory>
 #include <vector>
 #include <core/common/common.h>
 
@@ -65,6 +66,13 @@ class TestEnv {
     return tests_;
   }
 
+  /// <summary>
+  /// Results of the last Run, one per test case in the order of GetTests(). A result is null if it is missing.
+  /// </summary>
+  const std::vector<std::shared_ptr<TestCaseResult>>& GetResults() const {
+    return results_;
+  }
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(TestEnv);
 
  private:
@@ -74,5 +82,6 @@ class TestEnv {
   const Ort::SessionOptions& so_;
   PThreadPool tp_;
   std::vector<ITestCase*> tests_;
+  std::vector<std::shared_ptr<TestCaseResult>> results_;
   TestResultStat& stat_;
 };
@@ -5,6 +5,7 @@
 #pragma warning(disable : 4244)
 #endif
 
+#include <numeric>
 #include <random>
 #include "core/graph/onnx_protobuf.h"
 
@@ -35,7 +36,9 @@
 #include "core/optimizer/div_mul_fusion.h"
 #include "core/optimizer/dropout_elimination.h"
 #include "core/optimizer/dynamic_quantize_matmul_fusion.h"
+#include "core/optimizer/elementwise_chain_fusion.h"
 #include "core/optimizer/embed_layer_norm_fusion.h"
+#include "core/optimizer/embedding_bag_fusion.h"
 #include "core/optimizer/expand_elimination.h"
 #include "core/optimizer/fast_gelu_fusion.h"
 #include "core/optimizer/gather_fusion.h"
@@ -52,12 +55,15 @@
 #include "core/optimizer/initializer.h"
 #include "core/optimizer/isinf_reducesum_fusion.h"
 #include "core/optimizer/layer_norm_fusion.h"
+#include "core/optimizer/loop_invariant_code_motion.h"
 #include "core/optimizer/matmul_add_fusion.h"
+#include "core/optimizer/matmul_float8_fusion.h"
 #include "core/optimizer/matmul_integer_to_float.h"
 #include "core/optimizer/matmul_scale_fusion.h"
 #include "core/optimizer/matmul_transpose_fusion.h"
 #include "core/optimizer/noop_elimination.h"
 #include "core/optimizer/not_where_fusion.h"
+#include "core/optimizer/packed_sequence_transformer.h"
 #include "core/optimizer/propagate_cast_ops.h"
 #include "core/optimizer/quick_gelu_fusion.h"
 #include "core/optimizer/relu_clip_fusion.h"
@@ -65,7 +71,9 @@
 #include "core/optimizer/rule_based_graph_transformer.h"
 #include "core/optimizer/skip_layer_norm_fusion.h"
 #include "core/optimizer/slice_elimination.h"
+#include "core/optimizer/tensor_parallel_transformer.h"
 #include "core/optimizer/unsqueeze_elimination.h"
+#include "core/optimizer/zipmap_elimination.h"
 #include "core/optimizer/utils.h"
 #include "core/platform/env.h"
 #include "core/session/inference_session.h"
@@ -96,6 +104,117 @@ namespace test {
 
 #define MODEL_FOLDER ORT_TSTR("testdata/transform/")
 
+// Counts how often it is applied. Optionally removes the first Identity node it finds.
+class CountingGraphTransformer : public GraphTransformer {
+ public:
+  CountingGraphTransformer(const std::string& name, InlinedHashSet<std::string_view> target_op_types,
+                           bool remove_identity = false)
+      : GraphTransformer(name), target_op_types_(std::move(target_op_types)), remove_identity_(remove_identity) {}
+
+  InlinedHashSet<std::string_view> TargetOpTypes() const override { return target_op_types_; }
+
+  int NumApplied() const { return num_applied_; }
+
+ private:
+  Status ApplyImpl(Graph& graph, bool& modified, int /*graph_level*/, const logging::Logger& logger) const override {
+    ++num_applied_;
+    if (remove_identity_) {
+      for (auto& node : graph.Nodes()) {
+        if (node.OpType() == "Identity" && graph_utils::CanRemoveNode(graph, node, logger)) {
+          modified = graph_utils::RemoveNode(graph, node);
+          break;
+        }
+      }
+    }
+    return Status::OK();
+  }
+
+  const InlinedHashSet<std::string_view> target_op_types_;
+  const bool remove_identity_;
+  mutable int num_applied_ = 0;
+};
+
+TEST_F(GraphTransformationTests, TransformersOnlyReappliedAfterRelevantModifications) {
+  Model model("ReapplyTransformersTest", false, ModelMetaData(), PathString(), IOnnxRuntimeOpSchemaRegistryList(),
+              {{kOnnxDomain, 12}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  // X -> Identity -> Neg -> Y and an unrelated X2 -> Relu -> Y2
+  auto& x = graph.GetOrCreateNodeArg("X", &float_tensor_type);
+  auto& identity_out = graph.GetOrCreateNodeArg("identity_out", &float_tensor_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_tensor_type);
+  auto& x2 = graph.GetOrCreateNodeArg("X2", &float_tensor_type);
+  auto& y2 = graph.GetOrCreateNodeArg("Y2", &float_tensor_type);
+  graph.AddNode("identity", "Identity", "", {&x}, {&identity_out});
+  graph.AddNode("neg", "Neg", "", {&identity_out}, {&y});
+  graph.AddNode("relu", "Relu", "", {&x2}, {&y2});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  const uint64_t epoch = graph.ModificationEpoch();
+  auto relu_transformer = std::make_unique<CountingGraphTransformer>("ReluTransformer",
+                                                                     InlinedHashSet<std::string_view>{"Relu"});
+  auto identity_remover = std::make_unique<CountingGraphTransformer>("IdentityRemover",
+                                                                     InlinedHashSet<std::string_view>{}, true);
+  auto any_op_transformer = std::make_unique<CountingGraphTransformer>("AnyOpTransformer",
+                                                                       InlinedHashSet<std::string_view>{});
+  const auto* relu_transformer_ptr = relu_transformer.get();
+  const auto* identity_remover_ptr = identity_remover.get();
+  const auto* any_op_transformer_ptr = any_op_transformer.get();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(relu_transformer), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(identity_remover), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::move(any_op_transformer), TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  ASSERT_EQ(CountOpsInGraph(graph)["Identity"], 0);
+  ASSERT_GT(graph.ModificationEpoch(), epoch);
+  EXPECT_TRUE(graph.IsOpTypeModifiedSince("Identity", epoch));
+  EXPECT_TRUE(graph.IsOpTypeModifiedSince("Neg", epoch));
+  EXPECT_FALSE(graph.IsOpTypeModifiedSince("Relu", epoch));
+
+  // the Identity removal doesn't affect Relu nodes, and AnyOpTransformer already ran after it in the first step.
+  // only IdentityRemover is applied again as it modified the graph itself.
+  EXPECT_EQ(relu_transformer_ptr->NumApplied(), 1);
+  EXPECT_EQ(identity_remover_ptr->NumApplied(), 2);
+  EXPECT_EQ(any_op_transformer_ptr->NumApplied(), 1);
+}
+
+TEST_F(GraphTransformationTests, GraphTransformerStats) {
+  constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "abs-id-max.onnx";
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger_));
+  Graph& graph = model->MainGraph();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<CountingGraphTransformer>("IdentityRemover", InlinedHashSet<std::string_view>{}, true),
+      TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<CountingGraphTransformer>("NoOpTransformer", InlinedHashSet<std::string_view>{}),
+      TransformerLevel::Level2));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+
+  const auto& stats = graph_transformation_mgr.GetStats();
+  ASSERT_EQ(stats.size(), 2u);
+
+  EXPECT_EQ(stats[0].name, "IdentityRemover");
+  EXPECT_EQ(stats[0].level, TransformerLevel::Level1);
+  EXPECT_EQ(stats[0].num_applied, 2u);
+  EXPECT_EQ(stats[0].num_modified, 1u);
+  EXPECT_EQ(stats[0].num_nodes_added, 0u);
+  EXPECT_EQ(stats[0].num_nodes_removed, 1u);
+
+  // Level2 wasn't applied
+  EXPECT_EQ(stats[1].name, "NoOpTransformer");
+  EXPECT_EQ(stats[1].num_applied, 0u);
+  EXPECT_EQ(stats[1].duration.count(), 0);
+}
+
 TEST_F(GraphTransformationTests, IdentityElimination) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "abs-id-max.onnx";
   std::shared_ptr<Model> model;
@@ -667,6 +786,125 @@ TEST_F(GraphTransformationTests, ConstantFoldingSubgraph) {
       << "Constant folding should have been able to remove the Add node in both subgraphs";
 }
 
+TEST_F(GraphTransformationTests, LoopInvariantCodeMotion) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  TypeProto int64_scalar_type;
+  int64_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+  int64_scalar_type.mutable_tensor_type()->mutable_shape();
+  TypeProto bool_scalar_type;
+  bool_scalar_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  bool_scalar_type.mutable_tensor_type()->mutable_shape();
+
+  // the body computes x_out = x_in + (outer * outer), where outer is a value of the main graph
+  GraphProto body_proto;
+  {
+    Model model("LoopInvariantCodeMotion_body", false, ModelMetaData(), PathString(),
+                IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {}, *logger_);
+    auto& body = model.MainGraph();
+    auto& iter_num = body.GetOrCreateNodeArg("iter_num", &int64_scalar_type);
+    auto& cond_in = body.GetOrCreateNodeArg("cond_in", &bool_scalar_type);
+    auto& x_in = body.GetOrCreateNodeArg("x_in", &float_tensor_type);
+    auto& outer = body.GetOrCreateNodeArg("outer", &float_tensor_type);
+    body.AddOuterScopeNodeArg("outer");
+
+    auto& invariant = body.GetOrCreateNodeArg("invariant", &float_tensor_type);
+    auto& cond_out = body.GetOrCreateNodeArg("cond_out", &bool_scalar_type);
+    auto& x_out = body.GetOrCreateNodeArg("x_out", &float_tensor_type);
+    body.AddNode("invariant_mul", "Mul", "Loop invariant.", {&outer, &outer}, {&invariant});
+    body.AddNode("add", "Add", "Depends on the iteration.", {&x_in, &invariant}, {&x_out});
+    body.AddNode("cond", "Identity", "Loop condition.", {&cond_in}, {&cond_out});
+    body.SetInputs({&iter_num, &cond_in, &x_in});
+    body.SetOutputs({&cond_out, &x_out});
+    ASSERT_STATUS_OK(body.Resolve());
+    body_proto = body.ToGraphProto();
+  }
+
+  Model model("LoopInvariantCodeMotion_main_graph", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+  auto& trip_count = graph.GetOrCreateNodeArg("trip_count", &int64_scalar_type);
+  auto& cond = graph.GetOrCreateNodeArg("cond", &bool_scalar_type);
+  auto& x = graph.GetOrCreateNodeArg("x", &float_tensor_type);
+  auto& outer = graph.GetOrCreateNodeArg("outer", &float_tensor_type);
+  auto& loop_out = graph.GetOrCreateNodeArg("loop_out", &float_tensor_type);
+  auto& loop_node = graph.AddNode("loop", "Loop", "Loop node", {&trip_count, &cond, &x}, {&loop_out});
+  loop_node.AddAttribute("body", body_proto);
+  graph.SetInputs({&trip_count, &cond, &x, &outer});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<LoopInvariantCodeMotion>(),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  // the Mul moved to the main graph and the Loop reads its output as an implicit input
+  auto op_to_count = CountOpsInGraph(graph, false);
+  EXPECT_EQ(op_to_count["Mul"], 1);
+  op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Mul"], 1);
+  EXPECT_EQ(op_to_count["Add"], 1);
+
+  const Node& mul_node = *std::find_if(graph.Nodes().begin(), graph.Nodes().end(),
+                                       [](const Node& node) { return node.OpType() == "Mul"; });
+  const auto& implicit_inputs = loop_node.ImplicitInputDefs();
+  EXPECT_TRUE(std::any_of(implicit_inputs.begin(), implicit_inputs.end(),
+                          [](const NodeArg* node_arg) { return node_arg->Name() == "invariant"; }));
+  EXPECT_EQ(mul_node.GetOutputEdgesCount(), 1u);
+}
+
+TEST_F(GraphTransformationTests, LoopInvariantCodeMotion_IfReusesOuterValue) {
+  TypeProto float_tensor_type;
+  float_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+  float_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(4);
+  TypeProto bool_tensor_type;
+  bool_tensor_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+  bool_tensor_type.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+  // the branch computes outer * outer, which the main graph computes too
+  GraphProto branch_proto;
+  {
+    Model model("LoopInvariantCodeMotion_branch", false, ModelMetaData(), PathString(),
+                IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {}, *logger_);
+    auto& branch = model.MainGraph();
+    auto& outer = branch.GetOrCreateNodeArg("outer", &float_tensor_type);
+    branch.AddOuterScopeNodeArg("outer");
+    auto& branch_out = branch.GetOrCreateNodeArg("branch_out", &float_tensor_type);
+    branch.AddNode("branch_mul", "Mul", "Same as the main graph Mul.", {&outer, &outer}, {&branch_out});
+    ASSERT_STATUS_OK(branch.Resolve());
+    branch_proto = branch.ToGraphProto();
+  }
+
+  Model model("LoopInvariantCodeMotion_main_graph", false, ModelMetaData(), PathString(),
+              IOnnxRuntimeOpSchemaRegistryList(), {{kOnnxDomain, 13}}, {}, *logger_);
+  auto& graph = model.MainGraph();
+  auto& cond = graph.GetOrCreateNodeArg("cond", &bool_tensor_type);
+  auto& outer = graph.GetOrCreateNodeArg("outer", &float_tensor_type);
+  auto& square = graph.GetOrCreateNodeArg("square", &float_tensor_type);
+  auto& if_out = graph.GetOrCreateNodeArg("if_out", &float_tensor_type);
+  graph.AddNode("mul", "Mul", "Main graph Mul.", {&outer, &outer}, {&square});
+  auto& if_node = graph.AddNode("if", "If", "If node", {&cond}, {&if_out});
+  if_node.AddAttribute("then_branch", branch_proto);
+  if_node.AddAttribute("else_branch", branch_proto);
+  graph.SetInputs({&cond, &outer});
+  graph.SetOutputs({&square, &if_out});
+  ASSERT_STATUS_OK(graph.Resolve());
+  ASSERT_EQ(CountOpsInGraph(graph)["Mul"], 3);
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(std::make_unique<LoopInvariantCodeMotion>(),
+                                                     TransformerLevel::Level1));
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level1, *logger_));
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  // the branches are not moved out of the If but read the value of the main graph Mul
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Mul"], 1);
+  EXPECT_EQ(op_to_count["Identity"], 2);
+}
+
 TEST_F(GraphTransformationTests, ConstantFoldingWithShapeToInitializer) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "fusion/constant_folding_with_shape_to_initializer.onnx";
   std::shared_ptr<Model> model;
@@ -826,6 +1064,78 @@ TEST_F(GraphTransformationTests, ConstantFoldingAShapeNodeDeepInTheGraph) {
   ASSERT_TRUE(op_to_count.size() == 0);
 }
 
+TEST_F(GraphTransformationTests, ConstantFoldingSharesIdenticalOutputs) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    const std::vector<float> data{1.f, 2.f, 3.f, 4.f, 5.f, 6.f};
+    auto* input_arg = builder.MakeInput<float>({{2, 3}});
+    auto* add1_out = builder.MakeIntermediate();
+    auto* add2_out = builder.MakeIntermediate();
+    builder.AddNode("Add", {builder.MakeInitializer<float>({2, 3}, data), builder.MakeInitializer<float>({2, 3}, data)},
+                    {add1_out});
+    builder.AddNode("Add", {builder.MakeInitializer<float>({2, 3}, data), builder.MakeInitializer<float>({2, 3}, data)},
+                    {add2_out});
+    builder.AddNode("Mul", {input_arg, add1_out}, {builder.MakeOutput()});
+    builder.AddNode("Mul", {input_arg, add2_out}, {builder.MakeOutput()});
+  };
+
+  auto pre_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Add"] == 2);
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [](Graph& graph) {
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Add"] == 0);
+    // both Mul nodes consume the same folded initializer
+    InlinedHashSet<std::string> mul_inputs;
+    for (const auto& node : graph.Nodes()) {
+      mul_inputs.insert(node.InputDefs()[1]->Name());
+    }
+    TEST_RETURN_IF_NOT(mul_inputs.size() == 1);
+    TEST_RETURN_IF_NOT(graph.GetAllInitializedTensors().size() == 1);
+    return Status::OK();
+  };
+
+  std::unique_ptr<CPUExecutionProvider> e =
+      std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_,
+                                        std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, ConstantFoldingSkipsLargeOutputGrowth) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({{512, 1024}});
+    auto* expand_out = builder.MakeIntermediate();
+    builder.AddNode("Expand", {builder.MakeScalarInitializer<float>(1.f),
+                               builder.MakeInitializer<int64_t>({2}, {512, 1024})},
+                    {expand_out});
+    builder.AddNode("Add", {input_arg, expand_out}, {builder.MakeOutput()});
+  };
+
+  auto check_expand_count = [](int expected_count) {
+    return [expected_count](Graph& graph) {
+      TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Expand"] == expected_count);
+      return Status::OK();
+    };
+  };
+
+  std::unique_ptr<CPUExecutionProvider> e =
+      std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
+
+  // the 2MB output of Expand is folded by default
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_,
+                                        std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/),
+                                        TransformerLevel::Level1, 1, check_expand_count(1), check_expand_count(0)));
+
+  ConstantFoldingOptions options;
+  options.max_output_growth_ratio = 4.f;
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_,
+                                        std::make_unique<ConstantFolding>(*e.get(), false /*skip_dequantize_linear*/,
+                                                                          InlinedHashSet<std::string_view>{},
+                                                                          InlinedHashSet<std::string>{}, options),
+                                        TransformerLevel::Level1, 1, check_expand_count(1), check_expand_count(1)));
+}
+
 // Check transformations in the case of a subgraph with constant inputs.
 TEST_F(GraphTransformationTests, SubgraphWithConstantInputs) {
   constexpr const ORTCHAR_T* model_uri = MODEL_FOLDER "constant-subgraph.onnx";
@@ -3540,6 +3850,60 @@ TEST_F(GraphTransformationTests, BiasGeluSwitchedInputOrder) {
   EXPECT_EQ(ret.first, COMPARE_RESULT::SUCCESS) << ret.second;
 }
 
+// Test Relu(X + B) * Sigmoid(X) -> FusedElementwise
+TEST_F(GraphTransformationTests, ElementwiseChainFusion) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 4, 64}, -1.f, 1.f);
+    auto* add_out = builder.MakeIntermediate();
+    auto* relu_out = builder.MakeIntermediate();
+    auto* sigmoid_out = builder.MakeIntermediate();
+    builder.AddNode("Add", {input_arg, builder.MakeInitializer<float>({64}, -1.f, 1.f)}, {add_out});
+    builder.AddNode("Relu", {add_out}, {relu_out});
+    builder.AddNode("Mul", {relu_out, sigmoid_out}, {builder.MakeOutput()});
+    builder.AddNode("Sigmoid", {input_arg}, {sigmoid_out});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.FusedElementwise"], 1);
+    EXPECT_EQ(op_to_count["Add"], 0);
+    EXPECT_EQ(op_to_count["Relu"], 0);
+    EXPECT_EQ(op_to_count["Mul"], 0);
+    // Sigmoid does not feed the next node of the chain so it stays as an input of the fused node
+    EXPECT_EQ(op_to_count["Sigmoid"], 1);
+  };
+
+  auto add_session_options = [](SessionOptions& session_options) {
+    ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(kOrtSessionOptionsEnableElementwiseChainFusion,
+                                                                   "1"));
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13,
+                    1e-5 /*per_sample_tolerance*/, 1e-5 /*relative_per_sample_tolerance*/, nullptr,
+                    add_session_options);
+}
+
+// The intermediate result of the chain is also used by another node so nothing is fused
+TEST_F(GraphTransformationTests, ElementwiseChainFusion_IntermediateWithTwoConsumers) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 64}, -1.f, 1.f);
+    auto* add_out = builder.MakeIntermediate();
+    builder.AddNode("Add", {input_arg, builder.MakeScalarInitializer<float>(0.5f)}, {add_out});
+    builder.AddNode("Relu", {add_out}, {builder.MakeOutput()});
+    builder.AddNode("Tanh", {add_out}, {builder.MakeOutput()});
+  };
+
+  auto check_graph = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.FusedElementwise"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Add"] == 1);
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<ElementwiseChainFusion>(),
+                                        TransformerLevel::Level2, 1, check_graph, check_graph));
+}
+
 static void VerifyGeluApproximation(bool is_enabled, SessionOptions& session_options) {
   std::unique_ptr<CPUExecutionProvider> e =
       std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo());
@@ -4017,6 +4381,260 @@ TEST_F(GraphTransformationTests, QuickGelu) {
   }
 }
 
+TEST_F(GraphTransformationTests, PackedSequenceTransformer) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 4, 8}, -1.f, 1.f);
+    auto* mask_arg = builder.MakeInput<int32_t>({2}, {3, 1});
+    auto* attention_out = builder.MakeIntermediate();
+    auto* matmul_out_0 = builder.MakeIntermediate();
+    auto* skip_out_0 = builder.MakeIntermediate();
+    auto* matmul_out_1 = builder.MakeIntermediate();
+    auto* gelu_out = builder.MakeIntermediate();
+    auto* matmul_out_2 = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    auto& attention = builder.AddNode("Attention",
+                                      {input_arg, builder.MakeInitializer<float>({8, 24}, -1.f, 1.f),
+                                       builder.MakeInitializer<float>({24}, -1.f, 1.f), mask_arg},
+                                      {attention_out}, kMSDomain);
+    attention.AddAttribute("num_heads", static_cast<int64_t>(2));
+    builder.AddNode("MatMul", {attention_out, builder.MakeInitializer<float>({8, 8}, -1.f, 1.f)}, {matmul_out_0});
+    builder.AddNode("SkipLayerNormalization",
+                    {matmul_out_0, input_arg, builder.MakeInitializer<float>({8}, -1.f, 1.f),
+                     builder.MakeInitializer<float>({8}, -1.f, 1.f)},
+                    {skip_out_0}, kMSDomain);
+    builder.AddNode("MatMul", {skip_out_0, builder.MakeInitializer<float>({8, 16}, -1.f, 1.f)}, {matmul_out_1});
+    builder.AddNode("FastGelu", {matmul_out_1, builder.MakeInitializer<float>({16}, -1.f, 1.f)}, {gelu_out},
+                    kMSDomain);
+    builder.AddNode("MatMul", {gelu_out, builder.MakeInitializer<float>({16, 8}, -1.f, 1.f)}, {matmul_out_2});
+    builder.AddNode("SkipLayerNormalization",
+                    {matmul_out_2, skip_out_0, builder.MakeInitializer<float>({8}, -1.f, 1.f),
+                     builder.MakeInitializer<float>({8}, -1.f, 1.f)},
+                    {output_arg}, kMSDomain);
+  };
+
+  auto assign_cuda = [](Graph& graph) {
+    for (auto& node : graph.Nodes()) {
+      node.SetExecutionProviderType(kCudaExecutionProvider);
+    }
+    return Status::OK();
+  };
+
+  // The attention output and the skip input of the first SkipLayerNormalization are packed, and only the graph
+  // output is restored.
+  auto post_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.RemovePadding"] == 2);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.RestorePadding"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.Attention"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 3);
+    for (auto& node : graph.Nodes()) {
+      TEST_RETURN_IF_NOT(node.GetExecutionProviderType() == kCudaExecutionProvider);
+      if (node.OpType() == "MatMul" || node.OpType() == "FastGelu" || node.OpType() == "SkipLayerNormalization") {
+        const auto* shape = node.OutputDefs()[0]->Shape();
+        TEST_RETURN_IF_NOT(shape != nullptr && shape->dim_size() == 2);
+      }
+    }
+
+    const Node* output_producer = graph.GetProducerNode(graph.GetOutputs()[0]->Name());
+    TEST_RETURN_IF_NOT(output_producer != nullptr && output_producer->OpType() == "RestorePadding");
+    const auto* output_shape = graph.GetOutputs()[0]->Shape();
+    TEST_RETURN_IF_NOT(output_shape != nullptr && output_shape->dim_size() == 3);
+    return Status::OK();
+  };
+
+  const InlinedHashSet<std::string_view> cuda_ep = {kCudaExecutionProvider};
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_,
+                                        std::make_unique<PackedSequenceTransformer>(cuda_ep),
+                                        TransformerLevel::Level2, 1, assign_cuda, post_graph_checker));
+
+  // Nothing is packed when the nodes are not assigned to CUDA.
+  auto unchanged_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.RemovePadding"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.RestorePadding"] == 0);
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_,
+                                        std::make_unique<PackedSequenceTransformer>(cuda_ep),
+                                        TransformerLevel::Level2, 1, [](Graph&) { return Status::OK(); },
+                                        unchanged_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, TensorParallelTransformer) {
+  std::vector<float> qkv_bias(24);
+  std::iota(qkv_bias.begin(), qkv_bias.end(), 0.f);
+
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({2, 4, 8}, -1.f, 1.f);
+    auto* mask_arg = builder.MakeInput<int32_t>({2}, {3, 1});
+    auto* attention_out = builder.MakeIntermediate();
+    auto* matmul_out_0 = builder.MakeIntermediate();
+    auto* skip_out_0 = builder.MakeIntermediate();
+    auto* matmul_out_1 = builder.MakeIntermediate();
+    auto* gelu_out = builder.MakeIntermediate();
+    auto* matmul_out_2 = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    auto& attention = builder.AddNode("Attention",
+                                      {input_arg, builder.MakeInitializer<float>({8, 24}, -1.f, 1.f),
+                                       builder.MakeInitializer<float>({24}, qkv_bias), mask_arg},
+                                      {attention_out}, kMSDomain);
+    attention.AddAttribute("num_heads", static_cast<int64_t>(2));
+    builder.AddNode("MatMul", {attention_out, builder.MakeInitializer<float>({8, 8}, -1.f, 1.f)}, {matmul_out_0});
+    builder.AddNode("SkipLayerNormalization",
+                    {matmul_out_0, input_arg, builder.MakeInitializer<float>({8}, -1.f, 1.f),
+                     builder.MakeInitializer<float>({8}, -1.f, 1.f)},
+                    {skip_out_0}, kMSDomain);
+    builder.AddNode("MatMul", {skip_out_0, builder.MakeInitializer<float>({8, 16}, -1.f, 1.f)}, {matmul_out_1});
+    builder.AddNode("FastGelu", {matmul_out_1, builder.MakeInitializer<float>({16}, -1.f, 1.f)}, {gelu_out},
+                    kMSDomain);
+    builder.AddNode("MatMul", {gelu_out, builder.MakeInitializer<float>({16, 8}, -1.f, 1.f)}, {matmul_out_2});
+    builder.AddNode("SkipLayerNormalization",
+                    {matmul_out_2, skip_out_0, builder.MakeInitializer<float>({8}, -1.f, 1.f),
+                     builder.MakeInitializer<float>({8}, -1.f, 1.f)},
+                    {output_arg}, kMSDomain);
+  };
+
+  auto assign_cuda = [](Graph& graph) {
+    for (auto& node : graph.Nodes()) {
+      node.SetExecutionProviderType(kCudaExecutionProvider);
+    }
+    return Status::OK();
+  };
+
+  auto initializer_dims = [](const Graph& graph, const NodeArg* arg) {
+    const ONNX_NAMESPACE::TensorProto* tensor = nullptr;
+    std::vector<int64_t> dims;
+    if (graph.GetInitializedTensor(arg->Name(), tensor)) {
+      dims.assign(tensor->dims().begin(), tensor->dims().end());
+    }
+    return dims;
+  };
+
+  // Rank 1 of 2 keeps the second head of the Attention node and the second half of the MLP.
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.AllReduce"] == 2);
+    TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 3);
+    for (auto& node : graph.Nodes()) {
+      const auto& inputs = node.InputDefs();
+      if (node.OpType() == "Attention") {
+        TEST_RETURN_IF_NOT(graph_utils::GetNodeAttribute(node, "num_heads")->i() == 1);
+        TEST_RETURN_IF_NOT(initializer_dims(graph, inputs[1]) == std::vector<int64_t>({8, 12}));
+
+        const ONNX_NAMESPACE::TensorProto* bias = nullptr;
+        TEST_RETURN_IF_NOT(graph.GetInitializedTensor(inputs[2]->Name(), bias));
+        Initializer bias_data(*bias, graph.ModelPath());
+        const std::vector<float> expected_bias = {4, 5, 6, 7, 12, 13, 14, 15, 20, 21, 22, 23};
+        TEST_RETURN_IF_NOT(std::vector<float>(bias_data.data<float>(), bias_data.data<float>() + bias_data.size()) ==
+                           expected_bias);
+      } else if (node.OpType() == "FastGelu") {
+        TEST_RETURN_IF_NOT(initializer_dims(graph, inputs[1]) == std::vector<int64_t>({8}));
+      } else if (node.OpType() == "MatMul") {
+        const auto dims = initializer_dims(graph, inputs[1]);
+        TEST_RETURN_IF_NOT(dims == std::vector<int64_t>({4, 8}) || dims == std::vector<int64_t>({8, 8}));
+        TEST_RETURN_IF_NOT(graph_utils::FindChildrenByType(node, "AllReduce").size() == 1 ||
+                           graph_utils::FindChildrenByType(node, "FastGelu").size() == 1);
+      } else if (node.OpType() == "AllReduce") {
+        TEST_RETURN_IF_NOT(graph_utils::FindChildrenByType(node, "SkipLayerNormalization").size() == 1);
+      }
+    }
+    return Status::OK();
+  };
+
+  const InlinedHashSet<std::string_view> cuda_ep = {kCudaExecutionProvider};
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_,
+                                        std::make_unique<TensorParallelTransformer>(1, 2, cuda_ep),
+                                        TransformerLevel::Level2, 1, assign_cuda, post_graph_checker));
+
+  // Nothing is sharded when the heads cannot be split evenly.
+  auto unchanged_graph_checker = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.AllReduce"] == 1);
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() == "Attention") {
+        TEST_RETURN_IF_NOT(graph_utils::GetNodeAttribute(node, "num_heads")->i() == 2);
+      }
+    }
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_,
+                                        std::make_unique<TensorParallelTransformer>(1, 4, cuda_ep),
+                                        TransformerLevel::Level2, 1, assign_cuda, unchanged_graph_checker));
+}
+
+TEST_F(GraphTransformationTests, MatMulFloat8Fusion) {
+  constexpr int64_t K = 16;
+  constexpr int64_t N = 32;
+  std::vector<uint8_t> weight(K * N);
+  std::iota(weight.begin(), weight.end(), static_cast<uint8_t>(0));
+
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<uint8_t>({2, 4, K}, 0, 0x7e);
+    auto* dq_a_out = builder.MakeIntermediate();
+    auto* dq_b_out = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    auto& dq_a = builder.AddNode("DequantizeFloat8",
+                                 {input_arg, builder.MakeScalarInitializer<MLFloat16>(MLFloat16(0.5f))},
+                                 {dq_a_out}, kMSDomain);
+    dq_a.AddAttribute("fp8_format", "E5M2");
+    builder.AddNode("DequantizeFloat8",
+                    {builder.MakeInitializer<uint8_t>({K, N}, weight),
+                     builder.MakeScalarInitializer<MLFloat16>(MLFloat16(0.25f))},
+                    {dq_b_out}, kMSDomain);
+    builder.AddNode("MatMul", {dq_a_out, dq_b_out}, {output_arg});
+  };
+
+  auto assign_cuda = [](Graph& graph) {
+    for (auto& node : graph.Nodes()) {
+      node.SetExecutionProviderType(kCudaExecutionProvider);
+    }
+    return Status::OK();
+  };
+
+  auto post_graph_checker = [&](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.DequantizeFloat8"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["MatMul"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.MatMulFloat8"] == 1);
+    for (auto& node : graph.Nodes()) {
+      if (node.OpType() != "MatMulFloat8") {
+        continue;
+      }
+      TEST_RETURN_IF_NOT(graph_utils::GetNodeAttribute(node, "fp8_format_a")->s() == "E5M2");
+      TEST_RETURN_IF_NOT(graph_utils::GetNodeAttribute(node, "fp8_format_b")->s() == "E4M3FN");
+      TEST_RETURN_IF_NOT(graph_utils::GetNodeAttribute(node, "dtype")->i() ==
+                         ONNX_NAMESPACE::TensorProto_DataType_FLOAT16);
+
+      const auto& inputs = node.InputDefs();
+      const ONNX_NAMESPACE::TensorProto* tensor = nullptr;
+      TEST_RETURN_IF_NOT(graph.GetInitializedTensor(inputs[1]->Name(), tensor));
+      TEST_RETURN_IF_NOT(std::vector<int64_t>(tensor->dims().begin(), tensor->dims().end()) ==
+                         std::vector<int64_t>({N, K}));
+      Initializer weight_transposed(*tensor, graph.ModelPath());
+      for (int64_t n = 0; n < N; ++n) {
+        for (int64_t k = 0; k < K; ++k) {
+          TEST_RETURN_IF_NOT(weight_transposed.data<uint8_t>()[n * K + k] == weight[k * N + n]);
+        }
+      }
+
+      TEST_RETURN_IF_NOT(graph.GetInitializedTensor(inputs[3]->Name(), tensor));
+      TEST_RETURN_IF_NOT(tensor->data_type() == ONNX_NAMESPACE::TensorProto_DataType_FLOAT);
+      TEST_RETURN_IF_NOT(*Initializer(*tensor, graph.ModelPath()).data<float>() == 0.25f);
+    }
+    return Status::OK();
+  };
+
+  const InlinedHashSet<std::string_view> cuda_ep = {kCudaExecutionProvider};
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 14, *logger_,
+                                        std::make_unique<MatMulFloat8Fusion>(cuda_ep),
+                                        TransformerLevel::Level2, 1, assign_cuda, post_graph_checker));
+}
+
 struct BiasSoftmaxFusionTester {
   std::shared_ptr<Model> p_model_;
   Status model_load_;
@@ -6330,5 +6948,125 @@ TEST_F(GraphTransformationTests, GatherToSliceFusion) {
   }
 }
 
+// Test Gather -> ReduceSum over the bag axis -> EmbeddingBag
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_ReduceSum) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({100, 16}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({4, 6}, static_cast<int64_t>(0), static_cast<int64_t>(99));
+    auto* gather_out = builder.MakeIntermediate();
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+    builder.AddNode("ReduceSum", {gather_out, builder.Make1DInitializer<int64_t>({1})}, {builder.MakeOutput()})
+        .AddAttribute("keepdims", static_cast<int64_t>(0));
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+    EXPECT_EQ(op_to_count["Gather"], 0);
+    EXPECT_EQ(op_to_count["ReduceSum"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 13,
+                    1e-5 /*per_sample_tolerance*/, 1e-5 /*relative_per_sample_tolerance*/);
+}
+
+// Test Gather -> ReduceMean with the axes attribute and keepdims -> EmbeddingBag
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_ReduceMeanKeepDims) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({50, 8}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({2, 3, 5}, static_cast<int64_t>(-50), static_cast<int64_t>(49));
+    auto* gather_out = builder.MakeIntermediate();
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+    builder.AddNode("ReduceMean", {gather_out}, {builder.MakeOutput()})
+        .AddAttribute("axes", std::vector<int64_t>{-2});
+  };
+
+  auto check_graph = [](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.EmbeddingBag"], 1);
+    EXPECT_EQ(op_to_count["Gather"], 0);
+    EXPECT_EQ(op_to_count["ReduceMean"], 0);
+  };
+
+  TransformerTester(build_test_case, check_graph, TransformerLevel::Level1, TransformerLevel::Level2, 12,
+                    1e-5 /*per_sample_tolerance*/, 1e-5 /*relative_per_sample_tolerance*/);
+}
+
+// The reduction is over the embedding dimension rather than the bag so nothing is fused
+TEST_F(GraphTransformationTests, EmbeddingBagFusion_ReduceOtherAxis) {
+  auto build_test_case = [](ModelTestBuilder& builder) {
+    auto* table_arg = builder.MakeInitializer<float>({50, 8}, -1.f, 1.f);
+    auto* indices_arg = builder.MakeInput<int64_t>({4, 5}, static_cast<int64_t>(0), static_cast<int64_t>(49));
+    auto* gather_out = builder.MakeIntermediate();
+    builder.AddNode("Gather", {table_arg, indices_arg}, {gather_out});
+    builder.AddNode("ReduceSum", {gather_out, builder.Make1DInitializer<int64_t>({2})}, {builder.MakeOutput()});
+  };
+
+  auto check_graph = [](Graph& graph) {
+    auto op_to_count = CountOpsInGraph(graph);
+    TEST_RETURN_IF_NOT(op_to_count["com.microsoft.EmbeddingBag"] == 0);
+    TEST_RETURN_IF_NOT(op_to_count["Gather"] == 1);
+    TEST_RETURN_IF_NOT(op_to_count["ReduceSum"] == 1);
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<EmbeddingBagFusion>(),
+                                        TransformerLevel::Level2, 1, check_graph, check_graph));
+}
+
+#if !defined(DISABLE_ML_OPS)
+namespace {
+// LinearClassifier -> ZipMap -> graph output, with the probabilities also returned if output_probabilities is set.
+void BuildZipMapTestCase(ModelTestBuilder& builder, bool output_probabilities) {
+  auto* input_arg = builder.MakeInput<float>({5, 2}, -1.f, 1.f);
+  auto* label_arg = builder.MakeOutput();
+  auto* probabilities_arg = output_probabilities ? builder.MakeOutput() : builder.MakeIntermediate();
+  auto& classifier = builder.AddNode("LinearClassifier", {input_arg}, {label_arg, probabilities_arg}, kMLDomain);
+  classifier.AddAttribute("coefficients", std::vector<float>{0.5f, -1.f, 1.f, 0.25f, -0.5f, 2.f});
+  classifier.AddAttribute("intercepts", std::vector<float>{0.1f, 0.2f, -0.3f});
+  classifier.AddAttribute("classlabels_ints", std::vector<int64_t>{7, 3, 5});
+  builder.AddNode("ZipMap", {probabilities_arg}, {builder.MakeOutput()}, kMLDomain)
+      .AddAttribute("classlabels_int64s", std::vector<int64_t>{7, 3, 5});
+}
+
+Status CheckZipMapOutputs(Graph& graph, bool zipmap_removed) {
+  auto op_to_count = CountOpsInGraph(graph);
+  TEST_RETURN_IF_NOT(op_to_count["ai.onnx.ml.ZipMap"] == (zipmap_removed ? 0 : 1));
+  const auto& outputs = graph.GetOutputs();
+  TEST_RETURN_IF_NOT(outputs.back()->TypeAsProto()->has_tensor_type() == zipmap_removed);
+  return Status::OK();
+}
+}  // namespace
+
+// The classifier writes the probabilities to the graph output of the ZipMap node
+TEST_F(GraphTransformationTests, ZipMapElimination) {
+  auto build_test_case = [](ModelTestBuilder& builder) { BuildZipMapTestCase(builder, false); };
+  auto pre_graph_checker = [](Graph& graph) { return CheckZipMapOutputs(graph, false); };
+  auto post_graph_checker = [](Graph& graph) {
+    ORT_RETURN_IF_ERROR(CheckZipMapOutputs(graph, true));
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Identity"] == 0);
+    TEST_RETURN_IF_NOT(graph.GetProducerNode(graph.GetOutputs().back()->Name())->OpType() == "LinearClassifier");
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<ZipMapElimination>(),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+}
+
+// The probabilities are a graph output too so the ZipMap node is replaced by an Identity node
+TEST_F(GraphTransformationTests, ZipMapElimination_ProbabilitiesOutput) {
+  auto build_test_case = [](ModelTestBuilder& builder) { BuildZipMapTestCase(builder, true); };
+  auto pre_graph_checker = [](Graph& graph) { return CheckZipMapOutputs(graph, false); };
+  auto post_graph_checker = [](Graph& graph) {
+    ORT_RETURN_IF_ERROR(CheckZipMapOutputs(graph, true));
+    TEST_RETURN_IF_NOT(CountOpsInGraph(graph)["Identity"] == 1);
+    return Status::OK();
+  };
+
+  ASSERT_STATUS_OK(TestGraphTransformer(build_test_case, 13, *logger_, std::make_unique<ZipMapElimination>(),
+                                        TransformerLevel::Level1, 1, pre_graph_checker, post_graph_checker));
+}
+#endif  // !defined(DISABLE_ML_OPS)
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -0,0 +1,128 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/framework/execution_providers.h"
+#include "core/framework/kernel_registry_manager.h"
+#include "core/graph/model.h"
+#include "core/optimizer/mixed_precision_transformer.h"
+#include "core/providers/cpu/cpu_execution_provider.h"
+#include "test/framework/test_utils.h"
+#include "test/test_environment.h"
+#include "gtest/gtest.h"
+#include "asserts.h"
+
+using namespace ONNX_NAMESPACE;
+
+namespace onnxruntime {
+namespace test {
+
+namespace {
+
+// Builds Y = Concat(Softmax(Transpose(Transpose(X))), W) with all the nodes assigned to the CPU execution provider.
+void BuildModel(Graph& graph, const std::vector<float>& w_values) {
+  TypeProto float_type;
+  float_type.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+
+  TensorProto w;
+  w.set_name("W");
+  w.set_data_type(TensorProto_DataType_FLOAT);
+  w.add_dims(2);
+  w.add_dims(3);
+  for (float value : w_values) {
+    w.add_float_data(value);
+  }
+  graph.AddInitializedTensor(w);
+
+  auto& x = graph.GetOrCreateNodeArg("X", &float_type);
+  auto& a = graph.GetOrCreateNodeArg("A", &float_type);
+  auto& b = graph.GetOrCreateNodeArg("B", &float_type);
+  auto& c = graph.GetOrCreateNodeArg("C", &float_type);
+  auto& y = graph.GetOrCreateNodeArg("Y", &float_type);
+  graph.AddNode("transpose1", "Transpose", "", {&x}, {&a});
+  graph.AddNode("transpose2", "Transpose", "", {&a}, {&b});
+  graph.AddNode("softmax", "Softmax", "", {&b}, {&c});
+  graph.AddNode("concat", "Concat", "", {&c, graph.GetNodeArg("W")}, {&y}).AddAttribute("axis", int64_t{0});
+  graph.SetInputs({&x});
+  graph.SetOutputs({&y});
+  ASSERT_STATUS_OK(graph.Resolve());
+
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCpuExecutionProvider);
+  }
+}
+
+void ApplyMixedPrecision(Graph& graph, const std::vector<std::string>& deny_ops = {}) {
+  ExecutionProviders execution_providers;
+  ASSERT_STATUS_OK(execution_providers.Add(kCpuExecutionProvider,
+                                           std::make_unique<CPUExecutionProvider>(CPUExecutionProviderInfo())));
+  KernelRegistryManager kernel_registry_manager;
+  ASSERT_STATUS_OK(kernel_registry_manager.RegisterKernels(execution_providers));
+
+  MixedPrecisionTransformer transformer{TensorProto_DataType_FLOAT16, {}, deny_ops, kernel_registry_manager,
+                                        {kCpuExecutionProvider}};
+  bool modified = false;
+  ASSERT_STATUS_OK(transformer.Apply(graph, modified, DefaultLoggingManager().DefaultLogger()));
+}
+
+int32_t GetElemType(const Graph& graph, const std::string& node_name, bool input) {
+  for (const auto& node : graph.Nodes()) {
+    if (node.Name() == node_name) {
+      const auto* type = (input ? node.InputDefs() : node.OutputDefs())[0]->TypeAsProto();
+      return type->tensor_type().elem_type();
+    }
+  }
+  return TensorProto_DataType_UNDEFINED;
+}
+
+}  // namespace
+
+TEST(MixedPrecisionTransformerTests, ConvertsAllowedNodes) {
+  Model model("MixedPrecision", false, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+  BuildModel(graph, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  ApplyMixedPrecision(graph);
+
+  // the Transpose nodes share one region, Softmax stays in float and Concat takes the converted W
+  EXPECT_EQ(GetElemType(graph, "transpose1", false), TensorProto_DataType_FLOAT16);
+  EXPECT_EQ(GetElemType(graph, "transpose2", true), TensorProto_DataType_FLOAT16);
+  EXPECT_EQ(GetElemType(graph, "softmax", true), TensorProto_DataType_FLOAT);
+  EXPECT_EQ(GetElemType(graph, "concat", false), TensorProto_DataType_FLOAT16);
+
+  // casts of X, of the Softmax input and output, and of Y
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Cast"], 4);
+  EXPECT_EQ(graph.GetConstantInitializer("W", false), nullptr);
+  ASSERT_EQ(graph.GetOutputs().size(), 1u);
+  EXPECT_EQ(graph.GetOutputs()[0]->TypeAsProto()->tensor_type().elem_type(), TensorProto_DataType_FLOAT);
+}
+
+TEST(MixedPrecisionTransformerTests, KeepsNodesWithFloat16OverflowInFloat) {
+  Model model("MixedPrecision", false, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+  BuildModel(graph, {1.f, 2.f, 3.f, 4.f, 5.f, -1e5f});
+  ApplyMixedPrecision(graph);
+
+  EXPECT_EQ(GetElemType(graph, "transpose1", false), TensorProto_DataType_FLOAT16);
+  EXPECT_EQ(GetElemType(graph, "concat", false), TensorProto_DataType_FLOAT);
+  EXPECT_NE(graph.GetConstantInitializer("W", false), nullptr);
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Cast"], 2);
+}
+
+TEST(MixedPrecisionTransformerTests, DenyOps) {
+  Model model("MixedPrecision", false, DefaultLoggingManager().DefaultLogger());
+  Graph& graph = model.MainGraph();
+  BuildModel(graph, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  ApplyMixedPrecision(graph, {"Transpose"});
+
+  EXPECT_EQ(GetElemType(graph, "transpose1", false), TensorProto_DataType_FLOAT);
+  EXPECT_EQ(GetElemType(graph, "transpose2", false), TensorProto_DataType_FLOAT);
+  EXPECT_EQ(GetElemType(graph, "concat", false), TensorProto_DataType_FLOAT16);
+
+  auto op_to_count = CountOpsInGraph(graph);
+  EXPECT_EQ(op_to_count["Cast"], 2);
+}
+
+}  // namespace test
+}  // namespace onnxruntime
@@ -6,6 +6,7 @@
 #include "core/mlas/inc/mlas.h"
 #include "core/session/environment.h"
 #include "core/session/inference_session.h"
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "test/compare_ortvalue.h"
 #include "test/test_environment.h"
 #include "test/framework/test_utils.h"
@@ -167,7 +168,8 @@ struct NchwcTestHelper {
 
 void NchwcOptimizerTester(const std::function<void(NchwcTestHelper& helper)>& build_test_case,
                           const std::function<void(InferenceSessionWrapper& session)>& check_nchwc_graph,
-                          int opset_version = 13) {
+                          int opset_version = 13,
+                          const std::function<void(SessionOptions&)>& add_session_options = {}) {
   // Ignore the test if NCHWc is not supported by the platform.
   if (MlasNchwcGetBlockSize() <= 1) {
     return;
@@ -190,6 +192,9 @@ void NchwcOptimizerTester(const std::function<void(NchwcTestHelper& helper)>& bu
     SessionOptions session_options;
     session_options.graph_optimization_level = level;
     session_options.session_logid = "NchwcOptimizerTests";
+    if (add_session_options) {
+      add_session_options(session_options);
+    }
     InferenceSessionWrapper session{session_options, GetEnvironment()};
     ASSERT_STATUS_OK(session.Load(model_data.data(), static_cast<int>(model_data.size())));
     ASSERT_STATUS_OK(session.Initialize());
@@ -407,6 +412,38 @@ TEST(NchwcOptimizerTests, ConvPointwise) {
   }
 }
 
+TEST(NchwcOptimizerTests, SkipUnprofitableRegions) {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape,
+                       bool skip_unprofitable_regions, int expected_nchwc_convs) {
+    auto build_test_case = [&](NchwcTestHelper& helper) {
+      auto* input_arg = helper.MakeInput<float>(input_shape);
+      auto* output_arg = helper.MakeOutput();
+      auto& conv_node = helper.AddConvNode(input_arg, output_arg, weights_shape);
+      conv_node.AddAttribute("pads", std::vector<int64_t>(4, weights_shape[2] / 2));
+    };
+
+    auto check_nchwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.nchwc.Conv"], expected_nchwc_convs);
+      EXPECT_EQ(op_to_count["Conv"], 1 - expected_nchwc_convs);
+    };
+
+    auto add_session_options = [&](SessionOptions& session_options) {
+      ASSERT_STATUS_OK(session_options.config_options.AddConfigEntry(
+          kOrtSessionOptionsNchwcSkipUnprofitableRegions, skip_unprofitable_regions ? "1" : "0"));
+    };
+
+    NchwcOptimizerTester(build_test_case, check_nchwc_graph, 13, add_session_options);
+  };
+
+  // the reorders of a small pointwise Conv cost more than the NCHWc Conv saves
+  test_case({1, 16, 8, 8}, {16, 16, 1, 1}, false, 1);
+  test_case({1, 16, 8, 8}, {16, 16, 1, 1}, true, 0);
+
+  // a larger 3x3 Conv is still converted
+  test_case({1, 32, 56, 56}, {64, 32, 3, 3}, true, 1);
+}
+
 TEST(NchwcOptimizerTests, ConvMaxPool) {
   auto build_test_case = [&](NchwcTestHelper& helper) {
     auto* input_arg = helper.MakeInput<float>({1, 48, 34, 34});
@@ -500,6 +500,84 @@ TEST(NhwcTransformerTests, ConvMixTensorRanks) {
                     TransformerLevel::Level3);
 }
 
+TEST(NhwcTransformerTests, ConvDepthwiseFloat) {
+  auto test_case = [&](int64_t channels, int64_t kernel, bool with_relu) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({1, channels, 13, 11}, -1.0f, 1.0f);
+      auto* conv_output_arg = with_relu ? builder.MakeIntermediate() : builder.MakeOutput();
+      auto* weight_arg = builder.MakeInitializer<float>({channels, 1, kernel, kernel}, -1.0f, 1.0f);
+      auto* bias_arg = builder.MakeInitializer<float>({channels}, -1.0f, 1.0f);
+
+      Node& conv_node = builder.AddNode("Conv", {input_arg, weight_arg, bias_arg}, {conv_output_arg});
+      conv_node.AddAttribute("group", channels);
+      conv_node.AddAttribute("pads", std::vector<int64_t>{kernel / 2, kernel / 2, kernel / 2, kernel / 2});
+      if (with_relu) {
+        builder.AddNode("Relu", {conv_output_arg}, {builder.MakeOutput()});
+      }
+    };
+
+    auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.NhwcConv"], 1);
+      EXPECT_EQ(op_to_count["Transpose"], 2);
+    };
+
+    TransformerTester(build_test_case,
+                      check_nhwc_graph,
+                      TransformerLevel::Level2,
+                      TransformerLevel::Level3,
+                      12, 1e-5, 1e-5,
+                      nullptr, {}, {"NchwcTransformer"});
+  };
+
+  test_case(19, 3, false);
+  test_case(32, 3, true);
+  test_case(24, 5, true);
+}
+
+TEST(NhwcTransformerTests, ConvInvertedBottleneckFloat) {
+  auto build_test_case = [&](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>({1, 16, 14, 14}, -1.0f, 1.0f);
+    auto* expand_output_arg = builder.MakeIntermediate();
+    auto* expand_relu_output_arg = builder.MakeIntermediate();
+    auto* depthwise_output_arg = builder.MakeIntermediate();
+    auto* depthwise_relu_output_arg = builder.MakeIntermediate();
+    auto* project_output_arg = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+
+    builder.AddConvNode(input_arg, builder.MakeInitializer<float>({48, 16, 1, 1}, -1.0f, 1.0f), expand_output_arg);
+    builder.AddNode("Relu", {expand_output_arg}, {expand_relu_output_arg});
+
+    Node& depthwise_node = builder.AddConvNode(expand_relu_output_arg,
+                                               builder.MakeInitializer<float>({48, 1, 3, 3}, -1.0f, 1.0f),
+                                               depthwise_output_arg);
+    depthwise_node.AddAttribute("group", static_cast<int64_t>(48));
+    depthwise_node.AddAttribute("strides", std::vector<int64_t>{2, 2});
+    depthwise_node.AddAttribute("pads", std::vector<int64_t>{1, 1, 1, 1});
+    builder.AddNode("Relu", {depthwise_output_arg}, {depthwise_relu_output_arg});
+
+    builder.AddConvNode(depthwise_relu_output_arg, builder.MakeInitializer<float>({24, 48, 1, 1}, -1.0f, 1.0f),
+                        project_output_arg);
+
+    // The pointwise convolution that is not adjacent to a depthwise convolution stays channels first.
+    builder.AddConvNode(project_output_arg, builder.MakeInitializer<float>({8, 24, 1, 1}, -1.0f, 1.0f), output_arg);
+  };
+
+  auto check_nhwc_graph = [&](InferenceSessionWrapper& session) {
+    auto op_to_count = CountOpsInGraph(session.GetGraph());
+    EXPECT_EQ(op_to_count["com.microsoft.NhwcConv"], 3);
+    EXPECT_EQ(op_to_count["Conv"], 1);
+    EXPECT_EQ(op_to_count["Transpose"], 2);
+  };
+
+  TransformerTester(build_test_case,
+                    check_nhwc_graph,
+                    TransformerLevel::Level2,
+                    TransformerLevel::Level3,
+                    12, 1e-4, 1e-5,
+                    nullptr, {}, {"NchwcTransformer"});
+}
+
 #endif  // DISABLE_CONTRIB_OPS
 
 }  // namespace test
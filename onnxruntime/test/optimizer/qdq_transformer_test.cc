@@ -6,6 +6,7 @@
 #include "core/graph/onnx_protobuf.h"
 #include "core/mlas/inc/mlas.h"
 #include "core/optimizer/qdq_transformer/qdq_final_cleanup.h"
+#include "core/optimizer/qdq_transformer/qdq_lookup_table_fusion.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selectors.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/qdq_selector_action_transformer.h"
 #include "core/optimizer/qdq_transformer/selectors_actions/shared/utils.h"
@@ -1528,6 +1529,69 @@ TEST(QDQTransformerTests, Sigmoid_U8S8) {
   QDQTransformerSigmoidTests<uint8_t, int8_t>();
 }
 
+template <typename InputType, typename OutputType>
+void QDQTransformerLookupTableTests() {
+  auto test_case = [&](const std::vector<int64_t>& input_shape) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -1.f, 1.f);
+      auto* output_arg = builder.MakeOutput();
+      // add QDQ + Sigmoid + Mul + Tanh
+      auto* dq_output = AddQDQNodePair<InputType>(builder, input_arg, .0035f, 7);
+      auto* sigmoid_output = builder.MakeIntermediate();
+      builder.AddNode("Sigmoid", {dq_output}, {sigmoid_output});
+      auto* mul_output = builder.MakeIntermediate();
+      builder.AddNode("Mul", {builder.MakeScalarInitializer<float>(2.f), sigmoid_output}, {mul_output});
+      auto* tanh_output = builder.MakeIntermediate();
+      builder.AddNode("Tanh", {mul_output}, {tanh_output});
+
+      // add QDQ output
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<OutputType>(tanh_output,
+                                                .0038f,
+                                                std::numeric_limits<OutputType>::max() / 2,
+                                                q_output);
+      builder.AddDequantizeLinearNode<OutputType>(q_output,
+                                                  .0039f,
+                                                  std::numeric_limits<OutputType>::max() / 2,
+                                                  output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearLookupTable"], 1);
+      EXPECT_EQ(op_to_count["Sigmoid"], 0);
+      EXPECT_EQ(op_to_count["Mul"], 0);
+      EXPECT_EQ(op_to_count["Tanh"], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      12 /*opset_version*/,
+                      0.01 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQLookupTableFusion>());
+  };
+
+  test_case({1, 12, 37});
+  test_case({1, 23, 13, 13});
+}
+
+TEST(QDQTransformerTests, LookupTable_S8S8) {
+  QDQTransformerLookupTableTests<int8_t, int8_t>();
+}
+
+TEST(QDQTransformerTests, LookupTable_U8U8) {
+  QDQTransformerLookupTableTests<uint8_t, uint8_t>();
+}
+
+TEST(QDQTransformerTests, LookupTable_S8U8) {
+  QDQTransformerLookupTableTests<int8_t, uint8_t>();
+}
+
 TEST(QDQTransformerTests, ConvTranspose_QBackward) {
   auto test_case = [&](const std::vector<int64_t>& input_shape, const std::vector<int64_t>& weights_shape, const std::vector<int64_t>& perms) {
     auto build_test_case = [&](ModelTestBuilder& builder) {
@@ -1948,6 +2012,169 @@ TEST(QDQTransformerTests, Softmax_U8U8) {
   QDQTransformerSoftmaxTests<uint8_t, uint8_t>();
 }
 
+template <typename T>
+void QDQTransformerGeluTests() {
+  auto test_case = [&](const std::vector<int64_t>& input_shape) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>(input_shape, -3.f, 3.f);
+      auto* output_arg = builder.MakeOutput();
+      // add QDQ + Gelu
+      auto* dq_output = AddQDQNodePair<T>(builder, input_arg, .025f, std::numeric_limits<T>::max() / 2);
+      auto* gelu_output = builder.MakeIntermediate();
+      builder.AddNode("Gelu", {dq_output}, {gelu_output}, kMSDomain);
+
+      // add QDQ output
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<T>(gelu_output, .015f, std::numeric_limits<T>::max() / 4, q_output);
+      builder.AddDequantizeLinearNode<T>(q_output, .015f, std::numeric_limits<T>::max() / 4, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearGelu"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.Gelu"], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 1);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      12 /*opset_version*/,
+                      0.02 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case({1, 12, 37});
+  test_case({2, 7, 64});
+}
+
+TEST(QDQTransformerTests, Gelu_S8S8) {
+  QDQTransformerGeluTests<int8_t>();
+}
+
+TEST(QDQTransformerTests, Gelu_U8U8) {
+  QDQTransformerGeluTests<uint8_t>();
+}
+
+template <typename T>
+void QDQTransformerLayerNormTests() {
+  auto test_case = [&](const std::vector<int64_t>& input_shape, bool use_mean_output) {
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      const int64_t hidden_size = input_shape.back();
+      auto* input_arg = builder.MakeInput<float>(input_shape, -2.f, 2.f);
+      auto* scale_arg = builder.MakeInitializer<float>({hidden_size}, 0.5f, 1.5f);
+      auto* bias_arg = builder.MakeInitializer<float>({hidden_size}, -0.5f, 0.5f);
+      auto* output_arg = builder.MakeOutput();
+      // add QDQ + LayerNormalization
+      auto* dq_output = AddQDQNodePair<T>(builder, input_arg, .016f, std::numeric_limits<T>::max() / 2);
+      auto* layer_norm_output = builder.MakeIntermediate();
+      std::vector<NodeArg*> layer_norm_outputs{layer_norm_output};
+      if (use_mean_output) {
+        layer_norm_outputs.push_back(builder.MakeOutput());
+      }
+      auto& layer_norm_node = builder.AddNode("LayerNormalization", {dq_output, scale_arg, bias_arg},
+                                              layer_norm_outputs);
+      layer_norm_node.AddAttribute("epsilon", 1e-5f);
+
+      // add QDQ output
+      auto* q_output = builder.MakeIntermediate();
+      builder.AddQuantizeLinearNode<T>(layer_norm_output, .032f, std::numeric_limits<T>::max() / 2, q_output);
+      builder.AddDequantizeLinearNode<T>(q_output, .032f, std::numeric_limits<T>::max() / 2, output_arg);
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      // the Mean output is needed so the float LayerNormalization stays
+      const int fused_count = use_mean_output ? 0 : 1;
+      EXPECT_EQ(op_to_count["com.microsoft.QLinearLayerNormalization"], fused_count);
+      EXPECT_EQ(op_to_count["LayerNormalization"], 1 - fused_count);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 2 - fused_count);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 2 - fused_count);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      12 /*opset_version*/,
+                      0.04 /*per_sample_tolerance*/,
+                      0.01 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case({2, 8, 32}, false);
+  test_case({1, 5, 64}, true);
+}
+
+TEST(QDQTransformerTests, LayerNorm_S8S8) {
+  QDQTransformerLayerNormTests<int8_t>();
+}
+
+TEST(QDQTransformerTests, LayerNorm_U8U8) {
+  QDQTransformerLayerNormTests<uint8_t>();
+}
+
+template <typename WeightType>
+void QDQTransformerAttentionTests() {
+  auto test_case = [&](bool use_mask) {
+    constexpr int64_t batch_size = 2;
+    constexpr int64_t sequence_length = 8;
+    constexpr int64_t hidden_size = 32;
+    auto build_test_case = [&](ModelTestBuilder& builder) {
+      auto* input_arg = builder.MakeInput<float>({batch_size, sequence_length, hidden_size}, -1.f, 1.f);
+      auto* weight_arg = builder.MakeInitializer<WeightType>({hidden_size, 3 * hidden_size},
+                                                             std::numeric_limits<WeightType>::min(),
+                                                             std::numeric_limits<WeightType>::max());
+      auto* bias_arg = builder.MakeInitializer<float>({3 * hidden_size}, -0.1f, 0.1f);
+      auto* output_arg = builder.MakeOutput();
+
+      // add QDQ for the input and DQ for the weights
+      auto* dq_input = AddQDQNodePair<uint8_t>(builder, input_arg, .008f, 128);
+      auto* dq_weight = builder.MakeIntermediate();
+      const auto weight_zp = static_cast<WeightType>(std::is_same<WeightType, int8_t>::value ? 0 : 128);
+      builder.AddDequantizeLinearNode<WeightType>(weight_arg, .002f, weight_zp, dq_weight);
+
+      std::vector<NodeArg*> attention_inputs{dq_input, dq_weight, bias_arg};
+      if (use_mask) {
+        attention_inputs.push_back(builder.MakeInitializer<int32_t>({batch_size}, {6, 8}));
+      }
+      auto& attention_node = builder.AddNode("Attention", attention_inputs, {output_arg}, kMSDomain);
+      attention_node.AddAttribute("num_heads", static_cast<int64_t>(4));
+    };
+
+    auto check_graph = [&](InferenceSessionWrapper& session) {
+      auto op_to_count = CountOpsInGraph(session.GetGraph());
+      EXPECT_EQ(op_to_count["com.microsoft.QAttention"], 1);
+      EXPECT_EQ(op_to_count["com.microsoft.Attention"], 0);
+      EXPECT_EQ(op_to_count["QuantizeLinear"], 1);
+      EXPECT_EQ(op_to_count["DequantizeLinear"], 0);
+    };
+
+    TransformerTester(build_test_case,
+                      check_graph,
+                      TransformerLevel::Level1,
+                      TransformerLevel::Level2,
+                      12 /*opset_version*/,
+                      1e-3 /*per_sample_tolerance*/,
+                      1e-3 /*relative_per_sample_tolerance*/,
+                      std::make_unique<QDQSelectorActionTransformer>(QDQIsInt8Allowed()));
+  };
+
+  test_case(false);
+  test_case(true);
+}
+
+TEST(QDQTransformerTests, Attention_U8U8) {
+  QDQTransformerAttentionTests<uint8_t>();
+}
+
+TEST(QDQTransformerTests, Attention_U8S8) {
+  QDQTransformerAttentionTests<int8_t>();
+}
+
 #endif  // !defined(DISABLE_CONTRIB_OPS)
 
 TEST(QDQTransformerTests, QDQPropagation_QBackward) {
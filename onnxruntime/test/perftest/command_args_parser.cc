@@ -5,6 +5,9 @@
 
 #include <string.h>
 #include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
 
 // Windows Specific
 #ifdef _WIN32
@@ -33,6 +36,11 @@ namespace perftest {
       "\t-A: Disable memory arena\n"
       "\t-I: Generate tensor input binding (Free dimensions are treated as 1.)\n"
       "\t-c [parallel runs]: Specifies the (max) number of runs to invoke simultaneously. Default:1.\n"
+      "\t-Q [arrival_rates]: Runs an open-loop load test where requests arrive at the given rates (requests per second) regardless of\n"
+      "\t\twhen the previous ones complete, and reports latency percentiles and histograms that include the time spent waiting for\n"
+      "\t\tone of the -c workers. A comma separated list of rates runs a throughput vs latency sweep, e.g. -Q 50,100,200.\n"
+      "\t\tEach rate runs for -t seconds, or for -r requests in 'times' mode.\n"
+      "\t-R [constant|poisson]: Specifies the arrival process of the open-loop load test. Default:'constant'.\n"
       "\t-e [cpu|cuda|dnnl|tensorrt|openvino|dml|acl|nnapi|coreml|snpe|rocm|migraphx|xnnpack]: Specifies the provider 'cpu','cuda','dnnl','tensorrt', "
       "'openvino', 'dml', 'acl', 'nnapi', 'coreml', 'snpe', 'rocm', 'migraphx' or 'xnnpack'. "
       "Default:'cpu'.\n"
@@ -81,6 +89,9 @@ namespace perftest {
       "\t    [TensorRT only] [trt_force_sequential_engine_build]: Force TensorRT engines to be built sequentially.\n"
       "\t    [TensorRT only] [trt_context_memory_sharing_enable]: Enable TensorRT context memory sharing between subgraphs.\n"
       "\t    [TensorRT only] [trt_layer_norm_fp32_fallback]: Force Pow + Reduce ops in layer norm to run in FP32 to avoid overflow.\n"
+      "\t    [TensorRT only] [trt_engine_build_thread_count]: Number of threads building TensorRT engines of subgraphs concurrently. 0 uses all cores.\n"
+      "\t    [TensorRT only] [trt_engine_build_in_background]: Build TensorRT engines after session creation and wait for them on first run.\n"
+      "\t    [TensorRT only] [trt_max_optimization_profiles]: Maximum number of TensorRT optimization profiles learned from observed input shapes. 0 disables it.\n"
       "\t [Usage]: -e <provider_name> -i '<key1>|<value1> <key2>|<value2>'\n\n"
       "\t [Example] [For TensorRT EP] -e tensorrt -i 'trt_fp16_enable|true trt_int8_enable|true trt_int8_calibration_table_name|calibration.flatbuffers trt_int8_use_native_calibration_table|false trt_force_sequential_engine_build|false'\n"
       "\t    [NNAPI only] [NNAPI_FLAG_USE_FP16]: Use fp16 relaxation in NNAPI EP..\n"
@@ -106,6 +117,24 @@ static const ORTCHAR_T* overrideDelimiter = L":";
 #else
 static const ORTCHAR_T* overrideDelimiter = ":";
 #endif
+static bool ParseArrivalRates(std::vector<double>& arrival_rates) {
+  std::istringstream rates(ToUTF8String(optarg));
+  std::string rate;
+  while (std::getline(rates, rate, ',')) {
+    ORT_TRY {
+      const double value = std::stod(rate);
+      if (!(value > 0)) {
+        return false;
+      }
+      arrival_rates.push_back(value);
+    }
+    ORT_CATCH(...) {
+      return false;
+    }
+  }
+  return !arrival_rates.empty();
+}
+
 static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier, int64_t& override_val) {
   std::basic_string<ORTCHAR_T> free_dim_str(optarg);
   size_t delimiter_location = free_dim_str.find(overrideDelimiter);
@@ -128,7 +157,7 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
 
 /*static*/ bool CommandLineParser::ParseArguments(PerformanceTestConfig& test_config, int argc, ORTCHAR_T* argv[]) {
   int ch;
-  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:AMPIvhsqz"))) != -1) {
+  while ((ch = getopt(argc, argv, ORT_TSTR("b:m:e:r:t:p:x:y:c:d:o:u:i:f:F:S:T:Q:R:AMPIvhsqz"))) != -1) {
     switch (ch) {
       case 'f': {
         std::basic_string<ORTCHAR_T> dim_name;
@@ -295,6 +324,21 @@ static bool ParseDimensionOverride(std::basic_string<ORTCHAR_T>& dim_identifier,
       case 'T':
         test_config.run_config.intra_op_thread_affinities = ToUTF8String(optarg);
         break;
+      case 'Q':
+        test_config.run_config.arrival_rates.clear();
+        if (!ParseArrivalRates(test_config.run_config.arrival_rates)) {
+          return false;
+        }
+        break;
+      case 'R':
+        if (!CompareCString(optarg, ORT_TSTR("constant"))) {
+          test_config.run_config.arrival_process = ArrivalProcess::kConstant;
+        } else if (!CompareCString(optarg, ORT_TSTR("poisson"))) {
+          test_config.run_config.arrival_process = ArrivalProcess::kPoisson;
+        } else {
+          return false;
+        }
+        break;
       case '?':
       case 'h':
       default:
@@ -75,6 +75,9 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     bool trt_force_sequential_engine_build = false;
     bool trt_context_memory_sharing_enable = false;
     bool trt_layer_norm_fp32_fallback = false;
+    int trt_engine_build_thread_count = 1;
+    bool trt_engine_build_in_background = false;
+    int trt_max_optimization_profiles = 0;
 
 #ifdef _MSC_VER
     std::string ov_string = ToUTF8String(performance_test_config.run_config.ep_runtime_config_string);
@@ -222,8 +225,28 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
         } else {
           ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_layer_norm_fp32_fallback' should be a boolean i.e. true or false. Default value is false.\n");
         }
+      } else if (key == "trt_engine_build_thread_count") {
+        if (!value.empty()) {
+          trt_engine_build_thread_count = std::stoi(value);
+        } else {
+          ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_engine_build_thread_count' should be a non-negative number.\n");
+        }
+      } else if (key == "trt_engine_build_in_background") {
+        if (value == "true" || value == "True") {
+          trt_engine_build_in_background = true;
+        } else if (value == "false" || value == "False") {
+          trt_engine_build_in_background = false;
+        } else {
+          ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_engine_build_in_background' should be a boolean i.e. true or false. Default value is false.\n");
+        }
+      } else if (key == "trt_max_optimization_profiles") {
+        if (!value.empty()) {
+          trt_max_optimization_profiles = std::stoi(value);
+        } else {
+          ORT_THROW("[ERROR] [TensorRT] The value for the key 'trt_max_optimization_profiles' should be a non-negative number.\n");
+        }
       } else {
-        ORT_THROW("[ERROR] [TensorRT] wrong key type entered. Choose from the following runtime key options that are available for TensorRT. ['device_id', 'trt_max_partition_iterations', 'trt_min_subgraph_size', 'trt_max_workspace_size', 'trt_fp16_enable', 'trt_int8_enable', 'trt_int8_calibration_table_name', 'trt_int8_use_native_calibration_table', 'trt_dla_enable', 'trt_dla_core', 'trt_dump_subgraphs', 'trt_engine_cache_enable', 'trt_engine_cache_path', 'trt_engine_decryption_enable', 'trt_engine_decryption_lib_path', 'trt_force_sequential_engine_build', 'trt_context_memory_sharing_enable', 'trt_layer_norm_fp32_fallback'] \n");
+        ORT_THROW("[ERROR] [TensorRT] wrong key type entered. Choose from the following runtime key options that are available for TensorRT. ['device_id', 'trt_max_partition_iterations', 'trt_min_subgraph_size', 'trt_max_workspace_size', 'trt_fp16_enable', 'trt_int8_enable', 'trt_int8_calibration_table_name', 'trt_int8_use_native_calibration_table', 'trt_dla_enable', 'trt_dla_core', 'trt_dump_subgraphs', 'trt_engine_cache_enable', 'trt_engine_cache_path', 'trt_engine_decryption_enable', 'trt_engine_decryption_lib_path', 'trt_force_sequential_engine_build', 'trt_context_memory_sharing_enable', 'trt_layer_norm_fp32_fallback', 'trt_engine_build_thread_count', 'trt_engine_build_in_background', 'trt_max_optimization_profiles'] \n");
       }
     }
     OrtTensorRTProviderOptionsV2 tensorrt_options;
@@ -247,6 +270,9 @@ OnnxRuntimeTestSession::OnnxRuntimeTestSession(Ort::Env& env, std::random_device
     tensorrt_options.trt_force_sequential_engine_build = trt_force_sequential_engine_build;
     tensorrt_options.trt_context_memory_sharing_enable = trt_context_memory_sharing_enable;
     tensorrt_options.trt_layer_norm_fp32_fallback = trt_layer_norm_fp32_fallback;
+    tensorrt_options.trt_engine_build_thread_count = trt_engine_build_thread_count;
+    tensorrt_options.trt_engine_build_in_background = trt_engine_build_in_background;
+    tensorrt_options.trt_max_optimization_profiles = trt_max_optimization_profiles;
     session_options.AppendExecutionProvider_TensorRT_V2(tensorrt_options);
 
     OrtCUDAProviderOptions cuda_options;
@@ -31,6 +31,11 @@ class OnnxRuntimeTestSession : public TestSession {
 
   std::chrono::duration<double> Run() override;
 
+  bool GetResourceStats(size_t& arena_peak_bytes_in_use, double& thread_pool_utilization) override {
+    session_.GetResourceStats(arena_peak_bytes_in_use, thread_pool_utilization);
+    return true;
+  }
+
   ORT_DISALLOW_COPY_ASSIGNMENT_AND_MOVE(OnnxRuntimeTestSession);
 
  private:
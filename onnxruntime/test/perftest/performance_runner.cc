@@ -7,7 +7,10 @@
 #endif
 
 #include "performance_runner.h"
+#include <cmath>
 #include <iostream>
+#include <numeric>
+#include <thread>
 
 #include "TestCase.h"
 #include "TFModelInfo.h"
@@ -51,6 +54,50 @@ Eigen::ThreadPoolInterface* GetDefaultThreadPool(const onnxruntime::Env& env) {
 namespace onnxruntime {
 namespace perftest {
 
+namespace {
+// value at the given fraction of the sorted values, picked the same way as the closed-loop statistics
+double Percentile(const std::vector<double>& sorted_values, double fraction) {
+  const size_t index = static_cast<size_t>(sorted_values.size() * fraction);
+  return sorted_values[std::min(index, sorted_values.size() - 1)];
+}
+
+void DumpLoadStep(const LoadStepResult& step, std::ostream& ostream) {
+  std::vector<double> sorted_latencies = step.latencies;
+  std::sort(sorted_latencies.begin(), sorted_latencies.end());
+
+  ostream << "Arrival rate: " << step.arrival_rate << " requests/s\n"
+          << "  Completed requests: " << sorted_latencies.size() << ", failed: " << step.num_failed_requests << "\n"
+          << "  Throughput: " << (step.duration > 0 ? sorted_latencies.size() / step.duration : 0) << " requests/s\n";
+  if (sorted_latencies.empty()) {
+    return;
+  }
+
+  ostream << "  Mean queueing time: " << step.total_queueing_time / sorted_latencies.size() * 1000 << " ms\n"
+          << "  P50 Latency: " << Percentile(sorted_latencies, 0.5) * 1000 << " ms\n"
+          << "  P90 Latency: " << Percentile(sorted_latencies, 0.9) * 1000 << " ms\n"
+          << "  P99 Latency: " << Percentile(sorted_latencies, 0.99) * 1000 << " ms\n"
+          << "  P999 Latency: " << Percentile(sorted_latencies, 0.999) * 1000 << " ms\n"
+          << "  Max Latency: " << sorted_latencies.back() * 1000 << " ms\n";
+  if (step.has_resource_stats) {
+    ostream << "  Arena peak bytes in use: " << step.arena_peak_bytes_in_use << " bytes\n"
+            << "  Intra-op thread pool utilization: " << step.thread_pool_utilization * 100 << " %\n";
+  }
+
+  // log2 buckets of the latency in microseconds
+  ostream << "  Latency histogram:\n";
+  auto bucket_of = [](double latency) {
+    return static_cast<int>(std::floor(std::log2(std::max(latency * 1e6, 1.0))));
+  };
+  std::vector<size_t> buckets(static_cast<size_t>(bucket_of(sorted_latencies.back())) + 1);
+  for (double latency : sorted_latencies) {
+    ++buckets[static_cast<size_t>(bucket_of(latency))];
+  }
+  for (size_t i = static_cast<size_t>(bucket_of(sorted_latencies.front())); i < buckets.size(); ++i) {
+    ostream << "    [" << (1ull << i) << ", " << (1ull << (i + 1)) << ") us: " << buckets[i] << "\n";
+  }
+}
+}  // namespace
+
 void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics) const {
   bool have_file = !path.empty();
   std::ofstream outfile;
@@ -106,6 +153,47 @@ void PerformanceResult::DumpToFile(const std::basic_string<ORTCHAR_T>& path, boo
 
     output_stats(std::cout);
   }
+
+  if (!arena_peak_bytes_in_use.empty() && f_include_statistics) {
+    const double total_utilization = std::accumulate(thread_pool_utilizations.begin(),
+                                                     thread_pool_utilizations.end(), 0.0);
+    auto output_resource_stats = [&](std::ostream& ostream) {
+      ostream << "Max arena peak bytes in use: "
+              << *std::max_element(arena_peak_bytes_in_use.begin(), arena_peak_bytes_in_use.end()) << " bytes\n"
+              << "Avg intra-op thread pool utilization: "
+              << total_utilization / thread_pool_utilizations.size() * 100 << " %" << std::endl;
+    };
+
+    if (have_file) {
+      output_resource_stats(outfile);
+    }
+    output_resource_stats(std::cout);
+  }
+
+  if (!load_steps.empty()) {
+    if (have_file) {
+      outfile << std::endl
+              << "arrival_rate,throughput,p50_latency,p90_latency,p99_latency,p999_latency,max_latency,"
+              << "arena_peak_bytes_in_use,thread_pool_utilization" << std::endl;
+      for (const auto& step : load_steps) {
+        std::vector<double> sorted_latencies = step.latencies;
+        std::sort(sorted_latencies.begin(), sorted_latencies.end());
+        if (sorted_latencies.empty()) {
+          continue;
+        }
+        outfile << step.arrival_rate << "," << sorted_latencies.size() / step.duration << ","
+                << Percentile(sorted_latencies, 0.5) << "," << Percentile(sorted_latencies, 0.9) << ","
+                << Percentile(sorted_latencies, 0.99) << "," << Percentile(sorted_latencies, 0.999) << ","
+                << sorted_latencies.back() << "," << step.arena_peak_bytes_in_use << ","
+                << step.thread_pool_utilization << std::endl;
+      }
+    }
+
+    for (const auto& step : load_steps) {
+      DumpLoadStep(step, std::cout);
+    }
+    std::cout << std::flush;
+  }
 }
 
 Status PerformanceRunner::Run() {
@@ -120,16 +208,34 @@ Status PerformanceRunner::Run() {
   // if (!performance_test_config_.run_config.profile_file.empty())
   performance_result_.start = std::chrono::high_resolution_clock::now();
 
+  // starts the interval of the resource stats
+  size_t arena_peak_bytes_in_use = 0;
+  double thread_pool_utilization = 0;
+  has_resource_stats_ = session_->GetResourceStats(arena_peak_bytes_in_use, thread_pool_utilization);
+  const bool open_loop = !performance_test_config_.run_config.arrival_rates.empty();
+  const bool sequential_runs = performance_test_config_.run_config.concurrent_session_runs <= 1;
+  collect_run_resource_stats_ = has_resource_stats_ && sequential_runs && !open_loop;
+
   std::unique_ptr<utils::ICPUUsage> p_ICPUUsage = utils::CreateICPUUsage();
-  switch (performance_test_config_.run_config.test_mode) {
-    case TestMode::kFixDurationMode:
-      ORT_RETURN_IF_ERROR(FixDurationTest());
-      break;
-    case TestMode::KFixRepeatedTimesMode:
-      ORT_RETURN_IF_ERROR(RepeatedTimesTest());
-      break;
-    default:
-      return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+  if (open_loop) {
+    ORT_RETURN_IF_ERROR(RunOpenLoop());
+  } else {
+    switch (performance_test_config_.run_config.test_mode) {
+      case TestMode::kFixDurationMode:
+        ORT_RETURN_IF_ERROR(FixDurationTest());
+        break;
+      case TestMode::KFixRepeatedTimesMode:
+        ORT_RETURN_IF_ERROR(RepeatedTimesTest());
+        break;
+      default:
+        return ORT_MAKE_STATUS(ONNXRUNTIME, FAIL, "unknown test mode.");
+    }
+
+    if (has_resource_stats_ && !collect_run_resource_stats_) {
+      session_->GetResourceStats(arena_peak_bytes_in_use, thread_pool_utilization);
+      performance_result_.arena_peak_bytes_in_use.push_back(arena_peak_bytes_in_use);
+      performance_result_.thread_pool_utilizations.push_back(thread_pool_utilization);
+    }
   }
   performance_result_.end = std::chrono::high_resolution_clock::now();
 
@@ -242,6 +348,89 @@ Status PerformanceRunner::ForkJoinRepeat() {
   return Status::OK();
 }
 
+Status PerformanceRunner::RunOpenLoop() {
+  using Clock = std::chrono::high_resolution_clock;
+  const auto& run_config = performance_test_config_.run_config;
+
+  // the requests wait for one of these workers when they are all busy, and the wait is part of their latency
+  auto tpool = std::make_unique<DefaultThreadPoolType>(static_cast<int>(run_config.concurrent_session_runs));
+  std::mt19937 rand_engine(run_config.random_seed_for_input_data >= 0
+                               ? static_cast<std::mt19937::result_type>(run_config.random_seed_for_input_data)
+                               : std::random_device{}());
+
+  for (const double arrival_rate : run_config.arrival_rates) {
+    LoadStepResult step;
+    step.arrival_rate = arrival_rate;
+    const size_t num_requests = run_config.test_mode == TestMode::kFixDurationMode
+                                    ? std::max<size_t>(1, static_cast<size_t>(arrival_rate *
+                                                                              run_config.duration_in_seconds))
+                                    : run_config.repeated_times;
+    if (has_resource_stats_) {
+      // starts the interval of the step
+      step.has_resource_stats = session_->GetResourceStats(step.arena_peak_bytes_in_use,
+                                                           step.thread_pool_utilization);
+    }
+
+    OrtMutex m;
+    OrtCondVar cv;
+    size_t num_pending = 0;
+    const auto start = Clock::now();
+    auto last_completion = start;
+    std::exponential_distribution<double> poisson_interval(arrival_rate);
+    double arrival_offset = 0;  // seconds since the start of the step
+
+    for (size_t i = 0; i < num_requests; ++i) {
+      // the arrival times don't depend on the completion of the previous requests, so a slow request delays the
+      // following ones instead of lowering the rate at which they arrive
+      const auto arrival = start + std::chrono::duration_cast<Clock::duration>(
+                                       std::chrono::duration<double>(arrival_offset));
+      std::this_thread::sleep_until(arrival);
+      {
+        std::lock_guard<OrtMutex> lock(m);
+        ++num_pending;
+      }
+
+      tpool->Schedule([this, arrival, &step, &m, &cv, &num_pending, &last_completion]() {
+        const auto run_start = Clock::now();
+        auto status = RunOneIteration<false>();
+        const auto end = Clock::now();
+
+        std::lock_guard<OrtMutex> lock(m);
+        if (status.IsOK()) {
+          step.latencies.push_back(std::chrono::duration<double>(end - arrival).count());
+          step.total_queueing_time += std::chrono::duration<double>(run_start - arrival).count();
+        } else {
+          ++step.num_failed_requests;
+          std::cerr << status.ErrorMessage() << std::endl;
+        }
+        last_completion = std::max(last_completion, end);
+        --num_pending;
+        cv.notify_all();
+      });
+
+      arrival_offset += run_config.arrival_process == ArrivalProcess::kPoisson ? poisson_interval(rand_engine)
+                                                                                : 1.0 / arrival_rate;
+    }
+
+    {
+      std::unique_lock<OrtMutex> lock(m);
+      cv.wait(lock, [&num_pending]() { return num_pending == 0; });
+    }
+    step.duration = std::chrono::duration<double>(last_completion - start).count();
+    if (step.has_resource_stats) {
+      session_->GetResourceStats(step.arena_peak_bytes_in_use, step.thread_pool_utilization);
+    }
+
+    if (run_config.f_verbose) {
+      std::cout << "arrival_rate:" << arrival_rate << ",requests:" << step.latencies.size()
+                << ",duration:" << step.duration << std::endl;
+    }
+    performance_result_.load_steps.push_back(std::move(step));
+  }
+
+  return Status::OK();
+}
+
 static std::unique_ptr<TestModelInfo> CreateModelInfo(const PerformanceTestConfig& performance_test_config_) {
   if (CompareCString(performance_test_config_.backend.c_str(), ORT_TSTR("ort")) == 0) {
     const auto& file_path = performance_test_config_.model_info.model_file_path;
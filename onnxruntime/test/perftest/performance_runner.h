@@ -27,6 +27,20 @@ class TestModelInfo;
 namespace onnxruntime {
 namespace perftest {
 
+// Result of the step of an open-loop load test at one arrival rate
+struct LoadStepResult {
+  double arrival_rate{0};  // requests per second
+  // seconds from the arrival of each request to its completion, so the time spent waiting for a free worker
+  // is included
+  std::vector<double> latencies;
+  double total_queueing_time{0};  // seconds the requests waited for a free worker
+  double duration{0};             // seconds from the first arrival to the last completion
+  size_t num_failed_requests{0};
+  bool has_resource_stats{false};
+  size_t arena_peak_bytes_in_use{0};
+  double thread_pool_utilization{0};
+};
+
 struct PerformanceResult {
   std::chrono::time_point<std::chrono::high_resolution_clock> start;
   std::chrono::time_point<std::chrono::high_resolution_clock> end;
@@ -35,6 +49,11 @@ struct PerformanceResult {
   double total_time_cost{0};
   std::vector<double> time_costs;
   std::string model_name;
+  // usage of the memory arenas and of the intra-op thread pool of each run when the runs don't overlap,
+  // otherwise a single entry for the whole test
+  std::vector<size_t> arena_peak_bytes_in_use;
+  std::vector<double> thread_pool_utilizations;
+  std::vector<LoadStepResult> load_steps;
 
   void DumpToFile(const std::basic_string<ORTCHAR_T>& path, bool f_include_statistics = false) const;
 };
@@ -76,9 +95,21 @@ class PerformanceRunner {
       std::lock_guard<OrtMutex> guard(results_mutex_);
       performance_result_.time_costs.emplace_back(duration_seconds.count());
       performance_result_.total_time_cost += duration_seconds.count();
+      if (collect_run_resource_stats_) {
+        size_t arena_peak_bytes_in_use = 0;
+        double thread_pool_utilization = 0;
+        session_->GetResourceStats(arena_peak_bytes_in_use, thread_pool_utilization);
+        performance_result_.arena_peak_bytes_in_use.push_back(arena_peak_bytes_in_use);
+        performance_result_.thread_pool_utilizations.push_back(thread_pool_utilization);
+      }
       if (performance_test_config_.run_config.f_verbose) {
         std::cout << "iteration:" << performance_result_.time_costs.size() << ","
-                  << "time_cost:" << performance_result_.time_costs.back() << std::endl;
+                  << "time_cost:" << performance_result_.time_costs.back();
+        if (collect_run_resource_stats_) {
+          std::cout << ",arena_peak_bytes:" << performance_result_.arena_peak_bytes_in_use.back()
+                    << ",thread_pool_utilization:" << performance_result_.thread_pool_utilizations.back();
+        }
+        std::cout << std::endl;
       }
     }
     return Status::OK();
@@ -88,6 +119,7 @@ class PerformanceRunner {
   Status RepeatedTimesTest();
   Status ForkJoinRepeat();
   Status RunParallelDuration();
+  Status RunOpenLoop();
 
   inline Status RunFixDuration() {
     while (performance_result_.total_time_cost < performance_test_config_.run_config.duration_in_seconds) {
@@ -114,6 +146,10 @@ class PerformanceRunner {
   std::unique_ptr<ITestCase> test_case_;
 
   OrtMutex results_mutex_;
+  // the session reports the usage of its memory arenas and thread pool
+  bool has_resource_stats_{false};
+  // the usage is recorded after each run, as the runs don't overlap
+  bool collect_run_resource_stats_{false};
 };
 }  // namespace perftest
 }  // namespace onnxruntime
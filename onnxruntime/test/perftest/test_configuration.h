@@ -6,6 +6,7 @@
 #include <map>
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "core/graph/constants.h"
 #include "core/framework/session_options.h"
@@ -18,6 +19,12 @@ enum class TestMode : std::uint8_t {
   KFixRepeatedTimesMode
 };
 
+// How the requests of an open-loop load test arrive
+enum class ArrivalProcess : std::uint8_t {
+  kConstant = 0,  // at a fixed interval
+  kPoisson        // at exponentially distributed intervals
+};
+
 enum class Platform : std::uint8_t {
   kWindows = 0,
   kLinux
@@ -59,6 +66,10 @@ struct RunConfig {
   std::map<std::basic_string<ORTCHAR_T>, int64_t> free_dim_name_overrides;
   std::map<std::basic_string<ORTCHAR_T>, int64_t> free_dim_denotation_overrides;
   std::string intra_op_thread_affinities;
+  // Open-loop load test: the requests arrive at these rates, in requests per second, regardless of when the previous
+  // requests complete. Each rate is a step of a throughput vs latency sweep. Empty for the closed-loop test.
+  std::vector<double> arrival_rates;
+  ArrivalProcess arrival_process{ArrivalProcess::kConstant};
 };
 
 struct PerformanceTestConfig {
@@ -16,6 +16,11 @@ class TestSession {
   // Please measure the perf at a higher level.
   void ThreadSafeRun() { abort(); }
   virtual void PreLoadTestData(size_t test_data_id, size_t input_id, Ort::Value&& value) = 0;
+  // Get the usage of the memory arenas and of the intra-op thread pool since the previous call, see
+  // OrtApi::SessionGetResourceStats. Returns false if the backend doesn't report it.
+  virtual bool GetResourceStats(size_t& /*arena_peak_bytes_in_use*/, double& /*thread_pool_utilization*/) {
+    return false;
+  }
 
   virtual ~TestSession() = default;
 };
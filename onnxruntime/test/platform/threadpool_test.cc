@@ -14,6 +14,8 @@
 #include <algorithm>
 #include <memory>
 #include <functional>
+#include <set>
+#include <thread>
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -510,6 +512,254 @@ TEST(ThreadPoolTest, TestStagedMultiLoopSections_4Thread_100Loop) {
   TestStagedMultiLoopSections("TestStagedMultiLoopSections_4Thread_100Loop", 4, 100);
 }
 
+TEST(ThreadPoolTest, TestWorkerBusyTime) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 2, true);
+  tp->EnableBusyTimeTracking();
+
+  Notification n;
+  ThreadPool::Schedule(tp.get(), [&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    n.Notify();
+  });
+  n.Wait();
+
+  // the busy time is added once the task returns
+  uint64_t busy_ns = 0;
+  for (int i = 0; i < 1000 && busy_ns == 0; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    busy_ns = tp->GetAverageWorkerBusyTimeNs();
+  }
+  ASSERT_GE(busy_ns, uint64_t{20000000});
+}
+
+TEST(ThreadPoolTest, TestPriority) {
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), onnxruntime::ThreadOptions{}, nullptr, 4, true);
+  EXPECT_EQ(ThreadPool::GetCurrentThreadPriority(), ThreadPoolPriority::kNormal);
+
+  for (auto priority : {ThreadPoolPriority::kLow, ThreadPoolPriority::kHigh}) {
+    ThreadPool::PriorityScope priority_scope(priority);
+    EXPECT_EQ(ThreadPool::GetCurrentThreadPriority(), priority);
+
+    // scheduled tasks and the tasks they schedule run with the priority
+    Barrier b(2, false);
+    std::atomic<int> count{0};
+    ThreadPool::Schedule(tp.get(), [&]() {
+      if (ThreadPool::GetCurrentThreadPriority() == priority) count++;
+      ThreadPool::Schedule(tp.get(), [&]() {
+        if (ThreadPool::GetCurrentThreadPriority() == priority) count++;
+        b.Notify();
+      });
+      b.Notify();
+    });
+    b.Wait();
+    EXPECT_EQ(count, 2);
+
+    // all iterations of a loop run in a parallel section of the priority
+    std::vector<std::atomic<int>> counts(100);
+    ThreadPool::TrySimpleParallelFor(tp.get(), 100, [&](std::ptrdiff_t i) { counts[i]++; });
+    for (int i = 0; i < 100; i++) {
+      ASSERT_EQ(counts[i], 1) << i;
+    }
+  }
+  EXPECT_EQ(ThreadPool::GetCurrentThreadPriority(), ThreadPoolPriority::kNormal);
+}
+
+TEST(ThreadPoolTest, TestYieldToHighPriorityWork) {
+  using namespace std::chrono;
+  {
+    ThreadPool::PriorityScope low_priority(ThreadPoolPriority::kLow);
+    // no high priority work in progress
+    auto start = steady_clock::now();
+    ThreadPool::YieldToHighPriorityWork(seconds(10));
+    EXPECT_LT(steady_clock::now() - start, seconds(5));
+  }
+
+  Notification high_priority_started;
+  Notification low_priority_done;
+  std::thread high_priority_thread([&]() {
+    ThreadPool::PriorityScope high_priority(ThreadPoolPriority::kHigh);
+    high_priority_started.Notify();
+    low_priority_done.Wait();
+  });
+  high_priority_started.Wait();
+
+  // normal priority work does not wait, low priority work waits for at most max_wait
+  auto start = steady_clock::now();
+  ThreadPool::YieldToHighPriorityWork(seconds(10));
+  EXPECT_LT(steady_clock::now() - start, seconds(5));
+  {
+    ThreadPool::PriorityScope low_priority(ThreadPoolPriority::kLow);
+    start = steady_clock::now();
+    ThreadPool::YieldToHighPriorityWork(milliseconds(20));
+    EXPECT_GE(steady_clock::now() - start, milliseconds(20));
+  }
+  low_priority_done.Notify();
+  high_priority_thread.join();
+}
+
+TEST(ThreadPoolTest, TestAdaptiveSpinPolicy) {
+  AdaptiveSpinPolicy policy;
+  EXPECT_EQ(policy.GetSpinDuration(), AdaptiveSpinPolicy::kMaxSpin);
+
+  // work arriving every 100 us
+  for (int i = 0; i < 100; i++) {
+    policy.OnIdleEnd(std::chrono::microseconds(100));
+  }
+  EXPECT_GE(policy.GetSpinDuration(), std::chrono::microseconds(190));
+  EXPECT_LE(policy.GetSpinDuration(), std::chrono::microseconds(210));
+
+  // an occasional long gap neither extends the spin nor stops the spinning for the short ones
+  for (int i = 0; i < 100; i++) {
+    policy.OnIdleEnd(i % 10 == 0 ? std::chrono::milliseconds(50) : std::chrono::microseconds(100));
+  }
+  EXPECT_GE(policy.GetSpinDuration(), std::chrono::microseconds(190));
+  EXPECT_LE(policy.GetSpinDuration(), std::chrono::microseconds(210));
+
+  // work arriving every 50 ms
+  for (int i = 0; i < 100; i++) {
+    policy.OnIdleEnd(std::chrono::milliseconds(50));
+  }
+  EXPECT_EQ(policy.GetSpinDuration(), AdaptiveSpinPolicy::kMinSpin);
+}
+
+TEST(ThreadPoolTest, TestAdaptiveSpinning) {
+  ThreadOptions to;
+  to.adaptive_spinning = true;
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), to, nullptr, 4, true);
+
+  constexpr int num_tasks = 100;
+  for (int run = 0; run < 20; run++) {
+    std::vector<std::atomic<int>> counts(num_tasks);
+    ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) { counts[i]++; });
+    for (int i = 0; i < num_tasks; i++) {
+      ASSERT_EQ(counts[i], 1) << i;
+    }
+    // idle periods longer than the adaptive spin
+    std::this_thread::sleep_for(std::chrono::milliseconds(run % 2 == 0 ? 2 : 0));
+  }
+}
+
+TEST(ThreadPoolTest, TestCostCalibration) {
+  ThreadOptions to;
+  to.calibrate_parallel_for_cost = true;
+  auto tp = std::make_unique<ThreadPool>(&onnxruntime::Env::Default(), to, nullptr, 4, true);
+
+  // a loop that claims to be far more expensive than it is
+  constexpr int num_tasks = 100;
+  const auto caller = std::this_thread::get_id();
+  bool all_on_caller = false;
+  for (int run = 0; run < 20; run++) {
+    std::vector<std::atomic<int>> counts(num_tasks);
+    std::atomic<bool> on_caller{true};
+    ThreadPool::TryParallelFor(tp.get(), num_tasks, 1e5, [&](std::ptrdiff_t first, std::ptrdiff_t last) {
+      if (std::this_thread::get_id() != caller) {
+        on_caller = false;
+      }
+      for (std::ptrdiff_t i = first; i < last; i++) {
+        counts[i]++;
+      }
+    });
+    for (int i = 0; i < num_tasks; i++) {
+      ASSERT_EQ(counts[i], 1) << i;
+    }
+    all_on_caller = on_caller;
+  }
+  // once measured, the loop is too cheap to be worth splitting
+  EXPECT_TRUE(all_on_caller);
+}
+
+namespace {
+// A scheduler of the host application that keeps the work it is given until it is told to run it.
+struct DeferredScheduler {
+  static void Schedule(void* param, OrtThreadWorkerFn work_fn, void* work_param) {
+    auto* scheduler = static_cast<DeferredScheduler*>(param);
+    std::lock_guard<onnxruntime::OrtMutex> lock(scheduler->mutex);
+    scheduler->work.emplace_back(work_fn, work_param);
+  }
+
+  void RunAll() {
+    std::vector<std::pair<OrtThreadWorkerFn, void*>> to_run;
+    {
+      std::lock_guard<onnxruntime::OrtMutex> lock(mutex);
+      to_run.swap(work);
+    }
+    for (auto& item : to_run) {
+      item.first(item.second);
+    }
+  }
+
+  onnxruntime::OrtMutex mutex;
+  std::vector<std::pair<OrtThreadWorkerFn, void*>> work;
+};
+
+// A scheduler of the host application that runs each work item on a new thread.
+struct ThreadScheduler {
+  static void Schedule(void* param, OrtThreadWorkerFn work_fn, void* work_param) {
+    auto* scheduler = static_cast<ThreadScheduler*>(param);
+    std::lock_guard<onnxruntime::OrtMutex> lock(scheduler->mutex);
+    scheduler->threads.emplace_back([work_fn, work_param]() { work_fn(work_param); });
+  }
+
+  ~ThreadScheduler() {
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+
+  onnxruntime::OrtMutex mutex;
+  std::vector<std::thread> threads;
+};
+}  // namespace
+
+TEST(ThreadPoolTest, TestHostSchedulerParallelFor) {
+  ThreadScheduler scheduler;
+  auto tp = std::make_unique<ThreadPool>(ThreadScheduler::Schedule, &scheduler, 4);
+
+  constexpr int num_tasks = 1000;
+  std::vector<std::atomic<int>> counts(num_tasks);
+  OrtMutex mutex;
+  std::set<std::thread::id> thread_ids;
+  ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) {
+    std::this_thread::sleep_for(std::chrono::microseconds(10));
+    counts[i]++;
+    std::lock_guard<OrtMutex> lock(mutex);
+    thread_ids.insert(std::this_thread::get_id());
+  });
+  for (int i = 0; i < num_tasks; i++) {
+    ASSERT_EQ(counts[i], 1) << i;
+  }
+  ASSERT_LE(thread_ids.size(), 4u);
+
+  Notification n;
+  ThreadPool::Schedule(tp.get(), [&]() { n.Notify(); });
+  n.Wait();
+}
+
+TEST(ThreadPoolTest, TestHostSchedulerDoesNotRunWork) {
+  DeferredScheduler scheduler;
+  auto tp = std::make_unique<ThreadPool>(DeferredScheduler::Schedule, &scheduler, 4);
+
+  // the calling thread runs the whole loop
+  constexpr int num_tasks = 100;
+  std::vector<int> counts(num_tasks);
+  const auto caller_id = std::this_thread::get_id();
+  ThreadPool::TrySimpleParallelFor(tp.get(), num_tasks, [&](std::ptrdiff_t i) {
+    ASSERT_EQ(std::this_thread::get_id(), caller_id);
+    counts[i]++;
+  });
+  ASSERT_EQ(scheduler.work.size(), 3u);
+  for (int i = 0; i < num_tasks; i++) {
+    ASSERT_EQ(counts[i], 1) << i;
+  }
+
+  // the work items of the loop that ended don't run the loop body, even after the pool is gone
+  tp.reset();
+  scheduler.RunAll();
+  for (int i = 0; i < num_tasks; i++) {
+    ASSERT_EQ(counts[i], 1) << i;
+  }
+}
+
 #ifdef _WIN32
 #if WINAPI_FAMILY_PARTITION(WINAPI_PARTITION_DESKTOP)
 #pragma warning(push)
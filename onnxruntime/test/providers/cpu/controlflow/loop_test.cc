@@ -1038,6 +1038,69 @@ TEST(Loop, IterationCountAsOutput) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// a loop with a trip count whose condition never changes writes the loop outputs of each iteration directly into
+// the output of the Loop node
+TEST(Loop, FixedTripCountPreallocatedOutput) {
+  auto create_subgraph = []() {
+    Model model("Fixed trip count subgraph", false, DefaultLoggingManager().DefaultLogger());
+    auto& graph = model.MainGraph();
+
+    /* Inputs: iter_num, cond_in, loop_var_0_in
+
+         cond_in       loop_var_0_in
+            |             |      |
+       [Identity]       [Add]  [Mul]
+            |             |      |
+        cond_out  loop_var_0_out  loop_out_0
+    */
+
+    TypeProto int64_scalar;
+    int64_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_INT64);
+    int64_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto bool_scalar;
+    bool_scalar.mutable_tensor_type()->set_elem_type(TensorProto_DataType_BOOL);
+    bool_scalar.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(1);
+
+    TypeProto float_tensor;
+    float_tensor.mutable_tensor_type()->set_elem_type(TensorProto_DataType_FLOAT);
+    float_tensor.mutable_tensor_type()->mutable_shape()->add_dim()->set_dim_value(2);
+
+    auto& iter_num_in = graph.GetOrCreateNodeArg("iter_num_in", &int64_scalar);
+    auto& cond_in = graph.GetOrCreateNodeArg("cond_in", &bool_scalar);
+    auto& loop_var_0_in = graph.GetOrCreateNodeArg("loop_var_0_in", &float_tensor);
+
+    auto& cond_out = graph.GetOrCreateNodeArg("cond_out", &bool_scalar);
+    auto& loop_var_0_out = graph.GetOrCreateNodeArg("loop_var_0_out", &float_tensor);
+    auto& loop_out_0 = graph.GetOrCreateNodeArg("loop_out_0", &float_tensor);
+
+    graph.AddNode("cond_in_identity", "Identity", "Forward cond_in to cond_out", {&cond_in}, {&cond_out});
+    graph.AddNode("add", "Add", "Double loop_var_0", {&loop_var_0_in, &loop_var_0_in}, {&loop_var_0_out});
+    graph.AddNode("mul", "Mul", "Square loop_var_0", {&loop_var_0_in, &loop_var_0_in}, {&loop_out_0});
+
+    graph.SetInputs({&iter_num_in, &cond_in, &loop_var_0_in});
+    graph.SetOutputs({&cond_out, &loop_var_0_out, &loop_out_0});
+
+    auto status = graph.Resolve();
+    EXPECT_EQ(status, Status::OK());
+
+    return graph.ToGraphProto();
+  };
+
+  OpTester test("Loop", 11);
+  auto body = create_subgraph();
+  test.AddAttribute<GraphProto>("body", body);
+  test.AddInput<int64_t>("M", {1}, {3});
+  test.AddInput<bool>("cond", {1}, {true});
+  test.AddInput<float>("loop_var_0_orig", {2}, {1.f, 2.f});
+
+  test.AddOutput<float>("loop_var_0_final", {2}, {8.f, 16.f});
+  test.AddOutput<float>("loop_out_0_final", {3, 2}, {1.f, 4.f, 4.f, 16.f, 16.f, 64.f});
+
+  // Disable TensorRT on unsupported data type BOOL
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 #ifdef USE_CUDA
 // test that when part of the subgraph run on CUDA it executes successfully
 TEST(Loop, MixedExecutionProviders) {
@@ -0,0 +1,66 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// Licensed under the MIT License.
+
+#include "core/providers/cpu/cpu_profiler.h"
+
+#include "core/common/logging/logging.h"
+#include "gtest/gtest.h"
+#include "test/util/include/asserts.h"
+
+namespace onnxruntime {
+namespace profiling {
+namespace test {
+
+#if defined(__linux__)
+TEST(CpuHardwareCounterProfilerTest, InvalidCounterNames) {
+  std::unique_ptr<EpProfiler> profiler;
+  const auto& logger = logging::LoggingManager::DefaultLogger();
+  EXPECT_FALSE(CpuHardwareCounterProfiler::Create("cycles,not_a_counter", logger, profiler).IsOK());
+  EXPECT_FALSE(CpuHardwareCounterProfiler::Create("", logger, profiler).IsOK());
+  EXPECT_EQ(profiler, nullptr);
+}
+
+TEST(CpuHardwareCounterProfilerTest, AddsCountersToEvents) {
+  std::unique_ptr<EpProfiler> profiler;
+  ASSERT_STATUS_OK(CpuHardwareCounterProfiler::Create("instructions,cycles,page_faults",
+                                                      logging::LoggingManager::DefaultLogger(), profiler));
+  const auto start_time = std::chrono::high_resolution_clock::now();
+  ASSERT_TRUE(profiler->StartProfiling(start_time));
+
+  constexpr uint64_t kStartTime = 42;
+  profiler->Start(kStartTime);
+  volatile uint64_t sum = 0;
+  for (uint64_t i = 0; i < 100000; ++i) {
+    sum = sum + i;
+  }
+  profiler->Stop(kStartTime);
+
+  Events events;
+  events.emplace_back(NODE_EVENT, logging::GetProcessId(), static_cast<int>(logging::GetThreadId()), "node",
+                      static_cast<long long>(kStartTime), 10, std::unordered_map<std::string, std::string>{});
+  // an event of another thread that started at the same time
+  events.emplace_back(NODE_EVENT, logging::GetProcessId(), -1, "other", static_cast<long long>(kStartTime), 10,
+                      std::unordered_map<std::string, std::string>{});
+  profiler->EndProfiling(start_time, events);
+
+  EXPECT_TRUE(events[1].args.empty());
+  if (events[0].args.empty()) {
+    GTEST_SKIP() << "Hardware counters are not available.";
+  }
+
+  // the software counters are available whenever perf events are, unlike the hardware counters of virtual machines
+  EXPECT_EQ(events[0].args.count("page_faults"), 1u);
+  if (events[0].args.count("instructions") > 0) {
+    EXPECT_GT(std::stoull(events[0].args["instructions"]), 100000u);
+  }
+}
+#else
+TEST(CpuHardwareCounterProfilerTest, NotSupported) {
+  std::unique_ptr<EpProfiler> profiler;
+  EXPECT_FALSE(CpuHardwareCounterProfiler::Create("cycles", logging::LoggingManager::DefaultLogger(), profiler).IsOK());
+}
+#endif
+
+}  // namespace test
+}  // namespace profiling
+}  // namespace onnxruntime
@@ -2,14 +2,63 @@
 // Licensed under the MIT License.
 
 #include "gtest/gtest.h"
+#include "core/platform/env.h"
+#include "core/platform/threadpool.h"
+#include "core/providers/cpu/generator/philox.h"
 #include "test/providers/provider_test_utils.h"
 
 #include <algorithm>
+#include <numeric>
 #include <random>
 using namespace ONNX_NAMESPACE;
 namespace onnxruntime {
 namespace test {
 
+TEST(Random, Philox4x32KnownAnswers) {
+  // known answers of the Random123 reference implementation
+  EXPECT_EQ(philox::Philox4x32({0, 0, 0, 0}, {0, 0}),
+            (philox::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  EXPECT_EQ(philox::Philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff}),
+            (philox::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  EXPECT_EQ(philox::Philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0}),
+            (philox::Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(Random, PhiloxFillIsIndependentOfThreadCount) {
+  concurrency::ThreadPool tp(&onnxruntime::Env::Default(), ThreadOptions(), ORT_TSTR("PhiloxTest"), 4, true);
+  constexpr size_t size = 100003;
+  constexpr uint64_t seed = 123;
+  constexpr uint64_t offset = 7;
+
+  std::vector<float> expected_float(size), float_output(size);
+  philox::FillNormal<float>(seed, offset, 1.f, 2.f, expected_float, nullptr);
+  philox::FillNormal<float>(seed, offset, 1.f, 2.f, float_output, &tp);
+  EXPECT_EQ(expected_float, float_output);
+
+  std::vector<double> expected_double(size), double_output(size);
+  philox::FillUniform<double>(seed, offset, -1., 1., expected_double, nullptr);
+  philox::FillUniform<double>(seed, offset, -1., 1., double_output, &tp);
+  EXPECT_EQ(expected_double, double_output);
+
+  // the values of a range of counters do not depend on where the output starts
+  std::vector<double> tail(size - 2 * 10);
+  philox::FillUniform<double>(seed, offset + 10, -1., 1., tail, &tp);
+  EXPECT_TRUE(std::equal(tail.begin(), tail.end(), expected_double.begin() + 20));
+
+  const double mean = std::accumulate(expected_float.begin(), expected_float.end(), 0.) / size;
+  double variance = 0.;
+  for (float value : expected_float) {
+    variance += (value - mean) * (value - mean);
+  }
+  variance /= size;
+  EXPECT_NEAR(mean, 1., 0.05);
+  EXPECT_NEAR(variance, 4., 0.1);
+  for (double value : expected_double) {
+    ASSERT_GE(value, -1.);
+    ASSERT_LT(value, 1.);
+  }
+}
+
 TEST(Random, RandomNormal2DDouble) {
   OpTester test("RandomNormal");
 
@@ -25,16 +74,13 @@ TEST(Random, RandomNormal2DDouble) {
   test.AddAttribute<int64_t>("dtype", TensorProto::DOUBLE);
   test.AddAttribute("shape", dims);
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::normal_distribution<double> distribution{mean, scale};
-
+  // the first call of the kernel draws from the start of the Philox stream of the seed
   std::vector<double> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](double& value) { value = distribution(generator); });
+  philox::FillNormal<double>(gsl::narrow_cast<uint32_t>(seed), 0, mean, scale, expected_output, nullptr);
 
   test.AddOutput<double>("Y", dims, expected_output);
 
-  // The expected_output is generated using std lib, which is used by CPU kernel only.
+  // The expected_output is generated using the Philox fill of the CPU kernel only.
   // So we need to exclude other EPs here. Ditto for other places.
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kCudaExecutionProvider, kRocmExecutionProvider});
 }
@@ -62,12 +108,9 @@ void RunRandomNormalLike3DFloat(bool infer_dtype = false) {
                         0.f, 0.f, 0.f,
                         0.f, 0.f, 0.f});
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::normal_distribution<float> distribution{mean, scale};
-
+  // the first call of the kernel draws from the start of the Philox stream of the seed
   std::vector<float> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](float& value) { value = distribution(generator); });
+  philox::FillNormal<float>(gsl::narrow_cast<uint32_t>(seed), 0, mean, scale, expected_output, nullptr);
 
   test.AddOutput<float>("Y", dims, expected_output);
 
@@ -99,12 +142,9 @@ TEST(Random, RandomUniform1DFloat) {
   test.AddAttribute<int64_t>("dtype", TensorProto::FLOAT);
   test.AddAttribute("shape", dims);
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::uniform_real_distribution<float> distribution{low, high};
-
+  // the first call of the kernel draws from the start of the Philox stream of the seed
   std::vector<float> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](float& value) { value = distribution(generator); });
+  philox::FillUniform<float>(gsl::narrow_cast<uint32_t>(seed), 0, low, high, expected_output, nullptr);
 
   test.AddOutput<float>("Y", dims, expected_output);
 
@@ -132,12 +172,9 @@ void RunRandomUniformLikeTest(bool infer_dtype = false) {
                         {0., 0., 0., 0., 0., 0.,
                          0., 0., 0., 0., 0., 0.});
 
-  std::default_random_engine generator{gsl::narrow_cast<uint32_t>(seed)};
-  std::uniform_real_distribution<double> distribution{low, high};
-
+  // the first call of the kernel draws from the start of the Philox stream of the seed
   std::vector<double> expected_output(TensorShape(dims).Size());
-  std::for_each(expected_output.begin(), expected_output.end(),
-                [&generator, &distribution](double& value) { value = distribution(generator); });
+  philox::FillUniform<double>(gsl::narrow_cast<uint32_t>(seed), 0, low, high, expected_output, nullptr);
 
   test.AddOutput<double>("Y", dims, expected_output);
 
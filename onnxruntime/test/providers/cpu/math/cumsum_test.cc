@@ -247,5 +247,41 @@ TEST(CumSumTest, _1DTestdouble_WithInt64Axis) {
   test.AddOutput<double>("y", {5}, {1., 3., 6., 10., 15.});
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
+TEST(CumSumTest, _2DTestLongAxisInt64) {
+  // long enough for the blocked scan on CPU and several tiles per row on CUDA
+  constexpr int64_t rows = 2;
+  constexpr int64_t dim = 40000;
+  std::vector<int64_t> x(rows * dim);
+  for (int64_t i = 0; i < rows * dim; ++i) {
+    x[i] = i % 7 - 3;
+  }
+
+  for (int64_t exclusive : {0, 1}) {
+    for (int64_t reverse : {0, 1}) {
+      std::vector<int64_t> y(rows * dim);
+      for (int64_t r = 0; r < rows; ++r) {
+        int64_t sum = 0;
+        for (int64_t step = 0; step < dim; ++step) {
+          const int64_t i = r * dim + (reverse ? dim - 1 - step : step);
+          if (exclusive) {
+            y[i] = sum;
+            sum += x[i];
+          } else {
+            sum += x[i];
+            y[i] = sum;
+          }
+        }
+      }
+
+      OpTester test("CumSum", 14, onnxruntime::kOnnxDomain);
+      test.AddAttribute<int64_t>("exclusive", exclusive);
+      test.AddAttribute<int64_t>("reverse", reverse);
+      test.AddInput<int64_t>("x", {rows, dim}, x);
+      test.AddInput<int32_t>("axis", {}, {1});
+      test.AddOutput<int64_t>("y", {rows, dim}, y);
+      test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+    }
+  }
+}
 }  // namespace test
 }  // namespace onnxruntime
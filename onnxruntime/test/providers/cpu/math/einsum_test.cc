@@ -286,6 +286,73 @@ TEST(Einsum, ExplicitEinsumAsMatmul_2) {
   test.Run();
 }
 
+TEST(Einsum, ExplicitEinsumAsMatmulWithTransposedLeft) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ji,jk->ik");
+  test.AddInput<float>("x", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("y", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddOutput<float>("o", {2, 2}, {35.f, 44.f, 44.f, 56.f});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsMatmulWithTransposedRight) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,kj->ik");
+  test.AddInput<float>("x", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("y", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddOutput<float>("o", {2, 2}, {14.f, 32.f, 32.f, 77.f});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsMatmulWithTransposedInputs_int32) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ji,kj->ik");
+  test.AddInput<int32_t>("x", {3, 2}, {1, 2, 3, 4, 5, 6});
+  test.AddInput<int32_t>("y", {2, 3}, {1, 2, 3, 4, 5, 6});
+  test.AddOutput<int32_t>("o", {2, 2}, {22, 49, 28, 64});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsBatchedMatmulWithTransposedLeft) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "bji,bjk->bik");
+  test.AddInput<float>("x", {2, 3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f});
+  test.AddInput<float>("y", {2, 3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f});
+  test.AddOutput<float>("o", {2, 2, 2}, {35.f, 44.f, 44.f, 56.f, 251.f, 278.f, 278.f, 308.f});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsBatchedMatmulWithTransposedRight) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "bij,bkj->bik");
+  test.AddInput<float>("x", {2, 2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f});
+  test.AddInput<float>("y", {2, 2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f});
+  test.AddOutput<float>("o", {2, 2, 2}, {14.f, 32.f, 32.f, 77.f, 194.f, 266.f, 266.f, 365.f});
+  test.Run();
+}
+
+// The cheapest contraction order of these operands is not left-to-right
+TEST(Einsum, ExplicitEinsumAsChainedMatmul_Multi_Input) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,kl->il");
+  test.AddInput<float>("x", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+  test.AddInput<float>("y", {3, 4}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f, 9.f, 10.f, 11.f, 12.f});
+  test.AddInput<float>("z", {4, 1}, {1.f, 2.f, 3.f, 4.f});
+  test.AddOutput<float>("o", {2, 1}, {500.f, 1130.f});
+  test.Run();
+}
+
+TEST(Einsum, ExplicitEinsumAsChainedMatmulWithBroadcasting_Multi_Input) {
+  OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
+  test.AddAttribute<std::string>("equation", "ij,jk,kl,lm->im");
+  test.AddInput<float>("w", {3, 1}, {1.f, 2.f, 3.f});
+  test.AddInput<float>("x", {1, 4}, {1.f, 2.f, 3.f, 4.f});
+  test.AddInput<float>("y", {4, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f, 7.f, 8.f});
+  test.AddInput<float>("z", {2, 2}, {1.f, 2.f, 3.f, 4.f});
+  test.AddOutput<float>("o", {3, 2}, {230.f, 340.f, 460.f, 680.f, 690.f, 1020.f});
+  test.Run();
+}
+
 // Implicit
 TEST(Einsum, ImplicitEinsumAsMatmul) {
   OpTester test("Einsum", 12, onnxruntime::kOnnxDomain);
@@ -368,6 +368,52 @@ TEST(MatmulIntegerOpTest, MatMulInteger_Uint8_Int8_GEMM) {
   RunMatMulIntegerU8X8TestBatch(4, 8, 68);
 }
 
+// B is a constant where most rows of blocks equal the zero points, so it is pre-packed for the block sparse kernels.
+TEST(MatmulIntegerOpTest, MatMulInteger_Int8_BlockSparse_B) {
+  constexpr int64_t M = 5;
+  constexpr int64_t N = 40;
+  constexpr int64_t K = 96;
+
+  std::default_random_engine e(321);
+  std::uniform_int_distribution<int> n_uint8(0, 255);
+  std::uniform_int_distribution<int> n_int8(-128, 127);
+
+  std::vector<uint8_t> a_data(M * K);
+  for (auto& a : a_data) {
+    a = static_cast<uint8_t>(n_uint8(e));
+  }
+  std::vector<int8_t> b_zero_point(N);
+  for (auto& zp : b_zero_point) {
+    zp = static_cast<int8_t>(n_int8(e));
+  }
+  std::vector<int8_t> b_data(K * N);
+  for (int64_t k = 0; k < K; k++) {
+    for (int64_t n = 0; n < N; n++) {
+      b_data[k * N + n] = (k % 16 == 3) ? static_cast<int8_t>(n_int8(e)) : b_zero_point[n];
+    }
+  }
+  const uint8_t a_zero_point = 17;
+
+  std::vector<int32_t> y_data(M * N);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      int32_t sum = 0;
+      for (int64_t k = 0; k < K; k++) {
+        sum += (int32_t(a_data[m * K + k]) - a_zero_point) * (int32_t(b_data[k * N + n]) - b_zero_point[n]);
+      }
+      y_data[m * N + n] = sum;
+    }
+  }
+
+  OpTester test("MatMulInteger", 10);
+  test.AddInput<uint8_t>("T1", {M, K}, a_data);
+  test.AddInput<int8_t>("T2", {K, N}, b_data, true);
+  test.AddInput<uint8_t>("a_zero_point", {}, {a_zero_point});
+  test.AddInput<int8_t>("b_zero_point", {N}, b_zero_point, true);
+  test.AddOutput<int32_t>("T3", {M, N}, y_data);
+  test.Run();
+}
+
 #ifndef ENABLE_TRAINING  // Prepacking is enabled only on non-training builds
 TEST(MatmulIntegerOpTest, SharedPrepackedWeights) {
   OpTester test("MatMulInteger", 10);
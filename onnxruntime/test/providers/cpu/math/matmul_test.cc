@@ -8,6 +8,9 @@
 #include "test/common/cuda_op_test_utils.h"
 #include "test/common/tensor_op_test_utils.h"
 #include "default_providers.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "test/providers/kernel_compute_test_utils.h"
+#endif
 
 namespace onnxruntime {
 namespace test {
@@ -199,6 +202,39 @@ TEST(MathOpTest, MatMulFloatTypeInitializer) {
   RunMatMulTest<float>(7, false, true);
 }
 
+// B is a constant where most rows of blocks are zero, so it is pre-packed for the block sparse kernels.
+TEST(MathOpTest, MatMulFloatTypeBlockSparseInitializer) {
+  constexpr int64_t M = 9;
+  constexpr int64_t N = 40;
+  constexpr int64_t K = 64;
+
+  std::vector<float> a_data(M * K);
+  for (size_t i = 0; i < a_data.size(); i++) {
+    a_data[i] = static_cast<float>(static_cast<int>(i % 7) - 3);
+  }
+  std::vector<float> b_data(K * N, 0.0f);
+  for (int64_t k = 0; k < K; k += 8) {
+    for (int64_t n = 0; n < N; n++) {
+      b_data[k * N + n] = static_cast<float>(static_cast<int>((k + n) % 5) - 2);
+    }
+  }
+
+  std::vector<float> y_data(M * N, 0.0f);
+  for (int64_t m = 0; m < M; m++) {
+    for (int64_t n = 0; n < N; n++) {
+      for (int64_t k = 0; k < K; k++) {
+        y_data[m * N + n] += a_data[m * K + k] * b_data[k * N + n];
+      }
+    }
+  }
+
+  OpTester test("MatMul", 13);
+  test.AddInput<float>("A", {M, K}, a_data);
+  test.AddInput<float>("B", {K, N}, b_data, true);
+  test.AddOutput<float>("Y", {M, N}, y_data);
+  test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
+}
+
 TEST(MathOpTest, MatMulInt32Type) {
   RunMatMulTest<int32_t>(9);
 }
@@ -215,7 +251,6 @@ TEST(MathOpTest, MatMulUint64Type) {
   RunMatMulTest<uint64_t>(9);
 }
 
-#if defined(USE_CUDA) || defined(USE_ROCM)
 TEST(MathOpTest, MatMul_Float16) {
 #ifdef USE_CUDA
   int min_cuda_architecture = 530;
@@ -246,7 +281,57 @@ TEST(MathOpTest, MatMul_Float16) {
       .Config(run_with_tunable_op)
       .RunWithConfig();
 }
-#endif
+
+TEST(MathOpTest, MatMul_Float16_Broadcast) {
+  OpTester test("MatMul", 13);
+
+  // Batched A with a shared B, large enough to cover the vectorized kernels and their tails.
+  constexpr int64_t batch = 2, M = 5, K = 7, N = 37;
+  std::vector<float> A(batch * M * K);
+  std::vector<float> B(K * N);
+  for (size_t i = 0; i < A.size(); i++) A[i] = static_cast<float>(static_cast<int>(i % 5) - 2);
+  for (size_t i = 0; i < B.size(); i++) B[i] = static_cast<float>(static_cast<int>(i % 7) - 3) * 0.5f;
+
+  std::vector<float> Y(batch * M * N, 0.0f);
+  for (int64_t b = 0; b < batch; b++) {
+    for (int64_t m = 0; m < M; m++) {
+      for (int64_t n = 0; n < N; n++) {
+        for (int64_t k = 0; k < K; k++) {
+          Y[(b * M + m) * N + n] += A[(b * M + m) * K + k] * B[k * N + n];
+        }
+      }
+    }
+  }
+
+  std::vector<MLFloat16> f_A(A.size());
+  std::vector<MLFloat16> f_B(B.size());
+  std::vector<MLFloat16> f_Y(Y.size());
+  ConvertFloatToMLFloat16(A.data(), f_A.data(), static_cast<int>(A.size()));
+  ConvertFloatToMLFloat16(B.data(), f_B.data(), static_cast<int>(B.size()));
+  ConvertFloatToMLFloat16(Y.data(), f_Y.data(), static_cast<int>(Y.size()));
+
+  test.AddInput<MLFloat16>("A", {batch, M, K}, f_A);
+  test.AddInput<MLFloat16>("B", {K, N}, f_B);
+  test.AddOutput<MLFloat16>("Y", {batch, M, N}, f_Y);
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
+
+TEST(MathOpTest, MatMul_bfloat16_Cpu) {
+  OpTester test("MatMul", 13);
+
+  test.AddInput<BFloat16>("A", {2, 4}, MakeBFloat16({1.0f, 2.0f, 3.0f, 4.0f, -1.0f, -2.0f, -3.0f, -4.0f}));
+  test.AddInput<BFloat16>("B", {4, 3}, MakeBFloat16({1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f, 1.f}));
+  test.AddOutput<BFloat16>("Y", {2, 3}, MakeBFloat16({10.0f, 10.0f, 10.0f, -10.0f, -10.0f, -10.0f}));
+
+  std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+  execution_providers.emplace_back(DefaultCpuExecutionProvider());
+  test.ConfigEps(std::move(execution_providers))
+      .RunWithConfig();
+}
 
 #if defined(USE_CUDA) || defined(USE_ROCM) || defined(USE_DNNL)
 TEST(MathOpTest, MatMul_bfloat16) {
@@ -366,5 +451,27 @@ TEST(MathOpTest, MatMulSharedPrepackedWeights) {
 
 #endif
 
+#ifdef ENABLE_STRIDED_TENSORS
+TEST(MathOpTest, MatMulStridedInput) {
+  // A is a transposed view on a {3, 2} buffer, read through the transA flag of the GEMM.
+  {
+    KernelComputeTester test("MatMul");
+    test.AddInput<float>("A", {2, 3}, {1.f, 4.f, 2.f, 5.f, 3.f, 6.f}, {1, 2});
+    test.AddInput<float>("B", {3, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    test.AddOutput<float>("Y", {2, 2}, {22.f, 28.f, 49.f, 64.f});
+    test.Run();
+  }
+
+  // B is a broadcast view, copied to a contiguous buffer first.
+  {
+    KernelComputeTester test("MatMul");
+    test.AddInput<float>("A", {2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    test.AddInput<float>("B", {3, 2}, {1.f, 2.f}, {0, 1});
+    test.AddOutput<float>("Y", {2, 2}, {6.f, 12.f, 15.f, 30.f});
+    test.Run();
+  }
+}
+#endif
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -230,6 +230,64 @@ TEST(QuantizeLinearMatmulOpTest, QLinearMatMul2D_S8S8) {
   run_test(true);
 }
 
+// K and N are multiples of 4, which the CUDA EP multiplies with the cuBLASLt IMMA kernels
+TEST(QuantizeLinearMatmulOpTest, QLinearMatMul3Dx2D_S8S8_Aligned) {
+  auto run_test = [](int8_t b_zero_point, const std::vector<int8_t>& expected, bool only_t1_not_initializer) {
+    OpTester test("QLinearMatMul", 10);
+    test.AddInput<int8_t>("T1", {2, 3, 8},
+                          {37, -51, 74, -104, -91, -80, 59, -99,
+                           -19, -109, -84, 94, 86, -93, -5, -82,
+                           89, -98, -65, -14, -97, 75, -103, -15,
+
+                           -105, -60, 20, 86, -55, -68, 29, -36,
+                           -76, -32, 62, -79, -96, -98, -23, 126,
+                           90, 32, 110, 104, 57, 25, -1, -36});
+
+    test.AddInput<float>("a_scale", {}, {0.0066f}, only_t1_not_initializer);
+    test.AddInput<int8_t>("a_zero_point", {}, {-15}, only_t1_not_initializer);
+
+    test.AddInput<int8_t>("T2", {8, 4},
+                          {-4, -87, 25, 125,
+                           47, 101, 19, -91,
+                           -68, 86, -44, 47,
+                           -51, 122, 87, -108,
+                           -89, 32, 46, 51,
+                           126, 105, -93, -81,
+                           10, 114, -95, -97,
+                           30, 100, 17, 69},
+                          only_t1_not_initializer);
+
+    test.AddInput<float>("b_scale", {}, {0.00802f}, only_t1_not_initializer);
+    test.AddInput<int8_t>("b_zero_point", {}, {b_zero_point}, only_t1_not_initializer);
+
+    test.AddInput<float>("y_scale", {}, {0.0123f}, only_t1_not_initializer);
+    test.AddInput<int8_t>("y_zero_point", {}, {-10}, only_t1_not_initializer);
+    test.AddOutput<int8_t>("T3", {2, 3, 4}, expected);
+
+    test.Run();
+  };
+
+  // without a weight zero point the requantization is fused into the GEMM
+  const std::vector<int8_t> expected{-38, -99, -83, 42,
+                                     -122, -63, 78, -15,
+                                     62, -117, -12, 55,
+
+                                     -64, 53, 2, -96,
+                                     -17, 8, -26, 66,
+                                     -73, 106, 17, -12};
+  const std::vector<int8_t> expected_b_zero_point{-37, -97, -81, 43,
+                                                  -121, -62, 79, -13,
+                                                  64, -115, -11, 57,
+
+                                                  -63, 54, 2, -95,
+                                                  -16, 10, -24, 67,
+                                                  -79, 99, 11, -19};
+  for (bool only_t1_not_initializer : {false, true}) {
+    run_test(0, expected, only_t1_not_initializer);
+    run_test(3, expected_b_zero_point, only_t1_not_initializer);
+  }
+}
+
 static void QLinearMatMul2DTest(bool only_t1_not_initializer) {
   // Test non-empty inputs
   OpTester test_non_empty("QLinearMatMul", 10);
@@ -861,5 +861,41 @@ TEST(TopKOperator, SelectTopKThreaded) {
   TestThreaded<double>(k, n, batch_size);
 }
 
+// rows long enough to be selected by MLAS, with repeated values so that ties have to be ranked by index.
+template <typename T>
+static void TestVocabularySizedRows(int64_t k, int64_t rows, int64_t vocab_size, int64_t largest) {
+  std::vector<T> input_vals(rows * vocab_size);
+  for (size_t i = 0; i < input_vals.size(); ++i) {
+    input_vals[i] = static_cast<T>(static_cast<int64_t>((i * 7919) % 1009) - 504) / 8;
+  }
+
+  std::vector<T> expected_vals(rows * k);
+  std::vector<int64_t> expected_indices(rows * k);
+  std::vector<int64_t> order(vocab_size);
+
+  for (int64_t r = 0; r < rows; ++r) {
+    const T* row = input_vals.data() + r * vocab_size;
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [row, largest](int64_t lhs, int64_t rhs) {
+      return largest ? row[lhs] > row[rhs] : row[lhs] < row[rhs];
+    });
+
+    for (int64_t i = 0; i < k; ++i) {
+      expected_vals[r * k + i] = row[order[i]];
+      expected_indices[r * k + i] = order[i];
+    }
+  }
+
+  RunTest(11, k, input_vals, {rows, vocab_size}, expected_vals, expected_indices, {rows, k}, false, -1, largest);
+}
+
+TEST(TopKOperator, VocabularySizedRows) {
+  TestVocabularySizedRows<float>(1, 3, 50257, 1);
+  TestVocabularySizedRows<float>(8, 3, 50257, 1);
+  TestVocabularySizedRows<float>(8, 3, 50257, 0);
+  TestVocabularySizedRows<float>(100, 1, 250002, 1);
+  TestVocabularySizedRows<float>(5000, 2, 8000, 0);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
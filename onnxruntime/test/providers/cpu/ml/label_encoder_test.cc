@@ -1,6 +1,8 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <limits>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -189,5 +191,39 @@ TEST(LabelEncoder, Int64ToInt64Opset2) {
   test.Run();
 }
 
+TEST(LabelEncoder, Int64ToInt64DenseKeysOpset2) {
+  // keys covering a dense range are looked up in an array, and the keys around the range map to the default
+  std::vector<std::int64_t> keys;
+  std::vector<std::int64_t> values;
+  for (std::int64_t key = -50; key < 50; key += 2) {
+    keys.push_back(key);
+    values.push_back(key * 10);
+  }
+
+  std::vector<std::int64_t> input;
+  std::vector<std::int64_t> output;
+  for (std::int64_t i = 0; i < 10000; ++i) {
+    const std::int64_t key = i % 120 - 60;
+    input.push_back(key);
+    output.push_back(key >= -50 && key < 50 && key % 2 == 0 ? key * 10 : -1);
+  }
+  input.push_back(std::numeric_limits<std::int64_t>::min());
+  output.push_back(-1);
+  input.push_back(std::numeric_limits<std::int64_t>::max());
+  output.push_back(-1);
+
+  OpTester test("LabelEncoder", 2, onnxruntime::kMLDomain);
+
+  test.AddAttribute("keys_int64s", keys);
+  test.AddAttribute("values_int64s", values);
+  test.AddAttribute("default_int64", (std::int64_t)-1);
+
+  std::vector<std::int64_t> dims{static_cast<std::int64_t>(input.size())};
+  test.AddInput<std::int64_t>("X", dims, input);
+  test.AddOutput<std::int64_t>("Y", dims, output);
+
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
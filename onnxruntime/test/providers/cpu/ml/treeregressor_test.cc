@@ -676,5 +676,63 @@ TEST(MLOpTest, TreeRegressorSingleTargetSum_as_tensor_precision) {
   GenTreeAndRunTest1_as_tensor_precision(3);
 }
 
+TEST(MLOpTest, TreeRegressorMissingValueTracksBatch) {
+  OpTester test("TreeEnsembleRegressor", 1, onnxruntime::kMLDomain);
+
+  //tree
+  std::vector<int64_t> lefts = {1, 0, 0};
+  std::vector<int64_t> rights = {2, 0, 0};
+  std::vector<int64_t> treeids = {0, 0, 0};
+  std::vector<int64_t> nodeids = {0, 1, 2};
+  std::vector<int64_t> featureids = {0, 0, 0};
+  std::vector<float> thresholds = {1, 0, 0};
+  std::vector<std::string> modes = {"BRANCH_LEQ", "LEAF", "LEAF"};
+  std::vector<int64_t> missing_tracks_true = {1, 0, 0};
+
+  std::vector<int64_t> target_treeids = {0, 0};
+  std::vector<int64_t> target_nodeids = {1, 2};
+  std::vector<int64_t> target_classids = {0, 0};
+  std::vector<float> target_weights = {1, 2};
+
+  //add attributes
+  test.AddAttribute("nodes_truenodeids", lefts);
+  test.AddAttribute("nodes_falsenodeids", rights);
+  test.AddAttribute("nodes_treeids", treeids);
+  test.AddAttribute("nodes_nodeids", nodeids);
+  test.AddAttribute("nodes_featureids", featureids);
+  test.AddAttribute("nodes_values", thresholds);
+  test.AddAttribute("nodes_modes", modes);
+  test.AddAttribute("nodes_missing_value_tracks_true", missing_tracks_true);
+  test.AddAttribute("target_treeids", target_treeids);
+  test.AddAttribute("target_nodeids", target_nodeids);
+  test.AddAttribute("target_ids", target_classids);
+  test.AddAttribute("target_weights", target_weights);
+  test.AddAttribute("n_targets", (int64_t)1);
+
+  // enough rows to span several blocks of rows walked together, with a missing value in every third row
+  const int64_t n_rows = 40;
+  std::vector<float> X(n_rows);
+  std::vector<float> Y(n_rows);
+  for (int64_t i = 0; i < n_rows; ++i) {
+    switch (i % 3) {
+      case 0:
+        X[i] = 0.5f;
+        Y[i] = 1.f;
+        break;
+      case 1:
+        X[i] = std::numeric_limits<float>::quiet_NaN();
+        Y[i] = 1.f;
+        break;
+      default:
+        X[i] = 2.f;
+        Y[i] = 2.f;
+        break;
+    }
+  }
+  test.AddInput<float>("X", {n_rows, 1}, X);
+  test.AddOutput<float>("Y", {n_rows, 1}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -55,6 +55,19 @@ TEST(MLOpTest, ZipMapOpInt64Float1D) {
   TestHelper<int64_t>({10, 20, 30, 40, 50, 60}, "int64_t", {6});
 }
 
+TEST(MLOpTest, ZipMapOpStringFloatUnsortedLabels) {
+  TestHelper<string>({"zebra", "ant", "moth"}, "string", {2, 3});
+}
+
+// a repeated label maps to the value of its last occurrence
+TEST(MLOpTest, ZipMapOpInt64FloatRepeatedLabels) {
+  OpTester test("ZipMap", 1, onnxruntime::kMLDomain);
+  test.AddAttribute("classlabels_int64s", std::vector<int64_t>{30, 10, 30});
+  test.AddInput<float>("X", {2, 3}, {1.f, 0.f, 3.f, 44.f, 23.f, 11.3f});
+  test.AddOutput<int64_t, float>("Z", {{{10, 0.f}, {30, 3.f}}, {{10, 23.f}, {30, 11.3f}}});
+  test.Run();
+}
+
 // Negative test cases
 TEST(MLOpTest, ZipMapOpStringFloatStrideMoreThanNumLabels) {
   TestHelper<string>({"class1", "class2", "class3"}, "string", {1, 6}, OpTester::ExpectResult::kExpectFailure);
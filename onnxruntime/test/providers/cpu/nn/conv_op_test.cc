@@ -1,8 +1,10 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include "core/session/onnxruntime_session_options_config_keys.h"
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
+#include "test/util/include/default_providers.h"
 using namespace std;
 namespace onnxruntime {
 namespace test {
@@ -725,5 +727,29 @@ TEST(ConvTest, Conv_AutoPad_with_non_default_strides) {
   TestConvOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape, true);
 }
 
+// In streaming mode every run provides the next frames of the stream and the frames of the previous run that are
+// still needed are kept as left context. The inputs of both runs are {1, 2, 3, 4} so the second run computes
+// the outputs of {0, 0, 1, 2, 3, 4, 1, 2, 3, 4} from its 5th frame onwards.
+TEST(ConvTest, Conv1D_Streaming) {
+  auto run_test = [](int num_run_calls, const vector<float>& expected_vals) {
+    OpTester test("Conv");
+    test.AddAttribute("kernel_shape", vector<int64_t>{3});
+    test.AddAttribute("pads", vector<int64_t>{2, 0});
+    test.AddInput<float>("X", {1, 1, 4}, {1.0f, 2.0f, 3.0f, 4.0f});
+    test.AddInput<float>("W", {1, 1, 3}, {1.0f, 1.0f, 1.0f});
+    test.AddOutput<float>("Y", {1, 1, 4}, expected_vals);
+    test.SetNumRunCalls(num_run_calls);
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigStreamingNodes, "node1"));
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  };
+
+  run_test(1, {1.0f, 3.0f, 6.0f, 9.0f});
+  run_test(2, {8.0f, 7.0f, 6.0f, 9.0f});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -851,6 +851,64 @@ TEST(ConvTransposeTest, ConvTranspose_2D_NonDefaultStridesAndDilations_T) {
   TestConvTransposeOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
 }
 
+// Stride 2 with padding, output padding, groups and a batch, which has output rows that no filter taps reach.
+TEST(ConvTransposeTest, ConvTranspose_2D_Stride2_Group_Batch) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{3, 3},        // kernel_shape
+      vector<int64_t>{1, 0},        // output_padding
+      {},                           // output_shape
+      vector<int64_t>{1, 1, 0, 0},  // pads
+      vector<int64_t>{2, 2},        // strides
+      vector<int64_t>{1, 1},        // dilations
+      2,                            // group
+      "NOTSET"                      // auto_pad
+  };
+  vector<float> X = {-3.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, 3.0f, -3.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, 3.0f, -3.0f,
+                     -2.0f};
+  vector<int64_t> X_shape = {2, 2, 2, 2};
+  vector<float> W = {-2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f,
+                     -2.0f, -1.0f, 0.0f};
+  vector<int64_t> W_shape = {2, 1, 3, 3};
+  vector<int64_t> Y_shape = {2, 2, 5, 4};
+  auto expected_vals = {-6.0f, 4.0f, -4.0f, 4.0f, 1.0f, -1.0f, 0.0f, -2.0f, -2.0f, 2.0f, 0.0f, 0.0f, 0.0f, -1.0f,
+                        0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 2.0f, 2.0f, 4.0f, -7.0f, -13.0f, 4.0f, 3.0f, 3.0f,
+                        6.0f, -3.0f, -6.0f, -3.0f, 6.0f, 3.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, -4.0f, 3.0f, -2.0f, 2.0f,
+                        0.0f, -3.0f, -1.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, 0.0f, -1.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f,
+                        0.0f, 2.0f, 4.0f, 3.0f, 6.0f, 4.0f, -7.0f, 1.0f, 2.0f, -3.0f, -6.0f, -2.0f, -4.0f, 3.0f, 4.0f,
+                        2.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+
+  TestConvTransposeOp(attrs, {X, W}, {X_shape, W_shape}, expected_vals, Y_shape);
+}
+
+// A filter equal to the strides without padding, which reads the input directly.
+TEST(ConvTransposeTest, ConvTranspose_2D_Stride2_Kernel2_Bias) {
+  ConvTransposeOpAttributes attrs = {
+      vector<int64_t>{2, 2},        // kernel_shape
+      {},                           // output_padding
+      {},                           // output_shape
+      vector<int64_t>{0, 0, 0, 0},  // pads
+      vector<int64_t>{2, 2},        // strides
+      vector<int64_t>{1, 1},        // dilations
+      1,                            // group
+      "NOTSET"                      // auto_pad
+  };
+  vector<float> X = {-3.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, 3.0f, -3.0f, -2.0f, -1.0f, 0.0f, 1.0f};
+  vector<int64_t> X_shape = {1, 2, 2, 3};
+  vector<float> W = {-2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f, 2.0f,
+                     -2.0f, -1.0f, 0.0f, 1.0f, 2.0f, -2.0f, -1.0f, 0.0f, 1.0f};
+  vector<int64_t> W_shape = {2, 3, 2, 2};
+  vector<float> B = {1.0f, 2.0f, 3.0f};
+  vector<int64_t> B_shape = {3};
+  vector<int64_t> Y_shape = {1, 3, 4, 6};
+  auto expected_vals = {7.0f, 7.0f, 5.0f, 0.0f, 3.0f, 0.0f, 7.0f, -8.0f, -5.0f, 5.0f, -3.0f, 4.0f, 1.0f, 0.0f, -1.0f,
+                        0.0f, -3.0f, 0.0f, -1.0f, 3.0f, 1.0f, 2.0f, 3.0f, 1.0f, -7.0f, 8.0f, 1.0f, 6.0f, 2.0f, 4.0f,
+                        8.0f, 8.0f, 1.0f, -4.0f, 1.0f, -2.0f, 3.0f, 2.0f, 4.0f, 0.0f, 5.0f, -2.0f, 1.0f, 0.0f, 1.0f,
+                        2.0f, 1.0f, 4.0f, -6.0f, -6.0f, 7.0f, 2.0f, 6.0f, 3.0f, 9.0f, 9.0f, 7.0f, 2.0f, 5.0f, 2.0f,
+                        5.0f, 4.0f, 4.0f, 5.0f, 3.0f, 6.0f, 3.0f, 2.0f, 1.0f, 2.0f, -1.0f, 2.0f};
+
+  TestConvTransposeOp(attrs, {X, W, B}, {X_shape, W_shape, B_shape}, expected_vals, Y_shape);
+}
+
 TEST(ConvTransposeTest, DimWithZero) {
   ConvTransposeOpAttributes attrs = {
       vector<int64_t>{3, 3},        // kernel_shape
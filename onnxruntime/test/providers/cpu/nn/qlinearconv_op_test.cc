@@ -1141,6 +1141,41 @@ TEST(QLinearConvTest, Conv2D_S8S8_Sym_M32_C32_Bias_Pads) {
   test.Run();
 }
 
+TEST(QLinearConvTest, Conv2D_S8S8_Sym_Groups_Bias_Pads) {
+  QLinearConvOpTester<int8_t, int8_t> test;
+  test.GenerateRandomInput({2, 16, 15, 11}, .05f, -4);
+  test.GenerateRandomWeights({32, 8, 3, 3}, .125f, 0);
+  test.GenerateRandomBias();
+  test.SetPads({1, 1, 1, 1});
+  test.SetGroups(2);
+  test.SetOutputScaleAndZeroPoint(.55f, 54);
+  test.Run();
+}
+
+TEST(QLinearConvTest, Conv2D_S8S8_Sym_Groups_Strides_Dilations) {
+  QLinearConvOpTester<int8_t, int8_t> test;
+  test.GenerateRandomInput({1, 32, 17, 13}, .05f, 4);
+  test.GenerateRandomWeights({64, 8, 3, 3}, .125f, 0);
+  test.SetWeightScales(std::vector<float>(64, .125f));
+  test.GenerateRandomBias();
+  test.SetPads({2, 1, 2, 1});
+  test.SetStrides({2, 2});
+  test.SetDilations({2, 1});
+  test.SetGroups(4);
+  test.SetOutputScaleAndZeroPoint(.55f, 54);
+  test.Run();
+}
+
+TEST(QLinearConvTest, Conv2D_S8S8_Sym_Groups_Pointwise) {
+  QLinearConvOpTester<int8_t, int8_t> test;
+  test.GenerateRandomInput({1, 32, 17, 13}, .05f, 4);
+  test.GenerateRandomWeights({32, 16, 1, 1}, .125f, 0);
+  test.GenerateRandomBias();
+  test.SetGroups(2);
+  test.SetOutputScaleAndZeroPoint(.26f, -8);
+  test.Run();
+}
+
 TEST(QLinearConvTest, Conv2D_S8S8) {
   QLinearConvOpTester<int8_t, int8_t> test;
   test.GenerateRandomInput({3, 24, 15, 11}, .05f, 4);
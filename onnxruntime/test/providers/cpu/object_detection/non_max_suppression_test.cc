@@ -383,5 +383,45 @@ TEST(NonMaxSuppressionOpTest, WithIOUThresholdOpset11) {
   test.Run();
 }
 
+// more selected boxes than a block of the IOU computation, over several batches and classes
+TEST(NonMaxSuppressionOpTest, ManyBoxes_TwoBatches_ThreeClasses) {
+  constexpr int64_t num_batches = 2;
+  constexpr int64_t num_classes = 3;
+  constexpr int64_t num_unique_boxes = 20;
+  constexpr int64_t num_boxes = 2 * num_unique_boxes;
+
+  // box i is followed by a lower scoring copy at num_unique_boxes + i shifted by 0.1, which it suppresses
+  std::vector<float> boxes;
+  std::vector<float> scores;
+  std::vector<int64_t> selected_indices;
+  for (int64_t b = 0; b < num_batches; ++b) {
+    for (int64_t copy = 0; copy < 2; ++copy) {
+      for (int64_t i = 0; i < num_unique_boxes; ++i) {
+        const float x = 2.0f * i + 0.1f * copy;
+        boxes.insert(boxes.end(), {0.0f, x, 1.0f, x + 1.0f});
+      }
+    }
+    for (int64_t c = 0; c < num_classes; ++c) {
+      for (int64_t copy = 0; copy < 2; ++copy) {
+        for (int64_t i = 0; i < num_unique_boxes; ++i) {
+          scores.push_back((copy == 0 ? 0.9f : 0.4f) - 0.01f * (i + c));
+        }
+      }
+      for (int64_t i = 0; i < num_unique_boxes; ++i) {
+        selected_indices.insert(selected_indices.end(), {b, c, i});
+      }
+    }
+  }
+
+  OpTester test("NonMaxSuppression", 11, kOnnxDomain);
+  test.AddInput<float>("boxes", {num_batches, num_boxes, 4}, boxes);
+  test.AddInput<float>("scores", {num_batches, num_classes, num_boxes}, scores);
+  test.AddInput<int64_t>("max_output_boxes_per_class", {}, {100L});
+  test.AddInput<float>("iou_threshold", {}, {0.5f});
+  test.AddInput<float>("score_threshold", {}, {0.0f});
+  test.AddOutput<int64_t>("selected_indices", {num_batches * num_classes * num_unique_boxes, 3}, selected_indices);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
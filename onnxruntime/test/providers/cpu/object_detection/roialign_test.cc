@@ -381,5 +381,39 @@ TEST(RoiAlignTest, MismatchNumRois) {
 
   test.Run(OpTester::ExpectResult::kExpectFailure, "[ShapeInferenceError] Dimension mismatch in unification between 4 and 5");
 }
+// more channels than a block of the kernel, and not a multiple of the channel group
+TEST(RoiAlignTest, AvgModeManyChannels) {
+  constexpr int64_t N = 2;
+  constexpr int64_t C = 37;
+  constexpr int64_t H = 6;
+  constexpr int64_t W = 6;
+
+  OpTester test("RoiAlign", 16);
+  test.AddAttribute<int64_t>("output_height", 2);
+  test.AddAttribute<int64_t>("output_width", 3);
+  test.AddAttribute<int64_t>("sampling_ratio", 2);
+  test.AddAttribute<float>("spatial_scale", 1.0f);
+
+  // each channel is constant, so the bilinear samples of a ROI inside the feature map reproduce it
+  std::vector<float> X(N * C * H * W);
+  for (size_t i = 0; i < X.size(); ++i) {
+    X[i] = static_cast<float>(i / (H * W));
+  }
+
+  const std::vector<int64_t> batch_indices{1, 0, 1};
+  std::vector<float> Y;
+  for (int64_t batch_index : batch_indices) {
+    for (int64_t c = 0; c < C; ++c) {
+      Y.insert(Y.end(), 2 * 3, static_cast<float>(batch_index * C + c));
+    }
+  }
+
+  test.AddInput<float>("X", {N, C, H, W}, X);
+  test.AddInput<float>("rois", {3, 4}, {1.0f, 1.0f, 4.0f, 4.0f, 0.5f, 2.0f, 3.5f, 4.5f, 2.0f, 0.0f, 5.0f, 3.0f});
+  test.AddInput<int64_t>("batch_indices", {3}, batch_indices);
+  test.AddOutput<float>("Y", {3, C, 2, 3}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
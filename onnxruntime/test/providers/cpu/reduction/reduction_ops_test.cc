@@ -730,6 +730,120 @@ TEST(ReductionOpTest, ReduceLogSumExp) {
   test.Run();
 }
 
+// Interleaved reduced axes over a tensor large enough to split the reduction across threads.
+TEST(ReductionOpTest, ReduceInterleavedAxesLarge) {
+  const std::vector<int64_t> dims{16, 3, 64, 5, 8};
+  const std::vector<int64_t> axes{0, 2, 4};
+  const int64_t kept0 = dims[1];
+  const int64_t kept1 = dims[3];
+  const int64_t reduce_count = dims[0] * dims[2] * dims[4];
+
+  std::vector<float> data(dims[0] * dims[1] * dims[2] * dims[3] * dims[4]);
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = static_cast<float>(static_cast<int>((i * 7919) % 201) - 100) / 50.0f;
+  }
+
+  std::vector<float> sum(kept0 * kept1, 0.0f);
+  std::vector<float> maximum(kept0 * kept1, std::numeric_limits<float>::lowest());
+  std::vector<double> sum_exp(kept0 * kept1, 0.0);
+  for (int64_t i0 = 0; i0 < dims[0]; ++i0) {
+    for (int64_t i1 = 0; i1 < dims[1]; ++i1) {
+      for (int64_t i2 = 0; i2 < dims[2]; ++i2) {
+        for (int64_t i3 = 0; i3 < dims[3]; ++i3) {
+          for (int64_t i4 = 0; i4 < dims[4]; ++i4) {
+            const float v = data[(((i0 * dims[1] + i1) * dims[2] + i2) * dims[3] + i3) * dims[4] + i4];
+            sum[i1 * kept1 + i3] += v;
+            maximum[i1 * kept1 + i3] = std::max(maximum[i1 * kept1 + i3], v);
+            sum_exp[i1 * kept1 + i3] += std::exp(static_cast<double>(v));
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<float> mean(sum.size());
+  std::vector<float> log_sum_exp(sum.size());
+  for (size_t i = 0; i < sum.size(); ++i) {
+    mean[i] = sum[i] / static_cast<float>(reduce_count);
+    log_sum_exp[i] = static_cast<float>(std::log(sum_exp[i]));
+  }
+
+  auto run = [&](const char* op, const std::vector<float>& expected) {
+    OpTester test(op);
+    test.AddAttribute("axes", axes);
+    test.AddAttribute("keepdims", (int64_t)0);
+    test.AddInput<float>("data", dims, data);
+    test.AddOutput<float>("reduced", {kept0, kept1}, expected);
+    test.SetOutputAbsErr("reduced", 1e-4f);
+    test.Run();
+  };
+  run("ReduceMean", mean);
+  run("ReduceMax", maximum);
+  run("ReduceLogSumExp", log_sum_exp);
+}
+
+// Reductions of a long middle or last axis with few outputs, which the CUDA EP splits across thread blocks.
+TEST(ReductionOpTest, ReduceLongAxisFewOutputs) {
+  auto test_reductions = [](const std::vector<int64_t>& dims) {
+    const int64_t axis = 1;
+    const int64_t outer_count = dims[0];
+    const int64_t reduce_count = dims[1];
+    const int64_t inner_count = dims.size() > 2 ? dims[2] : 1;
+
+    std::vector<float> data(outer_count * reduce_count * inner_count);
+    for (size_t i = 0; i < data.size(); ++i) {
+      data[i] = static_cast<float>(static_cast<int>((i * 7919) % 201) - 100) / 100.0f;
+    }
+
+    std::vector<double> sum_abs(outer_count * inner_count, 0.0);
+    std::vector<double> sum_square(outer_count * inner_count, 0.0);
+    std::vector<double> sum_exp(outer_count * inner_count, 0.0);
+    std::vector<float> minimum(outer_count * inner_count, std::numeric_limits<float>::max());
+    for (int64_t o = 0; o < outer_count; ++o) {
+      for (int64_t r = 0; r < reduce_count; ++r) {
+        for (int64_t i = 0; i < inner_count; ++i) {
+          const float v = data[(o * reduce_count + r) * inner_count + i];
+          const int64_t y = o * inner_count + i;
+          sum_abs[y] += std::abs(v);
+          sum_square[y] += static_cast<double>(v) * v;
+          sum_exp[y] += std::exp(static_cast<double>(v));
+          minimum[y] = std::min(minimum[y], v);
+        }
+      }
+    }
+
+    std::vector<float> l1(sum_abs.size()), l2(sum_abs.size()), square(sum_abs.size()), log_sum_exp(sum_abs.size());
+    for (size_t y = 0; y < sum_abs.size(); ++y) {
+      l1[y] = static_cast<float>(sum_abs[y]);
+      l2[y] = static_cast<float>(std::sqrt(sum_square[y]));
+      square[y] = static_cast<float>(sum_square[y]);
+      log_sum_exp[y] = static_cast<float>(std::log(sum_exp[y]));
+    }
+
+    std::vector<int64_t> output_dims(dims);
+    output_dims.erase(output_dims.begin() + axis);
+    auto run = [&](const char* op, const std::vector<float>& expected, float tolerance) {
+      SCOPED_TRACE(MakeString(op, " dims: ", TensorShape(dims)));
+      OpTester test(op);
+      test.AddAttribute("axes", std::vector<int64_t>{axis});
+      test.AddAttribute("keepdims", (int64_t)0);
+      test.AddInput<float>("data", dims, data);
+      test.AddOutput<float>("reduced", output_dims, expected);
+      test.SetOutputRelErr("reduced", tolerance);
+      test.Run();
+    };
+    run("ReduceL1", l1, 1e-4f);
+    run("ReduceL2", l2, 1e-4f);
+    run("ReduceSumSquare", square, 1e-4f);
+    run("ReduceMin", minimum, 1e-6f);
+    run("ReduceLogSumExp", log_sum_exp, 1e-4f);
+  };
+
+  test_reductions({3, 4096, 5});
+  test_reductions({2, 9000});
+  test_reductions({1, 20000, 2});
+}
+
 #if defined(USE_DNNL)
 TEST(ReductionOpTest, ReduceLogSumExp_bfloat16) {
 #ifdef USE_DNNL
@@ -5,7 +5,7 @@
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
-#if defined(ENABLE_STRIDED_TENSORS) && (defined(USE_CUDA) || defined(USE_ROCM))
+#ifdef ENABLE_STRIDED_TENSORS
 #include "test/providers/kernel_compute_test_utils.h"
 #endif
 
@@ -187,12 +187,14 @@ TEST(ExpandOpTest, Expand_scalar_int32) {
   test.Run();
 }
 
-#if defined(ENABLE_STRIDED_TENSORS) && (defined(USE_CUDA) || defined(USE_ROCM))
+#ifdef ENABLE_STRIDED_TENSORS
 TEST(ExpandOpTest, Strided) {
-#ifdef USE_CUDA
+#if defined(USE_CUDA)
   const char* provider = kCudaExecutionProvider;
-#else  // USE_ROCM
+#elif defined(USE_ROCM)
   const char* provider = kRocmExecutionProvider;
+#else
+  const char* provider = kCpuExecutionProvider;
 #endif
   // Generate contiguous output.
   {
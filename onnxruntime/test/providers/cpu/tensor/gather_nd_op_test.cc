@@ -321,5 +321,30 @@ TEST(GatherNDOpTest, GatherND_slice_int64_t) {
   test.Run();
 }
 
+// slices of 32 floats, which the CUDA EP copies with 16 byte vectors
+TEST(GatherNDOpTest, GatherND_slice_rows_batch_dims_one) {
+  std::vector<float> data(2 * 3 * 32);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<float>(i);
+  }
+
+  const std::vector<int64_t> indices{2, 0, -1, 1};
+  std::vector<float> output;
+  for (int64_t b = 0; b < 2; b++) {
+    for (int64_t s = 0; s < 2; s++) {
+      const int64_t index = indices[b * 2 + s];
+      const float* slice = data.data() + (b * 3 + (index < 0 ? index + 3 : index)) * 32;
+      output.insert(output.end(), slice, slice + 32);
+    }
+  }
+
+  OpTester test("GatherND", 12, kOnnxDomain);
+  test.AddAttribute<int64_t>("batch_dims", 1);
+  test.AddInput<float>("data", {2, 3, 32}, data);
+  test.AddInput<int64_t>("indices", {2, 2, 1}, indices);
+  test.AddOutput<float>("output", {2, 2, 32}, output);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -404,6 +404,46 @@ TEST(GatherOpTest, Gather_perf) {
   test.Run();
 }
 
+// rows of 36 and 34 int32 values, which the CUDA EP copies with 16 and 8 byte vectors
+TEST(GatherOpTest, Gather_rows) {
+  // gathers along axis 0 of {axis_dim, row_size} without outer dimension, else along axis 1 of
+  // {outer, axis_dim, row_size}
+  auto run_test = [](int64_t outer, int64_t axis_dim, int64_t row_size) {
+    const int64_t axis = outer == 0 ? 0 : 1;
+    outer = std::max<int64_t>(outer, 1);
+    std::vector<int32_t> data(static_cast<size_t>(outer * axis_dim * row_size));
+    for (size_t i = 0; i < data.size(); i++) {
+      data[i] = static_cast<int32_t>(i);
+    }
+
+    const std::vector<int64_t> indices{3, -1, 0, 3, 1, -2};
+    std::vector<int32_t> output;
+    for (int64_t o = 0; o < outer; o++) {
+      for (int64_t index : indices) {
+        const int64_t idx = index < 0 ? index + axis_dim : index;
+        const int32_t* row = data.data() + (o * axis_dim + idx) * row_size;
+        output.insert(output.end(), row, row + row_size);
+      }
+    }
+
+    const std::vector<int64_t> dims = axis == 0 ? std::vector<int64_t>{axis_dim, row_size}
+                                                : std::vector<int64_t>{outer, axis_dim, row_size};
+    const std::vector<int64_t> output_dims = axis == 0 ? std::vector<int64_t>{2, 3, row_size}
+                                                       : std::vector<int64_t>{outer, 2, 3, row_size};
+
+    OpTester test("Gather", 13);
+    test.AddAttribute<int64_t>("axis", axis);
+    test.AddInput<int32_t>("data", dims, data);
+    test.AddInput<int64_t>("indices", {2, 3}, indices);
+    test.AddOutput<int32_t>("output", output_dims, output);
+    test.Run();
+  };
+
+  run_test(0, 5, 36);
+  run_test(2, 4, 36);
+  run_test(3, 5, 34);
+}
+
 TEST(GatherOpTest, Gather_axis1_neg_indices2d_int8) {
   OpTester test("Gather", 11);
   test.AddAttribute<int64_t>("axis", 1LL);
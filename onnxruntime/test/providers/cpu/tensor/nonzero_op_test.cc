@@ -99,5 +99,29 @@ TEST(NonZeroOpTest, EmptyInput) {
   test.Run();
 }
 
+TEST(NonZeroOpTest, LargeInput) {
+  // large enough to be split between threads
+  constexpr int64_t kRows = 3;
+  constexpr int64_t kCols = 50000;
+
+  std::vector<int32_t> X(kRows * kCols, 0);
+  std::vector<int64_t> rows, cols;
+  for (int64_t r = 0; r < kRows; ++r) {
+    for (int64_t c = r; c < kCols; c += 7) {
+      X[r * kCols + c] = 1;
+      rows.push_back(r);
+      cols.push_back(c);
+    }
+  }
+
+  std::vector<int64_t> Y = rows;
+  Y.insert(Y.end(), cols.begin(), cols.end());
+
+  OpTester test{kOpName, kOpVersion};
+  test.AddInput<int32_t>("X", {kRows, kCols}, X);
+  test.AddOutput<int64_t>("Y", {2, static_cast<int64_t>(rows.size())}, Y);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -805,5 +805,26 @@ TEST(PadOpTest, BoolType) {
   test.Run(OpTester::ExpectResult::kExpectSuccess, "", {kTensorrtExecutionProvider});
 }
 
+// In streaming mode the innermost axis is only padded at the start of the stream and never at its end
+TEST(PadOpTest, Streaming) {
+  auto run_test = [](int num_run_calls, const std::vector<int64_t>& output_dims, const std::vector<float>& output) {
+    OpTester test("Pad", 13);
+    test.AddAttribute("mode", "constant");
+    test.AddInput<float>("data", {1, 1, 3}, {1.0f, 2.0f, 3.0f});
+    test.AddInput<int64_t>("pads", {6}, {0, 0, 2, 0, 0, 1});
+    test.AddOutput<float>("output", output_dims, output);
+    test.SetNumRunCalls(num_run_calls);
+
+    SessionOptions so;
+    ASSERT_STATUS_OK(so.config_options.AddConfigEntry(kOrtSessionOptionsConfigStreamingNodes, "node1"));
+    std::vector<std::unique_ptr<IExecutionProvider>> execution_providers;
+    execution_providers.push_back(DefaultCpuExecutionProvider());
+    test.Run(so, OpTester::ExpectResult::kExpectSuccess, "", {}, nullptr, &execution_providers);
+  };
+
+  run_test(1, {1, 1, 5}, {0.0f, 0.0f, 1.0f, 2.0f, 3.0f});
+  run_test(2, {1, 1, 3}, {1.0f, 2.0f, 3.0f});
+}
+
 }  // namespace test
 }  // namespace onnxruntime
@@ -180,5 +180,28 @@ TEST(ScatterNDOpTest, ScatterND_batched_3tensor_int64) {
   test3.Run();
 }
 
+// update slices of 36 floats, which the CUDA EP copies with 16 byte vectors
+TEST(ScatterNDOpTest, ScatterND_slice_rows_float_int64_t) {
+  std::vector<float> data(2 * 4 * 36, 0.0f);
+  std::vector<float> updates(3 * 36);
+  for (size_t i = 0; i < updates.size(); i++) {
+    updates[i] = static_cast<float>(i + 1);
+  }
+
+  const std::vector<int64_t> indices{1, 2, 0, -1, 0, 0};
+  std::vector<float> output = data;
+  for (size_t u = 0; u < 3; u++) {
+    const int64_t row = indices[2 * u] * 4 + (indices[2 * u + 1] < 0 ? indices[2 * u + 1] + 4 : indices[2 * u + 1]);
+    std::copy(updates.begin() + u * 36, updates.begin() + (u + 1) * 36, output.begin() + row * 36);
+  }
+
+  OpTester test("ScatterND", 11);
+  test.AddInput<float>("data", {2, 4, 36}, data);
+  test.AddInput<int64_t>("indices", {3, 2}, indices);
+  test.AddInput<float>("updates", {3, 36}, updates);
+  test.AddOutput<float>("output", {2, 4, 36}, output);
+  test.Run();
+}
+
 }  // namespace test
 }  // namespace onnxruntime
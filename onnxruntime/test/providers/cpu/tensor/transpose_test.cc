@@ -8,6 +8,9 @@
 #include "core/providers/cpu/tensor/transpose.h"
 #include "test/util/include/default_providers.h"
 #include "test/util/include/asserts.h"
+#ifdef ENABLE_STRIDED_TENSORS
+#include "test/providers/kernel_compute_test_utils.h"
+#endif
 
 namespace onnxruntime {
 namespace test {
@@ -756,6 +759,72 @@ TEST(TransposeOpTest, Transpose3DImpl) {
   }
 }
 
+TEST(TransposeOpTest, TransposeTiledImpl) {
+  // Innermost dim moves to the middle, with batch dims on both sides.
+  {
+    const std::vector<int64_t> X_dims{4, 40, 24, 72};
+    const std::vector<int64_t> perm{1, 3, 0, 2};
+    const std::vector<int64_t> Y_dims{40, 72, 4, 24};
+    TestTranspose(perm, X_dims, Y_dims);
+  }
+
+  // The innermost output dim is the outermost input dim.
+  {
+    const std::vector<int64_t> X_dims{33, 5, 3, 47};
+    const std::vector<int64_t> perm{2, 3, 1, 0};
+    const std::vector<int64_t> Y_dims{3, 47, 5, 33};
+    TestTranspose(perm, X_dims, Y_dims);
+  }
+
+  // Rank 5 without mergeable dims.
+  {
+    const std::vector<int64_t> X_dims{3, 4, 20, 64, 36};
+    const std::vector<int64_t> perm{4, 1, 3, 0, 2};
+    const std::vector<int64_t> Y_dims{36, 4, 64, 3, 20};
+    TestTranspose(perm, X_dims, Y_dims);
+  }
+}
+
+TEST(TransposeOpTest, TransposeInnermostDimVectorized) {
+  // Rank 5 keeping the innermost dim, copied as 128-bit vectors.
+  {
+    const std::vector<int64_t> X_dims{3, 4, 5, 6, 8};
+    const std::vector<int64_t> perm{2, 0, 3, 1, 4};
+    const std::vector<int64_t> Y_dims{5, 3, 6, 4, 8};
+    TestTranspose(perm, X_dims, Y_dims);
+  }
+
+  // Rows of 2 floats, copied as 64-bit vectors.
+  {
+    const std::vector<int64_t> X_dims{8, 5, 7, 2};
+    const std::vector<int64_t> perm{1, 2, 0, 3};
+    const std::vector<int64_t> Y_dims{5, 7, 8, 2};
+    TestTranspose(perm, X_dims, Y_dims);
+  }
+}
+
+#endif
+
+#ifdef ENABLE_STRIDED_TENSORS
+TEST(TransposeOpTest, Strided) {
+  // Strided output, a view on the input with permuted strides.
+  {
+    KernelComputeTester test("Transpose");
+    test.AddInput<float>("input", {1, 2, 3}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f});
+    test.AddAttribute("perm", std::vector<int64_t>{2, 0, 1});
+    test.AddOutput<float>("output", {3, 1, 2}, {1.f, 2.f, 3.f, 4.f, 5.f, 6.f}, {1, 6, 3});
+    test.Run({0});
+  }
+
+  // Strided input, gathered into a contiguous output.
+  {
+    KernelComputeTester test("Transpose");
+    test.AddInput<float>("input", {2, 3}, {1.f, 4.f, 2.f, 5.f, 3.f, 6.f}, {1, 2});
+    test.AddAttribute("perm", std::vector<int64_t>{1, 0});
+    test.AddOutput<float>("output", {3, 2}, {1.f, 4.f, 2.f, 5.f, 3.f, 6.f});
+    test.Run();
+  }
+}
 #endif
 
 }  // namespace test
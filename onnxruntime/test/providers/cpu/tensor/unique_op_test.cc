@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <algorithm>
+#include <map>
+
 #include "gtest/gtest.h"
 #include "test/providers/provider_test_utils.h"
 
@@ -375,5 +378,58 @@ TEST(Unique, EmptyInput) {
   test.Run();
 }
 
+// input large enough to be split between threads, with each value repeated throughout the input
+static void RunLargeFlattenedTest(bool sorted) {
+  constexpr int64_t kNumValues = 1000;
+  constexpr int64_t kSize = 100000;
+
+  std::vector<int64_t> X(kSize);
+  for (int64_t i = 0; i < kSize; ++i) {
+    X[i] = (i * 7919) % kNumValues - kNumValues / 2;
+  }
+
+  // expected output, in the order of first occurrence
+  std::map<int64_t, int64_t> first_occurrence;
+  std::vector<int64_t> unsorted_Y;
+  for (int64_t i = 0; i < kSize; ++i) {
+    if (first_occurrence.emplace(X[i], i).second) {
+      unsorted_Y.push_back(X[i]);
+    }
+  }
+
+  std::vector<int64_t> Y = unsorted_Y;
+  if (sorted) {
+    std::sort(Y.begin(), Y.end());
+  }
+
+  std::map<int64_t, int64_t> output_index;
+  for (size_t i = 0; i < Y.size(); ++i) {
+    output_index[Y[i]] = static_cast<int64_t>(i);
+  }
+
+  std::vector<int64_t> indices(Y.size());
+  std::vector<int64_t> counts(Y.size(), 0);
+  std::vector<int64_t> inverse_indices(kSize);
+  for (size_t i = 0; i < Y.size(); ++i) {
+    indices[i] = first_occurrence[Y[i]];
+  }
+  for (int64_t i = 0; i < kSize; ++i) {
+    inverse_indices[i] = output_index[X[i]];
+    ++counts[inverse_indices[i]];
+  }
+
+  const std::vector<int64_t> unique_dims{static_cast<int64_t>(Y.size())};
+  RunUniqueTest<int64_t>({kSize}, X, nullptr, sorted, unique_dims, Y, unique_dims, indices,
+                         {kSize}, inverse_indices, unique_dims, counts);
+}
+
+TEST(Unique, Flatten_Sorted_Large) {
+  RunLargeFlattenedTest(true);
+}
+
+TEST(Unique, Flatten_Unsorted_Large) {
+  RunLargeFlattenedTest(false);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
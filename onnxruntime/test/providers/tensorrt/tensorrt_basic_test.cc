@@ -151,6 +151,9 @@ void RunWithOneSessionSingleThreadInference(std::string model_name, std::string
       nullptr,
       0,
       0,
+      0,
+      1,
+      0,
       0};
 
     params.trt_engine_cache_enable = 1;
@@ -222,6 +225,9 @@ void RunWithOneSessionMultiThreadsInference(std::string model_name, std::string
       nullptr,
       0,
       0,
+      0,
+      1,
+      0,
       0};
 
     params.trt_engine_cache_enable = 1;
@@ -425,6 +431,9 @@ TEST_P(TensorrtExecutionProviderCacheTest, Run) {
       nullptr,
       0,
       0,
+      0,
+      1,
+      0,
       0};
 
   if (cache_type.compare("engine") == 0) {
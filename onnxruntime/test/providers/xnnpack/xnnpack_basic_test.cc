@@ -387,6 +387,23 @@ TEST(XnnpackEP, TestQDQSoftMax_axisLast) {
                {ExpectedEPNodeAssignment::All});
 }
 
+TEST(XnnpackEP, TestBroadcastAddMulSigmoid) {
+  auto modelBuilder = [](ModelTestBuilder& builder) {
+    auto* input_arg = builder.MakeInput<float>(std::vector<int64_t>{1, 4, 3, 5}, -4.f, 4.f);
+    auto* bias_arg = builder.MakeInitializer<float>(std::vector<int64_t>{5}, -1.f, 1.f);
+    auto* scale_arg = builder.MakeInitializer<float>(std::vector<int64_t>{4, 1, 1}, -2.f, 2.f);
+
+    auto* add_output = builder.MakeIntermediate();
+    auto* mul_output = builder.MakeIntermediate();
+    auto* output_arg = builder.MakeOutput();
+    builder.AddNode("Add", {input_arg, bias_arg}, {add_output});
+    builder.AddNode("Mul", {scale_arg, add_output}, {mul_output});
+    builder.AddNode("Sigmoid", {mul_output}, {output_arg});
+  };
+  RunModelTest(modelBuilder, "xnnpack_test_graph_add_mul_sigmoid",
+               {ExpectedEPNodeAssignment::All});
+}
+
 TEST(XnnpackEP, TestConvTranspose) {
   // Conv+ConvTranspose with attributes of Group and Dilation
   const ORTCHAR_T* ort_model_path = ORT_MODEL_FOLDER "test_conv_follow_convtrans.onnx";
@@ -402,6 +402,33 @@ class TestInferenceSession(unittest.TestCase):
         output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
         np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
 
+    def testWarmup(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=available_providers)
+        stats = sess.warmup([{"X": [3, 2]}, {"X": [3, 2]}], num_runs_per_shape_set=2)
+        self.assertEqual(len(stats["shape_sets"]), 2)
+        self.assertGreaterEqual(stats["shape_sets"][0]["first_run_ms"], 0.0)
+        with self.assertRaises(Exception):
+            sess.warmup([{"Y": [3, 2]}])
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        res = sess.run(["Y"], {"X": x})
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
+    def testClone(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=available_providers)
+        so = onnxrt.SessionOptions()
+        so.intra_op_num_threads = 1
+        so.logid = "ClonedSession"
+        clone = sess.clone(so)
+        self.assertEqual(clone.get_session_options().logid, "ClonedSession")
+        self.assertEqual(clone.get_inputs()[0].name, "X")
+        # the clone keeps the session it was cloned from alive
+        del sess
+        x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
+        res = clone.run(["Y"], {"X": x})
+        output_expected = np.array([[1.0, 4.0], [9.0, 16.0], [25.0, 36.0]], dtype=np.float32)
+        np.testing.assert_allclose(output_expected, res[0], rtol=1e-05, atol=1e-08)
+
     def testRunModelFromBytes(self):
         with open(get_name("mul_1.onnx"), "rb") as f:
             content = f.read()
@@ -482,6 +509,24 @@ class TestInferenceSession(unittest.TestCase):
             t1.join()
             t2.join()
 
+    def testRunBatch(self):
+        sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=["CPUExecutionProvider"])
+        input_name = sess.get_inputs()[0].name
+        xs = [np.full((3, 2), i, dtype=np.float32) for i in range(8)]
+        input_feeds = [{input_name: x} for x in xs]
+
+        for max_concurrency in [0, 1, 3]:
+            results = sess.run_batch([], input_feeds, max_concurrency=max_concurrency)
+            self.assertEqual(len(results), len(xs))
+            for x, res in zip(xs, results):
+                np.testing.assert_allclose(x * x, res[0], rtol=1e-05, atol=1e-08)
+
+        self.assertEqual(sess.run_batch([], []), [])
+        with self.assertRaises(ValueError):
+            sess.run_batch([], [{}])
+        with self.assertRaises(ValueError):
+            sess.run_batch([], input_feeds, max_concurrency=-1)
+
     def testListAsInput(self):
         sess = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=onnxrt.get_available_providers())
         x = np.array([[1.0, 2.0], [3.0, 4.0], [5.0, 6.0]], dtype=np.float32)
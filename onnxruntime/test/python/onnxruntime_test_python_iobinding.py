@@ -66,6 +66,24 @@ class TestIOBinding(unittest.TestCase):
         # Validate results
         self.assertTrue(np.array_equal(self.create_expected_output(), ort_output))
 
+    @unittest.skipIf(not hasattr(np.ndarray, "__dlpack__"), "numpy does not implement the DLPack protocol")
+    def test_bind_dlpack_input_and_output_on_cpu(self):
+        session = onnxrt.InferenceSession(get_name("mul_1.onnx"), providers=["CPUExecutionProvider"])
+        io_binding = session.io_binding()
+
+        # numpy arrays implement __dlpack__, the run reads and writes their memory directly
+        input = self.create_numpy_input()
+        output = np.zeros((3, 2), dtype=np.float32)
+        io_binding.bind_dlpack_input("X", input)
+        io_binding.bind_dlpack_output("Y", output)
+        session.run_with_iobinding(io_binding)
+        self.assertTrue(np.array_equal(self.create_expected_output(), output))
+
+        # the output shares the memory of the bound array and can be exported again
+        ort_output = io_binding.get_outputs()[0]
+        self.assertEqual(ort_output.data_ptr(), output.ctypes.data)
+        self.assertTrue(np.array_equal(self.create_expected_output(), np.from_dlpack(ort_output)))
+
     def test_bind_input_types(self):
 
         opset = onnx_opset_version()
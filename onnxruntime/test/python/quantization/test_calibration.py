@@ -358,6 +358,28 @@ class TestCalibrateMinMaxCalibrator(unittest.TestCase):
         for output_name in output_min_max_dict.keys():
             self.assertEqual(output_min_max_dict[output_name], tensors_range[output_name])
 
+    def test_compute_range_with_max_intermediate_outputs(self):
+        test_model_path = Path(self._tmp_model_dir.name).joinpath("./test_model_4.onnx")
+        self.construct_test_compute_range_model(test_model_path.as_posix())
+
+        data_reader = TestDataReader()
+        augmented_model_path = Path(self._tmp_model_dir.name).joinpath("./augmented_test_model_4.onnx")
+        calibrater = create_calibrator(test_model_path, augmented_model_path=augmented_model_path.as_posix())
+        calibrater.collect_data(data_reader)
+        expected_range = calibrater.compute_range()
+
+        # Ranges are computed every 3 batches, the last batch is handled at the end of collect_data.
+        data_reader.rewind()
+        streaming_augmented_model_path = Path(self._tmp_model_dir.name).joinpath("./augmented_test_model_4_s.onnx")
+        calibrater = create_calibrator(
+            test_model_path,
+            augmented_model_path=streaming_augmented_model_path.as_posix(),
+            extra_options={"max_intermediate_outputs": 3},
+        )
+        calibrater.collect_data(data_reader)
+        self.assertEqual(len(calibrater.intermediate_outputs), 0)
+        self.assertEqual(calibrater.compute_range(), expected_range)
+
     def test_augment_graph_with_zero_value_dimension(self):
         """TEST_CONFIG_5"""
         #   Conv
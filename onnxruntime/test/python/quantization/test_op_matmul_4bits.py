@@ -0,0 +1,132 @@
+#!/usr/bin/env python
+# coding: utf-8
+# -------------------------------------------------------------------------
+# Copyright (c) Microsoft Corporation. All rights reserved.
+# Licensed under the MIT License. See License.txt in the project root for
+# license information.
+# --------------------------------------------------------------------------
+
+import tempfile
+import unittest
+from pathlib import Path
+
+import numpy as np
+import onnx
+from onnx import TensorProto, helper
+from op_test_utils import TestDataFeeds, check_op_type_count
+
+import onnxruntime
+from onnxruntime.quantization.matmul_weight4_quantizer import MatMulWeight4Quantizer
+
+
+def dequantize_weight(model, node):
+    """
+    Dequantize the weight of a MatMulNBits node back to a (K, N) float matrix.
+    """
+    initializers = {init.name: onnx.numpy_helper.to_array(init) for init in model.graph.initializer}
+    attrs = {attr.name: helper.get_attribute_value(attr) for attr in node.attribute}
+    k, n, block_size = attrs["K"], attrs["N"], attrs["block_size"]
+    n_blocks = (k + block_size - 1) // block_size
+
+    packed = initializers[node.input[1]].reshape(n, n_blocks, block_size // 2)
+    quantized = np.empty((n, n_blocks, block_size), dtype=np.float32)
+    quantized[..., 0::2] = packed & 0x0F
+    quantized[..., 1::2] = packed >> 4
+
+    scales = initializers[node.input[2]].reshape(n, n_blocks, 1)
+    if len(node.input) > 3:
+        packed_zero_points = initializers[node.input[3]].reshape(n, -1)
+        zero_points = np.empty((n, packed_zero_points.shape[1] * 2), dtype=np.float32)
+        zero_points[:, 0::2] = packed_zero_points & 0x0F
+        zero_points[:, 1::2] = packed_zero_points >> 4
+        zero_points = zero_points[:, :n_blocks].reshape(n, n_blocks, 1)
+    else:
+        zero_points = 8.0
+
+    weight = ((quantized - zero_points) * scales).reshape(n, -1)[:, :k]
+    return weight.T
+
+
+class TestOpMatMul4Bits(unittest.TestCase):
+    @classmethod
+    def setUpClass(cls):
+        cls._tmp_model_dir = tempfile.TemporaryDirectory(prefix="test_matmul4bits.")
+
+    @classmethod
+    def tearDownClass(cls):
+        cls._tmp_model_dir.cleanup()
+
+    def input_feeds(self, n, shape):
+        input_data_list = []
+        for _ in range(n):
+            input_data_list.append({"input": np.random.normal(0, 1, shape).astype(np.float32)})
+        return TestDataFeeds(input_data_list)
+
+    def construct_model_matmul(self, output_model_path, k, n):
+        #      (input)
+        #         |
+        #       MatMul
+        #         |
+        #      (output)
+        weight = np.random.normal(0, 0.1, [k, n]).astype(np.float32)
+        initializers = [onnx.numpy_helper.from_array(weight, name="weight")]
+        matmul_node = helper.make_node("MatMul", ["input", "weight"], ["output"], name="MatMul")
+
+        input_tensor = helper.make_tensor_value_info("input", TensorProto.FLOAT, [-1, k])
+        output_tensor = helper.make_tensor_value_info("output", TensorProto.FLOAT, [-1, n])
+        graph = helper.make_graph(
+            [matmul_node], "matmul_test", [input_tensor], [output_tensor], initializer=initializers
+        )
+        model = helper.make_model(graph, opset_imports=[helper.make_opsetid("", 13)])
+        model.ir_version = 7  # use stable onnx ir version
+        onnx.save(model, output_model_path)
+
+    def quant_test(self, k, n, block_size, is_symmetric, algorithm="RTN"):
+        model_fp32_path = Path(self._tmp_model_dir.name).joinpath(f"matmul_fp32_{k}_{n}.onnx").as_posix()
+        self.construct_model_matmul(model_fp32_path, k, n)
+
+        data_reader = self.input_feeds(4, [8, k]) if algorithm == "GPTQ" else None
+        quantizer = MatMulWeight4Quantizer(
+            onnx.load(model_fp32_path),
+            block_size=block_size,
+            is_symmetric=is_symmetric,
+            algorithm=algorithm,
+            calibration_data_reader=data_reader,
+        )
+        model_q4 = quantizer.process()
+        model_q4_path = Path(self._tmp_model_dir.name).joinpath(f"matmul_q4_{k}_{n}_{algorithm}.onnx").as_posix()
+        quantizer.model.save_model_to_file(model_q4_path)
+
+        check_op_type_count(self, model_q4_path, MatMul=0, MatMulNBits=1)
+        self.assertEqual(len(model_q4.graph.node[0].input), 3 if is_symmetric else 4)
+
+        # The kernel must match a float MatMul with the dequantized weight.
+        weight = dequantize_weight(model_q4, model_q4.graph.node[0])
+        session = onnxruntime.InferenceSession(model_q4_path, providers=["CPUExecutionProvider"])
+        original = onnx.numpy_helper.to_array(onnx.load(model_fp32_path).graph.initializer[0])
+        for inputs in self.input_feeds(2, [5, k]):
+            output = session.run(None, inputs)[0]
+            np.testing.assert_allclose(output, inputs["input"] @ weight, rtol=1e-3, atol=1e-3)
+            # Loose check against the float model, 4 bits weights are not exact.
+            np.testing.assert_allclose(output, inputs["input"] @ original, atol=0.5)
+
+    def test_quantize_matmul_rtn_symmetric(self):
+        np.random.seed(13)
+        self.quant_test(64, 32, 32, True)
+
+    def test_quantize_matmul_rtn_asymmetric(self):
+        np.random.seed(13)
+        self.quant_test(96, 16, 32, False)
+
+    def test_quantize_matmul_rtn_padded_k(self):
+        np.random.seed(13)
+        self.quant_test(80, 16, 64, False)
+
+    def test_quantize_matmul_gptq(self):
+        np.random.seed(13)
+        self.quant_test(64, 32, 32, False, "GPTQ")
+        self.quant_test(64, 32, 32, True, "GPTQ")
+
+
+if __name__ == "__main__":
+    unittest.main()
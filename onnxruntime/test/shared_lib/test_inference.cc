@@ -10,6 +10,7 @@
 #include <mutex>
 #include <algorithm>
 #include <thread>
+#include <future>
 
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
@@ -1466,6 +1467,75 @@ TEST(CApiTest, io_binding) {
   binding.ClearBoundOutputs();
 }
 
+TEST(CApiTest, run_async) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(2);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value input = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(),
+                                              x_shape.data(), x_shape.size());
+  const std::array<float, 3 * 2> expected_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::Value output{nullptr};
+  Ort::RunOptions run_options;
+
+  struct RunResult {
+    std::promise<void> done;
+    size_t num_outputs = 0;
+    std::string error;
+  } result;
+
+  auto callback = [](void* user_data, OrtValue** /*outputs*/, size_t num_outputs, OrtStatusPtr status) {
+    auto* run_result = reinterpret_cast<RunResult*>(user_data);
+    run_result->num_outputs = num_outputs;
+    if (status != nullptr) {
+      run_result->error = Ort::GetApi().GetErrorMessage(status);
+      Ort::GetApi().ReleaseStatus(status);
+    }
+    run_result->done.set_value();
+  };
+
+  session.RunAsync(run_options, input_names, &input, 1, output_names, &output, 1, callback, &result);
+  result.done.get_future().wait();
+
+  ASSERT_EQ(result.error, "");
+  ASSERT_EQ(result.num_outputs, 1U);
+  ASSERT_TRUE(output.IsTensor());
+  auto type_info = output.GetTensorTypeAndShapeInfo();
+  ASSERT_EQ(expected_y.size(), type_info.GetElementCount());
+  const float* values = output.GetTensorData<float>();
+  ASSERT_TRUE(std::equal(values, values + expected_y.size(), std::begin(expected_y)));
+}
+
+TEST(CApiTest, run_async_requires_worker_thread) {
+  Ort::SessionOptions session_options;
+  session_options.SetIntraOpNumThreads(1);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  Ort::Value input = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(),
+                                              x_shape.data(), x_shape.size());
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+  Ort::Value output{nullptr};
+
+  auto callback = [](void*, OrtValue**, size_t, OrtStatusPtr status) { Ort::GetApi().ReleaseStatus(status); };
+  try {
+    session.RunAsync(Ort::RunOptions(), input_names, &input, 1, output_names, &output, 1, callback, nullptr);
+    FAIL() << "RunAsync should fail without a worker thread";
+  } catch (const Ort::Exception& e) {
+    ASSERT_EQ(e.GetOrtErrorCode(), ORT_INVALID_ARGUMENT);
+  }
+}
+
 #if defined(USE_CUDA) || defined(USE_TENSORRT)
 TEST(CApiTest, io_binding_cuda) {
 
@@ -1648,6 +1718,207 @@ TEST(CApiTest, cuda_graph) {
   binding.ClearBoundInputs();
   binding.ClearBoundOutputs();
 }
+
+// Each graph annotation id captures its own graph, bound to its own buffers.
+TEST(CApiTest, cuda_graph_with_annotation_id) {
+  const auto& api = Ort::GetApi();
+
+  OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+  ASSERT_TRUE(api.CreateCUDAProviderOptions(&cuda_options) == nullptr);
+  std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)>
+      rel_cuda_options(cuda_options, api.ReleaseCUDAProviderOptions);
+  std::vector<const char*> keys{"enable_cuda_graph", "max_cuda_graphs"};
+  std::vector<const char*> values{"1", "2"};
+  ASSERT_TRUE(api.UpdateCUDAProviderOptions(rel_cuda_options.get(), keys.data(), values.data(), 2) == nullptr);
+
+  Ort::SessionOptions session_options;
+  ASSERT_TRUE(api.SessionOptionsAppendExecutionProvider_CUDA_V2(
+                  static_cast<OrtSessionOptions*>(session_options),
+                  rel_cuda_options.get()) == nullptr);
+
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+  Ort::MemoryInfo info_cuda("Cuda", OrtAllocatorType::OrtArenaAllocator, 0, OrtMemTypeDefault);
+  Ort::Allocator cuda_allocator(session, info_cuda);
+
+  const std::array<int64_t, 2> shape = {3, 2};
+  constexpr size_t num_graphs = 2;
+  std::vector<Ort::MemoryAllocation> input_data;
+  std::vector<Ort::MemoryAllocation> output_data;
+  std::vector<Ort::IoBinding> bindings;
+  for (size_t graph = 0; graph < num_graphs; ++graph) {
+    input_data.push_back(cuda_allocator.GetAllocation(6 * sizeof(float)));
+    output_data.push_back(cuda_allocator.GetAllocation(6 * sizeof(float)));
+    Ort::Value bound_x = Ort::Value::CreateTensor(info_cuda, reinterpret_cast<float*>(input_data.back().get()), 6,
+                                                  shape.data(), shape.size());
+    Ort::Value bound_y = Ort::Value::CreateTensor(info_cuda, reinterpret_cast<float*>(output_data.back().get()), 6,
+                                                  shape.data(), shape.size());
+    bindings.emplace_back(session);
+    bindings.back().BindInput("X", bound_x);
+    bindings.back().BindOutput("Y", bound_y);
+  }
+
+  // Capture and then replay both graphs with changing inputs
+  for (int iteration = 0; iteration < 3; ++iteration) {
+    for (size_t graph = 0; graph < num_graphs; ++graph) {
+      const float scale = static_cast<float>(iteration * num_graphs + graph + 1);
+      std::array<float, 6> x_values;
+      std::array<float, 6> expected_y;
+      for (size_t i = 0; i < x_values.size(); ++i) {
+        x_values[i] = scale * static_cast<float>(i + 1);
+        expected_y[i] = x_values[i] * x_values[i];
+      }
+      cudaMemcpy(input_data[graph].get(), x_values.data(), sizeof(float) * x_values.size(), cudaMemcpyHostToDevice);
+
+      Ort::RunOptions run_options;
+      run_options.AddConfigEntry(kOrtRunOptionsConfigCudaGraphAnnotation, std::to_string(graph).c_str());
+      session.Run(run_options, bindings[graph]);
+
+      std::array<float, 6> y_values;
+      cudaMemcpy(y_values.data(), output_data[graph].get(), sizeof(float) * y_values.size(), cudaMemcpyDeviceToHost);
+      ASSERT_THAT(y_values, ::testing::ContainerEq(expected_y));
+    }
+  }
+
+  for (auto& binding : bindings) {
+    binding.ClearBoundInputs();
+    binding.ClearBoundOutputs();
+  }
+}
+
+// Sessions that allocate from the CUDA memory pool share it.
+TEST(CApiTest, cuda_mem_pool) {
+  const auto& api = Ort::GetApi();
+
+  OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+  ASSERT_TRUE(api.CreateCUDAProviderOptions(&cuda_options) == nullptr);
+  std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)>
+      rel_cuda_options(cuda_options, api.ReleaseCUDAProviderOptions);
+  std::vector<const char*> keys{"use_cuda_mem_pool", "cuda_mem_pool_release_threshold"};
+  std::vector<const char*> values{"1", "0"};
+  ASSERT_TRUE(api.UpdateCUDAProviderOptions(rel_cuda_options.get(), keys.data(), values.data(), 2) == nullptr);
+
+  Ort::SessionOptions session_options;
+  ASSERT_TRUE(api.SessionOptionsAppendExecutionProvider_CUDA_V2(
+                  static_cast<OrtSessionOptions*>(session_options),
+                  rel_cuda_options.get()) == nullptr);
+
+  std::vector<Ort::Session> sessions;
+  sessions.emplace_back(*ort_env, MODEL_URI, session_options);
+  sessions.emplace_back(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  const std::array<float, 3 * 2> expected_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  const char* input_names[] = {"X"};
+  const char* output_names[] = {"Y"};
+
+  for (int iteration = 0; iteration < 3; ++iteration) {
+    for (auto& session : sessions) {
+      Ort::Value x = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(),
+                                              x_shape.data(), x_shape.size());
+      auto outputs = session.Run(Ort::RunOptions{}, input_names, &x, 1, output_names, 1);
+      ASSERT_EQ(outputs.size(), 1u);
+      const float* y = outputs[0].GetTensorData<float>();
+      ASSERT_THAT(std::vector<float>(y, y + expected_y.size()), ::testing::ElementsAreArray(expected_y));
+    }
+  }
+}
+
+// The copies of the inputs and outputs run on the copy streams when do_copy_in_default_stream is disabled.
+TEST(CApiTest, cuda_copy_streams) {
+  const auto& api = Ort::GetApi();
+
+  OrtCUDAProviderOptionsV2* cuda_options = nullptr;
+  ASSERT_TRUE(api.CreateCUDAProviderOptions(&cuda_options) == nullptr);
+  std::unique_ptr<OrtCUDAProviderOptionsV2, decltype(api.ReleaseCUDAProviderOptions)>
+      rel_cuda_options(cuda_options, api.ReleaseCUDAProviderOptions);
+  std::vector<const char*> keys{"do_copy_in_default_stream"};
+  std::vector<const char*> values{"0"};
+  ASSERT_TRUE(api.UpdateCUDAProviderOptions(rel_cuda_options.get(), keys.data(), values.data(), 1) == nullptr);
+
+  Ort::SessionOptions session_options;
+  ASSERT_TRUE(api.SessionOptionsAppendExecutionProvider_CUDA_V2(
+                  static_cast<OrtSessionOptions*>(session_options),
+                  rel_cuda_options.get()) == nullptr);
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values{};
+  std::array<float, 3 * 2> y_values{};
+  Ort::Value x = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(), x_shape.data(), x_shape.size());
+  Ort::Value y = Ort::Value::CreateTensor(info_cpu, y_values.data(), y_values.size(), x_shape.data(), x_shape.size());
+
+  Ort::IoBinding binding(session);
+  binding.BindInput("X", x);
+  binding.BindOutput("Y", y);
+
+  // the pageable input is staged, so it can be updated as soon as Run returns
+  for (int iteration = 0; iteration < 4; ++iteration) {
+    std::vector<float> expected_y;
+    for (size_t i = 0; i < x_values.size(); ++i) {
+      x_values[i] = static_cast<float>(iteration + i);
+      expected_y.push_back(x_values[i] * x_values[i]);
+    }
+
+    session.Run(Ort::RunOptions{}, binding);
+    ASSERT_THAT(std::vector<float>(y_values.begin(), y_values.end()), ::testing::ElementsAreArray(expected_y));
+  }
+}
+
+// Outputs bound to pageable CPU memory are staged in pinned buffers, outputs in pinned memory are copied directly.
+TEST(CApiTest, cuda_cpu_outputs) {
+  Ort::SessionOptions session_options;
+  Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_CUDA(session_options, 0));
+  Ort::Session session(*ort_env, MODEL_URI, session_options);
+
+  Ort::MemoryInfo info_cpu = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemTypeDefault);
+  Ort::MemoryInfo info_pinned("CudaPinned", OrtAllocatorType::OrtDeviceAllocator, 0, OrtMemTypeCPUOutput);
+  Ort::Allocator pinned_allocator(session, info_pinned);
+
+  const std::array<int64_t, 2> x_shape = {3, 2};
+  std::array<float, 3 * 2> x_values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  const std::array<float, 3 * 2> expected_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+  Ort::Value x = Ort::Value::CreateTensor(info_cpu, x_values.data(), x_values.size(), x_shape.data(), x_shape.size());
+
+  Ort::IoBinding binding(session);
+  binding.BindInput("X", x);
+
+  // pre-allocated pageable memory
+  {
+    std::array<float, 3 * 2> y_values{};
+    Ort::Value y = Ort::Value::CreateTensor(info_cpu, y_values.data(), y_values.size(), x_shape.data(),
+                                            x_shape.size());
+    binding.BindOutput("Y", y);
+    session.Run(Ort::RunOptions{}, binding);
+    ASSERT_THAT(y_values, ::testing::ElementsAreArray(expected_y));
+  }
+
+  // pageable memory allocated by the session
+  {
+    binding.BindOutput("Y", info_cpu);
+    session.Run(Ort::RunOptions{}, binding);
+    std::vector<Ort::Value> output_values = binding.GetOutputValues();
+    ASSERT_EQ(output_values.size(), 1U);
+    const float* y_values = output_values[0].GetTensorData<float>();
+    ASSERT_THAT(std::vector<float>(y_values, y_values + expected_y.size()), ::testing::ElementsAreArray(expected_y));
+  }
+
+  // pinned memory
+  {
+    auto y_data = pinned_allocator.GetAllocation(expected_y.size() * sizeof(float));
+    ASSERT_NE(y_data.get(), nullptr);
+    float* y_values = reinterpret_cast<float*>(y_data.get());
+    Ort::Value y = Ort::Value::CreateTensor(info_pinned, y_values, expected_y.size(), x_shape.data(), x_shape.size());
+    binding.BindOutput("Y", y);
+    session.Run(Ort::RunOptions{}, binding);
+    ASSERT_THAT(std::vector<float>(y_values, y_values + expected_y.size()), ::testing::ElementsAreArray(expected_y));
+  }
+
+  binding.ClearBoundInputs();
+  binding.ClearBoundOutputs();
+}
 #endif
 
 TEST(CApiTest, create_tensor) {
@@ -2141,6 +2412,66 @@ TEST(CApiTest, TestSharedAllocators) {
   }
 }
 
+#ifdef USE_CUDA
+TEST(CApiTest, TestSharedCudaAllocators) {
+  OrtEnv* env_ptr = (OrtEnv*)(*ort_env);
+  const auto& api = Ort::GetApi();
+
+  std::vector<Input> inputs(1);
+  Input& input = inputs.back();
+  input.name = "X";
+  input.dims = {3, 2};
+  input.values = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f};
+  auto allocator_for_input_memory_allocation = std::make_unique<MockedOrtAllocator>();
+
+  std::vector<int64_t> expected_dims_y = {3, 2};
+  std::vector<float> expected_values_y = {1.0f, 4.0f, 9.0f, 16.0f, 25.0f, 36.0f};
+
+  Ort::SessionOptions session_options;
+  session_options.AddConfigEntry(kOrtSessionOptionsConfigUseEnvAllocators, "1");
+  Ort::ThrowOnError(OrtSessionOptionsAppendExecutionProvider_CUDA(session_options, 0));
+
+  Ort::MemoryInfo cuda_mem_info("Cuda", OrtArenaAllocator, 0, OrtMemTypeDefault);
+  Ort::MemoryInfo pinned_mem_info("CudaPinned", OrtArenaAllocator, 0, OrtMemTypeCPUOutput);
+
+  // the CUDA EP only uses pinned memory for OrtMemTypeCPUOutput so anything else is rejected
+  {
+    Ort::MemoryInfo invalid_mem_info("CudaPinned", OrtArenaAllocator, 0, OrtMemTypeCPUInput);
+    std::unique_ptr<OrtStatus, decltype(api.ReleaseStatus)> status_releaser(
+        api.CreateAndRegisterAllocator(env_ptr, invalid_mem_info, nullptr),
+        api.ReleaseStatus);
+    ASSERT_FALSE(status_releaser.get() == nullptr);
+  }
+
+  ASSERT_TRUE(api.CreateAndRegisterAllocator(env_ptr, cuda_mem_info, nullptr) == nullptr);
+  ASSERT_TRUE(api.CreateAndRegisterAllocator(env_ptr, pinned_mem_info, nullptr) == nullptr);
+
+  // Test that duplicates are handled
+  {
+    std::unique_ptr<OrtStatus, decltype(api.ReleaseStatus)> status_releaser(
+        api.CreateAndRegisterAllocator(env_ptr, cuda_mem_info, nullptr),
+        api.ReleaseStatus);
+    ASSERT_FALSE(status_releaser.get() == nullptr);
+  }
+
+  {
+    // both sessions run their CUDA nodes with the arena registered in the environment
+    Ort::Session session1(*ort_env, MODEL_URI, session_options);
+    Ort::Session session2(*ort_env, MODEL_URI, session_options);
+    for (int i = 0; i < 2; ++i) {
+      RunSession<float>(allocator_for_input_memory_allocation.get(), session1, inputs, "Y",
+                        expected_dims_y, expected_values_y, nullptr);
+      RunSession<float>(allocator_for_input_memory_allocation.get(), session2, inputs, "Y",
+                        expected_dims_y, expected_values_y, nullptr);
+    }
+  }
+
+  // Remove the registered shared allocators from the global environment (common to all tests)
+  ASSERT_TRUE(api.UnregisterAllocator(env_ptr, cuda_mem_info) == nullptr);
+  ASSERT_TRUE(api.UnregisterAllocator(env_ptr, pinned_mem_info) == nullptr);
+}
+#endif
+
 TEST(CApiTest, TestSharingOfInitializerAndItsPrepackedVersion) {
   // simple inference test
   // prepare inputs
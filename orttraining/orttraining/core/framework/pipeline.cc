@@ -87,17 +87,24 @@ const PipelineTask& PipelineSlot::GetFrontAction() const {
 }
 
 PipelineScheduler::PipelineScheduler() : num_stages_(0),
-                                         num_batches_(0) {}
+                                         num_batches_(0),
+                                         max_active_batches_(0) {}
 
 PipelineScheduler::PipelineScheduler(
     int num_batches,
     const int num_stages,
-    const std::vector<int>& stage_id_to_rank_id_map) : num_stages_(num_stages),
-                                                       num_batches_(num_batches),
-                                                       stage_id_to_rank_id_map_(stage_id_to_rank_id_map) {
+    const std::vector<int>& stage_id_to_rank_id_map,
+    const int max_active_batches) : num_stages_(num_stages),
+                                    num_batches_(num_batches),
+                                    max_active_batches_(max_active_batches > 0 ? max_active_batches : num_stages),
+                                    stage_id_to_rank_id_map_(stage_id_to_rank_id_map) {
   if (stage_id_to_rank_id_map.size() != static_cast<size_t>(num_stages)) {
     throw std::invalid_argument("stage_id_to_rank_id_map should contain the MPI ranks from the first to the last pipeline stages");
   }
+  if (max_active_batches_ > num_stages_) {
+    // More than num_stages_ active batches never shortens the schedule; it only holds more activations.
+    throw std::invalid_argument("max_active_batches should not exceed the number of pipeline stages");
+  }
 
   CreateComputeSchedule();
 
@@ -198,7 +205,7 @@ std::vector<int> PipelineScheduler::FindForwardComputeTime(const std::vector<int
         continue;
       }
 
-      if (compute_batch_count_.at(t) >= num_stages_) {
+      if (compute_batch_count_.at(t) >= max_active_batches_) {
         // At time t, the number of running batches is at maximum,
         // so we need to put this stage to another time slot.
         continue;
@@ -231,7 +238,7 @@ std::vector<int> PipelineScheduler::FindBackwardComputeTime(const std::vector<in
         continue;
       }
 
-      if (compute_batch_count_.at(t) >= num_stages_) {
+      if (compute_batch_count_.at(t) >= max_active_batches_) {
         continue;
       }
 
@@ -438,7 +445,11 @@ void PipelineScheduler::InsertBackwardCompute(const int batch_id, const std::vec
 
 void PipelineScheduler::CreateComputeSchedule() {
   // Expand table to accomonadate the new batch.
-  const int compute_max_time = 2 * num_stages_ + 2 * (num_batches_ - 1);
+  // With fewer active batches than stages, the pipeline cannot be kept full, so fall back to the
+  // bound of running every batch through all stages back-to-back.
+  const int compute_max_time = max_active_batches_ < num_stages_
+                                   ? 2 * num_stages_ * num_batches_
+                                   : 2 * num_stages_ + 2 * (num_batches_ - 1);
 
   compute_table_.resize(compute_max_time, std::vector<PipelineSlot>(num_stages_));
   compute_batch_count_.resize(compute_max_time);
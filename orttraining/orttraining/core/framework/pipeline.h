@@ -145,7 +145,11 @@ class PipelineSlot {
 class PipelineScheduler {
  public:
   PipelineScheduler();
-  PipelineScheduler(const int num_batches, const int num_stages, const std::vector<int>& stage_id_to_rank_id_map);
+  // max_active_batches caps the number of micro-batches in flight (forwarded but not yet fully
+  // backwarded) at any time slot, which bounds the activations each stage keeps alive.
+  // A non-positive value means num_stages, the classic 1F1B (PipeDream-flush) bound.
+  PipelineScheduler(const int num_batches, const int num_stages, const std::vector<int>& stage_id_to_rank_id_map,
+                    const int max_active_batches = 0);
 
   // Number of time steps.
   size_t GetScheduleSize() const { return compute_commute_table_.size(); }
@@ -214,6 +218,8 @@ class PipelineScheduler {
   int num_stages_;
   // Number of micro-batches.
   int num_batches_;
+  // Maximum number of micro-batches that can be active in the pipeline at the same time slot.
+  int max_active_batches_;
   // Compute-only pipeline schedule as a 2-D table. table_[i][j] is the computation happening in
   // the i-th time slot at the j-th stage. For example, PipeDream schedule may have
   //   1. table_[0][0].batch_id is 0 and table_[0][0].type is Forward.
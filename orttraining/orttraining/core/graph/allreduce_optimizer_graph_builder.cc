@@ -19,7 +19,8 @@ static bool IsNcclAvailable() {
 static Status AddNcclAllReduceForGradients(
     std::vector<ArgDef>& gradient_argdefs,
     std::vector<ArgDef>& input_gradient_argdef,
-    GraphAugmenter::GraphDefs& graph_defs) {
+    GraphAugmenter::GraphDefs& graph_defs,
+    const std::string& node_name = "NcclAllReduce") {
   std::vector<ArgDef> allreduce_outputs(gradient_argdefs.size());
   for (size_t i = 0; i < gradient_argdefs.size(); i++) {
     TypeProto* allreduced_gradient_type_proto = graph_defs.CopyTypeProto(gradient_argdefs[i]);
@@ -35,12 +36,69 @@ static Status AddNcclAllReduceForGradients(
                                   allreduce_outputs,
                                   {ONNX_NAMESPACE::MakeAttribute("group_type",
                                                                  static_cast<int64_t>(WorkerGroupType::DataParallel))},
-                                  "NcclAllReduce")});
+                                  node_name)});
 
   gradient_argdefs = allreduce_outputs;
   return Status::OK();
 }
 
+// Returns the size in bytes of the gradient once cast to element_type, or -1 if its shape is not fully known.
+static int64_t GetGradientSizeInBytes(const ArgDef& gradient_argdef,
+                                      ONNX_NAMESPACE::TensorProto_DataType element_type) {
+  int64_t element_size = 0;
+  switch (element_type) {
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT:
+      element_size = 4;
+      break;
+    case ONNX_NAMESPACE::TensorProto_DataType_FLOAT16:
+    case ONNX_NAMESPACE::TensorProto_DataType_BFLOAT16:
+      element_size = 2;
+      break;
+    default:
+      return -1;
+  }
+
+  if (gradient_argdef.type_proto == nullptr || !gradient_argdef.type_proto->tensor_type().has_shape()) {
+    return -1;
+  }
+
+  int64_t size = element_size;
+  for (const auto& dim : gradient_argdef.type_proto->tensor_type().shape().dim()) {
+    if (!dim.has_dim_value()) {
+      return -1;
+    }
+    size *= dim.dim_value();
+  }
+  return size;
+}
+
+// Splits the gradients into buckets of roughly bucket_size_in_bytes each. Gradients are visited from the last one
+// to the first, which is close to the order backward produces them in, so the first bucket only waits for the
+// tail of the backward pass. Gradients with an unknown size close the bucket they land in.
+static std::vector<std::vector<size_t>> GetGradientBuckets(const std::vector<ArgDef>& gradient_argdefs,
+                                                           ONNX_NAMESPACE::TensorProto_DataType element_type,
+                                                           int64_t bucket_size_in_bytes) {
+  std::vector<std::vector<size_t>> buckets;
+  std::vector<size_t> current_bucket;
+  int64_t current_bucket_size = 0;
+  for (size_t i = gradient_argdefs.size(); i > 0; --i) {
+    const size_t index = i - 1;
+    const int64_t gradient_size = GetGradientSizeInBytes(gradient_argdefs[index], element_type);
+    current_bucket.push_back(index);
+    current_bucket_size += gradient_size < 0 ? bucket_size_in_bytes : gradient_size;
+    if (current_bucket_size >= bucket_size_in_bytes) {
+      buckets.push_back(std::move(current_bucket));
+      current_bucket.clear();
+      current_bucket_size = 0;
+    }
+  }
+
+  if (!current_bucket.empty()) {
+    buckets.push_back(std::move(current_bucket));
+  }
+  return buckets;
+}
+
 AllreduceOptimizerGraphBuilder::AllreduceOptimizerGraphBuilder(
     const OptimizerBuilderRegistry& opt_builder_registry,
     const OptimizerGraphConfig& opt_graph_config,
@@ -75,15 +133,41 @@ Status AllreduceOptimizerGraphBuilder::BuildInternal(
   };
 
   // add gradient scaling
-  std::vector<ArgDef> output_gradient_argdef;
   const auto total_num_accumulations =
       opt_graph_config_.gradient_accumulation_steps * opt_graph_config_.data_parallel_group_size;
   ORT_RETURN_IF_NOT(total_num_accumulations > 0, "total_num_accumulations <= 0");
   const float scale = 1.0f / total_num_accumulations;
-  ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef, graph_defs,
-                                              opt_graph_config_.AllReduceDataType()));
 
-  ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+  if (opt_graph_config_.allreduce_bucket_size_in_bytes <= 0) {
+    std::vector<ArgDef> output_gradient_argdef;
+    ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, gradient_argdefs, output_gradient_argdef,
+                                                graph_defs, opt_graph_config_.AllReduceDataType()));
+
+    ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(gradient_argdefs, output_gradient_argdef, graph_defs));
+  } else {
+    // Each bucket gets its own scaling and AllReduce nodes, which only depend on the gradients in that bucket.
+    // This lets the AllReduce of the buckets completed early in the backward pass run ahead of the rest of it.
+    const auto buckets = GetGradientBuckets(gradient_argdefs, opt_graph_config_.AllReduceDataType(),
+                                            opt_graph_config_.allreduce_bucket_size_in_bytes);
+    for (const auto& bucket : buckets) {
+      std::vector<ArgDef> bucket_gradient_argdefs;
+      bucket_gradient_argdefs.reserve(bucket.size());
+      for (size_t index : bucket) {
+        bucket_gradient_argdefs.push_back(gradient_argdefs[index]);
+      }
+
+      std::vector<ArgDef> output_gradient_argdef;
+      ORT_RETURN_IF_ERROR(AddGradientScalingNodes(nodearg_name_generator, scale, bucket_gradient_argdefs,
+                                                  output_gradient_argdef, graph_defs,
+                                                  opt_graph_config_.AllReduceDataType()));
+      ORT_RETURN_IF_ERROR(AddNcclAllReduceForGradients(bucket_gradient_argdefs, output_gradient_argdef, graph_defs,
+                                                       nodearg_name_generator("NcclAllReduce")));
+
+      for (size_t i = 0; i < bucket.size(); ++i) {
+        gradient_argdefs[bucket[i]] = bucket_gradient_argdefs[i];
+      }
+    }
+  }
 
   // check if all gradients are finite
   ArgDef global_grad_norm_argdef;
@@ -31,7 +31,7 @@ enum class MixedPrecisionDataType {
 
 // Configuration for the DeepSpeed ZeRO technique.  Currently only the stage
 // setting is supported, and only with stages 0 (disabled) and 1 (optimizer
-// state partitioning).
+// state partitioning). Other stages are rejected when the optimizer graph is built.
 
 struct ZeROConfig {
   // Default configuration
@@ -68,6 +68,9 @@ struct OptimizerGraphConfig {
   MixedPrecisionDataType mixed_precision_type{MixedPrecisionDataType::FP16};
   bool allreduce_in_mixed_precision_type{false};
   bool use_nccl{false};
+  // Upper bound of the size of each gradient bucket reduced by a separate NCCL AllReduce.
+  // 0 means all gradients are reduced by a single AllReduce.
+  int64_t allreduce_bucket_size_in_bytes{0};
   ZeROConfig deepspeed_zero{0};
   int gradient_accumulation_steps{1};
   std::string loss_scale_input_name{};  // empty string means no loss scaling factor is applied
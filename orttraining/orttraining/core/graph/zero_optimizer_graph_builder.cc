@@ -436,6 +436,10 @@ ZeROOptimizerGraphBuilder::ZeROOptimizerGraphBuilder(
   ORT_ENFORCE(opt_graph_config.data_parallel_group_size > 1, "ZeRO optimizer graph builder can only be used for distributed training.");
   ORT_ENFORCE(opt_graph_config.use_nccl, "Distributed training with ZeRO is only supported with NCCL.");
   ORT_ENFORCE(IsNcclAvailable(), "Distributed training with NCCL is not supported, as NCCL is not enabled in this build.");
+  // Gradients and parameters are not partitioned, so stages 2 and 3 would silently run as stage 1.
+  ORT_ENFORCE(opt_graph_config.deepspeed_zero.stage <= 1,
+              "Only ZeRO stage 1 (optimizer state partitioning) is supported, got stage ",
+              opt_graph_config.deepspeed_zero.stage, ".");
 }
 
 Status ZeROOptimizerGraphBuilder::BuildInternal(
@@ -52,6 +52,24 @@ static size_t GetElementSize(const ONNX_NAMESPACE::DataType& tensor_type) {
   return elt_type->Size();
 }
 
+// Returns the size in bytes of the activation, or -1 if its shape or element type is not statically known.
+int64_t GetActivationSizeInBytes(const NodeArg& arg) {
+  const ONNX_NAMESPACE::TensorShapeProto* shape = arg.Shape();
+  if (shape == nullptr || arg.Type() == nullptr ||
+      arg.TypeAsProto()->tensor_type().elem_type() == ONNX_NAMESPACE::TensorProto_DataType_STRING) {
+    return -1;
+  }
+
+  int64_t size = static_cast<int64_t>(GetElementSize(arg.Type()));
+  for (const auto& dim : shape->dim()) {
+    if (!utils::HasDimValue(dim)) {
+      return -1;
+    }
+    size *= dim.dim_value();
+  }
+  return size;
+}
+
 // TODO(pengwa): extend this function to be more general.
 float InputOutputSizeRatio(const Node* node) {
   if (node->OpType().compare("Cast") == 0) {
@@ -73,7 +91,8 @@ float InputOutputSizeRatio(const Node* node) {
 }  // namespace
 
 Status MemoryOptimizer::ParseConfigFromString(const std::string& enable_memory_optimizer,
-                                              const std::string& level) {
+                                              const std::string& level,
+                                              const std::string& activation_budget) {
   optimizer_config_ = enable_memory_optimizer;
   if (!enable_memory_optimizer.empty()) {
     const auto user_config_strs = utils::SplitString(enable_memory_optimizer, ",");
@@ -104,6 +123,13 @@ Status MemoryOptimizer::ParseConfigFromString(const std::string& enable_memory_o
                     "Invalid probe level specified: ", level);
   recompute_probe_level_ = static_cast<ProbeLevel>(probe_level);
 
+  if (!activation_budget.empty()) {
+    auto result = std::from_chars(activation_budget.data(), activation_budget.data() + activation_budget.size(),
+                                  activation_budget_in_bytes_);
+    ORT_RETURN_IF_NOT(result.ec == std::errc() && activation_budget_in_bytes_ >= 0,
+                      "Invalid activation budget specified: ", activation_budget);
+  }
+
   return Status::OK();
 }
 
@@ -219,26 +245,45 @@ bool MemoryOptimizer::ModifyGraph(Graph& graph,
 
   subgraph_desc.skip_count += 1;
 
-  if (user_config.type != OptimizationType::None && subgraph_desc.skip_count > skip_count) {
+  bool should_apply = user_config.type != OptimizationType::None && subgraph_desc.skip_count > skip_count;
+  if (subgraph_stores.planned_instances.has_value()) {
+    should_apply = subgraph_stores.planned_instances->find(node) != subgraph_stores.planned_instances->end();
+  }
+
+  if (should_apply) {
     subgraph_desc.applied_count += 1;
-    Node* replacement_node_ptr = nullptr;
     LOGS(logger, WARNING) << "[Modify Graph] Node " << node->Name() << "(" << node->OpType() << ") is "
                           << UserConfigToString(user_config);
+
+    // For each stashed activation, the node index and output index its backward consumers are connected to.
+    InlinedHashMap<size_t, std::pair<NodeIndex, int>> replacement_output_ports;
+    // Newly added forward nodes consuming the stashed activations, their edges must be kept.
+    InlinedHashSet<NodeIndex> new_forward_node_indices;
     if (user_config.type == OptimizationType::Recompute) {
+      Node* replacement_node_ptr = nullptr;
       ORT_ENFORCE(CreateRecomputeGraph(graph, sub_graph_instance_info.first, replacement_node_ptr).IsOK());
+      ORT_ENFORCE(replacement_node_ptr);
+      for (size_t output_index : candidate_output_args_map.at(node)) {
+        replacement_output_ports[output_index] = {replacement_node_ptr->Index(), static_cast<int>(output_index)};
+      }
+    } else if (user_config.type == OptimizationType::Offload) {
+      ORT_ENFORCE(CreateOffloadGraph(graph, *node, candidate_output_args_map.at(node), new_forward_node_indices,
+                                     replacement_output_ports)
+                      .IsOK());
     } else {
       ORT_THROW("unsupported optimization type found: " + UserConfigToString(user_config));
     }
-    ORT_ENFORCE(replacement_node_ptr);
 
     graph_is_modified = true;
 
     for (size_t output_index : candidate_output_args_map.at(node)) {
+      const auto& replacement_output_port = replacement_output_ports.at(output_index);
       // Collect output edges (connecting to backward ops), to remove.
       std::vector<graph_utils::GraphEdge> output_edges;
       for (auto it = node->OutputEdgesBegin(), end = node->OutputEdgesEnd(); it != end; ++it) {
         size_t src_output_idx = static_cast<size_t>(it->GetSrcArgIndex());
-        if (src_output_idx != output_index) {
+        if (src_output_idx != output_index ||
+            new_forward_node_indices.find(it->GetNode().Index()) != new_forward_node_indices.end()) {
           continue;
         }
 
@@ -263,7 +308,7 @@ bool MemoryOptimizer::ModifyGraph(Graph& graph,
 
           // Add new edge connecting the input with the output nodes directly.
           // This also updates the destination node's input node args
-          graph.AddEdge(replacement_node_ptr->Index(), output_edge.dst_node, static_cast<int>(output_index),
+          graph.AddEdge(replacement_output_port.first, output_edge.dst_node, replacement_output_port.second,
                         output_edge.dst_arg_index);
         }
       }
@@ -294,6 +339,7 @@ Status MemoryOptimizer::ApplyImpl(Graph& graph, bool& modified, int /*graph_leve
 
   SubGraphStores recompute_subgraph_stores;
   SubGraphStores recompute_with_compromise_subgraph_stores;
+  SubGraphStores offload_subgraph_stores;
   GraphViewer graph_viewer(graph);
   const auto& node_ids = graph_viewer.GetNodesInTopologicalOrder();
 
@@ -325,6 +371,13 @@ Status MemoryOptimizer::ApplyImpl(Graph& graph, bool& modified, int /*graph_leve
                             recompute_with_compromise_subgraph_stores, logger, true,
                             can_compromise_stashed_activation);
     }
+
+    CheckNodeForOffload(*p_node, candidate_output_args_map, offload_subgraph_stores, logger);
+  }
+
+  if (activation_budget_in_bytes_ >= 0) {
+    PlanWithActivationBudget(candidate_output_args_map, recompute_subgraph_stores,
+                             recompute_with_compromise_subgraph_stores, offload_subgraph_stores, logger);
   }
 
   // The second pass - apply the transformation.
@@ -354,14 +407,118 @@ Status MemoryOptimizer::ApplyImpl(Graph& graph, bool& modified, int /*graph_leve
                                       recompute_with_compromise_subgraph_stores, p_node);
     }
 
+    if (!has_been_modified && offload_subgraph_stores.ContainsSubGraphInstance(p_node)) {
+      has_been_modified = ModifyGraph(graph, node_index_to_its_order_in_topological_sort_map,
+                                      candidate_output_args_map, logger,
+                                      boundary_op_order_in_topological_sort,
+                                      offload_subgraph_stores, p_node);
+    }
+
     modified = modified || has_been_modified;
   }
 
-  PrintSummary(recompute_subgraph_stores, recompute_with_compromise_subgraph_stores, logger);
+  PrintSummary(recompute_subgraph_stores, recompute_with_compromise_subgraph_stores, offload_subgraph_stores,
+               logger);
 
   return Status::OK();
 }
 
+void MemoryOptimizer::PlanWithActivationBudget(
+    const InlinedHashMap<const Node*, InlinedVector<size_t>>& candidate_output_args_map,
+    SubGraphStores& recompute_stores,
+    SubGraphStores& recompute_with_compromise_stores,
+    SubGraphStores& offload_stores,
+    const logging::Logger& logger) const {
+  recompute_stores.planned_instances.emplace();
+  recompute_with_compromise_stores.planned_instances.emplace();
+  offload_stores.planned_instances.emplace();
+
+  InlinedHashMap<const Node*, int64_t> stashed_sizes;
+  int64_t total_stashed_size = 0;
+  for (const auto& candidate : candidate_output_args_map) {
+    int64_t node_stashed_size = 0;
+    for (size_t output_index : candidate.second) {
+      const int64_t size = GetActivationSizeInBytes(*candidate.first->OutputDefs()[output_index]);
+      if (size < 0) {
+        node_stashed_size = -1;
+        break;
+      }
+      node_stashed_size += size;
+    }
+
+    if (node_stashed_size < 0) {
+      LOGS(logger, VERBOSE) << "Node " << candidate.first->Name() << "(" << candidate.first->OpType()
+                            << ") has stashed activations of unknown size, skipped by the activation budget planner.";
+      continue;
+    }
+
+    stashed_sizes[candidate.first] = node_stashed_size;
+    total_stashed_size += node_stashed_size;
+  }
+
+  int64_t size_to_save = total_stashed_size - activation_budget_in_bytes_;
+  LOGS(logger, INFO) << "Stashed activation size: " << total_stashed_size << " bytes, budget: "
+                     << activation_budget_in_bytes_ << " bytes.";
+
+  struct PlanCandidate {
+    const Node* node;
+    size_t cost;
+    int64_t size;
+  };
+
+  auto pick = [&size_to_save, &stashed_sizes](SubGraphStores& stores, OptimizationType type,
+                                               InlinedVector<PlanCandidate>& candidates) {
+    for (const auto& candidate : candidates) {
+      if (size_to_save <= 0) {
+        break;
+      }
+
+      SubGraphDesc& desc = stores.GetSubGraphDesc(stores.GetSubGraphInstance(candidate.node).second);
+      desc.user_optimizer_config = UserConfig{type, -1};
+      stores.planned_instances->insert(candidate.node);
+      stashed_sizes.erase(candidate.node);
+      size_to_save -= candidate.size;
+    }
+  };
+
+  // Ties are broken by node index so the plan does not depend on hash map iteration order.
+  auto by_cost_then_size = [](const PlanCandidate& lhs, const PlanCandidate& rhs) {
+    if (lhs.cost != rhs.cost) {
+      return lhs.cost < rhs.cost;
+    }
+    if (lhs.size != rhs.size) {
+      return lhs.size > rhs.size;
+    }
+    return lhs.node->Index() < rhs.node->Index();
+  };
+
+  InlinedVector<PlanCandidate> recompute_candidates;
+  for (const auto& instance : recompute_stores._optimization_target_graphs_) {
+    auto size_it = stashed_sizes.find(instance.first);
+    if (size_it != stashed_sizes.end()) {
+      recompute_candidates.push_back({instance.first, instance.second.first.size(), size_it->second});
+    }
+  }
+  std::sort(recompute_candidates.begin(), recompute_candidates.end(), by_cost_then_size);
+  pick(recompute_stores, OptimizationType::Recompute, recompute_candidates);
+
+  // Every offload costs a round trip of its activation, so cost is equal and the biggest ones go first.
+  InlinedVector<PlanCandidate> offload_candidates;
+  for (const auto& instance : offload_stores._optimization_target_graphs_) {
+    auto size_it = stashed_sizes.find(instance.first);
+    if (size_it != stashed_sizes.end()) {
+      offload_candidates.push_back({instance.first, 0, size_it->second});
+    }
+  }
+  std::sort(offload_candidates.begin(), offload_candidates.end(), by_cost_then_size);
+  pick(offload_stores, OptimizationType::Offload, offload_candidates);
+
+  if (size_to_save > 0) {
+    LOGS(logger, WARNING) << "Activation budget of " << activation_budget_in_bytes_ << " bytes cannot be met, "
+                          << size_to_save << " bytes of statically known stashed activations are left over.";
+  }
+}
+
 void MemoryOptimizer::NodesInTopoOrderToString(const InlinedVector<const Node*>& nodes_in_topological_order,
                                                std::string& subgraph_string_representation,
                                                std::string& log_info) const {
@@ -393,6 +550,9 @@ std::string MemoryOptimizer::UserConfigToString(const UserConfig& config) const
     case OptimizationType::Recompute: {
       type_str = "Recomputed";
     } break;
+    case OptimizationType::Offload: {
+      type_str = "Offloaded";
+    } break;
     default: {
       type_str = "Unknown";
     } break;
@@ -402,8 +562,10 @@ std::string MemoryOptimizer::UserConfigToString(const UserConfig& config) const
 
 void MemoryOptimizer::PrintSummary(const SubGraphStores& recompute_stores,
                                    const SubGraphStores& recompute_with_compromise_stores,
+                                   const SubGraphStores& offload_stores,
                                    const logging::Logger& logger) const {
-  if (recompute_stores.SubGraphDescCount() == 0 && recompute_with_compromise_stores.SubGraphDescCount() == 0) {
+  if (recompute_stores.SubGraphDescCount() == 0 && recompute_with_compromise_stores.SubGraphDescCount() == 0 &&
+      offload_stores.SubGraphDescCount() == 0) {
     return;
   }
 
@@ -437,6 +599,7 @@ void MemoryOptimizer::PrintSummary(const SubGraphStores& recompute_stores,
 
   print_info_from_stores("Recompute", recompute_stores);
   print_info_from_stores("RecomputeWithCompromise", recompute_with_compromise_stores);
+  print_info_from_stores("Offload", offload_stores);
 
   LOGS(logger, INFO) << summary.str() << "\n";
 }
@@ -683,10 +846,12 @@ void MemoryOptimizer::CheckNodeForRecompute(const Node& node,
   LOGS(logger, VERBOSE) << "Node " << node.Name() << "(" << node.OpType() << ") can be recomputed" << log_info;
 
   // Update the subgraph optimization config map - key is the subgraph string representation, value is user config.
+  // Offload configs share the subgraph string format, they are handled by CheckNodeForOffload.
   UserConfig user_config{OptimizationType::None, 0};
-  if (pattern_subgraph_to_user_optimizer_config_map_.find(subgraph_str_representation) !=
-      pattern_subgraph_to_user_optimizer_config_map_.end()) {
-    user_config = pattern_subgraph_to_user_optimizer_config_map_.at(subgraph_str_representation);
+  auto user_config_it = pattern_subgraph_to_user_optimizer_config_map_.find(subgraph_str_representation);
+  if (user_config_it != pattern_subgraph_to_user_optimizer_config_map_.end() &&
+      user_config_it->second.type != OptimizationType::Offload) {
+    user_config = user_config_it->second;
   }
 
   SubGraphDesc& subgraph_desc =
@@ -785,4 +950,101 @@ Status MemoryOptimizer::CreateRecomputeGraph(Graph& graph,
  ** Recompute related function implementation ends   **
  ******************************************************/
 
+/****************************************************
+ ** Offload related function implementation starts **
+ ****************************************************/
+
+void MemoryOptimizer::CheckNodeForOffload(const Node& node,
+                                          const InlinedHashMap<const Node*, InlinedVector<size_t>>&
+                                              candidate_output_args_map,
+                                          SubGraphStores& subgraph_stores,
+                                          const logging::Logger& logger) const {
+  // Activations produced on CPU are already in host memory, and MemcpyToHost/MemcpyFromHost are only
+  // registered by device execution providers.
+  const auto& provider_type = node.GetExecutionProviderType();
+  if (provider_type.empty() || provider_type == kCpuExecutionProvider) {
+    return;
+  }
+
+  InlinedVector<const Node*> nodes_in_topological_order{&node};
+  std::string subgraph_str_representation, log_info;
+  NodesInTopoOrderToString(nodes_in_topological_order, subgraph_str_representation, log_info);
+  LOGS(logger, VERBOSE) << "Node " << node.Name() << "(" << node.OpType() << ") can be offloaded";
+
+  UserConfig user_config{OptimizationType::None, 0};
+  auto user_config_it = pattern_subgraph_to_user_optimizer_config_map_.find(subgraph_str_representation);
+  if (user_config_it != pattern_subgraph_to_user_optimizer_config_map_.end() &&
+      user_config_it->second.type == OptimizationType::Offload) {
+    user_config = user_config_it->second;
+  }
+
+  SubGraphDesc& subgraph_desc =
+      subgraph_stores.Contains(subgraph_str_representation)
+          ? subgraph_stores.GetSubGraphDesc(subgraph_str_representation)
+          : subgraph_stores.CreateSubGraphDesc(subgraph_str_representation, user_config);
+
+  subgraph_desc.total_frequency += 1;
+
+  for (size_t output_index : candidate_output_args_map.at(&node)) {
+    auto shape_str = TensorShapeProtoToString(node.OutputDefs()[output_index]->Shape());
+    subgraph_desc.shape_str_frequency[shape_str]++;
+  }
+
+  subgraph_stores.AddSubGraphInstance(&node, nodes_in_topological_order, subgraph_desc);
+}
+
+Status MemoryOptimizer::CreateOffloadGraph(Graph& graph,
+                                           Node& node,
+                                           const InlinedVector<size_t>& output_indices,
+                                           InlinedHashSet<NodeIndex>& offload_node_indices,
+                                           InlinedHashMap<size_t, std::pair<NodeIndex, int>>& reload_output_ports)
+    const {
+  for (size_t output_index : output_indices) {
+    NodeArg* activation_arg = node.MutableOutputDefs()[output_index];
+    NodeArg* offloaded_arg = &graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(activation_arg->Name() + "_offload"),
+                                                       activation_arg->TypeAsProto());
+    NodeArg* reloaded_arg = &graph.GetOrCreateNodeArg(graph.GenerateNodeArgName(activation_arg->Name() + "_reload"),
+                                                      activation_arg->TypeAsProto());
+
+    // The copy to host runs with default priority, right after the activation is produced, so the device buffer
+    // can be released once the remaining forward consumers are done. With the CUDA EP the host side is allocated
+    // from pinned memory.
+    Node& offload_node = graph.AddNode(graph.GenerateNodeName(activation_arg->Name() + "_offload"),
+                                       "MemcpyToHost",
+                                       "Offload of " + activation_arg->Name(),
+                                       {activation_arg},
+                                       {offloaded_arg});
+    offload_node.SetExecutionProviderType(node.GetExecutionProviderType());
+    ORT_RETURN_IF_NOT(graph.SetOpSchemaFromRegistryForNode(offload_node),
+                      "Failed to set op schema for added offload node.");
+    graph.UpdateProducerNode(offloaded_arg->Name(), offload_node.Index());
+    graph.AddEdge(node.Index(), offload_node.Index(), static_cast<int>(output_index), 0);
+    graph.AddConsumerNode(activation_arg->Name(), &offload_node);
+
+    // The copy back to device is scheduled as late as possible, e.g. right before its backward consumers,
+    // in the same way as recompute nodes.
+    Node& reload_node = graph.AddNode(graph.GenerateNodeName(activation_arg->Name() + "_reload"),
+                                      "MemcpyFromHost",
+                                      "Reload of " + activation_arg->Name(),
+                                      {offloaded_arg},
+                                      {reloaded_arg});
+    reload_node.SetPriority(static_cast<int>(ExecutionPriority::LOCAL_LOW));
+    reload_node.SetExecutionProviderType(node.GetExecutionProviderType());
+    ORT_RETURN_IF_NOT(graph.SetOpSchemaFromRegistryForNode(reload_node),
+                      "Failed to set op schema for added reload node.");
+    graph.UpdateProducerNode(reloaded_arg->Name(), reload_node.Index());
+    graph.AddEdge(offload_node.Index(), reload_node.Index(), 0, 0);
+    graph.AddConsumerNode(offloaded_arg->Name(), &reload_node);
+
+    offload_node_indices.insert(offload_node.Index());
+    reload_output_ports[output_index] = {reload_node.Index(), 0};
+  }
+
+  return Status::OK();
+}
+
+/****************************************************
+ ** Offload related function implementation ends   **
+ ****************************************************/
+
 }  // namespace onnxruntime
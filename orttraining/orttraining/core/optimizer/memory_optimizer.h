@@ -3,6 +3,7 @@
 
 #pragma once
 #include <charconv>
+#include <optional>
 #include "core/common/inlined_containers.h"
 #include "core/common/string_utils.h"
 #include "core/optimizer/graph_transformer.h"
@@ -12,7 +13,7 @@ namespace onnxruntime {
 /**
 @Class MemoryOptimizer
 
-Find recomputable subgraphs and enable according to user configs.
+Find recomputable subgraphs and offloadable activations, and enable them according to user configs.
 */
 
 class MemoryOptimizer : public GraphTransformer {
@@ -37,7 +38,9 @@ class MemoryOptimizer : public GraphTransformer {
   enum class OptimizationType {
     None = 0,  // Disabled.
     Recompute = 1,
-    TypeMax = 2,
+    // Copy the stashed activation to host memory after its forward use, and copy it back before backward uses it.
+    Offload = 2,
+    TypeMax = 3,
   };
 
   /**
@@ -142,6 +145,10 @@ class MemoryOptimizer : public GraphTransformer {
 
     InlinedHashMap<std::string /*subgraph_representative_str*/, SubGraphDesc> subgraph_descs;
     InlinedHashMap<const Node*, GraphInstanceInfo> _optimization_target_graphs_;
+
+    // Instances picked by the activation budget planner. When set, only these instances are applied, regardless of
+    // requested_count in the user config.
+    std::optional<InlinedHashSet<const Node*>> planned_instances;
   };
 
   /**
@@ -153,10 +160,11 @@ class MemoryOptimizer : public GraphTransformer {
   };
 
  public:
-  MemoryOptimizer(const std::string& enable_memory_optimizer, const std::string& level)
+  MemoryOptimizer(const std::string& enable_memory_optimizer, const std::string& level,
+                  const std::string& activation_budget = "")
       : GraphTransformer("MemoryOptimizer") {
     // Parse user defined configs.
-    ORT_ENFORCE(ParseConfigFromString(enable_memory_optimizer, level).IsOK());
+    ORT_ENFORCE(ParseConfigFromString(enable_memory_optimizer, level, activation_budget).IsOK());
 
     RegisterAllowedRecomputeOps();
   }
@@ -166,7 +174,26 @@ class MemoryOptimizer : public GraphTransformer {
   bool ShouldOnlyApplyOnce() const override { return true; }
 
  private:
-  Status ParseConfigFromString(const std::string& enable_memory_optimizer, const std::string& level);
+  Status ParseConfigFromString(const std::string& enable_memory_optimizer, const std::string& level,
+                               const std::string& activation_budget);
+
+  /**
+   * @brief Pick recompute and offload instances until the stashed activations fit in activation_budget_in_bytes_.
+   * Recompute is preferred, subgraphs with fewer nodes first. The remaining activations are offloaded, the biggest
+   * first. Activations whose size is not statically known are neither counted nor picked.
+   *
+   * @param candidate_output_args_map A map from node to its candidate activations, which are consumed by both fw and
+   *  bw ops.
+   * @param recompute_stores Found recompute subgraphs.
+   * @param recompute_with_compromise_stores Found compromised recompute subgraphs, the planner does not pick them.
+   * @param offload_stores Found offloadable activations.
+   * @param logger Logger.
+   */
+  void PlanWithActivationBudget(const InlinedHashMap<const Node*, InlinedVector<size_t>>& candidate_output_args_map,
+                                SubGraphStores& recompute_stores,
+                                SubGraphStores& recompute_with_compromise_stores,
+                                SubGraphStores& offload_stores,
+                                const logging::Logger& logger) const;
 
   /**
    * @brief Prepare info including activation usage, node usage in fw and bw.
@@ -243,6 +270,7 @@ class MemoryOptimizer : public GraphTransformer {
    */
   void PrintSummary(const SubGraphStores& recompute_stores,
                     const SubGraphStores& recompute_with_compromise_stores,
+                    const SubGraphStores& offload_stores,
                     const logging::Logger& logger) const;
 
   /**************************************************
@@ -323,12 +351,54 @@ class MemoryOptimizer : public GraphTransformer {
    ** Recompute related function definition ends   **
    *************************************************/
 
+  /************************************************
+   ** Offload related function definition starts **
+   ***********************************************/
+
+  /**
+   * @brief For the node producing stashed activation, check whether its stashed activations can be offloaded.
+   *
+   * @param node The node producing stashed activations.
+   * @param candidate_output_args_map A map from node to its candidate activations, which are consumed by both fw and
+   *  bw ops.
+   * @param subgraph_stores A store to maintain all found subgraphs.
+   * @param logger Logger.
+   */
+  void CheckNodeForOffload(const Node& node,
+                           const InlinedHashMap<const Node*, InlinedVector<size_t>>&
+                               candidate_output_args_map,
+                           SubGraphStores& subgraph_stores,
+                           const logging::Logger& logger) const;
+
+  /**
+   * @brief Add a MemcpyToHost node after the node for each stashed activation, and a MemcpyFromHost node
+   * running late (LOCAL_LOW priority) to copy it back to device for backward consumers.
+   *
+   * @param graph Graph to modify.
+   * @param node The node producing stashed activations.
+   * @param output_indices Output indices of the stashed activations to offload.
+   * @param offload_node_indices Returns the indices of the added MemcpyToHost nodes.
+   * @param reload_output_ports Returns the node index and output index that replace each offloaded activation.
+   * @return Status
+   */
+  Status CreateOffloadGraph(Graph& graph,
+                            Node& node,
+                            const InlinedVector<size_t>& output_indices,
+                            InlinedHashSet<NodeIndex>& offload_node_indices,
+                            InlinedHashMap<size_t, std::pair<NodeIndex, int>>& reload_output_ports) const;
+
+  /************************************************
+   ** Offload related function definition ends   **
+   ***********************************************/
+
   // The op types that are supported predefined.
   InlinedHashMap<std::string, AllowedRecomputeNodeConfig> recomputable_op_type_to_input_arg_index_map_;
   // User enabled map of the subgraph string representation to the alleviation type.
   InlinedHashMap<std::string, UserConfig> pattern_subgraph_to_user_optimizer_config_map_;
   std::string optimizer_config_;
   ProbeLevel recompute_probe_level_;
+  // Budget for stashed activations in bytes, -1 means the planner is disabled.
+  int64_t activation_budget_in_bytes_{-1};
 };
 
 }  // namespace onnxruntime
@@ -186,6 +186,8 @@ class TrainingSession : public InferenceSession {
       bool do_all_reduce_in_mixed_precision_type{};
       // Whether to use NCCL.
       bool use_nccl{};
+      // Size of the gradient buckets reduced by separate NCCL AllReduce nodes, 0 uses a single AllReduce.
+      int64_t allreduce_bucket_size_in_bytes{};
       // Whether to partition the optimizer state.
       ZeROConfig deepspeed_zero{};
       // Selects the reduction algorithm for Adasum.
@@ -242,6 +244,11 @@ class TrainingSession : public InferenceSession {
 
       // The base path at which to save the intermediate partitioned input model (forward pass only).
       optional<PathString> partitioned_model_path{};
+
+      // Maximum number of micro-batches in flight at the same time. Fewer in-flight micro-batches
+      // reduce the activations kept by each stage at the cost of a longer pipeline bubble.
+      // A non-positive value means the number of pipeline stages.
+      int max_active_micro_batches{0};
     };
 
     // If pipeline is enabled, this field's has_value() returns true.
@@ -116,7 +116,7 @@ void Accelerator::OrtRun(torch::jit::Stack& stack) {
   // If such input schema appears before, we can reuse a cached compiled callable.
   torch::jit::CompleteArgumentSpec spec{false, inputs};
   if (cache_.find(spec) == cache_.end()) {
-    cache_.emplace(spec, Compile(spec, inputs));
+    cache_.emplace(spec, GetOrCompile(spec, inputs));
   }
 
   if (DumpInputsOutputs()) {
@@ -366,6 +366,32 @@ void Accelerator::ExampleRun(at::ArrayRef<c10::IValue> inputs) {
   }
 }
 
+CompiledObject Accelerator::GetOrCompile(
+    torch::jit::CompleteArgumentSpec spec, at::ArrayRef<c10::IValue>& args) {
+#ifdef USE_CUDA
+  NvtxRange range(__func__);
+#endif
+  // Compiled results of all Accelerator's. Entries live until the process exits
+  // so that re-captured graphs keep hitting the same sessions.
+  static std::unordered_map<CompiledGraphKey, CompiledObject, CompiledGraphKeyHash> shared_cache;
+  static std::mutex shared_cache_mutex;
+
+  CompiledGraphKey key{subgraph_->toString(false), spec};
+  {
+    std::lock_guard<std::mutex> lock(shared_cache_mutex);
+    auto it = shared_cache.find(key);
+    if (it != shared_cache.end()) {
+      return it->second;
+    }
+  }
+
+  // Compile without holding the lock because exporting acquires GIL.
+  // If another thread compiled the same key meanwhile, keep its result.
+  CompiledObject compiled = Compile(spec, args);
+  std::lock_guard<std::mutex> lock(shared_cache_mutex);
+  return shared_cache.emplace(std::move(key), std::move(compiled)).first->second;
+}
+
 CompiledObject Accelerator::Compile(
     torch::jit::CompleteArgumentSpec spec, at::ArrayRef<c10::IValue>& args) {
   CheckArgs(args);
@@ -377,7 +403,7 @@ CompiledObject Accelerator::Compile(
   // Create an empty session.
   compiled.sess = CreateSession();
   // Let's get the empty session and initialize it.
-  onnxruntime::InferenceSession& sess = *compiled.sess;
+  std::shared_ptr<onnxruntime::InferenceSession> sess = compiled.sess;
   // Export subgraph_ to ONNX.
   // The exporter should never fail. If it does, please modify
   // Accelerator::Supported to filter out unsupported operators.
@@ -387,27 +413,33 @@ CompiledObject Accelerator::Compile(
   OrtDevice shared_device = CheckAndGetTensorDevice(args);
   // Load ONNX model into session, register
   // EPs and finally initialize session.
-  InitializeSession(shared_device, serialized_model, sess);
+  InitializeSession(shared_device, serialized_model, *sess);
 
   onnxruntime::RunOptions run_options;
   std::vector<std::string> feed_names;
   std::vector<std::string> fetch_names;
 
-  for (auto node_arg : *sess.GetModelInputs().second) {
+  for (auto node_arg : *sess->GetModelInputs().second) {
     feed_names.push_back(node_arg->Name());
   }
-  for (auto node_arg : *sess.GetModelOutputs().second) {
+  for (auto node_arg : *sess->GetModelOutputs().second) {
     fetch_names.push_back(node_arg->Name());
   }
 
   // Duplicate device info for putting output tensors on the shared device.
   std::vector<OrtDevice> fetches_device_info(fetch_names.size(), shared_device);
 
+  // The callable may be reused by other Accelerator's (see GetOrCompile),
+  // so it must not refer to members of this Accelerator. Output types are
+  // copied because ExampleRun overwrites them when compiling for other inputs.
+  std::shared_ptr<torch::jit::Graph> subgraph = subgraph_;
+  std::vector<c10::TypePtr> output_types = output_types_;
+
   // Create a callable which feeds inputs to ORT
   // session's Run(...) and returns outputs.
-  auto code = [this, run_options,
+  auto code = [subgraph, output_types, run_options,
                feed_names, fetch_names,
-               fetches_device_info, &sess](at::ArrayRef<c10::IValue>& args) {
+               fetches_device_info, sess](at::ArrayRef<c10::IValue>& args) {
     // Inputs of ORT session.
     std::vector<OrtValue> feeds;
     // Outputs of ORT session.
@@ -418,18 +450,18 @@ CompiledObject Accelerator::Compile(
       NvtxRange range("Prepare inputs");
 #endif
       // Prepare inputs.
-      const auto num_inputs = subgraph_->inputs().size();
+      const auto num_inputs = subgraph->inputs().size();
       for (size_t i = 0; i < num_inputs; ++i) {
         // The value can be either tensor or scalar.
         // Scalar is a tensor with empty shape vector.
         // Create ORT tensor from Pytorch tensor without copy.
         if (args.at(i).isScalar()) {
           // Scalar.
-          // ORT_ENFORCE(subgraph_->inputs().at(i)->type()->kind() == c10::TypeKind::TensorType);
+          // ORT_ENFORCE(subgraph->inputs().at(i)->type()->kind() == c10::TypeKind::TensorType);
           feeds.push_back(CreateOrtScalarValue(args.at(i).toScalar()));
         } else if (args.at(i).isTensor()) {
           // Tensor.
-          ORT_ENFORCE(subgraph_->inputs().at(i)->type()->kind() == c10::TypeKind::TensorType);
+          ORT_ENFORCE(subgraph->inputs().at(i)->type()->kind() == c10::TypeKind::TensorType);
           feeds.push_back(CreateOrtTensorValue(args.at(i).toTensor()));
         } else {
           // Looks like LTC only passes scalars and tensors into backend, so we don't care
@@ -444,7 +476,7 @@ CompiledObject Accelerator::Compile(
       NvtxRange range("Call sess.Run");
 #endif
       // Inputs are ready. Let's run ORT.
-      ORT_THROW_IF_ERROR(sess.Run(
+      ORT_THROW_IF_ERROR(sess->Run(
           run_options,
           feed_names, feeds,
           fetch_names, &fetches, &fetches_device_info));
@@ -458,12 +490,12 @@ CompiledObject Accelerator::Compile(
       // Convert ORT output to Pytorch format.
       for (size_t i = 0; i < fetches.size(); ++i) {
         // Get the expected type of the i-th output.
-        const c10::TypePtr type = output_types_.at(i);
+        const c10::TypePtr type = output_types.at(i);
         // Convert ORTValue to IValue.
         if (type->isSubtypeOf(*c10::TensorType::get())) {
           ORT_ENFORCE(fetches.at(i).IsTensor(), "Only ORT tensor can be translated to Pytorch tensor.");
           auto value = CreateC10IvalueTensor(fetches.at(i));
-          auto expected_scalar_type = output_types_.at(i)->cast<c10::TensorType>()->scalarType().value();
+          auto expected_scalar_type = output_types.at(i)->cast<c10::TensorType>()->scalarType().value();
           outputs.push_back(value.toTensor().to(expected_scalar_type));
         } else if (type->isSubtypeOf(*c10::NumberType::get())) {
           // ORT represents scalar as tensor without shape.
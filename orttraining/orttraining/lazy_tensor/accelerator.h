@@ -3,6 +3,7 @@
 
 #include <torch/csrc/jit/ir/ir.h>
 #include <torch/csrc/jit/runtime/argument_spec.h>
+#include <c10/util/hash.h>
 #include "core/session/inference_session.h"
 #include "core/session/onnxruntime_cxx_api.h"
 
@@ -14,8 +15,28 @@ struct CompiledObject {
   // Callable to execute the computation represented by torch::jit::Graph.
   // It processes tensors across ORT and Pytorch and invokes "sess".
   std::function<std::vector<c10::IValue>(at::ArrayRef<c10::IValue>&)> code;
-  // Session used in the "code" above.
-  std::unique_ptr<onnxruntime::InferenceSession> sess;
+  // Session used in the "code" above. It's shared by all
+  // Accelerator's compiling the same graph for the same inputs.
+  std::shared_ptr<onnxruntime::InferenceSession> sess;
+};
+
+// Key of compiled results shared across Accelerator's. Pytorch creates
+// one Accelerator per ort::graph node, and lazy tensor may capture
+// the same sub-graph into different nodes (e.g., once per training
+// iteration), so we identify a compilation by the graph's structure
+// (its textual IR including types) and its input signature.
+struct CompiledGraphKey {
+  std::string graph;
+  torch::jit::CompleteArgumentSpec spec;
+  bool operator==(const CompiledGraphKey& other) const {
+    return spec == other.spec && graph == other.graph;
+  }
+};
+
+struct CompiledGraphKeyHash {
+  size_t operator()(const CompiledGraphKey& key) const {
+    return c10::hash_combine(std::hash<std::string>()(key.graph), key.spec.hashCode());
+  }
 };
 
 // Custom JIT engine called by Pytorch.
@@ -49,6 +70,10 @@ class Accelerator {
   // This calllable is cached for repeated uses.
   CompiledObject Compile(
       torch::jit::CompleteArgumentSpec spec, at::ArrayRef<c10::IValue>& args);
+  // Return the callable for "spec" from the process-wide cache,
+  // compiling "subgraph_" if no Accelerator has done it before.
+  CompiledObject GetOrCompile(
+      torch::jit::CompleteArgumentSpec spec, at::ArrayRef<c10::IValue>& args);
   // The graph to be compiled and executed by ORT.
   std::shared_ptr<torch::jit::Graph> subgraph_;
   // Previously compiled results.
@@ -307,6 +307,10 @@ class GraphExecutionManager(GraphExecutionInterface):
         probe_level = ortmodule._defined_from_envvar("ORTMODULE_MEMORY_OPT_PROBE_RECOMPUTE_LEVEL", "1", warn=True)
         session_options.add_session_config_entry("optimization.enable_memory_optimizer", alleviation_config)
         session_options.add_session_config_entry("optimization.enable_memory_probe_recompute_level", probe_level)
+        activation_budget = ortmodule._defined_from_envvar("ORTMODULE_MEMORY_OPT_ACTIVATION_BUDGET", "", warn=True)
+        session_options.add_session_config_entry(
+            "optimization.memory_optimizer_activation_budget_in_bytes", activation_budget
+        )
 
         if self._debug_options.save_onnx_models.save:
             session_options.optimized_model_filepath = os.path.join(
@@ -112,5 +112,27 @@ TEST(Pipeline, ScheduleB5S3) {
   TestPipelineScheduler(num_batches, num_stages, baseline_events);
 }
 
+TEST(Pipeline, ScheduleB4S3OneActiveBatch) {
+  constexpr int num_batches = 4;
+  constexpr int num_stages = 3;
+  constexpr int max_active_batches = 1;
+  onnxruntime::training::pipeline::PipelineScheduler schedule(num_batches, num_stages, {0, 1, 2}, max_active_batches);
+
+  // With a single active batch, a stage only starts the next forward once the previous backward is done.
+  for (int s = 0; s < num_stages; ++s) {
+    for (int b = 0; b + 1 < num_batches; ++b) {
+      EXPECT_GE(schedule.GetForwardComputeWaitedEvent(b + 1, s), schedule.GetBackwardComputeRecordedEvent(b, s))
+          << " batch " << b << " stage " << s;
+    }
+  }
+}
+
+TEST(Pipeline, ScheduleTooManyActiveBatches) {
+  constexpr int num_batches = 4;
+  constexpr int num_stages = 3;
+  EXPECT_THROW(onnxruntime::training::pipeline::PipelineScheduler(num_batches, num_stages, {0, 1, 2}, num_stages + 1),
+               std::invalid_argument);
+}
+
 }  // namespace test
 }  // namespace onnxruntime
\ No newline at end of file
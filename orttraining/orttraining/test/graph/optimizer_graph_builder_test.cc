@@ -478,6 +478,21 @@ TEST_F(OptimizerGraphBuilderTest, Allreduce_WithGradientAccumulation_WithMixedPr
   TestAllreduceOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, Allreduce_BucketedGradients) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  config.gradient_accumulation_steps = 1;
+  config.use_mixed_precision = false;
+  // each gradient holds a single float, so every gradient gets its own bucket
+  config.allreduce_bucket_size_in_bytes = sizeof(float);
+  TestAllreduceOptimizerGraphBuilder(config, graph_);
+
+  auto op_counts = CountOpsInGraph(graph_, false);
+  ASSERT_EQ(GetOpCount(op_counts, k_all_reduce_op_name), k_weight_names.size());
+  ASSERT_EQ(GetOpCount(op_counts, k_unscale_op_name), k_weight_names.size());
+}
+
 static void TestZeROOptimizerGraphBuilder(OptimizerGraphConfig config, Graph& graph) {
   std::unordered_map<std::string, std::string> updated_weight_names_map;
   std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
@@ -555,6 +570,18 @@ TEST_F(OptimizerGraphBuilderTest, ZeRO_WithGradientAccumulation_WithMixedPrecisi
   TestZeROOptimizerGraphBuilder(config, graph_);
 }
 
+TEST_F(OptimizerGraphBuilderTest, ZeRO_UnsupportedStage) {
+  OptimizerGraphConfig config;
+  config.data_parallel_group_size = 4;
+  config.use_nccl = true;
+  config.deepspeed_zero = ZeROConfig{3};
+  std::unordered_map<std::string, std::string> updated_weight_names_map;
+  std::unordered_map<std::string, training::TrainingSession::PartitionInfo> weight_partition_info;
+  ASSERT_THROW(ZeROOptimizerGraphBuilder(GetOptimizerBuilderRegistry(), config, GetOptInfoMap(),
+                                         updated_weight_names_map, weight_partition_info),
+               OnnxRuntimeException);
+}
+
 #endif  // ORT_USE_NCCL
 
 }  // namespace test
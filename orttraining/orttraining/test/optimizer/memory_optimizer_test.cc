@@ -90,6 +90,84 @@ TEST(MemoryOptimizerTests, GeluRecompute) {
   ASSERT_EQ(original_gelu_node->Priority(), static_cast<int>(ExecutionPriority::DEFAULT));
 }
 
+TEST(MemoryOptimizerTests, GeluOffload) {
+  const logging::Logger* logger = &logging::LoggingManager::DefaultLogger();
+  auto model_uri = MODEL_FOLDER "recompute_gelu.onnx";
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger));
+  Graph& graph = model->MainGraph();
+
+  // Offload only applies to activations produced on a device.
+  for (auto& node : graph.Nodes()) {
+    node.SetExecutionProviderType(kCudaExecutionProvider);
+  }
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+
+  const std::string alleviation_config("Gelu+:2:-1");
+  const std::string alleviation_level("1");
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<MemoryOptimizer>(alleviation_config, alleviation_level), TransformerLevel::Level3));
+
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level3, *logger));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["com.microsoft.Gelu"] == 1);
+  ASSERT_TRUE(op_to_count["MemcpyToHost"] == 1);
+  ASSERT_TRUE(op_to_count["MemcpyFromHost"] == 1);
+
+  const Node* gelu_node{nullptr};
+  const Node* offload_node{nullptr};
+  const Node* reload_node{nullptr};
+  for (auto& node : graph.Nodes()) {
+    if (node.OpType().compare("Gelu") == 0) {
+      gelu_node = &node;
+    } else if (node.OpType().compare("MemcpyToHost") == 0) {
+      offload_node = &node;
+    } else if (node.OpType().compare("MemcpyFromHost") == 0) {
+      reload_node = &node;
+    }
+  }
+
+  ASSERT_TRUE(gelu_node);
+  ASSERT_TRUE(offload_node);
+  ASSERT_TRUE(reload_node);
+
+  ASSERT_EQ(offload_node->InputDefs()[0]->Name(), gelu_node->OutputDefs()[0]->Name());
+  ASSERT_EQ(reload_node->InputDefs()[0]->Name(), offload_node->OutputDefs()[0]->Name());
+  ASSERT_EQ(offload_node->Priority(), static_cast<int>(ExecutionPriority::DEFAULT));
+  ASSERT_EQ(reload_node->Priority(), static_cast<int>(ExecutionPriority::LOCAL_LOW));
+
+  // Backward consumers now read the reloaded activation, forward consumers still read the original one.
+  ASSERT_GT(reload_node->GetOutputEdgesCount(), 0U);
+  ASSERT_GT(graph.GetConsumerNodes(gelu_node->OutputDefs()[0]->Name()).size(), 1U);
+}
+
+TEST(MemoryOptimizerTests, ActivationBudgetIgnoresUnknownSizes) {
+  const logging::Logger* logger = &logging::LoggingManager::DefaultLogger();
+  auto model_uri = MODEL_FOLDER "recompute_gelu.onnx";
+  std::shared_ptr<Model> model;
+  ASSERT_STATUS_OK(Model::Load(model_uri, model, nullptr, *logger));
+  Graph& graph = model->MainGraph();
+
+  onnxruntime::GraphTransformerManager graph_transformation_mgr{5};
+
+  // The planner overrides the user config, and the activations of this model all depend on input1_dim0, so nothing
+  // can be accounted for and the graph is left as it is.
+  const std::string alleviation_config("Gelu+:1:-1");
+  const std::string alleviation_level("1");
+  const std::string activation_budget("0");
+  ASSERT_STATUS_OK(graph_transformation_mgr.Register(
+      std::make_unique<MemoryOptimizer>(alleviation_config, alleviation_level, activation_budget),
+      TransformerLevel::Level3));
+
+  ASSERT_STATUS_OK(graph_transformation_mgr.ApplyTransformers(graph, TransformerLevel::Level3, *logger));
+
+  std::map<std::string, int> op_to_count = CountOpsInGraph(graph);
+  ASSERT_TRUE(op_to_count["com.microsoft.Gelu"] == 1);
+  ASSERT_TRUE(op_to_count["MemcpyToHost"] == 0);
+}
+
 TEST(MemoryOptimizerTests, TileRecompute) {
   const logging::Logger* logger = &logging::LoggingManager::DefaultLogger();
   auto model_uri = MODEL_FOLDER "recompute_tile.onnx";
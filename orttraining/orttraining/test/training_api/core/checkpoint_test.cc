@@ -399,6 +399,39 @@ TEST(CheckpointApiTest, SaveCustomPropertyAsCheckpoint_ThenLoad_CPU) {
   std::string restored_s_data = restored_property_bag.GetProperty<std::string>(s_property_name);
   ASSERT_EQ(s_data, restored_s_data);
 }
+
+/**
+ * Save a checkpoint asynchronously, update the states while it is written,
+ * then load it and check the states at the time of the save were written.
+ */
+TEST(CheckpointApiTest, SaveCheckpointAsync_ThenLoad_CPU) {
+  CheckpointState checkpoint_state;
+  PropertyBag& property_bag = checkpoint_state.property_bag;
+
+  std::string i_property_name("dataset_epoch_index");
+  property_bag.AddProperty(i_property_name, static_cast<int64_t>(400));
+
+  // Remove the temporary directory if it already exists.
+  auto ckpt_test_root_dir = ORT_TSTR("checkpointing_api_test_dir");
+  if (Env::Default().FolderExists(ckpt_test_root_dir)) {
+    ORT_ENFORCE(Env::Default().DeleteFolder(ckpt_test_root_dir).IsOK());
+  }
+  TemporaryDirectory tmp_dir{ckpt_test_root_dir};
+
+  PathString checkpoint_path{
+      ConcatPathComponent<PathChar>(tmp_dir.Path(), ORT_TSTR("e2e_ckpt_save_async_cpu"))};
+  std::future<Status> save_result = SaveCheckpointAsync(checkpoint_state, checkpoint_path);
+
+  // The states were copied before SaveCheckpointAsync returned.
+  checkpoint_state.property_bag = PropertyBag();
+  ASSERT_STATUS_OK(save_result.get());
+
+  CheckpointState checkpoint_state_to_load;
+  ASSERT_STATUS_OK(LoadCheckpoint(checkpoint_path, checkpoint_state_to_load));
+  PropertyBag& restored_property_bag = checkpoint_state_to_load.property_bag;
+  ASSERT_EQ(restored_property_bag.Size(), 1);
+  ASSERT_EQ(restored_property_bag.GetProperty<int64_t>(i_property_name), 400);
+}
 }  // namespace
 }  // namespace test
 }  // namespace training
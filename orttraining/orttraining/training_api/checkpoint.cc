@@ -1,6 +1,9 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // Licensed under the MIT License.
 
+#include <future>
+#include <thread>
+
 #include "core/common/inlined_containers.h"
 #include "core/common/logging/logging.h"
 #include "core/common/logging/sinks/clog_sink.h"
@@ -34,6 +37,9 @@ const PathString k_name_separator = ORT_TSTR("_");
 const char builtin_lr_property_name[] = "builtin.initial_learning_rate";
 const char builtin_step_property_name[] = "builtin.step";
 
+// Tensor protos copied out of the training states, along with the path of the file they are written to.
+using CheckpointFileContents = std::vector<std::pair<PathString, std::vector<ONNX_NAMESPACE::TensorProto>>>;
+
 /**
  * @brief Create TensorProtos From OrtValue objects
  *
@@ -119,9 +125,9 @@ bool StringEndsWith(PathString const& s, PathString const& p) {
   return std::equal(p.rbegin(), p.rend(), s.rbegin());
 }
 
-void WriteTensorProtoToFile(const PathString& file_path,
-                            const std::vector<ONNX_NAMESPACE::TensorProto>& tensor_protos,
-                            std::string caller_context) {
+Status WriteTensorProtoToFile(const PathString& file_path,
+                              const std::vector<ONNX_NAMESPACE::TensorProto>& tensor_protos,
+                              std::string caller_context) {
   auto file_write_status = WithOpenFile(
       file_path, false,
       [&tensor_protos](int fd) {
@@ -130,7 +136,42 @@ void WriteTensorProtoToFile(const PathString& file_path,
         return Status::OK();
       });
 
-  ORT_ENFORCE(file_write_status.IsOK(), caller_context, " write file failed: ", ToUTF8String(file_path));
+  ORT_RETURN_IF_NOT(file_write_status.IsOK(), caller_context, " write file failed: ", ToUTF8String(file_path),
+                    " - ", file_write_status.ErrorMessage());
+  return Status::OK();
+}
+
+/**
+ * @brief Write the checkpoint files. Files are independent of each other, so they are serialized and written
+ * in parallel, one thread per file.
+ *
+ * @param files tensor protos to write, along with their file paths.
+ * @return Status of the first write that failed, if any.
+ */
+Status WriteCheckpointFiles(const CheckpointFileContents& files) {
+  if (files.empty()) {
+    return Status::OK();
+  }
+
+  std::vector<Status> statuses(files.size());
+  std::vector<std::thread> writers;
+  writers.reserve(files.size() - 1);
+  for (size_t i = 1; i < files.size(); ++i) {
+    writers.emplace_back([&files, &statuses, i]() {
+      statuses[i] = WriteTensorProtoToFile(files[i].first, files[i].second, "[checkpoint]");
+    });
+  }
+
+  // The calling thread writes the first file.
+  statuses[0] = WriteTensorProtoToFile(files[0].first, files[0].second, "[checkpoint]");
+  for (auto& writer : writers) {
+    writer.join();
+  }
+
+  for (const auto& status : statuses) {
+    ORT_RETURN_IF_ERROR(status);
+  }
+  return Status::OK();
 }
 
 void LoadTensorProtoFromFile(const PathString& file_path,
@@ -190,22 +231,23 @@ Status OrtSaveInternal(
 
   // Save TensorProto to file.
   if (trainable_tensor_protos.size() > 0) {
-    WriteTensorProtoToFile(
+    ORT_RETURN_IF_ERROR(WriteTensorProtoToFile(
         GetTensorProtoFilePath(checkpoint_path, k_trainable_param_root_prefix),
-        trainable_tensor_protos, "[trainable_param]");
+        trainable_tensor_protos, "[trainable_param]"));
   }
 
   if (non_trainable_tensor_protos.size() > 0) {
-    WriteTensorProtoToFile(
+    ORT_RETURN_IF_ERROR(WriteTensorProtoToFile(
         GetTensorProtoFilePath(checkpoint_path, k_non_trainable_param_root_prefix),
-        non_trainable_tensor_protos, "[non_trainable_param]");
+        non_trainable_tensor_protos, "[non_trainable_param]"));
   }
 
   return Status::OK();
 }
 
 Status OrtSaveModuleStatesInternal(ModuleCheckpointState& module_state,
-                                   const PathString& parameter_folder_path) {
+                                   const PathString& parameter_folder_path,
+                                   CheckpointFileContents& files) {
   // Write weight tensors files.
   const auto& param_states = module_state.named_parameters;
   if (!param_states.empty()) {
@@ -230,10 +272,7 @@ Status OrtSaveModuleStatesInternal(ModuleCheckpointState& module_state,
           *module_state.train_session_data_transfer_mgr,
           param_tensor_protos));
 
-      // Save TensorProto to file.
-      WriteTensorProtoToFile(
-          GetTensorProtoFilePath(parameter_folder_path, pair.first),
-          param_tensor_protos, "[param]");
+      files.emplace_back(GetTensorProtoFilePath(parameter_folder_path, pair.first), std::move(param_tensor_protos));
     }
   }
 
@@ -241,7 +280,8 @@ Status OrtSaveModuleStatesInternal(ModuleCheckpointState& module_state,
 }
 
 Status OrtSaveOptimizerStatesInternal(OptimizerCheckpointState& optimizer_state,
-                                      const PathString& checkpoint_path) {
+                                      const PathString& checkpoint_path,
+                                      CheckpointFileContents& files) {
   if (optimizer_state.group_named_optimizer_states.empty()) {
     return Status::OK();
   }
@@ -284,10 +324,8 @@ Status OrtSaveOptimizerStatesInternal(OptimizerCheckpointState& optimizer_state,
           *optimizer_state.optimizer_session_data_transfer_mgr,
           saved_tensor_protos));
 
-      // Save TensorProto to file.
-      WriteTensorProtoToFile(
-          GetTensorProtoFilePath(checkpoint_path, cur_state_filename_prefix),
-          saved_tensor_protos, "[optimizer_state]");
+      files.emplace_back(GetTensorProtoFilePath(checkpoint_path, cur_state_filename_prefix),
+                         std::move(saved_tensor_protos));
     }
 
     // Storing group-wise properties.
@@ -297,42 +335,75 @@ Status OrtSaveOptimizerStatesInternal(OptimizerCheckpointState& optimizer_state,
     std::vector<ONNX_NAMESPACE::TensorProto> group_wise_properties_tensor_protos;
     properties.ToTensorProtos(group_wise_properties_tensor_protos);
 
-    WriteTensorProtoToFile(
-        GetTensorProtoPropertiesFilePath(checkpoint_path, cur_group_filename_prefix),
-        group_wise_properties_tensor_protos, "[param_group_properties]");
+    files.emplace_back(GetTensorProtoPropertiesFilePath(checkpoint_path, cur_group_filename_prefix),
+                       std::move(group_wise_properties_tensor_protos));
   }
 
   return Status::OK();
 }
 
-Status OrtSaveInternal(
-    CheckpointState& state, const PathString& checkpoint_path) {
+/**
+ * @brief Create the checkpoint folder and copy all training states to host tensor protos.
+ * Once this returns, the training states can be updated without affecting the checkpoint being written.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @param checkpoint_path folder where checkpoint is saved.
+ * @param files returns the tensor protos to write, along with their file paths.
+ * @return Status
+ */
+Status OrtSnapshotInternal(
+    CheckpointState& state, const PathString& checkpoint_path, CheckpointFileContents& files) {
   LOGS_DEFAULT(INFO) << "Saving model checkpoint files to " << ToUTF8String(checkpoint_path);
   LOGS_DEFAULT_IF(Env::Default().FolderExists(checkpoint_path), WARNING)
       << "Checkpoint directory exists - data may be overwritten.";
   ORT_RETURN_IF_ERROR(Env::Default().CreateFolder(checkpoint_path));
 
-  // Write weight tensors files.
-  ORT_RETURN_IF_ERROR(OrtSaveModuleStatesInternal(state.module_checkpoint_state, checkpoint_path));
+  // Weight tensors files.
+  ORT_RETURN_IF_ERROR(OrtSaveModuleStatesInternal(state.module_checkpoint_state, checkpoint_path, files));
 
-  // Write optimizer state tensors files.
-  ORT_RETURN_IF_ERROR(OrtSaveOptimizerStatesInternal(state.optimizer_checkpoint_state, checkpoint_path));
+  // Optimizer state tensors files.
+  ORT_RETURN_IF_ERROR(OrtSaveOptimizerStatesInternal(state.optimizer_checkpoint_state, checkpoint_path, files));
 
-  // Write properties file
+  // Properties file
   const PropertyBag& property_bag = state.property_bag;
   if (property_bag.Size() > 0) {
     std::vector<ONNX_NAMESPACE::TensorProto> properties_tensor_protos;
     property_bag.ToTensorProtos(properties_tensor_protos);
 
-    WriteTensorProtoToFile(
-        GetTensorProtoPropertiesFilePath(checkpoint_path, k_property_root_prefix),
-        properties_tensor_protos, "[custom_properties]");
+    files.emplace_back(GetTensorProtoPropertiesFilePath(checkpoint_path, k_property_root_prefix),
+                       std::move(properties_tensor_protos));
   }
 
+  return Status::OK();
+}
+
+Status OrtSaveInternal(
+    CheckpointState& state, const PathString& checkpoint_path) {
+  CheckpointFileContents files;
+  ORT_RETURN_IF_ERROR(OrtSnapshotInternal(state, checkpoint_path, files));
+  ORT_RETURN_IF_ERROR(WriteCheckpointFiles(files));
+
   LOGS_DEFAULT(INFO) << "Checkpoint saved successfully.";
   return Status::OK();
 }
 
+std::future<Status> OrtSaveAsyncInternal(
+    CheckpointState& state, const PathString& checkpoint_path) {
+  auto files = std::make_shared<CheckpointFileContents>();
+  Status snapshot_status = OrtSnapshotInternal(state, checkpoint_path, *files);
+  if (!snapshot_status.IsOK()) {
+    std::promise<Status> failed;
+    failed.set_value(snapshot_status);
+    return failed.get_future();
+  }
+
+  return std::async(std::launch::async, [files]() {
+    ORT_RETURN_IF_ERROR(WriteCheckpointFiles(*files));
+    LOGS_DEFAULT(INFO) << "Checkpoint saved successfully.";
+    return Status::OK();
+  });
+}
+
 Status OrtLoadModuleStatesInternal(
     const PathString& parameter_folder_path, ModuleCheckpointState& module_state) {
   // Find parameter files.
@@ -563,6 +634,10 @@ Status SaveCheckpoint(CheckpointState& states, const PathString& checkpoint_path
   return OrtSaveInternal(states, checkpoint_path);
 }
 
+std::future<Status> SaveCheckpointAsync(CheckpointState& states, const PathString& checkpoint_path) {
+  return OrtSaveAsyncInternal(states, checkpoint_path);
+}
+
 Status LoadCheckpoint(const PathString& checkpoint_path, CheckpointState& checkpoint_states) {
   return OrtLoadInternal(checkpoint_path, checkpoint_states);
 }
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <future>
+
 #include "core/platform/path_lib.h"
 #include "core/platform/env.h"
 #include "onnx/defs/tensor_proto_util.h"
@@ -60,6 +62,18 @@ struct CheckpointState {
 Status SaveCheckpoint(CheckpointState& state,
                       const PathString& checkpoint_path);
 
+/**
+ * @brief Save training states as ORT checkpoint without waiting for the files to be written.
+ * The states are copied to host memory before this returns, so training can go on and update them while
+ * the checkpoint files are written on a background thread.
+ *
+ * @param state parameter/optimizer and other user defined training states.
+ * @param checkpoint_path folder where checkpoint is saved.
+ * @return future holding the Status of the save, which must be waited on before the checkpoint is loaded.
+ */
+std::future<Status> SaveCheckpointAsync(CheckpointState& state,
+                                        const PathString& checkpoint_path);
+
 /**
  * @brief Save ONNX initializers as ORT checkpoint.
  *
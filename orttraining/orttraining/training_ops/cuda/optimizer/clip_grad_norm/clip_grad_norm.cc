@@ -87,7 +87,8 @@ Status InplaceClipGradNorm::ComputeInternal(OpKernelContext* ctx) const {
   ORT_RETURN_IF_ERROR(ctx->GetTempSpaceAllocator(&alloc));
 
   // Get frobenius norm for the grouped inputs
-  float* total_norm = reinterpret_cast<float*>(alloc->Alloc(sizeof(float)));
+  auto total_norm_buffer = GetScratchBuffer<float>(1, ctx->GetComputeStream());
+  float* total_norm = total_norm_buffer.get();
   ORT_RETURN_IF_ERROR(GetL2Norm(Stream(ctx), tensor_sizes, grouped_tensor_pointers, &total_norm));
 
   // Perform gradient clipping
@@ -439,48 +439,48 @@ void Impl(
       dX_indices, num_gathered_indices,
       dX_indices_sorted, dY_indices_sorted);
 
-  // get number of segments and segment counts
+  // get number of segments, segment counts and the largest segment size, which selects the implementation.
+  // the counts past the number of segments are zeroed, so the largest one is found without first reading the number
+  // of segments back and both values are read with a single CPU/GPU sync.
   SegmentIndex_t host_num_segments = 0;
+  GatheredIndexIndex_t host_max_segment_count = 0;
   auto segment_counts = allocator.GetScratchBuffer<GatheredIndexIndex_t>(num_gathered_indices);
   {
-    auto num_segments = allocator.GetScratchBuffer<SegmentIndex_t>(1);
-    size_t temp_storage_size_bytes = 0;
-    CUDA_CALL_THROW(cub::DeviceRunLengthEncode::Encode(
-        nullptr, temp_storage_size_bytes,
-        dX_indices_sorted.get(), cub::DiscardOutputIterator<TIndex>{}, segment_counts.get(),
-        num_segments.get(), num_gathered_indices, stream));
+    static_assert(std::is_same<SegmentIndex_t, GatheredIndexIndex_t>::value,
+                  "the number of segments and the largest segment size are read back together");
+    auto segment_stats = allocator.GetScratchBuffer<SegmentIndex_t>(2);
+    CUDA_CALL_THROW(cudaMemsetAsync(
+        segment_counts.get(), 0, num_gathered_indices * sizeof(GatheredIndexIndex_t), stream));
 
-    auto temp_storage = allocator.GetScratchBuffer<void>(temp_storage_size_bytes);
+    size_t encode_temp_storage_size_bytes = 0;
     CUDA_CALL_THROW(cub::DeviceRunLengthEncode::Encode(
-        temp_storage.get(), temp_storage_size_bytes,
+        nullptr, encode_temp_storage_size_bytes,
         dX_indices_sorted.get(), cub::DiscardOutputIterator<TIndex>{}, segment_counts.get(),
-        num_segments.get(), num_gathered_indices, stream));
-
-    // CPU/GPU sync!
-    CUDA_CALL_THROW(cudaMemcpyAsync(
-        &host_num_segments, num_segments.get(), sizeof(SegmentIndex_t), cudaMemcpyDeviceToHost, stream));
-    CUDA_CALL_THROW(cudaStreamSynchronize(stream));
-  }
-
-  // get largest segment size and use that to select implementation
-  GatheredIndexIndex_t host_max_segment_count = 0;
-  {
-    auto max_segment_count = allocator.GetScratchBuffer<GatheredIndexIndex_t>(1);
+        segment_stats.get(), num_gathered_indices, stream));
 
-    size_t temp_storage_size_bytes = 0;
+    size_t max_temp_storage_size_bytes = 0;
     CUDA_CALL_THROW(cub::DeviceReduce::Max(
-        nullptr, temp_storage_size_bytes,
-        segment_counts.get(), max_segment_count.get(), host_num_segments, stream));
+        nullptr, max_temp_storage_size_bytes,
+        segment_counts.get(), segment_stats.get() + 1, num_gathered_indices, stream));
+
+    auto temp_storage = allocator.GetScratchBuffer<void>(
+        std::max(encode_temp_storage_size_bytes, max_temp_storage_size_bytes));
+    CUDA_CALL_THROW(cub::DeviceRunLengthEncode::Encode(
+        temp_storage.get(), encode_temp_storage_size_bytes,
+        dX_indices_sorted.get(), cub::DiscardOutputIterator<TIndex>{}, segment_counts.get(),
+        segment_stats.get(), num_gathered_indices, stream));
 
-    auto temp_storage = allocator.GetScratchBuffer<void>(temp_storage_size_bytes);
     CUDA_CALL_THROW(cub::DeviceReduce::Max(
-        temp_storage.get(), temp_storage_size_bytes,
-        segment_counts.get(), max_segment_count.get(), host_num_segments, stream));
+        temp_storage.get(), max_temp_storage_size_bytes,
+        segment_counts.get(), segment_stats.get() + 1, num_gathered_indices, stream));
 
     // CPU/GPU sync!
+    SegmentIndex_t host_segment_stats[2];
     CUDA_CALL_THROW(cudaMemcpyAsync(
-        &host_max_segment_count, max_segment_count.get(), sizeof(GatheredIndexIndex_t), cudaMemcpyDeviceToHost, stream));
+        host_segment_stats, segment_stats.get(), sizeof(host_segment_stats), cudaMemcpyDeviceToHost, stream));
     CUDA_CALL_THROW(cudaStreamSynchronize(stream));
+    host_num_segments = host_segment_stats[0];
+    host_max_segment_count = host_segment_stats[1];
   }
 
   constexpr GatheredIndexIndex_t kMaxSegmentSizeThreshold = 32;
@@ -80,6 +80,19 @@ void ImageConverter::ResetCommandList(_In_ D3DDeviceCache& device_cache) {
   }
 }
 
+UINT32 ImageConverter::AcquireDescriptorSet(_In_ D3DDeviceCache& device_cache) {
+  descriptor_set_ = (descriptor_set_ + 1) % DescriptorSetCount;
+  // The descriptors of the set may only be rewritten once the conversion that last used them is done.
+  if (fence_completion_values_[descriptor_set_] > 0) {
+    device_cache.WaitForFenceValue(fence_completion_values_[descriptor_set_]);
+  }
+  return descriptor_set_ * DescriptorCount;
+}
+
+void ImageConverter::ReleaseDescriptorSet(uint64_t fence_completion_value) {
+  fence_completion_values_[descriptor_set_] = fence_completion_value;
+}
+
 void ImageConverter::ResetAllocator() {
   WINML_THROW_IF_FAILED(command_allocator_->Reset());
 }
@@ -370,25 +370,26 @@ void VideoFrameToTensorConverter::ConvertDX12TextureToGPUTensor(
   if (descriptor_heap_ == nullptr) {
     // Describe and create a shader resource view (SRV) and unordered access view (UAV) descriptor heap.
     D3D12_DESCRIPTOR_HEAP_DESC srvUavHeapDesc = {};
-    srvUavHeapDesc.NumDescriptors = DescriptorCount;
+    srvUavHeapDesc.NumDescriptors = DescriptorCount * DescriptorSetCount;
     srvUavHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
     srvUavHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
     WINML_THROW_IF_FAILED(spDx12Device->CreateDescriptorHeap(&srvUavHeapDesc, IID_PPV_ARGS(&descriptor_heap_)));
     descriptor_heap_->SetName(L"Tensorize Descriptor Heap");
   }
 
-  // Create SRV and UAV for input and output respectively
+  // Create SRV and UAV for input and output respectively, in a descriptor set that the GPU is done with
+  const UINT32 descriptorSetIdx = AcquireDescriptorSet(device_cache);
   {
     D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
     srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
     srvDesc.Format = inputDesc.Format;
     srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2D;
     srvDesc.Texture2D.MipLevels = 1;
-    CD3DX12_CPU_DESCRIPTOR_HANDLE srvHandle(descriptor_heap_->GetCPUDescriptorHandleForHeapStart(), SrvBufferIdx, srvUavDescriptorSize);
+    CD3DX12_CPU_DESCRIPTOR_HANDLE srvHandle(descriptor_heap_->GetCPUDescriptorHandleForHeapStart(), descriptorSetIdx + SrvBufferIdx, srvUavDescriptorSize);
     spDx12Device->CreateShaderResourceView(pInputResource, &srvDesc, srvHandle);
 
     D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = CreateUAVDescription(batchIdx, outputDesc, tensorDesc);
-    CD3DX12_CPU_DESCRIPTOR_HANDLE uavHandle(descriptor_heap_->GetCPUDescriptorHandleForHeapStart(), UavBufferIdx, srvUavDescriptorSize);
+    CD3DX12_CPU_DESCRIPTOR_HANDLE uavHandle(descriptor_heap_->GetCPUDescriptorHandleForHeapStart(), descriptorSetIdx + UavBufferIdx, srvUavDescriptorSize);
     spDx12Device->CreateUnorderedAccessView(pOutputResource, nullptr, &uavDesc, uavHandle);
   }
 
@@ -428,14 +429,8 @@ void VideoFrameToTensorConverter::ConvertDX12TextureToGPUTensor(
     ID3D12DescriptorHeap* ppHeaps[] = {descriptor_heap_.Get()};
     command_list_->SetDescriptorHeaps(_countof(ppHeaps), ppHeaps);
 
-    // This code currently re-uses the same decriptors each execution, which is unsafe if previous executions are in flight.
-    if (fence_completion_value_ > 0)
-    {
-        device_cache.WaitForFenceValue(fence_completion_value_);
-    }
-
-    CD3DX12_GPU_DESCRIPTOR_HANDLE srvHandle(descriptor_heap_->GetGPUDescriptorHandleForHeapStart(), SrvBufferIdx, srvUavDescriptorSize);
-    CD3DX12_GPU_DESCRIPTOR_HANDLE uavHandle(descriptor_heap_->GetGPUDescriptorHandleForHeapStart(), UavBufferIdx, srvUavDescriptorSize);
+    CD3DX12_GPU_DESCRIPTOR_HANDLE srvHandle(descriptor_heap_->GetGPUDescriptorHandleForHeapStart(), descriptorSetIdx + SrvBufferIdx, srvUavDescriptorSize);
+    CD3DX12_GPU_DESCRIPTOR_HANDLE uavHandle(descriptor_heap_->GetGPUDescriptorHandleForHeapStart(), descriptorSetIdx + UavBufferIdx, srvUavDescriptorSize);
     {
       ConstantBufferCS constantBufferCS = {};
       constantBufferCS.height = inputDesc.Height;
@@ -454,7 +449,7 @@ void VideoFrameToTensorConverter::ConvertDX12TextureToGPUTensor(
     ID3D12CommandList* pComputeToGPUCLs[] = {command_list_.Get()};
 
     device_cache.GetCommandQueue()->ExecuteCommandLists(ARRAYSIZE(pComputeToGPUCLs), pComputeToGPUCLs);
-    fence_completion_value_ = device_cache.QueueFenceToD3D12();
+    ReleaseDescriptorSet(device_cache.QueueFenceToD3D12());
   }
 }
 
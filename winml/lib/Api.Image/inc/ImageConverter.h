@@ -40,19 +40,25 @@ class ImageConverter {
   void ResetAllocator();
 
  protected:
-  // Indices of shader resources in the descriptor heap.
+  // Indices of shader resources in a descriptor set of the descriptor heap.
   enum DescriptorHeapIndex : UINT32 {
     SrvBufferIdx = 0,
     UavBufferIdx = SrvBufferIdx + 1,
     DescriptorCount = UavBufferIdx + 1
   };
 
+  // Number of descriptor sets in the descriptor heap. The conversions cycle through the sets, so a conversion only
+  // waits for the GPU to finish the conversion that used its set DescriptorSetCount conversions earlier, instead of
+  // the previous one.
+  static constexpr UINT32 DescriptorSetCount = 4;
+
   Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList> command_list_;
   Microsoft::WRL::ComPtr<ID3D12CommandAllocator> command_allocator_;
   Microsoft::WRL::ComPtr<ID3D12RootSignature> root_signature_;
   Microsoft::WRL::ComPtr<ID3D12PipelineState> pipeline_state_;
   Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> descriptor_heap_;
-  uint64_t fence_completion_value_ = 0;
+  uint64_t fence_completion_values_[DescriptorSetCount] = {};
+  UINT32 descriptor_set_ = 0;
 
   Microsoft::WRL::ComPtr<ID3D11Texture2D> D3D11_cached_texture_;
   wm::VideoFrame converted_video_frame_;
@@ -61,6 +67,10 @@ class ImageConverter {
   void SyncD3D11ToD3D12(_In_ _winml::D3DDeviceCache& device_cache, _In_ ID3D11Texture2D* D3D11_texture);
   void SyncD3D12ToD3D11(_In_ _winml::D3DDeviceCache& device_cache, _In_ ID3D11Texture2D* texture);
   void ResetCommandList(_In_ _winml::D3DDeviceCache& device_cache);
+  // Moves to the next descriptor set once the GPU is done with it, and returns the heap index of its first descriptor.
+  UINT32 AcquireDescriptorSet(_In_ _winml::D3DDeviceCache& device_cache);
+  // Records the fence value signaled once the GPU is done with the current descriptor set.
+  void ReleaseDescriptorSet(uint64_t fence_completion_value);
   Microsoft::WRL::ComPtr<ID3D11Fence> FetchOrCreateFenceOnDevice(_In_ _winml::D3DDeviceCache& device_cache, _In_ ID3D11Device* D3D11_device);
 
   Microsoft::WRL::ComPtr<ID3D11Texture2D> CreateTextureFromUnsupportedColorFormat(